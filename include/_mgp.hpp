@@ -261,10 +261,57 @@ inline mgp_vertex *graph_get_vertex_by_id(mgp_graph *g, mgp_vertex_id id, mgp_me
   return MgInvoke<mgp_vertex *>(mgp_graph_get_vertex_by_id, g, id, memory);
 }
 
+inline void graph_get_vertices_property(mgp_graph *g, const mgp_vertex_id *ids, size_t count, const char *property_name,
+                                        mgp_memory *memory, mgp_value **results) {
+  MgInvokeVoid(mgp_graph_get_vertices_property, g, ids, count, property_name, memory, results);
+}
+
+inline mgp_graph_projection *graph_project(mgp_graph *graph, const char *const *labels, size_t labels_count,
+                                           const char *const *edge_types, size_t edge_types_count,
+                                           const char *weight_property, double default_weight, mgp_memory *memory) {
+  return MgInvoke<mgp_graph_projection *>(mgp_graph_project, graph, labels, labels_count, edge_types, edge_types_count,
+                                          weight_property, default_weight, memory);
+}
+
+inline void graph_projection_destroy(mgp_graph_projection *projection) { mgp_graph_projection_destroy(projection); }
+
+inline size_t graph_projection_vertex_count(mgp_graph_projection *projection) {
+  return MgInvoke<size_t>(mgp_graph_projection_vertex_count, projection);
+}
+
+inline size_t graph_projection_edge_count(mgp_graph_projection *projection) {
+  return MgInvoke<size_t>(mgp_graph_projection_edge_count, projection);
+}
+
+inline const mgp_vertex_id *graph_projection_vertex_ids(mgp_graph_projection *projection) {
+  return MgInvoke<const mgp_vertex_id *>(mgp_graph_projection_vertex_ids, projection);
+}
+
+inline const size_t *graph_projection_offsets(mgp_graph_projection *projection) {
+  return MgInvoke<const size_t *>(mgp_graph_projection_offsets, projection);
+}
+
+inline const size_t *graph_projection_targets(mgp_graph_projection *projection) {
+  return MgInvoke<const size_t *>(mgp_graph_projection_targets, projection);
+}
+
+inline const double *graph_projection_weights(mgp_graph_projection *projection) {
+  return MgInvoke<const double *>(mgp_graph_projection_weights, projection);
+}
+
+inline size_t graph_projection_ordinal(mgp_graph_projection *projection, mgp_vertex_id id) {
+  return MgInvoke<size_t>(mgp_graph_projection_ordinal, projection, id);
+}
+
 inline mgp_vertices_iterator *graph_iter_vertices(mgp_graph *g, mgp_memory *memory) {
   return MgInvoke<mgp_vertices_iterator *>(mgp_graph_iter_vertices, g, memory);
 }
 
+inline void graph_parallel_for_vertices(mgp_graph *graph, size_t num_workers, mgp_vertices_range_cb cb, void *data,
+                                        mgp_memory *memory) {
+  MgInvokeVoid(mgp_graph_parallel_for_vertices, graph, num_workers, cb, data, memory);
+}
+
 // mgp_vertices_iterator
 
 inline void vertices_iterator_destroy(mgp_vertices_iterator *it) { mgp_vertices_iterator_destroy(it); }
@@ -277,6 +324,10 @@ inline mgp_vertex *vertices_iterator_next(mgp_vertices_iterator *it) {
   return MgInvoke<mgp_vertex *>(mgp_vertices_iterator_next, it);
 }
 
+inline size_t vertices_iterator_next_batch(mgp_vertices_iterator *it, mgp_vertex_id *ids, size_t capacity) {
+  return MgInvoke<size_t>(mgp_vertices_iterator_next_batch, it, ids, capacity);
+}
+
 // mgp_edges_iterator
 
 inline void edges_iterator_destroy(mgp_edges_iterator *it) { mgp_edges_iterator_destroy(it); }
@@ -413,6 +464,16 @@ inline mgp_edges_iterator *vertex_iter_out_edges(mgp_vertex *v, mgp_memory *memo
   return MgInvoke<mgp_edges_iterator *>(mgp_vertex_iter_out_edges, v, memory);
 }
 
+inline size_t vertex_in_edges_batch(mgp_vertex *v, mgp_edge_id *edge_ids, mgp_vertex_id *neighbor_ids,
+                                    mgp_edge_type *types, size_t capacity) {
+  return MgInvoke<size_t>(mgp_vertex_in_edges_batch, v, edge_ids, neighbor_ids, types, capacity);
+}
+
+inline size_t vertex_out_edges_batch(mgp_vertex *v, mgp_edge_id *edge_ids, mgp_vertex_id *neighbor_ids,
+                                     mgp_edge_type *types, size_t capacity) {
+  return MgInvoke<size_t>(mgp_vertex_out_edges_batch, v, edge_ids, neighbor_ids, types, capacity);
+}
+
 // mgp_edge
 
 inline mgp_edge_id edge_get_id(mgp_edge *e) { return MgInvoke<mgp_edge_id>(mgp_edge_get_id, e); }
@@ -580,7 +580,10 @@ enum mgp_error mgp_result_set_error_msg(struct mgp_result *res, const char *erro
 
 /// Create a new record for results.
 /// The previously obtained mgp_result_record pointer is no longer valid, and you must not use it.
+/// The records of read procedures are streamed to the query, so the call may wait until the query has pulled the
+/// previous records. Once the query no longer pulls them, the procedure should return without using the graph.
 /// Return mgp_error::MGP_ERROR_UNABLE_TO_ALLOCATE if unable to allocate a mgp_result_record.
+/// Return mgp_error::MGP_ERROR_LOGIC_ERROR if the query no longer pulls the records.
 enum mgp_error mgp_result_new_record(struct mgp_result *res, struct mgp_result_record **result);
 
 /// Assign a value to a field in the given record.
@@ -741,6 +744,26 @@ enum mgp_error mgp_vertex_iter_in_edges(struct mgp_vertex *v, struct mgp_memory
 enum mgp_error mgp_vertex_iter_out_edges(struct mgp_vertex *v, struct mgp_memory *memory,
                                          struct mgp_edges_iterator **result);
 
+/// Copy the inbound edges of the given vertex into caller-provided arrays, without allocating an mgp_edge for each of
+/// them. For the i-th edge, `edge_ids[i]` is set to its ID, `neighbor_ids[i]` to the ID of its source vertex and
+/// `types[i]` to its type. Any of the arrays can be NULL, in which case it isn't filled.
+/// Result is the number of copied edges.
+/// Return mgp_error::MGP_ERROR_INSUFFICIENT_BUFFER if the vertex has more than `capacity` edges, in which case the
+/// result is set to the number of edges, so that the arrays can be enlarged.
+/// Return mgp_error::MGP_ERROR_DELETED_OBJECT if `v` has been deleted.
+enum mgp_error mgp_vertex_in_edges_batch(struct mgp_vertex *v, struct mgp_edge_id *edge_ids,
+                                         struct mgp_vertex_id *neighbor_ids, struct mgp_edge_type *types,
+                                         size_t capacity, size_t *result);
+
+/// Copy the outbound edges of the given vertex into caller-provided arrays, like mgp_vertex_in_edges_batch does for
+/// the inbound edges. `neighbor_ids[i]` is set to the ID of the destination vertex of the i-th edge.
+/// Return mgp_error::MGP_ERROR_INSUFFICIENT_BUFFER if the vertex has more than `capacity` edges, in which case the
+/// result is set to the number of edges, so that the arrays can be enlarged.
+/// Return mgp_error::MGP_ERROR_DELETED_OBJECT if `v` has been deleted.
+enum mgp_error mgp_vertex_out_edges_batch(struct mgp_vertex *v, struct mgp_edge_id *edge_ids,
+                                          struct mgp_vertex_id *neighbor_ids, struct mgp_edge_type *types,
+                                          size_t capacity, size_t *result);
+
 /// Result is non-zero if the edges returned by this iterator can be modified.
 /// The mutability of the mgp_edges_iterator is the same as the graph which it belongs to.
 /// Current implementation always returns without errors.
@@ -832,6 +855,65 @@ struct mgp_graph;
 enum mgp_error mgp_graph_get_vertex_by_id(struct mgp_graph *g, struct mgp_vertex_id id, struct mgp_memory *memory,
                                           struct mgp_vertex **result);
 
+/// Get copies of a property of `count` vertices with the given IDs, reading the property of all of them with a single
+/// call. The property name is resolved only once. `results[i]` is set to the property of the vertex `ids[i]`, which is
+/// null if the vertex doesn't have the property, and must be freed with mgp_value_destroy.
+/// When an error is returned, none of the results are set.
+/// Return mgp_error::MGP_ERROR_UNABLE_TO_ALLOCATE if unable to allocate a mgp_value.
+/// Return mgp_error::MGP_ERROR_OUT_OF_RANGE if one of the vertices doesn't exist.
+/// Return mgp_error::MGP_ERROR_DELETED_OBJECT if one of the vertices has been deleted.
+enum mgp_error mgp_graph_get_vertices_property(struct mgp_graph *g, const struct mgp_vertex_id *ids, size_t count,
+                                               const char *property_name, struct mgp_memory *memory,
+                                               struct mgp_value **results);
+
+/// Compressed sparse row (CSR) projection of a graph.
+/// The projected vertices are numbered with ordinals from 0 to the vertex count, in the ascending order of their IDs.
+/// The outbound edges of the vertex with ordinal `i` are stored at positions from `offsets[i]` to `offsets[i + 1]` of
+/// the `targets` array, which holds the ordinals of the destination vertices, and of the `weights` array.
+/// The arrays stay valid until the projection is destroyed and mustn't be modified.
+struct mgp_graph_projection;
+
+/// Project the vertices which have one of the `labels` and the edges of one of the `edge_types` between them. Empty
+/// lists of labels or edge types select all vertices or all edges. If `weight_property` isn't NULL, the weight of an
+/// edge is its numeric `weight_property`, or `default_weight` if the edge doesn't have it.
+/// Projections are cached by the database and shared between procedure calls and transactions for as long as the
+/// graph doesn't change, so calling this function again for the same graph doesn't iterate over it again.
+/// Resulting projection must be freed with mgp_graph_projection_destroy.
+/// Return mgp_error::MGP_ERROR_UNABLE_TO_ALLOCATE if unable to allocate the projection.
+/// Return mgp_error::MGP_ERROR_VALUE_CONVERSION if the weight of an edge isn't a number.
+enum mgp_error mgp_graph_project(struct mgp_graph *graph, const char *const *labels, size_t labels_count,
+                                 const char *const *edge_types, size_t edge_types_count, const char *weight_property,
+                                 double default_weight, struct mgp_memory *memory,
+                                 struct mgp_graph_projection **result);
+
+/// Free the memory used by a mgp_graph_projection.
+void mgp_graph_projection_destroy(struct mgp_graph_projection *projection);
+
+/// Get the number of vertices in the projection.
+enum mgp_error mgp_graph_projection_vertex_count(struct mgp_graph_projection *projection, size_t *result);
+
+/// Get the number of edges in the projection.
+enum mgp_error mgp_graph_projection_edge_count(struct mgp_graph_projection *projection, size_t *result);
+
+/// Get the array of vertex count IDs of the projected vertices, indexed by their ordinals.
+enum mgp_error mgp_graph_projection_vertex_ids(struct mgp_graph_projection *projection,
+                                               const struct mgp_vertex_id **result);
+
+/// Get the array of vertex count + 1 offsets of the outbound edges of the vertices.
+enum mgp_error mgp_graph_projection_offsets(struct mgp_graph_projection *projection, const size_t **result);
+
+/// Get the array of edge count ordinals of the destinations of the edges.
+enum mgp_error mgp_graph_projection_targets(struct mgp_graph_projection *projection, const size_t **result);
+
+/// Get the array of edge count weights of the edges.
+/// Result is NULL if the projection was made without a weight property.
+enum mgp_error mgp_graph_projection_weights(struct mgp_graph_projection *projection, const double **result);
+
+/// Get the ordinal of the vertex with the given ID.
+/// Return mgp_error::MGP_ERROR_OUT_OF_RANGE if the vertex isn't in the projection.
+enum mgp_error mgp_graph_projection_ordinal(struct mgp_graph_projection *projection, struct mgp_vertex_id id,
+                                            size_t *result);
+
 /// Result is non-zero if the graph can be modified.
 /// If a graph is immutable, then vertices cannot be created or deleted, and all of the returned vertices will be
 /// immutable also. The same applies for edges.
@@ -882,6 +964,25 @@ void mgp_vertices_iterator_destroy(struct mgp_vertices_iterator *it);
 enum mgp_error mgp_graph_iter_vertices(struct mgp_graph *g, struct mgp_memory *memory,
                                        struct mgp_vertices_iterator **result);
 
+/// Callback invoked by mgp_graph_parallel_for_vertices for each range of vertices.
+/// `vertices` iterates over the range and is freed after the callback returns, so it mustn't be destroyed.
+/// `graph` is a read-only view of the graph which may be read concurrently with the other workers.
+/// `memory` belongs to the worker with the `worker_id`, from 0 to the number of workers, and is freed after
+/// mgp_graph_parallel_for_vertices returns, so nothing allocated from it may be returned by the procedure.
+typedef void (*mgp_vertices_range_cb)(struct mgp_vertices_iterator *vertices, struct mgp_graph *graph,
+                                      struct mgp_memory *memory, size_t worker_id, void *data);
+
+/// Iterate over disjoint ranges of the vertices of the graph on up to `num_workers` threads, calling `cb` for each
+/// of them. A value of 0 for `num_workers` uses all available cores. Each worker invokes `cb` for one range at a time,
+/// so the data of a worker may be kept in an array indexed by its `worker_id`. The function returns once all vertices
+/// have been visited. The graph mustn't be modified in the meantime, and the graph and the memory of the procedure
+/// mustn't be used by the callbacks.
+/// The ranges are visited one after another on the calling thread if the graph can't be read concurrently, which is
+/// the case for subgraphs and for users with fine-grained access restrictions.
+/// Return mgp_error::MGP_ERROR_UNABLE_TO_ALLOCATE if unable to allocate the memory of the workers.
+enum mgp_error mgp_graph_parallel_for_vertices(struct mgp_graph *graph, size_t num_workers, mgp_vertices_range_cb cb,
+                                               void *data, struct mgp_memory *memory);
+
 /// Result is non-zero if the vertices returned by this iterator can be modified.
 /// The mutability of the mgp_vertices_iterator is the same as the graph which it belongs to.
 /// Current implementation always returns without errors.
@@ -1195,6 +1296,15 @@ enum mgp_error mgp_duration_sub(struct mgp_duration *first, struct mgp_duration
 /// Result is NULL if the end of the iteration has been reached.
 /// Return mgp_error::MGP_ERROR_UNABLE_TO_ALLOCATE if unable to allocate a mgp_vertex.
 enum mgp_error mgp_vertices_iterator_next(struct mgp_vertices_iterator *it, struct mgp_vertex **result);
+
+/// Copy the IDs of the vertices starting from the current one into `ids`, at most `capacity` of them, and advance the
+/// iterator past them, without allocating an mgp_vertex for each of them.
+/// Afterwards mgp_vertices_iterator_get returns the vertex after the last copied one, and the previous mgp_vertex
+/// obtained from the iterator is invalidated.
+/// Result is the number of copied IDs, which is 0 if the end of the iteration has been reached.
+/// Return mgp_error::MGP_ERROR_UNABLE_TO_ALLOCATE if unable to allocate a mgp_vertex.
+enum mgp_error mgp_vertices_iterator_next_batch(struct mgp_vertices_iterator *it, struct mgp_vertex_id *ids,
+                                                size_t capacity, size_t *result);
 ///@}
 
 /// @name Type System
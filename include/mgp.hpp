@@ -11,13 +11,17 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
+#include <exception>
 #include <functional>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <shared_mutex>
+#include <span>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -111,7 +115,9 @@ class MemoryDispatcher final {
   mgp_memory *GetMemoryResource() noexcept {
     const auto this_id = std::this_thread::get_id();
     std::shared_lock lock(mut_);
-    return map_[this_id];
+    // Inserting under the shared lock would race with the other readers.
+    const auto it = map_.find(this_id);
+    return it == map_.end() ? nullptr : it->second;
   }
 
   void Register(mgp_memory *mem) noexcept {
@@ -214,6 +220,7 @@ class Graph {
  private:
   friend class Node;
   friend class Relationship;
+  friend class GraphProjection;
 
  public:
   explicit Graph(mgp_graph *graph);
@@ -228,6 +235,16 @@ class Graph {
   /// @brief Returns an iterable structure of the graph’s relationships.
   GraphRelationships Relationships() const;
 
+  /// @brief Calls `func(node, worker_id)` for each of the graph’s nodes on up to `num_workers` threads, or on all
+  /// cores if it's 0. The calls of a worker are sequential, and its `worker_id` is less than `num_workers`, so the
+  /// results may be accumulated per worker without locking. The graph mustn't be modified in the meantime.
+  /// The Node objects and any other values created by `func` are allocated from the memory of the worker, which is
+  /// freed once all nodes have been visited, so they can't be kept past this call.
+  /// @throw ValueException if the memory is set with the deprecated `mgp::memory` instead of MemoryDispatcherGuard.
+  /// @throws the first exception thrown by `func`, after which the remaining nodes are skipped.
+  template <typename Func>
+  void ParallelForNodes(size_t num_workers, const Func &func) const;
+
   /// @brief Returns the graph node with the given ID.
   Node GetNodeById(const Id node_id) const;
 
@@ -266,6 +283,55 @@ class Graph {
   mgp_graph *graph_;
 };
 
+/// @brief Compressed sparse row projection of the graph; wrapper class for @ref mgp_graph_projection.
+/// The projected nodes are numbered with ordinals in the ascending order of their IDs. The targets and the weights of
+/// the relationships going out of the node with ordinal `i` are at positions from `Offsets()[i]` to
+/// `Offsets()[i + 1]` of `Targets()` and `Weights()`.
+class GraphProjection {
+ public:
+  /// @brief Projects the nodes with one of the `labels` and the relationships of one of the `types` between them.
+  /// Empty lists select all nodes or all relationships. If `weight_property` is given, it's used as the weight of the
+  /// relationships which have it, and `default_weight` of the others. Projections of unchanged graphs are cached.
+  GraphProjection(const Graph &graph, const std::vector<std::string_view> &labels,
+                  const std::vector<std::string_view> &types,
+                  std::optional<std::string_view> weight_property = std::nullopt, double default_weight = 1.0);
+
+  GraphProjection(const GraphProjection &) = delete;
+  GraphProjection(GraphProjection &&other) noexcept;
+
+  GraphProjection &operator=(const GraphProjection &) = delete;
+  GraphProjection &operator=(GraphProjection &&other) noexcept;
+
+  ~GraphProjection();
+
+  /// @brief Returns the number of projected nodes.
+  size_t NodeCount() const;
+  /// @brief Returns the number of projected relationships.
+  size_t RelationshipCount() const;
+
+  /// @brief Returns the NodeCount() + 1 offsets of the relationships of the nodes.
+  std::span<const size_t> Offsets() const;
+  /// @brief Returns the ordinals of the end nodes of the relationships.
+  std::span<const size_t> Targets() const;
+  /// @brief Returns the weights of the relationships, which are empty if no weight property was given.
+  std::span<const double> Weights() const;
+
+  /// @brief Returns the ID of the node with the given ordinal.
+  mgp::Id NodeId(size_t ordinal) const;
+  /// @brief Returns the ordinal of the node with the given ID, if it's projected.
+  std::optional<size_t> Ordinal(mgp::Id node_id) const;
+
+ private:
+  mgp_graph_projection *ptr_;
+  // The arrays are immutable, so they are fetched only once.
+  size_t node_count_;
+  size_t relationship_count_;
+  const mgp_vertex_id *node_ids_;
+  const size_t *offsets_;
+  const size_t *targets_;
+  const double *weights_;
+};
+
 /// @brief View of graph nodes; wrapper class for @ref mgp_vertices_iterator.
 class Nodes {
  public:
@@ -1913,6 +1979,44 @@ inline GraphNodes Graph::Nodes() const {
 
 inline GraphRelationships Graph::Relationships() const { return GraphRelationships(graph_); }
 
+template <typename Func>
+inline void Graph::ParallelForNodes(size_t num_workers, const Func &func) const {
+  if (memory) {
+    throw ValueException("Parallel iteration requires the memory to be set with MemoryDispatcherGuard.");
+  }
+  struct State {
+    const Func *func;
+    std::atomic<bool> failed{false};
+    std::mutex error_lock;
+    std::exception_ptr error;
+  } state{.func = &func};
+
+  auto callback = [](mgp_vertices_iterator *vertices, mgp_graph * /*graph*/, mgp_memory *worker_memory,
+                     size_t worker_id, void *data) {
+    auto &state = *static_cast<State *>(data);
+    // Ranges may also be visited on the calling thread, whose memory is restored afterwards.
+    auto *previous_memory = mrd.GetMemoryResource();
+    mrd.Register(worker_memory);
+    try {
+      for (auto *vertex = vertices_iterator_get(vertices); vertex && !state.failed.load(std::memory_order_acquire);
+           vertex = vertices_iterator_next(vertices)) {
+        (*state.func)(Node(vertex), worker_id);
+      }
+    } catch (...) {
+      state.failed.store(true, std::memory_order_release);
+      const std::lock_guard guard(state.error_lock);
+      if (!state.error) state.error = std::current_exception();
+    }
+    if (previous_memory) {
+      mrd.Register(previous_memory);
+    } else {
+      mrd.UnRegister();
+    }
+  };
+  mgp::MemHandlerCallback(graph_parallel_for_vertices, graph_, num_workers, callback, &state);
+  if (state.error) std::rethrow_exception(state.error);
+}
+
 inline Node Graph::GetNodeById(const Id node_id) const {
   auto mgp_node = mgp::MemHandlerCallback(graph_get_vertex_by_id, graph_, mgp_vertex_id{.as_int = node_id.AsInt()});
   if (mgp_node == nullptr) {
@@ -1983,6 +2087,79 @@ inline void Graph::DeleteRelationship(const Relationship &relationship) {
   mgp::graph_delete_edge(graph_, relationship.ptr_);
 }
 
+// GraphProjection:
+
+inline GraphProjection::GraphProjection(const Graph &graph, const std::vector<std::string_view> &labels,
+                                        const std::vector<std::string_view> &types,
+                                        std::optional<std::string_view> weight_property, double default_weight) {
+  // The names have to be null-terminated.
+  const std::vector<std::string> label_names(labels.begin(), labels.end());
+  const std::vector<std::string> type_names(types.begin(), types.end());
+  std::vector<const char *> label_ptrs;
+  for (const auto &name : label_names) label_ptrs.push_back(name.c_str());
+  std::vector<const char *> type_ptrs;
+  for (const auto &name : type_names) type_ptrs.push_back(name.c_str());
+  const auto weight_name = weight_property ? std::optional<std::string>(*weight_property) : std::nullopt;
+
+  ptr_ = mgp::MemHandlerCallback(graph_project, graph.graph_, label_ptrs.data(), label_ptrs.size(), type_ptrs.data(),
+                                 type_ptrs.size(), weight_name ? weight_name->c_str() : nullptr, default_weight);
+  node_count_ = mgp::graph_projection_vertex_count(ptr_);
+  relationship_count_ = mgp::graph_projection_edge_count(ptr_);
+  node_ids_ = mgp::graph_projection_vertex_ids(ptr_);
+  offsets_ = mgp::graph_projection_offsets(ptr_);
+  targets_ = mgp::graph_projection_targets(ptr_);
+  weights_ = mgp::graph_projection_weights(ptr_);
+}
+
+inline GraphProjection::GraphProjection(GraphProjection &&other) noexcept
+    : ptr_(std::exchange(other.ptr_, nullptr)),
+      node_count_(other.node_count_),
+      relationship_count_(other.relationship_count_),
+      node_ids_(other.node_ids_),
+      offsets_(other.offsets_),
+      targets_(other.targets_),
+      weights_(other.weights_) {}
+
+inline GraphProjection &GraphProjection::operator=(GraphProjection &&other) noexcept {
+  if (this == &other) return *this;
+  if (ptr_ != nullptr) mgp::graph_projection_destroy(ptr_);
+  ptr_ = std::exchange(other.ptr_, nullptr);
+  node_count_ = other.node_count_;
+  relationship_count_ = other.relationship_count_;
+  node_ids_ = other.node_ids_;
+  offsets_ = other.offsets_;
+  targets_ = other.targets_;
+  weights_ = other.weights_;
+  return *this;
+}
+
+inline GraphProjection::~GraphProjection() {
+  if (ptr_ != nullptr) mgp::graph_projection_destroy(ptr_);
+}
+
+inline size_t GraphProjection::NodeCount() const { return node_count_; }
+
+inline size_t GraphProjection::RelationshipCount() const { return relationship_count_; }
+
+inline std::span<const size_t> GraphProjection::Offsets() const { return {offsets_, node_count_ + 1}; }
+
+inline std::span<const size_t> GraphProjection::Targets() const { return {targets_, relationship_count_}; }
+
+inline std::span<const double> GraphProjection::Weights() const {
+  if (weights_ == nullptr) return {};
+  return {weights_, relationship_count_};
+}
+
+inline mgp::Id GraphProjection::NodeId(size_t ordinal) const { return mgp::Id::FromInt(node_ids_[ordinal].as_int); }
+
+inline std::optional<size_t> GraphProjection::Ordinal(mgp::Id node_id) const {
+  try {
+    return mgp::graph_projection_ordinal(ptr_, mgp_vertex_id{.as_int = node_id.AsInt()});
+  } catch (const mg_exception::OutOfRangeException &) {
+    return std::nullopt;
+  }
+}
+
 // Nodes:
 
 inline Nodes::Nodes(mgp_vertices_iterator *nodes_iterator) : nodes_iterator_(nodes_iterator) {}
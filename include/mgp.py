@@ -1128,6 +1128,88 @@ class Vertices:
         return self._len
 
 
+class GraphProjection:
+    """
+    Compressed sparse row (CSR) projection of a graph.
+
+    The projected vertices are numbered with ordinals in the ascending order
+    of their IDs. The outbound edges of the vertex with ordinal `i` are at
+    positions from `offsets[i]` to `offsets[i + 1]` of `targets`, which holds
+    the ordinals of the destination vertices, and of `weights`.
+
+    The arrays are read-only `memoryview`s which share the memory of the
+    projection, so they can be passed to NumPy, SciPy or Arrow without copying
+    them. Unlike vertices and edges, the projection may be used after the
+    procedure returns.
+
+    Examples:
+        ```
+        projection = context.graph.project(edge_types=["FOLLOWS"])
+        offsets = numpy.asarray(projection.offsets)
+        targets = numpy.asarray(projection.targets)
+        matrix = scipy.sparse.csr_matrix(
+            (numpy.ones(len(targets)), targets, offsets),
+            shape=(projection.vertex_count, projection.vertex_count))
+        ```
+    """
+
+    __slots__ = ("_projection", "_vertex_ids", "_offsets", "_targets", "_weights", "_ordinals")
+
+    def __init__(self, projection):
+        if not isinstance(projection, _mgp.GraphProjection):
+            raise TypeError("Expected '_mgp.GraphProjection', got '{}'".format(type(projection)))
+        self._projection = projection
+        self._vertex_ids = projection.vertex_ids()
+        self._offsets = projection.offsets()
+        self._targets = projection.targets()
+        self._weights = projection.weights()
+        self._ordinals = None
+
+    @property
+    def vertex_count(self) -> int:
+        """Get the number of projected vertices."""
+        return len(self._vertex_ids)
+
+    @property
+    def edge_count(self) -> int:
+        """Get the number of projected edges."""
+        return len(self._targets)
+
+    @property
+    def vertex_ids(self) -> memoryview:
+        """Get the IDs of the projected vertices as 64-bit integers, indexed by their ordinals."""
+        return self._vertex_ids
+
+    @property
+    def offsets(self) -> memoryview:
+        """Get the `vertex_count + 1` offsets of the outbound edges as unsigned 64-bit integers."""
+        return self._offsets
+
+    @property
+    def targets(self) -> memoryview:
+        """Get the ordinals of the destinations of the edges as unsigned 64-bit integers."""
+        return self._targets
+
+    @property
+    def weights(self) -> typing.Optional[memoryview]:
+        """Get the weights of the edges as doubles, or None if the projection has no weight property."""
+        return self._weights
+
+    def ordinal(self, vertex_id: VertexId) -> int:
+        """
+        Get the ordinal of the vertex with the given ID.
+
+        Raises:
+            IndexError: If the vertex isn't in the projection.
+        """
+        if self._ordinals is None:
+            self._ordinals = {vertex_id: ordinal for ordinal, vertex_id in enumerate(self._vertex_ids)}
+        try:
+            return self._ordinals[vertex_id]
+        except KeyError:
+            raise IndexError("Vertex with ID {} isn't in the projection.".format(vertex_id)) from None
+
+
 class Graph:
     """State of the graph database in current ProcCtx."""
 
@@ -1322,6 +1404,45 @@ class Graph:
             raise InvalidContextError()
         self._graph.delete_edge(edge._edge)
 
+    def project(
+        self,
+        labels: typing.Iterable[str] = (),
+        edge_types: typing.Iterable[str] = (),
+        weight_property: typing.Optional[str] = None,
+        default_weight: float = 1.0,
+    ) -> GraphProjection:
+        """
+        Project the graph into contiguous arrays without creating an object
+        for each vertex and edge.
+
+        The vertices with one of the `labels` and the edges of one of the
+        `edge_types` between them are projected. Empty `labels` or
+        `edge_types` select all vertices or all edges. The projections of an
+        unchanged graph are cached, so projecting it again is cheap.
+
+        Args:
+            labels: Names of the labels of the projected vertices.
+            edge_types: Names of the types of the projected edges.
+            weight_property: Name of the numeric edge property used as the weight.
+            default_weight: Weight of the edges without the `weight_property`.
+
+        Returns:
+            `GraphProjection` of the graph.
+
+        Raises:
+            InvalidContextError: If context is invalid.
+            UnableToAllocateError: If unable to allocate the projection.
+            ValueConversionError: If the weight of an edge isn't a number.
+
+        Examples:
+            ```projection = graph.project(labels=["Person"], edge_types=["KNOWS"], weight_property="weight")```
+        """
+        if not self.is_valid():
+            raise InvalidContextError()
+        return GraphProjection(
+            self._graph.project(tuple(labels), tuple(edge_types), weight_property, float(default_weight))
+        )
+
 
 class AbortError(Exception):
     """Signals that the procedure was asked to abort its execution."""
@@ -8,18 +8,36 @@
 
 #include "audit/log.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <sstream>
+#include <thread>
 
 #include <fmt/format.h>
 #include <json/json.hpp>
 
 #include "storage/v2/temporal.hpp"
+#include "utils/event_counter.hpp"
 #include "utils/logging.hpp"
 #include "utils/string.hpp"
 
+namespace memgraph::metrics {
+extern const Event DroppedAuditLogEntries;
+}  // namespace memgraph::metrics
+
 namespace memgraph::audit {
 
+namespace {
+// Threads are assigned to the buffers round-robin when they first record an
+// entry.
+std::atomic<uint64_t> next_buffer{0};
+
+uint64_t ThreadBufferIndex() {
+  thread_local const uint64_t index = next_buffer.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+}  // namespace
+
 // Helper function that converts a `storage::PropertyValue` to `nlohmann::json`.
 inline nlohmann::json PropertyValueToJson(const storage::PropertyValue &pv) {
   nlohmann::json ret;
@@ -87,10 +105,12 @@ inline nlohmann::json PropertyValueToJson(const storage::PropertyValue &pv) {
   return ret;
 }
 
-Log::Log(const std::filesystem::path &storage_directory, int32_t buffer_size, int32_t buffer_flush_interval_millis)
+Log::Log(const std::filesystem::path &storage_directory, int32_t buffer_size, int32_t buffer_flush_interval_millis,
+         OverloadPolicy overload_policy)
     : storage_directory_(storage_directory),
       buffer_size_(buffer_size),
       buffer_flush_interval_millis_(buffer_flush_interval_millis),
+      overload_policy_(overload_policy),
       started_(false) {}
 
 void Log::Start() {
@@ -98,7 +118,12 @@ void Log::Start() {
 
   utils::EnsureDirOrDie(storage_directory_);
 
-  buffer_.emplace(buffer_size_);
+  // The buffers together hold at most `buffer_size_` entries.
+  const auto buffers = std::clamp<int32_t>(static_cast<int32_t>(std::thread::hardware_concurrency()), 1, buffer_size_);
+  buffers_.reserve(buffers);
+  for (int32_t i = 0; i < buffers; ++i) {
+    buffers_.push_back(std::make_unique<RingBuffer<Item>>(buffer_size_ / buffers));
+  }
   started_ = true;
 
   ReopenLog();
@@ -121,7 +146,18 @@ void Log::Record(const std::string &address, const std::string &username, const
   auto timestamp =
       std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
           .count();
-  buffer_->emplace(Item{timestamp, address, username, query, params, db});
+  auto &buffer = *buffers_[ThreadBufferIndex() % buffers_.size()];
+  switch (overload_policy_) {
+    case OverloadPolicy::BLOCK:
+      buffer.emplace(Item{timestamp, address, username, query, params, db});
+      break;
+    case OverloadPolicy::DROP:
+      if (!buffer.try_emplace(Item{timestamp, address, username, query, params, db})) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        memgraph::metrics::IncrementCounter(memgraph::metrics::DroppedAuditLogEntries);
+      }
+      break;
+  }
 }
 
 void Log::ReopenLog() {
@@ -133,14 +169,27 @@ void Log::ReopenLog() {
 
 void Log::Flush() {
   std::lock_guard<std::mutex> guard(lock_);
-  for (uint64_t i = 0; i < buffer_size_; ++i) {
-    auto item = buffer_->pop();
-    if (!item) break;
-    log_.Write(fmt::format("{}.{:06d},{},{},{},{},{}\n", item->timestamp / 1000000, item->timestamp % 1000000,
-                           item->address, item->username, item->db, utils::Escape(item->query),
-                           utils::Escape(PropertyValueToJson(item->params).dump())));
+  // Each buffer is drained only up to the size of all of them, so that a
+  // buffer which keeps being filled can't stall the flush.
+  std::vector<Item> items;
+  for (auto &buffer : buffers_) {
+    for (int32_t i = 0; i < buffer_size_; ++i) {
+      auto item = buffer->pop();
+      if (!item) break;
+      items.push_back(std::move(*item));
+    }
+  }
+  std::stable_sort(items.begin(), items.end(),
+                   [](const auto &lhs, const auto &rhs) { return lhs.timestamp < rhs.timestamp; });
+  for (const auto &item : items) {
+    log_.Write(fmt::format("{}.{:06d},{},{},{},{},{}\n", item.timestamp / 1000000, item.timestamp % 1000000,
+                           item.address, item.username, item.db, utils::Escape(item.query),
+                           utils::Escape(PropertyValueToJson(item.params).dump())));
   }
   log_.Sync();
+  if (const auto dropped = dropped_.exchange(0, std::memory_order_relaxed); dropped > 0) {
+    spdlog::warn("Dropped {} audit log entries because the audit log buffer was full.", dropped);
+  }
 }
 
 }  // namespace memgraph::audit
@@ -10,7 +10,9 @@
 
 #include <atomic>
 #include <filesystem>
+#include <memory>
 #include <optional>
+#include <vector>
 
 #include "data_structures/ring_buffer.hpp"
 #include "storage/v2/property_value.hpp"
@@ -22,8 +24,21 @@ namespace memgraph::audit {
 const uint64_t kBufferSizeDefault = 100000;
 const uint64_t kBufferFlushIntervalMillisDefault = 200;
 
+/// What `Log::Record` does when the buffer of the calling thread is full.
+enum class OverloadPolicy : uint8_t {
+  /// Waits until the buffer is flushed, which slows the queries down.
+  BLOCK,
+  /// Drops the entry, which is counted and reported when the log is flushed.
+  DROP,
+};
+
 /// This class implements an audit log. Functions used for logging are
 /// thread-safe, functions used for setup aren't thread-safe.
+///
+/// The entries are kept in several buffers, and each thread recording entries
+/// keeps using the same buffer, so that the threads don't contend for a
+/// single buffer. The entries are formatted and written in the order of their
+/// timestamps by the thread flushing the log.
 class Log {
  private:
   struct Item {
@@ -36,7 +51,8 @@ class Log {
   };
 
  public:
-  Log(const std::filesystem::path &storage_directory, int32_t buffer_size, int32_t buffer_flush_interval_millis);
+  Log(const std::filesystem::path &storage_directory, int32_t buffer_size, int32_t buffer_flush_interval_millis,
+      OverloadPolicy overload_policy = OverloadPolicy::BLOCK);
 
   ~Log();
 
@@ -63,9 +79,11 @@ class Log {
   std::filesystem::path storage_directory_;
   int32_t buffer_size_;
   int32_t buffer_flush_interval_millis_;
+  OverloadPolicy overload_policy_;
   std::atomic<bool> started_;
+  std::atomic<uint64_t> dropped_{0};
 
-  std::optional<RingBuffer<Item>> buffer_;
+  std::vector<std::unique_ptr<RingBuffer<Item>>> buffers_;
   utils::Scheduler scheduler_;
 
   utils::OutputFile log_;
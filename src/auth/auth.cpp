@@ -195,6 +195,7 @@ void Auth::SaveUser(const User &user) {
   if (!success) {
     throw AuthException("Couldn't save user '{}'!", user.username());
   }
+  epoch_.fetch_add(1, std::memory_order_acq_rel);
 }
 
 std::optional<User> Auth::AddUser(const std::string &username, const std::optional<std::string> &password) {
@@ -215,6 +216,7 @@ bool Auth::RemoveUser(const std::string &username_orig) {
   if (!storage_.DeleteMultiple(keys)) {
     throw AuthException("Couldn't remove user '{}'!", username);
   }
+  epoch_.fetch_add(1, std::memory_order_acq_rel);
   return true;
 }
 
@@ -252,6 +254,7 @@ void Auth::SaveRole(const Role &role) {
   if (!storage_.Put(kRolePrefix + role.rolename(), role.Serialize().dump())) {
     throw AuthException("Couldn't save role '{}'!", role.rolename());
   }
+  epoch_.fetch_add(1, std::memory_order_acq_rel);
 }
 
 std::optional<Role> Auth::AddRole(const std::string &rolename) {
@@ -277,6 +280,7 @@ bool Auth::RemoveRole(const std::string &rolename_orig) {
   if (!storage_.DeleteMultiple(keys)) {
     throw AuthException("Couldn't remove role '{}'!", rolename);
   }
+  epoch_.fetch_add(1, std::memory_order_acq_rel);
   return true;
 }
 
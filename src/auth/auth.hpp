@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <optional>
 #include <vector>
@@ -158,6 +160,16 @@ class Auth final {
    */
   std::vector<User> AllUsersForRole(const std::string &rolename) const;
 
+  /**
+   * Gets the counter of the changes of users and roles, which is incremented
+   * after each change while the changing thread still holds the lock. The
+   * counter is atomic, so readers that only want to check whether what they
+   * cached is still current can read it without the lock.
+   *
+   * @return the counter of changes
+   */
+  const std::atomic<uint64_t> &Epoch() const { return epoch_; }
+
 #ifdef MG_ENTERPRISE
   /**
    * @brief Revoke access to individual database for a user.
@@ -204,5 +216,6 @@ class Auth final {
   // more than one operation on the storage.
   kvstore::KVStore storage_;
   auth::Module module_;
+  std::atomic<uint64_t> epoch_{0};
 };
 }  // namespace memgraph::auth
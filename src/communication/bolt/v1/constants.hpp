@@ -30,6 +30,13 @@ inline constexpr size_t kHandshakeSize = 20;
 
 inline constexpr uint16_t kSupportedVersions[] = {0x0100, 0x0400, 0x0401, 0x0403, 0x0502};
 
+/**
+ * Compression which the client can request with the `compression` field of
+ * the HELLO message. The server confirms it with the same field in the
+ * success message, after which everything it sends is compressed.
+ */
+inline constexpr char kCompressionZlib[] = "zlib";
+
 inline constexpr int kPullAll = -1;
 inline constexpr int kPullLast = -1;
 }  // namespace memgraph::communication::bolt
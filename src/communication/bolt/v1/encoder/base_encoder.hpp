@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <string_view>
 #include <type_traits>
 
 #include "communication/bolt/v1/codes.hpp"
@@ -104,9 +105,18 @@ class BaseEncoder {
     }
   }
 
-  void WriteString(const std::string &value) {
+  /**
+   * Writes the string. Buffers which can send data by reference may reference
+   * the contents of large strings, which then have to stay valid until the
+   * buffer is flushed.
+   */
+  void WriteString(std::string_view value) {
     WriteTypeSize(value.size(), MarkerString);
-    WriteRAW(value.c_str(), value.size());
+    if constexpr (requires(const uint8_t *data, uint64_t len) { buffer_.WriteReference(data, len); }) {
+      buffer_.WriteReference(reinterpret_cast<const uint8_t *>(value.data()), value.size());
+    } else {
+      WriteRAW(value.data(), value.size());
+    }
   }
 
   void WriteList(const std::vector<Value> &value) {
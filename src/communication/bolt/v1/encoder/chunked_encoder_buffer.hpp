@@ -11,12 +11,19 @@
 
 #pragma once
 
+#include <sys/uio.h>
+
 #include <algorithm>
+#include <array>
+#include <concepts>
 #include <cstring>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "communication/bolt/v1/constants.hpp"
+#include "utils/compressor.hpp"
+#include "utils/logging.hpp"
 
 namespace memgraph::communication::bolt {
 
@@ -40,87 +47,269 @@ namespace memgraph::communication::bolt {
  * can control when the message is over and the whole message isn't
  * unnecessarily buffered in memory.
  *
- * The current implementation stores only a single chunk into memory and sends
- * it immediately to the output stream when new data arrives.
+ * Flushing with `have_more` keeps the chunk in the buffer, so that several
+ * chunks and messages are sent to the output stream at once. Chunks are sent
+ * when a flush tells that no more data follows, when `kMaxBufferedSize` bytes
+ * are buffered, and on every flush after data was written by reference. If
+ * the output stream has a `Write(std::span<const iovec>, bool)` method, the
+ * chunks are sent with it in a single call, otherwise piece by piece.
+ *
+ * While the buffer is held, every flush keeps the chunks as if `have_more`
+ * was given. The responses to several messages are then sent together when
+ * the buffer is released.
+ *
+ * Once compression is enabled, everything sent afterwards is a single zlib
+ * stream, which is flushed whenever the chunks are sent without `have_more`.
  *
  * @tparam TOutputStream the output stream that should be used
  */
 template <class TOutputStream>
 class ChunkedEncoderBuffer {
  public:
-  ChunkedEncoderBuffer(TOutputStream &output_stream) : output_stream_(output_stream) {}
+  /// Data which is written by reference is only referenced if it's at least
+  /// this large, since referencing makes the next flush send the buffer.
+  static constexpr size_t kMinReferencedSize = 4096;
+  /// Chunks are sent once this much data is buffered, even if more will follow.
+  static constexpr size_t kMaxBufferedSize = 4 * kChunkWholeSize;
+
+  ChunkedEncoderBuffer(TOutputStream &output_stream) : output_stream_(output_stream) { OpenChunk(); }
 
   /**
    * Writes n values into the buffer. If n is bigger than whole chunk size
-   * values are automatically chunked and sent to the output buffer.
+   * values are automatically chunked.
    *
    * @param values data array of bytes
    * @param n is the number of bytes
    */
   void Write(const uint8_t *values, size_t n) {
-    size_t written = 0;
-
     while (n > 0) {
       // Define the number of bytes which will be copied into the chunk because
-      // the internal storage is a fixed length array.
-      size_t size = n < kChunkMaxDataSize - have_ ? n : kChunkMaxDataSize - have_;
-
-      // Copy `size` values to the chunk array.
-      std::memcpy(chunk_.data() + kChunkHeaderSize + have_, values + written, size);
-
-      // Update positions. The position pointer and incoming size have to be
-      // updated because all incoming values have to be processed.
-      written += size;
+      // the size of a chunk is limited.
+      size_t size = std::min(n, kChunkMaxDataSize - have_);
+      AppendOwned(values, size);
+      values += size;
       have_ += size;
       n -= size;
+      if (have_ == kChunkMaxDataSize) NextChunk();
+    }
+  }
 
-      // If the chunk is full, send it to the output stream and clear the
-      // internal storage to make space for other incoming values that are left
-      // in the values array.
-      if (have_ == kChunkMaxDataSize) Flush(true);
+  /**
+   * Writes n values into the buffer like `Write` does, but if there are enough
+   * of them they are sent from where they are instead of being copied. The
+   * values then have to stay valid until the next `Flush`.
+   *
+   * @param values data array of bytes
+   * @param n is the number of bytes
+   */
+  void WriteReference(const uint8_t *values, size_t n) {
+    if (n < kMinReferencedSize) return Write(values, n);
+    while (n > 0) {
+      size_t size = std::min(n, kChunkMaxDataSize - have_);
+      segments_.push_back(Segment{.data = values, .offset = 0, .size = size});
+      has_references_ = true;
+      values += size;
+      have_ += size;
+      n -= size;
+      if (have_ == kChunkMaxDataSize) NextChunk();
     }
   }
 
   /**
-   * Wrap the data from the chunk array (append the size header) and send
-   * the whole chunk into the output stream.
+   * Wrap the data from the chunk (append the size header) and send the
+   * buffered chunks into the output stream, unless they are kept in the
+   * buffer until more data has been written.
    *
    * @param have_more this parameter is passed to the underlying output stream
    *                  `Write` method to indicate wether we have more data
    *                  waiting to be sent (in order to optimize network packets)
+   * @returns false if sending the chunks failed
    */
   bool Flush(bool have_more = false) {
-    // Write the size of the chunk.
-    chunk_[0] = have_ >> 8;
-    chunk_[1] = have_ & 0xFF;
+    CloseChunk();
+    have_more = have_more || held_;
+    bool ret = true;
+    if (!have_more || has_references_ || buffer_.size() >= kMaxBufferedSize) ret = Send(have_more);
+    flushed_segments_ = segments_.size();
+    flushed_size_ = buffer_.size();
+    OpenChunk();
+    return ret;
+  }
 
-    // Write the data to the stream.
-    auto ret = output_stream_.Write(chunk_.data(), kChunkHeaderSize + have_, have_more);
+  /** Keeps the flushed chunks in the buffer until `Release` is called. */
+  void Hold() { held_ = true; }
 
-    // Cleanup.
-    Clear();
+  /**
+   * Stops holding the buffer and sends the flushed chunks to the output
+   * stream. The data written since the last flush is sent by the next flush.
+   *
+   * @returns false if sending the chunks failed
+   */
+  bool Release() {
+    held_ = false;
+    if (flushed_segments_ == 0 || HasData()) return true;
+    return SendFlushed(false);
+  }
 
+  /**
+   * Compresses all the data sent after the chunks which were already flushed.
+   * Has to be called right after a flush.
+   *
+   * @returns false if sending the flushed chunks failed
+   */
+  bool EnableCompression() {
+    DMG_ASSERT(!HasData(), "Compression can only be enabled after a flush");
+    const bool ret = flushed_segments_ == 0 || SendFlushed(true);
+    compressor_ = std::make_unique<utils::StreamCompressor>();
     return ret;
   }
 
-  /** Clears the internal buffers. */
-  void Clear() { have_ = 0; }
+  bool IsCompressed() const { return compressor_ != nullptr; }
+
+  /** Clears the data written since the last flush. */
+  void Clear() {
+    segments_.resize(flushed_segments_);
+    buffer_.resize(flushed_size_);
+    has_references_ = std::any_of(segments_.begin(), segments_.end(), [](const auto &s) { return s.data; });
+    OpenChunk();
+  }
 
   /**
-   * Returns a boolean indicating whether there is data in the buffer.
+   * Returns a boolean indicating whether there is data in the current chunk.
    * @returns true if there is data in the buffer,
    *          false otherwise
    */
   bool HasData() { return have_ > 0; }
 
  private:
+  /// Part of the buffered chunks, which is either referenced data or `size`
+  /// bytes at `offset` in `buffer_`.
+  struct Segment {
+    const uint8_t *data;
+    size_t offset;
+    size_t size;
+  };
+
+  void AppendOwned(const uint8_t *values, size_t n) {
+    if (segments_.empty() || segments_.back().data) {
+      segments_.push_back(Segment{.data = nullptr, .offset = buffer_.size(), .size = 0});
+    }
+    buffer_.insert(buffer_.end(), values, values + n);
+    segments_.back().size += n;
+  }
+
+  void OpenChunk() {
+    chunk_header_ = buffer_.size();
+    have_ = 0;
+    // The header is written when the chunk is closed.
+    const std::array<uint8_t, kChunkHeaderSize> header{};
+    segments_.push_back(Segment{.data = nullptr, .offset = buffer_.size(), .size = 0});
+    AppendOwned(header.data(), header.size());
+  }
+
+  void CloseChunk() {
+    // Write the size of the chunk.
+    buffer_[chunk_header_] = have_ >> 8;
+    buffer_[chunk_header_ + 1] = have_ & 0xFF;
+  }
+
+  /// Closes the full chunk and opens the next one.
+  void NextChunk() {
+    CloseChunk();
+    if (has_references_ || buffer_.size() >= kMaxBufferedSize) {
+      // The chunks of the unfinished message can't be cleared anymore.
+      Send(true);
+      flushed_segments_ = 0;
+      flushed_size_ = 0;
+    }
+    OpenChunk();
+  }
+
+  /// Sends the flushed chunks and drops the header of the empty current chunk,
+  /// which is sent with the next message.
+  bool SendFlushed(bool have_more) {
+    segments_.resize(flushed_segments_);
+    buffer_.resize(flushed_size_);
+    const bool ret = Send(have_more);
+    flushed_segments_ = 0;
+    flushed_size_ = 0;
+    OpenChunk();
+    return ret;
+  }
+
+  /// Replaces the data to send with its compressed version, which is flushed
+  /// if no more data follows.
+  bool Compress(bool have_more) {
+    compressed_.clear();
+    for (size_t i = 0; i < iovecs_.size(); ++i) {
+      const bool flush = !have_more && i + 1 == iovecs_.size();
+      if (!compressor_->Compress(static_cast<const uint8_t *>(iovecs_[i].iov_base), iovecs_[i].iov_len, flush,
+                                 compressed_)) {
+        return false;
+      }
+    }
+    // The data compressed by earlier sends still has to be flushed.
+    if (iovecs_.empty() && !have_more && !compressor_->Compress(nullptr, 0, true, compressed_)) return false;
+    iovecs_.clear();
+    if (!compressed_.empty()) iovecs_.push_back(iovec{.iov_base = compressed_.data(), .iov_len = compressed_.size()});
+    return true;
+  }
+
+  /// Sends all the closed chunks and clears the buffer.
+  bool Send(bool have_more) {
+    iovecs_.clear();
+    for (const auto &segment : segments_) {
+      if (segment.size == 0) continue;
+      auto *base = const_cast<uint8_t *>(segment.data ? segment.data : buffer_.data() + segment.offset);
+      // Adjacent parts of the buffer are sent as one.
+      if (!iovecs_.empty() && static_cast<uint8_t *>(iovecs_.back().iov_base) + iovecs_.back().iov_len == base) {
+        iovecs_.back().iov_len += segment.size;
+      } else {
+        iovecs_.push_back(iovec{.iov_base = base, .iov_len = segment.size});
+      }
+    }
+    bool ret = true;
+    if (compressor_ && !Compress(have_more)) {
+      iovecs_.clear();
+      ret = false;
+    }
+    if constexpr (requires(std::span<const iovec> buffers) {
+                    { output_stream_.Write(buffers, have_more) } -> std::same_as<bool>;
+                  }) {
+      if (!iovecs_.empty()) ret = output_stream_.Write(std::span<const iovec>(iovecs_), have_more);
+    } else {
+      for (size_t i = 0; i < iovecs_.size() && ret; ++i) {
+        ret = output_stream_.Write(static_cast<const uint8_t *>(iovecs_[i].iov_base), iovecs_[i].iov_len,
+                                   have_more || i + 1 < iovecs_.size());
+      }
+    }
+    segments_.clear();
+    buffer_.clear();
+    has_references_ = false;
+    return ret;
+  }
+
   // The output stream used.
   TOutputStream &output_stream_;
 
-  // Buffer for a single chunk.
-  std::array<uint8_t, kChunkWholeSize> chunk_;
+  // Closed chunks followed by the current chunk, whose header starts at
+  // `chunk_header_`. Only the data which isn't referenced is in `buffer_`.
+  std::vector<uint8_t> buffer_;
+  std::vector<Segment> segments_;
+  std::vector<iovec> iovecs_;
+  size_t chunk_header_{0};
+  bool has_references_{false};
+  bool held_{false};
+
+  // Set once compression is enabled, with the output of the last send.
+  std::unique_ptr<utils::StreamCompressor> compressor_;
+  std::vector<uint8_t> compressed_;
 
-  // Amount of data in chunk array.
+  // Amount of data in the current chunk.
   size_t have_{0};
+
+  // Size of the buffer at the last flush, which `Clear` returns to.
+  size_t flushed_segments_{0};
+  size_t flushed_size_{0};
 };
 }  // namespace memgraph::communication::bolt
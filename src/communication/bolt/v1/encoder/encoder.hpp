@@ -60,6 +60,27 @@ class Encoder : private BaseEncoder<Buffer> {
     return buffer_.Flush(true);
   }
 
+  /**
+   * Sends a Record message whose list of fields is already encoded. Large
+   * records are sent from the given memory instead of being copied, if the
+   * buffer supports it.
+   *
+   * @param fields the encoded list of fields
+   * @param size the number of bytes of the encoded fields
+   */
+  bool MessageRecord(const uint8_t *fields, size_t size) {
+    WriteRAW(utils::UnderlyingCast(Marker::TinyStruct1));
+    WriteRAW(utils::UnderlyingCast(Signature::Record));
+    if constexpr (requires { buffer_.WriteReference(fields, size); }) {
+      buffer_.WriteReference(fields, size);
+    } else {
+      WriteRAW(fields, size);
+    }
+    // The record is followed by another message, like in the overload above.
+    if (!buffer_.Flush(true)) return false;
+    return buffer_.Flush(true);
+  }
+
   /**
    * Sends a Success message.
    *
@@ -107,7 +107,8 @@ class Session : public dbms::SessionInterface {
   virtual std::map<std::string, Value> Discard(std::optional<int> n, std::optional<int> qid) = 0;
 
   virtual void BeginTransaction(const std::map<std::string, memgraph::communication::bolt::Value> &params) = 0;
-  virtual void CommitTransaction() = 0;
+  /** Return the metadata of the COMMIT success message, e.g. the bookmark. */
+  virtual std::map<std::string, Value> CommitTransaction() = 0;
   virtual void RollbackTransaction() = 0;
 
   /** Aborts currently running query. */
@@ -119,6 +120,10 @@ class Session : public dbms::SessionInterface {
   /** Return the name of the server that should be used for the Bolt INIT
    * message. */
   virtual std::optional<std::string> GetServerNameForInit() = 0;
+
+  /** Return `true` if the client may request compression of the messages it
+   * receives. */
+  virtual bool IsCompressionAllowed() = 0;
   /**
    * Executes the session after data has been read into the buffer.
    * Goes through the bolt states in order to execute commands from the client.
@@ -145,6 +150,50 @@ class Session : public dbms::SessionInterface {
       encoder_.UpdateVersion(version_.major);
     }
 
+    // Drivers pipeline several messages, like BEGIN, RUN, PULL and COMMIT,
+    // without waiting for the responses. All the messages which were received
+    // are executed one after another and their responses are sent at once.
+    encoder_buffer_.Hold();
+    try {
+      ExecuteMessages();
+    } catch (...) {
+      // The responses, e.g. the failure before the connection is closed, are
+      // still sent.
+      encoder_buffer_.Release();
+      throw;
+    }
+    if (UNLIKELY(!encoder_buffer_.Release())) {
+      spdlog::trace("Couldn't send the responses to the client!");
+      ClientFailureInvalidData();
+    }
+  }
+
+  // TODO: Rethink if there is a way to hide some members. At the momement all of them are public.
+  TInputStream &input_stream_;
+  TOutputStream &output_stream_;
+
+  ChunkedEncoderBuffer<TOutputStream> encoder_buffer_{output_stream_};
+  TEncoder encoder_{encoder_buffer_};
+
+  ChunkedDecoderBuffer<TInputStream> decoder_buffer_{input_stream_};
+  Decoder<ChunkedDecoderBuffer<TInputStream>> decoder_{decoder_buffer_};
+
+  bool handshake_done_{false};
+  State state_{State::Handshake};
+
+  struct Version {
+    uint8_t major;
+    uint8_t minor;
+  };
+
+  Version version_;
+
+  std::string GetDatabaseName() const override = 0;
+  std::string UUID() const final { return session_uuid_; }
+
+ private:
+  /** Executes all the whole messages in the input buffer. */
+  void ExecuteMessages() {
     ChunkState chunk_state;
     while ((chunk_state = decoder_buffer_.GetChunk()) != ChunkState::Partial) {
       if (chunk_state == ChunkState::Whole) {
@@ -165,7 +214,7 @@ class Session : public dbms::SessionInterface {
           state_ = StateErrorRun(*this, state_);
           break;
         default:
-          // State::Handshake is handled above
+          // State::Handshake is handled in Execute
           // State::Close is handled below
           break;
       }
@@ -180,30 +229,6 @@ class Session : public dbms::SessionInterface {
     }
   }
 
-  // TODO: Rethink if there is a way to hide some members. At the momement all of them are public.
-  TInputStream &input_stream_;
-  TOutputStream &output_stream_;
-
-  ChunkedEncoderBuffer<TOutputStream> encoder_buffer_{output_stream_};
-  TEncoder encoder_{encoder_buffer_};
-
-  ChunkedDecoderBuffer<TInputStream> decoder_buffer_{input_stream_};
-  Decoder<ChunkedDecoderBuffer<TInputStream>> decoder_{decoder_buffer_};
-
-  bool handshake_done_{false};
-  State state_{State::Handshake};
-
-  struct Version {
-    uint8_t major;
-    uint8_t minor;
-  };
-
-  Version version_;
-
-  std::string GetDatabaseName() const override = 0;
-  std::string UUID() const final { return session_uuid_; }
-
- private:
   void ClientFailureInvalidData() {
     // Set the state to Close.
     state_ = State::Close;
@@ -412,11 +412,11 @@ State HandleCommit(TSession &session, const State state, const Marker marker) {
   DMG_ASSERT(!session.encoder_buffer_.HasData(), "There should be no data to write in this state");
 
   try {
-    if (!session.encoder_.MessageSuccess({})) {
+    const auto metadata = session.CommitTransaction();
+    if (!session.encoder_.MessageSuccess(metadata)) {
       spdlog::trace("Couldn't send success message!");
       return State::Close;
     }
-    session.CommitTransaction();
     return State::Idle;
   } catch (const std::exception &e) {
     return HandleFailure(session, e);
@@ -166,8 +166,22 @@ std::optional<Value> GetAuthDataV5(TSession &session, const Marker marker) {
   return metadata;
 }
 
+/// Returns true if the client requested compression in the HELLO metadata and
+/// the server allows it.
 template <typename TSession>
-State SendSuccessMessage(TSession &session) {
+bool NegotiateCompression(TSession &session, const Value &metadata) {
+  const auto &data = metadata.ValueMap();
+  const auto compression = data.find("compression");
+  if (compression == data.end()) return false;
+  if (!compression->second.IsString() || compression->second.ValueString() != kCompressionZlib) {
+    spdlog::warn("The client requested an unsupported compression, the messages won't be compressed.");
+    return false;
+  }
+  return session.IsCompressionAllowed();
+}
+
+template <typename TSession>
+State SendSuccessMessage(TSession &session, bool compression = false) {
   // Neo4j's Java driver 4.1.1+ requires connection_id.
   // The only usage in the mentioned version is for logging purposes.
   // Because it's not critical for the regular usage of the driver
@@ -176,11 +190,19 @@ State SendSuccessMessage(TSession &session) {
   if (auto server_name = session.GetServerNameForInit(); server_name) {
     metadata.insert({"server", *server_name});
   }
+  if (compression) {
+    metadata.insert({"compression", kCompressionZlib});
+  }
   bool success_sent = session.encoder_.MessageSuccess(metadata);
   if (!success_sent) {
     spdlog::trace("Couldn't send success message to the client!");
     return State::Close;
   }
+  // Only the messages after the success message are compressed.
+  if (compression && !session.encoder_buffer_.EnableCompression()) {
+    spdlog::trace("Couldn't send success message to the client!");
+    return State::Close;
+  }
 
   return State::Idle;
 }
@@ -223,11 +245,12 @@ State StateInitRunV4(TSession &session, Marker marker, Signature signature) {
   if (!maybeMetadata) {
     return State::Close;
   }
+  const bool compression = NegotiateCompression(session, *maybeMetadata);
   if (auto result = AuthenticateUser(session, *maybeMetadata)) {
     return result.value();
   }
 
-  return SendSuccessMessage(session);
+  return SendSuccessMessage(session, compression);
 }
 
 template <typename TSession>
@@ -244,7 +267,7 @@ State StateInitRunV5(TSession &session, Marker marker, Signature signature) {
       return State::Close;
     }
 
-    if (SendSuccessMessage(session) == State::Close) {
+    if (SendSuccessMessage(session, NegotiateCompression(session, *maybeMetadata)) == State::Close) {
       return State::Close;
     }
     // Stay in Init
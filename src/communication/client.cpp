@@ -11,6 +11,11 @@
 
 #include "communication/client.hpp"
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+
 #include "communication/helpers.hpp"
 #include "utils/logging.hpp"
 
@@ -209,6 +214,34 @@ bool Client::Write(const std::string &str, bool have_more) {
   return Write(reinterpret_cast<const uint8_t *>(str.data()), str.size(), have_more);
 }
 
+bool Client::WriteFile(int fd, uint64_t offset, size_t len) {
+  if (!ssl_) return socket_.WriteFile(fd, offset, len);
+
+  // OpenSSL has to encrypt the data in user space, the data is written in
+  // chunks of the size of the largest TLS record.
+  constexpr size_t kChunkSize = 16384;
+  uint8_t buffer[kChunkSize];
+  while (len > 0) {
+    auto bytes_read = pread(fd, buffer, std::min(len, kChunkSize), static_cast<off_t>(offset));
+    if (bytes_read == -1 && errno == EINTR) continue;
+    if (bytes_read <= 0) return false;
+    if (!Write(buffer, bytes_read, true)) return false;
+    len -= bytes_read;
+    offset += bytes_read;
+  }
+  return true;
+}
+
+bool Client::WriteVector(const iovec *iov, size_t iovcnt, bool have_more) {
+  if (!ssl_) return socket_.WriteVector(iov, iovcnt, have_more);
+  for (size_t i = 0; i < iovcnt; ++i) {
+    if (!Write(static_cast<const uint8_t *>(iov[i].iov_base), iov[i].iov_len, have_more || i + 1 < iovcnt)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 const io::network::Endpoint &Client::endpoint() { return socket_.endpoint(); }
 
 void Client::ReleaseSslObjects() {
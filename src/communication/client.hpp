@@ -110,6 +110,21 @@ class Client final {
    */
   bool Write(const std::string &str, bool have_more = false);
 
+  /**
+   * This function writes `len` bytes of the file descriptor, starting at
+   * `offset`, to the socket. The data is sent by the kernel with `sendfile`
+   * unless the connection is encrypted, in which case it's read and written
+   * using OpenSSL.
+   */
+  bool WriteFile(int fd, uint64_t offset, size_t len);
+
+  /**
+   * This function writes a list of buffers to the socket. Without encryption
+   * they are written with a single `sendmsg` call where possible, otherwise
+   * each of them is written using OpenSSL.
+   */
+  bool WriteVector(const iovec *iov, size_t iovcnt, bool have_more = false);
+
   const io::network::Endpoint &endpoint();
 
  private:
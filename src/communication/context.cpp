@@ -18,6 +18,12 @@
 
 namespace memgraph::communication {
 
+namespace {
+// The sessions of a server can only be resumed by the same server, and
+// OpenSSL refuses to resume sessions with verified clients without it.
+constexpr std::string_view kSessionIdContext = "memgraph";
+}  // namespace
+
 ClientContext::ClientContext(bool use_ssl) : use_ssl_(use_ssl), ctx_(nullptr) {
   if (use_ssl_) {
 #if OPENSSL_VERSION_NUMBER < 0x10100000L
@@ -95,6 +101,11 @@ ServerContext::ServerContext(const std::string &key_file, const std::string &cer
   ctx_->set_options(SSL_OP_NO_SSLv3, ec);
   MG_ASSERT(!ec, "Setting options to SSL context failed!");
 
+  MG_ASSERT(SSL_CTX_set_session_id_context(ctx_->native_handle(),
+                                           reinterpret_cast<const unsigned char *>(kSessionIdContext.data()),
+                                           kSessionIdContext.size()) == 1,
+            "Setting the SSL session id context failed!");
+
   if (!ca_file.empty()) {
     // Load the certificate authority file.
     boost::system::error_code ec;
@@ -138,4 +149,29 @@ boost::asio::ssl::context &ServerContext::context_clone() {
 
 bool ServerContext::use_ssl() const { return ctx_.has_value(); }
 
+void ServerContext::SetSessionResumption(const std::chrono::seconds timeout) {
+  auto *ctx = context();
+  if (timeout.count() <= 0) {
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+    SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+    // TLS 1.3 sends the tickets after the handshake.
+    SSL_CTX_set_num_tickets(ctx, 0);
+#endif
+    return;
+  }
+  SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER);
+  SSL_CTX_clear_options(ctx, SSL_OP_NO_TICKET);
+  SSL_CTX_set_timeout(ctx, static_cast<long>(timeout.count()));
+}
+
+bool ServerContext::EnableKernelTLS() {
+#ifdef SSL_OP_ENABLE_KTLS
+  SSL_CTX_set_options(context(), SSL_OP_ENABLE_KTLS);
+  return true;
+#else
+  return false;
+#endif
+}
+
 }  // namespace memgraph::communication
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <optional>
 #include <string>
 
@@ -100,6 +101,22 @@ class ServerContext final {
 
   bool use_ssl() const;
 
+  /**
+   * Lets the clients resume their sessions for `timeout` after the full
+   * handshake, either with a session ticket or from the session cache. The
+   * resumed handshakes skip the key exchange and the certificate
+   * verification. A zero `timeout` disables resumption.
+   */
+  void SetSessionResumption(std::chrono::seconds timeout);
+
+  /**
+   * Lets OpenSSL hand the encryption of established connections over to the
+   * kernel (kTLS), if the kernel supports the negotiated cipher.
+   *
+   * @returns false if the OpenSSL library doesn't support kTLS
+   */
+  bool EnableKernelTLS();
+
  private:
   std::optional<boost::asio::ssl::context> ctx_;
 };
@@ -0,0 +1,161 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "utils/logging.hpp"
+#include "utils/thread.hpp"
+
+namespace memgraph::communication::v2 {
+
+/**
+ * Threads which execute the messages received by the sessions, so that the
+ * threads of the `IOContextThreadPool` only do the network I/O and a long
+ * query doesn't keep the other sessions from being read.
+ *
+ * Executions are scheduled as short or long depending on how long the
+ * previous execution of the session took. Short executions are started
+ * before the long ones, and the long ones run on at most `max_long_workers`
+ * threads at once, which keeps the remaining threads free for short queries.
+ *
+ * If `pin_to_numa_nodes` is set, the threads are pinned to the NUMA nodes in
+ * turns, so they are spread evenly over the sockets and each one runs on a
+ * single socket.
+ */
+class ExecutionPool final {
+ public:
+  enum class Priority : uint8_t { SHORT, LONG };
+
+  ExecutionPool(size_t pool_size, std::chrono::milliseconds long_execution_threshold,
+                bool pin_to_numa_nodes = false)
+      : pool_size_{pool_size},
+        // A quarter of the threads, but at least one, is reserved for short
+        // executions if there are two threads or more.
+        max_long_workers_{std::max<size_t>(pool_size - std::max<size_t>(pool_size / 4, 1), 1)},
+        long_execution_threshold_{long_execution_threshold},
+        pin_to_numa_nodes_{pin_to_numa_nodes} {
+    MG_ASSERT(pool_size != 0, "Pool size must be greater then 0!");
+  }
+
+  ExecutionPool(const ExecutionPool &) = delete;
+  ExecutionPool &operator=(const ExecutionPool &) = delete;
+  ExecutionPool(ExecutionPool &&) = delete;
+  ExecutionPool &operator=(ExecutionPool &&) = delete;
+  ~ExecutionPool() {
+    Shutdown();
+    AwaitShutdown();
+  }
+
+  void Run() {
+    workers_.reserve(pool_size_);
+    for (size_t i = 0; i < pool_size_; ++i) {
+      workers_.emplace_back([this, i] {
+        if (pin_to_numa_nodes_ && !utils::ThreadPinToNumaNode(i)) {
+          spdlog::warn("Couldn't pin the execution thread {} to a NUMA node.", i);
+        }
+        ThreadLoop();
+      });
+    }
+    running_ = true;
+  }
+
+  /// Stops the threads once they finish their current executions. The
+  /// executions which haven't started yet are dropped.
+  void Shutdown() {
+    {
+      std::lock_guard lock(mutex_);
+      stopped_ = true;
+      short_tasks_.clear();
+      long_tasks_.clear();
+    }
+    cv_.notify_all();
+    running_ = false;
+  }
+
+  void AwaitShutdown() { workers_.clear(); }
+
+  bool IsRunning() const noexcept { return running_; }
+
+  void Schedule(Priority priority, std::function<void()> task) {
+    {
+      std::lock_guard lock(mutex_);
+      if (stopped_) return;
+      (priority == Priority::SHORT ? short_tasks_ : long_tasks_).push_back(std::move(task));
+    }
+    cv_.notify_one();
+  }
+
+  /// Returns the priority of the next execution of a session whose previous
+  /// execution took `elapsed`.
+  template <typename TDuration>
+  Priority PriorityOf(TDuration elapsed) const {
+    return elapsed >= long_execution_threshold_ ? Priority::LONG : Priority::SHORT;
+  }
+
+  size_t MaxLongWorkers() const { return max_long_workers_; }
+
+ private:
+  void ThreadLoop() {
+    while (true) {
+      std::function<void()> task;
+      bool is_long = false;
+      {
+        std::unique_lock lock(mutex_);
+        cv_.wait(lock, [this] {
+          return stopped_ || !short_tasks_.empty() || (!long_tasks_.empty() && running_long_ < max_long_workers_);
+        });
+        if (stopped_) return;
+        auto &tasks = short_tasks_.empty() ? long_tasks_ : short_tasks_;
+        is_long = short_tasks_.empty();
+        task = std::move(tasks.front());
+        tasks.pop_front();
+        if (is_long) ++running_long_;
+      }
+      task();
+      if (is_long) {
+        {
+          std::lock_guard lock(mutex_);
+          --running_long_;
+        }
+        // A waiting long execution can take the freed slot.
+        cv_.notify_all();
+      }
+    }
+  }
+
+  const size_t pool_size_;
+  const size_t max_long_workers_;
+  const std::chrono::milliseconds long_execution_threshold_;
+  const bool pin_to_numa_nodes_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> short_tasks_;
+  std::deque<std::function<void()>> long_tasks_;
+  size_t running_long_{0};
+  bool stopped_{false};
+
+  std::vector<std::jthread> workers_;
+  bool running_{false};
+};
+
+}  // namespace memgraph::communication::v2
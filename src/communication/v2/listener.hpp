@@ -28,6 +28,7 @@
 #include <boost/system/detail/error_code.hpp>
 
 #include "communication/context.hpp"
+#include "communication/v2/execution_pool.hpp"
 #include "communication/v2/pool.hpp"
 #include "communication/v2/session.hpp"
 #include "utils/message.hpp"
@@ -58,12 +59,22 @@ class Listener final : public std::enable_shared_from_this<Listener<TSession, TS
 
   bool IsRunning() const noexcept { return alive_.load(std::memory_order_relaxed); }
 
+  /// The endpoint the listener is bound to, which has the actual port if the
+  /// listener was bound to port 0.
+  tcp::endpoint LocalEndpoint() const {
+    boost::system::error_code ec;
+    auto endpoint = acceptor_.local_endpoint(ec);
+    return ec ? endpoint_ : endpoint;
+  }
+
  private:
   Listener(boost::asio::io_context &io_context, TSessionContext *session_context, ServerContext *server_context,
-           tcp::endpoint &endpoint, const std::string_view service_name, const uint64_t inactivity_timeout_sec)
+           ExecutionPool &execution_pool, tcp::endpoint &endpoint, const std::string_view service_name,
+           const uint64_t inactivity_timeout_sec, const bool reuse_port)
       : io_context_(io_context),
         session_context_(session_context),
         server_context_(server_context),
+        execution_pool_(execution_pool),
         acceptor_(io_context_),
         endpoint_{endpoint},
         service_name_{service_name},
@@ -83,6 +94,16 @@ class Listener final : public std::enable_shared_from_this<Listener<TSession, TS
       return;
     }
 
+    // Several listeners, one for each io_context, can be bound to the same
+    // endpoint. The kernel then spreads the incoming connections over them.
+    if (reuse_port) {
+      acceptor_.set_option(boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true), ec);
+      if (ec) {
+        OnError(ec, "set_option");
+        return;
+      }
+    }
+
     // Bind to the server address
     acceptor_.bind(endpoint, ec);
     if (ec) {
@@ -111,8 +132,8 @@ class Listener final : public std::enable_shared_from_this<Listener<TSession, TS
       return OnError(ec, "accept");
     }
 
-    auto session = SessionHandler::Create(std::move(socket), session_context_, *server_context_, endpoint_,
-                                          inactivity_timeout_, service_name_);
+    auto session = SessionHandler::Create(std::move(socket), session_context_, *server_context_, execution_pool_,
+                                          endpoint_, inactivity_timeout_, service_name_);
     session->Start();
     DoAccept();
   }
@@ -125,6 +146,7 @@ class Listener final : public std::enable_shared_from_this<Listener<TSession, TS
   boost::asio::io_context &io_context_;
   TSessionContext *session_context_;
   ServerContext *server_context_;
+  ExecutionPool &execution_pool_;
   tcp::acceptor acceptor_;
 
   tcp::endpoint endpoint_;
@@ -11,7 +11,12 @@
 
 #pragma once
 
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
 #include <cstddef>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -22,14 +27,30 @@
 
 namespace memgraph::communication::v2 {
 
+/**
+ * Threads which run the handlers of io_contexts.
+ *
+ * By default all the threads share one io_context. With an io_context per
+ * thread, each thread runs its own io_context and is pinned to its own core,
+ * so that everything dispatched on an io_context stays on one core.
+ */
 class IOContextThreadPool final {
  private:
   using IOContext = boost::asio::io_context;
   using IOContextGuard = boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
 
+  struct Context {
+    IOContext io_context;
+    IOContextGuard guard{io_context.get_executor()};
+  };
+
  public:
-  explicit IOContextThreadPool(size_t pool_size) : guard_{io_context_.get_executor()}, pool_size_{pool_size} {
+  explicit IOContextThreadPool(size_t pool_size, bool io_context_per_thread = false)
+      : pool_size_{pool_size}, io_context_per_thread_{io_context_per_thread} {
     MG_ASSERT(pool_size != 0, "Pool size must be greater then 0!");
+    const auto contexts_count = io_context_per_thread ? pool_size : 1;
+    contexts_.reserve(contexts_count);
+    for (size_t i = 0; i < contexts_count; ++i) contexts_.push_back(std::make_unique<Context>());
   }
 
   IOContextThreadPool(const IOContextThreadPool &) = delete;
@@ -41,13 +62,15 @@ class IOContextThreadPool final {
   void Run() {
     background_threads_.reserve(pool_size_);
     for (size_t i = 0; i < pool_size_; ++i) {
-      background_threads_.emplace_back([this]() { io_context_.run(); });
+      auto &io_context = contexts_[i % contexts_.size()]->io_context;
+      background_threads_.emplace_back([&io_context]() { io_context.run(); });
+      if (io_context_per_thread_) PinToCore(background_threads_.back(), i);
     }
     running_ = true;
   }
 
   void Shutdown() {
-    io_context_.stop();
+    for (auto &context : contexts_) context->io_context.stop();
     running_ = false;
   }
 
@@ -55,13 +78,26 @@ class IOContextThreadPool final {
 
   bool IsRunning() const noexcept { return running_; }
 
-  IOContext &GetIOContext() noexcept { return io_context_; }
+  /// Number of io_contexts, which is the pool size if each thread has its own.
+  size_t IOContextsCount() const noexcept { return contexts_.size(); }
+
+  IOContext &GetIOContext(size_t index = 0) noexcept { return contexts_[index]->io_context; }
 
  private:
+  static void PinToCore(std::jthread &thread, size_t index) {
+    const auto cores = std::max(std::thread::hardware_concurrency(), 1U);
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(index % cores, &cpu_set);
+    if (pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set) != 0) {
+      spdlog::warn("Couldn't pin the I/O thread {} to a core.", index);
+    }
+  }
+
   /// The pool of io_context.
-  IOContext io_context_;
-  IOContextGuard guard_;
+  std::vector<std::unique_ptr<Context>> contexts_;
   size_t pool_size_;
+  bool io_context_per_thread_;
   std::vector<std::jthread> background_threads_;
   bool running_{false};
 };
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <iostream>
 #include <memory>
@@ -27,6 +28,7 @@
 
 #include "communication/context.hpp"
 #include "communication/init.hpp"
+#include "communication/v2/execution_pool.hpp"
 #include "communication/v2/listener.hpp"
 #include "communication/v2/pool.hpp"
 #include "utils/logging.hpp"
@@ -42,19 +44,25 @@ using ServerEndpoint = boost::asio::ip::tcp::endpoint;
  *
  * Listens for incoming connections on the server port and assigns them to the
  * connection listener. The listener and session are implemented using asio
- * async model. Currently the implemented model is thread per core model
- * opposed to io_context per core. The reasoning for opting for the former model
- * is the robustness to the multiple resource demanding queries that can be split
- * across multiple threads, and then a single thread would not block io_context,
- * unlike in the latter model where it is possible that thread that accepts
- * request is being blocked by demanding query.
- * All logic is contained within handlers that are being dispatched
- * on a single strand per session. The only exception is write which is
- * synchronous since the nature of the clients conenction is synchronous as
- * well.
+ * async model. The network I/O runs on a pool of threads sharing one
+ * io_context, while the received messages are executed on a separate
+ * `ExecutionPool`, so that a demanding query doesn't keep the I/O threads
+ * from accepting connections and reading from the other sessions. Sessions
+ * which executed long before are scheduled after the short ones and can't
+ * take all of the execution threads.
+ * All network logic is contained within handlers that are being dispatched
+ * on a single strand per session. Once a message is executed, the session is
+ * handed back to its strand. The only exception is write which is
+ * synchronous and done by the execution thread, since the nature of the
+ * clients conenction is synchronous as well.
+ *
+ * With an I/O thread per core, each I/O thread runs its own io_context and
+ * has its own listener. The listeners share the endpoint through
+ * SO_REUSEPORT, so the kernel spreads the connections over them, and a
+ * session is handled on the core which accepted it for its whole lifetime.
  *
  * Current Server architecture:
- * incoming connection -> server -> listener -> session
+ * incoming connection -> server -> listener -> session -> execution pool
 
  *
  * @tparam TSession the server can handle different Sessions, each session
@@ -70,11 +78,19 @@ class Server final {
  public:
   /**
    * Constructs and binds server to endpoint, operates on session data and
-   * invokes workers_count workers
+   * invokes workers_count workers which execute the messages and
+   * io_workers_count workers which do the network I/O. Sessions whose message
+   * took at least long_execution_threshold to execute are scheduled as long.
+   * If io_thread_per_core is set, each I/O worker has its own io_context and
+   * listener and is pinned to its own core. If pin_workers_to_numa_nodes is
+   * set, the workers which execute the messages are pinned to the NUMA nodes
+   * in turns.
    */
   Server(ServerEndpoint &endpoint, TSessionContext *session_context, ServerContext *server_context,
          int inactivity_timeout_sec, std::string_view service_name,
-         size_t workers_count = std::thread::hardware_concurrency());
+         size_t workers_count = std::thread::hardware_concurrency(), size_t io_workers_count = 1,
+         std::chrono::milliseconds long_execution_threshold = std::chrono::milliseconds(100),
+         bool io_thread_per_core = false, bool pin_workers_to_numa_nodes = false);
 
   ~Server();
 
@@ -89,10 +105,14 @@ class Server final {
 
   void Shutdown() {
     context_thread_pool_.Shutdown();
+    execution_pool_.Shutdown();
     spdlog::info("{} shutting down...", service_name_);
   }
 
-  void AwaitShutdown() { context_thread_pool_.AwaitShutdown(); }
+  void AwaitShutdown() {
+    execution_pool_.AwaitShutdown();
+    context_thread_pool_.AwaitShutdown();
+  }
 
   bool IsRunning() const noexcept;
 
@@ -101,7 +121,8 @@ class Server final {
   std::string service_name_;
 
   IOContextThreadPool context_thread_pool_;
-  std::shared_ptr<Listener<TSession, TSessionContext>> listener_;
+  ExecutionPool execution_pool_;
+  std::vector<std::shared_ptr<Listener<TSession, TSessionContext>>> listeners_;
 };
 
 template <typename TSession, typename TSessionContext>
@@ -112,13 +133,25 @@ Server<TSession, TSessionContext>::~Server() {
 template <typename TSession, typename TSessionContext>
 Server<TSession, TSessionContext>::Server(ServerEndpoint &endpoint, TSessionContext *session_context,
                                           ServerContext *server_context, const int inactivity_timeout_sec,
-                                          const std::string_view service_name, size_t workers_count)
+                                          const std::string_view service_name, size_t workers_count,
+                                          size_t io_workers_count,
+                                          std::chrono::milliseconds long_execution_threshold,
+                                          const bool io_thread_per_core, const bool pin_workers_to_numa_nodes)
     : endpoint_{endpoint},
       service_name_{service_name},
-      context_thread_pool_{workers_count},
-      listener_{Listener<TSession, TSessionContext>::Create(context_thread_pool_.GetIOContext(), session_context,
-                                                            server_context, endpoint_, service_name_,
-                                                            inactivity_timeout_sec)} {}
+      context_thread_pool_{io_workers_count, io_thread_per_core},
+      execution_pool_{workers_count, long_execution_threshold, pin_workers_to_numa_nodes} {
+  const auto listeners_count = context_thread_pool_.IOContextsCount();
+  listeners_.reserve(listeners_count);
+  for (size_t i = 0; i < listeners_count; ++i) {
+    // The other listeners are bound to the port which the first one got, in
+    // case the server was given port 0.
+    auto listener_endpoint = listeners_.empty() ? endpoint_ : listeners_.front()->LocalEndpoint();
+    listeners_.push_back(Listener<TSession, TSessionContext>::Create(
+        context_thread_pool_.GetIOContext(i), session_context, server_context, execution_pool_, listener_endpoint,
+        service_name_, inactivity_timeout_sec, io_thread_per_core));
+  }
+}
 
 template <typename TSession, typename TSessionContext>
 bool Server<TSession, TSessionContext>::Start() {
@@ -126,7 +159,8 @@ bool Server<TSession, TSessionContext>::Start() {
     spdlog::error("The server is already running");
     return false;
   }
-  listener_->Start();
+  for (auto &listener : listeners_) listener->Start();
+  execution_pool_.Run();
 
   spdlog::info("{} server is fully armed and operational", service_name_);
   spdlog::info("{} listening on {}", service_name_, endpoint_.address());
@@ -143,7 +177,8 @@ const auto &Server<TSession, TSessionContext>::Endpoint() const {
 
 template <typename TSession, typename TSessionContext>
 bool Server<TSession, TSessionContext>::IsRunning() const noexcept {
-  return context_thread_pool_.IsRunning() && listener_->IsRunning();
+  return context_thread_pool_.IsRunning() && execution_pool_.IsRunning() &&
+         std::all_of(listeners_.begin(), listeners_.end(), [](const auto &listener) { return listener->IsRunning(); });
 }
 
 }  // namespace memgraph::communication::v2
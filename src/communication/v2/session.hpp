@@ -19,15 +19,20 @@
 #include <exception>
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <variant>
+#include <vector>
+
+#include <sys/uio.h>
 
 #include <spdlog/spdlog.h>
 #include <boost/asio/bind_executor.hpp>
 #include <boost/asio/buffer.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/socket_base.hpp>
@@ -47,10 +52,13 @@
 #include "communication/buffer.hpp"
 #include "communication/context.hpp"
 #include "communication/exceptions.hpp"
+#include "communication/v2/execution_pool.hpp"
 #include "dbms/global.hpp"
 #include "utils/event_counter.hpp"
+#include "utils/event_histogram.hpp"
 #include "utils/logging.hpp"
 #include "utils/on_scope_exit.hpp"
+#include "utils/timer.hpp"
 #include "utils/variant_helpers.hpp"
 
 namespace memgraph::metrics {
@@ -58,6 +66,11 @@ extern const Event ActiveSessions;
 extern const Event ActiveTCPSessions;
 extern const Event ActiveSSLSessions;
 extern const Event ActiveWebSocketSessions;
+extern const Event SSLHandshakes;
+extern const Event SSLResumedHandshakes;
+extern const Event SSLFailedHandshakes;
+extern const Event SSLKernelOffloadedSessions;
+extern const Event SSLHandshakeLatency_us;
 }  // namespace memgraph::metrics
 
 namespace memgraph::communication::v2 {
@@ -75,8 +88,9 @@ using tcp = boost::asio::ip::tcp;
  */
 class OutputStream final {
  public:
-  explicit OutputStream(std::function<bool(const uint8_t *, size_t, bool)> write_function)
-      : write_function_(write_function) {}
+  explicit OutputStream(std::function<bool(const uint8_t *, size_t, bool)> write_function,
+                        std::function<bool(std::span<const iovec>, bool)> write_vectored_function = {})
+      : write_function_(std::move(write_function)), write_vectored_function_(std::move(write_vectored_function)) {}
 
   OutputStream(const OutputStream &) = delete;
   OutputStream(OutputStream &&) = delete;
@@ -90,10 +104,34 @@ class OutputStream final {
     return Write(reinterpret_cast<const uint8_t *>(str.data()), str.size(), have_more);
   }
 
+  /// Writes the buffers one after another, with a single write to the socket
+  /// if the session supports it.
+  bool Write(std::span<const iovec> buffers, bool have_more = false) {
+    if (write_vectored_function_) return write_vectored_function_(buffers, have_more);
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      if (!Write(static_cast<const uint8_t *>(buffers[i].iov_base), buffers[i].iov_len,
+                 have_more || i + 1 < buffers.size())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
  private:
   std::function<bool(const uint8_t *, size_t, bool)> write_function_;
+  std::function<bool(std::span<const iovec>, bool)> write_vectored_function_;
 };
 
+/// How the execution of the received messages ended.
+enum class ExecutionResult : uint8_t { OK, CLOSED, FAILED };
+
+inline std::vector<boost::asio::const_buffer> ToAsioBuffers(std::span<const iovec> buffers) {
+  std::vector<boost::asio::const_buffer> asio_buffers;
+  asio_buffers.reserve(buffers.size());
+  for (const auto &buffer : buffers) asio_buffers.emplace_back(buffer.iov_base, buffer.iov_len);
+  return asio_buffers;
+}
+
 /**
  * This class is used internally in the communication stack to handle all user
  * Websocket Sessions. It handles socket ownership, inactivity timeout and protocol
@@ -158,7 +196,22 @@ class WebsocketSession : public std::enable_shared_from_this<WebsocketSession<TS
     boost::system::error_code ec;
     ws_.write(boost::asio::buffer(data, len), ec);
     if (ec) {
-      OnError(ec, "write");
+      // The error is handled on the strand once the execution is done.
+      write_error_ = ec;
+      return false;
+    }
+    return true;
+  }
+
+  bool Write(std::span<const iovec> buffers) {
+    if (!IsConnected()) {
+      return false;
+    }
+
+    boost::system::error_code ec;
+    ws_.write(ToAsioBuffers(buffers), ec);
+    if (ec) {
+      write_error_ = ec;
       return false;
     }
     return true;
@@ -166,13 +219,15 @@ class WebsocketSession : public std::enable_shared_from_this<WebsocketSession<TS
 
  private:
   // Take ownership of the socket
-  explicit WebsocketSession(tcp::socket &&socket, TSessionContext *session_context, tcp::endpoint endpoint,
-                            std::string_view service_name)
+  explicit WebsocketSession(tcp::socket &&socket, TSessionContext *session_context, ExecutionPool &execution_pool,
+                            tcp::endpoint endpoint, std::string_view service_name)
       : ws_(std::move(socket)),
         strand_{boost::asio::make_strand(ws_.get_executor())},
-        output_stream_([this](const uint8_t *data, size_t len, bool /*have_more*/) { return Write(data, len); }),
+        output_stream_([this](const uint8_t *data, size_t len, bool /*have_more*/) { return Write(data, len); },
+                       [this](std::span<const iovec> buffers, bool /*have_more*/) { return Write(buffers); }),
         session_{*session_context, endpoint, input_buffer_.read_end(), &output_stream_},
         session_context_{session_context},
+        execution_pool_{execution_pool},
         endpoint_{endpoint},
         remote_endpoint_{ws_.next_layer().socket().remote_endpoint()},
         service_name_{service_name} {
@@ -211,20 +266,45 @@ class WebsocketSession : public std::enable_shared_from_this<WebsocketSession<TS
     }
     input_buffer_.write_end()->Written(bytes_transferred);
 
+    execution_pool_.Schedule(priority_, [shared_this = shared_from_this()] { shared_this->DoExecute(); });
+  }
+
+  void DoExecute() {
+    utils::Timer timer;
+    auto result = ExecutionResult::OK;
+    std::string error;
     try {
       session_.Execute();
-      DoRead();
     } catch (const SessionClosedException &e) {
-      spdlog::info("{} client {}:{} closed the connection.", service_name_, remote_endpoint_.address(),
-                   remote_endpoint_.port());
-      DoClose();
+      result = ExecutionResult::CLOSED;
     } catch (const std::exception &e) {
-      spdlog::error(
-          "Exception was thrown while processing event in {} session "
-          "associated with {}:{}",
-          service_name_, remote_endpoint_.address(), remote_endpoint_.port());
-      spdlog::debug("Exception message: {}", e.what());
-      DoClose();
+      result = ExecutionResult::FAILED;
+      error = e.what();
+    }
+    priority_ = execution_pool_.PriorityOf(timer.Elapsed());
+    boost::asio::post(strand_, [shared_this = shared_from_this(), result, error = std::move(error)] {
+      shared_this->OnExecuted(result, error);
+    });
+  }
+
+  void OnExecuted(const ExecutionResult result, const std::string &error) {
+    if (write_error_) {
+      return OnError(std::exchange(write_error_, {}), "write");
+    }
+    switch (result) {
+      case ExecutionResult::OK:
+        return DoRead();
+      case ExecutionResult::CLOSED:
+        spdlog::info("{} client {}:{} closed the connection.", service_name_, remote_endpoint_.address(),
+                     remote_endpoint_.port());
+        return DoClose();
+      case ExecutionResult::FAILED:
+        spdlog::error(
+            "Exception was thrown while processing event in {} session "
+            "associated with {}:{}",
+            service_name_, remote_endpoint_.address(), remote_endpoint_.port());
+        spdlog::debug("Exception message: {}", error);
+        return DoClose();
     }
   }
 
@@ -254,7 +334,7 @@ class WebsocketSession : public std::enable_shared_from_this<WebsocketSession<TS
     }
   }
 
-  bool IsConnected() const { return ws_.is_open() && execution_active_; }
+  bool IsConnected() const { return ws_.is_open() && execution_active_ && !write_error_; }
 
   WebSocket ws_;
   boost::asio::strand<WebSocket::executor_type> strand_;
@@ -263,6 +343,11 @@ class WebsocketSession : public std::enable_shared_from_this<WebsocketSession<TS
   OutputStream output_stream_;
   TSession session_;
   TSessionContext *session_context_;
+  ExecutionPool &execution_pool_;
+  ExecutionPool::Priority priority_{ExecutionPool::Priority::SHORT};
+  // Written while the messages are executed, when the socket can't be closed
+  // from the execution thread.
+  boost::system::error_code write_error_;
   tcp::endpoint endpoint_;
   tcp::endpoint remote_endpoint_;
   std::string_view service_name_;
@@ -330,7 +415,7 @@ class Session final : public std::enable_shared_from_this<Session<TSession, TSes
                               const auto sent = socket.send(boost::asio::buffer(data, len),
                                                             MSG_NOSIGNAL | (have_more ? MSG_MORE : 0), ec);
                               if (ec) {
-                                shared_this->OnError(ec);
+                                shared_this->write_error_ = ec;
                                 return false;
                               }
                               data += sent;
@@ -343,7 +428,7 @@ class Session final : public std::enable_shared_from_this<Session<TSession, TSes
                             while (len > 0) {
                               const auto sent = socket.write_some(boost::asio::buffer(data, len), ec);
                               if (ec) {
-                                shared_this->OnError(ec);
+                                shared_this->write_error_ = ec;
                                 return false;
                               }
                               data += sent;
@@ -354,20 +439,60 @@ class Session final : public std::enable_shared_from_this<Session<TSession, TSes
         socket_);
   }
 
+  bool Write(std::span<const iovec> buffers, bool have_more = false) {
+    if (!IsConnected()) {
+      return false;
+    }
+    auto asio_buffers = ToAsioBuffers(buffers);
+    return std::visit(
+        utils::Overloaded{[shared_this = shared_from_this(), &asio_buffers, have_more](TCPSocket &socket) mutable {
+                            boost::system::error_code ec;
+                            std::span<boost::asio::const_buffer> remaining(asio_buffers);
+                            while (!remaining.empty()) {
+                              auto sent =
+                                  socket.send(remaining, MSG_NOSIGNAL | (have_more ? MSG_MORE : 0), ec);
+                              if (ec) {
+                                shared_this->write_error_ = ec;
+                                return false;
+                              }
+                              // Drop the buffers which were sent completely.
+                              while (!remaining.empty() && sent >= remaining.front().size()) {
+                                sent -= remaining.front().size();
+                                remaining = remaining.subspan(1);
+                              }
+                              if (sent > 0) remaining.front() += sent;
+                            }
+                            return true;
+                          },
+                          [shared_this = shared_from_this(), &asio_buffers](SSLSocket &socket) mutable {
+                            boost::system::error_code ec;
+                            boost::asio::write(socket, asio_buffers, ec);
+                            if (ec) {
+                              shared_this->write_error_ = ec;
+                              return false;
+                            }
+                            return true;
+                          }},
+        socket_);
+  }
+
   bool IsConnected() const {
-    return std::visit([this](const auto &socket) { return execution_active_ && socket.lowest_layer().is_open(); },
-                      socket_);
+    return std::visit(
+        [this](const auto &socket) { return execution_active_ && !write_error_ && socket.lowest_layer().is_open(); },
+        socket_);
   }
 
  private:
   explicit Session(tcp::socket &&socket, TSessionContext *session_context, ServerContext &server_context,
-                   tcp::endpoint endpoint, const std::chrono::seconds inactivity_timeout_sec,
-                   std::string_view service_name)
+                   ExecutionPool &execution_pool, tcp::endpoint endpoint,
+                   const std::chrono::seconds inactivity_timeout_sec, std::string_view service_name)
       : socket_(CreateSocket(std::move(socket), server_context)),
         strand_{boost::asio::make_strand(GetExecutor())},
-        output_stream_([this](const uint8_t *data, size_t len, bool have_more) { return Write(data, len, have_more); }),
+        output_stream_([this](const uint8_t *data, size_t len, bool have_more) { return Write(data, len, have_more); },
+                       [this](std::span<const iovec> buffers, bool have_more) { return Write(buffers, have_more); }),
         session_{*session_context, endpoint, input_buffer_.read_end(), &output_stream_},
         session_context_{session_context},
+        execution_pool_{execution_pool},
         endpoint_{endpoint},
         remote_endpoint_{GetRemoteEndpoint()},
         service_name_{service_name},
@@ -427,8 +552,8 @@ class Session final : public std::enable_shared_from_this<Session<TSession, TSes
         spdlog::info("Switching {} to websocket connection", remote_endpoint_);
         if (std::holds_alternative<TCPSocket>(socket_)) {
           auto sock = std::get<TCPSocket>(std::move(socket_));
-          WebsocketSession<TSession, TSessionContext>::Create(std::move(sock), session_context_, endpoint_,
-                                                              service_name_)
+          WebsocketSession<TSession, TSessionContext>::Create(std::move(sock), session_context_, execution_pool_,
+                                                              endpoint_, service_name_)
               ->DoAccept(parser.release());
           execution_active_ = false;
           return;
@@ -438,20 +563,49 @@ class Session final : public std::enable_shared_from_this<Session<TSession, TSes
       }
     }
 
+    // The messages are executed on the execution pool, which hands the
+    // session back to the strand once it's done. The inactivity timeout
+    // doesn't run in the meantime, like it didn't when the strand executed.
+    timeout_timer_.expires_at(boost::asio::steady_timer::time_point::max());
+    execution_pool_.Schedule(priority_, [shared_this = shared_from_this()] { shared_this->DoExecute(); });
+  }
+
+  void DoExecute() {
+    utils::Timer timer;
+    auto result = ExecutionResult::OK;
+    std::string error;
     try {
       session_.Execute();
-      DoRead();
     } catch (const SessionClosedException &e) {
-      spdlog::info("{} client {}:{} closed the connection.", service_name_, remote_endpoint_.address(),
-                   remote_endpoint_.port());
-      DoShutdown();
+      result = ExecutionResult::CLOSED;
     } catch (const std::exception &e) {
-      spdlog::error(
-          "Exception was thrown while processing event in {} session "
-          "associated with {}:{}",
-          service_name_, remote_endpoint_.address(), remote_endpoint_.port());
-      spdlog::debug("Exception message: {}", e.what());
-      DoShutdown();
+      result = ExecutionResult::FAILED;
+      error = e.what();
+    }
+    priority_ = execution_pool_.PriorityOf(timer.Elapsed());
+    boost::asio::post(strand_, [shared_this = shared_from_this(), result, error = std::move(error)] {
+      shared_this->OnExecuted(result, error);
+    });
+  }
+
+  void OnExecuted(const ExecutionResult result, const std::string &error) {
+    if (write_error_) {
+      return OnError(std::exchange(write_error_, {}));
+    }
+    switch (result) {
+      case ExecutionResult::OK:
+        return DoRead();
+      case ExecutionResult::CLOSED:
+        spdlog::info("{} client {}:{} closed the connection.", service_name_, remote_endpoint_.address(),
+                     remote_endpoint_.port());
+        return DoShutdown();
+      case ExecutionResult::FAILED:
+        spdlog::error(
+            "Exception was thrown while processing event in {} session "
+            "associated with {}:{}",
+            service_name_, remote_endpoint_.address(), remote_endpoint_.port());
+        spdlog::debug("Exception message: {}", error);
+        return DoShutdown();
     }
   }
 
@@ -491,6 +645,7 @@ class Session final : public std::enable_shared_from_this<Session<TSession, TSes
       return;
     }
     if (auto *socket = std::get_if<SSLSocket>(&socket_); socket) {
+      handshake_timer_.emplace();
       socket->async_handshake(
           boost::asio::ssl::stream_base::server,
           boost::asio::bind_executor(strand_, std::bind_front(&Session::OnHandshake, shared_from_this())));
@@ -499,8 +654,19 @@ class Session final : public std::enable_shared_from_this<Session<TSession, TSes
 
   void OnHandshake(const boost::system::error_code &ec) {
     if (ec) {
+      memgraph::metrics::IncrementCounter(memgraph::metrics::SSLFailedHandshakes);
       return OnError(ec);
     }
+    memgraph::metrics::Measure(memgraph::metrics::SSLHandshakeLatency_us,
+                               handshake_timer_->Elapsed<std::chrono::microseconds>().count());
+    auto *ssl = std::get<SSLSocket>(socket_).native_handle();
+    memgraph::metrics::IncrementCounter(SSL_session_reused(ssl) ? memgraph::metrics::SSLResumedHandshakes
+                                                                : memgraph::metrics::SSLHandshakes);
+#ifdef SSL_OP_ENABLE_KTLS
+    if (BIO_get_ktls_send(SSL_get_wbio(ssl))) {
+      memgraph::metrics::IncrementCounter(memgraph::metrics::SSLKernelOffloadedSessions);
+    }
+#endif
     DoRead();
   }
 
@@ -562,12 +728,18 @@ class Session final : public std::enable_shared_from_this<Session<TSession, TSes
 
   std::variant<TCPSocket, SSLSocket> socket_;
   std::optional<std::reference_wrapper<boost::asio::ssl::context>> ssl_context_;
+  std::optional<utils::Timer> handshake_timer_;
   boost::asio::strand<tcp::socket::executor_type> strand_;
 
   communication::Buffer input_buffer_;
   OutputStream output_stream_;
   TSession session_;
   TSessionContext *session_context_;
+  ExecutionPool &execution_pool_;
+  ExecutionPool::Priority priority_{ExecutionPool::Priority::SHORT};
+  // Written while the messages are executed, when the socket can't be shut
+  // down from the execution thread.
+  boost::system::error_code write_error_;
   tcp::endpoint endpoint_;
   tcp::endpoint remote_endpoint_;
   std::string_view service_name_;
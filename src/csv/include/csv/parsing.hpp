@@ -89,6 +89,10 @@ class Reader {
     bool ignore_bad{false};
     std::optional<utils::pmr::string> delimiter{};
     std::optional<utils::pmr::string> quote{};
+    // Number of threads which parse the rows. If it's greater than 1, the
+    // file is read ahead on a separate thread and split into chunks of rows,
+    // which are parsed in parallel and returned in the order of the file.
+    uint64_t parallelism{1};
   };
 
   using Row = utils::pmr::vector<utils::pmr::string>;
@@ -116,6 +120,8 @@ class Reader {
 
   bool HasHeader() const;
   auto GetHeader() const -> Header const &;
+  // The rows parsed in parallel are allocated with `utils::NewDeleteResource`
+  // instead of `mem`, since they're parsed before they are requested.
   auto GetNextRow(utils::MemoryResource *mem) -> std::optional<Row>;
 
  private:
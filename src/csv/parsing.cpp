@@ -11,7 +11,14 @@
 
 #include "csv/parsing.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <string_view>
+#include <thread>
 
 #include <boost/iostreams/filter/bzip2.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
@@ -22,6 +29,7 @@
 #include "utils/file.hpp"
 #include "utils/on_scope_exit.hpp"
 #include "utils/string.hpp"
+#include "utils/thread.hpp"
 
 using PlainStream = boost::iostreams::filtering_istream;
 
@@ -31,6 +39,12 @@ using ParseError = Reader::ParseError;
 
 struct Reader::impl {
   impl(CsvSource source, Reader::Config cfg, utils::MemoryResource *mem);
+  ~impl();
+
+  impl(const impl &) = delete;
+  impl &operator=(const impl &) = delete;
+  impl(impl &&) = delete;
+  impl &operator=(impl &&) = delete;
 
   [[nodiscard]] bool HasHeader() const { return read_config_.with_header; }
   [[nodiscard]] auto Header() const -> Header const & { return header_; }
@@ -38,16 +52,38 @@ struct Reader::impl {
   auto GetNextRow(utils::MemoryResource *mem) -> std::optional<Reader::Row>;
 
  private:
+  // Lines of consecutive rows of the file, which are parsed by one thread of
+  // the parallel reader.
+  struct Chunk {
+    uint64_t first_line{0};
+    std::vector<std::string> lines;
+    // Index one past the last line of each row in `lines`.
+    std::vector<size_t> row_ends;
+    std::vector<ParsingResult> rows;
+    bool parsed{false};
+  };
+
   void InitializeStream();
 
   void TryInitializeHeader();
 
-  std::optional<utils::pmr::string> GetNextLine(utils::MemoryResource *mem);
+  bool GetNextLine(utils::pmr::string &line);
 
   ParsingResult ParseHeader();
 
+  // Parses the row starting at line `first_line`, whose lines are returned
+  // by `next_line` until it returns std::nullopt at the end of the file.
+  template <typename TNextLine>
+  ParsingResult ParseRow(uint64_t first_line, TNextLine &&next_line, utils::MemoryResource *mem) const;
+
   ParsingResult ParseRow(utils::MemoryResource *mem);
 
+  void StartParallelReading();
+  void StopParallelReading();
+  void ReadChunks();
+  void ParseChunks();
+  auto GetNextParsedRow() -> std::optional<Reader::Row>;
+
   utils::MemoryResource *memory_;
   std::filesystem::path path_;
   CsvSource source_;
@@ -56,6 +92,22 @@ struct Reader::impl {
   uint64_t line_count_{1};
   uint16_t number_of_columns_{0};
   Reader::Header header_{memory_};
+  // Buffer of the line which is being parsed, reused for all lines.
+  utils::pmr::string line_{memory_};
+
+  // State of the parallel reader. The chunks are kept in the order of the
+  // file until all of their rows are returned, and the reading thread waits
+  // while `kMaxChunksInFlight` of them are read ahead.
+  std::mutex chunks_lock_;
+  std::condition_variable chunks_cv_;
+  std::deque<std::shared_ptr<Chunk>> chunks_;
+  std::deque<std::shared_ptr<Chunk>> unparsed_chunks_;
+  size_t next_row_{0};
+  bool reading_done_{false};
+  bool stop_{false};
+  bool reached_end_{false};
+  std::exception_ptr reading_error_;
+  std::vector<std::jthread> threads_;
 };
 
 Reader::impl::impl(CsvSource source, Reader::Config cfg, utils::MemoryResource *mem)
@@ -64,10 +116,14 @@ Reader::impl::impl(CsvSource source, Reader::Config cfg, utils::MemoryResource *
   read_config_.ignore_bad = cfg.ignore_bad;
   read_config_.delimiter = cfg.delimiter ? std::move(*cfg.delimiter) : utils::pmr::string{",", memory_};
   read_config_.quote = cfg.quote ? std::move(*cfg.quote) : utils::pmr::string{"\"", memory_};
+  read_config_.parallelism = cfg.parallelism;
   InitializeStream();
   TryInitializeHeader();
+  if (read_config_.parallelism > 1) StartParallelReading();
 }
 
+Reader::impl::~impl() { StopParallelReading(); }
+
 enum class CompressionMethod : uint8_t {
   NONE,
   GZip,
@@ -129,17 +185,16 @@ void Reader::impl::InitializeStream() {
   MG_ASSERT(csv_stream_.is_complete(), "Should be 'complete' for correct operation");
 }
 
-std::optional<utils::pmr::string> Reader::impl::GetNextLine(utils::MemoryResource *mem) {
-  utils::pmr::string line(mem);
+bool Reader::impl::GetNextLine(utils::pmr::string &line) {
   if (!std::getline(csv_stream_, line)) {
     // reached end of file or an I/0 error occurred
     if (!csv_stream_.good()) {
       csv_stream_.reset();  // this will close the file_stream_ and clear the chain
     }
-    return std::nullopt;
+    return false;
   }
   ++line_count_;
-  return std::move(line);
+  return true;
 }
 
 Reader::ParsingResult Reader::impl::ParseHeader() {
@@ -173,29 +228,118 @@ const Reader::Header &Reader::GetHeader() const { return pimpl->Header(); }
 namespace {
 enum class CsvParserState : uint8_t { INITIAL_FIELD, NEXT_FIELD, QUOTING, EXPECT_DELIMITER, DONE };
 
+// Returns the position of the first character of the line which a quoted
+// field can't simply take: a possible quote, a line break or a null byte. Each
+// of them is looked up with `memchr`, which compares many characters at once,
+// instead of looking at the characters one by one.
+size_t FindQuotedSpecial(std::string_view line, const char quote) {
+  const auto quote_idx = line.find(quote);
+  const auto span = line.substr(0, quote_idx);
+  return std::min({quote_idx, span.find('\0'), span.find('\r'), span.find('\n')});
+}
+
+// Follows the states `ParseRow` goes through on the line without building the
+// row, so that the reading thread of the parallel reader can tell where the
+// rows end. Returns DONE if `ParseRow` would stop on an error in the line.
+CsvParserState ScanLine(std::string_view line, CsvParserState state, const Reader::Config &config) {
+  const auto &delimiter = *config.delimiter;
+  const auto &quote = *config.quote;
+
+  if (!line.empty() && line.back() == '\r') {
+    line.remove_suffix(1);
+  }
+
+  while (state != CsvParserState::DONE && !line.empty()) {
+    const auto c = line[0];
+    if (c == '\n' || c == '\r') {
+      line.remove_prefix(1);
+      continue;
+    }
+    if (c == '\0') return CsvParserState::DONE;
+
+    switch (state) {
+      case CsvParserState::INITIAL_FIELD:
+      case CsvParserState::NEXT_FIELD: {
+        if (utils::StartsWith(line, quote)) {
+          state = CsvParserState::QUOTING;
+          line.remove_prefix(quote.size());
+        } else if (utils::StartsWith(line, delimiter)) {
+          state = CsvParserState::NEXT_FIELD;
+          line.remove_prefix(delimiter.size());
+        } else {
+          const auto delimiter_idx = line.find(delimiter);
+          if (delimiter_idx == std::string_view::npos) {
+            state = CsvParserState::DONE;
+          } else {
+            line.remove_prefix(delimiter_idx + delimiter.size());
+            state = CsvParserState::NEXT_FIELD;
+          }
+        }
+        break;
+      }
+      case CsvParserState::QUOTING: {
+        // Only a null byte or a quote can change the state, so the regular
+        // characters are skipped at once.
+        const auto special_idx = FindQuotedSpecial(line, quote[0]);
+        if (special_idx != 0) {
+          line.remove_prefix(std::min(special_idx, line.size()));
+          break;
+        }
+        if (utils::StartsWith(line, quote)) {
+          const auto after_quote = line.substr(quote.size());
+          if (utils::StartsWith(after_quote, quote)) {
+            line.remove_prefix(quote.size() * 2);
+          } else {
+            state = CsvParserState::EXPECT_DELIMITER;
+            line = after_quote;
+          }
+        } else {
+          line.remove_prefix(1);
+        }
+        break;
+      }
+      case CsvParserState::EXPECT_DELIMITER: {
+        if (!utils::StartsWith(line, delimiter)) return CsvParserState::DONE;
+        state = CsvParserState::NEXT_FIELD;
+        line.remove_prefix(delimiter.size());
+        break;
+      }
+      case CsvParserState::DONE: {
+        LOG_FATAL("Invalid state of the CSV parser!");
+      }
+    }
+  }
+  return state;
+}
+
 }  // namespace
 
-Reader::ParsingResult Reader::impl::ParseRow(utils::MemoryResource *mem) {
+template <typename TNextLine>
+Reader::ParsingResult Reader::impl::ParseRow(uint64_t first_line, TNextLine &&next_line,
+                                             utils::MemoryResource *mem) const {
   utils::pmr::vector<utils::pmr::string> row(mem);
   if (number_of_columns_ != 0) {
     row.reserve(number_of_columns_);
   }
 
-  utils::pmr::string column(memory_);
+  utils::pmr::string column(mem);
 
   auto state = CsvParserState::INITIAL_FIELD;
+  // Number of the last line of the row which was read.
+  auto line_number = first_line - 1;
 
   do {
-    const auto maybe_line = GetNextLine(mem);
+    const auto maybe_line = next_line();
     if (!maybe_line) {
       // The whole file was processed.
       break;
     }
+    ++line_number;
 
     std::string_view line_string_view = *maybe_line;
 
     // remove '\r' from the end in case we have dos file format
-    if (line_string_view.back() == '\r') {
+    if (!line_string_view.empty() && line_string_view.back() == '\r') {
       line_string_view.remove_suffix(1);
     }
 
@@ -210,7 +354,7 @@ Reader::ParsingResult Reader::impl::ParseRow(utils::MemoryResource *mem) {
       // Null bytes aren't allowed in CSVs.
       if (c == '\0') {
         return ParseError(ParseError::ErrorCode::NULL_BYTE,
-                          fmt::format("CSV: Line {:d} contains NULL byte", line_count_ - 1));
+                          fmt::format("CSV: Line {:d} contains NULL byte", line_number));
       }
 
       switch (state) {
@@ -239,6 +383,14 @@ Reader::ParsingResult Reader::impl::ParseRow(utils::MemoryResource *mem) {
           break;
         }
         case CsvParserState::QUOTING: {
+          // The characters up to the next possible quote are appended at once.
+          const auto special_idx = FindQuotedSpecial(line_string_view, (*read_config_.quote)[0]);
+          if (special_idx != 0) {
+            const auto span = line_string_view.substr(0, special_idx);
+            column += span;
+            line_string_view.remove_prefix(span.size());
+            break;
+          }
           const auto quote_size = read_config_.quote->size();
           const auto quote_now = utils::StartsWith(line_string_view, *read_config_.quote);
           const auto quote_next = quote_size <= line_string_view.size() &&
@@ -248,8 +400,9 @@ Reader::ParsingResult Reader::impl::ParseRow(utils::MemoryResource *mem) {
             column += *read_config_.quote;
             line_string_view.remove_prefix(read_config_.quote->size() * 2);
           } else if (quote_now) {
-            // This is the end of the quoted field.
-            row.emplace_back(std::move(column));
+            // This is the end of the quoted field. The column is copied so that
+            // its buffer is reused for the next quoted field.
+            row.emplace_back(column);
             column.clear();
             state = CsvParserState::EXPECT_DELIMITER;
             line_string_view.remove_prefix(read_config_.quote->size());
@@ -266,7 +419,7 @@ Reader::ParsingResult Reader::impl::ParseRow(utils::MemoryResource *mem) {
           } else {
             return ParseError(ParseError::ErrorCode::UNEXPECTED_TOKEN,
                               fmt::format("CSV Reader: Expected '{}' after '{}', but got '{}' at line {:d}",
-                                          *read_config_.delimiter, *read_config_.quote, c, line_count_ - 1));
+                                          *read_config_.delimiter, *read_config_.quote, c, line_number));
           }
           break;
         }
@@ -310,13 +463,25 @@ Reader::ParsingResult Reader::impl::ParseRow(utils::MemoryResource *mem) {
                       //      row may span several lines) ==> should have a row
                       //      counter
                       fmt::format("Expected {:d} columns in row {:d}, but got {:d}", number_of_columns_,
-                                  line_count_ - 1, row.size()));
+                                  line_number, row.size()));
   }
 
   return std::move(row);
 }
 
+Reader::ParsingResult Reader::impl::ParseRow(utils::MemoryResource *mem) {
+  return ParseRow(
+      line_count_,
+      [&]() -> std::optional<std::string_view> {
+        if (!GetNextLine(line_)) return std::nullopt;
+        return line_;
+      },
+      mem);
+}
+
 std::optional<Reader::Row> Reader::impl::GetNextRow(utils::MemoryResource *mem) {
+  if (read_config_.parallelism > 1) return GetNextParsedRow();
+
   auto row = ParseRow(mem);
 
   if (row.HasError()) {
@@ -340,6 +505,171 @@ std::optional<Reader::Row> Reader::impl::GetNextRow(utils::MemoryResource *mem)
   return std::move(*row);
 }
 
+namespace {
+// The reading thread ends a chunk after the row which makes it larger than
+// this, so that the threads parse enough rows at once to not wait on each
+// other.
+constexpr size_t kChunkSize = 1U << 20U;
+}  // namespace
+
+void Reader::impl::StartParallelReading() {
+  threads_.emplace_back([this] {
+    utils::ThreadSetName("csv reader");
+    ReadChunks();
+  });
+  for (uint64_t i = 0; i < read_config_.parallelism; ++i) {
+    threads_.emplace_back([this] {
+      utils::ThreadSetName("csv parser");
+      ParseChunks();
+    });
+  }
+}
+
+void Reader::impl::StopParallelReading() {
+  {
+    std::lock_guard guard(chunks_lock_);
+    stop_ = true;
+  }
+  chunks_cv_.notify_all();
+  threads_.clear();
+}
+
+void Reader::impl::ReadChunks() {
+  const auto max_chunks_in_flight = 2 * read_config_.parallelism;
+  const auto push_chunk = [&](std::shared_ptr<Chunk> chunk) {
+    std::unique_lock lock(chunks_lock_);
+    chunks_cv_.wait(lock, [&] { return stop_ || chunks_.size() < max_chunks_in_flight; });
+    if (stop_) return false;
+    chunks_.push_back(chunk);
+    unparsed_chunks_.push_back(std::move(chunk));
+    lock.unlock();
+    chunks_cv_.notify_all();
+    return true;
+  };
+
+  try {
+    auto chunk = std::make_shared<Chunk>();
+    chunk->first_line = line_count_;
+    size_t chunk_size = 0;
+    auto state = CsvParserState::INITIAL_FIELD;
+    bool reached_end = false;
+    std::string line;
+    while (!reached_end) {
+      bool row_ended = false;
+      if (!std::getline(csv_stream_, line)) {
+        // A quoted field which isn't closed takes the rest of the file.
+        row_ended = state == CsvParserState::QUOTING;
+        reached_end = true;
+      } else {
+        ++line_count_;
+        chunk_size += line.size();
+        state = ScanLine(line, state, read_config_);
+        chunk->lines.push_back(std::move(line));
+        row_ended = state != CsvParserState::QUOTING;
+        // An empty row ends the file, like it does when parsing without
+        // threads.
+        reached_end = state == CsvParserState::INITIAL_FIELD;
+      }
+      if (row_ended) {
+        chunk->row_ends.push_back(chunk->lines.size());
+        state = CsvParserState::INITIAL_FIELD;
+      }
+      if ((reached_end || (row_ended && chunk_size >= kChunkSize)) && !chunk->row_ends.empty()) {
+        if (!push_chunk(std::move(chunk))) return;
+        chunk = std::make_shared<Chunk>();
+        chunk->first_line = line_count_;
+        chunk_size = 0;
+      }
+    }
+  } catch (...) {
+    std::lock_guard guard(chunks_lock_);
+    reading_error_ = std::current_exception();
+  }
+
+  {
+    std::lock_guard guard(chunks_lock_);
+    reading_done_ = true;
+  }
+  chunks_cv_.notify_all();
+}
+
+void Reader::impl::ParseChunks() {
+  while (true) {
+    std::shared_ptr<Chunk> chunk;
+    {
+      std::unique_lock lock(chunks_lock_);
+      chunks_cv_.wait(lock, [&] { return stop_ || reading_done_ || !unparsed_chunks_.empty(); });
+      if (stop_ || unparsed_chunks_.empty()) return;
+      chunk = std::move(unparsed_chunks_.front());
+      unparsed_chunks_.pop_front();
+    }
+
+    chunk->rows.reserve(chunk->row_ends.size());
+    size_t row_begin = 0;
+    for (const auto row_end : chunk->row_ends) {
+      auto line_it = chunk->lines.begin() + row_begin;
+      const auto line_end = chunk->lines.begin() + row_end;
+      chunk->rows.push_back(ParseRow(
+          chunk->first_line + row_begin,
+          [&]() -> std::optional<std::string_view> {
+            if (line_it == line_end) return std::nullopt;
+            return *line_it++;
+          },
+          utils::NewDeleteResource()));
+      row_begin = row_end;
+    }
+    chunk->lines.clear();
+
+    {
+      std::lock_guard guard(chunks_lock_);
+      chunk->parsed = true;
+    }
+    chunks_cv_.notify_all();
+  }
+}
+
+std::optional<Reader::Row> Reader::impl::GetNextParsedRow() {
+  while (!reached_end_) {
+    std::unique_lock lock(chunks_lock_);
+    chunks_cv_.wait(lock, [&] { return chunks_.empty() ? reading_done_ : chunks_.front()->parsed; });
+    if (chunks_.empty()) {
+      if (reading_error_) std::rethrow_exception(reading_error_);
+      break;
+    }
+    auto &chunk = *chunks_.front();
+    if (next_row_ == chunk.rows.size()) {
+      chunks_.pop_front();
+      next_row_ = 0;
+      lock.unlock();
+      chunks_cv_.notify_all();
+      continue;
+    }
+    lock.unlock();
+
+    // Only this thread removes the parsed chunks, so the chunk can be read
+    // without holding the lock.
+    auto &row = chunk.rows[next_row_];
+    const auto last_line = chunk.first_line + chunk.row_ends[next_row_] - 1;
+    ++next_row_;
+    if (row.HasError()) {
+      if (!read_config_.ignore_bad) {
+        throw CsvReadException("CSV Reader: Bad row at line {:d}: {}", last_line, row.GetError().message);
+      }
+      spdlog::debug("CSV Reader: Bad row at line {:d}: {}", last_line, row.GetError().message);
+      continue;
+    }
+    if (row->empty()) break;
+    return std::move(*row);
+  }
+
+  // reached end of file
+  if (!reached_end_) {
+    reached_end_ = true;
+    StopParallelReading();
+  }
+  return std::nullopt;
+}
+
 // Returns Reader::Row if the read row if valid;
 // Returns std::nullopt if end of file is reached or an error occurred
 // making it unreadable;
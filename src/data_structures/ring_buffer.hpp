@@ -48,15 +48,7 @@ class RingBuffer {
   template <typename... TArgs>
   void emplace(TArgs &&...args) {
     while (true) {
-      {
-        std::lock_guard<memgraph::utils::SpinLock> guard(lock_);
-        if (size_ < capacity_) {
-          buffer_[write_pos_++] = TElement(std::forward<TArgs>(args)...);
-          write_pos_ %= capacity_;
-          size_++;
-          return;
-        }
-      }
+      if (try_emplace(std::forward<TArgs>(args)...)) return;
 
       SPDLOG_WARN("RingBuffer full: worker waiting");
 
@@ -65,6 +57,21 @@ class RingBuffer {
     }
   }
 
+  /**
+   * Emplaces a new element into the buffer if there is space available.
+   * Returns false without blocking and without constructing the element if
+   * the buffer is full.
+   */
+  template <typename... TArgs>
+  bool try_emplace(TArgs &&...args) {
+    std::lock_guard<memgraph::utils::SpinLock> guard(lock_);
+    if (size_ == capacity_) return false;
+    buffer_[write_pos_++] = TElement(std::forward<TArgs>(args)...);
+    write_pos_ %= capacity_;
+    size_++;
+    return true;
+  }
+
   /**
    * Removes and returns the oldest element from the buffer. If the buffer is
    * empty, nullopt is returned.
@@ -10,6 +10,8 @@
 // licenses/APL.txt.
 #include "flags/audit.hpp"
 
+#include <iostream>
+
 #include "audit/log.hpp"
 
 #include "utils/flag_validation.hpp"
@@ -25,4 +27,19 @@ DEFINE_VALIDATED_int32(audit_buffer_size, memgraph::audit::kBufferSizeDefault,
 DEFINE_VALIDATED_int32(audit_buffer_flush_interval_ms, memgraph::audit::kBufferFlushIntervalMillisDefault,
                        "Interval (in milliseconds) used for flushing the audit log buffer.",
                        FLAG_IN_RANGE(10, INT32_MAX));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_string(audit_overload_policy, "BLOCK",
+                        "What to do with new audit log entries when the audit log buffer is full. BLOCK waits until "
+                        "the buffer is flushed, DROP drops the entries. Allowed values: BLOCK, DROP",
+                        {
+                          if (value == "BLOCK" || value == "DROP") return true;
+                          std::cout << "Invalid value for --" << flagname << ". Allowed values: BLOCK, DROP"
+                                    << std::endl;
+                          return false;
+                        });
+
+memgraph::audit::OverloadPolicy memgraph::flags::ParseAuditOverloadPolicy() {
+  return FLAGS_audit_overload_policy == "DROP" ? memgraph::audit::OverloadPolicy::DROP
+                                               : memgraph::audit::OverloadPolicy::BLOCK;
+}
 #endif
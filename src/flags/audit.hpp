@@ -10,6 +10,7 @@
 // licenses/APL.txt.
 #pragma once
 
+#include "audit/log.hpp"
 #include "gflags/gflags.h"
 
 // Audit logging flags.
@@ -20,4 +21,12 @@ DECLARE_bool(audit_enabled);
 DECLARE_int32(audit_buffer_size);
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DECLARE_int32(audit_buffer_flush_interval_ms);
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DECLARE_string(audit_overload_policy);
+
+namespace memgraph::flags {
+
+memgraph::audit::OverloadPolicy ParseAuditOverloadPolicy();
+
+}  // namespace memgraph::flags
 #endif
@@ -23,10 +23,30 @@ DEFINE_VALIDATED_int32(bolt_port, 7687, "Port on which the Bolt server should li
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_VALIDATED_int32(bolt_num_workers, std::max(std::thread::hardware_concurrency(), 1U),
-                       "Number of workers used by the Bolt server. By default, this will be the "
+                       "Number of workers which execute the queries of the Bolt server. By default, this will be "
+                       "the number of processing units available on the machine.",
+                       FLAG_IN_RANGE(1, INT32_MAX));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_int32(bolt_num_io_workers, std::max(std::thread::hardware_concurrency() / 4, 1U),
+                       "Number of workers which do the network I/O of the Bolt server, while the queries are "
+                       "executed by the --bolt-num-workers workers. By default, this will be a quarter of the "
                        "number of processing units available on the machine.",
                        FLAG_IN_RANGE(1, INT32_MAX));
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(bolt_io_thread_per_core, false,
+            "Run each of the --bolt-num-io-workers workers on its own core with its own listener, which shares the "
+            "Bolt port through SO_REUSEPORT. A connection is then handled by the core that accepted it.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(bolt_pin_workers_to_numa_nodes, false,
+            "Pin the --bolt-num-workers workers to the NUMA nodes in turns, so each of them runs on the cores of a "
+            "single socket.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_int32(bolt_long_execution_threshold_ms, 100,
+                       "Time in milliseconds after which the execution of a Bolt message counts as long. The next "
+                       "messages of such a session are executed after the short ones and on at most three "
+                       "quarters of the workers.",
+                       FLAG_IN_RANGE(0, INT32_MAX));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_VALIDATED_int32(bolt_session_inactivity_timeout, 1800,
                        "Time in seconds after which inactive Bolt sessions will be "
                        "closed.",
@@ -36,3 +56,12 @@ DEFINE_VALIDATED_int32(bolt_session_inactivity_timeout, 1800,
 DEFINE_string(bolt_cert_file, "", "Certificate file which should be used for the Bolt server.");
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_string(bolt_key_file, "", "Key file which should be used for the Bolt server.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_int32(bolt_tls_session_timeout_sec, 300,
+                       "Time in seconds for which the clients of the Bolt server can resume their SSL sessions "
+                       "instead of doing the full handshake. 0 disables the resumption.",
+                       FLAG_IN_RANGE(0, INT32_MAX));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(bolt_tls_kernel_offload, false,
+            "Let the kernel encrypt the SSL connections of the Bolt server (kTLS), if both the OpenSSL library and "
+            "the kernel support it.");
@@ -34,6 +34,15 @@ DEFINE_VALIDATED_int32(monitoring_port, 7444,
 DEFINE_VALIDATED_int32(metrics_port, 9091, "Port on which the Memgraph server for exposing metrics should listen.",
                        FLAG_IN_RANGE(0, std::numeric_limits<uint16_t>::max()));
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_string(arrow_address, "0.0.0.0",
+              "IP address on which the HTTP server returning query results in the Arrow format should listen.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_int32(arrow_port, 0,
+                       "Port on which the HTTP server returning query results in the Arrow format should listen. "
+                       "The server isn't started if the port is 0.",
+                       FLAG_IN_RANGE(0, std::numeric_limits<uint16_t>::max()));
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_string(init_file, "",
               "Path to cypherl file that is used for configuring users and database schema before server starts.");
@@ -55,6 +64,17 @@ DEFINE_uint64(memory_warning_threshold, 1024,
               "less available RAM it will log a warning. Set to 0 to "
               "disable.");
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(memory_huge_pages, false,
+            "Advise the kernel to back the memory which the allocator maps from now on with transparent huge pages, "
+            "which reduces the TLB misses of the random accesses to the graph. Has an effect only if the transparent "
+            "huge pages are enabled in the madvise or the always mode.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(memory_numa_interleave, false,
+            "Interleave the pages of the memory which the allocator maps from now on across all NUMA nodes, so "
+            "the accesses to the graph from all sockets see the same average latency.");
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_bool(allow_load_csv, true, "Controls whether LOAD CSV clause is allowed in queries.");
 
@@ -62,10 +82,54 @@ DEFINE_bool(allow_load_csv, true, "Controls whether LOAD CSV clause is allowed i
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_VALIDATED_uint64(storage_gc_cycle_sec, 30, "Storage garbage collector interval (in seconds).",
                         FLAG_IN_RANGE(1, 24 * 3600));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_gc_threads, memgraph::storage::Config::Gc().threads,
+                        "Number of threads used by the storage garbage collector.", FLAG_IN_RANGE(1, 1024));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_gc_incremental, false,
+            "Controls whether the storage garbage collector runs bounded cycles driven by the amount of garbage "
+            "instead of full cycles every storage_gc_cycle_sec seconds.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_double(storage_index_stats_refresh_threshold, 0,
+              "Fraction of the vertices in an index that have to change before its statistics are recomputed in the "
+              "background. Value of 0 disables the refresh.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_index_stats_refresh_interval_sec, 60,
+                        "Interval (in seconds) at which the index statistics are checked for the refresh.",
+                        FLAG_IN_RANGE(1, 24 * 3600));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(storage_defragmentation_budget, 0,
+              "The number of vertices and edges whose property buffers are moved out of the sparsely used memory "
+              "extents in each background defragmentation pass. Value of 0 disables the defragmentation.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_defragmentation_interval_sec, 10,
+                        "Interval (in seconds) of the background memory defragmentation passes.",
+                        FLAG_IN_RANGE(1, 24 * 3600));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(storage_tiering_budget, 0,
+              "The number of vertices and edges visited in each background tiering pass. The large property values of "
+              "the objects whose properties weren't read since the previous visit are evicted to disk, and read back "
+              "from it until the objects are read often again. Value of 0 keeps all values in memory.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_tiering_interval_sec, 10, "Interval (in seconds) of the background tiering passes.",
+                        FLAG_IN_RANGE(1, 24 * 3600));
 // NOTE: The `storage_properties_on_edges` flag must be the same here and in
 // `mg_import_csv`. If you change it, make sure to change it there as well.
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_bool(storage_properties_on_edges, false, "Controls whether edges have properties.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_light_edges, false,
+            "With properties on edges, an edge is stored as a separate object only once a property is set on it, "
+            "which saves memory for the edges without properties. Edge type property indices can't be created.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_property_store_compression_enabled, false,
+            "Controls whether large string, list and map property values are stored compressed. The setting "
+            "applies to all databases.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_unique_constraints_hash_index, false,
+            "Controls whether unique constraints keep their entries in a hash table instead of a skip list. Only "
+            "equal values are looked up when checking uniqueness, so this makes commits cheaper.");
 
 // storage_recover_on_startup deprecated; use data_recovery_on_startup instead
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
@@ -84,6 +148,24 @@ DEFINE_bool(storage_wal_enabled, false,
 DEFINE_VALIDATED_uint64(storage_snapshot_retention_count, 3, "The number of snapshots that should always be kept.",
                         FLAG_IN_RANGE(1, 1000000));
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_snapshot_min_changed_percent, 0,
+                        "The percentage of vertices and edges that have to be changed since the last snapshot before "
+                        "a periodic snapshot is written. Until then the changes are kept only in the WAL files. Set "
+                        "to 0 to write every periodic snapshot.",
+                        FLAG_IN_RANGE(0, 100));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_snapshot_compression, false,
+            "Controls whether the snapshot files are compressed. The data is compressed in independent blocks so the "
+            "snapshots can still be recovered in parallel.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(storage_snapshot_write_rate_limit_mib, 0,
+              "The maximum rate at which the snapshot files are written in MiB per second. Set to 0 to disable the "
+              "limit.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_snapshot_low_priority, false,
+            "Controls whether the snapshots are written with the lowest CPU and I/O priority, so that they interfere "
+            "less with the queries and the WAL.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_VALIDATED_uint64(storage_wal_file_size_kib, memgraph::storage::Config::Durability().wal_file_size_kibibytes,
                         "Minimum file size of each WAL file.",
                         FLAG_IN_RANGE(1, static_cast<unsigned long>(1000) * 1024));
@@ -94,6 +176,20 @@ DEFINE_VALIDATED_uint64(storage_wal_file_flush_every_n_tx,
                         "WAL file. Set to 1 for fully synchronous operation.",
                         FLAG_IN_RANGE(1, 1000000));
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_wal_segment_pool_size, 0,
+                        "The number of empty files with preallocated disk space that are kept ready for new WAL "
+                        "files, so that switching to a new WAL file doesn't have to create and allocate one. Set "
+                        "to 0 to disable the pool.",
+                        FLAG_IN_RANGE(0, 100));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_wal_group_commit, false,
+            "Controls whether every commit waits for its WAL records to be synced to disk. Transactions that commit "
+            "concurrently are synced together with a single 'fsync' call.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_async_writeback, false,
+            "Controls whether the WAL files are preallocated and whether the WAL and snapshot data is written back to "
+            "the disk in the background as soon as it is written to the files, so that the syncs have less work left.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_bool(storage_snapshot_on_exit, false, "Controls whether the storage creates another snapshot on exit.");
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
@@ -104,12 +200,51 @@ DEFINE_uint64(storage_items_per_batch, memgraph::storage::Config::Durability().i
 DEFINE_bool(storage_parallel_index_recovery, false,
             "Controls whether the index creation can be done in a multithreaded fashion.");
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_parallel_wal_recovery, false,
+            "Controls whether the WAL files are read and applied in a multithreaded fashion during recovery, using "
+            "'storage_recovery_thread_count' threads.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_snapshot_recovery_mmap, false,
+            "Controls whether the snapshot files are memory mapped instead of read through a buffer during recovery.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_parallel_snapshot_creation, false,
+            "Controls whether the snapshots are written in a multithreaded fashion, using "
+            "'storage_recovery_thread_count' threads.");
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_uint64(storage_recovery_thread_count,
               std::max(static_cast<uint64_t>(std::thread::hardware_concurrency()),
                        memgraph::storage::Config::Durability().recovery_thread_count),
               "The number of threads used to recover persisted data from disk.");
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(storage_disk_block_cache_size_mib, 0,
+              "Size of the RocksDB block cache shared by the vertices and edges of the ON_DISK_TRANSACTIONAL storage "
+              "mode. Value of 0 keeps the RocksDB default.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(storage_disk_bloom_filter_bits_per_key, 0,
+              "Bits per key of the RocksDB bloom filters used by the ON_DISK_TRANSACTIONAL storage mode, e.g. 10 for "
+              "about 1% false positives. Value of 0 disables the bloom filters.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_disk_universal_compaction, false,
+            "Controls whether the ON_DISK_TRANSACTIONAL storage mode uses RocksDB universal compaction instead of "
+            "level compaction.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(storage_disk_object_cache_size, 0,
+              "Number of committed vertices, and separately of committed edges, of the ON_DISK_TRANSACTIONAL storage "
+              "mode kept in memory between transactions. Value of 0 disables the cache.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_disk_pipelined_write, false,
+            "Controls whether the ON_DISK_TRANSACTIONAL storage mode uses RocksDB pipelined writes, which overlap the "
+            "WAL and memtable writes of concurrent commits.");
+
 #ifdef MG_ENTERPRISE
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_bool(storage_delete_on_drop, true,
@@ -125,6 +260,10 @@ DEFINE_bool(telemetry_enabled, false,
 
 // Streams flags
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(stream_batch_queries, false,
+            "Execute consecutive rows of a stream transformation result which have the same query as a single query "
+            "that unwinds their parameters, if the query only writes to the database.");
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_uint32(
     stream_transaction_conflict_retries, 30,
     "Number of times to retry when a stream transformation fails to commit because of conflicting transactions");
@@ -135,22 +274,166 @@ DEFINE_uint32(
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_string(kafka_bootstrap_servers, "",
               "List of default Kafka brokers as a comma separated list of broker host or host:port.");
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_int32(kafka_partition_workers, 1,
+                       "Number of workers which process the batches of the newly created Kafka streams in parallel. "
+                       "The messages of a partition are always processed in order by the same worker, in a separate "
+                       "transaction from the messages of the partitions processed by the other workers.",
+                       FLAG_IN_RANGE(1, 1024));
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(kafka_adaptive_batching, false,
+            "Tune the size and the interval of the batches of the Kafka streams from the processing latency and the "
+            "consumer lag. The batch size and interval of a stream are the starting point, and the interval is never "
+            "longer than the one of the stream.");
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_int64(kafka_adaptive_batching_max_size, 10000,
+                       "Largest batch size of the Kafka streams when --kafka-adaptive-batching is enabled.",
+                       FLAG_IN_RANGE(1, std::numeric_limits<int64_t>::max()));
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_int64(kafka_adaptive_batching_target_latency_ms, 1000,
+                       "Processing latency in milliseconds above which the batches of the Kafka streams are made "
+                       "smaller when --kafka-adaptive-batching is enabled.",
+                       FLAG_IN_RANGE(1, std::numeric_limits<int64_t>::max()));
 
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_string(pulsar_service_url, "", "Default URL used while connecting to Pulsar brokers.");
 
 // Query flags.
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_admission_max_concurrent, 0,
+              "Maximum number of queries executed on a database at the same time, further queries wait until they "
+              "are admitted. Value of 0 means no limit.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_admission_max_concurrent_per_user, 0,
+              "Maximum number of queries of a single user executed on a database at the same time. Value of 0 means "
+              "no limit.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_admission_max_memory_mb, 0,
+              "Maximum memory in MiB reserved by the queries executed on a database at the same time. A query "
+              "reserves its QUERY MEMORY LIMIT or --query-admission-default-memory-mb. Value of 0 means no limit.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_admission_max_memory_per_user_mb, 0,
+              "Maximum memory in MiB reserved by the queries of a single user executed on a database at the same "
+              "time. Value of 0 means no limit.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_admission_default_memory_mb, 100,
+              "Memory in MiB reserved for admission control by a query without a QUERY MEMORY LIMIT.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_admission_queue_size, 1000,
+              "Maximum number of queries waiting to be admitted on a database. Further queries fail at once.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_admission_timeout_ms, 10000,
+              "Maximum time in milliseconds a query waits to be admitted for execution. The query fails afterwards.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_bookmark_wait_timeout_ms, 10000,
+              "Maximum time a transaction waits for the instance to apply the transaction referenced by the client's "
+              "bookmark, e.g. when a REPLICA is behind the MAIN. The transaction fails afterwards.");
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_double(query_execution_timeout_sec, 600,
               "Maximum allowed query execution time. Queries exceeding this "
               "limit will be aborted. Value of 0 means no limit.");
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_parallel_execution_threads, 0,
+              "Maximum number of threads used by a query with the USING PARALLEL EXECUTION hint. "
+              "Value of 0 means the number of hardware threads.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_spill_memory_limit_mb, 0,
+              "Approximate memory in MiB an ORDER BY, DISTINCT or aggregation of a single query may use before it "
+              "writes its intermediate results to temporary files in the data directory. Value of 0 means no limit.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_database_memory_limit_mb, 0,
+              "Memory in MiB the queries running on a single database may allocate for their execution together. "
+              "Queries going over the limit are aborted. Value of 0 means no limit.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_transaction_memory_limit_mb, 0,
+              "Memory in MiB a single transaction may allocate, counting both its query execution and the storage "
+              "objects it creates. Transactions going over the limit are aborted. Value of 0 means no limit.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_procedure_result_buffer_size, 1000,
+              "Number of records a read procedure may yield before it is suspended until the query pulls them. Value "
+              "of 0 means that each procedure call keeps all of its records in memory.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(query_commutative_increments, false,
+            "Makes SET n.p = n.p + x add to the vertex property when the transaction commits, so the transactions "
+            "incrementing the same property don't conflict with each other. The transaction doesn't see its own "
+            "increments, and they aren't passed to the triggers.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_stats_max_queries, 1000,
+              "Number of distinct queries whose execution statistics are returned by mg.query_stats(). The query "
+              "with the fewest executions is dropped to make room for a new one. Value of 0 disables the statistics.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_slow_log_threshold_ms, 0,
+              "Queries which execute longer are logged with their plans and returned by mg.slow_queries(). The next "
+              "execution of a logged query is profiled. Value of 0 disables the slow query log.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_slow_log_size, 100, "Number of the most recent slow queries kept in the slow query log.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_result_cache_size, 0,
+              "Number of results of read-only queries cached by their query and parameters, which are returned "
+              "without executing the query again until a commit changes the labels or the edge types they read. "
+              "Value of 0 disables the cache.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_result_cache_max_rows, 1000, "Results with more rows aren't kept in the query result cache.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_plan_cache_warmup_queries, 100,
+              "Number of the most executed queries from the query statistics whose stripped text and parameter types "
+              "are saved, so that they are planned at startup before the Bolt server accepts connections. Value of 0 "
+              "disables the warm-up.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_string(query_plan_cache_warmup_file, "",
+              "File the queries planned at startup are saved to and loaded from, plan_cache_warmup.json in the data "
+              "directory by default. A REPLICA only loads the file, so it can be pointed to the file saved by its "
+              "MAIN.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(query_plan_cache_warmup_save_interval_sec, 60,
+                        "How often the queries planned at startup are saved, they are also saved on shutdown.",
+                        FLAG_IN_RANGE(1, 24 * 3600));
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(trigger_after_commit_workers, 1,
+                        "Number of threads running the AFTER COMMIT triggers. Each trigger always runs on the same "
+                        "thread, so its runs keep the order of the commits.",
+                        FLAG_IN_RANGE(1, 1024));
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(trigger_after_commit_max_backlog, 0,
+              "Number of committed transactions whose AFTER COMMIT triggers may wait to be run before the commits "
+              "wait for them. Value of 0 means no limit.");
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_uint64(replication_replica_check_frequency_sec, 1,
               "The time duration between two replica checks/pings. If < 1, replicas will NOT be checked at all. NOTE: "
               "The MAIN instance allocates a new thread for each REPLICA.");
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(replication_compression, false,
+            "Compress the snapshot and WAL files sent to REPLICA instances while they are being recovered. Applies to "
+            "replicas registered while the flag is set.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(replication_sync_quorum, 0,
+              "Number of SYNC replicas that have to confirm a transaction before its commit is acknowledged. The "
+              "remaining SYNC replicas are replicated to in the background. Value of 0 waits for all SYNC replicas.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(replication_max_retained_wal_files, 100,
+              "Maximum number of WAL files older than the oldest snapshot that are kept because a REPLICA still needs "
+              "them. Such replicas are recovered from the WAL files instead of the whole snapshot.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_bool(replication_restore_state_on_startup, false, "Restore replication state on startup, e.g. recover replica");
 
 DEFINE_VALIDATED_string(query_modules_directory, "",
@@ -168,6 +451,14 @@ DEFINE_VALIDATED_string(query_modules_directory, "",
                           }
                           return true;
                         });
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(query_modules_lazy_loading, false,
+            "Load the Python and shared library query modules when they are first used instead of at startup. A "
+            "module which fails to load has no procedures.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_modules_warmup_threads, 0,
+              "Number of threads which load the lazily loaded query modules in the background after startup. 0 "
+              "disables the background loading.");
 
 auto memgraph::flags::ParseQueryModulesDirectory() -> std::vector<std::filesystem::path> {
   const auto directories = memgraph::utils::Split(FLAGS_query_modules_directory, ",");
@@ -14,8 +14,12 @@
 #include "audit/log.hpp"
 #include "glue/auth_checker.hpp"
 #include "glue/communication.hpp"
+#include "glue/record_queue.hpp"
+#include "glue/typed_value_encoder.hpp"
 #include "license/license.hpp"
 #include "query/discard_value_stream.hpp"
+#include "utils/on_scope_exit.hpp"
+#include "utils/thread_pool.hpp"
 
 #include "gflags/gflags.h"
 
@@ -27,6 +31,14 @@ extern const Event ActiveBoltSessions;
 DEFINE_string(bolt_server_name_for_init, "",
               "Server name which the database should send to the client in the "
               "Bolt INIT message.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(bolt_pull_buffer_size, 1U << 20U,
+              "Number of bytes of records which a session produces ahead while the previous records of a PULL are sent "
+              "to the client. If 0, the records are produced and sent one after another.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(bolt_allow_compression, true,
+            "Allow the Bolt clients to request zlib compression of the messages which they receive with the "
+            "'compression' field of the HELLO message.");
 
 auto ToQueryExtras(const memgraph::communication::bolt::Value &extra) -> memgraph::query::QueryExtras {
   auto const &as_map = extra.ValueMap();
@@ -44,60 +56,60 @@ auto ToQueryExtras(const memgraph::communication::bolt::Value &extra) -> memgrap
     tx_timeout = it->second.ValueInt();
   }
 
-  return memgraph::query::QueryExtras{std::move(metadata_pv), tx_timeout};
+  // Bookmarks that weren't created by Memgraph are ignored
+  auto bookmark_timestamp = std::optional<uint64_t>{};
+  if (auto const it = as_map.find("bookmarks"); it != as_map.cend() && it->second.IsList()) {
+    for (const auto &bookmark : it->second.ValueList()) {
+      if (!bookmark.IsString()) continue;
+      auto const timestamp = memgraph::query::BookmarkToCommitTimestamp(bookmark.ValueString());
+      if (timestamp && (!bookmark_timestamp || *bookmark_timestamp < *timestamp)) bookmark_timestamp = timestamp;
+    }
+  }
+
+  // Statements are prepared and executed by the client's own ids
+  auto statement_id = std::optional<std::string>{};
+  if (auto const it = as_map.find("statement_id"); it != as_map.cend() && it->second.IsString()) {
+    statement_id = it->second.ValueString();
+  }
+
+  return memgraph::query::QueryExtras{std::move(metadata_pv), tx_timeout, bookmark_timestamp, std::move(statement_id)};
 }
 
-class TypedValueResultStreamBase {
+/// Wrapper around TEncoder which encodes the TypedValues of each record
+/// before forwarding them to the original TEncoder.
+template <typename TEncoder>
+class TypedValueResultStream {
  public:
-  explicit TypedValueResultStreamBase(memgraph::query::InterpreterContext *interpreterContext);
+  TypedValueResultStream(TEncoder *encoder, memgraph::query::InterpreterContext *ic, int major_version)
+      : encoder_(encoder), fields_encoder_(*ic->db, memgraph::storage::View::NEW, major_version) {}
 
-  std::vector<memgraph::communication::bolt::Value> DecodeValues(
-      const std::vector<memgraph::query::TypedValue> &values) const;
+  void Result(const std::vector<memgraph::query::TypedValue> &values) {
+    fields_encoder_.EncodeFields(values);
+    encoder_->MessageRecord(fields_encoder_.data(), fields_encoder_.size());
+  }
 
  private:
-  // NOTE: Needed only for ToBoltValue conversions
-  memgraph::query::InterpreterContext *interpreter_context_;
+  TEncoder *encoder_;
+  memgraph::glue::TypedValueEncoder fields_encoder_;
 };
 
-/// Wrapper around TEncoder which converts TypedValue to Value
-/// before forwarding the calls to original TEncoder.
-template <typename TEncoder>
-class TypedValueResultStream : public TypedValueResultStreamBase {
+/// Stream which encodes the records on the worker running the query and
+/// queues them for the session to send.
+class QueuedResultStream {
  public:
-  TypedValueResultStream(TEncoder *encoder, memgraph::query::InterpreterContext *ic)
-      : TypedValueResultStreamBase{ic}, encoder_(encoder) {}
+  QueuedResultStream(memgraph::glue::RecordQueue *queue, memgraph::query::InterpreterContext *ic, int major_version)
+      : queue_(queue), fields_encoder_(*ic->db, memgraph::storage::View::NEW, major_version) {}
 
-  void Result(const std::vector<memgraph::query::TypedValue> &values) { encoder_->MessageRecord(DecodeValues(values)); }
+  void Result(const std::vector<memgraph::query::TypedValue> &values) {
+    fields_encoder_.EncodeFields(values);
+    queue_->Push(fields_encoder_.data(), fields_encoder_.size());
+  }
 
  private:
-  TEncoder *encoder_;
+  memgraph::glue::RecordQueue *queue_;
+  memgraph::glue::TypedValueEncoder fields_encoder_;
 };
 
-std::vector<memgraph::communication::bolt::Value> TypedValueResultStreamBase::DecodeValues(
-    const std::vector<memgraph::query::TypedValue> &values) const {
-  std::vector<memgraph::communication::bolt::Value> decoded_values;
-  decoded_values.reserve(values.size());
-  for (const auto &v : values) {
-    auto maybe_value = memgraph::glue::ToBoltValue(v, *interpreter_context_->db, memgraph::storage::View::NEW);
-    if (maybe_value.HasError()) {
-      switch (maybe_value.GetError()) {
-        case memgraph::storage::Error::DELETED_OBJECT:
-          throw memgraph::communication::bolt::ClientError("Returning a deleted object as a result.");
-        case memgraph::storage::Error::NONEXISTENT_OBJECT:
-          throw memgraph::communication::bolt::ClientError("Returning a nonexistent object as a result.");
-        case memgraph::storage::Error::VERTEX_HAS_EDGES:
-        case memgraph::storage::Error::SERIALIZATION_ERROR:
-        case memgraph::storage::Error::PROPERTIES_DISABLED:
-          throw memgraph::communication::bolt::ClientError("Unexpected storage error when streaming results.");
-      }
-    }
-    decoded_values.emplace_back(std::move(*maybe_value));
-  }
-  return decoded_values;
-}
-TypedValueResultStreamBase::TypedValueResultStreamBase(memgraph::query::InterpreterContext *interpreterContext)
-    : interpreter_context_(interpreterContext) {}
-
 namespace memgraph::glue {
 
 #ifdef MG_ENTERPRISE
@@ -154,6 +166,7 @@ std::optional<std::string> SessionHL::GetServerNameForInit() {
   if (FLAGS_bolt_server_name_for_init.empty()) return std::nullopt;
   return FLAGS_bolt_server_name_for_init;
 }
+bool SessionHL::IsCompressionAllowed() { return FLAGS_bolt_allow_compression; }
 bool SessionHL::Authenticate(const std::string &username, const std::string &password) {
   auto locked_auth = auth_->Lock();
   if (!locked_auth->HasUsers()) {
@@ -189,14 +202,55 @@ std::map<std::string, memgraph::communication::bolt::Value> SessionHL::Pull(Sess
                                                                             std::optional<int> n,
                                                                             std::optional<int> qid) {
   try {
-    TypedValueResultStream<TEncoder> stream(encoder, interpreter_context_);
-    return DecodeSummary(interpreter_->Pull(&stream, n, qid));
+    if (FLAGS_bolt_pull_buffer_size == 0) {
+      TypedValueResultStream<TEncoder> stream(encoder, interpreter_context_, version_.major);
+      return DecodeSummary(interpreter_->Pull(&stream, n, qid));
+    }
+    return DecodeSummary(PipelinedPull(encoder, n, qid));
   } catch (const memgraph::query::QueryException &e) {
     // Wrap QueryException into ClientError, because we want to allow the
     // client to fix their query.
     throw memgraph::communication::bolt::ClientError(e.what());
   }
 }
+std::map<std::string, memgraph::query::TypedValue> SessionHL::PipelinedPull(SessionHL::TEncoder *encoder,
+                                                                           std::optional<int> n,
+                                                                           std::optional<int> qid) {
+  // The state is shared with the worker, which may still be finishing when
+  // the last records have been taken.
+  struct State {
+    explicit State(size_t max_bytes) : queue(max_bytes) {}
+    RecordQueue queue;
+    std::map<std::string, memgraph::query::TypedValue> summary;
+  };
+  auto state = std::make_shared<State>(FLAGS_bolt_pull_buffer_size);
+
+  if (!pull_worker_) pull_worker_ = std::make_unique<memgraph::utils::ThreadPool>(1);
+  // The session waits for the worker, so the interpreter is only used by one
+  // thread at a time.
+  pull_worker_->AddTask([this, state, n, qid] {
+    try {
+      QueuedResultStream stream(&state->queue, interpreter_context_, version_.major);
+      state->summary = interpreter_->Pull(&stream, n, qid);
+      state->queue.Finish();
+    } catch (...) {
+      state->queue.Finish(std::current_exception());
+    }
+  });
+  memgraph::utils::OnScopeExit wait_for_worker([&state] { state->queue.Cancel(); });
+
+  std::vector<uint8_t> records;
+  std::vector<size_t> record_ends;
+  while (state->queue.Pop(records, record_ends)) {
+    size_t begin = 0;
+    for (auto end : record_ends) {
+      encoder->MessageRecord(records.data() + begin, end - begin);
+      begin = end;
+    }
+  }
+  return std::move(state->summary);
+}
+
 std::pair<std::vector<std::string>, std::optional<int>> SessionHL::Interpret(
     const std::string &query, const std::map<std::string, memgraph::communication::bolt::Value> &params,
     const std::map<std::string, memgraph::communication::bolt::Value> &extra) {
@@ -240,7 +294,14 @@ std::pair<std::vector<std::string>, std::optional<int>> SessionHL::Interpret(
   }
 }
 void SessionHL::RollbackTransaction() { interpreter_->RollbackTransaction(); }
-void SessionHL::CommitTransaction() { interpreter_->CommitTransaction(); }
+std::map<std::string, memgraph::communication::bolt::Value> SessionHL::CommitTransaction() {
+  interpreter_->CommitTransaction();
+  std::map<std::string, memgraph::communication::bolt::Value> metadata;
+  if (auto bookmark = interpreter_->TakeBookmark()) {
+    metadata.emplace("bookmark", std::move(*bookmark));
+  }
+  return metadata;
+}
 void SessionHL::BeginTransaction(const std::map<std::string, memgraph::communication::bolt::Value> &extra) {
   interpreter_->BeginTransaction(ToQueryExtras(extra));
 }
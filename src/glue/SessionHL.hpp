@@ -13,6 +13,7 @@
 #include "communication/v2/server.hpp"
 #include "communication/v2/session.hpp"
 #include "dbms/session_context.hpp"
+#include "utils/thread_pool.hpp"
 
 #ifdef MG_ENTERPRISE
 #include "dbms/session_context_handler.hpp"
@@ -75,7 +76,7 @@ class SessionHL final : public memgraph::communication::bolt::Session<memgraph::
 
   void BeginTransaction(const std::map<std::string, memgraph::communication::bolt::Value> &extra) override;
 
-  void CommitTransaction() override;
+  std::map<std::string, memgraph::communication::bolt::Value> CommitTransaction() override;
 
   void RollbackTransaction() override;
 
@@ -102,12 +103,20 @@ class SessionHL final : public memgraph::communication::bolt::Session<memgraph::
 #endif
   std::optional<std::string> GetServerNameForInit() override;
 
+  bool IsCompressionAllowed() override;
+
   std::string GetDatabaseName() const override;
 
  private:
   std::map<std::string, memgraph::communication::bolt::Value> DecodeSummary(
       const std::map<std::string, memgraph::query::TypedValue> &summary);
 
+  /// Runs the PULL on `pull_worker_` and sends the records while the worker
+  /// produces the next ones, with at most `--bolt-pull-buffer-size` bytes of
+  /// them buffered.
+  std::map<std::string, memgraph::query::TypedValue> PipelinedPull(TEncoder *encoder, std::optional<int> n,
+                                                                   std::optional<int> qid);
+
 #ifdef MG_ENTERPRISE
   /**
    * @brief Update setup to the new database.
@@ -156,6 +165,7 @@ class SessionHL final : public memgraph::communication::bolt::Session<memgraph::
   memgraph::communication::v2::ServerEndpoint endpoint_;
   // NOTE: run_id should be const but that complicates code a lot.
   std::optional<std::string> run_id_;
+  std::unique_ptr<memgraph::utils::ThreadPool> pull_worker_;
 };
 
 }  // namespace memgraph::glue
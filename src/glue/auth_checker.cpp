@@ -19,72 +19,65 @@
 #include "query/frontend/ast/ast.hpp"
 #include "utils/synchronized.hpp"
 
-#ifdef MG_ENTERPRISE
-namespace {
-bool IsUserAuthorizedLabels(const memgraph::auth::User &user, const memgraph::query::DbAccessor *dba,
-                            const std::vector<memgraph::storage::LabelId> &labels,
-                            const memgraph::query::AuthQuery::FineGrainedPrivilege fine_grained_privilege) {
-  if (!memgraph::license::global_license_checker.IsEnterpriseValidFast()) {
-    return true;
-  }
-  return std::all_of(labels.begin(), labels.end(), [dba, &user, fine_grained_privilege](const auto &label) {
-    return user.GetFineGrainedAccessLabelPermissions().Has(
-               dba->LabelToName(label), memgraph::glue::FineGrainedPrivilegeToFineGrainedPermission(
-                                            fine_grained_privilege)) == memgraph::auth::PermissionLevel::GRANT;
-  });
-}
+namespace memgraph::glue {
 
-bool IsUserAuthorizedGloballyLabels(const memgraph::auth::User &user,
-                                    const memgraph::auth::FineGrainedPermission fine_grained_permission) {
-  if (!memgraph::license::global_license_checker.IsEnterpriseValidFast()) {
-    return true;
+AuthChecker::AuthChecker(
+    memgraph::utils::Synchronized<memgraph::auth::Auth, memgraph::utils::WritePrioritizedRWLock> *auth)
+    : auth_(auth), epoch_(&auth->ReadLock()->Epoch()) {}
+
+std::shared_ptr<const AuthChecker::ResolvedUser> AuthChecker::GetUser(const std::string &username,
+                                                                      bool *has_users) const {
+  {
+    const auto epoch = epoch_->load(std::memory_order_acquire);
+    auto cache = cache_.Lock();
+    if (cache->resolved && cache->epoch == epoch) {
+      *has_users = cache->has_users;
+      if (!*has_users) return nullptr;
+      if (auto it = cache->users.find(username); it != cache->users.end()) {
+        return it->second;
+      }
+    }
   }
-  return user.GetFineGrainedAccessLabelPermissions().Has(memgraph::query::kAsterisk, fine_grained_permission) ==
-         memgraph::auth::PermissionLevel::GRANT;
-}
 
-bool IsUserAuthorizedGloballyEdges(const memgraph::auth::User &user,
-                                   const memgraph::auth::FineGrainedPermission fine_grained_permission) {
-  if (!memgraph::license::global_license_checker.IsEnterpriseValidFast()) {
-    return true;
+  // The epoch is read again under the lock, because the users and roles can't
+  // change while it's held.
+  std::shared_ptr<const ResolvedUser> user;
+  uint64_t epoch = 0;
+  {
+    auto locked_auth = auth_->ReadLock();
+    epoch = locked_auth->Epoch().load(std::memory_order_acquire);
+    *has_users = locked_auth->HasUsers();
+    if (*has_users) {
+      if (auto maybe_user = locked_auth->GetUser(username)) {
+        user = std::make_shared<const ResolvedUser>(std::move(*maybe_user));
+      }
+    }
   }
-  return user.GetFineGrainedAccessEdgeTypePermissions().Has(memgraph::query::kAsterisk, fine_grained_permission) ==
-         memgraph::auth::PermissionLevel::GRANT;
-}
 
-bool IsUserAuthorizedEdgeType(const memgraph::auth::User &user, const memgraph::query::DbAccessor *dba,
-                              const memgraph::storage::EdgeTypeId &edgeType,
-                              const memgraph::query::AuthQuery::FineGrainedPrivilege fine_grained_privilege) {
-  if (!memgraph::license::global_license_checker.IsEnterpriseValidFast()) {
-    return true;
+  auto cache = cache_.Lock();
+  if (!cache->resolved || cache->epoch != epoch) {
+    // Users resolved at a later epoch are kept, since they are more current.
+    if (cache->resolved && cache->epoch > epoch) {
+      return user;
+    }
+    cache->users.clear();
+    cache->epoch = epoch;
+    cache->resolved = true;
+    cache->has_users = *has_users;
   }
-  return user.GetFineGrainedAccessEdgeTypePermissions().Has(
-             dba->EdgeTypeToName(edgeType), memgraph::glue::FineGrainedPrivilegeToFineGrainedPermission(
-                                                fine_grained_privilege)) == memgraph::auth::PermissionLevel::GRANT;
+  cache->users.insert_or_assign(username, user);
+  return user;
 }
-}  // namespace
-#endif
-namespace memgraph::glue {
-
-AuthChecker::AuthChecker(
-    memgraph::utils::Synchronized<memgraph::auth::Auth, memgraph::utils::WritePrioritizedRWLock> *auth)
-    : auth_(auth) {}
 
 bool AuthChecker::IsUserAuthorized(const std::optional<std::string> &username,
                                    const std::vector<memgraph::query::AuthQuery::Privilege> &privileges,
                                    const std::string &db_name) const {
-  std::optional<memgraph::auth::User> maybe_user;
-  {
-    auto locked_auth = auth_->ReadLock();
-    if (!locked_auth->HasUsers()) {
-      return true;
-    }
-    if (username.has_value()) {
-      maybe_user = locked_auth->GetUser(*username);
-    }
+  bool has_users = true;
+  const auto user = GetUser(username.value_or(""), &has_users);
+  if (!has_users) {
+    return true;
   }
-
-  return maybe_user.has_value() && IsUserAuthorized(*maybe_user, privileges, db_name);
+  return username.has_value() && user && IsUserAuthorized(user->user, user->permissions, privileges, db_name);
 }
 
 #ifdef MG_ENTERPRISE
@@ -94,15 +87,12 @@ std::unique_ptr<memgraph::query::FineGrainedAuthChecker> AuthChecker::GetFineGra
     return {};
   }
   try {
-    auto user = user_.Lock();
-    if (username != user->username()) {
-      auto maybe_user = auth_->ReadLock()->GetUser(username);
-      if (!maybe_user) {
-        throw memgraph::query::QueryRuntimeException("User '{}' doesn't exist .", username);
-      }
-      *user = std::move(*maybe_user);
+    bool has_users = true;
+    const auto user = GetUser(username, &has_users);
+    if (!user) {
+      throw memgraph::query::QueryRuntimeException("User '{}' doesn't exist .", username);
     }
-    return std::make_unique<memgraph::glue::FineGrainedAuthChecker>(*user, dba);
+    return std::make_unique<memgraph::glue::FineGrainedAuthChecker>(user->user, dba);
 
   } catch (const memgraph::auth::AuthException &e) {
     throw memgraph::query::QueryRuntimeException(e.what());
@@ -110,19 +100,24 @@ std::unique_ptr<memgraph::query::FineGrainedAuthChecker> AuthChecker::GetFineGra
 }
 
 void AuthChecker::ClearCache() const {
-  user_.WithLock([](auto &user) mutable { user = {}; });
+  cache_.WithLock([](auto &cache) { cache = {}; });
 }
 #endif
 
 bool AuthChecker::IsUserAuthorized(const memgraph::auth::User &user,
                                    const std::vector<memgraph::query::AuthQuery::Privilege> &privileges,
                                    const std::string &db_name) {  // NOLINT
+  return IsUserAuthorized(user, user.GetPermissions(), privileges, db_name);
+}
+
+bool AuthChecker::IsUserAuthorized(const memgraph::auth::User &user, const auth::Permissions &user_permissions,
+                                   const std::vector<memgraph::query::AuthQuery::Privilege> &privileges,
+                                   const std::string &db_name) {  // NOLINT
 #ifdef MG_ENTERPRISE
   if (!db_name.empty() && !user.db_access().Contains(db_name)) {
     return false;
   }
 #endif
-  const auto user_permissions = user.GetPermissions();
   return std::all_of(privileges.begin(), privileges.end(), [&user_permissions](const auto privilege) {
     return user_permissions.Has(memgraph::glue::PrivilegeToPermission(privilege)) ==
            memgraph::auth::PermissionLevel::GRANT;
@@ -131,10 +126,72 @@ bool AuthChecker::IsUserAuthorized(const memgraph::auth::User &user,
 
 #ifdef MG_ENTERPRISE
 FineGrainedAuthChecker::FineGrainedAuthChecker(auth::User user, const memgraph::query::DbAccessor *dba)
-    : user_{std::move(user)}, dba_(dba){};
+    : label_permissions_{user.GetFineGrainedAccessLabelPermissions()},
+      edge_type_permissions_{user.GetFineGrainedAccessEdgeTypePermissions()},
+      dba_(dba),
+      resolved_labels_{std::make_unique<ResolvedPermissions>()},
+      resolved_edge_types_{std::make_unique<ResolvedPermissions>()} {
+  if (label_permissions_.GetPermissions().empty()) {
+    all_labels_grants_ = Grants(label_permissions_, memgraph::query::kAsterisk);
+  }
+  if (edge_type_permissions_.GetPermissions().empty()) {
+    all_edge_types_grants_ = Grants(edge_type_permissions_, memgraph::query::kAsterisk);
+  }
+}
+
+uint8_t FineGrainedAuthChecker::Grants(const auth::FineGrainedAccessPermissions &permissions,
+                                       const std::string &name) {
+  uint8_t grants = kResolved;
+  for (const auto permission : {auth::FineGrainedPermission::READ, auth::FineGrainedPermission::UPDATE,
+                                auth::FineGrainedPermission::CREATE_DELETE}) {
+    if (permissions.Has(name, permission) == auth::PermissionLevel::GRANT) {
+      grants |= static_cast<uint8_t>(permission);
+    }
+  }
+  return grants;
+}
+
+bool FineGrainedAuthChecker::IsGranted(const uint8_t grants,
+                                       const query::AuthQuery::FineGrainedPrivilege fine_grained_privilege) {
+  return (grants & static_cast<uint8_t>(FineGrainedPrivilegeToFineGrainedPermission(fine_grained_privilege))) != 0;
+}
+
+template <typename TGetName>
+bool FineGrainedAuthChecker::IsGranted(ResolvedPermissions &resolved, const uint64_t id,
+                                       const auth::FineGrainedAccessPermissions &permissions, const TGetName &get_name,
+                                       const query::AuthQuery::FineGrainedPrivilege fine_grained_privilege) {
+  uint8_t grants = id < resolved.size() ? resolved[id].load(std::memory_order_relaxed) : 0;
+  if ((grants & kResolved) == 0) {
+    grants = Grants(permissions, get_name());
+    if (id < resolved.size()) {
+      resolved[id].store(grants, std::memory_order_relaxed);
+    }
+  }
+  return IsGranted(grants, fine_grained_privilege);
+}
+
+bool FineGrainedAuthChecker::IsGrantedLabel(const storage::LabelId label,
+                                            const query::AuthQuery::FineGrainedPrivilege fine_grained_privilege) const {
+  if (all_labels_grants_) return IsGranted(*all_labels_grants_, fine_grained_privilege);
+  return IsGranted(
+      *resolved_labels_, label.AsUint(), label_permissions_,
+      [&]() -> const std::string & { return dba_->LabelToName(label); }, fine_grained_privilege);
+}
+
+bool FineGrainedAuthChecker::IsGrantedEdgeType(
+    const storage::EdgeTypeId edge_type, const query::AuthQuery::FineGrainedPrivilege fine_grained_privilege) const {
+  if (all_edge_types_grants_) return IsGranted(*all_edge_types_grants_, fine_grained_privilege);
+  return IsGranted(
+      *resolved_edge_types_, edge_type.AsUint(), edge_type_permissions_,
+      [&]() -> const std::string & { return dba_->EdgeTypeToName(edge_type); }, fine_grained_privilege);
+}
 
 bool FineGrainedAuthChecker::Has(const memgraph::query::VertexAccessor &vertex, const memgraph::storage::View view,
                                  const memgraph::query::AuthQuery::FineGrainedPrivilege fine_grained_privilege) const {
+  if (!memgraph::license::global_license_checker.IsEnterpriseValidFast() ||
+      (all_labels_grants_ && IsGranted(*all_labels_grants_, fine_grained_privilege))) {
+    return true;
+  }
   auto maybe_labels = vertex.Labels(view);
   if (maybe_labels.HasError()) {
     switch (maybe_labels.GetError()) {
@@ -149,22 +206,29 @@ bool FineGrainedAuthChecker::Has(const memgraph::query::VertexAccessor &vertex,
     }
   }
 
-  return IsUserAuthorizedLabels(user_, dba_, *maybe_labels, fine_grained_privilege);
+  return Has(*maybe_labels, fine_grained_privilege);
 }
 
 bool FineGrainedAuthChecker::Has(const memgraph::query::EdgeAccessor &edge,
                                  const memgraph::query::AuthQuery::FineGrainedPrivilege fine_grained_privilege) const {
-  return IsUserAuthorizedEdgeType(user_, dba_, edge.EdgeType(), fine_grained_privilege);
+  return Has(edge.EdgeType(), fine_grained_privilege);
 }
 
 bool FineGrainedAuthChecker::Has(const std::vector<memgraph::storage::LabelId> &labels,
                                  const memgraph::query::AuthQuery::FineGrainedPrivilege fine_grained_privilege) const {
-  return IsUserAuthorizedLabels(user_, dba_, labels, fine_grained_privilege);
+  if (!memgraph::license::global_license_checker.IsEnterpriseValidFast()) {
+    return true;
+  }
+  return std::all_of(labels.begin(), labels.end(),
+                     [&](const auto label) { return IsGrantedLabel(label, fine_grained_privilege); });
 }
 
 bool FineGrainedAuthChecker::Has(const memgraph::storage::EdgeTypeId &edge_type,
                                  const memgraph::query::AuthQuery::FineGrainedPrivilege fine_grained_privilege) const {
-  return IsUserAuthorizedEdgeType(user_, dba_, edge_type, fine_grained_privilege);
+  if (!memgraph::license::global_license_checker.IsEnterpriseValidFast()) {
+    return true;
+  }
+  return IsGrantedEdgeType(edge_type, fine_grained_privilege);
 }
 
 bool FineGrainedAuthChecker::HasGlobalPrivilegeOnVertices(
@@ -172,7 +236,9 @@ bool FineGrainedAuthChecker::HasGlobalPrivilegeOnVertices(
   if (!memgraph::license::global_license_checker.IsEnterpriseValidFast()) {
     return true;
   }
-  return IsUserAuthorizedGloballyLabels(user_, FineGrainedPrivilegeToFineGrainedPermission(fine_grained_privilege));
+  return label_permissions_.Has(memgraph::query::kAsterisk,
+                                FineGrainedPrivilegeToFineGrainedPermission(fine_grained_privilege)) ==
+         memgraph::auth::PermissionLevel::GRANT;
 }
 
 bool FineGrainedAuthChecker::HasGlobalPrivilegeOnEdges(
@@ -180,7 +246,9 @@ bool FineGrainedAuthChecker::HasGlobalPrivilegeOnEdges(
   if (!memgraph::license::global_license_checker.IsEnterpriseValidFast()) {
     return true;
   }
-  return IsUserAuthorizedGloballyEdges(user_, FineGrainedPrivilegeToFineGrainedPermission(fine_grained_privilege));
+  return edge_type_permissions_.Has(memgraph::query::kAsterisk,
+                                    FineGrainedPrivilegeToFineGrainedPermission(fine_grained_privilege)) ==
+         memgraph::auth::PermissionLevel::GRANT;
 };
 #endif
 }  // namespace memgraph::glue
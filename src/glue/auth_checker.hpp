@@ -11,6 +11,13 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
 #include "auth/auth.hpp"
 #include "glue/auth.hpp"
 #include "query/auth_checker.hpp"
@@ -20,6 +27,10 @@
 
 namespace memgraph::glue {
 
+/// Checks the privileges of users, which are resolved from the auth storage
+/// once and then kept in memory until a user or a role changes. Whether the
+/// cached users are still current is checked against the change counter of
+/// `auth::Auth` without taking its lock.
 class AuthChecker : public query::AuthChecker {
  public:
   explicit AuthChecker(
@@ -41,8 +52,35 @@ class AuthChecker : public query::AuthChecker {
                                              const std::string &db_name = "");
 
  private:
+  // User with the permissions of its role merged into its own.
+  struct ResolvedUser {
+    explicit ResolvedUser(auth::User user) : user{std::move(user)}, permissions{this->user.GetPermissions()} {}
+
+    auth::User user;
+    auth::Permissions permissions;
+  };
+
+  struct Cache {
+    // Value of the change counter from which the cached users were resolved.
+    uint64_t epoch{0};
+    bool resolved{false};
+    bool has_users{false};
+    // Users which don't exist are cached as nullptr.
+    std::unordered_map<std::string, std::shared_ptr<const ResolvedUser>> users;
+  };
+
+  /// Returns the user from the cache, or resolves it from the auth storage if
+  /// the cache isn't current. Returns `has_users` false if there are no users
+  /// at all, in which case everyone is authorized.
+  std::shared_ptr<const ResolvedUser> GetUser(const std::string &username, bool *has_users) const;
+
+  [[nodiscard]] static bool IsUserAuthorized(const memgraph::auth::User &user, const auth::Permissions &permissions,
+                                             const std::vector<memgraph::query::AuthQuery::Privilege> &privileges,
+                                             const std::string &db_name);
+
   memgraph::utils::Synchronized<memgraph::auth::Auth, memgraph::utils::WritePrioritizedRWLock> *auth_;
-  mutable memgraph::utils::Synchronized<auth::User, memgraph::utils::SpinLock> user_;  // cached user
+  const std::atomic<uint64_t> *epoch_;
+  mutable memgraph::utils::Synchronized<Cache, memgraph::utils::SpinLock> cache_;
 };
 #ifdef MG_ENTERPRISE
 class FineGrainedAuthChecker : public query::FineGrainedAuthChecker {
@@ -68,8 +106,37 @@ class FineGrainedAuthChecker : public query::FineGrainedAuthChecker {
       memgraph::query::AuthQuery::FineGrainedPrivilege fine_grained_privilege) const override;
 
  private:
-  auth::User user_;
+  // The granted fine-grained permissions of the labels and edge types with
+  // ids below kResolvedIds are resolved on the first check and then looked up
+  // by id. An entry is 0 until it's resolved, and the granted permissions with
+  // kResolved set afterwards, so threads checking the same id concurrently can
+  // only store the same value.
+  static constexpr size_t kResolvedIds = 1024;
+  static constexpr uint8_t kResolved = 1U << 7U;
+  using ResolvedPermissions = std::array<std::atomic<uint8_t>, kResolvedIds>;
+
+  static uint8_t Grants(const auth::FineGrainedAccessPermissions &permissions, const std::string &name);
+  static bool IsGranted(uint8_t grants, query::AuthQuery::FineGrainedPrivilege fine_grained_privilege);
+
+  template <typename TGetName>
+  static bool IsGranted(ResolvedPermissions &resolved, uint64_t id,
+                        const auth::FineGrainedAccessPermissions &permissions, const TGetName &get_name,
+                        query::AuthQuery::FineGrainedPrivilege fine_grained_privilege);
+
+  bool IsGrantedLabel(storage::LabelId label, query::AuthQuery::FineGrainedPrivilege fine_grained_privilege) const;
+  bool IsGrantedEdgeType(storage::EdgeTypeId edge_type,
+                         query::AuthQuery::FineGrainedPrivilege fine_grained_privilege) const;
+
+  auth::FineGrainedAccessPermissions label_permissions_;
+  auth::FineGrainedAccessPermissions edge_type_permissions_;
   const memgraph::query::DbAccessor *dba_;
+  std::unique_ptr<ResolvedPermissions> resolved_labels_;
+  std::unique_ptr<ResolvedPermissions> resolved_edge_types_;
+  // The granted permissions shared by all labels or edge types, which are
+  // known when the query starts if none of them has permissions of its own.
+  // Vertices are then checked without reading their labels.
+  std::optional<uint8_t> all_labels_grants_;
+  std::optional<uint8_t> all_edge_types_grants_;
 };
 #endif
 }  // namespace memgraph::glue
@@ -0,0 +1,96 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace memgraph::glue {
+
+/// Encoded records which a worker produces while the session writes the
+/// previous ones to the client. The worker waits while at least `max_bytes`
+/// are buffered, so a slow client doesn't make the whole result pile up in
+/// memory.
+class RecordQueue {
+ public:
+  explicit RecordQueue(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+  /// Appends a record, waiting until there is space for it. The record is
+  /// dropped if the queue was cancelled.
+  void Push(const uint8_t *data, size_t size) {
+    std::unique_lock lock(mutex_);
+    space_cv_.wait(lock, [this] { return buffer_.size() < max_bytes_ || cancelled_; });
+    if (cancelled_) return;
+    const bool was_empty = record_ends_.empty();
+    buffer_.insert(buffer_.end(), data, data + size);
+    record_ends_.push_back(buffer_.size());
+    lock.unlock();
+    if (was_empty) data_cv_.notify_one();
+  }
+
+  /// Marks that no more records follow, because the worker is done or failed
+  /// with `error`.
+  void Finish(std::exception_ptr error = nullptr) {
+    std::unique_lock lock(mutex_);
+    finished_ = true;
+    error_ = std::move(error);
+    data_cv_.notify_all();
+  }
+
+  /// Takes all buffered records, waiting for some if there are none. The
+  /// records are concatenated in `buffer` and end at `record_ends`.
+  /// @returns false once all records were taken.
+  /// @throw the exception the worker finished with, after its records.
+  bool Pop(std::vector<uint8_t> &buffer, std::vector<size_t> &record_ends) {
+    std::unique_lock lock(mutex_);
+    data_cv_.wait(lock, [this] { return !record_ends_.empty() || finished_; });
+    if (record_ends_.empty()) {
+      if (error_) std::rethrow_exception(error_);
+      return false;
+    }
+    buffer.clear();
+    record_ends.clear();
+    buffer.swap(buffer_);
+    record_ends.swap(record_ends_);
+    lock.unlock();
+    space_cv_.notify_one();
+    return true;
+  }
+
+  /// Drops the buffered and all further records and waits until the worker
+  /// finishes.
+  void Cancel() {
+    std::unique_lock lock(mutex_);
+    cancelled_ = true;
+    buffer_.clear();
+    record_ends_.clear();
+    space_cv_.notify_all();
+    data_cv_.wait(lock, [this] { return finished_; });
+  }
+
+ private:
+  const size_t max_bytes_;
+  std::mutex mutex_;
+  std::condition_variable space_cv_;
+  std::condition_variable data_cv_;
+  std::vector<uint8_t> buffer_;
+  std::vector<size_t> record_ends_;
+  bool finished_{false};
+  bool cancelled_{false};
+  std::exception_ptr error_;
+};
+
+}  // namespace memgraph::glue
@@ -0,0 +1,252 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "glue/typed_value_encoder.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "communication/bolt/v1/codes.hpp"
+#include "communication/bolt/v1/exceptions.hpp"
+#include "communication/bolt/v1/value.hpp"
+#include "storage/v2/edge_accessor.hpp"
+#include "storage/v2/storage.hpp"
+#include "storage/v2/vertex_accessor.hpp"
+#include "utils/cast.hpp"
+#include "utils/temporal.hpp"
+
+namespace memgraph::glue {
+
+namespace {
+
+using communication::bolt::Marker;
+using communication::bolt::MarkerList;
+using communication::bolt::MarkerMap;
+using communication::bolt::Signature;
+
+[[noreturn]] void ThrowStorageError(storage::Error error) {
+  switch (error) {
+    case storage::Error::DELETED_OBJECT:
+      throw communication::bolt::ClientError("Returning a deleted object as a result.");
+    case storage::Error::NONEXISTENT_OBJECT:
+      throw communication::bolt::ClientError("Returning a nonexistent object as a result.");
+    case storage::Error::VERTEX_HAS_EDGES:
+    case storage::Error::SERIALIZATION_ERROR:
+    case storage::Error::PROPERTIES_DISABLED:
+      break;
+  }
+  throw communication::bolt::ClientError("Unexpected storage error when streaming results.");
+}
+
+int64_t ToBoltId(storage::Gid gid) { return communication::bolt::Id::FromUint(gid.AsUint()).AsInt(); }
+
+}  // namespace
+
+TypedValueEncoder::TypedValueEncoder(const storage::Storage &db, storage::View view, int major_version)
+    : db_(db), view_(view), major_v_(major_version) {
+  encoder_.UpdateVersion(major_version);
+}
+
+void TypedValueEncoder::EncodeFields(const std::vector<query::TypedValue> &values) {
+  buffer_.Clear();
+  encoder_.WriteTypeSize(values.size(), MarkerList);
+  for (const auto &value : values) WriteValue(value);
+}
+
+void TypedValueEncoder::WriteValue(const query::TypedValue &value) {
+  switch (value.type()) {
+    case query::TypedValue::Type::Null:
+      return encoder_.WriteNull();
+    case query::TypedValue::Type::Bool:
+      return encoder_.WriteBool(value.ValueBool());
+    case query::TypedValue::Type::Int:
+      return encoder_.WriteInt(value.ValueInt());
+    case query::TypedValue::Type::Double:
+      return encoder_.WriteDouble(value.ValueDouble());
+    case query::TypedValue::Type::String:
+      return encoder_.WriteString(value.ValueString());
+    case query::TypedValue::Type::List:
+      encoder_.WriteTypeSize(value.ValueList().size(), MarkerList);
+      for (const auto &element : value.ValueList()) WriteValue(element);
+      return;
+    case query::TypedValue::Type::Map:
+      encoder_.WriteTypeSize(value.ValueMap().size(), MarkerMap);
+      for (const auto &[key, element] : value.ValueMap()) {
+        encoder_.WriteString(key);
+        WriteValue(element);
+      }
+      return;
+    case query::TypedValue::Type::Vertex:
+      return WriteVertex(value.ValueVertex().impl_);
+    case query::TypedValue::Type::Edge:
+      return WriteEdge(value.ValueEdge().impl_, false);
+    case query::TypedValue::Type::Path:
+      return WritePath(value.ValuePath());
+    case query::TypedValue::Type::Date:
+      return encoder_.WriteDate(value.ValueDate());
+    case query::TypedValue::Type::LocalTime:
+      return encoder_.WriteLocalTime(value.ValueLocalTime());
+    case query::TypedValue::Type::LocalDateTime:
+      return encoder_.WriteLocalDateTime(value.ValueLocalDateTime());
+    case query::TypedValue::Type::Duration:
+      return encoder_.WriteDuration(value.ValueDuration());
+    case query::TypedValue::Type::Graph:
+      return WriteGraph(value.ValueGraph());
+  }
+}
+
+void TypedValueEncoder::WritePropertyValue(const storage::PropertyValue &value) {
+  switch (value.type()) {
+    case storage::PropertyValue::Type::Null:
+      return encoder_.WriteNull();
+    case storage::PropertyValue::Type::Bool:
+      return encoder_.WriteBool(value.ValueBool());
+    case storage::PropertyValue::Type::Int:
+      return encoder_.WriteInt(value.ValueInt());
+    case storage::PropertyValue::Type::Double:
+      return encoder_.WriteDouble(value.ValueDouble());
+    case storage::PropertyValue::Type::String:
+      return encoder_.WriteString(value.ValueString());
+    case storage::PropertyValue::Type::List:
+      encoder_.WriteTypeSize(value.ValueList().size(), MarkerList);
+      for (const auto &element : value.ValueList()) WritePropertyValue(element);
+      return;
+    case storage::PropertyValue::Type::Map:
+      encoder_.WriteTypeSize(value.ValueMap().size(), MarkerMap);
+      for (const auto &[key, element] : value.ValueMap()) {
+        encoder_.WriteString(key);
+        WritePropertyValue(element);
+      }
+      return;
+    case storage::PropertyValue::Type::TemporalData: {
+      const auto &temporal = value.ValueTemporalData();
+      switch (temporal.type) {
+        case storage::TemporalType::Date:
+          return encoder_.WriteDate(utils::Date(temporal.microseconds));
+        case storage::TemporalType::LocalTime:
+          return encoder_.WriteLocalTime(utils::LocalTime(temporal.microseconds));
+        case storage::TemporalType::LocalDateTime:
+          return encoder_.WriteLocalDateTime(utils::LocalDateTime(temporal.microseconds));
+        case storage::TemporalType::Duration:
+          return encoder_.WriteDuration(utils::Duration(temporal.microseconds));
+      }
+    }
+  }
+}
+
+void TypedValueEncoder::WriteProperties(const std::map<storage::PropertyId, storage::PropertyValue> &properties) {
+  // The properties are ordered by name, like in the maps of
+  // communication::bolt::Value.
+  std::vector<std::pair<const std::string *, const storage::PropertyValue *>> sorted;
+  sorted.reserve(properties.size());
+  for (const auto &[property, value] : properties) sorted.emplace_back(&db_.PropertyToName(property), &value);
+  std::sort(sorted.begin(), sorted.end(), [](const auto &lhs, const auto &rhs) { return *lhs.first < *rhs.first; });
+
+  encoder_.WriteTypeSize(sorted.size(), MarkerMap);
+  for (const auto &[name, value] : sorted) {
+    encoder_.WriteString(*name);
+    WritePropertyValue(*value);
+  }
+}
+
+void TypedValueEncoder::WriteElementId(int64_t id) {
+  // Introduced in Bolt v5 (for now just send the ID)
+  if (major_v_ > 4) encoder_.WriteString(std::to_string(id));
+}
+
+void TypedValueEncoder::WriteVertex(const storage::VertexAccessor &vertex) {
+  auto maybe_labels = vertex.Labels(view_);
+  if (maybe_labels.HasError()) ThrowStorageError(maybe_labels.GetError());
+  auto maybe_properties = vertex.Properties(view_);
+  if (maybe_properties.HasError()) ThrowStorageError(maybe_properties.GetError());
+
+  const auto id = ToBoltId(vertex.Gid());
+  encoder_.WriteRAW(utils::UnderlyingCast(Marker::TinyStruct) + 3 + static_cast<int>(major_v_ > 4));
+  encoder_.WriteRAW(utils::UnderlyingCast(Signature::Node));
+  encoder_.WriteInt(id);
+  encoder_.WriteTypeSize(maybe_labels->size(), MarkerList);
+  for (const auto &label : *maybe_labels) encoder_.WriteString(db_.LabelToName(label));
+  WriteProperties(*maybe_properties);
+  WriteElementId(id);
+}
+
+void TypedValueEncoder::WriteEdge(const storage::EdgeAccessor &edge, bool unbound) {
+  auto maybe_properties = edge.Properties(view_);
+  if (maybe_properties.HasError()) ThrowStorageError(maybe_properties.GetError());
+
+  const auto id = ToBoltId(edge.Gid());
+  const auto from = ToBoltId(edge.FromVertex().Gid());
+  const auto to = ToBoltId(edge.ToVertex().Gid());
+  const int struct_n = unbound ? 3 + static_cast<int>(major_v_ > 4) : 5 + 3 * static_cast<int>(major_v_ > 4);
+  encoder_.WriteRAW(utils::UnderlyingCast(Marker::TinyStruct) + struct_n);
+  encoder_.WriteRAW(utils::UnderlyingCast(unbound ? Signature::UnboundRelationship : Signature::Relationship));
+  encoder_.WriteInt(id);
+  if (!unbound) {
+    encoder_.WriteInt(from);
+    encoder_.WriteInt(to);
+  }
+  encoder_.WriteString(db_.EdgeTypeToName(edge.EdgeType()));
+  WriteProperties(*maybe_properties);
+  WriteElementId(id);
+  if (!unbound) {
+    WriteElementId(from);
+    WriteElementId(to);
+  }
+}
+
+void TypedValueEncoder::WritePath(const query::Path &path) {
+  // The unique vertices and edges are written once and the indices map the
+  // positions of the path to them, like communication::bolt::Path does.
+  const auto &path_vertices = path.vertices();
+  const auto &path_edges = path.edges();
+  std::vector<const storage::VertexAccessor *> vertices;
+  std::vector<const storage::EdgeAccessor *> edges;
+  std::vector<int64_t> indices;
+  vertices.reserve(path_vertices.size());
+  edges.reserve(path_edges.size());
+  indices.reserve(2 * path_edges.size());
+  auto add_element = [&indices](auto &collection, const auto *element, int64_t multiplier, int64_t offset) {
+    auto found = std::find_if(collection.begin(), collection.end(),
+                              [element](const auto *other) { return other->Gid() == element->Gid(); });
+    indices.emplace_back(multiplier * (std::distance(collection.begin(), found) + offset));
+    if (found == collection.end()) collection.push_back(element);
+  };
+  vertices.push_back(&path_vertices[0].impl_);
+  for (size_t i = 0; i < path_edges.size(); ++i) {
+    const auto &edge = path_edges[i].impl_;
+    const auto &vertex = path_vertices[i + 1].impl_;
+    add_element(edges, &edge, edge.ToVertex().Gid() == vertex.Gid() ? 1 : -1, 1);
+    add_element(vertices, &vertex, 1, 0);
+  }
+
+  encoder_.WriteRAW(utils::UnderlyingCast(Marker::TinyStruct) + 3);
+  encoder_.WriteRAW(utils::UnderlyingCast(Signature::Path));
+  encoder_.WriteTypeSize(vertices.size(), MarkerList);
+  for (const auto *vertex : vertices) WriteVertex(*vertex);
+  encoder_.WriteTypeSize(edges.size(), MarkerList);
+  for (const auto *edge : edges) WriteEdge(*edge, true);
+  encoder_.WriteTypeSize(indices.size(), MarkerList);
+  for (const auto index : indices) encoder_.WriteInt(index);
+}
+
+void TypedValueEncoder::WriteGraph(const query::Graph &graph) {
+  // Written as the map {edges: [...], nodes: [...]}, with the keys in order.
+  encoder_.WriteTypeSize(2, MarkerMap);
+  encoder_.WriteString("edges");
+  encoder_.WriteTypeSize(graph.edges().size(), MarkerList);
+  for (const auto &edge : graph.edges()) WriteEdge(edge.impl_, false);
+  encoder_.WriteString("nodes");
+  encoder_.WriteTypeSize(graph.vertices().size(), MarkerList);
+  for (const auto &vertex : graph.vertices()) WriteVertex(vertex.impl_);
+}
+
+}  // namespace memgraph::glue
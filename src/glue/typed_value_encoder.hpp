@@ -0,0 +1,90 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file Encoding of query results into Bolt records without converting them
+/// to communication::bolt::Value first.
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string_view>
+#include <vector>
+
+#include "communication/bolt/v1/encoder/base_encoder.hpp"
+#include "query/typed_value.hpp"
+#include "storage/v2/property_value.hpp"
+#include "storage/v2/view.hpp"
+
+namespace memgraph::storage {
+class EdgeAccessor;
+class Storage;
+class VertexAccessor;
+}  // namespace memgraph::storage
+
+namespace memgraph::glue {
+
+/// Buffer which the fields of a record are encoded into before they are sent.
+class RecordBuffer {
+ public:
+  void Write(const uint8_t *data, size_t size) { data_.insert(data_.end(), data, data + size); }
+
+  const uint8_t *data() const { return data_.data(); }
+  size_t size() const { return data_.size(); }
+  void Clear() { data_.clear(); }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+/// Encodes the fields of result records straight from the TypedValues and the
+/// accessors, without building the communication::bolt::Value of each field,
+/// which copies all the strings and the properties of the vertices and edges.
+/// The encoded fields are the same as when encoding the values returned by
+/// ToBoltValue.
+///
+/// A record is encoded completely before it's sent, so that a field which
+/// can't be encoded fails the record before any part of it is sent.
+class TypedValueEncoder {
+ public:
+  /// @param storage::Storage for getting label, edge type and property names.
+  /// @param storage::View for deciding which vertex and edge attributes are
+  ///        visible.
+  TypedValueEncoder(const storage::Storage &db, storage::View view, int major_version);
+
+  /// Encodes the values as the list of fields of a record, replacing the
+  /// previously encoded record.
+  ///
+  /// @throw communication::bolt::ClientError if a value contains a deleted or
+  ///        a nonexistent object.
+  /// @throw std::bad_alloc
+  void EncodeFields(const std::vector<query::TypedValue> &values);
+
+  const uint8_t *data() const { return buffer_.data(); }
+  size_t size() const { return buffer_.size(); }
+
+ private:
+  void WriteValue(const query::TypedValue &value);
+  void WritePropertyValue(const storage::PropertyValue &value);
+  void WriteProperties(const std::map<storage::PropertyId, storage::PropertyValue> &properties);
+  void WriteVertex(const storage::VertexAccessor &vertex);
+  void WriteEdge(const storage::EdgeAccessor &edge, bool unbound);
+  void WritePath(const query::Path &path);
+  void WriteGraph(const query::Graph &graph);
+  void WriteElementId(int64_t id);
+
+  const storage::Storage &db_;
+  storage::View view_;
+  int major_v_;
+  RecordBuffer buffer_;
+  communication::bolt::BaseEncoder<RecordBuffer> encoder_{buffer_};
+};
+
+}  // namespace memgraph::glue
@@ -12,6 +12,10 @@
 #pragma once
 
 #include <atomic>
+#include <cctype>
+#include <iterator>
+#include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -22,12 +26,96 @@
 
 #include <utils/event_counter.hpp>
 #include <utils/event_gauge.hpp>
+#include "query/interpreter.hpp"
+#include "query/procedure/procedure_stats.hpp"
 #include "storage/v2/storage.hpp"
 #include "utils/event_gauge.hpp"
 #include "utils/event_histogram.hpp"
+#include "utils/memory_tracker.hpp"
 
 namespace memgraph::http {
 
+// Converts a metric name like `QueryExecutionLatency_us` to the snake case
+// `query_execution_latency_us` used by Prometheus.
+inline std::string PrometheusName(std::string_view name) {
+  std::string result;
+  result.reserve(name.size() + 8);
+  for (size_t i = 0; i < name.size(); ++i) {
+    const auto c = name[i];
+    if (std::isupper(c) && i > 0 && name[i - 1] != '_' &&
+        (!std::isupper(name[i - 1]) || (i + 1 < name.size() && std::islower(name[i + 1])))) {
+      result.push_back('_');
+    }
+    result.push_back(static_cast<char>(std::tolower(c)));
+  }
+  return result;
+}
+
+inline std::string PrometheusLabelValue(std::string_view value) {
+  std::string result;
+  result.reserve(value.size());
+  for (const auto c : value) {
+    if (c == '\\' || c == '"') {
+      result.push_back('\\');
+      result.push_back(c);
+    } else if (c == '\n') {
+      result.append("\\n");
+    } else {
+      result.push_back(c);
+    }
+  }
+  return result;
+}
+
+// Renders metrics in the Prometheus text exposition format. The families have
+// to be written one at a time, with all samples of a family following its
+// header.
+class PrometheusWriter {
+ public:
+  // Upper bounds of the histogram buckets, which are powers of 4 so that the
+  // same buckets fit the latencies, sizes and counts.
+  static const std::vector<uint64_t> &BucketBounds() {
+    static const std::vector<uint64_t> bounds = [] {
+      std::vector<uint64_t> bounds;
+      for (uint64_t bound = 1; bound <= (1ULL << 40U); bound *= 4) bounds.push_back(bound);
+      return bounds;
+    }();
+    return bounds;
+  }
+
+  void Family(std::string_view name, std::string_view type, std::string_view help) {
+    fmt::format_to(std::back_inserter(out_), "# HELP memgraph_{} {}\n# TYPE memgraph_{} {}\n", name, help, name, type);
+  }
+
+  template <typename TValue>
+  void Sample(std::string_view name, std::string_view labels, TValue value) {
+    if (labels.empty()) {
+      fmt::format_to(std::back_inserter(out_), "memgraph_{} {}\n", name, value);
+    } else {
+      fmt::format_to(std::back_inserter(out_), "memgraph_{}{{{}}} {}\n", name, labels, value);
+    }
+  }
+
+  void Histogram(std::string_view name, std::string_view labels, const metrics::Histogram &histogram) {
+    const auto &bounds = BucketBounds();
+    const auto counts = histogram.CumulativeCounts(bounds);
+    const auto *separator = labels.empty() ? "" : ",";
+    for (size_t i = 0; i < bounds.size(); ++i) {
+      fmt::format_to(std::back_inserter(out_), "memgraph_{}_bucket{{{}{}le=\"{}\"}} {}\n", name, labels, separator,
+                     bounds[i], counts[i]);
+    }
+    fmt::format_to(std::back_inserter(out_), "memgraph_{}_bucket{{{}{}le=\"+Inf\"}} {}\n", name, labels, separator,
+                   counts.back());
+    Sample(fmt::format("{}_sum", name), labels, histogram.Sum());
+    Sample(fmt::format("{}_count", name), labels, counts.back());
+  }
+
+  std::string Release() { return std::move(out_); }
+
+ private:
+  std::string out_;
+};
+
 struct MetricsResponse {
   uint64_t vertex_count;
   uint64_t edge_count;
@@ -45,20 +133,111 @@ struct MetricsResponse {
   // Storage of all the percentile values across the histograms in the system
   // e.g. query latency percentiles, snapshot recovery duration percentiles, etc.
   std::vector<std::tuple<std::string, std::string, uint64_t>> event_histograms{};
+
+  // Resources used by each of the called query procedures
+  std::vector<query::procedure::ProcedureStatsInfo> procedure_stats{};
 };
 
 template <typename TSessionContext>
 class MetricsService {
  public:
-  explicit MetricsService(TSessionContext *session_context) : db_(session_context->interpreter_context->db.get()) {}
+  explicit MetricsService(TSessionContext *session_context)
+      : interpreter_context_(session_context->interpreter_context.get()),
+        db_(session_context->interpreter_context->db.get()) {}
 
   nlohmann::json GetMetricsJSON() {
     auto response = GetMetrics();
     return AsJson(response);
   }
 
+  // Renders the metrics in the Prometheus text exposition format. The
+  // histograms are rendered with their buckets, counters and histograms of
+  // the operators get an `operator` label, and the metrics of the storage get
+  // a `database` label.
+  std::string GetMetricsPrometheus() {
+    PrometheusWriter writer;
+    const auto database = fmt::format("database=\"{}\"", PrometheusLabelValue(db_->id()));
+
+    const auto info = db_->GetInfo();
+    writer.Family("vertex_count", "gauge", "Number of vertices in the database.");
+    writer.Sample("vertex_count", database, info.vertex_count);
+    writer.Family("edge_count", "gauge", "Number of edges in the database.");
+    writer.Sample("edge_count", database, info.edge_count);
+    writer.Family("memory_usage_bytes", "gauge", "Resident memory of the process in bytes.");
+    writer.Sample("memory_usage_bytes", database, info.memory_usage);
+    writer.Family("disk_usage_bytes", "gauge", "Size of the data directory of the database in bytes.");
+    writer.Sample("disk_usage_bytes", database, info.disk_usage);
+    writer.Family("tracked_memory_bytes", "gauge", "Memory allocated by the process as tracked by Memgraph in bytes.");
+    writer.Sample("tracked_memory_bytes", "", utils::total_memory_tracker.Amount());
+    writer.Family("query_memory_bytes", "gauge", "Memory allocated by the running transactions in bytes.");
+    writer.Sample("query_memory_bytes", database, interpreter_context_->query_memory_tracker.Amount());
+
+    const auto replicas = db_->ReplicasLag();
+    if (!replicas.empty()) {
+      writer.Family("replica_timestamps_behind_main", "gauge",
+                    "Commit timestamps the replica is behind MAIN as of its last acknowledgement.");
+      for (const auto &replica : replicas) {
+        writer.Sample("replica_timestamps_behind_main",
+                      fmt::format("{},replica=\"{}\"", database, PrometheusLabelValue(replica.name)),
+                      replica.timestamps_behind_main);
+      }
+      writer.Family("replica_acknowledgement_latency_us", "gauge",
+                    "Time the replica took to acknowledge the last replicated transactions in microseconds.");
+      for (const auto &replica : replicas) {
+        writer.Sample("replica_acknowledgement_latency_us",
+                      fmt::format("{},replica=\"{}\"", database, PrometheusLabelValue(replica.name)),
+                      replica.acknowledgement_latency.count());
+      }
+    }
+
+    bool operator_family = false;
+    for (auto i = 0; i < metrics::CounterEnd(); i++) {
+      const std::string_view name = metrics::GetCounterName(i);
+      const auto value = metrics::global_counters[i].load(std::memory_order_acquire);
+      if (std::string_view{metrics::GetCounterType(i)} == "Operator" && name.ends_with("Operator")) {
+        if (!std::exchange(operator_family, true)) {
+          writer.Family("operator_total", "counter", "Number of times each operator was used.");
+        }
+        writer.Sample("operator_total", fmt::format("operator=\"{}\"", name.substr(0, name.size() - 8)), value);
+        continue;
+      }
+      const auto family = PrometheusName(name) + "_total";
+      writer.Family(family, "counter", metrics::GetCounterDocumentation(i));
+      writer.Sample(family, "", value);
+    }
+
+    for (auto i = 0; i < metrics::GaugeEnd(); i++) {
+      const auto family = PrometheusName(metrics::GetGaugeName(i));
+      writer.Family(family, "gauge", metrics::GetGaugeDocumentation(i));
+      writer.Sample(family, "", metrics::global_gauges[i].load(std::memory_order_acquire));
+    }
+
+    constexpr std::string_view kPullLatency = "PullLatency_ns";
+    operator_family = false;
+    for (auto i = 0; i < metrics::HistogramEnd(); i++) {
+      const std::string_view name = metrics::GetHistogramName(i);
+      const auto &histogram = metrics::global_histograms[i];
+      if (std::string_view{metrics::GetHistogramType(i)} == "Operator" && name.ends_with(kPullLatency)) {
+        if (!std::exchange(operator_family, true)) {
+          writer.Family("operator_pull_latency_ns", "histogram",
+                        "Sampled pull latency of the operators of each category in nanoseconds.");
+        }
+        writer.Histogram("operator_pull_latency_ns",
+                         fmt::format("operator=\"{}\"", name.substr(0, name.size() - kPullLatency.size())),
+                         histogram);
+        continue;
+      }
+      const auto family = PrometheusName(name);
+      writer.Family(family, "histogram", metrics::GetHistogramDocumentation(i));
+      writer.Histogram(family, "", histogram);
+    }
+
+    return writer.Release();
+  }
+
  private:
-  const storage::Storage *db_;
+  query::InterpreterContext *interpreter_context_;
+  storage::Storage *db_;
 
   MetricsResponse GetMetrics() {
     auto info = db_->GetInfo();
@@ -70,7 +249,8 @@ class MetricsService {
                            .disk_usage = info.disk_usage,
                            .event_counters = GetEventCounters(),
                            .event_gauges = GetEventGauges(),
-                           .event_histograms = GetEventHistograms()};
+                           .event_histograms = GetEventHistograms(),
+                           .procedure_stats = query::procedure::gProcedureStats.GetInfo()};
   }
 
   nlohmann::json AsJson(MetricsResponse response) {
@@ -95,6 +275,23 @@ class MetricsService {
       metrics_response[type][name] = value;
     }
 
+    for (const auto &stats : response.procedure_stats) {
+      auto &procedure = metrics_response["Procedure"][stats.name];
+      procedure["Calls"] = stats.calls;
+      procedure["FailedCalls"] = stats.failed_calls;
+      procedure["WallTime_us"] = stats.wall_time_us;
+      procedure["CpuTime_us"] = stats.cpu_time_us;
+      procedure["AllocatedBytes"] = stats.allocated_bytes;
+      procedure["VerticesAccessed"] = stats.vertices;
+      procedure["EdgesAccessed"] = stats.edges;
+      for (const auto &[percentile, value] : stats.wall_time_percentiles) {
+        procedure["WallTime_us_" + std::to_string(percentile) + "p"] = value;
+      }
+      for (const auto &[percentile, value] : stats.cpu_time_percentiles) {
+        procedure["CpuTime_us_" + std::to_string(percentile) + "p"] = value;
+      }
+    }
+
     return metrics_response;
   }
 
@@ -189,8 +386,14 @@ class MetricsRequestHandler final {
     // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
     boost::beast::http::string_body::value_type body;
 
-    auto service_response = service_.GetMetricsJSON();
-    body.append(service_response.dump());
+    // Prometheus scrapes `/metrics`, while all other paths keep serving JSON.
+    const auto path = req.target().substr(0, req.target().find('?'));
+    const bool prometheus = path == "/metrics";
+    if (prometheus) {
+      body.append(service_.GetMetricsPrometheus());
+    } else {
+      body.append(service_.GetMetricsJSON().dump());
+    }
 
     // Cache the size since we need it after the move
     const auto size = body.size();
@@ -201,7 +404,8 @@ class MetricsRequestHandler final {
         std::piecewise_construct, std::make_tuple(std::move(body)),
         std::make_tuple(boost::beast::http::status::ok, req.version())};
     res.set(boost::beast::http::field::server, BOOST_BEAST_VERSION_STRING);
-    res.set(boost::beast::http::field::content_type, "application/json");
+    res.set(boost::beast::http::field::content_type,
+            prometheus ? "text/plain; version=0.0.4; charset=utf-8" : "application/json");
     res.content_length(size);
     res.keep_alive(req.keep_alive());
     return send(std::move(res));
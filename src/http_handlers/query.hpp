@@ -0,0 +1,201 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+#include <boost/beast/http.hpp>
+#include <boost/beast/version.hpp>
+#include <json/json.hpp>
+
+#include "auth/models.hpp"
+#include "query/arrow_stream.hpp"
+#include "query/interpreter.hpp"
+#include "storage/v2/property_value.hpp"
+#include "utils/base64.hpp"
+#include "utils/exceptions.hpp"
+#include "utils/on_scope_exit.hpp"
+
+namespace memgraph::http {
+
+inline storage::PropertyValue JsonToPropertyValue(const nlohmann::json &value) {
+  switch (value.type()) {
+    case nlohmann::json::value_t::boolean:
+      return storage::PropertyValue(value.get<bool>());
+    case nlohmann::json::value_t::number_integer:
+    case nlohmann::json::value_t::number_unsigned:
+      return storage::PropertyValue(value.get<int64_t>());
+    case nlohmann::json::value_t::number_float:
+      return storage::PropertyValue(value.get<double>());
+    case nlohmann::json::value_t::string:
+      return storage::PropertyValue(value.get<std::string>());
+    case nlohmann::json::value_t::array: {
+      std::vector<storage::PropertyValue> list;
+      list.reserve(value.size());
+      for (const auto &item : value) list.push_back(JsonToPropertyValue(item));
+      return storage::PropertyValue(std::move(list));
+    }
+    case nlohmann::json::value_t::object: {
+      std::map<std::string, storage::PropertyValue> map;
+      for (const auto &[key, item] : value.items()) map.emplace(key, JsonToPropertyValue(item));
+      return storage::PropertyValue(std::move(map));
+    }
+    default:
+      return {};
+  }
+}
+
+/// Handler which executes the query in the body of a POST request, given as
+/// `{"query": "...", "parameters": {...}}`, and responds with the results in
+/// the Arrow IPC streaming format. Data frame libraries read such results
+/// column by column, which is much faster than decoding the records of Bolt.
+///
+/// If there are users, the request has to authenticate with the HTTP basic
+/// authentication. Each query is executed in its own implicit transaction on
+/// the default database.
+template <typename TSessionContext>
+class QueryRequestHandler final {
+ public:
+  explicit QueryRequestHandler(TSessionContext *session_context) : session_context_(session_context) {}
+
+  QueryRequestHandler(const QueryRequestHandler &) = delete;
+  QueryRequestHandler(QueryRequestHandler &&) = delete;
+  QueryRequestHandler &operator=(const QueryRequestHandler &) = delete;
+  QueryRequestHandler &operator=(QueryRequestHandler &&) = delete;
+  ~QueryRequestHandler() = default;
+
+  template <class Body, class Allocator>
+  void HandleRequest(boost::beast::http::request<Body, boost::beast::http::basic_fields<Allocator>> &&req,
+                     std::function<void(boost::beast::http::response<boost::beast::http::string_body>)> &&send) {
+    auto const error = [&req](boost::beast::http::status status, const auto why) {
+      auto response_json = nlohmann::json();
+      response_json["error"] = std::string(why);
+
+      // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+      boost::beast::http::response<boost::beast::http::string_body> res{status, req.version()};
+      res.set(boost::beast::http::field::server, BOOST_BEAST_VERSION_STRING);
+      res.set(boost::beast::http::field::content_type, "application/json");
+      if (status == boost::beast::http::status::unauthorized) {
+        res.set(boost::beast::http::field::www_authenticate, "Basic realm=\"Memgraph\"");
+      }
+      res.keep_alive(req.keep_alive());
+      res.body() = response_json.dump();
+      res.prepare_payload();
+      return res;
+    };
+    auto const bad_request = [&error](const auto why) { return error(boost::beast::http::status::bad_request, why); };
+
+    if (req.method() != boost::beast::http::verb::post) {
+      return send(bad_request("Unknown HTTP-method"));
+    }
+
+    // Request path must be absolute and not contain "..".
+    if (req.target().empty() || req.target()[0] != '/' || req.target().find("..") != boost::beast::string_view::npos) {
+      return send(bad_request("Illegal request-target"));
+    }
+
+    const nlohmann::json request_json = nlohmann::json::parse(req.body(), nullptr, false);
+    if (request_json.is_discarded() || !request_json.is_object() || !request_json.contains("query") ||
+        !request_json["query"].is_string()) {
+      return send(bad_request("The body must be a JSON object with the query"));
+    }
+    std::map<std::string, storage::PropertyValue> params;
+    if (request_json.contains("parameters")) {
+      if (!request_json["parameters"].is_object()) {
+        return send(bad_request("The parameters must be a JSON object"));
+      }
+      for (const auto &[key, value] : request_json["parameters"].items()) {
+        params.emplace(key, JsonToPropertyValue(value));
+      }
+    }
+
+    std::optional<auth::User> user;
+    {
+      auto locked_auth = session_context_->auth->Lock();
+      if (locked_auth->HasUsers()) {
+        if (auto credentials = BasicCredentials(std::string(req[boost::beast::http::field::authorization]))) {
+          user = locked_auth->Authenticate(credentials->first, credentials->second);
+        }
+        if (!user) {
+          return send(error(boost::beast::http::status::unauthorized, "Authentication failed"));
+        }
+      }
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    boost::beast::http::string_body::value_type body;
+    try {
+      body = Execute(request_json["query"].get<std::string>(), params, user);
+    } catch (const utils::BasicException &e) {
+      return send(bad_request(e.what()));
+    }
+
+    // Cache the size since we need it after the move
+    const auto size = body.size();
+
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    boost::beast::http::response<boost::beast::http::string_body> res{
+        std::piecewise_construct, std::make_tuple(std::move(body)),
+        std::make_tuple(boost::beast::http::status::ok, req.version())};
+    res.set(boost::beast::http::field::server, BOOST_BEAST_VERSION_STRING);
+    res.set(boost::beast::http::field::content_type, "application/vnd.apache.arrow.stream");
+    res.content_length(size);
+    res.keep_alive(req.keep_alive());
+    return send(std::move(res));
+  }
+
+ private:
+  /// Returns the user name and the password of the basic authentication.
+  static std::optional<std::pair<std::string, std::string>> BasicCredentials(std::string_view header) {
+    constexpr std::string_view kScheme = "Basic ";
+    if (!header.starts_with(kScheme)) return std::nullopt;
+    const auto decoded = utils::base64_decode(std::string(header.substr(kScheme.size())));
+    const auto colon = decoded.find(':');
+    if (colon == std::string::npos) return std::nullopt;
+    return std::make_pair(decoded.substr(0, colon), decoded.substr(colon + 1));
+  }
+
+  /// @throw utils::BasicException if the query fails.
+  std::string Execute(const std::string &query, const std::map<std::string, storage::PropertyValue> &params,
+                      const std::optional<auth::User> &user) {
+    auto &interpreter_context = *session_context_->interpreter_context;
+    query::Interpreter interpreter(&interpreter_context);
+    // The interpreter is registered so that its transaction can be listed and
+    // terminated like the ones of Bolt sessions.
+    interpreter_context.interpreters.WithLock([&](auto &interpreters) { interpreters.insert(&interpreter); });
+    utils::OnScopeExit unregister{[&] {
+      interpreter_context.interpreters.WithLock([&](auto &interpreters) { interpreters.erase(&interpreter); });
+    }};
+
+    std::optional<std::string> username;
+    if (user) username = user->username();
+    auto result = interpreter.Prepare(query, params, username ? &*username : nullptr);
+    const std::string db_name = result.db ? *result.db : "";
+    if (user && !interpreter_context.auth_checker->IsUserAuthorized(username, result.privileges, db_name)) {
+      interpreter.Abort();
+      throw utils::BasicException(
+          "You are not authorized to execute this query! Please contact your database administrator.");
+    }
+
+    query::ArrowResultStream stream(result.headers);
+    interpreter.Pull(&stream, {}, result.qid);
+    return stream.Finish();
+  }
+
+  TSessionContext *session_context_;
+};
+
+}  // namespace memgraph::http
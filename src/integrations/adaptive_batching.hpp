@@ -0,0 +1,90 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+#include "integrations/constants.hpp"
+
+namespace memgraph::integrations {
+
+/// Bounds within which `AdaptiveBatching` tunes the batches of a consumer.
+struct AdaptiveBatchingConfig {
+  /// The batches are never larger than this, nor smaller than kMinimumSize.
+  int64_t max_batch_size;
+  /// Processing a batch for longer than this makes the following batches smaller.
+  std::chrono::milliseconds target_latency;
+};
+
+/// Statistics of the batches of a consumer.
+struct BatchStats {
+  int64_t batch_size;
+  std::chrono::milliseconds batch_interval;
+  int64_t last_batch_size{0};
+  std::chrono::milliseconds last_batch_latency{0};
+  /// Number of messages which are available but not yet consumed.
+  int64_t lag{0};
+};
+
+/// Tunes the size and the interval of the batches from how long the previous
+/// batches took to process and how many messages are waiting to be consumed.
+///
+/// The size is halved when a batch takes longer to process than the target
+/// latency, which also covers the retries on serialization conflicts, and
+/// doubled when a full batch is processed in time while messages are still
+/// waiting. The interval is halved while the batches aren't filled, because
+/// waiting longer then only delays the messages, and doubled back towards the
+/// configured interval when they are filled. Without a config, the size and
+/// the interval stay as configured.
+class AdaptiveBatching {
+ public:
+  AdaptiveBatching(int64_t batch_size, std::chrono::milliseconds batch_interval,
+                   std::optional<AdaptiveBatchingConfig> config)
+      : config_{config},
+        max_batch_interval_{batch_interval},
+        stats_{.batch_size = config ? std::clamp(batch_size, kMinimumSize, config->max_batch_size) : batch_size,
+               .batch_interval = batch_interval} {}
+
+  int64_t BatchSize() const { return stats_.batch_size; }
+  std::chrono::milliseconds BatchInterval() const { return stats_.batch_interval; }
+  const BatchStats &Stats() const { return stats_; }
+
+  /// Records a processed batch and tunes the following batches.
+  void Update(int64_t batch_size, std::chrono::milliseconds latency, int64_t lag) {
+    const bool was_full = batch_size >= stats_.batch_size;
+    stats_.last_batch_size = batch_size;
+    stats_.last_batch_latency = latency;
+    stats_.lag = lag;
+    if (!config_) return;
+
+    if (latency > config_->target_latency) {
+      stats_.batch_size = std::max(stats_.batch_size / 2, kMinimumSize);
+    } else if (was_full && lag > 0) {
+      stats_.batch_size = std::min(stats_.batch_size * 2, config_->max_batch_size);
+    }
+    if (was_full) {
+      stats_.batch_interval = std::min(stats_.batch_interval * 2, max_batch_interval_);
+    } else {
+      stats_.batch_interval = std::max(stats_.batch_interval / 2, kMinimumInterval);
+    }
+  }
+
+ private:
+  std::optional<AdaptiveBatchingConfig> config_;
+  std::chrono::milliseconds max_batch_interval_;
+  BatchStats stats_;
+};
+
+}  // namespace memgraph::integrations
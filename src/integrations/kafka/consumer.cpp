@@ -13,7 +13,10 @@
 
 #include <algorithm>
 #include <chrono>
+#include <exception>
 #include <iterator>
+#include <latch>
+#include <map>
 #include <memory>
 #include <unordered_set>
 
@@ -31,17 +34,18 @@ namespace memgraph::integrations::kafka {
 
 namespace {
 utils::BasicResult<std::string, std::vector<Message>> GetBatch(RdKafka::KafkaConsumer &consumer,
-                                                               const ConsumerInfo &info,
+                                                               const ConsumerInfo &info, const int64_t batch_size,
+                                                               const std::chrono::milliseconds batch_interval,
                                                                std::atomic<bool> &is_running) {
   std::vector<Message> batch{};
 
-  batch.reserve(info.batch_size);
+  batch.reserve(batch_size);
 
-  auto remaining_timeout_in_ms = info.batch_interval.count();
+  auto remaining_timeout_in_ms = batch_interval.count();
   auto start = std::chrono::steady_clock::now();
 
   bool run_batch = true;
-  for (int64_t i = 0; remaining_timeout_in_ms > 0 && i < info.batch_size && is_running.load(); ++i) {
+  for (int64_t i = 0; remaining_timeout_in_ms > 0 && i < batch_size && is_running.load(); ++i) {
     std::unique_ptr<RdKafka::Message> msg(consumer.consume(remaining_timeout_in_ms));
     switch (msg->err()) {
       case RdKafka::ERR__TIMED_OUT:
@@ -86,8 +90,95 @@ void CheckAndDestroyLastAssignmentIfNeeded(RdKafka::KafkaConsumer &consumer, con
   }
 }
 
+// Returns the number of messages in the assigned partitions after the current positions of the consumer, as far as
+// the high watermarks cached by librdkafka tell.
+int64_t ConsumerLag(RdKafka::KafkaConsumer &consumer) {
+  std::vector<RdKafka::TopicPartition *> partitions;
+  utils::OnScopeExit clear_partitions([&]() { RdKafka::TopicPartition::destroy(partitions); });
+  if (consumer.assignment(partitions) != RdKafka::ERR_NO_ERROR ||
+      consumer.position(partitions) != RdKafka::ERR_NO_ERROR) {
+    return 0;
+  }
+  int64_t lag = 0;
+  for (const auto *partition : partitions) {
+    int64_t low = 0;
+    int64_t high = 0;
+    if (partition->offset() < 0 ||
+        consumer.get_watermark_offsets(partition->topic(), partition->partition(), &low, &high) !=
+            RdKafka::ERR_NO_ERROR) {
+      continue;
+    }
+    lag += std::max<int64_t>(high - partition->offset(), 0);
+  }
+  return lag;
+}
+
+// Splits the batch between the workers by partitions, so the messages of each partition are processed in order by a
+// single worker, and each worker processes its part of the batch separately. The offsets are committed for the
+// partitions whose messages were processed succesfully, even if processing the other parts failed.
+void TryToConsumeBatchInParallel(RdKafka::KafkaConsumer &consumer, const ConsumerInfo &info,
+                                 const ConsumerFunction &consumer_function, std::vector<Message> &batch,
+                                 utils::ThreadPool &workers) {
+  std::vector<std::vector<Message>> worker_batches(info.partition_workers);
+  for (auto &message : batch) {
+    const auto partition_hash = std::hash<std::string_view>{}(message.TopicName()) + message.Partition();
+    const auto worker = partition_hash % worker_batches.size();
+    worker_batches[worker].push_back(std::move(message));
+  }
+  std::erase_if(worker_batches, [](const auto &worker_batch) { return worker_batch.empty(); });
+
+  std::vector<std::exception_ptr> errors(worker_batches.size());
+  std::latch done{static_cast<std::ptrdiff_t>(worker_batches.size())};
+  // The last part is processed on the current thread instead of waiting idle.
+  for (size_t i = 0; i < worker_batches.size(); ++i) {
+    auto process = [&, i] {
+      try {
+        consumer_function(worker_batches[i]);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+      done.count_down();
+    };
+    if (i + 1 == worker_batches.size()) {
+      process();
+    } else {
+      workers.AddTask(process);
+    }
+  }
+  done.wait();
+
+  std::map<std::pair<std::string_view, int32_t>, int64_t> next_offsets;
+  for (size_t i = 0; i < worker_batches.size(); ++i) {
+    if (errors[i]) continue;
+    for (const auto &message : worker_batches[i]) {
+      auto &offset = next_offsets[{message.TopicName(), message.Partition()}];
+      offset = std::max(offset, message.Offset() + 1);
+    }
+  }
+  std::vector<RdKafka::TopicPartition *> partitions;
+  utils::OnScopeExit clear_partitions([&]() { RdKafka::TopicPartition::destroy(partitions); });
+  for (const auto &[topic_partition, offset] : next_offsets) {
+    partitions.push_back(
+        RdKafka::TopicPartition::create(std::string{topic_partition.first}, topic_partition.second, offset));
+  }
+  if (!partitions.empty()) {
+    if (const auto err = consumer.commitSync(partitions); err != RdKafka::ERR_NO_ERROR) {
+      throw ConsumerCommitFailedException(info.consumer_name, RdKafka::err2str(err));
+    }
+  }
+
+  for (const auto &error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
 void TryToConsumeBatch(RdKafka::KafkaConsumer &consumer, const ConsumerInfo &info,
-                       const ConsumerFunction &consumer_function, const std::vector<Message> &batch) {
+                       const ConsumerFunction &consumer_function, std::vector<Message> &batch,
+                       utils::ThreadPool *workers) {
+  if (workers) {
+    TryToConsumeBatchInParallel(consumer, info, consumer_function, batch, *workers);
+    return;
+  }
   consumer_function(batch);
   std::vector<RdKafka::TopicPartition *> partitions;
   utils::OnScopeExit clear_partitions([&]() { RdKafka::TopicPartition::destroy(partitions); });
@@ -138,8 +229,16 @@ int64_t Message::Offset() const {
   return c_message->offset;
 }
 
+int32_t Message::Partition() const {
+  const auto *c_message = message_->c_ptr();
+  return c_message->partition;
+}
+
 Consumer::Consumer(ConsumerInfo info, ConsumerFunction consumer_function)
-    : info_{std::move(info)}, consumer_function_(std::move(consumer_function)), cb_(info_.consumer_name) {
+    : info_{std::move(info)},
+      consumer_function_(std::move(consumer_function)),
+      batching_(info_.batch_size, info_.batch_interval, info_.adaptive_batching),
+      cb_(info_.consumer_name) {
   MG_ASSERT(consumer_function_, "Empty consumer function for Kafka consumer");
   // NOLINTNEXTLINE (modernize-use-nullptr)
   if (info_.batch_interval < kMinimumInterval) {
@@ -148,6 +247,15 @@ Consumer::Consumer(ConsumerInfo info, ConsumerFunction consumer_function)
   if (info_.batch_size < kMinimumSize) {
     throw ConsumerFailedToInitializeException(info_.consumer_name, "Batch size has to be positive!");
   }
+  if (info_.partition_workers == 0) {
+    throw ConsumerFailedToInitializeException(info_.consumer_name, "Number of partition workers has to be positive!");
+  }
+  if (info_.adaptive_batching && info_.adaptive_batching->max_batch_size < kMinimumSize) {
+    throw ConsumerFailedToInitializeException(info_.consumer_name, "Maximum batch size has to be positive!");
+  }
+  if (info_.partition_workers > 1) {
+    workers_ = std::make_unique<utils::ThreadPool>(info_.partition_workers - 1);
+  }
 
   std::unique_ptr<RdKafka::Conf> conf(RdKafka::Conf::create(RdKafka::Conf::CONF_GLOBAL));
   if (conf == nullptr) {
@@ -336,7 +444,7 @@ void Consumer::Check(std::optional<std::chrono::milliseconds> timeout, std::opti
     if (now - start >= timeout_to_use) {
       throw ConsumerCheckFailedException(info_.consumer_name, "timeout reached");
     }
-    auto maybe_batch = GetBatch(*consumer_, info_, is_running_);
+    auto maybe_batch = GetBatch(*consumer_, info_, info_.batch_size, info_.batch_interval, is_running_);
 
     if (maybe_batch.HasError()) {
       throw ConsumerCheckFailedException(info_.consumer_name, maybe_batch.GetError());
@@ -362,6 +470,17 @@ bool Consumer::IsRunning() const { return is_running_; }
 
 const ConsumerInfo &Consumer::Info() const { return info_; }
 
+BatchStats Consumer::Stats() const {
+  return batching_.WithLock([](const auto &batching) { return batching.Stats(); });
+}
+
+void Consumer::UpdateBatching(const int64_t batch_size, const std::chrono::steady_clock::time_point start) const {
+  const auto latency =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  const auto lag = ConsumerLag(*consumer_);
+  batching_.WithLock([&](auto &batching) { batching.Update(batch_size, latency, lag); });
+}
+
 void Consumer::event_cb(RdKafka::Event &event) {
   switch (event.type()) {
     case RdKafka::Event::Type::EVENT_ERROR:
@@ -394,11 +513,13 @@ void Consumer::StartConsuming() {
     utils::ThreadSetName(full_thread_name.substr(0, kMaxThreadNameSize));
 
     while (is_running_) {
-      auto maybe_batch = GetBatch(*consumer_, info_, is_running_);
+      const auto [batch_size, batch_interval] = batching_.WithLock(
+          [](const auto &batching) { return std::pair{batching.BatchSize(), batching.BatchInterval()}; });
+      auto maybe_batch = GetBatch(*consumer_, info_, batch_size, batch_interval, is_running_);
       if (maybe_batch.HasError()) {
         throw ConsumerReadMessagesFailedException(info_.consumer_name, maybe_batch.GetError());
       }
-      const auto &batch = maybe_batch.GetValue();
+      auto &batch = maybe_batch.GetValue();
 
       if (batch.empty()) {
         continue;
@@ -406,12 +527,14 @@ void Consumer::StartConsuming() {
 
       spdlog::info("Kafka consumer {} is processing a batch", info_.consumer_name);
 
+      const auto start = std::chrono::steady_clock::now();
       try {
-        TryToConsumeBatch(*consumer_, info_, consumer_function_, batch);
+        TryToConsumeBatch(*consumer_, info_, consumer_function_, batch, workers_.get());
       } catch (const std::exception &e) {
         spdlog::warn("Error happened in consumer {} while processing a batch: {}!", info_.consumer_name, e.what());
         break;
       }
+      UpdateBatching(static_cast<int64_t>(batch.size()), start);
       spdlog::info("Kafka consumer {} finished processing", info_.consumer_name);
     }
     is_running_.store(false);
@@ -437,11 +560,13 @@ void Consumer::StartConsumingWithLimit(uint64_t limit_batches, std::optional<std
       throw ConsumerStartFailedException(info_.consumer_name, "Timeout reached");
     }
 
-    const auto maybe_batch = GetBatch(*consumer_, info_, is_running_);
+    const auto [batch_size, batch_interval] = batching_.WithLock(
+        [](const auto &batching) { return std::pair{batching.BatchSize(), batching.BatchInterval()}; });
+    auto maybe_batch = GetBatch(*consumer_, info_, batch_size, batch_interval, is_running_);
     if (maybe_batch.HasError()) {
       throw ConsumerReadMessagesFailedException(info_.consumer_name, maybe_batch.GetError());
     }
-    const auto &batch = maybe_batch.GetValue();
+    auto &batch = maybe_batch.GetValue();
 
     if (batch.empty()) {
       continue;
@@ -450,7 +575,9 @@ void Consumer::StartConsumingWithLimit(uint64_t limit_batches, std::optional<std
 
     spdlog::info("Kafka consumer {} is processing a batch", info_.consumer_name);
 
-    TryToConsumeBatch(*consumer_, info_, consumer_function_, batch);
+    const auto start = std::chrono::steady_clock::now();
+    TryToConsumeBatch(*consumer_, info_, consumer_function_, batch, workers_.get());
+    UpdateBatching(static_cast<int64_t>(batch.size()), start);
 
     spdlog::info("Kafka consumer {} finished processing", info_.consumer_name);
   }
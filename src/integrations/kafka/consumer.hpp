@@ -24,7 +24,11 @@
 
 #include <librdkafka/rdkafka.h>
 #include <librdkafka/rdkafkacpp.h>
+#include "integrations/adaptive_batching.hpp"
 #include "utils/result.hpp"
+#include "utils/spin_lock.hpp"
+#include "utils/synchronized.hpp"
+#include "utils/thread_pool.hpp"
 
 namespace memgraph::integrations::kafka {
 
@@ -72,6 +76,9 @@ class Message final {
   /// Returns the offset of the message
   int64_t Offset() const;
 
+  /// Returns the partition of the topic the message belongs to.
+  int32_t Partition() const;
+
  private:
   std::unique_ptr<RdKafka::Message> message_;
 };
@@ -88,6 +95,12 @@ struct ConsumerInfo {
   int64_t batch_size;
   std::unordered_map<std::string, std::string> public_configs{};
   std::unordered_map<std::string, std::string> private_configs{};
+  /// Number of workers which process the messages of a batch in parallel. The messages of a partition are always
+  /// processed by the same worker, so they are processed in order, while there is no ordering between partitions.
+  uint32_t partition_workers{1};
+  /// Bounds within which the size and the interval of the batches are tuned, starting from `batch_size` and
+  /// `batch_interval`. If not set, all batches use the configured size and interval.
+  std::optional<AdaptiveBatchingConfig> adaptive_batching{};
 };
 
 /// Memgraphs Kafka consumer wrapper.
@@ -161,6 +174,9 @@ class Consumer final : public RdKafka::EventCb {
 
   const ConsumerInfo &Info() const;
 
+  /// Returns the current batch size and interval, and the latency and the lag after the last processed batch.
+  BatchStats Stats() const;
+
  private:
   void event_cb(RdKafka::Event &event) override;
 
@@ -169,6 +185,9 @@ class Consumer final : public RdKafka::EventCb {
 
   void StopConsuming();
 
+  /// Records the batch of `batch_size` messages whose processing started at `start`.
+  void UpdateBatching(int64_t batch_size, std::chrono::steady_clock::time_point start) const;
+
   class ConsumerRebalanceCb : public RdKafka::RebalanceCb {
    public:
     ConsumerRebalanceCb(std::string consumer_name);
@@ -189,6 +208,9 @@ class Consumer final : public RdKafka::EventCb {
   mutable std::vector<RdKafka::TopicPartition *> last_assignment_;  // Protected by is_running_
   std::unique_ptr<RdKafka::KafkaConsumer, std::function<void(RdKafka::KafkaConsumer *)>> consumer_;
   std::thread thread_;
+  // Processes the parts of the batches if there is more than one partition worker.
+  std::unique_ptr<utils::ThreadPool> workers_;
+  mutable utils::Synchronized<AdaptiveBatching, utils::SpinLock> batching_;
   ConsumerRebalanceCb cb_;
 };
 }  // namespace memgraph::integrations::kafka
@@ -13,6 +13,11 @@
 #include <fcntl.h>
 #include <netinet/tcp.h>
 #include <poll.h>
+#include <sys/sendfile.h>
+
+#include <algorithm>
+#include <climits>
+#include <vector>
 
 #include "io/network/addrinfo.hpp"
 #include "io/network/socket.hpp"
@@ -220,6 +225,70 @@ bool Socket::Write(const std::string &s, bool have_more) {
   return Write(reinterpret_cast<const uint8_t *>(s.data()), s.size(), have_more);
 }
 
+bool Socket::WriteFile(int fd, uint64_t offset, size_t len) {
+  auto file_offset = static_cast<off_t>(offset);
+  while (len > 0) {
+    // `sendfile` advances `file_offset` by the number of the written bytes.
+    auto written = sendfile(socket_, fd, &file_offset, len);
+    if (written == -1) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        // Terminal error, return failure.
+        return false;
+      }
+      // Non-fatal error, retry after the socket is ready.
+      if (!WaitForReadyWrite()) return false;
+    } else if (written == 0) {
+      // The file is shorter than expected.
+      return false;
+    } else {
+      len -= written;
+    }
+  }
+  return true;
+}
+
+bool Socket::WriteVector(const iovec *iov, size_t iovcnt, bool have_more) {
+  constexpr unsigned msg_nosignal = MSG_NOSIGNAL;
+  constexpr unsigned msg_more = MSG_MORE;
+  const unsigned flags = msg_nosignal | (have_more ? msg_more : 0);
+  // The buffers are copied so that the partially written ones can be
+  // adjusted, at most `IOV_MAX` of them are written by one call.
+  std::vector<iovec> pending(iov, iov + iovcnt);
+  size_t first = 0;
+  while (first < pending.size()) {
+    if (pending[first].iov_len == 0) {
+      ++first;
+      continue;
+    }
+    msghdr msg{};
+    msg.msg_iov = pending.data() + first;
+    msg.msg_iovlen = std::min(pending.size() - first, static_cast<size_t>(IOV_MAX));
+    auto written = sendmsg(socket_, &msg, static_cast<int>(flags));
+    if (written == -1) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        // Terminal error, return failure.
+        return false;
+      }
+      // Non-fatal error, retry after the socket is ready.
+      if (!WaitForReadyWrite()) return false;
+    } else if (written == 0) {
+      // The client closed the connection.
+      return false;
+    } else {
+      auto left = static_cast<size_t>(written);
+      while (left > 0) {
+        auto &buffer = pending[first];
+        const auto consumed = std::min(left, buffer.iov_len);
+        buffer.iov_base = static_cast<uint8_t *>(buffer.iov_base) + consumed;
+        buffer.iov_len -= consumed;
+        left -= consumed;
+        if (buffer.iov_len == 0) ++first;
+      }
+    }
+  }
+  return true;
+}
+
 ssize_t Socket::Read(void *buffer, size_t len, bool nonblock) {
   return recv(socket_, buffer, len, nonblock ? MSG_DONTWAIT : 0);
 }
@@ -11,6 +11,9 @@
 
 #pragma once
 
+#include <sys/uio.h>
+
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <optional>
@@ -151,6 +154,38 @@ class Socket {
   bool Write(const uint8_t *data, size_t len, bool have_more = false);
   bool Write(const std::string &s, bool have_more = false);
 
+  /**
+   * Write data of a file to the socket with `sendfile`, so that the data is
+   * copied by the kernel without going through user space.
+   * This function guarantees that all data will be written.
+   *
+   * @param fd file descriptor of the file whose data should be written
+   * @param offset position in the file from which the data is written, the
+   * file position of the descriptor isn't changed
+   * @param len length of the data that should be written
+   *
+   * @return write success status:
+   *             true if write succeeded
+   *             false if write failed
+   */
+  bool WriteFile(int fd, uint64_t offset, size_t len);
+
+  /**
+   * Write a list of buffers to the socket with as few system calls as
+   * possible, without copying them into one buffer first.
+   * This function guarantees that all data will be written.
+   *
+   * @param iov buffers that should be written, in order
+   * @param iovcnt number of the buffers
+   * @param have_more set to true if you plan to send more data to allow the
+   * kernel to buffer the data instead of immediately sending it out
+   *
+   * @return write success status:
+   *             true if write succeeded
+   *             false if write failed
+   */
+  bool WriteVector(const iovec *iov, size_t iovcnt, bool have_more = false);
+
   /**
    * Read data from the socket.
    * This function is a direct wrapper for the read function.
@@ -31,7 +31,9 @@ LicenseInfoSender::LicenseInfoSender(std::string url, std::string uuid, std::str
       machine_id_{std::move(machine_id)},
       memory_limit_{memory_limit},
       license_info_{license_info} {
-  scheduler_.Run("LicenseCheck", request_frequency, [&] { SendData(); });
+  // Sending the data can wait for the network, so it doesn't hold up the workers of the other periodic tasks.
+  scheduler_.Run(
+      "LicenseCheck", request_frequency, [&] { SendData(); }, {.priority = utils::PeriodicTaskPriority::LOW});
 }
 
 LicenseInfoSender::~LicenseInfoSender() { scheduler_.Stop(); }
@@ -13,26 +13,34 @@
 #include "dbms/session_context_handler.hpp"
 #endif
 
+#include <thread>
+
 #include "audit/log.hpp"
 #include "communication/websocket/auth.hpp"
 #include "communication/websocket/server.hpp"
 #include "flags/all.hpp"
+#include "glue/ArrowServerT.hpp"
 #include "glue/MonitoringServerT.hpp"
 #include "glue/ServerT.hpp"
 #include "glue/auth_checker.hpp"
 #include "glue/auth_handler.hpp"
 #include "helpers.hpp"
 #include "license/license_sender.hpp"
+#include "memory/memory_control.hpp"
 #include "query/discard_value_stream.hpp"
+#include "query/plan_cache_warmup.hpp"
 #include "query/procedure/callable_alias_mapper.hpp"
 #include "query/procedure/module.hpp"
 #include "query/procedure/py_module.hpp"
 #include "requests/requests.hpp"
+#include "storage/v2/property_store.hpp"
 #include "telemetry/telemetry.hpp"
+#include "utils/file.hpp"
 #include "utils/signals.hpp"
 #include "utils/sysinfo/memory.hpp"
 #include "utils/system_info.hpp"
 #include "utils/terminate_handler.hpp"
+#include "utils/timer.hpp"
 #include "version.hpp"
 
 constexpr const char *kMgUser = "MEMGRAPH_USER";
@@ -202,6 +210,11 @@ int main(int argc, char **argv) {
   spdlog::info("Memory limit in config is set to {}", memgraph::utils::GetReadableSize(memory_limit));
   memgraph::utils::total_memory_tracker.SetMaximumHardLimit(memory_limit);
   memgraph::utils::total_memory_tracker.SetHardLimit(memory_limit);
+  memgraph::memory::SetPagePlacement(
+      {.huge_pages = FLAGS_memory_huge_pages, .numa_interleave = FLAGS_memory_numa_interleave});
+
+  // Temporary query files can be left over only if the previous run crashed.
+  memgraph::utils::DeleteDir(data_directory / "query_spill");
 
   memgraph::utils::global_settings.Initialize(data_directory / "settings");
   memgraph::utils::OnScopeExit settings_finalizer([&] { memgraph::utils::global_settings.Finalize(); });
@@ -231,7 +244,7 @@ int main(int argc, char **argv) {
 #ifdef MG_ENTERPRISE
   // Audit log
   memgraph::audit::Log audit_log{data_directory / "audit", FLAGS_audit_buffer_size,
-                                 FLAGS_audit_buffer_flush_interval_ms};
+                                 FLAGS_audit_buffer_flush_interval_ms, memgraph::flags::ParseAuditOverloadPolicy()};
   // Start the log if enabled.
   if (FLAGS_audit_enabled) {
     audit_log.Start();
@@ -245,22 +258,47 @@ int main(int argc, char **argv) {
   // End enterprise features initialization
 #endif
 
+  // The compression of property values is shared by all databases, so it's
+  // set once before any storage is created.
+  memgraph::storage::PropertyStore::EnableCompression(FLAGS_storage_property_store_compression_enabled);
+
   // Main storage and execution engines initialization
   memgraph::storage::Config db_config{
-      .gc = {.type = memgraph::storage::Config::Gc::Type::PERIODIC,
-             .interval = std::chrono::seconds(FLAGS_storage_gc_cycle_sec)},
-      .items = {.properties_on_edges = FLAGS_storage_properties_on_edges},
+      .gc = {.type = FLAGS_storage_gc_incremental ? memgraph::storage::Config::Gc::Type::INCREMENTAL
+                                                  : memgraph::storage::Config::Gc::Type::PERIODIC,
+             .interval = std::chrono::seconds(FLAGS_storage_gc_cycle_sec),
+             .threads = FLAGS_storage_gc_threads},
+      .items = {.properties_on_edges = FLAGS_storage_properties_on_edges, .light_edges = FLAGS_storage_light_edges},
       .durability = {.storage_directory = FLAGS_data_directory,
                      .recover_on_startup = FLAGS_storage_recover_on_startup || FLAGS_data_recovery_on_startup,
                      .snapshot_retention_count = FLAGS_storage_snapshot_retention_count,
+                     .snapshot_min_changed_percent = FLAGS_storage_snapshot_min_changed_percent,
+                     .snapshot_compression = FLAGS_storage_snapshot_compression,
+                     .snapshot_write_rate_limit_mib = FLAGS_storage_snapshot_write_rate_limit_mib,
+                     .snapshot_low_priority = FLAGS_storage_snapshot_low_priority,
                      .wal_file_size_kibibytes = FLAGS_storage_wal_file_size_kib,
                      .wal_file_flush_every_n_tx = FLAGS_storage_wal_file_flush_every_n_tx,
+                     .wal_segment_pool_size = FLAGS_storage_wal_segment_pool_size,
+                     .wal_group_commit = FLAGS_storage_wal_group_commit,
+                     .async_writeback = FLAGS_storage_async_writeback,
                      .snapshot_on_exit = FLAGS_storage_snapshot_on_exit,
                      .restore_replication_state_on_startup = FLAGS_replication_restore_state_on_startup,
+                     .replication_sync_quorum = FLAGS_replication_sync_quorum,
+                     .replication_max_retained_wal_files = FLAGS_replication_max_retained_wal_files,
                      .items_per_batch = FLAGS_storage_items_per_batch,
                      .recovery_thread_count = FLAGS_storage_recovery_thread_count,
-                     .allow_parallel_index_creation = FLAGS_storage_parallel_index_recovery},
+                     .snapshot_recovery_mmap = FLAGS_storage_snapshot_recovery_mmap,
+                     .allow_parallel_index_creation = FLAGS_storage_parallel_index_recovery,
+                     .allow_parallel_snapshot_creation = FLAGS_storage_parallel_snapshot_creation,
+                     .allow_parallel_wal_recovery = FLAGS_storage_parallel_wal_recovery},
       .transaction = {.isolation_level = memgraph::flags::ParseIsolationLevel()},
+      .constraints = {.unique_hash_index = FLAGS_storage_unique_constraints_hash_index},
+      .index_stats = {.refresh_threshold = FLAGS_storage_index_stats_refresh_threshold,
+                      .refresh_interval = std::chrono::seconds(FLAGS_storage_index_stats_refresh_interval_sec)},
+      .defragmentation = {.budget = FLAGS_storage_defragmentation_budget,
+                          .interval = std::chrono::seconds(FLAGS_storage_defragmentation_interval_sec)},
+      .tiering = {.budget = FLAGS_storage_tiering_budget,
+                  .interval = std::chrono::seconds(FLAGS_storage_tiering_interval_sec)},
       .disk = {.main_storage_directory = FLAGS_data_directory + "/rocksdb_main_storage",
                .label_index_directory = FLAGS_data_directory + "/rocksdb_label_index",
                .label_property_index_directory = FLAGS_data_directory + "/rocksdb_label_property_index",
@@ -268,7 +306,12 @@ int main(int argc, char **argv) {
                .name_id_mapper_directory = FLAGS_data_directory + "/rocksdb_name_id_mapper",
                .id_name_mapper_directory = FLAGS_data_directory + "/rocksdb_id_name_mapper",
                .durability_directory = FLAGS_data_directory + "/rocksdb_durability",
-               .wal_directory = FLAGS_data_directory + "/rocksdb_wal"}};
+               .wal_directory = FLAGS_data_directory + "/rocksdb_wal",
+               .block_cache_size_mib = FLAGS_storage_disk_block_cache_size_mib,
+               .bloom_filter_bits_per_key = FLAGS_storage_disk_bloom_filter_bits_per_key,
+               .universal_compaction = FLAGS_storage_disk_universal_compaction,
+               .object_cache_size = FLAGS_storage_disk_object_cache_size,
+               .pipelined_write = FLAGS_storage_disk_pipelined_write}};
   if (FLAGS_storage_snapshot_interval_sec == 0) {
     if (FLAGS_storage_wal_enabled) {
       LOG_FATAL(
@@ -290,13 +333,46 @@ int main(int argc, char **argv) {
 
   // Default interpreter configuration
   memgraph::query::InterpreterConfig interp_config{
-      .query = {.allow_load_csv = FLAGS_allow_load_csv},
+      .query = {.allow_load_csv = FLAGS_allow_load_csv,
+                .parallel_execution_threads = FLAGS_query_parallel_execution_threads != 0
+                                                  ? FLAGS_query_parallel_execution_threads
+                                                  : std::max<uint64_t>(std::thread::hardware_concurrency(), 1),
+                .spill_memory_limit = FLAGS_query_spill_memory_limit_mb * 1024 * 1024,
+                .spill_directory = data_directory / "query_spill",
+                .procedure_result_buffer_size = FLAGS_query_procedure_result_buffer_size,
+                .commutative_increments = FLAGS_query_commutative_increments,
+                .database_memory_limit = FLAGS_query_database_memory_limit_mb * 1024 * 1024,
+                .transaction_memory_limit = FLAGS_query_transaction_memory_limit_mb * 1024 * 1024,
+                .stats_max_queries = FLAGS_query_stats_max_queries,
+                .slow_query_threshold = std::chrono::milliseconds(FLAGS_query_slow_log_threshold_ms),
+                .slow_query_log_size = FLAGS_query_slow_log_size,
+                .result_cache_size = FLAGS_query_result_cache_size,
+                .result_cache_max_rows = FLAGS_query_result_cache_max_rows},
+      .admission = {.max_concurrent_queries = FLAGS_query_admission_max_concurrent,
+                    .max_concurrent_queries_per_user = FLAGS_query_admission_max_concurrent_per_user,
+                    .max_memory_in_flight = FLAGS_query_admission_max_memory_mb * 1024 * 1024,
+                    .max_memory_in_flight_per_user = FLAGS_query_admission_max_memory_per_user_mb * 1024 * 1024,
+                    .default_query_memory = FLAGS_query_admission_default_memory_mb * 1024 * 1024,
+                    .max_queue_size = FLAGS_query_admission_queue_size,
+                    .queue_timeout = std::chrono::milliseconds(FLAGS_query_admission_timeout_ms)},
       .execution_timeout_sec = FLAGS_query_execution_timeout_sec,
       .replication_replica_check_frequency = std::chrono::seconds(FLAGS_replication_replica_check_frequency_sec),
+      .replication_compression = FLAGS_replication_compression,
+      .bookmark_wait_timeout = std::chrono::milliseconds(FLAGS_query_bookmark_wait_timeout_ms),
+      .after_commit_trigger_workers = FLAGS_trigger_after_commit_workers,
+      .after_commit_trigger_max_backlog = FLAGS_trigger_after_commit_max_backlog,
       .default_kafka_bootstrap_servers = FLAGS_kafka_bootstrap_servers,
+      .kafka_partition_workers = static_cast<uint32_t>(FLAGS_kafka_partition_workers),
+      .kafka_adaptive_batching =
+          FLAGS_kafka_adaptive_batching
+              ? std::make_optional(memgraph::integrations::AdaptiveBatchingConfig{
+                    .max_batch_size = FLAGS_kafka_adaptive_batching_max_size,
+                    .target_latency = std::chrono::milliseconds(FLAGS_kafka_adaptive_batching_target_latency_ms)})
+              : std::nullopt,
       .default_pulsar_service_url = FLAGS_pulsar_service_url,
       .stream_transaction_conflict_retries = FLAGS_stream_transaction_conflict_retries,
-      .stream_transaction_retry_interval = std::chrono::milliseconds(FLAGS_stream_transaction_retry_interval)};
+      .stream_transaction_retry_interval = std::chrono::milliseconds(FLAGS_stream_transaction_retry_interval),
+      .stream_batch_queries = FLAGS_stream_batch_queries};
 
   auto auth_glue =
       [flag = FLAGS_auth_user_or_role_name_regex](
@@ -342,7 +418,13 @@ int main(int argc, char **argv) {
 
   memgraph::query::procedure::gModuleRegistry.SetModulesDirectory(memgraph::flags::ParseQueryModulesDirectory(),
                                                                   FLAGS_data_directory);
+  memgraph::query::procedure::gModuleRegistry.SetLazyLoading(FLAGS_query_modules_lazy_loading);
   memgraph::query::procedure::gModuleRegistry.UnloadAndLoadModulesFromDirectories();
+  std::jthread modules_warmup;
+  if (FLAGS_query_modules_lazy_loading && FLAGS_query_modules_warmup_threads > 0) {
+    modules_warmup = std::jthread(
+        [] { memgraph::query::procedure::gModuleRegistry.LoadLazyModules(FLAGS_query_modules_warmup_threads); });
+  }
   memgraph::query::procedure::gCallableAliasMapper.LoadMapping(FLAGS_query_callable_mappings_path);
 
   if (!FLAGS_init_file.empty()) {
@@ -375,10 +457,51 @@ int main(int argc, char **argv) {
   interpreter_context.streams.RestoreStreams();
 #endif
 
+  // The queries executed the most before the restart are planned before the
+  // Bolt server accepts connections, so that the clients don't wait for all of
+  // them to be parsed and planned at once after a restart or a failover.
+  const auto plan_cache_warmup_file = FLAGS_query_plan_cache_warmup_file.empty()
+                                          ? data_directory / "plan_cache_warmup.json"
+                                          : std::filesystem::path(FLAGS_query_plan_cache_warmup_file);
+  std::vector<memgraph::query::WarmUpQuery> warmup_queries;
+  if (FLAGS_query_plan_cache_warmup_queries > 0) {
+    memgraph::utils::Timer timer;
+    warmup_queries = memgraph::query::LoadWarmUpQueries(plan_cache_warmup_file);
+    if (warmup_queries.size() > FLAGS_query_plan_cache_warmup_queries) {
+      warmup_queries.resize(FLAGS_query_plan_cache_warmup_queries);
+    }
+    if (!warmup_queries.empty()) {
+      const auto planned = memgraph::query::WarmUpPlanCache(&interpreter_context, warmup_queries,
+                                                            interp_config.query.parallel_execution_threads);
+      spdlog::info("Planned {} of the {} saved queries in {:.3f}s.", planned, warmup_queries.size(),
+                   timer.Elapsed().count());
+    }
+  }
+  // Only MAIN saves its queries, so that a REPLICA which loads the file saved
+  // by its MAIN doesn't overwrite it.
+  auto save_warmup_queries = [&interpreter_context, &plan_cache_warmup_file, &warmup_queries] {
+    if (interpreter_context.db->GetReplicationRole() != memgraph::storage::replication::ReplicationRole::MAIN) return;
+    if (!memgraph::query::SaveWarmUpQueries(
+            plan_cache_warmup_file,
+            memgraph::query::HottestQueries(FLAGS_query_plan_cache_warmup_queries, warmup_queries))) {
+      spdlog::warn("Couldn't save the queries planned at startup to {}.", plan_cache_warmup_file.string());
+    }
+  };
+  memgraph::utils::Scheduler warmup_queries_scheduler;
+  if (FLAGS_query_plan_cache_warmup_queries > 0) {
+    warmup_queries_scheduler.Run("Plan cache warm-up",
+                                 std::chrono::seconds(FLAGS_query_plan_cache_warmup_save_interval_sec),
+                                 save_warmup_queries);
+  }
+
   ServerContext context;
   std::string service_name = "Bolt";
   if (!FLAGS_bolt_key_file.empty() && !FLAGS_bolt_cert_file.empty()) {
     context = ServerContext(FLAGS_bolt_key_file, FLAGS_bolt_cert_file);
+    context.SetSessionResumption(std::chrono::seconds(FLAGS_bolt_tls_session_timeout_sec));
+    if (FLAGS_bolt_tls_kernel_offload && !context.EnableKernelTLS()) {
+      spdlog::warn("The OpenSSL library doesn't support kernel TLS, the Bolt connections are encrypted by Memgraph.");
+    }
     service_name = "BoltS";
     spdlog::info("Using secure Bolt connection (with SSL)");
   } else {
@@ -389,10 +512,14 @@ int main(int argc, char **argv) {
       boost::asio::ip::address::from_string(FLAGS_bolt_address), static_cast<uint16_t>(FLAGS_bolt_port)};
 #ifdef MG_ENTERPRISE
   memgraph::glue::ServerT server(server_endpoint, &sc_handler, &context, FLAGS_bolt_session_inactivity_timeout,
-                                 service_name, FLAGS_bolt_num_workers);
+                                 service_name, FLAGS_bolt_num_workers, FLAGS_bolt_num_io_workers,
+                                 std::chrono::milliseconds(FLAGS_bolt_long_execution_threshold_ms),
+                                 FLAGS_bolt_io_thread_per_core, FLAGS_bolt_pin_workers_to_numa_nodes);
 #else
   memgraph::glue::ServerT server(server_endpoint, &session_context, &context, FLAGS_bolt_session_inactivity_timeout,
-                                 service_name, FLAGS_bolt_num_workers);
+                                 service_name, FLAGS_bolt_num_workers, FLAGS_bolt_num_io_workers,
+                                 std::chrono::milliseconds(FLAGS_bolt_long_execution_threshold_ms),
+                                 FLAGS_bolt_io_thread_per_core, FLAGS_bolt_pin_workers_to_numa_nodes);
 #endif
 
   const auto machine_id = memgraph::utils::GetMachineId();
@@ -437,13 +564,21 @@ int main(int argc, char **argv) {
   memgraph::glue::MonitoringServerT metrics_server{
       {FLAGS_metrics_address, static_cast<uint16_t>(FLAGS_metrics_port)}, &session_context, &context};
 
+  std::optional<memgraph::glue::ArrowServerT> arrow_server;
+  if (FLAGS_arrow_port != 0) {
+    arrow_server.emplace(
+        memgraph::io::network::Endpoint{FLAGS_arrow_address, static_cast<uint16_t>(FLAGS_arrow_port)},
+        &session_context, &context);
+  }
+
 #ifdef MG_ENTERPRISE
   if (memgraph::license::global_license_checker.IsEnterpriseValidFast()) {
     // Handler for regular termination signals
-    auto shutdown = [&metrics_server, &websocket_server, &server, &sc_handler] {
+    auto shutdown = [&metrics_server, &arrow_server, &websocket_server, &server, &sc_handler] {
       // Server needs to be shutdown first and then the database. This prevents
       // a race condition when a transaction is accepted during server shutdown.
       server.Shutdown();
+      if (arrow_server) arrow_server->Shutdown();
       // After the server is notified to stop accepting and processing
       // connections we tell the execution engine to stop processing all pending
       // queries.
@@ -456,10 +591,11 @@ int main(int argc, char **argv) {
     InitSignalHandlers(shutdown);
   } else {
     // Handler for regular termination signals
-    auto shutdown = [&websocket_server, &server, &interpreter_context] {
+    auto shutdown = [&arrow_server, &websocket_server, &server, &interpreter_context] {
       // Server needs to be shutdown first and then the database. This prevents
       // a race condition when a transaction is accepted during server shutdown.
       server.Shutdown();
+      if (arrow_server) arrow_server->Shutdown();
       // After the server is notified to stop accepting and processing
       // connections we tell the execution engine to stop processing all pending
       // queries.
@@ -472,10 +608,11 @@ int main(int argc, char **argv) {
   }
 #else
   // Handler for regular termination signals
-  auto shutdown = [&websocket_server, &server, &interpreter_context] {
+  auto shutdown = [&arrow_server, &websocket_server, &server, &interpreter_context] {
     // Server needs to be shutdown first and then the database. This prevents
     // a race condition when a transaction is accepted during server shutdown.
     server.Shutdown();
+    if (arrow_server) arrow_server->Shutdown();
     // After the server is notified to stop accepting and processing
     // connections we tell the execution engine to stop processing all pending
     // queries.
@@ -489,6 +626,7 @@ int main(int argc, char **argv) {
 
   MG_ASSERT(server.Start(), "Couldn't start the Bolt server!");
   websocket_server.Start();
+  if (arrow_server) arrow_server->Start();
 
 #ifdef MG_ENTERPRISE
   if (memgraph::license::global_license_checker.IsEnterpriseValidFast()) {
@@ -511,12 +649,19 @@ int main(int argc, char **argv) {
 
   server.AwaitShutdown();
   websocket_server.AwaitShutdown();
+  if (arrow_server) arrow_server->AwaitShutdown();
 #ifdef MG_ENTERPRISE
   if (memgraph::license::global_license_checker.IsEnterpriseValidFast()) {
     metrics_server.AwaitShutdown();
   }
 #endif
 
+  if (FLAGS_query_plan_cache_warmup_queries > 0) {
+    warmup_queries_scheduler.Stop();
+    save_warmup_queries();
+  }
+
+  if (modules_warmup.joinable()) modules_warmup.join();
   memgraph::query::procedure::gModuleRegistry.UnloadAllModules();
 
   Py_END_ALLOW_THREADS;
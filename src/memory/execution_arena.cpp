@@ -0,0 +1,142 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "memory/execution_arena.hpp"
+
+#include <cstddef>
+#include <optional>
+
+#if USE_JEMALLOC
+#include <jemalloc/jemalloc.h>
+#endif
+
+#include <fmt/format.h>
+
+#include "utils/logging.hpp"
+#include "utils/memory_tracker.hpp"
+
+namespace memgraph::memory {
+
+#if USE_JEMALLOC
+namespace {
+
+// Unused dirty pages of the arena are returned to the OS after this time. It's
+// shorter than jemalloc's default of 10s, since the memory of a finished query
+// isn't necessarily needed again soon.
+constexpr ssize_t kDirtyDecayMillis = 1000;
+
+std::optional<unsigned> CreateArena() {
+  unsigned arena = 0;
+  size_t arena_size = sizeof(arena);
+  if (mallctl("arenas.create", &arena, &arena_size, nullptr, 0) != 0) {
+    spdlog::warn("Couldn't create the jemalloc arena for the query execution memory.");
+    return std::nullopt;
+  }
+  auto decay = kDirtyDecayMillis;
+  const auto decay_name = fmt::format("arena.{}.dirty_decay_ms", arena);
+  if (mallctl(decay_name.c_str(), nullptr, nullptr, &decay, sizeof(decay)) != 0) {
+    spdlog::warn("Couldn't set the dirty decay of the jemalloc arena for the query execution memory.");
+  }
+  return arena;
+}
+
+// Set when the cache of the thread is destroyed, after which the memory the
+// thread frees while it exits bypasses the cache.
+thread_local bool thread_cache_destroyed{false};
+
+// Explicit thread cache which caches only the memory of the arena, unlike
+// the automatic cache of the thread which caches the memory of all arenas.
+class ThreadCache {
+ public:
+  ThreadCache() {
+    size_t id_size = sizeof(id_);
+    if (mallctl("tcache.create", &id_, &id_size, nullptr, 0) == 0) {
+      flags_ = MALLOCX_TCACHE(id_);  // NOLINT(hicpp-signed-bitwise)
+    }
+  }
+
+  ThreadCache(const ThreadCache &) = delete;
+  ThreadCache &operator=(const ThreadCache &) = delete;
+  ThreadCache(ThreadCache &&) = delete;
+  ThreadCache &operator=(ThreadCache &&) = delete;
+
+  ~ThreadCache() {
+    thread_cache_destroyed = true;
+    if (flags_ != MALLOCX_TCACHE_NONE) {
+      mallctl("tcache.destroy", nullptr, nullptr, &id_, sizeof(id_));
+    }
+  }
+
+  int Flags() const { return flags_; }
+
+ private:
+  unsigned id_{0};
+  int flags_{MALLOCX_TCACHE_NONE};
+};
+
+class ArenaMemoryResource final : public utils::MemoryResource {
+ public:
+  explicit ArenaMemoryResource(unsigned arena) : arena_flags_(MALLOCX_ARENA(arena)) {}
+
+ private:
+  int Flags(size_t alignment) const {
+    // NOLINTNEXTLINE(hicpp-signed-bitwise)
+    return arena_flags_ | CacheFlags() | MALLOCX_ALIGN(alignment);
+  }
+
+  static int CacheFlags() {
+    if (thread_cache_destroyed) return MALLOCX_TCACHE_NONE;
+    thread_local const ThreadCache thread_cache;
+    return thread_cache.Flags();
+  }
+
+  void *DoAllocate(size_t bytes, size_t alignment) override {
+    const auto flags = Flags(alignment);
+    const auto size = static_cast<int64_t>(nallocx(bytes, flags));
+    utils::total_memory_tracker.Alloc(size);
+    auto *ptr = mallocx(bytes, flags);
+    if (ptr == nullptr) [[unlikely]] {
+      utils::total_memory_tracker.Free(size);
+      throw utils::BadAlloc("Failed to allocate query execution memory");
+    }
+    return ptr;
+  }
+
+  void DoDeallocate(void *ptr, size_t bytes, size_t alignment) override {
+    const auto flags = Flags(alignment);
+    utils::total_memory_tracker.Free(static_cast<int64_t>(nallocx(bytes, flags)));
+    sdallocx(ptr, bytes, flags);
+  }
+
+  bool DoIsEqual(const utils::MemoryResource &other) const noexcept override { return this == &other; }
+
+  int arena_flags_;
+};
+
+}  // namespace
+#endif
+
+utils::MemoryResource *ExecutionArenaResource() {
+#if USE_JEMALLOC
+  static utils::MemoryResource *const resource = []() -> utils::MemoryResource * {
+    const auto arena = CreateArena();
+    if (!arena) return utils::NewDeleteResource();
+    // Never destroyed, since the memory of the queries may be freed at any
+    // point of the shutdown.
+    return new ArenaMemoryResource(*arena);  // NOLINT(cppcoreguidelines-owning-memory)
+  }();
+  return resource;
+#else
+  return utils::NewDeleteResource();
+#endif
+}
+
+}  // namespace memgraph::memory
@@ -0,0 +1,32 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include "utils/memory.hpp"
+
+namespace memgraph::memory {
+
+/// Returns the resource allocating the execution memory of queries.
+///
+/// With jemalloc, the memory comes from a jemalloc arena which is used only
+/// for the execution memory, through a cache of each thread which is also
+/// used only for it. The short-lived allocations of queries then don't share
+/// pages with the long-lived objects of the storage, which would otherwise be
+/// kept from being returned to the OS, and the memory returned by finished
+/// queries is released sooner than the storage's. The allocations are tracked
+/// in `utils::total_memory_tracker` like the ones made with `new`.
+///
+/// Without jemalloc, or if the arena can't be created, `NewDeleteResource()`
+/// is returned.
+utils::MemoryResource *ExecutionArenaResource();
+
+}  // namespace memgraph::memory
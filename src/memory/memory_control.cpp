@@ -11,10 +11,24 @@
 
 #include "memory_control.hpp"
 
+#include <climits>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <vector>
+
 #if USE_JEMALLOC
 #include <jemalloc/jemalloc.h>
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #endif
 
+#include "utils/logging.hpp"
+#include "utils/memory_tracker.hpp"
+#include "utils/thread.hpp"
+
 namespace memgraph::memory {
 
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
@@ -28,6 +42,131 @@ void PurgeUnusedMemory() {
 #endif
 }
 
+bool IsFragmentedAllocation([[maybe_unused]] const void *ptr) {
+#if USE_JEMALLOC
+  // The layout of the output of `experimental.utilization.query`.
+  struct {
+    size_t nfree;
+    size_t nregs;
+    size_t size;
+    size_t bin_nfree;
+    size_t bin_nregs;
+  } utilization{};
+  size_t utilization_size = sizeof(utilization);
+  if (mallctl("experimental.utilization.query", &utilization, &utilization_size, &ptr, sizeof(ptr)) != 0) {
+    return false;
+  }
+  // The large allocations have their own extents and the full slabs can't be
+  // released anyway.
+  if (utilization.nregs <= 1 || utilization.nfree == 0) return false;
+  if (utilization.bin_nregs == 0) {
+    // The bin statistics are only available if jemalloc keeps the statistics.
+    return utilization.nfree * 2 > utilization.nregs;
+  }
+  // The slab is used less than the average slab of the bin.
+  return (utilization.nregs - utilization.nfree) * utilization.bin_nregs <
+         (utilization.bin_nregs - utilization.bin_nfree) * utilization.nregs;
+#else
+  return false;
+#endif
+}
+
+void *AllocateForRelocation(const size_t size) {
+#if USE_JEMALLOC
+  // The allocation is released with `operator delete[]` from new_delete.cpp,
+  // which frees it with `dallocx` and untracks `sallocx` bytes. Freeing memory
+  // from `mallocx` with `dallocx` is valid whatever the flags of the
+  // allocation were, so only the tracking has to match `operator new[]`.
+  auto *ptr = mallocx(size, MALLOCX_TCACHE_NONE);
+  if (ptr == nullptr) return nullptr;
+  const auto allocated = static_cast<int64_t>(sallocx(ptr, 0));
+  try {
+    utils::total_memory_tracker.Alloc(allocated);
+    try {
+      utils::MemoryTracker::ThreadScope::Alloc(allocated);
+    } catch (...) {
+      utils::total_memory_tracker.Free(allocated);
+      throw;
+    }
+  } catch (...) {
+    dallocx(ptr, MALLOCX_TCACHE_NONE);
+    return nullptr;
+  }
+  return ptr;
+#else
+  return new (std::nothrow) uint8_t[size];
+#endif
+}
+
+#if USE_JEMALLOC
+namespace {
+// Set once by `SetPagePlacement`, before the hooks are installed.
+PagePlacement page_placement;
+std::vector<unsigned long> numa_nodes_mask;  // NOLINT(google-runtime-int)
+extent_hooks_t placement_hooks;
+extent_alloc_t *default_extent_alloc{nullptr};
+
+void *PlacementExtentAlloc(extent_hooks_t *extent_hooks, void *new_addr, size_t size, size_t alignment, bool *zero,
+                           bool *commit, unsigned arena_ind) {
+  auto *ptr = default_extent_alloc(extent_hooks, new_addr, size, alignment, zero, commit, arena_ind);
+  if (ptr == nullptr) return ptr;
+  // jemalloc retains the extents it maps and grows the mappings
+  // geometrically, so most of them are large enough for huge pages. The advice
+  // and the policy only affect the pages which aren't faulted in yet. Their
+  // failures are ignored since the memory is usable either way.
+  if (page_placement.huge_pages) madvise(ptr, size, MADV_HUGEPAGE);
+  if (!numa_nodes_mask.empty()) {
+    const auto max_node = numa_nodes_mask.size() * sizeof(numa_nodes_mask[0]) * CHAR_BIT;
+    syscall(SYS_mbind, ptr, size, MPOL_INTERLEAVE, numa_nodes_mask.data(), max_node, 0);
+  }
+  return ptr;
+}
+}  // namespace
+#endif
+
+void SetPagePlacement([[maybe_unused]] const PagePlacement placement) {
+#if USE_JEMALLOC
+  if (!placement.huge_pages && !placement.numa_interleave) return;
+  MG_ASSERT(default_extent_alloc == nullptr, "The page placement can be set only once!");
+  page_placement = placement;
+  if (placement.numa_interleave) {
+    const auto nodes = utils::NumaNodesWithMemory();
+    if (nodes.size() > 1) {
+      constexpr size_t kBitsPerWord = sizeof(unsigned long) * CHAR_BIT;  // NOLINT(google-runtime-int)
+      for (const auto node : nodes) {
+        const auto word = static_cast<size_t>(node) / kBitsPerWord;
+        if (numa_nodes_mask.size() <= word) numa_nodes_mask.resize(word + 1, 0);
+        numa_nodes_mask[word] |= 1UL << (static_cast<size_t>(node) % kBitsPerWord);
+      }
+    } else {
+      spdlog::info("The memory isn't interleaved because there is only one NUMA node with memory.");
+    }
+  }
+
+  // All arenas start with the default hooks, which don't depend on the hooks
+  // they are called with, so one copy of them is shared by all arenas.
+  extent_hooks_t *default_hooks{nullptr};
+  size_t hooks_size = sizeof(default_hooks);
+  unsigned arenas_count{0};
+  size_t arenas_count_size = sizeof(arenas_count);
+  if (mallctl("arena.0.extent_hooks", &default_hooks, &hooks_size, nullptr, 0) != 0 ||
+      mallctl("arenas.narenas", &arenas_count, &arenas_count_size, nullptr, 0) != 0) {
+    spdlog::warn("Couldn't read the extent hooks of jemalloc, the page placement isn't changed.");
+    return;
+  }
+  placement_hooks = *default_hooks;
+  default_extent_alloc = default_hooks->alloc;
+  placement_hooks.alloc = PlacementExtentAlloc;
+  auto *hooks = &placement_hooks;
+  for (unsigned i = 0; i < arenas_count; ++i) {
+    const auto name = "arena." + std::to_string(i) + ".extent_hooks";
+    if (mallctl(name.c_str(), nullptr, nullptr, &hooks, sizeof(hooks)) != 0) {
+      spdlog::warn("Couldn't set the extent hooks of the jemalloc arena {}.", i);
+    }
+  }
+#endif
+}
+
 #undef STRINGIFY
 #undef STRINGIFY_HELPER
 }  // namespace memgraph::memory
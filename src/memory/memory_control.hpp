@@ -11,6 +11,35 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace memgraph::memory {
 void PurgeUnusedMemory();
+
+/// Returns whether the small allocation at `ptr` is in an extent which is
+/// used less than the average extent of its size class, so moving it to an
+/// allocation made by `AllocateForRelocation` helps the allocator to release
+/// the extent. Always false without jemalloc.
+bool IsFragmentedAllocation(const void *ptr);
+
+/// Allocates `size` bytes which replace an allocation in a fragmented extent.
+/// The allocation bypasses the thread cache, which would likely return a
+/// region of the extent which is being emptied. It is released with `delete[]`
+/// like a `uint8_t` array and is tracked by the memory trackers the same way.
+/// Returns nullptr if the memory couldn't be allocated.
+void *AllocateForRelocation(size_t size);
+
+/// How the pages of the memory mapped by the allocator are placed.
+struct PagePlacement {
+  // Advise the kernel to back the mappings with transparent huge pages.
+  bool huge_pages{false};
+  // Interleave the pages of the mappings across all NUMA nodes with memory.
+  bool numa_interleave{false};
+};
+
+/// Applies `placement` to the memory which jemalloc maps from now on, by
+/// hooking the extent allocation of all arenas. Has to be called once, before
+/// the graph is loaded, since the memory mapped before isn't changed. No-op
+/// without jemalloc.
+void SetPagePlacement(PagePlacement placement);
 }  // namespace memgraph::memory
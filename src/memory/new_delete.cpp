@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -86,13 +86,29 @@ void deleteSized(void *ptr, const std::size_t /*unused*/) noexcept { free(ptr);
 void deleteSized(void *ptr, const std::size_t /*unused*/, const std::align_val_t /*unused*/) noexcept { free(ptr); }
 #endif
 
+// Tracks the allocation globally and in the tracker of the thread's scope.
+void TrackAllocation(const int64_t size) {
+  memgraph::utils::total_memory_tracker.Alloc(size);
+  try {
+    memgraph::utils::MemoryTracker::ThreadScope::Alloc(size);
+  } catch (...) {
+    memgraph::utils::total_memory_tracker.Free(size);
+    throw;
+  }
+}
+
+void UntrackAllocation(const int64_t size) {
+  memgraph::utils::total_memory_tracker.Free(size);
+  memgraph::utils::MemoryTracker::ThreadScope::Free(size);
+}
+
 void TrackMemory(std::size_t size) {
 #if USE_JEMALLOC
   if (size != 0) [[likely]] {
     size = nallocx(size, 0);
   }
 #endif
-  memgraph::utils::total_memory_tracker.Alloc(static_cast<int64_t>(size));
+  TrackAllocation(static_cast<int64_t>(size));
 }
 
 void TrackMemory(std::size_t size, const std::align_val_t align) {
@@ -101,7 +117,7 @@ void TrackMemory(std::size_t size, const std::align_val_t align) {
     size = nallocx(size, MALLOCX_ALIGN(align));  // NOLINT(hicpp-signed-bitwise)
   }
 #endif
-  memgraph::utils::total_memory_tracker.Alloc(static_cast<int64_t>(size));
+  TrackAllocation(static_cast<int64_t>(size));
 }
 
 bool TrackMemoryNoExcept(const std::size_t size) {
@@ -128,14 +144,14 @@ void UntrackMemory([[maybe_unused]] void *ptr, [[maybe_unused]] std::size_t size
   try {
 #if USE_JEMALLOC
     if (ptr != nullptr) [[likely]] {
-      memgraph::utils::total_memory_tracker.Free(sallocx(ptr, 0));
+      UntrackAllocation(static_cast<int64_t>(sallocx(ptr, 0)));
     }
 #else
     if (size) {
-      memgraph::utils::total_memory_tracker.Free(static_cast<int64_t>(size));
+      UntrackAllocation(static_cast<int64_t>(size));
     } else {
       // Innaccurate because malloc_usable_size() result is greater or equal to allocated size.
-      memgraph::utils::total_memory_tracker.Free(static_cast<int64_t>(malloc_usable_size(ptr)));
+      UntrackAllocation(static_cast<int64_t>(malloc_usable_size(ptr)));
     }
 #endif
   } catch (...) {
@@ -146,14 +162,14 @@ void UntrackMemory(void *ptr, const std::align_val_t align, [[maybe_unused]] std
   try {
 #if USE_JEMALLOC
     if (ptr != nullptr) [[likely]] {
-      memgraph::utils::total_memory_tracker.Free(sallocx(ptr, MALLOCX_ALIGN(align)));  // NOLINT(hicpp-signed-bitwise)
+      UntrackAllocation(static_cast<int64_t>(sallocx(ptr, MALLOCX_ALIGN(align))));  // NOLINT(hicpp-signed-bitwise)
     }
 #else
     if (size) {
-      memgraph::utils::total_memory_tracker.Free(static_cast<int64_t>(size));
+      UntrackAllocation(static_cast<int64_t>(size));
     } else {
       // Innaccurate because malloc_usable_size() result is greater or equal to allocated size.
-      memgraph::utils::total_memory_tracker.Free(static_cast<int64_t>(malloc_usable_size(ptr)));
+      UntrackAllocation(static_cast<int64_t>(malloc_usable_size(ptr)));
     }
 #endif
   } catch (...) {
@@ -14,9 +14,22 @@
 #include <algorithm>
 #include <cstdio>
 #include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
 #include <fstream>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <queue>
 #include <regex>
+#include <thread>
 #include <unordered_map>
 
 #include "helpers.hpp"
@@ -24,6 +37,8 @@
 #include "storage/v2/edge_accessor.hpp"
 #include "storage/v2/inmemory/storage.hpp"
 #include "utils/exceptions.hpp"
+#include "utils/file.hpp"
+#include "utils/flag_validation.hpp"
 #include "utils/logging.hpp"
 #include "utils/message.hpp"
 #include "utils/string.hpp"
@@ -95,6 +110,13 @@ DEFINE_string(relationships, "",
               "specified for the relationship files. The flag can be specified multiple "
               "times (useful for differently formatted relationship files). The format "
               "of this argument is: [<type>=]<file>[,<file>][,<file>]...");
+DEFINE_bool(store_node_ids_on_disk, false,
+            "Set to true to keep the node IDs in sorted files in the data directory instead of in memory "
+            "while importing, so that the IDs of billions of nodes don't have to fit into memory.");
+DEFINE_uint64(num_threads, std::thread::hardware_concurrency(),
+              "Number of threads which store the nodes and convert the relationships.");
+DEFINE_VALIDATED_uint64(batch_size, 10000, "Number of rows which are stored in a single transaction.",
+                        FLAG_IN_RANGE(1, std::numeric_limits<uint32_t>::max()));
 
 std::vector<std::string> ParseRepeatedFlag(const std::string &flagname, int argc, char *argv[]) {
   std::vector<std::string> values;
@@ -126,6 +148,8 @@ struct Field {
   std::string name;
   // Type of the values under this field.
   std::string type;
+  // Group/space of the IDs of an ID field.
+  std::string id_space;
 };
 
 // A node ID from CSV format.
@@ -406,7 +430,7 @@ memgraph::storage::PropertyValue StringToValue(const std::string &str, const std
 std::string GetIdSpace(const std::string &type) {
   // The format of this field is as follows:
   // [START_|END_]ID[(<id_space>)]
-  std::regex format(R"(^(START_|END_)?ID(\(([^\(\)]+)\))?$)", std::regex::extended);
+  static const std::regex format(R"(^(START_|END_)?ID(\(([^\(\)]+)\))?$)", std::regex::extended);
   std::smatch res;
   if (!std::regex_match(type, res, format))
     throw LoadException(
@@ -417,46 +441,378 @@ std::string GetIdSpace(const std::string &type) {
   return res[3];
 }
 
+/// Map of the node IDs to the GIDs of the nodes. The IDs are either kept in
+/// a hash map or, with `--store_node_ids_on_disk`, in a sorted table on disk
+/// which is memory mapped for the lookups, so that the OS can evict it. The
+/// table is built by sorting runs of IDs in memory and merging the runs, and
+/// the duplicate IDs are found when merging them.
+class NodeIdMap {
+ public:
+  explicit NodeIdMap(std::optional<std::filesystem::path> directory) : directory_(std::move(directory)) {
+    if (directory_) {
+      std::filesystem::remove_all(*directory_);
+      MG_ASSERT(std::filesystem::create_directories(*directory_), "Couldn't create the directory '{}'", *directory_);
+    }
+  }
+
+  NodeIdMap(const NodeIdMap &) = delete;
+  NodeIdMap &operator=(const NodeIdMap &) = delete;
+  NodeIdMap(NodeIdMap &&) = delete;
+  NodeIdMap &operator=(NodeIdMap &&) = delete;
+
+  ~NodeIdMap() {
+    if (keys_) munmap(const_cast<char *>(keys_), keys_size_);
+    if (entries_) munmap(const_cast<Entry *>(entries_), entries_size_ * sizeof(Entry));
+    if (directory_) {
+      std::error_code error_code;  // Ignore the error, the files are temporary.
+      std::filesystem::remove_all(*directory_, error_code);
+    }
+  }
+
+  /// Returns false if the ID already exists. On disk the duplicates are only
+  /// found by `Finalize`.
+  bool Insert(const NodeId &id, memgraph::storage::Gid gid) {
+    if (!directory_) return ids_.emplace(id, gid).second;
+    auto key = EncodeKey(id);
+    run_size_ += key.size() + sizeof(std::pair<std::string, uint64_t>);
+    run_.emplace_back(std::move(key), gid.AsUint());
+    if (run_size_ >= kRunSize) WriteRun();
+    return true;
+  }
+
+  /// Builds the table after all IDs are inserted, and calls `on_duplicate`
+  /// for each of the nodes whose ID was already given to an earlier node.
+  template <typename TOnDuplicate>
+  void Finalize(TOnDuplicate &&on_duplicate) {
+    if (!directory_) return;
+    if (!run_.empty()) WriteRun();
+    MergeRuns(on_duplicate);
+    keys_ = static_cast<const char *>(Map(*directory_ / "keys", &keys_size_));
+    size_t entries_bytes = 0;
+    entries_ = static_cast<const Entry *>(Map(*directory_ / "entries", &entries_bytes));
+    entries_size_ = entries_bytes / sizeof(Entry);
+  }
+
+  /// Can be called concurrently once the map is finalized.
+  std::optional<memgraph::storage::Gid> Find(const NodeId &id) const {
+    if (!directory_) {
+      auto it = ids_.find(id);
+      if (it == ids_.end()) return std::nullopt;
+      return it->second;
+    }
+    auto key = EncodeKey(id);
+    const auto *end = entries_ + entries_size_;
+    const auto *it = std::lower_bound(entries_, end, key, [this](const Entry &entry, const std::string &key) {
+      return Key(entry) < std::string_view(key);
+    });
+    if (it == end || Key(*it) != key) return std::nullopt;
+    return memgraph::storage::Gid::FromUint(it->gid);
+  }
+
+ private:
+  // Approximate memory used by a run of IDs before it is sorted and written.
+  static constexpr size_t kRunSize = 256UL * 1024 * 1024;
+
+  struct Entry {
+    uint64_t key_offset;
+    uint64_t key_size;
+    uint64_t gid;
+  };
+
+  // Sorted run of IDs being read while merging the runs.
+  struct RunReader {
+    memgraph::utils::InputFile file;
+    std::string key;
+    uint64_t gid;
+  };
+
+  // The ID space is prefixed with its size, so that the keys of different IDs
+  // differ.
+  static std::string EncodeKey(const NodeId &id) {
+    auto id_space_size = static_cast<uint32_t>(id.id_space.size());
+    std::string key(sizeof(id_space_size), '\0');
+    std::memcpy(key.data(), &id_space_size, sizeof(id_space_size));
+    key += id.id_space;
+    key += id.id;
+    return key;
+  }
+
+  static NodeId DecodeKey(std::string_view key) {
+    uint32_t id_space_size = 0;
+    std::memcpy(&id_space_size, key.data(), sizeof(id_space_size));
+    key.remove_prefix(sizeof(id_space_size));
+    return NodeId{std::string(key.substr(id_space_size)), std::string(key.substr(0, id_space_size))};
+  }
+
+  std::string_view Key(const Entry &entry) const { return {keys_ + entry.key_offset, entry.key_size}; }
+
+  static void *Map(const std::filesystem::path &path, size_t *size) {
+    *size = std::filesystem::file_size(path);
+    if (*size == 0) return nullptr;
+    auto fd = open(path.c_str(), O_RDONLY);
+    MG_ASSERT(fd != -1, "Couldn't open '{}'", path);
+    // The mapping stays valid after the file is closed.
+    auto *mapping = mmap(nullptr, *size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    MG_ASSERT(mapping != MAP_FAILED, "Couldn't map '{}'", path);
+    return mapping;
+  }
+
+  void WriteRun() {
+    std::sort(run_.begin(), run_.end());
+    memgraph::utils::OutputFile file;
+    file.Open(*directory_ / fmt::format("run_{}", runs_), memgraph::utils::OutputFile::Mode::OVERWRITE_EXISTING);
+    for (const auto &[key, gid] : run_) {
+      auto key_size = static_cast<uint32_t>(key.size());
+      file.Write(reinterpret_cast<const uint8_t *>(&key_size), sizeof(key_size));
+      file.Write(key);
+      file.Write(reinterpret_cast<const uint8_t *>(&gid), sizeof(gid));
+    }
+    file.Close();
+    ++runs_;
+    run_.clear();
+    run_.shrink_to_fit();
+    run_size_ = 0;
+  }
+
+  static bool ReadNext(RunReader *run) {
+    uint32_t key_size = 0;
+    if (!run->file.Read(reinterpret_cast<uint8_t *>(&key_size), sizeof(key_size))) return false;
+    run->key.resize(key_size);
+    MG_ASSERT(run->file.Read(reinterpret_cast<uint8_t *>(run->key.data()), key_size) &&
+                  run->file.Read(reinterpret_cast<uint8_t *>(&run->gid), sizeof(run->gid)),
+              "Couldn't read the node IDs from '{}'", run->file.path());
+    return true;
+  }
+
+  template <typename TOnDuplicate>
+  void MergeRuns(TOnDuplicate &on_duplicate) {
+    std::vector<RunReader> runs(runs_);
+    auto greater = [&runs](size_t a, size_t b) {
+      return std::tie(runs[a].key, runs[a].gid) > std::tie(runs[b].key, runs[b].gid);
+    };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heads(greater);
+    for (size_t i = 0; i < runs_; ++i) {
+      const auto path = *directory_ / fmt::format("run_{}", i);
+      MG_ASSERT(runs[i].file.Open(path), "Couldn't open '{}'", path);
+      if (ReadNext(&runs[i])) heads.push(i);
+    }
+
+    memgraph::utils::OutputFile keys;
+    keys.Open(*directory_ / "keys", memgraph::utils::OutputFile::Mode::OVERWRITE_EXISTING);
+    memgraph::utils::OutputFile entries;
+    entries.Open(*directory_ / "entries", memgraph::utils::OutputFile::Mode::OVERWRITE_EXISTING);
+    std::optional<std::string> last_key;
+    uint64_t keys_size = 0;
+    while (!heads.empty()) {
+      auto i = heads.top();
+      heads.pop();
+      auto &run = runs[i];
+      // Equal keys are ordered by the GIDs, which are given to the nodes in
+      // the order of the files, so the first node with the ID is kept.
+      if (last_key == run.key) {
+        on_duplicate(DecodeKey(run.key), memgraph::storage::Gid::FromUint(run.gid));
+      } else {
+        Entry entry{keys_size, run.key.size(), run.gid};
+        keys.Write(run.key);
+        entries.Write(reinterpret_cast<const uint8_t *>(&entry), sizeof(entry));
+        keys_size += run.key.size();
+        last_key = run.key;
+      }
+      if (ReadNext(&run)) heads.push(i);
+    }
+    keys.Close();
+    entries.Close();
+    for (size_t i = 0; i < runs_; ++i) {
+      runs[i].file.Close();
+      std::filesystem::remove(*directory_ / fmt::format("run_{}", i));
+    }
+  }
+
+  std::optional<std::filesystem::path> directory_;
+  std::unordered_map<NodeId, memgraph::storage::Gid> ids_;
+  std::vector<std::pair<std::string, uint64_t>> run_;
+  size_t run_size_{0};
+  size_t runs_{0};
+  const char *keys_{nullptr};
+  size_t keys_size_{0};
+  const Entry *entries_{nullptr};
+  size_t entries_size_{0};
+};
+
+/// Queue of batches between the stages of the import. Pushing blocks while the
+/// queue is full and popping blocks while it is empty, so that the stages run
+/// concurrently without reading the whole file ahead.
+template <typename T>
+class BatchQueue {
+ public:
+  explicit BatchQueue(size_t capacity) : capacity_(capacity) {}
+
+  void Push(T item) {
+    std::unique_lock lock(lock_);
+    not_full_.wait(lock, [&] { return items_.size() < capacity_; });
+    items_.push_back(std::move(item));
+    lock.unlock();
+    not_empty_.notify_one();
+  }
+
+  /// Returns std::nullopt once the queue is closed and all batches are popped.
+  std::optional<T> Pop() {
+    std::unique_lock lock(lock_);
+    not_empty_.wait(lock, [&] { return closed_ || !items_.empty(); });
+    if (items_.empty()) return std::nullopt;
+    auto item = std::move(items_.front());
+    items_.pop_front();
+    lock.unlock();
+    not_full_.notify_one();
+    return item;
+  }
+
+  void Close() {
+    {
+      std::lock_guard guard(lock_);
+      closed_ = true;
+    }
+    not_empty_.notify_all();
+  }
+
+ private:
+  size_t capacity_;
+  std::mutex lock_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+  std::deque<T> items_;
+  bool closed_{false};
+};
+
+/// Rows of a single file, which are stored in a single transaction.
+struct RowBatch {
+  // Path and header of the file.
+  std::shared_ptr<const std::string> path;
+  std::shared_ptr<const std::vector<Field>> fields;
+  std::vector<std::vector<std::string>> rows;
+  // Number of the first line of each row, used in the error messages.
+  std::vector<uint64_t> row_numbers;
+};
+
+/// Looks up the ID spaces of the ID fields once for the whole file instead of
+/// matching the regex for each row.
 /// @throw LoadException
-void ProcessNodeRow(memgraph::storage::Storage *store, const std::vector<std::string> &row,
-                    const std::vector<Field> &fields, const std::vector<std::string> &additional_labels,
-                    std::unordered_map<NodeId, memgraph::storage::Gid> *node_id_map) {
+std::vector<Field> WithIdSpaces(std::vector<Field> fields, const std::vector<std::string_view> &id_types) {
+  for (auto &field : fields) {
+    if (std::any_of(id_types.begin(), id_types.end(),
+                    [&](const auto &id_type) { return memgraph::utils::StartsWith(field.type, id_type); })) {
+      field.id_space = GetIdSpace(field.type);
+    }
+  }
+  return fields;
+}
+
+/// Reads the rows of the file and calls `process_row` for each of them in the
+/// order of the file, with the header and the number of the row's first line.
+template <typename TProcessRow>
+void ReadRows(const std::string &path, std::optional<std::shared_ptr<const std::vector<Field>>> *header,
+              const std::vector<std::string_view> &id_types, TProcessRow &&process_row) {
+  std::ifstream file(path);
+  MG_ASSERT(file, "Unable to open '{}'", path);
+  uint64_t row_number = 1;
+  try {
+    if (!*header) {
+      auto [fields, header_lines] = ReadHeader(file);
+      row_number += header_lines;
+      header->emplace(std::make_shared<const std::vector<Field>>(WithIdSpaces(std::move(fields), id_types)));
+    }
+    const auto &fields = **header;
+    while (true) {
+      auto [row, lines_count] = ReadRow(file);
+      if (lines_count == 0) break;
+      if ((!FLAGS_ignore_extra_columns && row.size() != fields->size()) ||
+          (FLAGS_ignore_extra_columns && row.size() < fields->size()))
+        throw LoadException(
+            "Expected as many values as there are header fields (found {}, "
+            "expected {})",
+            row.size(), fields->size());
+      if (row.size() > fields->size()) {
+        row.resize(fields->size());
+      }
+      process_row(fields, std::move(row), row_number);
+      row_number += lines_count;
+    }
+  } catch (const LoadException &e) {
+    LOG_FATAL("Couldn't process row {} of '{}' because of: {}", row_number, path, e.what());
+  }
+}
+
+/// Starts `num_threads` threads which call `process_batch` for the batches
+/// popped from `queue` until it is closed.
+template <typename T, typename TProcessBatch>
+std::vector<std::jthread> StartWorkers(uint64_t num_threads, BatchQueue<T> *queue, TProcessBatch process_batch) {
+  std::vector<std::jthread> workers;
+  workers.reserve(num_threads);
+  for (uint64_t i = 0; i < num_threads; ++i) {
+    workers.emplace_back([queue, process_batch] {
+      while (auto batch = queue->Pop()) process_batch(*batch);
+    });
+  }
+  return workers;
+}
+
+/// Access to the storage which creates the vertices with the given GIDs.
+memgraph::storage::InMemoryStorage::ReplicationAccessor ImportAccess(memgraph::storage::InMemoryStorage *store) {
+  auto acc = store->Access(std::nullopt);
+  auto inmem_acc = std::unique_ptr<memgraph::storage::InMemoryStorage::InMemoryAccessor>(
+      static_cast<memgraph::storage::InMemoryStorage::InMemoryAccessor *>(acc.release()));
+  return memgraph::storage::InMemoryStorage::ReplicationAccessor(std::move(*inmem_acc));
+}
+
+/// Registers the node ID of the row in the map and assigns it the GID of the
+/// node. Returns false if the node should be skipped.
+/// @throw LoadException
+bool RegisterNodeRow(const std::vector<std::string> &row, const std::vector<Field> &fields,
+                     memgraph::storage::Gid gid, NodeIdMap *node_id_map) {
   std::optional<NodeId> id;
-  auto acc = store->Access();
-  auto node = acc->CreateVertex();
+  for (size_t i = 0; i < row.size(); ++i) {
+    const auto &field = fields[i];
+    if (!memgraph::utils::StartsWith(field.type, "ID")) continue;
+    if (id) throw LoadException("Only one node ID must be specified");
+    if (FLAGS_id_type == "INTEGER") {
+      // Call `StringToInt` to verify that the ID is a valid integer.
+      StringToInt(row[i]);
+    }
+    id.emplace(NodeId{row[i], field.id_space});
+  }
+  if (!id) return true;
+  if (!node_id_map->Insert(*id, gid)) {
+    if (FLAGS_skip_duplicate_nodes) {
+      spdlog::warn(memgraph::utils::MessageWithLink("Skipping duplicate node with ID '{}'.", *id,
+                                                    "https://memgr.ph/csv-import-tool"));
+      return false;
+    }
+    throw LoadException("Node with ID '{}' already exists", *id);
+  }
+  return true;
+}
+
+/// @throw LoadException
+void StoreNodeRow(memgraph::storage::InMemoryStorage::ReplicationAccessor *acc, memgraph::storage::Gid gid,
+                  const std::vector<std::string> &row, const std::vector<Field> &fields,
+                  const std::vector<std::string> &additional_labels) {
+  auto node = acc->CreateVertexEx(gid);
   for (size_t i = 0; i < row.size(); ++i) {
     const auto &field = fields[i];
     const auto &value = row[i];
     if (memgraph::utils::StartsWith(field.type, "ID")) {
-      if (id) throw LoadException("Only one node ID must be specified");
-      if (FLAGS_id_type == "INTEGER") {
-        // Call `StringToInt` to verify that the ID is a valid integer.
-        StringToInt(value);
-      }
-      NodeId node_id{value, GetIdSpace(field.type)};
-      auto it = node_id_map->find(node_id);
-      if (it != node_id_map->end()) {
-        if (FLAGS_skip_duplicate_nodes) {
-          spdlog::warn(memgraph::utils::MessageWithLink("Skipping duplicate node with ID '{}'.", node_id,
-                                                        "https://memgr.ph/csv-import-tool"));
-          return;
-        } else {
-          throw LoadException("Node with ID '{}' already exists", node_id);
-        }
-      }
-      node_id_map->emplace(node_id, node.Gid());
       if (!field.name.empty()) {
         memgraph::storage::PropertyValue pv_id;
         if (FLAGS_id_type == "INTEGER") {
-          pv_id = memgraph::storage::PropertyValue(StringToInt(node_id.id));
+          pv_id = memgraph::storage::PropertyValue(StringToInt(value));
         } else {
-          pv_id = memgraph::storage::PropertyValue(node_id.id);
+          pv_id = memgraph::storage::PropertyValue(value);
         }
         auto old_node_property = node.SetProperty(acc->NameToProperty(field.name), pv_id);
         if (!old_node_property.HasValue()) throw LoadException("Couldn't add property '{}' to the node", field.name);
         if (!old_node_property->IsNull()) throw LoadException("The property '{}' already exists", field.name);
       }
-      id = node_id;
     } else if (field.type == "LABEL") {
       for (const auto &label : memgraph::utils::Split(value, FLAGS_array_delimiter)) {
         auto node_label = node.AddLabel(acc->NameToLabel(label));
@@ -474,46 +830,41 @@ void ProcessNodeRow(memgraph::storage::Storage *store, const std::vector<std::st
     if (!node_label.HasValue()) throw LoadException("Couldn't add label '{}' to the node", label);
     if (!*node_label) throw LoadException("The label '{}' already exists", label);
   }
-  if (acc->Commit().HasError()) throw LoadException("Couldn't store the node");
 }
 
-void ProcessNodes(memgraph::storage::Storage *store, const std::string &nodes_path,
-                  std::optional<std::vector<Field>> *header,
-                  std::unordered_map<NodeId, memgraph::storage::Gid> *node_id_map,
-                  const std::vector<std::string> &additional_labels) {
-  std::ifstream nodes_file(nodes_path);
-  MG_ASSERT(nodes_file, "Unable to open '{}'", nodes_path);
-  uint64_t row_number = 1;
-  try {
-    if (!*header) {
-      auto [fields, header_lines] = ReadHeader(nodes_file);
-      row_number += header_lines;
-      header->emplace(std::move(fields));
-    }
-    while (true) {
-      auto [row, lines_count] = ReadRow(nodes_file);
-      if (lines_count == 0) break;
-      if ((!FLAGS_ignore_extra_columns && row.size() != (*header)->size()) ||
-          (FLAGS_ignore_extra_columns && row.size() < (*header)->size()))
-        throw LoadException(
-            "Expected as many values as there are header fields (found {}, "
-            "expected {})",
-            row.size(), (*header)->size());
-      if (row.size() > (*header)->size()) {
-        row.resize((*header)->size());
-      }
-      ProcessNodeRow(store, row, **header, additional_labels, node_id_map);
-      row_number += lines_count;
-    }
-  } catch (const LoadException &e) {
-    LOG_FATAL("Couldn't process row {} of '{}' because of: {}", row_number, nodes_path, e.what());
-  }
-}
+/// Rows of nodes with the GIDs assigned to them in the order of the files.
+struct NodeBatch {
+  RowBatch rows;
+  std::vector<memgraph::storage::Gid> gids;
+};
+
+/// A relationship whose nodes are looked up, ready to be stored.
+struct Relationship {
+  memgraph::storage::Gid start_id;
+  memgraph::storage::Gid end_id;
+  std::string type;
+  std::map<std::string, memgraph::storage::PropertyValue> properties;
+  uint64_t row_number;
+};
+
+struct RelationshipBatch {
+  std::shared_ptr<const std::string> path;
+  std::vector<Relationship> relationships;
+};
 
+/// Rows of relationships which are converted by one of the workers, after
+/// which the relationships are stored in the order of the files.
+struct ConversionTask {
+  RowBatch rows;
+  std::promise<RelationshipBatch> relationships;
+};
+
+/// Returns std::nullopt if the relationship should be skipped.
 /// @throw LoadException
-void ProcessRelationshipsRow(memgraph::storage::Storage *store, const std::vector<Field> &fields,
-                             const std::vector<std::string> &row, std::optional<std::string> relationship_type,
-                             const std::unordered_map<NodeId, memgraph::storage::Gid> &node_id_map) {
+std::optional<Relationship> ConvertRelationshipRow(
+    const std::vector<Field> &fields, const std::vector<std::string> &row, uint64_t row_number,
+    std::optional<std::string> relationship_type,
+    const NodeIdMap &node_id_map) {
   std::optional<memgraph::storage::Gid> start_id;
   std::optional<memgraph::storage::Gid> end_id;
   std::map<std::string, memgraph::storage::PropertyValue> properties;
@@ -526,36 +877,36 @@ void ProcessRelationshipsRow(memgraph::storage::Storage *store, const std::vecto
         // Call `StringToInt` to verify that the START_ID is a valid integer.
         StringToInt(value);
       }
-      NodeId node_id{value, GetIdSpace(field.type)};
-      auto it = node_id_map.find(node_id);
-      if (it == node_id_map.end()) {
+      NodeId node_id{value, field.id_space};
+      auto gid = node_id_map.Find(node_id);
+      if (!gid) {
         if (FLAGS_skip_bad_relationships) {
           spdlog::warn(memgraph::utils::MessageWithLink("Skipping bad relationship with START_ID '{}'.", node_id,
                                                         "https://memgr.ph/csv-import-tool"));
-          return;
+          return std::nullopt;
         } else {
           throw LoadException("Node with ID '{}' does not exist", node_id);
         }
       }
-      start_id = it->second;
+      start_id = gid;
     } else if (memgraph::utils::StartsWith(field.type, "END_ID")) {
       if (end_id) throw LoadException("Only one node ID must be specified");
       if (FLAGS_id_type == "INTEGER") {
         // Call `StringToInt` to verify that the END_ID is a valid integer.
         StringToInt(value);
       }
-      NodeId node_id{value, GetIdSpace(field.type)};
-      auto it = node_id_map.find(node_id);
-      if (it == node_id_map.end()) {
+      NodeId node_id{value, field.id_space};
+      auto gid = node_id_map.Find(node_id);
+      if (!gid) {
         if (FLAGS_skip_bad_relationships) {
           spdlog::warn(memgraph::utils::MessageWithLink("Skipping bad relationship with END_ID '{}'.", node_id,
                                                         "https://memgr.ph/csv-import-tool"));
-          return;
+          return std::nullopt;
         } else {
           throw LoadException("Node with ID '{}' does not exist", node_id);
         }
       }
-      end_id = it->second;
+      end_id = gid;
     } else if (field.type == "TYPE") {
       if (relationship_type) throw LoadException("Only one relationship TYPE must be specified");
       relationship_type = value;
@@ -567,18 +918,21 @@ void ProcessRelationshipsRow(memgraph::storage::Storage *store, const std::vecto
   if (!start_id) throw LoadException("START_ID must be set");
   if (!end_id) throw LoadException("END_ID must be set");
   if (!relationship_type) throw LoadException("Relationship TYPE must be set");
+  return Relationship{*start_id, *end_id, std::move(*relationship_type), std::move(properties), row_number};
+}
 
-  auto acc = store->Access();
-  auto from_node = acc->FindVertex(*start_id, memgraph::storage::View::NEW);
+/// @throw LoadException
+void StoreRelationship(memgraph::storage::Storage::Accessor *acc, const Relationship &relationship) {
+  auto from_node = acc->FindVertex(relationship.start_id, memgraph::storage::View::NEW);
   if (!from_node) throw LoadException("From node must be in the storage");
-  auto to_node = acc->FindVertex(*end_id, memgraph::storage::View::NEW);
+  auto to_node = acc->FindVertex(relationship.end_id, memgraph::storage::View::NEW);
   if (!to_node) throw LoadException("To node must be in the storage");
 
-  auto relationship = acc->CreateEdge(&from_node.value(), &to_node.value(), acc->NameToEdgeType(*relationship_type));
-  if (!relationship.HasValue()) throw LoadException("Couldn't create the relationship");
+  auto edge = acc->CreateEdge(&from_node.value(), &to_node.value(), acc->NameToEdgeType(relationship.type));
+  if (!edge.HasValue()) throw LoadException("Couldn't create the relationship");
 
-  for (const auto &property : properties) {
-    auto ret = relationship.GetValue().SetProperty(acc->NameToProperty(property.first), property.second);
+  for (const auto &property : relationship.properties) {
+    auto ret = edge.GetValue().SetProperty(acc->NameToProperty(property.first), property.second);
     if (!ret.HasValue()) {
       if (ret.GetError() != memgraph::storage::Error::PROPERTIES_DISABLED) {
         throw LoadException("Couldn't add property '{}' to the relationship", property.first);
@@ -590,41 +944,136 @@ void ProcessRelationshipsRow(memgraph::storage::Storage *store, const std::vecto
       }
     }
   }
+}
 
-  if (acc->Commit().HasError()) throw LoadException("Couldn't store the relationship");
+/// Imports the nodes of the files with the same header. The files are read
+/// on this thread, which assigns the GIDs of the nodes in the order of the
+/// rows like creating them one by one would, and the nodes are stored by
+/// `num_threads` workers concurrently.
+void ImportNodes(memgraph::storage::InMemoryStorage *store, const std::vector<std::string> &files,
+                 const std::vector<std::string> &additional_labels,
+                 NodeIdMap *node_id_map, uint64_t *next_gid,
+                 uint64_t num_threads) {
+  BatchQueue<NodeBatch> queue(2 * num_threads);
+  auto workers = StartWorkers(num_threads, &queue, [store, &additional_labels](const NodeBatch &batch) {
+    auto acc = ImportAccess(store);
+    for (size_t i = 0; i < batch.gids.size(); ++i) {
+      try {
+        StoreNodeRow(&acc, batch.gids[i], batch.rows.rows[i], *batch.rows.fields, additional_labels);
+      } catch (const LoadException &e) {
+        LOG_FATAL("Couldn't process row {} of '{}' because of: {}", batch.rows.row_numbers[i], *batch.rows.path,
+                  e.what());
+      }
+    }
+    MG_ASSERT(!acc.Commit().HasError(), "Couldn't store the nodes of '{}'", *batch.rows.path);
+  });
+
+  std::optional<std::shared_ptr<const std::vector<Field>>> header;
+  for (const auto &nodes_file : files) {
+    spdlog::info("Loading {}", nodes_file);
+    NodeBatch batch{{std::make_shared<const std::string>(nodes_file), nullptr, {}, {}}, {}};
+    ReadRows(nodes_file, &header, {"ID"}, [&](const auto &fields, std::vector<std::string> row, uint64_t row_number) {
+      // Every row takes a GID, even the skipped duplicates.
+      auto gid = memgraph::storage::Gid::FromUint((*next_gid)++);
+      if (!RegisterNodeRow(row, *fields, gid, node_id_map)) return;
+      batch.rows.fields = fields;
+      batch.rows.rows.push_back(std::move(row));
+      batch.rows.row_numbers.push_back(row_number);
+      batch.gids.push_back(gid);
+      if (batch.gids.size() == FLAGS_batch_size) {
+        queue.Push(std::move(batch));
+        batch = NodeBatch{{std::make_shared<const std::string>(nodes_file), fields, {}, {}}, {}};
+      }
+    });
+    if (!batch.gids.empty()) queue.Push(std::move(batch));
+  }
+  queue.Close();
 }
 
-void ProcessRelationships(memgraph::storage::Storage *store, const std::string &relationships_path,
-                          const std::optional<std::string> &relationship_type,
-                          std::optional<std::vector<Field>> *header,
-                          const std::unordered_map<NodeId, memgraph::storage::Gid> &node_id_map) {
-  std::ifstream relationships_file(relationships_path);
-  MG_ASSERT(relationships_file, "Unable to open '{}'", relationships_path);
-  uint64_t row_number = 1;
-  try {
-    if (!*header) {
-      auto [fields, header_lines] = ReadHeader(relationships_file);
-      row_number += header_lines;
-      header->emplace(std::move(fields));
+/// Finalizes the node IDs and removes the nodes with the IDs which were
+/// already given to other nodes. Only the IDs stored on disk have duplicates
+/// at this point, since the ones in memory are checked when reading the rows.
+void RemoveDuplicateNodes(memgraph::storage::InMemoryStorage *store, NodeIdMap *node_id_map) {
+  std::vector<memgraph::storage::Gid> duplicates;
+  node_id_map->Finalize([&duplicates](const NodeId &id, memgraph::storage::Gid gid) {
+    if (!FLAGS_skip_duplicate_nodes) LOG_FATAL("Node with ID '{}' already exists", id);
+    spdlog::warn(memgraph::utils::MessageWithLink("Skipping duplicate node with ID '{}'.", id,
+                                                  "https://memgr.ph/csv-import-tool"));
+    duplicates.push_back(gid);
+  });
+  for (size_t begin = 0; begin < duplicates.size(); begin += FLAGS_batch_size) {
+    auto acc = store->Access(std::nullopt);
+    for (size_t i = begin; i < std::min<size_t>(begin + FLAGS_batch_size, duplicates.size()); ++i) {
+      auto node = acc->FindVertex(duplicates[i], memgraph::storage::View::NEW);
+      MG_ASSERT(node, "The duplicate node must be in the storage");
+      MG_ASSERT(acc->DeleteVertex(&*node).HasValue(), "Couldn't remove the duplicate node");
     }
-    while (true) {
-      auto [row, lines_count] = ReadRow(relationships_file);
-      if (lines_count == 0) break;
-      if ((!FLAGS_ignore_extra_columns && row.size() != (*header)->size()) ||
-          (FLAGS_ignore_extra_columns && row.size() < (*header)->size()))
-        throw LoadException(
-            "Expected as many values as there are header fields (found {}, "
-            "expected {})",
-            row.size(), (*header)->size());
-      if (row.size() > (*header)->size()) {
-        row.resize((*header)->size());
+    MG_ASSERT(!acc->Commit().HasError(), "Couldn't remove the duplicate nodes");
+  }
+}
+
+/// Imports the relationships of the files with the same header. The rows are
+/// read on this thread and converted by `num_threads` workers, while a single
+/// thread stores the relationships in the order of the files, since concurrent
+/// transactions can't add relationships to the same node.
+void ImportRelationships(memgraph::storage::InMemoryStorage *store, const std::vector<std::string> &files,
+                         const std::optional<std::string> &relationship_type,
+                         const NodeIdMap &node_id_map, uint64_t num_threads) {
+  BatchQueue<ConversionTask> conversions(2 * num_threads);
+  BatchQueue<std::future<RelationshipBatch>> converted(2 * num_threads);
+  auto converters =
+      StartWorkers(num_threads, &conversions, [&relationship_type, &node_id_map](ConversionTask &task) {
+        RelationshipBatch batch{task.rows.path, {}};
+        batch.relationships.reserve(task.rows.rows.size());
+        for (size_t i = 0; i < task.rows.rows.size(); ++i) {
+          try {
+            auto relationship = ConvertRelationshipRow(*task.rows.fields, task.rows.rows[i], task.rows.row_numbers[i],
+                                                       relationship_type, node_id_map);
+            if (relationship) batch.relationships.push_back(std::move(*relationship));
+          } catch (const LoadException &e) {
+            LOG_FATAL("Couldn't process row {} of '{}' because of: {}", task.rows.row_numbers[i], *task.rows.path,
+                      e.what());
+          }
+        }
+        task.relationships.set_value(std::move(batch));
+      });
+  auto inserter = StartWorkers(1, &converted, [store](std::future<RelationshipBatch> &future) {
+    auto batch = future.get();
+    auto acc = store->Access(std::nullopt);
+    for (const auto &relationship : batch.relationships) {
+      try {
+        StoreRelationship(acc.get(), relationship);
+      } catch (const LoadException &e) {
+        LOG_FATAL("Couldn't process row {} of '{}' because of: {}", relationship.row_number, *batch.path, e.what());
       }
-      ProcessRelationshipsRow(store, **header, row, relationship_type, node_id_map);
-      row_number += lines_count;
     }
-  } catch (const LoadException &e) {
-    LOG_FATAL("Couldn't process row {} of '{}' because of: {}", row_number, relationships_path, e.what());
+    MG_ASSERT(!acc->Commit().HasError(), "Couldn't store the relationships of '{}'", *batch.path);
+  });
+
+  auto push = [&](RowBatch rows) {
+    ConversionTask task{std::move(rows), {}};
+    converted.Push(task.relationships.get_future());
+    conversions.Push(std::move(task));
+  };
+  std::optional<std::shared_ptr<const std::vector<Field>>> header;
+  for (const auto &relationships_file : files) {
+    spdlog::info("Loading {}", relationships_file);
+    const auto path = std::make_shared<const std::string>(relationships_file);
+    RowBatch batch{path, nullptr, {}, {}};
+    ReadRows(relationships_file, &header, {"START_ID", "END_ID"},
+             [&](const auto &fields, std::vector<std::string> row, uint64_t row_number) {
+               batch.fields = fields;
+               batch.rows.push_back(std::move(row));
+               batch.row_numbers.push_back(row_number);
+               if (batch.rows.size() == FLAGS_batch_size) {
+                 push(std::move(batch));
+                 batch = RowBatch{path, fields, {}, {}};
+               }
+             });
+    if (!batch.rows.empty()) push(std::move(batch));
   }
+  conversions.Close();
+  converted.Close();
 }
 
 struct NodesArgument {
@@ -700,7 +1149,9 @@ int main(int argc, char *argv[]) {
     FLAGS_id_type = upper;
   }
 
-  std::unordered_map<NodeId, memgraph::storage::Gid> node_id_map;
+  NodeIdMap node_id_map(FLAGS_store_node_ids_on_disk
+                            ? std::make_optional(std::filesystem::path(FLAGS_data_directory) / ".mg_import_csv_ids")
+                            : std::nullopt);
   auto store = std::make_unique<memgraph::storage::InMemoryStorage>(memgraph::storage::Config{
 
       .items = {.properties_on_edges = FLAGS_storage_properties_on_edges},
@@ -712,24 +1163,20 @@ int main(int argc, char *argv[]) {
 
   memgraph::utils::Timer load_timer;
 
+  const uint64_t num_threads = std::max<uint64_t>(FLAGS_num_threads, 1);
+
   // Process all nodes files.
+  uint64_t next_gid = 0;
   for (const auto &value : nodes) {
     auto [files, additional_labels] = ParseNodesArgument(value);
-    std::optional<std::vector<Field>> header;
-    for (const auto &nodes_file : files) {
-      spdlog::info("Loading {}", nodes_file);
-      ProcessNodes(store.get(), nodes_file, &header, &node_id_map, additional_labels);
-    }
+    ImportNodes(store.get(), files, additional_labels, &node_id_map, &next_gid, num_threads);
   }
+  RemoveDuplicateNodes(store.get(), &node_id_map);
 
   // Process all relationships files.
   for (const auto &value : relationships) {
     auto [files, type] = ParseRelationshipsArgument(value);
-    std::optional<std::vector<Field>> header;
-    for (const auto &relationships_file : files) {
-      spdlog::info("Loading {}", relationships_file);
-      ProcessRelationships(store.get(), relationships_file, type, &header, node_id_map);
-    }
+    ImportRelationships(store.get(), files, type, node_id_map, num_threads);
   }
 
   double load_sec = load_timer.Elapsed().count();
@@ -48,6 +48,24 @@ class EnsureGIL final {
   EnsureGIL &operator=(EnsureGIL &&) = delete;
 };
 
+/// Release the GIL held by the current thread, so that other threads may run
+/// Python code while this one doesn't use the Python C API.
+///
+/// This is the RAII equivalent of the `Py_BEGIN_ALLOW_THREADS` and
+/// `Py_END_ALLOW_THREADS` macros. No `PyObject` may be accessed while the GIL
+/// is released.
+class ReleaseGIL final {
+  PyThreadState *thread_state_;
+
+ public:
+  ReleaseGIL() noexcept : thread_state_(PyEval_SaveThread()) {}
+  ~ReleaseGIL() noexcept { PyEval_RestoreThread(thread_state_); }
+  ReleaseGIL(const ReleaseGIL &) = delete;
+  ReleaseGIL(ReleaseGIL &&) = delete;
+  ReleaseGIL &operator=(const ReleaseGIL &) = delete;
+  ReleaseGIL &operator=(ReleaseGIL &&) = delete;
+};
+
 /// Owns a `PyObject *` and supports a more C++ idiomatic API to objects.
 class [[nodiscard]] Object final {
   PyObject *ptr_{nullptr};
@@ -0,0 +1,137 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/admission_controller.hpp"
+
+#include "query/exceptions.hpp"
+#include "utils/event_counter.hpp"
+#include "utils/event_histogram.hpp"
+#include "utils/timer.hpp"
+
+namespace memgraph::metrics {
+extern const Event QueuedQueries;
+extern const Event RejectedQueries;
+extern const Event AdmissionWaitTime_us;
+}  // namespace memgraph::metrics
+
+namespace memgraph::query {
+
+AdmissionController::Ticket::Ticket(Ticket &&other) noexcept
+    : controller_(std::exchange(other.controller_, nullptr)),
+      username_(std::move(other.username_)),
+      memory_(other.memory_) {}
+
+AdmissionController::Ticket &AdmissionController::Ticket::operator=(Ticket &&other) noexcept {
+  if (this != &other) {
+    Release();
+    controller_ = std::exchange(other.controller_, nullptr);
+    username_ = std::move(other.username_);
+    memory_ = other.memory_;
+  }
+  return *this;
+}
+
+void AdmissionController::Ticket::Release() {
+  if (!controller_) return;
+  std::exchange(controller_, nullptr)->Release(username_, memory_);
+}
+
+AdmissionController::Ticket AdmissionController::Admit(const std::optional<std::string> &username,
+                                                       std::optional<uint64_t> memory_limit) {
+  if (!Enabled()) return {};
+  const uint64_t memory = memory_limit.value_or(config_.default_query_memory);
+  // Per-user limits don't apply to the queries of unauthenticated sessions.
+  const bool limit_user = username && (config_.max_concurrent_queries_per_user != 0 ||
+                                       config_.max_memory_in_flight_per_user != 0);
+
+  std::unique_lock lock(mutex_);
+  auto *user = limit_user ? &users_[*username] : nullptr;
+  if (!CanAdmit(user, memory)) {
+    if (queued_ >= config_.max_queue_size) {
+      if (user) EraseIfIdle(*username);
+      memgraph::metrics::IncrementCounter(memgraph::metrics::RejectedQueries);
+      throw AdmissionRejectedException("too many queries are already waiting to be executed");
+    }
+    ++queued_;
+    if (user) ++user->queued;
+    memgraph::metrics::IncrementCounter(memgraph::metrics::QueuedQueries);
+    utils::Timer timer;
+    const bool admitted =
+        released_cv_.wait_for(lock, config_.queue_timeout, [&] { return CanAdmit(user, memory); });
+    --queued_;
+    if (user) --user->queued;
+    memgraph::metrics::DecrementCounter(memgraph::metrics::QueuedQueries);
+    memgraph::metrics::Measure(memgraph::metrics::AdmissionWaitTime_us,
+                               timer.Elapsed<std::chrono::microseconds>().count());
+    if (!admitted) {
+      if (user) EraseIfIdle(*username);
+      memgraph::metrics::IncrementCounter(memgraph::metrics::RejectedQueries);
+      throw AdmissionRejectedException("the query waited for too long to be executed");
+    }
+  }
+
+  ++total_.queries;
+  total_.memory += memory;
+  if (user) {
+    ++user->queries;
+    user->memory += memory;
+  }
+  return {this, limit_user ? username : std::nullopt, memory};
+}
+
+bool AdmissionController::CanAdmit(const InFlight *user, uint64_t memory) const {
+  const auto fits = [memory](const InFlight &in_flight, uint64_t max_queries, uint64_t max_memory) {
+    if (max_queries != 0 && in_flight.queries >= max_queries) return false;
+    return max_memory == 0 || in_flight.memory == 0 || in_flight.memory + memory <= max_memory;
+  };
+  return fits(total_, config_.max_concurrent_queries, config_.max_memory_in_flight) &&
+         (!user || fits(*user, config_.max_concurrent_queries_per_user, config_.max_memory_in_flight_per_user));
+}
+
+void AdmissionController::Release(const std::optional<std::string> &username, uint64_t memory) {
+  {
+    std::lock_guard lock(mutex_);
+    --total_.queries;
+    total_.memory -= memory;
+    if (username) {
+      auto &user = users_.at(*username);
+      --user.queries;
+      user.memory -= memory;
+      EraseIfIdle(*username);
+    }
+  }
+  // The waiting queries have different users and reservations, so any of
+  // them may fit now.
+  released_cv_.notify_all();
+}
+
+void AdmissionController::EraseIfIdle(const std::string &username) {
+  if (auto it = users_.find(username); it != users_.end() && it->second.queries == 0 && it->second.queued == 0) {
+    users_.erase(it);
+  }
+}
+
+uint64_t AdmissionController::RunningQueries() const {
+  std::lock_guard lock(mutex_);
+  return total_.queries;
+}
+
+uint64_t AdmissionController::MemoryInFlight() const {
+  std::lock_guard lock(mutex_);
+  return total_.memory;
+}
+
+uint64_t AdmissionController::QueuedQueries() const {
+  std::lock_guard lock(mutex_);
+  return queued_;
+}
+
+}  // namespace memgraph::query
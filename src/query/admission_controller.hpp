@@ -0,0 +1,101 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Admission control of the queries executed on a database, which queues the
+/// queries once the configured number of them or their memory is in flight.
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "query/config.hpp"
+
+namespace memgraph::query {
+
+/// Limits the queries which run at the same time on a database, in total and
+/// for each user. Each admitted query reserves the memory it may use, which is
+/// its `QUERY MEMORY LIMIT` or the configured default, until it finishes. A
+/// query which would exceed a limit waits in a queue of bounded size until the
+/// limit allows it or the queue timeout passes. A query reserving more memory
+/// than the limit is admitted once no other query holds a reservation.
+///
+/// A zero limit means no limit, and with all limits at zero queries are
+/// admitted without taking the lock.
+class AdmissionController {
+ public:
+  using Config = InterpreterConfig::Admission;
+
+  /// Releases the admission of the query when it's destroyed.
+  class Ticket {
+   public:
+    Ticket() = default;
+    Ticket(const Ticket &) = delete;
+    Ticket &operator=(const Ticket &) = delete;
+    Ticket(Ticket &&other) noexcept;
+    Ticket &operator=(Ticket &&other) noexcept;
+    ~Ticket() { Release(); }
+
+    void Release();
+
+   private:
+    friend class AdmissionController;
+    Ticket(AdmissionController *controller, std::optional<std::string> username, uint64_t memory)
+        : controller_(controller), username_(std::move(username)), memory_(memory) {}
+
+    AdmissionController *controller_{nullptr};
+    std::optional<std::string> username_;
+    uint64_t memory_{0};
+  };
+
+  explicit AdmissionController(Config config) : config_(config) {}
+
+  /// Admits a query of the user, which reserves `memory_limit` bytes or the
+  /// default reservation if the query has no memory limit.
+  /// @throw AdmissionRejectedException if the queue is full or the query
+  ///        waited for longer than the queue timeout.
+  Ticket Admit(const std::optional<std::string> &username, std::optional<uint64_t> memory_limit);
+
+  bool Enabled() const {
+    return config_.max_concurrent_queries != 0 || config_.max_concurrent_queries_per_user != 0 ||
+           config_.max_memory_in_flight != 0 || config_.max_memory_in_flight_per_user != 0;
+  }
+
+  uint64_t RunningQueries() const;
+  uint64_t MemoryInFlight() const;
+  uint64_t QueuedQueries() const;
+
+ private:
+  struct InFlight {
+    uint64_t queries{0};
+    uint64_t memory{0};
+    // Queries of the user in the queue, which keep the entry of the user.
+    uint64_t queued{0};
+  };
+
+  bool CanAdmit(const InFlight *user, uint64_t memory) const;
+  void Release(const std::optional<std::string> &username, uint64_t memory);
+  void EraseIfIdle(const std::string &username);
+
+  const Config config_;
+  mutable std::mutex mutex_;
+  std::condition_variable released_cv_;
+  InFlight total_;
+  std::unordered_map<std::string, InFlight> users_;
+  uint64_t queued_{0};
+};
+
+}  // namespace memgraph::query
@@ -0,0 +1,83 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/arrow_export.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "query/exceptions.hpp"
+
+namespace memgraph::query {
+
+ArrowFileExport::ArrowFileExport(std::filesystem::path directory, std::vector<std::string> column_names,
+                                 const size_t writers, const size_t rows_per_file)
+    : directory_(std::move(directory)),
+      column_names_(std::move(column_names)),
+      writers_(std::max<size_t>(writers, 1)),
+      rows_per_file_(std::max<size_t>(rows_per_file, 1)) {
+  std::error_code error;
+  std::filesystem::create_directories(directory_, error);
+  if (error) {
+    throw QueryRuntimeException("Couldn't create the export directory '{}': {}.", directory_.string(),
+                                error.message());
+  }
+  // The files of an earlier export could be mistaken for the files of this one.
+  if (!std::filesystem::is_empty(directory_, error) || error) {
+    throw QueryRuntimeException("The export directory '{}' isn't empty.", directory_.string());
+  }
+}
+
+void ArrowFileExport::Result(const std::vector<TypedValue> &values) {
+  if (!current_) current_.emplace(column_names_);
+  current_->Result(values);
+  if (++current_rows_ == rows_per_file_) WriteFile();
+}
+
+void ArrowFileExport::WriteFile() {
+  // The results are held by at most `writers_` files which are being written
+  // and the current one.
+  if (pending_.size() == writers_) {
+    pending_.front().get();
+    pending_.pop_front();
+  }
+  auto path = directory_ / fmt::format("part-{:05}.arrows", files_.size());
+  files_.push_back({path.string(), current_rows_});
+  pending_.push_back(std::async(std::launch::async, [stream = std::move(*current_), path = std::move(path)] {
+    const auto data = stream.Finish();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    file.close();
+    if (!file) {
+      throw QueryRuntimeException("Couldn't write the export file '{}'.", path.string());
+    }
+  }));
+  current_.reset();
+  current_rows_ = 0;
+}
+
+std::vector<ArrowFileExport::File> ArrowFileExport::Finish() {
+  if (current_ || files_.empty()) {
+    if (!current_) current_.emplace(column_names_);
+    WriteFile();
+  }
+  while (!pending_.empty()) {
+    pending_.front().get();
+    pending_.pop_front();
+  }
+  return std::move(files_);
+}
+
+}  // namespace memgraph::query
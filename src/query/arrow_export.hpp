@@ -0,0 +1,80 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Export of query results to Arrow IPC files on the server, which LOAD ARROW
+/// and the data frame libraries read directly.
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "query/arrow_stream.hpp"
+#include "query/typed_value.hpp"
+
+namespace memgraph::query {
+
+/// Result stream which writes the results of a query to files in the Arrow IPC
+/// streaming format, `part-00000.arrows`, `part-00001.arrows` and so on, with
+/// at most `rows_per_file` rows in each file. A full file is encoded and
+/// written on a separate thread while the next results are collected, and up
+/// to `writers` files are written at once.
+class ArrowFileExport {
+ public:
+  static constexpr size_t kDefaultRowsPerFile = 1UL << 20UL;
+
+  struct File {
+    std::string path;
+    size_t rows;
+  };
+
+  /// Creates the directory if it doesn't exist.
+  /// @throw QueryRuntimeException if the directory can't be created or it
+  /// isn't empty.
+  ArrowFileExport(std::filesystem::path directory, std::vector<std::string> column_names, size_t writers,
+                  size_t rows_per_file = kDefaultRowsPerFile);
+
+  ArrowFileExport(const ArrowFileExport &) = delete;
+  ArrowFileExport &operator=(const ArrowFileExport &) = delete;
+  ArrowFileExport(ArrowFileExport &&) = delete;
+  ArrowFileExport &operator=(ArrowFileExport &&) = delete;
+  ~ArrowFileExport() = default;
+
+  /// @throw QueryRuntimeException if a value can't be put into its column, or
+  /// if a previous file couldn't be written.
+  void Result(const std::vector<TypedValue> &values);
+
+  /// Writes the remaining results and waits for all the files to be written.
+  /// A query without results is exported as a single file with the schema.
+  /// @throw QueryRuntimeException if a file couldn't be written.
+  std::vector<File> Finish();
+
+ private:
+  /// Starts writing the current file.
+  void WriteFile();
+
+  std::filesystem::path directory_;
+  std::vector<std::string> column_names_;
+  size_t writers_;
+  size_t rows_per_file_;
+  std::optional<ArrowResultStream> current_;
+  size_t current_rows_{0};
+  std::vector<File> files_;
+  /// The files which are being written, from the oldest one.
+  std::deque<std::future<void>> pending_;
+};
+
+}  // namespace memgraph::query
@@ -0,0 +1,508 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/arrow_reader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <utility>
+
+#include "query/exceptions.hpp"
+#include "utils/temporal.hpp"
+
+namespace memgraph::query {
+
+namespace {
+
+// Constants of the Arrow format from Schema.fbs and Message.fbs.
+constexpr int16_t kMetadataVersionV5 = 4;
+constexpr uint8_t kMessageHeaderSchema = 1;
+constexpr uint8_t kMessageHeaderDictionaryBatch = 2;
+constexpr uint8_t kMessageHeaderRecordBatch = 3;
+constexpr uint8_t kTypeNull = 1;
+constexpr uint8_t kTypeInt = 2;
+constexpr uint8_t kTypeFloatingPoint = 3;
+constexpr uint8_t kTypeBinary = 4;
+constexpr uint8_t kTypeUtf8 = 5;
+constexpr uint8_t kTypeBool = 6;
+constexpr uint8_t kTypeDecimal = 7;
+constexpr uint8_t kTypeDate = 8;
+constexpr uint8_t kTypeTime = 9;
+constexpr uint8_t kTypeTimestamp = 10;
+constexpr uint8_t kTypeInterval = 11;
+constexpr uint8_t kTypeFixedSizeBinary = 15;
+constexpr uint8_t kTypeDuration = 18;
+constexpr uint8_t kTypeLargeBinary = 19;
+constexpr uint8_t kTypeLargeUtf8 = 20;
+constexpr int16_t kPrecisionSingle = 1;
+constexpr int16_t kPrecisionDouble = 2;
+constexpr int16_t kDateUnitDay = 0;
+constexpr int16_t kDateUnitMillisecond = 1;
+constexpr int16_t kTimeUnitSecond = 0;
+constexpr int16_t kTimeUnitMillisecond = 1;
+constexpr int16_t kTimeUnitMicrosecond = 2;
+constexpr int16_t kTimeUnitNanosecond = 3;
+constexpr uint32_t kContinuation = 0xFFFFFFFF;
+constexpr std::string_view kFileMagic = "ARROW1";
+constexpr int64_t kMicrosecondsPerDay = 86'400'000'000;
+
+/// Bodies are read in chunks of this size, so that a corrupted length
+/// doesn't allocate more memory than the stream has.
+constexpr size_t kReadChunkSize = 1UL << 20UL;
+
+template <class T>
+T Read(std::string_view buffer, size_t pos) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  if (pos > buffer.size() || buffer.size() - pos < sizeof(T)) {
+    throw QueryRuntimeException("Invalid Arrow data, a value is out of bounds.");
+  }
+  T value;
+  // The Arrow format is little endian, like all the platforms Memgraph runs on.
+  std::memcpy(&value, buffer.data() + pos, sizeof(T));
+  return value;
+}
+
+/// Table of a flatbuffer, which holds the metadata of Arrow messages. All the
+/// positions are checked, as the metadata comes from the user.
+class FlatBufferTable {
+ public:
+  FlatBufferTable(std::string_view buffer, size_t pos) : buffer_(buffer), pos_(pos) {
+    const auto vtable = static_cast<int64_t>(pos_) - Read<int32_t>(buffer_, pos_);
+    if (vtable < 0) throw QueryRuntimeException("Invalid Arrow data, a table is out of bounds.");
+    vtable_ = static_cast<size_t>(vtable);
+    vtable_size_ = Read<uint16_t>(buffer_, vtable_);
+  }
+
+  static FlatBufferTable Root(std::string_view buffer) { return {buffer, Read<uint32_t>(buffer, 0)}; }
+
+  template <class T>
+  T Scalar(uint16_t id, T default_value) const {
+    const auto field = Field(id);
+    return field == 0 ? default_value : Read<T>(buffer_, field);
+  }
+
+  std::optional<FlatBufferTable> Table(uint16_t id) const {
+    const auto field = Field(id);
+    if (field == 0) return std::nullopt;
+    return FlatBufferTable(buffer_, field + Read<uint32_t>(buffer_, field));
+  }
+
+  /// Returns the position of the first element and the size of a vector,
+  /// which is empty if it's missing.
+  std::pair<size_t, size_t> Vector(uint16_t id) const {
+    const auto field = Field(id);
+    if (field == 0) return {0, 0};
+    const auto vector = field + Read<uint32_t>(buffer_, field);
+    return {vector + sizeof(uint32_t), Read<uint32_t>(buffer_, vector)};
+  }
+
+  /// Returns the table at position `index` of a vector of tables.
+  FlatBufferTable Element(std::pair<size_t, size_t> vector, size_t index) const {
+    const auto element = vector.first + index * sizeof(uint32_t);
+    return {buffer_, element + Read<uint32_t>(buffer_, element)};
+  }
+
+  std::string_view String(uint16_t id) const {
+    const auto [begin, size] = Vector(id);
+    if (begin > buffer_.size() || buffer_.size() - begin < size) {
+      throw QueryRuntimeException("Invalid Arrow data, a string is out of bounds.");
+    }
+    return buffer_.substr(begin, size);
+  }
+
+ private:
+  size_t Field(uint16_t id) const {
+    const auto entry = sizeof(uint16_t) * (2 + id);
+    if (entry >= vtable_size_) return 0;
+    const auto offset = Read<uint16_t>(buffer_, vtable_ + entry);
+    return offset == 0 ? 0 : pos_ + offset;
+  }
+
+  std::string_view buffer_;
+  size_t pos_;
+  size_t vtable_{0};
+  uint16_t vtable_size_{0};
+};
+
+/// Returns the struct of two longs, which are FieldNode and Buffer, at
+/// position `index` of the vector.
+std::pair<int64_t, int64_t> ReadPair(std::string_view buffer, std::pair<size_t, size_t> vector, size_t index) {
+  if (index >= vector.second) throw QueryRuntimeException("Invalid Arrow data, a record batch is missing a column.");
+  const auto pos = vector.first + index * 2 * sizeof(int64_t);
+  return {Read<int64_t>(buffer, pos), Read<int64_t>(buffer, pos + sizeof(int64_t))};
+}
+
+/// Sets the conversion of a time unit to microseconds.
+void SetTimeUnit(int16_t unit, int64_t *multiplier, int64_t *divisor) {
+  switch (unit) {
+    case kTimeUnitSecond:
+      *multiplier = 1'000'000;
+      break;
+    case kTimeUnitMillisecond:
+      *multiplier = 1'000;
+      break;
+    case kTimeUnitMicrosecond:
+      break;
+    case kTimeUnitNanosecond:
+      *divisor = 1'000;
+      break;
+    default:
+      throw QueryRuntimeException("Invalid Arrow data, unknown time unit {}.", unit);
+  }
+}
+
+/// Returns the number of buffers of a column of the type, which isn't nested.
+size_t NumBuffers(uint8_t type) {
+  switch (type) {
+    case kTypeNull:
+      return 0;
+    case kTypeBinary:
+    case kTypeUtf8:
+    case kTypeLargeBinary:
+    case kTypeLargeUtf8:
+      return 3;
+    case kTypeInt:
+    case kTypeFloatingPoint:
+    case kTypeBool:
+    case kTypeDecimal:
+    case kTypeDate:
+    case kTypeTime:
+    case kTypeTimestamp:
+    case kTypeInterval:
+    case kTypeFixedSizeBinary:
+    case kTypeDuration:
+      return 2;
+    default:
+      throw QueryRuntimeException("Arrow columns of nested types aren't supported.");
+  }
+}
+
+bool IsSet(std::string_view bitmap, size_t index) {
+  return (static_cast<uint8_t>(bitmap[index / 8]) >> (index % 8)) & 1;
+}
+
+int64_t ToMicroseconds(int64_t value, int64_t multiplier, int64_t divisor) {
+  int64_t microseconds = 0;
+  if (__builtin_mul_overflow(value, multiplier, &microseconds)) {
+    throw QueryRuntimeException("An Arrow temporal value is out of range.");
+  }
+  // The division rounds down, so that the earlier times stay earlier.
+  auto quotient = microseconds / divisor;
+  if (microseconds % divisor < 0) --quotient;
+  return quotient;
+}
+
+}  // namespace
+
+ArrowReader::ArrowReader(std::istream &stream, const std::vector<std::string> *columns) : stream_(stream) {
+  // The file format starts with the magic, padded to 8 bytes, which is
+  // followed by a stream. The footer after the stream isn't needed.
+  uint32_t word = 0;
+  if (stream_.read(reinterpret_cast<char *>(&word), sizeof(word))) {
+    if (std::memcmp(&word, kFileMagic.data(), sizeof(word)) == 0) {
+      char rest[4];
+      if (!stream_.read(rest, sizeof(rest)) || std::string_view(rest, 2) != kFileMagic.substr(sizeof(word))) {
+        throw QueryRuntimeException("Invalid Arrow file, the magic is broken.");
+      }
+    } else {
+      first_word_ = word;
+    }
+  }
+  auto message = ReadMessage();
+  if (!message || message->header_type != kMessageHeaderSchema) {
+    throw QueryRuntimeException("Invalid Arrow data, the stream doesn't start with the schema.");
+  }
+  ReadSchema(message->metadata, columns);
+}
+
+std::optional<ArrowReader::Message> ArrowReader::ReadMessage() {
+  auto read = [this](void *out, size_t size) {
+    return static_cast<bool>(stream_.read(static_cast<char *>(out), static_cast<std::streamsize>(size)));
+  };
+  // The lengths aren't trusted, so the memory grows only with the data which
+  // is actually in the stream.
+  auto read_string = [&read](std::string *out, size_t size) {
+    for (size_t read_length = 0; read_length < size;) {
+      const auto chunk = std::min(kReadChunkSize, size - read_length);
+      out->resize(read_length + chunk);
+      if (!read(out->data() + read_length, chunk)) {
+        throw QueryRuntimeException("Invalid Arrow data, the stream ends inside a message.");
+      }
+      read_length += chunk;
+    }
+  };
+  uint32_t length = 0;
+  if (first_word_) {
+    length = *first_word_;
+    first_word_.reset();
+  } else if (!read(&length, sizeof(length))) {
+    // The stream may end without the end-of-stream marker.
+    return std::nullopt;
+  }
+  // The continuation is missing before the length in the older streams.
+  if (length == kContinuation && !read(&length, sizeof(length))) {
+    throw QueryRuntimeException("Invalid Arrow data, the stream ends inside a message.");
+  }
+  if (length == 0) return std::nullopt;
+
+  Message message;
+  read_string(&message.metadata, length);
+  const auto root = FlatBufferTable::Root(message.metadata);
+  if (root.Scalar<int16_t>(0, 0) != kMetadataVersionV5) {
+    throw QueryRuntimeException("Only the version 5 of the Arrow format is supported.");
+  }
+  message.header_type = root.Scalar<uint8_t>(1, 0);
+  const auto body_length = root.Scalar<int64_t>(3, 0);
+  if (body_length < 0) throw QueryRuntimeException("Invalid Arrow data, a message has a negative length.");
+  read_string(&message.body, static_cast<size_t>(body_length));
+  return message;
+}
+
+void ArrowReader::ReadSchema(const std::string &metadata, const std::vector<std::string> *columns) {
+  const auto root = FlatBufferTable::Root(metadata);
+  const auto schema = root.Table(2);
+  if (!schema) throw QueryRuntimeException("Invalid Arrow data, the schema is missing.");
+  const auto fields = schema->Vector(1);
+  size_t buffer = 0;
+  for (size_t node = 0; node < fields.second; ++node) {
+    const auto field = schema->Element(fields, node);
+    const auto type_type = field.Scalar<uint8_t>(2, 0);
+    const std::string name(field.String(0));
+    const bool decoded = !columns || std::find(columns->begin(), columns->end(), name) != columns->end();
+    if (field.Table(4)) {
+      throw QueryRuntimeException("Column '{}' can't be loaded because dictionary encoded Arrow columns aren't supported.",
+                                  name);
+    }
+    const auto num_buffers = NumBuffers(type_type);
+    const auto first_buffer = buffer;
+    buffer += num_buffers;
+    if (!decoded) continue;
+
+    Column column{.type = Type::NULL_, .node = node, .buffer = first_buffer};
+    const auto type = field.Table(3);
+    auto unsupported = [&name]() {
+      return QueryRuntimeException("Column '{}' can't be loaded because its Arrow type isn't supported.", name);
+    };
+    if (!type && type_type != kTypeNull) throw QueryRuntimeException("Invalid Arrow data, a type is missing.");
+    switch (type_type) {
+      case kTypeNull:
+        break;
+      case kTypeBool:
+        column.type = Type::BOOL;
+        break;
+      case kTypeInt: {
+        column.type = Type::INT;
+        const auto bit_width = type->Scalar<int32_t>(0, 0);
+        if (bit_width != 8 && bit_width != 16 && bit_width != 32 && bit_width != 64) throw unsupported();
+        column.width = bit_width / 8;
+        column.is_signed = type->Scalar<uint8_t>(1, 0) != 0;
+        break;
+      }
+      case kTypeFloatingPoint: {
+        column.type = Type::FLOAT;
+        const auto precision = type->Scalar<int16_t>(0, 0);
+        if (precision != kPrecisionSingle && precision != kPrecisionDouble) throw unsupported();
+        column.width = precision == kPrecisionSingle ? sizeof(float) : sizeof(double);
+        break;
+      }
+      case kTypeUtf8:
+      case kTypeLargeUtf8:
+        column.type = Type::STRING;
+        column.width = type_type == kTypeUtf8 ? sizeof(int32_t) : sizeof(int64_t);
+        break;
+      case kTypeDate: {
+        column.type = Type::DATE;
+        const auto unit = type->Scalar<int16_t>(0, kDateUnitMillisecond);
+        if (unit == kDateUnitDay) {
+          column.width = sizeof(int32_t);
+          column.multiplier = kMicrosecondsPerDay;
+        } else if (unit == kDateUnitMillisecond) {
+          column.width = sizeof(int64_t);
+          column.multiplier = 1'000;
+        } else {
+          throw unsupported();
+        }
+        break;
+      }
+      case kTypeTime: {
+        column.type = Type::TIME;
+        SetTimeUnit(type->Scalar<int16_t>(0, kTimeUnitMillisecond), &column.multiplier, &column.divisor);
+        const auto bit_width = type->Scalar<int32_t>(1, 32);
+        if (bit_width != 32 && bit_width != 64) throw unsupported();
+        column.width = bit_width / 8;
+        break;
+      }
+      case kTypeTimestamp:
+        column.type = Type::TIMESTAMP;
+        column.width = sizeof(int64_t);
+        SetTimeUnit(type->Scalar<int16_t>(0, kTimeUnitSecond), &column.multiplier, &column.divisor);
+        break;
+      case kTypeDuration:
+        column.type = Type::DURATION;
+        column.width = sizeof(int64_t);
+        SetTimeUnit(type->Scalar<int16_t>(0, kTimeUnitMillisecond), &column.multiplier, &column.divisor);
+        break;
+      default:
+        throw unsupported();
+    }
+    column_names_.push_back(name);
+    columns_.push_back(column);
+  }
+}
+
+std::optional<ArrowReader::Batch> ArrowReader::ReadBatch() {
+  while (auto message = ReadMessage()) {
+    switch (message->header_type) {
+      case kMessageHeaderRecordBatch:
+        return Batch{.metadata = std::move(message->metadata), .body = std::move(message->body)};
+      case kMessageHeaderDictionaryBatch:
+        throw QueryRuntimeException("Dictionary encoded Arrow columns aren't supported.");
+      default:
+        throw QueryRuntimeException("Invalid Arrow data, unexpected message in the stream.");
+    }
+  }
+  return std::nullopt;
+}
+
+ArrowReader::DecodedBatch ArrowReader::Decode(const Batch &batch) const {
+  const auto root = FlatBufferTable::Root(batch.metadata);
+  const auto header = root.Table(2);
+  if (!header) throw QueryRuntimeException("Invalid Arrow data, a record batch is missing.");
+  if (header->Table(3)) throw QueryRuntimeException("Compressed Arrow record batches aren't supported.");
+  const auto nodes = header->Vector(1);
+  const auto buffers = header->Vector(2);
+  const std::string_view body(batch.body);
+
+  auto get_buffer = [&](size_t index) {
+    const auto [offset, length] = ReadPair(batch.metadata, buffers, index);
+    if (offset < 0 || length < 0 || static_cast<size_t>(offset) > body.size() ||
+        body.size() - static_cast<size_t>(offset) < static_cast<size_t>(length)) {
+      throw QueryRuntimeException("Invalid Arrow data, a buffer is out of bounds.");
+    }
+    return body.substr(offset, length);
+  };
+
+  const auto length = header->Scalar<int64_t>(0, 0);
+  if (length < 0) throw QueryRuntimeException("Invalid Arrow data, a record batch has a negative length.");
+  DecodedBatch decoded{.rows = static_cast<size_t>(length), .columns = {}};
+  decoded.columns.resize(columns_.size());
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    const auto &column = columns_[i];
+    const auto [column_length, null_count] = ReadPair(batch.metadata, nodes, column.node);
+    if (column_length != length) throw QueryRuntimeException("Invalid Arrow data, a column has a wrong length.");
+    auto &column_values = decoded.columns[i];
+    const auto rows = decoded.rows;
+    if (column.type == Type::NULL_) {
+      column_values.resize(rows);
+      continue;
+    }
+
+    // The validity bitmap can be left out if there are no nulls.
+    const auto validity = get_buffer(column.buffer);
+    const bool has_nulls = null_count != 0 && !validity.empty();
+    if (has_nulls && validity.size() < (rows + 7) / 8) {
+      throw QueryRuntimeException("Invalid Arrow data, a buffer is too short.");
+    }
+    const auto data = get_buffer(column.buffer + 1);
+    // Returns the integer of `width` bytes at `index`, extended to 64 bits.
+    const auto read_int = [&column](std::string_view buffer, size_t index) -> int64_t {
+      const auto pos = index * column.width;
+      switch (column.width) {
+        case 1:
+          return column.is_signed ? Read<int8_t>(buffer, pos) : Read<uint8_t>(buffer, pos);
+        case 2:
+          return column.is_signed ? Read<int16_t>(buffer, pos) : Read<uint16_t>(buffer, pos);
+        case 4:
+          return column.is_signed ? Read<int32_t>(buffer, pos) : Read<uint32_t>(buffer, pos);
+        default: {
+          if (column.is_signed) return Read<int64_t>(buffer, pos);
+          const auto value = Read<uint64_t>(buffer, pos);
+          if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            throw QueryRuntimeException("An unsigned Arrow integer is too large to be loaded.");
+          }
+          return static_cast<int64_t>(value);
+        }
+      }
+    };
+
+    std::string_view strings;
+    switch (column.type) {
+      case Type::BOOL:
+        if (data.size() < (rows + 7) / 8) throw QueryRuntimeException("Invalid Arrow data, a buffer is too short.");
+        break;
+      case Type::STRING:
+        // The offsets of the strings have one entry more than the rows.
+        if (data.size() / column.width <= rows) {
+          throw QueryRuntimeException("Invalid Arrow data, a buffer is too short.");
+        }
+        strings = get_buffer(column.buffer + 2);
+        break;
+      default:
+        if (data.size() / column.width < rows) {
+          throw QueryRuntimeException("Invalid Arrow data, a buffer is too short.");
+        }
+        break;
+    }
+
+    column_values.reserve(rows);
+    for (size_t row = 0; row < rows; ++row) {
+      if (has_nulls && !IsSet(validity, row)) {
+        column_values.emplace_back();
+        continue;
+      }
+      switch (column.type) {
+        case Type::NULL_:
+          break;
+        case Type::BOOL:
+          column_values.emplace_back(IsSet(data, row));
+          break;
+        case Type::INT:
+          column_values.emplace_back(read_int(data, row));
+          break;
+        case Type::FLOAT:
+          column_values.emplace_back(column.width == sizeof(float)
+                                         ? static_cast<double>(Read<float>(data, row * sizeof(float)))
+                                         : Read<double>(data, row * sizeof(double)));
+          break;
+        case Type::STRING: {
+          const auto begin = read_int(data, row);
+          const auto end = read_int(data, row + 1);
+          if (begin < 0 || begin > end || static_cast<size_t>(end) > strings.size()) {
+            throw QueryRuntimeException("Invalid Arrow data, a string is out of bounds.");
+          }
+          column_values.emplace_back(strings.substr(begin, end - begin));
+          break;
+        }
+        case Type::DATE:
+          column_values.emplace_back(
+              utils::Date(ToMicroseconds(read_int(data, row), column.multiplier, column.divisor)));
+          break;
+        case Type::TIME:
+          column_values.emplace_back(
+              utils::LocalTime(ToMicroseconds(read_int(data, row), column.multiplier, column.divisor)));
+          break;
+        case Type::TIMESTAMP:
+          column_values.emplace_back(
+              utils::LocalDateTime(ToMicroseconds(read_int(data, row), column.multiplier, column.divisor)));
+          break;
+        case Type::DURATION:
+          column_values.emplace_back(
+              utils::Duration(ToMicroseconds(read_int(data, row), column.multiplier, column.divisor)));
+          break;
+      }
+    }
+  }
+  return decoded;
+}
+
+}  // namespace memgraph::query
@@ -0,0 +1,105 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Reading of data in the Arrow IPC formats, which LOAD ARROW imports column
+/// by column instead of parsing the text of each field.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "query/typed_value.hpp"
+
+namespace memgraph::query {
+
+/// Reader of the Arrow IPC streaming format and of the file format, which
+/// wraps a stream. The record batches are read from the stream one by one
+/// and decoded separately, so that several of them can be decoded at once on
+/// different threads.
+///
+/// Booleans, integers, floats, strings, dates, times, timestamps and
+/// durations are decoded as the corresponding values, with the temporal
+/// values in microseconds. Timestamps with a time zone are decoded as the
+/// local date times in UTC. Columns of other types, dictionary encoded
+/// columns and compressed batches aren't supported.
+class ArrowReader {
+ public:
+  /// A record batch as it's stored in the stream.
+  struct Batch {
+    std::string metadata;
+    std::string body;
+  };
+
+  struct DecodedBatch {
+    size_t rows{0};
+    /// Values of the decoded columns, in the order of `ColumnNames`.
+    std::vector<std::vector<TypedValue>> columns;
+  };
+
+  /// Reads the schema from the stream, which is then read by `ReadBatch`.
+  /// Only the `columns` are decoded, or all columns if it's nullptr. The
+  /// columns which aren't in the schema are left out.
+  /// @throw QueryRuntimeException if the stream isn't valid or a decoded
+  /// column isn't supported.
+  ArrowReader(std::istream &stream, const std::vector<std::string> *columns);
+
+  /// Names of the decoded columns, in the order of the schema.
+  const std::vector<std::string> &ColumnNames() const { return column_names_; }
+
+  /// Reads the next record batch without decoding it, or returns
+  /// std::nullopt at the end of the stream.
+  /// @throw QueryRuntimeException if the stream isn't valid.
+  std::optional<Batch> ReadBatch();
+
+  /// Decodes the columns of a batch read by `ReadBatch`. The values are
+  /// allocated with `utils::NewDeleteResource`, so batches can be decoded
+  /// concurrently.
+  /// @throw QueryRuntimeException if the batch isn't valid.
+  DecodedBatch Decode(const Batch &batch) const;
+
+ private:
+  enum class Type : uint8_t { NULL_, BOOL, INT, FLOAT, STRING, DATE, TIME, TIMESTAMP, DURATION };
+
+  struct Column {
+    Type type;
+    /// Width of a value in bytes, of the offsets for strings.
+    uint8_t width{0};
+    bool is_signed{true};
+    /// Conversion of the temporal values to microseconds.
+    int64_t multiplier{1};
+    int64_t divisor{1};
+    /// Positions of the field node and of the first buffer of the column.
+    size_t node{0};
+    size_t buffer{0};
+  };
+
+  struct Message {
+    uint8_t header_type;
+    std::string metadata;
+    std::string body;
+  };
+
+  std::optional<Message> ReadMessage();
+  void ReadSchema(const std::string &metadata, const std::vector<std::string> *columns);
+
+  std::istream &stream_;
+  /// First word of the stream, which was read to tell the formats apart.
+  std::optional<uint32_t> first_word_;
+  std::vector<std::string> column_names_;
+  std::vector<Column> columns_;
+};
+
+}  // namespace memgraph::query
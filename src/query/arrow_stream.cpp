@@ -0,0 +1,429 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/arrow_stream.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <utility>
+
+#include "query/exceptions.hpp"
+#include "utils/logging.hpp"
+
+namespace memgraph::query {
+
+namespace {
+
+// Constants of the Arrow format from Schema.fbs and Message.fbs.
+constexpr int16_t kMetadataVersionV5 = 4;
+constexpr uint8_t kMessageHeaderSchema = 1;
+constexpr uint8_t kMessageHeaderRecordBatch = 3;
+constexpr uint8_t kTypeNull = 1;
+constexpr uint8_t kTypeInt = 2;
+constexpr uint8_t kTypeFloatingPoint = 3;
+constexpr uint8_t kTypeUtf8 = 5;
+constexpr uint8_t kTypeBool = 6;
+constexpr uint8_t kTypeDate = 8;
+constexpr uint8_t kTypeTime = 9;
+constexpr uint8_t kTypeTimestamp = 10;
+constexpr uint8_t kTypeDuration = 18;
+constexpr int16_t kPrecisionDouble = 2;
+constexpr int16_t kDateUnitDay = 0;
+constexpr int16_t kTimeUnitMicrosecond = 2;
+constexpr uint32_t kContinuation = 0xFFFFFFFF;
+
+void Pad(std::string &out, size_t alignment) { out.resize((out.size() + alignment - 1) / alignment * alignment, '\0'); }
+
+template <class T>
+void Put(std::string &out, T value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  // The Arrow format is little endian, like all the platforms Memgraph runs on.
+  out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/// Builder of the flatbuffers which hold the metadata of Arrow messages. The
+/// flatbuffer is written front to back, so each table is followed by its
+/// children, and the offsets to the children are patched once they are
+/// written. All the values are aligned to their size relative to the start of
+/// the buffer.
+class FlatBufferBuilder {
+ public:
+  /// Scalar field or, if `offset` is set, an offset to a child which is
+  /// linked later.
+  struct Field {
+    uint16_t id;
+    uint8_t size;
+    uint64_t value{0};
+    bool offset{false};
+
+    static Field Offset(uint16_t id) { return {.id = id, .size = sizeof(uint32_t), .offset = true}; }
+  };
+
+  static constexpr size_t kMaxFields = 8;
+  /// Positions of the offset fields of a table, indexed by field id.
+  using Slots = std::array<size_t, kMaxFields>;
+
+  /// Position of the offset to the root table, which starts the buffer.
+  static constexpr size_t kRootSlot = 0;
+
+  FlatBufferBuilder() { Put<uint32_t>(buffer_, 0); }
+
+  /// Writes a table referenced by the offset at `slot` and returns the
+  /// positions of its offset fields.
+  Slots Table(size_t slot, std::vector<Field> fields) {
+    std::stable_sort(fields.begin(), fields.end(), [](const auto &a, const auto &b) { return a.size > b.size; });
+    uint16_t num_fields = 0;
+    for (const auto &field : fields) {
+      DMG_ASSERT(field.id < kMaxFields, "Too many fields in a flatbuffer table");
+      num_fields = std::max<uint16_t>(num_fields, field.id + 1);
+    }
+
+    Pad(buffer_, alignof(uint16_t));
+    const auto vtable = buffer_.size();
+    const auto vtable_size = sizeof(uint16_t) * (2 + num_fields);
+    const auto table = (vtable + vtable_size + 3) / 4 * 4;
+    std::array<uint16_t, kMaxFields> field_offsets{};
+    auto end = table + sizeof(int32_t);
+    for (const auto &field : fields) {
+      end = (end + field.size - 1) / field.size * field.size;
+      field_offsets[field.id] = end - table;
+      end += field.size;
+    }
+
+    Put<uint16_t>(buffer_, vtable_size);
+    Put<uint16_t>(buffer_, end - table);
+    for (uint16_t id = 0; id < num_fields; ++id) Put<uint16_t>(buffer_, field_offsets[id]);
+    buffer_.resize(table, '\0');
+    Patch(slot, table);
+    Put<int32_t>(buffer_, static_cast<int32_t>(table - vtable));
+
+    Slots slots{};
+    for (const auto &field : fields) {
+      buffer_.resize(table + field_offsets[field.id], '\0');
+      if (field.offset) slots[field.id] = buffer_.size();
+      buffer_.append(reinterpret_cast<const char *>(&field.value), field.size);
+    }
+    return slots;
+  }
+
+  /// Writes a vector of offsets and returns the positions of its elements.
+  std::vector<size_t> OffsetVector(size_t slot, size_t size) {
+    Pad(buffer_, alignof(uint32_t));
+    Patch(slot, buffer_.size());
+    Put<uint32_t>(buffer_, size);
+    std::vector<size_t> slots;
+    slots.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      slots.push_back(buffer_.size());
+      Put<uint32_t>(buffer_, 0);
+    }
+    return slots;
+  }
+
+  /// Writes a vector of structs of two longs, which are FieldNode and Buffer.
+  void StructVector(size_t slot, const std::vector<std::pair<int64_t, int64_t>> &elements) {
+    // The elements are aligned to 8 bytes and follow the 4 byte size.
+    Pad(buffer_, alignof(uint32_t));
+    if (buffer_.size() % alignof(int64_t) == 0) Put<uint32_t>(buffer_, 0);
+    Patch(slot, buffer_.size());
+    Put<uint32_t>(buffer_, elements.size());
+    for (const auto &[first, second] : elements) {
+      Put<int64_t>(buffer_, first);
+      Put<int64_t>(buffer_, second);
+    }
+  }
+
+  void String(size_t slot, std::string_view value) {
+    Pad(buffer_, alignof(uint32_t));
+    Patch(slot, buffer_.size());
+    Put<uint32_t>(buffer_, value.size());
+    buffer_.append(value);
+    buffer_.push_back('\0');
+  }
+
+
+  std::string Finish() && { return std::move(buffer_); }
+
+ private:
+  void Patch(size_t slot, size_t target) {
+    const auto offset = static_cast<uint32_t>(target - slot);
+    std::memcpy(buffer_.data() + slot, &offset, sizeof(offset));
+  }
+
+  std::string buffer_;
+};
+
+using Field = FlatBufferBuilder::Field;
+
+/// Appends a message with the flatbuffer `metadata` and the `body`, whose
+/// size is a multiple of 8 bytes, to the stream.
+void WriteMessage(std::string &out, const std::string &metadata, std::string_view body) {
+  Put<uint32_t>(out, kContinuation);
+  // The body has to start at a multiple of 8 bytes, and so does the message.
+  Put<int32_t>(out, static_cast<int32_t>((metadata.size() + 7) / 8 * 8));
+  out.append(metadata);
+  Pad(out, alignof(int64_t));
+  out.append(body);
+}
+
+/// Returns the bitmap in which bit `i` is set if `values[i]` isn't 0.
+template <class T>
+std::string Bitmap(const T *values, size_t size) {
+  std::string bitmap((size + 7) / 8, '\0');
+  for (size_t i = 0; i < size; ++i) {
+    if (values[i]) bitmap[i / 8] = static_cast<char>(bitmap[i / 8] | (1 << (i % 8)));
+  }
+  return bitmap;
+}
+
+}  // namespace
+
+ArrowResultStream::ArrowResultStream(std::vector<std::string> column_names, size_t batch_size)
+    : column_names_(std::move(column_names)),
+      columns_(column_names_.size()),
+      batch_size_(std::max<size_t>(batch_size, 1)) {}
+
+void ArrowResultStream::Result(const std::vector<TypedValue> &values) {
+  DMG_ASSERT(values.size() == columns_.size(), "Wrong number of values in a result");
+  for (size_t i = 0; i < values.size(); ++i) Append(i, values[i]);
+  ++rows_;
+}
+
+void ArrowResultStream::Append(size_t index, const TypedValue &value) {
+  auto &column = columns_[index];
+  Type type{Type::NULL_};
+  switch (value.type()) {
+    case TypedValue::Type::Null:
+      break;
+    case TypedValue::Type::Bool:
+      type = Type::BOOL;
+      break;
+    case TypedValue::Type::Int:
+      // Integers are converted in a column of floats.
+      type = column.type == Type::DOUBLE ? Type::DOUBLE : Type::INT;
+      break;
+    case TypedValue::Type::Double:
+      type = Type::DOUBLE;
+      break;
+    case TypedValue::Type::String:
+      type = Type::STRING;
+      break;
+    case TypedValue::Type::Date:
+      type = Type::DATE;
+      break;
+    case TypedValue::Type::LocalTime:
+      type = Type::LOCAL_TIME;
+      break;
+    case TypedValue::Type::LocalDateTime:
+      type = Type::LOCAL_DATE_TIME;
+      break;
+    case TypedValue::Type::Duration:
+      type = Type::DURATION;
+      break;
+    default:
+      throw QueryRuntimeException("Values of type {} in column '{}' can't be returned in the Arrow format.",
+                                  value.type(), column_names_[index]);
+  }
+
+  if (type != Type::NULL_ && type != column.type) {
+    if (column.type == Type::NULL_) {
+      column.type = type;
+      // Fill in the values of the null rows.
+      column.ints.resize(column.valid.size());
+      column.doubles.resize(column.valid.size());
+      column.ends.resize(column.valid.size());
+    } else if (column.type == Type::INT && type == Type::DOUBLE) {
+      column.type = Type::DOUBLE;
+      column.doubles.assign(column.ints.begin(), column.ints.end());
+    } else {
+      throw QueryRuntimeException(
+          "Column '{}' can't be returned in the Arrow format because it has values of type {} and of another type.",
+          column_names_[index], value.type());
+    }
+  }
+
+  column.valid.push_back(type != Type::NULL_);
+  switch (column.type) {
+    case Type::NULL_:
+      break;
+    case Type::BOOL:
+      column.ints.push_back(value.IsBool() && value.ValueBool());
+      break;
+    case Type::INT:
+      column.ints.push_back(value.IsInt() ? value.ValueInt() : 0);
+      break;
+    case Type::DOUBLE:
+      column.doubles.push_back(value.IsInt() ? static_cast<double>(value.ValueInt())
+                                             : (value.IsDouble() ? value.ValueDouble() : 0.0));
+      break;
+    case Type::STRING:
+      if (value.IsString()) column.chars.append(value.ValueString());
+      column.ends.push_back(column.chars.size());
+      break;
+    case Type::DATE:
+      column.ints.push_back(value.IsDate() ? value.ValueDate().DaysSinceEpoch() : 0);
+      break;
+    case Type::LOCAL_TIME:
+      column.ints.push_back(value.IsLocalTime() ? value.ValueLocalTime().MicrosecondsSinceEpoch() : 0);
+      break;
+    case Type::LOCAL_DATE_TIME:
+      column.ints.push_back(value.IsLocalDateTime() ? value.ValueLocalDateTime().MicrosecondsSinceEpoch() : 0);
+      break;
+    case Type::DURATION:
+      column.ints.push_back(value.IsDuration() ? value.ValueDuration().microseconds : 0);
+      break;
+  }
+}
+
+std::string ArrowResultStream::Finish() const {
+  std::string out;
+
+  FlatBufferBuilder schema;
+  const auto message = schema.Table(FlatBufferBuilder::kRootSlot, {{0, sizeof(int16_t), kMetadataVersionV5},
+                                                                   {1, sizeof(uint8_t), kMessageHeaderSchema},
+                                                                   Field::Offset(2),
+                                                                   {3, sizeof(int64_t), 0}});
+  // The endianness is left at its default, which is little endian.
+  const auto header = schema.Table(message[2], {Field::Offset(1)});
+  const auto fields = schema.OffsetVector(header[1], columns_.size());
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    uint8_t type_type = kTypeNull;
+    std::vector<Field> type_fields;
+    switch (columns_[i].type) {
+      case Type::NULL_:
+        break;
+      case Type::BOOL:
+        type_type = kTypeBool;
+        break;
+      case Type::INT:
+        type_type = kTypeInt;
+        type_fields = {{0, sizeof(int32_t), 64}, {1, sizeof(uint8_t), 1}};
+        break;
+      case Type::DOUBLE:
+        type_type = kTypeFloatingPoint;
+        type_fields = {{0, sizeof(int16_t), kPrecisionDouble}};
+        break;
+      case Type::STRING:
+        type_type = kTypeUtf8;
+        break;
+      case Type::DATE:
+        type_type = kTypeDate;
+        type_fields = {{0, sizeof(int16_t), kDateUnitDay}};
+        break;
+      case Type::LOCAL_TIME:
+        type_type = kTypeTime;
+        type_fields = {{0, sizeof(int16_t), kTimeUnitMicrosecond}, {1, sizeof(int32_t), 64}};
+        break;
+      case Type::LOCAL_DATE_TIME:
+        // Timestamp without a time zone.
+        type_type = kTypeTimestamp;
+        type_fields = {{0, sizeof(int16_t), kTimeUnitMicrosecond}};
+        break;
+      case Type::DURATION:
+        type_type = kTypeDuration;
+        type_fields = {{0, sizeof(int16_t), kTimeUnitMicrosecond}};
+        break;
+    }
+    const auto field = schema.Table(fields[i], {Field::Offset(0),
+                                                {1, sizeof(uint8_t), 1},
+                                                {2, sizeof(uint8_t), type_type},
+                                                Field::Offset(3),
+                                                Field::Offset(5)});
+    schema.String(field[0], column_names_[i]);
+    schema.Table(field[3], std::move(type_fields));
+    // Readers require the children even for types which have none.
+    schema.OffsetVector(field[5], 0);
+  }
+  WriteMessage(out, std::move(schema).Finish(), {});
+
+  for (size_t begin = 0; begin < rows_; begin += batch_size_) {
+    AppendBatch(out, begin, std::min(batch_size_, rows_ - begin));
+  }
+
+  Put<uint32_t>(out, kContinuation);
+  Put<int32_t>(out, 0);
+  return out;
+}
+
+void ArrowResultStream::AppendBatch(std::string &out, size_t begin, size_t size) const {
+  std::string body;
+  std::vector<std::pair<int64_t, int64_t>> nodes;
+  std::vector<std::pair<int64_t, int64_t>> buffers;
+  auto add_buffer = [&](const void *data, size_t length) {
+    buffers.emplace_back(body.size(), length);
+    body.append(static_cast<const char *>(data), length);
+    Pad(body, alignof(int64_t));
+  };
+  auto add_string = [&](const std::string &data) { add_buffer(data.data(), data.size()); };
+
+  for (const auto &column : columns_) {
+    const auto *valid = column.valid.data() + begin;
+    const auto null_count = static_cast<int64_t>(std::count(valid, valid + size, 0));
+    nodes.emplace_back(size, null_count);
+    // Columns of the null type don't have any buffers.
+    if (column.type == Type::NULL_) continue;
+
+    // The validity bitmap can be left out if there are no nulls.
+    if (null_count == 0) {
+      add_buffer(nullptr, 0);
+    } else {
+      add_string(Bitmap(valid, size));
+    }
+    switch (column.type) {
+      case Type::NULL_:
+        break;
+      case Type::BOOL:
+        add_string(Bitmap(column.ints.data() + begin, size));
+        break;
+      case Type::INT:
+      case Type::LOCAL_TIME:
+      case Type::LOCAL_DATE_TIME:
+      case Type::DURATION:
+        add_buffer(column.ints.data() + begin, size * sizeof(int64_t));
+        break;
+      case Type::DOUBLE:
+        add_buffer(column.doubles.data() + begin, size * sizeof(double));
+        break;
+      case Type::DATE: {
+        std::vector<int32_t> days(column.ints.begin() + begin, column.ints.begin() + begin + size);
+        add_buffer(days.data(), days.size() * sizeof(int32_t));
+        break;
+      }
+      case Type::STRING: {
+        const auto start = begin == 0 ? 0 : column.ends[begin - 1];
+        if (column.ends[begin + size - 1] - start > std::numeric_limits<int32_t>::max()) {
+          throw QueryRuntimeException("The strings in column '{}' are too large to be returned in the Arrow format.",
+                                      column_names_[&column - columns_.data()]);
+        }
+        std::vector<int32_t> offsets(size + 1, 0);
+        for (size_t i = 0; i < size; ++i) offsets[i + 1] = static_cast<int32_t>(column.ends[begin + i] - start);
+        add_buffer(offsets.data(), offsets.size() * sizeof(int32_t));
+        add_buffer(column.chars.data() + start, offsets.back());
+        break;
+      }
+    }
+  }
+
+  FlatBufferBuilder metadata;
+  const auto message = metadata.Table(FlatBufferBuilder::kRootSlot, {{0, sizeof(int16_t), kMetadataVersionV5},
+                                                                     {1, sizeof(uint8_t), kMessageHeaderRecordBatch},
+                                                                     Field::Offset(2),
+                                                                     {3, sizeof(int64_t), body.size()}});
+  const auto header = metadata.Table(message[2], {{0, sizeof(int64_t), size}, Field::Offset(1), Field::Offset(2)});
+  metadata.StructVector(header[1], nodes);
+  metadata.StructVector(header[2], buffers);
+  WriteMessage(out, std::move(metadata).Finish(), body);
+}
+
+}  // namespace memgraph::query
@@ -0,0 +1,74 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Query results in the Arrow IPC streaming format, which data frame
+/// libraries read column by column instead of decoding each record.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "query/typed_value.hpp"
+
+namespace memgraph::query {
+
+/// Result stream which collects the results of a query into columns and
+/// encodes them as an Arrow IPC stream. The stream consists of the schema,
+/// record batches of at most `batch_size` rows and the end-of-stream marker.
+///
+/// The Arrow type of a column is chosen from all of its values, which is why
+/// the stream is encoded only when all the results were collected. Booleans,
+/// integers, floats, strings, dates, local times, local date times and
+/// durations become the corresponding Arrow types, with the temporal types in
+/// microseconds. A column with both integers and floats becomes a column of
+/// floats, and a column of nulls has the Arrow null type.
+class ArrowResultStream {
+ public:
+  static constexpr size_t kDefaultBatchSize = 64UL * 1024UL;
+
+  explicit ArrowResultStream(std::vector<std::string> column_names, size_t batch_size = kDefaultBatchSize);
+
+  /// @throw QueryRuntimeException if a value can't be put into its column,
+  /// e.g. a node, or a string in a column of integers.
+  void Result(const std::vector<TypedValue> &values);
+
+  /// Returns the encoded stream of all the collected results.
+  /// @throw QueryRuntimeException if the strings of a batch are too large.
+  std::string Finish() const;
+
+ private:
+  enum class Type : uint8_t { NULL_, BOOL, INT, DOUBLE, STRING, DATE, LOCAL_TIME, LOCAL_DATE_TIME, DURATION };
+
+  /// Values of a column with one entry per row, including the null rows.
+  struct Column {
+    Type type{Type::NULL_};
+    std::vector<uint8_t> valid;
+    // Values of all the types but DOUBLE and STRING.
+    std::vector<int64_t> ints;
+    std::vector<double> doubles;
+    // End of each string in `chars`.
+    std::vector<uint64_t> ends;
+    std::string chars;
+  };
+
+  void Append(size_t index, const TypedValue &value);
+  void AppendBatch(std::string &out, size_t begin, size_t size) const;
+
+  std::vector<std::string> column_names_;
+  std::vector<Column> columns_;
+  size_t batch_size_;
+  size_t rows_{0};
+};
+
+}  // namespace memgraph::query
@@ -112,6 +112,25 @@ storage::PropertyValue PropsSetChecked(T *record, const storage::PropertyId &key
   }
 }
 
+/// Add `value` to the property `key` of the `record` when the transaction
+/// commits, see `storage::VertexAccessor::AddToProperty`.
+///
+/// @return false if the value can't be added, in which case the property has
+/// to be set instead
+/// @throw QueryRuntimeException if value cannot be set as a property value
+template <typename T>
+bool PropsAddChecked(T *record, const storage::PropertyId &key, const TypedValue &value) {
+  try {
+    auto maybe_added = record->AddToProperty(key, storage::PropertyValue(value));
+    if (maybe_added.HasError()) {
+      ProcessError(maybe_added.GetError());
+    }
+    return *maybe_added;
+  } catch (const TypedValueException &) {
+    throw QueryRuntimeException("'{}' cannot be used as a property value.", value.type());
+  }
+}
+
 template <typename T>
 concept AccessorWithInitProperties = requires(T accessor,
                                               const std::map<storage::PropertyId, storage::PropertyValue> &properties) {
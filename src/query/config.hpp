@@ -11,22 +11,82 @@
 
 #pragma once
 #include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
 #include <string>
 
+#include "integrations/adaptive_batching.hpp"
+
 namespace memgraph::query {
 struct InterpreterConfig {
   struct Query {
     bool allow_load_csv{true};
+    // Maximum number of threads used by queries with the parallel execution hint.
+    uint64_t parallel_execution_threads{1};
+    // Approximate number of bytes ORDER BY, DISTINCT and aggregations may keep
+    // in memory before spilling to `spill_directory`, 0 means no limit.
+    uint64_t spill_memory_limit{0};
+    std::filesystem::path spill_directory;
+    // Number of records a read procedure may yield before it waits for them to
+    // be pulled, 0 means that all records of a call are kept in memory.
+    uint64_t procedure_result_buffer_size{0};
+    // Makes `SET n.p = n.p + x` add to the property when the transaction
+    // commits, so concurrent increments don't conflict.
+    bool commutative_increments{false};
+    // Bytes the queries running on the database may allocate for their
+    // execution together, 0 means no limit.
+    uint64_t database_memory_limit{0};
+    // Bytes a single transaction may allocate, 0 means no limit.
+    uint64_t transaction_memory_limit{0};
+    // Number of distinct queries tracked by the query statistics, 0 disables
+    // them. See `QueryStats`.
+    uint64_t stats_max_queries{0};
+    // Queries executing longer are kept in the slow query log, 0 disables the
+    // log.
+    std::chrono::milliseconds slow_query_threshold{0};
+    uint64_t slow_query_log_size{0};
+    // Number of results of read-only queries kept in the `ResultCache`, 0
+    // disables the cache.
+    uint64_t result_cache_size{0};
+    uint64_t result_cache_max_rows{0};
   } query;
 
+  // Limits of the queries executed at the same time on a database, see
+  // `AdmissionController`. Zero limits mean no limit.
+  struct Admission {
+    uint64_t max_concurrent_queries{0};
+    uint64_t max_concurrent_queries_per_user{0};
+    uint64_t max_memory_in_flight{0};
+    uint64_t max_memory_in_flight_per_user{0};
+    // Memory reserved by a query without a QUERY MEMORY LIMIT.
+    uint64_t default_query_memory{0};
+    uint64_t max_queue_size{0};
+    std::chrono::milliseconds queue_timeout{0};
+  } admission;
+
   // The default execution timeout is 10 minutes.
   double execution_timeout_sec{600.0};
   // The same as \ref memgraph::storage::replication::ReplicationClientConfig
   std::chrono::seconds replication_replica_check_frequency{1};
+  // Compression of the recovery files sent to newly registered replicas
+  bool replication_compression{false};
+  // How long a transaction waits for the commit referenced by the client's bookmark
+  std::chrono::milliseconds bookmark_wait_timeout{10000};
+  // Number of workers running the AFTER COMMIT triggers, and the number of committed transactions whose AFTER COMMIT
+  // triggers may wait for the workers before the commits wait as well, 0 means no limit.
+  uint64_t after_commit_trigger_workers{1};
+  uint64_t after_commit_trigger_max_backlog{0};
 
   std::string default_kafka_bootstrap_servers;
+  // Number of workers which process the partitions of newly created Kafka streams in parallel
+  uint32_t kafka_partition_workers{1};
+  // Bounds within which the batches of the Kafka streams are tuned, if adaptive batching is enabled
+  std::optional<integrations::AdaptiveBatchingConfig> kafka_adaptive_batching;
   std::string default_pulsar_service_url;
   uint32_t stream_transaction_conflict_retries;
   std::chrono::milliseconds stream_transaction_retry_interval;
+  // Whether consecutive rows of a transformation result with the same query are executed as a single query
+  bool stream_batch_queries{false};
 };
 }  // namespace memgraph::query
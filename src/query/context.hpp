@@ -11,8 +11,13 @@
 
 #pragma once
 
+#include <filesystem>
+#include <limits>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
 
 #include "query/common.hpp"
 #include "query/frontend/semantic/symbol_table.hpp"
@@ -21,6 +26,8 @@
 #include "query/plan/profile.hpp"
 #include "query/trigger.hpp"
 #include "utils/async_timer.hpp"
+#include "utils/interrupt.hpp"
+#include "utils/regex.hpp"
 
 #include "query/frame_change.hpp"
 
@@ -35,6 +42,112 @@ enum class TransactionStatus {
   STARTED_ROLLBACK,
 };
 
+/// Ids of the property names which are only known during the execution, e.g.
+/// the keys in `n[$key]` or `SET n += $map`. Each name is resolved through the
+/// storage once per execution, and the last one is also kept aside, since the
+/// same key is usually looked up for every row.
+class PropertyNameCache {
+ public:
+  PropertyNameCache() = default;
+  // A copy must not point to the last name of the original.
+  PropertyNameCache(const PropertyNameCache &other) : ids_(other.ids_) {}
+  PropertyNameCache &operator=(const PropertyNameCache &other) {
+    if (this != &other) {
+      ids_ = other.ids_;
+      last_ = nullptr;
+    }
+    return *this;
+  }
+  PropertyNameCache(PropertyNameCache &&) noexcept = default;
+  PropertyNameCache &operator=(PropertyNameCache &&) noexcept = default;
+  ~PropertyNameCache() = default;
+
+  storage::PropertyId Resolve(std::string_view name, DbAccessor *dba) {
+    if (last_ && last_->first == name) return last_->second;
+    auto found = ids_.find(name);
+    if (found == ids_.end()) found = ids_.emplace(std::string(name), dba->NameToProperty(name)).first;
+    last_ = &*found;
+    return found->second;
+  }
+
+ private:
+  struct Hash {
+    using is_transparent = void;
+    size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+  };
+
+  // The elements of an unordered_map aren't moved when it grows.
+  std::unordered_map<std::string, storage::PropertyId, Hash, std::equal_to<>> ids_;
+  const std::pair<const std::string, storage::PropertyId> *last_{nullptr};
+};
+
+/// Regular expressions compiled for `=~` during an execution. A pattern is
+/// compiled once instead of for every row, and the last one is also kept
+/// aside, since the same pattern is usually matched for every row.
+class RegexCache {
+ public:
+  RegexCache() = default;
+  // A copy must not point to the last pattern of the original.
+  RegexCache(const RegexCache &other) : regexes_(other.regexes_) {}
+  RegexCache &operator=(const RegexCache &other) {
+    if (this != &other) {
+      regexes_ = other.regexes_;
+      last_ = nullptr;
+    }
+    return *this;
+  }
+  RegexCache(RegexCache &&) noexcept = default;
+  RegexCache &operator=(RegexCache &&) noexcept = default;
+  ~RegexCache() = default;
+
+  /// Throws `std::regex_error` if the pattern is invalid.
+  const utils::Regex &Get(std::string_view pattern) {
+    if (last_ && last_->first == pattern) return *last_->second;
+    auto found = regexes_.find(pattern);
+    if (found == regexes_.end()) {
+      auto regex = std::make_shared<const utils::Regex>(pattern);
+      // The patterns computed for every row could fill the memory otherwise.
+      if (regexes_.size() >= kMaxPatterns) regexes_.clear();
+      found = regexes_.emplace(std::string(pattern), std::move(regex)).first;
+    }
+    last_ = &*found;
+    return *found->second;
+  }
+
+ private:
+  static constexpr size_t kMaxPatterns = 1024;
+
+  struct Hash {
+    using is_transparent = void;
+    size_t operator()(std::string_view pattern) const { return std::hash<std::string_view>{}(pattern); }
+  };
+
+  // The elements of an unordered_map aren't moved when it grows. The regexes
+  // are shared by the copies, matching doesn't change them.
+  std::unordered_map<std::string, std::shared_ptr<const utils::Regex>, Hash, std::equal_to<>> regexes_;
+  const std::pair<const std::string, std::shared_ptr<const utils::Regex>> *last_{nullptr};
+};
+
+/// Values of the functions which are constant during an execution, see
+/// `Function::is_constant_`. Each function is evaluated when it's first needed,
+/// so the errors are raised and the short-circuiting is respected as if it
+/// were evaluated for every row.
+class ConstantCache {
+ public:
+  const TypedValue *Find(const Function *function) const {
+    auto found = values_.find(function);
+    return found == values_.end() ? nullptr : &found->second;
+  }
+
+  void Insert(const Function *function, const TypedValue &value) {
+    // The memory of the evaluation is only valid during a single pull.
+    values_.insert_or_assign(function, TypedValue(value, utils::NewDeleteResource()));
+  }
+
+ private:
+  std::unordered_map<const Function *, TypedValue> values_;
+};
+
 struct EvaluationContext {
   /// Memory for allocations during evaluation of a *single* Pull call.
   ///
@@ -51,6 +164,15 @@ struct EvaluationContext {
   /// All counters generated by `counter` function, mutable because the function
   /// modifies the values
   mutable std::unordered_map<std::string, int64_t> counters{};
+  /// Property names resolved during the evaluation, mutable for the same
+  /// reason as the counters
+  mutable PropertyNameCache property_names{};
+  /// Compiled patterns of the regex matches, mutable for the same reason as
+  /// the counters
+  mutable RegexCache regexes{};
+  /// Values of the constant functions, mutable for the same reason as the
+  /// counters
+  mutable ConstantCache constants{};
 };
 
 inline std::vector<storage::PropertyId> NamesToProperties(const std::vector<std::string> &property_names,
@@ -72,6 +194,14 @@ inline std::vector<storage::LabelId> NamesToLabels(const std::vector<std::string
   return labels;
 }
 
+/// Elements of the list of an UNWIND unwound by a worker of a parallel
+/// pipeline.
+struct UnwindMorsel {
+  const TypedValue::TVector *values;
+  size_t begin;
+  size_t end;
+};
+
 struct ExecutionContext {
   DbAccessor *db_accessor{nullptr};
   SymbolTable symbol_table;
@@ -86,6 +216,33 @@ struct ExecutionContext {
   TriggerContextCollector *trigger_context_collector{nullptr};
   FrameChangeCollector *frame_change_collector{nullptr};
   std::shared_ptr<utils::AsyncTimer> timer;
+  /// Maximum number of threads a single operator may use to pull its input,
+  /// 1 means that the whole plan is executed on the calling thread.
+  uint64_t parallelism{1};
+  /// Set for the workers of a parallel pipeline, the ScanAll at the bottom of
+  /// the pipeline iterates only over this morsel of vertices and consumes it.
+  VerticesIterable *scan_morsel{nullptr};
+  /// Set for the workers of a parallel pipeline over an UNWIND, the Unwind at
+  /// the bottom of the pipeline yields only this morsel of its list and
+  /// consumes it.
+  const UnwindMorsel *unwind_morsel{nullptr};
+  /// Approximate number of bytes an operator may keep in memory before it
+  /// spills its state to `spill_directory`, 0 means no limit.
+  uint64_t spill_memory_limit{0};
+  std::filesystem::path spill_directory;
+  /// Number of records a read procedure may yield before it's suspended until
+  /// they're pulled, 0 means that the procedure runs to completion at once.
+  uint64_t procedure_result_buffer_size{0};
+  /// Set if `SET n.p = n.p + x` adds to the property when the transaction
+  /// commits, see `storage::VertexAccessor::AddToProperty`.
+  bool commutative_increments{false};
+  /// Id of the query carried by the USDT probes of the operators.
+  uint64_t query_id{0};
+  /// The interrupt epoch when the abort conditions were last read and the
+  /// number of `ShouldAbort` calls left until they're read again regardless.
+  /// The maximum epoch makes the first call read them.
+  mutable uint64_t checked_interrupt_epoch{std::numeric_limits<uint64_t>::max()};
+  mutable uint32_t abort_checks_until_read{0};
 #ifdef MG_ENTERPRISE
   std::unique_ptr<FineGrainedAuthChecker> auth_checker{nullptr};
 #endif
@@ -108,6 +265,26 @@ inline auto MustAbort(const ExecutionContext &context) noexcept -> AbortReason {
   return AbortReason::NO_ABORT;
 }
 
+/// Number of `ShouldAbort` calls after which the abort conditions are read
+/// even if the interrupt epoch didn't change, in case they were set without
+/// advancing it.
+inline constexpr uint32_t kAbortConditionsReadInterval = 64;
+
+/// Same as `MustAbort`, but reads the abort conditions only if an execution
+/// was interrupted since they were last read, or every
+/// `kAbortConditionsReadInterval` calls. The other calls cost a single load of
+/// the interrupt epoch, so this can be called for each row.
+inline auto ShouldAbort(const ExecutionContext &context) noexcept -> AbortReason {
+  const auto epoch = utils::InterruptEpoch();
+  if (epoch == context.checked_interrupt_epoch && context.abort_checks_until_read > 0) {
+    --context.abort_checks_until_read;
+    return AbortReason::NO_ABORT;
+  }
+  context.checked_interrupt_epoch = epoch;
+  context.abort_checks_until_read = kAbortConditionsReadInterval;
+  return MustAbort(context);
+}
+
 inline plan::ProfilingStatsWithTotalTime GetStatsWithTotalTime(const ExecutionContext &context) {
   return plan::ProfilingStatsWithTotalTime{context.stats, context.profile_execution_time};
 }
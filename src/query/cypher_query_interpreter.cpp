@@ -11,39 +11,156 @@
 
 #include "query/cypher_query_interpreter.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "query/plan/cardinality_feedback.hpp"
+#include "query/plan/pretty_print.hpp"
+#include "query/plan/read_write_type_checker.hpp"
+#include "utils/logging.hpp"
+
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_bool(query_cost_planner, true, "Use the cost-estimating query planner.");
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_VALIDATED_int32(query_plan_cache_ttl, 60, "Time to live for cached query plans, in seconds.",
                        FLAG_IN_RANGE(0, std::numeric_limits<int32_t>::max()));
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_double(query_plan_cardinality_feedback_threshold, 10,
+                        "How many times the number of rows of an operator observed by PROFILE has to differ from the "
+                        "estimated one for the cached plans of the query to be made again with the observed "
+                        "cardinalities. 0 disables the feedback.",
+                        FLAG_IN_RANGE(0, std::numeric_limits<double>::max()));
 
 namespace memgraph::query {
-CachedPlan::CachedPlan(std::unique_ptr<LogicalPlan> plan) : plan_(std::move(plan)) {}
+CachedPlan::CachedPlan(std::unique_ptr<LogicalPlan> plan, const uint64_t plan_hash)
+    : plan_(std::move(plan)), plan_hash_(plan_hash) {}
 
-ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::string, storage::PropertyValue> &params,
-                       utils::SkipList<QueryCacheEntry> *cache, const InterpreterConfig::Query &query_config) {
-  // Strip the query for caching purposes. The process of stripping a query
-  // "normalizes" it by replacing any literals with new parameters. This
-  // results in just the *structure* of the query being taken into account for
-  // caching.
-  frontend::StrippedQuery stripped_query{query_string};
+std::shared_ptr<CachedPlan> CachedPlanVariants::Find(const std::vector<uint64_t> &buckets) {
+  auto plans = plans_.Lock();
+  auto it = std::find_if(plans->begin(), plans->end(), [&buckets](const auto &plan) { return plan.first == buckets; });
+  if (it == plans->end()) return nullptr;
+  if (it->second->IsExpired()) {
+    plans->erase(it);
+    return nullptr;
+  }
+  return it->second;
+}
 
-  // Copy over the parameters that were introduced during stripping.
-  Parameters parameters{stripped_query.literals()};
+void CachedPlanVariants::Insert(std::vector<uint64_t> buckets, std::shared_ptr<CachedPlan> plan) {
+  auto plans = plans_.Lock();
+  auto it = std::find_if(plans->begin(), plans->end(), [&buckets](const auto &plan) { return plan.first == buckets; });
+  if (it != plans->end()) {
+    it->second = std::move(plan);
+    return;
+  }
+  if (plans->size() >= kMaxCachedPlanVariants) {
+    plans->erase(plans->begin());
+  }
+  plans->emplace_back(std::move(buckets), std::move(plan));
+}
 
-  // Check that all user-specified parameters are provided.
-  for (const auto &param_pair : stripped_query.parameters()) {
-    auto it = params.find(param_pair.second);
+void CachedPlanVariants::Invalidate(plan::CardinalityCorrections corrections) {
+  // The corrections are set first, so a plan made after the plans are removed
+  // is made with them.
+  *corrections_.Lock() = corrections;
+  plans_->clear();
+}
 
-    if (it == params.end()) {
-      throw query::UnprovidedParameterError("Parameter ${} not provided.", param_pair.second);
+namespace {
+
+class ParameterSensitiveLookupCollector : public plan::HierarchicalLogicalOperatorVisitor {
+ public:
+  using HierarchicalLogicalOperatorVisitor::PostVisit;
+  using HierarchicalLogicalOperatorVisitor::PreVisit;
+  using HierarchicalLogicalOperatorVisitor::Visit;
+
+  bool Visit(plan::Once & /*op*/) override { return true; }
+
+  bool PostVisit(plan::ScanAllByLabelPropertyValue &op) override {
+    if (auto *parameter = utils::Downcast<ParameterLookup>(op.expression_)) {
+      lookups_.push_back({op.label_, op.property_, parameter->token_position_});
     }
+    return true;
+  }
 
-    parameters.Add(param_pair.first, it->second);
+  std::vector<ParameterSensitiveLookup> lookups_;
+};
+
+std::vector<ParameterSensitiveLookup> CollectParameterSensitiveLookups(const plan::LogicalOperator &root) {
+  ParameterSensitiveLookupCollector collector;
+  const_cast<plan::LogicalOperator &>(root).Accept(collector);
+  return std::move(collector.lookups_);
+}
+
+bool IsReadOnlyPlan(const plan::LogicalOperator &root) {
+  plan::ReadWriteTypeChecker checker;
+  checker.InferRWType(const_cast<plan::LogicalOperator &>(root));
+  return checker.type == plan::ReadWriteTypeChecker::RWType::NONE ||
+         checker.type == plan::ReadWriteTypeChecker::RWType::R;
+}
+
+// Buckets the estimated number of vertices of each lookup by its order of
+// magnitude. The estimation uses the index statistics when they hold the
+// distribution of the values, same as the planner.
+std::vector<uint64_t> SelectivityBuckets(const std::vector<ParameterSensitiveLookup> &lookups,
+                                         const Parameters &parameters, DbAccessor *db_accessor) {
+  std::vector<uint64_t> buckets;
+  if (lookups.empty()) return buckets;
+  buckets.reserve(lookups.size());
+  auto vertex_counts = plan::MakeVertexCountCache(db_accessor);
+  for (const auto &lookup : lookups) {
+    const auto count = vertex_counts.VerticesCount(lookup.label, lookup.property,
+                                                   parameters.AtTokenPosition(lookup.token_position));
+    buckets.push_back(static_cast<uint64_t>(std::log10(static_cast<double>(count) + 1.0)));
   }
+  return buckets;
+}
+
+}  // namespace
+
+bool IsCachedReadOnlyQuery(const uint64_t hash, utils::SkipList<PlanCacheEntry> *plan_cache) {
+  auto access = plan_cache->access();
+  auto it = access.find(hash);
+  return it != access.end() && it->second->read_only();
+}
+
+void InvalidatePlanCache(utils::SkipList<PlanCacheEntry> *plan_cache) {
+  auto access = plan_cache->access();
+  for (auto &kv : access) {
+    access.remove(kv.first);
+  }
+}
+
+namespace {
+
+CachedQuery CloneCachedQuery(const CachedQuery &cached_query) {
+  CachedQuery result;
+  result.ast_storage.properties_ = cached_query.ast_storage.properties_;
+  result.ast_storage.labels_ = cached_query.ast_storage.labels_;
+  result.ast_storage.edge_types_ = cached_query.ast_storage.edge_types_;
+
+  result.query = cached_query.query->Clone(&result.ast_storage);
+  result.required_privileges = cached_query.required_privileges;
+  return result;
+}
+
+}  // namespace
+
+PreparedStatement PreparedStatement::Clone() const {
+  return PreparedStatement{query_string, stripped_query, CloneCachedQuery(cached_query), is_cacheable};
+}
+
+PreparedStatement PrepareStatement(const std::string &query_string, utils::SkipList<QueryCacheEntry> *cache,
+                                   const InterpreterConfig::Query &query_config) {
+  // Strip the query for caching purposes. The process of stripping a query
+  // "normalizes" it by replacing any literals with new parameters. This
+  // results in just the *structure* of the query being taken into account for
+  // caching.
+  auto stripped_query = std::make_shared<const frontend::StrippedQuery>(query_string);
 
   // Cache the query's AST if it isn't already.
-  auto hash = stripped_query.hash();
+  auto hash = stripped_query->hash();
   auto accessor = cache->access();
   auto it = accessor.find(hash);
   std::unique_ptr<frontend::opencypher::Parser> parser;
@@ -52,18 +169,9 @@ ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::stri
   CachedQuery result;
   bool is_cacheable = true;
 
-  auto get_information_from_cache = [&](const auto &cached_query) {
-    result.ast_storage.properties_ = cached_query.ast_storage.properties_;
-    result.ast_storage.labels_ = cached_query.ast_storage.labels_;
-    result.ast_storage.edge_types_ = cached_query.ast_storage.edge_types_;
-
-    result.query = cached_query.query->Clone(&result.ast_storage);
-    result.required_privileges = cached_query.required_privileges;
-  };
-
   if (it == accessor.end()) {
     try {
-      parser = std::make_unique<frontend::opencypher::Parser>(stripped_query.query());
+      parser = std::make_unique<frontend::opencypher::Parser>(stripped_query->query());
     } catch (const SyntaxException &e) {
       // There is a syntax exception in the stripped query. Re-run the parser
       // on the original query to get an appropriate error messsage.
@@ -89,7 +197,7 @@ ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::stri
       CachedQuery cached_query{std::move(ast_storage), visitor.query(), query::GetRequiredPrivileges(visitor.query())};
       it = accessor.insert({hash, std::move(cached_query)}).first;
 
-      get_information_from_cache(it->second);
+      result = CloneCachedQuery(it->second);
     } else {
       result.ast_storage.properties_ = ast_storage.properties_;
       result.ast_storage.labels_ = ast_storage.labels_;
@@ -101,51 +209,114 @@ ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::stri
       is_cacheable = false;
     }
   } else {
-    get_information_from_cache(it->second);
+    result = CloneCachedQuery(it->second);
+  }
+
+  return PreparedStatement{query_string, std::move(stripped_query), std::move(result), is_cacheable};
+}
+
+ParsedQuery BindParameters(PreparedStatement statement, const std::map<std::string, storage::PropertyValue> &params) {
+  // Copy over the parameters that were introduced during stripping.
+  Parameters parameters{statement.stripped_query->literals()};
+
+  // Check that all user-specified parameters are provided.
+  for (const auto &param_pair : statement.stripped_query->parameters()) {
+    auto it = params.find(param_pair.second);
+
+    if (it == params.end()) {
+      throw query::UnprovidedParameterError("Parameter ${} not provided.", param_pair.second);
+    }
+
+    parameters.Add(param_pair.first, it->second);
   }
 
-  return ParsedQuery{query_string,
+  return ParsedQuery{std::move(statement.query_string),
                      params,
                      std::move(parameters),
-                     std::move(stripped_query),
-                     std::move(result.ast_storage),
-                     result.query,
-                     std::move(result.required_privileges),
-                     is_cacheable};
+                     std::move(statement.stripped_query),
+                     std::move(statement.cached_query.ast_storage),
+                     statement.cached_query.query,
+                     std::move(statement.cached_query.required_privileges),
+                     statement.is_cacheable};
+}
+
+ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::string, storage::PropertyValue> &params,
+                       utils::SkipList<QueryCacheEntry> *cache, const InterpreterConfig::Query &query_config) {
+  return BindParameters(PrepareStatement(query_string, cache, query_config), params);
 }
 
 std::unique_ptr<LogicalPlan> MakeLogicalPlan(AstStorage ast_storage, CypherQuery *query, const Parameters &parameters,
                                              DbAccessor *db_accessor,
-                                             const std::vector<Identifier *> &predefined_identifiers) {
+                                             const std::vector<Identifier *> &predefined_identifiers,
+                                             const plan::CardinalityCorrections &corrections) {
   auto vertex_counts = plan::MakeVertexCountCache(db_accessor);
   auto symbol_table = MakeSymbolTable(query, predefined_identifiers);
   auto planning_context = plan::MakePlanningContext(&ast_storage, &symbol_table, query, &vertex_counts);
-  auto [root, cost] = plan::MakeLogicalPlan(&planning_context, parameters, FLAGS_query_cost_planner);
+  auto [root, cost] = plan::MakeLogicalPlan(&planning_context, parameters, FLAGS_query_cost_planner, corrections);
   return std::make_unique<SingleNodeLogicalPlan>(std::move(root), cost, std::move(ast_storage),
                                                  std::move(symbol_table));
 }
 
+bool ApplyCardinalityFeedback(const uint64_t hash, const CachedPlan &plan, const plan::ProfilingStats &stats,
+                              const Parameters &parameters, utils::SkipList<PlanCacheEntry> *plan_cache,
+                              DbAccessor *db_accessor) {
+  if (!plan_cache || FLAGS_query_plan_cardinality_feedback_threshold == 0) return false;
+  auto access = plan_cache->access();
+  auto it = access.find(hash);
+  if (it == access.end()) return false;
+  const auto &variants = it->second;
+
+  auto vertex_counts = plan::MakeVertexCountCache(db_accessor);
+  const auto cardinalities = plan::CompareCardinalities(plan.plan(), stats, &vertex_counts, plan.symbol_table(),
+                                                        parameters, variants->corrections());
+  const bool misestimated = std::any_of(cardinalities.begin(), cardinalities.end(), [](const auto &cardinality) {
+    return plan::CardinalityError(cardinality.estimated, cardinality.actual) >
+           FLAGS_query_plan_cardinality_feedback_threshold;
+  });
+  if (!misestimated) return false;
+  auto corrections = plan::CorrectCardinalities(cardinalities);
+  // Without anything to correct the same plan would be made again.
+  if (corrections.empty()) return false;
+  spdlog::debug("Cardinalities of the plan of query {} were misestimated, the query will be planned again", hash);
+  variants->Invalidate(corrections);
+  return true;
+}
+
 std::shared_ptr<CachedPlan> CypherQueryToPlan(uint64_t hash, AstStorage ast_storage, CypherQuery *query,
                                               const Parameters &parameters, utils::SkipList<PlanCacheEntry> *plan_cache,
                                               DbAccessor *db_accessor,
                                               const std::vector<Identifier *> &predefined_identifiers) {
   std::optional<utils::SkipList<PlanCacheEntry>::Accessor> plan_cache_access;
+  std::shared_ptr<CachedPlanVariants> variants;
+  std::vector<uint64_t> buckets;
   if (plan_cache) {
     plan_cache_access.emplace(plan_cache->access());
     auto it = plan_cache_access->find(hash);
     if (it != plan_cache_access->end()) {
-      if (it->second->IsExpired()) {
-        plan_cache_access->remove(hash);
-      } else {
-        return it->second;
+      variants = it->second;
+      buckets = SelectivityBuckets(variants->lookups(), parameters, db_accessor);
+      if (auto plan = variants->Find(buckets)) {
+        return plan;
       }
     }
   }
 
-  auto plan = std::make_shared<CachedPlan>(
-      MakeLogicalPlan(std::move(ast_storage), query, parameters, db_accessor, predefined_identifiers));
+  auto logical_plan = MakeLogicalPlan(std::move(ast_storage), query, parameters, db_accessor, predefined_identifiers,
+                                      variants ? variants->corrections() : plan::CardinalityCorrections{});
+  // The plan is only hashed when it's made, so the cached plans don't add to
+  // the cost of recording the query statistics.
+  const auto plan_hash = std::hash<std::string>{}(plan::PlanToJson(*db_accessor, &logical_plan->GetRoot()).dump());
+  auto plan = std::make_shared<CachedPlan>(std::move(logical_plan), plan_hash);
   if (plan_cache_access) {
-    plan_cache_access->insert({hash, plan});
+    if (!variants) {
+      // Another query could have inserted the entry in the meantime.
+      variants = plan_cache_access
+                     ->insert({hash, std::make_shared<CachedPlanVariants>(
+                                         CollectParameterSensitiveLookups(plan->plan()), IsReadOnlyPlan(plan->plan()))})
+                     .first->second;
+      buckets = SelectivityBuckets(variants->lookups(), parameters, db_accessor);
+    }
+    variants->Insert(std::move(buckets), plan);
   }
   return plan;
 }
@@ -18,7 +18,10 @@
 #include "query/frontend/semantic/symbol_generator.hpp"
 #include "query/frontend/stripped.hpp"
 #include "query/plan/planner.hpp"
+#include "query/plan/profile.hpp"
 #include "utils/flag_validation.hpp"
+#include "utils/spin_lock.hpp"
+#include "utils/synchronized.hpp"
 #include "utils/timer.hpp"
 
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
@@ -49,12 +52,15 @@ class LogicalPlan {
 
 class CachedPlan {
  public:
-  explicit CachedPlan(std::unique_ptr<LogicalPlan> plan);
+  explicit CachedPlan(std::unique_ptr<LogicalPlan> plan, uint64_t plan_hash = 0);
 
   const auto &plan() const { return plan_->GetRoot(); }
   double cost() const { return plan_->GetCost(); }
   const auto &symbol_table() const { return plan_->GetSymbolTable(); }
   const auto &ast_storage() const { return plan_->GetAstStorage(); }
+  /// Hash of the plan's operators, which tells apart the different plans of a
+  /// query in the query statistics.
+  uint64_t plan_hash() const { return plan_hash_; }
 
   bool IsExpired() const {
     // NOLINTNEXTLINE (modernize-use-nullptr)
@@ -63,9 +69,67 @@ class CachedPlan {
 
  private:
   std::unique_ptr<LogicalPlan> plan_;
+  uint64_t plan_hash_;
   utils::Timer cache_timer_;
 };
 
+/// Index lookup of a plan whose number of vertices depends on the value of a
+/// query parameter.
+struct ParameterSensitiveLookup {
+  storage::LabelId label;
+  storage::PropertyId property;
+  int token_position;
+};
+
+/// Maximum number of plans cached for a single query.
+inline constexpr size_t kMaxCachedPlanVariants{4};
+
+/// Plans cached for a single query.
+///
+/// The best plan for a query can depend on the parameter values, e.g. looking
+/// up a hub vertex instead of a leaf. Because of that, the estimated number of
+/// vertices of each parameter sensitive lookup is bucketed by its order of
+/// magnitude and a separate plan is cached for each combination of buckets.
+/// The lookups are taken from the first plan made for the query.
+///
+/// When profiling a plan shows that its cardinalities were misestimated, the
+/// plans are removed and the observed cardinalities are kept, so the next
+/// plans of the query are made with them.
+/// This class is thread safe.
+class CachedPlanVariants {
+ public:
+  CachedPlanVariants(std::vector<ParameterSensitiveLookup> lookups, bool read_only)
+      : lookups_(std::move(lookups)), read_only_(read_only) {}
+
+  const auto &lookups() const { return lookups_; }
+  /// Whether the plans only read the graph. The plans of a query differ only
+  /// in the way they look up the vertices, so all of them do.
+  bool read_only() const { return read_only_; }
+
+  /// Returns the plan made for the buckets or nullptr if there is no such plan
+  /// or it has expired.
+  std::shared_ptr<CachedPlan> Find(const std::vector<uint64_t> &buckets);
+
+  /// Caches the plan made for the buckets. The oldest plan is removed if there
+  /// are already `kMaxCachedPlanVariants` plans.
+  void Insert(std::vector<uint64_t> buckets, std::shared_ptr<CachedPlan> plan);
+
+  size_t size() { return plans_->size(); }
+
+  /// Returns the cardinality corrections the plans of the query are made with.
+  plan::CardinalityCorrections corrections() { return *corrections_.Lock(); }
+
+  /// Removes all plans and keeps the corrections for the next plans.
+  void Invalidate(plan::CardinalityCorrections corrections);
+
+ private:
+  std::vector<ParameterSensitiveLookup> lookups_;
+  bool read_only_;
+  utils::Synchronized<std::vector<std::pair<std::vector<uint64_t>, std::shared_ptr<CachedPlan>>>, utils::SpinLock>
+      plans_;
+  utils::Synchronized<plan::CardinalityCorrections, utils::SpinLock> corrections_;
+};
+
 struct CachedQuery {
   AstStorage ast_storage;
   Query *query;
@@ -93,7 +157,7 @@ struct PlanCacheEntry {
   uint64_t first;
   // TODO: Maybe store the query string here and use it as a key with the hash
   // so that we eliminate the risk of hash collisions.
-  std::shared_ptr<CachedPlan> second;
+  std::shared_ptr<CachedPlanVariants> second;
 };
 
 /**
@@ -103,13 +167,35 @@ struct ParsedQuery {
   std::string query_string;
   std::map<std::string, storage::PropertyValue> user_parameters;
   Parameters parameters;
-  frontend::StrippedQuery stripped_query;
+  std::shared_ptr<const frontend::StrippedQuery> stripped_query;
   AstStorage ast_storage;
   Query *query;
   std::vector<AuthQuery::Privilege> required_privileges;
   bool is_cacheable{true};
 };
 
+/**
+ * A query which is stripped and parsed, but doesn't have its parameters yet.
+ * It can be executed many times with different parameters without stripping,
+ * parsing and looking it up in the AST cache again.
+ */
+struct PreparedStatement {
+  /// Returns a copy of the statement with a clone of its AST.
+  PreparedStatement Clone() const;
+
+  std::string query_string;
+  std::shared_ptr<const frontend::StrippedQuery> stripped_query;
+  CachedQuery cached_query;
+  bool is_cacheable{true};
+};
+
+PreparedStatement PrepareStatement(const std::string &query_string, utils::SkipList<QueryCacheEntry> *cache,
+                                   const InterpreterConfig::Query &query_config);
+
+/// Binds the parameters to the statement.
+/// @throw UnprovidedParameterError if a parameter used in the query is missing.
+ParsedQuery BindParameters(PreparedStatement statement, const std::map<std::string, storage::PropertyValue> &params);
+
 ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::string, storage::PropertyValue> &params,
                        utils::SkipList<QueryCacheEntry> *cache, const InterpreterConfig::Query &query_config);
 
@@ -133,16 +219,38 @@ class SingleNodeLogicalPlan final : public LogicalPlan {
 
 std::unique_ptr<LogicalPlan> MakeLogicalPlan(AstStorage ast_storage, CypherQuery *query, const Parameters &parameters,
                                              DbAccessor *db_accessor,
-                                             const std::vector<Identifier *> &predefined_identifiers);
+                                             const std::vector<Identifier *> &predefined_identifiers,
+                                             const plan::CardinalityCorrections &corrections = {});
+
+/// Removes all cached plans. Has to be called when the plans could become
+/// suboptimal or invalid, e.g. after creating an index.
+void InvalidatePlanCache(utils::SkipList<PlanCacheEntry> *plan_cache);
+
+/// Returns whether the query has cached plans and they only read the graph,
+/// so that its transaction can be started as a read-only one before the query
+/// is planned.
+bool IsCachedReadOnlyQuery(uint64_t hash, utils::SkipList<PlanCacheEntry> *plan_cache);
 
 /**
  * Return the parsed *Cypher* query's AST cached logical plan, or create and
- * cache a fresh one if it doesn't yet exist.
+ * cache a fresh one if it doesn't yet exist. Plans are cached separately for
+ * parameter values which are estimated to match a very different number of
+ * vertices.
  * @param predefined_identifiers optional identifiers you want to inject into a query.
  * If an identifier is not defined in a scope, we check the predefined identifiers.
  * If an identifier is contained there, we inject it at that place and remove it,
  * because a predefined identifier can be used only in one scope.
  */
+/// Compares the cardinalities estimated for the cached plan of the query with
+/// the ones observed by profiling it. If they differ by more than
+/// `--query_plan_cardinality_feedback_threshold` times for any operator, the
+/// cached plans of the query are removed and the query is planned again with
+/// the observed selectivities of its filters and degrees of its expansions.
+/// Returns whether the plans were removed.
+bool ApplyCardinalityFeedback(uint64_t hash, const CachedPlan &plan, const plan::ProfilingStats &stats,
+                              const Parameters &parameters, utils::SkipList<PlanCacheEntry> *plan_cache,
+                              DbAccessor *db_accessor);
+
 std::shared_ptr<CachedPlan> CypherQueryToPlan(uint64_t hash, AstStorage ast_storage, CypherQuery *query,
                                               const Parameters &parameters, utils::SkipList<PlanCacheEntry> *plan_cache,
                                               DbAccessor *db_accessor,
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <optional>
+#include <span>
 
 #include <cppitertools/filter.hpp>
 #include <cppitertools/imap.hpp>
@@ -69,6 +70,11 @@ class EdgeAccessor final {
     return impl_.GetProperty(key, view);
   }
 
+  storage::Result<std::vector<storage::PropertyValue>> GetProperties(
+      storage::View view, const std::vector<storage::PropertyId> &keys) const {
+    return impl_.GetProperties(keys, view);
+  }
+
   storage::Result<storage::PropertyValue> SetProperty(storage::PropertyId key, const storage::PropertyValue &value) {
     return impl_.SetProperty(key, value);
   }
@@ -132,10 +138,19 @@ class VertexAccessor final {
     return impl_.GetProperty(key, view);
   }
 
+  storage::Result<std::vector<storage::PropertyValue>> GetProperties(
+      storage::View view, const std::vector<storage::PropertyId> &keys) const {
+    return impl_.GetProperties(keys, view);
+  }
+
   storage::Result<storage::PropertyValue> SetProperty(storage::PropertyId key, const storage::PropertyValue &value) {
     return impl_.SetProperty(key, value);
   }
 
+  storage::Result<bool> AddToProperty(storage::PropertyId key, const storage::PropertyValue &value) {
+    return impl_.AddToProperty(key, value);
+  }
+
   storage::Result<bool> InitProperties(const std::map<storage::PropertyId, storage::PropertyValue> &properties) {
     return impl_.InitProperties(properties);
   }
@@ -190,6 +205,10 @@ class VertexAccessor final {
 
   storage::Result<size_t> OutDegree(storage::View view) const { return impl_.OutDegree(view); }
 
+  size_t ApproximateInDegree() const { return impl_.ApproximateInDegree(); }
+
+  size_t ApproximateOutDegree() const { return impl_.ApproximateOutDegree(); }
+
   int64_t CypherId() const { return impl_.Gid().AsInt(); }
 
   storage::Gid Gid() const noexcept { return impl_.Gid(); }
@@ -322,6 +341,35 @@ class VerticesIterable final {
   }
 };
 
+class EdgesIterable final {
+  storage::EdgesIterable iterable_;
+
+ public:
+  class Iterator final {
+    storage::EdgesIterable::Iterator it_;
+
+   public:
+    explicit Iterator(storage::EdgesIterable::Iterator it) : it_(std::move(it)) {}
+
+    EdgeAccessor operator*() const { return EdgeAccessor(*it_); }
+
+    Iterator &operator++() {
+      ++it_;
+      return *this;
+    }
+
+    bool operator==(const Iterator &other) const { return it_ == other.it_; }
+
+    bool operator!=(const Iterator &other) const { return !(other == *this); }
+  };
+
+  explicit EdgesIterable(storage::EdgesIterable iterable) : iterable_(std::move(iterable)) {}
+
+  Iterator begin() { return Iterator(iterable_.begin()); }
+
+  Iterator end() { return Iterator(iterable_.end()); }
+};
+
 class DbAccessor final {
   storage::Storage::Accessor *accessor_;
 
@@ -338,10 +386,38 @@ class DbAccessor final {
 
   VerticesIterable Vertices(storage::View view) { return VerticesIterable(accessor_->Vertices(view)); }
 
+  std::vector<VerticesIterable> PartitionVertices(storage::View view, uint64_t max_partitions) {
+    auto storage_partitions = accessor_->PartitionVertices(view, max_partitions);
+    std::vector<VerticesIterable> partitions;
+    partitions.reserve(storage_partitions.size());
+    for (auto &partition : storage_partitions) partitions.emplace_back(std::move(partition));
+    return partitions;
+  }
+
   VerticesIterable Vertices(storage::View view, storage::LabelId label) {
     return VerticesIterable(accessor_->Vertices(label, view));
   }
 
+  std::vector<VerticesIterable> PartitionVertices(storage::View view, storage::LabelId label,
+                                                  uint64_t max_partitions) {
+    auto storage_partitions = accessor_->PartitionVertices(label, view, max_partitions);
+    std::vector<VerticesIterable> partitions;
+    partitions.reserve(storage_partitions.size());
+    for (auto &partition : storage_partitions) partitions.emplace_back(std::move(partition));
+    return partitions;
+  }
+
+  VerticesIterable Vertices(storage::View view, storage::LabelId label,
+                            const std::vector<storage::LabelId> &filter_labels) {
+    return VerticesIterable(accessor_->Vertices(label, filter_labels, view));
+  }
+
+  VerticesIterable Vertices(
+      storage::View view, storage::LabelId label, const std::vector<storage::LabelId> &filter_labels,
+      const std::vector<std::pair<storage::PropertyId, storage::PropertyValue>> &filter_properties) {
+    return VerticesIterable(accessor_->Vertices(label, filter_labels, filter_properties, view));
+  }
+
   VerticesIterable Vertices(storage::View view, storage::LabelId label, storage::PropertyId property) {
     return VerticesIterable(accessor_->Vertices(label, property, view));
   }
@@ -351,18 +427,54 @@ class DbAccessor final {
     return VerticesIterable(accessor_->Vertices(label, property, value, view));
   }
 
+  VerticesIterable Vertices(storage::View view, storage::LabelId label, storage::PropertyId property,
+                            const std::vector<storage::PropertyValue> &values) {
+    return VerticesIterable(accessor_->Vertices(label, property, values, view));
+  }
+
   VerticesIterable Vertices(storage::View view, storage::LabelId label, storage::PropertyId property,
                             const std::optional<utils::Bound<storage::PropertyValue>> &lower,
                             const std::optional<utils::Bound<storage::PropertyValue>> &upper) {
     return VerticesIterable(accessor_->Vertices(label, property, lower, upper, view));
   }
 
+  VerticesIterable Vertices(storage::View view, storage::LabelId label,
+                            const std::vector<storage::PropertyId> &properties,
+                            const std::vector<storage::PropertyValue> &prefix,
+                            const std::optional<utils::Bound<storage::PropertyValue>> &lower,
+                            const std::optional<utils::Bound<storage::PropertyValue>> &upper) {
+    return VerticesIterable(accessor_->Vertices(label, properties, prefix, lower, upper, view));
+  }
+
+  EdgesIterable Edges(storage::View view, storage::EdgeTypeId edge_type) {
+    return EdgesIterable(accessor_->Edges(edge_type, view));
+  }
+
+  EdgesIterable Edges(storage::View view, storage::EdgeTypeId edge_type, storage::PropertyId property,
+                      const storage::PropertyValue &value) {
+    return EdgesIterable(accessor_->Edges(edge_type, property, value, view));
+  }
+
+  EdgesIterable Edges(storage::View view, storage::EdgeTypeId edge_type, storage::PropertyId property,
+                      const std::optional<utils::Bound<storage::PropertyValue>> &lower,
+                      const std::optional<utils::Bound<storage::PropertyValue>> &upper) {
+    return EdgesIterable(accessor_->Edges(edge_type, property, lower, upper, view));
+  }
+
   VertexAccessor InsertVertex() { return VertexAccessor(accessor_->CreateVertex()); }
 
   void PrefetchOutEdges(const VertexAccessor &vertex) const { accessor_->PrefetchOutEdges(vertex.impl_); }
 
   void PrefetchInEdges(const VertexAccessor &vertex) const { accessor_->PrefetchInEdges(vertex.impl_); }
 
+  void PrefetchOutEdges(const std::vector<VertexAccessor> &vertices) const {
+    accessor_->PrefetchOutEdges(StorageVertices(vertices));
+  }
+
+  void PrefetchInEdges(const std::vector<VertexAccessor> &vertices) const {
+    accessor_->PrefetchInEdges(StorageVertices(vertices));
+  }
+
   storage::Result<EdgeAccessor> InsertEdge(VertexAccessor *from, VertexAccessor *to,
                                            const storage::EdgeTypeId &edge_type) {
     auto maybe_edge = accessor_->CreateEdge(&from->impl_, &to->impl_, edge_type);
@@ -410,6 +522,35 @@ class DbAccessor final {
     return std::make_optional<ReturnType>(vertex, std::move(deleted_edges));
   }
 
+  /// Detach deletes the vertices together, see `storage::Storage::Accessor::DetachDeleteVertices`.
+  storage::Result<std::pair<std::vector<VertexAccessor>, std::vector<EdgeAccessor>>> DetachRemoveVertices(
+      const std::vector<VertexAccessor *> &vertex_accessors) {
+    std::vector<storage::VertexAccessor> impls;
+    std::vector<storage::VertexAccessor *> vertices;
+    impls.reserve(vertex_accessors.size());
+    vertices.reserve(vertex_accessors.size());
+    for (auto *vertex_accessor : vertex_accessors) {
+      impls.push_back(vertex_accessor->impl_);
+      vertices.push_back(&vertex_accessor->impl_);
+    }
+    accessor_->PrefetchOutEdges(impls);
+    accessor_->PrefetchInEdges(impls);
+    auto res = accessor_->DetachDeleteVertices(vertices);
+    if (res.HasError()) {
+      return res.GetError();
+    }
+
+    auto &[deleted_vertices, deleted_edges] = *res;
+    std::pair<std::vector<VertexAccessor>, std::vector<EdgeAccessor>> deleted;
+    deleted.first.reserve(deleted_vertices.size());
+    deleted.second.reserve(deleted_edges.size());
+    std::transform(deleted_vertices.begin(), deleted_vertices.end(), std::back_inserter(deleted.first),
+                   [](const auto &deleted_vertex) { return VertexAccessor{deleted_vertex}; });
+    std::transform(deleted_edges.begin(), deleted_edges.end(), std::back_inserter(deleted.second),
+                   [](const auto &deleted_edge) { return EdgeAccessor{deleted_edge}; });
+    return deleted;
+  }
+
   storage::Result<std::optional<VertexAccessor>> RemoveVertex(VertexAccessor *vertex_accessor) {
     auto res = accessor_->DeleteVertex(&vertex_accessor->impl_);
     if (res.HasError()) {
@@ -438,18 +579,110 @@ class DbAccessor final {
 
   void AdvanceCommand() { accessor_->AdvanceCommand(); }
 
+  void SuspendVertexInfoCache() { accessor_->SuspendVertexInfoCache(); }
+
+  void ResumeVertexInfoCache() { accessor_->ResumeVertexInfoCache(); }
+
   utils::BasicResult<storage::StorageDataManipulationError, void> Commit() { return accessor_->Commit(); }
 
+  utils::BasicResult<storage::StorageDataManipulationError, void> PeriodicCommit() {
+    return accessor_->PeriodicCommit();
+  }
+
   void Abort() { accessor_->Abort(); }
 
   storage::StorageMode GetStorageMode() const { return accessor_->GetCreationStorageMode(); }
 
+  std::optional<uint64_t> GraphVersion() const { return accessor_->GraphVersion(); }
+
+  std::optional<uint64_t> LastGraphChange(const storage::GraphFootprint &footprint) const {
+    return accessor_->LastGraphChange(footprint);
+  }
+
+  std::vector<storage::LongDeltaChainInfo> LongDeltaChainsInfo() const { return accessor_->LongDeltaChainsInfo(); }
+
+  std::shared_ptr<const storage::PropertyColumn> GetPropertyColumn(storage::LabelId label,
+                                                                   storage::PropertyId property) {
+    return accessor_->GetPropertyColumn(label, property);
+  }
+
   bool LabelIndexExists(storage::LabelId label) const { return accessor_->LabelIndexExists(label); }
 
   bool LabelPropertyIndexExists(storage::LabelId label, storage::PropertyId prop) const {
     return accessor_->LabelPropertyIndexExists(label, prop);
   }
 
+  bool LabelPropertyCompositeIndexExists(storage::LabelId label,
+                                         const std::vector<storage::PropertyId> &properties) const {
+    return accessor_->LabelPropertyCompositeIndexExists(label, properties);
+  }
+
+  bool EdgeTypeIndexExists(storage::EdgeTypeId edge_type) const { return accessor_->EdgeTypeIndexExists(edge_type); }
+
+  bool EdgeTypePropertyIndexExists(storage::EdgeTypeId edge_type, storage::PropertyId property) const {
+    return accessor_->EdgeTypePropertyIndexExists(edge_type, property);
+  }
+
+  bool TextIndexExists(storage::LabelId label, storage::PropertyId property) const {
+    return accessor_->TextIndexExists(label, property);
+  }
+
+  /// Returns at most `limit` vertices found by the text index with their
+  /// scores, ordered from the most relevant one.
+  std::vector<std::pair<VertexAccessor, double>> TextSearch(storage::LabelId label, storage::PropertyId property,
+                                                            std::string_view query, uint64_t limit,
+                                                            storage::View view) {
+    std::vector<std::pair<VertexAccessor, double>> results;
+    for (auto &result : accessor_->TextSearch(label, property, query, limit, view)) {
+      results.emplace_back(VertexAccessor(result.vertex), result.score);
+    }
+    return results;
+  }
+
+  bool VectorIndexExists(storage::LabelId label, storage::PropertyId property) const {
+    return accessor_->VectorIndexExists(label, property);
+  }
+
+  /// Returns at most `k` vertices found by the vector index with their cosine
+  /// distances to `query`, ordered from the nearest one. Returns std::nullopt
+  /// if the dimension of `query` differs from the dimension of the index.
+  std::optional<std::vector<std::pair<VertexAccessor, double>>> VectorSearch(storage::LabelId label,
+                                                                             storage::PropertyId property,
+                                                                             std::span<const float> query,
+                                                                             uint64_t k, storage::View view) {
+    auto found = accessor_->VectorSearch(label, property, query, k, view);
+    if (!found) return std::nullopt;
+    std::vector<std::pair<VertexAccessor, double>> results;
+    results.reserve(found->size());
+    for (auto &result : *found) {
+      results.emplace_back(VertexAccessor(result.vertex), result.distance);
+    }
+    return results;
+  }
+
+  bool AggregateIndexExists(storage::LabelId label, storage::PropertyId group_property,
+                            storage::PropertyId value_property) const {
+    return accessor_->AggregateIndexExists(label, group_property, value_property);
+  }
+
+  /// Returns the groups of the aggregate index as of the start of the
+  /// transaction, or std::nullopt if they have to be computed from the
+  /// vertices.
+  std::optional<std::vector<storage::AggregateGroup>> AggregateIndexLookup(storage::LabelId label,
+                                                                          storage::PropertyId group_property,
+                                                                          storage::PropertyId value_property) {
+    return accessor_->AggregateIndexLookup(label, group_property, value_property);
+  }
+
+  /// Returns the properties of all composite indices on the given label.
+  std::vector<std::vector<storage::PropertyId>> LabelPropertyCompositeIndices(storage::LabelId label) const {
+    std::vector<std::vector<storage::PropertyId>> indices;
+    for (auto &[index_label, properties] : accessor_->ListAllIndices().label_property_composite) {
+      if (index_label == label) indices.push_back(std::move(properties));
+    }
+    return indices;
+  }
+
   std::optional<storage::LabelIndexStats> GetIndexStats(const storage::LabelId &label) const {
     return accessor_->GetIndexStats(label);
   }
@@ -502,11 +735,49 @@ class DbAccessor final {
     return accessor_->ApproximateVertexCount(label, property, lower, upper);
   }
 
+  int64_t VerticesCount(storage::LabelId label, const std::vector<storage::PropertyId> &properties) const {
+    return accessor_->ApproximateVertexCount(label, properties);
+  }
+
+  int64_t VerticesCount(storage::LabelId label, const std::vector<storage::PropertyId> &properties,
+                        const std::vector<storage::PropertyValue> &prefix,
+                        const std::optional<utils::Bound<storage::PropertyValue>> &lower,
+                        const std::optional<utils::Bound<storage::PropertyValue>> &upper) const {
+    return accessor_->ApproximateVertexCount(label, properties, prefix, lower, upper);
+  }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type) const { return accessor_->ApproximateEdgeCount(edge_type); }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type, storage::PropertyId property) const {
+    return accessor_->ApproximateEdgeCount(edge_type, property);
+  }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type, storage::PropertyId property,
+                     const storage::PropertyValue &value) const {
+    return accessor_->ApproximateEdgeCount(edge_type, property, value);
+  }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type, storage::PropertyId property,
+                     const std::optional<utils::Bound<storage::PropertyValue>> &lower,
+                     const std::optional<utils::Bound<storage::PropertyValue>> &upper) const {
+    return accessor_->ApproximateEdgeCount(edge_type, property, lower, upper);
+  }
+
   storage::IndicesInfo ListAllIndices() const { return accessor_->ListAllIndices(); }
 
   storage::ConstraintsInfo ListAllConstraints() const { return accessor_->ListAllConstraints(); }
 
   const std::string &id() const { return accessor_->id(); }
+
+ private:
+  static std::vector<storage::VertexAccessor> StorageVertices(const std::vector<VertexAccessor> &vertices) {
+    std::vector<storage::VertexAccessor> storage_vertices;
+    storage_vertices.reserve(vertices.size());
+    for (const auto &vertex : vertices) {
+      storage_vertices.push_back(vertex.impl_);
+    }
+    return storage_vertices;
+  }
 };
 
 class SubgraphDbAccessor final {
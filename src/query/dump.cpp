@@ -11,11 +11,21 @@
 
 #include "query/dump.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <iomanip>
 #include <limits>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <ostream>
+#include <sstream>
+#include <stop_token>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -245,6 +255,42 @@ void DumpLabelPropertyIndex(std::ostream *os, query::DbAccessor *dba, storage::L
       << ");";
 }
 
+void DumpLabelPropertyCompositeIndex(std::ostream *os, query::DbAccessor *dba, storage::LabelId label,
+                                     const std::vector<storage::PropertyId> &properties) {
+  *os << "CREATE INDEX ON :" << EscapeName(dba->LabelToName(label)) << "(";
+  utils::PrintIterable(*os, properties, ", ", [&dba](auto &stream, const auto &property) {
+    stream << EscapeName(dba->PropertyToName(property));
+  });
+  *os << ");";
+}
+
+void DumpEdgeTypeIndex(std::ostream *os, query::DbAccessor *dba, const storage::EdgeTypeId edge_type) {
+  *os << "CREATE EDGE INDEX ON :" << EscapeName(dba->EdgeTypeToName(edge_type)) << ";";
+}
+
+void DumpEdgeTypePropertyIndex(std::ostream *os, query::DbAccessor *dba, storage::EdgeTypeId edge_type,
+                               storage::PropertyId property) {
+  *os << "CREATE EDGE INDEX ON :" << EscapeName(dba->EdgeTypeToName(edge_type)) << "("
+      << EscapeName(dba->PropertyToName(property)) << ");";
+}
+
+void DumpTextIndex(std::ostream *os, query::DbAccessor *dba, storage::LabelId label, storage::PropertyId property) {
+  *os << "CREATE TEXT INDEX ON :" << EscapeName(dba->LabelToName(label)) << "("
+      << EscapeName(dba->PropertyToName(property)) << ");";
+}
+
+void DumpVectorIndex(std::ostream *os, query::DbAccessor *dba, storage::LabelId label, storage::PropertyId property) {
+  *os << "CREATE VECTOR INDEX ON :" << EscapeName(dba->LabelToName(label)) << "("
+      << EscapeName(dba->PropertyToName(property)) << ");";
+}
+
+void DumpAggregateIndex(std::ostream *os, query::DbAccessor *dba, storage::LabelId label,
+                        storage::PropertyId group_property, storage::PropertyId value_property) {
+  *os << "CREATE AGGREGATE INDEX ON :" << EscapeName(dba->LabelToName(label)) << "("
+      << EscapeName(dba->PropertyToName(group_property)) << ", " << EscapeName(dba->PropertyToName(value_property))
+      << ");";
+}
+
 void DumpExistenceConstraint(std::ostream *os, query::DbAccessor *dba, storage::LabelId label,
                              storage::PropertyId property) {
   *os << "CREATE CONSTRAINT ON (u:" << EscapeName(dba->LabelToName(label)) << ") ASSERT EXISTS (u."
@@ -260,15 +306,201 @@ void DumpUniqueConstraint(std::ostream *os, query::DbAccessor *dba, storage::Lab
   *os << " IS UNIQUE;";
 }
 
+// Number of vertices or edges created by a single query of the parallel dump.
+constexpr size_t kDumpBatchSize = 1000;
+
+// Number of queries which each thread of the parallel dump can prepare before
+// they are pulled.
+constexpr size_t kQueuedQueriesPerThread = 4;
+
+/// Collects the vertices or the edges which are created by the same batched
+/// query until there are enough of them.
+class QueryBatches {
+ public:
+  QueryBatches(query::DbAccessor *dba, std::function<void(std::string)> emit) : dba_(dba), emit_(std::move(emit)) {}
+
+  void AddVertex(const query::VertexAccessor &vertex) {
+    auto maybe_labels = vertex.Labels(storage::View::OLD);
+    if (maybe_labels.HasError()) throw query::QueryRuntimeException("Trying to get labels from a deleted node.");
+    auto labels = std::move(*maybe_labels);
+    std::sort(labels.begin(), labels.end());
+    auto maybe_props = vertex.Properties(storage::View::OLD);
+    if (maybe_props.HasError()) throw query::QueryRuntimeException("Trying to get properties from a deleted object.");
+    auto &batch = vertex_batches_[labels];
+    if (batch.size++ > 0) batch.rows << ", ";
+    DumpProperties(&batch.rows, dba_, *maybe_props, vertex.CypherId());
+    if (batch.size == kDumpBatchSize) EmitVertices(labels, &batch);
+  }
+
+  void AddEdge(const query::EdgeAccessor &edge) {
+    auto maybe_props = edge.Properties(storage::View::OLD);
+    if (maybe_props.HasError()) throw query::QueryRuntimeException("Trying to get properties from a deleted object.");
+    // Edges without properties are created without setting the properties,
+    // which fails when the properties on edges are disabled.
+    const std::pair key{edge.EdgeType(), !maybe_props->empty()};
+    auto &batch = edge_batches_[key];
+    if (batch.size++ > 0) batch.rows << ", ";
+    batch.rows << "{from_id: " << edge.From().CypherId() << ", to_id: " << edge.To().CypherId();
+    if (key.second) {
+      batch.rows << ", properties: ";
+      DumpProperties(&batch.rows, dba_, *maybe_props);
+    }
+    batch.rows << "}";
+    if (batch.size == kDumpBatchSize) EmitEdges(key, &batch);
+  }
+
+  void Flush() {
+    for (auto &[labels, batch] : vertex_batches_) {
+      if (batch.size > 0) EmitVertices(labels, &batch);
+    }
+    for (auto &[key, batch] : edge_batches_) {
+      if (batch.size > 0) EmitEdges(key, &batch);
+    }
+  }
+
+ private:
+  struct Batch {
+    std::ostringstream rows;
+    size_t size{0};
+  };
+
+  void EmitVertices(const std::vector<storage::LabelId> &labels, Batch *batch) {
+    std::ostringstream os;
+    os << "UNWIND [" << batch->rows.str() << "] AS row CREATE (u:" << kInternalVertexLabel;
+    for (const auto &label : labels) {
+      os << ":" << EscapeName(dba_->LabelToName(label));
+    }
+    os << ") SET u = row;";
+    Reset(batch);
+    emit_(os.str());
+  }
+
+  void EmitEdges(const std::pair<storage::EdgeTypeId, bool> &key, Batch *batch) {
+    std::ostringstream os;
+    os << "UNWIND [" << batch->rows.str() << "] AS row ";
+    os << "MATCH (u:" << kInternalVertexLabel << " {" << kInternalPropertyId << ": row.from_id}), ";
+    os << "(v:" << kInternalVertexLabel << " {" << kInternalPropertyId << ": row.to_id}) ";
+    os << "CREATE (u)-[e:" << EscapeName(dba_->EdgeTypeToName(key.first)) << "]->(v)";
+    if (key.second) os << " SET e += row.properties";
+    os << ";";
+    Reset(batch);
+    emit_(os.str());
+  }
+
+  static void Reset(Batch *batch) {
+    batch->rows.str("");
+    batch->size = 0;
+  }
+
+  query::DbAccessor *dba_;
+  std::function<void(std::string)> emit_;
+  std::map<std::vector<storage::LabelId>, Batch> vertex_batches_;
+  std::map<std::pair<storage::EdgeTypeId, bool>, Batch> edge_batches_;
+};
+
 }  // namespace
 
-PullPlanDump::PullPlanDump(DbAccessor *dba)
+/// Dumps the vertices or the edges of the partitions of the vertices on
+/// multiple threads. The queries are passed to the pulling thread through a
+/// bounded queue, so the dump is streamed instead of being prepared up front.
+/// The threads only read the transaction, which isn't modified while dumping.
+class PullPlanDump::ParallelDump {
+ public:
+  ParallelDump(DbAccessor *dba, uint64_t parallelism, bool edges)
+      : dba_(dba),
+        partitions_(dba->PartitionVertices(storage::View::OLD, parallelism)),
+        capacity_(kQueuedQueriesPerThread * parallelism) {
+    const auto num_workers = std::min<size_t>(parallelism, partitions_.size());
+    remaining_workers_ = num_workers;
+    workers_.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+      workers_.emplace_back([this, edges](std::stop_token stop_token) { Work(stop_token, edges); });
+    }
+  }
+
+  /// Returns the next query or std::nullopt once all queries are returned.
+  /// @throw QueryRuntimeException if one of the threads failed.
+  std::optional<std::string> Next() {
+    std::unique_lock lock(lock_);
+    not_empty_.wait(lock, [this] { return error_ || !queries_.empty() || remaining_workers_ == 0; });
+    if (error_) std::rethrow_exception(error_);
+    if (queries_.empty()) return std::nullopt;
+    auto query = std::move(queries_.front());
+    queries_.pop_front();
+    lock.unlock();
+    not_full_.notify_one();
+    return query;
+  }
+
+ private:
+  void Work(const std::stop_token &stop_token, bool edges) {
+    try {
+      QueryBatches batches(dba_, [this, &stop_token](std::string query) {
+        std::unique_lock lock(lock_);
+        if (!not_full_.wait(lock, stop_token, [this] { return queries_.size() < capacity_; })) return;
+        queries_.push_back(std::move(query));
+        lock.unlock();
+        not_empty_.notify_one();
+      });
+      for (auto i = next_partition_++; i < partitions_.size() && !stop_token.stop_requested(); i = next_partition_++) {
+        for (const auto &vertex : partitions_[i]) {
+          if (stop_token.stop_requested()) break;
+          if (!edges) {
+            batches.AddVertex(vertex);
+            continue;
+          }
+          dba_->PrefetchOutEdges(vertex);
+          auto maybe_edges = vertex.OutEdges(storage::View::OLD);
+          MG_ASSERT(maybe_edges.HasValue(), "Invalid database state!");
+          for (const auto &edge : *maybe_edges) batches.AddEdge(edge);
+        }
+      }
+      batches.Flush();
+    } catch (...) {
+      std::lock_guard guard(lock_);
+      error_ = std::current_exception();
+    }
+    {
+      std::lock_guard guard(lock_);
+      --remaining_workers_;
+    }
+    not_empty_.notify_all();
+  }
+
+  DbAccessor *dba_;
+  std::vector<VerticesIterable> partitions_;
+  std::atomic<size_t> next_partition_{0};
+  size_t capacity_;
+  std::mutex lock_;
+  std::condition_variable_any not_full_;
+  std::condition_variable not_empty_;
+  std::deque<std::string> queries_;
+  size_t remaining_workers_{0};
+  std::exception_ptr error_;
+  // Destroyed first, which stops and joins the threads.
+  std::vector<std::jthread> workers_;
+};
+
+PullPlanDump::PullPlanDump(DbAccessor *dba, uint64_t parallelism)
     : dba_(dba),
+      parallelism_(parallelism),
       vertices_iterable_(dba->Vertices(storage::View::OLD)),
       pull_chunks_{// Dump all label indices
                    CreateLabelIndicesPullChunk(),
                    // Dump all label property indices
                    CreateLabelPropertyIndicesPullChunk(),
+                   // Dump all composite label property indices
+                   CreateLabelPropertyCompositeIndicesPullChunk(),
+                   // Dump all edge-type indices
+                   CreateEdgeTypeIndicesPullChunk(),
+                   // Dump all edge-type property indices
+                   CreateEdgeTypePropertyIndicesPullChunk(),
+                   // Dump all text indices
+                   CreateTextIndicesPullChunk(),
+                   // Dump all vector indices
+                   CreateVectorIndicesPullChunk(),
+                   // Dump all aggregate indices
+                   CreateAggregateIndicesPullChunk(),
                    // Dump all existence constraints
                    CreateExistenceConstraintsPullChunk(),
                    // Dump all unique constraints
@@ -276,14 +508,16 @@ PullPlanDump::PullPlanDump(DbAccessor *dba)
                    // Create internal index for faster edge creation
                    CreateInternalIndexPullChunk(),
                    // Dump all vertices
-                   CreateVertexPullChunk(),
+                   parallelism > 1 ? CreateParallelPullChunk(false) : CreateVertexPullChunk(),
                    // Dump all edges
-                   CreateEdgePullChunk(),
+                   parallelism > 1 ? CreateParallelPullChunk(true) : CreateEdgePullChunk(),
                    // Drop the internal index
                    CreateDropInternalIndexPullChunk(),
                    // Internal index cleanup
                    CreateInternalIndexCleanupPullChunk()} {}
 
+PullPlanDump::~PullPlanDump() = default;
+
 bool PullPlanDump::Pull(AnyStream *stream, std::optional<int> n) {
   // Iterate all functions that stream some results.
   // Each function should return number of results it streamed after it
@@ -364,6 +598,167 @@ PullPlanDump::PullChunk PullPlanDump::CreateLabelPropertyIndicesPullChunk() {
   };
 }
 
+PullPlanDump::PullChunk PullPlanDump::CreateLabelPropertyCompositeIndicesPullChunk() {
+  return [this, global_index = 0U](AnyStream *stream, std::optional<int> n) mutable -> std::optional<size_t> {
+    // Delay the construction of indices vectors
+    if (!indices_info_) {
+      indices_info_.emplace(dba_->ListAllIndices());
+    }
+    const auto &label_property_composite = indices_info_->label_property_composite;
+
+    size_t local_counter = 0;
+    while (global_index < label_property_composite.size() && (!n || local_counter < *n)) {
+      std::ostringstream os;
+      const auto &index = label_property_composite[global_index];
+      DumpLabelPropertyCompositeIndex(&os, dba_, index.first, index.second);
+      stream->Result({TypedValue(os.str())});
+
+      ++global_index;
+      ++local_counter;
+    }
+
+    if (global_index == label_property_composite.size()) {
+      return local_counter;
+    }
+
+    return std::nullopt;
+  };
+}
+
+PullPlanDump::PullChunk PullPlanDump::CreateEdgeTypeIndicesPullChunk() {
+  return [this, global_index = 0U](AnyStream *stream, std::optional<int> n) mutable -> std::optional<size_t> {
+    // Delay the construction of indices vectors
+    if (!indices_info_) {
+      indices_info_.emplace(dba_->ListAllIndices());
+    }
+    const auto &edge_type = indices_info_->edge_type;
+
+    size_t local_counter = 0;
+    while (global_index < edge_type.size() && (!n || local_counter < *n)) {
+      std::ostringstream os;
+      DumpEdgeTypeIndex(&os, dba_, edge_type[global_index]);
+      stream->Result({TypedValue(os.str())});
+
+      ++global_index;
+      ++local_counter;
+    }
+
+    if (global_index == edge_type.size()) {
+      return local_counter;
+    }
+
+    return std::nullopt;
+  };
+}
+
+PullPlanDump::PullChunk PullPlanDump::CreateEdgeTypePropertyIndicesPullChunk() {
+  return [this, global_index = 0U](AnyStream *stream, std::optional<int> n) mutable -> std::optional<size_t> {
+    // Delay the construction of indices vectors
+    if (!indices_info_) {
+      indices_info_.emplace(dba_->ListAllIndices());
+    }
+    const auto &edge_type_property = indices_info_->edge_type_property;
+
+    size_t local_counter = 0;
+    while (global_index < edge_type_property.size() && (!n || local_counter < *n)) {
+      std::ostringstream os;
+      const auto &index = edge_type_property[global_index];
+      DumpEdgeTypePropertyIndex(&os, dba_, index.first, index.second);
+      stream->Result({TypedValue(os.str())});
+
+      ++global_index;
+      ++local_counter;
+    }
+
+    if (global_index == edge_type_property.size()) {
+      return local_counter;
+    }
+
+    return std::nullopt;
+  };
+}
+
+PullPlanDump::PullChunk PullPlanDump::CreateTextIndicesPullChunk() {
+  return [this, global_index = 0U](AnyStream *stream, std::optional<int> n) mutable -> std::optional<size_t> {
+    // Delay the construction of indices vectors
+    if (!indices_info_) {
+      indices_info_.emplace(dba_->ListAllIndices());
+    }
+    const auto &text = indices_info_->text;
+
+    size_t local_counter = 0;
+    while (global_index < text.size() && (!n || local_counter < *n)) {
+      std::ostringstream os;
+      const auto &index = text[global_index];
+      DumpTextIndex(&os, dba_, index.first, index.second);
+      stream->Result({TypedValue(os.str())});
+
+      ++global_index;
+      ++local_counter;
+    }
+
+    if (global_index == text.size()) {
+      return local_counter;
+    }
+
+    return std::nullopt;
+  };
+}
+
+PullPlanDump::PullChunk PullPlanDump::CreateVectorIndicesPullChunk() {
+  return [this, global_index = 0U](AnyStream *stream, std::optional<int> n) mutable -> std::optional<size_t> {
+    // Delay the construction of indices vectors
+    if (!indices_info_) {
+      indices_info_.emplace(dba_->ListAllIndices());
+    }
+    const auto &vector = indices_info_->vector;
+
+    size_t local_counter = 0;
+    while (global_index < vector.size() && (!n || local_counter < *n)) {
+      std::ostringstream os;
+      const auto &index = vector[global_index];
+      DumpVectorIndex(&os, dba_, index.first, index.second);
+      stream->Result({TypedValue(os.str())});
+
+      ++global_index;
+      ++local_counter;
+    }
+
+    if (global_index == vector.size()) {
+      return local_counter;
+    }
+
+    return std::nullopt;
+  };
+}
+
+PullPlanDump::PullChunk PullPlanDump::CreateAggregateIndicesPullChunk() {
+  return [this, global_index = 0U](AnyStream *stream, std::optional<int> n) mutable -> std::optional<size_t> {
+    // Delay the construction of indices vectors
+    if (!indices_info_) {
+      indices_info_.emplace(dba_->ListAllIndices());
+    }
+    const auto &aggregate = indices_info_->aggregate;
+
+    size_t local_counter = 0;
+    while (global_index < aggregate.size() && (!n || local_counter < *n)) {
+      std::ostringstream os;
+      const auto &[label, group_property, value_property] = aggregate[global_index];
+      DumpAggregateIndex(&os, dba_, label, group_property, value_property);
+      stream->Result({TypedValue(os.str())});
+
+      ++global_index;
+      ++local_counter;
+    }
+
+    if (global_index == aggregate.size()) {
+      return local_counter;
+    }
+
+    return std::nullopt;
+  };
+}
+
 PullPlanDump::PullChunk PullPlanDump::CreateExistenceConstraintsPullChunk() {
   return [this, global_index = 0U](AnyStream *stream, std::optional<int> n) mutable -> std::optional<size_t> {
     // Delay the construction of constraint vectors
@@ -513,6 +908,28 @@ PullPlanDump::PullChunk PullPlanDump::CreateEdgePullChunk() {
   };
 }
 
+PullPlanDump::PullChunk PullPlanDump::CreateParallelPullChunk(bool edges) {
+  return [this, edges](AnyStream *stream, std::optional<int> n) -> std::optional<size_t> {
+    // The threads are started on the first pull, after the queries of the
+    // previous chunks are streamed.
+    if (!parallel_dump_) {
+      parallel_dump_ = std::make_unique<ParallelDump>(dba_, parallelism_, edges);
+    }
+
+    size_t local_counter = 0;
+    while (!n || local_counter < *n) {
+      auto query = parallel_dump_->Next();
+      if (!query) {
+        parallel_dump_.reset();
+        return local_counter;
+      }
+      stream->Result({TypedValue(std::move(*query))});
+      ++local_counter;
+    }
+    return std::nullopt;
+  };
+}
+
 PullPlanDump::PullChunk PullPlanDump::CreateDropInternalIndexPullChunk() {
   return [this](AnyStream *stream, std::optional<int>) {
     if (internal_index_created_) {
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <memory>
 #include <ostream>
 
 #include "query/db_accessor.hpp"
@@ -22,14 +23,29 @@ namespace memgraph::query {
 void DumpDatabaseToCypherQueries(query::DbAccessor *dba, AnyStream *stream);
 
 struct PullPlanDump {
-  explicit PullPlanDump(query::DbAccessor *dba);
+  /// With `parallelism` greater than 1 the vertices and edges are dumped by
+  /// that many threads, each of which dumps whole partitions of the vertices
+  /// with batched `UNWIND` queries. The order of these queries isn't
+  /// deterministic then.
+  explicit PullPlanDump(query::DbAccessor *dba, uint64_t parallelism = 1);
+  ~PullPlanDump();
+
+  PullPlanDump(const PullPlanDump &) = delete;
+  PullPlanDump &operator=(const PullPlanDump &) = delete;
+  PullPlanDump(PullPlanDump &&) = delete;
+  PullPlanDump &operator=(PullPlanDump &&) = delete;
 
   /// Pull the dump results lazily
   /// @return true if all results were returned, false otherwise
   bool Pull(AnyStream *stream, std::optional<int> n);
 
  private:
+  class ParallelDump;
+
   query::DbAccessor *dba_ = nullptr;
+  uint64_t parallelism_ = 1;
+  // Threads dumping the vertices or the edges when dumping in parallel.
+  std::unique_ptr<ParallelDump> parallel_dump_;
 
   std::optional<storage::IndicesInfo> indices_info_ = std::nullopt;
   std::optional<storage::ConstraintsInfo> constraints_info_ = std::nullopt;
@@ -55,11 +71,18 @@ struct PullPlanDump {
 
   PullChunk CreateLabelIndicesPullChunk();
   PullChunk CreateLabelPropertyIndicesPullChunk();
+  PullChunk CreateLabelPropertyCompositeIndicesPullChunk();
+  PullChunk CreateEdgeTypeIndicesPullChunk();
+  PullChunk CreateEdgeTypePropertyIndicesPullChunk();
+  PullChunk CreateTextIndicesPullChunk();
+  PullChunk CreateVectorIndicesPullChunk();
+  PullChunk CreateAggregateIndicesPullChunk();
   PullChunk CreateExistenceConstraintsPullChunk();
   PullChunk CreateUniqueConstraintsPullChunk();
   PullChunk CreateInternalIndexPullChunk();
   PullChunk CreateVertexPullChunk();
   PullChunk CreateEdgePullChunk();
+  PullChunk CreateParallelPullChunk(bool edges);
   PullChunk CreateDropInternalIndexPullChunk();
   PullChunk CreateInternalIndexCleanupPullChunk();
 };
@@ -76,6 +76,11 @@ class UnprovidedParameterError : public QueryException {
   using QueryException::QueryException;
 };
 
+class PreparedStatementException : public QueryException {
+ public:
+  using QueryException::QueryException;
+};
+
 class ProfileInMulticommandTxException : public QueryException {
  public:
   using QueryException::QueryException;
@@ -308,6 +313,21 @@ class ReplicationException : public utils::BasicException {
                               message) {}
 };
 
+class BookmarkWaitTimeoutException : public QueryException {
+ public:
+  explicit BookmarkWaitTimeoutException(uint64_t commit_timestamp)
+      : QueryException(
+            "Timed out while waiting for the transaction committed at {} to be applied. The instance is behind the "
+            "MAIN instance, check the status of the replicas using 'SHOW REPLICAS' query.",
+            commit_timestamp) {}
+};
+
+class AdmissionRejectedException : public QueryException {
+ public:
+  explicit AdmissionRejectedException(std::string_view reason)
+      : QueryException("The query wasn't admitted for execution because {}. Retry the query later.", reason) {}
+};
+
 class TransactionQueueInMulticommandTxException : public QueryException {
  public:
   TransactionQueueInMulticommandTxException()
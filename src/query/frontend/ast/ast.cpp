@@ -184,8 +184,23 @@ constexpr utils::TypeInfo query::ExplainQuery::kType{utils::TypeId::AST_EXPLAIN_
 constexpr utils::TypeInfo query::ProfileQuery::kType{utils::TypeId::AST_PROFILE_QUERY, "ProfileQuery",
                                                      &query::Query::kType};
 
+constexpr utils::TypeInfo query::ExportQuery::kType{utils::TypeId::AST_EXPORT_QUERY, "ExportQuery",
+                                                    &query::Query::kType};
+
 constexpr utils::TypeInfo query::IndexQuery::kType{utils::TypeId::AST_INDEX_QUERY, "IndexQuery", &query::Query::kType};
 
+constexpr utils::TypeInfo query::EdgeIndexQuery::kType{utils::TypeId::AST_EDGE_INDEX_QUERY, "EdgeIndexQuery",
+                                                       &query::Query::kType};
+
+constexpr utils::TypeInfo query::TextIndexQuery::kType{utils::TypeId::AST_TEXT_INDEX_QUERY, "TextIndexQuery",
+                                                       &query::Query::kType};
+
+constexpr utils::TypeInfo query::VectorIndexQuery::kType{utils::TypeId::AST_VECTOR_INDEX_QUERY, "VectorIndexQuery",
+                                                         &query::Query::kType};
+
+constexpr utils::TypeInfo query::AggregateIndexQuery::kType{utils::TypeId::AST_AGGREGATE_INDEX_QUERY,
+                                                            "AggregateIndexQuery", &query::Query::kType};
+
 constexpr utils::TypeInfo query::Create::kType{utils::TypeId::AST_CREATE, "Create", &query::Clause::kType};
 
 constexpr utils::TypeInfo query::CallProcedure::kType{utils::TypeId::AST_CALL_PROCEDURE, "CallProcedure",
@@ -240,6 +255,8 @@ constexpr utils::TypeInfo query::LockPathQuery::kType{utils::TypeId::AST_LOCK_PA
 
 constexpr utils::TypeInfo query::LoadCsv::kType{utils::TypeId::AST_LOAD_CSV, "LoadCsv", &query::Clause::kType};
 
+constexpr utils::TypeInfo query::LoadArrow::kType{utils::TypeId::AST_LOAD_ARROW, "LoadArrow", &query::Clause::kType};
+
 constexpr utils::TypeInfo query::FreeMemoryQuery::kType{utils::TypeId::AST_FREE_MEMORY_QUERY, "FreeMemoryQuery",
                                                         &query::Query::kType};
 
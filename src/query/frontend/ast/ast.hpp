@@ -819,7 +819,18 @@ class Aggregation : public memgraph::query::BinaryOperator {
   static const utils::TypeInfo kType;
   const utils::TypeInfo &GetTypeInfo() const override { return kType; }
 
-  enum class Op { COUNT, MIN, MAX, SUM, AVG, COLLECT_LIST, COLLECT_MAP, PROJECT };
+  enum class Op {
+    COUNT,
+    MIN,
+    MAX,
+    SUM,
+    AVG,
+    COLLECT_LIST,
+    COLLECT_MAP,
+    PROJECT,
+    APPROX_COUNT_DISTINCT,
+    APPROX_PERCENTILE
+  };
 
   Aggregation() = default;
 
@@ -830,9 +841,13 @@ class Aggregation : public memgraph::query::BinaryOperator {
   static const constexpr char *const kAvg = "AVG";
   static const constexpr char *const kCollect = "COLLECT";
   static const constexpr char *const kProject = "PROJECT";
+  static const constexpr char *const kApproxCountDistinct = "APPROXCOUNTDISTINCT";
+  static const constexpr char *const kApproxPercentile = "APPROXPERCENTILE";
 
   static std::string OpToString(Op op) {
-    const char *op_strings[] = {kCount, kMin, kMax, kSum, kAvg, kCollect, kCollect, kProject};
+    const char *op_strings[] = {kCount,   kMin,     kMax,     kSum,
+                                kAvg,     kCollect, kCollect, kProject,
+                                kApproxCountDistinct, kApproxPercentile};
     return op_strings[static_cast<int>(op)];
   }
 
@@ -872,13 +887,15 @@ class Aggregation : public memgraph::query::BinaryOperator {
   explicit Aggregation(Op op) : op_(op) {}
 
   /// Aggregation's first expression is the value being aggregated. The second
-  /// expression is the key used only in COLLECT_MAP.
+  /// expression is the key used in COLLECT_MAP and the percentile used in
+  /// APPROX_PERCENTILE.
   Aggregation(Expression *expression1, Expression *expression2, Op op, bool distinct)
       : BinaryOperator(expression1, expression2), op_(op), distinct_(distinct) {
     // COUNT without expression denotes COUNT(*) in cypher.
     DMG_ASSERT(expression1 || op == Aggregation::Op::COUNT, "All aggregations, except COUNT require expression");
-    DMG_ASSERT((expression2 == nullptr) ^ (op == Aggregation::Op::COLLECT_MAP),
-               "The second expression is obligatory in COLLECT_MAP and "
+    DMG_ASSERT((expression2 == nullptr) ^
+                   (op == Aggregation::Op::COLLECT_MAP || op == Aggregation::Op::APPROX_PERCENTILE),
+               "The second expression is obligatory in COLLECT_MAP and APPROX_PERCENTILE and "
                "invalid otherwise");
   }
 
@@ -1304,6 +1321,9 @@ class Function : public memgraph::query::Expression {
   std::vector<memgraph::query::Expression *> arguments_;
   std::string function_name_;
   std::function<TypedValue(const TypedValue *, int64_t, const FunctionContext &)> function_;
+  /// Set by the planner if the function is deterministic and its arguments are constant during an execution, so it's
+  /// evaluated once per execution.
+  bool is_constant_{false};
 
   Function *Clone(AstStorage *storage) const override {
     Function *object = storage->Create<Function>();
@@ -1313,6 +1333,7 @@ class Function : public memgraph::query::Expression {
     }
     object->function_name_ = function_name_;
     object->function_ = function_;
+    object->is_constant_ = is_constant_;
     return object;
   }
 
@@ -2089,6 +2110,10 @@ class CypherQuery : public memgraph::query::Query, public utils::Visitable<Hiera
   std::vector<memgraph::query::CypherUnion *> cypher_unions_;
   memgraph::query::Expression *memory_limit_{nullptr};
   size_t memory_scale_{1024U};
+  /// Set by the `USING PARALLEL EXECUTION` hint, allows operators of the query to pull their input on multiple threads.
+  bool parallel_execution_{false};
+  /// Set by the `USING PERIODIC COMMIT n` hint, the number of rows after which the transaction is committed.
+  memgraph::query::Expression *commit_frequency_{nullptr};
 
   CypherQuery *Clone(AstStorage *storage) const override {
     CypherQuery *object = storage->Create<CypherQuery>();
@@ -2099,6 +2124,8 @@ class CypherQuery : public memgraph::query::Query, public utils::Visitable<Hiera
     }
     object->memory_limit_ = memory_limit_ ? memory_limit_->Clone(storage) : nullptr;
     object->memory_scale_ = memory_scale_;
+    object->parallel_execution_ = parallel_execution_;
+    object->commit_frequency_ = commit_frequency_ ? commit_frequency_->Clone(storage) : nullptr;
     return object;
   }
 
@@ -2150,6 +2177,31 @@ class ProfileQuery : public memgraph::query::Query {
   friend class AstStorage;
 };
 
+class ExportQuery : public memgraph::query::Query {
+ public:
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const override { return kType; }
+
+  ExportQuery() = default;
+
+  DEFVISITABLE(QueryVisitor<void>);
+
+  /// The directory on the server where the files are written.
+  memgraph::query::Expression *directory_{nullptr};
+  /// The CypherQuery whose results are exported.
+  memgraph::query::CypherQuery *cypher_query_{nullptr};
+
+  ExportQuery *Clone(AstStorage *storage) const override {
+    ExportQuery *object = storage->Create<ExportQuery>();
+    object->directory_ = directory_ ? directory_->Clone(storage) : nullptr;
+    object->cypher_query_ = cypher_query_ ? cypher_query_->Clone(storage) : nullptr;
+    return object;
+  }
+
+ private:
+  friend class AstStorage;
+};
+
 class IndexQuery : public memgraph::query::Query {
  public:
   static const utils::TypeInfo kType;
@@ -2184,6 +2236,135 @@ class IndexQuery : public memgraph::query::Query {
   friend class AstStorage;
 };
 
+class EdgeIndexQuery : public memgraph::query::Query {
+ public:
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const override { return kType; }
+
+  enum class Action { CREATE, DROP };
+
+  EdgeIndexQuery() = default;
+
+  DEFVISITABLE(QueryVisitor<void>);
+
+  memgraph::query::EdgeIndexQuery::Action action_;
+  memgraph::query::EdgeTypeIx edge_type_;
+  std::vector<memgraph::query::PropertyIx> properties_;
+
+  EdgeIndexQuery *Clone(AstStorage *storage) const override {
+    EdgeIndexQuery *object = storage->Create<EdgeIndexQuery>();
+    object->action_ = action_;
+    object->edge_type_ = storage->GetEdgeTypeIx(edge_type_.name);
+    object->properties_.resize(properties_.size());
+    for (auto i = 0; i < object->properties_.size(); ++i) {
+      object->properties_[i] = storage->GetPropertyIx(properties_[i].name);
+    }
+    return object;
+  }
+
+ protected:
+  EdgeIndexQuery(Action action, EdgeTypeIx edge_type, std::vector<PropertyIx> properties)
+      : action_(action), edge_type_(edge_type), properties_(properties) {}
+
+ private:
+  friend class AstStorage;
+};
+
+class TextIndexQuery : public memgraph::query::Query {
+ public:
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const override { return kType; }
+
+  enum class Action { CREATE, DROP };
+
+  TextIndexQuery() = default;
+
+  DEFVISITABLE(QueryVisitor<void>);
+
+  memgraph::query::TextIndexQuery::Action action_;
+  memgraph::query::LabelIx label_;
+  memgraph::query::PropertyIx property_;
+
+  TextIndexQuery *Clone(AstStorage *storage) const override {
+    TextIndexQuery *object = storage->Create<TextIndexQuery>();
+    object->action_ = action_;
+    object->label_ = storage->GetLabelIx(label_.name);
+    object->property_ = storage->GetPropertyIx(property_.name);
+    return object;
+  }
+
+ protected:
+  TextIndexQuery(Action action, LabelIx label, PropertyIx property)
+      : action_(action), label_(label), property_(property) {}
+
+ private:
+  friend class AstStorage;
+};
+
+class VectorIndexQuery : public memgraph::query::Query {
+ public:
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const override { return kType; }
+
+  enum class Action { CREATE, DROP };
+
+  VectorIndexQuery() = default;
+
+  DEFVISITABLE(QueryVisitor<void>);
+
+  memgraph::query::VectorIndexQuery::Action action_;
+  memgraph::query::LabelIx label_;
+  memgraph::query::PropertyIx property_;
+
+  VectorIndexQuery *Clone(AstStorage *storage) const override {
+    VectorIndexQuery *object = storage->Create<VectorIndexQuery>();
+    object->action_ = action_;
+    object->label_ = storage->GetLabelIx(label_.name);
+    object->property_ = storage->GetPropertyIx(property_.name);
+    return object;
+  }
+
+ protected:
+  VectorIndexQuery(Action action, LabelIx label, PropertyIx property)
+      : action_(action), label_(label), property_(property) {}
+
+ private:
+  friend class AstStorage;
+};
+
+class AggregateIndexQuery : public memgraph::query::Query {
+ public:
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const override { return kType; }
+
+  enum class Action { CREATE, DROP };
+
+  AggregateIndexQuery() = default;
+
+  DEFVISITABLE(QueryVisitor<void>);
+
+  memgraph::query::AggregateIndexQuery::Action action_;
+  memgraph::query::LabelIx label_;
+  memgraph::query::PropertyIx group_property_;
+  memgraph::query::PropertyIx value_property_;
+
+  AggregateIndexQuery *Clone(AstStorage *storage) const override {
+    AggregateIndexQuery *object = storage->Create<AggregateIndexQuery>();
+    object->action_ = action_;
+    object->label_ = storage->GetLabelIx(label_.name);
+    object->group_property_ = storage->GetPropertyIx(group_property_.name);
+    object->value_property_ = storage->GetPropertyIx(value_property_.name);
+    return object;
+  }
+
+ protected:
+  AggregateIndexQuery(Action action, LabelIx label, PropertyIx group_property, PropertyIx value_property)
+      : action_(action), label_(label), group_property_(group_property), value_property_(value_property) {}
+
+ private:
+  friend class AstStorage;
+};
+
 class Create : public memgraph::query::Clause {
  public:
   static const utils::TypeInfo kType;
@@ -2958,8 +3139,12 @@ class DumpQuery : public memgraph::query::Query {
 
   DEFVISITABLE(QueryVisitor<void>);
 
+  /// Dump the vertices and edges on multiple threads with batched queries.
+  bool parallel_execution_{false};
+
   DumpQuery *Clone(AstStorage *storage) const override {
     DumpQuery *object = storage->Create<DumpQuery>();
+    object->parallel_execution_ = parallel_execution_;
     return object;
   }
 };
@@ -3077,6 +3262,46 @@ class LoadCsv : public memgraph::query::Clause {
   friend class AstStorage;
 };
 
+class LoadArrow : public memgraph::query::Clause {
+ public:
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const override { return kType; }
+
+  LoadArrow() = default;
+
+  bool Accept(HierarchicalTreeVisitor &visitor) override {
+    if (visitor.PreVisit(*this)) {
+      row_var_->Accept(visitor);
+    }
+    return visitor.PostVisit(*this);
+  }
+
+  memgraph::query::Expression *file_;
+  memgraph::query::Identifier *row_var_{nullptr};
+  /// Columns which the rest of the query reads from the row, the others aren't
+  /// decoded. Ignored if `all_columns_` is set.
+  std::vector<std::string> columns_;
+  /// Set if the row is used as a whole, e.g. returned or passed to a function.
+  bool all_columns_{true};
+
+  LoadArrow *Clone(AstStorage *storage) const override {
+    LoadArrow *object = storage->Create<LoadArrow>();
+    object->file_ = file_ ? file_->Clone(storage) : nullptr;
+    object->row_var_ = row_var_ ? row_var_->Clone(storage) : nullptr;
+    object->columns_ = columns_;
+    object->all_columns_ = all_columns_;
+    return object;
+  }
+
+ protected:
+  LoadArrow(Expression *file, Identifier *row_var) : file_(file), row_var_(row_var) {
+    DMG_ASSERT(row_var, "LoadArrow cannot take nullptr for identifier");
+  }
+
+ private:
+  friend class AstStorage;
+};
+
 class FreeMemoryQuery : public memgraph::query::Query {
  public:
   static const utils::TypeInfo kType;
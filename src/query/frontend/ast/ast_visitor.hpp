@@ -81,7 +81,12 @@ class Unwind;
 class AuthQuery;
 class ExplainQuery;
 class ProfileQuery;
+class ExportQuery;
 class IndexQuery;
+class EdgeIndexQuery;
+class TextIndexQuery;
+class VectorIndexQuery;
+class AggregateIndexQuery;
 class InfoQuery;
 class ConstraintQuery;
 class RegexMatch;
@@ -89,6 +94,7 @@ class DumpQuery;
 class ReplicationQuery;
 class LockPathQuery;
 class LoadCsv;
+class LoadArrow;
 class FreeMemoryQuery;
 class TriggerQuery;
 class IsolationLevelQuery;
@@ -114,7 +120,7 @@ using TreeCompositeVisitor = utils::CompositeVisitor<
     MapProjectionLiteral, PropertyLookup, AllPropertiesLookup, LabelsTest, Aggregation, Function, Reduce, Coalesce,
     Extract, All, Single, Any, None, CallProcedure, Create, Match, Return, With, Pattern, NodeAtom, EdgeAtom, Delete,
     Where, SetProperty, SetProperties, SetLabels, RemoveProperty, RemoveLabels, Merge, Unwind, RegexMatch, LoadCsv,
-    Foreach, Exists, CallSubquery, CypherQuery>;
+    LoadArrow, Foreach, Exists, CallSubquery, CypherQuery>;
 
 using TreeLeafVisitor = utils::LeafVisitor<Identifier, PrimitiveLiteral, ParameterLookup>;
 
@@ -139,7 +145,8 @@ class ExpressionVisitor
 
 template <class TResult>
 class QueryVisitor
-    : public utils::Visitor<TResult, CypherQuery, ExplainQuery, ProfileQuery, IndexQuery, AuthQuery, InfoQuery,
+    : public utils::Visitor<TResult, CypherQuery, ExplainQuery, ProfileQuery, ExportQuery, IndexQuery,
+                            EdgeIndexQuery, TextIndexQuery, VectorIndexQuery, AggregateIndexQuery, AuthQuery, InfoQuery,
                             ConstraintQuery, DumpQuery, ReplicationQuery, LockPathQuery, FreeMemoryQuery, TriggerQuery,
                             IsolationLevelQuery, CreateSnapshotQuery, StreamQuery, SettingQuery, VersionQuery,
                             ShowConfigQuery, TransactionQueueQuery, StorageModeQuery, AnalyzeGraphQuery,
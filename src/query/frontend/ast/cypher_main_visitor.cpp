@@ -20,6 +20,7 @@
 #include <cstring>
 #include <iterator>
 #include <limits>
+#include <set>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -92,6 +93,68 @@ std::string JoinSymbolicNamesWithDotsAndMinus(antlr4::tree::ParseTreeVisitor &vi
       ctx.symbolicNameWithMinus(), [&](auto *token) { return JoinSymbolicNames(&visitor, token->symbolicName(), "-"); },
       ".");
 }
+
+/// Collects the columns of the row of LOAD ARROW which are read by the clauses
+/// after it. The row is recognized by its name, so a variable which shadows it
+/// only makes more columns be read.
+class ArrowColumnsCollector : public HierarchicalTreeVisitor {
+ public:
+  explicit ArrowColumnsCollector(const std::string &row_name) : row_name_(row_name) {}
+
+  using HierarchicalTreeVisitor::PostVisit;
+  using HierarchicalTreeVisitor::PreVisit;
+  using HierarchicalTreeVisitor::Visit;
+
+  bool PreVisit(PropertyLookup &lookup) override {
+    if (IsRow(lookup.expression_)) {
+      columns_.insert(lookup.property_.name);
+      return false;
+    }
+    return true;
+  }
+
+  bool PreVisit(MapProjectionLiteral &projection) override {
+    // The variable of the projection isn't visited.
+    if (IsRow(projection.map_variable_)) all_columns_ = true;
+    return true;
+  }
+
+  bool PreVisit(EdgeAtom &edge_atom) override {
+    // The lambdas of the edge aren't visited.
+    for (auto *lambda : {&edge_atom.filter_lambda_, &edge_atom.weight_lambda_}) {
+      if (lambda->expression) lambda->expression->Accept(*this);
+    }
+    return true;
+  }
+
+  bool PreVisit(Return &ret) override {
+    all_columns_ = all_columns_ || ret.body_.all_identifiers;
+    return true;
+  }
+
+  bool PreVisit(With &with) override {
+    all_columns_ = all_columns_ || with.body_.all_identifiers;
+    return true;
+  }
+
+  bool Visit(Identifier &identifier) override {
+    if (identifier.name_ == row_name_) all_columns_ = true;
+    return true;
+  }
+  bool Visit(PrimitiveLiteral & /*unused*/) override { return true; }
+  bool Visit(ParameterLookup & /*unused*/) override { return true; }
+
+  std::set<std::string> columns_;
+  bool all_columns_{false};
+
+ private:
+  bool IsRow(Expression *expression) const {
+    auto *identifier = utils::Downcast<Identifier>(expression);
+    return identifier && identifier->name_ == row_name_;
+  }
+
+  const std::string &row_name_;
+};
 }  // namespace
 
 antlrcpp::Any CypherMainVisitor::visitExplainQuery(MemgraphCypher::ExplainQueryContext *ctx) {
@@ -112,6 +175,24 @@ antlrcpp::Any CypherMainVisitor::visitProfileQuery(MemgraphCypher::ProfileQueryC
   return profile_query;
 }
 
+antlrcpp::Any CypherMainVisitor::visitExportQuery(MemgraphCypher::ExportQueryContext *ctx) {
+  // The files are written on the server, so the same setting as for LOAD CSV
+  // disables it.
+  query_info_.has_load_csv = true;
+
+  if (!ctx->directory->StringLiteral()) {
+    throw SemanticException("Export directory should be a string literal");
+  }
+  auto *export_query = storage_->Create<ExportQuery>();
+  export_query->directory_ = std::any_cast<Expression *>(ctx->directory->accept(this));
+  export_query->cypher_query_ = std::any_cast<CypherQuery *>(ctx->cypherQuery()->accept(this));
+  if (export_query->cypher_query_->commit_frequency_) {
+    throw SemanticException("Periodic commit can't be used with EXPORT!");
+  }
+  query_ = export_query;
+  return export_query;
+}
+
 antlrcpp::Any CypherMainVisitor::visitInfoQuery(MemgraphCypher::InfoQueryContext *ctx) {
   MG_ASSERT(ctx->children.size() == 2, "InfoQuery should have exactly two children!");
   auto *info_query = storage_->Create<InfoQuery>();
@@ -199,6 +280,16 @@ antlrcpp::Any CypherMainVisitor::visitCypherQuery(MemgraphCypher::CypherQueryCon
     }
   }
 
+  cypher_query->parallel_execution_ = ctx->parallelExecution() != nullptr;
+
+  if (auto *periodic_commit_ctx = ctx->periodicCommit()) {
+    if (!cypher_query->cypher_unions_.empty()) {
+      throw SemanticException("Periodic commit can't be used with UNION!");
+    }
+    cypher_query->commit_frequency_ =
+        std::any_cast<Expression *>(periodic_commit_ctx->periodicCommitNumber->accept(this));
+  }
+
   query_ = cypher_query;
   return cypher_query;
 }
@@ -210,28 +301,138 @@ antlrcpp::Any CypherMainVisitor::visitIndexQuery(MemgraphCypher::IndexQueryConte
   return index_query;
 }
 
+namespace {
+
+void CheckIndexProperties(const std::vector<PropertyIx> &properties) {
+  for (auto it = properties.begin(); it != properties.end(); ++it) {
+    if (std::find(std::next(it), properties.end(), *it) != properties.end()) {
+      throw SemanticException("Property {} appears in the index more than once.", it->name);
+    }
+  }
+}
+
+}  // namespace
+
 antlrcpp::Any CypherMainVisitor::visitCreateIndex(MemgraphCypher::CreateIndexContext *ctx) {
   auto *index_query = storage_->Create<IndexQuery>();
   index_query->action_ = IndexQuery::Action::CREATE;
   index_query->label_ = AddLabel(std::any_cast<std::string>(ctx->labelName()->accept(this)));
-  if (ctx->propertyKeyName()) {
-    auto name_key = std::any_cast<PropertyIx>(ctx->propertyKeyName()->accept(this));
-    index_query->properties_ = {name_key};
+  for (auto *property_key_name : ctx->propertyKeyName()) {
+    index_query->properties_.push_back(std::any_cast<PropertyIx>(property_key_name->accept(this)));
   }
+  CheckIndexProperties(index_query->properties_);
   return index_query;
 }
 
 antlrcpp::Any CypherMainVisitor::visitDropIndex(MemgraphCypher::DropIndexContext *ctx) {
   auto *index_query = storage_->Create<IndexQuery>();
   index_query->action_ = IndexQuery::Action::DROP;
-  if (ctx->propertyKeyName()) {
-    auto key = std::any_cast<PropertyIx>(ctx->propertyKeyName()->accept(this));
-    index_query->properties_ = {key};
+  for (auto *property_key_name : ctx->propertyKeyName()) {
+    index_query->properties_.push_back(std::any_cast<PropertyIx>(property_key_name->accept(this)));
   }
+  CheckIndexProperties(index_query->properties_);
   index_query->label_ = AddLabel(std::any_cast<std::string>(ctx->labelName()->accept(this)));
   return index_query;
 }
 
+antlrcpp::Any CypherMainVisitor::visitEdgeIndexQuery(MemgraphCypher::EdgeIndexQueryContext *ctx) {
+  MG_ASSERT(ctx->children.size() == 1, "EdgeIndexQuery should have exactly one child!");
+  auto *edge_index_query = std::any_cast<EdgeIndexQuery *>(ctx->children[0]->accept(this));
+  query_ = edge_index_query;
+  return edge_index_query;
+}
+
+antlrcpp::Any CypherMainVisitor::visitCreateEdgeIndex(MemgraphCypher::CreateEdgeIndexContext *ctx) {
+  auto *edge_index_query = storage_->Create<EdgeIndexQuery>();
+  edge_index_query->action_ = EdgeIndexQuery::Action::CREATE;
+  edge_index_query->edge_type_ = AddEdgeType(std::any_cast<std::string>(ctx->relTypeName()->accept(this)));
+  if (ctx->propertyKeyName()) {
+    edge_index_query->properties_.push_back(std::any_cast<PropertyIx>(ctx->propertyKeyName()->accept(this)));
+  }
+  return edge_index_query;
+}
+
+antlrcpp::Any CypherMainVisitor::visitDropEdgeIndex(MemgraphCypher::DropEdgeIndexContext *ctx) {
+  auto *edge_index_query = storage_->Create<EdgeIndexQuery>();
+  edge_index_query->action_ = EdgeIndexQuery::Action::DROP;
+  edge_index_query->edge_type_ = AddEdgeType(std::any_cast<std::string>(ctx->relTypeName()->accept(this)));
+  if (ctx->propertyKeyName()) {
+    edge_index_query->properties_.push_back(std::any_cast<PropertyIx>(ctx->propertyKeyName()->accept(this)));
+  }
+  return edge_index_query;
+}
+
+antlrcpp::Any CypherMainVisitor::visitTextIndexQuery(MemgraphCypher::TextIndexQueryContext *ctx) {
+  MG_ASSERT(ctx->children.size() == 1, "TextIndexQuery should have exactly one child!");
+  auto *text_index_query = std::any_cast<TextIndexQuery *>(ctx->children[0]->accept(this));
+  query_ = text_index_query;
+  return text_index_query;
+}
+
+antlrcpp::Any CypherMainVisitor::visitCreateTextIndex(MemgraphCypher::CreateTextIndexContext *ctx) {
+  auto *text_index_query = storage_->Create<TextIndexQuery>();
+  text_index_query->action_ = TextIndexQuery::Action::CREATE;
+  text_index_query->label_ = AddLabel(std::any_cast<std::string>(ctx->labelName()->accept(this)));
+  text_index_query->property_ = std::any_cast<PropertyIx>(ctx->propertyKeyName()->accept(this));
+  return text_index_query;
+}
+
+antlrcpp::Any CypherMainVisitor::visitDropTextIndex(MemgraphCypher::DropTextIndexContext *ctx) {
+  auto *text_index_query = storage_->Create<TextIndexQuery>();
+  text_index_query->action_ = TextIndexQuery::Action::DROP;
+  text_index_query->label_ = AddLabel(std::any_cast<std::string>(ctx->labelName()->accept(this)));
+  text_index_query->property_ = std::any_cast<PropertyIx>(ctx->propertyKeyName()->accept(this));
+  return text_index_query;
+}
+
+antlrcpp::Any CypherMainVisitor::visitVectorIndexQuery(MemgraphCypher::VectorIndexQueryContext *ctx) {
+  MG_ASSERT(ctx->children.size() == 1, "VectorIndexQuery should have exactly one child!");
+  auto *vector_index_query = std::any_cast<VectorIndexQuery *>(ctx->children[0]->accept(this));
+  query_ = vector_index_query;
+  return vector_index_query;
+}
+
+antlrcpp::Any CypherMainVisitor::visitCreateVectorIndex(MemgraphCypher::CreateVectorIndexContext *ctx) {
+  auto *vector_index_query = storage_->Create<VectorIndexQuery>();
+  vector_index_query->action_ = VectorIndexQuery::Action::CREATE;
+  vector_index_query->label_ = AddLabel(std::any_cast<std::string>(ctx->labelName()->accept(this)));
+  vector_index_query->property_ = std::any_cast<PropertyIx>(ctx->propertyKeyName()->accept(this));
+  return vector_index_query;
+}
+
+antlrcpp::Any CypherMainVisitor::visitDropVectorIndex(MemgraphCypher::DropVectorIndexContext *ctx) {
+  auto *vector_index_query = storage_->Create<VectorIndexQuery>();
+  vector_index_query->action_ = VectorIndexQuery::Action::DROP;
+  vector_index_query->label_ = AddLabel(std::any_cast<std::string>(ctx->labelName()->accept(this)));
+  vector_index_query->property_ = std::any_cast<PropertyIx>(ctx->propertyKeyName()->accept(this));
+  return vector_index_query;
+}
+
+antlrcpp::Any CypherMainVisitor::visitAggregateIndexQuery(MemgraphCypher::AggregateIndexQueryContext *ctx) {
+  MG_ASSERT(ctx->children.size() == 1, "AggregateIndexQuery should have exactly one child!");
+  auto *aggregate_index_query = std::any_cast<AggregateIndexQuery *>(ctx->children[0]->accept(this));
+  query_ = aggregate_index_query;
+  return aggregate_index_query;
+}
+
+antlrcpp::Any CypherMainVisitor::visitCreateAggregateIndex(MemgraphCypher::CreateAggregateIndexContext *ctx) {
+  auto *aggregate_index_query = storage_->Create<AggregateIndexQuery>();
+  aggregate_index_query->action_ = AggregateIndexQuery::Action::CREATE;
+  aggregate_index_query->label_ = AddLabel(std::any_cast<std::string>(ctx->labelName()->accept(this)));
+  aggregate_index_query->group_property_ = std::any_cast<PropertyIx>(ctx->groupProperty->accept(this));
+  aggregate_index_query->value_property_ = std::any_cast<PropertyIx>(ctx->valueProperty->accept(this));
+  return aggregate_index_query;
+}
+
+antlrcpp::Any CypherMainVisitor::visitDropAggregateIndex(MemgraphCypher::DropAggregateIndexContext *ctx) {
+  auto *aggregate_index_query = storage_->Create<AggregateIndexQuery>();
+  aggregate_index_query->action_ = AggregateIndexQuery::Action::DROP;
+  aggregate_index_query->label_ = AddLabel(std::any_cast<std::string>(ctx->labelName()->accept(this)));
+  aggregate_index_query->group_property_ = std::any_cast<PropertyIx>(ctx->groupProperty->accept(this));
+  aggregate_index_query->value_property_ = std::any_cast<PropertyIx>(ctx->valueProperty->accept(this));
+  return aggregate_index_query;
+}
+
 antlrcpp::Any CypherMainVisitor::visitAuthQuery(MemgraphCypher::AuthQueryContext *ctx) {
   MG_ASSERT(ctx->children.size() == 1, "AuthQuery should have exactly one child!");
   auto *auth_query = std::any_cast<AuthQuery *>(ctx->children[0]->accept(this));
@@ -241,6 +442,7 @@ antlrcpp::Any CypherMainVisitor::visitAuthQuery(MemgraphCypher::AuthQueryContext
 
 antlrcpp::Any CypherMainVisitor::visitDumpQuery(MemgraphCypher::DumpQueryContext *ctx) {
   auto *dump_query = storage_->Create<DumpQuery>();
+  dump_query->parallel_execution_ = ctx->parallelExecution() != nullptr;
   query_ = dump_query;
   return dump_query;
 }
@@ -393,6 +595,22 @@ antlrcpp::Any CypherMainVisitor::visitLoadCsv(MemgraphCypher::LoadCsvContext *ct
   return load_csv;
 }
 
+antlrcpp::Any CypherMainVisitor::visitLoadArrow(MemgraphCypher::LoadArrowContext *ctx) {
+  // LOAD ARROW reads files like LOAD CSV, so the same setting disables it.
+  query_info_.has_load_csv = true;
+
+  auto *load_arrow = storage_->Create<LoadArrow>();
+  if (ctx->arrowFile()->literal()->StringLiteral()) {
+    load_arrow->file_ = std::any_cast<Expression *>(ctx->arrowFile()->accept(this));
+  } else {
+    throw SemanticException("Arrow file path should be a string literal");
+  }
+  load_arrow->row_var_ =
+      storage_->Create<Identifier>(std::any_cast<std::string>(ctx->rowVar()->variable()->accept(this)));
+  // The columns are known once the rest of the query is visited.
+  return load_arrow;
+}
+
 antlrcpp::Any CypherMainVisitor::visitFreeMemoryQuery(MemgraphCypher::FreeMemoryQueryContext *ctx) {
   auto *free_memory_query = storage_->Create<FreeMemoryQuery>();
   query_ = free_memory_query;
@@ -1035,6 +1253,16 @@ antlrcpp::Any CypherMainVisitor::visitSingleQuery(MemgraphCypher::SingleQueryCon
         throw SemanticException("LOAD CSV can't be put after RETURN clause.");
       }
       has_load_csv = true;
+    } else if (utils::IsSubtype(clause_type, LoadArrow::kType)) {
+      // Like LOAD CSV, the clause can only be executed once.
+      if (has_load_csv) {
+        throw SemanticException("Can't have multiple LOAD CSV or LOAD ARROW clauses in a single query.");
+      }
+      check_write_procedure("LOAD ARROW");
+      if (has_return) {
+        throw SemanticException("LOAD ARROW can't be put after RETURN clause.");
+      }
+      has_load_csv = true;
     } else if (auto *match = utils::Downcast<Match>(clause)) {
       if (has_update || has_return) {
         throw SemanticException("MATCH can't be put after RETURN clause or after an update.");
@@ -1091,6 +1319,16 @@ antlrcpp::Any CypherMainVisitor::visitSingleQuery(MemgraphCypher::SingleQueryCon
       }
     }
   }
+
+  // LOAD ARROW decodes only the columns which the clauses after it read.
+  for (auto it = single_query->clauses_.begin(); it != single_query->clauses_.end(); ++it) {
+    auto *load_arrow = utils::Downcast<LoadArrow>(*it);
+    if (!load_arrow) continue;
+    ArrowColumnsCollector collector(load_arrow->row_var_->name_);
+    for (auto next = std::next(it); next != single_query->clauses_.end(); ++next) (*next)->Accept(collector);
+    load_arrow->all_columns_ = collector.all_columns_;
+    load_arrow->columns_.assign(collector.columns_.begin(), collector.columns_.end());
+  }
   return single_query;
 }
 
@@ -1130,6 +1368,9 @@ antlrcpp::Any CypherMainVisitor::visitClause(MemgraphCypher::ClauseContext *ctx)
   if (ctx->loadCsv()) {
     return static_cast<Clause *>(std::any_cast<LoadCsv *>(ctx->loadCsv()->accept(this)));
   }
+  if (ctx->loadArrow()) {
+    return static_cast<Clause *>(std::any_cast<LoadArrow *>(ctx->loadArrow()->accept(this)));
+  }
   if (ctx->foreach ()) {
     return static_cast<Clause *>(std::any_cast<Foreach *>(ctx->foreach ()->accept(this)));
   }
@@ -2465,6 +2706,10 @@ antlrcpp::Any CypherMainVisitor::visitFunctionInvocation(MemgraphCypher::Functio
       return static_cast<Expression *>(
           storage_->Create<Aggregation>(expressions[0], nullptr, Aggregation::Op::PROJECT, is_distinct));
     }
+    if (function_name == Aggregation::kApproxCountDistinct) {
+      return static_cast<Expression *>(storage_->Create<Aggregation>(
+          expressions[0], nullptr, Aggregation::Op::APPROX_COUNT_DISTINCT, is_distinct));
+    }
   }
 
   if (expressions.size() == 2U && function_name == Aggregation::kCollect) {
@@ -2472,6 +2717,11 @@ antlrcpp::Any CypherMainVisitor::visitFunctionInvocation(MemgraphCypher::Functio
         storage_->Create<Aggregation>(expressions[1], expressions[0], Aggregation::Op::COLLECT_MAP, is_distinct));
   }
 
+  if (expressions.size() == 2U && function_name == Aggregation::kApproxPercentile) {
+    return static_cast<Expression *>(storage_->Create<Aggregation>(
+        expressions[0], expressions[1], Aggregation::Op::APPROX_PERCENTILE, is_distinct));
+  }
+
   auto is_user_defined_function = [](const std::string &function_name) {
     // Dots are present only in user-defined functions, since modules are case-sensitive, so must be
     // user-defined functions. Builtin functions should be case insensitive.
@@ -2715,6 +2965,14 @@ antlrcpp::Any CypherMainVisitor::visitCallSubquery(MemgraphCypher::CallSubqueryC
     throw SyntaxException("Memory limit cannot be set on subqueries!");
   }
 
+  if (ctx->cypherQuery()->parallelExecution()) {
+    throw SyntaxException("Parallel execution cannot be set on subqueries!");
+  }
+
+  if (ctx->cypherQuery()->periodicCommit()) {
+    throw SyntaxException("Periodic commit cannot be set on subqueries!");
+  }
+
   call_subquery->cypher_query_ = std::any_cast<CypherQuery *>(ctx->cypherQuery()->accept(this));
 
   return call_subquery;
@@ -146,6 +146,26 @@ class CypherMainVisitor : public antlropencypher::MemgraphCypherBaseVisitor {
    */
   antlrcpp::Any visitIndexQuery(MemgraphCypher::IndexQueryContext *ctx) override;
 
+  /**
+   * @return EdgeIndexQuery*
+   */
+  antlrcpp::Any visitEdgeIndexQuery(MemgraphCypher::EdgeIndexQueryContext *ctx) override;
+
+  /**
+   * @return TextIndexQuery*
+   */
+  antlrcpp::Any visitTextIndexQuery(MemgraphCypher::TextIndexQueryContext *ctx) override;
+
+  /**
+   * @return VectorIndexQuery*
+   */
+  antlrcpp::Any visitVectorIndexQuery(MemgraphCypher::VectorIndexQueryContext *ctx) override;
+
+  /**
+   * @return AggregateIndexQuery*
+   */
+  antlrcpp::Any visitAggregateIndexQuery(MemgraphCypher::AggregateIndexQueryContext *ctx) override;
+
   /**
    * @return ExplainQuery*
    */
@@ -156,6 +176,11 @@ class CypherMainVisitor : public antlropencypher::MemgraphCypherBaseVisitor {
    */
   antlrcpp::Any visitProfileQuery(MemgraphCypher::ProfileQueryContext *ctx) override;
 
+  /**
+   * @return ExportQuery*
+   */
+  antlrcpp::Any visitExportQuery(MemgraphCypher::ExportQueryContext *ctx) override;
+
   /**
    * @return InfoQuery*
    */
@@ -231,6 +256,11 @@ class CypherMainVisitor : public antlropencypher::MemgraphCypherBaseVisitor {
    */
   antlrcpp::Any visitLoadCsv(MemgraphCypher::LoadCsvContext *ctx) override;
 
+  /**
+   * @return LoadArrow*
+   */
+  antlrcpp::Any visitLoadArrow(MemgraphCypher::LoadArrowContext *ctx) override;
+
   /**
    * @return FreeMemoryQuery*
    */
@@ -456,6 +486,46 @@ class CypherMainVisitor : public antlropencypher::MemgraphCypherBaseVisitor {
    */
   antlrcpp::Any visitDropIndex(MemgraphCypher::DropIndexContext *ctx) override;
 
+  /**
+   * @return EdgeIndexQuery*
+   */
+  antlrcpp::Any visitCreateEdgeIndex(MemgraphCypher::CreateEdgeIndexContext *ctx) override;
+
+  /**
+   * @return EdgeIndexQuery*
+   */
+  antlrcpp::Any visitDropEdgeIndex(MemgraphCypher::DropEdgeIndexContext *ctx) override;
+
+  /**
+   * @return TextIndexQuery*
+   */
+  antlrcpp::Any visitCreateTextIndex(MemgraphCypher::CreateTextIndexContext *ctx) override;
+
+  /**
+   * @return TextIndexQuery*
+   */
+  antlrcpp::Any visitDropTextIndex(MemgraphCypher::DropTextIndexContext *ctx) override;
+
+  /**
+   * @return VectorIndexQuery*
+   */
+  antlrcpp::Any visitCreateVectorIndex(MemgraphCypher::CreateVectorIndexContext *ctx) override;
+
+  /**
+   * @return VectorIndexQuery*
+   */
+  antlrcpp::Any visitDropVectorIndex(MemgraphCypher::DropVectorIndexContext *ctx) override;
+
+  /**
+   * @return AggregateIndexQuery*
+   */
+  antlrcpp::Any visitCreateAggregateIndex(MemgraphCypher::CreateAggregateIndexContext *ctx) override;
+
+  /**
+   * @return AggregateIndexQuery*
+   */
+  antlrcpp::Any visitDropAggregateIndex(MemgraphCypher::DropAggregateIndexContext *ctx) override;
+
   /**
    * @return AuthQuery*
    */
@@ -54,7 +54,7 @@ explainQuery : EXPLAIN cypherQuery ;
 
 profileQuery : PROFILE cypherQuery ;
 
-cypherQuery : singleQuery ( cypherUnion )* ( queryMemoryLimit )? ;
+cypherQuery : ( parallelExecution )? singleQuery ( cypherUnion )* ( queryMemoryLimit )? ;
 
 indexQuery : createIndex | dropIndex;
 
@@ -118,6 +118,8 @@ memoryLimit : MEMORY ( UNLIMITED | LIMIT literal ( MB | KB ) ) ;
 
 queryMemoryLimit : QUERY memoryLimit ;
 
+parallelExecution : USING PARALLEL EXECUTION ;
+
 procedureMemoryLimit : PROCEDURE memoryLimit ;
 
 procedureResult : ( variable AS variable ) | variable ;
@@ -328,9 +330,9 @@ integerLiteral : DecimalLiteral
                | HexadecimalLiteral
                ;
 
-createIndex : CREATE INDEX ON ':' labelName ( '(' propertyKeyName ')' )? ;
+createIndex : CREATE INDEX ON ':' labelName ( '(' propertyKeyName ( ',' propertyKeyName )* ')' )? ;
 
-dropIndex : DROP INDEX ON ':' labelName ( '(' propertyKeyName ')' )? ;
+dropIndex : DROP INDEX ON ':' labelName ( '(' propertyKeyName ( ',' propertyKeyName )* ')' )? ;
 
 doubleLiteral : FloatingLiteral ;
 
@@ -358,6 +360,7 @@ cypherKeyword : ALL
               | ELSE
               | END
               | ENDS
+              | EXECUTION
               | EXISTS
               | EXPLAIN
               | EXTRACT
@@ -379,6 +382,7 @@ cypherKeyword : ALL
               | OPTIONAL
               | OR
               | ORDER
+              | PARALLEL
               | PROCEDURE
               | PROFILE
               | QUERY
@@ -395,6 +399,7 @@ cypherKeyword : ALL
               | UNION
               | UNIQUE
               | UNWIND
+              | USING
               | WHEN
               | WHERE
               | WITH
@@ -94,6 +94,7 @@ DROP           : D R O P ;
 ELSE           : E L S E ;
 END            : E N D ;
 ENDS           : E N D S ;
+EXECUTION      : E X E C U T I O N ;
 EXISTS         : E X I S T S ;
 EXPLAIN        : E X P L A I N ;
 EXTRACT        : E X T R A C T ;
@@ -118,6 +119,7 @@ ON             : O N ;
 OPTIONAL       : O P T I O N A L ;
 OR             : O R ;
 ORDER          : O R D E R ;
+PARALLEL       : P A R A L L E L ;
 PROCEDURE      : P R O C E D U R E ;
 PROFILE        : P R O F I L E ;
 QUERY          : Q U E R Y ;
@@ -135,6 +137,7 @@ UNION          : U N I O N ;
 UNIQUE         : U N I Q U E ;
 UNLIMITED      : U N L I M I T E D ;
 UNWIND         : U N W I N D ;
+USING          : U S I N G ;
 WHEN           : W H E N ;
 WHERE          : W H E R E ;
 WITH           : W I T H ;
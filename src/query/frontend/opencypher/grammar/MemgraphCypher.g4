@@ -23,6 +23,7 @@ memgraphCypherKeyword : cypherKeyword
                       | AFTER
                       | ALTER
                       | ANALYZE
+                      | ARROW
                       | ASYNC
                       | AUTH
                       | BAD
@@ -48,8 +49,10 @@ memgraphCypherKeyword : cypherKeyword
                       | DENY
                       | DROP
                       | DUMP
+                      | EDGE
                       | EDGE_TYPES
                       | EXECUTE
+                      | EXPORT
                       | FOR
                       | FOREACH
                       | FREE
@@ -74,6 +77,7 @@ memgraphCypherKeyword : cypherKeyword
                       | NO
                       | NOTHING
                       | PASSWORD
+                      | PERIODIC
                       | PULSAR
                       | PORT
                       | PRIVILEGES
@@ -112,7 +116,10 @@ memgraphCypherKeyword : cypherKeyword
                       | USERS
                       | VERSION
                       | TERMINATE
+                      | TEXT
                       | TRANSACTIONS
+                      | VECTOR
+                      | AGGREGATE
                       ;
 
 symbolicName : UnescapedSymbolicName
@@ -122,8 +129,13 @@ symbolicName : UnescapedSymbolicName
 
 query : cypherQuery
       | indexQuery
+      | edgeIndexQuery
+      | textIndexQuery
+      | vectorIndexQuery
+      | aggregateIndexQuery
       | explainQuery
       | profileQuery
+      | exportQuery
       | infoQuery
       | constraintQuery
       | authQuery
@@ -178,6 +190,10 @@ triggerQuery : createTrigger
              | showTriggers
              ;
 
+cypherQuery : ( parallelExecution | periodicCommit )? singleQuery ( cypherUnion )* ( queryMemoryLimit )? ;
+
+periodicCommit : USING PERIODIC COMMIT periodicCommitNumber=literal ;
+
 clause : cypherMatch
        | unwind
        | merge
@@ -189,6 +205,7 @@ clause : cypherMatch
        | cypherReturn
        | callProcedure
        | loadCsv
+       | loadArrow
        | foreach
        | callSubquery
        ;
@@ -249,6 +266,10 @@ nullif : literal ;
 
 rowVar : variable ;
 
+loadArrow : LOAD ARROW FROM arrowFile AS rowVar ;
+
+arrowFile : literal ;
+
 userOrRoleName : symbolicName ;
 
 createRole : CREATE ROLE role=userOrRoleName ;
@@ -341,7 +362,35 @@ showRoleForUser : SHOW ROLE FOR user=userOrRoleName ;
 
 showUsersForRole : SHOW USERS FOR role=userOrRoleName ;
 
-dumpQuery: DUMP DATABASE ;
+dumpQuery: DUMP DATABASE ( parallelExecution )? ;
+
+exportQuery : EXPORT ARROW TO directory=literal cypherQuery ;
+
+edgeIndexQuery : createEdgeIndex | dropEdgeIndex ;
+
+createEdgeIndex : CREATE EDGE INDEX ON ':' relTypeName ( '(' propertyKeyName ')' )? ;
+
+dropEdgeIndex : DROP EDGE INDEX ON ':' relTypeName ( '(' propertyKeyName ')' )? ;
+
+textIndexQuery : createTextIndex | dropTextIndex ;
+
+createTextIndex : CREATE TEXT INDEX ON ':' labelName '(' propertyKeyName ')' ;
+
+dropTextIndex : DROP TEXT INDEX ON ':' labelName '(' propertyKeyName ')' ;
+
+vectorIndexQuery : createVectorIndex | dropVectorIndex ;
+
+createVectorIndex : CREATE VECTOR INDEX ON ':' labelName '(' propertyKeyName ')' ;
+
+dropVectorIndex : DROP VECTOR INDEX ON ':' labelName '(' propertyKeyName ')' ;
+
+aggregateIndexQuery : createAggregateIndex | dropAggregateIndex ;
+
+createAggregateIndex : CREATE AGGREGATE INDEX ON ':' labelName
+                       '(' groupProperty=propertyKeyName ',' valueProperty=propertyKeyName ')' ;
+
+dropAggregateIndex : DROP AGGREGATE INDEX ON ':' labelName
+                       '(' groupProperty=propertyKeyName ',' valueProperty=propertyKeyName ')' ;
 
 analyzeGraphQuery: ANALYZE GRAPH ( ON LABELS ( listOfColonSymbolicNames | ASTERISK ) ) ? ( DELETE STATISTICS ) ? ;
 
@@ -24,8 +24,10 @@ lexer grammar MemgraphCypherLexer ;
 import CypherLexer ;
 
 AFTER                   : A F T E R ;
+AGGREGATE               : A G G R E G A T E ;
 ALTER                   : A L T E R ;
 ANALYZE                 : A N A L Y Z E ;
+ARROW                   : A R R O W ;
 ASYNC                   : A S Y N C ;
 AUTH                    : A U T H ;
 BAD                     : B A D ;
@@ -55,8 +57,10 @@ DIRECTORY               : D I R E C T O R Y ;
 DROP                    : D R O P ;
 DUMP                    : D U M P ;
 DURABILITY              : D U R A B I L I T Y ;
+EDGE                    : E D G E ;
 EDGE_TYPES              : E D G E UNDERSCORE T Y P E S ;
 EXECUTE                 : E X E C U T E ;
+EXPORT                  : E X P O R T ;
 FOR                     : F O R ;
 FOREACH                 : F O R E A C H;
 FREE                    : F R E E ;
@@ -89,6 +93,7 @@ NOTHING                 : N O T H I N G ;
 ON_DISK_TRANSACTIONAL   : O N UNDERSCORE D I S K UNDERSCORE T R A N S A C T I O N A L ;
 NULLIF                  : N U L L I F ;
 PASSWORD                : P A S S W O R D ;
+PERIODIC                : P E R I O D I C ;
 PORT                    : P O R T ;
 PRIVILEGES              : P R I V I L E G E S ;
 PULSAR                  : P U L S A R ;
@@ -118,6 +123,7 @@ STREAM                  : S T R E A M ;
 STREAMS                 : S T R E A M S ;
 SYNC                    : S Y N C ;
 TERMINATE               : T E R M I N A T E ;
+TEXT                    : T E X T ;
 TIMEOUT                 : T I M E O U T ;
 TO                      : T O ;
 TOPICS                  : T O P I C S;
@@ -133,5 +139,6 @@ UPDATE                  : U P D A T E ;
 USE                     : U S E ;
 USER                    : U S E R ;
 USERS                   : U S E R S ;
+VECTOR                  : V E C T O R ;
 VERSION                 : V E R S I O N ;
 WEBSOCKET               : W E B S O C K E T ;
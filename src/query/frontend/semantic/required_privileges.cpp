@@ -27,6 +27,12 @@ class PrivilegeExtractor : public QueryVisitor<void>, public HierarchicalTreeVis
 
   void Visit(IndexQuery & /*unused*/) override { AddPrivilege(AuthQuery::Privilege::INDEX); }
 
+  void Visit(EdgeIndexQuery & /*unused*/) override { AddPrivilege(AuthQuery::Privilege::INDEX); }
+
+  void Visit(TextIndexQuery & /*unused*/) override { AddPrivilege(AuthQuery::Privilege::INDEX); }
+  void Visit(VectorIndexQuery & /*unused*/) override { AddPrivilege(AuthQuery::Privilege::INDEX); }
+  void Visit(AggregateIndexQuery & /*unused*/) override { AddPrivilege(AuthQuery::Privilege::INDEX); }
+
   void Visit(AnalyzeGraphQuery & /*unused*/) override { AddPrivilege(AuthQuery::Privilege::INDEX); }
 
   void Visit(AuthQuery & /*unused*/) override { AddPrivilege(AuthQuery::Privilege::AUTH); }
@@ -35,6 +41,12 @@ class PrivilegeExtractor : public QueryVisitor<void>, public HierarchicalTreeVis
 
   void Visit(ProfileQuery &query) override { query.cypher_query_->Accept(dynamic_cast<QueryVisitor &>(*this)); }
 
+  void Visit(ExportQuery &query) override {
+    // The files are written on the server, like LOAD CSV reads them.
+    AddPrivilege(AuthQuery::Privilege::READ_FILE);
+    query.cypher_query_->Accept(dynamic_cast<QueryVisitor &>(*this));
+  }
+
   void Visit(InfoQuery &info_query) override {
     switch (info_query.info_type_) {
       case InfoQuery::InfoType::INDEX:
@@ -153,6 +165,10 @@ class PrivilegeExtractor : public QueryVisitor<void>, public HierarchicalTreeVis
     AddPrivilege(AuthQuery::Privilege::READ_FILE);
     return false;
   }
+  bool PreVisit(LoadArrow & /*unused*/) override {
+    AddPrivilege(AuthQuery::Privilege::READ_FILE);
+    return false;
+  }
 
   bool Visit(Identifier & /*unused*/) override { return true; }
   bool Visit(PrimitiveLiteral & /*unused*/) override { return true; }
@@ -257,6 +257,16 @@ bool SymbolGenerator::PostVisit(LoadCsv &load_csv) {
   return true;
 }
 
+bool SymbolGenerator::PreVisit(LoadArrow & /*load_arrow*/) { return false; }
+
+bool SymbolGenerator::PostVisit(LoadArrow &load_arrow) {
+  if (HasSymbol(load_arrow.row_var_->name_)) {
+    throw RedeclareVariableError(load_arrow.row_var_->name_);
+  }
+  load_arrow.row_var_->MapTo(CreateSymbol(load_arrow.row_var_->name_, true));
+  return true;
+}
+
 bool SymbolGenerator::PreVisit(Return &ret) {
   auto &scope = scopes_.back();
   scope.in_return = true;
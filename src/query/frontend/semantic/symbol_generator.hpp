@@ -54,6 +54,8 @@ class SymbolGenerator : public HierarchicalTreeVisitor {
   bool PostVisit(CallSubquery & /*unused*/) override;
   bool PreVisit(LoadCsv &) override;
   bool PostVisit(LoadCsv &) override;
+  bool PreVisit(LoadArrow &) override;
+  bool PostVisit(LoadArrow &) override;
   bool PreVisit(Return &) override;
   bool PostVisit(Return &) override;
   bool PreVisit(With &) override;
@@ -11,11 +11,13 @@
 
 #include "query/frontend/stripped.hpp"
 
+#include <array>
 #include <cctype>
 #include <cstdint>
 #include <iostream>
 #include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "query/exceptions.hpp"
@@ -32,6 +34,29 @@ namespace memgraph::query::frontend {
 
 using namespace lexer_constants;
 
+namespace {
+
+// Tokens which can start with an ASCII character. Only the matchers of those
+// tokens are run for the character because all of the other matchers would
+// return 0. Characters of the OTHER class (special tokens, comments and
+// non-ASCII characters) run all of the matchers.
+enum class FirstCharClass : uint8_t { OTHER, WORD, DIGIT, QUOTE, BACKTICK, SPACE };
+
+constexpr auto kFirstCharClasses = [] {
+  std::array<FirstCharClass, 256> classes{};
+  for (int c = 'a'; c <= 'z'; ++c) classes[c] = FirstCharClass::WORD;
+  for (int c = 'A'; c <= 'Z'; ++c) classes[c] = FirstCharClass::WORD;
+  classes['_'] = FirstCharClass::WORD;
+  for (int c = '0'; c <= '9'; ++c) classes[c] = FirstCharClass::DIGIT;
+  classes['"'] = FirstCharClass::QUOTE;
+  classes['\''] = FirstCharClass::QUOTE;
+  classes['`'] = FirstCharClass::BACKTICK;
+  for (char c : {' ', '\t', '\n', '\v', '\f', '\r'}) classes[static_cast<unsigned char>(c)] = FirstCharClass::SPACE;
+  return classes;
+}();
+
+}  // namespace
+
 StrippedQuery::StrippedQuery(const std::string &query) : original_(query) {
   enum class Token {
     UNMATCHED,
@@ -46,30 +71,56 @@ StrippedQuery::StrippedQuery(const std::string &query) : original_(query) {
     SPACE
   };
 
-  std::vector<std::pair<Token, std::string>> tokens;
+  // Tokens are views into `original_`, which outlives them.
+  std::vector<std::pair<Token, std::string_view>> tokens;
+  const std::string_view original_view = original_;
   std::string unstripped_chunk;
   for (int i = 0; i < static_cast<int>(original_.size());) {
     Token token = Token::UNMATCHED;
     int len = 0;
+    // The longest match wins, the first matcher wins a tie.
     auto update = [&](int new_len, Token new_token) {
       if (new_len > len) {
         len = new_len;
         token = new_token;
       }
     };
-    update(MatchKeyword(i), Token::KEYWORD);
-    update(MatchSpecial(i), Token::SPECIAL);
-    update(MatchString(i), Token::STRING);
-    update(MatchDecimalInt(i), Token::INT);
-    update(MatchOctalInt(i), Token::INT);
-    update(MatchHexadecimalInt(i), Token::INT);
-    update(MatchReal(i), Token::REAL);
-    update(MatchParameter(i), Token::PARAMETER);
-    update(MatchEscapedName(i), Token::ESCAPED_NAME);
-    update(MatchUnescapedName(i), Token::UNESCAPED_NAME);
-    update(MatchWhitespaceAndComments(i), Token::SPACE);
+    switch (kFirstCharClasses[static_cast<unsigned char>(original_[i])]) {
+      case FirstCharClass::WORD:
+        update(MatchKeyword(i), Token::KEYWORD);
+        update(MatchUnescapedName(i), Token::UNESCAPED_NAME);
+        break;
+      case FirstCharClass::DIGIT:
+        update(MatchDecimalInt(i), Token::INT);
+        update(MatchOctalInt(i), Token::INT);
+        update(MatchHexadecimalInt(i), Token::INT);
+        update(MatchReal(i), Token::REAL);
+        break;
+      case FirstCharClass::QUOTE:
+        update(MatchString(i), Token::STRING);
+        break;
+      case FirstCharClass::BACKTICK:
+        update(MatchEscapedName(i), Token::ESCAPED_NAME);
+        break;
+      case FirstCharClass::SPACE:
+        update(MatchWhitespaceAndComments(i), Token::SPACE);
+        break;
+      case FirstCharClass::OTHER:
+        update(MatchKeyword(i), Token::KEYWORD);
+        update(MatchSpecial(i), Token::SPECIAL);
+        update(MatchString(i), Token::STRING);
+        update(MatchDecimalInt(i), Token::INT);
+        update(MatchOctalInt(i), Token::INT);
+        update(MatchHexadecimalInt(i), Token::INT);
+        update(MatchReal(i), Token::REAL);
+        update(MatchParameter(i), Token::PARAMETER);
+        update(MatchEscapedName(i), Token::ESCAPED_NAME);
+        update(MatchUnescapedName(i), Token::UNESCAPED_NAME);
+        update(MatchWhitespaceAndComments(i), Token::SPACE);
+        break;
+    }
     if (token == Token::UNMATCHED) throw LexingException("Invalid query.");
-    tokens.emplace_back(token, original_.substr(i, len));
+    tokens.emplace_back(token, original_view.substr(i, len));
     i += len;
 
     // If we notice execute, we possibly create a trigger which has defined statements.
@@ -94,7 +145,9 @@ StrippedQuery::StrippedQuery(const std::string &query) : original_(query) {
     }
   }
 
-  std::vector<std::string> token_strings;
+  // Views into the tokens, the stripped replacements and `unstripped_chunk`.
+  std::vector<std::string_view> token_strings;
+  token_strings.reserve(tokens.size() + 1);
   // A helper function that stores literal and its token position in a
   // literals_. In stripped query text literal is replaced with a new_value.
   // new_value can be any value that is lexed as a literal.
@@ -103,9 +156,6 @@ StrippedQuery::StrippedQuery(const std::string &query) : original_(query) {
     token_strings.push_back(new_value);
   };
 
-  // Copy original tokens because we need to use original case in named
-  // expressions and keywords in tokens will be lowercased in the next loop.
-  auto original_tokens = tokens;
   // For every token in original query remember token index in stripped query.
   std::vector<int> position_mapping(tokens.size(), -1);
 
@@ -134,13 +184,13 @@ StrippedQuery::StrippedQuery(const std::string &query) : original_(query) {
       case Token::SPACE:
         break;
       case Token::STRING:
-        replace_stripped(token_index, ParseStringLiteral(token.second), kStrippedStringToken);
+        replace_stripped(token_index, ParseStringLiteral(std::string(token.second)), kStrippedStringToken);
         break;
       case Token::INT:
-        replace_stripped(token_index, ParseIntegerLiteral(token.second), kStrippedIntToken);
+        replace_stripped(token_index, ParseIntegerLiteral(std::string(token.second)), kStrippedIntToken);
         break;
       case Token::REAL:
-        replace_stripped(token_index, ParseDoubleLiteral(token.second), kStrippedDoubleToken);
+        replace_stripped(token_index, ParseDoubleLiteral(std::string(token.second)), kStrippedDoubleToken);
         break;
       case Token::SPECIAL:
       case Token::ESCAPED_NAME:
@@ -148,7 +198,7 @@ StrippedQuery::StrippedQuery(const std::string &query) : original_(query) {
         token_strings.push_back(token.second);
         break;
       case Token::PARAMETER:
-        parameters_[token_index] = ParseParameter(token.second);
+        parameters_[token_index] = ParseParameter(std::string(token.second));
         token_strings.push_back(token.second);
         break;
     }
@@ -159,17 +209,17 @@ StrippedQuery::StrippedQuery(const std::string &query) : original_(query) {
   }
 
   if (!unstripped_chunk.empty()) {
-    token_strings.push_back(std::move(unstripped_chunk));
+    token_strings.push_back(unstripped_chunk);
   }
 
-  query_ = utils::Join(token_strings, " ");
+  utils::Join(&query_, token_strings, " ");
   hash_ = utils::Fnv(query_);
 
   auto it = tokens.begin();
   while (it != tokens.end()) {
     // Store nonaliased named expressions in returns in named_exprs_.
     it = std::find_if(it, tokens.end(),
-                      [](const std::pair<Token, std::string> &a) { return utils::IEquals(a.second, "return"); });
+                      [](const std::pair<Token, std::string_view> &a) { return utils::IEquals(a.second, "return"); });
     // There is no RETURN so there is nothing to do here.
     if (it == tokens.end()) return;
     // Skip RETURN;
@@ -233,9 +283,7 @@ StrippedQuery::StrippedQuery(const std::string &query) : original_(query) {
         // Named expression is not aliased. Save string disregarding leading and
         // trailing whitespaces.
         std::string s;
-        auto begin_token = it - tokens.begin() + original_tokens.begin();
-        auto end_token = last_non_space - tokens.begin() + original_tokens.begin() + 1;
-        for (auto kt = begin_token; kt != end_token; ++kt) {
+        for (auto kt = it; kt != last_non_space + 1; ++kt) {
           s += kt->second;
         }
         named_exprs_[position_mapping[it - tokens.begin()]] = s;
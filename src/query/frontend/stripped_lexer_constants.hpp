@@ -176,6 +176,10 @@ const trie::Trie kKeywords = {"union",
                               "after",
                               "before",
                               "execute",
+                              "execution",
+                              "parallel",
+                              "using",
+                              "periodic",
                               "transaction",
                               "trigger",
                               "triggers",
@@ -211,7 +215,11 @@ const trie::Trie kKeywords = {"union",
                               "websocket",
                               "foreach",
                               "labels",
+                              "edge",
                               "edge_types",
+                              "text",
+                              "vector",
+                              "aggregate",
                               "off",
                               "in_memory_transactional",
                               "in_memory_analytical",
@@ -0,0 +1,429 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/interpret/compiled_expression.hpp"
+
+#include <numeric>
+#include <optional>
+
+#include "query/exceptions.hpp"
+#include "query/interpret/kernels.hpp"
+#include "utils/logging.hpp"
+
+namespace memgraph::query {
+
+CompiledExpression::CompiledExpression(Expression *expression, const SymbolTable &symbol_table,
+                                       const EvaluationContext &ctx) {
+  result_ = Compile(expression, symbol_table, ctx);
+  registers_.reserve(program_.size());
+  for (size_t i = 0; i < program_.size(); ++i) registers_.emplace_back(ctx.memory);
+  if (!CollectColumnPredicates(expression, symbol_table, ctx)) column_predicates_.clear();
+}
+
+uint32_t CompiledExpression::Emit(Instruction instruction) {
+  instruction.result = static_cast<uint32_t>(program_.size());
+  program_.push_back(instruction);
+  return instruction.result;
+}
+
+CompiledExpression::Operand CompiledExpression::Compile(Expression *expression, const SymbolTable &symbol_table,
+                                                        const EvaluationContext &ctx) {
+  auto binary = [&](OpCode op) {
+    auto *binary_operator = static_cast<BinaryOperator *>(expression);
+    const auto lhs = Compile(binary_operator->expression1_, symbol_table, ctx);
+    const auto rhs = Compile(binary_operator->expression2_, symbol_table, ctx);
+    return Operand{Operand::Kind::REGISTER, Emit({.op = op, .result = 0, .lhs = lhs, .rhs = rhs})};
+  };
+  auto unary = [&](OpCode op) {
+    auto *unary_operator = static_cast<UnaryOperator *>(expression);
+    const auto operand = Compile(unary_operator->expression_, symbol_table, ctx);
+    return Operand{Operand::Kind::REGISTER, Emit({.op = op, .result = 0, .lhs = operand})};
+  };
+  auto constant = [&](TypedValue value) {
+    constants_.emplace_back(std::move(value));
+    return Operand{Operand::Kind::CONSTANT, static_cast<uint32_t>(constants_.size() - 1)};
+  };
+
+  switch (expression->GetTypeInfo().id) {
+    case utils::TypeId::AST_IDENTIFIER:
+      return {Operand::Kind::FRAME,
+              static_cast<uint32_t>(symbol_table.at(*static_cast<Identifier *>(expression)).position())};
+    case utils::TypeId::AST_PRIMITIVE_LITERAL:
+      return constant(TypedValue(static_cast<PrimitiveLiteral *>(expression)->value_, ctx.memory));
+    case utils::TypeId::AST_PARAMETER_LOOKUP:
+      return constant(TypedValue(
+          ctx.parameters.AtTokenPosition(static_cast<ParameterLookup *>(expression)->token_position_), ctx.memory));
+    case utils::TypeId::AST_OR_OPERATOR:
+      return binary(OpCode::OR);
+    case utils::TypeId::AST_XOR_OPERATOR:
+      return binary(OpCode::XOR);
+    case utils::TypeId::AST_AND_OPERATOR: {
+      auto *and_operator = static_cast<AndOperator *>(expression);
+      const auto lhs = Compile(and_operator->expression1_, symbol_table, ctx);
+      // Both the jump and AND write to the same register, so that it holds the
+      // result whichever of them was executed.
+      const auto jump = Emit({.op = OpCode::JUMP_IF_FALSE, .result = 0, .lhs = lhs});
+      const auto rhs = Compile(and_operator->expression2_, symbol_table, ctx);
+      program_.push_back({.op = OpCode::AND, .result = jump, .lhs = lhs, .rhs = rhs});
+      program_[jump].jump = static_cast<uint32_t>(program_.size());
+      return {Operand::Kind::REGISTER, jump};
+    }
+    case utils::TypeId::AST_ADDITION_OPERATOR:
+      return binary(OpCode::ADD);
+    case utils::TypeId::AST_SUBTRACTION_OPERATOR:
+      return binary(OpCode::SUBTRACT);
+    case utils::TypeId::AST_MULTIPLICATION_OPERATOR:
+      return binary(OpCode::MULTIPLY);
+    case utils::TypeId::AST_DIVISION_OPERATOR:
+      return binary(OpCode::DIVIDE);
+    case utils::TypeId::AST_MOD_OPERATOR:
+      return binary(OpCode::MOD);
+    case utils::TypeId::AST_NOT_EQUAL_OPERATOR:
+      return binary(OpCode::NOT_EQUAL);
+    case utils::TypeId::AST_EQUAL_OPERATOR:
+      return binary(OpCode::EQUAL);
+    case utils::TypeId::AST_LESS_OPERATOR:
+      return binary(OpCode::LESS);
+    case utils::TypeId::AST_GREATER_OPERATOR:
+      return binary(OpCode::GREATER);
+    case utils::TypeId::AST_LESS_EQUAL_OPERATOR:
+      return binary(OpCode::LESS_EQUAL);
+    case utils::TypeId::AST_GREATER_EQUAL_OPERATOR:
+      return binary(OpCode::GREATER_EQUAL);
+    case utils::TypeId::AST_NOT_OPERATOR:
+      return unary(OpCode::NOT);
+    case utils::TypeId::AST_UNARY_PLUS_OPERATOR:
+      return unary(OpCode::UNARY_PLUS);
+    case utils::TypeId::AST_UNARY_MINUS_OPERATOR:
+      return unary(OpCode::UNARY_MINUS);
+    case utils::TypeId::AST_IS_NULL_OPERATOR:
+      return unary(OpCode::IS_NULL);
+    case utils::TypeId::AST_PROPERTY_LOOKUP: {
+      auto *lookup = static_cast<PropertyLookup *>(expression);
+      const auto operand = Compile(lookup->expression_, symbol_table, ctx);
+      return {Operand::Kind::REGISTER,
+              Emit({.op = OpCode::PROPERTY_LOOKUP, .result = 0, .lhs = operand, .expression = lookup})};
+    }
+    default:
+      return {Operand::Kind::REGISTER, Emit({.op = OpCode::EVALUATE, .result = 0, .expression = expression})};
+  }
+}
+
+const char *CompiledExpression::CypherOperator(OpCode op) {
+  switch (op) {
+    case OpCode::OR:
+      return "OR";
+    case OpCode::XOR:
+      return "XOR";
+    case OpCode::ADD:
+    case OpCode::UNARY_PLUS:
+      return "+";
+    case OpCode::SUBTRACT:
+    case OpCode::UNARY_MINUS:
+      return "-";
+    case OpCode::MULTIPLY:
+      return "*";
+    case OpCode::DIVIDE:
+      return "/";
+    case OpCode::MOD:
+      return "%";
+    case OpCode::NOT_EQUAL:
+      return "<>";
+    case OpCode::EQUAL:
+      return "=";
+    case OpCode::LESS:
+      return "<";
+    case OpCode::GREATER:
+      return ">";
+    case OpCode::LESS_EQUAL:
+      return "<=";
+    case OpCode::GREATER_EQUAL:
+      return ">=";
+    case OpCode::NOT:
+      return "NOT";
+    default:
+      return "";
+  }
+}
+
+TypedValue CompiledExpression::ApplyBinary(OpCode op, const TypedValue &lhs, const TypedValue &rhs) {
+  try {
+    switch (op) {
+      case OpCode::OR:
+        return lhs || rhs;
+      case OpCode::XOR:
+        return lhs ^ rhs;
+      case OpCode::AND:
+        return lhs && rhs;
+      case OpCode::ADD:
+        return lhs + rhs;
+      case OpCode::SUBTRACT:
+        return lhs - rhs;
+      case OpCode::MULTIPLY:
+        return lhs * rhs;
+      case OpCode::DIVIDE:
+        return lhs / rhs;
+      case OpCode::MOD:
+        return lhs % rhs;
+      case OpCode::NOT_EQUAL:
+        return lhs != rhs;
+      case OpCode::EQUAL:
+        return lhs == rhs;
+      case OpCode::LESS:
+        return lhs < rhs;
+      case OpCode::GREATER:
+        return lhs > rhs;
+      case OpCode::LESS_EQUAL:
+        return lhs <= rhs;
+      case OpCode::GREATER_EQUAL:
+        return lhs >= rhs;
+      default:
+        LOG_FATAL("Invalid instruction of a compiled expression");
+    }
+  } catch (const TypedValueException &) {
+    if (op == OpCode::AND) {
+      throw QueryRuntimeException("Invalid types: {} and {} for AND.", lhs.type(), rhs.type());
+    }
+    throw QueryRuntimeException("Invalid types: {} and {} for '{}'.", lhs.type(), rhs.type(), CypherOperator(op));
+  }
+}
+
+const TypedValue &CompiledExpression::Get(const Operand &operand, const Frame &frame) const {
+  switch (operand.kind) {
+    case Operand::Kind::REGISTER:
+      return registers_[operand.index];
+    case Operand::Kind::FRAME:
+      return frame.elems()[operand.index];
+    case Operand::Kind::CONSTANT:
+      return constants_[operand.index];
+  }
+  LOG_FATAL("Invalid operand of a compiled expression");
+}
+
+void CompiledExpression::Execute(Frame &frame, ExpressionEvaluator &evaluator) {
+  for (size_t pc = 0; pc < program_.size(); ++pc) {
+    const auto &instruction = program_[pc];
+    auto &result = registers_[instruction.result];
+    switch (instruction.op) {
+      case OpCode::JUMP_IF_FALSE: {
+        const auto &value = Get(instruction.lhs, frame);
+        if (value.IsBool() && !value.ValueBool()) {
+          result = value;
+          pc = instruction.jump - 1;
+        }
+        continue;
+      }
+      case OpCode::EVALUATE:
+        result = instruction.expression->Accept(evaluator);
+        continue;
+      case OpCode::PROPERTY_LOOKUP:
+        result = evaluator.LookupProperty(Get(instruction.lhs, frame),
+                                          static_cast<PropertyLookup *>(instruction.expression)->property_);
+        continue;
+      case OpCode::IS_NULL:
+        result = TypedValue(Get(instruction.lhs, frame).IsNull(), evaluator.GetMemoryResource());
+        continue;
+      case OpCode::NOT:
+      case OpCode::UNARY_PLUS:
+      case OpCode::UNARY_MINUS: {
+        const auto &value = Get(instruction.lhs, frame);
+        try {
+          if (instruction.op == OpCode::NOT) {
+            result = !value;
+          } else if (instruction.op == OpCode::UNARY_PLUS) {
+            result = +value;
+          } else {
+            result = -value;
+          }
+        } catch (const TypedValueException &) {
+          throw QueryRuntimeException("Invalid type {} for '{}'.", value.type(), CypherOperator(instruction.op));
+        }
+        continue;
+      }
+      default:
+        break;
+    }
+
+    result = ApplyBinary(instruction.op, Get(instruction.lhs, frame), Get(instruction.rhs, frame));
+  }
+}
+
+TypedValue CompiledExpression::Evaluate(Frame &frame, ExpressionEvaluator &evaluator) {
+  Execute(frame, evaluator);
+  if (result_.kind == Operand::Kind::REGISTER) {
+    return TypedValue(std::move(registers_[result_.index]), evaluator.GetMemoryResource());
+  }
+  return TypedValue(Get(result_, frame), evaluator.GetMemoryResource());
+}
+
+bool CompiledExpression::EvaluateFilter(Frame &frame, ExpressionEvaluator &evaluator) {
+  Execute(frame, evaluator);
+  const auto &result = Get(result_, frame);
+  // Null is treated like false.
+  if (result.IsNull()) return false;
+  if (result.type() != TypedValue::Type::Bool) {
+    throw QueryRuntimeException("Filter expression must evaluate to bool or null, got {}.", result.type());
+  }
+  return result.ValueBool();
+}
+
+bool CompiledExpression::CollectColumnPredicates(Expression *expression, const SymbolTable &symbol_table,
+                                                 const EvaluationContext &ctx) {
+  if (expression->GetTypeInfo().id == utils::TypeId::AST_AND_OPERATOR) {
+    auto *and_operator = static_cast<AndOperator *>(expression);
+    // The comparisons are collected from left to right, which is the order in
+    // which AND evaluates them.
+    return CollectColumnPredicates(and_operator->expression1_, symbol_table, ctx) &&
+           CollectColumnPredicates(and_operator->expression2_, symbol_table, ctx);
+  }
+
+  OpCode op{};
+  switch (expression->GetTypeInfo().id) {
+    case utils::TypeId::AST_LESS_OPERATOR:
+      op = OpCode::LESS;
+      break;
+    case utils::TypeId::AST_GREATER_OPERATOR:
+      op = OpCode::GREATER;
+      break;
+    case utils::TypeId::AST_LESS_EQUAL_OPERATOR:
+      op = OpCode::LESS_EQUAL;
+      break;
+    case utils::TypeId::AST_GREATER_EQUAL_OPERATOR:
+      op = OpCode::GREATER_EQUAL;
+      break;
+    case utils::TypeId::AST_EQUAL_OPERATOR:
+      op = OpCode::EQUAL;
+      break;
+    case utils::TypeId::AST_NOT_EQUAL_OPERATOR:
+      op = OpCode::NOT_EQUAL;
+      break;
+    default:
+      return false;
+  }
+
+  auto *comparison = static_cast<BinaryOperator *>(expression);
+  auto *value = comparison->expression1_;
+  auto *constant = comparison->expression2_;
+  const bool constant_on_left = constant->GetTypeInfo().id == utils::TypeId::AST_IDENTIFIER ||
+                                constant->GetTypeInfo().id == utils::TypeId::AST_PROPERTY_LOOKUP;
+  if (constant_on_left) std::swap(value, constant);
+
+  std::optional<TypedValue> constant_value;
+  if (constant->GetTypeInfo().id == utils::TypeId::AST_PRIMITIVE_LITERAL) {
+    constant_value.emplace(static_cast<PrimitiveLiteral *>(constant)->value_, ctx.memory);
+  } else if (constant->GetTypeInfo().id == utils::TypeId::AST_PARAMETER_LOOKUP) {
+    constant_value.emplace(
+        ctx.parameters.AtTokenPosition(static_cast<ParameterLookup *>(constant)->token_position_), ctx.memory);
+  }
+  if (!constant_value || !constant_value->IsInt()) return false;
+
+  const PropertyLookup *lookup = nullptr;
+  if (value->GetTypeInfo().id == utils::TypeId::AST_PROPERTY_LOOKUP) {
+    lookup = static_cast<PropertyLookup *>(value);
+    value = lookup->expression_;
+  }
+  if (value->GetTypeInfo().id != utils::TypeId::AST_IDENTIFIER) return false;
+
+  column_predicates_.push_back({.op = op,
+                                .constant_on_left = constant_on_left,
+                                .position = static_cast<uint32_t>(
+                                    symbol_table.at(*static_cast<Identifier *>(value)).position()),
+                                .lookup = lookup,
+                                .constant = std::move(*constant_value)});
+  return true;
+}
+
+void CompiledExpression::FilterBatch(FrameBatch &batch, ExpressionEvaluator &evaluator) {
+  DMG_ASSERT(CanFilterBatch(), "The expression can't filter a batch");
+  // The rows for which none of the comparisons evaluated so far was false,
+  // and whether any of them was null for the row.
+  std::vector<uint32_t> rows(batch.size());
+  std::iota(rows.begin(), rows.end(), 0);
+  std::vector<uint8_t> is_null(batch.size(), 0);
+
+  for (const auto &predicate : column_predicates_) {
+    if (rows.empty()) break;
+    column_.ints.assign(rows.size(), 0);
+    column_.is_int.assign(rows.size(), 0);
+    column_.others.resize(rows.size());
+    column_.results.resize(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+      const auto &slot = batch[rows[i]].elems()[predicate.position];
+      auto &other = column_.others[i];
+      if (predicate.lookup) {
+        other = evaluator.LookupProperty(slot, predicate.lookup->property_);
+      } else if (slot.IsInt()) {
+        other = TypedValue();
+        column_.ints[i] = slot.ValueInt();
+        column_.is_int[i] = 1;
+        continue;
+      } else {
+        other = slot;
+      }
+      if (other.IsInt()) {
+        column_.ints[i] = other.ValueInt();
+        column_.is_int[i] = 1;
+      }
+    }
+
+    kernels::Comparison comparison{};
+    switch (predicate.op) {
+      case OpCode::LESS:
+        comparison = kernels::Comparison::LESS;
+        break;
+      case OpCode::GREATER:
+        comparison = kernels::Comparison::GREATER;
+        break;
+      case OpCode::LESS_EQUAL:
+        comparison = kernels::Comparison::LESS_EQUAL;
+        break;
+      case OpCode::GREATER_EQUAL:
+        comparison = kernels::Comparison::GREATER_EQUAL;
+        break;
+      case OpCode::EQUAL:
+        comparison = kernels::Comparison::EQUAL;
+        break;
+      case OpCode::NOT_EQUAL:
+        comparison = kernels::Comparison::NOT_EQUAL;
+        break;
+      default:
+        LOG_FATAL("Invalid comparison of a compiled expression");
+    }
+    kernels::Compare(comparison, column_.ints.data(), rows.size(), predicate.constant.ValueInt(),
+                     predicate.constant_on_left, column_.results.data());
+
+    // The values which aren't integers are compared like the evaluator
+    // compares them, which also raises the same errors.
+    size_t remaining = 0;
+    for (size_t i = 0; i < rows.size(); ++i) {
+      if (!column_.is_int[i]) {
+        const auto &other = column_.others[i];
+        const auto result = predicate.constant_on_left ? ApplyBinary(predicate.op, predicate.constant, other)
+                                                       : ApplyBinary(predicate.op, other, predicate.constant);
+        if (result.IsNull()) {
+          is_null[rows[i]] = 1;
+          column_.results[i] = 1;
+        } else {
+          column_.results[i] = result.ValueBool();
+        }
+      }
+      if (column_.results[i]) rows[remaining++] = rows[i];
+    }
+    rows.resize(remaining);
+  }
+
+  std::vector<uint8_t> satisfied(batch.size(), 0);
+  for (const auto row : rows) satisfied[row] = !is_null[row];
+  size_t row = 0;
+  batch.Retain([&](const Frame & /*frame*/) { return satisfied[row++] != 0; });
+}
+
+}  // namespace memgraph::query
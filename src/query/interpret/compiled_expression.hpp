@@ -0,0 +1,146 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "query/context.hpp"
+#include "query/frontend/ast/ast.hpp"
+#include "query/frontend/semantic/symbol_table.hpp"
+#include "query/interpret/eval.hpp"
+#include "query/interpret/frame.hpp"
+#include "query/typed_value.hpp"
+
+namespace memgraph::query {
+
+/// Expression lowered into a flat program over registers, so that operators
+/// evaluating the same expression for every row don't walk the AST each time.
+///
+/// Literals and parameters are resolved into constants when compiling, and
+/// identifiers are read from the frame in place instead of being copied.
+/// Operators, property lookups and `IS NULL` are executed by the program,
+/// while all other expressions are still evaluated by the
+/// `ExpressionEvaluator`, which makes the results the same as when the whole
+/// expression is evaluated by it.
+///
+/// The program is only valid for the execution for which it was compiled,
+/// since the constants depend on the parameters of the query.
+class CompiledExpression {
+ public:
+  CompiledExpression(Expression *expression, const SymbolTable &symbol_table, const EvaluationContext &ctx);
+
+  /// Evaluates the expression on the frame. The evaluator must evaluate on the
+  /// same frame and is used for the expressions which aren't compiled.
+  /// @throw QueryRuntimeException in the same cases as the evaluator.
+  TypedValue Evaluate(Frame &frame, ExpressionEvaluator &evaluator);
+
+  /// Evaluates the expression as a filter, like `EvaluateFilter` does.
+  bool EvaluateFilter(Frame &frame, ExpressionEvaluator &evaluator);
+
+  /// Returns true if `FilterBatch` can evaluate the expression, which must be
+  /// a conjunction of comparisons of symbols or their properties with
+  /// constants, like `n.age > 18 AND n.age < $max`.
+  bool CanFilterBatch() const { return !column_predicates_.empty(); }
+
+  /// Keeps only the rows of the batch which satisfy the expression as a
+  /// filter. The comparisons are evaluated one at a time for all remaining
+  /// rows of the batch, and the integers they compare are gathered into a
+  /// column first, so that the comparison itself is a vectorized loop. The
+  /// evaluator is only used to look up the properties.
+  /// @throw QueryRuntimeException in the same cases as the evaluator.
+  void FilterBatch(FrameBatch &batch, ExpressionEvaluator &evaluator);
+
+  /// Number of instructions in the program.
+  size_t size() const { return program_.size(); }
+
+ private:
+  /// Where an instruction reads its argument from.
+  struct Operand {
+    enum class Kind : uint8_t { REGISTER, FRAME, CONSTANT };
+    Kind kind;
+    uint32_t index;
+  };
+
+  enum class OpCode : uint8_t {
+    OR,
+    XOR,
+    AND,
+    ADD,
+    SUBTRACT,
+    MULTIPLY,
+    DIVIDE,
+    MOD,
+    NOT_EQUAL,
+    EQUAL,
+    LESS,
+    GREATER,
+    LESS_EQUAL,
+    GREATER_EQUAL,
+    NOT,
+    UNARY_PLUS,
+    UNARY_MINUS,
+    IS_NULL,
+    PROPERTY_LOOKUP,
+    // Writes `lhs` to the result and skips to `jump` if it is false, which
+    // short-circuits AND.
+    JUMP_IF_FALSE,
+    // Evaluates `expression` with the `ExpressionEvaluator`.
+    EVALUATE,
+  };
+
+  struct Instruction {
+    OpCode op;
+    uint32_t result;
+    Operand lhs{};
+    Operand rhs{};
+    uint32_t jump{0};
+    Expression *expression{nullptr};
+  };
+
+  /// Comparison `<value> <op> <constant>` evaluated by `FilterBatch`, where
+  /// the value is a symbol or one of its properties.
+  struct ColumnPredicate {
+    OpCode op;
+    bool constant_on_left;
+    uint32_t position;
+    const PropertyLookup *lookup;
+    TypedValue constant;
+  };
+
+  /// Integer values of a predicate for the remaining rows of a batch, with
+  /// the values of all other types kept aside.
+  struct IntColumn {
+    std::vector<int64_t> ints;
+    std::vector<uint8_t> is_int;
+    std::vector<TypedValue> others;
+    std::vector<uint8_t> results;
+  };
+
+  static const char *CypherOperator(OpCode op);
+  static TypedValue ApplyBinary(OpCode op, const TypedValue &lhs, const TypedValue &rhs);
+  bool CollectColumnPredicates(Expression *expression, const SymbolTable &symbol_table, const EvaluationContext &ctx);
+  Operand Compile(Expression *expression, const SymbolTable &symbol_table, const EvaluationContext &ctx);
+  uint32_t Emit(Instruction instruction);
+  void Execute(Frame &frame, ExpressionEvaluator &evaluator);
+  const TypedValue &Get(const Operand &operand, const Frame &frame) const;
+
+  std::vector<Instruction> program_;
+  std::vector<TypedValue> constants_;
+  std::vector<TypedValue> registers_;
+  Operand result_{};
+  std::vector<ColumnPredicate> column_predicates_;
+  IntColumn column_;
+};
+
+}  // namespace memgraph::query
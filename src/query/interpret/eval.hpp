@@ -187,6 +187,9 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
 
   utils::MemoryResource *GetMemoryResource() const { return ctx_->memory; }
 
+  /// Resolves a property name which is only known during the execution.
+  storage::PropertyId NameToProperty(std::string_view name) { return ctx_->property_names.Resolve(name, dba_); }
+
   TypedValue Visit(NamedExpression &named_expression) override {
     const auto &symbol = symbol_table_->at(named_expression);
     auto value = named_expression.expression_->Accept(*this);
@@ -469,6 +472,13 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
       expression_result = property_lookup.expression_->Accept(*this);
       expression_result_ptr = &expression_result;
     }
+    return LookupProperty(*expression_result_ptr, property_lookup.property_);
+  }
+
+  /// Looks up the property of the already evaluated value, like
+  /// `PropertyLookup` does.
+  TypedValue LookupProperty(const TypedValue &value, const PropertyIx &property) {
+    const auto *expression_result_ptr = &value;
     auto maybe_date = [this](const auto &date, const auto &prop_name) -> std::optional<TypedValue> {
       if (prop_name == "year") {
         return TypedValue(date.year, ctx_->memory);
@@ -546,17 +556,17 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
       case TypedValue::Type::Null:
         return TypedValue(ctx_->memory);
       case TypedValue::Type::Vertex:
-        return TypedValue(GetProperty(expression_result_ptr->ValueVertex(), property_lookup.property_), ctx_->memory);
+        return TypedValue(GetProperty(expression_result_ptr->ValueVertex(), property), ctx_->memory);
       case TypedValue::Type::Edge:
-        return TypedValue(GetProperty(expression_result_ptr->ValueEdge(), property_lookup.property_), ctx_->memory);
+        return TypedValue(GetProperty(expression_result_ptr->ValueEdge(), property), ctx_->memory);
       case TypedValue::Type::Map: {
         auto &map = expression_result_ptr->ValueMap();
-        auto found = map.find(property_lookup.property_.name.c_str());
+        auto found = map.find(property.name.c_str());
         if (found == map.end()) return TypedValue(ctx_->memory);
         return TypedValue(found->second, ctx_->memory);
       }
       case TypedValue::Type::Duration: {
-        const auto &prop_name = property_lookup.property_.name;
+        const auto &prop_name = property.name;
         const auto &dur = expression_result_ptr->ValueDuration();
         if (auto dur_field = maybe_duration(dur, prop_name); dur_field) {
           return TypedValue(*dur_field, ctx_->memory);
@@ -564,7 +574,7 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
         throw QueryRuntimeException("Invalid property name {} for Duration", prop_name);
       }
       case TypedValue::Type::Date: {
-        const auto &prop_name = property_lookup.property_.name;
+        const auto &prop_name = property.name;
         const auto &date = expression_result_ptr->ValueDate();
         if (auto date_field = maybe_date(date, prop_name); date_field) {
           return TypedValue(*date_field, ctx_->memory);
@@ -572,7 +582,7 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
         throw QueryRuntimeException("Invalid property name {} for Date", prop_name);
       }
       case TypedValue::Type::LocalTime: {
-        const auto &prop_name = property_lookup.property_.name;
+        const auto &prop_name = property.name;
         const auto &lt = expression_result_ptr->ValueLocalTime();
         if (auto lt_field = maybe_local_time(lt, prop_name); lt_field) {
           return std::move(*lt_field);
@@ -580,7 +590,7 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
         throw QueryRuntimeException("Invalid property name {} for LocalTime", prop_name);
       }
       case TypedValue::Type::LocalDateTime: {
-        const auto &prop_name = property_lookup.property_.name;
+        const auto &prop_name = property.name;
         const auto &ldt = expression_result_ptr->ValueLocalDateTime();
         if (auto date_field = maybe_date(ldt.date, prop_name); date_field) {
           return std::move(*date_field);
@@ -591,7 +601,7 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
         throw QueryRuntimeException("Invalid property name {} for LocalDateTime", prop_name);
       }
       case TypedValue::Type::Graph: {
-        const auto &prop_name = property_lookup.property_.name;
+        const auto &prop_name = property.name;
         const auto &graph = expression_result_ptr->ValueGraph();
         if (auto graph_field = maybe_graph(graph, prop_name); graph_field) {
           return TypedValue(*graph_field, ctx_->memory);
@@ -763,6 +773,10 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
 
     TypedValue::TMap result(ctx_->memory);
     TypedValue::TMap all_properties_lookup(ctx_->memory);
+    // Property selectors like `.name` in `n {.name, .age}` are read from the
+    // vertex or edge together instead of one lookup per property.
+    Identifier *projected = nullptr;
+    std::vector<std::pair<const std::string *, PropertyLookup *>> projected_lookups;
     for (const auto &[property_key, property_value] : literal.elements_) {
       if (property_key.name == kAllPropertiesSelector.data()) {
         auto maybe_all_properties_lookup = property_value->Accept(*this);
@@ -775,8 +789,32 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
         continue;
       }
 
+      if (auto *lookup = utils::Downcast<PropertyLookup>(property_value)) {
+        auto *identifier = utils::Downcast<Identifier>(lookup->expression_);
+        if (identifier && (!projected || identifier->symbol_pos_ == projected->symbol_pos_)) {
+          projected = identifier;
+          projected_lookups.emplace_back(&property_key.name, lookup);
+          continue;
+        }
+      }
+
       result.emplace(property_key.name, property_value->Accept(*this));
     }
+    if (projected) {
+      const auto &value = frame_->at(symbol_table_->at(*projected));
+      std::vector<storage::PropertyId> properties;
+      properties.reserve(projected_lookups.size());
+      for (const auto &[key, lookup] : projected_lookups) properties.push_back(ctx_->properties[lookup->property_.ix]);
+      if (value.IsVertex() || value.IsEdge()) {
+        auto values = value.IsVertex() ? GetProperties(value.ValueVertex(), properties)
+                                       : GetProperties(value.ValueEdge(), properties);
+        for (size_t i = 0; i < projected_lookups.size(); ++i) {
+          result.emplace(*projected_lookups[i].first, TypedValue(std::move(values[i]), ctx_->memory));
+        }
+      } else {
+        for (const auto &[key, lookup] : projected_lookups) result.emplace(*key, lookup->Accept(*this));
+      }
+    }
     if (!all_properties_lookup.empty()) result.merge(all_properties_lookup);
 
     return TypedValue(result, ctx_->memory);
@@ -804,28 +842,11 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
   }
 
   TypedValue Visit(Function &function) override {
-    FunctionContext function_ctx{dba_, ctx_->memory, ctx_->timestamp, &ctx_->counters, view_};
-    // Stack allocate evaluated arguments when there's a small number of them.
-    if (function.arguments_.size() <= 8) {
-      TypedValue arguments[8] = {TypedValue(ctx_->memory), TypedValue(ctx_->memory), TypedValue(ctx_->memory),
-                                 TypedValue(ctx_->memory), TypedValue(ctx_->memory), TypedValue(ctx_->memory),
-                                 TypedValue(ctx_->memory), TypedValue(ctx_->memory)};
-      for (size_t i = 0; i < function.arguments_.size(); ++i) {
-        arguments[i] = function.arguments_[i]->Accept(*this);
-      }
-      auto res = function.function_(arguments, function.arguments_.size(), function_ctx);
-      MG_ASSERT(res.GetMemoryResource() == ctx_->memory);
-      return res;
-    } else {
-      TypedValue::TVector arguments(ctx_->memory);
-      arguments.reserve(function.arguments_.size());
-      for (const auto &argument : function.arguments_) {
-        arguments.emplace_back(argument->Accept(*this));
-      }
-      auto res = function.function_(arguments.data(), arguments.size(), function_ctx);
-      MG_ASSERT(res.GetMemoryResource() == ctx_->memory);
-      return res;
-    }
+    if (!function.is_constant_) return EvaluateFunction(function);
+    if (const auto *value = ctx_->constants.Find(&function)) return TypedValue(*value, ctx_->memory);
+    auto value = EvaluateFunction(function);
+    ctx_->constants.Insert(&function, value);
+    return value;
   }
 
   TypedValue Visit(Reduce &reduce) override {
@@ -1033,14 +1054,38 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
     }
     const auto &target_string = target_string_value.ValueString();
     try {
-      std::regex regex(regex_value.ValueString());
-      return TypedValue(std::regex_match(target_string, regex), ctx_->memory);
+      return TypedValue(ctx_->regexes.Get(regex_value.ValueString()).Match(target_string), ctx_->memory);
     } catch (const std::regex_error &e) {
       throw QueryRuntimeException("Regex error in '{}': {}", regex_value.ValueString(), e.what());
     }
   }
 
  private:
+  TypedValue EvaluateFunction(Function &function) {
+    FunctionContext function_ctx{dba_, ctx_->memory, ctx_->timestamp, &ctx_->counters, view_};
+    // Stack allocate evaluated arguments when there's a small number of them.
+    if (function.arguments_.size() <= 8) {
+      TypedValue arguments[8] = {TypedValue(ctx_->memory), TypedValue(ctx_->memory), TypedValue(ctx_->memory),
+                                 TypedValue(ctx_->memory), TypedValue(ctx_->memory), TypedValue(ctx_->memory),
+                                 TypedValue(ctx_->memory), TypedValue(ctx_->memory)};
+      for (size_t i = 0; i < function.arguments_.size(); ++i) {
+        arguments[i] = function.arguments_[i]->Accept(*this);
+      }
+      auto res = function.function_(arguments, function.arguments_.size(), function_ctx);
+      MG_ASSERT(res.GetMemoryResource() == ctx_->memory);
+      return res;
+    } else {
+      TypedValue::TVector arguments(ctx_->memory);
+      arguments.reserve(function.arguments_.size());
+      for (const auto &argument : function.arguments_) {
+        arguments.emplace_back(argument->Accept(*this));
+      }
+      auto res = function.function_(arguments.data(), arguments.size(), function_ctx);
+      MG_ASSERT(res.GetMemoryResource() == ctx_->memory);
+      return res;
+    }
+  }
+
   template <class TRecordAccessor>
   storage::PropertyValue GetProperty(const TRecordAccessor &record_accessor, PropertyIx prop) {
     auto maybe_prop = record_accessor.GetProperty(view_, ctx_->properties[prop.ix]);
@@ -1068,9 +1113,33 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
     return *maybe_prop;
   }
 
+  template <class TRecordAccessor>
+  std::vector<storage::PropertyValue> GetProperties(const TRecordAccessor &record_accessor,
+                                                    const std::vector<storage::PropertyId> &properties) {
+    auto maybe_props = record_accessor.GetProperties(view_, properties);
+    if (maybe_props.HasError() && maybe_props.GetError() == storage::Error::NONEXISTENT_OBJECT) {
+      // The same hack for MERGE as in GetProperty above.
+      maybe_props = record_accessor.GetProperties(storage::View::NEW, properties);
+    }
+    if (maybe_props.HasError()) {
+      switch (maybe_props.GetError()) {
+        case storage::Error::DELETED_OBJECT:
+          throw QueryRuntimeException("Trying to get a property from a deleted object.");
+        case storage::Error::NONEXISTENT_OBJECT:
+          throw query::QueryRuntimeException("Trying to get a property from an object that doesn't exist.");
+        case storage::Error::SERIALIZATION_ERROR:
+        case storage::Error::VERTEX_HAS_EDGES:
+        case storage::Error::PROPERTIES_DISABLED:
+          throw QueryRuntimeException("Unexpected error when getting a property.");
+      }
+    }
+    return std::move(*maybe_props);
+  }
+
   template <class TRecordAccessor>
   storage::PropertyValue GetProperty(const TRecordAccessor &record_accessor, const std::string_view name) {
-    auto maybe_prop = record_accessor.GetProperty(view_, dba_->NameToProperty(name));
+    const auto property = NameToProperty(name);
+    auto maybe_prop = record_accessor.GetProperty(view_, property);
     if (maybe_prop.HasError() && maybe_prop.GetError() == storage::Error::NONEXISTENT_OBJECT) {
       // This is a very nasty and temporary hack in order to make MERGE work.
       // The old storage had the following logic when returning an `OLD` view:
@@ -1078,7 +1147,7 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
       // exist, it returned the NEW view. With this hack we simulate that
       // behavior.
       // TODO (mferencevic, teon.banek): Remove once MERGE is reimplemented.
-      maybe_prop = record_accessor.GetProperty(view_, dba_->NameToProperty(name));
+      maybe_prop = record_accessor.GetProperty(storage::View::NEW, property);
     }
     if (maybe_prop.HasError()) {
       switch (maybe_prop.GetError()) {
@@ -11,6 +11,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "query/frontend/semantic/symbol_table.hpp"
@@ -35,6 +38,7 @@ class Frame {
   const TypedValue &at(const Symbol &symbol) const { return elems_.at(symbol.position()); }
 
   auto &elems() { return elems_; }
+  const auto &elems() const { return elems_; }
 
   utils::MemoryResource *GetMemoryResource() const { return elems_.get_allocator().GetMemoryResource(); }
 
@@ -42,4 +46,52 @@ class Frame {
   utils::pmr::vector<TypedValue> elems_;
 };
 
+/// A chunk of frames which operators pass between each other when they pull
+/// their input in batches. The frames are allocated once and reused by
+/// consecutive pulls, a row of the batch is valid until the next pull.
+class FrameBatch {
+ public:
+  static constexpr size_t kDefaultCapacity = 256;
+
+  FrameBatch(int64_t frame_size, size_t capacity, utils::MemoryResource *memory) : rows_(memory) {
+    MG_ASSERT(capacity > 0, "FrameBatch must be able to hold at least one frame!");
+    rows_.reserve(capacity);
+    for (size_t i = 0; i < capacity; ++i) rows_.emplace_back(frame_size, memory);
+  }
+
+  size_t size() const { return size_; }
+  size_t capacity() const { return rows_.size(); }
+  bool empty() const { return size_ == 0; }
+  bool full() const { return size_ == rows_.size(); }
+
+  Frame &operator[](size_t row) { return rows_[row]; }
+  const Frame &operator[](size_t row) const { return rows_[row]; }
+
+  /// Appends a copy of `frame` to the batch and returns it.
+  Frame &Append(const Frame &frame) {
+    DMG_ASSERT(!full(), "Appending to a full FrameBatch!");
+    auto &row = rows_[size_++];
+    std::copy(frame.elems().begin(), frame.elems().end(), row.elems().begin());
+    return row;
+  }
+
+  /// Keeps only the rows which satisfy `pred`, preserving their order.
+  template <class TPred>
+  void Retain(TPred &&pred) {
+    size_t retained = 0;
+    for (size_t row = 0; row < size_; ++row) {
+      if (!pred(rows_[row])) continue;
+      if (row != retained) std::swap(rows_[row].elems(), rows_[retained].elems());
+      ++retained;
+    }
+    size_ = retained;
+  }
+
+  void Clear() { size_ = 0; }
+
+ private:
+  utils::pmr::vector<Frame> rows_;
+  size_t size_{0};
+};
+
 }  // namespace memgraph::query
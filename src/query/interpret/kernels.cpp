@@ -0,0 +1,136 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/interpret/kernels.hpp"
+
+#include "utils/logging.hpp"
+
+// The loops are written so that the compiler vectorizes them for each of the
+// targets, which are dispatched through an ifunc resolver.
+#if defined(__x86_64__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define MG_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+#ifndef MG_KERNEL
+#define MG_KERNEL
+#endif
+
+namespace memgraph::query::kernels {
+
+namespace {
+
+// The comparisons are derived from `<` and `==` like the comparison operators
+// of TypedValue are, which matters when comparing NaN.
+template <class T>
+struct Less {
+  bool operator()(T a, T b) const { return a < b; }
+};
+template <class T>
+struct LessEqual {
+  bool operator()(T a, T b) const { return a < b || a == b; }
+};
+template <class T>
+struct Greater {
+  bool operator()(T a, T b) const { return !(a < b || a == b); }
+};
+template <class T>
+struct GreaterEqual {
+  bool operator()(T a, T b) const { return !(a < b); }
+};
+template <class T>
+struct Equal {
+  bool operator()(T a, T b) const { return a == b; }
+};
+template <class T>
+struct NotEqual {
+  bool operator()(T a, T b) const { return !(a == b); }
+};
+
+template <class T, class TCompare>
+inline __attribute__((always_inline)) void CompareLoop(const T *values, size_t size, T constant,
+                                                       bool constant_on_left, uint8_t *out, TCompare compare) {
+  if (constant_on_left) {
+    for (size_t i = 0; i < size; ++i) out[i] = compare(constant, values[i]);
+  } else {
+    for (size_t i = 0; i < size; ++i) out[i] = compare(values[i], constant);
+  }
+}
+
+template <class T>
+inline __attribute__((always_inline)) void CompareValues(Comparison comparison, const T *values, size_t size,
+                                                         T constant, bool constant_on_left, uint8_t *out) {
+  switch (comparison) {
+    case Comparison::LESS:
+      return CompareLoop(values, size, constant, constant_on_left, out, Less<T>{});
+    case Comparison::LESS_EQUAL:
+      return CompareLoop(values, size, constant, constant_on_left, out, LessEqual<T>{});
+    case Comparison::GREATER:
+      return CompareLoop(values, size, constant, constant_on_left, out, Greater<T>{});
+    case Comparison::GREATER_EQUAL:
+      return CompareLoop(values, size, constant, constant_on_left, out, GreaterEqual<T>{});
+    case Comparison::EQUAL:
+      return CompareLoop(values, size, constant, constant_on_left, out, Equal<T>{});
+    case Comparison::NOT_EQUAL:
+      return CompareLoop(values, size, constant, constant_on_left, out, NotEqual<T>{});
+  }
+  LOG_FATAL("Invalid comparison kernel");
+}
+
+}  // namespace
+
+MG_KERNEL void Compare(Comparison comparison, const int64_t *values, size_t size, int64_t constant,
+                       bool constant_on_left, uint8_t *out) {
+  CompareValues(comparison, values, size, constant, constant_on_left, out);
+}
+
+MG_KERNEL void Compare(Comparison comparison, const double *values, size_t size, double constant,
+                       bool constant_on_left, uint8_t *out) {
+  CompareValues(comparison, values, size, constant, constant_on_left, out);
+}
+
+MG_KERNEL int64_t Sum(const int64_t *values, size_t size) {
+  // Unsigned addition wraps around without undefined behavior.
+  uint64_t sum = 0;
+  for (size_t i = 0; i < size; ++i) sum += static_cast<uint64_t>(values[i]);
+  return static_cast<int64_t>(sum);
+}
+
+double Sum(double sum, const double *values, size_t size) {
+  for (size_t i = 0; i < size; ++i) sum += values[i];
+  return sum;
+}
+
+MG_KERNEL int64_t Min(const int64_t *values, size_t size) {
+  DMG_ASSERT(size > 0, "Min of no values");
+  int64_t min = values[0];
+  for (size_t i = 1; i < size; ++i) min = values[i] < min ? values[i] : min;
+  return min;
+}
+
+MG_KERNEL int64_t Max(const int64_t *values, size_t size) {
+  DMG_ASSERT(size > 0, "Max of no values");
+  int64_t max = values[0];
+  for (size_t i = 1; i < size; ++i) max = values[i] > max ? values[i] : max;
+  return max;
+}
+
+MG_KERNEL double Min(double current, const double *values, size_t size) {
+  for (size_t i = 0; i < size; ++i) current = Less<double>{}(values[i], current) ? values[i] : current;
+  return current;
+}
+
+MG_KERNEL double Max(double current, const double *values, size_t size) {
+  for (size_t i = 0; i < size; ++i) current = Greater<double>{}(values[i], current) ? values[i] : current;
+  return current;
+}
+
+}  // namespace memgraph::query::kernels
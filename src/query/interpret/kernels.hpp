@@ -0,0 +1,53 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Loops over columns of integers and doubles which the operators run when
+/// they process their input in batches. On x86-64 each kernel is compiled for
+/// AVX-512, AVX2 and the baseline instruction set, and the best version
+/// supported by the CPU is selected when the program is loaded.
+///
+/// The kernels give the same results as the corresponding operations on
+/// `TypedValue`s, including for NaN and integer overflow. Nulls and values of
+/// other types are handled by the callers.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace memgraph::query::kernels {
+
+enum class Comparison : uint8_t { LESS, LESS_EQUAL, GREATER, GREATER_EQUAL, EQUAL, NOT_EQUAL };
+
+/// Writes `values[i] <comparison> constant` to `out[i]`, or
+/// `constant <comparison> values[i]` if `constant_on_left` is set.
+void Compare(Comparison comparison, const int64_t *values, size_t size, int64_t constant, bool constant_on_left,
+             uint8_t *out);
+void Compare(Comparison comparison, const double *values, size_t size, double constant, bool constant_on_left,
+             uint8_t *out);
+
+/// Returns the sum of the values, which wraps around on overflow.
+int64_t Sum(const int64_t *values, size_t size);
+
+/// Adds the values to `sum` one after another, so that the result is rounded
+/// the same as when adding them one by one.
+double Sum(double sum, const double *values, size_t size);
+
+/// Returns the smallest and the largest of the `size` > 0 values.
+int64_t Min(const int64_t *values, size_t size);
+int64_t Max(const int64_t *values, size_t size);
+
+/// Returns the smallest or the largest of `current` and the values, replacing
+/// the current value like MIN and MAX aggregations do for each value.
+double Min(double current, const double *values, size_t size);
+double Max(double current, const double *values, size_t size);
+
+}  // namespace memgraph::query::kernels
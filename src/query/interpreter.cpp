@@ -15,6 +15,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <charconv>
 #include <chrono>
 #include <concepts>
 #include <cstddef>
@@ -38,6 +39,7 @@
 #include "glue/communication.hpp"
 #include "license/license.hpp"
 #include "memory/memory_control.hpp"
+#include "query/arrow_export.hpp"
 #include "query/constants.hpp"
 #include "query/context.hpp"
 #include "query/cypher_query_interpreter.hpp"
@@ -57,6 +59,8 @@
 #include "query/plan/profile.hpp"
 #include "query/plan/vertex_count_cache.hpp"
 #include "query/procedure/module.hpp"
+#include "query/query_stats.hpp"
+#include "query/result_cache.hpp"
 #include "query/stream.hpp"
 #include "query/stream/common.hpp"
 #include "query/trigger.hpp"
@@ -85,6 +89,7 @@
 #include "utils/readable_size.hpp"
 #include "utils/settings.hpp"
 #include "utils/string.hpp"
+#include "utils/tracepoint.hpp"
 #include "utils/tsc.hpp"
 #include "utils/typeinfo.hpp"
 #include "utils/variant_helpers.hpp"
@@ -92,6 +97,7 @@ namespace memgraph::metrics {
 extern Event ReadQuery;
 extern Event WriteQuery;
 extern Event ReadWriteQuery;
+extern const Event CachedQueryResults;
 
 extern const Event StreamsCreated;
 extern const Event TriggersCreated;
@@ -101,6 +107,7 @@ extern const Event QueryExecutionLatency_us;
 extern const Event CommitedTransactions;
 extern const Event RollbackedTransactions;
 extern const Event ActiveTransactions;
+extern const Event TransactionPeakMemory_bytes;
 }  // namespace memgraph::metrics
 
 namespace memgraph::query {
@@ -109,6 +116,8 @@ template <typename>
 constexpr auto kAlwaysFalse = false;
 
 namespace {
+constexpr std::string_view kBookmarkPrefix{"memgraph:"};
+
 template <typename T, typename K>
 void Sort(std::vector<T, K> &vec) {
   std::sort(vec.begin(), vec.end());
@@ -246,8 +255,8 @@ class ReplQueryHandler final : public query::ReplicationQueryHandler {
 
   /// @throw QueryRuntimeException if an error ocurred.
   void RegisterReplica(const std::string &name, const std::string &socket_address,
-                       const ReplicationQuery::SyncMode sync_mode,
-                       const std::chrono::seconds replica_check_frequency) override {
+                       const ReplicationQuery::SyncMode sync_mode, const std::chrono::seconds replica_check_frequency,
+                       const bool compression) override {
     if (db_->GetReplicationRole() == storage::replication::ReplicationRole::REPLICA) {
       // replica can't register another replica
       throw QueryRuntimeException("Replica can't register another replica!");
@@ -275,7 +284,9 @@ class ReplQueryHandler final : public query::ReplicationQueryHandler {
       auto [ip, port] = *maybe_ip_and_port;
       auto ret = db_->RegisterReplica(name, {std::move(ip), port}, repl_mode,
                                       storage::replication::RegistrationMode::MUST_BE_INSTANTLY_VALID,
-                                      {.replica_check_frequency = replica_check_frequency, .ssl = std::nullopt});
+                                      {.replica_check_frequency = replica_check_frequency,
+                                       .ssl = std::nullopt,
+                                       .compression = compression});
       if (ret.HasError()) {
         throw QueryRuntimeException(fmt::format("Couldn't register replica '{}'!", name));
       }
@@ -686,10 +697,12 @@ Callback HandleReplicationQuery(ReplicationQuery *repl_query, const Parameters &
       const auto &sync_mode = repl_query->sync_mode_;
       auto socket_address = repl_query->socket_address_->Accept(evaluator);
       const auto replica_check_frequency = interpreter_context->config.replication_replica_check_frequency;
+      const auto compression = interpreter_context->config.replication_compression;
 
       callback.fn = [handler = ReplQueryHandler{interpreter_context->db.get()}, name, socket_address, sync_mode,
-                     replica_check_frequency]() mutable {
-        handler.RegisterReplica(name, std::string(socket_address.ValueString()), sync_mode, replica_check_frequency);
+                     replica_check_frequency, compression]() mutable {
+        handler.RegisterReplica(name, std::string(socket_address.ValueString()), sync_mode, replica_check_frequency,
+                                compression);
         return std::vector<std::vector<TypedValue>>();
       };
       notifications->emplace_back(SeverityLevel::INFO, NotificationCode::REGISTER_REPLICA,
@@ -822,13 +835,15 @@ Callback::CallbackFunction GetKafkaCreateCallback(StreamQuery *stream_query, Exp
     std::string bootstrap = bootstrap_servers
                                 ? std::move(*bootstrap_servers)
                                 : std::string{interpreter_context->config.default_kafka_bootstrap_servers};
+    const auto partition_workers = interpreter_context->config.kafka_partition_workers;
     interpreter_context->streams.Create<query::stream::KafkaStream>(stream_name,
                                                                     {.common_info = std::move(common_stream_info),
                                                                      .topics = std::move(topic_names),
                                                                      .consumer_group = std::move(consumer_group),
                                                                      .bootstrap_servers = std::move(bootstrap),
                                                                      .configs = std::move(configs),
-                                                                     .credentials = std::move(credentials)},
+                                                                     .credentials = std::move(credentials),
+                                                                     .partition_workers = partition_workers},
                                                                     std::move(owner));
 
     return std::vector<std::vector<TypedValue>>{};
@@ -1140,6 +1155,27 @@ struct TxTimeout {
   std::optional<std::chrono::duration<double>> value_;
 };
 
+/// Query whose execution is added to `gQueryStats` once all of its results
+/// are pulled.
+struct QueryStatsTarget {
+  std::shared_ptr<const frontend::StrippedQuery> stripped_query;
+  // Tracker of the query's transaction, whose peak is recorded as the memory
+  // of the query.
+  const utils::MemoryTracker *memory_tracker;
+  const InterpreterConfig::Query *config;
+  // Kept so that the plan of the query can be made again at startup, see
+  // `SaveWarmUpQueries`.
+  QueryParameterTypes parameter_types;
+};
+
+/// Read-only query whose results are looked up in the `ResultCache` before it
+/// is executed, and cached once all of them are pulled.
+struct ResultCacheTarget {
+  ResultCache *cache;
+  uint64_t query_hash;
+  storage::GraphFootprint footprint;
+};
+
 struct PullPlan {
   explicit PullPlan(std::shared_ptr<CachedPlan> plan, const Parameters &parameters, bool is_profile_query,
                     DbAccessor *dba, InterpreterContext *interpreter_context, utils::MemoryResource *execution_memory,
@@ -1147,18 +1183,35 @@ struct PullPlan {
                     std::shared_ptr<utils::AsyncTimer> tx_timer,
                     TriggerContextCollector *trigger_context_collector = nullptr,
                     std::optional<size_t> memory_limit = {}, bool use_monotonic_memory = true,
-                    FrameChangeCollector *frame_change_collector_ = nullptr);
+                    FrameChangeCollector *frame_change_collector_ = nullptr, uint64_t parallelism = 1,
+                    std::optional<QueryStatsTarget> stats_target = {},
+                    std::optional<ResultCacheTarget> result_cache_target = {});
 
   std::optional<plan::ProfilingStatsWithTotalTime> Pull(AnyStream *stream, std::optional<int> n,
                                                         const std::vector<Symbol> &output_symbols,
                                                         std::map<std::string, TypedValue> *summary);
 
  private:
+  // Streams the results found in the result cache instead of pulling them.
+  std::optional<plan::ProfilingStatsWithTotalTime> PullCachedResults(AnyStream *stream, std::optional<int> n,
+                                                                     std::map<std::string, TypedValue> *summary);
+
+  // Called once all the results are pulled.
+  plan::ProfilingStatsWithTotalTime Finish(std::map<std::string, TypedValue> *summary);
+
+  // Looks up the results of the query in the result cache, and starts
+  // recording them if they aren't there.
+  void StartResultCaching();
+  void RecordResult(const std::vector<TypedValue> &values);
+
+  void RecordQueryStats(uint64_t execution_time_us, const plan::ProfilingStatsWithTotalTime &profile) const;
+
   std::shared_ptr<CachedPlan> plan_ = nullptr;
   plan::UniqueCursorPtr cursor_ = nullptr;
   Frame frame_;
   ExecutionContext ctx_;
   std::optional<size_t> memory_limit_;
+  utils::MemoryResource *query_memory_;
 
   // As it's possible to query execution using multiple pulls
   // we need the keep track of the total execution time across
@@ -1173,6 +1226,18 @@ struct PullPlan {
   // manually by using this flag.
   bool has_unsent_results_ = false;
 
+  std::optional<QueryStatsTarget> stats_target_;
+  // Number of results streamed across all pulls.
+  uint64_t streamed_results_{0};
+
+  std::optional<ResultCacheTarget> result_cache_target_;
+  // Results found in the cache, which are streamed instead of executing the
+  // plan, and the next of their rows to stream.
+  std::shared_ptr<const CachedResults> cached_results_;
+  size_t next_cached_row_{0};
+  // Results of this execution, until they turn out not to be cacheable.
+  std::optional<CachedResults> recorded_results_;
+
   // In the case of LOAD CSV, we want to use only PoolResource without MonotonicMemoryResource
   // to reuse allocated memory. As LOAD CSV is processing row by row
   // it is possible to reduce memory usage significantly if MemoryResource deals with memory allocation
@@ -1186,11 +1251,15 @@ PullPlan::PullPlan(const std::shared_ptr<CachedPlan> plan, const Parameters &par
                    std::optional<std::string> username, std::atomic<TransactionStatus> *transaction_status,
                    std::shared_ptr<utils::AsyncTimer> tx_timer, TriggerContextCollector *trigger_context_collector,
                    const std::optional<size_t> memory_limit, bool use_monotonic_memory,
-                   FrameChangeCollector *frame_change_collector)
+                   FrameChangeCollector *frame_change_collector, const uint64_t parallelism,
+                   std::optional<QueryStatsTarget> stats_target, std::optional<ResultCacheTarget> result_cache_target)
     : plan_(plan),
       cursor_(plan->plan().MakeCursor(execution_memory)),
       frame_(plan->symbol_table().max_position(), execution_memory),
       memory_limit_(memory_limit),
+      query_memory_(&interpreter_context->query_memory),
+      stats_target_(std::move(stats_target)),
+      result_cache_target_(std::move(result_cache_target)),
       use_monotonic_memory_(use_monotonic_memory) {
   ctx_.db_accessor = dba;
   ctx_.symbol_table = plan->symbol_table();
@@ -1218,18 +1287,62 @@ PullPlan::PullPlan(const std::shared_ptr<CachedPlan> plan, const Parameters &par
   ctx_.is_profile_query = is_profile_query;
   ctx_.trigger_context_collector = trigger_context_collector;
   ctx_.frame_change_collector = frame_change_collector;
+  ctx_.parallelism = parallelism;
+  ctx_.spill_memory_limit = interpreter_context->config.query.spill_memory_limit;
+  ctx_.spill_directory = interpreter_context->config.query.spill_directory;
+  ctx_.procedure_result_buffer_size = interpreter_context->config.query.procedure_result_buffer_size;
+  ctx_.commutative_increments = interpreter_context->config.query.commutative_increments;
+  ctx_.query_id = utils::CurrentQueryId();
+  if (result_cache_target_) StartResultCaching();
+}
+
+void PullPlan::StartResultCaching() {
+#ifdef MG_ENTERPRISE
+  // The results filtered by the fine-grained privileges of a user aren't
+  // shared with the other users.
+  if (ctx_.auth_checker) {
+    result_cache_target_.reset();
+    return;
+  }
+#endif
+  const auto graph_version = ctx_.db_accessor->GraphVersion();
+  if (!graph_version) {
+    result_cache_target_.reset();
+    return;
+  }
+  cached_results_ = result_cache_target_->cache->Find(result_cache_target_->query_hash,
+                                                      ctx_.evaluation_context.parameters, *ctx_.db_accessor);
+  if (cached_results_) {
+    memgraph::metrics::IncrementCounter(memgraph::metrics::CachedQueryResults);
+    return;
+  }
+  recorded_results_.emplace(
+      CachedResults{.graph_version = *graph_version, .footprint = result_cache_target_->footprint});
+}
+
+void PullPlan::RecordResult(const std::vector<TypedValue> &values) {
+  if (recorded_results_->rows.size() >= result_cache_target_->cache->max_rows() ||
+      !std::ranges::all_of(values, IsCacheableValue)) {
+    recorded_results_.reset();
+    return;
+  }
+  auto &row = recorded_results_->rows.emplace_back();
+  row.reserve(values.size());
+  for (const auto &value : values) row.emplace_back(value, utils::NewDeleteResource());
 }
 
 std::optional<plan::ProfilingStatsWithTotalTime> PullPlan::Pull(AnyStream *stream, std::optional<int> n,
                                                                 const std::vector<Symbol> &output_symbols,
                                                                 std::map<std::string, TypedValue> *summary) {
+  if (cached_results_) return PullCachedResults(stream, n, summary);
+
   // Set up temporary memory for a single Pull. Initial memory comes from the
   // stack. 256 KiB should fit on the stack and should be more than enough for a
   // single `Pull`.
   static constexpr size_t stack_size = 256UL * 1024UL;
   char stack_data[stack_size];
 
-  utils::ResourceWithOutOfMemoryException resource_with_exception;
+  utils::ResourceWithOutOfMemoryException resource_with_exception{query_memory_};
   utils::MonotonicBufferResource monotonic_memory{&stack_data[0], stack_size, &resource_with_exception};
   std::optional<utils::PoolResource> pool_memory;
   static constexpr auto kMaxBlockPerChunks = 128;
@@ -1266,6 +1379,7 @@ std::optional<plan::ProfilingStatsWithTotalTime> PullPlan::Pull(AnyStream *strea
       values.emplace_back(frame_[symbol]);
     }
 
+    if (recorded_results_) RecordResult(values);
     stream->Result(values);
   };
 
@@ -1296,14 +1410,37 @@ std::optional<plan::ProfilingStatsWithTotalTime> PullPlan::Pull(AnyStream *strea
   has_unsent_results_ = i == n && pull_result();
 
   execution_time_ += timer.Elapsed();
+  if (!output_symbols.empty()) streamed_results_ += i;
 
   if (has_unsent_results_) {
     return std::nullopt;
   }
 
+  return Finish(summary);
+}
+
+std::optional<plan::ProfilingStatsWithTotalTime> PullPlan::PullCachedResults(
+    AnyStream *stream, std::optional<int> n, std::map<std::string, TypedValue> *summary) {
+  utils::Timer timer;
+  const auto &rows = cached_results_->rows;
+  int i = 0;
+  for (; (!n || i < n) && next_cached_row_ < rows.size(); ++i, ++next_cached_row_) {
+    stream->Result(rows[next_cached_row_]);
+  }
+  execution_time_ += timer.Elapsed();
+  streamed_results_ += i;
+
+  if (next_cached_row_ < rows.size()) {
+    return std::nullopt;
+  }
+
+  return Finish(summary);
+}
+
+plan::ProfilingStatsWithTotalTime PullPlan::Finish(std::map<std::string, TypedValue> *summary) {
   summary->insert_or_assign("plan_execution_time", execution_time_.count());
-  memgraph::metrics::Measure(memgraph::metrics::QueryExecutionLatency_us,
-                             std::chrono::duration_cast<std::chrono::microseconds>(execution_time_).count());
+  const auto execution_time_us = std::chrono::duration_cast<std::chrono::microseconds>(execution_time_).count();
+  memgraph::metrics::Measure(memgraph::metrics::QueryExecutionLatency_us, execution_time_us);
 
   // We are finished with pulling all the data, therefore we can send any
   // metadata about the results i.e. notifications and statistics
@@ -1319,7 +1456,42 @@ std::optional<plan::ProfilingStatsWithTotalTime> PullPlan::Pull(AnyStream *strea
   }
   cursor_->Shutdown();
   ctx_.profile_execution_time = execution_time_;
-  return GetStatsWithTotalTime(ctx_);
+  auto profile = GetStatsWithTotalTime(ctx_);
+  if (stats_target_) RecordQueryStats(execution_time_us, profile);
+  if (recorded_results_) {
+    result_cache_target_->cache->Insert(result_cache_target_->query_hash, ctx_.evaluation_context.parameters,
+                                        std::make_shared<const CachedResults>(std::move(*recorded_results_)));
+    recorded_results_.reset();
+  }
+  return profile;
+}
+
+void PullPlan::RecordQueryStats(const uint64_t execution_time_us,
+                                const plan::ProfilingStatsWithTotalTime &profile) const {
+  const auto &stripped_query = *stats_target_->stripped_query;
+  const auto &config = *stats_target_->config;
+  const QueryExecutionInfo execution{
+      .query_hash = stripped_query.hash(),
+      .plan_hash = plan_->plan_hash(),
+      .time_us = execution_time_us,
+      .rows = streamed_results_,
+      .memory_bytes = static_cast<uint64_t>(std::max<int64_t>(stats_target_->memory_tracker->Peak(), 0))};
+  gQueryStats.Record(stripped_query.query(), execution, config.stats_max_queries, stats_target_->parameter_types);
+
+  const auto threshold_us = std::chrono::duration_cast<std::chrono::microseconds>(config.slow_query_threshold).count();
+  if (threshold_us == 0 || execution_time_us < static_cast<uint64_t>(threshold_us)) return;
+  // The plan is only printed for the slow queries, as it's as expensive as
+  // EXPLAIN.
+  std::stringstream printed_plan;
+  plan::PrettyPrint(*ctx_.db_accessor, &plan_->plan(), &printed_plan);
+  std::optional<std::string> printed_profile;
+  if (ctx_.is_profile_query) printed_profile = plan::ProfilingStatsToJson(profile).dump();
+  gQueryStats.LogSlowQuery(SlowQueryInfo{.timestamp = QueryTimestamp(),
+                                         .query = stripped_query.query(),
+                                         .execution = execution,
+                                         .plan = printed_plan.str(),
+                                         .profile = std::move(printed_profile)},
+                           config.slow_query_log_size);
 }
 
 using RWType = plan::ReadWriteTypeChecker::RWType;
@@ -1352,11 +1524,15 @@ InterpreterContext::InterpreterContext(const storage::Config storage_config, con
       trigger_store(data_directory / "triggers"),
       config(interpreter_config),
       streams{this, data_directory / "streams"} {
+  if (config.query.database_memory_limit != 0) {
+    query_memory_tracker.SetHardLimit(static_cast<int64_t>(config.query.database_memory_limit));
+  }
   if (utils::DirExists(storage_config.disk.main_storage_directory)) {
     db = std::make_unique<storage::DiskStorage>(storage_config);
   } else {
     db = std::make_unique<storage::InMemoryStorage>(storage_config);
   }
+  if (result_cache.IsEnabled()) db->EnableGraphChangeTracking();
 }
 
 InterpreterContext::InterpreterContext(std::unique_ptr<storage::Storage> &&db, InterpreterConfig interpreter_config,
@@ -1367,10 +1543,66 @@ InterpreterContext::InterpreterContext(std::unique_ptr<storage::Storage> &&db, I
       auth_checker(ac),
       trigger_store(data_directory / "triggers"),
       config(interpreter_config),
-      streams{this, data_directory / "streams"} {}
+      streams{this, data_directory / "streams"} {
+  if (config.query.database_memory_limit != 0) {
+    query_memory_tracker.SetHardLimit(static_cast<int64_t>(config.query.database_memory_limit));
+  }
+  if (result_cache.IsEnabled()) this->db->EnableGraphChangeTracking();
+}
 
-Interpreter::Interpreter(InterpreterContext *interpreter_context) : interpreter_context_(interpreter_context) {
+Interpreter::Interpreter(InterpreterContext *interpreter_context)
+    : transaction_memory_tracker_(interpreter_context ? &interpreter_context->query_memory_tracker : nullptr),
+      execution_buffer_cache_(kMinExecutionBufferSize, kMaxExecutionBufferSize,
+                              interpreter_context ? &interpreter_context->query_memory : nullptr),
+      interpreter_context_(interpreter_context) {
   MG_ASSERT(interpreter_context_, "Interpreter context must not be NULL");
+  if (interpreter_context_->config.query.transaction_memory_limit != 0) {
+    transaction_memory_tracker_.SetHardLimit(
+        static_cast<int64_t>(interpreter_context_->config.query.transaction_memory_limit));
+  }
+}
+
+std::string CommitTimestampToBookmark(uint64_t commit_timestamp) {
+  return fmt::format("{}{}", kBookmarkPrefix, commit_timestamp);
+}
+
+std::optional<uint64_t> BookmarkToCommitTimestamp(std::string_view bookmark) {
+  if (!bookmark.starts_with(kBookmarkPrefix)) return std::nullopt;
+  bookmark.remove_prefix(kBookmarkPrefix.size());
+  uint64_t commit_timestamp{0};
+  const auto *end = bookmark.data() + bookmark.size();
+  const auto [ptr, ec] = std::from_chars(bookmark.data(), end, commit_timestamp);
+  if (ec != std::errc{} || ptr != end) return std::nullopt;
+  return commit_timestamp;
+}
+
+void Interpreter::WaitForBookmark(QueryExtras const &extras) {
+  if (!extras.bookmark_timestamp) return;
+  if (!interpreter_context_->db->WaitForCommitTimestamp(*extras.bookmark_timestamp,
+                                                        interpreter_context_->config.bookmark_wait_timeout)) {
+    throw BookmarkWaitTimeoutException(*extras.bookmark_timestamp);
+  }
+}
+
+ParsedQuery Interpreter::ParsePreparedStatement(const std::string &query_string,
+                                                const std::map<std::string, storage::PropertyValue> &params,
+                                                const std::string &statement_id) {
+  auto it = prepared_statements_.find(statement_id);
+  if (!query_string.empty()) {
+    auto statement =
+        PrepareStatement(query_string, &interpreter_context_->ast_cache, interpreter_context_->config.query);
+    if (it != prepared_statements_.end()) {
+      it->second = std::move(statement);
+    } else if (prepared_statements_.size() < kMaxPreparedStatements) {
+      it = prepared_statements_.emplace(statement_id, std::move(statement)).first;
+    } else {
+      throw PreparedStatementException("Unable to prepare more than {} statements in a session.",
+                                       kMaxPreparedStatements);
+    }
+  } else if (it == prepared_statements_.end()) {
+    throw PreparedStatementException("Statement {} isn't prepared.", statement_id);
+  }
+  return BindParameters(it->second.Clone(), params);
 }
 
 auto DetermineTxTimeout(std::optional<int64_t> tx_timeout_ms, InterpreterConfig const &config) -> TxTimeout {
@@ -1400,6 +1632,7 @@ PreparedQuery Interpreter::PrepareTransactionQuery(std::string_view query_upper,
       if (in_explicit_transaction_) {
         throw ExplicitTransactionUsageException("Nested transactions are not supported.");
       }
+      WaitForBookmark(extras);
 
       memgraph::metrics::IncrementCounter(memgraph::metrics::ActiveTransactions);
 
@@ -1416,7 +1649,8 @@ PreparedQuery Interpreter::PrepareTransactionQuery(std::string_view query_upper,
       transaction_status_.store(TransactionStatus::ACTIVE, std::memory_order_release);
 
       if (interpreter_context_->trigger_store.HasTriggers()) {
-        trigger_context_collector_.emplace(interpreter_context_->trigger_store.GetEventTypes());
+        trigger_context_collector_.emplace(interpreter_context_->trigger_store.GetEventTypes(),
+                                           interpreter_context_->trigger_store.GetIdentifierTags());
       }
     };
   } else if (query_upper == "COMMIT") {
@@ -1514,6 +1748,7 @@ PreparedQuery PrepareCypherQuery(ParsedQuery parsed_query, std::map<std::string,
                                  utils::MemoryResource *execution_memory, std::vector<Notification> *notifications,
                                  const std::string *username, std::atomic<TransactionStatus> *transaction_status,
                                  std::shared_ptr<utils::AsyncTimer> tx_timer,
+                                 const utils::MemoryTracker *transaction_memory_tracker,
                                  TriggerContextCollector *trigger_context_collector = nullptr,
                                  FrameChangeCollector *frame_change_collector = nullptr) {
   auto *cypher_query = utils::Downcast<CypherQuery>(parsed_query.query);
@@ -1527,8 +1762,15 @@ PreparedQuery PrepareCypherQuery(ParsedQuery parsed_query, std::map<std::string,
   if (memory_limit) {
     spdlog::info("Running query with memory limit of {}", utils::GetReadableSize(*memory_limit));
   }
+  const auto parallelism =
+      cypher_query->parallel_execution_ ? interpreter_context->config.query.parallel_execution_threads : 1;
   auto clauses = cypher_query->single_query_->clauses_;
   bool contains_csv = false;
+  // LOAD ARROW streams the rows of a file like LOAD CSV, but its values are typed.
+  if (std::any_of(clauses.begin(), clauses.end(),
+                  [](const auto *clause) { return clause->GetTypeInfo() == LoadArrow::kType; })) {
+    contains_csv = true;
+  }
   if (std::any_of(clauses.begin(), clauses.end(),
                   [](const auto *clause) { return clause->GetTypeInfo() == LoadCsv::kType; })) {
     notifications->emplace_back(
@@ -1545,7 +1787,7 @@ PreparedQuery PrepareCypherQuery(ParsedQuery parsed_query, std::map<std::string,
   spdlog::trace("PrepareCypher has {} encountered all shortest paths and will {} use of monotonic memory",
                 IsAllShortestPathsQuery(clauses) ? "" : "not", use_monotonic_memory ? "" : "not");
 
-  auto plan = CypherQueryToPlan(parsed_query.stripped_query.hash(), std::move(parsed_query.ast_storage), cypher_query,
+  auto plan = CypherQueryToPlan(parsed_query.stripped_query->hash(), std::move(parsed_query.ast_storage), cypher_query,
                                 parsed_query.parameters,
                                 parsed_query.is_cacheable ? &interpreter_context->plan_cache : nullptr, dba);
 
@@ -1564,13 +1806,40 @@ PreparedQuery PrepareCypherQuery(ParsedQuery parsed_query, std::map<std::string,
     // WITH), then there is no token position, so use symbol name.
     // Otherwise, find the name from stripped query.
     header.push_back(
-        utils::FindOr(parsed_query.stripped_query.named_expressions(), symbol.token_position(), symbol.name()).first);
+        utils::FindOr(parsed_query.stripped_query->named_expressions(), symbol.token_position(), symbol.name()).first);
+  }
+  // A query whose last slow execution wasn't profiled is profiled, so that
+  // the slow query log shows where it spends its time.
+  const auto &query_config = interpreter_context->config.query;
+  const bool is_profiled = query_config.slow_query_threshold.count() != 0 &&
+                           gQueryStats.TakeProfileRequest(parsed_query.stripped_query->hash());
+  std::optional<QueryStatsTarget> stats_target;
+  if (query_config.stats_max_queries != 0 || query_config.slow_query_threshold.count() != 0) {
+    QueryParameterTypes parameter_types;
+    parameter_types.reserve(parsed_query.user_parameters.size());
+    for (const auto &[name, value] : parsed_query.user_parameters) parameter_types.emplace_back(name, value.type());
+    stats_target.emplace(QueryStatsTarget{.stripped_query = parsed_query.stripped_query,
+                                          .memory_tracker = transaction_memory_tracker,
+                                          .config = &query_config,
+                                          .parameter_types = std::move(parameter_types)});
   }
-  auto pull_plan =
-      std::make_shared<PullPlan>(plan, parsed_query.parameters, false, dba, interpreter_context, execution_memory,
-                                 StringPointerToOptional(username), transaction_status, std::move(tx_timer),
-                                 trigger_context_collector, memory_limit, use_monotonic_memory,
-                                 frame_change_collector->IsTrackingValues() ? frame_change_collector : nullptr);
+  // The results of a query are cached if they only depend on the graph and the
+  // parameters.
+  std::optional<ResultCacheTarget> result_cache_target;
+  if (interpreter_context->result_cache.IsEnabled() && parsed_query.is_cacheable && !is_profiled &&
+      !output_symbols.empty() && rw_type_checker.type == RWType::R &&
+      plan::impl::IsDeterministic(*cypher_query, true)) {
+    if (auto footprint = GetReadFootprint(const_cast<plan::LogicalOperator &>(plan->plan()))) {
+      result_cache_target.emplace(ResultCacheTarget{.cache = &interpreter_context->result_cache,
+                                                    .query_hash = parsed_query.stripped_query->hash(),
+                                                    .footprint = std::move(*footprint)});
+    }
+  }
+  auto pull_plan = std::make_shared<PullPlan>(
+      plan, parsed_query.parameters, is_profiled, dba, interpreter_context, execution_memory,
+      StringPointerToOptional(username), transaction_status, std::move(tx_timer), trigger_context_collector,
+      memory_limit, use_monotonic_memory, frame_change_collector->IsTrackingValues() ? frame_change_collector : nullptr,
+      parallelism, std::move(stats_target), std::move(result_cache_target));
   return PreparedQuery{std::move(header), std::move(parsed_query.required_privileges),
                        [pull_plan = std::move(pull_plan), output_symbols = std::move(output_symbols), summary](
                            AnyStream *stream, std::optional<int> n) -> std::optional<QueryHandlerResult> {
@@ -1586,7 +1855,7 @@ PreparedQuery PrepareExplainQuery(ParsedQuery parsed_query, std::map<std::string
                                   InterpreterContext *interpreter_context, DbAccessor *dba,
                                   utils::MemoryResource *execution_memory) {
   const std::string kExplainQueryStart = "explain ";
-  MG_ASSERT(utils::StartsWith(utils::ToLowerCase(parsed_query.stripped_query.query()), kExplainQueryStart),
+  MG_ASSERT(utils::StartsWith(utils::ToLowerCase(parsed_query.stripped_query->query()), kExplainQueryStart),
             "Expected stripped query to start with '{}'", kExplainQueryStart);
 
   // Parse and cache the inner query separately (as if it was a standalone
@@ -1603,7 +1872,7 @@ PreparedQuery PrepareExplainQuery(ParsedQuery parsed_query, std::map<std::string
   MG_ASSERT(cypher_query, "Cypher grammar should not allow other queries in EXPLAIN");
 
   auto cypher_query_plan = CypherQueryToPlan(
-      parsed_inner_query.stripped_query.hash(), std::move(parsed_inner_query.ast_storage), cypher_query,
+      parsed_inner_query.stripped_query->hash(), std::move(parsed_inner_query.ast_storage), cypher_query,
       parsed_inner_query.parameters, parsed_inner_query.is_cacheable ? &interpreter_context->plan_cache : nullptr, dba);
 
   std::stringstream printed_plan;
@@ -1636,7 +1905,7 @@ PreparedQuery PrepareProfileQuery(ParsedQuery parsed_query, bool in_explicit_tra
                                   FrameChangeCollector *frame_change_collector) {
   const std::string kProfileQueryStart = "profile ";
 
-  MG_ASSERT(utils::StartsWith(utils::ToLowerCase(parsed_query.stripped_query.query()), kProfileQueryStart),
+  MG_ASSERT(utils::StartsWith(utils::ToLowerCase(parsed_query.stripped_query->query()), kProfileQueryStart),
             "Expected stripped query to start with '{}'", kProfileQueryStart);
 
   // PROFILE isn't allowed inside multi-command (explicit) transactions. This is
@@ -1673,8 +1942,9 @@ PreparedQuery PrepareProfileQuery(ParsedQuery parsed_query, bool in_explicit_tra
 
   bool contains_csv = false;
   auto clauses = cypher_query->single_query_->clauses_;
-  if (std::any_of(clauses.begin(), clauses.end(),
-                  [](const auto *clause) { return clause->GetTypeInfo() == LoadCsv::kType; })) {
+  if (std::any_of(clauses.begin(), clauses.end(), [](const auto *clause) {
+        return clause->GetTypeInfo() == LoadCsv::kType || clause->GetTypeInfo() == LoadArrow::kType;
+      })) {
     contains_csv = true;
   }
 
@@ -1689,10 +1959,13 @@ PreparedQuery PrepareProfileQuery(ParsedQuery parsed_query, bool in_explicit_tra
   evaluation_context.parameters = parsed_inner_query.parameters;
   auto evaluator = PrimitiveLiteralExpressionEvaluator{evaluation_context};
   const auto memory_limit = EvaluateMemoryLimit(evaluator, cypher_query->memory_limit_, cypher_query->memory_scale_);
+  const auto parallelism =
+      cypher_query->parallel_execution_ ? interpreter_context->config.query.parallel_execution_threads : 1;
 
-  auto cypher_query_plan = CypherQueryToPlan(
-      parsed_inner_query.stripped_query.hash(), std::move(parsed_inner_query.ast_storage), cypher_query,
-      parsed_inner_query.parameters, parsed_inner_query.is_cacheable ? &interpreter_context->plan_cache : nullptr, dba);
+  const auto hash = parsed_inner_query.stripped_query->hash();
+  auto *plan_cache = parsed_inner_query.is_cacheable ? &interpreter_context->plan_cache : nullptr;
+  auto cypher_query_plan = CypherQueryToPlan(hash, std::move(parsed_inner_query.ast_storage), cypher_query,
+                                             parsed_inner_query.parameters, plan_cache, dba);
   TryCaching(cypher_query_plan->ast_storage(), frame_change_collector);
   auto rw_type_checker = plan::ReadWriteTypeChecker();
   auto optional_username = StringPointerToOptional(username);
@@ -1702,12 +1975,13 @@ PreparedQuery PrepareProfileQuery(ParsedQuery parsed_query, bool in_explicit_tra
   return PreparedQuery{{"OPERATOR", "ACTUAL HITS", "RELATIVE TIME", "ABSOLUTE TIME"},
                        std::move(parsed_query.required_privileges),
                        [plan = std::move(cypher_query_plan), parameters = std::move(parsed_inner_query.parameters),
-                        summary, dba, interpreter_context, execution_memory, memory_limit, optional_username,
+                        hash, plan_cache, summary, dba, interpreter_context, execution_memory, memory_limit,
+                        optional_username,
                         // We want to execute the query we are profiling lazily, so we delay
                         // the construction of the corresponding context.
                         stats_and_total_time = std::optional<plan::ProfilingStatsWithTotalTime>{},
                         pull_plan = std::shared_ptr<PullPlanVector>(nullptr), transaction_status, use_monotonic_memory,
-                        frame_change_collector, tx_timer = std::move(tx_timer)](
+                        frame_change_collector, parallelism, tx_timer = std::move(tx_timer)](
                            AnyStream *stream, std::optional<int> n) mutable -> std::optional<QueryHandlerResult> {
                          // No output symbols are given so that nothing is streamed.
                          if (!stats_and_total_time) {
@@ -1715,8 +1989,12 @@ PreparedQuery PrepareProfileQuery(ParsedQuery parsed_query, bool in_explicit_tra
                                PullPlan(plan, parameters, true, dba, interpreter_context, execution_memory,
                                         optional_username, transaction_status, std::move(tx_timer), nullptr,
                                         memory_limit, use_monotonic_memory,
-                                        frame_change_collector->IsTrackingValues() ? frame_change_collector : nullptr)
+                                        frame_change_collector->IsTrackingValues() ? frame_change_collector : nullptr,
+                                        parallelism)
                                    .Pull(stream, {}, {}, summary);
+                           // The observed cardinalities correct the next plans of the query.
+                           ApplyCardinalityFeedback(hash, *plan, stats_and_total_time->cumulative_stats, parameters,
+                                                    plan_cache, dba);
                            pull_plan = std::make_shared<PullPlanVector>(ProfilingStatsToTable(*stats_and_total_time));
                          }
 
@@ -1732,11 +2010,90 @@ PreparedQuery PrepareProfileQuery(ParsedQuery parsed_query, bool in_explicit_tra
                        rw_type_checker.type};
 }
 
+PreparedQuery PrepareExportQuery(ParsedQuery parsed_query, std::map<std::string, TypedValue> *summary,
+                                 InterpreterContext *interpreter_context, DbAccessor *dba,
+                                 utils::MemoryResource *execution_memory, const std::string *username,
+                                 std::atomic<TransactionStatus> *transaction_status,
+                                 std::shared_ptr<utils::AsyncTimer> tx_timer,
+                                 FrameChangeCollector *frame_change_collector) {
+  auto *export_query = utils::Downcast<ExportQuery>(parsed_query.query);
+  auto *cypher_query = export_query->cypher_query_;
+
+  EvaluationContext evaluation_context;
+  evaluation_context.timestamp = QueryTimestamp();
+  evaluation_context.parameters = parsed_query.parameters;
+  auto evaluator = PrimitiveLiteralExpressionEvaluator{evaluation_context};
+  auto directory = std::string(export_query->directory_->Accept(evaluator).ValueString());
+  const auto memory_limit = EvaluateMemoryLimit(evaluator, cypher_query->memory_limit_, cypher_query->memory_scale_);
+  // The files are written on as many threads as the query is executed on.
+  const auto parallelism =
+      cypher_query->parallel_execution_ ? interpreter_context->config.query.parallel_execution_threads : 1;
+
+  const auto &clauses = cypher_query->single_query_->clauses_;
+  const auto use_monotonic_memory =
+      std::none_of(clauses.begin(), clauses.end(),
+                   [](const auto *clause) {
+                     return clause->GetTypeInfo() == LoadCsv::kType || clause->GetTypeInfo() == LoadArrow::kType;
+                   }) &&
+      !IsCallBatchedProcedureQuery(clauses) && !IsAllShortestPathsQuery(clauses);
+
+  // Unlike EXPLAIN and PROFILE, the inner query isn't parsed again. It's
+  // planned from the AST of the whole query, so its parameters are looked up
+  // at the positions in the whole query.
+  auto plan = CypherQueryToPlan(parsed_query.stripped_query->hash(), std::move(parsed_query.ast_storage), cypher_query,
+                                parsed_query.parameters,
+                                parsed_query.is_cacheable ? &interpreter_context->plan_cache : nullptr, dba);
+  TryCaching(plan->ast_storage(), frame_change_collector);
+  auto rw_type_checker = plan::ReadWriteTypeChecker();
+  rw_type_checker.InferRWType(const_cast<plan::LogicalOperator &>(plan->plan()));
+
+  auto output_symbols = plan->plan().OutputSymbols(plan->symbol_table());
+  std::vector<std::string> columns;
+  columns.reserve(output_symbols.size());
+  for (const auto &symbol : output_symbols) {
+    columns.push_back(
+        utils::FindOr(parsed_query.stripped_query->named_expressions(), symbol.token_position(), symbol.name()).first);
+  }
+
+  auto pull_plan = std::make_shared<PullPlan>(
+      plan, parsed_query.parameters, false, dba, interpreter_context, execution_memory,
+      StringPointerToOptional(username), transaction_status, std::move(tx_timer), nullptr, memory_limit,
+      use_monotonic_memory,
+      frame_change_collector->IsTrackingValues() ? frame_change_collector : nullptr, parallelism);
+  return PreparedQuery{{"file", "rows"},
+                       std::move(parsed_query.required_privileges),
+                       [pull_plan = std::move(pull_plan), output_symbols = std::move(output_symbols),
+                        columns = std::move(columns), directory = std::move(directory), parallelism, summary,
+                        files = std::shared_ptr<PullPlanVector>(nullptr)](
+                           AnyStream *stream, std::optional<int> n) mutable -> std::optional<QueryHandlerResult> {
+                         if (!files) {
+                           // All the results are exported at once, only the written files are streamed.
+                           ArrowFileExport exporter(directory, std::move(columns), parallelism);
+                           AnyStream export_stream(&exporter, utils::NewDeleteResource());
+                           pull_plan->Pull(&export_stream, {}, output_symbols, summary);
+                           std::vector<std::vector<TypedValue>> rows;
+                           for (auto &file : exporter.Finish()) {
+                             rows.push_back(
+                                 {TypedValue(std::move(file.path)), TypedValue(static_cast<int64_t>(file.rows))});
+                           }
+                           files = std::make_shared<PullPlanVector>(std::move(rows));
+                         }
+                         if (files->Pull(stream, n)) {
+                           return QueryHandlerResult::COMMIT;
+                         }
+                         return std::nullopt;
+                       },
+                       rw_type_checker.type};
+}
+
 PreparedQuery PrepareDumpQuery(ParsedQuery parsed_query, std::map<std::string, TypedValue> *summary, DbAccessor *dba,
-                               utils::MemoryResource *execution_memory) {
+                               InterpreterContext *interpreter_context, utils::MemoryResource *execution_memory) {
+  auto *dump_query = utils::Downcast<DumpQuery>(parsed_query.query);
+  const auto parallelism =
+      dump_query->parallel_execution_ ? interpreter_context->config.query.parallel_execution_threads : 1;
   return PreparedQuery{{"QUERY"},
                        std::move(parsed_query.required_privileges),
-                       [pull_plan = std::make_shared<PullPlanDump>(dba)](
+                       [pull_plan = std::make_shared<PullPlanDump>(dba, parallelism)](
                            AnyStream *stream, std::optional<int> n) -> std::optional<QueryHandlerResult> {
                          if (pull_plan->Pull(stream, n)) {
                            return QueryHandlerResult::COMMIT;
@@ -1824,28 +2181,7 @@ std::vector<std::vector<TypedValue>> AnalyzeGraphQueryHandler::AnalyzeGraphCreat
         label_property_counter.begin(), label_property_counter.end(),
         [execution_db_accessor, &vertex_degree_counter, &label_property_stats](const auto &counter_entry) {
           const auto &[label_property, values_map] = counter_entry;
-          // Extract info
-          uint64_t count_property_value = std::accumulate(
-              values_map.begin(), values_map.end(), 0,
-              [](uint64_t prev_value, const auto &prop_value_count) { return prev_value + prop_value_count.second; });
-          // num_distinc_values will never be 0
-          double avg_group_size = static_cast<double>(count_property_value) / static_cast<double>(values_map.size());
-          double chi_squared_stat = std::accumulate(
-              values_map.begin(), values_map.end(), 0.0, [avg_group_size](double prev_result, const auto &value_entry) {
-                return prev_result + utils::ChiSquaredValue(value_entry.second, avg_group_size);
-              });
-
-          double average_degree = count_property_value > 0
-                                      ? static_cast<double>(vertex_degree_counter[label_property]) /
-                                            static_cast<double>(count_property_value)
-                                      : 0;
-
-          auto index_stats =
-              storage::LabelPropertyIndexStats{.count = count_property_value,
-                                               .distinct_values_count = static_cast<uint64_t>(values_map.size()),
-                                               .statistic = chi_squared_stat,
-                                               .avg_group_size = avg_group_size,
-                                               .avg_degree = average_degree};
+          auto index_stats = storage::MakeLabelPropertyIndexStats(values_map, vertex_degree_counter[label_property]);
           execution_db_accessor->SetIndexStats(label_property.first, label_property.second, index_stats);
           label_property_stats.push_back(std::make_pair(label_property, index_stats));
         });
@@ -1960,12 +2296,7 @@ PreparedQuery PrepareAnalyzeGraphQuery(ParsedQuery parsed_query, bool in_explici
   }
 
   // Creating an index influences computed plan costs.
-  auto invalidate_plan_cache = [plan_cache = &interpreter_context->plan_cache] {
-    auto access = plan_cache->access();
-    for (auto &kv : access) {
-      access.remove(kv.first);
-    }
-  };
+  auto invalidate_plan_cache = [plan_cache = &interpreter_context->plan_cache] { InvalidatePlanCache(plan_cache); };
   utils::OnScopeExit cache_invalidator(invalidate_plan_cache);
 
   auto *analyze_graph_query = utils::Downcast<AnalyzeGraphQuery>(parsed_query.query);
@@ -1997,12 +2328,7 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
   std::function<void(Notification &)> handler;
 
   // Creating an index influences computed plan costs.
-  auto invalidate_plan_cache = [plan_cache = &interpreter_context->plan_cache] {
-    auto access = plan_cache->access();
-    for (auto &kv : access) {
-      access.remove(kv.first);
-    }
-  };
+  auto invalidate_plan_cache = [plan_cache = &interpreter_context->plan_cache] { InvalidatePlanCache(plan_cache); };
 
   auto label = interpreter_context->db->NameToLabel(index_query->label_.name);
 
@@ -2016,10 +2342,6 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
   }
   auto properties_stringified = utils::Join(properties_string, ", ");
 
-  if (properties.size() > 1) {
-    throw utils::NotYetImplemented("index on multiple properties");
-  }
-
   Notification index_notification(SeverityLevel::INFO);
   switch (index_query->action_) {
     case IndexQuery::Action::CREATE: {
@@ -2030,9 +2352,11 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
       handler = [interpreter_context, label, properties_stringified = std::move(properties_stringified),
                  label_name = index_query->label_.name, properties = std::move(properties),
                  invalidate_plan_cache = std::move(invalidate_plan_cache)](Notification &index_notification) {
-        MG_ASSERT(properties.size() <= 1U);
-        auto maybe_index_error = properties.empty() ? interpreter_context->db->CreateIndex(label)
-                                                    : interpreter_context->db->CreateIndex(label, properties[0]);
+        auto maybe_index_error = std::invoke([&] {
+          if (properties.empty()) return interpreter_context->db->CreateIndex(label);
+          if (properties.size() == 1) return interpreter_context->db->CreateIndex(label, properties[0]);
+          return interpreter_context->db->CreateIndex(label, properties);
+        });
         utils::OnScopeExit invalidator(invalidate_plan_cache);
 
         if (maybe_index_error.HasError()) {
@@ -2067,9 +2391,11 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
       handler = [interpreter_context, label, properties_stringified = std::move(properties_stringified),
                  label_name = index_query->label_.name, properties = std::move(properties),
                  invalidate_plan_cache = std::move(invalidate_plan_cache)](Notification &index_notification) {
-        MG_ASSERT(properties.size() <= 1U);
-        auto maybe_index_error = properties.empty() ? interpreter_context->db->DropIndex(label)
-                                                    : interpreter_context->db->DropIndex(label, properties[0]);
+        auto maybe_index_error = std::invoke([&] {
+          if (properties.empty()) return interpreter_context->db->DropIndex(label);
+          if (properties.size() == 1) return interpreter_context->db->DropIndex(label, properties[0]);
+          return interpreter_context->db->DropIndex(label, properties);
+        });
         utils::OnScopeExit invalidator(invalidate_plan_cache);
 
         if (maybe_index_error.HasError()) {
@@ -2111,6 +2437,345 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
       RWType::W};
 }
 
+PreparedQuery PrepareEdgeIndexQuery(ParsedQuery parsed_query, bool in_explicit_transaction,
+                                    std::vector<Notification> *notifications, InterpreterContext *interpreter_context) {
+  if (in_explicit_transaction) {
+    throw IndexInMulticommandTxException();
+  }
+
+  auto *edge_index_query = utils::Downcast<EdgeIndexQuery>(parsed_query.query);
+  std::function<void(Notification &)> handler;
+
+  // Creating an index influences computed plan costs.
+  auto invalidate_plan_cache = [plan_cache = &interpreter_context->plan_cache] { InvalidatePlanCache(plan_cache); };
+
+  auto edge_type = interpreter_context->db->NameToEdgeType(edge_index_query->edge_type_.name);
+  std::optional<storage::PropertyId> property;
+  std::string index_description = fmt::format("edge type {}", edge_index_query->edge_type_.name);
+  if (!edge_index_query->properties_.empty()) {
+    property = interpreter_context->db->NameToProperty(edge_index_query->properties_[0].name);
+    index_description += fmt::format(" on property {}", edge_index_query->properties_[0].name);
+    if (!interpreter_context->db->config_.items.properties_on_edges) {
+      throw QueryException(
+          "Edge-type+property indices can't be created while properties on edges are disabled. Enable them with "
+          "the --storage-properties-on-edges flag.");
+    }
+  }
+
+  Notification index_notification(SeverityLevel::INFO);
+  switch (edge_index_query->action_) {
+    case EdgeIndexQuery::Action::CREATE: {
+      index_notification.code = NotificationCode::CREATE_INDEX;
+      index_notification.title = fmt::format("Created index on {}.", index_description);
+
+      handler = [interpreter_context, edge_type, property, index_description,
+                 invalidate_plan_cache = std::move(invalidate_plan_cache)](Notification &index_notification) {
+        auto maybe_index_error = property ? interpreter_context->db->CreateIndex(edge_type, *property)
+                                          : interpreter_context->db->CreateIndex(edge_type);
+        utils::OnScopeExit invalidator(invalidate_plan_cache);
+
+        if (maybe_index_error.HasError()) {
+          index_notification.code = NotificationCode::EXISTENT_INDEX;
+          index_notification.title = fmt::format("Index on {} already exists.", index_description);
+        }
+      };
+      break;
+    }
+    case EdgeIndexQuery::Action::DROP: {
+      index_notification.code = NotificationCode::DROP_INDEX;
+      index_notification.title = fmt::format("Dropped index on {}.", index_description);
+
+      handler = [interpreter_context, edge_type, property, index_description,
+                 invalidate_plan_cache = std::move(invalidate_plan_cache)](Notification &index_notification) {
+        auto maybe_index_error = property ? interpreter_context->db->DropIndex(edge_type, *property)
+                                          : interpreter_context->db->DropIndex(edge_type);
+        utils::OnScopeExit invalidator(invalidate_plan_cache);
+
+        if (maybe_index_error.HasError()) {
+          index_notification.code = NotificationCode::NONEXISTENT_INDEX;
+          index_notification.title = fmt::format("Index on {} doesn't exist.", index_description);
+        }
+      };
+      break;
+    }
+  }
+
+  return PreparedQuery{
+      {},
+      std::move(parsed_query.required_privileges),
+      [handler = std::move(handler), notifications, index_notification = std::move(index_notification)](
+          AnyStream * /*stream*/, std::optional<int> /*unused*/) mutable {
+        handler(index_notification);
+        notifications->push_back(index_notification);
+        return QueryHandlerResult::NOTHING;
+      },
+      RWType::W};
+}
+
+PreparedQuery PrepareTextIndexQuery(ParsedQuery parsed_query, bool in_explicit_transaction,
+                                    std::vector<Notification> *notifications, InterpreterContext *interpreter_context) {
+  if (in_explicit_transaction) {
+    throw IndexInMulticommandTxException();
+  }
+
+  auto *text_index_query = utils::Downcast<TextIndexQuery>(parsed_query.query);
+  std::function<void(Notification &)> handler;
+
+  auto label = interpreter_context->db->NameToLabel(text_index_query->label_.name);
+  auto property = interpreter_context->db->NameToProperty(text_index_query->property_.name);
+  std::string index_description =
+      fmt::format("label {} on property {}", text_index_query->label_.name, text_index_query->property_.name);
+
+  Notification index_notification(SeverityLevel::INFO);
+  switch (text_index_query->action_) {
+    case TextIndexQuery::Action::CREATE: {
+      index_notification.code = NotificationCode::CREATE_INDEX;
+      index_notification.title = fmt::format("Created text index on {}.", index_description);
+
+      handler = [interpreter_context, label, property, index_description](Notification &index_notification) {
+        auto maybe_index_error = interpreter_context->db->CreateTextIndex(label, property);
+        if (maybe_index_error.HasError()) {
+          std::visit(
+              [&index_notification, &index_description]<typename T>(T &&) {
+                using ErrorType = std::remove_cvref_t<T>;
+                if constexpr (std::is_same_v<ErrorType, storage::ReplicationError>) {
+                  throw ReplicationException(fmt::format(
+                      "At least one SYNC replica has not confirmed the creation of the text index on {}.",
+                      index_description));
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexDefinitionError>) {
+                  index_notification.code = NotificationCode::EXISTENT_INDEX;
+                  index_notification.title = fmt::format("Text index on {} already exists.", index_description);
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexPersistenceError>) {
+                  throw IndexPersistenceException();
+                } else {
+                  static_assert(kAlwaysFalse<T>, "Missing type from variant visitor");
+                }
+              },
+              maybe_index_error.GetError());
+        }
+      };
+      break;
+    }
+    case TextIndexQuery::Action::DROP: {
+      index_notification.code = NotificationCode::DROP_INDEX;
+      index_notification.title = fmt::format("Dropped text index on {}.", index_description);
+
+      handler = [interpreter_context, label, property, index_description](Notification &index_notification) {
+        auto maybe_index_error = interpreter_context->db->DropTextIndex(label, property);
+        if (maybe_index_error.HasError()) {
+          std::visit(
+              [&index_notification, &index_description]<typename T>(T &&) {
+                using ErrorType = std::remove_cvref_t<T>;
+                if constexpr (std::is_same_v<ErrorType, storage::ReplicationError>) {
+                  throw ReplicationException(fmt::format(
+                      "At least one SYNC replica has not confirmed the dropping of the text index on {}.",
+                      index_description));
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexDefinitionError>) {
+                  index_notification.code = NotificationCode::NONEXISTENT_INDEX;
+                  index_notification.title = fmt::format("Text index on {} doesn't exist.", index_description);
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexPersistenceError>) {
+                  throw IndexPersistenceException();
+                } else {
+                  static_assert(kAlwaysFalse<T>, "Missing type from variant visitor");
+                }
+              },
+              maybe_index_error.GetError());
+        }
+      };
+      break;
+    }
+  }
+
+  return PreparedQuery{
+      {},
+      std::move(parsed_query.required_privileges),
+      [handler = std::move(handler), notifications, index_notification = std::move(index_notification)](
+          AnyStream * /*stream*/, std::optional<int> /*unused*/) mutable {
+        handler(index_notification);
+        notifications->push_back(index_notification);
+        return QueryHandlerResult::NOTHING;
+      },
+      RWType::W};
+}
+
+PreparedQuery PrepareVectorIndexQuery(ParsedQuery parsed_query, bool in_explicit_transaction,
+                                      std::vector<Notification> *notifications,
+                                      InterpreterContext *interpreter_context) {
+  if (in_explicit_transaction) {
+    throw IndexInMulticommandTxException();
+  }
+
+  auto *vector_index_query = utils::Downcast<VectorIndexQuery>(parsed_query.query);
+  std::function<void(Notification &)> handler;
+
+  auto label = interpreter_context->db->NameToLabel(vector_index_query->label_.name);
+  auto property = interpreter_context->db->NameToProperty(vector_index_query->property_.name);
+  std::string index_description =
+      fmt::format("label {} on property {}", vector_index_query->label_.name, vector_index_query->property_.name);
+
+  Notification index_notification(SeverityLevel::INFO);
+  switch (vector_index_query->action_) {
+    case VectorIndexQuery::Action::CREATE: {
+      index_notification.code = NotificationCode::CREATE_INDEX;
+      index_notification.title = fmt::format("Created vector index on {}.", index_description);
+
+      handler = [interpreter_context, label, property, index_description](Notification &index_notification) {
+        auto maybe_index_error = interpreter_context->db->CreateVectorIndex(label, property);
+        if (maybe_index_error.HasError()) {
+          std::visit(
+              [&index_notification, &index_description]<typename T>(T &&) {
+                using ErrorType = std::remove_cvref_t<T>;
+                if constexpr (std::is_same_v<ErrorType, storage::ReplicationError>) {
+                  throw ReplicationException(fmt::format(
+                      "At least one SYNC replica has not confirmed the creation of the vector index on {}.",
+                      index_description));
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexDefinitionError>) {
+                  index_notification.code = NotificationCode::EXISTENT_INDEX;
+                  index_notification.title = fmt::format("Vector index on {} already exists.", index_description);
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexPersistenceError>) {
+                  throw IndexPersistenceException();
+                } else {
+                  static_assert(kAlwaysFalse<T>, "Missing type from variant visitor");
+                }
+              },
+              maybe_index_error.GetError());
+        }
+      };
+      break;
+    }
+    case VectorIndexQuery::Action::DROP: {
+      index_notification.code = NotificationCode::DROP_INDEX;
+      index_notification.title = fmt::format("Dropped vector index on {}.", index_description);
+
+      handler = [interpreter_context, label, property, index_description](Notification &index_notification) {
+        auto maybe_index_error = interpreter_context->db->DropVectorIndex(label, property);
+        if (maybe_index_error.HasError()) {
+          std::visit(
+              [&index_notification, &index_description]<typename T>(T &&) {
+                using ErrorType = std::remove_cvref_t<T>;
+                if constexpr (std::is_same_v<ErrorType, storage::ReplicationError>) {
+                  throw ReplicationException(fmt::format(
+                      "At least one SYNC replica has not confirmed the dropping of the vector index on {}.",
+                      index_description));
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexDefinitionError>) {
+                  index_notification.code = NotificationCode::NONEXISTENT_INDEX;
+                  index_notification.title = fmt::format("Vector index on {} doesn't exist.", index_description);
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexPersistenceError>) {
+                  throw IndexPersistenceException();
+                } else {
+                  static_assert(kAlwaysFalse<T>, "Missing type from variant visitor");
+                }
+              },
+              maybe_index_error.GetError());
+        }
+      };
+      break;
+    }
+  }
+
+  return PreparedQuery{
+      {},
+      std::move(parsed_query.required_privileges),
+      [handler = std::move(handler), notifications, index_notification = std::move(index_notification)](
+          AnyStream * /*stream*/, std::optional<int> /*unused*/) mutable {
+        handler(index_notification);
+        notifications->push_back(index_notification);
+        return QueryHandlerResult::NOTHING;
+      },
+      RWType::W};
+}
+
+PreparedQuery PrepareAggregateIndexQuery(ParsedQuery parsed_query, bool in_explicit_transaction,
+                                         std::vector<Notification> *notifications,
+                                         InterpreterContext *interpreter_context) {
+  if (in_explicit_transaction) {
+    throw IndexInMulticommandTxException();
+  }
+
+  auto *aggregate_index_query = utils::Downcast<AggregateIndexQuery>(parsed_query.query);
+  std::function<void(Notification &)> handler;
+
+  auto label = interpreter_context->db->NameToLabel(aggregate_index_query->label_.name);
+  auto group_property = interpreter_context->db->NameToProperty(aggregate_index_query->group_property_.name);
+  auto value_property = interpreter_context->db->NameToProperty(aggregate_index_query->value_property_.name);
+  std::string index_description = fmt::format("label {} on properties {}, {}", aggregate_index_query->label_.name,
+                                              aggregate_index_query->group_property_.name,
+                                              aggregate_index_query->value_property_.name);
+
+  Notification index_notification(SeverityLevel::INFO);
+  switch (aggregate_index_query->action_) {
+    case AggregateIndexQuery::Action::CREATE: {
+      index_notification.code = NotificationCode::CREATE_INDEX;
+      index_notification.title = fmt::format("Created aggregate index on {}.", index_description);
+
+      handler = [interpreter_context, label, group_property, value_property,
+                 index_description](Notification &index_notification) {
+        auto maybe_index_error = interpreter_context->db->CreateAggregateIndex(label, group_property, value_property);
+        if (maybe_index_error.HasError()) {
+          std::visit(
+              [&index_notification, &index_description]<typename T>(T &&) {
+                using ErrorType = std::remove_cvref_t<T>;
+                if constexpr (std::is_same_v<ErrorType, storage::ReplicationError>) {
+                  throw ReplicationException(fmt::format(
+                      "At least one SYNC replica has not confirmed the creation of the aggregate index on {}.",
+                      index_description));
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexDefinitionError>) {
+                  index_notification.code = NotificationCode::EXISTENT_INDEX;
+                  index_notification.title = fmt::format("Aggregate index on {} already exists.", index_description);
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexPersistenceError>) {
+                  throw IndexPersistenceException();
+                } else {
+                  static_assert(kAlwaysFalse<T>, "Missing type from variant visitor");
+                }
+              },
+              maybe_index_error.GetError());
+        }
+      };
+      break;
+    }
+    case AggregateIndexQuery::Action::DROP: {
+      index_notification.code = NotificationCode::DROP_INDEX;
+      index_notification.title = fmt::format("Dropped aggregate index on {}.", index_description);
+
+      handler = [interpreter_context, label, group_property, value_property,
+                 index_description](Notification &index_notification) {
+        auto maybe_index_error = interpreter_context->db->DropAggregateIndex(label, group_property, value_property);
+        if (maybe_index_error.HasError()) {
+          std::visit(
+              [&index_notification, &index_description]<typename T>(T &&) {
+                using ErrorType = std::remove_cvref_t<T>;
+                if constexpr (std::is_same_v<ErrorType, storage::ReplicationError>) {
+                  throw ReplicationException(fmt::format(
+                      "At least one SYNC replica has not confirmed the dropping of the aggregate index on {}.",
+                      index_description));
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexDefinitionError>) {
+                  index_notification.code = NotificationCode::NONEXISTENT_INDEX;
+                  index_notification.title = fmt::format("Aggregate index on {} doesn't exist.", index_description);
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexPersistenceError>) {
+                  throw IndexPersistenceException();
+                } else {
+                  static_assert(kAlwaysFalse<T>, "Missing type from variant visitor");
+                }
+              },
+              maybe_index_error.GetError());
+        }
+      };
+      break;
+    }
+  }
+
+  return PreparedQuery{
+      {},
+      std::move(parsed_query.required_privileges),
+      [handler = std::move(handler), notifications, index_notification = std::move(index_notification)](
+          AnyStream * /*stream*/, std::optional<int> /*unused*/) mutable {
+        handler(index_notification);
+        notifications->push_back(index_notification);
+        return QueryHandlerResult::NOTHING;
+      },
+      RWType::W};
+}
+
 PreparedQuery PrepareAuthQuery(ParsedQuery parsed_query, bool in_explicit_transaction,
                                InterpreterContext *interpreter_context) {
   if (in_explicit_transaction) {
@@ -2690,6 +3355,7 @@ std::vector<std::vector<TypedValue>> TransactionQueueQueryHandler::ShowTransacti
         }
       }
       results.back().push_back(TypedValue(metadata_tv));
+      results.back().emplace_back(interpreter->GetTransactionMemory());
     }
   }
   return results;
@@ -2717,6 +3383,7 @@ std::vector<std::vector<TypedValue>> TransactionQueueQueryHandler::KillTransacti
         utils::OnScopeExit clean_status([interpreter, &killed]() {
           if (killed) {
             interpreter->transaction_status_.store(TransactionStatus::TERMINATED, std::memory_order_release);
+            utils::NotifyInterrupt();
           } else {
             interpreter->transaction_status_.store(TransactionStatus::ACTIVE, std::memory_order_release);
           }
@@ -2757,7 +3424,7 @@ Callback HandleTransactionQueueQuery(TransactionQueueQuery *transaction_query,
   Callback callback;
   switch (transaction_query->action_) {
     case TransactionQueueQuery::Action::SHOW_TRANSACTIONS: {
-      callback.header = {"username", "transaction_id", "query", "metadata"};
+      callback.header = {"username", "transaction_id", "query", "metadata", "memory_allocated"};
       callback.fn = [handler = TransactionQueueQueryHandler(), interpreter_context, username,
                      hasTransactionManagementPrivilege]() mutable {
         std::vector<std::vector<TypedValue>> results;
@@ -2851,7 +3518,8 @@ PreparedQuery PrepareInfoQuery(ParsedQuery parsed_query, bool in_explicit_transa
     case InfoQuery::InfoType::STORAGE:
       header = {"storage info", "value"};
 
-      handler = [db, interpreter_isolation_level, next_transaction_isolation_level] {
+      handler = [db, interpreter_context, interpreter_isolation_level, next_transaction_isolation_level] {
+        const auto &query_memory_tracker = interpreter_context->query_memory_tracker;
         auto info = db->GetInfo();
         std::vector<std::vector<TypedValue>> results{
             {TypedValue("name"), TypedValue(db->id())},
@@ -2862,6 +3530,8 @@ PreparedQuery PrepareInfoQuery(ParsedQuery parsed_query, bool in_explicit_transa
             {TypedValue("disk_usage"), TypedValue(static_cast<int64_t>(info.disk_usage))},
             {TypedValue("memory_allocated"), TypedValue(static_cast<int64_t>(utils::total_memory_tracker.Amount()))},
             {TypedValue("allocation_limit"), TypedValue(static_cast<int64_t>(utils::total_memory_tracker.HardLimit()))},
+            {TypedValue("query_memory_allocated"), TypedValue(static_cast<int64_t>(query_memory_tracker.Amount()))},
+            {TypedValue("query_memory_limit"), TypedValue(static_cast<int64_t>(query_memory_tracker.HardLimit()))},
             {TypedValue("global_isolation_level"), TypedValue(IsolationLevelToString(db->GetIsolationLevel()))},
             {TypedValue("session_isolation_level"), TypedValue(IsolationLevelToString(interpreter_isolation_level))},
             {TypedValue("next_session_isolation_level"),
@@ -2876,7 +3546,9 @@ PreparedQuery PrepareInfoQuery(ParsedQuery parsed_query, bool in_explicit_transa
         auto *db = interpreter_context->db.get();
         auto info = db->ListAllIndices();
         std::vector<std::vector<TypedValue>> results;
-        results.reserve(info.label.size() + info.label_property.size());
+        results.reserve(info.label.size() + info.label_property.size() + info.label_property_composite.size() +
+                        info.edge_type.size() + info.edge_type_property.size() + info.text.size() +
+                        info.vector.size() + info.aggregate.size());
         for (const auto &item : info.label) {
           results.push_back({TypedValue("label"), TypedValue(db->LabelToName(item)), TypedValue()});
         }
@@ -2884,6 +3556,36 @@ PreparedQuery PrepareInfoQuery(ParsedQuery parsed_query, bool in_explicit_transa
           results.push_back({TypedValue("label+property"), TypedValue(db->LabelToName(item.first)),
                              TypedValue(db->PropertyToName(item.second))});
         }
+        for (const auto &item : info.label_property_composite) {
+          std::vector<TypedValue> properties;
+          properties.reserve(item.second.size());
+          for (const auto &property : item.second) {
+            properties.emplace_back(db->PropertyToName(property));
+          }
+          results.push_back({TypedValue("label+properties"), TypedValue(db->LabelToName(item.first)),
+                             TypedValue(std::move(properties))});
+        }
+        // Edge indices are listed with the edge type in the place of the label.
+        for (const auto &item : info.edge_type) {
+          results.push_back({TypedValue("edge-type"), TypedValue(db->EdgeTypeToName(item)), TypedValue()});
+        }
+        for (const auto &item : info.edge_type_property) {
+          results.push_back({TypedValue("edge-type+property"), TypedValue(db->EdgeTypeToName(item.first)),
+                             TypedValue(db->PropertyToName(item.second))});
+        }
+        for (const auto &item : info.text) {
+          results.push_back({TypedValue("text"), TypedValue(db->LabelToName(item.first)),
+                             TypedValue(db->PropertyToName(item.second))});
+        }
+        for (const auto &item : info.vector) {
+          results.push_back({TypedValue("vector"), TypedValue(db->LabelToName(item.first)),
+                             TypedValue(db->PropertyToName(item.second))});
+        }
+        for (const auto &[label, group_property, value_property] : info.aggregate) {
+          results.push_back({TypedValue("aggregate"), TypedValue(db->LabelToName(label)),
+                             TypedValue(std::vector<TypedValue>{TypedValue(db->PropertyToName(group_property)),
+                                                                TypedValue(db->PropertyToName(value_property))})});
+        }
         return std::pair{results, QueryHandlerResult::NOTHING};
       };
       break;
@@ -3192,10 +3894,15 @@ PreparedQuery PrepareConstraintQuery(ParsedQuery parsed_query, bool in_explicit_
     } break;
   }
 
+  // Constraints are a part of the schema the cached plans were made for.
+  auto invalidate_plan_cache = [plan_cache = &interpreter_context->plan_cache] { InvalidatePlanCache(plan_cache); };
+
   return PreparedQuery{{},
                        std::move(parsed_query.required_privileges),
                        [handler = std::move(handler), constraint_notification = std::move(constraint_notification),
-                        notifications](AnyStream * /*stream*/, std::optional<int> /*n*/) mutable {
+                        notifications, invalidate_plan_cache = std::move(invalidate_plan_cache)](
+                           AnyStream * /*stream*/, std::optional<int> /*n*/) mutable {
+                         utils::OnScopeExit invalidator(invalidate_plan_cache);
                          handler(constraint_notification);
                          notifications->push_back(constraint_notification);
                          return QueryHandlerResult::COMMIT;
@@ -3462,10 +4169,15 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
                                                 const std::map<std::string, storage::PropertyValue> &params,
                                                 const std::string *username, QueryExtras const &extras,
                                                 const std::string &session_uuid) {
+  const utils::MemoryTracker::ThreadScope memory_scope{&transaction_memory_tracker_};
+  const auto query_id = utils::NextQueryId();
+  const utils::QueryIdScope query_id_scope{query_id};
+  MG_TRACEPOINT(query__start, query_id, query_string.c_str());
   std::shared_ptr<utils::AsyncTimer> current_timer;
   if (!in_explicit_transaction_) {
     query_executions_.clear();
     transaction_queries_->clear();
+    ResetTransactionMemory();
     // Handle user-defined metadata in auto-transactions
     metadata_ = GenOptional(extras.metadata_pv);
     auto const timeout = DetermineTxTimeout(extras.tx_timeout, interpreter_context_->config);
@@ -3485,9 +4197,9 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
   const auto trimmed_query = utils::Trim(upper_case_query);
 
   if (trimmed_query == "BEGIN" || trimmed_query == "COMMIT" || trimmed_query == "ROLLBACK") {
-    query_executions_.emplace_back(
-        std::make_unique<QueryExecution>(utils::MonotonicBufferResource(kExecutionMemoryBlockSize)));
+    query_executions_.emplace_back(std::make_unique<QueryExecution>(&execution_buffer_cache_, &transaction_memory_));
     auto &query_execution = query_executions_.back();
+    query_execution->query_id = query_id;
     std::optional<int> qid =
         in_explicit_transaction_ ? static_cast<int>(query_executions_.size() - 1) : std::optional<int>{};
 
@@ -3496,7 +4208,12 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
   }
 
   // Don't save BEGIN, COMMIT or ROLLBACK
-  transaction_queries_->push_back(query_string);
+  if (query_string.empty() && extras.statement_id) {
+    auto it = prepared_statements_.find(*extras.statement_id);
+    transaction_queries_->push_back(it != prepared_statements_.end() ? it->second.query_string : query_string);
+  } else {
+    transaction_queries_->push_back(query_string);
+  }
 
   // All queries other than transaction control queries advance the command in
   // an explicit transaction block.
@@ -3505,34 +4222,41 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
   } else if (db_accessor_) {
     // If we're not in an explicit transaction block and we have an open
     // transaction, abort it since we're about to prepare a new query.
-    query_executions_.emplace_back(
-        std::make_unique<QueryExecution>(utils::MonotonicBufferResource(kExecutionMemoryBlockSize)));
+    query_executions_.emplace_back(std::make_unique<QueryExecution>(&execution_buffer_cache_, &transaction_memory_));
     AbortCommand(&query_executions_.back());
   }
 
   std::unique_ptr<QueryExecution> *query_execution_ptr = nullptr;
   try {
-    query_executions_.emplace_back(
-        std::make_unique<QueryExecution>(utils::MonotonicBufferResource(kExecutionMemoryBlockSize)));
+    query_executions_.emplace_back(std::make_unique<QueryExecution>(&execution_buffer_cache_, &transaction_memory_));
     query_execution_ptr = &query_executions_.back();
     utils::Timer parsing_timer;
     ParsedQuery parsed_query =
-        ParseQuery(query_string, params, &interpreter_context_->ast_cache, interpreter_context_->config.query);
+        extras.statement_id
+            ? ParsePreparedStatement(query_string, params, *extras.statement_id)
+            : ParseQuery(query_string, params, &interpreter_context_->ast_cache, interpreter_context_->config.query);
     TypedValue parsing_time{parsing_timer.Elapsed().count()};
 
-    if ((utils::Downcast<CypherQuery>(parsed_query.query) || utils::Downcast<ProfileQuery>(parsed_query.query))) {
+    if ((utils::Downcast<CypherQuery>(parsed_query.query) || utils::Downcast<ProfileQuery>(parsed_query.query) ||
+         utils::Downcast<ExportQuery>(parsed_query.query))) {
       CypherQuery *cypher_query = nullptr;
       if (utils::Downcast<CypherQuery>(parsed_query.query)) {
         cypher_query = utils::Downcast<CypherQuery>(parsed_query.query);
+      } else if (auto *export_query = utils::Downcast<ExportQuery>(parsed_query.query)) {
+        cypher_query = export_query->cypher_query_;
       } else {
         auto *profile_query = utils::Downcast<ProfileQuery>(parsed_query.query);
         cypher_query = profile_query->cypher_query_;
       }
       if (const auto &clauses = cypher_query->single_query_->clauses_;
-          IsAllShortestPathsQuery(clauses) || IsCallBatchedProcedureQuery(clauses) ||
+          interpreter_context_->config.query.spill_memory_limit != 0 || IsAllShortestPathsQuery(clauses) ||
+          IsCallBatchedProcedureQuery(clauses) ||
           std::any_of(clauses.begin(), clauses.end(),
-                      [](const auto *clause) { return clause->GetTypeInfo() == LoadCsv::kType; })) {
-        // Using PoolResource without MonotonicMemoryResouce for LOAD CSV reduces memory usage.
+                      [](const auto *clause) {
+                        return clause->GetTypeInfo() == LoadCsv::kType || clause->GetTypeInfo() == LoadArrow::kType;
+                      })) {
+        // Using PoolResource without MonotonicMemoryResouce for LOAD CSV and LOAD ARROW reduces memory usage.
+        // The operators which spill their state to disk also need the freed memory to be reused.
         // QueryExecution MemoryResource is mostly used for allocations done on Frame and storing `row`s
         query_executions_[query_executions_.size() - 1] = std::make_unique<QueryExecution>(utils::PoolResource(
             128, kExecutionPoolMaxBlockSize, utils::NewDeleteResource(), utils::NewDeleteResource()));
@@ -3543,6 +4267,7 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
     }
 
     auto &query_execution = query_executions_.back();
+    query_execution->query_id = query_id;
 
     std::optional<int> qid =
         in_explicit_transaction_ ? static_cast<int>(query_executions_.size() - 1) : std::optional<int>{};
@@ -3553,19 +4278,49 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
     // field with an improved estimate.
     query_execution->summary["cost_estimate"] = 0.0;
 
+    // Queries are admitted before their transaction starts, so the queued ones
+    // don't hold back the garbage collection.
+    if (interpreter_context_->admission_controller.Enabled()) {
+      auto *admitted_query = utils::Downcast<CypherQuery>(parsed_query.query);
+      if (auto *profile_query = utils::Downcast<ProfileQuery>(parsed_query.query)) {
+        admitted_query = profile_query->cypher_query_;
+      } else if (auto *export_query = utils::Downcast<ExportQuery>(parsed_query.query)) {
+        admitted_query = export_query->cypher_query_;
+      }
+      if (admitted_query) {
+        EvaluationContext evaluation_context;
+        evaluation_context.parameters = parsed_query.parameters;
+        auto evaluator = PrimitiveLiteralExpressionEvaluator{evaluation_context};
+        query_execution->admission_ticket = interpreter_context_->admission_controller.Admit(
+            username_, EvaluateMemoryLimit(evaluator, admitted_query->memory_limit_, admitted_query->memory_scale_));
+      }
+    }
+
     // Some queries require an active transaction in order to be prepared.
     if (!in_explicit_transaction_ &&
         (utils::Downcast<CypherQuery>(parsed_query.query) || utils::Downcast<ExplainQuery>(parsed_query.query) ||
-         utils::Downcast<ProfileQuery>(parsed_query.query) || utils::Downcast<DumpQuery>(parsed_query.query) ||
-         utils::Downcast<TriggerQuery>(parsed_query.query) || utils::Downcast<AnalyzeGraphQuery>(parsed_query.query) ||
+         utils::Downcast<ProfileQuery>(parsed_query.query) || utils::Downcast<ExportQuery>(parsed_query.query) ||
+         utils::Downcast<DumpQuery>(parsed_query.query) || utils::Downcast<TriggerQuery>(parsed_query.query) ||
+         utils::Downcast<AnalyzeGraphQuery>(parsed_query.query) ||
          utils::Downcast<TransactionQueueQuery>(parsed_query.query))) {
+      WaitForBookmark(extras);
       memgraph::metrics::IncrementCounter(memgraph::metrics::ActiveTransactions);
-      db_accessor_ = interpreter_context_->db->Access(GetIsolationLevelOverride());
+      // A query which was already planned as read-only starts a read-only
+      // transaction. The triggers run in the transaction of the query, so it
+      // can't be a read-only one if there are any.
+      if (utils::Downcast<CypherQuery>(parsed_query.query) && parsed_query.is_cacheable &&
+          !interpreter_context_->trigger_store.HasTriggers() &&
+          IsCachedReadOnlyQuery(parsed_query.stripped_query->hash(), &interpreter_context_->plan_cache)) {
+        db_accessor_ = interpreter_context_->db->ReadOnlyAccess(GetIsolationLevelOverride());
+      } else {
+        db_accessor_ = interpreter_context_->db->Access(GetIsolationLevelOverride());
+      }
       execution_db_accessor_.emplace(db_accessor_.get());
       transaction_status_.store(TransactionStatus::ACTIVE, std::memory_order_release);
 
       if (utils::Downcast<CypherQuery>(parsed_query.query) && interpreter_context_->trigger_store.HasTriggers()) {
-        trigger_context_collector_.emplace(interpreter_context_->trigger_store.GetEventTypes());
+        trigger_context_collector_.emplace(interpreter_context_->trigger_store.GetEventTypes(),
+                                           interpreter_context_->trigger_store.GetIdentifierTags());
       }
     }
 
@@ -3576,11 +4331,15 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
                    query_execution->execution_memory);
     frame_change_collector_.reset();
     frame_change_collector_.emplace(memory_resource);
-    if (utils::Downcast<CypherQuery>(parsed_query.query)) {
+    if (auto *cypher_query = utils::Downcast<CypherQuery>(parsed_query.query)) {
+      if (in_explicit_transaction_ && cypher_query->commit_frequency_) {
+        throw ExplicitTransactionUsageException("Periodic commit can't be used in multicommand transactions.");
+      }
       prepared_query = PrepareCypherQuery(
           std::move(parsed_query), &query_execution->summary, interpreter_context_, &*execution_db_accessor_,
           memory_resource, &query_execution->notifications, username, &transaction_status_, std::move(current_timer),
-          trigger_context_collector_ ? &*trigger_context_collector_ : nullptr, &*frame_change_collector_);
+          &transaction_memory_tracker_, trigger_context_collector_ ? &*trigger_context_collector_ : nullptr,
+          &*frame_change_collector_);
     } else if (utils::Downcast<ExplainQuery>(parsed_query.query)) {
       prepared_query = PrepareExplainQuery(std::move(parsed_query), &query_execution->summary, interpreter_context_,
                                            &*execution_db_accessor_, &query_execution->execution_memory_with_exception);
@@ -3589,12 +4348,29 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
                                            interpreter_context_, &*execution_db_accessor_,
                                            &query_execution->execution_memory_with_exception, username,
                                            &transaction_status_, std::move(current_timer), &*frame_change_collector_);
+    } else if (utils::Downcast<ExportQuery>(parsed_query.query)) {
+      prepared_query = PrepareExportQuery(std::move(parsed_query), &query_execution->summary, interpreter_context_,
+                                          &*execution_db_accessor_, &query_execution->execution_memory_with_exception,
+                                          username, &transaction_status_, std::move(current_timer),
+                                          &*frame_change_collector_);
     } else if (utils::Downcast<DumpQuery>(parsed_query.query)) {
       prepared_query = PrepareDumpQuery(std::move(parsed_query), &query_execution->summary, &*execution_db_accessor_,
-                                        memory_resource);
+                                        interpreter_context_, memory_resource);
     } else if (utils::Downcast<IndexQuery>(parsed_query.query)) {
       prepared_query = PrepareIndexQuery(std::move(parsed_query), in_explicit_transaction_,
                                          &query_execution->notifications, interpreter_context_);
+    } else if (utils::Downcast<EdgeIndexQuery>(parsed_query.query)) {
+      prepared_query = PrepareEdgeIndexQuery(std::move(parsed_query), in_explicit_transaction_,
+                                             &query_execution->notifications, interpreter_context_);
+    } else if (utils::Downcast<TextIndexQuery>(parsed_query.query)) {
+      prepared_query = PrepareTextIndexQuery(std::move(parsed_query), in_explicit_transaction_,
+                                             &query_execution->notifications, interpreter_context_);
+    } else if (utils::Downcast<VectorIndexQuery>(parsed_query.query)) {
+      prepared_query = PrepareVectorIndexQuery(std::move(parsed_query), in_explicit_transaction_,
+                                               &query_execution->notifications, interpreter_context_);
+    } else if (utils::Downcast<AggregateIndexQuery>(parsed_query.query)) {
+      prepared_query = PrepareAggregateIndexQuery(std::move(parsed_query), in_explicit_transaction_,
+                                                  &query_execution->notifications, interpreter_context_);
     } else if (utils::Downcast<AnalyzeGraphQuery>(parsed_query.query)) {
       prepared_query = PrepareAnalyzeGraphQuery(std::move(parsed_query), in_explicit_transaction_,
                                                 &*execution_db_accessor_, interpreter_context_);
@@ -3672,6 +4448,7 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
             query_execution->prepared_query->db};
   } catch (const utils::BasicException &) {
     memgraph::metrics::IncrementCounter(memgraph::metrics::FailedQuery);
+    MG_TRACEPOINT(query__done, query_id, true);
     AbortCommand(query_execution_ptr);
     throw;
   }
@@ -3721,10 +4498,14 @@ void Interpreter::Abort() {
 
 namespace {
 void RunTriggersIndividually(const utils::SkipList<Trigger> &triggers, InterpreterContext *interpreter_context,
-                             TriggerContext original_trigger_context,
-                             std::atomic<TransactionStatus> *transaction_status) {
+                             const TriggerContext &original_trigger_context,
+                             std::atomic<TransactionStatus> *transaction_status,
+                             const std::function<bool(const Trigger &)> &should_run) {
   // Run the triggers
   for (const auto &trigger : triggers.access()) {
+    if (!should_run(trigger)) {
+      continue;
+    }
     utils::MonotonicBufferResource execution_memory{kExecutionMemoryBlockSize};
 
     // create a new transaction for each trigger
@@ -3866,7 +4647,10 @@ void Interpreter::Commit() {
 
   auto commit_confirmed_by_all_sync_repplicas = true;
 
+  const auto transaction_id = db_accessor_->GetTransactionId().value_or(0);
+  MG_TRACEPOINT(commit__start, utils::CurrentQueryId(), transaction_id);
   auto maybe_commit_error = db_accessor_->Commit();
+  MG_TRACEPOINT(commit__done, utils::CurrentQueryId(), transaction_id, maybe_commit_error.HasError());
   if (maybe_commit_error.HasError()) {
     const auto &error = maybe_commit_error.GetError();
 
@@ -3904,18 +4688,34 @@ void Interpreter::Commit() {
         },
         error);
   }
+  // The last commit timestamp covers this transaction, the commits done in the
+  // meantime only make the bookmark stricter than necessary.
+  bookmark_ = CommitTimestampToBookmark(interpreter_context_->db->LastCommitTimestamp());
 
   // The ordered execution of after commit triggers is heavily depending on the exclusiveness of
   // db_accessor_->Commit(): only one of the transactions can be commiting at the same time, so when the commit is
   // finished, that transaction probably will schedule its after commit triggers, because the other transactions that
   // want to commit are still waiting for commiting or one of them just started commiting its changes. This means the
-  // ordered execution of after commit triggers are not guaranteed.
+  // ordered execution of after commit triggers are not guaranteed. The runs of each trigger keep the order in which
+  // they are scheduled, because each trigger always runs on the same worker.
   if (trigger_context && interpreter_context_->trigger_store.AfterCommitTriggers().size() > 0) {
-    interpreter_context_->after_commit_trigger_pool.AddTask(
-        [this, trigger_context = std::move(*trigger_context),
-         user_transaction = std::shared_ptr(std::move(db_accessor_))]() mutable {
+    auto &executor = interpreter_context_->after_commit_trigger_executor;
+    std::vector<size_t> workers;
+    for (const auto &trigger : interpreter_context_->trigger_store.AfterCommitTriggers().access()) {
+      workers.push_back(executor.Worker(trigger.Name()));
+    }
+    std::sort(workers.begin(), workers.end());
+    workers.erase(std::unique(workers.begin(), workers.end()), workers.end());
+
+    executor.Schedule(
+        workers,
+        [this, trigger_context = std::make_shared<const TriggerContext>(std::move(*trigger_context))](size_t worker) {
+          auto &executor = this->interpreter_context_->after_commit_trigger_executor;
           RunTriggersIndividually(this->interpreter_context_->trigger_store.AfterCommitTriggers(),
-                                  this->interpreter_context_, std::move(trigger_context), &this->transaction_status_);
+                                  this->interpreter_context_, *trigger_context, &this->transaction_status_,
+                                  [&](const Trigger &trigger) { return executor.Worker(trigger.Name()) == worker; });
+        },
+        [user_transaction = std::shared_ptr(std::move(db_accessor_))] {
           user_transaction->FinalizeTransaction();
           SPDLOG_DEBUG("Finished executing after commit triggers");  // NOLINT(bugprone-lambda-function-name)
         });
@@ -3953,6 +4753,13 @@ std::optional<storage::IsolationLevel> Interpreter::GetIsolationLevelOverride()
   return interpreter_isolation_level;
 }
 
+void Interpreter::ResetTransactionMemory() {
+  if (const auto peak = transaction_memory_tracker_.Peak(); peak > 0) {
+    memgraph::metrics::Measure(memgraph::metrics::TransactionPeakMemory_bytes, peak);
+  }
+  transaction_memory_tracker_.Reset();
+}
+
 void Interpreter::SetNextTransactionIsolationLevel(const storage::IsolationLevel isolation_level) {
   next_transaction_isolation_level.emplace(isolation_level);
 }
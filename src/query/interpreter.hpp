@@ -11,10 +11,13 @@
 
 #pragma once
 
+#include <unordered_map>
 #include <unordered_set>
 
 #include <gflags/gflags.h>
 
+#include "memory/execution_arena.hpp"
+#include "query/admission_controller.hpp"
 #include "query/auth_checker.hpp"
 #include "query/config.hpp"
 #include "query/context.hpp"
@@ -28,15 +31,18 @@
 #include "query/metadata.hpp"
 #include "query/plan/operator.hpp"
 #include "query/plan/read_write_type_checker.hpp"
+#include "query/result_cache.hpp"
 #include "query/stream.hpp"
 #include "query/stream/streams.hpp"
 #include "query/trigger.hpp"
+#include "query/trigger_executor.hpp"
 #include "query/typed_value.hpp"
 #include "spdlog/spdlog.h"
 #include "storage/v2/disk/storage.hpp"
 #include "storage/v2/isolation_level.hpp"
 #include "storage/v2/storage.hpp"
 #include "utils/event_counter.hpp"
+#include "utils/interrupt.hpp"
 #include "utils/logging.hpp"
 #include "utils/memory.hpp"
 #include "utils/settings.hpp"
@@ -45,6 +51,7 @@
 #include "utils/synchronized.hpp"
 #include "utils/thread_pool.hpp"
 #include "utils/timer.hpp"
+#include "utils/tracepoint.hpp"
 #include "utils/tsc.hpp"
 
 namespace memgraph::metrics {
@@ -55,6 +62,10 @@ namespace memgraph::query {
 
 inline constexpr size_t kExecutionMemoryBlockSize = 1UL * 1024UL * 1024UL;
 inline constexpr size_t kExecutionPoolMaxBlockSize = 1024UL;  // 2 ^ 10
+inline constexpr size_t kMinExecutionBufferSize = 64UL * 1024UL;
+inline constexpr size_t kMaxExecutionBufferSize = 4UL * kExecutionMemoryBlockSize;
+/// Maximum number of statements prepared in a single session.
+inline constexpr size_t kMaxPreparedStatements = 1000UL;
 
 class AuthQueryHandler {
  public:
@@ -185,7 +196,7 @@ class ReplicationQueryHandler {
   /// @throw QueryRuntimeException if an error ocurred.
   virtual void RegisterReplica(const std::string &name, const std::string &socket_address,
                                ReplicationQuery::SyncMode sync_mode,
-                               const std::chrono::seconds replica_check_frequency) = 0;
+                               const std::chrono::seconds replica_check_frequency, bool compression) = 0;
 
   /// @throw QueryRuntimeException if an error ocurred.
   virtual void DropReplica(const std::string &replica_name) = 0;
@@ -230,8 +241,21 @@ struct PreparedQuery {
 struct QueryExtras {
   std::map<std::string, memgraph::storage::PropertyValue> metadata_pv;
   std::optional<int64_t> tx_timeout;
+  // Newest commit timestamp from the client's bookmarks, the transaction waits until it's applied
+  std::optional<uint64_t> bookmark_timestamp;
+  // Id of the prepared statement to execute or to prepare, see `Interpreter::Prepare`
+  std::optional<std::string> statement_id;
 };
 
+/**
+ * Bookmarks handed to the clients hold the commit timestamp of their last
+ * transaction. Timestamps are the same on MAIN and its REPLICAs, so a client
+ * can read its own writes from a REPLICA by passing the bookmark back.
+ */
+std::string CommitTimestampToBookmark(uint64_t commit_timestamp);
+/// Return nullopt if the bookmark wasn't created by `CommitTimestampToBookmark`.
+std::optional<uint64_t> BookmarkToCommitTimestamp(std::string_view bookmark);
+
 class Interpreter;
 
 /**
@@ -268,17 +292,32 @@ struct InterpreterContext {
   utils::SkipList<PlanCacheEntry> plan_cache;
 
   TriggerStore trigger_store;
-  utils::ThreadPool after_commit_trigger_pool{1};
 
   const InterpreterConfig config;
 
+  ResultCache result_cache{config.query.result_cache_size, config.query.result_cache_max_rows};
+
+  // Tracks the execution memory of the queries running on the database and
+  // the memory of its transactions, so that a database can't use up the
+  // memory of the others.
+  utils::MemoryTracker query_memory_tracker;
+  utils::TrackedMemoryResource query_memory{&query_memory_tracker, memory::ExecutionArenaResource()};
+
+  AfterCommitTriggerExecutor after_commit_trigger_executor{config.after_commit_trigger_workers,
+                                                           config.after_commit_trigger_max_backlog};
+
   query::stream::Streams streams;
   utils::Synchronized<std::unordered_set<Interpreter *>, utils::SpinLock> interpreters;
+
+  AdmissionController admission_controller{config.admission};
 };
 
 /// Function that is used to tell all active interpreters that they should stop
 /// their ongoing execution.
-inline void Shutdown(InterpreterContext *context) { context->is_shutting_down.store(true, std::memory_order_release); }
+inline void Shutdown(InterpreterContext *context) {
+  context->is_shutting_down.store(true, std::memory_order_release);
+  utils::NotifyInterrupt();
+}
 
 class Interpreter final {
  public:
@@ -309,6 +348,12 @@ class Interpreter final {
    * Preparing a query means to preprocess the query and save it for
    * future calls of `Pull`.
    *
+   * If `extras.statement_id` is set, the stripped and parsed query is kept
+   * under that id for the rest of the session. A later call with the same id
+   * and an empty query reuses it with the new parameters, without stripping,
+   * parsing and looking up the AST cache again. A non-empty query prepares
+   * the statement again.
+   *
    * @throw query::QueryException
    */
   PrepareResult Prepare(const std::string &query, const std::map<std::string, storage::PropertyValue> &params,
@@ -361,10 +406,16 @@ class Interpreter final {
 
   std::optional<uint64_t> GetTransactionId() const;
 
+  // Bytes allocated by the current transaction which weren't freed yet.
+  int64_t GetTransactionMemory() const { return transaction_memory_tracker_.Amount(); }
+
   void CommitTransaction();
 
   void RollbackTransaction();
 
+  // Bookmark of the last transaction committed by this interpreter if it wasn't taken already
+  std::optional<std::string> TakeBookmark() { return std::exchange(bookmark_, std::nullopt); }
+
   void SetNextTransactionIsolationLevel(storage::IsolationLevel isolation_level);
   void SetSessionIsolationLevel(storage::IsolationLevel isolation_level);
 
@@ -385,6 +436,17 @@ class Interpreter final {
 
     std::map<std::string, TypedValue> summary;
     std::vector<Notification> notifications;
+    // Held until the query finishes executing.
+    AdmissionController::Ticket admission_ticket;
+    // Cache from which the monotonic execution memory got its initial buffer.
+    utils::MonotonicBufferCache *buffer_cache{nullptr};
+    // Id carried by the USDT probes, see `utils::CurrentQueryId`.
+    uint64_t query_id{0};
+
+    QueryExecution(utils::MonotonicBufferCache *cache, utils::MemoryResource *upstream)
+        : QueryExecution(cache->Acquire(upstream)) {
+      buffer_cache = cache;
+    }
 
     explicit QueryExecution(utils::MonotonicBufferResource monotonic_memory)
         : execution_memory(std::move(monotonic_memory)) {
@@ -413,6 +475,11 @@ class Interpreter final {
       // destroy the prepared query which is using that instance
       // of execution memory.
       prepared_query.reset();
+      if (auto *monotonic_memory = std::get_if<utils::MonotonicBufferResource>(&execution_memory);
+          monotonic_memory && buffer_cache) {
+        buffer_cache->Recycle(monotonic_memory);
+        return;
+      }
       std::visit([](auto &memory_resource) { memory_resource.Release(); }, execution_memory);
     }
 
@@ -424,6 +491,18 @@ class Interpreter final {
     }
   };
 
+  // The memory of the current transaction, i.e. the execution memory of its
+  // queries and everything the interpreter allocates while executing them,
+  // including the storage objects, is tracked under the database's tracker.
+  // It's declared before the query executions so that they free their memory
+  // before it's destroyed.
+  utils::MemoryTracker transaction_memory_tracker_;
+  utils::TrackedMemoryResource transaction_memory_{&transaction_memory_tracker_, memory::ExecutionArenaResource()};
+  // Initial buffer of the execution memory of the queries, which is reused by
+  // the next query instead of being freed, so that small queries don't
+  // allocate their execution memory. It's counted in the database's tracker.
+  utils::MonotonicBufferCache execution_buffer_cache_;
+
   // Interpreter supports multiple prepared queries at the same time.
   // The client can reference a specific query for pull using an arbitrary qid
   // which is in our case the index of the query in the vector.
@@ -452,10 +531,22 @@ class Interpreter final {
   std::optional<storage::IsolationLevel> interpreter_isolation_level;
   std::optional<storage::IsolationLevel> next_transaction_isolation_level;
 
+  std::optional<std::string> bookmark_;
+
+  // Statements prepared in this session, by their id.
+  std::unordered_map<std::string, PreparedStatement> prepared_statements_;
+
+  // @throw PreparedStatementException
+  ParsedQuery ParsePreparedStatement(const std::string &query_string,
+                                     const std::map<std::string, storage::PropertyValue> &params,
+                                     const std::string &statement_id);
   PreparedQuery PrepareTransactionQuery(std::string_view query_upper, QueryExtras const &extras = {});
+  // @throw BookmarkWaitTimeoutException
+  void WaitForBookmark(QueryExtras const &extras);
   void Commit();
   void AdvanceCommand();
   void AbortCommand(std::unique_ptr<QueryExecution> *query_execution);
+  void ResetTransactionMemory();
   std::optional<storage::IsolationLevel> GetIsolationLevelOverride();
 
   size_t ActiveQueryExecutions() {
@@ -488,6 +579,7 @@ template <typename TStream>
 std::map<std::string, TypedValue> Interpreter::Pull(TStream *result_stream, std::optional<int> n,
                                                     std::optional<int> qid) {
   MG_ASSERT(in_explicit_transaction_ || !qid, "qid can be only used in explicit transaction!");
+  const utils::MemoryTracker::ThreadScope memory_scope{&transaction_memory_tracker_};
 
   const int qid_value = qid ? *qid : static_cast<int>(query_executions_.size() - 1);
   if (qid_value < 0 || qid_value >= query_executions_.size()) {
@@ -501,6 +593,8 @@ std::map<std::string, TypedValue> Interpreter::Pull(TStream *result_stream, std:
   auto &query_execution = query_executions_[qid_value];
 
   MG_ASSERT(query_execution && query_execution->prepared_query, "Query already finished executing!");
+  const auto query_id = query_execution->query_id;
+  const utils::QueryIdScope query_id_scope{query_id};
 
   // Each prepared query has its own summary so we need to somehow preserve
   // it after it finishes executing because it gets destroyed alongside
@@ -552,17 +646,21 @@ std::map<std::string, TypedValue> Interpreter::Pull(TStream *result_stream, std:
         // after our query finished executing.
         query_executions_.clear();
         transaction_queries_->clear();
+        ResetTransactionMemory();
       } else {
         // We can only clear this execution as some of the queries
         // in the transaction can be in unfinished state
         query_execution.reset(nullptr);
       }
+      MG_TRACEPOINT(query__done, query_id, false);
     }
   } catch (const ExplicitTransactionUsageException &) {
+    MG_TRACEPOINT(query__done, query_id, true);
     query_execution.reset(nullptr);
     throw;
   } catch (const utils::BasicException &) {
     memgraph::metrics::IncrementCounter(memgraph::metrics::FailedQuery);
+    MG_TRACEPOINT(query__done, query_id, true);
     AbortCommand(&query_execution);
     throw;
   }
@@ -570,6 +668,9 @@ std::map<std::string, TypedValue> Interpreter::Pull(TStream *result_stream, std:
   if (maybe_summary) {
     // return the execution summary
     maybe_summary->insert_or_assign("has_more", false);
+    if (auto bookmark = TakeBookmark()) {
+      maybe_summary->insert_or_assign("bookmark", std::move(*bookmark));
+    }
     return std::move(*maybe_summary);
   }
 
@@ -0,0 +1,51 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/plan/cardinality_feedback.hpp"
+
+namespace memgraph::query::plan {
+
+double CardinalityError(const double estimated, const double actual) {
+  const auto estimated_rows = std::max(estimated, 1.0);
+  const auto actual_rows = std::max(actual, 1.0);
+  return std::max(estimated_rows, actual_rows) / std::min(estimated_rows, actual_rows);
+}
+
+CardinalityCorrections CorrectCardinalities(const std::vector<OperatorCardinality> &cardinalities) {
+  // The rows of all filters, and of all expansions, are summed up, so the
+  // operators with more rows have more influence on the corrections.
+  double filter_rows = 0;
+  double filter_input_rows = 0;
+  double expand_rows = 0;
+  double expand_input_rows = 0;
+  for (const auto &cardinality : cardinalities) {
+    if (!cardinality.actual_input || *cardinality.actual_input == 0) continue;
+    const auto type = cardinality.op->GetTypeInfo();
+    if (type == Filter::kType) {
+      filter_rows += cardinality.actual;
+      filter_input_rows += *cardinality.actual_input;
+    } else if (type == Expand::kType) {
+      expand_rows += cardinality.actual;
+      expand_input_rows += *cardinality.actual_input;
+    }
+  }
+
+  CardinalityCorrections corrections;
+  if (filter_input_rows > 0) {
+    corrections.filter_selectivity = std::clamp(filter_rows / filter_input_rows, kMinCardinalityCorrection, 1.0);
+  }
+  if (expand_input_rows > 0) {
+    corrections.expand_degree = std::max(expand_rows / expand_input_rows, kMinCardinalityCorrection);
+  }
+  return corrections;
+}
+
+}  // namespace memgraph::query::plan
@@ -0,0 +1,100 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Comparison of the cardinalities the cost estimator expects with the ones
+/// observed by profiling a plan, from which the selectivities of the next plan
+/// of the query are corrected.
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+#include "query/plan/cost_estimator.hpp"
+#include "query/plan/profile.hpp"
+
+namespace memgraph::query::plan {
+
+/// The smallest corrected selectivity or degree. Plans in which no rows pass
+/// the filters would all cost the same, so the corrections never reach 0.
+inline constexpr double kMinCardinalityCorrection = 1e-3;
+
+/// Estimated and actual number of rows produced by an operator of a profiled
+/// plan.
+struct OperatorCardinality {
+  const LogicalOperator *op;
+  double estimated;
+  double actual;
+  /// The actual number of rows produced by the input of the operator, if the
+  /// operator has a single input which was profiled.
+  std::optional<double> actual_input;
+};
+
+/// Returns how many times the larger of the cardinalities is larger than the
+/// smaller one. Both are taken to be at least 1, so the operators producing
+/// few rows don't count as misestimated.
+double CardinalityError(double estimated, double actual);
+
+/// Returns the corrections which replace the constants of the cost estimator
+/// by the selectivities of the filters and the degrees of the expansions which
+/// the cardinalities were observed with, or empty corrections if there are no
+/// such operators with profiled inputs.
+CardinalityCorrections CorrectCardinalities(const std::vector<OperatorCardinality> &cardinalities);
+
+/// Pairs the operators of the plan with their stats collected by profiling it
+/// and the cardinalities the cost estimator expects for them. The last pull of
+/// an operator doesn't produce a row, so the actual number of rows is one less
+/// than the number of hits.
+///
+/// The operators are followed from the root through their single inputs,
+/// matched to the stats by name, because the stats of the operators in
+/// branches aren't ordered by the branches. The pairing stops at the first
+/// operator without a profiled input.
+template <class TDbAccessor>
+std::vector<OperatorCardinality> CompareCardinalities(const LogicalOperator &root, const ProfilingStats &stats,
+                                                      TDbAccessor *db, const SymbolTable &symbol_table,
+                                                      const Parameters &parameters,
+                                                      const CardinalityCorrections &corrections = {}) {
+  const auto rows = [](const ProfilingStats &stats) {
+    return static_cast<double>(std::max<int64_t>(stats.actual_hits - 1, 0));
+  };
+  const auto is_stats_of = [](const ProfilingStats &stats, const LogicalOperator &op) {
+    return stats.name && std::strcmp(stats.name, op.GetTypeInfo().name) == 0;
+  };
+
+  std::vector<OperatorCardinality> cardinalities;
+  if (!is_stats_of(stats, root)) return cardinalities;
+  const auto *op = &root;
+  const auto *op_stats = &stats;
+  while (op) {
+    // The cardinality of the operator is the one estimated for its subtree.
+    CostEstimator<TDbAccessor> estimator(db, symbol_table, parameters, corrections);
+    const_cast<LogicalOperator *>(op)->Accept(estimator);
+    cardinalities.push_back({op, estimator.cardinality(), rows(*op_stats), std::nullopt});
+
+    if (!op->HasSingleInput() || !op->input()) break;
+    const auto *input = op->input().get();
+    const auto is_input_stats = [&](const auto &child) { return is_stats_of(child, *input); };
+    const auto it = std::find_if(op_stats->children.begin(), op_stats->children.end(), is_input_stats);
+    if (it == op_stats->children.end() ||
+        std::find_if(std::next(it), op_stats->children.end(), is_input_stats) != op_stats->children.end()) {
+      break;
+    }
+    cardinalities.back().actual_input = rows(*it);
+    op = input;
+    op_stats = &*it;
+  }
+  return cardinalities;
+}
+
+}  // namespace memgraph::query::plan
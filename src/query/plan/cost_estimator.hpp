@@ -11,9 +11,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <optional>
+
 #include "query/frontend/ast/ast.hpp"
 #include "query/parameters.hpp"
 #include "query/plan/operator.hpp"
+#include "query/plan/rewrite/constant_folding.hpp"
 #include "query/typed_value.hpp"
 #include "utils/algorithm.hpp"
 #include "utils/math.hpp"
@@ -38,6 +42,21 @@ struct Scope {
   std::unordered_map<std::string, SymbolStatistics> symbol_stats;
 };
 
+/**
+ * Cardinalities observed by profiling a query, which replace the constants of
+ * the cost estimator when the query is planned again.
+ *
+ * @sa CompareCardinalities
+ */
+struct CardinalityCorrections {
+  /// Fraction of the rows which passed the filters.
+  std::optional<double> filter_selectivity;
+  /// Average number of rows an expansion produced for each of its input rows.
+  std::optional<double> expand_degree;
+
+  bool empty() const { return !filter_selectivity && !expand_degree; }
+};
+
 /**
  * Query plan execution time cost estimator, for comparing and choosing optimal
  * execution plans.
@@ -74,8 +93,12 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     static constexpr double kScanAll{1.0};
     static constexpr double kScanAllByLabel{1.1};
     static constexpr double MakeScanAllByLabelPropertyValue{1.1};
+    static constexpr double MakeScanAllByLabelPropertyValues{1.1};
     static constexpr double MakeScanAllByLabelPropertyRange{1.1};
     static constexpr double MakeScanAllByLabelProperty{1.1};
+    static constexpr double MakeScanAllByLabelPropertyComposite{1.1};
+    static constexpr double kScanAllByEdgeType{1.1};
+    static constexpr double MakeScanAllByEdgeTypeProperty{1.1};
     static constexpr double kExpand{2.0};
     static constexpr double kExpandVariable{3.0};
     static constexpr double kFilter{1.5};
@@ -84,6 +107,7 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     static constexpr double kForeach{1.0};
     static constexpr double kUnion{1.0};
     static constexpr double kSubquery{1.0};
+    static constexpr double kHashJoin{1.5};
   };
 
   struct CardParam {
@@ -101,11 +125,17 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
   using HierarchicalLogicalOperatorVisitor::PostVisit;
   using HierarchicalLogicalOperatorVisitor::PreVisit;
 
-  CostEstimator(TDbAccessor *db_accessor, const SymbolTable &table, const Parameters &parameters)
-      : db_accessor_(db_accessor), table_(table), parameters(parameters), scopes_{Scope()} {}
+  CostEstimator(TDbAccessor *db_accessor, const SymbolTable &table, const Parameters &parameters,
+                CardinalityCorrections corrections = {})
+      : db_accessor_(db_accessor),
+        table_(table),
+        parameters(parameters),
+        corrections_(corrections),
+        scopes_{Scope()} {}
 
-  CostEstimator(TDbAccessor *db_accessor, const SymbolTable &table, const Parameters &parameters, Scope scope)
-      : db_accessor_(db_accessor), table_(table), parameters(parameters), scopes_{scope} {}
+  CostEstimator(TDbAccessor *db_accessor, const SymbolTable &table, const Parameters &parameters, Scope scope,
+                CardinalityCorrections corrections = {})
+      : db_accessor_(db_accessor), table_(table), parameters(parameters), corrections_(corrections), scopes_{scope} {}
 
   bool PostVisit(ScanAll &) override {
     cardinality_ *= db_accessor_->VerticesCount();
@@ -140,6 +170,9 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     if (property_value)
       // get the exact influence based on ScanAll(label, property, value)
       factor = db_accessor_->VerticesCount(logical_op.label_, logical_op.property_, property_value.value());
+    else if (index_stats.has_value() && index_stats->distinct_values_count > 0)
+      // the value isn't known yet, so expect the average number of vertices per value
+      factor = index_stats->avg_group_size;
     else
       // estimate the influence as ScanAll(label, property) * filtering
       factor = db_accessor_->VerticesCount(logical_op.label_, logical_op.property_) * CardParam::kFilter;
@@ -151,6 +184,41 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PostVisit(ScanAllByLabelPropertyValues &logical_op) override {
+    auto index_stats = db_accessor_->GetIndexStats(logical_op.label_, logical_op.property_);
+    if (index_stats.has_value()) {
+      SaveStatsFor(logical_op.output_symbol_, index_stats.value());
+    }
+
+    // If the list is a constant, the vertices with each of its distinct values
+    // are counted exactly, otherwise the list is expected to have as many
+    // values as an unwound list.
+    auto list = ConstPropertyValue(logical_op.expression_);
+    double factor = 0.0;
+    if (list && list->IsList()) {
+      auto values = list->ValueList();
+      std::sort(values.begin(), values.end());
+      values.erase(std::unique(values.begin(), values.end()), values.end());
+      for (const auto &value : values) {
+        if (value.IsNull()) continue;
+        factor += db_accessor_->VerticesCount(logical_op.label_, logical_op.property_, value);
+      }
+    } else if (list && list->IsNull()) {
+      // No vertex has a value in a Null list.
+    } else if (index_stats.has_value() && index_stats->distinct_values_count > 0) {
+      factor = MiscParam::kUnwindNoLiteral * index_stats->avg_group_size;
+    } else {
+      factor = MiscParam::kUnwindNoLiteral * db_accessor_->VerticesCount(logical_op.label_, logical_op.property_) *
+               CardParam::kFilter;
+    }
+
+    cardinality_ *= factor;
+
+    // ScanAll performs some work for every element that is produced
+    IncrementCost(CostParam::MakeScanAllByLabelPropertyValues);
+    return true;
+  }
+
   bool PostVisit(ScanAllByLabelPropertyRange &logical_op) override {
     auto index_stats = db_accessor_->GetIndexStats(logical_op.label_, logical_op.property_);
     if (index_stats.has_value()) {
@@ -193,10 +261,73 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PostVisit(ScanAllByLabelPropertyComposite &logical_op) override {
+    // Same as for the value and range lookups, the estimation is exact only
+    // when all of the values and bounds are literals.
+    std::vector<storage::PropertyValue> prefix;
+    prefix.reserve(logical_op.prefix_.size());
+    for (auto *expression : logical_op.prefix_) {
+      auto property_value = ConstPropertyValue(expression);
+      if (!property_value) break;
+      prefix.emplace_back(std::move(*property_value));
+    }
+    const bool whole_prefix = prefix.size() == logical_op.prefix_.size();
+    auto lower = whole_prefix ? BoundToPropertyValue(logical_op.lower_bound_) : std::nullopt;
+    auto upper = whole_prefix ? BoundToPropertyValue(logical_op.upper_bound_) : std::nullopt;
+
+    double factor = 1.0;
+    if (!prefix.empty()) {
+      factor = db_accessor_->VerticesCount(logical_op.label_, logical_op.properties_, prefix, lower, upper);
+    } else {
+      factor = db_accessor_->VerticesCount(logical_op.label_, logical_op.properties_);
+    }
+    // Apply the filtering constant for each of the values we couldn't use.
+    for (auto i = prefix.size(); i < logical_op.prefix_.size(); ++i) factor *= CardParam::kFilter;
+    if ((logical_op.upper_bound_ && !upper) || (logical_op.lower_bound_ && !lower)) factor *= CardParam::kFilter;
+
+    cardinality_ *= factor;
+    IncrementCost(CostParam::MakeScanAllByLabelPropertyComposite);
+    return true;
+  }
+
+  bool PostVisit(ScanAllByEdgeType &logical_op) override {
+    cardinality_ *= db_accessor_->EdgesCount(logical_op.edge_type_);
+    IncrementCost(CostParam::kScanAllByEdgeType);
+    return true;
+  }
+
+  bool PostVisit(ScanAllByEdgeTypeProperty &logical_op) override {
+    // Same as for the vertex lookups, the estimation is exact only when the
+    // value or the bounds are literals.
+    double factor = 1.0;
+    if (logical_op.expression_) {
+      auto property_value = ConstPropertyValue(logical_op.expression_);
+      if (property_value) {
+        factor = db_accessor_->EdgesCount(logical_op.edge_type_, logical_op.property_, property_value.value());
+      } else {
+        factor = db_accessor_->EdgesCount(logical_op.edge_type_, logical_op.property_) * CardParam::kFilter;
+      }
+    } else if (logical_op.lower_bound_ || logical_op.upper_bound_) {
+      auto lower = BoundToPropertyValue(logical_op.lower_bound_);
+      auto upper = BoundToPropertyValue(logical_op.upper_bound_);
+      if ((logical_op.upper_bound_ && !upper) || (logical_op.lower_bound_ && !lower)) {
+        factor = db_accessor_->EdgesCount(logical_op.edge_type_, logical_op.property_) * CardParam::kFilter;
+      } else {
+        factor = db_accessor_->EdgesCount(logical_op.edge_type_, logical_op.property_, lower, upper);
+      }
+    } else {
+      factor = db_accessor_->EdgesCount(logical_op.edge_type_, logical_op.property_);
+    }
+
+    cardinality_ *= factor;
+    IncrementCost(CostParam::MakeScanAllByEdgeTypeProperty);
+    return true;
+  }
+
   // TODO: Cost estimate ScanAllById?
 
   bool PostVisit(Expand &expand) override {
-    auto card_param = CardParam::kExpand;
+    auto card_param = corrections_.expand_degree.value_or(CardParam::kExpand);
     auto stats = GetStatsFor(expand.input_symbol_);
 
     if (stats.has_value()) {
@@ -209,6 +340,19 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PostVisit(IntersectExpand &expand) override {
+    // Each edge multiplies the rows like in the chain of expansions it
+    // replaces, but only the edges of one vertex are iterated.
+    for (const auto &edge : expand.edges_) {
+      auto stats = GetStatsFor(edge.input_symbol);
+      cardinality_ *= stats.has_value() ? stats.value().degree
+                                        : corrections_.expand_degree.value_or(CardParam::kExpand);
+    }
+    IncrementCost(CostParam::kExpand);
+
+    return true;
+  }
+
 // For the given op first increments the cardinality and then cost.
 #define POST_VISIT_CARD_FIRST(NAME)     \
   bool PostVisit(NAME &) override {     \
@@ -229,11 +373,16 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     return true;                                      \
   }
 
-  POST_VISIT_COST_FIRST(Filter, kFilter)
   POST_VISIT_COST_FIRST(EdgeUniquenessFilter, kEdgeUniquenessFilter);
 
 #undef POST_VISIT_COST_FIRST
 
+  bool PostVisit(Filter &) override {
+    IncrementCost(CostParam::kFilter);
+    cardinality_ *= corrections_.filter_selectivity.value_or(CardParam::kFilter);
+    return true;
+  }
+
   bool PostVisit(Unwind &unwind) override {
     // Unwind cost depends more on the number of lists that get unwound
     // much less on the number of outputs
@@ -281,6 +430,22 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     return false;
   }
 
+  bool PreVisit(HashJoin &op) override {
+    // Unlike Cartesian, the branches are executed only once and their results
+    // are joined by hashing, so the costs of the branches add up and each
+    // result of both branches is hashed once.
+    CostEstimator<TDbAccessor> left_estimator(db_accessor_, table_, parameters, scopes_.back(), corrections_);
+    op.left_op_->Accept(left_estimator);
+    CostEstimator<TDbAccessor> right_estimator(db_accessor_, table_, parameters, scopes_.back(), corrections_);
+    op.right_op_->Accept(right_estimator);
+
+    cost_ += cardinality_ * (left_estimator.cost() + right_estimator.cost());
+    IncrementCost(CostParam::kHashJoin * (left_estimator.cardinality() + right_estimator.cardinality()));
+    // The join condition filters the pairs like the Filter it replaced.
+    cardinality_ *= left_estimator.cardinality() * right_estimator.cardinality() * CardParam::kFilter;
+    return false;
+  }
+
   bool PostVisit(Produce &op) override {
     auto scope = Scope();
 
@@ -335,18 +500,19 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
   TDbAccessor *db_accessor_;
   const SymbolTable &table_;
   const Parameters &parameters;
+  CardinalityCorrections corrections_;
   std::vector<Scope> scopes_;
 
   void IncrementCost(double param) { cost_ += param * cardinality_; }
 
   double EstimateCostOnBranch(std::shared_ptr<LogicalOperator> *branch) {
-    CostEstimator<TDbAccessor> cost_estimator(db_accessor_, table_, parameters);
+    CostEstimator<TDbAccessor> cost_estimator(db_accessor_, table_, parameters, corrections_);
     (*branch)->Accept(cost_estimator);
     return cost_estimator.cost();
   }
 
   double EstimateCostOnBranch(std::shared_ptr<LogicalOperator> *branch, Scope scope) {
-    CostEstimator<TDbAccessor> cost_estimator(db_accessor_, table_, parameters, scope);
+    CostEstimator<TDbAccessor> cost_estimator(db_accessor_, table_, parameters, scope, corrections_);
     (*branch)->Accept(cost_estimator);
     return cost_estimator.cost();
   }
@@ -363,13 +529,16 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     return std::nullopt;
   }
 
-  // If the expression is a constant property value, it is returned. Otherwise,
-  // return nullopt.
+  // If the expression is a constant property value, it is returned. The
+  // constant expressions, e.g. `date($date) - duration('P30D')`, are evaluated
+  // with the parameters of the planned query. Otherwise, return nullopt.
   std::optional<storage::PropertyValue> ConstPropertyValue(const Expression *expression) {
     if (auto *literal = utils::Downcast<const PrimitiveLiteral>(expression)) {
       return literal->value_;
     } else if (auto *param_lookup = utils::Downcast<const ParameterLookup>(expression)) {
       return parameters.AtTokenPosition(param_lookup->token_position_);
+    } else if (expression) {
+      return EvaluateConstantExpression(*expression, parameters);
     }
     return std::nullopt;
   }
@@ -397,8 +566,8 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
 /** Returns the estimated cost of the given plan. */
 template <class TDbAccessor>
 double EstimatePlanCost(TDbAccessor *db, const SymbolTable &table, const Parameters &parameters,
-                        LogicalOperator &plan) {
-  CostEstimator<TDbAccessor> estimator(db, table, parameters);
+                        LogicalOperator &plan, const CardinalityCorrections &corrections = {}) {
+  CostEstimator<TDbAccessor> estimator(db, table, parameters, corrections);
   plan.Accept(estimator);
   return estimator.cost();
 }
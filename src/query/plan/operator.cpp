@@ -12,13 +12,22 @@
 #include "query/plan/operator.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cmath>
+#include <condition_variable>
 #include <cstdint>
+#include <exception>
+#include <functional>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <numeric>
 #include <optional>
 #include <queue>
 #include <random>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
@@ -32,6 +41,7 @@
 
 #include "csv/parsing.hpp"
 #include "license/license.hpp"
+#include "query/arrow_reader.hpp"
 #include "query/auth_checker.hpp"
 #include "query/context.hpp"
 #include "query/db_accessor.hpp"
@@ -39,17 +49,24 @@
 #include "query/frontend/ast/ast.hpp"
 #include "query/frontend/semantic/symbol_table.hpp"
 #include "query/graph.hpp"
+#include "query/interpret/compiled_expression.hpp"
 #include "query/interpret/eval.hpp"
+#include "query/interpret/kernels.hpp"
 #include "query/path.hpp"
 #include "query/plan/scoped_profile.hpp"
+#include "query/plan/sketches.hpp"
+#include "query/plan/spill.hpp"
 #include "query/procedure/cypher_types.hpp"
 #include "query/procedure/mg_procedure_impl.hpp"
 #include "query/procedure/module.hpp"
+#include "query/procedure/procedure_stats.hpp"
 #include "query/typed_value.hpp"
+#include "storage/v2/property_columns.hpp"
 #include "storage/v2/property_value.hpp"
 #include "storage/v2/view.hpp"
 #include "utils/algorithm.hpp"
 #include "utils/event_counter.hpp"
+#include "utils/event_histogram.hpp"
 #include "utils/exceptions.hpp"
 #include "utils/fnv.hpp"
 #include "utils/java_string_formatter.hpp"
@@ -59,12 +76,18 @@
 #include "utils/message.hpp"
 #include "utils/pmr/deque.hpp"
 #include "utils/pmr/list.hpp"
+#include "utils/pmr/map.hpp"
 #include "utils/pmr/unordered_map.hpp"
 #include "utils/pmr/unordered_set.hpp"
 #include "utils/pmr/vector.hpp"
 #include "utils/readable_size.hpp"
+#include "utils/regex.hpp"
+#include "utils/spin_lock.hpp"
 #include "utils/string.hpp"
+#include "utils/synchronized.hpp"
 #include "utils/temporal.hpp"
+#include "utils/on_scope_exit.hpp"
+#include "utils/timer.hpp"
 #include "utils/typeinfo.hpp"
 
 // macro for the default implementation of LogicalOperator::Accept
@@ -94,10 +117,15 @@ extern const Event ScanAllOperator;
 extern const Event ScanAllByLabelOperator;
 extern const Event ScanAllByLabelPropertyRangeOperator;
 extern const Event ScanAllByLabelPropertyValueOperator;
+extern const Event ScanAllByLabelPropertyValuesOperator;
 extern const Event ScanAllByLabelPropertyOperator;
+extern const Event ScanAllByLabelPropertyCompositeOperator;
 extern const Event ScanAllByIdOperator;
+extern const Event ScanAllByEdgeTypeOperator;
+extern const Event ScanAllByEdgeTypePropertyOperator;
 extern const Event ExpandOperator;
 extern const Event ExpandVariableOperator;
+extern const Event IntersectExpandOperator;
 extern const Event ConstructNamedPathOperator;
 extern const Event FilterOperator;
 extern const Event ProduceOperator;
@@ -116,14 +144,27 @@ extern const Event OrderByOperator;
 extern const Event MergeOperator;
 extern const Event OptionalOperator;
 extern const Event UnwindOperator;
+extern const Event UnwindMergeOperator;
 extern const Event DistinctOperator;
 extern const Event UnionOperator;
 extern const Event CartesianOperator;
+extern const Event HashJoinOperator;
 extern const Event CallProcedureOperator;
 extern const Event ForeachOperator;
 extern const Event EmptyResultOperator;
 extern const Event EvaluatePatternFilterOperator;
 extern const Event ApplyOperator;
+extern const Event PeriodicCommitOperator;
+
+extern const Event ProcedureTimeToFirstRecord_us;
+extern const Event ProcedureResultBuffer_bytes;
+
+extern const Event ScanPullLatency_ns;
+extern const Event ExpandPullLatency_ns;
+extern const Event FilterPullLatency_ns;
+extern const Event AggregationPullLatency_ns;
+extern const Event WritePullLatency_ns;
+extern const Event ProducePullLatency_ns;
 }  // namespace memgraph::metrics
 
 namespace memgraph::query::plan {
@@ -161,13 +202,96 @@ uint64_t ComputeProfilingKey(const T *obj) {
 }
 
 inline void AbortCheck(ExecutionContext const &context) {
-  if (auto const reason = MustAbort(context); reason != AbortReason::NO_ABORT) throw HintedAbortError(reason);
+  if (auto const reason = ShouldAbort(context); reason != AbortReason::NO_ABORT) throw HintedAbortError(reason);
 }
 
 }  // namespace
 
+void MeasureSampledPull(const char *name, uint64_t cycles) noexcept {
+  const std::string_view op{name};
+  const auto histogram = [&]() -> std::optional<metrics::Event> {
+    if (op.starts_with("ScanAll")) return metrics::ScanPullLatency_ns;
+    if (op.starts_with("Expand") || op.ends_with("ShortestPath") || op == "IntersectExpand") {
+      return metrics::ExpandPullLatency_ns;
+    }
+    if (op.ends_with("Filter")) return metrics::FilterPullLatency_ns;
+    if (op == "Aggregate" || op == "Distinct" || op == "OrderBy" || op == "Accumulate") {
+      return metrics::AggregationPullLatency_ns;
+    }
+    if (op.starts_with("Create") || op.starts_with("Set") || op.starts_with("Remove") || op == "Delete" ||
+        op == "Merge" || op == "UnwindMerge") {
+      return metrics::WritePullLatency_ns;
+    }
+    if (op == "Produce") return metrics::ProducePullLatency_ns;
+    return std::nullopt;
+  }();
+  if (!histogram) return;
+  if (const auto latency = utils::TSCCyclesToNanoseconds(cycles)) metrics::Measure(*histogram, *latency);
+}
+
 #define SCOPED_PROFILE_OP(name) ScopedProfile profile{ComputeProfilingKey(this), name, &context};
 
+bool Cursor::PullBatch(Frame &frame, FrameBatch &batch, ExecutionContext &context) {
+  batch.Clear();
+  while (!batch.full() && Pull(frame, context)) batch.Append(frame);
+  return !batch.empty();
+}
+
+BatchedInput::BatchedInput() = default;
+BatchedInput::BatchedInput(BatchedInput &&) noexcept = default;
+BatchedInput &BatchedInput::operator=(BatchedInput &&) noexcept = default;
+BatchedInput::~BatchedInput() = default;
+
+bool BatchedInput::Next(Cursor &input, Frame &frame, ExecutionContext &context) {
+  if (!batch_) {
+    batch_ = std::make_unique<FrameBatch>(static_cast<int64_t>(frame.elems().size()), FrameBatch::kDefaultCapacity,
+                                          frame.GetMemoryResource());
+  }
+  if (++row_ < batch_->size()) return true;
+  row_ = 0;
+  return input.PullBatch(frame, *batch_, context);
+}
+
+Frame &BatchedInput::row() { return (*batch_)[row_]; }
+
+void BatchedInput::Reset() {
+  if (batch_) batch_->Clear();
+  row_ = 0;
+}
+
+namespace {
+
+/** Returns true if all operators of the pipeline `op` pull their input in
+ * batches natively. The rows of such a pipeline are pulled before they are
+ * consumed, so only operators that read the graph as it was before the
+ * current command (View::OLD) are allowed. */
+bool IsBatchPipeline(const LogicalOperator &op) {
+  const auto *current = &op;
+  while (true) {
+    const auto &type = current->GetTypeInfo();
+    if (type == Once::kType) return true;
+    if (utils::IsSubtype(type, ScanAll::kType)) {
+      if (static_cast<const ScanAll *>(current)->view_ != storage::View::OLD) return false;
+    } else if (type == Expand::kType) {
+      if (static_cast<const Expand *>(current)->view_ != storage::View::OLD) return false;
+    } else if (type == Filter::kType) {
+      if (!static_cast<const Filter *>(current)->pattern_filters_.empty()) return false;
+    } else if (type != LoadArrow::kType) {
+      return false;
+    }
+    current = current->input().get();
+  }
+}
+
+/** Returns true if the cursor of a consuming operator should pull `input` in
+ * batches. Profiling and frame change tracking follow the rows one by one, so
+ * they keep the row at a time execution. */
+bool UseBatches(const LogicalOperator &input, const ExecutionContext &context) {
+  return !context.is_profile_query && !context.frame_change_collector && IsBatchPipeline(input);
+}
+
+}  // namespace
+
 bool Once::OnceCursor::Pull(Frame &, ExecutionContext &context) {
   SCOPED_PROFILE_OP("Once");
 
@@ -178,6 +302,16 @@ bool Once::OnceCursor::Pull(Frame &, ExecutionContext &context) {
   return false;
 }
 
+bool Once::OnceCursor::PullBatch(Frame &frame, FrameBatch &batch, ExecutionContext &context) {
+  SCOPED_PROFILE_OP("Once");
+
+  batch.Clear();
+  if (did_pull_) return false;
+  did_pull_ = true;
+  batch.Append(frame);
+  return true;
+}
+
 UniqueCursorPtr Once::MakeCursor(utils::MemoryResource *mem) const {
   memgraph::metrics::IncrementCounter(memgraph::metrics::OnceOperator);
 
@@ -193,13 +327,13 @@ void Once::OnceCursor::Reset() { did_pull_ = false; }
 CreateNode::CreateNode(const std::shared_ptr<LogicalOperator> &input, const NodeCreationInfo &node_info)
     : input_(input ? input : std::make_shared<Once>()), node_info_(node_info) {}
 
-// Creates a vertex on this GraphDb. Returns a reference to vertex placed on the
-// frame.
-VertexAccessor &CreateLocalVertex(const NodeCreationInfo &node_info, Frame *frame, ExecutionContext &context) {
-  auto &dba = *context.db_accessor;
-  auto new_node = dba.InsertVertex();
+namespace {
+
+// Creates a vertex with the given labels, but without properties.
+VertexAccessor InsertVertexWithLabels(const std::vector<storage::LabelId> &labels, ExecutionContext &context) {
+  auto new_node = context.db_accessor->InsertVertex();
   context.execution_stats[ExecutionStats::Key::CREATED_NODES] += 1;
-  for (auto label : node_info.labels) {
+  for (auto label : labels) {
     auto maybe_error = new_node.AddLabel(label);
     if (maybe_error.HasError()) {
       switch (maybe_error.GetError()) {
@@ -215,6 +349,15 @@ VertexAccessor &CreateLocalVertex(const NodeCreationInfo &node_info, Frame *fram
     }
     context.execution_stats[ExecutionStats::Key::CREATED_LABELS] += 1;
   }
+  return new_node;
+}
+
+}  // namespace
+
+// Creates a vertex on this GraphDb. Returns a reference to vertex placed on the
+// frame.
+VertexAccessor &CreateLocalVertex(const NodeCreationInfo &node_info, Frame *frame, ExecutionContext &context) {
+  auto new_node = InsertVertexWithLabels(node_info.labels, context);
   // Evaluator should use the latest accessors, as modified in this query, when
   // setting properties on new nodes.
   ExpressionEvaluator evaluator(frame, context.symbol_table, context.evaluation_context, context.db_accessor,
@@ -229,7 +372,7 @@ VertexAccessor &CreateLocalVertex(const NodeCreationInfo &node_info, Frame *fram
   } else {
     auto property_map = evaluator.Visit(*std::get<ParameterLookup *>(node_info.properties));
     for (const auto &[key, value] : property_map.ValueMap()) {
-      properties.emplace(dba.NameToProperty(key), value);
+      properties.emplace(evaluator.NameToProperty(key), value);
     }
   }
   MultiPropsInitChecked(&new_node, properties);
@@ -321,7 +464,7 @@ EdgeAccessor CreateEdge(const EdgeCreationInfo &edge_info, DbAccessor *dba, Vert
     } else {
       auto property_map = evaluator->Visit(*std::get<ParameterLookup *>(edge_info.properties));
       for (const auto &[key, value] : property_map.ValueMap()) {
-        properties.emplace(dba->NameToProperty(key), value);
+        properties.emplace(evaluator->NameToProperty(key), value);
       }
     }
     if (!properties.empty()) MultiPropsInitChecked(&edge, properties);
@@ -422,6 +565,22 @@ VertexAccessor &CreateExpand::CreateExpandCursor::OtherVertex(Frame &frame, Exec
   }
 }
 
+namespace {
+
+// Vertices are only readable when all of their labels are, so none of the
+// vertices a label scan yields can be read if its label can't be. Such scans
+// are skipped instead of checking each of the vertices.
+bool CanReadLabel(storage::LabelId label, const ExecutionContext &context) {
+#ifdef MG_ENTERPRISE
+  return !(license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
+           !context.auth_checker->Has(std::vector{label}, memgraph::query::AuthQuery::FineGrainedPrivilege::READ));
+#else
+  return true;
+#endif
+}
+
+}  // namespace
+
 template <class TVerticesFun>
 class ScanAllCursor : public Cursor {
  public:
@@ -461,6 +620,39 @@ class ScanAllCursor : public Cursor {
     return true;
   }
 
+  bool PullBatch(Frame &frame, FrameBatch &batch, ExecutionContext &context) override {
+    SCOPED_PROFILE_OP(op_name_);
+
+    AbortCheck(context);
+
+    batch.Clear();
+    while (!batch.full()) {
+      if (!vertices_ || vertices_it_.value() == vertices_.value().end()) {
+        if (!input_batch_.Next(*input_cursor_, frame, context)) break;
+        auto next_vertices = get_vertices_(input_batch_.row(), context);
+        if (!next_vertices) {
+          vertices_ = std::nullopt;
+          vertices_it_ = std::nullopt;
+          continue;
+        }
+        vertices_.emplace(std::move(next_vertices.value()));
+        vertices_it_.emplace(vertices_.value().begin());
+        continue;
+      }
+#ifdef MG_ENTERPRISE
+      if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
+          !context.auth_checker->Has(*vertices_it_.value(), view_,
+                                     memgraph::query::AuthQuery::FineGrainedPrivilege::READ)) {
+        ++vertices_it_.value();
+        continue;
+      }
+#endif
+      batch.Append(input_batch_.row())[output_symbol_] = *vertices_it_.value();
+      ++vertices_it_.value();
+    }
+    return !batch.empty();
+  }
+
 #ifdef MG_ENTERPRISE
   bool FindNextVertex(const ExecutionContext &context) {
     while (vertices_it_.value() != vertices_.value().end()) {
@@ -480,6 +672,7 @@ class ScanAllCursor : public Cursor {
     input_cursor_->Reset();
     vertices_ = std::nullopt;
     vertices_it_ = std::nullopt;
+    input_batch_.Reset();
   }
 
  private:
@@ -489,6 +682,7 @@ class ScanAllCursor : public Cursor {
   TVerticesFun get_vertices_;
   std::optional<typename std::result_of<TVerticesFun(Frame &, ExecutionContext &)>::type::value_type> vertices_;
   std::optional<decltype(vertices_.value().begin())> vertices_it_;
+  BatchedInput input_batch_;
   const char *op_name_;
 };
 
@@ -501,6 +695,7 @@ UniqueCursorPtr ScanAll::MakeCursor(utils::MemoryResource *mem) const {
   memgraph::metrics::IncrementCounter(memgraph::metrics::ScanAllOperator);
 
   auto vertices = [this](Frame &, ExecutionContext &context) {
+    if (context.scan_morsel) return std::make_optional(std::move(*std::exchange(context.scan_morsel, nullptr)));
     auto *db = context.db_accessor;
     return std::make_optional(db->Vertices(view_));
   };
@@ -515,17 +710,47 @@ std::vector<Symbol> ScanAll::ModifiedSymbols(const SymbolTable &table) const {
 }
 
 ScanAllByLabel::ScanAllByLabel(const std::shared_ptr<LogicalOperator> &input, Symbol output_symbol,
-                               storage::LabelId label, storage::View view)
-    : ScanAll(input, output_symbol, view), label_(label) {}
+                               storage::LabelId label, storage::View view,
+                               std::vector<storage::LabelId> filter_labels,
+                               std::vector<storage::PropertyId> filter_properties,
+                               std::vector<Expression *> filter_values)
+    : ScanAll(input, output_symbol, view),
+      label_(label),
+      filter_labels_(std::move(filter_labels)),
+      filter_properties_(std::move(filter_properties)),
+      filter_values_(std::move(filter_values)) {
+  MG_ASSERT(filter_properties_.size() == filter_values_.size(),
+            "Each filter property of ScanAllByLabel needs a value expression");
+}
 
 ACCEPT_WITH_INPUT(ScanAllByLabel)
 
 UniqueCursorPtr ScanAllByLabel::MakeCursor(utils::MemoryResource *mem) const {
   memgraph::metrics::IncrementCounter(memgraph::metrics::ScanAllByLabelOperator);
 
-  auto vertices = [this](Frame &, ExecutionContext &context) {
+  auto vertices = [this](Frame &frame, ExecutionContext &context)
+      -> std::optional<decltype(context.db_accessor->Vertices(view_, label_))> {
+    // The filters are only a shortcut, a morsel of all vertices with the label
+    // is still checked against them by the Filter above.
+    if (context.scan_morsel) return std::make_optional(std::move(*std::exchange(context.scan_morsel, nullptr)));
+    if (!CanReadLabel(label_, context)) return std::nullopt;
     auto *db = context.db_accessor;
-    return std::make_optional(db->Vertices(view_, label_));
+    if (filter_properties_.empty()) {
+      if (filter_labels_.empty()) return std::make_optional(db->Vertices(view_, label_));
+      return std::make_optional(db->Vertices(view_, label_, filter_labels_));
+    }
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor, view_);
+    std::vector<std::pair<storage::PropertyId, storage::PropertyValue>> filter_properties;
+    filter_properties.reserve(filter_properties_.size());
+    for (size_t i = 0; i < filter_properties_.size(); ++i) {
+      auto value = filter_values_[i]->Accept(evaluator);
+      // Equality with null is never true, so no vertex passes the Filter.
+      if (value.IsNull()) return std::nullopt;
+      // Other values are compared by the Filter only.
+      if (!value.IsPropertyValue()) continue;
+      filter_properties.emplace_back(filter_properties_[i], storage::PropertyValue(value));
+    }
+    return std::make_optional(db->Vertices(view_, label_, filter_labels_, filter_properties));
   };
   return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem), view_,
                                                                 std::move(vertices), "ScanAllByLabel");
@@ -534,6 +759,38 @@ UniqueCursorPtr ScanAllByLabel::MakeCursor(utils::MemoryResource *mem) const {
 // TODO(buda): Implement ScanAllByLabelProperty operator to iterate over
 // vertices that have the label and some value for the given property.
 
+namespace {
+// Evaluates the bound expression into a bound on the property value.
+std::optional<utils::Bound<storage::PropertyValue>> EvaluateBound(
+    ExpressionEvaluator &evaluator, const std::optional<utils::Bound<Expression *>> &bound) {
+  if (!bound) return std::nullopt;
+  const auto &value = bound->value()->Accept(evaluator);
+  try {
+    const auto &property_value = storage::PropertyValue(value);
+    switch (property_value.type()) {
+      case storage::PropertyValue::Type::Bool:
+      case storage::PropertyValue::Type::List:
+      case storage::PropertyValue::Type::Map:
+        // Prevent indexed lookup with something that would fail if we did
+        // the original filter with `operator<`. Note, for some reason,
+        // Cypher does not support comparing boolean values.
+        throw QueryRuntimeException("Invalid type {} for '<'.", value.type());
+      case storage::PropertyValue::Type::Null:
+      case storage::PropertyValue::Type::Int:
+      case storage::PropertyValue::Type::Double:
+      case storage::PropertyValue::Type::String:
+      case storage::PropertyValue::Type::TemporalData:
+        // These are all fine, there's also Point, Date and Time data types
+        // which were added to Cypher, but we don't have support for those
+        // yet.
+        return std::make_optional(utils::Bound<storage::PropertyValue>(property_value, bound->type()));
+    }
+  } catch (const TypedValueException &) {
+    throw QueryRuntimeException("'{}' cannot be used as a property value.", value.type());
+  }
+}
+}  // namespace
+
 ScanAllByLabelPropertyRange::ScanAllByLabelPropertyRange(const std::shared_ptr<LogicalOperator> &input,
                                                          Symbol output_symbol, storage::LabelId label,
                                                          storage::PropertyId property, const std::string &property_name,
@@ -555,41 +812,29 @@ UniqueCursorPtr ScanAllByLabelPropertyRange::MakeCursor(utils::MemoryResource *m
 
   auto vertices = [this](Frame &frame, ExecutionContext &context)
       -> std::optional<decltype(context.db_accessor->Vertices(view_, label_, property_, std::nullopt, std::nullopt))> {
+    if (!CanReadLabel(label_, context)) return std::nullopt;
     auto *db = context.db_accessor;
     ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor, view_);
-    auto convert = [&evaluator](const auto &bound) -> std::optional<utils::Bound<storage::PropertyValue>> {
-      if (!bound) return std::nullopt;
-      const auto &value = bound->value()->Accept(evaluator);
-      try {
-        const auto &property_value = storage::PropertyValue(value);
-        switch (property_value.type()) {
-          case storage::PropertyValue::Type::Bool:
-          case storage::PropertyValue::Type::List:
-          case storage::PropertyValue::Type::Map:
-            // Prevent indexed lookup with something that would fail if we did
-            // the original filter with `operator<`. Note, for some reason,
-            // Cypher does not support comparing boolean values.
-            throw QueryRuntimeException("Invalid type {} for '<'.", value.type());
-          case storage::PropertyValue::Type::Null:
-          case storage::PropertyValue::Type::Int:
-          case storage::PropertyValue::Type::Double:
-          case storage::PropertyValue::Type::String:
-          case storage::PropertyValue::Type::TemporalData:
-            // These are all fine, there's also Point, Date and Time data types
-            // which were added to Cypher, but we don't have support for those
-            // yet.
-            return std::make_optional(utils::Bound<storage::PropertyValue>(property_value, bound->type()));
-        }
-      } catch (const TypedValueException &) {
-        throw QueryRuntimeException("'{}' cannot be used as a property value.", value.type());
-      }
-    };
-    auto maybe_lower = convert(lower_bound_);
-    auto maybe_upper = convert(upper_bound_);
+    auto maybe_lower = EvaluateBound(evaluator, lower_bound_);
+    auto maybe_upper = EvaluateBound(evaluator, upper_bound_);
     // If any bound is null, then the comparison would result in nulls. This
     // is treated as not satisfying the filter, so return no vertices.
     if (maybe_lower && maybe_lower->value().IsNull()) return std::nullopt;
     if (maybe_upper && maybe_upper->value().IsNull()) return std::nullopt;
+    if (regex_) {
+      const auto pattern = regex_->Accept(evaluator);
+      if (pattern.IsNull()) return std::nullopt;
+      // The patterns of other types are reported by the filter of the match.
+      if (pattern.IsString()) {
+        auto prefix = utils::RegexLiteralPrefix(pattern.ValueString());
+        if (!prefix.empty()) {
+          if (auto upper = utils::PrefixUpperBound(prefix)) {
+            maybe_upper = utils::MakeBoundExclusive(storage::PropertyValue(std::move(*upper)));
+          }
+          maybe_lower = utils::MakeBoundInclusive(storage::PropertyValue(std::move(prefix)));
+        }
+      }
+    }
     return std::make_optional(db->Vertices(view_, label_, property_, maybe_lower, maybe_upper));
   };
   return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem), view_,
@@ -615,6 +860,7 @@ UniqueCursorPtr ScanAllByLabelPropertyValue::MakeCursor(utils::MemoryResource *m
 
   auto vertices = [this](Frame &frame, ExecutionContext &context)
       -> std::optional<decltype(context.db_accessor->Vertices(view_, label_, property_, storage::PropertyValue()))> {
+    if (!CanReadLabel(label_, context)) return std::nullopt;
     auto *db = context.db_accessor;
     ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor, view_);
     auto value = expression_->Accept(evaluator);
@@ -628,6 +874,51 @@ UniqueCursorPtr ScanAllByLabelPropertyValue::MakeCursor(utils::MemoryResource *m
                                                                 std::move(vertices), "ScanAllByLabelPropertyValue");
 }
 
+ScanAllByLabelPropertyValues::ScanAllByLabelPropertyValues(const std::shared_ptr<LogicalOperator> &input,
+                                                           Symbol output_symbol, storage::LabelId label,
+                                                           storage::PropertyId property,
+                                                           const std::string &property_name, Expression *expression,
+                                                           storage::View view)
+    : ScanAll(input, output_symbol, view),
+      label_(label),
+      property_(property),
+      property_name_(property_name),
+      expression_(expression) {
+  DMG_ASSERT(expression, "Expression is not optional.");
+}
+
+ACCEPT_WITH_INPUT(ScanAllByLabelPropertyValues)
+
+UniqueCursorPtr ScanAllByLabelPropertyValues::MakeCursor(utils::MemoryResource *mem) const {
+  memgraph::metrics::IncrementCounter(memgraph::metrics::ScanAllByLabelPropertyValuesOperator);
+
+  auto vertices = [this](Frame &frame, ExecutionContext &context)
+      -> std::optional<decltype(context.db_accessor->Vertices(view_, label_, property_,
+                                                              std::vector<storage::PropertyValue>()))> {
+    if (!CanReadLabel(label_, context)) return std::nullopt;
+    auto *db = context.db_accessor;
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor, view_);
+    auto list = expression_->Accept(evaluator);
+    if (list.IsNull()) return std::nullopt;
+    if (!list.IsList()) {
+      throw QueryRuntimeException("IN expected a list, got {}.", list.type());
+    }
+    std::vector<storage::PropertyValue> values;
+    values.reserve(list.ValueList().size());
+    for (const auto &value : list.ValueList()) {
+      // Nothing is equal to Null, so it doesn't match any vertex.
+      if (value.IsNull()) continue;
+      if (!value.IsPropertyValue()) {
+        throw QueryRuntimeException("'{}' cannot be used as a property value.", value.type());
+      }
+      values.emplace_back(value);
+    }
+    return std::make_optional(db->Vertices(view_, label_, property_, values));
+  };
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem), view_,
+                                                                std::move(vertices), "ScanAllByLabelPropertyValues");
+}
+
 ScanAllByLabelProperty::ScanAllByLabelProperty(const std::shared_ptr<LogicalOperator> &input, Symbol output_symbol,
                                                storage::LabelId label, storage::PropertyId property,
                                                const std::string &property_name, storage::View view)
@@ -638,7 +929,9 @@ ACCEPT_WITH_INPUT(ScanAllByLabelProperty)
 UniqueCursorPtr ScanAllByLabelProperty::MakeCursor(utils::MemoryResource *mem) const {
   memgraph::metrics::IncrementCounter(memgraph::metrics::ScanAllByLabelPropertyOperator);
 
-  auto vertices = [this](Frame &frame, ExecutionContext &context) {
+  auto vertices = [this](Frame &frame, ExecutionContext &context)
+      -> std::optional<decltype(context.db_accessor->Vertices(view_, label_, property_))> {
+    if (!CanReadLabel(label_, context)) return std::nullopt;
     auto *db = context.db_accessor;
     return std::make_optional(db->Vertices(view_, label_, property_));
   };
@@ -646,6 +939,53 @@ UniqueCursorPtr ScanAllByLabelProperty::MakeCursor(utils::MemoryResource *mem) c
                                                                 std::move(vertices), "ScanAllByLabelProperty");
 }
 
+ScanAllByLabelPropertyComposite::ScanAllByLabelPropertyComposite(
+    const std::shared_ptr<LogicalOperator> &input, Symbol output_symbol, storage::LabelId label,
+    std::vector<storage::PropertyId> properties, std::vector<Expression *> prefix, std::optional<Bound> lower_bound,
+    std::optional<Bound> upper_bound, storage::View view)
+    : ScanAll(input, output_symbol, view),
+      label_(label),
+      properties_(std::move(properties)),
+      prefix_(std::move(prefix)),
+      lower_bound_(lower_bound),
+      upper_bound_(upper_bound) {
+  MG_ASSERT(!prefix_.empty(), "Composite index lookup requires at least one property value");
+  MG_ASSERT(prefix_.size() + ((lower_bound_ || upper_bound_) ? 1 : 0) <= properties_.size(),
+            "Composite index lookup uses more properties than the index has");
+}
+
+ACCEPT_WITH_INPUT(ScanAllByLabelPropertyComposite)
+
+UniqueCursorPtr ScanAllByLabelPropertyComposite::MakeCursor(utils::MemoryResource *mem) const {
+  memgraph::metrics::IncrementCounter(memgraph::metrics::ScanAllByLabelPropertyCompositeOperator);
+
+  auto vertices = [this](Frame &frame, ExecutionContext &context)
+      -> std::optional<decltype(context.db_accessor->Vertices(view_, label_, properties_, {}, std::nullopt,
+                                                              std::nullopt))> {
+    if (!CanReadLabel(label_, context)) return std::nullopt;
+    auto *db = context.db_accessor;
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor, view_);
+    std::vector<storage::PropertyValue> prefix_values;
+    prefix_values.reserve(prefix_.size());
+    for (auto *expression : prefix_) {
+      auto value = expression->Accept(evaluator);
+      // Comparing with null never satisfies the filter, so return no vertices.
+      if (value.IsNull()) return std::nullopt;
+      if (!value.IsPropertyValue()) {
+        throw QueryRuntimeException("'{}' cannot be used as a property value.", value.type());
+      }
+      prefix_values.emplace_back(value);
+    }
+    auto maybe_lower = EvaluateBound(evaluator, lower_bound_);
+    auto maybe_upper = EvaluateBound(evaluator, upper_bound_);
+    if (maybe_lower && maybe_lower->value().IsNull()) return std::nullopt;
+    if (maybe_upper && maybe_upper->value().IsNull()) return std::nullopt;
+    return std::make_optional(db->Vertices(view_, label_, properties_, prefix_values, maybe_lower, maybe_upper));
+  };
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem), view_,
+                                                                std::move(vertices), "ScanAllByLabelPropertyComposite");
+}
+
 ScanAllById::ScanAllById(const std::shared_ptr<LogicalOperator> &input, Symbol output_symbol, Expression *expression,
                          storage::View view)
     : ScanAll(input, output_symbol, view), expression_(expression) {
@@ -672,6 +1012,140 @@ UniqueCursorPtr ScanAllById::MakeCursor(utils::MemoryResource *mem) const {
                                                                 std::move(vertices), "ScanAllById");
 }
 
+namespace {
+
+template <typename TEdgesFun>
+class ScanAllByEdgeTypeCursor : public Cursor {
+ public:
+  ScanAllByEdgeTypeCursor(const ScanAllByEdgeType &self, UniqueCursorPtr input_cursor, TEdgesFun get_edges,
+                          const char *op_name)
+      : self_(self), input_cursor_(std::move(input_cursor)), get_edges_(std::move(get_edges)), op_name_(op_name) {}
+
+  bool Pull(Frame &frame, ExecutionContext &context) override {
+    SCOPED_PROFILE_OP(op_name_);
+
+    AbortCheck(context);
+
+    while (true) {
+      while (!edges_ || edges_it_.value() == edges_.value().end()) {
+        if (!input_cursor_->Pull(frame, context)) return false;
+        auto next_edges = get_edges_(frame, context);
+        if (!next_edges) continue;
+        // Same as in ScanAllCursor, the iterable has to be emplaced.
+        edges_.emplace(std::move(next_edges.value()));
+        edges_it_.emplace(edges_.value().begin());
+      }
+
+      auto edge = *edges_it_.value();
+      ++edges_it_.value();
+#ifdef MG_ENTERPRISE
+      if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
+          !(context.auth_checker->Has(edge, memgraph::query::AuthQuery::FineGrainedPrivilege::READ) &&
+            context.auth_checker->Has(edge.From(), self_.view_,
+                                      memgraph::query::AuthQuery::FineGrainedPrivilege::READ) &&
+            context.auth_checker->Has(edge.To(), self_.view_,
+                                      memgraph::query::AuthQuery::FineGrainedPrivilege::READ))) {
+        continue;
+      }
+#endif
+      frame[self_.from_symbol_] = edge.From();
+      frame[self_.to_symbol_] = edge.To();
+      frame[self_.edge_symbol_] = edge;
+      return true;
+    }
+  }
+
+  void Shutdown() override { input_cursor_->Shutdown(); }
+
+  void Reset() override {
+    input_cursor_->Reset();
+    edges_ = std::nullopt;
+    edges_it_ = std::nullopt;
+  }
+
+ private:
+  const ScanAllByEdgeType &self_;
+  const UniqueCursorPtr input_cursor_;
+  TEdgesFun get_edges_;
+  std::optional<typename std::result_of<TEdgesFun(Frame &, ExecutionContext &)>::type::value_type> edges_;
+  std::optional<decltype(edges_.value().begin())> edges_it_;
+  const char *op_name_;
+};
+
+}  // namespace
+
+ScanAllByEdgeType::ScanAllByEdgeType(const std::shared_ptr<LogicalOperator> &input, Symbol edge_symbol,
+                                     Symbol from_symbol, Symbol to_symbol, storage::EdgeTypeId edge_type,
+                                     storage::View view)
+    : input_(input ? input : std::make_shared<Once>()),
+      edge_symbol_(edge_symbol),
+      from_symbol_(from_symbol),
+      to_symbol_(to_symbol),
+      edge_type_(edge_type),
+      view_(view) {}
+
+ACCEPT_WITH_INPUT(ScanAllByEdgeType)
+
+UniqueCursorPtr ScanAllByEdgeType::MakeCursor(utils::MemoryResource *mem) const {
+  memgraph::metrics::IncrementCounter(memgraph::metrics::ScanAllByEdgeTypeOperator);
+
+  auto edges = [this](Frame &, ExecutionContext &context) {
+    auto *db = context.db_accessor;
+    return std::make_optional(db->Edges(view_, edge_type_));
+  };
+  return MakeUniqueCursorPtr<ScanAllByEdgeTypeCursor<decltype(edges)>>(mem, *this, input_->MakeCursor(mem),
+                                                                       std::move(edges), "ScanAllByEdgeType");
+}
+
+std::vector<Symbol> ScanAllByEdgeType::ModifiedSymbols(const SymbolTable &table) const {
+  auto symbols = input_->ModifiedSymbols(table);
+  symbols.emplace_back(from_symbol_);
+  symbols.emplace_back(to_symbol_);
+  symbols.emplace_back(edge_symbol_);
+  return symbols;
+}
+
+ScanAllByEdgeTypeProperty::ScanAllByEdgeTypeProperty(const std::shared_ptr<LogicalOperator> &input,
+                                                     Symbol edge_symbol, Symbol from_symbol, Symbol to_symbol,
+                                                     storage::EdgeTypeId edge_type, storage::PropertyId property,
+                                                     Expression *expression, std::optional<Bound> lower_bound,
+                                                     std::optional<Bound> upper_bound, storage::View view)
+    : ScanAllByEdgeType(input, edge_symbol, from_symbol, to_symbol, edge_type, view),
+      property_(property),
+      expression_(expression),
+      lower_bound_(lower_bound),
+      upper_bound_(upper_bound) {
+  MG_ASSERT(!expression_ || (!lower_bound_ && !upper_bound_),
+            "Edge-type+property index lookup takes either a value or bounds");
+}
+
+ACCEPT_WITH_INPUT(ScanAllByEdgeTypeProperty)
+
+UniqueCursorPtr ScanAllByEdgeTypeProperty::MakeCursor(utils::MemoryResource *mem) const {
+  memgraph::metrics::IncrementCounter(memgraph::metrics::ScanAllByEdgeTypePropertyOperator);
+
+  auto edges = [this](Frame &frame, ExecutionContext &context)
+      -> std::optional<decltype(context.db_accessor->Edges(view_, edge_type_, property_, std::nullopt, std::nullopt))> {
+    auto *db = context.db_accessor;
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor, view_);
+    if (expression_) {
+      auto value = expression_->Accept(evaluator);
+      if (value.IsNull()) return std::nullopt;
+      if (!value.IsPropertyValue()) {
+        throw QueryRuntimeException("'{}' cannot be used as a property value.", value.type());
+      }
+      return std::make_optional(db->Edges(view_, edge_type_, property_, storage::PropertyValue(value)));
+    }
+    auto maybe_lower = EvaluateBound(evaluator, lower_bound_);
+    auto maybe_upper = EvaluateBound(evaluator, upper_bound_);
+    if (maybe_lower && maybe_lower->value().IsNull()) return std::nullopt;
+    if (maybe_upper && maybe_upper->value().IsNull()) return std::nullopt;
+    return std::make_optional(db->Edges(view_, edge_type_, property_, maybe_lower, maybe_upper));
+  };
+  return MakeUniqueCursorPtr<ScanAllByEdgeTypeCursor<decltype(edges)>>(mem, *this, input_->MakeCursor(mem),
+                                                                       std::move(edges), "ScanAllByEdgeTypeProperty");
+}
+
 namespace {
 bool CheckExistingNode(const VertexAccessor &new_node, const Symbol &existing_node_sym, Frame &frame) {
   const TypedValue &existing_node = frame[existing_node_sym];
@@ -728,57 +1202,10 @@ Expand::ExpandCursor::ExpandCursor(const Expand &self, utils::MemoryResource *me
 bool Expand::ExpandCursor::Pull(Frame &frame, ExecutionContext &context) {
   SCOPED_PROFILE_OP("Expand");
 
-  // A helper function for expanding a node from an edge.
-  auto pull_node = [this, &frame](const EdgeAccessor &new_edge, EdgeAtom::Direction direction) {
-    if (self_.common_.existing_node) return;
-    switch (direction) {
-      case EdgeAtom::Direction::IN:
-        frame[self_.common_.node_symbol] = new_edge.From();
-        break;
-      case EdgeAtom::Direction::OUT:
-        frame[self_.common_.node_symbol] = new_edge.To();
-        break;
-      case EdgeAtom::Direction::BOTH:
-        LOG_FATAL("Must indicate exact expansion direction here");
-    }
-  };
-
   while (true) {
     AbortCheck(context);
-    // attempt to get a value from the incoming edges
-    if (in_edges_ && *in_edges_it_ != in_edges_->end()) {
-      auto edge = *(*in_edges_it_)++;
-#ifdef MG_ENTERPRISE
-      if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
-          !(context.auth_checker->Has(edge, memgraph::query::AuthQuery::FineGrainedPrivilege::READ) &&
-            context.auth_checker->Has(edge.From(), self_.view_,
-                                      memgraph::query::AuthQuery::FineGrainedPrivilege::READ))) {
-        continue;
-      }
-#endif
-
-      frame[self_.common_.edge_symbol] = edge;
-      pull_node(edge, EdgeAtom::Direction::IN);
-      return true;
-    }
-
-    // attempt to get a value from the outgoing edges
-    if (out_edges_ && *out_edges_it_ != out_edges_->end()) {
-      auto edge = *(*out_edges_it_)++;
-      // when expanding in EdgeAtom::Direction::BOTH directions
-      // we should do only one expansion for cycles, and it was
-      // already done in the block above
-      if (self_.common_.direction == EdgeAtom::Direction::BOTH && edge.IsCycle()) continue;
-#ifdef MG_ENTERPRISE
-      if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
-          !(context.auth_checker->Has(edge, memgraph::query::AuthQuery::FineGrainedPrivilege::READ) &&
-            context.auth_checker->Has(edge.To(), self_.view_,
-                                      memgraph::query::AuthQuery::FineGrainedPrivilege::READ))) {
-        continue;
-      }
-#endif
-      frame[self_.common_.edge_symbol] = edge;
-      pull_node(edge, EdgeAtom::Direction::OUT);
+    if (auto next = NextEdge(context)) {
+      SetExpansion(frame, next->first, next->second);
       return true;
     }
 
@@ -790,70 +1217,186 @@ bool Expand::ExpandCursor::Pull(Frame &frame, ExecutionContext &context) {
   }
 }
 
-void Expand::ExpandCursor::Shutdown() { input_cursor_->Shutdown(); }
-
-void Expand::ExpandCursor::Reset() {
-  input_cursor_->Reset();
-  in_edges_ = std::nullopt;
-  in_edges_it_ = std::nullopt;
-  out_edges_ = std::nullopt;
-  out_edges_it_ = std::nullopt;
-}
+bool Expand::ExpandCursor::PullBatch(Frame &frame, FrameBatch &batch, ExecutionContext &context) {
+  SCOPED_PROFILE_OP("Expand");
 
-bool Expand::ExpandCursor::InitEdges(Frame &frame, ExecutionContext &context) {
-  // Input Vertex could be null if it is created by a failed optional match. In
-  // those cases we skip that input pull and continue with the next.
-  while (true) {
-    if (!input_cursor_->Pull(frame, context)) return false;
-    TypedValue &vertex_value = frame[self_.input_symbol_];
+  AbortCheck(context);
 
-    // Null check due to possible failed optional match.
-    if (vertex_value.IsNull()) continue;
+  batch.Clear();
+  while (!batch.full()) {
+    if (auto next = NextEdge(context)) {
+      SetExpansion(batch.Append(input_batch_.row()), next->first, next->second);
+      continue;
+    }
+    // The edges of the current input row are exhausted, move to the next row.
+    do {
+      if (!input_batch_.Next(*input_cursor_, frame, context)) return !batch.empty();
+      if (input_batch_.PulledBatch()) PrefetchBatch(context);
+    } while (!InitEdgesOf(input_batch_.row(), context));
+  }
+  return true;
+}
 
-    ExpectType(self_.input_symbol_, vertex_value, TypedValue::Type::Vertex);
-    auto &vertex = vertex_value.ValueVertex();
+void Expand::ExpandCursor::PrefetchBatch(ExecutionContext &context) {
+  batch_prefetched_ = context.db_accessor->GetStorageMode() == storage::StorageMode::ON_DISK_TRANSACTIONAL;
+  if (!batch_prefetched_) return;
 
-    auto direction = self_.common_.direction;
-    if (direction == EdgeAtom::Direction::IN || direction == EdgeAtom::Direction::BOTH) {
-      if (self_.common_.existing_node) {
-        TypedValue &existing_node = frame[self_.common_.node_symbol];
-        // old_node_value may be Null when using optional matching
-        if (!existing_node.IsNull()) {
-          ExpectType(self_.common_.node_symbol, existing_node, TypedValue::Type::Vertex);
-          context.db_accessor->PrefetchInEdges(vertex);
-          in_edges_.emplace(
-              UnwrapEdgesResult(vertex.InEdges(self_.view_, self_.common_.edge_types, existing_node.ValueVertex())));
+  std::vector<VertexAccessor> vertices;
+  auto &rows = input_batch_.batch();
+  vertices.reserve(rows.size());
+  for (size_t row = 0; row < rows.size(); ++row) {
+    const auto &vertex_value = rows[row][self_.input_symbol_];
+    // The rows without a vertex are reported when they are expanded.
+    if (vertex_value.IsVertex()) vertices.push_back(vertex_value.ValueVertex());
+  }
+  const auto direction = self_.common_.direction;
+  if (direction == EdgeAtom::Direction::IN || direction == EdgeAtom::Direction::BOTH) {
+    context.db_accessor->PrefetchInEdges(vertices);
+  }
+  if (direction == EdgeAtom::Direction::OUT || direction == EdgeAtom::Direction::BOTH) {
+    context.db_accessor->PrefetchOutEdges(vertices);
+  }
+}
+
+std::optional<std::pair<EdgeAccessor, EdgeAtom::Direction>> Expand::ExpandCursor::NextEdge(
+    ExecutionContext &context) {
+  // attempt to get a value from the incoming edges
+  while (in_edges_ && *in_edges_it_ != in_edges_->end()) {
+    auto edge = *(*in_edges_it_)++;
+#ifdef MG_ENTERPRISE
+    if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
+        !(context.auth_checker->Has(edge, memgraph::query::AuthQuery::FineGrainedPrivilege::READ) &&
+          context.auth_checker->Has(edge.From(), self_.view_,
+                                    memgraph::query::AuthQuery::FineGrainedPrivilege::READ))) {
+      continue;
+    }
+#endif
+    return std::make_pair(edge, EdgeAtom::Direction::IN);
+  }
+
+  // attempt to get a value from the outgoing edges
+  while (out_edges_ && *out_edges_it_ != out_edges_->end()) {
+    auto edge = *(*out_edges_it_)++;
+    // when expanding in EdgeAtom::Direction::BOTH directions
+    // we should do only one expansion for cycles, and it was
+    // already done in the block above
+    if (self_.common_.direction == EdgeAtom::Direction::BOTH && edge.IsCycle()) continue;
+#ifdef MG_ENTERPRISE
+    if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
+        !(context.auth_checker->Has(edge, memgraph::query::AuthQuery::FineGrainedPrivilege::READ) &&
+          context.auth_checker->Has(edge.To(), self_.view_, memgraph::query::AuthQuery::FineGrainedPrivilege::READ))) {
+      continue;
+    }
+#endif
+    return std::make_pair(edge, EdgeAtom::Direction::OUT);
+  }
+  return std::nullopt;
+}
+
+void Expand::ExpandCursor::SetExpansion(Frame &frame, const EdgeAccessor &edge, EdgeAtom::Direction direction) const {
+  frame[self_.common_.edge_symbol] = edge;
+  if (self_.common_.existing_node) return;
+  switch (direction) {
+    case EdgeAtom::Direction::IN:
+      frame[self_.common_.node_symbol] = edge.From();
+      break;
+    case EdgeAtom::Direction::OUT:
+      frame[self_.common_.node_symbol] = edge.To();
+      break;
+    case EdgeAtom::Direction::BOTH:
+      LOG_FATAL("Must indicate exact expansion direction here");
+  }
+}
+
+void Expand::ExpandCursor::Shutdown() { input_cursor_->Shutdown(); }
+
+void Expand::ExpandCursor::Reset() {
+  input_cursor_->Reset();
+  in_edges_ = std::nullopt;
+  in_edges_it_ = std::nullopt;
+  out_edges_ = std::nullopt;
+  out_edges_it_ = std::nullopt;
+  input_batch_.Reset();
+  batch_prefetched_ = false;
+}
+
+bool Expand::ExpandCursor::InitEdges(Frame &frame, ExecutionContext &context) {
+  // Input Vertex could be null if it is created by a failed optional match. In
+  // those cases we skip that input pull and continue with the next.
+  while (true) {
+    if (!input_cursor_->Pull(frame, context)) return false;
+    if (InitEdgesOf(frame, context)) return true;
+  }
+}
+
+bool Expand::ExpandCursor::InitEdgesOf(Frame &frame, ExecutionContext &context) {
+  TypedValue &vertex_value = frame[self_.input_symbol_];
+
+  // Null check due to possible failed optional match.
+  if (vertex_value.IsNull()) return false;
+
+  ExpectType(self_.input_symbol_, vertex_value, TypedValue::Type::Vertex);
+  auto &vertex = vertex_value.ValueVertex();
+
+  auto direction = self_.common_.direction;
+  // With both ends bound the edges can be looked up from either of them, so
+  // the end with fewer edges is used and a supernode on the other end costs
+  // nothing. The on-disk storage loads the edges only when they are read, so
+  // the degrees aren't known in advance there.
+  const bool choose_end = self_.common_.existing_node &&
+                          context.db_accessor->GetStorageMode() != storage::StorageMode::ON_DISK_TRANSACTIONAL;
+  // The edges of the input vertex were already prefetched with the rest of
+  // its batch.
+  const bool prefetch = !batch_prefetched_;
+  if (direction == EdgeAtom::Direction::IN || direction == EdgeAtom::Direction::BOTH) {
+    if (self_.common_.existing_node) {
+      TypedValue &existing_node = frame[self_.common_.node_symbol];
+      // old_node_value may be Null when using optional matching
+      if (!existing_node.IsNull()) {
+        ExpectType(self_.common_.node_symbol, existing_node, TypedValue::Type::Vertex);
+        const auto &from = existing_node.ValueVertex();
+        if (choose_end && from.ApproximateOutDegree() < vertex.ApproximateInDegree()) {
+          context.db_accessor->PrefetchOutEdges(from);
+          in_edges_.emplace(UnwrapEdgesResult(from.OutEdges(self_.view_, self_.common_.edge_types, vertex)));
+        } else {
+          if (prefetch) context.db_accessor->PrefetchInEdges(vertex);
+          in_edges_.emplace(UnwrapEdgesResult(vertex.InEdges(self_.view_, self_.common_.edge_types, from)));
         }
-      } else {
-        context.db_accessor->PrefetchInEdges(vertex);
-        in_edges_.emplace(UnwrapEdgesResult(vertex.InEdges(self_.view_, self_.common_.edge_types)));
-      }
-      if (in_edges_) {
-        in_edges_it_.emplace(in_edges_->begin());
       }
+    } else {
+      if (prefetch) context.db_accessor->PrefetchInEdges(vertex);
+      in_edges_.emplace(UnwrapEdgesResult(vertex.InEdges(self_.view_, self_.common_.edge_types)));
     }
+    if (in_edges_) {
+      in_edges_it_.emplace(in_edges_->begin());
+    }
+  }
 
-    if (direction == EdgeAtom::Direction::OUT || direction == EdgeAtom::Direction::BOTH) {
-      if (self_.common_.existing_node) {
-        TypedValue &existing_node = frame[self_.common_.node_symbol];
-        // old_node_value may be Null when using optional matching
-        if (!existing_node.IsNull()) {
-          ExpectType(self_.common_.node_symbol, existing_node, TypedValue::Type::Vertex);
-          context.db_accessor->PrefetchOutEdges(vertex);
-          out_edges_.emplace(
-              UnwrapEdgesResult(vertex.OutEdges(self_.view_, self_.common_.edge_types, existing_node.ValueVertex())));
+  if (direction == EdgeAtom::Direction::OUT || direction == EdgeAtom::Direction::BOTH) {
+    if (self_.common_.existing_node) {
+      TypedValue &existing_node = frame[self_.common_.node_symbol];
+      // old_node_value may be Null when using optional matching
+      if (!existing_node.IsNull()) {
+        ExpectType(self_.common_.node_symbol, existing_node, TypedValue::Type::Vertex);
+        const auto &to = existing_node.ValueVertex();
+        if (choose_end && to.ApproximateInDegree() < vertex.ApproximateOutDegree()) {
+          context.db_accessor->PrefetchInEdges(to);
+          out_edges_.emplace(UnwrapEdgesResult(to.InEdges(self_.view_, self_.common_.edge_types, vertex)));
+        } else {
+          if (prefetch) context.db_accessor->PrefetchOutEdges(vertex);
+          out_edges_.emplace(UnwrapEdgesResult(vertex.OutEdges(self_.view_, self_.common_.edge_types, to)));
         }
-      } else {
-        context.db_accessor->PrefetchOutEdges(vertex);
-        out_edges_.emplace(UnwrapEdgesResult(vertex.OutEdges(self_.view_, self_.common_.edge_types)));
-      }
-      if (out_edges_) {
-        out_edges_it_.emplace(out_edges_->begin());
       }
+    } else {
+      if (prefetch) context.db_accessor->PrefetchOutEdges(vertex);
+      out_edges_.emplace(UnwrapEdgesResult(vertex.OutEdges(self_.view_, self_.common_.edge_types)));
+    }
+    if (out_edges_) {
+      out_edges_it_.emplace(out_edges_->begin());
     }
-
-    return true;
   }
+
+  return true;
 }
 
 ExpandVariable::ExpandVariable(const std::shared_ptr<LogicalOperator> &input, Symbol input_symbol, Symbol node_symbol,
@@ -885,6 +1428,7 @@ std::vector<Symbol> ExpandVariable::ModifiedSymbols(const SymbolTable &table) co
   auto symbols = input_->ModifiedSymbols(table);
   symbols.emplace_back(common_.node_symbol);
   symbols.emplace_back(common_.edge_symbol);
+  if (path_count_symbol_) symbols.emplace_back(*path_count_symbol_);
   return symbols;
 }
 
@@ -938,7 +1482,7 @@ auto ExpandFromVertex(const VertexAccessor &vertex, EdgeAtom::Direction directio
 class ExpandVariableCursor : public Cursor {
  public:
   ExpandVariableCursor(const ExpandVariable &self, utils::MemoryResource *mem)
-      : self_(self), input_cursor_(self.input_->MakeCursor(mem)), edges_(mem), edges_it_(mem) {}
+      : self_(self), input_cursor_(self.input_->MakeCursor(mem)), edges_(mem), edges_it_(mem), path_edges_(mem) {}
 
   bool Pull(Frame &frame, ExecutionContext &context) override {
     SCOPED_PROFILE_OP("ExpandVariable");
@@ -974,6 +1518,7 @@ class ExpandVariableCursor : public Cursor {
     input_cursor_->Reset();
     edges_.clear();
     edges_it_.clear();
+    path_edges_.clear();
   }
 
  private:
@@ -995,6 +1540,9 @@ class ExpandVariableCursor : public Cursor {
   utils::pmr::vector<ExpandEdges> edges_;
   // an iterator indicating the position in the corresponding edges_ element
   utils::pmr::vector<decltype(edges_.begin()->begin())> edges_it_;
+  // the edges of the path on the frame, so the uniqueness of an edge is
+  // checked without going through the path
+  utils::pmr::unordered_set<storage::Gid> path_edges_;
 
   /**
    * Helper function that Pulls from the input vertex and
@@ -1039,26 +1587,38 @@ class ExpandVariableCursor : public Cursor {
       // reset the frame value to an empty edge list
       auto *pull_memory = context.evaluation_context.memory;
       frame[self_.common_.edge_symbol] = TypedValue::TVector(pull_memory);
+      path_edges_.clear();
 
       return true;
     }
   }
 
+  // Helper function for removing the edges past the given length of the path
+  // from the list on the frame. The path is built from its end if the
+  // expansion is reversed, so the edges are then removed from the front.
+  void TruncatePath(utils::pmr::vector<TypedValue> *edges_on_frame, size_t length) {
+    if (edges_on_frame->size() <= length) return;
+    const auto diff = edges_on_frame->size() - length;
+    const auto removed_begin = self_.is_reverse_ ? edges_on_frame->begin() : edges_on_frame->begin() + length;
+    const auto removed_end = removed_begin + diff;
+    for (auto it = removed_begin; it != removed_end; ++it) path_edges_.erase(it->ValueEdge().Gid());
+    // TODO: This is innefficient for the reversed expansion, we should look
+    // into replacing vector with something else for TypedValue::List.
+    edges_on_frame->erase(removed_begin, removed_end);
+  }
+
   // Helper function for appending an edge to the list on the frame.
   void AppendEdge(const EdgeAccessor &new_edge, utils::pmr::vector<TypedValue> *edges_on_frame) {
     // We are placing an edge on the frame. It is possible that there already
     // exists an edge on the frame for this level. If so first remove it.
     DMG_ASSERT(edges_.size() > 0, "Edges are empty");
+    TruncatePath(edges_on_frame, edges_.size() - 1U);
     if (self_.is_reverse_) {
-      // TODO: This is innefficient, we should look into replacing
-      // vector with something else for TypedValue::List.
-      size_t diff = edges_on_frame->size() - std::min(edges_on_frame->size(), edges_.size() - 1U);
-      if (diff > 0U) edges_on_frame->erase(edges_on_frame->begin(), edges_on_frame->begin() + diff);
       edges_on_frame->emplace(edges_on_frame->begin(), new_edge);
     } else {
-      edges_on_frame->resize(std::min(edges_on_frame->size(), edges_.size() - 1U));
       edges_on_frame->emplace_back(new_edge);
     }
+    path_edges_.insert(new_edge.Gid());
   }
 
   /**
@@ -1095,23 +1655,13 @@ class ExpandVariableCursor : public Cursor {
       // elements as edges_ due to edge-uniqueness (when a whole layer
       // gets exhausted but no edges are valid). for that reason only
       // pop from edges_on_frame if they contain enough elements
-      if (self_.is_reverse_) {
-        auto diff = edges_on_frame.size() - std::min(edges_on_frame.size(), edges_.size());
-        if (diff > 0) {
-          edges_on_frame.erase(edges_on_frame.begin(), edges_on_frame.begin() + diff);
-        }
-      } else {
-        edges_on_frame.resize(std::min(edges_on_frame.size(), edges_.size()));
-      }
+      TruncatePath(&edges_on_frame, edges_.size());
 
       // if we are here, we have a valid stack,
       // get the edge, increase the relevant iterator
       auto current_edge = *edges_it_.back()++;
       // Check edge-uniqueness.
-      bool found_existing =
-          std::any_of(edges_on_frame.begin(), edges_on_frame.end(),
-                      [&current_edge](const TypedValue &edge) { return current_edge.first == edge.ValueEdge(); });
-      if (found_existing) continue;
+      if (path_edges_.contains(current_edge.first.Gid())) continue;
 
       VertexAccessor current_vertex =
           current_edge.second == EdgeAtom::Direction::IN ? current_edge.first.From() : current_edge.first.To();
@@ -1154,6 +1704,190 @@ class ExpandVariableCursor : public Cursor {
   }
 };
 
+namespace {
+
+/** Set of vertices stored as a bitset indexed by the vertex gids. The storage
+ * allocates the gids sequentially, so the bitset is dense for the vertices
+ * reached by a traversal and no hashing is needed to test them. */
+class VertexBitset {
+ public:
+  explicit VertexBitset(utils::MemoryResource *mem) : words_(mem) {}
+
+  /** Returns false if the vertex was already in the set. */
+  bool Insert(const VertexAccessor &vertex) {
+    const auto gid = vertex.Gid().AsUint();
+    const auto word = gid / kBitsPerWord;
+    if (word >= words_.size()) words_.resize(std::max<size_t>(word + 1, 2 * words_.size()), 0);
+    const auto mask = uint64_t{1} << (gid % kBitsPerWord);
+    if (words_[word] & mask) return false;
+    words_[word] |= mask;
+    return true;
+  }
+
+  bool Contains(const VertexAccessor &vertex) const {
+    const auto gid = vertex.Gid().AsUint();
+    const auto word = gid / kBitsPerWord;
+    return word < words_.size() && (words_[word] & (uint64_t{1} << (gid % kBitsPerWord)));
+  }
+
+  void Clear() { std::fill(words_.begin(), words_.end(), 0); }
+
+ private:
+  static constexpr uint64_t kBitsPerWord = 64;
+
+  utils::pmr::vector<uint64_t> words_;
+};
+
+/** Map of vertices to positions, e.g. in a vector of the visited vertices,
+ * stored in pages indexed by the vertex gids like `VertexBitset`. Only the
+ * pages with the gids of the inserted vertices are allocated, so positions of
+ * the vertices reached by a traversal of a large graph don't have to be kept
+ * for all of its vertices. */
+class VertexPositions {
+ public:
+  explicit VertexPositions(utils::MemoryResource *mem) : pages_(mem) {}
+
+  /** Inserts the vertex with `position` if it isn't in the map. Returns the
+   * position of the vertex and whether it was inserted. */
+  std::pair<size_t, bool> TryEmplace(const VertexAccessor &vertex, size_t position) {
+    const auto gid = vertex.Gid().AsUint();
+    const auto page = gid / kPageSize;
+    if (page >= pages_.size()) pages_.resize(std::max<size_t>(page + 1, 2 * pages_.size()));
+    if (pages_[page].empty()) pages_[page].resize(kPageSize, kNoPosition);
+    auto &slot = pages_[page][gid % kPageSize];
+    if (slot != kNoPosition) return {slot, false};
+    slot = position;
+    return {position, true};
+  }
+
+  void Clear() { pages_.clear(); }
+
+ private:
+  static constexpr uint64_t kPageSize = 1024;
+  static constexpr size_t kNoPosition = std::numeric_limits<size_t>::max();
+
+  utils::pmr::vector<utils::pmr::vector<size_t>> pages_;
+};
+
+/** Vertex visited by a breadth-first search. The vertices are kept in the order
+ * of their visit, so each level of the search is a range of them. */
+struct BfsNode {
+  VertexAccessor vertex;
+  // edge the vertex was reached with, std::nullopt for the start of the search
+  std::optional<EdgeAccessor> edge;
+  // position of the vertex `edge` was expanded from
+  size_t parent;
+};
+
+/** Vertex found by `ExpandFrontier` which hasn't been checked against the
+ * visited vertices yet. */
+struct BfsExpansion {
+  EdgeAccessor edge;
+  VertexAccessor vertex;
+  size_t parent;
+};
+
+// Frontiers smaller than this are expanded on the calling thread.
+constexpr size_t kMinParallelFrontier = 1024;
+// Number of frontier vertices a thread takes at once.
+constexpr size_t kFrontierChunkSize = 256;
+
+EdgeAtom::Direction ReverseDirection(EdgeAtom::Direction direction) {
+  switch (direction) {
+    case EdgeAtom::Direction::IN:
+      return EdgeAtom::Direction::OUT;
+    case EdgeAtom::Direction::OUT:
+      return EdgeAtom::Direction::IN;
+    case EdgeAtom::Direction::BOTH:
+      return EdgeAtom::Direction::BOTH;
+  }
+}
+
+/** Returns true if the BFS levels of the expansion may be expanded on several
+ * threads. The filter lambda and the fine-grained auth checker aren't safe to
+ * be shared among threads, and the disk storage loads the edges on demand. */
+bool CanExpandInParallel(const ExpandVariable &self, const ExecutionContext &context) {
+  if (context.parallelism <= 1 || self.filter_lambda_.expression) return false;
+#ifdef MG_ENTERPRISE
+  if (context.auth_checker) return false;
+#endif
+  return context.db_accessor->GetStorageMode() != storage::StorageMode::ON_DISK_TRANSACTIONAL;
+}
+
+/** Calls `func(chunk, chunk_begin, chunk_end)` for the chunks of
+ * `chunk_size` positions in [0, size) on up to `parallelism` threads.
+ * The first exception thrown by `func` stops the remaining chunks and is
+ * rethrown on the calling thread. */
+template <typename TFunc>
+void ForEachChunkInParallel(size_t size, uint64_t parallelism, const TFunc &func,
+                            const size_t chunk_size = kFrontierChunkSize) {
+  const auto num_chunks = (size + chunk_size - 1) / chunk_size;
+  if (parallelism <= 1 || num_chunks <= 1) {
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+      func(chunk, chunk * chunk_size, std::min(size, (chunk + 1) * chunk_size));
+    }
+    return;
+  }
+  std::atomic<size_t> next_chunk{0};
+  std::atomic<bool> failed{false};
+  utils::Synchronized<std::exception_ptr, utils::SpinLock> error;
+  {
+    std::vector<std::jthread> threads;
+    const auto num_threads = std::min<uint64_t>(parallelism, num_chunks);
+    threads.reserve(num_threads);
+    for (uint64_t i = 0; i < num_threads; ++i) {
+      threads.emplace_back([&] {
+        try {
+          while (!failed.load(std::memory_order_acquire)) {
+            const auto chunk = next_chunk.fetch_add(1, std::memory_order_acq_rel);
+            if (chunk >= num_chunks) break;
+            func(chunk, chunk * chunk_size, std::min(size, (chunk + 1) * chunk_size));
+          }
+        } catch (...) {
+          failed.store(true, std::memory_order_release);
+          auto locked_error = error.Lock();
+          if (!*locked_error) *locked_error = std::current_exception();
+        }
+      });
+    }
+  }
+  if (auto thrown = *error.Lock()) std::rethrow_exception(thrown);
+}
+
+/** Returns the edges of the BFS frontier `nodes[begin, end)` in the given
+ * direction, each with the vertex on its other end, pulled on up to
+ * `parallelism` threads. The edges are returned in the order of the frontier,
+ * or in the reverse order if `reversed` is set, as they would be found by a
+ * single thread. */
+std::vector<BfsExpansion> ExpandFrontier(const utils::pmr::vector<BfsNode> &nodes, size_t begin, size_t end,
+                                         bool reversed, EdgeAtom::Direction direction,
+                                         const std::vector<storage::EdgeTypeId> &edge_types, uint64_t parallelism) {
+  std::vector<std::vector<BfsExpansion>> chunks((end - begin + kFrontierChunkSize - 1) / kFrontierChunkSize);
+  ForEachChunkInParallel(end - begin, parallelism, [&](size_t chunk, size_t chunk_begin, size_t chunk_end) {
+    auto &expansions = chunks[chunk];
+    for (auto offset = chunk_begin; offset < chunk_end; ++offset) {
+      const auto parent = reversed ? end - 1 - offset : begin + offset;
+      const auto &vertex = nodes[parent].vertex;
+      if (direction != EdgeAtom::Direction::IN) {
+        for (const auto &edge : UnwrapEdgesResult(vertex.OutEdges(storage::View::OLD, edge_types))) {
+          expansions.push_back(BfsExpansion{edge, edge.To(), parent});
+        }
+      }
+      if (direction != EdgeAtom::Direction::OUT) {
+        for (const auto &edge : UnwrapEdgesResult(vertex.InEdges(storage::View::OLD, edge_types))) {
+          expansions.push_back(BfsExpansion{edge, edge.From(), parent});
+        }
+      }
+    }
+  });
+
+  std::vector<BfsExpansion> expansions;
+  for (auto &chunk : chunks) expansions.insert(expansions.end(), chunk.begin(), chunk.end());
+  return expansions;
+}
+
+}  // namespace
+
 class STShortestPathCursor : public query::plan::Cursor {
  public:
   STShortestPathCursor(const ExpandVariable &self, utils::MemoryResource *mem)
@@ -1203,25 +1937,16 @@ class STShortestPathCursor : public query::plan::Cursor {
   const ExpandVariable &self_;
   UniqueCursorPtr input_cursor_;
 
-  using VertexEdgeMapT = utils::pmr::unordered_map<VertexAccessor, std::optional<EdgeAccessor>>;
-
-  void ReconstructPath(const VertexAccessor &midpoint, const VertexEdgeMapT &in_edge, const VertexEdgeMapT &out_edge,
-                       Frame *frame, utils::MemoryResource *pull_memory) {
+  void ReconstructPath(const utils::pmr::vector<BfsNode> &source_nodes, size_t source_midpoint,
+                       const utils::pmr::vector<BfsNode> &sink_nodes, size_t sink_midpoint, Frame *frame,
+                       utils::MemoryResource *pull_memory) {
     utils::pmr::vector<TypedValue> result(pull_memory);
-    auto last_vertex = midpoint;
-    while (true) {
-      const auto &last_edge = in_edge.at(last_vertex);
-      if (!last_edge) break;
-      last_vertex = last_edge->From() == last_vertex ? last_edge->To() : last_edge->From();
-      result.emplace_back(*last_edge);
+    for (auto pos = source_midpoint; source_nodes[pos].edge; pos = source_nodes[pos].parent) {
+      result.emplace_back(*source_nodes[pos].edge);
     }
     std::reverse(result.begin(), result.end());
-    last_vertex = midpoint;
-    while (true) {
-      const auto &last_edge = out_edge.at(last_vertex);
-      if (!last_edge) break;
-      last_vertex = last_edge->From() == last_vertex ? last_edge->To() : last_edge->From();
-      result.emplace_back(*last_edge);
+    for (auto pos = sink_midpoint; sink_nodes[pos].edge; pos = sink_nodes[pos].parent) {
+      result.emplace_back(*sink_nodes[pos].edge);
     }
     frame->at(self_.common_.edge_symbol) = std::move(result);
   }
@@ -1242,8 +1967,6 @@ class STShortestPathCursor : public query::plan::Cursor {
 
   bool FindPath(const DbAccessor &dba, const VertexAccessor &source, const VertexAccessor &sink, int64_t lower_bound,
                 int64_t upper_bound, Frame *frame, ExpressionEvaluator *evaluator, const ExecutionContext &context) {
-    using utils::Contains;
-
     if (source == sink) return false;
 
     // We expand from both directions, both from the source and the sink.
@@ -1252,105 +1975,64 @@ class STShortestPathCursor : public query::plan::Cursor {
     // grows exponentially, effectively reducing the exponent by half.
 
     auto *pull_memory = evaluator->GetMemoryResource();
-    // Holds vertices at the current level of expansion from the source
-    // (sink).
-    utils::pmr::vector<VertexAccessor> source_frontier(pull_memory);
-    utils::pmr::vector<VertexAccessor> sink_frontier(pull_memory);
-
-    // Holds vertices we can expand to from `source_frontier`
-    // (`sink_frontier`).
-    utils::pmr::vector<VertexAccessor> source_next(pull_memory);
-    utils::pmr::vector<VertexAccessor> sink_next(pull_memory);
-
-    // Maps each vertex we visited expanding from the source (sink) to the
-    // edge used. Necessary for path reconstruction.
-    VertexEdgeMapT in_edge(pull_memory);
-    VertexEdgeMapT out_edge(pull_memory);
-
-    size_t current_length = 0;
-
-    source_frontier.emplace_back(source);
-    in_edge[source] = std::nullopt;
-    sink_frontier.emplace_back(sink);
-    out_edge[sink] = std::nullopt;
-
+    // Vertices visited expanding from the source (sink) in the order of their
+    // visit, the last level of them is the frontier of the expansion.
+    utils::pmr::vector<BfsNode> source_nodes(pull_memory);
+    utils::pmr::vector<BfsNode> sink_nodes(pull_memory);
+    VertexBitset source_visited(pull_memory);
+    VertexBitset sink_visited(pull_memory);
+    size_t source_frontier = 0;
+    size_t sink_frontier = 0;
+
+    source_nodes.push_back(BfsNode{source, std::nullopt, 0});
+    source_visited.Insert(source);
+    sink_nodes.push_back(BfsNode{sink, std::nullopt, 0});
+    sink_visited.Insert(sink);
+
+    const bool parallel = CanExpandInParallel(self_, context);
+    int64_t current_length = 0;
     while (true) {
       AbortCheck(context);
-      // Top-down step (expansion from the source).
       ++current_length;
       if (current_length > upper_bound) return false;
 
-      for (const auto &vertex : source_frontier) {
-        if (self_.common_.direction != EdgeAtom::Direction::IN) {
-          context.db_accessor->PrefetchOutEdges(vertex);
-          auto out_edges = UnwrapEdgesResult(vertex.OutEdges(storage::View::OLD, self_.common_.edge_types));
-          for (const auto &edge : out_edges) {
-#ifdef MG_ENTERPRISE
-            if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
-                !(context.auth_checker->Has(edge, memgraph::query::AuthQuery::FineGrainedPrivilege::READ) &&
-                  context.auth_checker->Has(edge.To(), storage::View::OLD,
-                                            memgraph::query::AuthQuery::FineGrainedPrivilege::READ))) {
-              continue;
-            }
-#endif
-
-            if (ShouldExpand(edge.To(), edge, frame, evaluator) && !Contains(in_edge, edge.To())) {
-              in_edge.emplace(edge.To(), edge);
-              if (Contains(out_edge, edge.To())) {
-                if (current_length >= lower_bound) {
-                  ReconstructPath(edge.To(), in_edge, out_edge, frame, pull_memory);
-                  return true;
-                } else {
-                  return false;
-                }
-              }
-              source_next.push_back(edge.To());
-            }
-          }
-        }
-        if (self_.common_.direction != EdgeAtom::Direction::OUT) {
-          dba.PrefetchInEdges(vertex);
-          auto in_edges = UnwrapEdgesResult(vertex.InEdges(storage::View::OLD, self_.common_.edge_types));
-          for (const auto &edge : in_edges) {
-#ifdef MG_ENTERPRISE
-            if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
-                !(context.auth_checker->Has(edge, memgraph::query::AuthQuery::FineGrainedPrivilege::READ) &&
-                  context.auth_checker->Has(edge.From(), storage::View::OLD,
-                                            memgraph::query::AuthQuery::FineGrainedPrivilege::READ))) {
-              continue;
-            }
-#endif
+      // Expanding the smaller frontier visits fewer vertices. The length of
+      // the path at the meeting point is the number of levels expanded from
+      // both sides, whichever side they were expanded from.
+      const bool from_source = source_nodes.size() - source_frontier <= sink_nodes.size() - sink_frontier;
+      auto &nodes = from_source ? source_nodes : sink_nodes;
+      auto &visited = from_source ? source_visited : sink_visited;
+      const auto &other_visited = from_source ? sink_visited : source_visited;
+      auto &frontier = from_source ? source_frontier : sink_frontier;
+      // When expanding from the sink everything is reversed, including the
+      // endpoint passed to `ShouldExpand`.
+      const auto direction = from_source ? self_.common_.direction : ReverseDirection(self_.common_.direction);
+
+      const auto frontier_end = nodes.size();
+      bool met = false;
+      // Returns true if the vertex has been visited from the other side.
+      auto visit = [&](const EdgeAccessor &edge, const VertexAccessor &vertex, size_t parent) {
+        if (!visited.Insert(vertex)) return false;
+        nodes.push_back(BfsNode{vertex, edge, parent});
+        return other_visited.Contains(vertex);
+      };
 
-            if (ShouldExpand(edge.From(), edge, frame, evaluator) && !Contains(in_edge, edge.From())) {
-              in_edge.emplace(edge.From(), edge);
-              if (Contains(out_edge, edge.From())) {
-                if (current_length >= lower_bound) {
-                  ReconstructPath(edge.From(), in_edge, out_edge, frame, pull_memory);
-                  return true;
-                } else {
-                  return false;
-                }
-              }
-              source_next.push_back(edge.From());
-            }
+      const bool expand_in_parallel = parallel && frontier_end - frontier >= kMinParallelFrontier;
+      if (expand_in_parallel) {
+        for (const auto &expansion : ExpandFrontier(nodes, frontier, frontier_end, false, direction,
+                                                    self_.common_.edge_types, context.parallelism)) {
+          if (visit(expansion.edge, expansion.vertex, expansion.parent)) {
+            met = true;
+            break;
           }
         }
       }
 
-      if (source_next.empty()) return false;
-      source_frontier.clear();
-      std::swap(source_frontier, source_next);
-
-      // Bottom-up step (expansion from the sink).
-      ++current_length;
-      if (current_length > upper_bound) return false;
-
-      // When expanding from the sink we have to be careful which edge
-      // endpoint we pass to `should_expand`, because everything is
-      // reversed.
-      for (const auto &vertex : sink_frontier) {
-        if (self_.common_.direction != EdgeAtom::Direction::OUT) {
-          context.db_accessor->PrefetchOutEdges(vertex);
+      for (auto pos = frontier; !met && !expand_in_parallel && pos < frontier_end; ++pos) {
+        // The nodes may be reallocated by the visits.
+        const auto vertex = nodes[pos].vertex;
+        if (direction != EdgeAtom::Direction::IN) {
+          dba.PrefetchOutEdges(vertex);
           auto out_edges = UnwrapEdgesResult(vertex.OutEdges(storage::View::OLD, self_.common_.edge_types));
           for (const auto &edge : out_edges) {
 #ifdef MG_ENTERPRISE
@@ -1361,21 +2043,14 @@ class STShortestPathCursor : public query::plan::Cursor {
               continue;
             }
 #endif
-            if (ShouldExpand(vertex, edge, frame, evaluator) && !Contains(out_edge, edge.To())) {
-              out_edge.emplace(edge.To(), edge);
-              if (Contains(in_edge, edge.To())) {
-                if (current_length >= lower_bound) {
-                  ReconstructPath(edge.To(), in_edge, out_edge, frame, pull_memory);
-                  return true;
-                } else {
-                  return false;
-                }
-              }
-              sink_next.push_back(edge.To());
+            if (ShouldExpand(from_source ? edge.To() : vertex, edge, frame, evaluator) &&
+                visit(edge, edge.To(), pos)) {
+              met = true;
+              break;
             }
           }
         }
-        if (self_.common_.direction != EdgeAtom::Direction::IN) {
+        if (!met && direction != EdgeAtom::Direction::OUT) {
           dba.PrefetchInEdges(vertex);
           auto in_edges = UnwrapEdgesResult(vertex.InEdges(storage::View::OLD, self_.common_.edge_types));
           for (const auto &edge : in_edges) {
@@ -1387,25 +2062,33 @@ class STShortestPathCursor : public query::plan::Cursor {
               continue;
             }
 #endif
-            if (ShouldExpand(vertex, edge, frame, evaluator) && !Contains(out_edge, edge.From())) {
-              out_edge.emplace(edge.From(), edge);
-              if (Contains(in_edge, edge.From())) {
-                if (current_length >= lower_bound) {
-                  ReconstructPath(edge.From(), in_edge, out_edge, frame, pull_memory);
-                  return true;
-                } else {
-                  return false;
-                }
-              }
-              sink_next.push_back(edge.From());
+            if (ShouldExpand(from_source ? edge.From() : vertex, edge, frame, evaluator) &&
+                visit(edge, edge.From(), pos)) {
+              met = true;
+              break;
             }
           }
         }
       }
 
-      if (sink_next.empty()) return false;
-      sink_frontier.clear();
-      std::swap(sink_frontier, sink_next);
+      if (met) {
+        if (current_length < lower_bound) return false;
+        const auto midpoint = nodes.size() - 1;
+        const auto &other_nodes = from_source ? sink_nodes : source_nodes;
+        const auto other_midpoint = static_cast<size_t>(
+            std::find_if(other_nodes.begin(), other_nodes.end(),
+                         [&](const auto &node) { return node.vertex == nodes[midpoint].vertex; }) -
+            other_nodes.begin());
+        if (from_source) {
+          ReconstructPath(source_nodes, midpoint, sink_nodes, other_midpoint, frame, pull_memory);
+        } else {
+          ReconstructPath(source_nodes, other_midpoint, sink_nodes, midpoint, frame, pull_memory);
+        }
+        return true;
+      }
+
+      if (nodes.size() == frontier_end) return false;
+      frontier = frontier_end;
     }
   }
 };
@@ -1413,11 +2096,7 @@ class STShortestPathCursor : public query::plan::Cursor {
 class SingleSourceShortestPathCursor : public query::plan::Cursor {
  public:
   SingleSourceShortestPathCursor(const ExpandVariable &self, utils::MemoryResource *mem)
-      : self_(self),
-        input_cursor_(self_.input()->MakeCursor(mem)),
-        processed_(mem),
-        to_visit_current_(mem),
-        to_visit_next_(mem) {
+      : self_(self), input_cursor_(self_.input()->MakeCursor(mem)), nodes_(mem), visited_(mem) {
     MG_ASSERT(!self_.common_.existing_node,
               "Single source shortest path algorithm "
               "should not be used when `existing_node` "
@@ -1432,10 +2111,10 @@ class SingleSourceShortestPathCursor : public query::plan::Cursor {
                                   storage::View::OLD);
 
     // for the given (edge, vertex) pair checks if they satisfy the
-    // "where" condition. if so, places them in the to_visit_ structure.
-    auto expand_pair = [this, &evaluator, &frame, &context](EdgeAccessor edge, VertexAccessor vertex) {
+    // "where" condition. if so, places them in the next level of nodes_.
+    auto expand_pair = [this, &evaluator, &frame, &context](EdgeAccessor edge, VertexAccessor vertex, size_t parent) {
       // if we already processed the given vertex it doesn't get expanded
-      if (processed_.find(vertex) != processed_.end()) return;
+      if (visited_.Contains(vertex)) return;
 #ifdef MG_ENTERPRISE
       if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
           !(context.auth_checker->Has(vertex, storage::View::OLD,
@@ -1459,23 +2138,24 @@ class SingleSourceShortestPathCursor : public query::plan::Cursor {
             throw QueryRuntimeException("Expansion condition must evaluate to boolean or null.");
         }
       }
-      to_visit_next_.emplace_back(edge, vertex);
-      processed_.emplace(vertex, edge);
+      visited_.Insert(vertex);
+      nodes_.push_back(BfsNode{std::move(vertex), std::move(edge), parent});
     };
 
-    // populates the to_visit_next_ structure with expansions
-    // from the given vertex. skips expansions that don't satisfy
-    // the "where" condition.
-    auto expand_from_vertex = [this, &expand_pair, &context](const auto &vertex) {
+    // populates the next level of nodes_ with expansions from the given
+    // vertex. skips expansions that don't satisfy the "where" condition.
+    auto expand_from_vertex = [this, &expand_pair, &context](size_t pos) {
+      // The nodes may be reallocated by the expansions.
+      const auto vertex = nodes_[pos].vertex;
       if (self_.common_.direction != EdgeAtom::Direction::IN) {
         context.db_accessor->PrefetchOutEdges(vertex);
         auto out_edges = UnwrapEdgesResult(vertex.OutEdges(storage::View::OLD, self_.common_.edge_types));
-        for (const auto &edge : out_edges) expand_pair(edge, edge.To());
+        for (const auto &edge : out_edges) expand_pair(edge, edge.To(), pos);
       }
       if (self_.common_.direction != EdgeAtom::Direction::OUT) {
         context.db_accessor->PrefetchInEdges(vertex);
         auto in_edges = UnwrapEdgesResult(vertex.InEdges(storage::View::OLD, self_.common_.edge_types));
-        for (const auto &edge : in_edges) expand_pair(edge, edge.From());
+        for (const auto &edge : in_edges) expand_pair(edge, edge.From(), pos);
       }
     };
 
@@ -1483,16 +2163,33 @@ class SingleSourceShortestPathCursor : public query::plan::Cursor {
     while (true) {
       AbortCheck(context);
       // if we have nothing to visit on the current depth, switch to next
-      if (to_visit_current_.empty()) to_visit_current_.swap(to_visit_next_);
+      if (next_ == level_begin_ && level_end_ < nodes_.size()) {
+        level_begin_ = level_end_;
+        level_end_ = nodes_.size();
+        next_ = level_end_;
+        ++depth_;
+        // A large level is expanded at once on several threads, in the order
+        // its vertices are taken below.
+        level_expanded_ = depth_ < upper_bound_ && level_end_ - level_begin_ >= kMinParallelFrontier &&
+                          CanExpandInParallel(self_, context);
+        if (level_expanded_) {
+          for (auto &expansion : ExpandFrontier(nodes_, level_begin_, level_end_, true, self_.common_.direction,
+                                                self_.common_.edge_types, context.parallelism)) {
+            if (visited_.Insert(expansion.vertex)) {
+              nodes_.push_back(BfsNode{std::move(expansion.vertex), std::move(expansion.edge), expansion.parent});
+            }
+          }
+        }
+      }
 
       // if current is still empty, it means both are empty, so pull from
       // input
-      if (to_visit_current_.empty()) {
+      if (next_ == level_begin_) {
         if (!input_cursor_->Pull(frame, context)) return false;
 
-        to_visit_current_.clear();
-        to_visit_next_.clear();
-        processed_.clear();
+        nodes_.clear();
+        visited_.Clear();
+        level_begin_ = level_end_ = next_ = 0;
 
         const auto &vertex_value = frame[self_.input_symbol_];
         // it is possible that the vertex is Null due to optional matching
@@ -1507,39 +2204,34 @@ class SingleSourceShortestPathCursor : public query::plan::Cursor {
         if (upper_bound_ < 1 || lower_bound_ > upper_bound_) continue;
 
         const auto &vertex = vertex_value.ValueVertex();
-        processed_.emplace(vertex, std::nullopt);
+        nodes_.push_back(BfsNode{vertex, std::nullopt, 0});
+        visited_.Insert(vertex);
+        level_end_ = 1;
+        depth_ = 0;
 
-        expand_from_vertex(vertex);
+        expand_from_vertex(0);
 
         // go back to loop start and see if we expanded anything
         continue;
       }
 
-      // take the next expansion from the queue
-      auto expansion = to_visit_current_.back();
-      to_visit_current_.pop_back();
+      // take the next expansion from the current level
+      const auto pos = --next_;
+
+      // expand only if what we've just expanded is less then max depth
+      if (!level_expanded_ && depth_ < upper_bound_) expand_from_vertex(pos);
+
+      if (depth_ < lower_bound_) continue;
 
       // create the frame value for the edges
       auto *pull_memory = context.evaluation_context.memory;
       utils::pmr::vector<TypedValue> edge_list(pull_memory);
-      edge_list.emplace_back(expansion.first);
-      auto last_vertex = expansion.second;
-      while (true) {
-        const EdgeAccessor &last_edge = edge_list.back().ValueEdge();
-        last_vertex = last_edge.From() == last_vertex ? last_edge.To() : last_edge.From();
-        // origin_vertex must be in processed
-        const auto &previous_edge = processed_.find(last_vertex)->second;
-        if (!previous_edge) break;
-
-        edge_list.emplace_back(previous_edge.value());
+      edge_list.reserve(depth_);
+      for (auto edge_pos = pos; nodes_[edge_pos].edge; edge_pos = nodes_[edge_pos].parent) {
+        edge_list.emplace_back(*nodes_[edge_pos].edge);
       }
 
-      // expand only if what we've just expanded is less then max depth
-      if (static_cast<int64_t>(edge_list.size()) < upper_bound_) expand_from_vertex(expansion.second);
-
-      if (static_cast<int64_t>(edge_list.size()) < lower_bound_) continue;
-
-      frame[self_.common_.node_symbol] = expansion.second;
+      frame[self_.common_.node_symbol] = nodes_[pos].vertex;
 
       // place edges on the frame in the correct order
       std::reverse(edge_list.begin(), edge_list.end());
@@ -1553,9 +2245,9 @@ class SingleSourceShortestPathCursor : public query::plan::Cursor {
 
   void Reset() override {
     input_cursor_->Reset();
-    processed_.clear();
-    to_visit_next_.clear();
-    to_visit_current_.clear();
+    nodes_.clear();
+    visited_.Clear();
+    level_begin_ = level_end_ = next_ = 0;
   }
 
  private:
@@ -1567,13 +2259,20 @@ class SingleSourceShortestPathCursor : public query::plan::Cursor {
   int64_t lower_bound_{-1};
   int64_t upper_bound_{-1};
 
-  // maps vertices to the edge they got expanded from. it is an optional
-  // edge because the root does not get expanded from anything.
-  // contains visited vertices as well as those scheduled to be visited.
-  utils::pmr::unordered_map<VertexAccessor, std::optional<EdgeAccessor>> processed_;
-  // edge/vertex pairs we have yet to visit, for current and next depth
-  utils::pmr::vector<std::pair<EdgeAccessor, VertexAccessor>> to_visit_current_;
-  utils::pmr::vector<std::pair<EdgeAccessor, VertexAccessor>> to_visit_next_;
+  // vertices in the order of their visit, with the edge they got expanded
+  // from. contains visited vertices as well as those scheduled to be visited.
+  utils::pmr::vector<BfsNode> nodes_;
+  VertexBitset visited_;
+  // the current level is nodes_[level_begin_, level_end_), its vertices are
+  // taken from the back and the ones before next_ are yet to be visited. the
+  // next level is nodes_[level_end_, nodes_.size()).
+  size_t level_begin_{0};
+  size_t level_end_{0};
+  size_t next_{0};
+  // number of edges from the start to the vertices of the current level
+  int64_t depth_{0};
+  // set if the vertices of the current level have already been expanded
+  bool level_expanded_{false};
 };
 
 namespace {
@@ -1596,6 +2295,64 @@ void CheckWeightType(TypedValue current_weight, utils::MemoryResource *memory) {
   }
 }
 
+/** Property which the weight lambda reads from the expanded edge or vertex, as
+ * in the common `(e, v | e.weight)` lambda. Such weights are read directly from
+ * the storage instead of evaluating the lambda for each edge. */
+struct DirectWeight {
+  storage::PropertyId property;
+  // true if the property is read from the edge, false if from the vertex
+  bool from_edge;
+};
+
+std::optional<DirectWeight> FindDirectWeight(const ExpansionLambda &lambda, const EvaluationContext &context) {
+  auto *lookup = utils::Downcast<PropertyLookup>(lambda.expression);
+  if (!lookup) return std::nullopt;
+  auto *identifier = utils::Downcast<Identifier>(lookup->expression_);
+  if (!identifier) return std::nullopt;
+  const auto property = context.properties[lookup->property_.ix];
+  if (identifier->symbol_pos_ == lambda.inner_edge_symbol.position()) return DirectWeight{property, true};
+  if (identifier->symbol_pos_ == lambda.inner_node_symbol.position()) return DirectWeight{property, false};
+  return std::nullopt;
+}
+
+template <typename TRecordAccessor>
+TypedValue ReadWeightProperty(const TRecordAccessor &record, storage::PropertyId property,
+                              utils::MemoryResource *memory) {
+  auto maybe_value = record.GetProperty(storage::View::OLD, property);
+  // Same fallback to the new view as in `ExpressionEvaluator::GetProperty`.
+  if (maybe_value.HasError() && maybe_value.GetError() == storage::Error::NONEXISTENT_OBJECT) {
+    maybe_value = record.GetProperty(storage::View::NEW, property);
+  }
+  if (maybe_value.HasError()) {
+    switch (maybe_value.GetError()) {
+      case storage::Error::DELETED_OBJECT:
+        throw QueryRuntimeException("Trying to get a property from a deleted object.");
+      case storage::Error::NONEXISTENT_OBJECT:
+        throw QueryRuntimeException("Trying to get a property from an object that doesn't exist.");
+      case storage::Error::SERIALIZATION_ERROR:
+      case storage::Error::VERTEX_HAS_EDGES:
+      case storage::Error::PROPERTIES_DISABLED:
+        throw QueryRuntimeException("Unexpected error when getting a property.");
+    }
+  }
+  return TypedValue(std::move(*maybe_value), memory);
+}
+
+TypedValue ReadDirectWeight(const DirectWeight &weight, const EdgeAccessor &edge, const VertexAccessor &vertex,
+                            utils::MemoryResource *memory) {
+  return weight.from_edge ? ReadWeightProperty(edge, weight.property, memory)
+                          : ReadWeightProperty(vertex, weight.property, memory);
+}
+
+/** Edge found by the delta-stepping expansion, with its weight which hasn't
+ * been added to the weight of the path to `parent` yet. */
+struct WspRelaxation {
+  EdgeAccessor edge;
+  VertexAccessor vertex;
+  size_t parent;
+  TypedValue weight;
+};
+
 }  // namespace
 
 class ExpandWeightedShortestPathCursor : public query::plan::Cursor {
@@ -1606,7 +2363,11 @@ class ExpandWeightedShortestPathCursor : public query::plan::Cursor {
         total_cost_(mem),
         previous_(mem),
         yielded_vertices_(mem),
-        pq_(mem) {}
+        pq_(mem),
+        nodes_(mem),
+        node_positions_(mem),
+        buckets_(mem),
+        settled_(mem) {}
 
   bool Pull(Frame &frame, ExecutionContext &context) override {
     SCOPED_PROFILE_OP("ExpandWeightedShortestPath");
@@ -1639,10 +2400,12 @@ class ExpandWeightedShortestPathCursor : public query::plan::Cursor {
         if (!EvaluateFilter(evaluator, self_.filter_lambda_.expression)) return;
       }
 
-      frame[self_.weight_lambda_->inner_edge_symbol] = edge;
-      frame[self_.weight_lambda_->inner_node_symbol] = vertex;
-
-      TypedValue current_weight = self_.weight_lambda_->expression->Accept(evaluator);
+      TypedValue current_weight = std::invoke([&] {
+        if (direct_weight_) return ReadDirectWeight(*direct_weight_, edge, vertex, memory);
+        frame[self_.weight_lambda_->inner_edge_symbol] = edge;
+        frame[self_.weight_lambda_->inner_node_symbol] = vertex;
+        return self_.weight_lambda_->expression->Accept(evaluator);
+      });
 
       CheckWeightType(current_weight, memory);
 
@@ -1688,7 +2451,7 @@ class ExpandWeightedShortestPathCursor : public query::plan::Cursor {
 
     while (true) {
       AbortCheck(context);
-      if (pq_.empty()) {
+      if (pq_.empty() && !delta_stepping_) {
         if (!input_cursor_->Pull(frame, context)) return false;
         const auto &vertex_value = frame[self_.input_symbol_];
         if (vertex_value.IsNull()) continue;
@@ -1714,13 +2477,23 @@ class ExpandWeightedShortestPathCursor : public query::plan::Cursor {
         // Clear existing data structures.
         previous_.clear();
         total_cost_.clear();
-        yielded_vertices_.clear();
+        yielded_vertices_.Clear();
+
+        direct_weight_ = FindDirectWeight(*self_.weight_lambda_, context.evaluation_context);
+        if (direct_weight_ && !upper_bound_set_ && CanExpandInParallel(self_, context)) {
+          StartDeltaStepping(vertex);
+        } else {
+          pq_.push({TypedValue(), 0, vertex, std::nullopt});
+          // We are adding the starting vertex to the set of yielded vertices
+          // because we don't want to yield paths that end with the starting
+          // vertex.
+          yielded_vertices_.Insert(vertex);
+        }
+      }
 
-        pq_.push({TypedValue(), 0, vertex, std::nullopt});
-        // We are adding the starting vertex to the set of yielded vertices
-        // because we don't want to yield paths that end with the starting
-        // vertex.
-        yielded_vertices_.insert(vertex);
+      if (delta_stepping_) {
+        if (PullDeltaStepping(frame, context)) return true;
+        continue;
       }
 
       while (!pq_.empty()) {
@@ -1742,7 +2515,7 @@ class ExpandWeightedShortestPathCursor : public query::plan::Cursor {
 
         // If we yielded a path for a vertex already, make the expansion but
         // don't return the path again.
-        if (yielded_vertices_.find(current_vertex) != yielded_vertices_.end()) continue;
+        if (yielded_vertices_.Contains(current_vertex)) continue;
 
         // Reconstruct the path.
         auto last_vertex = current_vertex;
@@ -1777,7 +2550,7 @@ class ExpandWeightedShortestPathCursor : public query::plan::Cursor {
         }
         frame[self_.common_.edge_symbol] = std::move(edge_list);
         frame[self_.total_weight_.value()] = current_weight;
-        yielded_vertices_.insert(current_vertex);
+        yielded_vertices_.Insert(current_vertex);
         return true;
       }
     }
@@ -1789,8 +2562,9 @@ class ExpandWeightedShortestPathCursor : public query::plan::Cursor {
     input_cursor_->Reset();
     previous_.clear();
     total_cost_.clear();
-    yielded_vertices_.clear();
+    yielded_vertices_.Clear();
     ClearQueue();
+    ClearDeltaStepping();
   }
 
  private:
@@ -1801,6 +2575,10 @@ class ExpandWeightedShortestPathCursor : public query::plan::Cursor {
   int64_t upper_bound_{-1};
   bool upper_bound_set_{false};
 
+  // Set if the weight lambda only reads a property of the expanded edge or
+  // vertex.
+  std::optional<DirectWeight> direct_weight_;
+
   struct WspStateHash {
     size_t operator()(const std::pair<VertexAccessor, int64_t> &key) const {
       return utils::HashCombine<VertexAccessor, int64_t>{}(key.first, key.second);
@@ -1814,7 +2592,7 @@ class ExpandWeightedShortestPathCursor : public query::plan::Cursor {
   utils::pmr::unordered_map<std::pair<VertexAccessor, int64_t>, std::optional<EdgeAccessor>, WspStateHash> previous_;
 
   // Keeps track of vertices for which we yielded a path already.
-  utils::pmr::unordered_set<VertexAccessor> yielded_vertices_;
+  VertexBitset yielded_vertices_;
 
   static void ValidateWeightTypes(const TypedValue &lhs, const TypedValue &rhs) {
     if (!((lhs.IsNumeric() && lhs.IsNumeric()) || (rhs.IsDuration() && rhs.IsDuration()))) {
@@ -1854,47 +2632,257 @@ class ExpandWeightedShortestPathCursor : public query::plan::Cursor {
   void ClearQueue() {
     while (!pq_.empty()) pq_.pop();
   }
-};
 
-class ExpandAllShortestPathsCursor : public query::plan::Cursor {
- public:
-  ExpandAllShortestPathsCursor(const ExpandVariable &self, utils::MemoryResource *mem)
-      : self_(self),
-        input_cursor_(self_.input_->MakeCursor(mem)),
-        visited_cost_(mem),
-        total_cost_(mem),
-        next_edges_(mem),
-        traversal_stack_(mem),
-        pq_(mem) {}
+  // Delta-stepping expansion, used instead of the priority queue when the
+  // weights are read directly and the edges may be expanded on several
+  // threads. The vertices are put into buckets by their weight, each bucket
+  // covering a range of `delta_`. The buckets are expanded in order, each until
+  // the weights inside it don't change any more, and then all of its vertices
+  // are settled at once.
+  struct WspNode {
+    VertexAccessor vertex;
+    // edge the vertex was reached with, std::nullopt for the start
+    std::optional<EdgeAccessor> edge;
+    // position of the vertex `edge` was expanded from
+    size_t parent;
+    TypedValue total_weight;
+    // true if the edges of the vertex were expanded with its current weight
+    bool expanded;
+  };
 
-  bool Pull(Frame &frame, ExecutionContext &context) override {
-    SCOPED_PROFILE_OP("ExpandAllShortestPathsCursor");
+  bool delta_stepping_{false};
+  double delta_{0};
+  utils::pmr::vector<WspNode> nodes_;
+  VertexPositions node_positions_;
+  utils::pmr::map<uint64_t, utils::pmr::vector<size_t>> buckets_;
+  // Vertices of the last settled bucket ordered by their weight, the ones
+  // before `settled_pos_` were already yielded.
+  utils::pmr::vector<size_t> settled_;
+  size_t settled_pos_{0};
+
+  void ClearDeltaStepping() {
+    delta_stepping_ = false;
+    delta_ = 0;
+    nodes_.clear();
+    node_positions_.Clear();
+    buckets_.clear();
+    settled_.clear();
+    settled_pos_ = 0;
+  }
 
-    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
-                                  storage::View::OLD);
-    auto create_state = [this](const VertexAccessor &vertex, int64_t depth) {
-      return std::make_pair(vertex, upper_bound_set_ ? depth : 0);
-    };
+  void StartDeltaStepping(const VertexAccessor &vertex) {
+    ClearDeltaStepping();
+    delta_stepping_ = true;
+    nodes_.push_back(WspNode{vertex, std::nullopt, 0, TypedValue(), false});
+    node_positions_.TryEmplace(vertex, 0);
+    buckets_[0].push_back(0);
+  }
 
-    // For the given (edge, direction, weight, depth) tuple checks if they
-    // satisfy the "where" condition. if so, places them in the priority
-    // queue.
-    auto expand_vertex = [this, &evaluator, &frame](const EdgeAccessor &edge, const EdgeAtom::Direction direction,
-                                                    const TypedValue &total_weight, int64_t depth) {
-      auto *memory = evaluator.GetMemoryResource();
+  static bool WeightLess(const TypedValue &lhs, const TypedValue &rhs) {
+    // Null defines minimum value for all types
+    if (lhs.IsNull()) return !rhs.IsNull();
+    if (rhs.IsNull()) return false;
+    ValidateWeightTypes(lhs, rhs);
+    return (lhs < rhs).ValueBool();
+  }
 
-      auto const &next_vertex = direction == EdgeAtom::Direction::IN ? edge.From() : edge.To();
+  static double WeightToDouble(const TypedValue &weight) {
+    if (weight.IsNull()) return 0;
+    if (weight.IsDuration()) return static_cast<double>(weight.ValueDuration().microseconds);
+    return weight.IsInt() ? static_cast<double>(weight.ValueInt()) : weight.ValueDouble();
+  }
 
-      // If filter expression exists, evaluate filter
-      if (self_.filter_lambda_.expression) {
-        frame[self_.filter_lambda_.inner_edge_symbol] = edge;
-        frame[self_.filter_lambda_.inner_node_symbol] = next_vertex;
+  uint64_t BucketOf(const TypedValue &weight) const {
+    if (weight.IsNull()) return 0;
+    // Infinite and huge weights all share the last bucket.
+    constexpr auto kMaxBucket = static_cast<double>(std::numeric_limits<uint64_t>::max() / 2);
+    return static_cast<uint64_t>(std::min(WeightToDouble(weight) / delta_, kMaxBucket));
+  }
 
-        if (!EvaluateFilter(evaluator, self_.filter_lambda_.expression)) return;
+  /** Returns the edges of the `frontier` vertices with their weights, read on
+   * up to `context.parallelism` threads for large frontiers. */
+  std::vector<WspRelaxation> ExpandWeighted(const std::vector<size_t> &frontier, const ExecutionContext &context) {
+    std::vector<std::vector<WspRelaxation>> chunks((frontier.size() + kFrontierChunkSize - 1) / kFrontierChunkSize);
+    const auto parallelism = frontier.size() >= kMinParallelFrontier ? context.parallelism : 1;
+    ForEachChunkInParallel(frontier.size(), parallelism, [&](size_t chunk, size_t chunk_begin, size_t chunk_end) {
+      // The query memory isn't thread safe, numeric weights don't allocate.
+      auto *memory = utils::NewDeleteResource();
+      auto &relaxations = chunks[chunk];
+      const auto relax = [&](const EdgeAccessor &edge, const VertexAccessor &vertex, size_t parent) {
+        auto weight = ReadDirectWeight(*direct_weight_, edge, vertex, memory);
+        CheckWeightType(weight, memory);
+        relaxations.push_back(WspRelaxation{edge, vertex, parent, std::move(weight)});
+      };
+      for (auto i = chunk_begin; i < chunk_end; ++i) {
+        const auto parent = frontier[i];
+        const auto &vertex = nodes_[parent].vertex;
+        if (self_.common_.direction != EdgeAtom::Direction::IN) {
+          for (const auto &edge : UnwrapEdgesResult(vertex.OutEdges(storage::View::OLD, self_.common_.edge_types))) {
+            relax(edge, edge.To(), parent);
+          }
+        }
+        if (self_.common_.direction != EdgeAtom::Direction::OUT) {
+          for (const auto &edge : UnwrapEdgesResult(vertex.InEdges(storage::View::OLD, self_.common_.edge_types))) {
+            relax(edge, edge.From(), parent);
+          }
+        }
       }
+    });
 
-      // Evaluate current weight
-      frame[self_.weight_lambda_->inner_edge_symbol] = edge;
+    std::vector<WspRelaxation> relaxations;
+    for (auto &chunk : chunks) {
+      relaxations.insert(relaxations.end(), std::make_move_iterator(chunk.begin()),
+                         std::make_move_iterator(chunk.end()));
+    }
+    return relaxations;
+  }
+
+  void Relax(std::vector<WspRelaxation> relaxations, utils::MemoryResource *memory) {
+    if (delta_ == 0) {
+      // The buckets are as wide as the average weight of the first expanded
+      // edges, so that a bucket holds about one level of the expansion.
+      double weight_sum = 0;
+      size_t weight_count = 0;
+      for (const auto &relaxation : relaxations) {
+        const auto weight = WeightToDouble(relaxation.weight);
+        if (weight <= 0 || !std::isfinite(weight)) continue;
+        weight_sum += weight;
+        ++weight_count;
+      }
+      delta_ = weight_count == 0 ? 1 : weight_sum / static_cast<double>(weight_count);
+    }
+
+    for (auto &relaxation : relaxations) {
+      const auto &parent_weight = nodes_[relaxation.parent].total_weight;
+      TypedValue next_weight(relaxation.weight, memory);
+      if (!parent_weight.IsNull()) {
+        ValidateWeightTypes(next_weight, parent_weight);
+        next_weight = next_weight + parent_weight;
+      }
+      const auto [position, inserted] = node_positions_.TryEmplace(relaxation.vertex, nodes_.size());
+      if (inserted) {
+        nodes_.push_back(WspNode{relaxation.vertex, relaxation.edge, relaxation.parent, std::move(next_weight), false});
+      } else {
+        auto &node = nodes_[position];
+        if (!WeightLess(next_weight, node.total_weight)) continue;
+        node.edge = relaxation.edge;
+        node.parent = relaxation.parent;
+        node.total_weight = std::move(next_weight);
+        node.expanded = false;
+      }
+      buckets_[BucketOf(nodes_[position].total_weight)].push_back(position);
+    }
+  }
+
+  void SettleNextBucket(ExecutionContext &context) {
+    const auto bucket = buckets_.begin()->first;
+    settled_.clear();
+    settled_pos_ = 0;
+    std::vector<size_t> frontier;
+    // The weights are non-negative, so the relaxations never add to the
+    // earlier buckets.
+    for (auto bucket_it = buckets_.begin(); bucket_it != buckets_.end() && bucket_it->first == bucket;
+         bucket_it = buckets_.begin()) {
+      AbortCheck(context);
+      frontier.clear();
+      for (const auto position : bucket_it->second) {
+        auto &node = nodes_[position];
+        if (node.expanded || BucketOf(node.total_weight) != bucket) continue;
+        node.expanded = true;
+        frontier.push_back(position);
+      }
+      buckets_.erase(bucket_it);
+      settled_.insert(settled_.end(), frontier.begin(), frontier.end());
+      Relax(ExpandWeighted(frontier, context), context.evaluation_context.memory);
+    }
+    std::sort(settled_.begin(), settled_.end());
+    settled_.erase(std::unique(settled_.begin(), settled_.end()), settled_.end());
+    std::stable_sort(settled_.begin(), settled_.end(), [this](const auto lhs, const auto rhs) {
+      return WeightLess(nodes_[lhs].total_weight, nodes_[rhs].total_weight);
+    });
+  }
+
+  bool PullDeltaStepping(Frame &frame, ExecutionContext &context) {
+    auto *pull_memory = context.evaluation_context.memory;
+    while (true) {
+      AbortCheck(context);
+      while (settled_pos_ < settled_.size()) {
+        const auto &node = nodes_[settled_[settled_pos_++]];
+        // There is no path to the starting vertex.
+        if (!node.edge) continue;
+
+        // Place destination node on the frame, handle existence flag.
+        if (self_.common_.existing_node) {
+          const auto &existing = frame[self_.common_.node_symbol];
+          if ((existing != TypedValue(node.vertex, pull_memory)).ValueBool()) continue;
+          // Prevent expanding other paths, because we found the shortest to
+          // existing node.
+          delta_stepping_ = false;
+        } else {
+          frame[self_.common_.node_symbol] = node.vertex;
+        }
+
+        utils::pmr::vector<TypedValue> edge_list(pull_memory);
+        for (const auto *current = &node; current->edge; current = &nodes_[current->parent]) {
+          edge_list.emplace_back(*current->edge);
+        }
+        if (!self_.is_reverse_) {
+          // Place edges on the frame in the correct order.
+          std::reverse(edge_list.begin(), edge_list.end());
+        }
+        frame[self_.common_.edge_symbol] = std::move(edge_list);
+        frame[self_.total_weight_.value()] = node.total_weight;
+        return true;
+      }
+      if (buckets_.empty()) {
+        delta_stepping_ = false;
+        return false;
+      }
+      SettleNextBucket(context);
+    }
+  }
+};
+
+class ExpandAllShortestPathsCursor : public query::plan::Cursor {
+ public:
+  ExpandAllShortestPathsCursor(const ExpandVariable &self, utils::MemoryResource *mem)
+      : self_(self),
+        input_cursor_(self_.input_->MakeCursor(mem)),
+        visited_cost_(mem),
+        state_positions_(mem),
+        nodes_(mem),
+        dag_edges_(mem),
+        traversal_stack_(mem),
+        pq_(mem) {}
+
+  bool Pull(Frame &frame, ExecutionContext &context) override {
+    SCOPED_PROFILE_OP("ExpandAllShortestPathsCursor");
+
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                  storage::View::OLD);
+    auto create_state = [this](const VertexAccessor &vertex, int64_t depth) {
+      return std::make_pair(vertex, upper_bound_set_ ? depth : 0);
+    };
+
+    // For the given (edge, direction, weight, depth) tuple checks if they
+    // satisfy the "where" condition. if so, places them in the priority
+    // queue.
+    auto expand_vertex = [this, &evaluator, &frame](const EdgeAccessor &edge, const EdgeAtom::Direction direction,
+                                                    const TypedValue &total_weight, int64_t depth, size_t parent) {
+      auto *memory = evaluator.GetMemoryResource();
+
+      auto const &next_vertex = direction == EdgeAtom::Direction::IN ? edge.From() : edge.To();
+
+      // If filter expression exists, evaluate filter
+      if (self_.filter_lambda_.expression) {
+        frame[self_.filter_lambda_.inner_edge_symbol] = edge;
+        frame[self_.filter_lambda_.inner_node_symbol] = next_vertex;
+
+        if (!EvaluateFilter(evaluator, self_.filter_lambda_.expression)) return;
+      }
+
+      // Evaluate current weight
+      frame[self_.weight_lambda_->inner_edge_symbol] = edge;
       frame[self_.weight_lambda_->inner_node_symbol] = next_vertex;
 
       TypedValue current_weight = self_.weight_lambda_->expression->Accept(evaluator);
@@ -1927,15 +2915,16 @@ class ExpandAllShortestPathsCursor : public query::plan::Cursor {
         visited_cost_[next_vertex] = next_weight;
       }
 
-      DirectedEdge directed_edge = {edge, direction, next_weight};
-      pq_.push({next_weight, depth + 1, next_vertex, directed_edge});
+      pq_.push({next_weight, depth + 1, next_vertex, edge, parent});
     };
 
     // Populates the priority queue structure with expansions
     // from the given vertex. skips expansions that don't satisfy
     // the "where" condition.
-    auto expand_from_vertex = [this, &expand_vertex, &context](const VertexAccessor &vertex, const TypedValue &weight,
-                                                               int64_t depth) {
+    auto expand_from_vertex = [this, &expand_vertex, &context](size_t position) {
+      const auto vertex = nodes_[position].vertex;
+      const auto weight = nodes_[position].total_weight;
+      const auto depth = nodes_[position].depth;
       if (self_.common_.direction != EdgeAtom::Direction::IN) {
         context.db_accessor->PrefetchOutEdges(vertex);
         auto out_edges = UnwrapEdgesResult(vertex.OutEdges(storage::View::OLD, self_.common_.edge_types));
@@ -1948,7 +2937,7 @@ class ExpandAllShortestPathsCursor : public query::plan::Cursor {
             continue;
           }
 #endif
-          expand_vertex(edge, EdgeAtom::Direction::OUT, weight, depth);
+          expand_vertex(edge, EdgeAtom::Direction::OUT, weight, depth, position);
         }
       }
       if (self_.common_.direction != EdgeAtom::Direction::OUT) {
@@ -1963,93 +2952,35 @@ class ExpandAllShortestPathsCursor : public query::plan::Cursor {
             continue;
           }
 #endif
-          expand_vertex(edge, EdgeAtom::Direction::IN, weight, depth);
-        }
-      }
-    };
-
-    std::optional<VertexAccessor> start_vertex;
-    auto *memory = context.evaluation_context.memory;
-
-    auto create_path = [this, &frame, &memory]() {
-      auto &current_level = traversal_stack_.back();
-      auto &edges_on_frame = frame[self_.common_.edge_symbol].ValueList();
-
-      // Clean out the current stack
-      if (current_level.empty()) {
-        if (!edges_on_frame.empty()) {
-          if (!self_.is_reverse_)
-            edges_on_frame.erase(edges_on_frame.end());
-          else
-            edges_on_frame.erase(edges_on_frame.begin());
+          expand_vertex(edge, EdgeAtom::Direction::IN, weight, depth, position);
         }
-        traversal_stack_.pop_back();
-        return false;
-      }
-
-      auto [current_edge, current_edge_direction, current_weight] = current_level.back();
-      current_level.pop_back();
-
-      // Edges order depends on direction of expansion
-      if (!self_.is_reverse_)
-        edges_on_frame.emplace_back(current_edge);
-      else
-        edges_on_frame.emplace(edges_on_frame.begin(), current_edge);
-
-      auto next_vertex = current_edge_direction == EdgeAtom::Direction::IN ? current_edge.From() : current_edge.To();
-      frame[self_.total_weight_.value()] = current_weight;
-
-      if (next_edges_.find({next_vertex, traversal_stack_.size()}) != next_edges_.end()) {
-        auto next_vertex_edges = next_edges_[{next_vertex, traversal_stack_.size()}];
-        traversal_stack_.emplace_back(std::move(next_vertex_edges));
-      } else {
-        // Signal the end of iteration
-        utils::pmr::list<DirectedEdge> empty(memory);
-        traversal_stack_.emplace_back(std::move(empty));
       }
-
-      if ((current_weight > visited_cost_.at(next_vertex)).ValueBool()) return false;
-
-      // Place destination node on the frame, handle existence flag
-      if (self_.common_.existing_node) {
-        const auto &node = frame[self_.common_.node_symbol];
-        ExpectType(self_.common_.node_symbol, node, TypedValue::Type::Vertex);
-        if (node.ValueVertex() != next_vertex) return false;
-      } else {
-        frame[self_.common_.node_symbol] = next_vertex;
-      }
-      return true;
     };
 
-    auto create_DFS_traversal_tree = [this, &context, &memory, &create_state, &expand_from_vertex]() {
+    // Runs Dijkstra's algorithm from the start vertex and records the edges of
+    // all the shortest paths. Each state gets a position in `nodes_` once it
+    // is settled, and each edge through which a state is reached with its
+    // lowest weight is added to the DAG.
+    auto create_shortest_path_dag = [this, &context, &create_state, &expand_from_vertex]() {
       while (!pq_.empty()) {
         AbortCheck(context);
 
-        const auto [current_weight, current_depth, current_vertex, directed_edge] = pq_.top();
+        const auto [current_weight, current_depth, current_vertex, current_edge, parent] = pq_.top();
         pq_.pop();
 
-        const auto &[current_edge, direction, weight] = directed_edge;
-        auto current_state = create_state(current_vertex, current_depth);
-
-        auto position = total_cost_.find(current_state);
-        if (position != total_cost_.end()) {
-          if ((position->second < current_weight).ValueBool()) continue;
+        auto [position_it, inserted] =
+            state_positions_.try_emplace(create_state(current_vertex, current_depth), nodes_.size());
+        const auto position = position_it->second;
+        if (inserted) {
+          nodes_.push_back(AspNode{current_vertex, current_depth, current_weight, kNoDagEdge, kNoDagEdge});
+          if (current_depth < upper_bound_) expand_from_vertex(position);
         } else {
-          total_cost_.emplace(current_state, current_weight);
-          if (current_depth < upper_bound_) {
-            expand_from_vertex(current_vertex, current_weight, current_depth);
-          }
-        }
-
-        // Searching for a previous vertex in the expansion
-        auto prev_vertex = direction == EdgeAtom::Direction::IN ? current_edge.To() : current_edge.From();
-
-        // Update the parent
-        if (next_edges_.find({prev_vertex, current_depth - 1}) == next_edges_.end()) {
-          utils::pmr::list<DirectedEdge> empty(memory);
-          next_edges_[{prev_vertex, current_depth - 1}] = std::move(empty);
+          if ((nodes_[position].total_weight < current_weight).ValueBool()) continue;
+          // A state reached through a zero weight edge from a state settled
+          // after it would close a cycle in the DAG.
+          if (parent >= position) continue;
         }
-        next_edges_.at({prev_vertex, current_depth - 1}).emplace_back(directed_edge);
+        AddDagEdge(parent, current_edge, position);
       }
     };
 
@@ -2068,55 +2999,51 @@ class ExpandAllShortestPathsCursor : public query::plan::Cursor {
       throw QueryRuntimeException("Maximum depth in all shortest paths expansion must be at least 1.");
     }
 
-    // On first Pull run, traversal stack and priority queue are empty, so we start a pulling stream
-    // and create a DFS traversal tree (main part of algorithm). Then we return the first path
-    // created from the DFS traversal tree (basically a DFS algorithm).
-    // On each subsequent Pull run, paths are created from the traversal stack and returned.
+    // For each pulled vertex the DAG of its shortest paths is created at once,
+    // and then the paths are enumerated one per Pull by a DFS over the DAG,
+    // whose state is kept on the traversal stack. This way only the DAG is
+    // kept in memory, however many paths it contains.
     while (true) {
       // Check if there is an external error.
       AbortCheck(context);
 
-      // The algorithm is run all at once by create_DFS_traversal_tree, after which we
-      // traverse the tree iteratively by preserving the traversal state on stack.
-      while (!traversal_stack_.empty()) {
-        if (create_path()) return true;
+      if (!traversal_stack_.empty()) {
+        if (NextPath(frame)) return true;
+        continue;
       }
 
-      // If priority queue is empty start new pulling stream.
-      if (pq_.empty()) {
-        // Finish if there is nothing to pull
-        if (!input_cursor_->Pull(frame, context)) return false;
-
-        const auto &vertex_value = frame[self_.input_symbol_];
-        if (vertex_value.IsNull()) continue;
-
-        start_vertex = vertex_value.ValueVertex();
-        if (self_.common_.existing_node) {
-          const auto &node = frame[self_.common_.node_symbol];
-          // Due to optional matching the existing node could be null.
-          // Skip expansion for such nodes.
-          if (node.IsNull()) continue;
-        }
+      // Finish if there is nothing to pull
+      if (!input_cursor_->Pull(frame, context)) return false;
 
-        // Clear existing data structures.
-        visited_cost_.clear();
-        next_edges_.clear();
-        traversal_stack_.clear();
-        total_cost_.clear();
+      const auto &vertex_value = frame[self_.input_symbol_];
+      if (vertex_value.IsNull()) continue;
 
-        expand_from_vertex(*start_vertex, TypedValue(), 0);
-        visited_cost_.emplace(*start_vertex, 0);
-        frame[self_.common_.edge_symbol] = TypedValue::TVector(memory);
+      const auto start_vertex = vertex_value.ValueVertex();
+      if (self_.common_.existing_node) {
+        const auto &node = frame[self_.common_.node_symbol];
+        // Due to optional matching the existing node could be null.
+        // Skip expansion for such nodes.
+        if (node.IsNull()) continue;
       }
 
-      // Create a DFS traversal tree from the start node
-      create_DFS_traversal_tree();
+      // Clear existing data structures.
+      ClearDag();
+
+      nodes_.push_back(AspNode{start_vertex, 0, TypedValue(), kNoDagEdge, kNoDagEdge});
+      state_positions_.emplace(create_state(start_vertex, 0), 0);
+      expand_from_vertex(0);
+      visited_cost_.emplace(start_vertex, 0);
+      create_shortest_path_dag();
 
-      // DFS traversal tree is create,
-      if (start_vertex && next_edges_.find({*start_vertex, 0}) != next_edges_.end()) {
-        auto start_vertex_edges = next_edges_[{*start_vertex, 0}];
-        traversal_stack_.emplace_back(std::move(start_vertex_edges));
+      if (self_.path_count_symbol_) {
+        const auto count = CountPaths(frame);
+        if (count == 0) continue;
+        frame[*self_.path_count_symbol_] = TypedValue(count, context.evaluation_context.memory);
+        return true;
       }
+
+      frame[self_.common_.edge_symbol] = TypedValue::TVector(context.evaluation_context.memory);
+      traversal_stack_.emplace_back(0, nodes_[0].first_edge);
     }
   }
 
@@ -2124,11 +3051,7 @@ class ExpandAllShortestPathsCursor : public query::plan::Cursor {
 
   void Reset() override {
     input_cursor_->Reset();
-    visited_cost_.clear();
-    next_edges_.clear();
-    traversal_stack_.clear();
-    total_cost_.clear();
-    ClearQueue();
+    ClearDag();
   }
 
  private:
@@ -2145,16 +3068,130 @@ class ExpandAllShortestPathsCursor : public query::plan::Cursor {
     }
   };
 
-  using DirectedEdge = std::tuple<EdgeAccessor, EdgeAtom::Direction, TypedValue>;
-  using NextEdgesState = std::pair<VertexAccessor, int64_t>;
+  static constexpr size_t kNoDagEdge = std::numeric_limits<size_t>::max();
+
+  // State settled by the expansion, a vertex and the depth it was reached at
+  // if there is an upper bound.
+  struct AspNode {
+    VertexAccessor vertex;
+    int64_t depth;
+    TypedValue total_weight;
+    // First and last of the DAG edges leaving the state, linked through
+    // `DagEdge::next`.
+    size_t first_edge;
+    size_t last_edge;
+  };
+
+  // Edge of a shortest path between two settled states. The edges always lead
+  // to a state settled later, so the DAG has no cycles.
+  struct DagEdge {
+    EdgeAccessor edge;
+    size_t to;
+    size_t next;
+  };
+
   // Maps vertices to minimum weights they got in expansion.
   utils::pmr::unordered_map<VertexAccessor, TypedValue> visited_cost_;
-  // Maps vertices to weights they got in expansion.
-  utils::pmr::unordered_map<NextEdgesState, TypedValue, AspStateHash> total_cost_;
-  // Maps the vertex with the potential expansion edge.
-  utils::pmr::unordered_map<NextEdgesState, utils::pmr::list<DirectedEdge>, AspStateHash> next_edges_;
-  // Stack indicating the traversal level.
-  utils::pmr::list<utils::pmr::list<DirectedEdge>> traversal_stack_;
+  // Maps the settled states to their positions in `nodes_`.
+  utils::pmr::unordered_map<std::pair<VertexAccessor, int64_t>, size_t, AspStateHash> state_positions_;
+  // Settled states in the order they were settled in.
+  utils::pmr::vector<AspNode> nodes_;
+  utils::pmr::vector<DagEdge> dag_edges_;
+  // States on the path currently on the frame, each with its next DAG edge
+  // to be taken.
+  utils::pmr::vector<std::pair<size_t, size_t>> traversal_stack_;
+
+  void AddDagEdge(size_t from, const EdgeAccessor &edge, size_t to) {
+    const auto position = dag_edges_.size();
+    dag_edges_.push_back(DagEdge{edge, to, kNoDagEdge});
+    auto &node = nodes_[from];
+    if (node.last_edge == kNoDagEdge) {
+      node.first_edge = position;
+    } else {
+      dag_edges_[node.last_edge].next = position;
+    }
+    node.last_edge = position;
+  }
+
+  void ClearDag() {
+    visited_cost_.clear();
+    state_positions_.clear();
+    nodes_.clear();
+    dag_edges_.clear();
+    traversal_stack_.clear();
+    ClearQueue();
+  }
+
+  // Returns true if the paths reaching the state are returned, which are the
+  // ones with the lowest weight to the vertex ending at the existing node.
+  bool IsPathEnd(const AspNode &node, const Frame &frame) const {
+    if ((node.total_weight > visited_cost_.at(node.vertex)).ValueBool()) return false;
+    if (self_.common_.existing_node) {
+      const auto &existing = frame[self_.common_.node_symbol];
+      ExpectType(self_.common_.node_symbol, existing, TypedValue::Type::Vertex);
+      return existing.ValueVertex() == node.vertex;
+    }
+    return true;
+  }
+
+  // Continues the DFS over the DAG until the next returned path is on the
+  // frame.
+  bool NextPath(Frame &frame) {
+    auto &edges_on_frame = frame[self_.common_.edge_symbol].ValueList();
+    while (!traversal_stack_.empty()) {
+      auto &next_edge = traversal_stack_.back().second;
+      if (next_edge == kNoDagEdge) {
+        traversal_stack_.pop_back();
+        if (!traversal_stack_.empty()) {
+          if (!self_.is_reverse_) {
+            edges_on_frame.pop_back();
+          } else {
+            edges_on_frame.erase(edges_on_frame.begin());
+          }
+        }
+        continue;
+      }
+
+      const auto &dag_edge = dag_edges_[next_edge];
+      next_edge = dag_edge.next;
+      // Edges order depends on direction of expansion
+      if (!self_.is_reverse_) {
+        edges_on_frame.emplace_back(dag_edge.edge);
+      } else {
+        edges_on_frame.emplace(edges_on_frame.begin(), dag_edge.edge);
+      }
+      const auto &node = nodes_[dag_edge.to];
+      traversal_stack_.emplace_back(dag_edge.to, node.first_edge);
+
+      if (!IsPathEnd(node, frame)) continue;
+      if (!self_.common_.existing_node) frame[self_.common_.node_symbol] = node.vertex;
+      frame[self_.total_weight_.value()] = node.total_weight;
+      return true;
+    }
+    return false;
+  }
+
+  // Returns the number of the paths the DFS would return. Each DAG edge leads
+  // to a later settled state, so the paths to a state are all counted before
+  // the state is expanded.
+  int64_t CountPaths(const Frame &frame) const {
+    std::vector<int64_t> paths_to(nodes_.size(), 0);
+    paths_to[0] = 1;
+    int64_t count = 0;
+    for (size_t position = 0; position < nodes_.size(); ++position) {
+      if (position != 0 && IsPathEnd(nodes_[position], frame) &&
+          __builtin_add_overflow(count, paths_to[position], &count)) {
+        throw QueryRuntimeException("The number of all shortest paths is too large to be counted.");
+      }
+      for (auto edge = nodes_[position].first_edge; edge != kNoDagEdge; edge = dag_edges_[edge].next) {
+        auto &paths = paths_to[dag_edges_[edge].to];
+        if (__builtin_add_overflow(paths, paths_to[position], &paths)) {
+          throw QueryRuntimeException("The number of all shortest paths is too large to be counted.");
+        }
+      }
+    }
+    return count;
+  }
 
   static void ValidateWeightTypes(const TypedValue &lhs, const TypedValue &rhs) {
     if (!((lhs.IsNumeric() && lhs.IsNumeric()) || (rhs.IsDuration() && rhs.IsDuration()))) {
@@ -2165,11 +3202,12 @@ class ExpandAllShortestPathsCursor : public query::plan::Cursor {
     }
   }
 
+  using QueueEntry = std::tuple<TypedValue, int64_t, VertexAccessor, EdgeAccessor, size_t>;
+
   // Priority queue comparator. Keep lowest weight on top of the queue.
   class PriorityQueueComparator {
    public:
-    bool operator()(const std::tuple<TypedValue, int64_t, VertexAccessor, DirectedEdge> &lhs,
-                    const std::tuple<TypedValue, int64_t, VertexAccessor, DirectedEdge> &rhs) {
+    bool operator()(const QueueEntry &lhs, const QueueEntry &rhs) {
       const auto &lhs_weight = std::get<0>(lhs);
       const auto &rhs_weight = std::get<0>(rhs);
       // Null defines minimum value for all types
@@ -2187,11 +3225,8 @@ class ExpandAllShortestPathsCursor : public query::plan::Cursor {
   };
 
   // Priority queue - core element of the algorithm.
-  // Stores: {weight, depth, next vertex, edge and direction}
-  std::priority_queue<std::tuple<TypedValue, int64_t, VertexAccessor, DirectedEdge>,
-                      utils::pmr::vector<std::tuple<TypedValue, int64_t, VertexAccessor, DirectedEdge>>,
-                      PriorityQueueComparator>
-      pq_;
+  // Stores: {weight, depth, next vertex, edge, position of the expanded state}
+  std::priority_queue<QueueEntry, utils::pmr::vector<QueueEntry>, PriorityQueueComparator> pq_;
 
   void ClearQueue() {
     while (!pq_.empty()) pq_.pop();
@@ -2219,70 +3254,285 @@ UniqueCursorPtr ExpandVariable::MakeCursor(utils::MemoryResource *mem) const {
   }
 }
 
-class ConstructNamedPathCursor : public Cursor {
- public:
-  ConstructNamedPathCursor(const ConstructNamedPath &self, utils::MemoryResource *mem)
-      : self_(self), input_cursor_(self_.input()->MakeCursor(mem)) {}
+ACCEPT_WITH_INPUT(IntersectExpand)
 
-  bool Pull(Frame &frame, ExecutionContext &context) override {
-    SCOPED_PROFILE_OP("ConstructNamedPath");
+std::vector<Symbol> IntersectExpand::ModifiedSymbols(const SymbolTable &table) const {
+  auto symbols = input_->ModifiedSymbols(table);
+  symbols.emplace_back(node_symbol_);
+  for (const auto &edge : edges_) symbols.emplace_back(edge.edge_symbol);
+  return symbols;
+}
 
-    if (!input_cursor_->Pull(frame, context)) return false;
+namespace {
 
-    auto symbol_it = self_.path_elements_.begin();
-    DMG_ASSERT(symbol_it != self_.path_elements_.end(), "Named path must contain at least one node");
+bool CanReadEdge(const EdgeAccessor &edge, ExecutionContext &context) {
+#ifdef MG_ENTERPRISE
+  return !(license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
+           !context.auth_checker->Has(edge, memgraph::query::AuthQuery::FineGrainedPrivilege::READ));
+#else
+  return true;
+#endif
+}
 
-    const auto &start_vertex = frame[*symbol_it++];
-    auto *pull_memory = context.evaluation_context.memory;
-    // In an OPTIONAL MATCH everything could be Null.
-    if (start_vertex.IsNull()) {
-      frame[self_.path_symbol_] = TypedValue(pull_memory);
-      return true;
-    }
+bool CanReadVertex(const VertexAccessor &vertex, storage::View view, ExecutionContext &context) {
+#ifdef MG_ENTERPRISE
+  return !(license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
+           !context.auth_checker->Has(vertex, view, memgraph::query::AuthQuery::FineGrainedPrivilege::READ));
+#else
+  return true;
+#endif
+}
 
-    DMG_ASSERT(start_vertex.IsVertex(), "First named path element must be a vertex");
-    query::Path path(start_vertex.ValueVertex(), pull_memory);
+size_t ApproximateDegree(const VertexAccessor &vertex, EdgeAtom::Direction direction) {
+  size_t degree = 0;
+  if (direction != EdgeAtom::Direction::OUT) degree += vertex.ApproximateInDegree();
+  if (direction != EdgeAtom::Direction::IN) degree += vertex.ApproximateOutDegree();
+  return degree;
+}
 
-    // If the last path element symbol was for an edge list, then
-    // the next symbol is a vertex and it should not append to the path
-    // because
-    // expansion already did it.
-    bool last_was_edge_list = false;
+class IntersectExpandCursor : public Cursor {
+ public:
+  IntersectExpandCursor(const IntersectExpand &self, utils::MemoryResource *mem)
+      : self_(self),
+        input_cursor_(self.input_->MakeCursor(mem)),
+        vertices_(mem),
+        candidates_(mem),
+        matches_(self.edges_.size(), mem),
+        positions_(self.edges_.size(), 0, mem) {
+    MG_ASSERT(self_.edges_.size() >= 2, "IntersectExpand needs at least 2 edges");
+  }
 
-    for (; symbol_it != self_.path_elements_.end(); symbol_it++) {
-      const auto &expansion = frame[*symbol_it];
-      //  We can have Null (OPTIONAL MATCH), a vertex, an edge, or an edge
-      //  list (variable expand or BFS).
-      switch (expansion.type()) {
-        case TypedValue::Type::Null:
-          frame[self_.path_symbol_] = TypedValue(pull_memory);
-          return true;
-        case TypedValue::Type::Vertex:
-          if (!last_was_edge_list) path.Expand(expansion.ValueVertex());
-          last_was_edge_list = false;
-          break;
-        case TypedValue::Type::Edge:
-          path.Expand(expansion.ValueEdge());
-          break;
-        case TypedValue::Type::List: {
-          last_was_edge_list = true;
-          // We need to expand all edges in the list and intermediary
-          // vertices.
-          const auto &edges = expansion.ValueList();
-          for (const auto &edge_value : edges) {
-            const auto &edge = edge_value.ValueEdge();
-            const auto &from = edge.From();
-            if (path.vertices().back() == from)
-              path.Expand(edge, edge.To());
-            else
-              path.Expand(edge, from);
-          }
-          break;
-        }
-        default:
-          LOG_FATAL("Unsupported type in named path construction");
+  bool Pull(Frame &frame, ExecutionContext &context) override {
+    SCOPED_PROFILE_OP("IntersectExpand");
 
-          break;
+    while (true) {
+      AbortCheck(context);
+      if (has_match_) {
+        SetMatch(frame);
+        has_match_ = NextCombination();
+        return true;
+      }
+      if (next_candidate_ < candidates_.size()) {
+        has_match_ = FindMatches(candidates_[next_candidate_++], context);
+        continue;
+      }
+      if (!input_cursor_->Pull(frame, context)) return false;
+      InitCandidates(frame, context);
+    }
+  }
+
+  void Shutdown() override { input_cursor_->Shutdown(); }
+
+  void Reset() override {
+    input_cursor_->Reset();
+    vertices_.clear();
+    candidates_.clear();
+    next_candidate_ = 0;
+    has_match_ = false;
+  }
+
+ private:
+  using Candidate = std::pair<EdgeAccessor, VertexAccessor>;
+
+  // Collects the edges of the bound vertex with the fewest edges, whose other
+  // ends are the candidate neighbors. The degrees aren't known in advance in
+  // the on-disk storage, so the first vertex is used there.
+  void InitCandidates(Frame &frame, ExecutionContext &context) {
+    vertices_.clear();
+    candidates_.clear();
+    next_candidate_ = 0;
+    for (const auto &edge : self_.edges_) {
+      const auto &value = frame[edge.input_symbol];
+      // Null check due to possible failed optional match.
+      if (value.IsNull()) return;
+      ExpectType(edge.input_symbol, value, TypedValue::Type::Vertex);
+      vertices_.push_back(value.ValueVertex());
+    }
+
+    choose_end_ = context.db_accessor->GetStorageMode() != storage::StorageMode::ON_DISK_TRANSACTIONAL;
+    pivot_ = 0;
+    if (choose_end_) {
+      auto min_degree = std::numeric_limits<size_t>::max();
+      for (size_t i = 0; i < vertices_.size(); ++i) {
+        const auto degree = ApproximateDegree(vertices_[i], self_.edges_[i].direction);
+        if (degree < min_degree) {
+          min_degree = degree;
+          pivot_ = i;
+        }
+      }
+    }
+
+    const auto &vertex = vertices_[pivot_];
+    const auto &pivot_edge = self_.edges_[pivot_];
+    auto add_candidate = [&](const EdgeAccessor &edge, const VertexAccessor &neighbor) {
+      if (CanReadEdge(edge, context) && CanReadVertex(neighbor, self_.view_, context)) {
+        candidates_.emplace_back(edge, neighbor);
+      }
+    };
+    if (pivot_edge.direction != EdgeAtom::Direction::OUT) {
+      context.db_accessor->PrefetchInEdges(vertex);
+      for (const auto &edge : UnwrapEdgesResult(vertex.InEdges(self_.view_, pivot_edge.edge_types))) {
+        add_candidate(edge, edge.From());
+      }
+    }
+    if (pivot_edge.direction != EdgeAtom::Direction::IN) {
+      context.db_accessor->PrefetchOutEdges(vertex);
+      for (const auto &edge : UnwrapEdgesResult(vertex.OutEdges(self_.view_, pivot_edge.edge_types))) {
+        // A cycle was already taken from the in edges.
+        if (pivot_edge.direction == EdgeAtom::Direction::BOTH && edge.IsCycle()) continue;
+        add_candidate(edge, edge.To());
+      }
+    }
+  }
+
+  // Looks up the edges of the other bound vertices to the candidate neighbor,
+  // returns false if one of them has none.
+  bool FindMatches(const Candidate &candidate, ExecutionContext &context) {
+    const auto &neighbor = candidate.second;
+    for (size_t i = 0; i < vertices_.size(); ++i) {
+      positions_[i] = 0;
+      if (i == pivot_) continue;
+      auto &matches = matches_[i];
+      matches.clear();
+      const auto &edge = self_.edges_[i];
+      if (edge.direction != EdgeAtom::Direction::OUT) {
+        AppendEdgesBetween(neighbor, vertices_[i], edge, false, context, &matches);
+      }
+      if (edge.direction != EdgeAtom::Direction::IN) {
+        // A cycle was already taken from the in edges, as in the pivot.
+        AppendEdgesBetween(vertices_[i], neighbor, edge, edge.direction == EdgeAtom::Direction::BOTH, context,
+                           &matches);
+      }
+      if (matches.empty()) return false;
+    }
+    return true;
+  }
+
+  // Appends the edges from `from` to `to`, read from the end with fewer
+  // edges.
+  void AppendEdgesBetween(const VertexAccessor &from, const VertexAccessor &to, const IntersectEdge &edge,
+                          bool skip_cycles, ExecutionContext &context, utils::pmr::vector<EdgeAccessor> *matches) {
+    auto append = [&](auto &&edges) {
+      for (const auto &found : edges) {
+        if (skip_cycles && found.IsCycle()) continue;
+        if (CanReadEdge(found, context)) matches->push_back(found);
+      }
+    };
+    if (choose_end_ && to.ApproximateInDegree() < from.ApproximateOutDegree()) {
+      context.db_accessor->PrefetchInEdges(to);
+      append(UnwrapEdgesResult(to.InEdges(self_.view_, edge.edge_types, from)));
+    } else {
+      context.db_accessor->PrefetchOutEdges(from);
+      append(UnwrapEdgesResult(from.OutEdges(self_.view_, edge.edge_types, to)));
+    }
+  }
+
+  // Moves to the next combination of the edges to the current neighbor,
+  // returns false if all of them were produced.
+  bool NextCombination() {
+    for (auto i = vertices_.size(); i-- > 0;) {
+      if (i == pivot_) continue;
+      if (++positions_[i] < matches_[i].size()) return true;
+      positions_[i] = 0;
+    }
+    return false;
+  }
+
+  void SetMatch(Frame &frame) const {
+    const auto &candidate = candidates_[next_candidate_ - 1];
+    frame[self_.node_symbol_] = candidate.second;
+    for (size_t i = 0; i < vertices_.size(); ++i) {
+      frame[self_.edges_[i].edge_symbol] = i == pivot_ ? candidate.first : matches_[i][positions_[i]];
+    }
+  }
+
+  const IntersectExpand &self_;
+  const UniqueCursorPtr input_cursor_;
+  // Bound vertices of the current input, in the order of the edges.
+  utils::pmr::vector<VertexAccessor> vertices_;
+  // Edges of the pivot vertex with their other ends.
+  utils::pmr::vector<Candidate> candidates_;
+  size_t next_candidate_{0};
+  // Edges of each of the other vertices to the current candidate.
+  utils::pmr::vector<utils::pmr::vector<EdgeAccessor>> matches_;
+  utils::pmr::vector<size_t> positions_;
+  size_t pivot_{0};
+  bool choose_end_{true};
+  bool has_match_{false};
+};
+
+}  // namespace
+
+UniqueCursorPtr IntersectExpand::MakeCursor(utils::MemoryResource *mem) const {
+  memgraph::metrics::IncrementCounter(memgraph::metrics::IntersectExpandOperator);
+
+  return MakeUniqueCursorPtr<IntersectExpandCursor>(mem, *this, mem);
+}
+
+class ConstructNamedPathCursor : public Cursor {
+ public:
+  ConstructNamedPathCursor(const ConstructNamedPath &self, utils::MemoryResource *mem)
+      : self_(self), input_cursor_(self_.input()->MakeCursor(mem)) {}
+
+  bool Pull(Frame &frame, ExecutionContext &context) override {
+    SCOPED_PROFILE_OP("ConstructNamedPath");
+
+    if (!input_cursor_->Pull(frame, context)) return false;
+
+    auto symbol_it = self_.path_elements_.begin();
+    DMG_ASSERT(symbol_it != self_.path_elements_.end(), "Named path must contain at least one node");
+
+    const auto &start_vertex = frame[*symbol_it++];
+    auto *pull_memory = context.evaluation_context.memory;
+    // In an OPTIONAL MATCH everything could be Null.
+    if (start_vertex.IsNull()) {
+      frame[self_.path_symbol_] = TypedValue(pull_memory);
+      return true;
+    }
+
+    DMG_ASSERT(start_vertex.IsVertex(), "First named path element must be a vertex");
+    query::Path path(start_vertex.ValueVertex(), pull_memory);
+
+    // If the last path element symbol was for an edge list, then
+    // the next symbol is a vertex and it should not append to the path
+    // because
+    // expansion already did it.
+    bool last_was_edge_list = false;
+
+    for (; symbol_it != self_.path_elements_.end(); symbol_it++) {
+      const auto &expansion = frame[*symbol_it];
+      //  We can have Null (OPTIONAL MATCH), a vertex, an edge, or an edge
+      //  list (variable expand or BFS).
+      switch (expansion.type()) {
+        case TypedValue::Type::Null:
+          frame[self_.path_symbol_] = TypedValue(pull_memory);
+          return true;
+        case TypedValue::Type::Vertex:
+          if (!last_was_edge_list) path.Expand(expansion.ValueVertex());
+          last_was_edge_list = false;
+          break;
+        case TypedValue::Type::Edge:
+          path.Expand(expansion.ValueEdge());
+          break;
+        case TypedValue::Type::List: {
+          last_was_edge_list = true;
+          // We need to expand all edges in the list and intermediary
+          // vertices.
+          const auto &edges = expansion.ValueList();
+          for (const auto &edge_value : edges) {
+            const auto &edge = edge_value.ValueEdge();
+            const auto &from = edge.From();
+            if (path.vertices().back() == from)
+              path.Expand(edge, edge.To());
+            else
+              path.Expand(edge, from);
+          }
+          break;
+        }
+        default:
+          LOG_FATAL("Unsupported type in named path construction");
+
+          break;
       }
     }
 
@@ -2361,11 +3611,46 @@ bool Filter::FilterCursor::Pull(Frame &frame, ExecutionContext &context) {
   // nodes and edges.
   ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
                                 storage::View::OLD, context.frame_change_collector);
+  if (!expression_) {
+    expression_ =
+        std::make_unique<CompiledExpression>(self_.expression_, context.symbol_table, context.evaluation_context);
+  }
   while (input_cursor_->Pull(frame, context)) {
     for (const auto &pattern_filter_cursor : pattern_filter_cursors_) {
       pattern_filter_cursor->Pull(frame, context);
     }
-    if (EvaluateFilter(evaluator, self_.expression_)) return true;
+    if (expression_->EvaluateFilter(frame, evaluator)) return true;
+  }
+  return false;
+}
+
+bool Filter::FilterCursor::PullBatch(Frame &frame, FrameBatch &batch, ExecutionContext &context) {
+  SCOPED_PROFILE_OP("Filter");
+
+  if (!expression_) {
+    expression_ =
+        std::make_unique<CompiledExpression>(self_.expression_, context.symbol_table, context.evaluation_context);
+  }
+  if (pattern_filter_cursors_.empty() && expression_->CanFilterBatch()) {
+    // The comparisons are evaluated a column at a time over the whole batch.
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                  storage::View::OLD, context.frame_change_collector);
+    while (input_cursor_->PullBatch(frame, batch, context)) {
+      expression_->FilterBatch(batch, evaluator);
+      if (!batch.empty()) return true;
+    }
+    return false;
+  }
+  while (input_cursor_->PullBatch(frame, batch, context)) {
+    batch.Retain([&](Frame &row) {
+      for (const auto &pattern_filter_cursor : pattern_filter_cursors_) {
+        pattern_filter_cursor->Pull(row, context);
+      }
+      ExpressionEvaluator evaluator(&row, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                    storage::View::OLD, context.frame_change_collector);
+      return expression_->EvaluateFilter(row, evaluator);
+    });
+    if (!batch.empty()) return true;
   }
   return false;
 }
@@ -2387,7 +3672,7 @@ UniqueCursorPtr EvaluatePatternFilter::MakeCursor(utils::MemoryResource *mem) co
 
 EvaluatePatternFilter::EvaluatePatternFilterCursor::EvaluatePatternFilterCursor(const EvaluatePatternFilter &self,
                                                                                 utils::MemoryResource *mem)
-    : self_(self), input_cursor_(self_.input_->MakeCursor(mem)) {}
+    : self_(self), input_cursor_(self_.input_->MakeCursor(mem)), memoized_results_(mem) {}
 
 std::vector<Symbol> EvaluatePatternFilter::ModifiedSymbols(const SymbolTable &table) const {
   return input_->ModifiedSymbols(table);
@@ -2396,16 +3681,33 @@ std::vector<Symbol> EvaluatePatternFilter::ModifiedSymbols(const SymbolTable &ta
 bool EvaluatePatternFilter::EvaluatePatternFilterCursor::Pull(Frame &frame, ExecutionContext &context) {
   SCOPED_PROFILE_OP("EvaluatePatternFilter");
 
+  std::optional<SubqueryResultCache::Row> key;
+  if (self_.memoize_results_) {
+    key.emplace(memoized_results_.MakeKey(frame, self_.correlated_symbols_));
+    if (const auto *rows = memoized_results_.Find(*key)) {
+      frame[self_.output_symbol_] = TypedValue((*rows)[0][0], context.evaluation_context.memory);
+      return true;
+    }
+  }
+
   input_cursor_->Reset();
 
   frame[self_.output_symbol_] = TypedValue(input_cursor_->Pull(frame, context), context.evaluation_context.memory);
 
+  if (key) {
+    SubqueryResultCache::Rows rows(memoized_results_.memory());
+    rows.emplace_back().emplace_back(frame[self_.output_symbol_]);
+    memoized_results_.Insert(std::move(*key), std::move(rows));
+  }
   return true;
 }
 
 void EvaluatePatternFilter::EvaluatePatternFilterCursor::Shutdown() { input_cursor_->Shutdown(); }
 
-void EvaluatePatternFilter::EvaluatePatternFilterCursor::Reset() { input_cursor_->Reset(); }
+void EvaluatePatternFilter::EvaluatePatternFilterCursor::Reset() {
+  input_cursor_->Reset();
+  memoized_results_.Clear();
+}
 
 Produce::Produce(const std::shared_ptr<LogicalOperator> &input, const std::vector<NamedExpression *> &named_expressions)
     : input_(input ? input : std::make_shared<Once>()), named_expressions_(named_expressions) {}
@@ -2434,24 +3736,67 @@ Produce::ProduceCursor::ProduceCursor(const Produce &self, utils::MemoryResource
 bool Produce::ProduceCursor::Pull(Frame &frame, ExecutionContext &context) {
   SCOPED_PROFILE_OP("Produce");
 
+  if (!use_batches_) {
+    use_batches_ = UseBatches(*self_.input_, context);
+    if (*use_batches_) {
+      batch_symbols_ = self_.input_->ModifiedSymbols(context.symbol_table);
+      for (auto &symbol : self_.OutputSymbols(context.symbol_table)) {
+        if (!utils::Contains(batch_symbols_, symbol)) batch_symbols_.push_back(std::move(symbol));
+      }
+    }
+  }
+  if (*use_batches_) return PullFromBatch(frame, context);
+
   if (input_cursor_->Pull(frame, context)) {
     // Produce should always yield the latest results.
     ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
                                   storage::View::NEW, context.frame_change_collector);
-    for (auto *named_expr : self_.named_expressions_) {
-      if (context.frame_change_collector && context.frame_change_collector->IsKeyTracked(named_expr->name_)) {
-        context.frame_change_collector->ResetTrackingValue(named_expr->name_);
-      }
-      named_expr->Accept(evaluator);
-    }
+    EvaluateNamedExpressions(frame, evaluator, context);
     return true;
   }
   return false;
 }
 
+void Produce::ProduceCursor::EvaluateNamedExpressions(Frame &frame, ExpressionEvaluator &evaluator,
+                                                      ExecutionContext &context) {
+  if (expressions_.empty()) {
+    expressions_.reserve(self_.named_expressions_.size());
+    for (auto *named_expr : self_.named_expressions_) {
+      expressions_.emplace_back(named_expr->expression_, context.symbol_table, context.evaluation_context);
+    }
+  }
+  for (size_t i = 0; i < self_.named_expressions_.size(); ++i) {
+    auto *named_expr = self_.named_expressions_[i];
+    if (context.frame_change_collector && context.frame_change_collector->IsKeyTracked(named_expr->name_)) {
+      context.frame_change_collector->ResetTrackingValue(named_expr->name_);
+    }
+    frame[context.symbol_table.at(*named_expr)] = expressions_[i].Evaluate(frame, evaluator);
+  }
+}
+
+bool Produce::ProduceCursor::PullFromBatch(Frame &frame, ExecutionContext &context) {
+  if (!input_batch_.Next(*input_cursor_, frame, context)) return false;
+
+  // The named expressions are evaluated only when the row is produced, so that
+  // they see the changes made by the operators that consumed the previous rows.
+  auto &row = input_batch_.row();
+  ExpressionEvaluator evaluator(&row, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                storage::View::NEW);
+  EvaluateNamedExpressions(row, evaluator, context);
+  // The operators after Produce may still read the symbols of its input, e.g.
+  // in ORDER BY.
+  for (const auto &symbol : batch_symbols_) {
+    frame[symbol] = std::move(row[symbol]);
+  }
+  return true;
+}
+
 void Produce::ProduceCursor::Shutdown() { input_cursor_->Shutdown(); }
 
-void Produce::ProduceCursor::Reset() { input_cursor_->Reset(); }
+void Produce::ProduceCursor::Reset() {
+  input_cursor_->Reset();
+  input_batch_.Reset();
+}
 
 Delete::Delete(const std::shared_ptr<LogicalOperator> &input_, const std::vector<Expression *> &expressions,
                bool detach_)
@@ -2473,6 +3818,14 @@ Delete::DeleteCursor::DeleteCursor(const Delete &self, utils::MemoryResource *me
 bool Delete::DeleteCursor::Pull(Frame &frame, ExecutionContext &context) {
   SCOPED_PROFILE_OP("Delete");
 
+  if (!use_batches_) {
+    // DELETE without DETACH keeps deleting row by row, so that it fails on the
+    // first vertex which still has edges.
+    use_batches_ = self_.detach_ && UseBatches(*self_.input_, context);
+    if (*use_batches_) batch_symbols_ = self_.input_->ModifiedSymbols(context.symbol_table);
+  }
+  if (*use_batches_) return PullFromBatch(frame, context);
+
   if (!input_cursor_->Pull(frame, context)) return false;
 
   // Delete should get the latest information, this way it is also possible
@@ -2489,39 +3842,10 @@ bool Delete::DeleteCursor::Pull(Frame &frame, ExecutionContext &context) {
     expression_results.emplace_back(expression->Accept(evaluator));
   }
 
-  auto &dba = *context.db_accessor;
   // delete edges first
-  for (TypedValue &expression_result : expression_results) {
-    AbortCheck(context);
-    if (expression_result.type() == TypedValue::Type::Edge) {
-      auto &ea = expression_result.ValueEdge();
-#ifdef MG_ENTERPRISE
-      if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
-          !(context.auth_checker->Has(ea, query::AuthQuery::FineGrainedPrivilege::CREATE_DELETE) &&
-            context.auth_checker->Has(ea.To(), storage::View::NEW, query::AuthQuery::FineGrainedPrivilege::UPDATE) &&
-            context.auth_checker->Has(ea.From(), storage::View::NEW, query::AuthQuery::FineGrainedPrivilege::UPDATE))) {
-        throw QueryRuntimeException("Edge not deleted due to not having enough permission!");
-      }
-#endif
-      auto maybe_value = dba.RemoveEdge(&ea);
-      if (maybe_value.HasError()) {
-        switch (maybe_value.GetError()) {
-          case storage::Error::SERIALIZATION_ERROR:
-            throw TransactionSerializationException();
-          case storage::Error::DELETED_OBJECT:
-          case storage::Error::VERTEX_HAS_EDGES:
-          case storage::Error::PROPERTIES_DISABLED:
-          case storage::Error::NONEXISTENT_OBJECT:
-            throw QueryRuntimeException("Unexpected error when deleting an edge.");
-        }
-      }
-      context.execution_stats[ExecutionStats::Key::DELETED_EDGES] += 1;
-      if (context.trigger_context_collector && maybe_value.GetValue()) {
-        context.trigger_context_collector->RegisterDeletedObject(*maybe_value.GetValue());
-      }
-    }
-  }
+  DeleteEdges(expression_results, context);
 
+  auto &dba = *context.db_accessor;
   // delete vertices
   for (TypedValue &expression_result : expression_results) {
     AbortCheck(context);
@@ -2601,39 +3925,184 @@ bool Delete::DeleteCursor::Pull(Frame &frame, ExecutionContext &context) {
   return true;
 }
 
-void Delete::DeleteCursor::Shutdown() { input_cursor_->Shutdown(); }
-
-void Delete::DeleteCursor::Reset() { input_cursor_->Reset(); }
-
-SetProperty::SetProperty(const std::shared_ptr<LogicalOperator> &input, storage::PropertyId property,
-                         PropertyLookup *lhs, Expression *rhs)
-    : input_(input), property_(property), lhs_(lhs), rhs_(rhs) {}
-
-ACCEPT_WITH_INPUT(SetProperty)
-
-UniqueCursorPtr SetProperty::MakeCursor(utils::MemoryResource *mem) const {
-  memgraph::metrics::IncrementCounter(memgraph::metrics::SetPropertyOperator);
-
-  return MakeUniqueCursorPtr<SetPropertyCursor>(mem, *this, mem);
+void Delete::DeleteCursor::DeleteEdges(utils::pmr::vector<TypedValue> &expression_results,
+                                       ExecutionContext &context) {
+  auto &dba = *context.db_accessor;
+  for (TypedValue &expression_result : expression_results) {
+    AbortCheck(context);
+    if (expression_result.type() == TypedValue::Type::Edge) {
+      auto &ea = expression_result.ValueEdge();
+#ifdef MG_ENTERPRISE
+      if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
+          !(context.auth_checker->Has(ea, query::AuthQuery::FineGrainedPrivilege::CREATE_DELETE) &&
+            context.auth_checker->Has(ea.To(), storage::View::NEW, query::AuthQuery::FineGrainedPrivilege::UPDATE) &&
+            context.auth_checker->Has(ea.From(), storage::View::NEW, query::AuthQuery::FineGrainedPrivilege::UPDATE))) {
+        throw QueryRuntimeException("Edge not deleted due to not having enough permission!");
+      }
+#endif
+      auto maybe_value = dba.RemoveEdge(&ea);
+      if (maybe_value.HasError()) {
+        switch (maybe_value.GetError()) {
+          case storage::Error::SERIALIZATION_ERROR:
+            throw TransactionSerializationException();
+          case storage::Error::DELETED_OBJECT:
+          case storage::Error::VERTEX_HAS_EDGES:
+          case storage::Error::PROPERTIES_DISABLED:
+          case storage::Error::NONEXISTENT_OBJECT:
+            throw QueryRuntimeException("Unexpected error when deleting an edge.");
+        }
+      }
+      context.execution_stats[ExecutionStats::Key::DELETED_EDGES] += 1;
+      if (context.trigger_context_collector && maybe_value.GetValue()) {
+        context.trigger_context_collector->RegisterDeletedObject(*maybe_value.GetValue());
+      }
+    }
+  }
 }
 
-std::vector<Symbol> SetProperty::ModifiedSymbols(const SymbolTable &table) const {
-  return input_->ModifiedSymbols(table);
-}
+bool Delete::DeleteCursor::PullFromBatch(Frame &frame, ExecutionContext &context) {
+  if (!input_batch_.Next(*input_cursor_, frame, context)) return false;
+  if (input_batch_.PulledBatch()) DeleteBatch(context);
 
-SetProperty::SetPropertyCursor::SetPropertyCursor(const SetProperty &self, utils::MemoryResource *mem)
-    : self_(self), input_cursor_(self.input_->MakeCursor(mem)) {}
+  auto &row = input_batch_.row();
+  for (const auto &symbol : batch_symbols_) {
+    frame[symbol] = std::move(row[symbol]);
+  }
+  return true;
+}
 
-bool SetProperty::SetPropertyCursor::Pull(Frame &frame, ExecutionContext &context) {
-  SCOPED_PROFILE_OP("SetProperty");
+void Delete::DeleteCursor::DeleteBatch(ExecutionContext &context) {
+  auto &rows = input_batch_.batch();
+  utils::pmr::vector<TypedValue> expression_results(context.evaluation_context.memory);
+  expression_results.reserve(rows.size() * self_.expressions_.size());
+  for (size_t row = 0; row < rows.size(); ++row) {
+    ExpressionEvaluator evaluator(&rows[row], context.symbol_table, context.evaluation_context, context.db_accessor,
+                                  storage::View::NEW);
+    for (Expression *expression : self_.expressions_) {
+      expression_results.emplace_back(expression->Accept(evaluator));
+    }
+  }
 
-  if (!input_cursor_->Pull(frame, context)) return false;
+  DeleteEdges(expression_results, context);
 
-  // Set, just like Create needs to see the latest changes.
-  ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
-                                storage::View::NEW);
-  TypedValue lhs = self_.lhs_->expression_->Accept(evaluator);
-  TypedValue rhs = self_.rhs_->Accept(evaluator);
+  std::vector<VertexAccessor *> vertices;
+  for (TypedValue &expression_result : expression_results) {
+    AbortCheck(context);
+    switch (expression_result.type()) {
+      case TypedValue::Type::Vertex: {
+        auto &va = expression_result.ValueVertex();
+#ifdef MG_ENTERPRISE
+        if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
+            !context.auth_checker->Has(va, storage::View::NEW, query::AuthQuery::FineGrainedPrivilege::CREATE_DELETE)) {
+          throw QueryRuntimeException("Vertex not deleted due to not having enough permission!");
+        }
+#endif
+        vertices.push_back(&va);
+        break;
+      }
+      case TypedValue::Type::Edge:
+      case TypedValue::Type::Null:
+        break;
+      default:
+        throw QueryRuntimeException("Only edges and vertices can be deleted.");
+    }
+  }
+  if (vertices.empty()) return;
+
+  auto res = context.db_accessor->DetachRemoveVertices(vertices);
+  if (res.HasError()) {
+    switch (res.GetError()) {
+      case storage::Error::SERIALIZATION_ERROR:
+        throw TransactionSerializationException();
+      case storage::Error::DELETED_OBJECT:
+      case storage::Error::VERTEX_HAS_EDGES:
+      case storage::Error::PROPERTIES_DISABLED:
+      case storage::Error::NONEXISTENT_OBJECT:
+        throw QueryRuntimeException("Unexpected error when deleting a node.");
+    }
+  }
+
+  const auto &[deleted_vertices, deleted_edges] = *res;
+  context.execution_stats[ExecutionStats::Key::DELETED_NODES] += static_cast<int64_t>(deleted_vertices.size());
+  context.execution_stats[ExecutionStats::Key::DELETED_EDGES] += static_cast<int64_t>(deleted_edges.size());
+  if (!context.trigger_context_collector) return;
+  for (const auto &vertex : deleted_vertices) {
+    context.trigger_context_collector->RegisterDeletedObject(vertex);
+  }
+  if (!context.trigger_context_collector->ShouldRegisterDeletedObject<query::EdgeAccessor>()) return;
+  for (const auto &edge : deleted_edges) {
+    context.trigger_context_collector->RegisterDeletedObject(edge);
+  }
+}
+
+void Delete::DeleteCursor::Shutdown() { input_cursor_->Shutdown(); }
+
+void Delete::DeleteCursor::Reset() {
+  input_cursor_->Reset();
+  input_batch_.Reset();
+}
+
+SetProperty::SetProperty(const std::shared_ptr<LogicalOperator> &input, storage::PropertyId property,
+                         PropertyLookup *lhs, Expression *rhs)
+    : input_(input), property_(property), lhs_(lhs), rhs_(rhs) {}
+
+ACCEPT_WITH_INPUT(SetProperty)
+
+UniqueCursorPtr SetProperty::MakeCursor(utils::MemoryResource *mem) const {
+  memgraph::metrics::IncrementCounter(memgraph::metrics::SetPropertyOperator);
+
+  return MakeUniqueCursorPtr<SetPropertyCursor>(mem, *this, mem);
+}
+
+std::vector<Symbol> SetProperty::ModifiedSymbols(const SymbolTable &table) const {
+  return input_->ModifiedSymbols(table);
+}
+
+namespace {
+/// Returns the expression added to the property if the property is set to its
+/// own value plus the expression, as in `SET n.views = n.views + 1`.
+Expression *FindPropertyAddend(const SetProperty &self) {
+  auto *addition = utils::Downcast<AdditionOperator>(self.rhs_);
+  if (!addition) return nullptr;
+  auto *lookup = utils::Downcast<PropertyLookup>(addition->expression1_);
+  if (!lookup || lookup->property_.ix != self.lhs_->property_.ix) return nullptr;
+  auto *identifier = utils::Downcast<Identifier>(lookup->expression_);
+  auto *target = utils::Downcast<Identifier>(self.lhs_->expression_);
+  if (!identifier || !target || identifier->symbol_pos_ != target->symbol_pos_) return nullptr;
+  return addition->expression2_;
+}
+}  // namespace
+
+SetProperty::SetPropertyCursor::SetPropertyCursor(const SetProperty &self, utils::MemoryResource *mem)
+    : self_(self), input_cursor_(self.input_->MakeCursor(mem)), addend_(FindPropertyAddend(self)) {}
+
+bool SetProperty::SetPropertyCursor::Pull(Frame &frame, ExecutionContext &context) {
+  SCOPED_PROFILE_OP("SetProperty");
+
+  if (!input_cursor_->Pull(frame, context)) return false;
+
+  // Set, just like Create needs to see the latest changes.
+  ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                storage::View::NEW);
+  TypedValue lhs = self_.lhs_->expression_->Accept(evaluator);
+
+  // The triggers get the old and the new value of the property, which aren't
+  // known until the increment is made when committing.
+  if (addend_ && context.commutative_increments && !context.trigger_context_collector && lhs.IsVertex()) {
+#ifdef MG_ENTERPRISE
+    if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
+        !context.auth_checker->Has(lhs.ValueVertex(), storage::View::NEW,
+                                   memgraph::query::AuthQuery::FineGrainedPrivilege::UPDATE)) {
+      throw QueryRuntimeException("Vertex property not set due to not having enough permission!");
+    }
+#endif
+    if (PropsAddChecked(&lhs.ValueVertex(), self_.property_, addend_->Accept(evaluator))) {
+      context.execution_stats[ExecutionStats::Key::UPDATED_PROPERTIES] += 1;
+      return true;
+    }
+  }
+
+  TypedValue rhs = self_.rhs_->Accept(evaluator);
 
   switch (lhs.type()) {
     case TypedValue::Type::Vertex: {
@@ -2787,6 +4256,8 @@ void SetPropertiesOnRecord(TRecordAccessor *record, const TypedValue &rhs, SetPr
 
   auto update_props = [&, record](PropertiesMap &new_properties) {
     auto updated_properties = UpdatePropertiesChecked(record, new_properties);
+    context->execution_stats[ExecutionStats::Key::UPDATED_PROPERTIES] +=
+        static_cast<int64_t>(updated_properties.size());
 
     if (should_register_change) {
       for (const auto &[id, old_value, new_value] : updated_properties) {
@@ -2809,7 +4280,7 @@ void SetPropertiesOnRecord(TRecordAccessor *record, const TypedValue &rhs, SetPr
     case TypedValue::Type::Map: {
       PropertiesMap new_properties;
       for (const auto &[prop_id, prop_value] : rhs.ValueMap()) {
-        auto key = context->db_accessor->NameToProperty(prop_id);
+        auto key = context->evaluation_context.property_names.Resolve(prop_id, context->db_accessor);
         new_properties.emplace(key, prop_value);
       }
       update_props(new_properties);
@@ -3129,18 +4600,36 @@ EdgeUniquenessFilter::EdgeUniquenessFilterCursor::EdgeUniquenessFilterCursor(con
     : self_(self), input_cursor_(self.input_->MakeCursor(mem)) {}
 
 namespace {
+// The most comparisons of the edges of two paths made one by one. The edges of
+// longer paths are compared through a set.
+constexpr size_t kMaxPairwiseEdgeComparisons = 16;
+
 /**
  * Returns true if:
  *    - a and b are either edge or edge-list values, and there
  *    is at least one matching edge in the two values
  */
-bool ContainsSameEdge(const TypedValue &a, const TypedValue &b) {
-  auto compare_to_list = [](const TypedValue &list, const TypedValue &other) {
+bool ContainsSameEdge(const TypedValue &a, const TypedValue &b, utils::MemoryResource *memory) {
+  auto compare_to_list = [memory](const TypedValue &list, const TypedValue &other) {
     for (const TypedValue &list_elem : list.ValueList())
-      if (ContainsSameEdge(list_elem, other)) return true;
+      if (ContainsSameEdge(list_elem, other, memory)) return true;
     return false;
   };
 
+  if (a.type() == TypedValue::Type::List && b.type() == TypedValue::Type::List) {
+    // Comparing each edge of a long path with each edge of another one is
+    // quadratic, so the edges of the shorter path are looked up instead.
+    const auto *shorter = &a.ValueList();
+    const auto *longer = &b.ValueList();
+    if (shorter->size() > longer->size()) std::swap(shorter, longer);
+    if (shorter->size() * longer->size() > kMaxPairwiseEdgeComparisons) {
+      utils::pmr::unordered_set<storage::Gid> edges(memory);
+      edges.reserve(shorter->size());
+      for (const auto &edge : *shorter) edges.insert(edge.ValueEdge().Gid());
+      return std::any_of(longer->begin(), longer->end(),
+                         [&edges](const TypedValue &edge) { return edges.contains(edge.ValueEdge().Gid()); });
+    }
+  }
   if (a.type() == TypedValue::Type::List) return compare_to_list(a, b);
   if (b.type() == TypedValue::Type::List) return compare_to_list(b, a);
 
@@ -3158,7 +4647,7 @@ bool EdgeUniquenessFilter::EdgeUniquenessFilterCursor::Pull(Frame &frame, Execut
       // This shouldn't raise a TypedValueException, because the planner
       // makes sure these are all of the expected type. In case they are not
       // an error should be raised long before this code is executed.
-      if (ContainsSameEdge(previous_value, expand_value)) return false;
+      if (ContainsSameEdge(previous_value, expand_value, context.evaluation_context.memory)) return false;
     }
     return true;
   };
@@ -3188,14 +4677,16 @@ std::vector<Symbol> EmptyResult::ModifiedSymbols(const SymbolTable &) const {  /
 class EmptyResultCursor : public Cursor {
  public:
   EmptyResultCursor(const EmptyResult &self, utils::MemoryResource *mem)
-      : input_cursor_(self.input_->MakeCursor(mem)) {}
+      : self_(self), input_cursor_(self.input_->MakeCursor(mem)) {}
 
   bool Pull(Frame &frame, ExecutionContext &context) override {
     SCOPED_PROFILE_OP("EmptyResult");
 
     if (!pulled_all_input_) {
-      while (input_cursor_->Pull(frame, context)) {
-        AbortCheck(context);
+      if (!PullAllInParallel(frame, context)) {
+        while (input_cursor_->Pull(frame, context)) {
+          AbortCheck(context);
+        }
       }
       pulled_all_input_ = true;
     }
@@ -3210,6 +4701,9 @@ class EmptyResultCursor : public Cursor {
   }
 
  private:
+  bool PullAllInParallel(Frame &frame, ExecutionContext &context);
+
+  const EmptyResult &self_;
   const UniqueCursorPtr input_cursor_;
   bool pulled_all_input_{false};
 };
@@ -3220,6 +4714,113 @@ UniqueCursorPtr EmptyResult::MakeCursor(utils::MemoryResource *mem) const {
   return MakeUniqueCursorPtr<EmptyResultCursor>(mem, *this, mem);
 }
 
+PeriodicCommit::PeriodicCommit(const std::shared_ptr<LogicalOperator> &input, Expression *commit_frequency)
+    : input_(input), commit_frequency_(commit_frequency) {}
+
+ACCEPT_WITH_INPUT(PeriodicCommit)
+
+std::vector<Symbol> PeriodicCommit::OutputSymbols(const SymbolTable &symbol_table) const {
+  return input_->OutputSymbols(symbol_table);
+}
+
+std::vector<Symbol> PeriodicCommit::ModifiedSymbols(const SymbolTable &table) const {
+  return input_->ModifiedSymbols(table);
+}
+
+namespace {
+
+template <typename>
+constexpr auto kAlwaysFalse = false;
+
+void CommitPeriodically(DbAccessor &dba) {
+  auto maybe_commit_error = dba.PeriodicCommit();
+  if (!maybe_commit_error.HasError()) return;
+
+  std::visit(
+      [&dba]<typename T>(T &&arg) {
+        using ErrorType = std::remove_cvref_t<T>;
+        if constexpr (std::is_same_v<ErrorType, storage::ReplicationError>) {
+          // The batch is committed on main, so the query carries on like it
+          // would if the replica confirmed it.
+          spdlog::warn("At least one SYNC replica has not confirmed the periodic commit.");
+        } else if constexpr (std::is_same_v<ErrorType, storage::ConstraintViolation>) {
+          const auto &constraint_violation = arg;
+          const auto &label_name = dba.LabelToName(constraint_violation.label);
+          switch (constraint_violation.type) {
+            case storage::ConstraintViolation::Type::EXISTENCE: {
+              MG_ASSERT(constraint_violation.properties.size() == 1U);
+              const auto &property_name = dba.PropertyToName(*constraint_violation.properties.begin());
+              throw QueryRuntimeException("Unable to commit due to existence constraint violation on :{}({})",
+                                          label_name, property_name);
+            }
+            case storage::ConstraintViolation::Type::UNIQUE: {
+              std::stringstream property_names_stream;
+              utils::PrintIterable(property_names_stream, constraint_violation.properties, ", ",
+                                   [&dba](auto &stream, const auto &prop) { stream << dba.PropertyToName(prop); });
+              throw QueryRuntimeException("Unable to commit due to unique constraint violation on :{}({})",
+                                          label_name, property_names_stream.str());
+            }
+          }
+        } else if constexpr (std::is_same_v<ErrorType, storage::SerializationError>) {
+          throw QueryRuntimeException("Unable to commit due to serialization error.");
+        } else {
+          static_assert(kAlwaysFalse<T>, "Missing type from variant visitor");
+        }
+      },
+      maybe_commit_error.GetError());
+}
+
+class PeriodicCommitCursor : public Cursor {
+ public:
+  PeriodicCommitCursor(const PeriodicCommit &self, utils::MemoryResource *mem)
+      : self_(self), input_cursor_(self.input_->MakeCursor(mem)) {}
+
+  bool Pull(Frame &frame, ExecutionContext &context) override {
+    SCOPED_PROFILE_OP("PeriodicCommit");
+
+    // The frequency can't contain identifiers, like the limit can't, so it's
+    // evaluated once before pulling the input.
+    if (commit_frequency_ == -1) {
+      if (context.trigger_context_collector) {
+        throw QueryRuntimeException("Periodic commit can't be used while there are active triggers.");
+      }
+      ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                    storage::View::OLD);
+      TypedValue commit_frequency = self_.commit_frequency_->Accept(evaluator);
+      if (commit_frequency.type() != TypedValue::Type::Int || commit_frequency.ValueInt() <= 0) {
+        throw QueryRuntimeException("Periodic commit frequency must be a positive integer.");
+      }
+      commit_frequency_ = commit_frequency.ValueInt();
+    }
+
+    if (!input_cursor_->Pull(frame, context)) return false;
+    if (++pulled_ % commit_frequency_ == 0) CommitPeriodically(*context.db_accessor);
+    return true;
+  }
+
+  void Shutdown() override { input_cursor_->Shutdown(); }
+
+  void Reset() override {
+    input_cursor_->Reset();
+    commit_frequency_ = -1;
+    pulled_ = 0;
+  }
+
+ private:
+  const PeriodicCommit &self_;
+  const UniqueCursorPtr input_cursor_;
+  int64_t commit_frequency_{-1};
+  int64_t pulled_{0};
+};
+
+}  // namespace
+
+UniqueCursorPtr PeriodicCommit::MakeCursor(utils::MemoryResource *mem) const {
+  memgraph::metrics::IncrementCounter(memgraph::metrics::PeriodicCommitOperator);
+
+  return MakeUniqueCursorPtr<PeriodicCommitCursor>(mem, *this, mem);
+}
+
 Accumulate::Accumulate(const std::shared_ptr<LogicalOperator> &input, const std::vector<Symbol> &symbols,
                        bool advance_command)
     : input_(input), symbols_(symbols), advance_command_(advance_command) {}
@@ -3253,12 +4854,14 @@ class AccumulateCursor : public Cursor {
 
     AbortCheck(context);
     if (cache_it_ == cache_.end()) return false;
+    // Every cached row is placed on the frame once, so its values are moved
+    // instead of copying the lists, maps and strings in them.
     auto row_it = (cache_it_++)->begin();
     for (const Symbol &symbol : self_.symbols_) {
       if (context.frame_change_collector && context.frame_change_collector->IsKeyTracked(symbol.name())) {
         context.frame_change_collector->ResetTrackingValue(symbol.name());
       }
-      frame[symbol] = *row_it++;
+      frame[symbol] = std::move(*row_it++);
     }
     return true;
   }
@@ -3311,9 +4914,11 @@ TypedValue DefaultAggregationOpValue(const Aggregate::Element &element, utils::M
     case Aggregation::Op::MIN:
     case Aggregation::Op::MAX:
     case Aggregation::Op::AVG:
+    case Aggregation::Op::APPROX_PERCENTILE:
       return TypedValue(memory);
     case Aggregation::Op::COUNT:
     case Aggregation::Op::SUM:
+    case Aggregation::Op::APPROX_COUNT_DISTINCT:
       return TypedValue(0, memory);
     case Aggregation::Op::COLLECT_LIST:
       return TypedValue(TypedValue::TVector(memory));
@@ -3323,12 +4928,350 @@ TypedValue DefaultAggregationOpValue(const Aggregate::Element &element, utils::M
       return TypedValue(query::Graph(memory));
   }
 }
+
+// Number of morsels per worker thread in parallel execution. Having several
+// morsels per worker lets the workers that got cheaper morsels take over the
+// remaining ones.
+constexpr uint64_t kMorselsPerThread = 8;
+
+/** Returns the ScanAll or ScanAllByLabel at the bottom of `op` if `op` is a
+ * pipeline that can be pulled by several threads at once, each one scanning
+ * its own morsel of vertices. Otherwise nullptr is returned. Only read-only operators that don't
+ * keep state across input rows are allowed in such a pipeline. */
+const ScanAll *FindParallelScan(const LogicalOperator &op) {
+  const auto *current = &op;
+  while (true) {
+    const auto &type = current->GetTypeInfo();
+    if (type == ScanAll::kType || type == ScanAllByLabel::kType) {
+      const auto *scan = static_cast<const ScanAll *>(current);
+      return scan->input()->GetTypeInfo() == Once::kType ? scan : nullptr;
+    }
+    if (type == Filter::kType) {
+      if (!static_cast<const Filter *>(current)->pattern_filters_.empty()) return nullptr;
+    } else if (type != Expand::kType) {
+      return nullptr;
+    }
+    current = current->input().get();
+  }
+}
+
+/** Returns the ScanAll, ScanAllByLabel or Unwind at the bottom of `op` if `op`
+ * is a pipeline of writes that can be pulled by several threads at once in the
+ * analytical storage mode, each one over its own morsel of vertices or list
+ * elements. Otherwise nullptr is returned. The objects are only created over
+ * an Unwind, so the scans of all vertices don't see the vertices created by
+ * the other threads. The rows may still be matched to the existing vertices
+ * by id or by an indexed property. Deletes and merges aren't allowed, and
+ * neither are the operators that keep state across input rows. */
+const LogicalOperator *FindParallelWriteInput(const LogicalOperator &op) {
+  const auto *current = &op;
+  bool creates = false;
+  bool writes = false;
+  while (true) {
+    const auto &type = current->GetTypeInfo();
+    if (type == ScanAll::kType || type == ScanAllByLabel::kType || type == Unwind::kType) {
+      if (!writes || current->input()->GetTypeInfo() != Once::kType) return nullptr;
+      return type == Unwind::kType || !creates ? current : nullptr;
+    }
+    if (type == CreateNode::kType || type == CreateExpand::kType) {
+      creates = writes = true;
+    } else if (type == SetProperty::kType || type == SetProperties::kType || type == SetLabels::kType ||
+               type == RemoveProperty::kType || type == RemoveLabels::kType) {
+      writes = true;
+    } else if (type == Filter::kType) {
+      if (!static_cast<const Filter *>(current)->pattern_filters_.empty()) return nullptr;
+    } else if (type != Expand::kType && type != EdgeUniquenessFilter::kType &&
+               type != ScanAllByLabelPropertyValue::kType && type != ScanAllById::kType) {
+      return nullptr;
+    }
+    current = current->input().get();
+  }
+}
+
+/** Returns true if partial results of the given aggregations, computed on
+ * disjoint parts of the input, can be merged into the final result. */
+bool CanMergeAggregations(const std::vector<Aggregate::Element> &aggregations) {
+  return std::all_of(aggregations.begin(), aggregations.end(), [](const auto &elem) {
+    return !elem.distinct && elem.op != Aggregation::Op::PROJECT;
+  });
+}
+
+/** Creates the context of a worker thread of a parallel pipeline. The worker
+ * shares the transaction and the abort conditions with `context`, but has its
+ * own evaluation memory and profiling statistics. */
+ExecutionContext MakeWorkerContext(const ExecutionContext &context, utils::MemoryResource *memory) {
+  ExecutionContext worker_context;
+  worker_context.db_accessor = context.db_accessor;
+  worker_context.symbol_table = context.symbol_table;
+  worker_context.evaluation_context.memory = memory;
+  worker_context.evaluation_context.timestamp = context.evaluation_context.timestamp;
+  worker_context.evaluation_context.parameters = context.evaluation_context.parameters;
+  worker_context.evaluation_context.properties = context.evaluation_context.properties;
+  worker_context.evaluation_context.labels = context.evaluation_context.labels;
+  worker_context.is_shutting_down = context.is_shutting_down;
+  worker_context.transaction_status = context.transaction_status;
+  worker_context.is_profile_query = context.is_profile_query;
+  worker_context.timer = context.timer;
+  worker_context.query_id = context.query_id;
+  return worker_context;
+}
+
+/** Open-addressing index over the groups of an aggregation whose group-by
+ * values are all integers, strings or vertices. Such keys are hashed and
+ * compared without the generic TypedValue dispatch, and the groups are found
+ * without building a new key vector. The groups themselves are still stored
+ * in the aggregation map, whose nodes are stable, so the index only points to
+ * them. Groups with other keys aren't indexed and are looked up in the map. */
+template <typename TEntry>
+class FlatGroupIndex {
+ public:
+  using TKey = utils::pmr::vector<TypedValue>;
+
+  explicit FlatGroupIndex(utils::MemoryResource *mem) : slots_(mem) {}
+
+  /** Returns the hash of the key, or std::nullopt if the key can't be indexed. */
+  static std::optional<size_t> Hash(const TKey &key) {
+    size_t hash = key.size();
+    for (const auto &value : key) {
+      size_t value_hash = 0;
+      switch (value.type()) {
+        case TypedValue::Type::Int:
+          value_hash = static_cast<size_t>(value.ValueInt());
+          break;
+        case TypedValue::Type::String:
+          value_hash = std::hash<std::string_view>{}(value.ValueString());
+          break;
+        case TypedValue::Type::Vertex:
+          value_hash = value.ValueVertex().Gid().AsUint();
+          break;
+        default:
+          return std::nullopt;
+      }
+      hash = hash * 31 + value_hash;
+    }
+    return hash;
+  }
+
+  /** Returns true if the keys have the same indexable values. */
+  static bool Equal(const TKey &lhs, const TKey &rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    for (size_t i = 0; i < lhs.size(); ++i) {
+      if (lhs[i].type() != rhs[i].type()) return false;
+      switch (lhs[i].type()) {
+        case TypedValue::Type::Int:
+          if (lhs[i].ValueInt() != rhs[i].ValueInt()) return false;
+          break;
+        case TypedValue::Type::String:
+          if (lhs[i].ValueString() != rhs[i].ValueString()) return false;
+          break;
+        case TypedValue::Type::Vertex:
+          if (lhs[i].ValueVertex() != rhs[i].ValueVertex()) return false;
+          break;
+        default:
+          return false;
+      }
+    }
+    return true;
+  }
+
+  TEntry *Find(const TKey &key, size_t hash) const {
+    if (slots_.empty()) return nullptr;
+    for (auto slot = SlotOf(hash);; slot = (slot + 1) & (slots_.size() - 1)) {
+      const auto &[slot_hash, entry] = slots_[slot];
+      if (!entry) return nullptr;
+      if (slot_hash == hash && Equal(entry->first, key)) return entry;
+    }
+  }
+
+  /** Indexes the entry, whose key mustn't be indexed yet. */
+  void Insert(TEntry *entry, size_t hash) {
+    // The load factor is kept at or below one half.
+    if (2 * (size_ + 1) > slots_.size()) Grow();
+    Place(entry, hash);
+    ++size_;
+  }
+
+  void Clear() {
+    slots_.clear();
+    size_ = 0;
+    capacity_bits_ = 0;
+  }
+
+ private:
+  struct Slot {
+    size_t hash;
+    TEntry *entry;
+  };
+
+  size_t SlotOf(size_t hash) const {
+    // Fibonacci hashing spreads the consecutive integer keys.
+    return (hash * 0x9E3779B97F4A7C15ULL) >> (std::numeric_limits<size_t>::digits - capacity_bits_);
+  }
+
+  void Place(TEntry *entry, size_t hash) {
+    auto slot = SlotOf(hash);
+    while (slots_[slot].entry) slot = (slot + 1) & (slots_.size() - 1);
+    slots_[slot] = Slot{hash, entry};
+  }
+
+  void Grow() {
+    utils::pmr::vector<Slot> old_slots(slots_.get_allocator().GetMemoryResource());
+    old_slots.swap(slots_);
+    capacity_bits_ = capacity_bits_ == 0 ? kInitialCapacityBits : capacity_bits_ + 1;
+    slots_.resize(size_t{1} << capacity_bits_, Slot{0, nullptr});
+    for (const auto &[hash, entry] : old_slots) {
+      if (entry) Place(entry, hash);
+    }
+  }
+
+  static constexpr size_t kInitialCapacityBits = 4;
+
+  utils::pmr::vector<Slot> slots_;
+  size_t size_{0};
+  size_t capacity_bits_{0};
+};
 }  // namespace
 
+/**
+ * Pulls the input on up to `context.parallelism` threads if the storage is in
+ * the analytical mode and the input is a pipeline of writes over a ScanAll,
+ * ScanAllByLabel or Unwind, e.g. a bulk import with `UNWIND $rows AS row
+ * CREATE ...`. The analytical mode doesn't create deltas, so the threads only
+ * synchronize on the locks of the objects they change. The order in which the
+ * changes are made isn't defined, so the last write to the same property
+ * wins.
+ *
+ * Returns false if the input can't be pulled in parallel, nothing has been
+ * pulled then.
+ */
+bool EmptyResultCursor::PullAllInParallel(Frame &frame, ExecutionContext &context) {
+  if (context.parallelism <= 1 || context.scan_morsel || context.unwind_morsel || context.frame_change_collector ||
+      context.trigger_context_collector) {
+    return false;
+  }
+  if (context.db_accessor->GetStorageMode() != storage::StorageMode::IN_MEMORY_ANALYTICAL) return false;
+#ifdef MG_ENTERPRISE
+  // The fine-grained auth checker isn't safe to be shared among threads.
+  if (context.auth_checker) return false;
+#endif
+  const auto *bottom = FindParallelWriteInput(*self_.input_);
+  if (!bottom) return false;
+
+  const auto max_morsels = context.parallelism * kMorselsPerThread;
+  std::vector<VerticesIterable> scan_morsels;
+  std::vector<UnwindMorsel> unwind_morsels;
+  TypedValue unwind_values(context.evaluation_context.memory);
+  if (bottom->GetTypeInfo() == Unwind::kType) {
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                  storage::View::OLD);
+    unwind_values = static_cast<const Unwind *>(bottom)->input_expression_->Accept(evaluator);
+    if (unwind_values.type() != TypedValue::Type::List) {
+      throw QueryRuntimeException("Argument of UNWIND must be a list, but '{}' was provided.", unwind_values.type());
+    }
+    const auto &values = unwind_values.ValueList();
+    const auto morsel_size = std::max<size_t>(1, (values.size() + max_morsels - 1) / max_morsels);
+    for (size_t begin = 0; begin < values.size(); begin += morsel_size) {
+      unwind_morsels.push_back({.values = &values, .begin = begin, .end = std::min(values.size(), begin + morsel_size)});
+    }
+  } else {
+    const auto *scan = static_cast<const ScanAll *>(bottom);
+    scan_morsels = scan->GetTypeInfo() == ScanAllByLabel::kType
+                       ? context.db_accessor->PartitionVertices(
+                             scan->view_, static_cast<const ScanAllByLabel *>(scan)->label_, max_morsels)
+                       : context.db_accessor->PartitionVertices(scan->view_, max_morsels);
+  }
+  const auto num_morsels = std::max(scan_morsels.size(), unwind_morsels.size());
+  if (num_morsels <= 1) return false;
+  const auto num_workers = std::min<uint64_t>(context.parallelism, num_morsels);
+
+  // Workers allocate from the memory of the current pull, so the memory
+  // limit of the query still applies to them.
+  utils::ConcurrentPoolResource shared_memory(1024U, context.evaluation_context.memory);
+
+  struct Worker {
+    Worker(const LogicalOperator &input, Frame &outer_frame, const ExecutionContext &context,
+           utils::MemoryResource *upstream)
+        : monotonic_memory(kWorkerInitialMemory, upstream),
+          pool_memory(128U, 1024U, &monotonic_memory, upstream),
+          context(MakeWorkerContext(context, &pool_memory)),
+          frame(static_cast<int64_t>(outer_frame.elems().size()), &pool_memory),
+          cursor(input.MakeCursor(&pool_memory)) {
+      std::copy(outer_frame.elems().begin(), outer_frame.elems().end(), frame.elems().begin());
+    }
+
+    static constexpr size_t kWorkerInitialMemory = 64UL * 1024UL;
+
+    utils::MonotonicBufferResource monotonic_memory;
+    utils::PoolResource pool_memory;
+    ExecutionContext context;
+    Frame frame;
+    UniqueCursorPtr cursor;
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  workers.reserve(num_workers);
+  for (uint64_t i = 0; i < num_workers; ++i) {
+    workers.push_back(std::make_unique<Worker>(*self_.input_, frame, context, &shared_memory));
+  }
+
+  // The workers read and change the vertices in the same transaction, whose
+  // cache of long delta chains isn't synchronized.
+  context.db_accessor->SuspendVertexInfoCache();
+  utils::OnScopeExit resume_cache([&] { context.db_accessor->ResumeVertexInfoCache(); });
+
+  std::atomic<uint64_t> next_morsel{0};
+  std::atomic<bool> failed{false};
+  utils::Synchronized<std::exception_ptr, utils::SpinLock> error;
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(num_workers);
+    for (auto &worker : workers) {
+      threads.emplace_back([&worker = *worker, &scan_morsels, &unwind_morsels, num_morsels, &next_morsel, &failed,
+                            &error] {
+        try {
+          while (!failed.load(std::memory_order_acquire)) {
+            const auto morsel = next_morsel.fetch_add(1, std::memory_order_acq_rel);
+            if (morsel >= num_morsels) break;
+            if (unwind_morsels.empty()) {
+              worker.context.scan_morsel = &scan_morsels[morsel];
+            } else {
+              worker.context.unwind_morsel = &unwind_morsels[morsel];
+            }
+            while (worker.cursor->Pull(worker.frame, worker.context)) AbortCheck(worker.context);
+            worker.cursor->Reset();
+          }
+        } catch (...) {
+          failed.store(true, std::memory_order_release);
+          auto locked_error = error.Lock();
+          if (!*locked_error) *locked_error = std::current_exception();
+        }
+        worker.context.scan_morsel = nullptr;
+        worker.context.unwind_morsel = nullptr;
+      });
+    }
+  }
+
+  if (auto thrown = *error.Lock()) std::rethrow_exception(thrown);
+
+  for (auto &worker : workers) {
+    for (size_t i = 0; i < context.execution_stats.counters.size(); ++i) {
+      context.execution_stats.counters[i] += worker->context.execution_stats.counters[i];
+    }
+    if (context.is_profile_query && context.stats_root && worker->context.stats.name) {
+      MergeParallelProfilingStats(worker->context.stats, num_workers, context.stats_root);
+    }
+  }
+  return true;
+}
+
 class AggregateCursor : public Cursor {
  public:
   AggregateCursor(const Aggregate &self, utils::MemoryResource *mem)
-      : self_(self), input_cursor_(self_.input_->MakeCursor(mem)), aggregation_(mem) {}
+      : self_(self),
+        input_cursor_(self_.input_->MakeCursor(mem)),
+        aggregation_(mem),
+        flat_index_(mem),
+        group_by_values_(mem) {}
 
   bool Pull(Frame &frame, ExecutionContext &context) override {
     SCOPED_PROFILE_OP("Aggregate");
@@ -3338,7 +5281,7 @@ class AggregateCursor : public Cursor {
       pulled_all_input_ = true;
       aggregation_it_ = aggregation_.begin();
 
-      if (aggregation_.empty()) {
+      if (aggregation_.empty() && partitions_.empty()) {
         auto *pull_memory = context.evaluation_context.memory;
         // place default aggregation values on the frame
         for (const auto &elem : self_.aggregations_) {
@@ -3359,16 +5302,27 @@ class AggregateCursor : public Cursor {
       }
     }
 
-    if (aggregation_it_ == aggregation_.end()) return false;
+    // The spilled groups are aggregated one partition at a time.
+    while (aggregation_it_ == aggregation_.end()) {
+      if (current_partition_ == partitions_.size()) return false;
+      AbortCheck(context);
+      aggregation_.clear();
+      flat_index_.Clear();
+      auto partition = std::move(partitions_[current_partition_++]);
+      LoadPartition(partition.get());
+      FinishAggregations(context.evaluation_context.memory);
+      aggregation_it_ = aggregation_.begin();
+    }
 
-    // place aggregation values on the frame
+    // place aggregation values on the frame, moving them since every group is
+    // output once
     auto aggregation_values_it = aggregation_it_->second.values_.begin();
     for (const auto &aggregation_elem : self_.aggregations_)
-      frame[aggregation_elem.output_sym] = *aggregation_values_it++;
+      frame[aggregation_elem.output_sym] = std::move(*aggregation_values_it++);
 
     // place remember values on the frame
     auto remember_values_it = aggregation_it_->second.remember_.begin();
-    for (const Symbol &remember_sym : self_.remember_) frame[remember_sym] = *remember_values_it++;
+    for (const Symbol &remember_sym : self_.remember_) frame[remember_sym] = std::move(*remember_values_it++);
 
     aggregation_it_++;
     return true;
@@ -3379,8 +5333,13 @@ class AggregateCursor : public Cursor {
   void Reset() override {
     input_cursor_->Reset();
     aggregation_.clear();
+    flat_index_.Clear();
     aggregation_it_ = aggregation_.begin();
     pulled_all_input_ = false;
+    can_spill_ = false;
+    aggregation_bytes_ = 0;
+    partitions_.clear();
+    current_partition_ = 0;
   }
 
  private:
@@ -3392,84 +5351,682 @@ class AggregateCursor : public Cursor {
     explicit AggregationValue(utils::MemoryResource *mem)
         : counts_(mem), values_(mem), remember_(mem), unique_values_(mem) {}
 
-    // how many input rows have been aggregated in respective values_ element so
-    // far
-    // TODO: The counting value type should be changed to an unsigned type once
-    // TypedValue can support signed integer values larger than 64bits so that
-    // precision isn't lost.
-    utils::pmr::vector<int64_t> counts_;
-    // aggregated values. Initially Null (until at least one input row with a
-    // valid value gets processed)
-    utils::pmr::vector<TypedValue> values_;
-    // remember values.
-    utils::pmr::vector<TypedValue> remember_;
+    // how many input rows have been aggregated in respective values_ element so
+    // far
+    // TODO: The counting value type should be changed to an unsigned type once
+    // TypedValue can support signed integer values larger than 64bits so that
+    // precision isn't lost.
+    utils::pmr::vector<int64_t> counts_;
+    // aggregated values. Initially Null (until at least one input row with a
+    // valid value gets processed)
+    utils::pmr::vector<TypedValue> values_;
+    // remember values.
+    utils::pmr::vector<TypedValue> remember_;
+
+    using TSet = utils::pmr::unordered_set<TypedValue, TypedValue::Hash, TypedValue::BoolEqual>;
+
+    utils::pmr::vector<TSet> unique_values_;
+  };
+
+  const Aggregate &self_;
+  const UniqueCursorPtr input_cursor_;
+  // storage for aggregated data
+  // map key is the vector of group-by values
+  // map value is an AggregationValue struct
+  utils::pmr::unordered_map<utils::pmr::vector<TypedValue>, AggregationValue,
+                            // use FNV collection hashing specialized for a
+                            // vector of TypedValues
+                            utils::FnvCollection<utils::pmr::vector<TypedValue>, TypedValue, TypedValue::Hash>,
+                            // custom equality
+                            TypedValueVectorEqual>
+      aggregation_;
+  // index over the groups of `aggregation_` with integer, string or vertex
+  // group-by values
+  FlatGroupIndex<typename decltype(aggregation_)::value_type> flat_index_;
+  // group-by values of the current input row, reused while they match
+  // existing groups
+  utils::pmr::vector<TypedValue> group_by_values_;
+  // iterator over the accumulated cache
+  decltype(aggregation_.begin()) aggregation_it_ = aggregation_.begin();
+  // this LogicalOp pulls all from the input on it's first pull
+  // this switch tracks if this has been performed
+  bool pulled_all_input_{false};
+  // rows of the input when it's pulled in batches
+  std::optional<FrameBatch> input_batch_;
+  // input values of each aggregation for the rows of a batch, and the
+  // integers or doubles among them which are passed to the kernels
+  std::vector<std::vector<TypedValue>> batch_values_;
+  std::vector<int64_t> batch_ints_;
+  std::vector<double> batch_doubles_;
+  // set if the groups may be spilled to disk once they take more than the
+  // memory limit of the context
+  bool can_spill_{false};
+  size_t aggregation_bytes_{0};
+  // partially aggregated groups spilled to disk, partitioned by the hash of
+  // their group-by values
+  std::vector<std::unique_ptr<SpillFile>> partitions_;
+  size_t current_partition_{0};
+
+  /**
+   * Pulls from the input operator until exhausted and aggregates the
+   * results. If the input operator is not provided, a single call
+   * to ProcessOne is issued.
+   *
+   * Accumulation automatically groups the results so that `aggregation_`
+   * cache cardinality depends on number of
+   * aggregation results, and not on the number of inputs.
+   */
+  void ProcessAll(Frame *frame, ExecutionContext *context) {
+    if (!ProcessAllFromColumns(frame, context) && !ProcessAllInParallel(frame, context)) {
+      // The partial aggregations of the spilled groups are merged later, so
+      // only the aggregations which can be merged are spilled.
+      can_spill_ = context->spill_memory_limit != 0 && CanMergeAggregations(self_.aggregations_);
+      ProcessInput(frame, context);
+    }
+
+    if (!partitions_.empty()) {
+      // Either all the groups are spilled and then read back one partition at
+      // a time, or none of them can be and all of them are read back now.
+      if (can_spill_) SpillAggregation(*context);
+      if (!can_spill_) {
+        for (auto &partition : partitions_) LoadPartition(partition.get());
+        partitions_.clear();
+      }
+    }
+
+    FinishAggregations(context->evaluation_context.memory);
+  }
+
+  /** Calculates the AVG aggregations, which have only been summed so far, and
+   * the approximate aggregations, which have only been sketched so far. */
+  void FinishAggregations(utils::MemoryResource *pull_memory) {
+    for (size_t pos = 0; pos < self_.aggregations_.size(); ++pos) {
+      const auto op = self_.aggregations_[pos].op;
+      if (op != Aggregation::Op::AVG && op != Aggregation::Op::APPROX_COUNT_DISTINCT &&
+          op != Aggregation::Op::APPROX_PERCENTILE) {
+        continue;
+      }
+      for (auto &kv : aggregation_) {
+        AggregationValue &agg_value = kv.second;
+        if (agg_value.counts_[pos] == 0) continue;
+        auto &value = agg_value.values_[pos];
+        if (op == Aggregation::Op::AVG) {
+          value = value / TypedValue(static_cast<double>(agg_value.counts_[pos]), pull_memory);
+        } else if (op == Aggregation::Op::APPROX_COUNT_DISTINCT) {
+          value = TypedValue(HyperLogLogEstimate(value.ValueString()), pull_memory);
+        } else {
+          const auto &sketch = value.ValueList();
+          const auto percentile = TDigestPercentile(sketch[1].ValueString(), sketch[0].ValueDouble());
+          value = percentile ? TypedValue(*percentile, pull_memory) : TypedValue(pull_memory);
+        }
+      }
+    }
+  }
+
+  /** Writes all the groups in `aggregation_` to the partitions on disk and
+   * clears it. If some of the values can't be spilled, nothing is written and
+   * the spilling is disabled. */
+  void SpillAggregation(const ExecutionContext &context) {
+    const auto can_spill = [](const auto &values) {
+      return std::all_of(values.begin(), values.end(), [](const auto &value) { return CanSpill(value); });
+    };
+    for (const auto &[group_by, agg_value] : aggregation_) {
+      if (!can_spill(group_by) || !can_spill(agg_value.values_) || !can_spill(agg_value.remember_)) {
+        can_spill_ = false;
+        return;
+      }
+    }
+
+    if (partitions_.empty()) {
+      for (size_t i = 0; i < kSpillPartitions; ++i) {
+        partitions_.emplace_back(std::make_unique<SpillFile>(context.spill_directory));
+      }
+    }
+    for (const auto &[group_by, agg_value] : aggregation_) {
+      auto &partition = partitions_[aggregation_.hash_function()(group_by) % kSpillPartitions];
+      for (const auto &value : group_by) partition->Write(value);
+      for (const auto count : agg_value.counts_) partition->Write(TypedValue(count));
+      for (const auto &value : agg_value.values_) partition->Write(value);
+      for (const auto &value : agg_value.remember_) partition->Write(value);
+    }
+    aggregation_.clear();
+    flat_index_.Clear();
+    aggregation_bytes_ = 0;
+  }
+
+  /** Reads all the groups of the partition and merges them into
+   * `aggregation_`. */
+  void LoadPartition(SpillFile *partition) {
+    auto *mem = aggregation_.get_allocator().GetMemoryResource();
+    while (!partition->AtEnd()) {
+      utils::pmr::vector<TypedValue> group_by(mem);
+      group_by.reserve(self_.group_by_.size());
+      for (size_t i = 0; i < self_.group_by_.size(); ++i) group_by.emplace_back(partition->Read(mem));
+      AggregationValue agg_value(mem);
+      for (size_t i = 0; i < self_.aggregations_.size(); ++i) {
+        agg_value.counts_.push_back(partition->Read(mem).ValueInt());
+      }
+      for (size_t i = 0; i < self_.aggregations_.size(); ++i) agg_value.values_.emplace_back(partition->Read(mem));
+      for (size_t i = 0; i < self_.remember_.size(); ++i) agg_value.remember_.emplace_back(partition->Read(mem));
+      MergeGroup(std::move(group_by), agg_value);
+    }
+  }
+
+  /** Pulls from the input operator until exhausted and aggregates the results
+   * into `aggregation_`. */
+  void ProcessInput(Frame *frame, ExecutionContext *context) {
+    if (UseBatches(*self_.input_, *context)) {
+      // The batch is kept across resets, so that it's allocated only once.
+      if (!input_batch_) {
+        input_batch_.emplace(static_cast<int64_t>(frame->elems().size()), FrameBatch::kDefaultCapacity,
+                             frame->GetMemoryResource());
+      }
+      auto &batch = *input_batch_;
+      const bool aggregates_batches = CanAggregateBatches();
+      while (input_cursor_->PullBatch(*frame, batch, *context)) {
+        if (aggregates_batches) {
+          ProcessBatch(batch, *context);
+          continue;
+        }
+        for (size_t row = 0; row < batch.size(); ++row) {
+          ExpressionEvaluator evaluator(&batch[row], context->symbol_table, context->evaluation_context,
+                                        context->db_accessor, storage::View::NEW);
+          ProcessOne(batch[row], &evaluator, *context);
+        }
+      }
+      return;
+    }
+
+    ExpressionEvaluator evaluator(frame, context->symbol_table, context->evaluation_context, context->db_accessor,
+                                  storage::View::NEW);
+    while (input_cursor_->Pull(*frame, *context)) {
+      ProcessOne(*frame, &evaluator, *context);
+    }
+  }
+
+  /** Returns true if the aggregations can be computed a batch at a time by
+   * `ProcessBatch`, which is the case for COUNT, MIN, MAX, SUM and AVG
+   * aggregations without DISTINCT and without grouping. */
+  bool CanAggregateBatches() const {
+    if (!self_.group_by_.empty()) return false;
+    return std::all_of(self_.aggregations_.begin(), self_.aggregations_.end(), [](const auto &agg_elem) {
+      switch (agg_elem.op) {
+        case Aggregation::Op::COUNT:
+        case Aggregation::Op::MIN:
+        case Aggregation::Op::MAX:
+        case Aggregation::Op::SUM:
+        case Aggregation::Op::AVG:
+          return !agg_elem.distinct;
+        default:
+          return false;
+      }
+    });
+  }
+
+  /** Aggregates all the rows of the batch into the single group. The input
+   * values are evaluated for all the rows first, and an aggregation whose
+   * values in the batch are all integers or all doubles is then computed by
+   * one of the vectorized kernels. */
+  void ProcessBatch(FrameBatch &batch, const ExecutionContext &context) {
+    if (batch.size() == 0) return;
+    auto *mem = aggregation_.get_allocator().GetMemoryResource();
+    auto [it, inserted] = aggregation_.try_emplace(utils::pmr::vector<TypedValue>(mem), mem);
+    auto &agg_value = it->second;
+    EnsureInitialized(batch[0], &agg_value);
+
+    const auto &aggregations = self_.aggregations_;
+    batch_values_.resize(aggregations.size());
+    for (size_t row = 0; row < batch.size(); ++row) {
+      ExpressionEvaluator evaluator(&batch[row], context.symbol_table, context.evaluation_context,
+                                    context.db_accessor, storage::View::NEW);
+      for (size_t pos = 0; pos < aggregations.size(); ++pos) {
+        if (aggregations[pos].value) batch_values_[pos].emplace_back(aggregations[pos].value->Accept(evaluator));
+      }
+    }
+
+    for (size_t pos = 0; pos < aggregations.size(); ++pos) {
+      auto &count = agg_value.counts_[pos];
+      auto &value = agg_value.values_[pos];
+      // COUNT(*) is the only case where input expression is optional
+      if (!aggregations[pos].value) {
+        count += static_cast<int64_t>(batch.size());
+        value = count;
+        continue;
+      }
+      AggregateColumn(aggregations[pos].op, batch_values_[pos], &count, &value);
+      // The values are allocated from the memory of the pull.
+      batch_values_[pos].clear();
+    }
+
+    if (!can_spill_) return;
+    if (inserted) aggregation_bytes_ += GroupSize(it->first, agg_value);
+    if (aggregation_bytes_ > context.spill_memory_limit) SpillAggregation(context);
+  }
+
+  /** Aggregates the input values of a batch like `AggregateValue` does for
+   * each of them one after another. */
+  void AggregateColumn(Aggregation::Op op, const std::vector<TypedValue> &values, int64_t *count, TypedValue *value) {
+    int64_t non_null = 0;
+    bool all_ints = true;
+    bool all_doubles = true;
+    for (const auto &input_value : values) {
+      if (input_value.IsNull()) continue;
+      ++non_null;
+      all_ints &= input_value.IsInt();
+      all_doubles &= input_value.IsDouble();
+    }
+    if (non_null == 0) return;
+    if (op == Aggregation::Op::COUNT) {
+      *count += non_null;
+      *value = *count;
+      return;
+    }
+
+    // The kernels are used only when they give the same result as aggregating
+    // the values one by one, which isn't the case for example when adding
+    // integers to a double sum.
+    const bool first = *count == 0;
+    const bool sums = op == Aggregation::Op::SUM || op == Aggregation::Op::AVG;
+    if (all_ints && (first || value->IsInt())) {
+      batch_ints_.clear();
+      for (const auto &input_value : values) {
+        if (input_value.IsInt()) batch_ints_.push_back(input_value.ValueInt());
+      }
+      const auto *ints = batch_ints_.data();
+      const auto size = batch_ints_.size();
+      int64_t result = 0;
+      if (sums) {
+        result = kernels::Sum(ints, size);
+        if (!first) result = static_cast<int64_t>(static_cast<uint64_t>(value->ValueInt()) + result);
+      } else if (op == Aggregation::Op::MIN) {
+        result = kernels::Min(ints, size);
+        if (!first) result = std::min(value->ValueInt(), result);
+      } else {
+        result = kernels::Max(ints, size);
+        if (!first) result = std::max(value->ValueInt(), result);
+      }
+      *count += non_null;
+      *value = result;
+      return;
+    }
+    if (all_doubles && (first || value->IsDouble() || (sums && value->IsInt()))) {
+      batch_doubles_.clear();
+      for (const auto &input_value : values) {
+        if (input_value.IsDouble()) batch_doubles_.push_back(input_value.ValueDouble());
+      }
+      // The first value starts the aggregation when there's no value yet.
+      const auto *doubles = batch_doubles_.data() + (first ? 1 : 0);
+      const auto size = batch_doubles_.size() - (first ? 1 : 0);
+      double current = batch_doubles_[0];
+      if (!first) current = value->IsInt() ? static_cast<double>(value->ValueInt()) : value->ValueDouble();
+      double result = 0.0;
+      if (sums) {
+        result = kernels::Sum(current, doubles, size);
+      } else if (op == Aggregation::Op::MIN) {
+        result = kernels::Min(current, doubles, size);
+      } else {
+        result = kernels::Max(current, doubles, size);
+      }
+      *count += non_null;
+      *value = result;
+      return;
+    }
+
+    for (const auto &input_value : values) {
+      if (input_value.IsNull()) continue;
+      *count += 1;
+      AggregateValue(op, input_value, *count, value);
+    }
+  }
+
+  /**
+   * Pulls the input on up to `context->parallelism` threads if the input is a
+   * read-only pipeline over a ScanAll or ScanAllByLabel (morsel-driven
+   * execution). The vertices are split into morsels that the workers take one
+   * by one. Each worker runs its own copy of the input cursors and aggregates
+   * into its own cache, and the caches are merged into `aggregation_` once all
+   * the morsels are done.
+   *
+   * Returns false if the input can't be pulled in parallel, nothing has been
+   * pulled then.
+   */
+  /** Aggregates the properties of the vertices with a label by reading their
+   * columns from the storage instead of pulling the label scan, see
+   * `storage::PropertyColumns`. Only done for the COUNT, SUM, AVG, MIN and MAX
+   * of the properties of the scanned vertices without grouping. Returns false
+   * if the input has to be pulled instead.
+   */
+  bool ProcessAllFromColumns(Frame *frame, ExecutionContext *context) {
+    if (!self_.group_by_.empty() || !self_.remember_.empty() || context->is_profile_query ||
+        context->frame_change_collector) {
+      return false;
+    }
+#ifdef MG_ENTERPRISE
+    if (context->auth_checker) return false;
+#endif
+    if (self_.input_->GetTypeInfo() != ScanAllByLabel::kType) return false;
+    const auto &scan = static_cast<const ScanAllByLabel &>(*self_.input_);
+    if (scan.input()->GetTypeInfo() != Once::kType) return false;
+
+    // COUNT(*) has no column.
+    std::vector<std::shared_ptr<const storage::PropertyColumn>> columns;
+    columns.reserve(self_.aggregations_.size());
+    std::optional<uint64_t> vertex_count;
+    for (const auto &elem : self_.aggregations_) {
+      if (elem.distinct || elem.key) return false;
+      if (elem.op != Aggregation::Op::COUNT && elem.op != Aggregation::Op::SUM && elem.op != Aggregation::Op::AVG &&
+          elem.op != Aggregation::Op::MIN && elem.op != Aggregation::Op::MAX) {
+        return false;
+      }
+      if (!elem.value) {
+        columns.emplace_back();
+        continue;
+      }
+      auto *lookup = utils::Downcast<PropertyLookup>(elem.value);
+      auto *identifier = lookup ? utils::Downcast<Identifier>(lookup->expression_) : nullptr;
+      if (!identifier || context->symbol_table.at(*identifier) != scan.output_symbol_) return false;
+      auto column = context->db_accessor->GetPropertyColumn(
+          scan.label_, context->evaluation_context.properties[lookup->property_.ix]);
+      if (!column) return false;
+      // The errors of the other aggregations of the values of other types are
+      // raised by the regular aggregation.
+      if (elem.op != Aggregation::Op::COUNT && !column->others.empty()) return false;
+      vertex_count = column->vertex_count;
+      columns.emplace_back(std::move(column));
+    }
+    if (!vertex_count) return false;
+    // Without any input the default values are returned.
+    if (*vertex_count == 0) return true;
+
+    auto *mem = aggregation_.get_allocator().GetMemoryResource();
+    auto &agg_value = aggregation_.try_emplace(utils::pmr::vector<TypedValue>(mem), mem).first->second;
+    EnsureInitialized(*frame, &agg_value);
+    for (size_t pos = 0; pos < self_.aggregations_.size(); ++pos) {
+      const auto *column = columns[pos].get();
+      auto &count = agg_value.counts_[pos];
+      auto &value = agg_value.values_[pos];
+      if (!column) {
+        count = static_cast<int64_t>(*vertex_count);
+        value = TypedValue(count, mem);
+        continue;
+      }
+      count = static_cast<int64_t>(column->ints.size() + column->doubles.size() + column->others.size());
+      if (count == 0) continue;
+      switch (self_.aggregations_[pos].op) {
+        case Aggregation::Op::COUNT:
+          value = TypedValue(count, mem);
+          break;
+        case Aggregation::Op::SUM:
+        case Aggregation::Op::AVG:
+          // The averages are divided by the count later.
+          value = SumColumn(*column, mem);
+          break;
+        case Aggregation::Op::MIN:
+        case Aggregation::Op::MAX:
+          value = MinMaxColumn(*column, self_.aggregations_[pos].op == Aggregation::Op::MIN, mem);
+          break;
+        default:
+          LOG_FATAL("Unexpected aggregation of a property column");
+      }
+    }
+    return true;
+  }
+
+  static TypedValue SumColumn(const storage::PropertyColumn &column, utils::MemoryResource *mem) {
+    // Summed as unsigned, so an overflow wraps around.
+    uint64_t int_sum = 0;
+    for (const auto value : column.ints) int_sum += static_cast<uint64_t>(value);
+    if (column.doubles.empty()) return TypedValue(static_cast<int64_t>(int_sum), mem);
+    double double_sum = 0;
+    for (const auto value : column.doubles) double_sum += value;
+    return TypedValue(static_cast<double>(static_cast<int64_t>(int_sum)) + double_sum, mem);
+  }
+
+  static TypedValue MinMaxColumn(const storage::PropertyColumn &column, bool is_min, utils::MemoryResource *mem) {
+    // Like the regular aggregation, the first of the equal values is kept.
+    std::optional<TypedValue> result;
+    if (!column.ints.empty()) {
+      const auto it = is_min ? std::min_element(column.ints.begin(), column.ints.end())
+                             : std::max_element(column.ints.begin(), column.ints.end());
+      result.emplace(*it, mem);
+    }
+    if (!column.doubles.empty()) {
+      const auto it = is_min ? std::min_element(column.doubles.begin(), column.doubles.end())
+                             : std::max_element(column.doubles.begin(), column.doubles.end());
+      TypedValue value(*it, mem);
+      if (!result || (is_min ? value < *result : value > *result).ValueBool()) result = std::move(value);
+    }
+    return std::move(*result);
+  }
+
+  bool ProcessAllInParallel(Frame *frame, ExecutionContext *context) {
+    if (context->parallelism <= 1 || context->scan_morsel || context->frame_change_collector) return false;
+#ifdef MG_ENTERPRISE
+    // The fine-grained auth checker isn't safe to be shared among threads.
+    if (context->auth_checker) return false;
+#endif
+    if (!CanMergeAggregations(self_.aggregations_)) return false;
+    const auto *scan = FindParallelScan(*self_.input_);
+    if (!scan) return false;
+
+    const auto max_morsels = context->parallelism * kMorselsPerThread;
+    auto morsels = scan->GetTypeInfo() == ScanAllByLabel::kType
+                       ? context->db_accessor->PartitionVertices(
+                             scan->view_, static_cast<const ScanAllByLabel *>(scan)->label_, max_morsels)
+                       : context->db_accessor->PartitionVertices(scan->view_, max_morsels);
+    if (morsels.size() <= 1) return false;
+    const auto num_workers = std::min<uint64_t>(context->parallelism, morsels.size());
+
+    // Workers allocate from the memory of the current pull, so the memory
+    // limit of the query still applies to them.
+    utils::ConcurrentPoolResource shared_memory(1024U, context->evaluation_context.memory);
+
+    struct Worker {
+      Worker(const Aggregate &self, Frame &outer_frame, const ExecutionContext &context,
+             utils::MemoryResource *upstream)
+          : monotonic_memory(kWorkerInitialMemory, upstream),
+            pool_memory(128U, 1024U, &monotonic_memory, upstream),
+            context(MakeWorkerContext(context, &pool_memory)),
+            frame(static_cast<int64_t>(outer_frame.elems().size()), &pool_memory),
+            cursor(self, &pool_memory) {
+        // The pipeline may be a subquery that reads the values of the outer
+        // query.
+        std::copy(outer_frame.elems().begin(), outer_frame.elems().end(), frame.elems().begin());
+      }
 
-    using TSet = utils::pmr::unordered_set<TypedValue, TypedValue::Hash, TypedValue::BoolEqual>;
+      static constexpr size_t kWorkerInitialMemory = 64UL * 1024UL;
 
-    utils::pmr::vector<TSet> unique_values_;
-  };
+      utils::MonotonicBufferResource monotonic_memory;
+      utils::PoolResource pool_memory;
+      ExecutionContext context;
+      Frame frame;
+      AggregateCursor cursor;
+    };
 
-  const Aggregate &self_;
-  const UniqueCursorPtr input_cursor_;
-  // storage for aggregated data
-  // map key is the vector of group-by values
-  // map value is an AggregationValue struct
-  utils::pmr::unordered_map<utils::pmr::vector<TypedValue>, AggregationValue,
-                            // use FNV collection hashing specialized for a
-                            // vector of TypedValues
-                            utils::FnvCollection<utils::pmr::vector<TypedValue>, TypedValue, TypedValue::Hash>,
-                            // custom equality
-                            TypedValueVectorEqual>
-      aggregation_;
-  // iterator over the accumulated cache
-  decltype(aggregation_.begin()) aggregation_it_ = aggregation_.begin();
-  // this LogicalOp pulls all from the input on it's first pull
-  // this switch tracks if this has been performed
-  bool pulled_all_input_{false};
+    std::vector<std::unique_ptr<Worker>> workers;
+    workers.reserve(num_workers);
+    for (uint64_t i = 0; i < num_workers; ++i) {
+      workers.push_back(std::make_unique<Worker>(self_, *frame, *context, &shared_memory));
+    }
 
-  /**
-   * Pulls from the input operator until exhausted and aggregates the
-   * results. If the input operator is not provided, a single call
-   * to ProcessOne is issued.
-   *
-   * Accumulation automatically groups the results so that `aggregation_`
-   * cache cardinality depends on number of
-   * aggregation results, and not on the number of inputs.
-   */
-  void ProcessAll(Frame *frame, ExecutionContext *context) {
-    ExpressionEvaluator evaluator(frame, context->symbol_table, context->evaluation_context, context->db_accessor,
-                                  storage::View::NEW);
-    while (input_cursor_->Pull(*frame, *context)) {
-      ProcessOne(*frame, &evaluator);
+    // The workers share the transaction, whose cache of long delta chains
+    // isn't synchronized.
+    context->db_accessor->SuspendVertexInfoCache();
+    utils::OnScopeExit resume_cache([&] { context->db_accessor->ResumeVertexInfoCache(); });
+
+    std::atomic<uint64_t> next_morsel{0};
+    std::atomic<bool> failed{false};
+    utils::Synchronized<std::exception_ptr, utils::SpinLock> error;
+    {
+      std::vector<std::jthread> threads;
+      threads.reserve(num_workers);
+      for (auto &worker : workers) {
+        threads.emplace_back([&worker = *worker, &morsels, &next_morsel, &failed, &error] {
+          try {
+            while (!failed.load(std::memory_order_acquire)) {
+              const auto morsel = next_morsel.fetch_add(1, std::memory_order_acq_rel);
+              if (morsel >= morsels.size()) break;
+              worker.context.scan_morsel = &morsels[morsel];
+              worker.cursor.ProcessInput(&worker.frame, &worker.context);
+              worker.cursor.input_cursor_->Reset();
+            }
+          } catch (...) {
+            failed.store(true, std::memory_order_release);
+            auto locked_error = error.Lock();
+            if (!*locked_error) *locked_error = std::current_exception();
+          }
+          worker.context.scan_morsel = nullptr;
+        });
+      }
+    }
+    if (auto thrown = *error.Lock()) std::rethrow_exception(thrown);
+
+    for (auto &worker : workers) {
+      MergeAggregation(worker->cursor);
+      if (context->is_profile_query && context->stats_root && worker->context.stats.name) {
+        MergeParallelProfilingStats(worker->context.stats, num_workers, context->stats_root);
+      }
+    }
+    return true;
+  }
+
+  /** Merges the cache of another cursor of the same Aggregate, that
+   * aggregated a disjoint part of the input, into `aggregation_`. The
+   * aggregations must not be finished yet. */
+  void MergeAggregation(const AggregateCursor &other) {
+    auto *mem = aggregation_.get_allocator().GetMemoryResource();
+    for (const auto &[other_group_by, other_value] : other.aggregation_) {
+      utils::pmr::vector<TypedValue> group_by(mem);
+      group_by.reserve(other_group_by.size());
+      for (const auto &value : other_group_by) group_by.emplace_back(value);
+      MergeGroup(std::move(group_by), other_value);
+    }
+  }
+
+  /** Merges the partial aggregation of a single group into `aggregation_`. */
+  void MergeGroup(utils::pmr::vector<TypedValue> group_by, const AggregationValue &other_value) {
+    auto *mem = aggregation_.get_allocator().GetMemoryResource();
+    auto [it, inserted] = aggregation_.try_emplace(std::move(group_by), mem);
+    auto &agg_value = it->second;
+    if (inserted) {
+      for (const auto &agg_elem : self_.aggregations_) {
+        agg_value.values_.emplace_back(DefaultAggregationOpValue(agg_elem, mem));
+        agg_value.unique_values_.emplace_back(AggregationValue::TSet(mem));
+      }
+      agg_value.counts_.resize(self_.aggregations_.size(), 0);
+      for (const auto &remember : other_value.remember_) agg_value.remember_.emplace_back(remember);
     }
 
-    // calculate AVG aggregations (so far they have only been summed)
     for (size_t pos = 0; pos < self_.aggregations_.size(); ++pos) {
-      if (self_.aggregations_[pos].op != Aggregation::Op::AVG) continue;
-      for (auto &kv : aggregation_) {
-        AggregationValue &agg_value = kv.second;
-        auto count = agg_value.counts_[pos];
-        auto *pull_memory = context->evaluation_context.memory;
-        if (count > 0) {
-          agg_value.values_[pos] = agg_value.values_[pos] / TypedValue(static_cast<double>(count), pull_memory);
+      const auto other_count = other_value.counts_[pos];
+      if (other_count == 0) continue;
+      const auto &other_agg = other_value.values_[pos];
+      auto &agg = agg_value.values_[pos];
+      auto &count = agg_value.counts_[pos];
+      switch (self_.aggregations_[pos].op) {
+        case Aggregation::Op::COUNT:
+          agg = count + other_count;
+          break;
+        case Aggregation::Op::MIN:
+        case Aggregation::Op::MAX: {
+          if (count == 0) {
+            agg = other_agg;
+            break;
+          }
+          const bool is_min = self_.aggregations_[pos].op == Aggregation::Op::MIN;
+          try {
+            TypedValue comparison_result = is_min ? other_agg < agg : other_agg > agg;
+            if (comparison_result.ValueBool()) agg = other_agg;
+          } catch (const TypedValueException &) {
+            throw QueryRuntimeException("Unable to get {} of '{}' and '{}'.", is_min ? "MIN" : "MAX",
+                                        other_agg.type(), agg.type());
+          }
+          break;
         }
+        case Aggregation::Op::SUM:
+        case Aggregation::Op::AVG:
+          agg = count == 0 ? other_agg : agg + other_agg;
+          break;
+        case Aggregation::Op::COLLECT_LIST:
+          for (const auto &value : other_agg.ValueList()) agg.ValueList().push_back(value);
+          break;
+        case Aggregation::Op::COLLECT_MAP:
+          for (const auto &[key, value] : other_agg.ValueMap()) agg.ValueMap().emplace(key, value);
+          break;
+        case Aggregation::Op::APPROX_COUNT_DISTINCT:
+          if (count == 0) {
+            agg = other_agg;
+          } else {
+            HyperLogLogMerge(&agg.ValueString(), other_agg.ValueString());
+          }
+          break;
+        case Aggregation::Op::APPROX_PERCENTILE:
+          // The percentile of the first part is kept, it's the same for all
+          // the parts unless it depends on the values of the rows.
+          if (count == 0) {
+            agg = other_agg;
+          } else {
+            TDigestMerge(&agg.ValueList()[1].ValueString(), other_agg.ValueList()[1].ValueString());
+          }
+          break;
+        case Aggregation::Op::PROJECT:
+          LOG_FATAL("PROJECT aggregations can't be merged!");
       }
+      count += other_count;
     }
   }
 
   /**
    * Performs a single accumulation.
    */
-  void ProcessOne(const Frame &frame, ExpressionEvaluator *evaluator) {
+  void ProcessOne(const Frame &frame, ExpressionEvaluator *evaluator, const ExecutionContext &context) {
     auto *mem = aggregation_.get_allocator().GetMemoryResource();
-    utils::pmr::vector<TypedValue> group_by(mem);
-    group_by.reserve(self_.group_by_.size());
+    // The values are moved into the map only for a new group.
+    group_by_values_.clear();
+    group_by_values_.reserve(self_.group_by_.size());
     for (Expression *expression : self_.group_by_) {
-      group_by.emplace_back(expression->Accept(*evaluator));
+      group_by_values_.emplace_back(expression->Accept(*evaluator));
+    }
+    const auto flat_hash = decltype(flat_index_)::Hash(group_by_values_);
+    auto *entry = flat_hash ? flat_index_.Find(group_by_values_, *flat_hash) : nullptr;
+    bool inserted = false;
+    if (!entry) {
+      // try_emplace leaves the key intact if the group exists.
+      auto it_inserted = aggregation_.try_emplace(std::move(group_by_values_), mem);
+      entry = &*it_inserted.first;
+      inserted = it_inserted.second;
+      // A group with equal values of other types, e.g. 1.0 for 1, isn't
+      // indexed under these values.
+      if (flat_hash && (inserted || decltype(flat_index_)::Equal(entry->first, group_by_values_))) {
+        flat_index_.Insert(entry, *flat_hash);
+      }
     }
-    auto &agg_value = aggregation_.try_emplace(std::move(group_by), mem).first->second;
+    auto &agg_value = entry->second;
     EnsureInitialized(frame, &agg_value);
     Update(evaluator, &agg_value);
+
+    if (!can_spill_) return;
+    if (inserted) {
+      aggregation_bytes_ += GroupSize(entry->first, agg_value);
+    } else {
+      // Only the collected values grow with the number of rows in the group.
+      for (const auto &agg_elem : self_.aggregations_) {
+        if (agg_elem.op == Aggregation::Op::COLLECT_LIST || agg_elem.op == Aggregation::Op::COLLECT_MAP) {
+          aggregation_bytes_ += sizeof(TypedValue);
+        }
+      }
+    }
+    if (aggregation_bytes_ > context.spill_memory_limit) SpillAggregation(context);
+  }
+
+  static size_t GroupSize(const utils::pmr::vector<TypedValue> &group_by, const AggregationValue &agg_value) {
+    // The group is kept in a node of the map.
+    size_t size = sizeof(group_by) + sizeof(agg_value) + 2 * sizeof(void *);
+    size += agg_value.counts_.size() * sizeof(int64_t);
+    for (const auto *values : {&group_by, &agg_value.values_, &agg_value.remember_}) {
+      for (const auto &value : *values) size += EstimateSize(value);
+    }
+    return size;
   }
 
   /** Ensures the new AggregationValue has been initialized. This means
@@ -3525,74 +6082,13 @@ class AggregateCursor : public Cursor {
         }
       }
       *count_it += 1;
-      if (*count_it == 1) {
-        // first value, nothing to aggregate. check type, set and continue.
-        switch (agg_op) {
-          case Aggregation::Op::MIN:
-          case Aggregation::Op::MAX:
-            *value_it = input_value;
-            EnsureOkForMinMax(input_value);
-            break;
-          case Aggregation::Op::SUM:
-          case Aggregation::Op::AVG:
-            *value_it = input_value;
-            EnsureOkForAvgSum(input_value);
-            break;
-          case Aggregation::Op::COUNT:
-            *value_it = 1;
-            break;
-          case Aggregation::Op::COLLECT_LIST:
-            value_it->ValueList().push_back(input_value);
-            break;
-          case Aggregation::Op::PROJECT: {
-            EnsureOkForProject(input_value);
-            value_it->ValueGraph().Expand(input_value.ValuePath());
-            break;
-          }
-          case Aggregation::Op::COLLECT_MAP:
-            auto key = agg_elem_it->key->Accept(*evaluator);
-            if (key.type() != TypedValue::Type::String) throw QueryRuntimeException("Map key must be a string.");
-            value_it->ValueMap().emplace(key.ValueString(), input_value);
-            break;
-        }
-        continue;
-      }
-
-      // aggregation of existing values
       switch (agg_op) {
         case Aggregation::Op::COUNT:
-          *value_it = *count_it;
-          break;
-        case Aggregation::Op::MIN: {
-          EnsureOkForMinMax(input_value);
-          try {
-            TypedValue comparison_result = input_value < *value_it;
-            // since we skip nulls we either have a valid comparison, or
-            // an exception was just thrown above
-            // safe to assume a bool TypedValue
-            if (comparison_result.ValueBool()) *value_it = input_value;
-          } catch (const TypedValueException &) {
-            throw QueryRuntimeException("Unable to get MIN of '{}' and '{}'.", input_value.type(), value_it->type());
-          }
-          break;
-        }
-        case Aggregation::Op::MAX: {
-          //  all comments as for Op::Min
-          EnsureOkForMinMax(input_value);
-          try {
-            TypedValue comparison_result = input_value > *value_it;
-            if (comparison_result.ValueBool()) *value_it = input_value;
-          } catch (const TypedValueException &) {
-            throw QueryRuntimeException("Unable to get MAX of '{}' and '{}'.", input_value.type(), value_it->type());
-          }
-          break;
-        }
-        case Aggregation::Op::AVG:
-        // for averaging we sum first and divide by count once all
-        // the input has been processed
+        case Aggregation::Op::MIN:
+        case Aggregation::Op::MAX:
         case Aggregation::Op::SUM:
-          EnsureOkForAvgSum(input_value);
-          *value_it = *value_it + input_value;
+        case Aggregation::Op::AVG:
+          AggregateValue(agg_op, input_value, *count_it, &*value_it);
           break;
         case Aggregation::Op::COLLECT_LIST:
           value_it->ValueList().push_back(input_value);
@@ -3602,6 +6098,20 @@ class AggregateCursor : public Cursor {
           value_it->ValueGraph().Expand(input_value.ValuePath());
           break;
         }
+        case Aggregation::Op::APPROX_COUNT_DISTINCT:
+          if (*count_it == 1) *value_it = TypedValue(HyperLogLogCreate(value_it->GetMemoryResource()));
+          HyperLogLogAdd(&value_it->ValueString(), TypedValue::Hash{}(input_value));
+          break;
+        case Aggregation::Op::APPROX_PERCENTILE:
+          if (*count_it == 1) {
+            *value_it = CreatePercentileSketch(agg_elem_it->key->Accept(*evaluator), value_it->GetMemoryResource());
+          }
+          if (!input_value.IsNumeric()) {
+            throw QueryRuntimeException("Only numeric values allowed in APPROXPERCENTILE aggregation.");
+          }
+          TDigestAdd(&value_it->ValueList()[1].ValueString(),
+                     input_value.IsInt() ? static_cast<double>(input_value.ValueInt()) : input_value.ValueDouble());
+          break;
         case Aggregation::Op::COLLECT_MAP:
           auto key = agg_elem_it->key->Accept(*evaluator);
           if (key.type() != TypedValue::Type::String) throw QueryRuntimeException("Map key must be a string.");
@@ -3611,6 +6121,67 @@ class AggregateCursor : public Cursor {
     }    // end loop over all aggregations
   }
 
+  /** Aggregates the non-null input value into the value of a COUNT, MIN,
+   * MAX, SUM or AVG aggregation, whose count already includes the input. */
+  void AggregateValue(Aggregation::Op op, const TypedValue &input_value, int64_t count, TypedValue *value) const {
+    switch (op) {
+      case Aggregation::Op::COUNT:
+        *value = count;
+        break;
+      case Aggregation::Op::MIN:
+      case Aggregation::Op::MAX: {
+        EnsureOkForMinMax(input_value);
+        // first value, nothing to aggregate
+        if (count == 1) {
+          *value = input_value;
+          break;
+        }
+        const bool is_min = op == Aggregation::Op::MIN;
+        try {
+          TypedValue comparison_result = is_min ? input_value < *value : input_value > *value;
+          // since we skip nulls we either have a valid comparison, or
+          // an exception was just thrown above
+          // safe to assume a bool TypedValue
+          if (comparison_result.ValueBool()) *value = input_value;
+        } catch (const TypedValueException &) {
+          throw QueryRuntimeException("Unable to get {} of '{}' and '{}'.", is_min ? "MIN" : "MAX", input_value.type(),
+                                      value->type());
+        }
+        break;
+      }
+      case Aggregation::Op::AVG:
+      // for averaging we sum first and divide by count once all
+      // the input has been processed
+      case Aggregation::Op::SUM:
+        EnsureOkForAvgSum(input_value);
+        *value = count == 1 ? input_value : *value + input_value;
+        break;
+      case Aggregation::Op::COLLECT_LIST:
+      case Aggregation::Op::COLLECT_MAP:
+      case Aggregation::Op::PROJECT:
+      case Aggregation::Op::APPROX_COUNT_DISTINCT:
+      case Aggregation::Op::APPROX_PERCENTILE:
+        LOG_FATAL("Aggregation of a single value is only supported for COUNT, MIN, MAX, SUM and AVG");
+    }
+  }
+
+  /** Returns the sketch of an APPROX_PERCENTILE aggregation, the list of the
+   * percentile and of the empty t-digest. The percentile is evaluated for the
+   * first value of each group. */
+  static TypedValue CreatePercentileSketch(const TypedValue &percentile, utils::MemoryResource *mem) {
+    if (!percentile.IsNumeric()) {
+      throw QueryRuntimeException("The percentile of APPROXPERCENTILE aggregation must be a number.");
+    }
+    const auto value = percentile.IsInt() ? static_cast<double>(percentile.ValueInt()) : percentile.ValueDouble();
+    if (!(value >= 0 && value <= 1)) {
+      throw QueryRuntimeException("The percentile of APPROXPERCENTILE aggregation must be between 0 and 1.");
+    }
+    TypedValue::TVector sketch(mem);
+    sketch.emplace_back(value);
+    sketch.emplace_back(TypedValue::TString(mem));
+    return TypedValue(std::move(sketch), mem);
+  }
+
   /** Checks if the given TypedValue is legal in MIN and MAX. If not
    * an appropriate exception is thrown. */
   void EnsureOkForMinMax(const TypedValue &value) const {
@@ -3767,8 +6338,8 @@ void Limit::LimitCursor::Reset() {
 }
 
 OrderBy::OrderBy(const std::shared_ptr<LogicalOperator> &input, const std::vector<SortItem> &order_by,
-                 const std::vector<Symbol> &output_symbols)
-    : input_(input), output_symbols_(output_symbols) {
+                 const std::vector<Symbol> &output_symbols, Expression *skip, Expression *limit)
+    : input_(input), output_symbols_(output_symbols), skip_(skip), limit_(limit) {
   // split the order_by vector into two vectors of orderings and expressions
   std::vector<Ordering> ordering;
   ordering.reserve(order_by.size());
@@ -3801,6 +6372,15 @@ class OrderByCursor : public Cursor {
       ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
                                     storage::View::OLD);
       auto *mem = cache_.get_allocator().GetMemoryResource();
+      auto compare = [this](const auto &pair1, const auto &pair2) {
+        return self_.compare_(pair1.order_by, pair2.order_by);
+      };
+      // With a known number of rows to keep, cache_ is a heap whose front is
+      // the last of the kept rows.
+      const auto rows_to_keep = RowsToKeep(&evaluator);
+      // Otherwise the sorted cache_ is written to a run on disk whenever it
+      // exceeds the memory limit, and the runs are merged at the end.
+      can_spill_ = !rows_to_keep && context.spill_memory_limit != 0;
       while (input_cursor_->Pull(frame, context)) {
         // collect the order_by elements
         utils::pmr::vector<TypedValue> order_by(mem);
@@ -3809,38 +6389,79 @@ class OrderByCursor : public Cursor {
           order_by.emplace_back(expression_ptr->Accept(evaluator));
         }
 
+        if (rows_to_keep) {
+          if (*rows_to_keep == 0) continue;
+          if (cache_.size() == *rows_to_keep) {
+            // The row replaces the last kept row only if it comes before it.
+            if (!self_.compare_(order_by, cache_.front().order_by)) continue;
+            std::pop_heap(cache_.begin(), cache_.end(), compare);
+            cache_.pop_back();
+          }
+        }
+
         // collect the output elements
         utils::pmr::vector<TypedValue> output(mem);
         output.reserve(self_.output_symbols_.size());
         for (const Symbol &output_sym : self_.output_symbols_) output.emplace_back(frame[output_sym]);
 
         cache_.push_back(Element{std::move(order_by), std::move(output)});
+        if (rows_to_keep) std::push_heap(cache_.begin(), cache_.end(), compare);
+        if (can_spill_) {
+          if (auto size = SpillSize(cache_.back())) {
+            cache_bytes_ += *size;
+          } else {
+            // The rows which can't be spilled stay in memory.
+            can_spill_ = false;
+          }
+        }
+        if (can_spill_ && cache_bytes_ > context.spill_memory_limit) {
+          std::sort(cache_.begin(), cache_.end(), compare);
+          SpillRun(context);
+        }
       }
 
-      std::sort(cache_.begin(), cache_.end(), [this](const auto &pair1, const auto &pair2) {
-        return self_.compare_(pair1.order_by, pair2.order_by);
-      });
+      if (rows_to_keep) {
+        std::sort_heap(cache_.begin(), cache_.end(), compare);
+      } else {
+        std::sort(cache_.begin(), cache_.end(), compare);
+      }
+      for (auto &run : runs_) heads_.emplace_back(ReadElement(run.get(), mem));
 
       did_pull_all_ = true;
       cache_it_ = cache_.begin();
     }
 
-    if (cache_it_ == cache_.end()) return false;
+    // The next row is the first one of the in-memory run and the heads of the
+    // runs on disk.
+    Element *next = cache_it_ == cache_.end() ? nullptr : &*cache_it_;
+    std::optional<size_t> next_run;
+    for (size_t i = 0; i < heads_.size(); ++i) {
+      if (heads_[i] && (!next || self_.compare_(heads_[i]->order_by, next->order_by))) {
+        next = &*heads_[i];
+        next_run = i;
+      }
+    }
+    if (!next) return false;
 
     AbortCheck(context);
 
-    // place the output values on the frame
-    DMG_ASSERT(self_.output_symbols_.size() == cache_it_->remember.size(),
+    // place the output values on the frame, moving them since every element
+    // is output once
+    DMG_ASSERT(self_.output_symbols_.size() == next->remember.size(),
                "Number of values does not match the number of output symbols "
                "in OrderBy");
     auto output_sym_it = self_.output_symbols_.begin();
-    for (const TypedValue &output : cache_it_->remember) {
+    for (TypedValue &output : next->remember) {
       if (context.frame_change_collector && context.frame_change_collector->IsKeyTracked(output_sym_it->name())) {
         context.frame_change_collector->ResetTrackingValue(output_sym_it->name());
       }
-      frame[*output_sym_it++] = output;
+      frame[*output_sym_it++] = std::move(output);
+    }
+    if (next_run) {
+      heads_[*next_run] = ReadElement(runs_[*next_run].get(), cache_.get_allocator().GetMemoryResource());
+    } else {
+      cache_it_++;
     }
-    cache_it_++;
     return true;
   }
   void Shutdown() override { input_cursor_->Shutdown(); }
@@ -3850,6 +6471,9 @@ class OrderByCursor : public Cursor {
     did_pull_all_ = false;
     cache_.clear();
     cache_it_ = cache_.begin();
+    cache_bytes_ = 0;
+    heads_.clear();
+    runs_.clear();
   }
 
  private:
@@ -3858,6 +6482,57 @@ class OrderByCursor : public Cursor {
     utils::pmr::vector<TypedValue> remember;
   };
 
+  // Returns the approximate memory taken by the element, or std::nullopt if
+  // it can't be spilled.
+  static std::optional<size_t> SpillSize(const Element &element) {
+    size_t size = sizeof(Element);
+    for (const auto *values : {&element.order_by, &element.remember}) {
+      for (const auto &value : *values) {
+        if (!CanSpill(value)) return std::nullopt;
+        size += EstimateSize(value);
+      }
+    }
+    return size;
+  }
+
+  // Writes the sorted cache_ to a new run on disk.
+  void SpillRun(const ExecutionContext &context) {
+    auto &run = runs_.emplace_back(std::make_unique<SpillFile>(context.spill_directory));
+    for (const auto &element : cache_) {
+      for (const auto &value : element.order_by) run->Write(value);
+      for (const auto &value : element.remember) run->Write(value);
+    }
+    cache_.clear();
+    cache_bytes_ = 0;
+  }
+
+  std::optional<Element> ReadElement(SpillFile *run, utils::MemoryResource *mem) const {
+    if (run->AtEnd()) return std::nullopt;
+    Element element{utils::pmr::vector<TypedValue>(mem), utils::pmr::vector<TypedValue>(mem)};
+    element.order_by.reserve(self_.order_by_.size());
+    for (size_t i = 0; i < self_.order_by_.size(); ++i) element.order_by.emplace_back(run->Read(mem));
+    element.remember.reserve(self_.output_symbols_.size());
+    for (size_t i = 0; i < self_.output_symbols_.size(); ++i) element.remember.emplace_back(run->Read(mem));
+    return element;
+  }
+
+  // Returns the number of rows which get past the following Skip and Limit, or
+  // std::nullopt if all rows have to be sorted. Invalid values are reported by
+  // the Skip and Limit operators themselves, so all rows are kept for them.
+  std::optional<size_t> RowsToKeep(ExpressionEvaluator *evaluator) const {
+    if (!self_.limit_) return std::nullopt;
+    auto limit = self_.limit_->Accept(*evaluator);
+    if (limit.type() != TypedValue::Type::Int || limit.ValueInt() < 0) return std::nullopt;
+    int64_t skip = 0;
+    if (self_.skip_) {
+      auto value = self_.skip_->Accept(*evaluator);
+      if (value.type() != TypedValue::Type::Int || value.ValueInt() < 0) return std::nullopt;
+      skip = value.ValueInt();
+    }
+    if (skip > std::numeric_limits<int64_t>::max() - limit.ValueInt()) return std::nullopt;
+    return skip + limit.ValueInt();
+  }
+
   const OrderBy &self_;
   const UniqueCursorPtr input_cursor_;
   bool did_pull_all_{false};
@@ -3866,6 +6541,11 @@ class OrderByCursor : public Cursor {
   utils::pmr::vector<Element> cache_;
   // iterator over the cache_, maintains state between Pulls
   decltype(cache_.begin()) cache_it_ = cache_.begin();
+  bool can_spill_{false};
+  size_t cache_bytes_{0};
+  // sorted runs spilled to disk and their first elements which weren't output
+  std::vector<std::unique_ptr<SpillFile>> runs_;
+  std::vector<std::optional<Element>> heads_;
 };
 
 UniqueCursorPtr OrderBy::MakeCursor(utils::MemoryResource *mem) const {
@@ -4057,6 +6737,13 @@ class UnwindCursor : public Cursor {
       if (input_value_it_ == input_value_.end()) {
         if (!input_cursor_->Pull(frame, context)) return false;
 
+        if (const auto *morsel = std::exchange(context.unwind_morsel, nullptr)) {
+          input_value_.assign(morsel->values->begin() + static_cast<std::ptrdiff_t>(morsel->begin),
+                              morsel->values->begin() + static_cast<std::ptrdiff_t>(morsel->end));
+          input_value_it_ = input_value_.begin();
+          continue;
+        }
+
         // successful pull from input, initialize value and iterator
         ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
                                       storage::View::OLD);
@@ -4068,38 +6755,246 @@ class UnwindCursor : public Cursor {
         input_value_it_ = input_value_.begin();
       }
 
-      // if we reached the end of our list of values goto back to top
-      if (input_value_it_ == input_value_.end()) continue;
-
-      frame[self_.output_symbol_] = *input_value_it_++;
-      if (context.frame_change_collector && context.frame_change_collector->IsKeyTracked(self_.output_symbol_.name_)) {
-        context.frame_change_collector->ResetTrackingValue(self_.output_symbol_.name_);
+      // if we reached the end of our list of values goto back to top
+      if (input_value_it_ == input_value_.end()) continue;
+
+      frame[self_.output_symbol_] = *input_value_it_++;
+      if (context.frame_change_collector && context.frame_change_collector->IsKeyTracked(self_.output_symbol_.name_)) {
+        context.frame_change_collector->ResetTrackingValue(self_.output_symbol_.name_);
+      }
+      return true;
+    }
+  }
+
+  void Shutdown() override { input_cursor_->Shutdown(); }
+
+  void Reset() override {
+    input_cursor_->Reset();
+    input_value_.clear();
+    input_value_it_ = input_value_.end();
+  }
+
+ private:
+  const Unwind &self_;
+  const UniqueCursorPtr input_cursor_;
+  // typed values we are unwinding and yielding
+  utils::pmr::vector<TypedValue> input_value_;
+  // current position in input_value_
+  decltype(input_value_)::iterator input_value_it_ = input_value_.end();
+};
+
+UniqueCursorPtr Unwind::MakeCursor(utils::MemoryResource *mem) const {
+  memgraph::metrics::IncrementCounter(memgraph::metrics::UnwindOperator);
+
+  return MakeUniqueCursorPtr<UnwindCursor>(mem, *this, mem);
+}
+
+UnwindMerge::UnwindMerge(const std::shared_ptr<LogicalOperator> &input, Expression *input_expression,
+                         Symbol row_symbol, Symbol node_symbol, storage::LabelId label, storage::PropertyId property,
+                         Expression *key, Expression *properties, const std::shared_ptr<LogicalOperator> &merge)
+    : input_(input ? input : std::make_shared<Once>()),
+      input_expression_(input_expression),
+      row_symbol_(std::move(row_symbol)),
+      node_symbol_(std::move(node_symbol)),
+      label_(label),
+      property_(property),
+      key_(key),
+      properties_(properties),
+      merge_(merge) {}
+
+ACCEPT_WITH_INPUT(UnwindMerge)
+
+std::vector<Symbol> UnwindMerge::ModifiedSymbols(const SymbolTable &table) const {
+  auto symbols = input_->ModifiedSymbols(table);
+  symbols.emplace_back(row_symbol_);
+  symbols.emplace_back(node_symbol_);
+  return symbols;
+}
+
+class UnwindMergeCursor : public Cursor {
+ public:
+  UnwindMergeCursor(const UnwindMerge &self, utils::MemoryResource *mem)
+      : self_(self), mem_(mem), input_cursor_(self.input_->MakeCursor(mem)), rows_(mem) {}
+
+  bool Pull(Frame &frame, ExecutionContext &context) override {
+    SCOPED_PROFILE_OP("UnwindMerge");
+    if (!ingested_) {
+      ingested_ = true;
+      if (self_.input_expression_ && !input_cursor_->Pull(frame, context)) return false;
+      ingest_one_by_one_ = !CanIngestInBulk(context) || !Prepare(frame, context);
+      if (ingest_one_by_one_) {
+        rows_.clear();
+        row_groups_.clear();
+        groups_.clear();
+      } else {
+        Ingest(context);
+      }
+    }
+    if (ingest_one_by_one_) {
+      if (!merge_cursor_) merge_cursor_ = self_.merge_->MakeCursor(mem_);
+      return merge_cursor_->Pull(frame, context);
+    }
+
+    while (row_ < rows_.size()) {
+      const auto &vertices = groups_[row_groups_[row_]].vertices;
+      if (vertex_ == vertices.size()) {
+        ++row_;
+        vertex_ = 0;
+        continue;
+      }
+      frame[self_.row_symbol_] = rows_[row_];
+      frame[self_.node_symbol_] = vertices[vertex_++];
+      return true;
+    }
+    return false;
+  }
+
+  void Shutdown() override {
+    input_cursor_->Shutdown();
+    if (merge_cursor_) merge_cursor_->Shutdown();
+  }
+
+  void Reset() override {
+    input_cursor_->Reset();
+    if (merge_cursor_) merge_cursor_->Reset();
+    ingested_ = false;
+    ingest_one_by_one_ = false;
+    rows_.clear();
+    row_groups_.clear();
+    groups_.clear();
+    row_ = 0;
+    vertex_ = 0;
+  }
+
+ private:
+  // Rows with the same key, which belong to the same vertices.
+  struct Group {
+    storage::PropertyValue key;
+    std::vector<VertexAccessor> vertices;
+    // properties of all the rows, where the later rows overwrite the earlier
+    std::map<storage::PropertyId, storage::PropertyValue> properties;
+  };
+
+  static bool CanIngestInBulk(const ExecutionContext &context) {
+    if (context.trigger_context_collector || context.frame_change_collector) return false;
+#ifdef MG_ENTERPRISE
+    if (context.auth_checker) return false;
+#endif
+    return true;
+  }
+
+  /// Evaluates the list, or pulls all the rows of the input, and the key and
+  /// the properties of each row. Returns false if the rows must be ingested
+  /// one by one, in which case nothing was written.
+  bool Prepare(Frame &frame, ExecutionContext &context) {
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                  storage::View::NEW);
+    // Any error is raised by the plan that ingests the rows one by one, after
+    // the same rows as without the bulk ingestion have been written.
+    try {
+      if (self_.input_expression_) {
+        auto list = self_.input_expression_->Accept(evaluator);
+        if (!list.IsList()) return false;
+        rows_ = list.ValueList();
+      } else {
+        FrameBatch batch(static_cast<int64_t>(frame.elems().size()), FrameBatch::kDefaultCapacity,
+                         frame.GetMemoryResource());
+        while (input_cursor_->PullBatch(frame, batch, context)) {
+          for (size_t row = 0; row < batch.size(); ++row) rows_.emplace_back(std::move(batch[row][self_.row_symbol_]));
+        }
+      }
+      std::vector<storage::PropertyValue> keys;
+      std::vector<std::map<storage::PropertyId, storage::PropertyValue>> properties;
+      keys.reserve(rows_.size());
+      properties.resize(rows_.size());
+      for (size_t i = 0; i < rows_.size(); ++i) {
+        if (i % 1024 == 0) AbortCheck(context);
+        frame[self_.row_symbol_] = rows_[i];
+        auto key = self_.key_->Accept(evaluator);
+        // Keys of other types may be equal to keys that are grouped apart,
+        // e.g. a double to an integer, and a null key matches no vertex.
+        if (!key.IsInt() && !key.IsString()) return false;
+        keys.emplace_back(key);
+        if (!self_.properties_) continue;
+        auto row_properties = self_.properties_->Accept(evaluator);
+        if (!row_properties.IsMap()) return false;
+        for (const auto &[name, value] : row_properties.ValueMap()) {
+          const auto property = context.evaluation_context.property_names.Resolve(name, context.db_accessor);
+          // Setting the key could change which vertices the later rows merge.
+          if (property == self_.property_ || !value.IsPropertyValue()) return false;
+          properties[i].emplace(property, value);
+        }
+      }
+
+      // The keys are grouped by sorting them, so that the index is also
+      // probed in order.
+      std::vector<uint32_t> order(rows_.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [&keys](auto lhs, auto rhs) { return keys[lhs] < keys[rhs]; });
+      row_groups_.resize(rows_.size());
+      for (const auto row : order) {
+        if (groups_.empty() || groups_.back().key != keys[row]) groups_.push_back({.key = std::move(keys[row])});
+        row_groups_[row] = groups_.size() - 1;
       }
-      return true;
+      for (size_t row = 0; row < rows_.size(); ++row) {
+        auto &group_properties = groups_[row_groups_[row]].properties;
+        for (auto &[property, value] : properties[row]) group_properties.insert_or_assign(property, std::move(value));
+      }
+    } catch (const utils::BasicException &) {
+      return false;
     }
+    return true;
   }
 
-  void Shutdown() override { input_cursor_->Shutdown(); }
+  /// Merges the vertices of all the groups and sets their properties.
+  void Ingest(ExecutionContext &context) {
+    for (size_t i = 0; i < groups_.size(); ++i) {
+      if (i % 1024 == 0) AbortCheck(context);
+      auto &group = groups_[i];
+      for (auto vertex : context.db_accessor->Vertices(storage::View::NEW, self_.label_, self_.property_, group.key)) {
+        group.vertices.push_back(vertex);
+      }
+    }
 
-  void Reset() override {
-    input_cursor_->Reset();
-    input_value_.clear();
-    input_value_it_ = input_value_.end();
+    // The vertices are created in the order of the rows that create them.
+    for (const auto group_index : row_groups_) {
+      auto &group = groups_[group_index];
+      if (!group.vertices.empty()) continue;
+      auto vertex = InsertVertexWithLabels({self_.label_}, context);
+      auto properties = std::move(group.properties);
+      properties.emplace(self_.property_, group.key);
+      MultiPropsInitChecked(&vertex, properties);
+      group.vertices.push_back(vertex);
+    }
+
+    for (auto &group : groups_) {
+      if (group.properties.empty()) continue;
+      for (auto &vertex : group.vertices) {
+        auto properties = group.properties;
+        UpdatePropertiesChecked(&vertex, properties);
+      }
+    }
   }
 
- private:
-  const Unwind &self_;
+  const UnwindMerge &self_;
+  utils::MemoryResource *mem_;
   const UniqueCursorPtr input_cursor_;
-  // typed values we are unwinding and yielding
-  utils::pmr::vector<TypedValue> input_value_;
-  // current position in input_value_
-  decltype(input_value_)::iterator input_value_it_ = input_value_.end();
+  UniqueCursorPtr merge_cursor_;
+  bool ingested_{false};
+  bool ingest_one_by_one_{false};
+  utils::pmr::vector<TypedValue> rows_;
+  // index of the group of each row
+  std::vector<uint32_t> row_groups_;
+  std::vector<Group> groups_;
+  // position of the next row and of its next vertex to yield
+  size_t row_{0};
+  size_t vertex_{0};
 };
 
-UniqueCursorPtr Unwind::MakeCursor(utils::MemoryResource *mem) const {
-  memgraph::metrics::IncrementCounter(memgraph::metrics::UnwindOperator);
+UniqueCursorPtr UnwindMerge::MakeCursor(utils::MemoryResource *mem) const {
+  memgraph::metrics::IncrementCounter(memgraph::metrics::UnwindMergeOperator);
 
-  return MakeUniqueCursorPtr<UnwindCursor>(mem, *this, mem);
+  return MakeUniqueCursorPtr<UnwindMergeCursor>(mem, *this, mem);
 }
 
 class DistinctCursor : public Cursor {
@@ -4110,20 +7005,69 @@ class DistinctCursor : public Cursor {
   bool Pull(Frame &frame, ExecutionContext &context) override {
     SCOPED_PROFILE_OP("Distinct");
 
-    while (true) {
-      if (!input_cursor_->Pull(frame, context)) return false;
+    auto *mem = seen_rows_.get_allocator().GetMemoryResource();
+    while (!pulled_all_input_) {
+      if (!input_cursor_->Pull(frame, context)) {
+        pulled_all_input_ = true;
+        // The spilled rows weren't seen before the set got full.
+        if (!partitions_.empty()) seen_rows_.clear();
+        break;
+      }
 
-      utils::pmr::vector<TypedValue> row(seen_rows_.get_allocator().GetMemoryResource());
+      utils::pmr::vector<TypedValue> row(mem);
       row.reserve(self_.value_symbols_.size());
 
       for (const auto &symbol : self_.value_symbols_) {
         row.emplace_back(frame.at(symbol));
       }
 
+      if (!partitions_.empty() && !seen_rows_.contains(row) &&
+          std::all_of(row.begin(), row.end(), [](const auto &value) { return CanSpill(value); })) {
+        // Once the set is full, the new rows are deduplicated after the input
+        // is exhausted, one partition at a time.
+        auto &partition = partitions_[seen_rows_.hash_function()(row) % kSpillPartitions];
+        for (const auto &value : row) partition->Write(value);
+        continue;
+      }
+
+      const auto row_size = context.spill_memory_limit != 0 ? RowSize(row) : 0;
       if (seen_rows_.insert(std::move(row)).second) {
+        seen_rows_bytes_ += row_size;
+        if (context.spill_memory_limit != 0 && partitions_.empty() &&
+            seen_rows_bytes_ > context.spill_memory_limit) {
+          for (size_t i = 0; i < kSpillPartitions; ++i) {
+            partitions_.emplace_back(std::make_unique<SpillFile>(context.spill_directory));
+          }
+        }
         return true;
       }
     }
+
+    while (current_partition_ < partitions_.size()) {
+      auto &partition = partitions_[current_partition_];
+      if (partition->AtEnd()) {
+        seen_rows_.clear();
+        ++current_partition_;
+        continue;
+      }
+      AbortCheck(context);
+
+      utils::pmr::vector<TypedValue> row(mem);
+      row.reserve(self_.value_symbols_.size());
+      for (size_t i = 0; i < self_.value_symbols_.size(); ++i) row.emplace_back(partition->Read(mem));
+
+      auto [it, inserted] = seen_rows_.insert(std::move(row));
+      if (!inserted) continue;
+      auto value_it = it->begin();
+      for (const auto &symbol : self_.value_symbols_) {
+        if (context.frame_change_collector && context.frame_change_collector->IsKeyTracked(symbol.name())) {
+          context.frame_change_collector->ResetTrackingValue(symbol.name());
+        }
+        frame[symbol] = *value_it++;
+      }
+      return true;
+    }
+    return false;
   }
 
   void Shutdown() override { input_cursor_->Shutdown(); }
@@ -4131,11 +7075,27 @@ class DistinctCursor : public Cursor {
   void Reset() override {
     input_cursor_->Reset();
     seen_rows_.clear();
+    seen_rows_bytes_ = 0;
+    pulled_all_input_ = false;
+    partitions_.clear();
+    current_partition_ = 0;
   }
 
  private:
+  static size_t RowSize(const utils::pmr::vector<TypedValue> &row) {
+    // The row is kept in a node of the set.
+    size_t size = sizeof(row) + 2 * sizeof(void *);
+    for (const auto &value : row) size += EstimateSize(value);
+    return size;
+  }
+
   const Distinct &self_;
   const UniqueCursorPtr input_cursor_;
+  bool pulled_all_input_{false};
+  size_t seen_rows_bytes_{0};
+  // rows spilled to disk, partitioned by their hash
+  std::vector<std::unique_ptr<SpillFile>> partitions_;
+  size_t current_partition_{0};
   // a set of already seen rows
   utils::pmr::unordered_set<utils::pmr::vector<TypedValue>,
                             // use FNV collection hashing specialized for a
@@ -4349,6 +7309,136 @@ UniqueCursorPtr Cartesian::MakeCursor(utils::MemoryResource *mem) const {
   return MakeUniqueCursorPtr<CartesianCursor>(mem, *this, mem);
 }
 
+std::vector<Symbol> HashJoin::ModifiedSymbols(const SymbolTable &table) const {
+  auto symbols = left_op_->ModifiedSymbols(table);
+  auto right = right_op_->ModifiedSymbols(table);
+  symbols.insert(symbols.end(), right.begin(), right.end());
+  return symbols;
+}
+
+bool HashJoin::Accept(HierarchicalLogicalOperatorVisitor &visitor) {
+  if (visitor.PreVisit(*this)) {
+    left_op_->Accept(visitor) && right_op_->Accept(visitor);
+  }
+  return visitor.PostVisit(*this);
+}
+
+WITHOUT_SINGLE_INPUT(HashJoin);
+
+namespace {
+
+class HashJoinCursor : public Cursor {
+ public:
+  HashJoinCursor(const HashJoin &self, utils::MemoryResource *mem)
+      : self_(self),
+        left_op_frames_(mem),
+        left_op_frames_by_key_(mem),
+        right_op_frame_(mem),
+        left_op_cursor_(self.left_op_->MakeCursor(mem)),
+        right_op_cursor_(self_.right_op_->MakeCursor(mem)) {
+    MG_ASSERT(left_op_cursor_ != nullptr, "HashJoinCursor: Missing left operator cursor.");
+    MG_ASSERT(right_op_cursor_ != nullptr, "HashJoinCursor: Missing right operator cursor.");
+    MG_ASSERT(self_.hash_join_condition_ != nullptr, "HashJoinCursor: Missing join condition.");
+  }
+
+  bool Pull(Frame &frame, ExecutionContext &context) override {
+    SCOPED_PROFILE_OP("HashJoin");
+
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                  storage::View::OLD, context.frame_change_collector);
+    if (!hash_join_initialized_) {
+      // Pull all left_op frames and hash them by their key. Null keys are
+      // skipped because null isn't equal to anything.
+      while (left_op_cursor_->Pull(frame, context)) {
+        auto key = self_.hash_join_condition_->expression1_->Accept(evaluator);
+        if (key.IsNull()) continue;
+        left_op_frames_by_key_[key].push_back(left_op_frames_.size());
+        left_op_frames_.emplace_back(frame.elems().begin(), frame.elems().end());
+      }
+      hash_join_initialized_ = true;
+    }
+
+    // If left operator yielded zero results there is nothing to join.
+    if (left_op_frames_.empty()) {
+      return false;
+    }
+
+    auto restore_frame = [&frame, &context](const auto &symbols, const auto &restore_from) {
+      for (const auto &symbol : symbols) {
+        frame[symbol] = restore_from[symbol.position()];
+        if (context.frame_change_collector && context.frame_change_collector->IsKeyTracked(symbol.name())) {
+          context.frame_change_collector->ResetTrackingValue(symbol.name());
+        }
+      }
+    };
+
+    if (matching_frames_ && matching_frames_it_ != matching_frames_->end()) {
+      // Make sure right_op_cursor last pulled results are on frame.
+      restore_frame(self_.right_symbols_, right_op_frame_);
+    } else {
+      // Advance right_op_cursor_ until its key matches some of the left keys.
+      matching_frames_ = nullptr;
+      while (!matching_frames_) {
+        if (!right_op_cursor_->Pull(frame, context)) return false;
+        AbortCheck(context);
+        auto key = self_.hash_join_condition_->expression2_->Accept(evaluator);
+        if (key.IsNull()) continue;
+        auto found = left_op_frames_by_key_.find(key);
+        if (found == left_op_frames_by_key_.end()) continue;
+        // Hashing considers values nested in lists and maps equal even when
+        // they contain nulls, so confirm the keys are equal as the condition
+        // would.
+        auto equal = found->first == key;
+        if (!equal.IsBool() || !equal.ValueBool()) continue;
+        matching_frames_ = &found->second;
+      }
+      right_op_frame_.assign(frame.elems().begin(), frame.elems().end());
+      matching_frames_it_ = matching_frames_->begin();
+    }
+
+    restore_frame(self_.left_symbols_, left_op_frames_[*matching_frames_it_]);
+    matching_frames_it_++;
+    return true;
+  }
+
+  void Shutdown() override {
+    left_op_cursor_->Shutdown();
+    right_op_cursor_->Shutdown();
+  }
+
+  void Reset() override {
+    left_op_cursor_->Reset();
+    right_op_cursor_->Reset();
+    right_op_frame_.clear();
+    left_op_frames_.clear();
+    left_op_frames_by_key_.clear();
+    matching_frames_ = nullptr;
+    hash_join_initialized_ = false;
+  }
+
+ private:
+  const HashJoin &self_;
+  utils::pmr::vector<utils::pmr::vector<TypedValue>> left_op_frames_;
+  // Indices of left_op_frames_ for each of the left keys.
+  utils::pmr::unordered_map<TypedValue, utils::pmr::vector<size_t>, TypedValue::Hash, TypedValue::BoolEqual>
+      left_op_frames_by_key_;
+  utils::pmr::vector<TypedValue> right_op_frame_;
+  const UniqueCursorPtr left_op_cursor_;
+  const UniqueCursorPtr right_op_cursor_;
+  // Left frames matching the key of the last pulled right_op frame.
+  const utils::pmr::vector<size_t> *matching_frames_{nullptr};
+  utils::pmr::vector<size_t>::const_iterator matching_frames_it_;
+  bool hash_join_initialized_{false};
+};
+
+}  // namespace
+
+UniqueCursorPtr HashJoin::MakeCursor(utils::MemoryResource *mem) const {
+  memgraph::metrics::IncrementCounter(memgraph::metrics::HashJoinOperator);
+
+  return MakeUniqueCursorPtr<HashJoinCursor>(mem, *this, mem);
+}
+
 OutputTable::OutputTable(std::vector<Symbol> output_symbols, std::vector<std::vector<TypedValue>> rows)
     : output_symbols_(std::move(output_symbols)), callback_([rows](Frame *, ExecutionContext *) { return rows; }) {}
 
@@ -4508,6 +7598,30 @@ void CallCustomProcedure(const std::string_view fully_qualified_procedure_name,
   }
 
   procedure::ConstructArguments(args_list, proc, fully_qualified_procedure_name, proc_args, graph);
+
+  // The resources used by the call are recorded even if it throws. The wall
+  // time of a streamed call includes the time it waits for the records to be
+  // pulled.
+  procedure::GraphAccessCounters access_counters;
+  procedure::AllocationCountingResource counting_memory(memory);
+  const utils::Timer timer;
+  const auto cpu_time_start = procedure::ProcedureStats::ThreadCpuTimeUs();
+  bool returned = false;
+  graph.access_counters = &access_counters;
+  utils::OnScopeExit record_stats([&] {
+    graph.access_counters = nullptr;
+    procedure::gProcedureStats.Record(
+        fully_qualified_procedure_name,
+        procedure::ProcedureCallStats{
+            .wall_time_us = static_cast<uint64_t>(timer.Elapsed<std::chrono::microseconds>().count()),
+            .cpu_time_us = procedure::ProcedureStats::ThreadCpuTimeUs() - cpu_time_start,
+            .allocated_bytes = counting_memory.GetAllocatedBytes(),
+            .vertices = access_counters.vertices.load(std::memory_order_relaxed),
+            .edges = access_counters.edges.load(std::memory_order_relaxed),
+            .failed = !returned || result->error_msg.has_value()});
+  });
+  memory = &counting_memory;
+
   if (call_initializer) {
     MG_ASSERT(proc.initializer);
     mgp_memory initializer_memory{memory};
@@ -4533,8 +7647,109 @@ void CallCustomProcedure(const std::string_view fully_qualified_procedure_name,
     // TODO: What about cross library boundary exceptions? OMG C++?!
     proc.cb(&proc_args, &graph, result, &proc_memory);
   }
+  returned = true;
 }
 
+/// Procedure call running on its own thread, which is suspended whenever the
+/// procedure yields more records than fit into the buffer of the result, until
+/// the query has pulled them. The procedure and the query take turns and never
+/// run at the same time, so the procedure may use the transaction and the
+/// memory of the query as if it were called on the thread of the query.
+class ProcedureResultStream {
+ public:
+  /// Starts the call and returns once it has filled the buffer or returned.
+  /// @throw anything the call throws.
+  ProcedureResultStream(procedure::ModulePtr module, const decltype(mgp_result::signature) signature,
+                        size_t buffer_size, std::function<void(mgp_result *)> call)
+      : module_(std::move(module)), result_(signature, &rows_memory_) {
+    result_.max_rows = buffer_size;
+    result_.flush = [this] { Suspend(); };
+    thread_ = std::jthread([this, call = std::move(call)] {
+      try {
+        call(&result_);
+      } catch (...) {
+        error_ = std::current_exception();
+      }
+      std::lock_guard guard(lock_);
+      finished_ = true;
+      procedure_turn_ = false;
+      turn_changed_.notify_all();
+    });
+    WaitForProcedure();
+  }
+
+  ProcedureResultStream(const ProcedureResultStream &) = delete;
+  ProcedureResultStream(ProcedureResultStream &&) = delete;
+  ProcedureResultStream &operator=(const ProcedureResultStream &) = delete;
+  ProcedureResultStream &operator=(ProcedureResultStream &&) = delete;
+
+  /// Makes `mgp_result_new_record` fail if the procedure is still running, and
+  /// waits for it to return.
+  ~ProcedureResultStream() {
+    {
+      std::lock_guard guard(lock_);
+      if (!finished_) {
+        cancelled_ = true;
+        procedure_turn_ = true;
+        turn_changed_.notify_all();
+      }
+    }
+    thread_.join();
+    memgraph::metrics::Measure(memgraph::metrics::ProcedureResultBuffer_bytes, peak_buffer_bytes_);
+  }
+
+  mgp_result &Result() { return result_; }
+
+  /// Removes the pulled records and lets the procedure yield the next ones.
+  /// Returns false if the procedure has already returned.
+  /// @throw anything the call throws.
+  bool Resume() {
+    if (finished_) return false;
+    result_.rows.clear();
+    {
+      std::lock_guard guard(lock_);
+      procedure_turn_ = true;
+      turn_changed_.notify_all();
+    }
+    WaitForProcedure();
+    return true;
+  }
+
+ private:
+  void WaitForProcedure() {
+    std::unique_lock guard(lock_);
+    turn_changed_.wait(guard, [this] { return !procedure_turn_; });
+    peak_buffer_bytes_ = std::max(peak_buffer_bytes_, rows_memory_.GetAllocatedBytes());
+    if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+  }
+
+  // Called by `mgp_result_new_record` on the thread of the procedure.
+  void Suspend() {
+    std::unique_lock guard(lock_);
+    procedure_turn_ = false;
+    turn_changed_.notify_all();
+    turn_changed_.wait(guard, [this] { return procedure_turn_; });
+    if (cancelled_) throw std::logic_error("The query no longer pulls the results of the procedure.");
+  }
+
+  // Keeps the module loaded without holding the lock of the registry, which
+  // the query may need to take again before the call returns.
+  procedure::ModulePtr module_;
+  // The records are allocated from a pool, so that the memory of the pulled
+  // records is reused for the next ones.
+  utils::PoolResource rows_pool_{128U, 1024U};
+  utils::LimitedMemoryResource rows_memory_{&rows_pool_, std::numeric_limits<size_t>::max()};
+  mgp_result result_;
+  size_t peak_buffer_bytes_{0};
+  std::mutex lock_;
+  std::condition_variable turn_changed_;
+  bool procedure_turn_{true};
+  bool finished_{false};
+  bool cancelled_{false};
+  std::exception_ptr error_;
+  std::jthread thread_;
+};
+
 }  // namespace
 
 class CallProcedureCursor : public Cursor {
@@ -4546,6 +7761,23 @@ class CallProcedureCursor : public Cursor {
   bool stream_exhausted{true};
   bool call_initializer{false};
   std::optional<std::function<void()>> cleanup_{std::nullopt};
+  // Set while a streamed procedure call hasn't returned, `result_` is then
+  // its result.
+  std::unique_ptr<ProcedureResultStream> stream_;
+
+  void CheckResultError() const {
+    if (result_->error_msg) {
+      throw QueryRuntimeException("{}: {}", self_->procedure_name_, *result_->error_msg);
+    }
+  }
+
+  // The records of read procedures are streamed, unless they're batched, which
+  // already bounds their number. The procedures of the builtin module may
+  // iterate over the registry, which requires its lock during the whole call.
+  static bool CanStream(const procedure::Module &module, const mgp_proc &proc, const ExecutionContext &context) {
+    return context.procedure_result_buffer_size != 0 && !proc.info.is_write && !proc.info.is_batched &&
+           module.Path().has_value();
+  }
 
  public:
   CallProcedureCursor(const CallProcedure *self, utils::MemoryResource *mem)
@@ -4570,6 +7802,19 @@ class CallProcedureCursor : public Cursor {
     // have procedures registering what they return.
     // This `while` loop will skip over empty results.
     while (result_row_it_ == result_->rows.end()) {
+      if (stream_) {
+        const bool resumed = stream_->Resume();
+        CheckResultError();
+        if (resumed) {
+          result_row_it_ = result_->rows.begin();
+          continue;
+        }
+        stream_.reset();
+        result_ = utils::Allocator<mgp_result>(self_->memory_resource)
+                      .new_object<mgp_result>(nullptr, self_->memory_resource);
+        result_row_it_ = result_->rows.end();
+        stream_exhausted = true;
+      }
       // It might be a good idea to resolve the procedure name once, at the
       // start. Unfortunately, this could deadlock if we tried to invoke a
       // procedure from a module (read lock) and reload a module (write lock)
@@ -4577,12 +7822,12 @@ class CallProcedureCursor : public Cursor {
       // it's not possible for a single thread to request multiple read locks.
       // Builtin module registration in query/procedure/module.cpp depends on
       // this locking scheme.
-      const auto &maybe_found = procedure::FindProcedure(procedure::gModuleRegistry, self_->procedure_name_,
-                                                         context.evaluation_context.memory);
+      auto maybe_found = procedure::FindProcedure(procedure::gModuleRegistry, self_->procedure_name_,
+                                                  context.evaluation_context.memory);
       if (!maybe_found) {
         throw QueryRuntimeException("There is no procedure named '{}'.", self_->procedure_name_);
       }
-      const auto &[module, proc] = *maybe_found;
+      auto &[module, proc] = *maybe_found;
       if (proc->info.is_write != self_->is_write_) {
         auto get_proc_type_str = [](bool is_write) { return is_write ? "write" : "read"; };
         throw QueryRuntimeException("The procedure named '{}' was a {} procedure, but changed to be a {} procedure.",
@@ -4627,9 +7872,35 @@ class CallProcedureCursor : public Cursor {
       // generator like procedures which yield a new result on new query calls.
       auto *memory = self_->memory_resource;
       auto memory_limit = EvaluateMemoryLimit(evaluator, self_->memory_limit_, self_->memory_scale_);
+      utils::Timer call_timer;
+      const auto measure_first_records = [&call_timer] {
+        memgraph::metrics::Measure(memgraph::metrics::ProcedureTimeToFirstRecord_us,
+                                   call_timer.Elapsed<std::chrono::microseconds>().count());
+      };
+      if (CanStream(*module, *proc, context)) {
+        // The call is resumed on the next pulls, while the query may call other
+        // procedures, so only the module is kept alive without the lock.
+        module.Unlock();
+        auto call = [this, &frame, &context, proc = proc, memory, memory_limit, graph_view](mgp_result *result) {
+          ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context,
+                                        context.db_accessor, graph_view);
+          auto graph = mgp_graph::WritableGraph(*context.db_accessor, graph_view, context);
+          CallCustomProcedure(self_->procedure_name_, *proc, self_->arguments_, graph, &evaluator, memory,
+                              memory_limit, result);
+        };
+        stream_ = std::make_unique<ProcedureResultStream>(std::move(module), &proc->results,
+                                                          context.procedure_result_buffer_size, std::move(call));
+        measure_first_records();
+        result_ = &stream_->Result();
+        result_signature_size_ = proc->results.size();
+        CheckResultError();
+        result_row_it_ = result_->rows.begin();
+        continue;
+      }
       auto graph = mgp_graph::WritableGraph(*context.db_accessor, graph_view, context);
       CallCustomProcedure(self_->procedure_name_, *proc, self_->arguments_, graph, &evaluator, memory, memory_limit,
                           result_, call_initializer);
+      if (!proc->info.is_batched) measure_first_records();
 
       if (call_initializer) call_initializer = false;
 
@@ -4638,9 +7909,7 @@ class CallProcedureCursor : public Cursor {
       // it, the pointer would be invalid.
       result_signature_size_ = result_->signature->size();
       result_->signature = nullptr;
-      if (result_->error_msg) {
-        throw QueryRuntimeException("{}: {}", self_->procedure_name_, *result_->error_msg);
-      }
+      CheckResultError();
       result_row_it_ = result_->rows.begin();
 
       stream_exhausted = result_row_it_ == result_->rows.end();
@@ -4676,6 +7945,8 @@ class CallProcedureCursor : public Cursor {
   }
 
   void Reset() override {
+    // The streamed call uses the memory of the procedure until it returns.
+    stream_.reset();
     self_->monotonic_memory.Release();
     result_ =
         utils::Allocator<mgp_result>(self_->memory_resource).new_object<mgp_result>(nullptr, self_->memory_resource);
@@ -4685,6 +7956,7 @@ class CallProcedureCursor : public Cursor {
   }
 
   void Shutdown() override {
+    stream_.reset();
     self_->monotonic_memory.Release();
     if (cleanup_) {
       cleanup_.value()();
@@ -4849,7 +8121,7 @@ class LoadCsvCursor : public Cursor {
     //  self_->delimiter_, and self_->quote_ earlier (say, in the interpreter.cpp)
     //  without massacring the code even worse than I did here
     if (UNLIKELY(!reader_)) {
-      reader_ = MakeReader(&context.evaluation_context);
+      reader_ = MakeReader(&context.evaluation_context, context.parallelism);
       nullif_ = ParseNullif(&context.evaluation_context);
     }
 
@@ -4881,7 +8153,7 @@ class LoadCsvCursor : public Cursor {
   void Shutdown() override { input_cursor_->Shutdown(); }
 
  private:
-  csv::Reader MakeReader(EvaluationContext *eval_context) {
+  csv::Reader MakeReader(EvaluationContext *eval_context, uint64_t parallelism) {
     Frame frame(0);
     SymbolTable symbol_table;
     DbAccessor *dba = nullptr;
@@ -4895,11 +8167,12 @@ class LoadCsvCursor : public Cursor {
     // we can't get a nullptr for the 'file_' member in the LoadCsv clause.
     // Note that the reader has to be given its own memory resource, as it
     // persists between pulls, so it can't use the evalutation context memory
-    // resource.
-    return csv::Reader(
-        csv::CsvSource::Create(*maybe_file),
-        csv::Reader::Config(self_->with_header_, self_->ignore_bad_, std::move(maybe_delim), std::move(maybe_quote)),
-        utils::NewDeleteResource());
+    // resource. With parallel execution the rows are parsed on separate
+    // threads while the rest of the plan executes.
+    auto config =
+        csv::Reader::Config(self_->with_header_, self_->ignore_bad_, std::move(maybe_delim), std::move(maybe_quote));
+    config.parallelism = parallelism;
+    return csv::Reader(csv::CsvSource::Create(*maybe_file), std::move(config), utils::NewDeleteResource());
   }
 
   std::optional<utils::pmr::string> ParseNullif(EvaluationContext *eval_context) {
@@ -4916,6 +8189,153 @@ UniqueCursorPtr LoadCsv::MakeCursor(utils::MemoryResource *mem) const {
   return MakeUniqueCursorPtr<LoadCsvCursor>(mem, this, mem);
 };
 
+LoadArrow::LoadArrow(std::shared_ptr<LogicalOperator> input, Expression *file, Symbol row_var,
+                     std::vector<std::string> columns, bool all_columns)
+    : input_(input ? input : (std::make_shared<Once>())),
+      file_(file),
+      row_var_(std::move(row_var)),
+      columns_(std::move(columns)),
+      all_columns_(all_columns) {
+  MG_ASSERT(file_, "Something went wrong - '{}' member file_ shouldn't be a nullptr", __func__);
+}
+
+ACCEPT_WITH_INPUT(LoadArrow)
+
+std::vector<Symbol> LoadArrow::OutputSymbols(const SymbolTable & /*symbol_table*/) const { return {row_var_}; }
+
+std::vector<Symbol> LoadArrow::ModifiedSymbols(const SymbolTable &table) const {
+  auto symbols = input_->ModifiedSymbols(table);
+  symbols.push_back(row_var_);
+  return symbols;
+}
+
+class LoadArrowCursor : public Cursor {
+ public:
+  LoadArrowCursor(const LoadArrow *self, utils::MemoryResource *mem)
+      : self_(self), input_cursor_(self_->input_->MakeCursor(mem)) {}
+
+  bool Pull(Frame &frame, ExecutionContext &context) override {
+    SCOPED_PROFILE_OP("LoadArrow");
+
+    AbortCheck(context);
+    PullInput(frame, context);
+    if (!NextRow(context)) return false;
+    frame[self_->row_var_] = MakeRow(context.evaluation_context.memory);
+    if (context.frame_change_collector && context.frame_change_collector->IsKeyTracked(self_->row_var_.name())) {
+      context.frame_change_collector->ResetTrackingValue(self_->row_var_.name());
+    }
+    return true;
+  }
+
+  bool PullBatch(Frame &frame, FrameBatch &batch, ExecutionContext &context) override {
+    SCOPED_PROFILE_OP("LoadArrow");
+
+    AbortCheck(context);
+    batch.Clear();
+    PullInput(frame, context);
+    while (!batch.full() && NextRow(context)) {
+      auto &row = batch.Append(frame);
+      row[self_->row_var_] = MakeRow(row.GetMemoryResource());
+    }
+    return !batch.empty();
+  }
+
+  void Reset() override { input_cursor_->Reset(); }
+  void Shutdown() override { input_cursor_->Shutdown(); }
+
+ private:
+  void PullInput(Frame &frame, ExecutionContext &context) {
+    if (UNLIKELY(!reader_)) {
+      // The file is opened on the first pull for the same reason as in LOAD
+      // CSV, the path is evaluated only then.
+      Frame empty_frame(0);
+      SymbolTable symbol_table;
+      DbAccessor *dba = nullptr;
+      auto evaluator = ExpressionEvaluator(&empty_frame, symbol_table, context.evaluation_context, dba,
+                                           storage::View::OLD);
+      // The parser makes sure the file is a string literal.
+      auto file = ToOptionalString(&evaluator, self_->file_);
+      source_.emplace(csv::CsvSource::Create(*file));
+      reader_.emplace(source_->GetStream(), self_->all_columns_ ? nullptr : &self_->columns_);
+    }
+    if (input_cursor_->Pull(frame, context)) {
+      if (did_pull_) {
+        throw QueryRuntimeException(
+            "LOAD ARROW can be executed only once, please check if the cardinality of the operator before LOAD ARROW "
+            "is 1");
+      }
+      did_pull_ = true;
+    }
+  }
+
+  /// Moves to the next row, decoding the next batches once all the rows of
+  /// the decoded ones are returned.
+  bool NextRow(ExecutionContext &context) {
+    if (++row_ < RowsOfBatch()) return true;
+    row_ = 0;
+    while (++batch_ < batches_.size()) {
+      if (RowsOfBatch() > 0) return true;
+    }
+    while (DecodeBatches(context)) {
+      for (batch_ = 0; batch_ < batches_.size(); ++batch_) {
+        if (RowsOfBatch() > 0) return true;
+      }
+    }
+    return false;
+  }
+
+  size_t RowsOfBatch() const { return batch_ < batches_.size() ? batches_[batch_].rows : 0; }
+
+  /// Reads as many record batches as there are threads and decodes them in
+  /// parallel. Returns false at the end of the file.
+  bool DecodeBatches(ExecutionContext &context) {
+    AbortCheck(context);
+    const auto parallelism = std::max<uint64_t>(context.parallelism, 1);
+    std::vector<ArrowReader::Batch> batches;
+    batches.reserve(parallelism);
+    while (batches.size() < parallelism) {
+      auto batch = reader_->ReadBatch();
+      if (!batch) break;
+      batches.push_back(std::move(*batch));
+    }
+    batches_.clear();
+    batches_.resize(batches.size());
+    ForEachChunkInParallel(
+        batches.size(), parallelism,
+        [&](size_t chunk, size_t /*chunk_begin*/, size_t /*chunk_end*/) {
+          batches_[chunk] = reader_->Decode(batches[chunk]);
+        },
+        1);
+    return !batches_.empty();
+  }
+
+  TypedValue MakeRow(utils::MemoryResource *memory) {
+    auto &batch = batches_[batch_];
+    const auto &names = reader_->ColumnNames();
+    TypedValue::TMap row(memory);
+    for (size_t i = 0; i < names.size(); ++i) {
+      // Each value is put in a single row.
+      row.emplace(std::piecewise_construct, std::forward_as_tuple(std::string_view(names[i])),
+                  std::forward_as_tuple(std::move(batch.columns[i][row_])));
+    }
+    return TypedValue(std::move(row), memory);
+  }
+
+  const LoadArrow *self_;
+  const UniqueCursorPtr input_cursor_;
+  bool did_pull_{false};
+  std::optional<csv::CsvSource> source_;
+  std::optional<ArrowReader> reader_;
+  std::vector<ArrowReader::DecodedBatch> batches_;
+  // position of the current row, which is before the first row at the start
+  size_t batch_{0};
+  size_t row_{std::numeric_limits<size_t>::max()};
+};
+
+UniqueCursorPtr LoadArrow::MakeCursor(utils::MemoryResource *mem) const {
+  return MakeUniqueCursorPtr<LoadArrowCursor>(mem, this, mem);
+}
+
 class ForeachCursor : public Cursor {
  public:
   explicit ForeachCursor(const Foreach &foreach, utils::MemoryResource *mem)
@@ -5020,7 +8440,8 @@ Apply::ApplyCursor::ApplyCursor(const Apply &self, utils::MemoryResource *mem)
     : self_(self),
       input_(self.input_->MakeCursor(mem)),
       subquery_(self.subquery_->MakeCursor(mem)),
-      subquery_has_return_(self.subquery_has_return_) {}
+      subquery_has_return_(self.subquery_has_return_),
+      memoized_results_(mem) {}
 
 std::vector<Symbol> Apply::ModifiedSymbols(const SymbolTable &table) const {
   // Since Apply is the Cartesian product, modified symbols are combined from
@@ -5034,12 +8455,49 @@ std::vector<Symbol> Apply::ModifiedSymbols(const SymbolTable &table) const {
 bool Apply::ApplyCursor::Pull(Frame &frame, ExecutionContext &context) {
   SCOPED_PROFILE_OP("Apply");
 
+  if (self_.memoize_results_ && subquery_symbols_.empty()) {
+    subquery_symbols_ = self_.subquery_->ModifiedSymbols(context.symbol_table);
+  }
+
   while (true) {
-    if (pull_input_ && !input_->Pull(frame, context)) {
-      return false;
-    };
+    if (pull_input_) {
+      if (!input_->Pull(frame, context)) return false;
+      if (self_.memoize_results_) {
+        key_.emplace(memoized_results_.MakeKey(frame, self_.correlated_symbols_));
+        memoized_rows_ = memoized_results_.Find(*key_);
+        memoized_row_ = 0;
+        if (memoized_rows_) {
+          key_.reset();
+        } else {
+          rows_.emplace(memoized_results_.memory());
+        }
+      }
+    }
+
+    if (memoized_rows_) {
+      if (memoized_row_ < memoized_rows_->size()) {
+        const auto &row = (*memoized_rows_)[memoized_row_++];
+        for (size_t i = 0; i < subquery_symbols_.size(); ++i) {
+          frame[subquery_symbols_[i]] = row[i];
+          if (context.frame_change_collector &&
+              context.frame_change_collector->IsKeyTracked(subquery_symbols_[i].name())) {
+            context.frame_change_collector->ResetTrackingValue(subquery_symbols_[i].name());
+          }
+        }
+        pull_input_ = false;
+        return true;
+      }
+      memoized_rows_ = nullptr;
+      pull_input_ = true;
+      continue;
+    }
 
     if (subquery_->Pull(frame, context)) {
+      if (rows_) {
+        auto &row = rows_->emplace_back();
+        row.reserve(subquery_symbols_.size());
+        for (const auto &symbol : subquery_symbols_) row.emplace_back(frame[symbol]);
+      }
       // if successful, next Pull from this should not pull_input_
       pull_input_ = false;
       return true;
@@ -5048,6 +8506,11 @@ bool Apply::ApplyCursor::Pull(Frame &frame, ExecutionContext &context) {
     // skip that row
     pull_input_ = true;
     subquery_->Reset();
+    if (key_ && rows_) {
+      memoized_results_.Insert(std::move(*key_), std::move(*rows_));
+    }
+    key_.reset();
+    rows_.reset();
 
     // don't skip row if no rows are returned from subquery, return input_ rows
     if (!subquery_has_return_) return true;
@@ -5063,6 +8526,10 @@ void Apply::ApplyCursor::Reset() {
   input_->Reset();
   subquery_->Reset();
   pull_input_ = true;
+  memoized_results_.Clear();
+  memoized_rows_ = nullptr;
+  key_.reset();
+  rows_.reset();
 }
 
 }  // namespace memgraph::query::plan
@@ -22,6 +22,7 @@
 #include "query/common.hpp"
 #include "query/frontend/ast/ast.hpp"
 #include "query/frontend/semantic/symbol.hpp"
+#include "query/plan/subquery_cache.hpp"
 #include "query/typed_value.hpp"
 #include "storage/v2/id_types.hpp"
 #include "utils/bound.hpp"
@@ -35,9 +36,11 @@ namespace memgraph {
 
 namespace query {
 
+class CompiledExpression;
 struct ExecutionContext;
 class ExpressionEvaluator;
 class Frame;
+class FrameBatch;
 class SymbolTable;
 
 namespace plan {
@@ -61,6 +64,23 @@ class Cursor {
   /// @throws QueryRuntimeException if something went wrong with execution
   virtual bool Pull(Frame &, ExecutionContext &) = 0;
 
+  /// Run iterations of a @c LogicalOperator until the batch is full or the
+  /// operator is exhausted.
+  ///
+  /// The batch is cleared before pulling. Each row of the batch is a complete
+  /// frame, as if it was produced by a call to `Pull`. Operators which don't
+  /// support batches natively fall back to pulling row by row.
+  ///
+  /// @param Frame Holds the values of the enclosing query, the rows of the
+  ///     batch start of as its copies. May be written to as in `Pull`.
+  /// @param FrameBatch The pulled rows.
+  /// @param ExecutionContext Used to get the position of symbols in frame and
+  ///     other information.
+  ///
+  /// @return true if at least one row was pulled.
+  /// @throws QueryRuntimeException if something went wrong with execution
+  virtual bool PullBatch(Frame &, FrameBatch &, ExecutionContext &);
+
   /// Resets the Cursor to its initial state.
   virtual void Reset() = 0;
 
@@ -91,6 +111,35 @@ std::unique_ptr<Cursor, std::function<void(Cursor *)>> MakeUniqueCursorPtr(utils
   }
 }
 
+/// The rows of the input of an operator which pulls its input in batches,
+/// together with the row that is currently being processed.
+class BatchedInput {
+ public:
+  BatchedInput();
+  BatchedInput(BatchedInput &&) noexcept;
+  BatchedInput &operator=(BatchedInput &&) noexcept;
+  ~BatchedInput();
+
+  /// Moves to the next input row, pulling the next batch from `input` once the
+  /// current one is processed. Returns false when the input is exhausted.
+  bool Next(Cursor &input, Frame &frame, ExecutionContext &context);
+
+  /// The current input row, valid until the next call to `Next`.
+  Frame &row();
+
+  /// Returns true if the last call to `Next` pulled a new batch, whose rows
+  /// are then returned by `batch`.
+  bool PulledBatch() const { return row_ == 0; }
+
+  FrameBatch &batch() { return *batch_; }
+
+  void Reset();
+
+ private:
+  std::unique_ptr<FrameBatch> batch_;
+  size_t row_{0};
+};
+
 class Once;
 class CreateNode;
 class CreateExpand;
@@ -98,10 +147,15 @@ class ScanAll;
 class ScanAllByLabel;
 class ScanAllByLabelPropertyRange;
 class ScanAllByLabelPropertyValue;
+class ScanAllByLabelPropertyValues;
 class ScanAllByLabelProperty;
+class ScanAllByLabelPropertyComposite;
 class ScanAllById;
+class ScanAllByEdgeType;
+class ScanAllByEdgeTypeProperty;
 class Expand;
 class ExpandVariable;
+class IntersectExpand;
 class ConstructNamedPath;
 class Filter;
 class Produce;
@@ -120,23 +174,29 @@ class OrderBy;
 class Merge;
 class Optional;
 class Unwind;
+class UnwindMerge;
 class Distinct;
 class Union;
 class Cartesian;
+class HashJoin;
 class CallProcedure;
 class LoadCsv;
+class LoadArrow;
 class Foreach;
 class EmptyResult;
 class EvaluatePatternFilter;
 class Apply;
+class PeriodicCommit;
 
 using LogicalOperatorCompositeVisitor =
     utils::CompositeVisitor<Once, CreateNode, CreateExpand, ScanAll, ScanAllByLabel, ScanAllByLabelPropertyRange,
-                            ScanAllByLabelPropertyValue, ScanAllByLabelProperty, ScanAllById, Expand, ExpandVariable,
-                            ConstructNamedPath, Filter, Produce, Delete, SetProperty, SetProperties, SetLabels,
-                            RemoveProperty, RemoveLabels, EdgeUniquenessFilter, Accumulate, Aggregate, Skip, Limit,
-                            OrderBy, Merge, Optional, Unwind, Distinct, Union, Cartesian, CallProcedure, LoadCsv,
-                            Foreach, EmptyResult, EvaluatePatternFilter, Apply>;
+                            ScanAllByLabelPropertyValue, ScanAllByLabelPropertyValues, ScanAllByLabelProperty,
+                            ScanAllByLabelPropertyComposite, ScanAllById, ScanAllByEdgeType, ScanAllByEdgeTypeProperty,
+                            Expand, ExpandVariable, IntersectExpand, ConstructNamedPath, Filter, Produce, Delete,
+                            SetProperty, SetProperties, SetLabels, RemoveProperty, RemoveLabels, EdgeUniquenessFilter,
+                            Accumulate, Aggregate, Skip, Limit, OrderBy, Merge, Optional, Unwind, UnwindMerge,
+                            Distinct, Union, Cartesian, HashJoin, CallProcedure, LoadCsv, LoadArrow, Foreach,
+                            EmptyResult, EvaluatePatternFilter, Apply, PeriodicCommit>;
 
 using LogicalOperatorLeafVisitor = utils::LeafVisitor<Once>;
 
@@ -264,6 +324,7 @@ class Once : public memgraph::query::plan::LogicalOperator {
    public:
     OnceCursor() {}
     bool Pull(Frame &, ExecutionContext &) override;
+    bool PullBatch(Frame &, FrameBatch &, ExecutionContext &) override;
     void Shutdown() override;
     void Reset() override;
 
@@ -552,11 +613,22 @@ class ScanAllByLabel : public memgraph::query::plan::ScanAll {
 
   ScanAllByLabel() {}
   ScanAllByLabel(const std::shared_ptr<LogicalOperator> &input, Symbol output_symbol, storage::LabelId label,
-                 storage::View view = storage::View::OLD);
+                 storage::View view = storage::View::OLD, std::vector<storage::LabelId> filter_labels = {},
+                 std::vector<storage::PropertyId> filter_properties = {}, std::vector<Expression *> filter_values = {});
   bool Accept(HierarchicalLogicalOperatorVisitor &visitor) override;
   UniqueCursorPtr MakeCursor(utils::MemoryResource *) const override;
 
   storage::LabelId label_;
+  /// Other labels which the vertices are filtered by. The storage uses them
+  /// only to skip vertices which certainly don't have them, so a @c Filter
+  /// checking the labels still has to follow.
+  std::vector<storage::LabelId> filter_labels_;
+  /// Properties which the storage compares to @c filter_values_ before the
+  /// vertices are read. A @c Filter with the original equality checks still
+  /// has to follow.
+  std::vector<storage::PropertyId> filter_properties_;
+  /// Expressions producing the values of @c filter_properties_.
+  std::vector<Expression *> filter_values_;
 
   std::unique_ptr<LogicalOperator> Clone(AstStorage *storage) const override {
     auto object = std::make_unique<ScanAllByLabel>();
@@ -564,6 +636,12 @@ class ScanAllByLabel : public memgraph::query::plan::ScanAll {
     object->output_symbol_ = output_symbol_;
     object->view_ = view_;
     object->label_ = label_;
+    object->filter_labels_ = filter_labels_;
+    object->filter_properties_ = filter_properties_;
+    object->filter_values_.resize(filter_values_.size());
+    for (auto i = 0; i < filter_values_.size(); ++i) {
+      object->filter_values_[i] = filter_values_[i] ? filter_values_[i]->Clone(storage) : nullptr;
+    }
     return object;
   }
 };
@@ -609,6 +687,10 @@ class ScanAllByLabelPropertyRange : public memgraph::query::plan::ScanAll {
   std::string property_name_;
   std::optional<Bound> lower_bound_;
   std::optional<Bound> upper_bound_;
+  /// If set, the pattern of a regex match on the property. The range is then
+  /// narrowed to the strings which start with the literal prefix of the
+  /// pattern, which is only known when the pattern is evaluated.
+  Expression *regex_{nullptr};
 
   std::unique_ptr<LogicalOperator> Clone(AstStorage *storage) const override {
     auto object = std::make_unique<ScanAllByLabelPropertyRange>();
@@ -618,6 +700,7 @@ class ScanAllByLabelPropertyRange : public memgraph::query::plan::ScanAll {
     object->label_ = label_;
     object->property_ = property_;
     object->property_name_ = property_name_;
+    object->regex_ = regex_ ? regex_->Clone(storage) : nullptr;
     if (lower_bound_) {
       object->lower_bound_.emplace(
           utils::Bound<Expression *>(lower_bound_->value()->Clone(storage), lower_bound_->type()));
@@ -681,6 +764,55 @@ class ScanAllByLabelPropertyValue : public memgraph::query::plan::ScanAll {
   }
 };
 
+/// Behaves like @c ScanAll, but produces only vertices with given label and
+/// any of the property values in a list. The values are sorted and the
+/// duplicates removed, so the index is walked once, from the smallest value to
+/// the largest, and each vertex is produced once.
+///
+/// @sa ScanAll
+/// @sa ScanAllByLabelPropertyValue
+class ScanAllByLabelPropertyValues : public memgraph::query::plan::ScanAll {
+ public:
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const override { return kType; }
+
+  ScanAllByLabelPropertyValues() {}
+  /**
+   * Constructs the operator for given label and list of property values.
+   *
+   * @param input Preceding operator which will serve as the input.
+   * @param output_symbol Symbol where the vertices will be stored.
+   * @param label Label which the vertex must have.
+   * @param property Property from which the values will be looked up from.
+   * @param expression Expression producing the list of the values of the
+   * vertex property.
+   * @param view storage::View used when obtaining vertices.
+   */
+  ScanAllByLabelPropertyValues(const std::shared_ptr<LogicalOperator> &input, Symbol output_symbol,
+                               storage::LabelId label, storage::PropertyId property, const std::string &property_name,
+                               Expression *expression, storage::View view = storage::View::OLD);
+
+  bool Accept(HierarchicalLogicalOperatorVisitor &visitor) override;
+  UniqueCursorPtr MakeCursor(utils::MemoryResource *) const override;
+
+  storage::LabelId label_;
+  storage::PropertyId property_;
+  std::string property_name_;
+  Expression *expression_;
+
+  std::unique_ptr<LogicalOperator> Clone(AstStorage *storage) const override {
+    auto object = std::make_unique<ScanAllByLabelPropertyValues>();
+    object->input_ = input_ ? input_->Clone(storage) : nullptr;
+    object->output_symbol_ = output_symbol_;
+    object->view_ = view_;
+    object->label_ = label_;
+    object->property_ = property_;
+    object->property_name_ = property_name_;
+    object->expression_ = expression_ ? expression_->Clone(storage) : nullptr;
+    return object;
+  }
+};
+
 /// Behaves like @c ScanAll, but this operator produces only vertices with
 /// given label and property.
 ///
@@ -717,6 +849,75 @@ class ScanAllByLabelProperty : public memgraph::query::plan::ScanAll {
   }
 };
 
+/// Behaves like @c ScanAll, but produces only vertices from a composite index
+/// on the given label and properties. The values of the leading properties
+/// must be equal to the prefix expressions, and the value of the property
+/// following them may be limited by a range.
+///
+/// @sa ScanAll
+/// @sa ScanAllByLabelPropertyRange
+/// @sa ScanAllByLabelPropertyValue
+class ScanAllByLabelPropertyComposite : public memgraph::query::plan::ScanAll {
+ public:
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const override { return kType; }
+
+  /** Bound with expression which when evaluated produces the bound value. */
+  using Bound = utils::Bound<Expression *>;
+  ScanAllByLabelPropertyComposite() {}
+  /**
+   * Constructs the operator for given label and indexed properties.
+   *
+   * @param input Preceding operator which will serve as the input.
+   * @param output_symbol Symbol where the vertices will be stored.
+   * @param label Label which the vertex must have.
+   * @param properties Properties of the composite index, in index order.
+   * @param prefix Expressions producing the values of the leading properties.
+   * @param lower_bound Optional lower @c Bound on the property following the prefix.
+   * @param upper_bound Optional upper @c Bound on the property following the prefix.
+   * @param view storage::View used when obtaining vertices.
+   */
+  ScanAllByLabelPropertyComposite(const std::shared_ptr<LogicalOperator> &input, Symbol output_symbol,
+                                  storage::LabelId label, std::vector<storage::PropertyId> properties,
+                                  std::vector<Expression *> prefix, std::optional<Bound> lower_bound,
+                                  std::optional<Bound> upper_bound, storage::View view = storage::View::OLD);
+
+  bool Accept(HierarchicalLogicalOperatorVisitor &visitor) override;
+  UniqueCursorPtr MakeCursor(utils::MemoryResource *) const override;
+
+  storage::LabelId label_;
+  std::vector<storage::PropertyId> properties_;
+  std::vector<Expression *> prefix_;
+  std::optional<Bound> lower_bound_;
+  std::optional<Bound> upper_bound_;
+
+  std::unique_ptr<LogicalOperator> Clone(AstStorage *storage) const override {
+    auto object = std::make_unique<ScanAllByLabelPropertyComposite>();
+    object->input_ = input_ ? input_->Clone(storage) : nullptr;
+    object->output_symbol_ = output_symbol_;
+    object->view_ = view_;
+    object->label_ = label_;
+    object->properties_ = properties_;
+    object->prefix_.resize(prefix_.size());
+    for (auto i = 0; i < prefix_.size(); ++i) {
+      object->prefix_[i] = prefix_[i] ? prefix_[i]->Clone(storage) : nullptr;
+    }
+    if (lower_bound_) {
+      object->lower_bound_.emplace(
+          utils::Bound<Expression *>(lower_bound_->value()->Clone(storage), lower_bound_->type()));
+    } else {
+      object->lower_bound_ = std::nullopt;
+    }
+    if (upper_bound_) {
+      object->upper_bound_.emplace(
+          utils::Bound<Expression *>(upper_bound_->value()->Clone(storage), upper_bound_->type()));
+    } else {
+      object->upper_bound_ = std::nullopt;
+    }
+    return object;
+  }
+};
+
 /// ScanAll producing a single node with ID equal to evaluated expression
 class ScanAllById : public memgraph::query::plan::ScanAll {
  public:
@@ -742,6 +943,115 @@ class ScanAllById : public memgraph::query::plan::ScanAll {
   }
 };
 
+/// Operator which produces the edges of the given type from the edge-type
+/// index. Along with the edge, both of its endpoints are stored on the frame,
+/// so the operator replaces a @c ScanAll followed by an @c Expand over a single
+/// edge type.
+///
+/// @sa ScanAllByEdgeTypeProperty
+class ScanAllByEdgeType : public memgraph::query::plan::LogicalOperator {
+ public:
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const override { return kType; }
+
+  ScanAllByEdgeType() {}
+  ScanAllByEdgeType(const std::shared_ptr<LogicalOperator> &input, Symbol edge_symbol, Symbol from_symbol,
+                    Symbol to_symbol, storage::EdgeTypeId edge_type, storage::View view = storage::View::OLD);
+  bool Accept(HierarchicalLogicalOperatorVisitor &visitor) override;
+  UniqueCursorPtr MakeCursor(utils::MemoryResource *) const override;
+  std::vector<Symbol> ModifiedSymbols(const SymbolTable &) const override;
+
+  bool HasSingleInput() const override { return true; }
+  std::shared_ptr<LogicalOperator> input() const override { return input_; }
+  void set_input(std::shared_ptr<LogicalOperator> input) override { input_ = input; }
+
+  std::shared_ptr<memgraph::query::plan::LogicalOperator> input_;
+  Symbol edge_symbol_;
+  Symbol from_symbol_;
+  Symbol to_symbol_;
+  storage::EdgeTypeId edge_type_;
+  /// Controls which graph state is used to produce edges.
+  storage::View view_;
+
+  std::unique_ptr<LogicalOperator> Clone(AstStorage *storage) const override {
+    auto object = std::make_unique<ScanAllByEdgeType>();
+    object->input_ = input_ ? input_->Clone(storage) : nullptr;
+    object->edge_symbol_ = edge_symbol_;
+    object->from_symbol_ = from_symbol_;
+    object->to_symbol_ = to_symbol_;
+    object->edge_type_ = edge_type_;
+    object->view_ = view_;
+    return object;
+  }
+};
+
+/// Behaves like @c ScanAllByEdgeType, but produces only edges from the
+/// edge-type+property index. The value of the property is either equal to the
+/// expression, or it is limited by a range. Without an expression and bounds,
+/// all edges which have the property are produced.
+///
+/// @sa ScanAllByEdgeType
+class ScanAllByEdgeTypeProperty : public memgraph::query::plan::ScanAllByEdgeType {
+ public:
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const override { return kType; }
+
+  /** Bound with expression which when evaluated produces the bound value. */
+  using Bound = utils::Bound<Expression *>;
+  ScanAllByEdgeTypeProperty() {}
+  /**
+   * Constructs the operator for given edge type and property.
+   *
+   * @param input Preceding operator which will serve as the input.
+   * @param edge_symbol Symbol where the edges will be stored.
+   * @param from_symbol Symbol where the source vertices will be stored.
+   * @param to_symbol Symbol where the destination vertices will be stored.
+   * @param edge_type Type which the edge must have.
+   * @param property Indexed property.
+   * @param expression Optional expression producing the property value.
+   * @param lower_bound Optional lower @c Bound, used only without the expression.
+   * @param upper_bound Optional upper @c Bound, used only without the expression.
+   * @param view storage::View used when obtaining edges.
+   */
+  ScanAllByEdgeTypeProperty(const std::shared_ptr<LogicalOperator> &input, Symbol edge_symbol, Symbol from_symbol,
+                            Symbol to_symbol, storage::EdgeTypeId edge_type, storage::PropertyId property,
+                            Expression *expression, std::optional<Bound> lower_bound, std::optional<Bound> upper_bound,
+                            storage::View view = storage::View::OLD);
+
+  bool Accept(HierarchicalLogicalOperatorVisitor &visitor) override;
+  UniqueCursorPtr MakeCursor(utils::MemoryResource *) const override;
+
+  storage::PropertyId property_;
+  Expression *expression_;
+  std::optional<Bound> lower_bound_;
+  std::optional<Bound> upper_bound_;
+
+  std::unique_ptr<LogicalOperator> Clone(AstStorage *storage) const override {
+    auto object = std::make_unique<ScanAllByEdgeTypeProperty>();
+    object->input_ = input_ ? input_->Clone(storage) : nullptr;
+    object->edge_symbol_ = edge_symbol_;
+    object->from_symbol_ = from_symbol_;
+    object->to_symbol_ = to_symbol_;
+    object->edge_type_ = edge_type_;
+    object->view_ = view_;
+    object->property_ = property_;
+    object->expression_ = expression_ ? expression_->Clone(storage) : nullptr;
+    if (lower_bound_) {
+      object->lower_bound_.emplace(
+          utils::Bound<Expression *>(lower_bound_->value()->Clone(storage), lower_bound_->type()));
+    } else {
+      object->lower_bound_ = std::nullopt;
+    }
+    if (upper_bound_) {
+      object->upper_bound_.emplace(
+          utils::Bound<Expression *>(upper_bound_->value()->Clone(storage), upper_bound_->type()));
+    } else {
+      object->upper_bound_ = std::nullopt;
+    }
+    return object;
+  }
+};
+
 struct ExpandCommon {
   static const utils::TypeInfo kType;
   const utils::TypeInfo &GetTypeInfo() const { return kType; }
@@ -807,6 +1117,7 @@ class Expand : public memgraph::query::plan::LogicalOperator {
    public:
     ExpandCursor(const Expand &, utils::MemoryResource *);
     bool Pull(Frame &, ExecutionContext &) override;
+    bool PullBatch(Frame &, FrameBatch &, ExecutionContext &) override;
     void Shutdown() override;
     void Reset() override;
 
@@ -826,8 +1137,22 @@ class Expand : public memgraph::query::plan::LogicalOperator {
     std::optional<InEdgeIteratorT> in_edges_it_;
     std::optional<OutEdgeT> out_edges_;
     std::optional<OutEdgeIteratorT> out_edges_it_;
+    BatchedInput input_batch_;
+    // Set while the rows of an input batch whose edges were prefetched
+    // together are expanded.
+    bool batch_prefetched_{false};
 
     bool InitEdges(Frame &, ExecutionContext &);
+    /// Prefetches the edges of the vertices of the input batch from the
+    /// on-disk storage together, instead of row by row.
+    void PrefetchBatch(ExecutionContext &);
+    /// Initializes the edges of the input vertex in the given frame, returns
+    /// false if there is no input vertex.
+    bool InitEdgesOf(Frame &, ExecutionContext &);
+    /// Returns the next edge to expand to, together with the direction of the
+    /// expansion, or std::nullopt if the edges are exhausted.
+    std::optional<std::pair<EdgeAccessor, EdgeAtom::Direction>> NextEdge(ExecutionContext &);
+    void SetExpansion(Frame &, const EdgeAccessor &, EdgeAtom::Direction) const;
   };
 
   std::shared_ptr<memgraph::query::plan::LogicalOperator> input_;
@@ -942,6 +1267,9 @@ class ExpandVariable : public memgraph::query::plan::LogicalOperator {
   memgraph::query::plan::ExpansionLambda filter_lambda_;
   std::optional<memgraph::query::plan::ExpansionLambda> weight_lambda_;
   std::optional<Symbol> total_weight_;
+  /// Set if only the number of all shortest paths is needed. For each input row the
+  /// number of paths is then written to this symbol instead of returning the paths one by one.
+  std::optional<Symbol> path_count_symbol_;
 
   std::unique_ptr<LogicalOperator> Clone(AstStorage *storage) const override {
     auto object = std::make_unique<ExpandVariable>();
@@ -961,6 +1289,7 @@ class ExpandVariable : public memgraph::query::plan::LogicalOperator {
       object->weight_lambda_ = std::nullopt;
     }
     object->total_weight_ = total_weight_;
+    object->path_count_symbol_ = path_count_symbol_;
     return object;
   }
 
@@ -973,6 +1302,77 @@ class ExpandVariable : public memgraph::query::plan::LogicalOperator {
   friend class ExpandAllShortestPathCursor;
 };
 
+/// One of the edges which connect an already bound vertex to the node
+/// produced by `IntersectExpand`.
+struct IntersectEdge {
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const { return kType; }
+
+  /// Symbol pointing to the bound vertex.
+  Symbol input_symbol;
+  /// Symbol where the edge will be stored.
+  Symbol edge_symbol;
+  /// Direction of the edge, relative to the bound vertex.
+  EdgeAtom::Direction direction;
+  /// Types of the edge. If empty, all edges are valid.
+  std::vector<storage::EdgeTypeId> edge_types;
+};
+
+/// Expansion of several bound vertices to their common neighbors, used to
+/// close cycles like `(a)-->(b)-->(c)-->(a)`. For each input it produces every
+/// node with one edge to each of the bound vertices, together with those
+/// edges.
+///
+/// Instead of expanding all edges of one vertex and then checking the
+/// others, the edges of the vertex with the fewest edges are iterated and the
+/// edges of the other vertices to each neighbor are looked up directly. The
+/// number of rows produced on the way is therefore bounded by the smallest
+/// degree, as in a generic worst-case optimal join.
+///
+/// Like `Expand`, this class doesn't handle filtering on properties and
+/// labels nor the uniqueness of edges.
+class IntersectExpand : public memgraph::query::plan::LogicalOperator {
+ public:
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const override { return kType; }
+
+  IntersectExpand() {}
+  /**
+   * @param input Optional logical operator that preceeds this one.
+   * @param node_symbol Symbol where the common neighbor will be stored.
+   * @param edges At least 2 edges from the bound vertices to the neighbor.
+   * @param view State from which the vertices should get expanded.
+   */
+  IntersectExpand(const std::shared_ptr<LogicalOperator> &input, Symbol node_symbol, std::vector<IntersectEdge> edges,
+                  storage::View view)
+      : input_(input ? input : std::make_shared<Once>()),
+        node_symbol_(node_symbol),
+        edges_(std::move(edges)),
+        view_(view) {}
+
+  bool Accept(HierarchicalLogicalOperatorVisitor &visitor) override;
+  UniqueCursorPtr MakeCursor(utils::MemoryResource *) const override;
+  std::vector<Symbol> ModifiedSymbols(const SymbolTable &) const override;
+
+  bool HasSingleInput() const override { return true; }
+  std::shared_ptr<LogicalOperator> input() const override { return input_; }
+  void set_input(std::shared_ptr<LogicalOperator> input) override { input_ = input; }
+
+  std::shared_ptr<memgraph::query::plan::LogicalOperator> input_;
+  Symbol node_symbol_;
+  std::vector<IntersectEdge> edges_;
+  storage::View view_;
+
+  std::unique_ptr<LogicalOperator> Clone(AstStorage *storage) const override {
+    auto object = std::make_unique<IntersectExpand>();
+    object->input_ = input_ ? input_->Clone(storage) : nullptr;
+    object->node_symbol_ = node_symbol_;
+    object->edges_ = edges_;
+    object->view_ = view_;
+    return object;
+  }
+};
+
 /// Constructs a named path from its elements and places it on the frame.
 class ConstructNamedPath : public memgraph::query::plan::LogicalOperator {
  public:
@@ -1046,6 +1446,7 @@ class Filter : public memgraph::query::plan::LogicalOperator {
    public:
     FilterCursor(const Filter &, utils::MemoryResource *);
     bool Pull(Frame &, ExecutionContext &) override;
+    bool PullBatch(Frame &, FrameBatch &, ExecutionContext &) override;
     void Shutdown() override;
     void Reset() override;
 
@@ -1053,6 +1454,8 @@ class Filter : public memgraph::query::plan::LogicalOperator {
     const Filter &self_;
     const UniqueCursorPtr input_cursor_;
     const std::vector<UniqueCursorPtr> pattern_filter_cursors_;
+    // Compiled on the first pull, since it depends on the query parameters.
+    std::unique_ptr<CompiledExpression> expression_;
   };
 };
 
@@ -1104,14 +1507,27 @@ class Produce : public memgraph::query::plan::LogicalOperator {
     void Reset() override;
 
    private:
+    bool PullFromBatch(Frame &, ExecutionContext &);
+    void EvaluateNamedExpressions(Frame &, ExpressionEvaluator &, ExecutionContext &);
+
     const Produce &self_;
     const UniqueCursorPtr input_cursor_;
+    // Set on the first pull, tells whether the input is pulled in batches.
+    std::optional<bool> use_batches_;
+    BatchedInput input_batch_;
+    // Symbols copied from the current input row to the frame when pulling in
+    // batches.
+    std::vector<Symbol> batch_symbols_;
+    // The named expressions compiled on the first pull.
+    std::vector<CompiledExpression> expressions_;
   };
 };
 
 /// Operator for deleting vertices and edges.
 ///
-/// Has a flag for using DETACH DELETE when deleting vertices.
+/// Has a flag for using DETACH DELETE when deleting vertices. With DETACH
+/// DELETE and an input pulled in batches, the vertices of a whole batch are
+/// deleted together, which locks each of them and their neighbors only once.
 class Delete : public memgraph::query::plan::LogicalOperator {
  public:
   static const utils::TypeInfo kType;
@@ -1154,8 +1570,20 @@ class Delete : public memgraph::query::plan::LogicalOperator {
     void Reset() override;
 
    private:
+    bool PullFromBatch(Frame &, ExecutionContext &);
+    /// Detach deletes the vertices of all rows of the current input batch
+    /// together.
+    void DeleteBatch(ExecutionContext &);
+    void DeleteEdges(utils::pmr::vector<TypedValue> &expression_results, ExecutionContext &);
+
     const Delete &self_;
     const UniqueCursorPtr input_cursor_;
+    // Set on the first pull, tells whether the input is pulled in batches.
+    std::optional<bool> use_batches_;
+    BatchedInput input_batch_;
+    // Symbols copied from the current input row to the frame when pulling in
+    // batches.
+    std::vector<Symbol> batch_symbols_;
   };
 };
 
@@ -1205,6 +1633,8 @@ class SetProperty : public memgraph::query::plan::LogicalOperator {
    private:
     const SetProperty &self_;
     const UniqueCursorPtr input_cursor_;
+    // Set if the property is set to its own value plus this expression.
+    Expression *addend_;
   };
 };
 
@@ -1492,6 +1922,41 @@ class EmptyResult : public memgraph::query::plan::LogicalOperator {
   }
 };
 
+/// Commits the transaction after every `commit_frequency_` rows pulled from
+/// the input and continues the query in a new transaction, so that a large
+/// write query doesn't keep the deltas of all its changes until it finishes.
+///
+/// The operator is planned for queries with the `USING PERIODIC COMMIT n`
+/// hint, right below the operators which produce the results of the query.
+/// The changes committed before an error are not rolled back.
+class PeriodicCommit : public memgraph::query::plan::LogicalOperator {
+ public:
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const override { return kType; }
+
+  PeriodicCommit() {}
+
+  PeriodicCommit(const std::shared_ptr<LogicalOperator> &input, Expression *commit_frequency);
+  bool Accept(HierarchicalLogicalOperatorVisitor &visitor) override;
+  UniqueCursorPtr MakeCursor(utils::MemoryResource *) const override;
+  std::vector<Symbol> OutputSymbols(const SymbolTable &) const override;
+  std::vector<Symbol> ModifiedSymbols(const SymbolTable &) const override;
+
+  bool HasSingleInput() const override { return true; }
+  std::shared_ptr<LogicalOperator> input() const override { return input_; }
+  void set_input(std::shared_ptr<LogicalOperator> input) override { input_ = input; }
+
+  std::shared_ptr<memgraph::query::plan::LogicalOperator> input_;
+  Expression *commit_frequency_{nullptr};
+
+  std::unique_ptr<LogicalOperator> Clone(AstStorage *storage) const override {
+    auto object = std::make_unique<PeriodicCommit>();
+    object->input_ = input_ ? input_->Clone(storage) : nullptr;
+    object->commit_frequency_ = commit_frequency_ ? commit_frequency_->Clone(storage) : nullptr;
+    return object;
+  }
+};
+
 /// Pulls everything from the input before passing it through.
 /// Optionally advances the command after accumulation and before emitting.
 ///
@@ -1567,8 +2032,8 @@ class Aggregate : public memgraph::query::plan::LogicalOperator {
   const utils::TypeInfo &GetTypeInfo() const override { return kType; }
 
   /// An aggregation element, contains:
-  ///        (input data expression, key expression - only used in COLLECT_MAP, type of
-  ///        aggregation, output symbol).
+  ///        (input data expression, key expression - the key of COLLECT_MAP or the
+  ///        percentile of APPROX_PERCENTILE, type of aggregation, output symbol).
   struct Element {
     static const utils::TypeInfo kType;
     const utils::TypeInfo &GetTypeInfo() const { return kType; }
@@ -1697,11 +2162,18 @@ class EvaluatePatternFilter : public memgraph::query::plan::LogicalOperator {
 
   std::shared_ptr<memgraph::query::plan::LogicalOperator> input_;
   Symbol output_symbol_;
+  /// Whether the results of the pattern are memoized by the values of the
+  /// `correlated_symbols_`, which is the case when the pattern is deterministic.
+  bool memoize_results_{false};
+  /// Symbols from the outer scope which the pattern reads.
+  std::vector<Symbol> correlated_symbols_;
 
   std::unique_ptr<LogicalOperator> Clone(AstStorage *storage) const override {
     auto object = std::make_unique<EvaluatePatternFilter>();
     object->input_ = input_ ? input_->Clone(storage) : nullptr;
     object->output_symbol_ = output_symbol_;
+    object->memoize_results_ = memoize_results_;
+    object->correlated_symbols_ = correlated_symbols_;
     return object;
   }
 
@@ -1716,6 +2188,7 @@ class EvaluatePatternFilter : public memgraph::query::plan::LogicalOperator {
    private:
     const EvaluatePatternFilter &self_;
     UniqueCursorPtr input_cursor_;
+    SubqueryResultCache memoized_results_;
   };
 };
 
@@ -1788,6 +2261,12 @@ class Limit : public memgraph::query::plan::LogicalOperator {
 /// For each row an arbitrary number of Frame elements can be
 /// remembered. Only these elements (defined by their Symbols)
 /// are valid for usage after the OrderBy operator.
+///
+/// If the operator is followed by a @c Limit, the rows
+/// past skip + limit are never returned. In that case only the
+/// best skip + limit rows are kept in a bounded heap instead of
+/// sorting all of them. The @c Skip and @c Limit operators still
+/// follow and drop the extra rows.
 class OrderBy : public memgraph::query::plan::LogicalOperator {
  public:
   static const utils::TypeInfo kType;
@@ -1796,7 +2275,7 @@ class OrderBy : public memgraph::query::plan::LogicalOperator {
   OrderBy() {}
 
   OrderBy(const std::shared_ptr<LogicalOperator> &input, const std::vector<SortItem> &order_by,
-          const std::vector<Symbol> &output_symbols);
+          const std::vector<Symbol> &output_symbols, Expression *skip = nullptr, Expression *limit = nullptr);
   bool Accept(HierarchicalLogicalOperatorVisitor &visitor) override;
   UniqueCursorPtr MakeCursor(utils::MemoryResource *) const override;
   std::vector<Symbol> OutputSymbols(const SymbolTable &) const override;
@@ -1810,6 +2289,11 @@ class OrderBy : public memgraph::query::plan::LogicalOperator {
   TypedValueVectorCompare compare_;
   std::vector<Expression *> order_by_;
   std::vector<Symbol> output_symbols_;
+  /// Expression of the @c Skip following this operator, if any.
+  Expression *skip_{nullptr};
+  /// Expression of the @c Limit following this operator, if any. When set, only
+  /// the first skip + limit rows are kept while the input is pulled.
+  Expression *limit_{nullptr};
 
   std::unique_ptr<LogicalOperator> Clone(AstStorage *storage) const override {
     auto object = std::make_unique<OrderBy>();
@@ -1820,6 +2304,8 @@ class OrderBy : public memgraph::query::plan::LogicalOperator {
       object->order_by_[i6] = order_by_[i6] ? order_by_[i6]->Clone(storage) : nullptr;
     }
     object->output_symbols_ = output_symbols_;
+    object->skip_ = skip_ ? skip_->Clone(storage) : nullptr;
+    object->limit_ = limit_ ? limit_->Clone(storage) : nullptr;
     return object;
   }
 };
@@ -1978,6 +2464,72 @@ class Unwind : public memgraph::query::plan::LogicalOperator {
   }
 };
 
+/// Ingests the elements of a list in bulk, replacing the plan of
+///
+///   UNWIND <list> AS row MERGE (n:Label {property: <key>}) [SET n += <properties>]
+///
+/// when the merge can use a label-property index. The rows of `LOAD ARROW` are
+/// ingested the same way, they are pulled from the input when there's no
+/// list. The keys of all the rows
+/// are evaluated first, sorted and deduplicated, and each distinct key is
+/// looked up in the index once. The missing vertices are then created and
+/// the properties of all the rows with the same key are written to the
+/// vertex at once. All rows are yielded in the order of the list afterwards,
+/// which is why the operator is only planned below operators that consume
+/// all of their input before yielding, like `EmptyResult` and `Accumulate`.
+///
+/// The rows are ingested by `merge_` instead, which is the original plan, if
+/// the result could differ from executing it row by row, e.g. because a key is
+/// null or one of the rows sets the key property, and if triggers, fine
+/// grained access control or frame change tracking need to see the rows one
+/// by one.
+class UnwindMerge : public memgraph::query::plan::LogicalOperator {
+ public:
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const override { return kType; }
+
+  UnwindMerge() {}
+
+  UnwindMerge(const std::shared_ptr<LogicalOperator> &input, Expression *input_expression, Symbol row_symbol,
+              Symbol node_symbol, storage::LabelId label, storage::PropertyId property, Expression *key,
+              Expression *properties, const std::shared_ptr<LogicalOperator> &merge);
+  bool Accept(HierarchicalLogicalOperatorVisitor &visitor) override;
+  UniqueCursorPtr MakeCursor(utils::MemoryResource *) const override;
+  std::vector<Symbol> ModifiedSymbols(const SymbolTable &) const override;
+
+  bool HasSingleInput() const override { return true; }
+  std::shared_ptr<LogicalOperator> input() const override { return input_; }
+  void set_input(std::shared_ptr<LogicalOperator> input) override { input_ = input; }
+
+  std::shared_ptr<memgraph::query::plan::LogicalOperator> input_;
+  /// The list of the rows, or nullptr if the input yields them.
+  Expression *input_expression_;
+  Symbol row_symbol_;
+  Symbol node_symbol_;
+  storage::LabelId label_;
+  storage::PropertyId property_;
+  /// Value of the property which identifies the vertex of a row.
+  Expression *key_;
+  /// Map of the properties set on the vertex of a row, or nullptr.
+  Expression *properties_;
+  /// Plan which ingests the rows one by one.
+  std::shared_ptr<memgraph::query::plan::LogicalOperator> merge_;
+
+  std::unique_ptr<LogicalOperator> Clone(AstStorage *storage) const override {
+    auto object = std::make_unique<UnwindMerge>();
+    object->input_ = input_ ? input_->Clone(storage) : nullptr;
+    object->input_expression_ = input_expression_ ? input_expression_->Clone(storage) : nullptr;
+    object->row_symbol_ = row_symbol_;
+    object->node_symbol_ = node_symbol_;
+    object->label_ = label_;
+    object->property_ = property_;
+    object->key_ = key_ ? key_->Clone(storage) : nullptr;
+    object->properties_ = properties_ ? properties_->Clone(storage) : nullptr;
+    object->merge_ = merge_ ? merge_->Clone(storage) : nullptr;
+    return object;
+  }
+};
+
 /// Ensures that only distinct rows are yielded.
 /// This implementation accepts a vector of Symbols
 /// which define a row. Only those Symbols are valid
@@ -2101,6 +2653,56 @@ class Cartesian : public memgraph::query::plan::LogicalOperator {
   }
 };
 
+/// Operator for joining 2 input branches on the equality of their keys.
+///
+/// All results of the left branch are hashed by the left side of the
+/// condition, then each result of the right branch is joined with the left
+/// results whose key is equal to the right side of the condition. This
+/// produces the same results as a Cartesian product filtered by the
+/// condition, without comparing each pair of results.
+class HashJoin : public memgraph::query::plan::LogicalOperator {
+ public:
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const override { return kType; }
+
+  HashJoin() {}
+  /** Construct the operator with left input branch, right input branch and
+   * the condition whose `expression1_` uses only the left symbols and
+   * `expression2_` only the right symbols. */
+  HashJoin(const std::shared_ptr<LogicalOperator> &left_op, const std::vector<Symbol> &left_symbols,
+           const std::shared_ptr<LogicalOperator> &right_op, const std::vector<Symbol> &right_symbols,
+           EqualOperator *hash_join_condition)
+      : left_op_(left_op),
+        left_symbols_(left_symbols),
+        right_op_(right_op),
+        right_symbols_(right_symbols),
+        hash_join_condition_(hash_join_condition) {}
+
+  bool Accept(HierarchicalLogicalOperatorVisitor &visitor) override;
+  UniqueCursorPtr MakeCursor(utils::MemoryResource *) const override;
+  std::vector<Symbol> ModifiedSymbols(const SymbolTable &) const override;
+
+  bool HasSingleInput() const override;
+  std::shared_ptr<LogicalOperator> input() const override;
+  void set_input(std::shared_ptr<LogicalOperator>) override;
+
+  std::shared_ptr<memgraph::query::plan::LogicalOperator> left_op_;
+  std::vector<Symbol> left_symbols_;
+  std::shared_ptr<memgraph::query::plan::LogicalOperator> right_op_;
+  std::vector<Symbol> right_symbols_;
+  EqualOperator *hash_join_condition_{nullptr};
+
+  std::unique_ptr<LogicalOperator> Clone(AstStorage *storage) const override {
+    auto object = std::make_unique<HashJoin>();
+    object->left_op_ = left_op_ ? left_op_->Clone(storage) : nullptr;
+    object->left_symbols_ = left_symbols_;
+    object->right_op_ = right_op_ ? right_op_->Clone(storage) : nullptr;
+    object->right_symbols_ = right_symbols_;
+    object->hash_join_condition_ = hash_join_condition_ ? hash_join_condition_->Clone(storage) : nullptr;
+    return object;
+  }
+};
+
 /// An operator that outputs a table, producing a single row on each pull
 class OutputTable : public memgraph::query::plan::LogicalOperator {
  public:
@@ -2265,6 +2867,45 @@ class LoadCsv : public memgraph::query::plan::LogicalOperator {
   }
 };
 
+/// Reads the rows of a file in the Arrow IPC stream or file format, as maps
+/// from the column names to values of the types of the columns. Only the
+/// columns read by the rest of the query are decoded, and the record batches
+/// are decoded on up to `parallelism` threads of the execution context.
+class LoadArrow : public memgraph::query::plan::LogicalOperator {
+ public:
+  static const utils::TypeInfo kType;
+  const utils::TypeInfo &GetTypeInfo() const override { return kType; }
+
+  LoadArrow() = default;
+  LoadArrow(std::shared_ptr<LogicalOperator> input, Expression *file, Symbol row_var, std::vector<std::string> columns,
+            bool all_columns);
+  bool Accept(HierarchicalLogicalOperatorVisitor &visitor) override;
+  UniqueCursorPtr MakeCursor(utils::MemoryResource *) const override;
+  std::vector<Symbol> OutputSymbols(const SymbolTable &) const override;
+  std::vector<Symbol> ModifiedSymbols(const SymbolTable &) const override;
+
+  bool HasSingleInput() const override { return true; }
+  std::shared_ptr<LogicalOperator> input() const override { return input_; }
+  void set_input(std::shared_ptr<LogicalOperator> input) override { input_ = input; }
+
+  std::shared_ptr<memgraph::query::plan::LogicalOperator> input_;
+  Expression *file_;
+  Symbol row_var_;
+  /// Columns put in the rows, ignored if `all_columns_` is set.
+  std::vector<std::string> columns_;
+  bool all_columns_{true};
+
+  std::unique_ptr<LogicalOperator> Clone(AstStorage *storage) const override {
+    auto object = std::make_unique<LoadArrow>();
+    object->input_ = input_ ? input_->Clone(storage) : nullptr;
+    object->file_ = file_ ? file_->Clone(storage) : nullptr;
+    object->row_var_ = row_var_;
+    object->columns_ = columns_;
+    object->all_columns_ = all_columns_;
+    return object;
+  }
+};
+
 /// Iterates over a collection of elements and applies one or more update
 /// clauses.
 ///
@@ -2320,12 +2961,20 @@ class Apply : public memgraph::query::plan::LogicalOperator {
   std::shared_ptr<memgraph::query::plan::LogicalOperator> input_;
   std::shared_ptr<memgraph::query::plan::LogicalOperator> subquery_;
   bool subquery_has_return_;
+  /// Whether the rows of the subquery are memoized by the values of the
+  /// `correlated_symbols_`, which is the case when the subquery only reads the
+  /// graph in a deterministic way.
+  bool memoize_results_{false};
+  /// Symbols from the outer scope which the subquery imports.
+  std::vector<Symbol> correlated_symbols_;
 
   std::unique_ptr<LogicalOperator> Clone(AstStorage *storage) const override {
     auto object = std::make_unique<Apply>();
     object->input_ = input_ ? input_->Clone(storage) : nullptr;
     object->subquery_ = subquery_ ? subquery_->Clone(storage) : nullptr;
     object->subquery_has_return_ = subquery_has_return_;
+    object->memoize_results_ = memoize_results_;
+    object->correlated_symbols_ = correlated_symbols_;
     return object;
   }
 
@@ -2343,6 +2992,16 @@ class Apply : public memgraph::query::plan::LogicalOperator {
     UniqueCursorPtr subquery_;
     bool pull_input_{true};
     bool subquery_has_return_{true};
+    SubqueryResultCache memoized_results_;
+    // The symbols which the memoized rows of the subquery set.
+    std::vector<Symbol> subquery_symbols_;
+    // The memoized rows which are returned for the current input row.
+    const SubqueryResultCache::Rows *memoized_rows_{nullptr};
+    size_t memoized_row_{0};
+    // The rows of the subquery for the current input row, which are memoized
+    // once the subquery is exhausted.
+    std::optional<SubqueryResultCache::Row> key_;
+    std::optional<SubqueryResultCache::Rows> rows_;
   };
 };
 
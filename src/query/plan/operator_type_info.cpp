@@ -44,12 +44,26 @@ constexpr utils::TypeInfo query::plan::ScanAllByLabelPropertyRange::kType{
 constexpr utils::TypeInfo query::plan::ScanAllByLabelPropertyValue::kType{
     utils::TypeId::SCAN_ALL_BY_LABEL_PROPERTY_VALUE, "ScanAllByLabelPropertyValue", &query::plan::ScanAll::kType};
 
+constexpr utils::TypeInfo query::plan::ScanAllByLabelPropertyValues::kType{
+    utils::TypeId::SCAN_ALL_BY_LABEL_PROPERTY_VALUES, "ScanAllByLabelPropertyValues", &query::plan::ScanAll::kType};
+
 constexpr utils::TypeInfo query::plan::ScanAllByLabelProperty::kType{
     utils::TypeId::SCAN_ALL_BY_LABEL_PROPERTY, "ScanAllByLabelProperty", &query::plan::ScanAll::kType};
 
+constexpr utils::TypeInfo query::plan::ScanAllByLabelPropertyComposite::kType{
+    utils::TypeId::SCAN_ALL_BY_LABEL_PROPERTY_COMPOSITE, "ScanAllByLabelPropertyComposite",
+    &query::plan::ScanAll::kType};
+
 constexpr utils::TypeInfo query::plan::ScanAllById::kType{utils::TypeId::SCAN_ALL_BY_ID, "ScanAllById",
                                                           &query::plan::ScanAll::kType};
 
+constexpr utils::TypeInfo query::plan::ScanAllByEdgeType::kType{utils::TypeId::SCAN_ALL_BY_EDGE_TYPE,
+                                                                "ScanAllByEdgeType",
+                                                                &query::plan::LogicalOperator::kType};
+
+constexpr utils::TypeInfo query::plan::ScanAllByEdgeTypeProperty::kType{
+    utils::TypeId::SCAN_ALL_BY_EDGE_TYPE_PROPERTY, "ScanAllByEdgeTypeProperty", &query::plan::ScanAllByEdgeType::kType};
+
 constexpr utils::TypeInfo query::plan::ExpandCommon::kType{utils::TypeId::EXPAND_COMMON, "ExpandCommon", nullptr};
 
 constexpr utils::TypeInfo query::plan::Expand::kType{utils::TypeId::EXPAND, "Expand",
@@ -61,6 +75,11 @@ constexpr utils::TypeInfo query::plan::ExpansionLambda::kType{utils::TypeId::EXP
 constexpr utils::TypeInfo query::plan::ExpandVariable::kType{utils::TypeId::EXPAND_VARIABLE, "ExpandVariable",
                                                              &query::plan::LogicalOperator::kType};
 
+constexpr utils::TypeInfo query::plan::IntersectEdge::kType{utils::TypeId::INTERSECT_EDGE, "IntersectEdge", nullptr};
+
+constexpr utils::TypeInfo query::plan::IntersectExpand::kType{utils::TypeId::INTERSECT_EXPAND, "IntersectExpand",
+                                                              &query::plan::LogicalOperator::kType};
+
 constexpr utils::TypeInfo query::plan::ConstructNamedPath::kType{
     utils::TypeId::CONSTRUCT_NAMED_PATH, "ConstructNamedPath", &query::plan::LogicalOperator::kType};
 
@@ -122,6 +141,9 @@ constexpr utils::TypeInfo query::plan::Optional::kType{utils::TypeId::OPTIONAL,
 constexpr utils::TypeInfo query::plan::Unwind::kType{utils::TypeId::UNWIND, "Unwind",
                                                      &query::plan::LogicalOperator::kType};
 
+constexpr utils::TypeInfo query::plan::UnwindMerge::kType{utils::TypeId::UNWIND_MERGE, "UnwindMerge",
+                                                          &query::plan::LogicalOperator::kType};
+
 constexpr utils::TypeInfo query::plan::Distinct::kType{utils::TypeId::DISTINCT, "Distinct",
                                                        &query::plan::LogicalOperator::kType};
 
@@ -131,6 +153,9 @@ constexpr utils::TypeInfo query::plan::Union::kType{utils::TypeId::UNION, "Union
 constexpr utils::TypeInfo query::plan::Cartesian::kType{utils::TypeId::CARTESIAN, "Cartesian",
                                                         &query::plan::LogicalOperator::kType};
 
+constexpr utils::TypeInfo query::plan::HashJoin::kType{utils::TypeId::HASH_JOIN, "HashJoin",
+                                                       &query::plan::LogicalOperator::kType};
+
 constexpr utils::TypeInfo query::plan::OutputTable::kType{utils::TypeId::OUTPUT_TABLE, "OutputTable",
                                                           &query::plan::LogicalOperator::kType};
 
@@ -143,9 +168,15 @@ constexpr utils::TypeInfo query::plan::CallProcedure::kType{utils::TypeId::CALL_
 constexpr utils::TypeInfo query::plan::LoadCsv::kType{utils::TypeId::LOAD_CSV, "LoadCsv",
                                                       &query::plan::LogicalOperator::kType};
 
+constexpr utils::TypeInfo query::plan::LoadArrow::kType{utils::TypeId::LOAD_ARROW, "LoadArrow",
+                                                        &query::plan::LogicalOperator::kType};
+
 constexpr utils::TypeInfo query::plan::Foreach::kType{utils::TypeId::FOREACH, "Foreach",
                                                       &query::plan::LogicalOperator::kType};
 
 constexpr utils::TypeInfo query::plan::Apply::kType{utils::TypeId::APPLY, "Apply",
                                                     &query::plan::LogicalOperator::kType};
+
+constexpr utils::TypeInfo query::plan::PeriodicCommit::kType{utils::TypeId::PERIODIC_COMMIT, "PeriodicCommit",
+                                                             &query::plan::LogicalOperator::kType};
 }  // namespace memgraph
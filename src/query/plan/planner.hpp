@@ -21,7 +21,12 @@
 #include "query/plan/operator.hpp"
 #include "query/plan/preprocess.hpp"
 #include "query/plan/pretty_print.hpp"
+#include "query/plan/rewrite/constant_folding.hpp"
 #include "query/plan/rewrite/index_lookup.hpp"
+#include "query/plan/rewrite/join.hpp"
+#include "query/plan/rewrite/periodic_commit.hpp"
+#include "query/plan/rewrite/set_properties.hpp"
+#include "query/plan/rewrite/unwind_merge.hpp"
 #include "query/plan/rule_based_planner.hpp"
 #include "query/plan/variable_start_planner.hpp"
 #include "query/plan/vertex_count_cache.hpp"
@@ -35,21 +40,33 @@ namespace plan {
 
 class PostProcessor final {
   Parameters parameters_;
+  CardinalityCorrections corrections_;
 
  public:
   using ProcessedPlan = std::unique_ptr<LogicalOperator>;
 
-  explicit PostProcessor(const Parameters &parameters) : parameters_(parameters) {}
+  explicit PostProcessor(const Parameters &parameters, CardinalityCorrections corrections = {})
+      : parameters_(parameters), corrections_(corrections) {}
 
   template <class TPlanningContext>
   std::unique_ptr<LogicalOperator> Rewrite(std::unique_ptr<LogicalOperator> plan, TPlanningContext *context) {
-    return RewriteWithIndexLookup(std::move(plan), context->symbol_table, context->ast_storage, context->db);
+    auto index_lookup_plan =
+        RewriteWithIndexLookup(std::move(plan), context->symbol_table, context->ast_storage, context->db);
+    auto join_plan = RewriteWithJoinRewriter(std::move(index_lookup_plan), context->symbol_table,
+                                             context->ast_storage, context->db, parameters_);
+    auto set_properties_plan =
+        RewriteWithSetProperties(std::move(join_plan), *context->symbol_table, context->ast_storage);
+    auto unwind_merge_plan = RewriteWithUnwindMerge(std::move(set_properties_plan), *context->symbol_table);
+    auto periodic_commit_plan =
+        RewriteWithPeriodicCommit(std::move(unwind_merge_plan), context->query->commit_frequency_);
+    if (!impl::IsReadOnly(*periodic_commit_plan)) DisableSubqueryMemoization(*periodic_commit_plan);
+    return periodic_commit_plan;
   }
 
   template <class TVertexCounts>
   double EstimatePlanCost(const std::unique_ptr<LogicalOperator> &plan, TVertexCounts *vertex_counts,
                           const SymbolTable &table) {
-    return query::plan::EstimatePlanCost(vertex_counts, table, parameters_, *plan);
+    return query::plan::EstimatePlanCost(vertex_counts, table, parameters_, *plan, corrections_);
   }
 };
 
@@ -84,6 +101,8 @@ auto MakeLogicalPlanForSingleQuery(QueryParts query_parts, PlanningContext<TDbAc
 /// the estimated cost of that plan as a `double`.
 template <class TPlanningContext, class TPlanPostProcess>
 auto MakeLogicalPlan(TPlanningContext *context, TPlanPostProcess *post_process, bool use_variable_planner) {
+  // The constant function calls are the same in all the plans of the query.
+  RewriteWithConstantFolding(context->query);
   auto query_parts = CollectQueryParts(*context->symbol_table, *context->ast_storage, context->query);
   auto &vertex_counts = *context->db;
   double total_cost = std::numeric_limits<double>::max();
@@ -116,9 +135,12 @@ auto MakeLogicalPlan(TPlanningContext *context, TPlanPostProcess *post_process,
   return std::make_pair(std::move(plan_with_least_cost), total_cost);
 }
 
+/// Generates the LogicalOperator tree, estimating the costs of the plans with
+/// the cardinality corrections, if any.
 template <class TPlanningContext>
-auto MakeLogicalPlan(TPlanningContext *context, const Parameters &parameters, bool use_variable_planner) {
-  PostProcessor post_processor(parameters);
+auto MakeLogicalPlan(TPlanningContext *context, const Parameters &parameters, bool use_variable_planner,
+                     const CardinalityCorrections &corrections = {}) {
+  PostProcessor post_processor(parameters, corrections);
   return MakeLogicalPlan(context, &post_processor, use_variable_planner);
 }
 
@@ -67,6 +67,15 @@ bool PlanPrinter::PreVisit(query::plan::ScanAllByLabelPropertyValue &op) {
   return true;
 }
 
+bool PlanPrinter::PreVisit(query::plan::ScanAllByLabelPropertyValues &op) {
+  WithPrintLn([&](auto &out) {
+    out << "* ScanAllByLabelPropertyValues"
+        << " (" << op.output_symbol_.name() << " :" << dba_->LabelToName(op.label_) << " {"
+        << dba_->PropertyToName(op.property_) << "})";
+  });
+  return true;
+}
+
 bool PlanPrinter::PreVisit(query::plan::ScanAllByLabelPropertyRange &op) {
   WithPrintLn([&](auto &out) {
     out << "* ScanAllByLabelPropertyRange"
@@ -85,6 +94,17 @@ bool PlanPrinter::PreVisit(query::plan::ScanAllByLabelProperty &op) {
   return true;
 }
 
+bool PlanPrinter::PreVisit(query::plan::ScanAllByLabelPropertyComposite &op) {
+  WithPrintLn([&](auto &out) {
+    out << "* ScanAllByLabelPropertyComposite"
+        << " (" << op.output_symbol_.name() << " :" << dba_->LabelToName(op.label_) << " {";
+    utils::PrintIterable(out, op.properties_, ", ",
+                         [&](auto &stream, const auto &property) { stream << dba_->PropertyToName(property); });
+    out << "})";
+  });
+  return true;
+}
+
 bool PlanPrinter::PreVisit(ScanAllById &op) {
   WithPrintLn([&](auto &out) {
     out << "* ScanAllById"
@@ -93,6 +113,25 @@ bool PlanPrinter::PreVisit(ScanAllById &op) {
   return true;
 }
 
+bool PlanPrinter::PreVisit(ScanAllByEdgeType &op) {
+  WithPrintLn([&](auto &out) {
+    out << "* ScanAllByEdgeType"
+        << " (" << op.from_symbol_.name() << ")-[" << op.edge_symbol_.name() << ":"
+        << dba_->EdgeTypeToName(op.edge_type_) << "]->(" << op.to_symbol_.name() << ")";
+  });
+  return true;
+}
+
+bool PlanPrinter::PreVisit(ScanAllByEdgeTypeProperty &op) {
+  WithPrintLn([&](auto &out) {
+    out << "* ScanAllByEdgeTypeProperty"
+        << " (" << op.from_symbol_.name() << ")-[" << op.edge_symbol_.name() << ":"
+        << dba_->EdgeTypeToName(op.edge_type_) << " {" << dba_->PropertyToName(op.property_) << "}]->("
+        << op.to_symbol_.name() << ")";
+  });
+  return true;
+}
+
 bool PlanPrinter::PreVisit(query::plan::Expand &op) {
   WithPrintLn([&](auto &out) {
     *out_ << "* Expand (" << op.input_symbol_.name() << ")"
@@ -107,6 +146,22 @@ bool PlanPrinter::PreVisit(query::plan::Expand &op) {
   return true;
 }
 
+bool PlanPrinter::PreVisit(query::plan::IntersectExpand &op) {
+  WithPrintLn([&](auto &out) {
+    *out_ << "* IntersectExpand (" << op.node_symbol_.name() << ")";
+    for (const auto &edge : op.edges_) {
+      *out_ << " " << (edge.direction == query::EdgeAtom::Direction::OUT ? "<-" : "-") << "["
+            << edge.edge_symbol.name();
+      utils::PrintIterable(*out_, edge.edge_types, "|", [this](auto &stream, const auto &edge_type) {
+        stream << ":" << dba_->EdgeTypeToName(edge_type);
+      });
+      *out_ << "]" << (edge.direction == query::EdgeAtom::Direction::IN ? "->" : "-") << "("
+            << edge.input_symbol.name() << ")";
+    }
+  });
+  return true;
+}
+
 bool PlanPrinter::PreVisit(query::plan::ExpandVariable &op) {
   using Type = query::EdgeAtom::Type;
   WithPrintLn([&](auto &out) {
@@ -157,6 +212,7 @@ PRE_VISIT(RemoveLabels);
 PRE_VISIT(EdgeUniquenessFilter);
 PRE_VISIT(Accumulate);
 PRE_VISIT(EmptyResult);
+PRE_VISIT(PeriodicCommit);
 PRE_VISIT(EvaluatePatternFilter);
 
 bool PlanPrinter::PreVisit(query::plan::Aggregate &op) {
@@ -199,6 +255,16 @@ bool PlanPrinter::PreVisit(query::plan::Optional &op) {
 }
 
 PRE_VISIT(Unwind);
+
+bool PlanPrinter::PreVisit(query::plan::UnwindMerge &op) {
+  WithPrintLn([&](auto &out) {
+    out << "* UnwindMerge"
+        << " (" << op.node_symbol_.name() << " :" << dba_->LabelToName(op.label_) << " {"
+        << dba_->PropertyToName(op.property_) << "})";
+  });
+  return true;
+}
+
 PRE_VISIT(Distinct);
 
 bool PlanPrinter::PreVisit(query::plan::Union &op) {
@@ -228,6 +294,11 @@ bool PlanPrinter::PreVisit(query::plan::LoadCsv &op) {
   return true;
 }
 
+bool PlanPrinter::PreVisit(query::plan::LoadArrow &op) {
+  WithPrintLn([&op](auto &out) { out << "* LoadArrow {" << op.row_var_.name() << "}"; });
+  return true;
+}
+
 bool PlanPrinter::Visit(query::plan::Once & /*op*/) {
   WithPrintLn([](auto &out) { out << "* Once"; });
   return true;
@@ -246,6 +317,19 @@ bool PlanPrinter::PreVisit(query::plan::Cartesian &op) {
   return false;
 }
 
+bool PlanPrinter::PreVisit(query::plan::HashJoin &op) {
+  WithPrintLn([&op](auto &out) {
+    out << "* HashJoin {";
+    utils::PrintIterable(out, op.left_symbols_, ", ", [](auto &out, const auto &sym) { out << sym.name(); });
+    out << " : ";
+    utils::PrintIterable(out, op.right_symbols_, ", ", [](auto &out, const auto &sym) { out << sym.name(); });
+    out << "}";
+  });
+  Branch(*op.right_op_);
+  op.left_op_->Accept(*this);
+  return false;
+}
+
 bool PlanPrinter::PreVisit(query::plan::Foreach &op) {
   WithPrintLn([](auto &out) { out << "* Foreach"; });
   Branch(*op.update_clauses_);
@@ -489,6 +573,21 @@ bool PlanToJsonVisitor::PreVisit(ScanAllByLabelPropertyValue &op) {
   return false;
 }
 
+bool PlanToJsonVisitor::PreVisit(ScanAllByLabelPropertyValues &op) {
+  json self;
+  self["name"] = "ScanAllByLabelPropertyValues";
+  self["label"] = ToJson(op.label_, *dba_);
+  self["property"] = ToJson(op.property_, *dba_);
+  self["expression"] = ToJson(op.expression_);
+  self["output_symbol"] = ToJson(op.output_symbol_);
+
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(ScanAllByLabelProperty &op) {
   json self;
   self["name"] = "ScanAllByLabelProperty";
@@ -503,6 +602,23 @@ bool PlanToJsonVisitor::PreVisit(ScanAllByLabelProperty &op) {
   return false;
 }
 
+bool PlanToJsonVisitor::PreVisit(ScanAllByLabelPropertyComposite &op) {
+  json self;
+  self["name"] = "ScanAllByLabelPropertyComposite";
+  self["label"] = ToJson(op.label_, *dba_);
+  self["properties"] = ToJson(op.properties_, *dba_);
+  self["prefix"] = ToJson(op.prefix_);
+  self["lower_bound"] = op.lower_bound_ ? ToJson(*op.lower_bound_) : json();
+  self["upper_bound"] = op.upper_bound_ ? ToJson(*op.upper_bound_) : json();
+  self["output_symbol"] = ToJson(op.output_symbol_);
+
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(ScanAllById &op) {
   json self;
   self["name"] = "ScanAllById";
@@ -513,6 +629,36 @@ bool PlanToJsonVisitor::PreVisit(ScanAllById &op) {
   return false;
 }
 
+bool PlanToJsonVisitor::PreVisit(ScanAllByEdgeType &op) {
+  json self;
+  self["name"] = "ScanAllByEdgeType";
+  self["edge_type"] = ToJson(op.edge_type_, *dba_);
+  self["edge_symbol"] = ToJson(op.edge_symbol_);
+  self["from_symbol"] = ToJson(op.from_symbol_);
+  self["to_symbol"] = ToJson(op.to_symbol_);
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+  output_ = std::move(self);
+  return false;
+}
+
+bool PlanToJsonVisitor::PreVisit(ScanAllByEdgeTypeProperty &op) {
+  json self;
+  self["name"] = "ScanAllByEdgeTypeProperty";
+  self["edge_type"] = ToJson(op.edge_type_, *dba_);
+  self["property"] = ToJson(op.property_, *dba_);
+  self["expression"] = op.expression_ ? ToJson(op.expression_) : json();
+  self["lower_bound"] = op.lower_bound_ ? ToJson(*op.lower_bound_) : json();
+  self["upper_bound"] = op.upper_bound_ ? ToJson(*op.upper_bound_) : json();
+  self["edge_symbol"] = ToJson(op.edge_symbol_);
+  self["from_symbol"] = ToJson(op.from_symbol_);
+  self["to_symbol"] = ToJson(op.to_symbol_);
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(CreateNode &op) {
   json self;
   self["name"] = "CreateNode";
@@ -557,6 +703,28 @@ bool PlanToJsonVisitor::PreVisit(Expand &op) {
   return false;
 }
 
+bool PlanToJsonVisitor::PreVisit(IntersectExpand &op) {
+  json self;
+  self["name"] = "IntersectExpand";
+  self["node_symbol"] = ToJson(op.node_symbol_);
+  json edges = json::array();
+  for (const auto &edge : op.edges_) {
+    json item;
+    item["input_symbol"] = ToJson(edge.input_symbol);
+    item["edge_symbol"] = ToJson(edge.edge_symbol);
+    item["edge_types"] = ToJson(edge.edge_types, *dba_);
+    item["direction"] = ToString(edge.direction);
+    edges.push_back(std::move(item));
+  }
+  self["edges"] = std::move(edges);
+
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(ExpandVariable &op) {
   json self;
   self["name"] = "ExpandVariable";
@@ -577,6 +745,9 @@ bool PlanToJsonVisitor::PreVisit(ExpandVariable &op) {
     self["weight_lambda"] = ToJson(op.weight_lambda_->expression);
     self["total_weight_symbol"] = ToJson(*op.total_weight_);
   }
+  if (op.path_count_symbol_) {
+    self["path_count_symbol"] = ToJson(*op.path_count_symbol_);
+  }
 
   op.input_->Accept(*this);
   self["input"] = PopOutput();
@@ -741,6 +912,18 @@ bool PlanToJsonVisitor::PreVisit(EmptyResult &op) {
   return false;
 }
 
+bool PlanToJsonVisitor::PreVisit(PeriodicCommit &op) {
+  json self;
+  self["name"] = "PeriodicCommit";
+  self["commit_frequency"] = ToJson(op.commit_frequency_);
+
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(Accumulate &op) {
   json self;
   self["name"] = "Accumulate";
@@ -856,6 +1039,24 @@ bool PlanToJsonVisitor::PreVisit(Unwind &op) {
   return false;
 }
 
+bool PlanToJsonVisitor::PreVisit(UnwindMerge &op) {
+  json self;
+  self["name"] = "UnwindMerge";
+  self["input_expression"] = op.input_expression_ ? ToJson(op.input_expression_) : json();
+  self["row_symbol"] = ToJson(op.row_symbol_);
+  self["node_symbol"] = ToJson(op.node_symbol_);
+  self["label"] = ToJson(op.label_, *dba_);
+  self["property"] = ToJson(op.property_, *dba_);
+  self["key"] = ToJson(op.key_);
+  self["properties"] = op.properties_ ? ToJson(op.properties_) : json();
+
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(query::plan::CallProcedure &op) {
   json self;
   self["name"] = "CallProcedure";
@@ -908,6 +1109,22 @@ bool PlanToJsonVisitor::PreVisit(query::plan::LoadCsv &op) {
   return false;
 }
 
+bool PlanToJsonVisitor::PreVisit(query::plan::LoadArrow &op) {
+  json self;
+  self["name"] = "LoadArrow";
+  self["file"] = ToJson(op.file_);
+  if (!op.all_columns_) {
+    self["columns"] = op.columns_;
+  }
+  self["row_variable"] = ToJson(op.row_var_);
+
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(Distinct &op) {
   json self;
   self["name"] = "Distinct";
@@ -953,6 +1170,23 @@ bool PlanToJsonVisitor::PreVisit(Cartesian &op) {
   return false;
 }
 
+bool PlanToJsonVisitor::PreVisit(HashJoin &op) {
+  json self;
+  self["name"] = "HashJoin";
+  self["left_symbols"] = ToJson(op.left_symbols_);
+  self["right_symbols"] = ToJson(op.right_symbols_);
+  self["hash_join_condition"] = ToJson(op.hash_join_condition_);
+
+  op.left_op_->Accept(*this);
+  self["left_op"] = PopOutput();
+
+  op.right_op_->Accept(*this);
+  self["right_op"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(Foreach &op) {
   json self;
   self["name"] = "Foreach";
@@ -13,6 +13,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <iterator>
 
 #include <fmt/format.h>
 #include <json/json.hpp>
@@ -42,6 +43,23 @@ double AbsoluteTime(unsigned long long num_cycles, unsigned long long total_cycl
 
 }  // namespace
 
+void MergeParallelProfilingStats(const ProfilingStats &thread_stats, uint64_t num_threads, ProfilingStats *root) {
+  auto it = std::find_if(root->children.begin(), root->children.end(),
+                         [key = thread_stats.key](const auto &stats) { return stats.key == key; });
+  if (it == root->children.end()) {
+    auto &stats = root->children.emplace_back();
+    stats.key = thread_stats.key;
+    stats.name = thread_stats.name;
+    it = std::prev(root->children.end());
+  }
+  it->actual_hits += thread_stats.actual_hits;
+  it->num_cycles += thread_stats.num_cycles / num_threads;
+  it->num_threads = num_threads;
+  for (const auto &child : thread_stats.children) {
+    MergeParallelProfilingStats(child, num_threads, &*it);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //
 // ProfilingStatsToTable
@@ -57,7 +75,7 @@ class ProfilingStatsToTableHelper {
     auto cycles = IndividualCycles(cumulative_stats);
 
     rows_.emplace_back(std::vector<TypedValue>{
-        TypedValue(FormatOperator(cumulative_stats.name)), TypedValue(cumulative_stats.actual_hits),
+        TypedValue(FormatOperator(cumulative_stats)), TypedValue(cumulative_stats.actual_hits),
         TypedValue(FormatRelativeTime(cycles)), TypedValue(FormatAbsoluteTime(cycles))});
 
     for (size_t i = 1; i < cumulative_stats.children.size(); ++i) {
@@ -91,7 +109,10 @@ class ProfilingStatsToTableHelper {
 
   std::string Format(const std::string &str) { return Format(str.c_str()); }
 
-  std::string FormatOperator(const char *str) { return Format(std::string("* ") + str); }
+  std::string FormatOperator(const ProfilingStats &stats) {
+    if (stats.num_threads > 1) return Format(fmt::format("* {} ({} threads)", stats.name, stats.num_threads));
+    return Format(std::string("* ") + stats.name);
+  }
 
   std::string FormatRelativeTime(unsigned long long num_cycles) {
     return fmt::format("{: 10.6f} %", RelativeTime(num_cycles, total_cycles_) * 100);
@@ -139,6 +160,7 @@ class ProfilingStatsToJsonHelper {
 
     obj->emplace("name", cumulative_stats.name);
     obj->emplace("actual_hits", cumulative_stats.actual_hits);
+    if (cumulative_stats.num_threads > 1) obj->emplace("threads", cumulative_stats.num_threads);
     obj->emplace("relative_time", RelativeTime(cycles, total_cycles_));
     obj->emplace("absolute_time", AbsoluteTime(cycles, total_cycles_, total_time_));
     obj->emplace("children", json::array());
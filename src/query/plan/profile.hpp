@@ -30,6 +30,8 @@ struct ProfilingStats {
   unsigned long long num_cycles{0};
   uint64_t key{0};
   const char *name{nullptr};
+  // number of threads that executed the operator in parallel
+  uint64_t num_threads{1};
   // TODO: This should use the allocator for query execution
   std::vector<ProfilingStats> children;
 };
@@ -39,6 +41,14 @@ struct ProfilingStatsWithTotalTime {
   std::chrono::duration<double> total_time{};
 };
 
+/**
+ * Merges the statistics collected by one of the `num_threads` threads that
+ * executed a part of the plan in parallel into the children of `root`. Hits are
+ * summed, while the cycles are averaged over the threads so that the relative
+ * times of the operators stay comparable to the sequential ones.
+ */
+void MergeParallelProfilingStats(const ProfilingStats &thread_stats, uint64_t num_threads, ProfilingStats *root);
+
 std::vector<std::vector<TypedValue>> ProfilingStatsToTable(const ProfilingStatsWithTotalTime &stats);
 
 nlohmann::json ProfilingStatsToJson(const ProfilingStatsWithTotalTime &stats);
@@ -35,11 +35,16 @@ PRE_VISIT(ScanAll, RWType::R, true)
 PRE_VISIT(ScanAllByLabel, RWType::R, true)
 PRE_VISIT(ScanAllByLabelPropertyRange, RWType::R, true)
 PRE_VISIT(ScanAllByLabelPropertyValue, RWType::R, true)
+PRE_VISIT(ScanAllByLabelPropertyValues, RWType::R, true)
+PRE_VISIT(ScanAllByLabelPropertyComposite, RWType::R, true)
 PRE_VISIT(ScanAllByLabelProperty, RWType::R, true)
 PRE_VISIT(ScanAllById, RWType::R, true)
+PRE_VISIT(ScanAllByEdgeType, RWType::R, true)
+PRE_VISIT(ScanAllByEdgeTypeProperty, RWType::R, true)
 
 PRE_VISIT(Expand, RWType::R, true)
 PRE_VISIT(ExpandVariable, RWType::R, true)
+PRE_VISIT(IntersectExpand, RWType::R, true)
 
 PRE_VISIT(ConstructNamedPath, RWType::R, true)
 
@@ -55,7 +60,14 @@ bool ReadWriteTypeChecker::PreVisit(Cartesian &op) {
   return false;
 }
 
+bool ReadWriteTypeChecker::PreVisit(HashJoin &op) {
+  op.left_op_->Accept(*this);
+  op.right_op_->Accept(*this);
+  return false;
+}
+
 PRE_VISIT(EmptyResult, RWType::NONE, true)
+PRE_VISIT(PeriodicCommit, RWType::NONE, true)
 PRE_VISIT(Produce, RWType::NONE, true)
 PRE_VISIT(Accumulate, RWType::NONE, true)
 PRE_VISIT(Aggregate, RWType::NONE, true)
@@ -71,6 +83,7 @@ bool ReadWriteTypeChecker::PreVisit(Union &op) {
 }
 
 PRE_VISIT(Unwind, RWType::NONE, true)
+PRE_VISIT(UnwindMerge, RWType::RW, true)
 
 bool ReadWriteTypeChecker::PreVisit(CallProcedure &op) {
   if (op.is_write_) {
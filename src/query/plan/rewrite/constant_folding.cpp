@@ -0,0 +1,132 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/plan/rewrite/constant_folding.hpp"
+
+#include <array>
+#include <string>
+
+#include "query/context.hpp"
+#include "query/frontend/ast/ast_visitor.hpp"
+#include "query/frontend/semantic/symbol_table.hpp"
+#include "query/interpret/eval.hpp"
+#include "query/interpret/frame.hpp"
+#include "utils/algorithm.hpp"
+#include "utils/exceptions.hpp"
+
+namespace memgraph::query::plan {
+
+namespace {
+
+// Functions whose results differ between the calls with the same arguments.
+// The ones depending on the time, like `timestamp()`, use the time at which
+// the execution started.
+constexpr std::array kNonDeterministicFunctions{"RAND", "RANDOMUUID", "COUNTER", "UNIFORMSAMPLE"};
+// Functions which can use the time at which the execution started.
+constexpr std::array kTimeDependentFunctions{"TIMESTAMP", "DATE", "LOCALTIME", "LOCALDATETIME"};
+
+class ConstantExpressionChecker : public HierarchicalTreeVisitor {
+ public:
+  using HierarchicalTreeVisitor::PostVisit;
+  using HierarchicalTreeVisitor::PreVisit;
+  using HierarchicalTreeVisitor::Visit;
+
+  bool PreVisit(Function &function) override {
+    if (!IsDeterministicFunction(function)) constant_ = false;
+    return constant_;
+  }
+
+  bool PreVisit(Aggregation & /*aggregation*/) override {
+    constant_ = false;
+    return false;
+  }
+
+  bool PreVisit(Exists & /*exists*/) override {
+    constant_ = false;
+    return false;
+  }
+
+  bool PreVisit(MapProjectionLiteral & /*literal*/) override {
+    constant_ = false;
+    return false;
+  }
+
+  // Even the variables declared by the expression itself, like the ones of
+  // list comprehensions, take different values.
+  bool Visit(Identifier & /*identifier*/) override {
+    constant_ = false;
+    return false;
+  }
+
+  bool Visit(PrimitiveLiteral & /*literal*/) override { return true; }
+  bool Visit(ParameterLookup & /*parameter_lookup*/) override { return true; }
+
+  bool constant_{true};
+};
+
+class ConstantFunctionMarker : public HierarchicalTreeVisitor {
+ public:
+  using HierarchicalTreeVisitor::PostVisit;
+  using HierarchicalTreeVisitor::PreVisit;
+  using HierarchicalTreeVisitor::Visit;
+
+  bool PreVisit(Function &function) override {
+    function.is_constant_ = IsConstantExpression(function);
+    return true;
+  }
+
+  bool Visit(Identifier & /*identifier*/) override { return true; }
+  bool Visit(PrimitiveLiteral & /*literal*/) override { return true; }
+  bool Visit(ParameterLookup & /*parameter_lookup*/) override { return true; }
+};
+
+}  // namespace
+
+bool IsDeterministicFunction(const Function &function, const bool across_executions) {
+  // The functions of the query modules can do anything.
+  return function.function_name_.find('.') == std::string::npos &&
+         !utils::Contains(kNonDeterministicFunctions, function.function_name_) &&
+         !(across_executions && utils::Contains(kTimeDependentFunctions, function.function_name_));
+}
+
+bool IsConstantExpression(Expression &expression) {
+  ConstantExpressionChecker checker;
+  expression.Accept(checker);
+  return checker.constant_;
+}
+
+std::optional<storage::PropertyValue> EvaluateConstantExpression(const Expression &expression,
+                                                                 const Parameters &parameters) {
+  // The evaluation doesn't change the expression.
+  auto &constant = const_cast<Expression &>(expression);
+  if (!IsConstantExpression(constant)) return std::nullopt;
+
+  Frame frame(0);
+  SymbolTable symbol_table;
+  EvaluationContext context;
+  context.timestamp = QueryTimestamp();
+  context.parameters = parameters;
+  // None of the deterministic functions of the constants read the graph.
+  ExpressionEvaluator evaluator(&frame, symbol_table, context, nullptr, storage::View::OLD);
+  try {
+    return storage::PropertyValue(constant.Accept(evaluator));
+  } catch (const utils::BasicException &) {
+    return std::nullopt;
+  }
+}
+
+void RewriteWithConstantFolding(CypherQuery *query) {
+  if (!query) return;
+  ConstantFunctionMarker marker;
+  query->Accept(marker);
+}
+
+}  // namespace memgraph::query::plan
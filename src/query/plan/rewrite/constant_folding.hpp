@@ -0,0 +1,51 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// This file provides a rewriter which finds the function calls whose values
+/// don't change during an execution, because they are deterministic and their
+/// arguments are made of literals and parameters. Such calls are evaluated
+/// once per execution instead of for every row. The plans are cached for the
+/// queries which differ only in the values of their literals, so the calls
+/// aren't replaced by their values, which differ between the executions. The
+/// public entrypoint is `RewriteWithConstantFolding`.
+
+#pragma once
+
+#include <optional>
+
+#include "query/frontend/ast/ast.hpp"
+#include "query/parameters.hpp"
+#include "storage/v2/property_value.hpp"
+
+namespace memgraph::query::plan {
+
+/// Returns true if the function returns the same value whenever it's called
+/// with the same arguments during an execution, or across the executions if
+/// `across_executions` is set.
+bool IsDeterministicFunction(const Function &function, bool across_executions = false);
+
+/// Returns true if the expression doesn't depend on the rows, i.e. it's made
+/// of literals, parameters and deterministic functions of them.
+bool IsConstantExpression(Expression &expression);
+
+/// Evaluates the constant expression with the parameters the query is planned
+/// for. Returns std::nullopt if the expression isn't constant, if it fails to
+/// evaluate or if its value isn't a property value.
+std::optional<storage::PropertyValue> EvaluateConstantExpression(const Expression &expression,
+                                                                 const Parameters &parameters);
+
+/// Marks the function calls of the query which are constant expressions, see
+/// `Function::is_constant_`. The calls nested in another constant call are
+/// marked too, since they can also be evaluated on their own.
+void RewriteWithConstantFolding(CypherQuery *query);
+
+}  // namespace memgraph::query::plan
@@ -21,6 +21,7 @@
 #include <optional>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <gflags/gflags.h>
@@ -97,6 +98,11 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     if (expand.common_.existing_node) {
       return true;
     }
+    auto edge_scan = GenScanByEdgeIndex(expand);
+    if (edge_scan) {
+      SetOnParent(std::move(edge_scan));
+      return true;
+    }
     ScanAll dst_scan(expand.input(), expand.common_.node_symbol, expand.view_);
     auto indexed_scan = GenScanByIndex(dst_scan, FLAGS_query_vertex_count_to_expand_existing);
     if (indexed_scan) {
@@ -106,6 +112,16 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PreVisit(IntersectExpand &op) override {
+    prev_ops_.push_back(&op);
+    return true;
+  }
+
+  bool PostVisit(IntersectExpand &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
   bool PreVisit(ExpandVariable &op) override {
     prev_ops_.push_back(&op);
     return true;
@@ -203,6 +219,18 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PreVisit(HashJoin &op) override {
+    prev_ops_.push_back(&op);
+    RewriteBranch(&op.left_op_);
+    RewriteBranch(&op.right_op_);
+    return false;
+  }
+
+  bool PostVisit(HashJoin &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
   bool PreVisit(Union &op) override {
     prev_ops_.push_back(&op);
     RewriteBranch(&op.left_op_);
@@ -262,6 +290,15 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PreVisit(ScanAllByLabelPropertyValues &op) override {
+    prev_ops_.push_back(&op);
+    return true;
+  }
+  bool PostVisit(ScanAllByLabelPropertyValues &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
   bool PreVisit(ScanAllByLabelProperty &op) override {
     prev_ops_.push_back(&op);
     return true;
@@ -271,6 +308,15 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PreVisit(ScanAllByLabelPropertyComposite &op) override {
+    prev_ops_.push_back(&op);
+    return true;
+  }
+  bool PostVisit(ScanAllByLabelPropertyComposite &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
   bool PreVisit(ScanAllById &op) override {
     prev_ops_.push_back(&op);
     return true;
@@ -280,6 +326,24 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PreVisit(ScanAllByEdgeType &op) override {
+    prev_ops_.push_back(&op);
+    return true;
+  }
+  bool PostVisit(ScanAllByEdgeType &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
+  bool PreVisit(ScanAllByEdgeTypeProperty &op) override {
+    prev_ops_.push_back(&op);
+    return true;
+  }
+  bool PostVisit(ScanAllByEdgeTypeProperty &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
   bool PreVisit(ConstructNamedPath &op) override {
     prev_ops_.push_back(&op);
     return true;
@@ -486,6 +550,16 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PreVisit(LoadArrow &op) override {
+    prev_ops_.push_back(&op);
+    return true;
+  }
+
+  bool PostVisit(LoadArrow & /*op*/) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
   std::shared_ptr<LogicalOperator> new_root_;
 
  private:
@@ -507,6 +581,18 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     std::optional<storage::LabelPropertyIndexStats> index_stats;
   };
 
+  struct LabelPropertyCompositeIndex {
+    LabelIx label;
+    std::vector<storage::PropertyId> properties;
+    // FilterInfo with equality PropertyFilter for each of the leading properties.
+    std::vector<FilterInfo> prefix_filters;
+    // FilterInfo with range PropertyFilter for the property following the prefix.
+    std::optional<FilterInfo> range_filter;
+    int64_t vertex_count;
+
+    size_t UsedProperties() const { return prefix_filters.size() + (range_filter ? 1 : 0); }
+  };
+
   bool DefaultPreVisit() override { throw utils::NotYetImplemented("optimizing index lookup"); }
 
   void SetOnParent(const std::shared_ptr<LogicalOperator> &input) {
@@ -633,9 +719,113 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     }
     return found;
   }
+  // Finds the composite index which can be used for the most filtered
+  // properties. A composite index is usable only when the filters cover at
+  // least two of its leading properties, with all but the last of them being
+  // equality filters. On equal number of used properties, the index with less
+  // vertices is better. If the index cannot be found, nullopt is returned.
+  std::optional<LabelPropertyCompositeIndex> FindBestLabelPropertyCompositeIndex(
+      const Symbol &symbol, const std::unordered_set<Symbol> &bound_symbols) {
+    auto are_bound = [&bound_symbols](const auto &used_symbols) {
+      for (const auto &used_symbol : used_symbols) {
+        if (!utils::Contains(bound_symbols, used_symbol)) {
+          return false;
+        }
+      }
+      return true;
+    };
+    auto find_filter = [&](storage::PropertyId property, PropertyFilter::Type type) -> std::optional<FilterInfo> {
+      for (const auto &filter : filters_.PropertyFilters(symbol)) {
+        if (filter.property_filter->is_symbol_in_value_ || !are_bound(filter.used_symbols)) continue;
+        if (filter.property_filter->type_ != type || GetProperty(filter.property_filter->property_) != property) {
+          continue;
+        }
+        return filter;
+      }
+      return std::nullopt;
+    };
+
+    std::optional<LabelPropertyCompositeIndex> found;
+    for (const auto &label : filters_.FilteredLabels(symbol)) {
+      for (const auto &properties : db_->LabelPropertyCompositeIndices(GetLabel(label))) {
+        LabelPropertyCompositeIndex candidate{label, properties, {}, std::nullopt, 0};
+        for (const auto &property : properties) {
+          if (auto filter = find_filter(property, PropertyFilter::Type::EQUAL)) {
+            candidate.prefix_filters.push_back(std::move(*filter));
+            continue;
+          }
+          candidate.range_filter = find_filter(property, PropertyFilter::Type::RANGE);
+          break;
+        }
+        if (candidate.prefix_filters.empty() || candidate.UsedProperties() < 2) continue;
+        candidate.vertex_count = db_->VerticesCount(GetLabel(label), properties);
+        if (!found || candidate.UsedProperties() > found->UsedProperties() ||
+            (candidate.UsedProperties() == found->UsedProperties() && candidate.vertex_count < found->vertex_count)) {
+          found = std::move(candidate);
+        }
+      }
+    }
+    return found;
+  }
+
   // Creates a ScanAll by the best possible index for the `node_symbol`. If the node
   // does not have at least a label, no indexed lookup can be created and
   // `nullptr` is returned. The operator is chained after `input`. Optional
+  // Replaces a plain `ScanAll` of the source vertex followed by an `Expand` of
+  // a single edge type with a scan of the edge type (or edge type+property)
+  // index, which binds the edge and both of its endpoints at once. Returns
+  // `nullptr` if the expansion doesn't have that shape or no index exists.
+  std::unique_ptr<ScanAllByEdgeType> GenScanByEdgeIndex(const Expand &expand) {
+    const auto &common = expand.common_;
+    if (common.edge_types.size() != 1U || common.direction == EdgeAtom::Direction::BOTH) return nullptr;
+    const auto &input = expand.input();
+    if (input->GetTypeInfo() != ScanAll::kType) return nullptr;
+    const auto &scan = static_cast<const ScanAll &>(*input);
+    if (scan.output_symbol_ != expand.input_symbol_) return nullptr;
+    const auto edge_type = common.edge_types.front();
+    const auto &edge_symbol = common.edge_symbol;
+    const auto &from_symbol = common.direction == EdgeAtom::Direction::OUT ? expand.input_symbol_ : common.node_symbol;
+    const auto &to_symbol = common.direction == EdgeAtom::Direction::OUT ? common.node_symbol : expand.input_symbol_;
+
+    // Values of the property filter may only use symbols bound before the
+    // source vertex scan.
+    const auto &modified_symbols = scan.input()->ModifiedSymbols(*symbol_table_);
+    std::unordered_set<Symbol> bound_symbols(modified_symbols.begin(), modified_symbols.end());
+    bound_symbols.insert(edge_symbol);
+    std::optional<FilterInfo> best_filter;
+    int64_t best_count = 0;
+    for (const auto &filter : filters_.PropertyFilters(edge_symbol)) {
+      const auto &prop_filter = *filter.property_filter;
+      if (prop_filter.is_symbol_in_value_) continue;
+      if (prop_filter.type_ != PropertyFilter::Type::EQUAL && prop_filter.type_ != PropertyFilter::Type::RANGE) {
+        continue;
+      }
+      if (!std::all_of(filter.used_symbols.begin(), filter.used_symbols.end(),
+                       [&bound_symbols](const auto &symbol) { return utils::Contains(bound_symbols, symbol); })) {
+        continue;
+      }
+      const auto property = GetProperty(prop_filter.property_);
+      if (!db_->EdgeTypePropertyIndexExists(edge_type, property)) continue;
+      const auto count = db_->EdgesCount(edge_type, property);
+      if (!best_filter || count < best_count) {
+        best_filter = filter;
+        best_count = count;
+      }
+    }
+    if (best_filter) {
+      const auto prop_filter = *best_filter->property_filter;
+      filter_exprs_for_removal_.insert(best_filter->expression);
+      filters_.EraseFilter(*best_filter);
+      return std::make_unique<ScanAllByEdgeTypeProperty>(scan.input(), edge_symbol, from_symbol, to_symbol, edge_type,
+                                                         GetProperty(prop_filter.property_), prop_filter.value_,
+                                                         prop_filter.lower_bound_, prop_filter.upper_bound_,
+                                                         expand.view_);
+    }
+    if (!db_->EdgeTypeIndexExists(edge_type)) return nullptr;
+    return std::make_unique<ScanAllByEdgeType>(scan.input(), edge_symbol, from_symbol, to_symbol, edge_type,
+                                               expand.view_);
+  }
+
   // `max_vertex_count` controls, whether no operator should be created if the
   // vertex count in the best index exceeds this number. In such a case,
   // `nullptr` is returned and `input` is not chained.
@@ -672,6 +862,33 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
       return nullptr;
     }
     auto found_index = FindBestLabelPropertyIndex(node_symbol, bound_symbols);
+    auto found_composite_index = FindBestLabelPropertyCompositeIndex(node_symbol, bound_symbols);
+    if (found_composite_index &&
+        // The composite index filters by more properties, so it is preferred
+        // unless the single property index has 10x less vertices.
+        (!found_index || found_index->vertex_count * 10 >= found_composite_index->vertex_count) &&
+        (!max_vertex_count || *max_vertex_count >= found_composite_index->vertex_count)) {
+      std::vector<Expression *> prefix;
+      for (const auto &filter : found_composite_index->prefix_filters) {
+        prefix.push_back(filter.property_filter->value_);
+        filter_exprs_for_removal_.insert(filter.expression);
+        filters_.EraseFilter(filter);
+      }
+      std::optional<ScanAllByLabelPropertyComposite::Bound> lower_bound;
+      std::optional<ScanAllByLabelPropertyComposite::Bound> upper_bound;
+      if (const auto &filter = found_composite_index->range_filter) {
+        lower_bound = filter->property_filter->lower_bound_;
+        upper_bound = filter->property_filter->upper_bound_;
+        filter_exprs_for_removal_.insert(filter->expression);
+        filters_.EraseFilter(*filter);
+      }
+      std::vector<Expression *> removed_expressions;
+      filters_.EraseLabelFilter(node_symbol, found_composite_index->label, &removed_expressions);
+      filter_exprs_for_removal_.insert(removed_expressions.begin(), removed_expressions.end());
+      return std::make_unique<ScanAllByLabelPropertyComposite>(
+          input, node_symbol, GetLabel(found_composite_index->label), found_composite_index->properties,
+          std::move(prefix), lower_bound, upper_bound, view);
+    }
     if (found_index &&
         // Use label+property index if we satisfy max_vertex_count.
         (!max_vertex_count || *max_vertex_count >= found_index->vertex_count)) {
@@ -692,22 +909,22 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
             input, node_symbol, GetLabel(found_index->label), GetProperty(prop_filter.property_),
             prop_filter.property_.name, prop_filter.lower_bound_, prop_filter.upper_bound_, view);
       } else if (prop_filter.type_ == PropertyFilter::Type::REGEX_MATCH) {
-        // Generate index scan using the empty string as a lower bound.
+        // Generate index scan using the empty string as a lower bound. The
+        // scan narrows it to the literal prefix of the pattern, which may be a
+        // parameter and so it isn't known while planning.
         Expression *empty_string = ast_storage_->Create<PrimitiveLiteral>("");
         auto lower_bound = utils::MakeBoundInclusive(empty_string);
-        return std::make_unique<ScanAllByLabelPropertyRange>(
+        auto scan = std::make_unique<ScanAllByLabelPropertyRange>(
             input, node_symbol, GetLabel(found_index->label), GetProperty(prop_filter.property_),
             prop_filter.property_.name, std::make_optional(lower_bound), std::nullopt, view);
+        scan->regex_ = prop_filter.value_;
+        return scan;
       } else if (prop_filter.type_ == PropertyFilter::Type::IN) {
         // TODO(buda): ScanAllByLabelProperty + Filter should be considered
         // here once the operator and the right cardinality estimation exist.
-        auto const &symbol = symbol_table_->CreateAnonymousSymbol();
-        auto *expression = ast_storage_->Create<Identifier>(symbol.name_);
-        expression->MapTo(symbol);
-        auto unwind_operator = std::make_unique<Unwind>(input, prop_filter.value_, symbol);
-        return std::make_unique<ScanAllByLabelPropertyValue>(
-            std::move(unwind_operator), node_symbol, GetLabel(found_index->label), GetProperty(prop_filter.property_),
-            prop_filter.property_.name, expression, view);
+        return std::make_unique<ScanAllByLabelPropertyValues>(input, node_symbol, GetLabel(found_index->label),
+                                                              GetProperty(prop_filter.property_),
+                                                              prop_filter.property_.name, prop_filter.value_, view);
       } else if (prop_filter.type_ == PropertyFilter::Type::IS_NOT_NULL) {
         return std::make_unique<ScanAllByLabelProperty>(input, node_symbol, GetLabel(found_index->label),
                                                         GetProperty(prop_filter.property_), prop_filter.property_.name,
@@ -730,7 +947,34 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     std::vector<Expression *> removed_expressions;
     filters_.EraseLabelFilter(node_symbol, label, &removed_expressions);
     filter_exprs_for_removal_.insert(removed_expressions.begin(), removed_expressions.end());
-    return std::make_unique<ScanAllByLabel>(input, node_symbol, GetLabel(label), view);
+    // The remaining indexed labels let the storage skip vertices without them
+    // before the Filter reads them. Labels with fewer vertices are checked
+    // first, since they skip the most vertices.
+    std::vector<storage::LabelId> filter_labels;
+    for (const auto &other_label : labels) {
+      if (other_label == label || !db_->LabelIndexExists(GetLabel(other_label))) continue;
+      filter_labels.push_back(GetLabel(other_label));
+    }
+    std::sort(filter_labels.begin(), filter_labels.end(), [this](const auto &lhs, const auto &rhs) {
+      return std::make_pair(db_->VerticesCount(lhs), lhs) < std::make_pair(db_->VerticesCount(rhs), rhs);
+    });
+    // Equality filters on properties are compared by the storage on the
+    // stored properties, so the vertices which don't match aren't read. The
+    // Filter keeps the original expressions, because Cypher equality differs
+    // from the stored comparison for some values, like lists with nulls.
+    std::vector<storage::PropertyId> filter_properties;
+    std::vector<Expression *> filter_values;
+    for (const auto &filter : filters_.PropertyFilters(node_symbol)) {
+      const auto &prop_filter = *filter.property_filter;
+      if (prop_filter.type_ != PropertyFilter::Type::EQUAL || prop_filter.is_symbol_in_value_ ||
+          !are_bound(filter.used_symbols)) {
+        continue;
+      }
+      filter_properties.push_back(GetProperty(prop_filter.property_));
+      filter_values.push_back(prop_filter.value_);
+    }
+    return std::make_unique<ScanAllByLabel>(input, node_symbol, GetLabel(label), view, std::move(filter_labels),
+                                            std::move(filter_properties), std::move(filter_values));
   }
 };
 
@@ -0,0 +1,430 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// This file provides a plan rewriter which replaces products of independent
+/// branches filtered by the equality of their values with `HashJoin`. The
+/// public entrypoint is `RewriteWithJoinRewriter`.
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "query/parameters.hpp"
+#include "query/plan/cost_estimator.hpp"
+#include "query/plan/operator.hpp"
+#include "query/plan/preprocess.hpp"
+#include "query/plan/read_write_type_checker.hpp"
+#include "query/plan/rewrite/index_lookup.hpp"
+
+namespace memgraph::query::plan {
+
+namespace impl {
+
+template <class TDbAccessor>
+class JoinRewriter final : public HierarchicalLogicalOperatorVisitor {
+ public:
+  JoinRewriter(SymbolTable *symbol_table, AstStorage *ast_storage, TDbAccessor *db, const Parameters &parameters)
+      : symbol_table_(symbol_table), ast_storage_(ast_storage), db_(db), parameters_(parameters) {}
+
+  using HierarchicalLogicalOperatorVisitor::PostVisit;
+  using HierarchicalLogicalOperatorVisitor::PreVisit;
+  using HierarchicalLogicalOperatorVisitor::Visit;
+
+  bool Visit(Once &) override { return true; }
+
+  bool PreVisit(Filter &op) override {
+    prev_ops_.push_back(&op);
+    return true;
+  }
+
+  // Join the input of the Filter in PostVisit, when its branches were already
+  // rewritten. Removal of the Filter may remove the last reference and thus
+  // free the memory. PostVisit should be the last thing Filter::Accept does,
+  // so it should be safe.
+  bool PostVisit(Filter &op) override {
+    prev_ops_.pop_back();
+    auto *join_condition = GenHashJoin(op);
+    if (!join_condition) {
+      return true;
+    }
+    op.expression_ = RemoveAndExpressions(op.expression_, {join_condition});
+    if (!op.expression_ || op.expression_ == join_condition) {
+      SetOnParent(op.input());
+    }
+    return true;
+  }
+
+  // The following operators may only be joined inside of their own branches.
+  // So we handle them all the same.
+  //  * Input operator is visited with the current visitor.
+  //  * Custom operator branches are visited with a new visitor.
+
+  bool PreVisit(Merge &op) override {
+    prev_ops_.push_back(&op);
+    op.input()->Accept(*this);
+    RewriteBranch(&op.merge_match_);
+    return false;
+  }
+
+  bool PostVisit(Merge &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
+  bool PreVisit(Optional &op) override {
+    prev_ops_.push_back(&op);
+    op.input()->Accept(*this);
+    RewriteBranch(&op.optional_);
+    return false;
+  }
+
+  bool PostVisit(Optional &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
+  bool PreVisit(Cartesian &op) override {
+    prev_ops_.push_back(&op);
+    RewriteBranch(&op.left_op_);
+    RewriteBranch(&op.right_op_);
+    return false;
+  }
+
+  bool PostVisit(Cartesian &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
+  bool PreVisit(HashJoin &op) override {
+    prev_ops_.push_back(&op);
+    RewriteBranch(&op.left_op_);
+    RewriteBranch(&op.right_op_);
+    return false;
+  }
+
+  bool PostVisit(HashJoin &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
+  bool PreVisit(Union &op) override {
+    prev_ops_.push_back(&op);
+    RewriteBranch(&op.left_op_);
+    RewriteBranch(&op.right_op_);
+    return false;
+  }
+
+  bool PostVisit(Union &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
+  bool PreVisit(Foreach &op) override {
+    prev_ops_.push_back(&op);
+    op.input()->Accept(*this);
+    RewriteBranch(&op.update_clauses_);
+    return false;
+  }
+
+  bool PostVisit(Foreach &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
+  bool PreVisit(Apply &op) override {
+    prev_ops_.push_back(&op);
+    op.input()->Accept(*this);
+    RewriteBranch(&op.subquery_);
+    return false;
+  }
+
+  bool PostVisit(Apply & /*op*/) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
+  // The remaining operators should work by just traversing into their input.
+
+#define PRE_POST_VISIT(TOp)               \
+  bool PreVisit(TOp &op) override {       \
+    prev_ops_.push_back(&op);             \
+    return true;                          \
+  }                                       \
+  bool PostVisit(TOp & /*op*/) override { \
+    prev_ops_.pop_back();                 \
+    return true;                          \
+  }
+
+  PRE_POST_VISIT(CreateNode)
+  PRE_POST_VISIT(CreateExpand)
+  PRE_POST_VISIT(ScanAll)
+  PRE_POST_VISIT(ScanAllByLabel)
+  PRE_POST_VISIT(ScanAllByLabelPropertyRange)
+  PRE_POST_VISIT(ScanAllByLabelPropertyValue)
+  PRE_POST_VISIT(ScanAllByLabelPropertyValues)
+  PRE_POST_VISIT(ScanAllByLabelProperty)
+  PRE_POST_VISIT(ScanAllByLabelPropertyComposite)
+  PRE_POST_VISIT(ScanAllById)
+  PRE_POST_VISIT(ScanAllByEdgeType)
+  PRE_POST_VISIT(ScanAllByEdgeTypeProperty)
+  PRE_POST_VISIT(Expand)
+  PRE_POST_VISIT(ExpandVariable)
+  PRE_POST_VISIT(IntersectExpand)
+  PRE_POST_VISIT(ConstructNamedPath)
+  PRE_POST_VISIT(Produce)
+  PRE_POST_VISIT(EmptyResult)
+  PRE_POST_VISIT(Delete)
+  PRE_POST_VISIT(SetProperty)
+  PRE_POST_VISIT(SetProperties)
+  PRE_POST_VISIT(SetLabels)
+  PRE_POST_VISIT(RemoveProperty)
+  PRE_POST_VISIT(RemoveLabels)
+  PRE_POST_VISIT(EdgeUniquenessFilter)
+  PRE_POST_VISIT(Accumulate)
+  PRE_POST_VISIT(Aggregate)
+  PRE_POST_VISIT(Skip)
+  PRE_POST_VISIT(Limit)
+  PRE_POST_VISIT(OrderBy)
+  PRE_POST_VISIT(Unwind)
+  PRE_POST_VISIT(Distinct)
+  PRE_POST_VISIT(CallProcedure)
+  PRE_POST_VISIT(EvaluatePatternFilter)
+  PRE_POST_VISIT(LoadCsv)
+  PRE_POST_VISIT(LoadArrow)
+
+#undef PRE_POST_VISIT
+
+  std::shared_ptr<LogicalOperator> new_root_;
+
+ private:
+  SymbolTable *symbol_table_;
+  AstStorage *ast_storage_;
+  TDbAccessor *db_;
+  const Parameters &parameters_;
+  std::vector<LogicalOperator *> prev_ops_;
+
+  bool DefaultPreVisit() override { throw utils::NotYetImplemented("optimizing joins"); }
+
+  void SetOnParent(const std::shared_ptr<LogicalOperator> &input) {
+    MG_ASSERT(input);
+    if (prev_ops_.empty()) {
+      MG_ASSERT(!new_root_);
+      new_root_ = input;
+      return;
+    }
+    prev_ops_.back()->set_input(input);
+  }
+
+  void RewriteBranch(std::shared_ptr<LogicalOperator> *branch) {
+    JoinRewriter<TDbAccessor> rewriter(symbol_table_, ast_storage_, db_, parameters_);
+    (*branch)->Accept(rewriter);
+    if (rewriter.new_root_) {
+      *branch = rewriter.new_root_;
+    }
+  }
+
+  std::unordered_set<Symbol> UsedSymbols(Expression *expression) {
+    UsedSymbolsCollector collector(*symbol_table_);
+    expression->Accept(collector);
+    return collector.symbols_;
+  }
+
+  static bool AreAllIn(const std::unordered_set<Symbol> &symbols, const std::unordered_set<Symbol> &in) {
+    return std::all_of(symbols.begin(), symbols.end(), [&in](const auto &symbol) { return in.contains(symbol); });
+  }
+
+  static bool AreNoneIn(const std::unordered_set<Symbol> &symbols, const std::unordered_set<Symbol> &in) {
+    return std::none_of(symbols.begin(), symbols.end(), [&in](const auto &symbol) { return in.contains(symbol); });
+  }
+
+  // Replaces the input of the filter with a HashJoin on one of the equalities
+  // in the filter expression and returns the used equality. Returns nullptr if
+  // the input can't be joined.
+  Expression *GenHashJoin(Filter &filter) {
+    if (!filter.pattern_filters_.empty()) return nullptr;
+    std::vector<Expression *> conjuncts;
+    std::vector<Expression *> to_split{filter.expression_};
+    while (!to_split.empty()) {
+      auto *expression = to_split.back();
+      to_split.pop_back();
+      if (auto *and_op = utils::Downcast<AndOperator>(expression)) {
+        to_split.push_back(and_op->expression1_);
+        to_split.push_back(and_op->expression2_);
+      } else {
+        conjuncts.push_back(expression);
+      }
+    }
+    for (auto *conjunct : conjuncts) {
+      auto *equal = utils::Downcast<EqualOperator>(conjunct);
+      if (!equal) continue;
+      auto lhs_symbols = UsedSymbols(equal->expression1_);
+      auto rhs_symbols = UsedSymbols(equal->expression2_);
+      if (lhs_symbols.empty() || rhs_symbols.empty()) continue;
+      if (JoinCartesian(filter, equal, lhs_symbols, rhs_symbols) ||
+          JoinIndependentScan(filter, equal, lhs_symbols, rhs_symbols)) {
+        return equal;
+      }
+    }
+    return nullptr;
+  }
+
+  // Joins the branches of a Cartesian which is the input of the filter.
+  bool JoinCartesian(Filter &filter, EqualOperator *equal, const std::unordered_set<Symbol> &lhs_symbols,
+                     const std::unordered_set<Symbol> &rhs_symbols) {
+    auto *cartesian = utils::Downcast<Cartesian>(filter.input().get());
+    if (!cartesian) return false;
+    const std::unordered_set<Symbol> left(cartesian->left_symbols_.begin(), cartesian->left_symbols_.end());
+    const std::unordered_set<Symbol> right(cartesian->right_symbols_.begin(), cartesian->right_symbols_.end());
+    EqualOperator *condition = nullptr;
+    if (AreAllIn(lhs_symbols, left) && AreAllIn(rhs_symbols, right)) {
+      condition = equal;
+    } else if (AreAllIn(lhs_symbols, right) && AreAllIn(rhs_symbols, left)) {
+      condition = ast_storage_->Create<EqualOperator>(equal->expression2_, equal->expression1_);
+    } else {
+      return false;
+    }
+    filter.set_input(MakeHashJoin(cartesian->left_op_, cartesian->left_symbols_, cartesian->right_op_,
+                                  cartesian->right_symbols_, condition));
+    return true;
+  }
+
+  static bool IsJoinableScan(const LogicalOperator &op) {
+    const auto &type = op.GetTypeInfo();
+    return type == ScanAll::kType || type == ScanAllByLabel::kType || type == ScanAllByLabelProperty::kType;
+  }
+
+  // Looks for scans starting an independent part of the pattern below the
+  // filter, like the scan of `m` in `MATCH (n), (m) WHERE n.x = m.x`. The
+  // regular planner matches such parts in nested loops, which are joined
+  // here. The part between the filter and its scan may contain only scans,
+  // expansions and filters. Filters in that part which use the symbols bound
+  // before it are moved above the join.
+  bool JoinIndependentScan(Filter &filter, EqualOperator *equal, const std::unordered_set<Symbol> &lhs_symbols,
+                           const std::unordered_set<Symbol> &rhs_symbols) {
+    std::vector<std::shared_ptr<LogicalOperator>> part;
+    std::unordered_set<Symbol> part_symbols;
+    EqualOperator *condition = nullptr;
+    for (auto op = filter.input(); !condition; op = op->input()) {
+      if (IsJoinableScan(*op)) {
+        part_symbols.insert(static_cast<const ScanAll &>(*op).output_symbol_);
+      } else if (auto *expand = utils::Downcast<Expand>(op.get())) {
+        part_symbols.insert(expand->common_.edge_symbol);
+        part_symbols.insert(expand->common_.node_symbol);
+      } else if (!utils::Downcast<Filter>(op.get()) && !utils::Downcast<EdgeUniquenessFilter>(op.get())) {
+        return false;
+      }
+      part.push_back(op);
+      if (!AreNoneIn(lhs_symbols, part_symbols) && !AreNoneIn(rhs_symbols, part_symbols)) return false;
+      if (!IsJoinableScan(*op)) continue;
+      if (AreAllIn(rhs_symbols, part_symbols) && AreNoneIn(lhs_symbols, part_symbols)) {
+        condition = equal;
+      } else if (AreAllIn(lhs_symbols, part_symbols) && AreNoneIn(rhs_symbols, part_symbols)) {
+        condition = ast_storage_->Create<EqualOperator>(equal->expression2_, equal->expression1_);
+      }
+    }
+
+    // Check that the part uses only its own symbols, starting from its scan.
+    std::unordered_set<Symbol> bound;
+    std::vector<bool> move_above_join(part.size(), false);
+    for (auto i = part.size(); i-- > 0;) {
+      const auto &op = part[i];
+      if (IsJoinableScan(*op)) {
+        bound.insert(static_cast<const ScanAll &>(*op).output_symbol_);
+      } else if (auto *expand = utils::Downcast<Expand>(op.get())) {
+        if (!bound.contains(expand->input_symbol_) ||
+            (expand->common_.existing_node && !bound.contains(expand->common_.node_symbol))) {
+          return false;
+        }
+        bound.insert(expand->common_.edge_symbol);
+        bound.insert(expand->common_.node_symbol);
+      } else if (auto *part_filter = utils::Downcast<Filter>(op.get())) {
+        if (!part_filter->pattern_filters_.empty()) return false;
+        move_above_join[i] = !AreAllIn(UsedSymbols(part_filter->expression_), bound);
+      } else if (auto *uniqueness_filter = utils::Downcast<EdgeUniquenessFilter>(op.get())) {
+        std::unordered_set<Symbol> used(uniqueness_filter->previous_symbols_.begin(),
+                                        uniqueness_filter->previous_symbols_.end());
+        used.insert(uniqueness_filter->expand_symbol_);
+        move_above_join[i] = !AreAllIn(used, bound);
+      }
+    }
+
+    auto left_op = part.back()->input();
+    std::shared_ptr<LogicalOperator> right_op = std::make_shared<Once>();
+    std::vector<std::shared_ptr<LogicalOperator>> above_join;
+    for (auto i = part.size(); i-- > 0;) {
+      if (move_above_join[i]) {
+        above_join.push_back(part[i]);
+        continue;
+      }
+      part[i]->set_input(right_op);
+      right_op = part[i];
+    }
+    std::shared_ptr<LogicalOperator> input = MakeHashJoin(left_op, left_op->ModifiedSymbols(*symbol_table_), right_op,
+                                                          right_op->ModifiedSymbols(*symbol_table_), condition);
+    for (auto &op : above_join) {
+      op->set_input(input);
+      input = op;
+    }
+    filter.set_input(input);
+    return true;
+  }
+
+  bool IsReadOnly(LogicalOperator &op) {
+    ReadWriteTypeChecker checker;
+    checker.InferRWType(op);
+    return checker.type == ReadWriteTypeChecker::RWType::NONE || checker.type == ReadWriteTypeChecker::RWType::R;
+  }
+
+  double EstimateCardinality(LogicalOperator &op) {
+    CostEstimator<TDbAccessor> estimator(db_, *symbol_table_, parameters_);
+    op.Accept(estimator);
+    return estimator.cardinality();
+  }
+
+  // HashJoin hashes the results of its left branch, so the branch with less
+  // results goes to the left when the branches can be executed in any order.
+  std::unique_ptr<HashJoin> MakeHashJoin(std::shared_ptr<LogicalOperator> left_op, std::vector<Symbol> left_symbols,
+                                         std::shared_ptr<LogicalOperator> right_op, std::vector<Symbol> right_symbols,
+                                         EqualOperator *condition) {
+    if (IsReadOnly(*left_op) && IsReadOnly(*right_op) &&
+        EstimateCardinality(*right_op) < EstimateCardinality(*left_op)) {
+      std::swap(left_op, right_op);
+      std::swap(left_symbols, right_symbols);
+      condition = ast_storage_->Create<EqualOperator>(condition->expression2_, condition->expression1_);
+    }
+    return std::make_unique<HashJoin>(left_op, left_symbols, right_op, right_symbols, condition);
+  }
+};
+
+}  // namespace impl
+
+template <class TDbAccessor>
+std::unique_ptr<LogicalOperator> RewriteWithJoinRewriter(std::unique_ptr<LogicalOperator> root_op,
+                                                         SymbolTable *symbol_table, AstStorage *ast_storage,
+                                                         TDbAccessor *db, const Parameters &parameters) {
+  impl::JoinRewriter<TDbAccessor> rewriter(symbol_table, ast_storage, db, parameters);
+  root_op->Accept(rewriter);
+  if (rewriter.new_root_) {
+    // This shouldn't happen in real use case, because JoinRewriter removes
+    // Filter operations and they cannot be the root op. In case we somehow
+    // missed this, raise NotYetImplemented instead of MG_ASSERT crashing the
+    // application.
+    throw utils::NotYetImplemented("optimizing joins");
+  }
+  return root_op;
+}
+
+}  // namespace memgraph::query::plan
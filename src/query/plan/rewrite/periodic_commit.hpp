@@ -0,0 +1,45 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// This file provides a plan rewriter which plans `PeriodicCommit` for the
+/// queries with the `USING PERIODIC COMMIT n` hint. The public entrypoint is
+/// `RewriteWithPeriodicCommit`.
+
+#pragma once
+
+#include <memory>
+
+#include "query/frontend/ast/ast.hpp"
+#include "query/plan/operator.hpp"
+
+namespace memgraph::query::plan {
+
+/// Places `PeriodicCommit` right below the `EmptyResult` or `Accumulate`
+/// which consume all the rows of the writing part of the query, or below the
+/// root if the query doesn't have them. The rows are then committed in
+/// batches as soon as they are written, before any of them is returned.
+inline std::unique_ptr<LogicalOperator> RewriteWithPeriodicCommit(std::unique_ptr<LogicalOperator> root_op,
+                                                                  Expression *commit_frequency) {
+  if (!commit_frequency || !root_op->HasSingleInput() || !root_op->input()) return root_op;
+
+  LogicalOperator *parent = root_op.get();
+  for (auto *op = root_op.get(); op->HasSingleInput() && op->input(); op = op->input().get()) {
+    if (op->GetTypeInfo() == EmptyResult::kType || op->GetTypeInfo() == Accumulate::kType) {
+      parent = op;
+      break;
+    }
+  }
+  parent->set_input(std::make_shared<PeriodicCommit>(parent->input(), commit_frequency));
+  return root_op;
+}
+
+}  // namespace memgraph::query::plan
@@ -0,0 +1,90 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// This file provides a plan rewriter which replaces consecutive `SetProperty`
+/// operators on the same node or edge with a single `SetProperties`, so that
+/// `SET n.a = 1, n.b = $b` updates the record with one storage call instead
+/// of one call for each property. The public entrypoint is
+/// `RewriteWithSetProperties`.
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "query/frontend/ast/ast.hpp"
+#include "query/frontend/semantic/symbol_table.hpp"
+#include "query/plan/operator.hpp"
+
+namespace memgraph::query::plan {
+
+namespace impl {
+
+/// Returns true if the value doesn't depend on the properties set before it,
+/// so all the values can be evaluated before setting any of them.
+inline bool IsConstantExpression(Expression *expression) {
+  return utils::IsSubtype(*expression, PrimitiveLiteral::kType) ||
+         utils::IsSubtype(*expression, ParameterLookup::kType);
+}
+
+/// Returns the `SetProperties` which updates the record like the chain of
+/// `SetProperty` operators starting at `op` does, or nullptr if the chain has
+/// fewer than two operators. The chain ends at the first operator which sets
+/// a property of a different symbol, sets a property which is already set in
+/// the chain, or sets a value which isn't constant.
+inline std::shared_ptr<SetProperties> MergeSetProperty(const std::shared_ptr<LogicalOperator> &op,
+                                                       const SymbolTable &symbol_table, AstStorage *ast_storage) {
+  std::optional<Symbol> symbol;
+  std::vector<const SetProperty *> chain;
+  auto input = op;
+  while (input->GetTypeInfo() == SetProperty::kType) {
+    const auto *set_property = static_cast<const SetProperty *>(input.get());
+    auto *identifier = utils::Downcast<Identifier>(set_property->lhs_->expression_);
+    if (!identifier || !IsConstantExpression(set_property->rhs_)) break;
+    const auto &lhs_symbol = symbol_table.at(*identifier);
+    if (symbol && lhs_symbol != *symbol) break;
+    if (std::any_of(chain.begin(), chain.end(),
+                    [&](const auto *other) { return other->property_ == set_property->property_; })) {
+      break;
+    }
+    symbol = lhs_symbol;
+    chain.push_back(set_property);
+    input = set_property->input_;
+  }
+  if (chain.size() < 2) return nullptr;
+
+  auto *properties = ast_storage->Create<MapLiteral>();
+  for (const auto *set_property : chain) {
+    properties->elements_.emplace(set_property->lhs_->property_, set_property->rhs_);
+  }
+  return std::make_shared<SetProperties>(input, *symbol, properties, SetProperties::Op::UPDATE);
+}
+
+}  // namespace impl
+
+/// Merges the `SetProperty` operators of each `SET` clause below the root of
+/// the plan, where setting all the properties at once gives the same result
+/// as setting them one after another.
+inline std::unique_ptr<LogicalOperator> RewriteWithSetProperties(std::unique_ptr<LogicalOperator> root_op,
+                                                                 const SymbolTable &symbol_table,
+                                                                 AstStorage *ast_storage) {
+  for (auto *op = root_op.get(); op->HasSingleInput() && op->input(); op = op->input().get()) {
+    if (auto set_properties = impl::MergeSetProperty(op->input(), symbol_table, ast_storage)) {
+      op->set_input(set_properties);
+    }
+  }
+  return root_op;
+}
+
+}  // namespace memgraph::query::plan
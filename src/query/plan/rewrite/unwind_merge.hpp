@@ -0,0 +1,126 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// This file provides a plan rewriter which replaces the ingestion of a list
+/// with `UNWIND` followed by `MERGE` of a single node and optionally
+/// `SET n += ...` with `UnwindMerge`. The public entrypoint is
+/// `RewriteWithUnwindMerge`.
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "query/frontend/ast/ast.hpp"
+#include "query/frontend/semantic/symbol_table.hpp"
+#include "query/plan/operator.hpp"
+
+namespace memgraph::query::plan {
+
+namespace impl {
+
+/// Returns true if the expression only reads the row symbol, if it's given,
+/// and the parameters. `UnwindMerge` evaluates such expressions for all the
+/// rows before writing any of them, which gives the same values as
+/// evaluating them when each row is written.
+inline bool IsRowExpression(Expression *expression, const Symbol *row_symbol, const SymbolTable &symbol_table) {
+  if (auto *identifier = utils::Downcast<Identifier>(expression)) {
+    return row_symbol && symbol_table.at(*identifier) == *row_symbol;
+  }
+  if (auto *lookup = utils::Downcast<PropertyLookup>(expression)) {
+    return IsRowExpression(lookup->expression_, row_symbol, symbol_table);
+  }
+  if (auto *list = utils::Downcast<ListLiteral>(expression)) {
+    return std::all_of(list->elements_.begin(), list->elements_.end(),
+                       [&](auto *element) { return IsRowExpression(element, row_symbol, symbol_table); });
+  }
+  if (auto *map = utils::Downcast<MapLiteral>(expression)) {
+    return std::all_of(map->elements_.begin(), map->elements_.end(),
+                       [&](const auto &element) { return IsRowExpression(element.second, row_symbol, symbol_table); });
+  }
+  return utils::IsSubtype(*expression, PrimitiveLiteral::kType) ||
+         utils::IsSubtype(*expression, ParameterLookup::kType);
+}
+
+/// Returns the `UnwindMerge` which ingests the rows like `op` does, or nullptr
+/// if `op` isn't a `SetProperties` or a `Merge` of the supported form.
+inline std::shared_ptr<UnwindMerge> MakeUnwindMerge(const std::shared_ptr<LogicalOperator> &op,
+                                                    const SymbolTable &symbol_table) {
+  const SetProperties *set_properties = nullptr;
+  const LogicalOperator *merge_op = op.get();
+  if (op->GetTypeInfo() == SetProperties::kType) {
+    set_properties = static_cast<const SetProperties *>(op.get());
+    if (set_properties->op_ != SetProperties::Op::UPDATE) return nullptr;
+    merge_op = set_properties->input_.get();
+  }
+  if (merge_op->GetTypeInfo() != Merge::kType) return nullptr;
+  const auto *merge = static_cast<const Merge *>(merge_op);
+
+  // The rows come from a list or from LOAD ARROW, which is the whole input.
+  const Unwind *unwind = nullptr;
+  const LoadArrow *load_arrow = nullptr;
+  if (merge->input_->GetTypeInfo() == Unwind::kType) {
+    unwind = static_cast<const Unwind *>(merge->input_.get());
+    if (unwind->input_->GetTypeInfo() != Once::kType) return nullptr;
+  } else if (merge->input_->GetTypeInfo() == LoadArrow::kType) {
+    load_arrow = static_cast<const LoadArrow *>(merge->input_.get());
+    if (load_arrow->input_->GetTypeInfo() != Once::kType) return nullptr;
+  } else {
+    return nullptr;
+  }
+
+  // The merged pattern must be a single node with one label and one property,
+  // which is looked up in the label-property index.
+  if (merge->merge_match_->GetTypeInfo() != ScanAllByLabelPropertyValue::kType) return nullptr;
+  const auto *scan = static_cast<const ScanAllByLabelPropertyValue *>(merge->merge_match_.get());
+  if (scan->input_->GetTypeInfo() != Once::kType) return nullptr;
+  if (merge->merge_create_->GetTypeInfo() != CreateNode::kType) return nullptr;
+  const auto *create = static_cast<const CreateNode *>(merge->merge_create_.get());
+  if (create->input_->GetTypeInfo() != Once::kType) return nullptr;
+  const auto &node_info = create->node_info_;
+  const auto *node_properties = std::get_if<PropertiesMapList>(&node_info.properties);
+  if (node_info.symbol != scan->output_symbol_ || node_info.labels != std::vector{scan->label_} || !node_properties ||
+      node_properties->size() != 1 || node_properties->front().first != scan->property_ ||
+      node_properties->front().second != scan->expression_) {
+    return nullptr;
+  }
+  if (set_properties && set_properties->input_symbol_ != scan->output_symbol_) return nullptr;
+
+  const auto &row_symbol = unwind ? unwind->output_symbol_ : load_arrow->row_var_;
+  if ((unwind && !IsRowExpression(unwind->input_expression_, nullptr, symbol_table)) ||
+      !IsRowExpression(scan->expression_, &row_symbol, symbol_table) ||
+      (set_properties && !IsRowExpression(set_properties->rhs_, &row_symbol, symbol_table))) {
+    return nullptr;
+  }
+  return std::make_shared<UnwindMerge>(unwind ? unwind->input_ : merge->input_,
+                                       unwind ? unwind->input_expression_ : nullptr, row_symbol,
+                                       scan->output_symbol_, scan->label_, scan->property_, scan->expression_,
+                                       set_properties ? set_properties->rhs_ : nullptr, op);
+}
+
+}  // namespace impl
+
+/// Replaces the ingestion of a list below `EmptyResult` or `Accumulate` with
+/// `UnwindMerge`. Both operators consume all of their input before yielding,
+/// so the operators above them can't notice in which order the rows were
+/// written.
+inline std::unique_ptr<LogicalOperator> RewriteWithUnwindMerge(std::unique_ptr<LogicalOperator> root_op,
+                                                               const SymbolTable &symbol_table) {
+  for (auto *op = root_op.get(); op->HasSingleInput() && op->input(); op = op->input().get()) {
+    if (op->GetTypeInfo() != EmptyResult::kType && op->GetTypeInfo() != Accumulate::kType) continue;
+    if (auto unwind_merge = impl::MakeUnwindMerge(op->input(), symbol_table)) op->set_input(unwind_merge);
+  }
+  return root_op;
+}
+
+}  // namespace memgraph::query::plan
@@ -17,6 +17,8 @@
 #include <stack>
 #include <unordered_set>
 
+#include "query/plan/read_write_type_checker.hpp"
+#include "query/plan/rewrite/constant_folding.hpp"
 #include "utils/algorithm.hpp"
 #include "utils/exceptions.hpp"
 #include "utils/logging.hpp"
@@ -344,10 +346,10 @@ class ReturnBodyContext : public HierarchicalTreeVisitor {
     const auto &symbol = symbol_table_.at(aggr);
     aggregations_.emplace_back(
         Aggregate::Element{aggr.expression1_, aggr.expression2_, aggr.op_, symbol, aggr.distinct_});
-    // Aggregation expression1_ is optional in COUNT(*), and COLLECT_MAP uses
-    // two expressions, so we can have 0, 1 or 2 elements on the
-    // has_aggregation_stack for this Aggregation expression.
-    if (aggr.op_ == Aggregation::Op::COLLECT_MAP) has_aggregation_.pop_back();
+    // Aggregation expression1_ is optional in COUNT(*), and COLLECT_MAP and
+    // APPROX_PERCENTILE use two expressions, so we can have 0, 1 or 2 elements
+    // on the has_aggregation_stack for this Aggregation expression.
+    if (aggr.expression2_) has_aggregation_.pop_back();
     if (aggr.expression1_)
       has_aggregation_.back() = true;
     else
@@ -433,6 +435,8 @@ class ReturnBodyContext : public HierarchicalTreeVisitor {
   // All symbols generated by named expressions. They are collected in order of
   // named_expressions.
   const auto &output_symbols() const { return output_symbols_; }
+  SymbolTable &symbol_table() const { return symbol_table_; }
+  AstStorage &storage() const { return storage_; }
 
  private:
   const ReturnBody &body_;
@@ -457,6 +461,45 @@ class ReturnBodyContext : public HierarchicalTreeVisitor {
   std::vector<NamedExpression *> named_expressions_;
 };
 
+// Returns true if the expression evaluates to the same value each time, so
+// that OrderBy gets the same number of rows to keep as Skip and Limit.
+bool IsConstantExpression(const Expression *expression) {
+  return utils::IsSubtype(*expression, PrimitiveLiteral::kType) ||
+         utils::IsSubtype(*expression, ParameterLookup::kType);
+}
+
+// When the only aggregation counts the paths of an all shortest paths
+// expansion, the expansion is made to count its paths and the aggregation sums
+// the counts, so that the paths aren't enumerated one by one. Returns the new
+// input of the aggregation.
+std::shared_ptr<LogicalOperator> CountShortestPaths(std::shared_ptr<LogicalOperator> input_op,
+                                                    std::vector<Aggregate::Element> *aggregations,
+                                                    const ReturnBodyContext &body) {
+  if (aggregations->size() != 1 || !body.group_by().empty()) return input_op;
+  auto &aggregation = aggregations->front();
+  if (aggregation.op != Aggregation::Op::COUNT || aggregation.distinct) return input_op;
+  auto expand_op = input_op;
+  std::optional<Symbol> path_symbol;
+  if (auto *named_path = utils::Downcast<ConstructNamedPath>(input_op.get())) {
+    path_symbol = named_path->path_symbol_;
+    expand_op = named_path->input();
+  }
+  auto *expand = utils::Downcast<ExpandVariable>(expand_op.get());
+  if (!expand || expand->type_ != EdgeAtom::Type::ALL_SHORTEST_PATHS) return input_op;
+  // Only count(*) and counting the path or its edges, which are never null.
+  if (aggregation.value) {
+    auto *identifier = utils::Downcast<Identifier>(aggregation.value);
+    if (!identifier) return input_op;
+    const auto &symbol = body.symbol_table().at(*identifier);
+    if (symbol != path_symbol && symbol != expand->common_.edge_symbol) return input_op;
+  }
+  const auto count_symbol = body.symbol_table().CreateAnonymousSymbol();
+  expand->path_count_symbol_ = count_symbol;
+  aggregation.op = Aggregation::Op::SUM;
+  aggregation.value = body.storage().Create<Identifier>(count_symbol.name())->MapTo(count_symbol);
+  return expand_op;
+}
+
 std::unique_ptr<LogicalOperator> GenReturnBody(std::unique_ptr<LogicalOperator> input_op, bool advance_command,
                                                const ReturnBodyContext &body, bool accumulate = false) {
   std::vector<Symbol> used_symbols(body.used_symbols().begin(), body.used_symbols().end());
@@ -470,7 +513,10 @@ std::unique_ptr<LogicalOperator> GenReturnBody(std::unique_ptr<LogicalOperator>
   if (!body.aggregations().empty()) {
     // When we have aggregation, SKIP/LIMIT should always come after it.
     std::vector<Symbol> remember(body.group_by_used_symbols().begin(), body.group_by_used_symbols().end());
-    last_op = std::make_unique<Aggregate>(std::move(last_op), body.aggregations(), body.group_by(), remember);
+    auto aggregations = body.aggregations();
+    std::shared_ptr<LogicalOperator> aggregate_input = std::move(last_op);
+    if (!accumulate) aggregate_input = CountShortestPaths(std::move(aggregate_input), &aggregations, body);
+    last_op = std::make_unique<Aggregate>(std::move(aggregate_input), aggregations, body.group_by(), remember);
   }
   last_op = std::make_unique<Produce>(std::move(last_op), body.named_expressions());
   // Distinct in ReturnBody only makes Produce values unique, so plan after it.
@@ -480,7 +526,15 @@ std::unique_ptr<LogicalOperator> GenReturnBody(std::unique_ptr<LogicalOperator>
   // Like Where, OrderBy can read from symbols established by named expressions
   // in Produce, so it must come after it.
   if (!body.order_by().empty()) {
-    last_op = std::make_unique<OrderBy>(std::move(last_op), body.order_by(), body.output_symbols());
+    // With a constant Limit, OrderBy only has to keep the rows which get past
+    // Skip and Limit, so it is given both of their expressions.
+    Expression *skip = nullptr;
+    Expression *limit = nullptr;
+    if (body.limit() && IsConstantExpression(body.limit()) && (!body.skip() || IsConstantExpression(body.skip()))) {
+      skip = body.skip();
+      limit = body.limit();
+    }
+    last_op = std::make_unique<OrderBy>(std::move(last_op), body.order_by(), body.output_symbols(), skip, limit);
   }
   // Finally, Skip and Limit must come after OrderBy.
   if (body.skip()) {
@@ -499,10 +553,93 @@ std::unique_ptr<LogicalOperator> GenReturnBody(std::unique_ptr<LogicalOperator>
   return last_op;
 }
 
+class DeterminismChecker : public HierarchicalTreeVisitor {
+ public:
+  using HierarchicalTreeVisitor::PostVisit;
+  using HierarchicalTreeVisitor::PreVisit;
+  using HierarchicalTreeVisitor::Visit;
+
+  explicit DeterminismChecker(bool across_executions) : across_executions_(across_executions) {}
+
+  bool PreVisit(Function &function) override {
+    if (!IsDeterministicFunction(function, across_executions_)) deterministic_ = false;
+    return deterministic_;
+  }
+
+  bool PreVisit(query::CallProcedure & /*call_procedure*/) override {
+    deterministic_ = false;
+    return false;
+  }
+
+  bool Visit(Identifier & /*identifier*/) override { return true; }
+  bool Visit(PrimitiveLiteral & /*literal*/) override { return true; }
+  bool Visit(ParameterLookup & /*parameter_lookup*/) override { return true; }
+
+  bool deterministic_{true};
+
+ private:
+  bool across_executions_;
+};
+
+// Resets the memoization of the subqueries and the pattern filters, whose
+// results could change once a write advances the command.
+class MemoizationDisabler : public HierarchicalLogicalOperatorVisitor {
+ public:
+  using HierarchicalLogicalOperatorVisitor::PostVisit;
+  using HierarchicalLogicalOperatorVisitor::PreVisit;
+  using HierarchicalLogicalOperatorVisitor::Visit;
+
+  bool PreVisit(EvaluatePatternFilter &op) override {
+    op.memoize_results_ = false;
+    return true;
+  }
+
+  bool PreVisit(Apply &op) override {
+    op.memoize_results_ = false;
+    return true;
+  }
+
+  bool Visit(Once & /*op*/) override { return true; }
+};
+
 }  // namespace
 
+void DisableSubqueryMemoization(LogicalOperator &plan) {
+  MemoizationDisabler disabler;
+  plan.Accept(disabler);
+}
+
 namespace impl {
 
+bool IsDeterministic(utils::Visitable<HierarchicalTreeVisitor> &tree, const bool across_executions) {
+  DeterminismChecker checker(across_executions);
+  tree.Accept(checker);
+  return checker.deterministic_;
+}
+
+bool IsReadOnly(LogicalOperator &plan) {
+  ReadWriteTypeChecker checker;
+  checker.InferRWType(plan);
+  return checker.type == ReadWriteTypeChecker::RWType::NONE || checker.type == ReadWriteTypeChecker::RWType::R;
+}
+
+std::vector<Symbol> GetSubqueryImportedSymbols(const std::vector<SingleQueryPart> &single_query_parts,
+                                               const SymbolTable &symbol_table,
+                                               const std::unordered_set<Symbol> &outer_scope_bound_symbols) {
+  const auto &query = single_query_parts[0];
+  if (!query.matching.expansions.empty() || query.remaining_clauses.empty()) return {};
+  auto *with = utils::Downcast<query::With>(query.remaining_clauses[0]);
+  if (!with) return {};
+
+  UsedSymbolsCollector collector(symbol_table);
+  with->Accept(collector);
+  std::vector<Symbol> imported_symbols;
+  for (const auto &symbol : collector.symbols_) {
+    if (outer_scope_bound_symbols.contains(symbol)) imported_symbols.push_back(symbol);
+  }
+  return imported_symbols;
+}
+
 bool HasBoundFilterSymbols(const std::unordered_set<Symbol> &bound_symbols, const FilterInfo &filter) {
   return std::ranges::all_of(
       filter.used_symbols.begin(), filter.used_symbols.end(),
@@ -601,6 +738,159 @@ std::unique_ptr<LogicalOperator> GenUnion(const CypherUnion &cypher_union, std::
                                  right_op->OutputSymbols(symbol_table));
 }
 
+std::vector<Expansion> OrderExpansionsByCost(const Matching &matching, const SymbolTable &symbol_table,
+                                             const std::unordered_map<Symbol, double> &node_cardinalities,
+                                             const std::vector<double> &expansion_degrees, double vertex_count) {
+  const auto &expansions = matching.expansions;
+  MG_ASSERT(expansions.size() == expansion_degrees.size(), "Missing degree estimates for expansions");
+  if (expansions.size() < 2) return expansions;
+
+  auto node_cardinality = [&](const Symbol &symbol) {
+    auto found = node_cardinalities.find(symbol);
+    return found != node_cardinalities.end() ? found->second : vertex_count;
+  };
+
+  struct ExpansionInfo {
+    Symbol node1;
+    std::optional<Symbol> node2;
+    std::optional<Symbol> edge;
+    std::vector<Symbol> range_symbols;
+    bool can_flip;
+  };
+  std::vector<ExpansionInfo> infos;
+  infos.reserve(expansions.size());
+  for (const auto &expansion : expansions) {
+    ExpansionInfo info{.node1 = symbol_table.at(*expansion.node1->identifier_),
+                       .node2 = std::nullopt,
+                       .edge = std::nullopt,
+                       .range_symbols = {},
+                       .can_flip = expansion.edge && expansion.edge->type_ != EdgeAtom::Type::BREADTH_FIRST};
+    if (expansion.edge) {
+      info.node2 = symbol_table.at(*expansion.node2->identifier_);
+      info.edge = symbol_table.at(*expansion.edge->identifier_);
+    }
+    // Symbols bound outside of the matching are already available.
+    for (const auto &symbol : expansion.symbols_in_range) {
+      if (matching.expansion_symbols.contains(symbol)) info.range_symbols.push_back(symbol);
+    }
+    infos.push_back(std::move(info));
+  }
+
+  auto is_bound = [](const std::unordered_set<Symbol> &bound, const Symbol &symbol) { return bound.contains(symbol); };
+  auto bind = [](std::unordered_set<Symbol> &bound, const ExpansionInfo &info) {
+    bound.insert(info.node1);
+    if (info.node2) bound.insert(*info.node2);
+    if (info.edge) bound.insert(*info.edge);
+  };
+  auto can_expand = [&](const std::unordered_set<Symbol> &bound, size_t id) {
+    return std::all_of(infos[id].range_symbols.begin(), infos[id].range_symbols.end(),
+                       [&](const auto &symbol) { return is_bound(bound, symbol); });
+  };
+  // Returns the factor by which the expansion multiplies the number of rows
+  // and the number of vertices scanned if it starts a new part of the pattern.
+  auto expand = [&](const std::unordered_set<Symbol> &bound, size_t id) -> std::pair<double, double> {
+    const auto &info = infos[id];
+    const bool node1_bound = is_bound(bound, info.node1);
+    if (!info.node2) {
+      const auto cardinality = node1_bound ? 1.0 : node_cardinality(info.node1);
+      return {cardinality, node1_bound ? 0.0 : cardinality};
+    }
+    const bool node2_bound = is_bound(bound, *info.node2);
+    double factor = expansion_degrees[id] / vertex_count;
+    if (!node1_bound) factor *= node_cardinality(info.node1);
+    if (!node2_bound) factor *= node_cardinality(*info.node2);
+    double scanned = 0.0;
+    if (!node1_bound && !node2_bound) {
+      scanned = info.can_flip ? std::min(node_cardinality(info.node1), node_cardinality(*info.node2))
+                              : node_cardinality(info.node1);
+    }
+    return {factor, scanned};
+  };
+  auto bound_symbols_of = [&](uint64_t subset) {
+    std::unordered_set<Symbol> bound;
+    for (size_t id = 0; id < infos.size(); ++id) {
+      if (subset & (uint64_t{1} << id)) bind(bound, infos[id]);
+    }
+    return bound;
+  };
+
+  std::vector<size_t> order;
+  order.reserve(expansions.size());
+  if (expansions.size() <= kMaxExpansionsForExhaustiveOrdering) {
+    // The number of rows of a subset doesn't depend on the order of its
+    // expansions, so the cheapest order of each subset extends the cheapest
+    // order of one of its subsets with one expansion less.
+    const uint64_t subsets = uint64_t{1} << expansions.size();
+    std::vector<double> rows(subsets, 0.0);
+    std::vector<double> cost(subsets, std::numeric_limits<double>::infinity());
+    std::vector<size_t> last(subsets, 0);
+    rows[0] = 1.0;
+    cost[0] = 0.0;
+    for (uint64_t subset = 0; subset < subsets; ++subset) {
+      if (cost[subset] == std::numeric_limits<double>::infinity()) continue;
+      const auto bound = bound_symbols_of(subset);
+      for (size_t id = 0; id < infos.size(); ++id) {
+        if ((subset & (uint64_t{1} << id)) || !can_expand(bound, id)) continue;
+        const auto [factor, scanned] = expand(bound, id);
+        const auto next = subset | (uint64_t{1} << id);
+        rows[next] = rows[subset] * factor;
+        const auto next_cost = cost[subset] + scanned + rows[next];
+        if (next_cost < cost[next]) {
+          cost[next] = next_cost;
+          last[next] = id;
+        }
+      }
+    }
+    auto subset = subsets - 1;
+    if (cost[subset] == std::numeric_limits<double>::infinity()) return expansions;
+    while (subset != 0) {
+      order.push_back(last[subset]);
+      subset &= ~(uint64_t{1} << last[subset]);
+    }
+    std::reverse(order.begin(), order.end());
+  } else {
+    // Greedily take the expansion producing the fewest rows.
+    std::unordered_set<Symbol> bound;
+    std::vector<bool> used(infos.size(), false);
+    while (order.size() < infos.size()) {
+      std::optional<size_t> best;
+      double best_cost = std::numeric_limits<double>::infinity();
+      for (size_t id = 0; id < infos.size(); ++id) {
+        if (used[id] || !can_expand(bound, id)) continue;
+        const auto [factor, scanned] = expand(bound, id);
+        if (!best || factor + scanned < best_cost) {
+          best = id;
+          best_cost = factor + scanned;
+        }
+      }
+      if (!best) return expansions;
+      used[*best] = true;
+      bind(bound, infos[*best]);
+      order.push_back(*best);
+    }
+  }
+
+  std::vector<Expansion> ordered;
+  ordered.reserve(order.size());
+  std::unordered_set<Symbol> bound;
+  for (const auto id : order) {
+    auto expansion = expansions[id];
+    const auto &info = infos[id];
+    if (info.can_flip && !is_bound(bound, info.node1) &&
+        (is_bound(bound, *info.node2) || node_cardinality(*info.node2) < node_cardinality(info.node1))) {
+      std::swap(expansion.node1, expansion.node2);
+      expansion.is_flipped = true;
+      if (expansion.direction != EdgeAtom::Direction::BOTH) {
+        expansion.direction =
+            expansion.direction == EdgeAtom::Direction::IN ? EdgeAtom::Direction::OUT : EdgeAtom::Direction::IN;
+      }
+    }
+    bind(bound, info);
+    ordered.push_back(std::move(expansion));
+  }
+  return ordered;
+}
+
 }  // namespace impl
 
 }  // namespace memgraph::query::plan
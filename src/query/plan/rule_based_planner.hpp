@@ -90,6 +90,22 @@ bool HasBoundFilterSymbols(const std::unordered_set<Symbol> &bound_symbols, cons
 std::unordered_set<Symbol> GetSubqueryBoundSymbols(const std::vector<SingleQueryPart> &single_query_parts,
                                                    SymbolTable &symbol_table, AstStorage &storage);
 
+/// Returns the symbols of the outer scope which the leading WITH clause of the
+/// subquery imports into it, or no symbols if the subquery doesn't import any.
+std::vector<Symbol> GetSubqueryImportedSymbols(const std::vector<SingleQueryPart> &single_query_parts,
+                                               const SymbolTable &symbol_table,
+                                               const std::unordered_set<Symbol> &outer_scope_bound_symbols);
+
+/// Returns whether the values of the tree only depend on the graph and the
+/// values of the symbols it uses. That isn't the case if it calls procedures,
+/// functions of query modules or functions like rand(). If
+/// `across_executions` is set, the values must also stay the same in the other
+/// executions, so functions like timestamp() aren't deterministic either.
+bool IsDeterministic(utils::Visitable<HierarchicalTreeVisitor> &tree, bool across_executions = false);
+
+/// Returns whether the plan only reads the graph.
+bool IsReadOnly(LogicalOperator &plan);
+
 /// Utility function for iterating pattern atoms and accumulating a result.
 ///
 /// Each pattern is of the form `NodeAtom (, EdgeAtom, NodeAtom)*`. Therefore,
@@ -148,6 +164,22 @@ std::unique_ptr<LogicalOperator> GenWith(With &with, std::unique_ptr<LogicalOper
 std::unique_ptr<LogicalOperator> GenUnion(const CypherUnion &cypher_union, std::shared_ptr<LogicalOperator> left_op,
                                           std::shared_ptr<LogicalOperator> right_op, SymbolTable &symbol_table);
 
+/// Matchings with at most this many expansions are ordered by dynamic
+/// programming over all subsets of expansions, larger ones greedily.
+constexpr size_t kMaxExpansionsForExhaustiveOrdering = 10;
+
+/// Orders the expansions of the matching so that the sum of the estimated
+/// numbers of rows produced after each expansion is the smallest. The number
+/// of rows matching a set of expansions is estimated as the product of the
+/// cardinalities of its nodes and of `expansion_degrees[i] / vertex_count` for
+/// each of its edges. Nodes missing from `node_cardinalities` can be any
+/// vertex. Expansions are flipped so they start from the bound or the smaller
+/// node, and an expansion is placed only after the symbols used in its range
+/// are bound.
+std::vector<Expansion> OrderExpansionsByCost(const Matching &matching, const SymbolTable &symbol_table,
+                                             const std::unordered_map<Symbol, double> &node_cardinalities,
+                                             const std::vector<double> &expansion_degrees, double vertex_count);
+
 template <class TBoolOperator>
 Expression *BoolJoin(AstStorage &storage, Expression *expr1, Expression *expr2) {
   if (expr1 && expr2) {
@@ -158,6 +190,11 @@ Expression *BoolJoin(AstStorage &storage, Expression *expr1, Expression *expr2)
 
 }  // namespace impl
 
+/// Turns off the memoization of the results of the subqueries and the pattern
+/// filters in the plan. The results are memoized only in read queries, because
+/// a write can advance the command which changes the graph they see.
+void DisableSubqueryMemoization(LogicalOperator &plan);
+
 /// @brief Planner which uses hardcoded rules to produce operators.
 ///
 /// @sa MakeLogicalPlan
@@ -230,12 +267,18 @@ class RuleBasedPlanner {
             input_op = std::make_unique<plan::LoadCsv>(std::move(input_op), load_csv->file_, load_csv->with_header_,
                                                        load_csv->ignore_bad_, load_csv->delimiter_, load_csv->quote_,
                                                        load_csv->nullif_, row_sym);
+          } else if (auto *load_arrow = utils::Downcast<query::LoadArrow>(clause)) {
+            const auto &row_sym = context.symbol_table->at(*load_arrow->row_var_);
+            context.bound_symbols.insert(row_sym);
+
+            input_op = std::make_unique<plan::LoadArrow>(std::move(input_op), load_arrow->file_, row_sym,
+                                                         load_arrow->columns_, load_arrow->all_columns_);
           } else if (auto *foreach = utils::Downcast<query::Foreach>(clause)) {
             context.is_write_query = true;
             input_op = HandleForeachClause(foreach, std::move(input_op), *context.symbol_table, context.bound_symbols,
                                            single_query_part, merge_id);
           } else if (auto *call_sub = utils::Downcast<query::CallSubquery>(clause)) {
-            input_op = HandleSubquery(std::move(input_op), single_query_part.subqueries[subquery_id++],
+            input_op = HandleSubquery(std::move(input_op), *call_sub, single_query_part.subqueries[subquery_id++],
                                       *context.symbol_table, *context_->ast_storage);
           } else {
             throw utils::NotYetImplemented("clause '{}' conversion to operator(s)", clause->GetTypeInfo().name);
@@ -481,7 +524,12 @@ class RuleBasedPlanner {
                                                    std::vector<Symbol> &new_symbols,
                                                    std::unordered_map<Symbol, std::vector<Symbol>> &named_paths,
                                                    Filters &filters, storage::View view) {
-    for (const auto &expansion : matching.expansions) {
+    // Expansions which close a cycle are planned together with the expansion
+    // to their first node, see `FindClosingExpansions`.
+    std::vector<bool> intersected(matching.expansions.size(), false);
+    for (size_t i = 0; i < matching.expansions.size(); ++i) {
+      if (intersected[i]) continue;
+      const auto &expansion = matching.expansions[i];
       const auto &node1_symbol = symbol_table.at(*expansion.node1->identifier_);
       if (bound_symbols.insert(node1_symbol).second) {
         // We have just bound this symbol, so generate ScanAll which fills it.
@@ -493,12 +541,116 @@ class RuleBasedPlanner {
         last_op = GenFilters(std::move(last_op), bound_symbols, filters, storage, symbol_table);
       }
 
-      if (expansion.edge) {
+      if (!expansion.edge) continue;
+      auto closing = FindClosingExpansions(matching, i, symbol_table, bound_symbols);
+      if (closing.empty()) {
         last_op = GenExpand(std::move(last_op), expansion, symbol_table, bound_symbols, matching, storage, filters,
                             named_paths, new_symbols, view);
+        continue;
+      }
+      closing.insert(closing.begin(), i);
+      for (auto index : closing) intersected[index] = true;
+      last_op = GenIntersectExpand(std::move(last_op), closing, symbol_table, bound_symbols, matching, storage,
+                                   filters, named_paths, new_symbols, view);
+    }
+
+    return last_op;
+  }
+
+  /// Returns the expansions after the expansion at `index` which connect its
+  /// new node to other bound nodes, like `(c)-->(a)` after `(b)-->(c)` in
+  /// `(a)-->(b)-->(c)-->(a)`. Such a cycle is matched by intersecting the
+  /// edges of the bound nodes, instead of expanding all edges of `b` and then
+  /// checking each for an edge to `a`. Only expansions of single edges are
+  /// intersected, and at most one to each bound node.
+  std::vector<size_t> FindClosingExpansions(const Matching &matching, size_t index, const SymbolTable &symbol_table,
+                                            const std::unordered_set<Symbol> &bound_symbols) {
+    const auto &expansion = matching.expansions[index];
+    const auto &node_symbol = symbol_table.at(*expansion.node2->identifier_);
+    if (expansion.edge->IsVariable() || utils::Contains(bound_symbols, node_symbol)) return {};
+    std::unordered_set<Symbol> ends{symbol_table.at(*expansion.node1->identifier_)};
+    std::vector<size_t> closing;
+    for (auto other = index + 1; other < matching.expansions.size(); ++other) {
+      const auto &candidate = matching.expansions[other];
+      if (!candidate.edge || candidate.edge->IsVariable()) continue;
+      const auto &node1 = symbol_table.at(*candidate.node1->identifier_);
+      const auto &node2 = symbol_table.at(*candidate.node2->identifier_);
+      if (node1 == node2 || (node1 != node_symbol && node2 != node_symbol)) continue;
+      const auto &end = node1 == node_symbol ? node2 : node1;
+      if (utils::Contains(bound_symbols, end) && ends.insert(end).second) closing.push_back(other);
+    }
+    return closing;
+  }
+
+  std::unique_ptr<LogicalOperator> GenIntersectExpand(std::unique_ptr<LogicalOperator> last_op,
+                                                      const std::vector<size_t> &expansions,
+                                                      const SymbolTable &symbol_table,
+                                                      std::unordered_set<Symbol> &bound_symbols,
+                                                      const Matching &matching, AstStorage &storage, Filters &filters,
+                                                      std::unordered_map<Symbol, std::vector<Symbol>> &named_paths,
+                                                      std::vector<Symbol> &new_symbols, storage::View view) {
+    const auto &node_symbol = symbol_table.at(*matching.expansions[expansions.front()].node2->identifier_);
+    std::vector<IntersectEdge> edges;
+    edges.reserve(expansions.size());
+    for (auto index : expansions) {
+      const auto &expansion = matching.expansions[index];
+      auto input_symbol = symbol_table.at(*expansion.node1->identifier_);
+      auto direction = expansion.direction;
+      // The edge should go from the bound node to the new one.
+      if (input_symbol == node_symbol) {
+        input_symbol = symbol_table.at(*expansion.node2->identifier_);
+        if (direction != EdgeAtom::Direction::BOTH) {
+          direction = direction == EdgeAtom::Direction::IN ? EdgeAtom::Direction::OUT : EdgeAtom::Direction::IN;
+        }
       }
+      const auto &edge_symbol = symbol_table.at(*expansion.edge->identifier_);
+      MG_ASSERT(!utils::Contains(bound_symbols, edge_symbol), "Existing edges are not supported");
+      std::vector<storage::EdgeTypeId> edge_types;
+      edge_types.reserve(expansion.edge->edge_types_.size());
+      for (const auto &type : expansion.edge->edge_types_) {
+        edge_types.push_back(GetEdgeType(type));
+      }
+      edges.push_back(IntersectEdge{input_symbol, edge_symbol, direction, std::move(edge_types)});
+    }
+    last_op = std::make_unique<IntersectExpand>(std::move(last_op), node_symbol, edges, view);
+
+    bound_symbols.insert(node_symbol);
+    new_symbols.emplace_back(node_symbol);
+    // Bind the edges one by one, so that each pair of them is checked for
+    // uniqueness only once.
+    for (const auto &edge : edges) {
+      bound_symbols.insert(edge.edge_symbol);
+      new_symbols.emplace_back(edge.edge_symbol);
+      last_op = GenEdgeUniquenessFilter(std::move(last_op), edge.edge_symbol, matching, bound_symbols);
     }
 
+    last_op = GenFilters(std::move(last_op), bound_symbols, filters, storage, symbol_table);
+    last_op = impl::GenNamedPaths(std::move(last_op), bound_symbols, named_paths);
+    last_op = GenFilters(std::move(last_op), bound_symbols, filters, storage, symbol_table);
+
+    return last_op;
+  }
+
+  // Ensure Cyphermorphism (different edge symbols always map to different
+  // edges) for the just bound `edge_symbol`.
+  std::unique_ptr<LogicalOperator> GenEdgeUniquenessFilter(std::unique_ptr<LogicalOperator> last_op,
+                                                           const Symbol &edge_symbol, const Matching &matching,
+                                                           const std::unordered_set<Symbol> &bound_symbols) {
+    for (const auto &edge_symbols : matching.edge_symbols) {
+      if (edge_symbols.find(edge_symbol) == edge_symbols.end()) {
+        continue;
+      }
+      std::vector<Symbol> other_symbols;
+      for (const auto &symbol : edge_symbols) {
+        if (symbol == edge_symbol || bound_symbols.find(symbol) == bound_symbols.end()) {
+          continue;
+        }
+        other_symbols.push_back(symbol);
+      }
+      if (!other_symbols.empty()) {
+        last_op = std::make_unique<EdgeUniquenessFilter>(std::move(last_op), edge_symbol, other_symbols);
+      }
+    }
     return last_op;
   }
 
@@ -587,23 +739,7 @@ class RuleBasedPlanner {
       new_symbols.emplace_back(node_symbol);
     }
 
-    // Ensure Cyphermorphism (different edge symbols always map to
-    // different edges).
-    for (const auto &edge_symbols : matching.edge_symbols) {
-      if (edge_symbols.find(edge_symbol) == edge_symbols.end()) {
-        continue;
-      }
-      std::vector<Symbol> other_symbols;
-      for (const auto &symbol : edge_symbols) {
-        if (symbol == edge_symbol || bound_symbols.find(symbol) == bound_symbols.end()) {
-          continue;
-        }
-        other_symbols.push_back(symbol);
-      }
-      if (!other_symbols.empty()) {
-        last_op = std::make_unique<EdgeUniquenessFilter>(std::move(last_op), edge_symbol, other_symbols);
-      }
-    }
+    last_op = GenEdgeUniquenessFilter(std::move(last_op), edge_symbol, matching, bound_symbols);
 
     last_op = GenFilters(std::move(last_op), bound_symbols, filters, storage, symbol_table);
     last_op = impl::GenNamedPaths(std::move(last_op), bound_symbols, named_paths);
@@ -633,7 +769,7 @@ class RuleBasedPlanner {
                                            symbol);
   }
 
-  std::unique_ptr<LogicalOperator> HandleSubquery(std::unique_ptr<LogicalOperator> last_op,
+  std::unique_ptr<LogicalOperator> HandleSubquery(std::unique_ptr<LogicalOperator> last_op, CallSubquery &call_subquery,
                                                   std::shared_ptr<QueryParts> subquery, SymbolTable &symbol_table,
                                                   AstStorage &storage) {
     std::unordered_set<Symbol> outer_scope_bound_symbols;
@@ -654,7 +790,17 @@ class RuleBasedPlanner {
       subquery_has_return = false;
     }
 
-    last_op = std::make_unique<Apply>(std::move(last_op), std::move(subquery_op), subquery_has_return);
+    // A subquery which only reads the graph returns the same rows for the same
+    // imported values, so they are memoized.
+    const bool memoize_results = subquery_has_return && impl::IsReadOnly(*subquery_op) &&
+                                 impl::IsDeterministic(*call_subquery.cypher_query_);
+    auto imported_symbols = impl::GetSubqueryImportedSymbols(subquery->query_parts[0].single_query_parts,
+                                                             symbol_table, context_->bound_symbols);
+
+    auto apply = std::make_unique<Apply>(std::move(last_op), std::move(subquery_op), subquery_has_return);
+    apply->memoize_results_ = memoize_results;
+    apply->correlated_symbols_ = std::move(imported_symbols);
+    last_op = std::move(apply);
 
     if (context_->is_write_query) {
       last_op = std::make_unique<Accumulate>(std::move(last_op), last_op->ModifiedSymbols(symbol_table), true);
@@ -693,9 +839,28 @@ class RuleBasedPlanner {
 
     last_op = std::make_unique<Limit>(std::move(last_op), storage.Create<PrimitiveLiteral>(1));
 
-    last_op = std::make_unique<EvaluatePatternFilter>(std::move(last_op), matching.symbol.value());
+    auto pattern_filter = std::make_unique<EvaluatePatternFilter>(std::move(last_op), matching.symbol.value());
+    // The pattern is matched again only for the values of the bound symbols it
+    // reads which it wasn't matched for yet.
+    UsedSymbolsCollector collector(symbol_table);
+    bool deterministic = true;
+    for (const auto &expansion : matching.expansions) {
+      for (PatternAtom *atom : std::initializer_list<PatternAtom *>{expansion.node1, expansion.edge, expansion.node2}) {
+        if (!atom) continue;
+        atom->Accept(collector);
+        deterministic = deterministic && impl::IsDeterministic(*atom);
+      }
+    }
+    for (const auto &filter : matching.filters) {
+      filter.expression->Accept(collector);
+      deterministic = deterministic && impl::IsDeterministic(*filter.expression);
+    }
+    pattern_filter->memoize_results_ = deterministic;
+    for (const auto &symbol : collector.symbols_) {
+      if (bound_symbols.contains(symbol)) pattern_filter->correlated_symbols_.push_back(symbol);
+    }
 
-    return last_op;
+    return pattern_filter;
   }
 
   std::vector<std::shared_ptr<LogicalOperator>> ExtractPatternFilters(Filters &filters, const SymbolTable &symbol_table,
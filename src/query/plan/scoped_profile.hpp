@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -16,19 +16,39 @@
 #include "query/context.hpp"
 #include "query/plan/profile.hpp"
 #include "utils/likely.hpp"
+#include "utils/tracepoint.hpp"
 #include "utils/tsc.hpp"
 
 namespace memgraph::query::plan {
 
+/// Records the cycles a sampled pull of the named logical operator took,
+/// including the pulls of its inputs, in the latency histogram of the
+/// operator's category.
+void MeasureSampledPull(const char *name, uint64_t cycles) noexcept;
+
 /**
  * A RAII class used for profiling logical operators. Instances of this class
  * update the profiling data stored within the `ExecutionContext` object and build
  * up a tree of `ProfilingStats` instances. The structure of the `ProfilingStats`
  * tree depends on the `LogicalOperator`s that were executed.
+ *
+ * Outside of profile queries, one in `kPullSampleInterval` pulls of each
+ * thread is timed and recorded by `MeasureSampledPull`, which keeps the
+ * overhead of the other pulls to a counter increment.
+ *
+ * Every pull also fires the `operator__pull__start` and `operator__pull__done`
+ * USDT probes with the query id and the operator name.
  */
 class ScopedProfile {
  public:
-  ScopedProfile(uint64_t key, const char *name, query::ExecutionContext *context) noexcept : context_(context) {
+  static constexpr uint32_t kPullSampleInterval = 1024;
+
+  ScopedProfile(uint64_t key, const char *name, query::ExecutionContext *context) noexcept
+      : context_(context), name_(name) {
+    MG_TRACEPOINT(operator__pull__start, context_->query_id, name_);
+    if (UNLIKELY((++pulls_ & (kPullSampleInterval - 1)) == 0)) {
+      sample_start_ = utils::ReadTSC();
+    }
     if (UNLIKELY(context_->is_profile_query)) {
       root_ = context_->stats_root;
 
@@ -67,6 +87,10 @@ class ScopedProfile {
       // Restore the old root ("pop")
       context_->stats_root = root_;
     }
+    if (UNLIKELY(sample_start_ != 0)) {
+      MeasureSampledPull(name_, utils::ReadTSC() - sample_start_);
+    }
+    MG_TRACEPOINT(operator__pull__done, context_->query_id, name_);
   }
 
  private:
@@ -74,6 +98,10 @@ class ScopedProfile {
   ProfilingStats *root_{nullptr};
   ProfilingStats *stats_{nullptr};
   unsigned long long start_time_{0};
+  const char *name_;
+  uint64_t sample_start_{0};
+
+  static inline thread_local uint32_t pulls_{0};
 };
 
 }  // namespace memgraph::query::plan
@@ -0,0 +1,171 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/plan/sketches.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <vector>
+
+#include "utils/logging.hpp"
+
+namespace memgraph::query::plan {
+
+namespace {
+
+// The finalizer of SplitMix64, which spreads the hashes of small integers,
+// which are often the integers themselves, over all the bits.
+uint64_t MixHash(uint64_t hash) {
+  hash ^= hash >> 30U;
+  hash *= 0xbf58476d1ce4e5b9ULL;
+  hash ^= hash >> 27U;
+  hash *= 0x94d049bb133111ebULL;
+  hash ^= hash >> 31U;
+  return hash;
+}
+
+struct Centroid {
+  double mean;
+  double weight;
+};
+
+std::vector<Centroid> DecodeCentroids(std::string_view digest) {
+  std::vector<Centroid> centroids(digest.size() / sizeof(Centroid));
+  std::memcpy(centroids.data(), digest.data(), centroids.size() * sizeof(Centroid));
+  return centroids;
+}
+
+void AppendCentroid(TypedValue::TString *digest, const Centroid &centroid) {
+  digest->append(reinterpret_cast<const char *>(&centroid), sizeof(Centroid));
+}
+
+// The k1 scale function of the t-digest, which maps the percentiles to the
+// centroid indices. A centroid spans at most one unit of the scale, so the
+// centroids near the ends of the distribution are small.
+double Scale(double percentile) {
+  return kTDigestCompression / (2 * std::numbers::pi) * std::asin(2 * std::clamp(percentile, 0.0, 1.0) - 1);
+}
+
+// Merges the neighbouring centroids as long as they span at most one unit of
+// the scale.
+void Compress(std::vector<Centroid> *centroids) {
+  if (centroids->empty()) return;
+  std::sort(centroids->begin(), centroids->end(), [](const auto &lhs, const auto &rhs) { return lhs.mean < rhs.mean; });
+  double total_weight = 0;
+  for (const auto &centroid : *centroids) total_weight += centroid.weight;
+
+  size_t merged = 0;
+  double weight_before = 0;
+  double scale_before = Scale(0);
+  for (size_t i = 1; i < centroids->size(); ++i) {
+    auto &current = (*centroids)[merged];
+    const auto &next = (*centroids)[i];
+    const auto weight = current.weight + next.weight;
+    if (Scale((weight_before + weight) / total_weight) - scale_before <= 1) {
+      current.mean += (next.mean - current.mean) * next.weight / weight;
+      current.weight = weight;
+      continue;
+    }
+    weight_before += current.weight;
+    scale_before = Scale(weight_before / total_weight);
+    (*centroids)[++merged] = next;
+  }
+  centroids->resize(merged + 1);
+}
+
+void CompressDigest(TypedValue::TString *digest) {
+  auto centroids = DecodeCentroids(*digest);
+  Compress(&centroids);
+  digest->assign(reinterpret_cast<const char *>(centroids.data()), centroids.size() * sizeof(Centroid));
+}
+
+}  // namespace
+
+TypedValue::TString HyperLogLogCreate(utils::MemoryResource *memory) {
+  return TypedValue::TString(kHyperLogLogSize, '\0', memory);
+}
+
+void HyperLogLogAdd(TypedValue::TString *sketch, size_t hash) {
+  DMG_ASSERT(sketch->size() == kHyperLogLogSize, "Invalid HyperLogLog sketch");
+  const auto mixed = MixHash(hash);
+  const auto index = mixed >> (64 - kHyperLogLogPrecision);
+  // The rank is the position of the first set bit among the remaining bits.
+  const auto remaining = mixed << kHyperLogLogPrecision;
+  const auto rank = remaining == 0 ? 64 - kHyperLogLogPrecision + 1 : std::countl_zero(remaining) + 1;
+  auto &reg = (*sketch)[index];
+  if (rank > static_cast<uint8_t>(reg)) reg = static_cast<char>(rank);
+}
+
+void HyperLogLogMerge(TypedValue::TString *sketch, std::string_view other) {
+  DMG_ASSERT(sketch->size() == kHyperLogLogSize && other.size() == kHyperLogLogSize, "Invalid HyperLogLog sketch");
+  for (size_t i = 0; i < kHyperLogLogSize; ++i) {
+    if (static_cast<uint8_t>(other[i]) > static_cast<uint8_t>((*sketch)[i])) (*sketch)[i] = other[i];
+  }
+}
+
+int64_t HyperLogLogEstimate(std::string_view sketch) {
+  DMG_ASSERT(sketch.size() == kHyperLogLogSize, "Invalid HyperLogLog sketch");
+  constexpr auto kRegisters = static_cast<double>(kHyperLogLogSize);
+  double sum = 0;
+  size_t zeros = 0;
+  for (const auto reg : sketch) {
+    sum += std::ldexp(1.0, -static_cast<int>(static_cast<uint8_t>(reg)));
+    zeros += reg == 0 ? 1 : 0;
+  }
+  const double alpha = 0.7213 / (1 + 1.079 / kRegisters);
+  double estimate = alpha * kRegisters * kRegisters / sum;
+  // Small cardinalities are counted more accurately by the empty registers.
+  // With 64-bit hashes there are no collisions to correct for large ones.
+  if (estimate <= 2.5 * kRegisters && zeros != 0) {
+    estimate = kRegisters * std::log(kRegisters / static_cast<double>(zeros));
+  }
+  return std::llround(estimate);
+}
+
+void TDigestAdd(TypedValue::TString *digest, double value) {
+  if (std::isnan(value)) return;
+  AppendCentroid(digest, {value, 1});
+  if (digest->size() > kTDigestBufferedCentroids * sizeof(Centroid)) CompressDigest(digest);
+}
+
+void TDigestMerge(TypedValue::TString *digest, std::string_view other) {
+  digest->append(other);
+  if (digest->size() > kTDigestBufferedCentroids * sizeof(Centroid)) CompressDigest(digest);
+}
+
+std::optional<double> TDigestPercentile(std::string_view digest, double percentile) {
+  auto centroids = DecodeCentroids(digest);
+  if (centroids.empty()) return std::nullopt;
+  Compress(&centroids);
+  double total_weight = 0;
+  for (const auto &centroid : centroids) total_weight += centroid.weight;
+
+  // Each centroid is taken to be at the middle of the weight it spans, and the
+  // values between the middles are interpolated.
+  const auto target = std::clamp(percentile, 0.0, 1.0) * total_weight;
+  double weight_before = 0;
+  for (size_t i = 0; i < centroids.size(); ++i) {
+    const auto middle = weight_before + centroids[i].weight / 2;
+    if (target <= middle) {
+      if (i == 0) return centroids[0].mean;
+      const auto previous_middle = weight_before - centroids[i - 1].weight / 2;
+      const auto fraction = (target - previous_middle) / (middle - previous_middle);
+      return centroids[i - 1].mean + fraction * (centroids[i].mean - centroids[i - 1].mean);
+    }
+    weight_before += centroids[i].weight;
+  }
+  return centroids.back().mean;
+}
+
+}  // namespace memgraph::query::plan
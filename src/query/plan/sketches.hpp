@@ -0,0 +1,69 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Sketches of the approximate aggregations. A sketch summarizes any number of
+/// values in a bounded amount of memory, and the sketches of disjoint parts of
+/// the input can be merged into the sketch of the whole input. The sketches
+/// are kept in strings, so they are aggregated, merged and spilled like the
+/// other aggregation values.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "query/typed_value.hpp"
+
+namespace memgraph::query::plan {
+
+/// Number of bits of the hash which select the register of the HyperLogLog
+/// sketch. The standard error of the estimate is 1.04 / sqrt(2^precision),
+/// which is 1.6%.
+inline constexpr int kHyperLogLogPrecision = 12;
+/// Number of bytes of the HyperLogLog sketch, one for each register.
+inline constexpr size_t kHyperLogLogSize = size_t{1} << kHyperLogLogPrecision;
+
+/// Returns the empty HyperLogLog sketch.
+TypedValue::TString HyperLogLogCreate(utils::MemoryResource *memory);
+
+/// Adds the hash of a value to the HyperLogLog sketch. The hash doesn't need
+/// to be uniformly distributed, it's mixed first.
+void HyperLogLogAdd(TypedValue::TString *sketch, size_t hash);
+
+/// Merges the other sketch into the sketch, which then estimates the number of
+/// distinct values added to any of them.
+void HyperLogLogMerge(TypedValue::TString *sketch, std::string_view other);
+
+/// Returns the estimated number of distinct values added to the sketch.
+int64_t HyperLogLogEstimate(std::string_view sketch);
+
+/// Compression of the t-digest. The digest keeps at most about this many
+/// centroids once it's compressed, and the percentiles near the ends of the
+/// distribution are estimated more accurately than the ones in the middle.
+inline constexpr double kTDigestCompression = 100;
+/// Number of centroids the t-digest keeps before it's compressed.
+inline constexpr size_t kTDigestBufferedCentroids = 500;
+
+/// Adds the value to the t-digest, which starts as an empty string. NaN values
+/// are ignored.
+void TDigestAdd(TypedValue::TString *digest, double value);
+
+/// Merges the other t-digest into the digest.
+void TDigestMerge(TypedValue::TString *digest, std::string_view other);
+
+/// Returns the estimated value at the `percentile` between 0 and 1 of the
+/// values added to the t-digest, interpolating between the centroids, or
+/// std::nullopt if the digest is empty.
+std::optional<double> TDigestPercentile(std::string_view digest, double percentile);
+
+}  // namespace memgraph::query::plan
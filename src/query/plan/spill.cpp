@@ -0,0 +1,245 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/plan/spill.hpp"
+
+#include <array>
+#include <bit>
+#include <system_error>
+
+#include "query/exceptions.hpp"
+#include "query/path.hpp"
+#include "utils/logging.hpp"
+#include "utils/uuid.hpp"
+
+namespace memgraph::query::plan {
+
+bool CanSpill(const TypedValue &value) {
+  switch (value.type()) {
+    case TypedValue::Type::List:
+      return std::all_of(value.ValueList().begin(), value.ValueList().end(),
+                         [](const auto &elem) { return CanSpill(elem); });
+    case TypedValue::Type::Map:
+      return std::all_of(value.ValueMap().begin(), value.ValueMap().end(),
+                         [](const auto &kv) { return CanSpill(kv.second); });
+    case TypedValue::Type::Graph:
+      return false;
+    default:
+      return true;
+  }
+}
+
+size_t EstimateSize(const TypedValue &value) {
+  size_t size = sizeof(TypedValue);
+  switch (value.type()) {
+    case TypedValue::Type::String:
+      size += value.ValueString().size();
+      break;
+    case TypedValue::Type::List:
+      for (const auto &elem : value.ValueList()) size += EstimateSize(elem);
+      break;
+    case TypedValue::Type::Map:
+      // Each entry is a tree node with the key and the value.
+      for (const auto &[key, elem] : value.ValueMap()) size += 4 * sizeof(void *) + key.size() + EstimateSize(elem);
+      break;
+    case TypedValue::Type::Path:
+      size += value.ValuePath().vertices().size() * sizeof(VertexAccessor) +
+              value.ValuePath().edges().size() * sizeof(EdgeAccessor);
+      break;
+    default:
+      break;
+  }
+  return size;
+}
+
+SpillFile::SpillFile(const std::filesystem::path &directory) {
+  std::error_code error_code;
+  std::filesystem::create_directories(directory, error_code);
+  if (error_code) {
+    throw QueryRuntimeException("Couldn't create the directory {} for the temporary query files: {}",
+                                directory.string(), error_code.message());
+  }
+  path_ = directory / ("spill_" + utils::GenerateUUID());
+  output_.Open(path_, utils::OutputFile::Mode::OVERWRITE_EXISTING);
+}
+
+SpillFile::~SpillFile() {
+  if (output_.IsOpen()) output_.Close();
+  if (input_.IsOpen()) input_.Close();
+  std::error_code error_code;
+  if (!std::filesystem::remove(path_, error_code) && error_code) {
+    spdlog::warn("Couldn't remove the temporary query file {}: {}", path_.string(), error_code.message());
+  }
+}
+
+void SpillFile::Write(const TypedValue &value) {
+  DMG_ASSERT(output_.IsOpen(), "Writing to a spill file which is being read");
+  WriteValue(value);
+  ++written_values_;
+}
+
+TypedValue SpillFile::Read(utils::MemoryResource *memory) {
+  MG_ASSERT(!AtEnd(), "Reading past the end of a spill file");
+  if (output_.IsOpen()) {
+    output_.Close();
+    if (!input_.Open(path_)) throw QueryRuntimeException("Couldn't open the temporary query file {}", path_.string());
+  }
+  ++read_values_;
+  return ReadValue(memory);
+}
+
+template <typename T>
+void SpillFile::WriteRaw(const T &value) {
+  const auto bytes = std::bit_cast<std::array<uint8_t, sizeof(T)>>(value);
+  output_.Write(bytes.data(), bytes.size());
+}
+
+template <typename T>
+T SpillFile::ReadRaw() {
+  std::array<uint8_t, sizeof(T)> bytes;
+  if (!input_.Read(bytes.data(), bytes.size())) {
+    throw QueryRuntimeException("Couldn't read the temporary query file {}", path_.string());
+  }
+  return std::bit_cast<T>(bytes);
+}
+
+void SpillFile::WriteValue(const TypedValue &value) {
+  WriteRaw(static_cast<uint8_t>(value.type()));
+  switch (value.type()) {
+    case TypedValue::Type::Null:
+      break;
+    case TypedValue::Type::Bool:
+      WriteRaw(value.ValueBool());
+      break;
+    case TypedValue::Type::Int:
+      WriteRaw(value.ValueInt());
+      break;
+    case TypedValue::Type::Double:
+      WriteRaw(value.ValueDouble());
+      break;
+    case TypedValue::Type::String:
+      WriteRaw(static_cast<uint64_t>(value.ValueString().size()));
+      output_.Write(value.ValueString().data(), value.ValueString().size());
+      break;
+    case TypedValue::Type::List:
+      WriteRaw(static_cast<uint64_t>(value.ValueList().size()));
+      for (const auto &elem : value.ValueList()) WriteValue(elem);
+      break;
+    case TypedValue::Type::Map:
+      WriteRaw(static_cast<uint64_t>(value.ValueMap().size()));
+      for (const auto &[key, elem] : value.ValueMap()) {
+        WriteRaw(static_cast<uint64_t>(key.size()));
+        output_.Write(key.data(), key.size());
+        WriteValue(elem);
+      }
+      break;
+    // The accessors only point to the objects, which are kept alive by the
+    // transaction.
+    case TypedValue::Type::Vertex:
+      WriteRaw(value.ValueVertex());
+      break;
+    case TypedValue::Type::Edge:
+      WriteRaw(value.ValueEdge());
+      break;
+    case TypedValue::Type::Path: {
+      const auto &path = value.ValuePath();
+      WriteRaw(static_cast<uint64_t>(path.vertices().size()));
+      for (const auto &vertex : path.vertices()) WriteRaw(vertex);
+      for (const auto &edge : path.edges()) WriteRaw(edge);
+      break;
+    }
+    case TypedValue::Type::Date:
+      WriteRaw(value.ValueDate());
+      break;
+    case TypedValue::Type::LocalTime:
+      WriteRaw(value.ValueLocalTime());
+      break;
+    case TypedValue::Type::LocalDateTime:
+      WriteRaw(value.ValueLocalDateTime());
+      break;
+    case TypedValue::Type::Duration:
+      WriteRaw(value.ValueDuration());
+      break;
+    case TypedValue::Type::Graph:
+      LOG_FATAL("Graph values can't be spilled");
+  }
+}
+
+TypedValue SpillFile::ReadValue(utils::MemoryResource *memory) {
+  const auto type = static_cast<TypedValue::Type>(ReadRaw<uint8_t>());
+  switch (type) {
+    case TypedValue::Type::Null:
+      return TypedValue(memory);
+    case TypedValue::Type::Bool:
+      return TypedValue(ReadRaw<bool>(), memory);
+    case TypedValue::Type::Int:
+      return TypedValue(ReadRaw<int64_t>(), memory);
+    case TypedValue::Type::Double:
+      return TypedValue(ReadRaw<double>(), memory);
+    case TypedValue::Type::String: {
+      TypedValue::TString string(ReadRaw<uint64_t>(), '\0', memory);
+      if (!input_.Read(reinterpret_cast<uint8_t *>(string.data()), string.size())) {
+        throw QueryRuntimeException("Couldn't read the temporary query file {}", path_.string());
+      }
+      return TypedValue(std::move(string), memory);
+    }
+    case TypedValue::Type::List: {
+      TypedValue::TVector list(memory);
+      const auto size = ReadRaw<uint64_t>();
+      list.reserve(size);
+      for (uint64_t i = 0; i < size; ++i) list.emplace_back(ReadValue(memory));
+      return TypedValue(std::move(list), memory);
+    }
+    case TypedValue::Type::Map: {
+      TypedValue::TMap map(memory);
+      const auto size = ReadRaw<uint64_t>();
+      for (uint64_t i = 0; i < size; ++i) {
+        TypedValue::TString key(ReadRaw<uint64_t>(), '\0', memory);
+        if (!input_.Read(reinterpret_cast<uint8_t *>(key.data()), key.size())) {
+          throw QueryRuntimeException("Couldn't read the temporary query file {}", path_.string());
+        }
+        auto elem = ReadValue(memory);
+        map.emplace(std::move(key), std::move(elem));
+      }
+      return TypedValue(std::move(map), memory);
+    }
+    case TypedValue::Type::Vertex:
+      return TypedValue(ReadRaw<VertexAccessor>(), memory);
+    case TypedValue::Type::Edge:
+      return TypedValue(ReadRaw<EdgeAccessor>(), memory);
+    case TypedValue::Type::Path: {
+      const auto num_vertices = ReadRaw<uint64_t>();
+      if (num_vertices == 0) return TypedValue(Path(memory), memory);
+      std::vector<VertexAccessor> vertices;
+      vertices.reserve(num_vertices);
+      for (uint64_t i = 0; i < num_vertices; ++i) vertices.push_back(ReadRaw<VertexAccessor>());
+      Path path(vertices.front(), memory);
+      for (uint64_t i = 1; i < num_vertices; ++i) {
+        path.Expand(ReadRaw<EdgeAccessor>());
+        path.Expand(vertices[i]);
+      }
+      return TypedValue(std::move(path), memory);
+    }
+    case TypedValue::Type::Date:
+      return TypedValue(ReadRaw<utils::Date>(), memory);
+    case TypedValue::Type::LocalTime:
+      return TypedValue(ReadRaw<utils::LocalTime>(), memory);
+    case TypedValue::Type::LocalDateTime:
+      return TypedValue(ReadRaw<utils::LocalDateTime>(), memory);
+    case TypedValue::Type::Duration:
+      return TypedValue(ReadRaw<utils::Duration>(), memory);
+    case TypedValue::Type::Graph:
+      break;
+  }
+  throw QueryRuntimeException("Invalid value in the temporary query file {}", path_.string());
+}
+
+}  // namespace memgraph::query::plan
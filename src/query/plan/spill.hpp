@@ -0,0 +1,82 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+#include "query/typed_value.hpp"
+#include "utils/file.hpp"
+#include "utils/memory.hpp"
+
+namespace memgraph::query::plan {
+
+/// Number of files among which the operators which hash their rows partition
+/// their spilled state. Each partition is read back into memory at once.
+inline constexpr size_t kSpillPartitions = 16;
+
+/// Returns true if the value can be written to a `SpillFile`. Graph values
+/// can't be, so the operators keep the rows containing them in memory.
+bool CanSpill(const TypedValue &value);
+
+/// Returns the approximate number of bytes the value takes in memory, used by
+/// the operators to decide when to spill their state.
+size_t EstimateSize(const TypedValue &value);
+
+/// Temporary file to which the operators write values which don't fit into
+/// their memory budget. The values are first all written and then read back in
+/// the same order.
+///
+/// Vertices and edges are written as their accessors, so the file can only be
+/// read by the transaction which wrote it. The file is removed when the object
+/// is destroyed.
+class SpillFile {
+ public:
+  /// Creates a new file with a unique name in `directory`.
+  /// @throw QueryRuntimeException if the directory can't be created.
+  explicit SpillFile(const std::filesystem::path &directory);
+  ~SpillFile();
+
+  SpillFile(const SpillFile &) = delete;
+  SpillFile &operator=(const SpillFile &) = delete;
+  SpillFile(SpillFile &&) = delete;
+  SpillFile &operator=(SpillFile &&) = delete;
+
+  /// Writes the value, which must satisfy `CanSpill`.
+  void Write(const TypedValue &value);
+
+  /// Reads the next written value. The first read finishes the writing.
+  /// @throw QueryRuntimeException if the file can't be read.
+  TypedValue Read(utils::MemoryResource *memory);
+
+  /// Returns true if all written values have been read.
+  bool AtEnd() const { return read_values_ == written_values_; }
+
+  uint64_t written_values() const { return written_values_; }
+
+ private:
+  void WriteValue(const TypedValue &value);
+  TypedValue ReadValue(utils::MemoryResource *memory);
+  template <typename T>
+  void WriteRaw(const T &value);
+  template <typename T>
+  T ReadRaw();
+
+  std::filesystem::path path_;
+  utils::OutputFile output_;
+  utils::InputFile input_;
+  uint64_t written_values_{0};
+  uint64_t read_values_{0};
+};
+
+}  // namespace memgraph::query::plan
@@ -0,0 +1,51 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/plan/subquery_cache.hpp"
+
+#include <algorithm>
+
+#include "query/interpret/frame.hpp"
+
+namespace memgraph::query::plan {
+
+bool SubqueryResultCache::KeyEqual::operator()(const Row &left, const Row &right) const {
+  return std::equal(left.begin(), left.end(), right.begin(), right.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.type() == rhs.type() && TypedValue::BoolEqual{}(lhs, rhs);
+  });
+}
+
+SubqueryResultCache::Row SubqueryResultCache::MakeKey(const Frame &frame, const std::vector<Symbol> &symbols) const {
+  Row key(memory());
+  key.reserve(symbols.size());
+  for (const auto &symbol : symbols) key.emplace_back(frame[symbol]);
+  return key;
+}
+
+const SubqueryResultCache::Rows *SubqueryResultCache::Find(const Row &key) const {
+  auto it = results_.find(key);
+  return it == results_.end() ? nullptr : &it->second;
+}
+
+void SubqueryResultCache::Insert(Row key, Rows rows) {
+  // A key without rows takes space too.
+  const auto size = std::max<size_t>(rows.size(), 1);
+  if (rows_ + size > kMaxRows) return;
+  rows_ += size;
+  results_.emplace(std::move(key), std::move(rows));
+}
+
+void SubqueryResultCache::Clear() {
+  results_.clear();
+  rows_ = 0;
+}
+
+}  // namespace memgraph::query::plan
@@ -0,0 +1,75 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "query/frontend/semantic/symbol.hpp"
+#include "query/typed_value.hpp"
+#include "utils/fnv.hpp"
+#include "utils/memory.hpp"
+#include "utils/pmr/unordered_map.hpp"
+#include "utils/pmr/vector.hpp"
+
+namespace memgraph::query {
+
+class Frame;
+
+namespace plan {
+
+/// Rows produced by a subquery or a pattern filter, memoized by the values of
+/// the symbols it reads from the outer scope. A subquery which only reads the
+/// graph in a deterministic way produces the same rows for the same values, so
+/// it's executed once for each distinct combination of them instead of once
+/// for each input row.
+class SubqueryResultCache {
+ public:
+  using Row = utils::pmr::vector<TypedValue>;
+  using Rows = utils::pmr::vector<Row>;
+
+  /// The most rows kept in the cache. Once it's full, the results of the other
+  /// combinations of values aren't memoized.
+  static constexpr size_t kMaxRows = size_t{1} << 16U;
+
+  explicit SubqueryResultCache(utils::MemoryResource *memory) : results_(memory) {}
+
+  /// Returns the values of the symbols in the frame, which are the key of the
+  /// rows produced for them.
+  Row MakeKey(const Frame &frame, const std::vector<Symbol> &symbols) const;
+
+  /// Returns the rows memoized for the key or nullptr if there are none.
+  const Rows *Find(const Row &key) const;
+
+  /// Memoizes the rows produced for the key, unless the cache would then hold
+  /// more than `kMaxRows` rows.
+  void Insert(Row key, Rows rows);
+
+  void Clear();
+
+  size_t size() const { return results_.size(); }
+
+  utils::MemoryResource *memory() const { return results_.get_allocator().GetMemoryResource(); }
+
+ private:
+  // Unlike the grouping of the aggregations, the values are the same only if
+  // their types are, because the subquery can return them, e.g. 1 and 1.0.
+  struct KeyEqual {
+    bool operator()(const Row &left, const Row &right) const;
+  };
+
+  utils::pmr::unordered_map<Row, Rows, utils::FnvCollection<Row, TypedValue, TypedValue::Hash>, KeyEqual> results_;
+  size_t rows_{0};
+};
+
+}  // namespace plan
+}  // namespace memgraph::query
@@ -169,8 +169,12 @@ FilterMatching ToFilterMatching(Matching &matching) {
 
 }  // namespace
 
-VaryMatchingStart::VaryMatchingStart(Matching matching, const SymbolTable &symbol_table)
-    : matching_(matching), symbol_table_(symbol_table), nodes_(ExpansionNodes(matching.expansions, symbol_table)) {}
+VaryMatchingStart::VaryMatchingStart(Matching matching, const SymbolTable &symbol_table,
+                                     std::optional<std::vector<Expansion>> cost_ordered_expansions)
+    : matching_(matching),
+      symbol_table_(symbol_table),
+      nodes_(ExpansionNodes(matching.expansions, symbol_table)),
+      cost_ordered_expansions_(std::move(cost_ordered_expansions)) {}
 
 VaryMatchingStart::iterator::iterator(VaryMatchingStart *self, bool is_done)
     : self_(self),
@@ -198,12 +202,18 @@ VaryMatchingStart::iterator &VaryMatchingStart::iterator::operator++() {
     start_nodes_it_ = self_->nodes_.end();
   }
   if (*start_nodes_it_ == self_->nodes_.end()) {
+    // The cost ordered expansions were the last matching.
+    cost_ordered_ = false;
     return *this;
   }
   ++*start_nodes_it_;
   // start_nodes_it_ can become equal to `end` and we shouldn't dereference
   // iterator in that case.
   if (*start_nodes_it_ == self_->nodes_.end()) {
+    if (self_->cost_ordered_expansions_) {
+      cost_ordered_ = true;
+      current_matching_.expansions = *self_->cost_ordered_expansions_;
+    }
     return *this;
   }
   const auto &start_node = **start_nodes_it_;
@@ -240,9 +250,10 @@ CartesianProduct<VaryMatchingStart> VaryFilterMatchingStarts(const Matching &mat
   return MakeCartesianProduct(std::move(variants));
 }
 
-VaryQueryPartMatching::VaryQueryPartMatching(SingleQueryPart query_part, const SymbolTable &symbol_table)
+VaryQueryPartMatching::VaryQueryPartMatching(SingleQueryPart query_part, const SymbolTable &symbol_table,
+                                             std::optional<std::vector<Expansion>> cost_ordered_expansions)
     : query_part_(std::move(query_part)),
-      matchings_(VaryMatchingStart(query_part_.matching, symbol_table)),
+      matchings_(VaryMatchingStart(query_part_.matching, symbol_table, std::move(cost_ordered_expansions))),
       optional_matchings_(VaryMultiMatchingStarts(query_part_.optional_matching, symbol_table)),
       merge_matchings_(VaryMultiMatchingStarts(query_part_.merge_matching, symbol_table)),
       filter_matchings_(VaryFilterMatchingStarts(query_part_.matching, symbol_table)) {}
@@ -16,6 +16,7 @@
 #include "cppitertools/slice.hpp"
 #include "gflags/gflags.h"
 
+#include "query/plan/cost_estimator.hpp"
 #include "query/plan/rule_based_planner.hpp"
 
 DECLARE_uint64(query_max_plans);
@@ -179,10 +180,13 @@ class NodeSymbolEqual {
 };
 
 // Generates n matchings, where n is the number of nodes to match. Each Matching
-// will have a different node as a starting node for expansion.
+// will have a different node as a starting node for expansion. If
+// `cost_ordered_expansions` are given, they are produced as an additional
+// matching after all the start nodes.
 class VaryMatchingStart {
  public:
-  VaryMatchingStart(Matching, const SymbolTable &);
+  VaryMatchingStart(Matching, const SymbolTable &,
+                    std::optional<std::vector<Expansion>> cost_ordered_expansions = std::nullopt);
 
   class iterator {
    public:
@@ -198,7 +202,7 @@ class VaryMatchingStart {
     reference operator*() const { return current_matching_; }
     pointer operator->() const { return &current_matching_; }
     bool operator==(const iterator &other) const {
-      return self_ == other.self_ && start_nodes_it_ == other.start_nodes_it_;
+      return self_ == other.self_ && start_nodes_it_ == other.start_nodes_it_ && cost_ordered_ == other.cost_ordered_;
     }
     bool operator!=(const iterator &other) const { return !(*this == other); }
 
@@ -213,6 +217,9 @@ class VaryMatchingStart {
     // a single result, which is the original matching passed in. Setting
     // start_nodes_it_ to end signifies the end of our iteration.
     std::optional<std::unordered_set<NodeAtom *, NodeSymbolHash, NodeSymbolEqual>::iterator> start_nodes_it_;
+    // True while producing the cost ordered expansions, which come after all
+    // the start nodes.
+    bool cost_ordered_{false};
   };
 
   auto begin() { return iterator(this, false); }
@@ -223,6 +230,7 @@ class VaryMatchingStart {
   Matching matching_;
   const SymbolTable &symbol_table_;
   std::unordered_set<NodeAtom *, NodeSymbolHash, NodeSymbolEqual> nodes_;
+  std::optional<std::vector<Expansion>> cost_ordered_expansions_;
 };
 
 // Similar to VaryMatchingStart, but varies the starting nodes for all given
@@ -236,7 +244,8 @@ CartesianProduct<VaryMatchingStart> VaryFilterMatchingStarts(const Matching &mat
 // graph matching is done.
 class VaryQueryPartMatching {
  public:
-  VaryQueryPartMatching(SingleQueryPart, const SymbolTable &);
+  VaryQueryPartMatching(SingleQueryPart, const SymbolTable &,
+                        std::optional<std::vector<Expansion>> cost_ordered_expansions = std::nullopt);
 
   class iterator {
    public:
@@ -299,6 +308,10 @@ class VaryQueryPartMatching {
 
 }  // namespace impl
 
+/// Matchings with at least this many expansions get an additional variant
+/// whose expansions are ordered by the estimated number of produced rows.
+constexpr size_t kMinExpansionsForCostOrdering = 3;
+
 /// @brief Planner which generates multiple plans by changing the order of graph
 /// traversal.
 ///
@@ -319,12 +332,68 @@ class VariableStartPlanner {
     auto single_query_parts = ExtractSingleQueryParts(std::make_unique<QueryParts>(query_parts));
 
     for (const auto &single_query_part : single_query_parts) {
-      varying_query_matchings.emplace_back(single_query_part, symbol_table);
+      varying_query_matchings.emplace_back(single_query_part, symbol_table,
+                                           CostOrderedExpansions(single_query_part.matching, symbol_table));
     }
 
     return iter::slice(MakeCartesianProduct(std::move(varying_query_matchings)), 0UL, FLAGS_query_max_plans);
   }
 
+  // Orders the expansions of the matching by the estimated number of rows they
+  // produce. Patterns with fewer expansions are fully covered by varying the
+  // start node, so nothing is returned for them.
+  std::optional<std::vector<Expansion>> CostOrderedExpansions(const Matching &matching,
+                                                              const SymbolTable &symbol_table) {
+    if (matching.expansions.size() < kMinExpansionsForCostOrdering) return std::nullopt;
+    using CardParam = typename CostEstimator<std::remove_pointer_t<decltype(context_->db)>>::CardParam;
+    auto *db = context_->db;
+    const auto vertex_count = std::max(1.0, static_cast<double>(db->VerticesCount()));
+
+    std::unordered_map<Symbol, double> node_cardinalities;
+    // Average degree of vertices with the node's labels, if any label has
+    // index statistics.
+    std::unordered_map<Symbol, double> node_degrees;
+    auto add_node = [&](const NodeAtom *node) {
+      const auto &symbol = symbol_table.at(*node->identifier_);
+      if (node_cardinalities.contains(symbol)) return;
+      auto cardinality = vertex_count;
+      double filter_factor = 1.0;
+      for (const auto &label_ix : matching.filters.FilteredLabels(symbol)) {
+        const auto label = db->NameToLabel(label_ix.name);
+        if (db->LabelIndexExists(label)) {
+          cardinality = std::min(cardinality, static_cast<double>(db->VerticesCount(label)));
+        } else {
+          filter_factor *= CardParam::kFilter;
+        }
+        if (auto stats = db->GetIndexStats(label)) {
+          auto found = node_degrees.find(symbol);
+          node_degrees[symbol] = found == node_degrees.end() ? stats->avg_degree
+                                                             : std::min(found->second, stats->avg_degree);
+        }
+      }
+      for (size_t i = 0; i < matching.filters.PropertyFilters(symbol).size(); ++i) filter_factor *= CardParam::kFilter;
+      node_cardinalities.emplace(symbol, cardinality * filter_factor);
+    };
+
+    std::vector<double> expansion_degrees;
+    expansion_degrees.reserve(matching.expansions.size());
+    for (const auto &expansion : matching.expansions) {
+      add_node(expansion.node1);
+      if (!expansion.edge) {
+        expansion_degrees.push_back(0.0);
+        continue;
+      }
+      add_node(expansion.node2);
+      double degree = expansion.edge->IsVariable() ? CardParam::kExpandVariable : CardParam::kExpand;
+      for (const auto *node : {expansion.node1, expansion.node2}) {
+        auto found = node_degrees.find(symbol_table.at(*node->identifier_));
+        if (found != node_degrees.end() && !expansion.edge->IsVariable()) degree = std::min(degree, found->second);
+      }
+      expansion_degrees.push_back(degree);
+    }
+    return impl::OrderExpansionsByCost(matching, symbol_table, node_cardinalities, expansion_degrees, vertex_count);
+  }
+
   std::vector<SingleQueryPart> ExtractSingleQueryParts(const std::shared_ptr<QueryParts> query_parts) {
     std::vector<SingleQueryPart> results;
 
@@ -12,10 +12,13 @@
 /// @file
 #pragma once
 
+#include <cmath>
 #include <optional>
+#include <vector>
 
 #include "query/typed_value.hpp"
 #include "storage/v2/id_types.hpp"
+#include "storage/v2/inmemory/label_property_index.hpp"
 #include "storage/v2/property_value.hpp"
 #include "utils/bound.hpp"
 #include "utils/fnv.hpp"
@@ -56,8 +59,13 @@ class VertexCountCache {
     auto &value_vertex_count = property_value_vertex_count_[label_prop];
     // TODO: Why do we even need TypedValue in this whole file?
     TypedValue tv_value(value);
-    if (value_vertex_count.find(tv_value) == value_vertex_count.end())
-      value_vertex_count[tv_value] = db_->VerticesCount(label, property, value);
+    if (value_vertex_count.find(tv_value) == value_vertex_count.end()) {
+      // Prefer the value distribution gathered by ANALYZE GRAPH to reading the index.
+      auto index_stats = GetIndexStats(label, property);
+      value_vertex_count[tv_value] = index_stats && storage::HasValueDistribution(*index_stats)
+                                         ? std::llround(storage::EstimateVertexCount(*index_stats, value))
+                                         : db_->VerticesCount(label, property, value);
+    }
     return value_vertex_count.at(tv_value);
   }
 
@@ -67,17 +75,61 @@ class VertexCountCache {
     auto label_prop = std::make_pair(label, property);
     auto &bounds_vertex_count = property_bounds_vertex_count_[label_prop];
     BoundsKey bounds = std::make_pair(lower, upper);
-    if (bounds_vertex_count.find(bounds) == bounds_vertex_count.end())
-      bounds_vertex_count[bounds] = db_->VerticesCount(label, property, lower, upper);
+    if (bounds_vertex_count.find(bounds) == bounds_vertex_count.end()) {
+      auto index_stats = GetIndexStats(label, property);
+      bounds_vertex_count[bounds] = index_stats && storage::HasValueDistribution(*index_stats)
+                                        ? std::llround(storage::EstimateVertexCount(*index_stats, lower, upper))
+                                        : db_->VerticesCount(label, property, lower, upper);
+    }
     return bounds_vertex_count.at(bounds);
   }
 
+  int64_t VerticesCount(storage::LabelId label, const std::vector<storage::PropertyId> &properties) {
+    return db_->VerticesCount(label, properties);
+  }
+
+  int64_t VerticesCount(storage::LabelId label, const std::vector<storage::PropertyId> &properties,
+                        const std::vector<storage::PropertyValue> &prefix,
+                        const std::optional<utils::Bound<storage::PropertyValue>> &lower,
+                        const std::optional<utils::Bound<storage::PropertyValue>> &upper) {
+    return db_->VerticesCount(label, properties, prefix, lower, upper);
+  }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type) { return db_->EdgesCount(edge_type); }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type, storage::PropertyId property) {
+    return db_->EdgesCount(edge_type, property);
+  }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type, storage::PropertyId property, const storage::PropertyValue &value) {
+    return db_->EdgesCount(edge_type, property, value);
+  }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type, storage::PropertyId property,
+                     const std::optional<utils::Bound<storage::PropertyValue>> &lower,
+                     const std::optional<utils::Bound<storage::PropertyValue>> &upper) {
+    return db_->EdgesCount(edge_type, property, lower, upper);
+  }
+
   bool LabelIndexExists(storage::LabelId label) { return db_->LabelIndexExists(label); }
 
+  bool EdgeTypeIndexExists(storage::EdgeTypeId edge_type) { return db_->EdgeTypeIndexExists(edge_type); }
+
+  bool EdgeTypePropertyIndexExists(storage::EdgeTypeId edge_type, storage::PropertyId property) {
+    return db_->EdgeTypePropertyIndexExists(edge_type, property);
+  }
+
   bool LabelPropertyIndexExists(storage::LabelId label, storage::PropertyId property) {
     return db_->LabelPropertyIndexExists(label, property);
   }
 
+  const std::vector<std::vector<storage::PropertyId>> &LabelPropertyCompositeIndices(storage::LabelId label) {
+    auto found = label_property_composite_indices_.find(label);
+    if (found == label_property_composite_indices_.end())
+      found = label_property_composite_indices_.emplace(label, db_->LabelPropertyCompositeIndices(label)).first;
+    return found->second;
+  }
+
   std::optional<storage::LabelIndexStats> GetIndexStats(const storage::LabelId &label) const {
     return db_->GetIndexStats(label);
   }
@@ -130,6 +182,8 @@ class VertexCountCache {
   TDbAccessor *db_;
   std::optional<int64_t> vertices_count_;
   std::unordered_map<storage::LabelId, int64_t> label_vertex_count_;
+  std::unordered_map<storage::LabelId, std::vector<std::vector<storage::PropertyId>>>
+      label_property_composite_indices_;
   std::unordered_map<LabelPropertyKey, int64_t, LabelPropertyHash> label_property_vertex_count_;
   std::unordered_map<
       LabelPropertyKey,
@@ -0,0 +1,170 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/plan_cache_warmup.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <system_error>
+#include <thread>
+#include <unordered_set>
+
+#include <spdlog/spdlog.h>
+#include <json/json.hpp>
+
+#include "query/cypher_query_interpreter.hpp"
+#include "query/db_accessor.hpp"
+#include "query/interpreter.hpp"
+#include "storage/v2/temporal.hpp"
+#include "utils/exceptions.hpp"
+
+namespace memgraph::query {
+
+namespace {
+
+// Written to the file so that a list written by a newer version with a
+// different format is ignored instead of misread.
+constexpr uint64_t kWarmUpFileVersion{1};
+
+}  // namespace
+
+std::vector<WarmUpQuery> HottestQueries(const uint64_t max_queries, const std::vector<WarmUpQuery> &previous) {
+  auto info = gQueryStats.GetInfo();
+  std::stable_sort(info.begin(), info.end(), [](const auto &lhs, const auto &rhs) { return lhs.calls > rhs.calls; });
+  if (info.size() > max_queries) info.resize(max_queries);
+  std::vector<WarmUpQuery> queries;
+  std::unordered_set<std::string> added;
+  for (auto &query_info : info) {
+    added.insert(query_info.query);
+    queries.push_back({std::move(query_info.query), std::move(query_info.parameter_types)});
+  }
+  for (const auto &query : previous) {
+    if (queries.size() >= max_queries) break;
+    if (!added.insert(query.query).second) continue;
+    queries.push_back(query);
+  }
+  return queries;
+}
+
+bool SaveWarmUpQueries(const std::filesystem::path &path, const std::vector<WarmUpQuery> &queries) {
+  auto data = nlohmann::json::array();
+  for (const auto &query : queries) {
+    auto parameters = nlohmann::json::array();
+    for (const auto &[name, type] : query.parameter_types) {
+      parameters.push_back({name, static_cast<uint8_t>(type)});
+    }
+    data.push_back({{"query", query.query}, {"parameters", std::move(parameters)}});
+  }
+
+  auto temporary_path = path;
+  temporary_path += ".tmp";
+  {
+    std::ofstream file(temporary_path, std::ios::trunc);
+    file << nlohmann::json{{"version", kWarmUpFileVersion}, {"queries", std::move(data)}}.dump();
+    file.close();
+    if (!file) return false;
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary_path, path, error);
+  return !error;
+}
+
+std::vector<WarmUpQuery> LoadWarmUpQueries(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  if (!file) return {};
+  std::vector<WarmUpQuery> queries;
+  try {
+    const auto data = nlohmann::json::parse(file);
+    if (data.at("version").get<uint64_t>() != kWarmUpFileVersion) return {};
+    for (const auto &query_data : data.at("queries")) {
+      WarmUpQuery query{.query = query_data.at("query").get<std::string>()};
+      for (const auto &parameter : query_data.at("parameters")) {
+        const auto type = parameter.at(1).get<uint8_t>();
+        if (type > static_cast<uint8_t>(storage::PropertyValue::Type::TemporalData)) return {};
+        query.parameter_types.emplace_back(parameter.at(0).get<std::string>(),
+                                           static_cast<storage::PropertyValue::Type>(type));
+      }
+      queries.push_back(std::move(query));
+    }
+  } catch (const nlohmann::json::exception &e) {
+    spdlog::warn("The plan cache warm-up file {} is invalid: {}", path.string(), e.what());
+    return {};
+  }
+  return queries;
+}
+
+std::map<std::string, storage::PropertyValue> PlaceholderParameters(const QueryParameterTypes &parameter_types) {
+  std::map<std::string, storage::PropertyValue> parameters;
+  for (const auto &[name, type] : parameter_types) {
+    switch (type) {
+      case storage::PropertyValue::Type::Null:
+        parameters.emplace(name, storage::PropertyValue());
+        break;
+      case storage::PropertyValue::Type::Bool:
+        parameters.emplace(name, storage::PropertyValue(false));
+        break;
+      case storage::PropertyValue::Type::Int:
+        parameters.emplace(name, storage::PropertyValue(0));
+        break;
+      case storage::PropertyValue::Type::Double:
+        parameters.emplace(name, storage::PropertyValue(0.0));
+        break;
+      case storage::PropertyValue::Type::String:
+        parameters.emplace(name, storage::PropertyValue(""));
+        break;
+      case storage::PropertyValue::Type::List:
+        parameters.emplace(name, storage::PropertyValue(std::vector<storage::PropertyValue>{}));
+        break;
+      case storage::PropertyValue::Type::Map:
+        parameters.emplace(name, storage::PropertyValue(std::map<std::string, storage::PropertyValue>{}));
+        break;
+      case storage::PropertyValue::Type::TemporalData:
+        parameters.emplace(name, storage::PropertyValue(storage::TemporalData(storage::TemporalType::Date, 0)));
+        break;
+    }
+  }
+  return parameters;
+}
+
+uint64_t WarmUpPlanCache(InterpreterContext *interpreter_context, const std::vector<WarmUpQuery> &queries,
+                         const uint64_t threads) {
+  std::atomic<size_t> next_query{0};
+  std::atomic<uint64_t> planned{0};
+  auto warm_up = [&] {
+    for (auto i = next_query.fetch_add(1); i < queries.size(); i = next_query.fetch_add(1)) {
+      const auto &query = queries[i];
+      try {
+        auto parsed_query = ParseQuery(query.query, PlaceholderParameters(query.parameter_types),
+                                       &interpreter_context->ast_cache, interpreter_context->config.query);
+        auto *cypher_query = utils::Downcast<CypherQuery>(parsed_query.query);
+        // Only the plans of the cacheable Cypher queries are kept.
+        if (!cypher_query || !parsed_query.is_cacheable) continue;
+        auto storage_accessor = interpreter_context->db->Access();
+        DbAccessor dba(storage_accessor.get());
+        CypherQueryToPlan(parsed_query.stripped_query->hash(), std::move(parsed_query.ast_storage), cypher_query,
+                          parsed_query.parameters, &interpreter_context->plan_cache, &dba);
+        planned.fetch_add(1, std::memory_order_relaxed);
+      } catch (const utils::BasicException &e) {
+        spdlog::debug("Query {} wasn't planned during the plan cache warm-up: {}", query.query, e.what());
+      }
+    }
+  };
+
+  std::vector<std::jthread> workers;
+  const auto worker_count = std::min<uint64_t>(std::max<uint64_t>(threads, 1), queries.size());
+  workers.reserve(worker_count);
+  for (uint64_t i = 0; i < worker_count; ++i) workers.emplace_back(warm_up);
+  workers.clear();
+  return planned.load();
+}
+
+}  // namespace memgraph::query
@@ -0,0 +1,64 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Warm-up of the AST and plan caches at startup with the queries which were
+/// executed the most before the restart, so that they aren't all parsed and
+/// planned at once when the clients reconnect.
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "query/query_stats.hpp"
+#include "storage/v2/property_value.hpp"
+
+namespace memgraph::query {
+
+struct InterpreterContext;
+
+/// Query whose plan is made at startup. The query is the stripped text, whose
+/// literals are replaced by placeholders, so neither the literals nor the
+/// parameter values are written to the disk.
+struct WarmUpQuery {
+  std::string query;
+  QueryParameterTypes parameter_types;
+};
+
+/// Returns the `max_queries` queries of `gQueryStats` with the most calls. If
+/// there are fewer of them, the list is filled up with the `previous` queries,
+/// so that a list saved shortly after a restart doesn't lose the queries which
+/// weren't executed yet.
+std::vector<WarmUpQuery> HottestQueries(uint64_t max_queries, const std::vector<WarmUpQuery> &previous = {});
+
+/// Writes the queries to the file as JSON. The file is replaced at once, so a
+/// crash while writing leaves the previous list.
+/// @return false if the file couldn't be written.
+bool SaveWarmUpQueries(const std::filesystem::path &path, const std::vector<WarmUpQuery> &queries);
+
+/// Returns the queries written by `SaveWarmUpQueries`, or no queries if the
+/// file doesn't exist or it's invalid.
+std::vector<WarmUpQuery> LoadWarmUpQueries(const std::filesystem::path &path);
+
+/// Returns a placeholder value of each parameter with the type of its value.
+std::map<std::string, storage::PropertyValue> PlaceholderParameters(const QueryParameterTypes &parameter_types);
+
+/// Parses and plans the queries on `threads` threads, which caches their ASTs
+/// and plans. Queries which can't be planned anymore, e.g. because they call a
+/// procedure which was removed, are skipped.
+/// @return the number of queries which were planned.
+uint64_t WarmUpPlanCache(InterpreterContext *interpreter_context, const std::vector<WarmUpQuery> &queries,
+                         uint64_t threads);
+
+}  // namespace memgraph::query
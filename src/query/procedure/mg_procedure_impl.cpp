@@ -12,20 +12,26 @@
 #include "query/procedure/mg_procedure_impl.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstring>
 #include <exception>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <regex>
 #include <stdexcept>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "license/license.hpp"
 #include "mg_procedure.h"
 #include "module.hpp"
+#include "query/auth_checker.hpp"
 #include "query/db_accessor.hpp"
 #include "query/frontend/ast/ast.hpp"
 #include "query/procedure/cypher_types.hpp"
@@ -52,6 +58,14 @@ using namespace memgraph::query::procedure;
 
 namespace {
 
+void CountVertexAccesses(const mgp_graph *graph, uint64_t count = 1) {
+  if (graph->access_counters) graph->access_counters->vertices.fetch_add(count, std::memory_order_relaxed);
+}
+
+void CountEdgeAccesses(const mgp_graph *graph, uint64_t count = 1) {
+  if (graph->access_counters) graph->access_counters->edges.fetch_add(count, std::memory_order_relaxed);
+}
+
 void *MgpAlignedAllocImpl(memgraph::utils::MemoryResource &memory, const size_t size_in_bytes, const size_t alignment) {
   if (size_in_bytes == 0U || !memgraph::utils::IsPow2(alignment)) return nullptr;
   // Simplify alignment by always using values greater or equal to max_align.
@@ -203,7 +217,7 @@ template <typename TFunc, typename... Args>
 
 // Graph mutations
 bool MgpGraphIsMutable(const mgp_graph &graph) noexcept {
-  return graph.view == memgraph::storage::View::NEW && graph.ctx != nullptr;
+  return graph.view == memgraph::storage::View::NEW && graph.ctx != nullptr && !graph.read_only;
 }
 
 bool MgpVertexIsMutable(const mgp_vertex &vertex) { return MgpGraphIsMutable(*vertex.graph); }
@@ -1515,6 +1529,7 @@ mgp_error mgp_result_new_record(mgp_result *res, mgp_result_record **result) {
       [res] {
         auto *memory = res->rows.get_allocator().GetMemoryResource();
         MG_ASSERT(res->signature, "Expected to have a valid signature");
+        if (res->IsFull()) res->flush();
         res->rows.push_back(mgp_result_record{
             res->signature,
             memgraph::utils::pmr::map<memgraph::utils::pmr::string, memgraph::query::TypedValue>(memory)});
@@ -2038,6 +2053,7 @@ mgp_error mgp_vertex_iter_in_edges(mgp_vertex *v, mgp_memory *memory, mgp_edges_
                                           v->graph, it->GetMemoryResource());
                   }},
               v->graph->impl);
+          CountEdgeAccesses(v->graph);
         }
 
         return it.release();
@@ -2099,6 +2115,7 @@ mgp_error mgp_vertex_iter_out_edges(mgp_vertex *v, mgp_memory *memory, mgp_edges
                                           v->graph, it->GetMemoryResource());
                   }},
               v->graph->impl);
+          CountEdgeAccesses(v->graph);
         }
 
         return it.release();
@@ -2106,6 +2123,93 @@ mgp_error mgp_vertex_iter_out_edges(mgp_vertex *v, mgp_memory *memory, mgp_edges
       result);
 }
 
+namespace {
+/// Copies the edges of the vertex like the `mgp_vertex_*_edges_batch`
+/// functions do.
+template <bool kForIn>
+mgp_error CopyVertexEdges(mgp_vertex *v, mgp_edge_id *edge_ids, mgp_vertex_id *neighbor_ids, mgp_edge_type *types,
+                          size_t capacity, size_t *result) {
+  return WrapExceptions([=] {
+    *result = 0;
+    std::visit(memgraph::utils::Overloaded{
+                   [v](memgraph::query::DbAccessor *impl) {
+                     const auto &vertex = std::get<memgraph::query::VertexAccessor>(v->impl);
+                     kForIn ? impl->PrefetchInEdges(vertex) : impl->PrefetchOutEdges(vertex);
+                   },
+                   [v](memgraph::query::SubgraphDbAccessor *impl) {
+                     const auto &vertex = std::get<memgraph::query::SubgraphVertexAccessor>(v->impl);
+                     kForIn ? impl->PrefetchInEdges(vertex) : impl->PrefetchOutEdges(vertex);
+                   }},
+               v->graph->impl);
+    auto maybe_edges = std::visit(
+        [v](auto &impl) {
+          if constexpr (kForIn) {
+            return impl.InEdges(v->graph->view);
+          } else {
+            return impl.OutEdges(v->graph->view);
+          }
+        },
+        v->impl);
+    if (maybe_edges.HasError()) {
+      switch (maybe_edges.GetError()) {
+        case memgraph::storage::Error::DELETED_OBJECT:
+          throw DeletedObjectException{"Cannot get the edges of a deleted vertex!"};
+        case memgraph::storage::Error::NONEXISTENT_OBJECT:
+          LOG_FATAL("Query modules shouldn't have access to nonexistent objects when getting the edges of a vertex.");
+        case memgraph::storage::Error::PROPERTIES_DISABLED:
+        case memgraph::storage::Error::VERTEX_HAS_EDGES:
+        case memgraph::storage::Error::SERIALIZATION_ERROR:
+          LOG_FATAL("Unexpected error when getting the edges of a vertex.");
+      }
+    }
+
+#ifdef MG_ENTERPRISE
+    const auto *ctx = v->graph->ctx;
+    const auto *auth_checker = ctx && memgraph::license::global_license_checker.IsEnterpriseValidFast()
+                                   ? ctx->auth_checker.get()
+                                   : nullptr;
+#endif
+    size_t count = 0;
+    for (const auto &edge : *maybe_edges) {
+      auto neighbor = kForIn ? edge.From() : edge.To();
+#ifdef MG_ENTERPRISE
+      if (auth_checker &&
+          (!auth_checker->Has(edge, memgraph::query::AuthQuery::FineGrainedPrivilege::READ) ||
+           !auth_checker->Has(neighbor, v->graph->view, memgraph::query::AuthQuery::FineGrainedPrivilege::READ))) {
+        continue;
+      }
+#endif
+      if (count < capacity) {
+        if (edge_ids) edge_ids[count] = mgp_edge_id{.as_int = edge.Gid().AsInt()};
+        if (neighbor_ids) neighbor_ids[count] = mgp_vertex_id{.as_int = neighbor.CypherId()};
+        if (types) {
+          const auto &name = std::visit(
+              [&edge](const auto *impl) -> const std::string & { return impl->EdgeTypeToName(edge.EdgeType()); },
+              v->graph->impl);
+          types[count].name = name.c_str();
+        }
+      }
+      ++count;
+    }
+    *result = count;
+    if (count > capacity) {
+      throw InsufficientBufferException{"The vertex has {} edges, which don't fit into {} elements.", count, capacity};
+    }
+    CountEdgeAccesses(v->graph, count);
+  });
+}
+}  // namespace
+
+mgp_error mgp_vertex_in_edges_batch(mgp_vertex *v, mgp_edge_id *edge_ids, mgp_vertex_id *neighbor_ids,
+                                    mgp_edge_type *types, size_t capacity, size_t *result) {
+  return CopyVertexEdges<true>(v, edge_ids, neighbor_ids, types, capacity, result);
+}
+
+mgp_error mgp_vertex_out_edges_batch(mgp_vertex *v, mgp_edge_id *edge_ids, mgp_vertex_id *neighbor_ids,
+                                     mgp_edge_type *types, size_t capacity, size_t *result) {
+  return CopyVertexEdges<false>(v, edge_ids, neighbor_ids, types, capacity, result);
+}
+
 mgp_error mgp_edges_iterator_underlying_graph_is_mutable(mgp_edges_iterator *it, int *result) {
   return mgp_vertex_underlying_graph_is_mutable(&it->source_vertex, result);
 }
@@ -2161,6 +2265,7 @@ mgp_error mgp_edges_iterator_next(mgp_edges_iterator *it, mgp_edge **result) {
                                it->source_vertex.graph, it->GetMemoryResource());
                          }},
                      it->source_vertex.graph->impl);
+          CountEdgeAccesses(it->source_vertex.graph);
 
           return &*it->current_e;
         };
@@ -2325,6 +2430,7 @@ mgp_error mgp_graph_get_vertex_by_id(mgp_graph *graph, mgp_vertex_id id, mgp_mem
             },
             graph->impl);
         if (maybe_vertex) {
+          CountVertexAccesses(graph);
           return std::visit(memgraph::utils::Overloaded{
                                 [memory, graph, maybe_vertex](memgraph::query::DbAccessor *) {
                                   return NewRawMgpObject<mgp_vertex>(memory, *maybe_vertex, graph);
@@ -2341,6 +2447,299 @@ mgp_error mgp_graph_get_vertex_by_id(mgp_graph *graph, mgp_vertex_id id, mgp_mem
       result);
 }
 
+mgp_error mgp_graph_get_vertices_property(mgp_graph *graph, const mgp_vertex_id *ids, size_t count,
+                                          const char *property_name, mgp_memory *memory, mgp_value **results) {
+  return WrapExceptions([=] {
+    const auto key =
+        std::visit([property_name](auto *impl) { return impl->NameToProperty(property_name); }, graph->impl);
+    std::vector<memgraph::storage::PropertyValue> values;
+    values.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      auto maybe_vertex = std::visit(
+          [graph, id = ids[i]](auto *impl) {
+            return impl->FindVertex(memgraph::storage::Gid::FromInt(id.as_int), graph->view);
+          },
+          graph->impl);
+      if (!maybe_vertex) throw std::out_of_range{fmt::format("Vertex with ID {} doesn't exist", ids[i].as_int)};
+      auto maybe_prop = maybe_vertex->GetProperty(graph->view, key);
+      if (maybe_prop.HasError()) {
+        switch (maybe_prop.GetError()) {
+          case memgraph::storage::Error::DELETED_OBJECT:
+            throw DeletedObjectException{"Cannot get a property of a deleted vertex!"};
+          case memgraph::storage::Error::NONEXISTENT_OBJECT:
+            LOG_FATAL(
+                "Query modules shouldn't have access to nonexistent objects when getting a property of a vertex.");
+          case memgraph::storage::Error::PROPERTIES_DISABLED:
+          case memgraph::storage::Error::VERTEX_HAS_EDGES:
+          case memgraph::storage::Error::SERIALIZATION_ERROR:
+            LOG_FATAL("Unexpected error when getting a property of a vertex.");
+        }
+      }
+      values.push_back(std::move(*maybe_prop));
+    }
+    // The values are only converted once all properties are read, so that no
+    // result is set when an error occurs.
+    size_t converted = 0;
+    memgraph::utils::OnScopeExit clean_up([&] {
+      for (size_t i = 0; i < converted; ++i) mgp_value_destroy(results[i]);
+    });
+    for (; converted < count; ++converted) {
+      results[converted] = NewRawMgpObject<mgp_value>(memory, std::move(values[converted]));
+    }
+    clean_up.Disable();
+  });
+}
+
+namespace {
+/// Identifies the projections which are the same, since they project the
+/// same version of a graph with the same parameters.
+struct GraphProjectionKey {
+  std::string storage_id;
+  uint64_t graph_version;
+  std::vector<memgraph::storage::LabelId> labels;
+  std::vector<memgraph::storage::EdgeTypeId> edge_types;
+  std::optional<memgraph::storage::PropertyId> weight_property;
+  double default_weight;
+
+  bool operator==(const GraphProjectionKey &) const = default;
+};
+
+/// Projections of the latest versions of the graphs, with the most recently
+/// used ones at the front. Only a few projections are kept, since each of them
+/// takes memory proportional to the size of the graph.
+class GraphProjectionCache {
+ public:
+  std::shared_ptr<const mgp_graph_projection_data> Find(const GraphProjectionKey &key) {
+    std::lock_guard guard(lock_);
+    auto it = std::find_if(entries_.begin(), entries_.end(), [&key](const auto &entry) { return entry.first == key; });
+    if (it == entries_.end()) return nullptr;
+    entries_.splice(entries_.begin(), entries_, it);
+    return it->second;
+  }
+
+  void Insert(GraphProjectionKey key, std::shared_ptr<const mgp_graph_projection_data> data) {
+    std::lock_guard guard(lock_);
+    // The graph versions only grow, so new transactions won't ask for the
+    // projections of the older versions of the same graph anymore.
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->first.storage_id != key.storage_id) {
+        ++it;
+      } else if (it->first.graph_version < key.graph_version) {
+        it = entries_.erase(it);
+      } else if (it->first.graph_version > key.graph_version || it->first == key) {
+        return;
+      } else {
+        ++it;
+      }
+    }
+    entries_.emplace_front(std::move(key), std::move(data));
+    if (entries_.size() > kMaxEntries) entries_.pop_back();
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 8;
+
+  std::mutex lock_;
+  std::list<std::pair<GraphProjectionKey, std::shared_ptr<const mgp_graph_projection_data>>> entries_;
+};
+
+GraphProjectionCache &GetGraphProjectionCache() {
+  static GraphProjectionCache cache;
+  return cache;
+}
+
+double GetEdgeWeight(const memgraph::query::EdgeAccessor &edge, memgraph::storage::View view,
+                     memgraph::storage::PropertyId property, double default_weight) {
+  auto maybe_prop = edge.GetProperty(view, property);
+  if (maybe_prop.HasError()) {
+    switch (maybe_prop.GetError()) {
+      case memgraph::storage::Error::DELETED_OBJECT:
+        throw DeletedObjectException{"Cannot get a property of a deleted edge!"};
+      case memgraph::storage::Error::PROPERTIES_DISABLED:
+        return default_weight;
+      case memgraph::storage::Error::NONEXISTENT_OBJECT:
+        LOG_FATAL("Query modules shouldn't have access to nonexistent objects when getting a property of an edge.");
+      case memgraph::storage::Error::VERTEX_HAS_EDGES:
+      case memgraph::storage::Error::SERIALIZATION_ERROR:
+        LOG_FATAL("Unexpected error when getting a property of an edge.");
+    }
+  }
+  const auto &value = *maybe_prop;
+  if (value.IsNull()) return default_weight;
+  if (value.IsInt()) return static_cast<double>(value.ValueInt());
+  if (value.IsDouble()) return value.ValueDouble();
+  throw ValueConversionException{"The weight of the edge with ID {} isn't a number.", edge.Gid().AsInt()};
+}
+
+/// Builds the CSR arrays by iterating over the graph. Only the vertices and
+/// edges which the `auth_checker` allows reading are projected if it's given.
+template <class TDbAccessor>
+std::shared_ptr<mgp_graph_projection_data> BuildGraphProjection(
+    TDbAccessor *impl, memgraph::storage::View view, const GraphProjectionKey &key,
+    const memgraph::query::FineGrainedAuthChecker *auth_checker) {
+  const auto to_impl_vertex = [impl](const memgraph::query::VertexAccessor &vertex) {
+    if constexpr (std::is_same_v<TDbAccessor, memgraph::query::SubgraphDbAccessor>) {
+      return memgraph::query::SubgraphVertexAccessor(vertex, impl->getGraph());
+    } else {
+      return vertex;
+    }
+  };
+
+  std::vector<memgraph::query::VertexAccessor> vertices;
+  for (auto vertex : impl->Vertices(view)) {
+    if (!key.labels.empty()) {
+      auto maybe_labels = vertex.Labels(view);
+      if (maybe_labels.HasError()) throw DeletedObjectException{"Cannot get the labels of a deleted vertex!"};
+      if (std::none_of(maybe_labels->begin(), maybe_labels->end(), [&key](const auto label) {
+            return std::binary_search(key.labels.begin(), key.labels.end(), label);
+          })) {
+        continue;
+      }
+    }
+#ifdef MG_ENTERPRISE
+    if (auth_checker && !auth_checker->Has(vertex, view, memgraph::query::AuthQuery::FineGrainedPrivilege::READ)) {
+      continue;
+    }
+#endif
+    vertices.push_back(vertex);
+  }
+  std::sort(vertices.begin(), vertices.end(), [](const auto &lhs, const auto &rhs) { return lhs.Gid() < rhs.Gid(); });
+
+  auto data = std::make_shared<mgp_graph_projection_data>();
+  data->has_weights = key.weight_property.has_value();
+  data->vertex_ids.reserve(vertices.size());
+  for (const auto &vertex : vertices) data->vertex_ids.push_back(mgp_vertex_id{.as_int = vertex.CypherId()});
+  data->offsets.reserve(vertices.size() + 1);
+  data->offsets.push_back(0);
+  for (const auto &vertex : vertices) {
+    const auto impl_vertex = to_impl_vertex(vertex);
+    impl->PrefetchOutEdges(impl_vertex);
+    auto maybe_edges = impl_vertex.OutEdges(view);
+    if (maybe_edges.HasError()) throw DeletedObjectException{"Cannot get the edges of a deleted vertex!"};
+    for (const auto &edge : *maybe_edges) {
+      if (!key.edge_types.empty() &&
+          !std::binary_search(key.edge_types.begin(), key.edge_types.end(), edge.EdgeType())) {
+        continue;
+      }
+#ifdef MG_ENTERPRISE
+      if (auth_checker && !auth_checker->Has(edge, memgraph::query::AuthQuery::FineGrainedPrivilege::READ)) continue;
+#endif
+      const auto target_id = edge.To().CypherId();
+      auto target = std::lower_bound(data->vertex_ids.begin(), data->vertex_ids.end(), target_id,
+                                     [](const auto &id, const int64_t value) { return id.as_int < value; });
+      if (target == data->vertex_ids.end() || target->as_int != target_id) continue;
+      data->targets.push_back(target - data->vertex_ids.begin());
+      if (key.weight_property) {
+        data->weights.push_back(GetEdgeWeight(edge, view, *key.weight_property, key.default_weight));
+      }
+    }
+    data->offsets.push_back(data->targets.size());
+  }
+  return data;
+}
+}  // namespace
+
+mgp_error mgp_graph_project(mgp_graph *graph, const char *const *labels, size_t labels_count,
+                            const char *const *edge_types, size_t edge_types_count, const char *weight_property,
+                            double default_weight, mgp_memory *memory, mgp_graph_projection **result) {
+  return WrapExceptions(
+      [=] {
+        GraphProjectionKey key{.graph_version = 0, .default_weight = default_weight};
+        std::visit(
+            [&](auto *impl) {
+              for (size_t i = 0; i < labels_count; ++i) key.labels.push_back(impl->NameToLabel(labels[i]));
+              for (size_t i = 0; i < edge_types_count; ++i) {
+                key.edge_types.push_back(impl->NameToEdgeType(edge_types[i]));
+              }
+              if (weight_property) key.weight_property = impl->NameToProperty(weight_property);
+            },
+            graph->impl);
+        std::sort(key.labels.begin(), key.labels.end());
+        key.labels.erase(std::unique(key.labels.begin(), key.labels.end()), key.labels.end());
+        std::sort(key.edge_types.begin(), key.edge_types.end());
+        key.edge_types.erase(std::unique(key.edge_types.begin(), key.edge_types.end()), key.edge_types.end());
+
+        const memgraph::query::FineGrainedAuthChecker *auth_checker = nullptr;
+#ifdef MG_ENTERPRISE
+        if (graph->ctx && memgraph::license::global_license_checker.IsEnterpriseValidFast()) {
+          auth_checker = graph->ctx->auth_checker.get();
+        }
+        if (auth_checker &&
+            auth_checker->HasGlobalPrivilegeOnVertices(memgraph::query::AuthQuery::FineGrainedPrivilege::READ) &&
+            auth_checker->HasGlobalPrivilegeOnEdges(memgraph::query::AuthQuery::FineGrainedPrivilege::READ)) {
+          auth_checker = nullptr;
+        }
+#endif
+
+        // The projections which depend on the privileges of the user or on
+        // the changes made by the transaction can't be shared.
+        std::optional<uint64_t> graph_version;
+        if (auto *const *db_accessor = std::get_if<memgraph::query::DbAccessor *>(&graph->impl);
+            db_accessor && !auth_checker) {
+          graph_version = (*db_accessor)->GraphVersion();
+          key.storage_id = (*db_accessor)->id();
+        }
+        std::shared_ptr<const mgp_graph_projection_data> data;
+        if (graph_version) {
+          key.graph_version = *graph_version;
+          data = GetGraphProjectionCache().Find(key);
+        }
+        if (!data) {
+          data = std::visit([&](auto *impl) { return BuildGraphProjection(impl, graph->view, key, auth_checker); },
+                            graph->impl);
+          CountVertexAccesses(graph, data->vertex_ids.size());
+          CountEdgeAccesses(graph, data->targets.size());
+          if (graph_version) GetGraphProjectionCache().Insert(key, data);
+        }
+        return NewRawMgpObject<mgp_graph_projection>(memory, std::move(data));
+      },
+      result);
+}
+
+void mgp_graph_projection_destroy(mgp_graph_projection *projection) { DeleteRawMgpObject(projection); }
+
+mgp_error mgp_graph_projection_vertex_count(mgp_graph_projection *projection, size_t *result) {
+  return WrapExceptions([projection] { return projection->data->vertex_ids.size(); }, result);
+}
+
+mgp_error mgp_graph_projection_edge_count(mgp_graph_projection *projection, size_t *result) {
+  return WrapExceptions([projection] { return projection->data->targets.size(); }, result);
+}
+
+mgp_error mgp_graph_projection_vertex_ids(mgp_graph_projection *projection, const mgp_vertex_id **result) {
+  return WrapExceptions([projection] { return projection->data->vertex_ids.data(); }, result);
+}
+
+mgp_error mgp_graph_projection_offsets(mgp_graph_projection *projection, const size_t **result) {
+  return WrapExceptions([projection] { return projection->data->offsets.data(); }, result);
+}
+
+mgp_error mgp_graph_projection_targets(mgp_graph_projection *projection, const size_t **result) {
+  return WrapExceptions([projection] { return projection->data->targets.data(); }, result);
+}
+
+mgp_error mgp_graph_projection_weights(mgp_graph_projection *projection, const double **result) {
+  return WrapExceptions(
+      [projection]() -> const double * {
+        return projection->data->has_weights ? projection->data->weights.data() : nullptr;
+      },
+      result);
+}
+
+mgp_error mgp_graph_projection_ordinal(mgp_graph_projection *projection, mgp_vertex_id id, size_t *result) {
+  return WrapExceptions(
+      [projection, id] {
+        const auto &ids = projection->data->vertex_ids;
+        auto it = std::lower_bound(ids.begin(), ids.end(), id.as_int,
+                                   [](const auto &vertex_id, const int64_t value) { return vertex_id.as_int < value; });
+        if (it == ids.end() || it->as_int != id.as_int) {
+          throw std::out_of_range{fmt::format("Vertex with ID {} isn't in the projection", id.as_int)};
+        }
+        return static_cast<size_t>(it - ids.begin());
+      },
+      result);
+}
+
 mgp_error mgp_graph_is_mutable(mgp_graph *graph, int *result) {
   *result = MgpGraphIsMutable(*graph) ? 1 : 0;
   return mgp_error::MGP_ERROR_NO_ERROR;
@@ -2614,10 +3013,12 @@ void NextPermitted(mgp_vertices_iterator &it) {
 
 /// @throw anything VerticesIterable may throw
 mgp_vertices_iterator::mgp_vertices_iterator(mgp_graph *graph, memgraph::utils::MemoryResource *memory)
-    : memory(memory),
-      graph(graph),
-      vertices(std::visit([graph](auto *impl) { return impl->Vertices(graph->view); }, graph->impl)),
-      current_it(vertices.begin()) {
+    : mgp_vertices_iterator(graph, std::visit([graph](auto *impl) { return impl->Vertices(graph->view); }, graph->impl),
+                            memory) {}
+
+mgp_vertices_iterator::mgp_vertices_iterator(mgp_graph *graph, memgraph::query::VerticesIterable range,
+                                             memgraph::utils::MemoryResource *memory)
+    : memory(memory), graph(graph), vertices(std::move(range)), current_it(vertices.begin()) {
 #ifdef MG_ENTERPRISE
   if (memgraph::license::global_license_checker.IsEnterpriseValidFast()) {
     NextPermitted(*this);
@@ -2632,6 +3033,7 @@ mgp_vertices_iterator::mgp_vertices_iterator(mgp_graph *graph, memgraph::utils::
               current_v.emplace(memgraph::query::SubgraphVertexAccessor(*current_it, impl->getGraph()), graph, memory);
             }},
         graph->impl);
+    CountVertexAccesses(graph);
   }
 }
 
@@ -2641,6 +3043,68 @@ mgp_error mgp_graph_iter_vertices(mgp_graph *graph, mgp_memory *memory, mgp_vert
   return WrapExceptions([graph, memory] { return NewRawMgpObject<mgp_vertices_iterator>(memory, graph); }, result);
 }
 
+namespace {
+// Each worker is given several ranges, so that the workers finishing early can
+// take over the ranges of the others.
+constexpr size_t kVertexRangesPerWorker = 8;
+constexpr size_t kWorkerInitialMemory = 64UL * 1024UL;
+}  // namespace
+
+mgp_error mgp_graph_parallel_for_vertices(mgp_graph *graph, size_t num_workers, mgp_vertices_range_cb cb, void *data,
+                                          mgp_memory *memory) {
+  return WrapExceptions([=]() mutable {
+    mgp_graph worker_graph{graph->impl, graph->view, graph->ctx, true, graph->access_counters};
+    auto *const *db_accessor = std::get_if<memgraph::query::DbAccessor *>(&graph->impl);
+    if (num_workers == 0) num_workers = std::max(1U, std::thread::hardware_concurrency());
+    bool sequential = db_accessor == nullptr || num_workers == 1;
+#ifdef MG_ENTERPRISE
+    // The fine-grained auth checker isn't safe to be shared among threads.
+    if (graph->ctx && graph->ctx->auth_checker && memgraph::license::global_license_checker.IsEnterpriseValidFast()) {
+      sequential = true;
+    }
+#endif
+    if (sequential) {
+      mgp_vertices_iterator vertices(&worker_graph, memory->impl);
+      cb(&vertices, &worker_graph, memory, 0, data);
+      return;
+    }
+
+    auto ranges = (*db_accessor)->PartitionVertices(graph->view, num_workers * kVertexRangesPerWorker);
+    num_workers = std::min(num_workers, ranges.size());
+    // The workers allocate from the memory of the procedure, so that its
+    // memory limit still applies to them.
+    memgraph::utils::SynchronizedPoolResource shared_memory(128U, 1024U, memory->impl);
+    std::atomic<size_t> next_range{0};
+    std::atomic<bool> failed{false};
+    std::mutex error_lock;
+    std::exception_ptr error;
+    {
+      std::vector<std::jthread> threads;
+      threads.reserve(num_workers);
+      for (size_t worker_id = 0; worker_id < num_workers; ++worker_id) {
+        threads.emplace_back([&, worker_id] {
+          try {
+            memgraph::utils::MonotonicBufferResource monotonic_memory(kWorkerInitialMemory, &shared_memory);
+            memgraph::utils::PoolResource pool_memory(128U, 1024U, &monotonic_memory, &shared_memory);
+            mgp_memory worker_memory{&pool_memory};
+            while (!failed.load(std::memory_order_acquire)) {
+              const auto range = next_range.fetch_add(1, std::memory_order_acq_rel);
+              if (range >= ranges.size()) break;
+              mgp_vertices_iterator vertices(&worker_graph, std::move(ranges[range]), &pool_memory);
+              cb(&vertices, &worker_graph, &worker_memory, worker_id, data);
+            }
+          } catch (...) {
+            failed.store(true, std::memory_order_release);
+            std::lock_guard guard(error_lock);
+            if (!error) error = std::current_exception();
+          }
+        });
+      }
+    }
+    if (error) std::rethrow_exception(error);
+  });
+}
+
 mgp_error mgp_vertices_iterator_underlying_graph_is_mutable(mgp_vertices_iterator *it, int *result) {
   return mgp_graph_is_mutable(it->graph, result);
 }
@@ -2690,11 +3154,48 @@ mgp_error mgp_vertices_iterator_next(mgp_vertices_iterator *it, mgp_vertex **res
                    it->graph->impl);
 
         clean_up.Disable();
+        CountVertexAccesses(it->graph);
         return &*it->current_v;
       },
       result);
 }
 
+mgp_error mgp_vertices_iterator_next_batch(mgp_vertices_iterator *it, mgp_vertex_id *ids, size_t capacity,
+                                           size_t *result) {
+  return WrapExceptions(
+      [it, ids, capacity] {
+        size_t count = 0;
+        while (count < capacity && it->current_it != it->vertices.end()) {
+          ids[count++] = mgp_vertex_id{.as_int = (*it->current_it).CypherId()};
+          ++it->current_it;
+#ifdef MG_ENTERPRISE
+          if (memgraph::license::global_license_checker.IsEnterpriseValidFast()) {
+            NextPermitted(*it);
+          }
+#endif
+        }
+        if (count == 0) return count;
+
+        it->current_v = std::nullopt;
+        if (it->current_it != it->vertices.end()) {
+          std::visit(memgraph::utils::Overloaded{[it](memgraph::query::DbAccessor *) {
+                                                   it->current_v.emplace(*it->current_it, it->graph,
+                                                                         it->GetMemoryResource());
+                                                 },
+                                                 [it](memgraph::query::SubgraphDbAccessor *impl) {
+                                                   it->current_v.emplace(memgraph::query::SubgraphVertexAccessor(
+                                                                             *it->current_it, impl->getGraph()),
+                                                                         it->graph, it->GetMemoryResource());
+                                                 }},
+                     it->graph->impl);
+        }
+        // The first of the vertices was counted when it became the current one.
+        CountVertexAccesses(it->graph, count - 1 + (it->current_v ? 1 : 0));
+        return count;
+      },
+      result);
+}
+
 /// Type System
 ///
 /// All types are allocated globally, so that we simplify the API and minimize
@@ -16,8 +16,11 @@
 
 #include "mg_procedure.h"
 
+#include <functional>
+#include <memory>
 #include <optional>
 #include <ostream>
+#include <vector>
 
 #include "integrations/kafka/consumer.hpp"
 #include "integrations/pulsar/consumer.hpp"
@@ -25,6 +28,7 @@
 #include "query/db_accessor.hpp"
 #include "query/frontend/ast/ast.hpp"
 #include "query/procedure/cypher_type_ptr.hpp"
+#include "query/procedure/procedure_stats.hpp"
 #include "query/typed_value.hpp"
 #include "storage/v2/view.hpp"
 #include "utils/memory.hpp"
@@ -560,6 +564,11 @@ struct mgp_graph {
   // TODO: Merge `mgp_graph` and `mgp_memory` into a single `mgp_context`. The
   // `ctx` field is out of place here.
   memgraph::query::ExecutionContext *ctx;
+  // Set for the views given to the workers of `mgp_graph_parallel_for_vertices`,
+  // which share the context of the procedure but mustn't modify the graph.
+  bool read_only{false};
+  // Counts the vertices and edges handed to the procedure, if it's set.
+  memgraph::query::procedure::GraphAccessCounters *access_counters{nullptr};
 
   static mgp_graph WritableGraph(memgraph::query::DbAccessor &acc, memgraph::storage::View view,
                                  memgraph::query::ExecutionContext &ctx) {
@@ -599,6 +608,13 @@ struct mgp_result {
                                   std::pair<const memgraph::query::procedure::CypherType *, bool>> *signature;
   memgraph::utils::pmr::vector<mgp_result_record> rows;
   std::optional<memgraph::utils::pmr::string> error_msg;
+  /// Set when the records are streamed to the query while the procedure runs.
+  /// It's called before a new record is added to the `max_rows` records, and
+  /// it returns once they have been consumed and removed from `rows`.
+  std::function<void()> flush;
+  size_t max_rows{0};
+
+  bool IsFull() const { return flush && rows.size() >= max_rows; }
 };
 
 struct mgp_func_result {
@@ -704,6 +720,11 @@ struct mgp_vertices_iterator {
   /// @throw anything VerticesIterable may throw
   mgp_vertices_iterator(mgp_graph *graph, memgraph::utils::MemoryResource *memory);
 
+  /// Iterates over the given vertices of the graph instead of all of them.
+  /// @throw anything VerticesIterable may throw
+  mgp_vertices_iterator(mgp_graph *graph, memgraph::query::VerticesIterable range,
+                        memgraph::utils::MemoryResource *memory);
+
   memgraph::utils::MemoryResource *GetMemoryResource() const { return memory; }
 
   memgraph::utils::MemoryResource *memory;
@@ -713,6 +734,28 @@ struct mgp_vertices_iterator {
   std::optional<mgp_vertex> current_v;
 };
 
+/// Adjacency arrays of a mgp_graph_projection. The arrays are immutable, so
+/// that they can be shared by the projections of the same version of the graph.
+struct mgp_graph_projection_data {
+  std::vector<mgp_vertex_id> vertex_ids;
+  std::vector<size_t> offsets;
+  std::vector<size_t> targets;
+  std::vector<double> weights;
+  bool has_weights{false};
+};
+
+struct mgp_graph_projection {
+  using allocator_type = memgraph::utils::Allocator<mgp_graph_projection>;
+
+  mgp_graph_projection(std::shared_ptr<const mgp_graph_projection_data> data, memgraph::utils::MemoryResource *memory)
+      : memory(memory), data(std::move(data)) {}
+
+  memgraph::utils::MemoryResource *GetMemoryResource() const { return memory; }
+
+  memgraph::utils::MemoryResource *memory;
+  std::shared_ptr<const mgp_graph_projection_data> data;
+};
+
 struct mgp_type {
   memgraph::query::procedure::CypherTypePtr impl;
 };
@@ -11,8 +11,15 @@
 
 #include "query/procedure/module.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
 #include <optional>
+#include <thread>
 
 extern "C" {
 #include <dlfcn.h>
@@ -20,17 +27,22 @@ extern "C" {
 
 #include <fmt/format.h>
 #include <unistd.h>
+#include <json/json.hpp>
 
 #include "py/py.hpp"
 #include "query/procedure/callable_alias_mapper.hpp"
 #include "query/procedure/mg_procedure_helpers.hpp"
+#include "query/procedure/procedure_stats.hpp"
 #include "query/procedure/py_module.hpp"
+#include "query/query_stats.hpp"
 #include "utils/file.hpp"
 #include "utils/logging.hpp"
 #include "utils/memory.hpp"
 #include "utils/message.hpp"
 #include "utils/pmr/vector.hpp"
 #include "utils/string.hpp"
+#include "utils/variant_helpers.hpp"
+#include "utils/vector_distance.hpp"
 
 namespace memgraph::query::procedure {
 
@@ -175,7 +187,7 @@ std::string GetPathString(const std::optional<std::filesystem::path> &path) {
 
 void RegisterMgProcedures(
     // We expect modules to be sorted by name.
-    const std::map<std::string, std::unique_ptr<Module>, std::less<>> *all_modules, BuiltinModule *module) {
+    const std::map<std::string, std::shared_ptr<Module>, std::less<>> *all_modules, BuiltinModule *module) {
   auto procedures_cb = [all_modules](mgp_list * /*args*/, mgp_graph * /*graph*/, mgp_result *result,
                                      mgp_memory *memory) {
     // Iterating over all_modules assumes that the standard mechanism of custom
@@ -271,7 +283,515 @@ void RegisterMgProcedures(
   module->AddProcedure("procedures", std::move(procedures));
 }
 
-void RegisterMgTransformations(const std::map<std::string, std::unique_ptr<Module>, std::less<>> *all_modules,
+void RegisterMgProcedureStats(BuiltinModule *module) {
+  auto procedure_stats_cb = [](mgp_list * /*args*/, mgp_graph * /*graph*/, mgp_result *result, mgp_memory *memory) {
+    const auto percentile = [](const auto &percentiles, uint64_t wanted) -> uint64_t {
+      for (const auto &[yielded, value] : percentiles) {
+        if (yielded == wanted) return value;
+      }
+      return 0;
+    };
+    for (const auto &stats : gProcedureStats.GetInfo()) {
+      mgp_result_record *record{nullptr};
+      if (!TryOrSetError([&] { return mgp_result_new_record(result, &record); }, result)) {
+        return;
+      }
+
+      const auto name_value = GetStringValueOrSetError(stats.name.c_str(), memory, result);
+      if (!name_value) {
+        return;
+      }
+      if (!InsertResultOrSetError(result, record, "name", name_value.get())) {
+        return;
+      }
+
+      const std::array<std::pair<const char *, uint64_t>, 9> int_fields{{
+          {"calls", stats.calls},
+          {"failed_calls", stats.failed_calls},
+          {"wall_time_us", stats.wall_time_us},
+          {"wall_time_p50_us", percentile(stats.wall_time_percentiles, 50)},
+          {"wall_time_p99_us", percentile(stats.wall_time_percentiles, 99)},
+          {"cpu_time_us", stats.cpu_time_us},
+          {"allocated_bytes", stats.allocated_bytes},
+          {"vertices_accessed", stats.vertices},
+          {"edges_accessed", stats.edges},
+      }};
+      for (const auto &[field_name, field_value] : int_fields) {
+        MgpUniquePtr<mgp_value> value{nullptr, mgp_value_destroy};
+        if (!TryOrSetError(
+                [&, field_value = field_value] {
+                  return CreateMgpObject(value, mgp_value_make_int, static_cast<int64_t>(field_value), memory);
+                },
+                result)) {
+          return;
+        }
+        if (!InsertResultOrSetError(result, record, field_name, value.get())) {
+          return;
+        }
+      }
+    }
+  };
+  mgp_proc procedure_stats("procedure_stats", procedure_stats_cb, utils::NewDeleteResource());
+  MG_ASSERT(mgp_proc_add_result(&procedure_stats, "name", Call<mgp_type *>(mgp_type_string)) ==
+            mgp_error::MGP_ERROR_NO_ERROR);
+  for (const auto *field_name : {"calls", "failed_calls", "wall_time_us", "wall_time_p50_us", "wall_time_p99_us",
+                                 "cpu_time_us", "allocated_bytes", "vertices_accessed", "edges_accessed"}) {
+    MG_ASSERT(mgp_proc_add_result(&procedure_stats, field_name, Call<mgp_type *>(mgp_type_int)) ==
+              mgp_error::MGP_ERROR_NO_ERROR);
+  }
+  module->AddProcedure("procedure_stats", std::move(procedure_stats));
+}
+
+namespace {
+template <size_t N>
+bool InsertIntResultsOrSetError(mgp_result *result, mgp_result_record *record,
+                                const std::array<std::pair<const char *, uint64_t>, N> &int_fields,
+                                mgp_memory *memory) {
+  for (const auto &[field_name, field_value] : int_fields) {
+    MgpUniquePtr<mgp_value> value{nullptr, mgp_value_destroy};
+    if (!TryOrSetError(
+            [&, field_value = field_value] {
+              return CreateMgpObject(value, mgp_value_make_int, static_cast<int64_t>(field_value), memory);
+            },
+            result)) {
+      return false;
+    }
+    if (!InsertResultOrSetError(result, record, field_name, value.get())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool InsertStringResultOrSetError(mgp_result *result, mgp_result_record *record, const char *field_name,
+                                  const std::string &field_value, mgp_memory *memory) {
+  const auto value = GetStringValueOrSetError(field_value.c_str(), memory, result);
+  return value && InsertResultOrSetError(result, record, field_name, value.get());
+}
+}  // namespace
+
+void RegisterMgQueryStats(BuiltinModule *module) {
+  auto query_stats_cb = [](mgp_list * /*args*/, mgp_graph * /*graph*/, mgp_result *result, mgp_memory *memory) {
+    for (const auto &stats : gQueryStats.GetInfo()) {
+      mgp_result_record *record{nullptr};
+      if (!TryOrSetError([&] { return mgp_result_new_record(result, &record); }, result)) {
+        return;
+      }
+      if (!InsertStringResultOrSetError(result, record, "query", stats.query, memory)) {
+        return;
+      }
+      const std::array<std::pair<const char *, uint64_t>, 8> int_fields{{
+          {"query_hash", stats.query_hash},
+          {"plan_hash", stats.plan_hash},
+          {"calls", stats.calls},
+          {"total_time_us", stats.total_time_us},
+          {"mean_time_us", stats.total_time_us / stats.calls},
+          {"max_time_us", stats.max_time_us},
+          {"rows", stats.rows},
+          {"max_memory_bytes", stats.max_memory_bytes},
+      }};
+      if (!InsertIntResultsOrSetError(result, record, int_fields, memory)) {
+        return;
+      }
+    }
+  };
+  mgp_proc query_stats("query_stats", query_stats_cb, utils::NewDeleteResource());
+  MG_ASSERT(mgp_proc_add_result(&query_stats, "query", Call<mgp_type *>(mgp_type_string)) ==
+            mgp_error::MGP_ERROR_NO_ERROR);
+  for (const auto *field_name : {"query_hash", "plan_hash", "calls", "total_time_us", "mean_time_us", "max_time_us",
+                                 "rows", "max_memory_bytes"}) {
+    MG_ASSERT(mgp_proc_add_result(&query_stats, field_name, Call<mgp_type *>(mgp_type_int)) ==
+              mgp_error::MGP_ERROR_NO_ERROR);
+  }
+  module->AddProcedure("query_stats", std::move(query_stats));
+
+  auto slow_queries_cb = [](mgp_list * /*args*/, mgp_graph * /*graph*/, mgp_result *result, mgp_memory *memory) {
+    for (const auto &slow_query : gQueryStats.GetSlowQueries()) {
+      mgp_result_record *record{nullptr};
+      if (!TryOrSetError([&] { return mgp_result_new_record(result, &record); }, result)) {
+        return;
+      }
+      if (!InsertStringResultOrSetError(result, record, "query", slow_query.query, memory) ||
+          !InsertStringResultOrSetError(result, record, "plan", slow_query.plan, memory)) {
+        return;
+      }
+      if (slow_query.profile) {
+        if (!InsertStringResultOrSetError(result, record, "profile", *slow_query.profile, memory)) {
+          return;
+        }
+      } else {
+        MgpUniquePtr<mgp_value> null_value{nullptr, mgp_value_destroy};
+        if (!TryOrSetError([&] { return CreateMgpObject(null_value, mgp_value_make_null, memory); }, result)) {
+          return;
+        }
+        if (!InsertResultOrSetError(result, record, "profile", null_value.get())) {
+          return;
+        }
+      }
+      const std::array<std::pair<const char *, uint64_t>, 6> int_fields{{
+          {"timestamp", static_cast<uint64_t>(slow_query.timestamp)},
+          {"query_hash", slow_query.execution.query_hash},
+          {"plan_hash", slow_query.execution.plan_hash},
+          {"time_us", slow_query.execution.time_us},
+          {"rows", slow_query.execution.rows},
+          {"memory_bytes", slow_query.execution.memory_bytes},
+      }};
+      if (!InsertIntResultsOrSetError(result, record, int_fields, memory)) {
+        return;
+      }
+    }
+  };
+  mgp_proc slow_queries("slow_queries", slow_queries_cb, utils::NewDeleteResource());
+  for (const auto *field_name : {"query", "plan"}) {
+    MG_ASSERT(mgp_proc_add_result(&slow_queries, field_name, Call<mgp_type *>(mgp_type_string)) ==
+              mgp_error::MGP_ERROR_NO_ERROR);
+  }
+  MG_ASSERT(mgp_proc_add_result(&slow_queries, "profile",
+                                Call<mgp_type *>(mgp_type_nullable, Call<mgp_type *>(mgp_type_string))) ==
+            mgp_error::MGP_ERROR_NO_ERROR);
+  for (const auto *field_name : {"timestamp", "query_hash", "plan_hash", "time_us", "rows", "memory_bytes"}) {
+    MG_ASSERT(mgp_proc_add_result(&slow_queries, field_name, Call<mgp_type *>(mgp_type_int)) ==
+              mgp_error::MGP_ERROR_NO_ERROR);
+  }
+  module->AddProcedure("slow_queries", std::move(slow_queries));
+}
+
+void RegisterMgDeltaChains(BuiltinModule *module) {
+  auto delta_chains_cb = [](mgp_list * /*args*/, mgp_graph *graph, mgp_result *result, mgp_memory *memory) {
+    // Subgraphs don't have chains of their own.
+    auto *const *db_accessor = std::get_if<DbAccessor *>(&graph->impl);
+    if (!db_accessor) return;
+    for (const auto &chain : (*db_accessor)->LongDeltaChainsInfo()) {
+      mgp_result_record *record{nullptr};
+      if (!TryOrSetError([&] { return mgp_result_new_record(result, &record); }, result)) {
+        return;
+      }
+      const std::array<std::pair<const char *, uint64_t>, 3> int_fields{{
+          {"gid", chain.gid.AsUint()},
+          {"max_length", chain.max_length},
+          {"long_reads", chain.long_reads},
+      }};
+      if (!InsertIntResultsOrSetError(result, record, int_fields, memory)) {
+        return;
+      }
+    }
+  };
+  mgp_proc delta_chains("delta_chains", delta_chains_cb, utils::NewDeleteResource());
+  for (const auto *field_name : {"gid", "max_length", "long_reads"}) {
+    MG_ASSERT(mgp_proc_add_result(&delta_chains, field_name, Call<mgp_type *>(mgp_type_int)) ==
+              mgp_error::MGP_ERROR_NO_ERROR);
+  }
+  module->AddProcedure("delta_chains", std::move(delta_chains));
+}
+
+void RegisterMgTextSearch(BuiltinModule *module) {
+  auto text_search_cb = [](mgp_list *args, mgp_graph *graph, mgp_result *result, mgp_memory *memory) {
+    MG_ASSERT(Call<size_t>(mgp_list_size, args) == 4U, "Should have been type checked already");
+    std::array<const char *, 3> strings{};
+    for (size_t i = 0; i < strings.size(); ++i) {
+      auto *arg = Call<mgp_value *>(mgp_list_at, args, i);
+      MG_ASSERT(CallBool(mgp_value_is_string, arg), "Should have been type checked already");
+      if (!TryOrSetError([&] { return mgp_value_get_string(arg, &strings[i]); }, result)) {
+        return;
+      }
+    }
+    const auto limit = Call<int64_t>(mgp_value_get_int, Call<mgp_value *>(mgp_list_at, args, 3));
+    if (limit < 0) {
+      static_cast<void>(mgp_result_set_error_msg(result, "The limit can't be negative."));
+      return;
+    }
+
+    // The text indices are searched in the whole graph.
+    auto *const *db_accessor = std::get_if<DbAccessor *>(&graph->impl);
+    if (!db_accessor) {
+      static_cast<void>(mgp_result_set_error_msg(result, "Text search isn't supported on subgraphs."));
+      return;
+    }
+    auto *dba = *db_accessor;
+    const auto label = dba->NameToLabel(strings[0]);
+    const auto property = dba->NameToProperty(strings[1]);
+    if (!dba->TextIndexExists(label, property)) {
+      const auto error_msg = fmt::format("There's no text index on :{}({}).", strings[0], strings[1]);
+      static_cast<void>(mgp_result_set_error_msg(result, error_msg.c_str()));
+      return;
+    }
+
+    auto found = dba->TextSearch(label, property, strings[2], static_cast<uint64_t>(limit), graph->view);
+    for (auto &[vertex, score] : found) {
+      mgp_result_record *record{nullptr};
+      if (!TryOrSetError([&] { return mgp_result_new_record(result, &record); }, result)) {
+        return;
+      }
+      mgp_value node_value(TypedValue(vertex), graph, memory->impl);
+      if (!InsertResultOrSetError(result, record, "node", &node_value)) {
+        return;
+      }
+      mgp_value score_value(score, memory->impl);
+      if (!InsertResultOrSetError(result, record, "score", &score_value)) {
+        return;
+      }
+    }
+  };
+  mgp_proc text_search("text_search", text_search_cb, utils::NewDeleteResource());
+  for (const auto *arg_name : {"label", "property", "query"}) {
+    MG_ASSERT(mgp_proc_add_arg(&text_search, arg_name, Call<mgp_type *>(mgp_type_string)) ==
+              mgp_error::MGP_ERROR_NO_ERROR);
+  }
+  mgp_value default_limit(int64_t{10}, utils::NewDeleteResource());
+  MG_ASSERT(mgp_proc_add_opt_arg(&text_search, "limit", Call<mgp_type *>(mgp_type_int), &default_limit) ==
+            mgp_error::MGP_ERROR_NO_ERROR);
+  MG_ASSERT(mgp_proc_add_result(&text_search, "node", Call<mgp_type *>(mgp_type_node)) ==
+            mgp_error::MGP_ERROR_NO_ERROR);
+  MG_ASSERT(mgp_proc_add_result(&text_search, "score", Call<mgp_type *>(mgp_type_float)) ==
+            mgp_error::MGP_ERROR_NO_ERROR);
+  module->AddProcedure("text_search", std::move(text_search));
+}
+
+namespace {
+// Returns the numbers of the list value as a vector, or std::nullopt if the
+// value isn't a non-empty list of numbers.
+std::optional<std::vector<float>> PropertyValueToVector(const storage::PropertyValue &value) {
+  if (!value.IsList() || value.ValueList().empty()) return std::nullopt;
+  std::vector<float> vector;
+  vector.reserve(value.ValueList().size());
+  for (const auto &element : value.ValueList()) {
+    if (element.IsInt()) {
+      vector.push_back(static_cast<float>(element.ValueInt()));
+    } else if (element.IsDouble()) {
+      vector.push_back(static_cast<float>(element.ValueDouble()));
+    } else {
+      return std::nullopt;
+    }
+  }
+  return vector;
+}
+}  // namespace
+
+void RegisterMgVectorSearch(BuiltinModule *module) {
+  auto vector_search_cb = [](mgp_list *args, mgp_graph *graph, mgp_result *result, mgp_memory *memory) {
+    MG_ASSERT(Call<size_t>(mgp_list_size, args) == 4U, "Should have been type checked already");
+    std::array<const char *, 2> strings{};
+    for (size_t i = 0; i < strings.size(); ++i) {
+      auto *arg = Call<mgp_value *>(mgp_list_at, args, i);
+      MG_ASSERT(CallBool(mgp_value_is_string, arg), "Should have been type checked already");
+      if (!TryOrSetError([&] { return mgp_value_get_string(arg, &strings[i]); }, result)) {
+        return;
+      }
+    }
+    auto *query_list = Call<mgp_list *>(mgp_value_get_list, Call<mgp_value *>(mgp_list_at, args, 2));
+    std::vector<float> query(Call<size_t>(mgp_list_size, query_list));
+    for (size_t i = 0; i < query.size(); ++i) {
+      auto *element = Call<mgp_value *>(mgp_list_at, query_list, i);
+      query[i] = CallBool(mgp_value_is_int, element)
+                     ? static_cast<float>(Call<int64_t>(mgp_value_get_int, element))
+                     : static_cast<float>(Call<double>(mgp_value_get_double, element));
+    }
+    if (query.empty()) {
+      static_cast<void>(mgp_result_set_error_msg(result, "The query vector can't be empty."));
+      return;
+    }
+    const auto k = Call<int64_t>(mgp_value_get_int, Call<mgp_value *>(mgp_list_at, args, 3));
+    if (k < 0) {
+      static_cast<void>(mgp_result_set_error_msg(result, "The number of neighbours can't be negative."));
+      return;
+    }
+
+    // The vector indices are searched in the whole graph.
+    auto *const *db_accessor = std::get_if<DbAccessor *>(&graph->impl);
+    if (!db_accessor) {
+      static_cast<void>(mgp_result_set_error_msg(result, "Vector search isn't supported on subgraphs."));
+      return;
+    }
+    auto *dba = *db_accessor;
+    const auto label = dba->NameToLabel(strings[0]);
+    const auto property = dba->NameToProperty(strings[1]);
+
+    std::vector<std::pair<VertexAccessor, double>> found;
+    if (dba->VectorIndexExists(label, property)) {
+      auto maybe_found = dba->VectorSearch(label, property, query, static_cast<uint64_t>(k), graph->view);
+      if (!maybe_found) {
+        const auto error_msg = fmt::format(
+            "The dimension of the query differs from the dimension of the vector index on :{}({}).", strings[0],
+            strings[1]);
+        static_cast<void>(mgp_result_set_error_msg(result, error_msg.c_str()));
+        return;
+      }
+      found = std::move(*maybe_found);
+    } else {
+      // Without an index the distances to all vectors of the same dimension are
+      // computed, which gives the exact nearest neighbours.
+      for (auto vertex : dba->Vertices(graph->view)) {
+        auto has_label = vertex.HasLabel(graph->view, label);
+        if (has_label.HasError() || !*has_label) continue;
+        auto value = vertex.GetProperty(graph->view, property);
+        if (value.HasError()) continue;
+        auto vector = PropertyValueToVector(*value);
+        if (!vector || vector->size() != query.size()) continue;
+        found.emplace_back(vertex, utils::CosineDistance(*vector, query));
+      }
+      const auto nearest = std::min(found.size(), static_cast<size_t>(k));
+      std::partial_sort(found.begin(), found.begin() + static_cast<std::ptrdiff_t>(nearest), found.end(),
+                        [](const auto &lhs, const auto &rhs) { return lhs.second < rhs.second; });
+      found.erase(found.begin() + static_cast<std::ptrdiff_t>(nearest), found.end());
+    }
+
+    for (auto &[vertex, distance] : found) {
+      mgp_result_record *record{nullptr};
+      if (!TryOrSetError([&] { return mgp_result_new_record(result, &record); }, result)) {
+        return;
+      }
+      mgp_value node_value(TypedValue(vertex), graph, memory->impl);
+      if (!InsertResultOrSetError(result, record, "node", &node_value)) {
+        return;
+      }
+      mgp_value distance_value(distance, memory->impl);
+      if (!InsertResultOrSetError(result, record, "distance", &distance_value)) {
+        return;
+      }
+    }
+  };
+  mgp_proc vector_search("vector_search", vector_search_cb, utils::NewDeleteResource());
+  for (const auto *arg_name : {"label", "property"}) {
+    MG_ASSERT(mgp_proc_add_arg(&vector_search, arg_name, Call<mgp_type *>(mgp_type_string)) ==
+              mgp_error::MGP_ERROR_NO_ERROR);
+  }
+  MG_ASSERT(mgp_proc_add_arg(&vector_search, "query",
+                             Call<mgp_type *>(mgp_type_list, Call<mgp_type *>(mgp_type_number))) ==
+            mgp_error::MGP_ERROR_NO_ERROR);
+  mgp_value default_k(int64_t{10}, utils::NewDeleteResource());
+  MG_ASSERT(mgp_proc_add_opt_arg(&vector_search, "k", Call<mgp_type *>(mgp_type_int), &default_k) ==
+            mgp_error::MGP_ERROR_NO_ERROR);
+  MG_ASSERT(mgp_proc_add_result(&vector_search, "node", Call<mgp_type *>(mgp_type_node)) ==
+            mgp_error::MGP_ERROR_NO_ERROR);
+  MG_ASSERT(mgp_proc_add_result(&vector_search, "distance", Call<mgp_type *>(mgp_type_float)) ==
+            mgp_error::MGP_ERROR_NO_ERROR);
+  module->AddProcedure("vector_search", std::move(vector_search));
+}
+
+namespace {
+// Computes the aggregates of the aggregate index on the label and the
+// properties by scanning the vertices, the same way the index does.
+std::vector<storage::AggregateGroup> ScanAggregateGroups(DbAccessor *dba, storage::LabelId label,
+                                                         storage::PropertyId group_property,
+                                                         storage::PropertyId value_property, storage::View view) {
+  struct Accumulator {
+    storage::AggregateGroup group;
+    bool has_double{false};
+    bool has_non_number{false};
+    // Wraps around like the sum of the index.
+    uint64_t int_sum{0};
+    double double_sum{0.0};
+  };
+  std::map<storage::PropertyValue, Accumulator> groups;
+  for (auto vertex : dba->Vertices(view)) {
+    auto has_label = vertex.HasLabel(view, label);
+    if (has_label.HasError() || !*has_label) continue;
+    auto group = vertex.GetProperty(view, group_property);
+    auto value = vertex.GetProperty(view, value_property);
+    if (group.HasError() || value.HasError()) continue;
+    auto &accumulator = groups[*group];
+    ++accumulator.group.count;
+    if (value->IsNull()) continue;
+    ++accumulator.group.value_count;
+    if (value->IsInt()) {
+      accumulator.int_sum += static_cast<uint64_t>(value->ValueInt());
+    } else if (value->IsDouble()) {
+      accumulator.has_double = true;
+      accumulator.double_sum += value->ValueDouble();
+    } else {
+      accumulator.has_non_number = true;
+    }
+    if (accumulator.group.min.IsNull() || *value < accumulator.group.min) accumulator.group.min = *value;
+    if (accumulator.group.max.IsNull() || accumulator.group.max < *value) accumulator.group.max = *value;
+  }
+
+  std::vector<storage::AggregateGroup> ret;
+  ret.reserve(groups.size());
+  for (auto &[group_value, accumulator] : groups) {
+    accumulator.group.group = group_value;
+    const auto int_sum = static_cast<int64_t>(accumulator.int_sum);
+    if (accumulator.has_non_number) {
+      accumulator.group.sum = storage::PropertyValue();
+    } else if (accumulator.has_double) {
+      accumulator.group.sum = storage::PropertyValue(accumulator.double_sum + static_cast<double>(int_sum));
+    } else {
+      accumulator.group.sum = storage::PropertyValue(int_sum);
+    }
+    ret.push_back(std::move(accumulator.group));
+  }
+  return ret;
+}
+}  // namespace
+
+void RegisterMgAggregate(BuiltinModule *module) {
+  auto aggregate_cb = [](mgp_list *args, mgp_graph *graph, mgp_result *result, mgp_memory *memory) {
+    MG_ASSERT(Call<size_t>(mgp_list_size, args) == 3U, "Should have been type checked already");
+    std::array<const char *, 3> strings{};
+    for (size_t i = 0; i < strings.size(); ++i) {
+      auto *arg = Call<mgp_value *>(mgp_list_at, args, i);
+      MG_ASSERT(CallBool(mgp_value_is_string, arg), "Should have been type checked already");
+      if (!TryOrSetError([&] { return mgp_value_get_string(arg, &strings[i]); }, result)) {
+        return;
+      }
+    }
+
+    // The aggregate indices cover the whole graph.
+    auto *const *db_accessor = std::get_if<DbAccessor *>(&graph->impl);
+    if (!db_accessor) {
+      static_cast<void>(mgp_result_set_error_msg(result, "Aggregating isn't supported on subgraphs."));
+      return;
+    }
+    auto *dba = *db_accessor;
+    const auto label = dba->NameToLabel(strings[0]);
+    const auto group_property = dba->NameToProperty(strings[1]);
+    const auto value_property = dba->NameToProperty(strings[2]);
+
+    // The index can't be used by the transactions which see uncommitted
+    // changes, in which case the vertices are scanned.
+    auto groups = dba->AggregateIndexLookup(label, group_property, value_property);
+    if (!groups) {
+      groups = ScanAggregateGroups(dba, label, group_property, value_property, graph->view);
+    }
+
+    for (const auto &group : *groups) {
+      mgp_result_record *record{nullptr};
+      if (!TryOrSetError([&] { return mgp_result_new_record(result, &record); }, result)) {
+        return;
+      }
+      const std::array<std::pair<const char *, TypedValue>, 6> fields{{
+          {"group", TypedValue(group.group, memory->impl)},
+          {"count", TypedValue(static_cast<int64_t>(group.count), memory->impl)},
+          {"value_count", TypedValue(static_cast<int64_t>(group.value_count), memory->impl)},
+          {"sum", TypedValue(group.sum, memory->impl)},
+          {"min", TypedValue(group.min, memory->impl)},
+          {"max", TypedValue(group.max, memory->impl)},
+      }};
+      for (const auto &[field_name, field] : fields) {
+        mgp_value field_value(field, graph, memory->impl);
+        if (!InsertResultOrSetError(result, record, field_name, &field_value)) {
+          return;
+        }
+      }
+    }
+  };
+  mgp_proc aggregate("aggregate", aggregate_cb, utils::NewDeleteResource());
+  for (const auto *arg_name : {"label", "group_property", "value_property"}) {
+    MG_ASSERT(mgp_proc_add_arg(&aggregate, arg_name, Call<mgp_type *>(mgp_type_string)) ==
+              mgp_error::MGP_ERROR_NO_ERROR);
+  }
+  for (const auto *result_name : {"group", "sum", "min", "max"}) {
+    MG_ASSERT(mgp_proc_add_result(&aggregate, result_name,
+                                  Call<mgp_type *>(mgp_type_nullable, Call<mgp_type *>(mgp_type_any))) ==
+              mgp_error::MGP_ERROR_NO_ERROR);
+  }
+  for (const auto *result_name : {"count", "value_count"}) {
+    MG_ASSERT(mgp_proc_add_result(&aggregate, result_name, Call<mgp_type *>(mgp_type_int)) ==
+              mgp_error::MGP_ERROR_NO_ERROR);
+  }
+  module->AddProcedure("aggregate", std::move(aggregate));
+}
+
+void RegisterMgTransformations(const std::map<std::string, std::shared_ptr<Module>, std::less<>> *all_modules,
                                BuiltinModule *module) {
   auto transformations_cb = [all_modules](mgp_list * /*unused*/, mgp_graph * /*unused*/, mgp_result *result,
                                           mgp_memory *memory) {
@@ -337,7 +857,7 @@ void RegisterMgTransformations(const std::map<std::string, std::unique_ptr<Modul
 
 void RegisterMgFunctions(
     // We expect modules to be sorted by name.
-    const std::map<std::string, std::unique_ptr<Module>, std::less<>> *all_modules, BuiltinModule *module) {
+    const std::map<std::string, std::shared_ptr<Module>, std::less<>> *all_modules, BuiltinModule *module) {
   auto functions_cb = [all_modules](mgp_list * /*args*/, mgp_graph * /*graph*/, mgp_result *result,
                                     mgp_memory *memory) {
     // Iterating over all_modules assumes that the standard mechanism of magic
@@ -1133,11 +1653,173 @@ const std::map<std::string, mgp_func, std::less<>> *PythonModule::Functions() co
             "not been loaded...");
   return &functions_;
 }
+
+/// Module with transformations which are declared in a JSON file, so they run
+/// without calling into Python or a shared library. A transformation decodes
+/// the payload of each message as JSON and yields its query with the
+/// parameters taken from the payload:
+///
+///   {"transformations": {"users": {"query": "MERGE (u:User {id: $id}) SET u.name = $name",
+///                                  "parameters": {"id": "/user/id", "name": "/user/name"}}}}
+///
+/// The parameters are mapped to JSON pointers into the payload, and a missing
+/// field gives a null parameter. Without the mapping, the fields of the
+/// payload object are the parameters. All rows of a transformation have the
+/// same query, so the stream can execute them as a single batched query.
+class JsonModule final : public Module {
+ public:
+  JsonModule() = default;
+  ~JsonModule() override = default;
+  JsonModule(const JsonModule &) = delete;
+  JsonModule(JsonModule &&) = delete;
+  JsonModule &operator=(const JsonModule &) = delete;
+  JsonModule &operator=(JsonModule &&) = delete;
+
+  bool Load(const std::filesystem::path &file_path);
+
+  bool Close() override;
+
+  const std::map<std::string, mgp_proc, std::less<>> *Procedures() const override { return &procedures_; }
+  const std::map<std::string, mgp_trans, std::less<>> *Transformations() const override { return &transformations_; }
+  const std::map<std::string, mgp_func, std::less<>> *Functions() const override { return &functions_; }
+  std::optional<std::filesystem::path> Path() const override { return file_path_; }
+
+ private:
+  std::filesystem::path file_path_;
+  std::map<std::string, mgp_proc, std::less<>> procedures_;
+  std::map<std::string, mgp_trans, std::less<>> transformations_;
+  std::map<std::string, mgp_func, std::less<>> functions_;
+};
+
+namespace {
+
+TypedValue JsonToTypedValue(const nlohmann::json &data, utils::MemoryResource *memory) {
+  switch (data.type()) {
+    case nlohmann::json::value_t::boolean:
+      return TypedValue(data.get<bool>(), memory);
+    case nlohmann::json::value_t::number_integer:
+    case nlohmann::json::value_t::number_unsigned:
+      return TypedValue(data.get<int64_t>(), memory);
+    case nlohmann::json::value_t::number_float:
+      return TypedValue(data.get<double>(), memory);
+    case nlohmann::json::value_t::string:
+      return TypedValue(data.get_ref<const std::string &>(), memory);
+    case nlohmann::json::value_t::array: {
+      TypedValue::TVector list(memory);
+      list.reserve(data.size());
+      for (const auto &element : data) list.push_back(JsonToTypedValue(element, memory));
+      return TypedValue(std::move(list), memory);
+    }
+    case nlohmann::json::value_t::object: {
+      TypedValue::TMap map(memory);
+      for (const auto &[key, value] : data.items()) map.emplace(key, JsonToTypedValue(value, memory));
+      return TypedValue(std::move(map), memory);
+    }
+    default:
+      return TypedValue(memory);
+  }
+}
+
+}  // namespace
+
+bool JsonModule::Load(const std::filesystem::path &file_path) {
+  spdlog::info("Loading module {}...", file_path);
+  file_path_ = file_path;
+  auto with_error = [&](std::string_view error) {
+    spdlog::error(
+        utils::MessageWithLink("Unable to load module {}; {}.", file_path, error, "https://memgr.ph/modules"));
+    transformations_.clear();
+    return false;
+  };
+
+  nlohmann::json definition;
+  try {
+    std::ifstream file{file_path};
+    definition = nlohmann::json::parse(file);
+  } catch (const nlohmann::json::exception &e) {
+    return with_error(e.what());
+  }
+  if (!definition.is_object() || !definition.contains("transformations") ||
+      !definition["transformations"].is_object()) {
+    return with_error("expected an object with the \"transformations\" object");
+  }
+
+  for (const auto &[name, transformation] : definition["transformations"].items()) {
+    if (!transformation.is_object() || !transformation.contains("query") || !transformation["query"].is_string()) {
+      return with_error(fmt::format("transformation {} doesn't have a query", name));
+    }
+    auto query = transformation["query"].get<std::string>();
+    std::optional<std::vector<std::pair<std::string, nlohmann::json::json_pointer>>> parameters;
+    if (transformation.contains("parameters")) {
+      if (!transformation["parameters"].is_object()) {
+        return with_error(fmt::format("parameters of transformation {} aren't an object", name));
+      }
+      parameters.emplace();
+      for (const auto &[parameter, pointer] : transformation["parameters"].items()) {
+        if (!pointer.is_string()) {
+          return with_error(fmt::format("parameter {} of transformation {} isn't a JSON pointer", parameter, name));
+        }
+        try {
+          parameters->emplace_back(parameter, nlohmann::json::json_pointer{pointer.get<std::string>()});
+        } catch (const nlohmann::json::exception &e) {
+          return with_error(fmt::format("parameter {} of transformation {}: {}", parameter, name, e.what()));
+        }
+      }
+    }
+
+    auto callback = [query = std::move(query), parameters = std::move(parameters)](
+                        mgp_messages *messages, mgp_graph * /*graph*/, mgp_result *result, mgp_memory * /*memory*/) {
+      auto *memory = result->rows.get_allocator().GetMemoryResource();
+      for (size_t i = 0; i < messages->messages.size(); ++i) {
+        const auto payload = std::visit(
+            utils::Overloaded{[](const mgp_message::KafkaMessage &msg) { return msg->Payload(); },
+                              [](const mgp_message::PulsarMessage &msg) { return msg.Payload(); }},
+            messages->messages[i].msg);
+        const auto data = nlohmann::json::parse(payload.begin(), payload.end(), nullptr, false);
+        if (data.is_discarded() || (!parameters && !data.is_object())) {
+          const auto error = fmt::format("Message {} of the batch isn't a JSON object", i);
+          result->error_msg.emplace(error.c_str(), memory);
+          return;
+        }
+
+        TypedValue::TMap params(memory);
+        if (parameters) {
+          for (const auto &[parameter, pointer] : *parameters) {
+            params.emplace(parameter, data.contains(pointer) ? JsonToTypedValue(data[pointer], memory)
+                                                             : TypedValue(memory));
+          }
+        } else {
+          params = JsonToTypedValue(data, memory).ValueMap();
+        }
+
+        result->rows.push_back(
+            mgp_result_record{result->signature, utils::pmr::map<utils::pmr::string, TypedValue>(memory)});
+        auto &values = result->rows.back().values;
+        values.emplace("query", TypedValue(query, memory));
+        values.emplace("parameters", TypedValue(std::move(params), memory));
+      }
+    };
+    auto [it, inserted] =
+        transformations_.emplace(name, mgp_trans(name.c_str(), std::move(callback), utils::NewDeleteResource()));
+    if (MgpTransAddFixedResult(&it->second) != mgp_error::MGP_ERROR_NO_ERROR) {
+      return with_error(fmt::format("unable to add result to transformation {}", name));
+    }
+  }
+  spdlog::info("Loaded module {}", file_path);
+  return true;
+}
+
+bool JsonModule::Close() {
+  spdlog::info("Closed module {}", file_path_);
+  transformations_.clear();
+  return true;
+}
+
 namespace {
 
 std::unique_ptr<Module> LoadModuleFromFile(const std::filesystem::path &path) {
   const auto &ext = path.extension();
-  if (ext != ".so" && ext != ".py") {
+  if (ext != ".so" && ext != ".py" && ext != ".json") {
     spdlog::warn(utils::MessageWithLink("Unknown query module file {}.", path, "https://memgr.ph/modules"));
     return nullptr;
   }
@@ -1150,10 +1832,66 @@ std::unique_ptr<Module> LoadModuleFromFile(const std::filesystem::path &path) {
     auto py_module = std::make_unique<PythonModule>();
     if (!py_module->Load(path)) return nullptr;
     module = std::move(py_module);
+  } else if (path.extension() == ".json") {
+    auto json_module = std::make_unique<JsonModule>();
+    if (!json_module->Load(path)) return nullptr;
+    module = std::move(json_module);
   }
   return module;
 }
 
+/// Module whose file is loaded when its procedures, transformations or
+/// functions are first needed, so that the startup doesn't wait for the import
+/// of every Python module and `dlopen` of every shared library. If the file
+/// fails to load, the module has no procedures, transformations or functions.
+class LazyModule final : public Module {
+ public:
+  explicit LazyModule(std::filesystem::path file_path) : file_path_(std::move(file_path)) {}
+  ~LazyModule() override = default;
+  LazyModule(const LazyModule &) = delete;
+  LazyModule(LazyModule &&) = delete;
+  LazyModule &operator=(const LazyModule &) = delete;
+  LazyModule &operator=(LazyModule &&) = delete;
+
+  /// Loads the file unless it was already loaded. Concurrent calls wait for
+  /// the first one to finish.
+  void Load() const {
+    std::call_once(loaded_, [this] { module_ = LoadModuleFromFile(file_path_); });
+  }
+
+  bool Close() override {
+    std::unique_ptr<Module> module;
+    // Close may be called only while no call uses the module, so the file is
+    // loaded by now or it never will be.
+    std::call_once(loaded_, [] {});
+    module.swap(module_);
+    return !module || module->Close();
+  }
+
+  const std::map<std::string, mgp_proc, std::less<>> *Procedures() const override {
+    Load();
+    return module_ ? module_->Procedures() : &procedures_;
+  }
+  const std::map<std::string, mgp_trans, std::less<>> *Transformations() const override {
+    Load();
+    return module_ ? module_->Transformations() : &transformations_;
+  }
+  const std::map<std::string, mgp_func, std::less<>> *Functions() const override {
+    Load();
+    return module_ ? module_->Functions() : &functions_;
+  }
+  std::optional<std::filesystem::path> Path() const override { return file_path_; }
+
+ private:
+  std::filesystem::path file_path_;
+  mutable std::once_flag loaded_;
+  mutable std::unique_ptr<Module> module_;
+  // Empty, returned if the file failed to load.
+  std::map<std::string, mgp_proc, std::less<>> procedures_;
+  std::map<std::string, mgp_trans, std::less<>> transformations_;
+  std::map<std::string, mgp_func, std::less<>> functions_;
+};
+
 }  // namespace
 
 bool ModuleRegistry::RegisterModule(const std::string_view name, std::unique_ptr<Module> module) {
@@ -1180,6 +1918,12 @@ void ModuleRegistry::DoUnloadAllModules() {
 ModuleRegistry::ModuleRegistry() {
   auto module = std::make_unique<BuiltinModule>();
   RegisterMgProcedures(&modules_, module.get());
+  RegisterMgProcedureStats(module.get());
+  RegisterMgQueryStats(module.get());
+  RegisterMgDeltaChains(module.get());
+  RegisterMgTextSearch(module.get());
+  RegisterMgVectorSearch(module.get());
+  RegisterMgAggregate(module.get());
   RegisterMgTransformations(&modules_, module.get());
   RegisterMgFunctions(&modules_, module.get());
   RegisterMgLoad(this, &lock_, module.get());
@@ -1224,7 +1968,9 @@ bool ModuleRegistry::LoadOrReloadModuleFromName(const std::string_view name) {
   std::unique_lock<utils::RWLock> guard(lock_);
   auto found_it = modules_.find(name);
   if (found_it != modules_.end()) {
-    if (!found_it->second->Close()) {
+    // A module which is still used by a call is closed by its destructor once
+    // the call finishes.
+    if (found_it->second.use_count() == 1 && !found_it->second->Close()) {
       spdlog::warn("Failed to close module {}", found_it->first);
     }
     modules_.erase(found_it);
@@ -1250,6 +1996,10 @@ void ModuleRegistry::LoadModulesFromDirectory(const std::filesystem::path &modul
     if (entry.is_regular_file()) {
       std::string name = path.stem();
       if (name.empty()) continue;
+      if (lazy_loading_ && (path.extension() == ".so" || path.extension() == ".py")) {
+        RegisterModule(name, std::make_unique<LazyModule>(path));
+        continue;
+      }
       auto module = LoadModuleFromFile(path);
       if (!module) continue;
       RegisterModule(name, std::move(module));
@@ -1265,11 +2015,43 @@ void ModuleRegistry::UnloadAndLoadModulesFromDirectories() {
   }
 }
 
+void ModuleRegistry::SetLazyLoading(const bool lazy_loading) {
+  std::unique_lock<utils::RWLock> guard(lock_);
+  lazy_loading_ = lazy_loading;
+}
+
+void ModuleRegistry::LoadLazyModules(const uint64_t threads) const {
+  std::vector<std::shared_ptr<const LazyModule>> lazy_modules;
+  {
+    std::shared_lock<utils::RWLock> guard(lock_);
+    for (const auto &[name, module] : modules_) {
+      if (auto lazy_module = std::dynamic_pointer_cast<const LazyModule>(module)) {
+        lazy_modules.push_back(std::move(lazy_module));
+      }
+    }
+  }
+  // The modules are loaded without the lock, so that the calls of the loaded
+  // modules and `mg.load_all` aren't blocked meanwhile. A module which is
+  // unloaded in the meantime is closed once it's loaded here.
+  std::atomic<size_t> next_module{0};
+  auto load = [&] {
+    for (auto i = next_module.fetch_add(1); i < lazy_modules.size(); i = next_module.fetch_add(1)) {
+      lazy_modules[i]->Load();
+    }
+  };
+  std::vector<std::jthread> workers;
+  const auto worker_count = std::min<uint64_t>(std::max<uint64_t>(threads, 1), lazy_modules.size());
+  workers.reserve(worker_count);
+  for (uint64_t i = 0; i < worker_count; ++i) workers.emplace_back(load);
+  workers.clear();
+  spdlog::info("Loaded {} query modules in the background.", lazy_modules.size());
+}
+
 ModulePtr ModuleRegistry::GetModuleNamed(const std::string_view name) const {
   std::shared_lock<utils::RWLock> guard(lock_);
   auto found_it = modules_.find(name);
   if (found_it == modules_.end()) return ModulePtr{nullptr};
-  return ModulePtr(found_it->second.get(), std::move(guard));
+  return ModulePtr(found_it->second, std::move(guard));
 }
 
 void ModuleRegistry::UnloadAllModules() {
@@ -55,25 +55,34 @@ class Module {
 
 /// Proxy for a registered Module, acquires a read lock from ModuleRegistry.
 class ModulePtr final {
-  const Module *module_{nullptr};
+  std::shared_ptr<const Module> module_;
   std::shared_lock<utils::RWLock> lock_;
 
  public:
   ModulePtr() = default;
   explicit ModulePtr(std::nullptr_t) {}
-  ModulePtr(const Module *module, std::shared_lock<utils::RWLock> lock) : module_(module), lock_(std::move(lock)) {}
+  ModulePtr(std::shared_ptr<const Module> module, std::shared_lock<utils::RWLock> lock)
+      : module_(std::move(module)), lock_(std::move(lock)) {}
 
   explicit operator bool() const { return static_cast<bool>(module_); }
 
+  /// Release the read lock while keeping the module loaded. The module may be
+  /// unloaded from the registry in the meantime, but it's closed only once the
+  /// last ModulePtr to it is destroyed. Used by calls which outlive a single
+  /// pull, since a thread mustn't take the lock again while holding it.
+  void Unlock() {
+    if (lock_.owns_lock()) lock_.unlock();
+  }
+
   const Module &operator*() const { return *module_; }
-  const Module *operator->() const { return module_; }
+  const Module *operator->() const { return module_.get(); }
 };
 
 /// Thread-safe registration of modules from libraries, uses utils::RWLock.
 class ModuleRegistry final {
   friend CypherMainVisitorTest;
 
-  std::map<std::string, std::unique_ptr<Module>, std::less<>> modules_;
+  std::map<std::string, std::shared_ptr<Module>, std::less<>> modules_;
   mutable utils::RWLock lock_{utils::RWLock::Priority::WRITE};
   std::unique_ptr<utils::MemoryResource> shared_{std::make_unique<utils::ResourceWithOutOfMemoryException>()};
 
@@ -113,6 +122,20 @@ class ModuleRegistry final {
   /// Takes a write lock.
   void UnloadAndLoadModulesFromDirectories();
 
+  /// Set whether the Python and shared library modules found by
+  /// `UnloadAndLoadModulesFromDirectories` are loaded only when their
+  /// procedures, transformations or functions are first needed. Modules loaded
+  /// by name are always loaded at once.
+  ///
+  /// Takes a write lock.
+  void SetLazyLoading(bool lazy_loading);
+
+  /// Load the lazily loaded modules which weren't loaded yet on `threads`
+  /// threads and return once they are all loaded.
+  ///
+  /// Takes a read lock only to list the modules.
+  void LoadLazyModules(uint64_t threads) const;
+
   /// Find a module with given name or return nullptr.
   /// Takes a read lock.
   ModulePtr GetModuleNamed(std::string_view name) const;
@@ -173,6 +196,7 @@ class ModuleRegistry final {
 #endif
   std::vector<std::filesystem::path> modules_dirs_;
   std::filesystem::path internal_module_dir_;
+  bool lazy_loading_{false};
 };
 
 /// Single, global module registry.
@@ -0,0 +1,69 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/procedure/procedure_stats.hpp"
+
+#include <ctime>
+
+namespace memgraph::query::procedure {
+
+ProcedureStats gProcedureStats;
+
+void ProcedureStats::Record(std::string_view procedure_name, const ProcedureCallStats &call) {
+  auto *entry = entries_.WithLock([procedure_name](auto &entries) {
+    auto it = entries.find(procedure_name);
+    if (it == entries.end()) {
+      it = entries.emplace(std::string(procedure_name), std::make_unique<Entry>()).first;
+    }
+    return it->second.get();
+  });
+  entry->calls.fetch_add(1, std::memory_order_relaxed);
+  if (call.failed) entry->failed_calls.fetch_add(1, std::memory_order_relaxed);
+  entry->allocated_bytes.fetch_add(call.allocated_bytes, std::memory_order_relaxed);
+  entry->vertices.fetch_add(call.vertices, std::memory_order_relaxed);
+  entry->edges.fetch_add(call.edges, std::memory_order_relaxed);
+  entry->wall_time.Measure(call.wall_time_us);
+  entry->cpu_time.Measure(call.cpu_time_us);
+}
+
+std::vector<ProcedureStatsInfo> ProcedureStats::GetInfo() const {
+  std::vector<std::pair<std::string, const Entry *>> entries;
+  entries_.WithLock([&entries](const auto &all_entries) {
+    entries.reserve(all_entries.size());
+    for (const auto &[name, entry] : all_entries) entries.emplace_back(name, entry.get());
+  });
+
+  // The percentiles are computed without holding the lock, since they scan
+  // all the buckets of the histograms.
+  std::vector<ProcedureStatsInfo> info;
+  info.reserve(entries.size());
+  for (auto &[name, entry] : entries) {
+    info.push_back(ProcedureStatsInfo{.name = std::move(name),
+                                      .calls = entry->calls.load(std::memory_order_relaxed),
+                                      .failed_calls = entry->failed_calls.load(std::memory_order_relaxed),
+                                      .wall_time_us = entry->wall_time.Sum(),
+                                      .cpu_time_us = entry->cpu_time.Sum(),
+                                      .allocated_bytes = entry->allocated_bytes.load(std::memory_order_relaxed),
+                                      .vertices = entry->vertices.load(std::memory_order_relaxed),
+                                      .edges = entry->edges.load(std::memory_order_relaxed),
+                                      .wall_time_percentiles = entry->wall_time.YieldPercentiles(),
+                                      .cpu_time_percentiles = entry->cpu_time.YieldPercentiles()});
+  }
+  return info;
+}
+
+uint64_t ProcedureStats::ThreadCpuTimeUs() {
+  timespec time{};
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) return 0;
+  return static_cast<uint64_t>(time.tv_sec) * 1000000U + static_cast<uint64_t>(time.tv_nsec) / 1000U;
+}
+
+}  // namespace memgraph::query::procedure
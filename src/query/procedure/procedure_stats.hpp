@@ -0,0 +1,123 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Accounting of the resources used by the calls of query procedures, which is
+/// exported by the metrics endpoint and returned by `mg.procedure_stats()`.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "utils/event_histogram.hpp"
+#include "utils/memory.hpp"
+#include "utils/spin_lock.hpp"
+#include "utils/synchronized.hpp"
+
+namespace memgraph::query::procedure {
+
+/// Vertices and edges which the `mgp_*` functions handed to a call of a
+/// procedure. The counters are atomic, since the workers of
+/// `mgp_graph_parallel_for_vertices` share them.
+struct GraphAccessCounters {
+  std::atomic<uint64_t> vertices{0};
+  std::atomic<uint64_t> edges{0};
+};
+
+/// Memory resource which counts all the bytes allocated through it, including
+/// the ones which were deallocated since.
+class AllocationCountingResource final : public utils::MemoryResource {
+ public:
+  explicit AllocationCountingResource(utils::MemoryResource *upstream) : upstream_(upstream) {}
+
+  uint64_t GetAllocatedBytes() const { return allocated_bytes_.load(std::memory_order_relaxed); }
+
+ private:
+  void *DoAllocate(size_t bytes, size_t alignment) override {
+    auto *ptr = upstream_->Allocate(bytes, alignment);
+    allocated_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    return ptr;
+  }
+
+  void DoDeallocate(void *ptr, size_t bytes, size_t alignment) override {
+    upstream_->Deallocate(ptr, bytes, alignment);
+  }
+
+  bool DoIsEqual(const utils::MemoryResource &other) const noexcept override { return this == &other; }
+
+  utils::MemoryResource *upstream_;
+  std::atomic<uint64_t> allocated_bytes_{0};
+};
+
+/// Resources used by a single call of a procedure. The CPU time is the time of
+/// the thread which called the procedure, so it doesn't include the threads
+/// which the procedure started itself.
+struct ProcedureCallStats {
+  uint64_t wall_time_us{0};
+  uint64_t cpu_time_us{0};
+  uint64_t allocated_bytes{0};
+  uint64_t vertices{0};
+  uint64_t edges{0};
+  bool failed{false};
+};
+
+/// Totals of all the calls of a procedure, with the percentiles of their times
+/// given as (percentile, microseconds) pairs.
+struct ProcedureStatsInfo {
+  std::string name;
+  uint64_t calls{0};
+  uint64_t failed_calls{0};
+  uint64_t wall_time_us{0};
+  uint64_t cpu_time_us{0};
+  uint64_t allocated_bytes{0};
+  uint64_t vertices{0};
+  uint64_t edges{0};
+  std::vector<std::pair<uint64_t, uint64_t>> wall_time_percentiles;
+  std::vector<std::pair<uint64_t, uint64_t>> cpu_time_percentiles;
+};
+
+/// Stats of the procedures, keyed by their fully qualified names. The stats of
+/// a procedure are kept after its module is unloaded, so that they also
+/// describe the previous versions of reloaded modules.
+class ProcedureStats final {
+ public:
+  void Record(std::string_view procedure_name, const ProcedureCallStats &call);
+
+  /// Returns the stats of all the called procedures, sorted by name.
+  std::vector<ProcedureStatsInfo> GetInfo() const;
+
+  /// Current time of the calling thread spent on the CPU.
+  static uint64_t ThreadCpuTimeUs();
+
+ private:
+  struct Entry {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> failed_calls{0};
+    std::atomic<uint64_t> allocated_bytes{0};
+    std::atomic<uint64_t> vertices{0};
+    std::atomic<uint64_t> edges{0};
+    metrics::Histogram wall_time{{50, 90, 99}};
+    metrics::Histogram cpu_time{{50, 90, 99}};
+  };
+
+  // Entries are never removed, so they can be updated without holding the lock.
+  mutable utils::Synchronized<std::map<std::string, std::unique_ptr<Entry>, std::less<>>, utils::SpinLock> entries_;
+};
+
+extern ProcedureStats gProcedureStats;
+
+}  // namespace memgraph::query::procedure
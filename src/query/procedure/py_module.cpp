@@ -15,11 +15,13 @@
 #include <methodobject.h>
 #include <pyerrors.h>
 #include <array>
+#include <memory>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "mg_procedure.h"
 #include "query/exceptions.hpp"
@@ -389,6 +391,191 @@ PyObject *PyGraphMustAbort(PyGraph *self, PyObject *Py_UNUSED(ignored)) {
   return PyBool_FromLong(mgp_must_abort(self->graph));
 }
 
+// The arrays of a graph projection don't belong to the execution memory, so
+// unlike the other objects `_mgp.GraphProjection` stays valid after the
+// procedure call, together with the buffers exported from it.
+//
+// clang-format off
+struct PyGraphProjection {
+  PyObject_HEAD
+  std::shared_ptr<const mgp_graph_projection_data> *data;
+};
+// clang-format on
+
+void PyGraphProjectionDealloc(PyGraphProjection *self) {
+  delete self->data;
+  Py_TYPE(self)->tp_free(self);
+}
+
+// One of the arrays of a projection, exported through the buffer protocol.
+//
+// clang-format off
+struct PyGraphProjectionArray {
+  PyObject_HEAD
+  PyGraphProjection *py_projection;
+  const void *data;
+  Py_ssize_t size;
+  Py_ssize_t item_size;
+  const char *format;
+};
+// clang-format on
+
+void PyGraphProjectionArrayDealloc(PyGraphProjectionArray *self) {
+  Py_DECREF(self->py_projection);
+  Py_TYPE(self)->tp_free(self);
+}
+
+int PyGraphProjectionArrayGetBuffer(PyGraphProjectionArray *self, Py_buffer *view, int flags) {
+  if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+    PyErr_SetString(PyExc_BufferError, "The arrays of a graph projection are read-only.");
+    return -1;
+  }
+  // An empty vector has no data, but buffers are expected to point somewhere.
+  static const uint64_t kEmpty{0};
+  view->obj = reinterpret_cast<PyObject *>(self);
+  Py_INCREF(view->obj);
+  view->buf = const_cast<void *>(self->size == 0 ? &kEmpty : self->data);
+  view->len = self->size * self->item_size;
+  view->readonly = 1;
+  view->itemsize = self->item_size;
+  view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? const_cast<char *>(self->format) : nullptr;
+  view->ndim = 1;
+  view->shape = (flags & PyBUF_ND) == PyBUF_ND ? &self->size : nullptr;
+  view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? &self->item_size : nullptr;
+  view->suboffsets = nullptr;
+  view->internal = nullptr;
+  return 0;
+}
+
+static PyBufferProcs PyGraphProjectionArrayBufferProcs = {
+    .bf_getbuffer = reinterpret_cast<getbufferproc>(PyGraphProjectionArrayGetBuffer),
+    .bf_releasebuffer = nullptr,
+};
+
+// clang-format off
+static PyTypeObject PyGraphProjectionArrayType = {
+    PyVarObject_HEAD_INIT(nullptr, 0)
+    .tp_name = "_mgp.GraphProjectionArray",
+    .tp_basicsize = sizeof(PyGraphProjectionArray),
+    .tp_dealloc = reinterpret_cast<destructor>(PyGraphProjectionArrayDealloc),
+    .tp_as_buffer = &PyGraphProjectionArrayBufferProcs,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Read-only array of a graph projection, which supports the buffer protocol.",
+};
+// clang-format on
+
+static_assert(sizeof(size_t) == sizeof(unsigned long long) && sizeof(mgp_vertex_id) == sizeof(long long),
+              "The formats of the projection arrays don't match their types.");
+
+template <class T>
+PyObject *MakePyGraphProjectionArray(PyGraphProjection *py_projection, const std::vector<T> &values,
+                                     const char *format) {
+  auto *py_array = PyObject_New(PyGraphProjectionArray, &PyGraphProjectionArrayType);
+  if (!py_array) return nullptr;
+  Py_INCREF(py_projection);
+  py_array->py_projection = py_projection;
+  py_array->data = values.data();
+  py_array->size = static_cast<Py_ssize_t>(values.size());
+  py_array->item_size = sizeof(T);
+  py_array->format = format;
+  // The memoryview keeps the array alive, and with it the projection.
+  auto *memory_view = PyMemoryView_FromObject(reinterpret_cast<PyObject *>(py_array));
+  Py_DECREF(py_array);
+  return memory_view;
+}
+
+PyObject *PyGraphProjectionVertexIds(PyGraphProjection *self, PyObject *Py_UNUSED(ignored)) {
+  return MakePyGraphProjectionArray(self, (*self->data)->vertex_ids, "q");
+}
+
+PyObject *PyGraphProjectionOffsets(PyGraphProjection *self, PyObject *Py_UNUSED(ignored)) {
+  return MakePyGraphProjectionArray(self, (*self->data)->offsets, "Q");
+}
+
+PyObject *PyGraphProjectionTargets(PyGraphProjection *self, PyObject *Py_UNUSED(ignored)) {
+  return MakePyGraphProjectionArray(self, (*self->data)->targets, "Q");
+}
+
+PyObject *PyGraphProjectionWeights(PyGraphProjection *self, PyObject *Py_UNUSED(ignored)) {
+  if (!(*self->data)->has_weights) Py_RETURN_NONE;
+  return MakePyGraphProjectionArray(self, (*self->data)->weights, "d");
+}
+
+static PyMethodDef PyGraphProjectionMethods[] = {
+    {"__reduce__", reinterpret_cast<PyCFunction>(DisallowPickleAndCopy), METH_NOARGS, "__reduce__ is not supported"},
+    {"vertex_ids", reinterpret_cast<PyCFunction>(PyGraphProjectionVertexIds), METH_NOARGS,
+     "Return a memoryview of the IDs of the projected vertices, indexed by their ordinals."},
+    {"offsets", reinterpret_cast<PyCFunction>(PyGraphProjectionOffsets), METH_NOARGS,
+     "Return a memoryview of the offsets of the outbound edges of the vertices."},
+    {"targets", reinterpret_cast<PyCFunction>(PyGraphProjectionTargets), METH_NOARGS,
+     "Return a memoryview of the ordinals of the destinations of the edges."},
+    {"weights", reinterpret_cast<PyCFunction>(PyGraphProjectionWeights), METH_NOARGS,
+     "Return a memoryview of the weights of the edges or None."},
+    {nullptr, {}, {}, {}},
+};
+
+// clang-format off
+static PyTypeObject PyGraphProjectionType = {
+    PyVarObject_HEAD_INIT(nullptr, 0)
+    .tp_name = "_mgp.GraphProjection",
+    .tp_basicsize = sizeof(PyGraphProjection),
+    .tp_dealloc = reinterpret_cast<destructor>(PyGraphProjectionDealloc),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Wraps struct mgp_graph_projection.",
+    .tp_methods = PyGraphProjectionMethods,
+};
+// clang-format on
+
+std::optional<std::vector<std::string>> ParseNames(PyObject *sequence) {
+  py::Object py_names(PySequence_Fast(sequence, "Expected a sequence of names."));
+  if (!py_names) return std::nullopt;
+  std::vector<std::string> names;
+  const auto size = PySequence_Fast_GET_SIZE(py_names.Ptr());
+  names.reserve(size);
+  for (Py_ssize_t i = 0; i < size; ++i) {
+    const auto *name = PyUnicode_AsUTF8(PySequence_Fast_GET_ITEM(py_names.Ptr(), i));
+    if (!name) return std::nullopt;
+    names.emplace_back(name);
+  }
+  return names;
+}
+
+PyObject *PyGraphProject(PyGraph *self, PyObject *args) {
+  MG_ASSERT(PyGraphIsValidImpl(*self));
+  MG_ASSERT(self->memory);
+  PyObject *py_labels{nullptr};
+  PyObject *py_edge_types{nullptr};
+  const char *weight_property{nullptr};
+  double default_weight{1.0};
+  if (!PyArg_ParseTuple(args, "OOzd", &py_labels, &py_edge_types, &weight_property, &default_weight)) return nullptr;
+  const auto labels = ParseNames(py_labels);
+  if (!labels) return nullptr;
+  const auto edge_types = ParseNames(py_edge_types);
+  if (!edge_types) return nullptr;
+  std::vector<const char *> label_names;
+  for (const auto &label : *labels) label_names.push_back(label.c_str());
+  std::vector<const char *> edge_type_names;
+  for (const auto &edge_type : *edge_types) edge_type_names.push_back(edge_type.c_str());
+
+  MgpUniquePtr<mgp_graph_projection> projection{nullptr, mgp_graph_projection_destroy};
+  mgp_error error{mgp_error::MGP_ERROR_NO_ERROR};
+  {
+    // Building the projection only reads the graph, so the Python procedures
+    // of the other queries may run in the meantime.
+    const py::ReleaseGIL no_gil;
+    error = CreateMgpObject(projection, mgp_graph_project, self->graph, label_names.data(), label_names.size(),
+                            edge_type_names.data(), edge_type_names.size(), weight_property, default_weight,
+                            self->memory);
+  }
+  if (RaiseExceptionFromErrorCode(error)) {
+    return nullptr;
+  }
+  auto *py_projection = PyObject_New(PyGraphProjection, &PyGraphProjectionType);
+  if (!py_projection) return nullptr;
+  py_projection->data = new std::shared_ptr<const mgp_graph_projection_data>(projection->data);
+  return reinterpret_cast<PyObject *>(py_projection);
+}
+
 static PyMethodDef PyGraphMethods[] = {
     {"__reduce__", reinterpret_cast<PyCFunction>(DisallowPickleAndCopy), METH_NOARGS, "__reduce__ is not supported"},
     {"invalidate", reinterpret_cast<PyCFunction>(PyGraphInvalidate), METH_NOARGS,
@@ -408,6 +595,8 @@ static PyMethodDef PyGraphMethods[] = {
     {"iter_vertices", reinterpret_cast<PyCFunction>(PyGraphIterVertices), METH_NOARGS, "Return _mgp.VerticesIterator."},
     {"must_abort", reinterpret_cast<PyCFunction>(PyGraphMustAbort), METH_NOARGS,
      "Check whether the running procedure should abort"},
+    {"project", reinterpret_cast<PyCFunction>(PyGraphProject), METH_VARARGS,
+     "Return _mgp.GraphProjection of the vertices with the labels and the edges of the types."},
     {nullptr, {}, {}, {}},
 };
 
@@ -888,7 +1077,16 @@ std::optional<py::ExceptionInfo> AddRecordFromPython(mgp_result *result, py::Obj
   py::Object items(PyDict_Items(fields.Ptr()));
   if (!items) return py::FetchError();
   mgp_result_record *record{nullptr};
-  if (RaiseExceptionFromErrorCode(mgp_result_new_record(result, &record))) {
+  mgp_error error{mgp_error::MGP_ERROR_NO_ERROR};
+  if (result->IsFull()) {
+    // The procedure waits for its records to be pulled, which may run Python
+    // code of the query on another thread.
+    const py::ReleaseGIL no_gil;
+    error = mgp_result_new_record(result, &record);
+  } else {
+    error = mgp_result_new_record(result, &record);
+  }
+  if (RaiseExceptionFromErrorCode(error)) {
     return py::FetchError();
   }
   Py_ssize_t len = PyList_GET_SIZE(items.Ptr());
@@ -932,7 +1130,7 @@ std::optional<py::ExceptionInfo> AddMultipleRecordsFromPython(mgp_result *result
                                                               mgp_memory *memory) {
   Py_ssize_t len = PySequence_Size(py_seq.Ptr());
   if (len == -1) return py::FetchError();
-  result->rows.reserve(len);
+  if (!result->flush) result->rows.reserve(len);
   // This proved to be good enough constant not to lose performance on transformation
   static constexpr auto del_cnt{100000};
   for (Py_ssize_t i = 0, curr_item = 0; i < len; ++i, ++curr_item) {
@@ -2319,6 +2517,8 @@ PyObject *PyInitMgpModule() {
   if (!register_type(&PyVerticesIteratorType, "VerticesIterator")) return nullptr;
   if (!register_type(&PyEdgesIteratorType, "EdgesIterator")) return nullptr;
   if (!register_type(&PyGraphType, "Graph")) return nullptr;
+  if (!register_type(&PyGraphProjectionType, "GraphProjection")) return nullptr;
+  if (!register_type(&PyGraphProjectionArrayType, "GraphProjectionArray")) return nullptr;
   if (!register_type(&PyEdgeType, "Edge")) return nullptr;
   if (!register_type(&PyQueryProcType, "Proc")) return nullptr;
   if (!register_type(&PyMagicFuncType, "Func")) return nullptr;
@@ -0,0 +1,93 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/query_stats.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace memgraph::query {
+
+QueryStats gQueryStats;
+
+void QueryStats::Record(std::string_view query, const QueryExecutionInfo &execution, const uint64_t max_queries,
+                        const QueryParameterTypes &parameter_types) {
+  if (max_queries == 0) return;
+  entries_.WithLock([&](auto &entries) {
+    auto it = entries.find(execution.query_hash);
+    if (it == entries.end()) {
+      if (entries.size() >= max_queries) {
+        entries.erase(std::min_element(entries.begin(), entries.end(), [](const auto &lhs, const auto &rhs) {
+          return lhs.second.calls < rhs.second.calls;
+        }));
+      }
+      it = entries.emplace(execution.query_hash, Entry{.query = std::string(query), .parameter_types = parameter_types})
+               .first;
+    }
+    auto &entry = it->second;
+    entry.plan_hash = execution.plan_hash;
+    ++entry.calls;
+    entry.total_time_us += execution.time_us;
+    entry.max_time_us = std::max(entry.max_time_us, execution.time_us);
+    entry.rows += execution.rows;
+    entry.max_memory_bytes = std::max(entry.max_memory_bytes, execution.memory_bytes);
+  });
+}
+
+void QueryStats::LogSlowQuery(SlowQueryInfo slow_query, const uint64_t log_size) {
+  if (!slow_query.profile) {
+    profile_requests_.WithLock([this, query_hash = slow_query.execution.query_hash](auto &profile_requests) {
+      if (profile_requests.insert(query_hash).second) profile_request_count_.fetch_add(1, std::memory_order_relaxed);
+    });
+  }
+  if (log_size == 0) return;
+  slow_queries_.WithLock([&](auto &slow_queries) {
+    while (slow_queries.size() >= log_size) slow_queries.pop_front();
+    slow_queries.push_back(std::move(slow_query));
+  });
+}
+
+bool QueryStats::TakeProfileRequest(const uint64_t query_hash) {
+  if (profile_request_count_.load(std::memory_order_relaxed) == 0) return false;
+  return profile_requests_.WithLock([this, query_hash](auto &profile_requests) {
+    if (profile_requests.erase(query_hash) == 0) return false;
+    profile_request_count_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  });
+}
+
+std::vector<QueryStatsInfo> QueryStats::GetInfo() const {
+  std::vector<QueryStatsInfo> info;
+  entries_.WithLock([&info](const auto &entries) {
+    info.reserve(entries.size());
+    for (const auto &[query_hash, entry] : entries) {
+      info.push_back(QueryStatsInfo{.query_hash = query_hash,
+                                    .query = entry.query,
+                                    .parameter_types = entry.parameter_types,
+                                    .plan_hash = entry.plan_hash,
+                                    .calls = entry.calls,
+                                    .total_time_us = entry.total_time_us,
+                                    .max_time_us = entry.max_time_us,
+                                    .rows = entry.rows,
+                                    .max_memory_bytes = entry.max_memory_bytes});
+    }
+  });
+  std::sort(info.begin(), info.end(),
+            [](const auto &lhs, const auto &rhs) { return lhs.total_time_us > rhs.total_time_us; });
+  return info;
+}
+
+std::vector<SlowQueryInfo> QueryStats::GetSlowQueries() const {
+  return slow_queries_.WithLock(
+      [](const auto &slow_queries) { return std::vector<SlowQueryInfo>(slow_queries.begin(), slow_queries.end()); });
+}
+
+}  // namespace memgraph::query
@@ -0,0 +1,126 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Statistics of the executed queries, keyed by the hash of their stripped
+/// text, and the log of the slow executions, which are returned by
+/// `mg.query_stats()` and `mg.slow_queries()`.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "storage/v2/property_value.hpp"
+#include "utils/spin_lock.hpp"
+#include "utils/synchronized.hpp"
+
+namespace memgraph::query {
+
+/// Names of the user parameters of a query with the types of their values.
+using QueryParameterTypes = std::vector<std::pair<std::string, storage::PropertyValue::Type>>;
+
+/// Execution of a query which pulled all of its results. The memory is the
+/// peak of the query's transaction up to the end of the query.
+struct QueryExecutionInfo {
+  uint64_t query_hash{0};
+  uint64_t plan_hash{0};
+  uint64_t time_us{0};
+  uint64_t rows{0};
+  uint64_t memory_bytes{0};
+};
+
+/// Totals of all the executions of a query. The plan hash is the one of the
+/// query's last execution and the parameter types the ones of its first.
+struct QueryStatsInfo {
+  uint64_t query_hash{0};
+  std::string query;
+  QueryParameterTypes parameter_types;
+  uint64_t plan_hash{0};
+  uint64_t calls{0};
+  uint64_t total_time_us{0};
+  uint64_t max_time_us{0};
+  uint64_t rows{0};
+  uint64_t max_memory_bytes{0};
+};
+
+/// Slow execution of a query, with the plan it was executed with. The profile
+/// is only there if the execution was profiled.
+struct SlowQueryInfo {
+  // Microseconds since the epoch, like `QueryTimestamp()`.
+  int64_t timestamp{0};
+  std::string query;
+  QueryExecutionInfo execution;
+  std::string plan;
+  std::optional<std::string> profile;
+};
+
+/// Statistics of the queries, like the `pg_stat_statements` of PostgreSQL.
+/// The queries are identified by the hash of their stripped text, which is the
+/// key of the AST and plan caches, so the executions of a query with different
+/// literals or parameters are counted together.
+/// This class is thread safe.
+class QueryStats final {
+ public:
+  /// Adds the execution to the statistics of the query. If `max_queries`
+  /// queries are already tracked, the one with the fewest calls is removed to
+  /// make room for a new one. Nothing is recorded if `max_queries` is 0.
+  void Record(std::string_view query, const QueryExecutionInfo &execution, uint64_t max_queries,
+              const QueryParameterTypes &parameter_types = {});
+
+  /// Adds the slow execution to the log, from which the oldest one is removed
+  /// once it holds `log_size` executions. If the execution wasn't profiled, the
+  /// next execution of the query will be, see `TakeProfileRequest`.
+  void LogSlowQuery(SlowQueryInfo slow_query, uint64_t log_size);
+
+  /// Returns true if the query should be profiled because its last slow
+  /// execution wasn't. Each request is taken only once.
+  bool TakeProfileRequest(uint64_t query_hash);
+
+  /// Returns the statistics of the tracked queries, sorted by their total
+  /// time, longest first.
+  std::vector<QueryStatsInfo> GetInfo() const;
+
+  /// Returns the logged slow executions, oldest first.
+  std::vector<SlowQueryInfo> GetSlowQueries() const;
+
+ private:
+  struct Entry {
+    std::string query;
+    QueryParameterTypes parameter_types;
+    uint64_t plan_hash{0};
+    uint64_t calls{0};
+    uint64_t total_time_us{0};
+    uint64_t max_time_us{0};
+    uint64_t rows{0};
+    uint64_t max_memory_bytes{0};
+  };
+
+  // The entries are small and updated in place, so they are guarded by a spin
+  // lock. The lock is only held for long while a query is evicted.
+  mutable utils::Synchronized<std::unordered_map<uint64_t, Entry>, utils::SpinLock> entries_;
+  mutable utils::Synchronized<std::deque<SlowQueryInfo>, utils::SpinLock> slow_queries_;
+  utils::Synchronized<std::unordered_set<uint64_t>, utils::SpinLock> profile_requests_;
+  // Lets `TakeProfileRequest` skip the lock in the common case that there are
+  // no requests.
+  std::atomic<uint64_t> profile_request_count_{0};
+};
+
+extern QueryStats gQueryStats;
+
+}  // namespace memgraph::query
@@ -0,0 +1,204 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/result_cache.hpp"
+
+#include <algorithm>
+
+#include "query/db_accessor.hpp"
+#include "query/plan/operator.hpp"
+
+namespace memgraph::query {
+
+namespace {
+
+// Unlike `PropertyValue::operator==`, the values are the same only if their
+// types are, because the query can return them, e.g. 1 and 1.0.
+bool AreIdenticalValues(const storage::PropertyValue &left, const storage::PropertyValue &right) {
+  if (left.type() != right.type()) return false;
+  switch (left.type()) {
+    case storage::PropertyValue::Type::List:
+      return std::equal(left.ValueList().begin(), left.ValueList().end(), right.ValueList().begin(),
+                        right.ValueList().end(), AreIdenticalValues);
+    case storage::PropertyValue::Type::Map:
+      return std::equal(left.ValueMap().begin(), left.ValueMap().end(), right.ValueMap().begin(),
+                        right.ValueMap().end(), [](const auto &lhs, const auto &rhs) {
+                          return lhs.first == rhs.first && AreIdenticalValues(lhs.second, rhs.second);
+                        });
+    default:
+      return left == right;
+  }
+}
+
+bool AreIdenticalParameters(const Parameters &left, const Parameters &right) {
+  return std::equal(left.begin(), left.end(), right.begin(), right.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.first == rhs.first && AreIdenticalValues(lhs.second, rhs.second);
+  });
+}
+
+class ReadFootprintCollector : public plan::HierarchicalLogicalOperatorVisitor {
+ public:
+  using HierarchicalLogicalOperatorVisitor::PostVisit;
+  using HierarchicalLogicalOperatorVisitor::PreVisit;
+  using HierarchicalLogicalOperatorVisitor::Visit;
+
+  bool PreVisit(plan::ScanAll & /*op*/) override { return ReadAllVertices(); }
+  bool PreVisit(plan::ScanAllById & /*op*/) override { return ReadAllVertices(); }
+  bool PreVisit(plan::ScanAllByLabel &op) override { return ReadLabel(op.label_); }
+  bool PreVisit(plan::ScanAllByLabelPropertyRange &op) override { return ReadLabel(op.label_); }
+  bool PreVisit(plan::ScanAllByLabelPropertyValue &op) override { return ReadLabel(op.label_); }
+  bool PreVisit(plan::ScanAllByLabelPropertyValues &op) override { return ReadLabel(op.label_); }
+  bool PreVisit(plan::ScanAllByLabelProperty &op) override { return ReadLabel(op.label_); }
+  bool PreVisit(plan::ScanAllByLabelPropertyComposite &op) override { return ReadLabel(op.label_); }
+
+  // The vertices reached through the edges can have any labels.
+  bool PreVisit(plan::ScanAllByEdgeType &op) override {
+    ReadAllVertices();
+    return ReadEdgeTypes({op.edge_type_});
+  }
+  bool PreVisit(plan::ScanAllByEdgeTypeProperty &op) override {
+    ReadAllVertices();
+    return ReadEdgeTypes({op.edge_type_});
+  }
+  bool PreVisit(plan::Expand &op) override {
+    ReadAllVertices();
+    return ReadEdgeTypes(op.common_.edge_types);
+  }
+  bool PreVisit(plan::ExpandVariable &op) override {
+    ReadAllVertices();
+    return ReadEdgeTypes(op.common_.edge_types);
+  }
+  bool PreVisit(plan::IntersectExpand &op) override {
+    ReadAllVertices();
+    for (const auto &edge : op.edges_) ReadEdgeTypes(edge.edge_types);
+    return true;
+  }
+
+  bool PreVisit(plan::CallProcedure & /*op*/) override {
+    cacheable_ = false;
+    return false;
+  }
+  bool PreVisit(plan::LoadCsv & /*op*/) override {
+    cacheable_ = false;
+    return false;
+  }
+  bool PreVisit(plan::LoadArrow & /*op*/) override {
+    cacheable_ = false;
+    return false;
+  }
+
+  bool Visit(plan::Once & /*op*/) override { return true; }
+
+  storage::GraphFootprint footprint_;
+  bool cacheable_{true};
+
+ private:
+  bool ReadAllVertices() {
+    footprint_.all_vertices = true;
+    return true;
+  }
+
+  bool ReadLabel(storage::LabelId label) {
+    footprint_.labels.insert(label);
+    return true;
+  }
+
+  // No edge types means edges of any type.
+  bool ReadEdgeTypes(const std::vector<storage::EdgeTypeId> &edge_types) {
+    if (edge_types.empty()) footprint_.all_edges = true;
+    footprint_.edge_types.insert(edge_types.begin(), edge_types.end());
+    return true;
+  }
+};
+
+}  // namespace
+
+std::shared_ptr<const CachedResults> ResultCache::Find(const uint64_t query_hash, const Parameters &parameters,
+                                                       DbAccessor &dba) {
+  const auto graph_version = dba.GraphVersion();
+  if (!graph_version) return nullptr;
+
+  std::shared_ptr<const CachedResults> results;
+  {
+    std::lock_guard guard(lock_);
+    auto it = FindEntry(query_hash, parameters);
+    if (it == entries_.end()) return nullptr;
+    results = it->results;
+    entries_.splice(entries_.begin(), entries_, it);
+  }
+
+  // The transaction may be older than the results, in which case the changes
+  // between the two versions matter as well.
+  const auto last_change = dba.LastGraphChange(results->footprint);
+  if (!last_change || *last_change > std::min(results->graph_version, *graph_version)) return nullptr;
+  return results;
+}
+
+void ResultCache::Insert(const uint64_t query_hash, const Parameters &parameters,
+                         std::shared_ptr<const CachedResults> results) {
+  if (!IsEnabled()) return;
+  std::lock_guard guard(lock_);
+  if (auto it = FindEntry(query_hash, parameters); it != entries_.end()) {
+    // Results of an older transaction don't replace the newer ones.
+    if (it->results->graph_version > results->graph_version) return;
+    it->results = std::move(results);
+    entries_.splice(entries_.begin(), entries_, it);
+    return;
+  }
+  entries_.push_front(Entry{.query_hash = query_hash, .parameters = parameters, .results = std::move(results)});
+  entries_by_hash_.emplace(query_hash, entries_.begin());
+  if (entries_.size() <= max_entries_) return;
+
+  const auto &evicted = entries_.back();
+  auto [begin, end] = entries_by_hash_.equal_range(evicted.query_hash);
+  auto it = std::find_if(begin, end, [&evicted](const auto &item) { return &*item.second == &evicted; });
+  entries_by_hash_.erase(it);
+  entries_.pop_back();
+}
+
+size_t ResultCache::size() const {
+  std::lock_guard guard(lock_);
+  return entries_.size();
+}
+
+std::list<ResultCache::Entry>::iterator ResultCache::FindEntry(const uint64_t query_hash,
+                                                               const Parameters &parameters) {
+  auto [begin, end] = entries_by_hash_.equal_range(query_hash);
+  auto it = std::find_if(begin, end, [&parameters](const auto &item) {
+    return AreIdenticalParameters(item.second->parameters, parameters);
+  });
+  return it != end ? it->second : entries_.end();
+}
+
+std::optional<storage::GraphFootprint> GetReadFootprint(plan::LogicalOperator &plan) {
+  ReadFootprintCollector collector;
+  plan.Accept(collector);
+  if (!collector.cacheable_) return std::nullopt;
+  return std::move(collector.footprint_);
+}
+
+bool IsCacheableValue(const TypedValue &value) {
+  switch (value.type()) {
+    case TypedValue::Type::List:
+      return std::ranges::all_of(value.ValueList(), IsCacheableValue);
+    case TypedValue::Type::Map:
+      return std::ranges::all_of(value.ValueMap(), [](const auto &item) { return IsCacheableValue(item.second); });
+    case TypedValue::Type::Vertex:
+    case TypedValue::Type::Edge:
+    case TypedValue::Type::Path:
+    case TypedValue::Type::Graph:
+      return false;
+    default:
+      return true;
+  }
+}
+
+}  // namespace memgraph::query
@@ -0,0 +1,98 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Cache of the results of the read-only queries, which are served again
+/// without executing the query while the part of the graph it read doesn't
+/// change.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "query/parameters.hpp"
+#include "query/typed_value.hpp"
+#include "storage/v2/graph_changes.hpp"
+
+namespace memgraph::query {
+
+class DbAccessor;
+
+namespace plan {
+class LogicalOperator;
+}  // namespace plan
+
+/// Results of a query, valid for the versions of the graph from `graph_version`
+/// on until a commit changes the part of the graph in `footprint`.
+struct CachedResults {
+  uint64_t graph_version{0};
+  storage::GraphFootprint footprint;
+  std::vector<std::vector<TypedValue>> rows;
+};
+
+/// Results of the read-only queries, keyed by the hash of the stripped query
+/// and the values of its parameters, including the stripped literals. The most
+/// recently used entries are kept once there are more than `max_entries` of
+/// them.
+/// This class is thread safe.
+class ResultCache final {
+ public:
+  ResultCache(size_t max_entries, size_t max_rows) : max_entries_(max_entries), max_rows_(max_rows) {}
+
+  bool IsEnabled() const { return max_entries_ != 0; }
+
+  /// The most rows of a query which are cached.
+  size_t max_rows() const { return max_rows_; }
+
+  /// Returns the results of the query which are still valid in the
+  /// transaction of the accessor, or nullptr if there are none.
+  std::shared_ptr<const CachedResults> Find(uint64_t query_hash, const Parameters &parameters, DbAccessor &dba);
+
+  /// Caches the results of the query, replacing the ones it had before.
+  void Insert(uint64_t query_hash, const Parameters &parameters, std::shared_ptr<const CachedResults> results);
+
+  size_t size() const;
+
+ private:
+  struct Entry {
+    uint64_t query_hash;
+    Parameters parameters;
+    std::shared_ptr<const CachedResults> results;
+  };
+
+  // Returns the entry of the query, which must be called with the lock held.
+  std::list<Entry>::iterator FindEntry(uint64_t query_hash, const Parameters &parameters);
+
+  const size_t max_entries_;
+  const size_t max_rows_;
+
+  mutable std::mutex lock_;
+  // The most recently used entries are at the front.
+  std::list<Entry> entries_;
+  std::unordered_multimap<uint64_t, std::list<Entry>::iterator> entries_by_hash_;
+};
+
+/// Returns the part of the graph the plan reads, or nothing if its results
+/// depend on more than the graph, e.g. on the file read by LOAD CSV.
+std::optional<storage::GraphFootprint> GetReadFootprint(plan::LogicalOperator &plan);
+
+/// Returns whether the value can outlive the transaction which produced it,
+/// which isn't the case for the vertices, the edges and the values that
+/// contain them.
+bool IsCacheableValue(const TypedValue &value);
+
+}  // namespace memgraph::query
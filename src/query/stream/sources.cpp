@@ -27,6 +27,8 @@ KafkaStream::KafkaStream(std::string stream_name, StreamInfo stream_info,
       .batch_size = stream_info.common_info.batch_size,
       .public_configs = std::move(stream_info.configs),
       .private_configs = std::move(stream_info.credentials),
+      .partition_workers = stream_info.partition_workers,
+      .adaptive_batching = stream_info.adaptive_batching,
   };
   consumer_.emplace(std::move(consumer_info), std::move(consumer_function));
 };
@@ -40,7 +42,9 @@ KafkaStream::StreamInfo KafkaStream::Info(std::string transformation_name) const
           .consumer_group = info.consumer_group,
           .bootstrap_servers = info.bootstrap_servers,
           .configs = info.public_configs,
-          .credentials = info.private_configs};
+          .credentials = info.private_configs,
+          .partition_workers = info.partition_workers,
+          .adaptive_batching = info.adaptive_batching};
 }
 
 void KafkaStream::Start() { consumer_->Start(); }
@@ -59,12 +63,15 @@ utils::BasicResult<std::string> KafkaStream::SetStreamOffset(const int64_t offse
   return consumer_->SetConsumerOffsets(offset);
 }
 
+integrations::BatchStats KafkaStream::Stats() const { return consumer_->Stats(); }
+
 namespace {
 const std::string kTopicsKey{"topics"};
 const std::string kConsumerGroupKey{"consumer_group"};
 const std::string kBoostrapServers{"bootstrap_servers"};
 const std::string kConfigs{"configs"};
 const std::string kCredentials{"credentials"};
+const std::string kPartitionWorkers{"partition_workers"};
 
 const std::unordered_map<std::string, std::string> kDefaultConfigsMap;
 }  // namespace
@@ -76,6 +83,7 @@ void to_json(nlohmann::json &data, KafkaStream::StreamInfo &&info) {
   data[kBoostrapServers] = std::move(info.bootstrap_servers);
   data[kConfigs] = std::move(info.configs);
   data[kCredentials] = std::move(info.credentials);
+  data[kPartitionWorkers] = info.partition_workers;
 }
 
 void from_json(const nlohmann::json &data, KafkaStream::StreamInfo &info) {
@@ -86,6 +94,7 @@ void from_json(const nlohmann::json &data, KafkaStream::StreamInfo &info) {
   // These values might not be present in the persisted JSON object
   info.configs = data.value(kConfigs, kDefaultConfigsMap);
   info.credentials = data.value(kCredentials, kDefaultConfigsMap);
+  info.partition_workers = data.value(kPartitionWorkers, uint32_t{1});
 }
 
 PulsarStream::PulsarStream(std::string stream_name, StreamInfo stream_info,
@@ -26,6 +26,9 @@ struct KafkaStream {
     std::string bootstrap_servers;
     std::unordered_map<std::string, std::string> configs;
     std::unordered_map<std::string, std::string> credentials;
+    uint32_t partition_workers{1};
+    // Taken from the configuration whenever the consumer is created, so it isn't persisted.
+    std::optional<integrations::AdaptiveBatchingConfig> adaptive_batching{};
   };
 
   using Message = integrations::kafka::Message;
@@ -45,6 +48,8 @@ struct KafkaStream {
 
   utils::BasicResult<std::string> SetStreamOffset(int64_t offset);
 
+  integrations::BatchStats Stats() const;
+
  private:
   using Consumer = integrations::kafka::Consumer;
   std::optional<Consumer> consumer_;
@@ -11,8 +11,10 @@
 
 #include "query/stream/streams.hpp"
 
+#include <array>
 #include <shared_mutex>
 #include <string_view>
+#include <unordered_set>
 #include <utility>
 
 #include <spdlog/spdlog.h>
@@ -34,6 +36,8 @@
 #include "utils/memory.hpp"
 #include "utils/on_scope_exit.hpp"
 #include "utils/pmr/string.hpp"
+#include "utils/spin_lock.hpp"
+#include "utils/synchronized.hpp"
 #include "utils/variant_helpers.hpp"
 
 namespace memgraph::metrics {
@@ -130,6 +134,121 @@ const std::string kStreamName{"name"};
 const std::string kIsRunningKey{"is_running"};
 const std::string kOwner{"owner"};
 const std::string kType{"type"};
+
+// Interpreter and transformation result used for processing a batch of messages.
+struct ConsumerWorker {
+  ConsumerWorker(InterpreterContext *interpreter_context, utils::MemoryResource *memory_resource)
+      : interpreter{std::make_shared<Interpreter>(interpreter_context)}, result{nullptr, memory_resource} {}
+
+  std::shared_ptr<Interpreter> interpreter;
+  mgp_result result;
+};
+
+// Name of the parameter which holds the rows of a batched query and of the
+// variable each row is unwound into.
+constexpr std::string_view kBatchParamName{"__batch"};
+constexpr std::string_view kBatchRowName{"__batch_row"};
+
+// Returns true if running the query once for each row of `UNWIND` gives the
+// same result as running it for each row separately. Reads aren't allowed,
+// since `MATCH` doesn't see the changes made by the earlier rows of the same
+// query, while it sees the changes of the earlier queries.
+bool IsBatchable(const Query *query) {
+  const auto *cypher_query = utils::Downcast<const CypherQuery>(query);
+  if (!cypher_query || !cypher_query->cypher_unions_.empty() || cypher_query->memory_limit_ ||
+      cypher_query->commit_frequency_ || cypher_query->parallel_execution_) {
+    return false;
+  }
+  return std::all_of(cypher_query->single_query_->clauses_.begin(), cypher_query->single_query_->clauses_.end(),
+                     [](const Clause *clause) {
+                       return utils::IsSubtype(*clause, Create::kType) || utils::IsSubtype(*clause, Merge::kType) ||
+                              utils::IsSubtype(*clause, SetProperty::kType) ||
+                              utils::IsSubtype(*clause, SetProperties::kType) ||
+                              utils::IsSubtype(*clause, SetLabels::kType) ||
+                              utils::IsSubtype(*clause, RemoveProperty::kType) ||
+                              utils::IsSubtype(*clause, RemoveLabels::kType) ||
+                              utils::IsSubtype(*clause, Delete::kType) || utils::IsSubtype(*clause, Unwind::kType) ||
+                              utils::IsSubtype(*clause, Foreach::kType);
+                     });
+}
+
+struct BatchedQuery {
+  std::string query;
+  // Names of the parameters, which each row has to contain.
+  std::vector<std::string> parameters;
+
+  bool HasParameters(const std::map<std::string, storage::PropertyValue> &params) const {
+    return std::all_of(parameters.begin(), parameters.end(), [&](const auto &name) { return params.contains(name); });
+  }
+};
+
+// Returns the query which runs `query` for each row of the `$__batch` list,
+// with the parameters replaced by the properties of the row, or nullopt if
+// the query can't be batched.
+std::optional<BatchedQuery> MakeBatchedQuery(const std::string &query, const InterpreterContext &interpreter_context) {
+  if (query.find(kBatchRowName) != std::string::npos) return std::nullopt;
+  std::string batched_query{fmt::format("UNWIND ${} AS {} ", kBatchParamName, kBatchRowName)};
+  std::vector<std::string> parameters;
+  try {
+    auto statement = PrepareStatement(query, &interpreter_context.ast_cache, interpreter_context.config.query);
+    if (!IsBatchable(statement.cached_query.query)) return std::nullopt;
+
+    auto is_name_char = [](char c) {
+      return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || (c & 0x80) != 0;
+    };
+    // Returns the end of the string or the escaped name starting at `i`.
+    // Backslashes escape the next character in strings, and doubled backticks
+    // escape a backtick in names.
+    auto skip_quoted = [&query](size_t i) {
+      const char quote = query[i++];
+      while (i < query.size()) {
+        if (quote != '`' && query[i] == '\\') {
+          i += 2;
+        } else if (query[i++] == quote) {
+          if (quote != '`' || i == query.size() || query[i] != '`') break;
+          ++i;
+        }
+      }
+      return std::min(i, query.size());
+    };
+    size_t replaced_parameters = 0;
+    for (size_t i = 0; i < query.size();) {
+      const auto begin = i;
+      if (query[i] == '\'' || query[i] == '"' || query[i] == '`') {
+        i = skip_quoted(i);
+      } else if (query.compare(i, 2, "//") == 0) {
+        i = std::min(query.find('\n', i), query.size());
+      } else if (query.compare(i, 2, "/*") == 0) {
+        i = std::min(query.find("*/", i + 2), query.size() - 2) + 2;
+      } else if (query[i] == '$') {
+        const auto name_begin = ++i;
+        if (i < query.size() && query[i] == '`') {
+          i = skip_quoted(i);
+          fmt::format_to(std::back_inserter(batched_query), "{}.{}", kBatchRowName,
+                         std::string_view{query}.substr(name_begin, i - name_begin));
+        } else {
+          while (i < query.size() && is_name_char(query[i])) ++i;
+          fmt::format_to(std::back_inserter(batched_query), "{}.`{}`", kBatchRowName,
+                         std::string_view{query}.substr(name_begin, i - name_begin));
+        }
+        ++replaced_parameters;
+        continue;
+      } else {
+        ++i;
+      }
+      batched_query.append(query, begin, i - begin);
+    }
+    if (replaced_parameters != statement.stripped_query->parameters().size()) return std::nullopt;
+    for (const auto &[position, name] : statement.stripped_query->parameters()) parameters.push_back(name);
+
+    // Make sure the batched query can be prepared before it's executed in the
+    // transaction, which can't continue after a failed query.
+    PrepareStatement(batched_query, &interpreter_context.ast_cache, interpreter_context.config.query);
+  } catch (const utils::BasicException &) {
+    return std::nullopt;
+  }
+  return BatchedQuery{std::move(batched_query), std::move(parameters)};
+}
 }  // namespace
 
 template <Stream TStream>
@@ -364,6 +483,55 @@ void Streams::RegisterKafkaProcedures() {
 
     procedure::gModuleRegistry.RegisterMgProcedure(proc_name, std::move(proc));
   }
+
+  {
+    static constexpr std::string_view proc_name = "kafka_stream_stats";
+    // The intervals and latencies are in milliseconds.
+    static constexpr std::array<std::string_view, 5> result_names{"batch_size", "batch_interval", "last_batch_size",
+                                                                  "last_batch_latency", "lag"};
+
+    auto get_stream_stats = [this](mgp_list *args, mgp_graph * /*graph*/, mgp_result *result, mgp_memory *memory) {
+      auto *arg_stream_name = procedure::Call<mgp_value *>(mgp_list_at, args, 0);
+      const auto *stream_name = procedure::Call<const char *>(mgp_value_get_string, arg_stream_name);
+      auto lock_ptr = streams_.Lock();
+      auto it = GetStream(*lock_ptr, std::string(stream_name));
+      std::visit(utils::Overloaded{
+                     [&](StreamData<KafkaStream> &kafka_stream) {
+                       const auto stats = kafka_stream.stream_source->ReadLock()->Stats();
+                       mgp_result_record *record{nullptr};
+                       if (!procedure::TryOrSetError([&] { return mgp_result_new_record(result, &record); }, result)) {
+                         return;
+                       }
+                       const std::array<int64_t, result_names.size()> values{
+                           stats.batch_size, stats.batch_interval.count(), stats.last_batch_size,
+                           stats.last_batch_latency.count(), stats.lag};
+                       for (size_t i = 0; i < values.size(); ++i) {
+                         procedure::MgpUniquePtr<mgp_value> value{nullptr, mgp_value_destroy};
+                         auto make_value = [&] {
+                           return procedure::CreateMgpObject(value, mgp_value_make_int, values[i], memory);
+                         };
+                         if (!procedure::TryOrSetError(make_value, result) ||
+                             !procedure::InsertResultOrSetError(result, record, result_names[i].data(), value.get())) {
+                           return;
+                         }
+                       }
+                     },
+                     [](auto && /*other*/) {
+                       throw QueryRuntimeException("'{}' can be only used for Kafka stream sources", proc_name);
+                     }},
+                 it->second);
+    };
+
+    mgp_proc proc(proc_name, get_stream_stats, utils::NewDeleteResource());
+    MG_ASSERT(mgp_proc_add_arg(&proc, "stream_name", procedure::Call<mgp_type *>(mgp_type_string)) ==
+              mgp_error::MGP_ERROR_NO_ERROR);
+    for (const auto result_name : result_names) {
+      MG_ASSERT(mgp_proc_add_result(&proc, result_name.data(), procedure::Call<mgp_type *>(mgp_type_int)) ==
+                mgp_error::MGP_ERROR_NO_ERROR);
+    }
+
+    procedure::gModuleRegistry.RegisterMgProcedure(proc_name, std::move(proc));
+  }
 }
 
 void Streams::RegisterPulsarProcedures() {
@@ -479,16 +647,34 @@ Streams::StreamsMap::iterator Streams::CreateConsumer(StreamsMap &map, const std
   if (map.contains(stream_name)) {
     throw StreamsException{"Stream already exists with name '{}'", stream_name};
   }
+  if constexpr (std::same_as<TStream, KafkaStream>) {
+    stream_info.adaptive_batching = interpreter_context_->config.kafka_adaptive_batching;
+  }
 
   auto *memory_resource = utils::NewDeleteResource();
 
   auto consumer_function = [interpreter_context = interpreter_context_, memory_resource, stream_name,
                             transformation_name = stream_info.common_info.transformation_name, owner = owner,
-                            interpreter = std::make_shared<Interpreter>(interpreter_context_),
-                            result = mgp_result{nullptr, memory_resource},
+                            free_workers = std::make_shared<utils::Synchronized<
+                                std::vector<std::unique_ptr<ConsumerWorker>>, utils::SpinLock>>(),
                             total_retries = interpreter_context_->config.stream_transaction_conflict_retries,
-                            retry_interval = interpreter_context_->config.stream_transaction_retry_interval](
-                               const std::vector<typename TStream::Message> &messages) mutable {
+                            retry_interval = interpreter_context_->config.stream_transaction_retry_interval,
+                            batch_queries = interpreter_context_->config.stream_batch_queries](
+                               const std::vector<typename TStream::Message> &messages) {
+    // The consumer can process the batches of different partitions concurrently, each of them with its own worker.
+    auto worker = free_workers->WithLock([&](auto &workers) {
+      if (workers.empty()) {
+        return std::make_unique<ConsumerWorker>(interpreter_context, memory_resource);
+      }
+      auto free_worker = std::move(workers.back());
+      workers.pop_back();
+      return free_worker;
+    });
+    utils::OnScopeExit release_worker{
+        [&]() { free_workers->WithLock([&](auto &workers) { workers.push_back(std::move(worker)); }); }};
+    auto &interpreter = worker->interpreter;
+    auto &result = worker->result;
+
     auto accessor = interpreter_context->db->Access();
     // register new interpreter into interpreter_context_
     interpreter_context->interpreters->insert(interpreter.get());
@@ -506,27 +692,65 @@ Streams::StreamsMap::iterator Streams::CreateConsumer(StreamsMap &map, const std
       interpreter->Abort();
     }};
 
-    const static std::map<std::string, storage::PropertyValue> empty_parameters{};
+    // Consecutive rows with the same query are executed together as a single
+    // batched query, if the query can be batched.
+    struct QueryGroup {
+      std::string query;
+      std::optional<BatchedQuery> batched_query;
+      std::vector<std::map<std::string, storage::PropertyValue>> params;
+    };
+    std::vector<QueryGroup> groups;
+    for (auto &row : result.rows) {
+      auto [query_value, params_value] = ExtractTransformationResult(row.values, transformation_name, stream_name);
+      storage::PropertyValue params_prop{params_value};
+      auto params = params_prop.IsNull() ? empty_parameters : std::move(params_prop.ValueMap());
+      std::string query{query_value.ValueString()};
+      // A missing parameter is an error when the query is executed for a
+      // single row, while it would be null in the batched query.
+      if (batch_queries && !groups.empty() && groups.back().batched_query &&
+          groups.back().query == query && groups.back().batched_query->HasParameters(params)) {
+        groups.back().params.push_back(std::move(params));
+        continue;
+      }
+      auto batched_query = batch_queries ? MakeBatchedQuery(query, *interpreter_context) : std::nullopt;
+      if (batched_query && !batched_query->HasParameters(params)) batched_query.reset();
+      groups.push_back({std::move(query), std::move(batched_query), {}});
+      groups.back().params.push_back(std::move(params));
+    }
+
     uint32_t i = 0;
     while (true) {
       try {
         interpreter->BeginTransaction();
-        for (auto &row : result.rows) {
-          spdlog::trace("Processing row in stream '{}'", stream_name);
-          auto [query_value, params_value] = ExtractTransformationResult(row.values, transformation_name, stream_name);
-          storage::PropertyValue params_prop{params_value};
-
-          std::string query{query_value.ValueString()};
+        std::unordered_set<std::string_view> authorized_queries;
+        auto execute = [&](const std::string &query, const std::map<std::string, storage::PropertyValue> &params,
+                           const std::string &original_query) {
           spdlog::trace("Executing query '{}' in stream '{}'", query, stream_name);
-          auto prepare_result =
-              interpreter->Prepare(query, params_prop.IsNull() ? empty_parameters : params_prop.ValueMap(), nullptr);
-          if (!interpreter_context->auth_checker->IsUserAuthorized(owner, prepare_result.privileges, "")) {
-            throw StreamsException{
-                "Couldn't execute query '{}' for stream '{}' because the owner is not authorized to execute the "
-                "query!",
-                query, stream_name};
+          auto prepare_result = interpreter->Prepare(query, params, nullptr);
+          if (!authorized_queries.contains(original_query)) {
+            if (!interpreter_context->auth_checker->IsUserAuthorized(owner, prepare_result.privileges, "")) {
+              throw StreamsException{
+                  "Couldn't execute query '{}' for stream '{}' because the owner is not authorized to execute the "
+                  "query!",
+                  original_query, stream_name};
+            }
+            authorized_queries.insert(original_query);
           }
           interpreter->PullAll(&stream);
+        };
+        for (const auto &group : groups) {
+          spdlog::trace("Processing {} row(s) in stream '{}'", group.params.size(), stream_name);
+          if (group.params.size() == 1) {
+            execute(group.query, group.params.front(), group.query);
+            continue;
+          }
+          std::vector<storage::PropertyValue> rows;
+          rows.reserve(group.params.size());
+          for (const auto &params : group.params) {
+            rows.emplace_back(std::map<std::string, storage::PropertyValue>{params});
+          }
+          execute(group.batched_query->query, {{std::string{kBatchParamName}, storage::PropertyValue{std::move(rows)}}},
+                  group.query);
         }
 
         spdlog::trace("Commit transaction in stream '{}'", stream_name);
@@ -24,6 +24,7 @@
 #include "storage/v2/property_value.hpp"
 #include "utils/event_counter.hpp"
 #include "utils/memory.hpp"
+#include "utils/tracepoint.hpp"
 
 namespace memgraph::metrics {
 extern const Event TriggersExecuted;
@@ -160,7 +161,12 @@ Trigger::Trigger(std::string name, const std::string &query,
       event_type_{event_type},
       owner_{std::move(owner)} {
   // We check immediately if the query is valid by trying to create a plan.
-  GetPlan(db_accessor, auth_checker);
+  const auto trigger_plan = GetPlan(db_accessor, auth_checker);
+  for (const auto &[identifier, tag] : trigger_plan->identifiers) {
+    if (identifier.symbol_pos_ != -1) {
+      identifier_tags_.push_back(tag);
+    }
+  }
 }
 
 Trigger::TriggerPlan::TriggerPlan(std::unique_ptr<LogicalPlan> logical_plan, std::vector<IdentifierInfo> identifiers)
@@ -217,6 +223,8 @@ void Trigger::Execute(DbAccessor *dba, utils::MonotonicBufferResource *execution
   ctx.is_shutting_down = is_shutting_down;
   ctx.transaction_status = transaction_status;
   ctx.is_profile_query = false;
+  // BEFORE COMMIT triggers are attributed to the committing query.
+  ctx.query_id = utils::CurrentQueryId();
 
   // Set up temporary memory for a single Pull. Initial memory comes from the
   // stack. 256 KiB should fit on the stack and should be more than enough for a
@@ -440,4 +448,18 @@ std::unordered_set<TriggerEventType> TriggerStore::GetEventTypes() const {
   add_event_types(after_commit_triggers_);
   return event_types;
 }
+
+std::unordered_set<TriggerIdentifierTag> TriggerStore::GetIdentifierTags() const {
+  std::unordered_set<TriggerIdentifierTag> identifier_tags;
+
+  const auto add_identifier_tags = [&](const utils::SkipList<Trigger> &trigger_list) {
+    for (const auto &trigger : trigger_list.access()) {
+      identifier_tags.insert(trigger.IdentifierTags().begin(), trigger.IdentifierTags().end());
+    }
+  };
+
+  add_identifier_tags(before_commit_triggers_);
+  add_identifier_tags(after_commit_triggers_);
+  return identifier_tags;
+}
 }  // namespace memgraph::query
@@ -55,6 +55,8 @@ struct Trigger {
   const auto &OriginalStatement() const noexcept { return parsed_statements_.query_string; }
   const auto &Owner() const noexcept { return owner_; }
   auto EventType() const noexcept { return event_type_; }
+  // Tags of the predefined identifiers which the trigger's query reads.
+  const auto &IdentifierTags() const noexcept { return identifier_tags_; }
 
  private:
   struct TriggerPlan {
@@ -71,6 +73,7 @@ struct Trigger {
   ParsedQuery parsed_statements_;
 
   TriggerEventType event_type_;
+  std::vector<TriggerIdentifierTag> identifier_tags_;
 
   mutable utils::SpinLock plan_lock_;
   mutable std::shared_ptr<TriggerPlan> trigger_plan_;
@@ -108,6 +111,7 @@ struct TriggerStore {
 
   bool HasTriggers() const noexcept { return before_commit_triggers_.size() > 0 || after_commit_triggers_.size() > 0; }
   std::unordered_set<TriggerEventType> GetEventTypes() const;
+  std::unordered_set<TriggerIdentifierTag> GetIdentifierTags() const;
 
  private:
   utils::SpinLock store_lock_;
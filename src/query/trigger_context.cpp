@@ -206,6 +206,7 @@ template <detail::ObjectAccessor TAccessor>
                  std::back_inserter(created_objects_vec),
                  [](const auto &gid_and_created_object) { return gid_and_created_object.second; });
   registry.created_objects.clear();
+  registry.created_gids.clear();
 
   return {std::move(created_objects_vec), std::move(registry.deleted_objects), std::move(set_object_properties),
           std::move(removed_object_properties)};
@@ -437,7 +438,7 @@ bool TriggerContext::ShouldEventTrigger(const TriggerEventType event_type) const
 void TriggerContextCollector::UpdateLabelMap(const VertexAccessor vertex, const storage::LabelId label_id,
                                              const LabelChange change) {
   auto &registry = GetRegistry<VertexAccessor>();
-  if (!registry.should_register_updated_objects || registry.created_objects.count(vertex.Gid())) {
+  if (!registry.should_register_updated_objects || registry.IsCreated(vertex.Gid())) {
     return;
   }
 
@@ -506,6 +507,19 @@ TriggerContextCollector::TriggerContextCollector(const std::unordered_set<Trigge
   deduce_if_should_register_created(edge_registry_);
 }
 
+TriggerContextCollector::TriggerContextCollector(const std::unordered_set<TriggerEventType> &event_types,
+                                                 const std::unordered_set<TriggerIdentifierTag> &identifier_tags)
+    : TriggerContextCollector{event_types} {
+  using IdentifierTag = TriggerIdentifierTag;
+  const auto is_read = [&](const auto... tags) { return (identifier_tags.contains(tags) || ...); };
+  vertex_registry_.should_keep_created_objects =
+      is_read(IdentifierTag::CREATED_VERTICES, IdentifierTag::CREATED_OBJECTS);
+  edge_registry_.should_keep_created_objects = is_read(IdentifierTag::CREATED_EDGES, IdentifierTag::CREATED_OBJECTS);
+  vertex_registry_.should_keep_deleted_objects =
+      is_read(IdentifierTag::DELETED_VERTICES, IdentifierTag::DELETED_OBJECTS);
+  edge_registry_.should_keep_deleted_objects = is_read(IdentifierTag::DELETED_EDGES, IdentifierTag::DELETED_OBJECTS);
+}
+
 bool TriggerContextCollector::ShouldRegisterVertexLabelChange() const {
   return vertex_registry_.should_register_updated_objects;
 }
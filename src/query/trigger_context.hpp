@@ -17,6 +17,7 @@
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -237,15 +238,28 @@ class TriggerContextCollector {
     bool should_register_created_objects{false};
     bool should_register_deleted_objects{false};
     bool should_register_updated_objects{false};  // Set/removed properties (and labels for vertices)
+    // When no trigger reads the created or the deleted objects, only the first of them is kept, which is enough to
+    // tell whether a trigger should run. The other created objects are then kept only by their Gid in
+    // created_gids, which is needed to ignore the later changes on them.
+    bool should_keep_created_objects{true};
+    bool should_keep_deleted_objects{true};
     std::unordered_map<storage::Gid, detail::CreatedObject<TAccessor>> created_objects;
+    std::unordered_set<storage::Gid> created_gids;
     std::vector<detail::DeletedObject<TAccessor>> deleted_objects;
     // During the transaction, a single property on a single object could be changed multiple times.
     // We want to register only the global change, at the end of the transaction. The change consists of
     // the value before the transaction start, and the latest value assigned throughout the transaction.
     PropertyChangesMap<TAccessor> property_changes;
+
+    bool IsCreated(const storage::Gid gid) const { return created_objects.contains(gid) || created_gids.contains(gid); }
   };
 
+  // Collects everything needed by triggers on the event types.
   explicit TriggerContextCollector(const std::unordered_set<TriggerEventType> &event_types);
+  // Collects everything needed by triggers on the event types, but keeps only the objects of the identifiers the
+  // triggers read.
+  TriggerContextCollector(const std::unordered_set<TriggerEventType> &event_types,
+                          const std::unordered_set<TriggerIdentifierTag> &identifier_tags);
   TriggerContextCollector(const TriggerContextCollector &) = default;
   TriggerContextCollector(TriggerContextCollector &&) = default;
   TriggerContextCollector &operator=(const TriggerContextCollector &) = default;
@@ -263,6 +277,10 @@ class TriggerContextCollector {
     if (!registry.should_register_created_objects) {
       return;
     }
+    if (!registry.should_keep_created_objects && !registry.created_objects.empty()) {
+      registry.created_gids.insert(created_object.Gid());
+      return;
+    }
     registry.created_objects.emplace(created_object.Gid(), detail::CreatedObject{created_object});
   }
 
@@ -274,7 +292,10 @@ class TriggerContextCollector {
   template <detail::ObjectAccessor TAccessor>
   void RegisterDeletedObject(const TAccessor &deleted_object) {
     auto &registry = GetRegistry<TAccessor>();
-    if (!registry.should_register_deleted_objects || registry.created_objects.count(deleted_object.Gid())) {
+    if (!registry.should_register_deleted_objects || registry.IsCreated(deleted_object.Gid())) {
+      return;
+    }
+    if (!registry.should_keep_deleted_objects && !registry.deleted_objects.empty()) {
       return;
     }
 
@@ -294,7 +315,7 @@ class TriggerContextCollector {
       return;
     }
 
-    if (registry.created_objects.count(object.Gid())) {
+    if (registry.IsCreated(object.Gid())) {
       return;
     }
 
@@ -0,0 +1,100 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/trigger_executor.hpp"
+
+#include <string>
+
+#include "utils/event_counter.hpp"
+#include "utils/event_gauge.hpp"
+#include "utils/event_histogram.hpp"
+#include "utils/logging.hpp"
+#include "utils/timer.hpp"
+
+namespace memgraph::metrics {
+extern const Event AfterCommitTriggerBackpressure;
+extern const Event AfterCommitTriggerBacklog;
+extern const Event AfterCommitTriggerLag_us;
+}  // namespace memgraph::metrics
+
+namespace memgraph::query {
+
+namespace {
+// Runs `finish` and releases the backlog when the last of the scheduled tasks
+// is done with it.
+struct Completion {
+  Completion(std::function<void()> finish, std::function<void()> release)
+      : finish(std::move(finish)), release(std::move(release)) {}
+  Completion(const Completion &) = delete;
+  Completion(Completion &&) = delete;
+  Completion &operator=(const Completion &) = delete;
+  Completion &operator=(Completion &&) = delete;
+  ~Completion() {
+    finish();
+    release();
+  }
+
+  std::function<void()> finish;
+  std::function<void()> release;
+};
+}  // namespace
+
+AfterCommitTriggerExecutor::AfterCommitTriggerExecutor(const size_t workers, const uint64_t max_backlog)
+    : max_backlog_(max_backlog) {
+  MG_ASSERT(workers > 0, "AFTER COMMIT triggers need at least one worker");
+  workers_.reserve(workers);
+  for (size_t i = 0; i < workers; ++i) {
+    workers_.push_back(std::make_unique<utils::ThreadPool>(1));
+  }
+}
+
+size_t AfterCommitTriggerExecutor::Worker(const std::string_view trigger_name) const {
+  return std::hash<std::string_view>{}(trigger_name) % workers_.size();
+}
+
+void AfterCommitTriggerExecutor::Schedule(const std::vector<size_t> &workers, std::function<void(size_t)> run,
+                                          std::function<void()> finish) {
+  {
+    std::unique_lock lock(mutex_);
+    if (max_backlog_ != 0 && backlog_ >= max_backlog_) {
+      memgraph::metrics::IncrementCounter(memgraph::metrics::AfterCommitTriggerBackpressure);
+      released_cv_.wait(lock, [this] { return backlog_ < max_backlog_; });
+    }
+    ++backlog_;
+    memgraph::metrics::SetGaugeValue(memgraph::metrics::AfterCommitTriggerBacklog, backlog_);
+  }
+
+  auto completion = std::make_shared<Completion>(std::move(finish), [this] { Release(); });
+  const utils::Timer timer;
+  for (const auto worker : workers) {
+    workers_[worker]->AddTask([run, completion, worker, timer] {
+      memgraph::metrics::Measure(memgraph::metrics::AfterCommitTriggerLag_us,
+                                 timer.Elapsed<std::chrono::microseconds>().count());
+      run(worker);
+    });
+  }
+}
+
+uint64_t AfterCommitTriggerExecutor::Backlog() const {
+  std::lock_guard lock(mutex_);
+  return backlog_;
+}
+
+void AfterCommitTriggerExecutor::Release() {
+  {
+    std::lock_guard lock(mutex_);
+    --backlog_;
+    memgraph::metrics::SetGaugeValue(memgraph::metrics::AfterCommitTriggerBacklog, backlog_);
+  }
+  released_cv_.notify_one();
+}
+
+}  // namespace memgraph::query
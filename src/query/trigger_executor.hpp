@@ -0,0 +1,70 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Execution of the AFTER COMMIT triggers on a pool of workers.
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "utils/thread_pool.hpp"
+
+namespace memgraph::query {
+
+/// Runs the AFTER COMMIT triggers of the committed transactions on a fixed
+/// number of workers. Every trigger is assigned to one of the workers by its
+/// name, so the runs of a trigger keep the order in which the transactions
+/// were scheduled, while different triggers run in parallel.
+///
+/// Scheduling a transaction waits while `max_backlog` transactions still have
+/// triggers to run, which slows the committers down to the pace of the
+/// triggers instead of letting the backlog grow. A zero `max_backlog` means
+/// no limit.
+class AfterCommitTriggerExecutor {
+ public:
+  AfterCommitTriggerExecutor(size_t workers, uint64_t max_backlog);
+
+  AfterCommitTriggerExecutor(const AfterCommitTriggerExecutor &) = delete;
+  AfterCommitTriggerExecutor(AfterCommitTriggerExecutor &&) = delete;
+  AfterCommitTriggerExecutor &operator=(const AfterCommitTriggerExecutor &) = delete;
+  AfterCommitTriggerExecutor &operator=(AfterCommitTriggerExecutor &&) = delete;
+  ~AfterCommitTriggerExecutor() = default;
+
+  /// Index of the worker which runs the trigger.
+  size_t Worker(std::string_view trigger_name) const;
+
+  /// Runs `run(worker)` on each of the `workers`, and `finish` once all of
+  /// them are done, or right away if there are none. The tasks which didn't
+  /// start before the executor is destroyed are dropped, but `finish` is
+  /// still run.
+  void Schedule(const std::vector<size_t> &workers, std::function<void(size_t)> run, std::function<void()> finish);
+
+  /// Number of the scheduled transactions whose triggers haven't finished.
+  uint64_t Backlog() const;
+
+ private:
+  void Release();
+
+  const uint64_t max_backlog_;
+  mutable std::mutex mutex_;
+  std::condition_variable released_cv_;
+  uint64_t backlog_{0};
+  // Destroyed first, so that the dropped tasks can still release the backlog.
+  std::vector<std::unique_ptr<utils::ThreadPool>> workers_;
+};
+
+}  // namespace memgraph::query
@@ -23,6 +23,7 @@
 #include "slk/streams.hpp"
 #include "utils/logging.hpp"
 #include "utils/on_scope_exit.hpp"
+#include "utils/tracepoint.hpp"
 #include "utils/typeinfo.hpp"
 
 namespace memgraph::rpc {
@@ -42,9 +43,16 @@ class Client {
                   std::function<typename TRequestResponse::Response(slk::Reader *)> res_load)
         : self_(self),
           guard_(std::move(guard)),
-          req_builder_([self](const uint8_t *data, size_t size, bool have_more) {
-            if (!self->client_->Write(data, size, have_more)) throw RpcFailedException(self->endpoint_);
-          }),
+          req_builder_(
+              [self](const uint8_t *data, size_t size, bool have_more) {
+                if (!self->client_->Write(data, size, have_more)) throw RpcFailedException(self->endpoint_);
+              },
+              [self](int fd, uint64_t offset, uint64_t size) {
+                if (!self->client_->WriteFile(fd, offset, size)) throw RpcFailedException(self->endpoint_);
+              },
+              [self](const iovec *iov, size_t iovcnt, bool have_more) {
+                if (!self->client_->WriteVector(iov, iovcnt, have_more)) throw RpcFailedException(self->endpoint_);
+              }),
           res_load_(res_load) {}
 
    public:
@@ -96,6 +104,7 @@ class Client {
       }
 
       SPDLOG_TRACE("[RpcClient] received {}", res_type.name);
+      MG_TRACEPOINT(rpc__response, utils::CurrentQueryId(), res_type.name);
 
       return res_load_(&res_reader);
     }
@@ -161,6 +170,7 @@ class Client {
     StreamHandler<TRequestResponse> handler(this, std::move(guard), load);
 
     // Build and send the request.
+    MG_TRACEPOINT(rpc__request, utils::CurrentQueryId(), req_type.name);
     slk::Save(req_type.id, handler.GetBuilder());
     TRequestResponse::Request::Save(request, handler.GetBuilder());
 
@@ -16,6 +16,7 @@
 #include "slk/serialization.hpp"
 #include "slk/streams.hpp"
 #include "utils/on_scope_exit.hpp"
+#include "utils/tracepoint.hpp"
 #include "utils/typeinfo.hpp"
 
 namespace memgraph::rpc {
@@ -38,8 +39,16 @@ void Session::Execute() {
 
   // Prepare SLK reader and builder.
   slk::Reader req_reader(input_stream_->data(), input_stream_->size());
+  // The large parts of the response are written in place, the output stream
+  // corks them until the last one.
   slk::Builder res_builder(
-      [&](const uint8_t *data, size_t size, bool have_more) { output_stream_->Write(data, size, have_more); });
+      [&](const uint8_t *data, size_t size, bool have_more) { output_stream_->Write(data, size, have_more); }, {},
+      [&](const iovec *iov, size_t iovcnt, bool have_more) {
+        for (size_t i = 0; i < iovcnt; ++i) {
+          output_stream_->Write(static_cast<const uint8_t *>(iov[i].iov_base), iov[i].iov_len,
+                                have_more || i + 1 < iovcnt);
+        }
+      });
 
   // Load the request ID.
   utils::TypeId req_id{utils::TypeId::UNKNOWN};
@@ -61,12 +70,16 @@ void Session::Execute() {
       throw SessionException("Session trying to execute an unregistered RPC call!");
     }
     SPDLOG_TRACE("[RpcServer] received {}", extended_it->second.req_type.name);
+    MG_TRACEPOINT(rpc__handle__start, extended_it->second.req_type.name);
     slk::Save(extended_it->second.res_type.id, &res_builder);
     extended_it->second.callback(endpoint_, &req_reader, &res_builder);
+    MG_TRACEPOINT(rpc__handle__done, extended_it->second.req_type.name);
   } else {
     SPDLOG_TRACE("[RpcServer] received {}", it->second.req_type.name);
+    MG_TRACEPOINT(rpc__handle__start, it->second.req_type.name);
     slk::Save(it->second.res_type.id, &res_builder);
     it->second.callback(&req_reader, &res_builder);
+    MG_TRACEPOINT(rpc__handle__done, it->second.req_type.name);
   }
 
   // Finalize the SLK streams.
@@ -181,6 +181,21 @@ inline void Load(std::string *obj, Reader *reader) {
   reader->Load(reinterpret_cast<uint8_t *>(obj->data()), size);
 }
 
+/// Loads a string as a view of the data of the reader, without copying it,
+/// when it's within one segment. Otherwise the string is loaded into `storage`
+/// and the view refers to it.
+inline void LoadView(std::string_view *obj, std::string *storage, Reader *reader) {
+  uint64_t size = 0;
+  Load(&size, reader);
+  if (auto view = reader->TryLoadView(size)) {
+    *obj = *view;
+    return;
+  }
+  *storage = std::string(size, '\0');
+  reader->Load(reinterpret_cast<uint8_t *>(storage->data()), size);
+  *obj = *storage;
+}
+
 template <typename T>
 inline void Save(const std::vector<T> &obj, Builder *builder) {
   uint64_t size = obj.size();
@@ -11,15 +11,28 @@
 
 #include "slk/streams.hpp"
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
 #include <cstring>
+#include <vector>
 
 #include "utils/logging.hpp"
 
 namespace memgraph::slk {
 
-Builder::Builder(std::function<void(const uint8_t *, size_t, bool)> write_func) : write_func_(write_func) {}
+Builder::Builder(std::function<void(const uint8_t *, size_t, bool)> write_func, FileWriteFunction file_write_func,
+                 VectorWriteFunction vector_write_func)
+    : write_func_(write_func),
+      file_write_func_(std::move(file_write_func)),
+      vector_write_func_(std::move(vector_write_func)) {}
 
 void Builder::Save(const uint8_t *data, uint64_t size) {
+  if (vector_write_func_ && size >= kSegmentReferenceMinSize) {
+    SaveInPlace(data, size);
+    return;
+  }
   size_t offset = 0;
   while (size > 0) {
     FlushSegment(false);
@@ -38,10 +51,84 @@ void Builder::Save(const uint8_t *data, uint64_t size) {
   }
 }
 
+void Builder::SaveInPlace(const uint8_t *data, uint64_t size) {
+  // The data already in the segment buffer is written as a segment of its
+  // own, followed by the segments of the data. The headers are reserved up
+  // front so that the buffers referencing them stay valid.
+  std::vector<SegmentSize> headers;
+  headers.reserve((size + kSegmentMaxDataSize - 1) / kSegmentMaxDataSize);
+  std::vector<iovec> buffers;
+  buffers.reserve(2 * headers.capacity() + 1);
+  if (pos_ > 0) {
+    SegmentSize segment_size = pos_;
+    memcpy(segment_, &segment_size, sizeof(SegmentSize));
+    buffers.push_back({segment_, sizeof(SegmentSize) + pos_});
+  }
+  while (size > 0) {
+    const auto to_write = std::min(size, kSegmentMaxDataSize);
+    headers.push_back(static_cast<SegmentSize>(to_write));
+    buffers.push_back({&headers.back(), sizeof(SegmentSize)});
+    buffers.push_back({const_cast<uint8_t *>(data), to_write});
+    data += to_write;
+    size -= to_write;
+  }
+  vector_write_func_(buffers.data(), buffers.size(), true);
+  pos_ = 0;
+  external_segment_written_ = true;
+}
+
+void Builder::SaveFile(int fd, uint64_t offset, uint64_t size) {
+  if (size == 0) return;
+  if (!file_write_func_) {
+    while (size > 0) {
+      FlushSegment(false);
+
+      size_t to_read = size;
+      if (to_read > kSegmentMaxDataSize - pos_) {
+        to_read = kSegmentMaxDataSize - pos_;
+      }
+
+      auto bytes_read = pread(fd, segment_ + sizeof(SegmentSize) + pos_, to_read, static_cast<off_t>(offset));
+      if (bytes_read == -1 && errno == EINTR) continue;
+      if (bytes_read <= 0) throw SlkBuilderException("Couldn't read the file data!");
+
+      size -= bytes_read;
+      pos_ += bytes_read;
+      offset += bytes_read;
+    }
+    return;
+  }
+
+  // The data already in the segment buffer is sent as a segment of its own,
+  // the file data follows it in segments which are written without the buffer.
+  if (pos_ > 0) {
+    SegmentSize segment_size = pos_;
+    memcpy(segment_, &segment_size, sizeof(SegmentSize));
+    write_func_(segment_, sizeof(SegmentSize) + pos_, true);
+    pos_ = 0;
+  }
+  while (size > 0) {
+    const auto to_write = std::min(size, kSegmentMaxDataSize);
+    SegmentSize segment_size = to_write;
+    write_func_(reinterpret_cast<const uint8_t *>(&segment_size), sizeof(SegmentSize), true);
+    file_write_func_(fd, offset, to_write);
+    external_segment_written_ = true;
+    size -= to_write;
+    offset += to_write;
+  }
+}
+
 void Builder::Finalize() { FlushSegment(true); }
 
 void Builder::FlushSegment(bool final_segment) {
   if (!final_segment && pos_ < kSegmentMaxDataSize) return;
+  if (final_segment && pos_ == 0 && external_segment_written_) {
+    // The last segment was written in place, only the footer is left.
+    SegmentSize footer = 0;
+    write_func_(reinterpret_cast<const uint8_t *>(&footer), sizeof(SegmentSize), false);
+    external_segment_written_ = false;
+    return;
+  }
   MG_ASSERT(pos_ > 0, "Trying to flush out a segment that has no data in it!");
 
   size_t total_size = sizeof(SegmentSize) + pos_;
@@ -58,6 +145,7 @@ void Builder::FlushSegment(bool final_segment) {
   write_func_(segment_, total_size, !final_segment);
 
   pos_ = 0;
+  external_segment_written_ = false;
 }
 
 Reader::Reader(const uint8_t *data, size_t size) : data_(data), size_(size) {}
@@ -78,6 +166,16 @@ void Reader::Load(uint8_t *data, uint64_t size) {
   }
 }
 
+std::optional<std::string_view> Reader::TryLoadView(uint64_t size) {
+  if (size == 0) return std::string_view{};
+  GetSegment();
+  if (size > have_) return std::nullopt;
+  std::string_view view(reinterpret_cast<const char *>(data_ + pos_), size);
+  pos_ += size;
+  have_ -= size;
+  return view;
+}
+
 void Reader::Finalize() { GetSegment(true); }
 
 void Reader::GetSegment(bool should_be_final) {
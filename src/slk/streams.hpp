@@ -11,9 +11,13 @@
 
 #pragma once
 
+#include <sys/uio.h>
+
 #include <cstdint>
 #include <functional>
 #include <limits>
+#include <optional>
+#include <string_view>
 
 #include "utils/exceptions.hpp"
 
@@ -31,6 +35,12 @@ const uint64_t kSegmentMaxTotalSize = kSegmentMaxDataSize + sizeof(SegmentSize)
 static_assert(kSegmentMaxDataSize <= std::numeric_limits<SegmentSize>::max(),
               "The SLK segment can't be larger than the type used to store its size!");
 
+// Data of at least `kSegmentReferenceMinSize` bytes isn't copied into the
+// segment buffer by builders in the scatter-gather mode, it's written in
+// segments of its own straight from where it's stored. Copying smaller data is
+// cheaper than writing an extra segment.
+const uint64_t kSegmentReferenceMinSize = 16384;
+
 /// SLK splits binary data into segments. Segments are used to avoid the need to
 /// have all of the encoded data in memory at once during the building process.
 /// That enables streaming during the building process and makes the whole
@@ -43,22 +53,57 @@ static_assert(kSegmentMaxDataSize <= std::numeric_limits<SegmentSize>::max(),
 /// `sizeof(SegmentSize)`. A segment of size 0 indicates that we have reached
 /// the end of a stream and that there is no more data to be read/written.
 
+/// Exception that will be thrown if the data can't be saved to the segment
+/// stream.
+class SlkBuilderException : public utils::BasicException {
+ public:
+  using utils::BasicException::BasicException;
+};
+
 /// Builder used to create a SLK segment stream.
 class Builder {
  public:
-  Builder(std::function<void(const uint8_t *, size_t, bool)> write_func);
-
-  /// Function used internally by SLK to serialize the data.
+  /// Function used to write `size` bytes of the file descriptor, starting at
+  /// `offset`, directly to the output, e.g. with `sendfile`.
+  using FileWriteFunction = std::function<void(int, uint64_t, uint64_t)>;
+
+  /// Function used to write a list of buffers at once, e.g. with `sendmsg`.
+  /// The buffers are only valid during the call.
+  using VectorWriteFunction = std::function<void(const iovec *, size_t, bool)>;
+
+  /// The builder is in the scatter-gather mode when it has the vector write
+  /// function. Then the segments can be written in parts, otherwise each
+  /// segment is written by one call of `write_func`.
+  Builder(std::function<void(const uint8_t *, size_t, bool)> write_func, FileWriteFunction file_write_func = {},
+          VectorWriteFunction vector_write_func = {});
+
+  /// Function used internally by SLK to serialize the data. In the
+  /// scatter-gather mode the data of at least `kSegmentReferenceMinSize` bytes
+  /// is written in place instead of being copied into the segment buffer.
   void Save(const uint8_t *data, uint64_t size);
 
+  /// Serializes `size` bytes of the file descriptor starting at `offset`, the
+  /// same as `Save` of the read data would. When the builder has a file write
+  /// function the data is handed to it segment by segment, so it never goes
+  /// through the segment buffer. Otherwise the data is read into the segment
+  /// buffer directly.
+  void SaveFile(int fd, uint64_t offset, uint64_t size);
+
   /// Function that should be called after all `slk::Save` operations are done.
   void Finalize();
 
  private:
   void FlushSegment(bool final_segment);
 
+  void SaveInPlace(const uint8_t *data, uint64_t size);
+
   std::function<void(const uint8_t *, size_t, bool)> write_func_;
+  FileWriteFunction file_write_func_;
+  VectorWriteFunction vector_write_func_;
   size_t pos_{0};
+  // Set when the last segment wasn't written from the segment buffer, so the
+  // footer can end the stream without a segment of its own.
+  bool external_segment_written_{false};
   uint8_t segment_[kSegmentMaxTotalSize];
 };
 
@@ -77,6 +122,11 @@ class Reader {
   /// Function used internally by SLK to deserialize the data.
   void Load(uint8_t *data, uint64_t size);
 
+  /// Loads the next `size` bytes as a view of the data the reader was created
+  /// with, without copying them, if they are all in the current segment.
+  /// Otherwise nothing is loaded and `std::nullopt` is returned.
+  std::optional<std::string_view> TryLoadView(uint64_t size);
+
   /// Function that should be called after all `slk::Load` operations are done.
   void Finalize();
 
@@ -0,0 +1,285 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/adjacency_list.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/inlined_vector.h>
+
+#include "utils/logging.hpp"
+
+namespace memgraph::storage {
+
+struct AdjacencyList::NeighborIndex {
+  void Add(const Vertex *vertex, uint32_t pos) { positions[vertex].push_back(pos); }
+
+  void Remove(const Vertex *vertex, uint32_t pos) {
+    auto it = positions.find(vertex);
+    MG_ASSERT(it != positions.end(), "Invalid AdjacencyList neighbor index!");
+    auto &vertex_positions = it->second;
+    auto pos_it = std::find(vertex_positions.begin(), vertex_positions.end(), pos);
+    MG_ASSERT(pos_it != vertex_positions.end(), "Invalid AdjacencyList neighbor index!");
+    *pos_it = vertex_positions.back();
+    vertex_positions.pop_back();
+    if (vertex_positions.empty()) positions.erase(it);
+  }
+
+  void Move(const Vertex *vertex, uint32_t from, uint32_t to) {
+    auto it = positions.find(vertex);
+    MG_ASSERT(it != positions.end(), "Invalid AdjacencyList neighbor index!");
+    auto pos_it = std::find(it->second.begin(), it->second.end(), from);
+    MG_ASSERT(pos_it != it->second.end(), "Invalid AdjacencyList neighbor index!");
+    *pos_it = to;
+  }
+
+  // Most neighbors of a supernode are connected with a single edge, so keep
+  // one position inline.
+  absl::flat_hash_map<const Vertex *, absl::InlinedVector<uint32_t, 1>> positions;
+};
+
+AdjacencyList::AdjacencyList(const AdjacencyList &other) {
+  if (other.empty()) return;
+  Reallocate(other.data_->size, other.data_->groups);
+  data_->size = other.data_->size;
+  data_->groups = other.data_->groups;
+  std::memcpy(Groups(), other.Groups(), other.data_->groups * sizeof(Group));
+  std::memcpy(Links(), other.Links(), other.data_->size * sizeof(Link));
+  if (other.data_->neighbors) BuildNeighborIndex();
+}
+
+AdjacencyList &AdjacencyList::operator=(const AdjacencyList &other) {
+  if (this == &other) return *this;
+  AdjacencyList copy(other);
+  std::swap(data_, copy.data_);
+  return *this;
+}
+
+AdjacencyList &AdjacencyList::operator=(AdjacencyList &&other) noexcept {
+  if (this == &other) return *this;
+  clear();
+  data_ = std::exchange(other.data_, nullptr);
+  return *this;
+}
+
+AdjacencyList::~AdjacencyList() { clear(); }
+
+uint32_t AdjacencyList::LowerBoundGroup(EdgeTypeId edge_type) const {
+  if (!data_) return 0;
+  const auto *groups = Groups();
+  const auto *it = std::lower_bound(groups, groups + data_->groups, edge_type,
+                                    [](const Group &group, EdgeTypeId type) { return group.edge_type < type; });
+  return static_cast<uint32_t>(it - groups);
+}
+
+std::pair<AdjacencyList::Iterator, AdjacencyList::Iterator> AdjacencyList::EdgeTypeRange(EdgeTypeId edge_type) const {
+  auto group = LowerBoundGroup(edge_type);
+  if (!data_ || group == data_->groups || GroupAt(group).edge_type != edge_type) return {end(), end()};
+  return {Iterator(this, group, GroupBegin(group)), Iterator(this, group + 1, GroupAt(group).end)};
+}
+
+uint32_t AdjacencyList::GroupOf(uint32_t pos) const {
+  const auto *groups = Groups();
+  const auto *it = std::upper_bound(groups, groups + data_->groups, pos,
+                                    [](uint32_t pos, const Group &group) { return pos < group.end; });
+  return static_cast<uint32_t>(it - groups);
+}
+
+void AdjacencyList::MoveLink(uint32_t from, uint32_t to) {
+  auto *links = Links();
+  if (data_->neighbors) data_->neighbors->Move(links[from].vertex, from, to);
+  links[to] = links[from];
+}
+
+void AdjacencyList::BuildNeighborIndex() {
+  if (!data_ || data_->neighbors) return;
+  auto index = std::make_unique<NeighborIndex>();
+  index->positions.reserve(data_->size);
+  const auto *links = Links();
+  for (uint32_t pos = 0; pos < data_->size; ++pos) index->Add(links[pos].vertex, pos);
+  data_->neighbors = index.release();
+}
+
+void AdjacencyList::DropNeighborIndex() noexcept {
+  if (!data_) return;
+  delete data_->neighbors;
+  data_->neighbors = nullptr;
+}
+
+void AdjacencyList::AppendEdgesTo(const Vertex *neighbor, const std::vector<EdgeTypeId> &edge_types,
+                                  std::vector<value_type> *result) const {
+  if (!data_) return;
+  const auto *links = Links();
+  auto const type_requested = [&edge_types](EdgeTypeId edge_type) {
+    return edge_types.empty() || std::find(edge_types.begin(), edge_types.end(), edge_type) != edge_types.end();
+  };
+
+  if (data_->neighbors) {
+    auto it = data_->neighbors->positions.find(neighbor);
+    if (it == data_->neighbors->positions.end()) return;
+    for (auto pos : it->second) {
+      auto edge_type = GroupAt(GroupOf(pos)).edge_type;
+      if (!type_requested(edge_type)) continue;
+      result->emplace_back(edge_type, links[pos].vertex, links[pos].edge);
+    }
+    return;
+  }
+
+  for (uint32_t group = 0; group < data_->groups; ++group) {
+    auto edge_type = GroupAt(group).edge_type;
+    if (!type_requested(edge_type)) continue;
+    for (auto pos = GroupBegin(group); pos < GroupAt(group).end; ++pos) {
+      if (links[pos].vertex != neighbor) continue;
+      result->emplace_back(edge_type, links[pos].vertex, links[pos].edge);
+    }
+  }
+}
+
+void AdjacencyList::Reallocate(uint32_t capacity, uint32_t groups_capacity) {
+  auto *new_data = static_cast<Header *>(
+      ::operator new(sizeof(Header) + groups_capacity * sizeof(Group) + capacity * sizeof(Link)));
+  new_data->size = 0;
+  new_data->capacity = capacity;
+  new_data->groups = 0;
+  new_data->groups_capacity = groups_capacity;
+  new_data->neighbors = nullptr;
+  if (data_) {
+    MG_ASSERT(capacity >= data_->size && groups_capacity >= data_->groups, "Invalid AdjacencyList reallocation!");
+    AdjacencyList new_list;
+    new_list.data_ = new_data;
+    std::memcpy(new_list.Groups(), Groups(), data_->groups * sizeof(Group));
+    std::memcpy(new_list.Links(), Links(), data_->size * sizeof(Link));
+    new_data->size = data_->size;
+    new_data->groups = data_->groups;
+    new_data->neighbors = std::exchange(data_->neighbors, nullptr);
+    std::swap(data_, new_list.data_);
+  } else {
+    data_ = new_data;
+  }
+}
+
+void AdjacencyList::reserve(size_t capacity) {
+  MG_ASSERT(capacity <= std::numeric_limits<uint32_t>::max(), "Too many edges for a single vertex!");
+  if (capacity <= (data_ ? data_->capacity : 0)) return;
+  Reallocate(static_cast<uint32_t>(capacity), data_ ? std::max(data_->groups_capacity, 1U) : 1U);
+}
+
+void AdjacencyList::emplace_back(EdgeTypeId edge_type, Vertex *vertex, EdgeRef edge) {
+  if (!data_) Reallocate(1, 1);
+  MG_ASSERT(data_->size < std::numeric_limits<uint32_t>::max(), "Too many edges for a single vertex!");
+
+  auto group = LowerBoundGroup(edge_type);
+  bool const new_group = group == data_->groups || GroupAt(group).edge_type != edge_type;
+
+  auto capacity = data_->capacity;
+  auto groups_capacity = data_->groups_capacity;
+  if (data_->size == capacity) capacity = std::max(2 * capacity, 1U);
+  if (new_group && data_->groups == groups_capacity) groups_capacity = std::max(2 * groups_capacity, 1U);
+  if (capacity != data_->capacity || groups_capacity != data_->groups_capacity) {
+    Reallocate(capacity, groups_capacity);
+  }
+
+  auto *groups = Groups();
+  auto *links = Links();
+
+  if (new_group) {
+    std::memmove(groups + group + 1, groups + group, (data_->groups - group) * sizeof(Group));
+    groups[group] = Group{edge_type, GroupBegin(group)};
+    ++data_->groups;
+  }
+
+  // Make room at the end of `group` by moving the first link of every
+  // following group to the end of that same group, starting from the last one.
+  auto hole = data_->size;
+  for (auto other = data_->groups - 1; other > group; --other) {
+    auto begin = groups[other - 1].end;
+    MoveLink(begin, hole);
+    hole = begin;
+    ++groups[other].end;
+  }
+  links[hole] = Link{vertex, edge};
+  if (data_->neighbors) data_->neighbors->Add(vertex, hole);
+  ++groups[group].end;
+  ++data_->size;
+
+  if (data_->size == kNeighborIndexThreshold) BuildNeighborIndex();
+}
+
+AdjacencyList::Iterator AdjacencyList::find(const value_type &link) const {
+  const auto &[edge_type, vertex, edge] = link;
+  auto group = LowerBoundGroup(edge_type);
+  if (!data_ || group == data_->groups || GroupAt(group).edge_type != edge_type) return end();
+  const auto *links = Links();
+  if (data_->neighbors) {
+    auto it = data_->neighbors->positions.find(vertex);
+    if (it == data_->neighbors->positions.end()) return end();
+    auto const begin = GroupBegin(group);
+    auto const end_pos = GroupAt(group).end;
+    for (auto pos : it->second) {
+      if (pos >= begin && pos < end_pos && links[pos].edge == edge) return Iterator(this, group, pos);
+    }
+    return end();
+  }
+  for (auto pos = GroupBegin(group); pos < GroupAt(group).end; ++pos) {
+    if (links[pos].vertex == vertex && links[pos].edge == edge) return Iterator(this, group, pos);
+  }
+  return end();
+}
+
+bool AdjacencyList::erase(const value_type &link) {
+  auto it = find(link);
+  if (it == end()) return false;
+
+  auto *groups = Groups();
+  auto const group = it.group_;
+  if (data_->neighbors) data_->neighbors->Remove(std::get<1>(link), it.pos_);
+
+  // Fill the hole with the last link of the group and then shift the hole
+  // through the following groups by moving each group's last link into it.
+  auto hole = it.pos_;
+  for (auto other = group; other < data_->groups; ++other) {
+    auto last = groups[other].end - 1;
+    if (last != hole) MoveLink(last, hole);
+    hole = last;
+    --groups[other].end;
+  }
+  --data_->size;
+  if (data_->size < kNeighborIndexThreshold / 2) DropNeighborIndex();
+
+  if (GroupBegin(group) == groups[group].end) {
+    std::memmove(groups + group, groups + group + 1, (data_->groups - group - 1) * sizeof(Group));
+    --data_->groups;
+  }
+  return true;
+}
+
+void AdjacencyList::clear() noexcept {
+  DropNeighborIndex();
+  ::operator delete(data_);
+  data_ = nullptr;
+}
+
+void AdjacencyList::shrink_to_fit() {
+  if (!data_) return;
+  if (data_->size == 0) {
+    clear();
+    return;
+  }
+  if (data_->size == data_->capacity && data_->groups == data_->groups_capacity) return;
+  Reallocate(data_->size, data_->groups);
+}
+
+}  // namespace memgraph::storage
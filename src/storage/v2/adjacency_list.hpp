@@ -0,0 +1,264 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "storage/v2/edge_ref.hpp"
+#include "storage/v2/id_types.hpp"
+
+namespace memgraph::storage {
+
+// Forward declaration because we only store a pointer here.
+struct Vertex;
+
+/// Compact adjacency storage used for `Vertex::in_edges` and `Vertex::out_edges`.
+///
+/// Edges are kept grouped by edge type, with groups sorted by `EdgeTypeId`.
+/// The edge type is stored once per group instead of once per edge, so each
+/// edge costs 16 bytes (neighbor + edge reference) instead of the 24 bytes of
+/// a `std::tuple<EdgeTypeId, Vertex *, EdgeRef>`. The whole list lives in a
+/// single heap allocation (header, group table and links) and an empty list
+/// is just a null pointer.
+///
+/// Iteration yields `std::tuple<EdgeTypeId, Vertex *, EdgeRef>` values so the
+/// list can be consumed the same way the previous vector was. Edges of a single
+/// type can be iterated without touching the other groups using
+/// `EdgeTypeRange`. The order of edges inside a group isn't preserved across
+/// removals.
+///
+/// Once a list grows to `kNeighborIndexThreshold` edges, a secondary hash
+/// index from neighbor vertex to link positions is built and maintained
+/// alongside it, so that looking up the edges to a given neighbor (and
+/// therefore `find` and `erase`) no longer scans the whole group. The index is
+/// dropped again when the list shrinks well below the threshold.
+///
+/// The list isn't thread-safe, it must be guarded by the owning vertex lock.
+class AdjacencyList final {
+ public:
+  using value_type = std::tuple<EdgeTypeId, Vertex *, EdgeRef>;
+
+  /// Degree at which the neighbor index gets built.
+  static constexpr uint32_t kNeighborIndexThreshold = 128;
+
+ private:
+  struct NeighborIndex;
+
+  struct Link {
+    Vertex *vertex;
+    EdgeRef edge;
+  };
+
+  struct Group {
+    EdgeTypeId edge_type;
+    // One past the index of the last link of the group. Groups are never
+    // empty, an emptied group is removed from the table.
+    uint32_t end;
+  };
+
+  struct Header {
+    uint32_t size;
+    uint32_t capacity;
+    uint32_t groups;
+    uint32_t groups_capacity;
+    NeighborIndex *neighbors;
+  };
+
+  static_assert(sizeof(Link) == 16, "AdjacencyList::Link should be 16 bytes!");
+  static_assert(sizeof(Header) % alignof(Group) == 0, "AdjacencyList::Header breaks Group alignment!");
+  static_assert(sizeof(Group) % alignof(Link) == 0, "AdjacencyList::Group breaks Link alignment!");
+
+ public:
+  class Iterator final {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = AdjacencyList::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    Iterator() = default;
+
+    value_type operator*() const {
+      const auto &link = list_->LinkAt(pos_);
+      return {list_->GroupAt(group_).edge_type, link.vertex, link.edge};
+    }
+
+    Iterator &operator++() {
+      ++pos_;
+      if (pos_ == list_->GroupAt(group_).end) ++group_;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto copy = *this;
+      ++(*this);
+      return copy;
+    }
+
+    EdgeTypeId edge_type() const { return list_->GroupAt(group_).edge_type; }
+    Vertex *vertex() const { return list_->LinkAt(pos_).vertex; }
+    EdgeRef edge() const { return list_->LinkAt(pos_).edge; }
+
+    friend bool operator==(const Iterator &a, const Iterator &b) { return a.pos_ == b.pos_; }
+    friend bool operator!=(const Iterator &a, const Iterator &b) { return a.pos_ != b.pos_; }
+
+   private:
+    friend class AdjacencyList;
+
+    Iterator(const AdjacencyList *list, uint32_t group, uint32_t pos) : list_(list), group_(group), pos_(pos) {}
+
+    const AdjacencyList *list_{nullptr};
+    uint32_t group_{0};
+    uint32_t pos_{0};
+  };
+
+  using iterator = Iterator;
+  using const_iterator = Iterator;
+
+  AdjacencyList() = default;
+
+  AdjacencyList(const AdjacencyList &other);
+  AdjacencyList(AdjacencyList &&other) noexcept : data_(std::exchange(other.data_, nullptr)) {}
+  AdjacencyList &operator=(const AdjacencyList &other);
+  AdjacencyList &operator=(AdjacencyList &&other) noexcept;
+
+  ~AdjacencyList();
+
+  bool empty() const { return size() == 0; }
+
+  size_t size() const { return data_ ? data_->size : 0; }
+
+  /// Number of distinct edge types currently stored in the list.
+  size_t edge_type_count() const { return data_ ? data_->groups : 0; }
+
+  Iterator begin() const { return Iterator(this, 0, 0); }
+  Iterator end() const { return data_ ? Iterator(this, data_->groups, data_->size) : Iterator(this, 0, 0); }
+
+  /// Returns the range of edges that have the edge type `edge_type`. The time
+  /// complexity of this function is O(log(t)) where t is the number of
+  /// distinct edge types in the list.
+  std::pair<Iterator, Iterator> EdgeTypeRange(EdgeTypeId edge_type) const;
+
+  /// Reserves space for at least `capacity` edges.
+  /// @throw std::bad_alloc
+  void reserve(size_t capacity);
+
+  /// Adds an edge into the group of `edge_type`. The time complexity of this
+  /// function is O(t) where t is the number of distinct edge types in the list.
+  /// @throw std::bad_alloc
+  void emplace_back(EdgeTypeId edge_type, Vertex *vertex, EdgeRef edge);
+
+  /// @throw std::bad_alloc
+  void push_back(const value_type &link) { emplace_back(std::get<0>(link), std::get<1>(link), std::get<2>(link)); }
+
+  /// Appends all edges to/from `neighbor` whose type is in `edge_types` (or all
+  /// of them if `edge_types` is empty) to `result`. With the neighbor index
+  /// in place the time complexity is proportional to the number of edges to
+  /// `neighbor`, otherwise all requested groups are scanned.
+  void AppendEdgesTo(const Vertex *neighbor, const std::vector<EdgeTypeId> &edge_types,
+                     std::vector<value_type> *result) const;
+
+  /// Returns true if the neighbor index is currently built for this list.
+  bool HasNeighborIndex() const { return data_ && data_->neighbors; }
+
+  /// Finds the given edge. Only the group of the edge's type is searched.
+  Iterator find(const value_type &link) const;
+
+  /// Returns true if the given edge exists in the list.
+  bool contains(const value_type &link) const { return find(link) != end(); }
+
+  /// Removes the given edge. Returns false if the edge doesn't exist. The
+  /// time complexity of this function is O(d + t) where d is the number of
+  /// edges of the given type and t the number of distinct edge types.
+  bool erase(const value_type &link);
+
+  /// Removes all edges for which `pred` returns true in a single pass over the
+  /// list and returns how many were removed. The time complexity of this
+  /// function is O(n), so removing many edges from a large list is much
+  /// cheaper than erasing them one by one.
+  template <typename TPredicate>
+  size_t erase_if(TPredicate &&pred);
+
+  void clear() noexcept;
+
+  /// Releases any unused capacity.
+  void shrink_to_fit();
+
+ private:
+  const Group &GroupAt(uint32_t group) const { return Groups()[group]; }
+  const Link &LinkAt(uint32_t pos) const { return Links()[pos]; }
+
+  Group *Groups() const { return reinterpret_cast<Group *>(reinterpret_cast<uint8_t *>(data_) + sizeof(Header)); }
+  Link *Links() const {
+    return reinterpret_cast<Link *>(reinterpret_cast<uint8_t *>(data_) + sizeof(Header) +
+                                    data_->groups_capacity * sizeof(Group));
+  }
+
+  uint32_t GroupBegin(uint32_t group) const { return group == 0 ? 0 : GroupAt(group - 1).end; }
+
+  /// Returns the index of the group for `edge_type` or the index where such
+  /// a group should be inserted to keep the groups sorted.
+  uint32_t LowerBoundGroup(EdgeTypeId edge_type) const;
+
+  /// Returns the index of the group that contains the link at `pos`.
+  uint32_t GroupOf(uint32_t pos) const;
+
+  /// Moves the link at `from` to `to`, keeping the neighbor index up to date.
+  void MoveLink(uint32_t from, uint32_t to);
+
+  void BuildNeighborIndex();
+  void DropNeighborIndex() noexcept;
+
+  /// Reallocates the underlying buffer so that it can hold at least
+  /// `capacity` edges and `groups_capacity` groups.
+  void Reallocate(uint32_t capacity, uint32_t groups_capacity);
+
+  Header *data_{nullptr};
+};
+
+template <typename TPredicate>
+size_t AdjacencyList::erase_if(TPredicate &&pred) {
+  if (!data_) return 0;
+  auto *groups = Groups();
+  auto *links = Links();
+  uint32_t kept = 0;
+  uint32_t kept_groups = 0;
+  uint32_t begin = 0;
+  for (uint32_t group = 0; group < data_->groups; ++group) {
+    const auto edge_type = groups[group].edge_type;
+    const auto end = groups[group].end;
+    for (uint32_t pos = begin; pos < end; ++pos) {
+      if (pred(value_type{edge_type, links[pos].vertex, links[pos].edge})) continue;
+      links[kept++] = links[pos];
+    }
+    begin = end;
+    // The emptied groups are removed from the table.
+    if (kept > (kept_groups == 0 ? 0 : groups[kept_groups - 1].end)) groups[kept_groups++] = {edge_type, kept};
+  }
+  const size_t removed = data_->size - kept;
+  if (removed == 0) return 0;
+  data_->size = kept;
+  data_->groups = kept_groups;
+  // The kept links moved, so the neighbor index is built again from scratch.
+  const bool indexed = data_->neighbors != nullptr;
+  DropNeighborIndex();
+  if (indexed && kept >= kNeighborIndexThreshold / 2) BuildNeighborIndex();
+  return removed;
+}
+
+}  // namespace memgraph::storage
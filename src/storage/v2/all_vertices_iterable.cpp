@@ -14,9 +14,13 @@
 namespace memgraph::storage {
 
 auto AdvanceToVisibleVertex(utils::SkipList<Vertex>::Iterator it, utils::SkipList<Vertex>::Iterator end,
-                            std::optional<VertexAccessor> *vertex, Transaction *tx, View view, Indices *indices,
-                            Constraints *constraints, Config::Items config) {
+                            const std::optional<Gid> &upper_bound, std::optional<VertexAccessor> *vertex,
+                            Transaction *tx, View view, Indices *indices, Constraints *constraints,
+                            Config::Items config) {
   while (it != end) {
+    // The bound is checked by gid and not by node because the node at the
+    // bound may get removed while the range is being iterated.
+    if (upper_bound && it->gid >= *upper_bound) return end;
     *vertex = VertexAccessor::Create(&*it, tx, indices, constraints, config, view);
     if (!*vertex) {
       ++it;
@@ -29,15 +33,15 @@ auto AdvanceToVisibleVertex(utils::SkipList<Vertex>::Iterator it, utils::SkipLis
 
 AllVerticesIterable::Iterator::Iterator(AllVerticesIterable *self, utils::SkipList<Vertex>::Iterator it)
     : self_(self),
-      it_(AdvanceToVisibleVertex(it, self->vertices_accessor_.end(), &self->vertex_, self->transaction_, self->view_,
-                                 self->indices_, self_->constraints_, self->config_)) {}
+      it_(AdvanceToVisibleVertex(it, self->vertices_accessor_.end(), self->upper_bound_, &self->vertex_,
+                                 self->transaction_, self->view_, self->indices_, self_->constraints_, self->config_)) {}
 
 VertexAccessor AllVerticesIterable::Iterator::operator*() const { return *self_->vertex_; }
 
 AllVerticesIterable::Iterator &AllVerticesIterable::Iterator::operator++() {
   ++it_;
-  it_ = AdvanceToVisibleVertex(it_, self_->vertices_accessor_.end(), &self_->vertex_, self_->transaction_, self_->view_,
-                               self_->indices_, self_->constraints_, self_->config_);
+  it_ = AdvanceToVisibleVertex(it_, self_->vertices_accessor_.end(), self_->upper_bound_, &self_->vertex_,
+                               self_->transaction_, self_->view_, self_->indices_, self_->constraints_, self_->config_);
   return *this;
 }
 
@@ -23,6 +23,8 @@ class AllVerticesIterable final {
   Indices *indices_;
   Constraints *constraints_;
   Config::Items config_;
+  std::optional<Gid> lower_bound_;
+  std::optional<Gid> upper_bound_;
   std::optional<VertexAccessor> vertex_;
 
  public:
@@ -51,7 +53,23 @@ class AllVerticesIterable final {
         constraints_(constraints),
         config_(config) {}
 
-  Iterator begin() { return {this, vertices_accessor_.begin()}; }
+  /// Iterates only over the vertices with a gid in `[lower_bound,
+  /// upper_bound)`, a missing bound doesn't limit the range.
+  AllVerticesIterable(utils::SkipList<Vertex>::Accessor vertices_accessor, Transaction *transaction, View view,
+                      Indices *indices, Constraints *constraints, Config::Items config, std::optional<Gid> lower_bound,
+                      std::optional<Gid> upper_bound)
+      : vertices_accessor_(std::move(vertices_accessor)),
+        transaction_(transaction),
+        view_(view),
+        indices_(indices),
+        constraints_(constraints),
+        config_(config),
+        lower_bound_(lower_bound),
+        upper_bound_(upper_bound) {}
+
+  Iterator begin() {
+    return {this, lower_bound_ ? vertices_accessor_.find_equal_or_greater(*lower_bound_) : vertices_accessor_.begin()};
+  }
   Iterator end() { return {this, vertices_accessor_.end()}; }
 };
 
@@ -0,0 +1,88 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/cold_value_store.hpp"
+
+#include <rocksdb/db.h>
+#include <rocksdb/options.h>
+
+#include <system_error>
+#include <utility>
+
+#include "utils/logging.hpp"
+
+namespace memgraph::storage {
+
+namespace {
+std::string EncodeKey(const uint64_t key) { return {reinterpret_cast<const char *>(&key), sizeof(key)}; }
+
+rocksdb::WriteOptions ColdWriteOptions() {
+  rocksdb::WriteOptions options;
+  options.disableWAL = true;
+  return options;
+}
+}  // namespace
+
+ColdValueStore::ColdValueStore(const std::filesystem::path &directory) {
+  std::error_code error;
+  std::filesystem::remove_all(directory, error);
+  std::filesystem::create_directories(directory, error);
+  if (error) {
+    spdlog::error("The directory {} of the evicted property values couldn't be created: {}", directory.string(),
+                  error.message());
+    return;
+  }
+  rocksdb::Options options;
+  options.create_if_missing = true;
+  rocksdb::DB *db = nullptr;
+  auto status = rocksdb::DB::Open(options, directory.string(), &db);
+  if (!status.ok()) {
+    spdlog::error("The store of the evicted property values couldn't be opened in {}: {}", directory.string(),
+                  status.ToString());
+    return;
+  }
+  db_.reset(db);
+}
+
+ColdValueStore::~ColdValueStore() {
+  if (db_ && !db_->Close().ok()) spdlog::error("The store of the evicted property values couldn't be closed.");
+}
+
+std::optional<uint64_t> ColdValueStore::Put(const std::string_view value) {
+  if (!db_) return std::nullopt;
+  const auto key = next_key_.fetch_add(1, std::memory_order_relaxed);
+  if (!db_->Put(ColdWriteOptions(), EncodeKey(key), rocksdb::Slice(value.data(), value.size())).ok()) {
+    return std::nullopt;
+  }
+  count_.fetch_add(1, std::memory_order_relaxed);
+  return key;
+}
+
+std::optional<std::string> ColdValueStore::Get(const uint64_t key) const {
+  if (!db_) return std::nullopt;
+  std::string value;
+  if (!db_->Get(rocksdb::ReadOptions(), EncodeKey(key), &value).ok()) return std::nullopt;
+  return value;
+}
+
+void ColdValueStore::Delete(const uint64_t key) {
+  if (!db_) return;
+  if (db_->Delete(ColdWriteOptions(), EncodeKey(key)).ok()) count_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ColdValueStore::DeleteLater(const uint64_t key) { pending_deletes_->push_back(key); }
+
+void ColdValueStore::DeletePending() {
+  auto keys = pending_deletes_.WithLock([](auto &pending_deletes) { return std::exchange(pending_deletes, {}); });
+  for (const auto key : keys) Delete(key);
+}
+
+}  // namespace memgraph::storage
@@ -0,0 +1,86 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "utils/exceptions.hpp"
+#include "utils/spin_lock.hpp"
+#include "utils/synchronized.hpp"
+
+namespace rocksdb {
+class DB;
+}  // namespace rocksdb
+
+namespace memgraph::storage {
+
+/// Thrown when an evicted property value can't be read back from its store.
+class ColdValueStoreException : public utils::BasicException {
+ public:
+  using utils::BasicException::BasicException;
+};
+
+/// RocksDB store of the large property values which the in-memory storage
+/// evicted from memory because their objects weren't read for a while. The
+/// evicted values are referenced only by the property stores of the running
+/// process, so the store doesn't outlive the process: it's emptied when it's
+/// opened and its writes skip the RocksDB WAL. The values are persisted by the
+/// snapshots and the WAL of the storage as usual.
+/// This class is thread safe.
+class ColdValueStore final {
+ public:
+  /// Opens an empty store in `directory`. If it can't be opened, all of the
+  /// writes fail, so nothing is evicted.
+  explicit ColdValueStore(const std::filesystem::path &directory);
+  ~ColdValueStore();
+
+  ColdValueStore(const ColdValueStore &) = delete;
+  ColdValueStore(ColdValueStore &&) = delete;
+  ColdValueStore &operator=(const ColdValueStore &) = delete;
+  ColdValueStore &operator=(ColdValueStore &&) = delete;
+
+  /// Stores the value and returns its key, or std::nullopt if it couldn't be
+  /// written.
+  std::optional<uint64_t> Put(std::string_view value);
+
+  /// Returns the value stored under the key, or std::nullopt if it couldn't be
+  /// read.
+  std::optional<std::string> Get(uint64_t key) const;
+
+  void Delete(uint64_t key);
+
+  /// Marks the value for deletion by the next `DeletePending` call. Used
+  /// while the lock of the object which referenced the value is held, so that
+  /// the object isn't locked while the store writes to disk.
+  void DeleteLater(uint64_t key);
+
+  /// Deletes the values marked by `DeleteLater`.
+  void DeletePending();
+
+  /// Returns the number of stored values.
+  uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+
+ private:
+  std::unique_ptr<rocksdb::DB> db_;
+  std::atomic<uint64_t> next_key_{0};
+  std::atomic<uint64_t> count_{0};
+  utils::Synchronized<std::vector<uint64_t>, utils::SpinLock> pending_deletes_;
+};
+
+}  // namespace memgraph::storage
@@ -60,6 +60,34 @@ uint64_t CommitLog::OldestActive() {
   return oldest_active_;
 }
 
+uint64_t CommitLog::OldestActiveExcept(uint64_t id) {
+  std::lock_guard<utils::SpinLock> guard(lock_);
+  if (id != oldest_active_) return oldest_active_;
+
+  // The ids before `id` are all finished, so the search continues after it.
+  Block *block = head_;
+  uint64_t block_start = head_start_;
+  uint64_t next = id + 1;
+  while (block) {
+    if (next < block_start + kIdsInBlock) {
+      for (uint64_t i = (next - block_start) / kIdsInField; i < kBlockSize; ++i) {
+        auto field = block->field[i];
+        if (i == (next - block_start) / kIdsInField) {
+          // Ignore the ids before `next` in its field.
+          field |= (1ULL << (next % kIdsInField)) - 1;
+        }
+        if (field != std::numeric_limits<uint64_t>::max()) {
+          return block_start + i * kIdsInField + __builtin_ffsl(~field) - 1;
+        }
+      }
+      next = block_start + kIdsInBlock;
+    }
+    block = block->next;
+    block_start += kIdsInBlock;
+  }
+  return std::max(next, next_start_);
+}
+
 void CommitLog::UpdateOldestActive() {
   while (head_) {
     // This is necessary for amortized constant complexity. If we always start
@@ -53,6 +53,10 @@ class CommitLog final {
   /// Retrieve the oldest transaction still not marked as finished.
   uint64_t OldestActive();
 
+  /// Retrieve the oldest transaction still not marked as finished, ignoring
+  /// the transaction `id`.
+  uint64_t OldestActiveExcept(uint64_t id);
+
  private:
   static constexpr uint64_t kBlockSize = 8192;
   static constexpr uint64_t kIdsInField = sizeof(uint64_t) * 8;
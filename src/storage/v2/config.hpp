@@ -29,14 +29,34 @@ class StorageConfigException : public utils::BasicException {
 /// the storage. This class also defines the default behavior.
 struct Config {
   struct Gc {
-    enum class Type { NONE, PERIODIC };
+    enum class Type { NONE, PERIODIC, INCREMENTAL };
 
     Type type{Type::PERIODIC};
     std::chrono::milliseconds interval{std::chrono::milliseconds(1000)};
+    // Number of threads (including the GC thread) used to unlink deltas and
+    // clean up indices in a single GC cycle.
+    uint64_t threads{1};
+    // Used only by the `INCREMENTAL` GC, which checks the backlog every
+    // `interval` instead of sweeping. A cycle is started once at least
+    // `incremental_backlog` deltas wait to be unlinked (or after a few idle
+    // checks) and it unlinks roughly `incremental_budget` deltas and scans at
+    // most `incremental_budget` objects when looking for analytical deletions.
+    uint64_t incremental_backlog{100000};
+    uint64_t incremental_budget{1000000};
   } gc;
 
   struct Items {
     bool properties_on_edges{true};
+    // With properties on edges, an edge gets its own object only once a
+    // property is set on it. Until then the adjacency lists of its vertices
+    // reference it by its gid, as without properties on edges. Only supported
+    // by the in-memory storage and the edge type property indices can't be
+    // created.
+    bool light_edges{false};
+
+    /// Whether the adjacency lists reference the edge objects instead of the
+    /// edge gids.
+    bool EdgeRefsArePointers() const { return properties_on_edges && !light_edges; }
   } items;
 
   struct Durability {
@@ -50,23 +70,89 @@ struct Config {
 
     std::chrono::milliseconds snapshot_interval{std::chrono::minutes(2)};
     uint64_t snapshot_retention_count{3};
+    // A periodic snapshot is written only once the transactions committed
+    // since the last snapshot changed at least this percentage of the objects.
+    // Until then the WAL files written since the last snapshot are kept and
+    // hold the changes on top of it. Only used with
+    // `PERIODIC_SNAPSHOT_WITH_WAL`.
+    uint64_t snapshot_min_changed_percent{0};
+    // Compress the snapshot files in independently decompressable blocks.
+    bool snapshot_compression{false};
+    // Maximum rate at which the snapshot files are written in MiB per second,
+    // `0` disables the limit.
+    uint64_t snapshot_write_rate_limit_mib{0};
+    // Write the snapshots with the lowest CPU and I/O priority.
+    bool snapshot_low_priority{false};
 
     uint64_t wal_file_size_kibibytes{20 * 1024};
     uint64_t wal_file_flush_every_n_tx{100000};
+    // Number of preallocated files kept ready for new WAL files, `0` disables
+    // the pool.
+    uint64_t wal_segment_pool_size{0};
+    // When enabled, every commit waits until its WAL records are synced to
+    // disk. Concurrent committers are synced together with a single `fsync`
+    // and `wal_file_flush_every_n_tx` is ignored.
+    bool wal_group_commit{false};
+    // Preallocate the WAL files and start writing the WAL and snapshot data
+    // to the disk in the background as soon as it is written to the files.
+    bool async_writeback{false};
 
     bool snapshot_on_exit{false};
     bool restore_replication_state_on_startup{false};
+    // Number of SYNC replicas that have to confirm a commit before it's
+    // acknowledged. 0 waits for all SYNC replicas one after another.
+    uint64_t replication_sync_quorum{0};
+    // Maximum number of WAL files kept after the oldest snapshot so that the
+    // replicas which are behind can be recovered without a snapshot transfer.
+    uint64_t replication_max_retained_wal_files{100};
 
     uint64_t items_per_batch{1'000'000};
     uint64_t recovery_thread_count{8};
+    // Read the snapshot files through a memory mapping instead of buffered
+    // reads during recovery.
+    bool snapshot_recovery_mmap{false};
 
     bool allow_parallel_index_creation{false};
+    bool allow_parallel_snapshot_creation{false};
+    bool allow_parallel_wal_recovery{false};
   } durability;
 
   struct Transaction {
     IsolationLevel isolation_level{IsolationLevel::SNAPSHOT_ISOLATION};
   } transaction;
 
+  struct Constraints {
+    // Keeps the entries of in-memory unique constraints in a hash table instead
+    // of a skip list, which makes the check done on every commit cheaper.
+    bool unique_hash_index{false};
+  } constraints;
+
+  struct IndexStats {
+    // The statistics of an index are recomputed in the background once the
+    // committed changes of its label and property reach this fraction of the
+    // vertices in the index. `0` disables the refresh.
+    double refresh_threshold{0.0};
+    std::chrono::milliseconds refresh_interval{std::chrono::seconds(60)};
+  } index_stats;
+
+  struct Defragmentation {
+    // Every `interval` the property buffers of at most `budget` vertices and
+    // edges are moved out of the sparsely used allocator extents, continuing
+    // after the objects visited by the previous pass. `0` disables the passes.
+    uint64_t budget{0};
+    std::chrono::milliseconds interval{std::chrono::seconds(10)};
+  } defragmentation;
+
+  struct Tiering {
+    // Every `interval` at most `budget` vertices and edges are visited,
+    // continuing after the objects visited by the previous pass. The large
+    // property values of the objects whose properties weren't read since the
+    // previous visit are evicted to disk, and the evicted values of the
+    // objects which are read again are loaded back. `0` disables the tiering.
+    uint64_t budget{0};
+    std::chrono::milliseconds interval{std::chrono::seconds(10)};
+  } tiering;
+
   struct DiskConfig {
     std::filesystem::path main_storage_directory{"storage/rocksdb_main_storage"};
     std::filesystem::path label_index_directory{"storage/rocksdb_label_index"};
@@ -76,6 +162,20 @@ struct Config {
     std::filesystem::path id_name_mapper_directory{"storage/rocksdb_id_name_mapper"};
     std::filesystem::path durability_directory{"storage/rocksdb_durability"};
     std::filesystem::path wal_directory{"storage/rocksdb_wal"};
+    // Size of the block cache shared by the vertex and edge column families,
+    // 0 keeps the RocksDB default cache of each column family.
+    uint64_t block_cache_size_mib{0};
+    // Bits per key of the bloom filters in the SST files, 0 disables them.
+    uint64_t bloom_filter_bits_per_key{0};
+    // Universal compaction has a lower write amplification than the default
+    // level compaction, at the cost of more space and slower reads.
+    bool universal_compaction{false};
+    // Number of committed vertices and of committed edges cached in memory
+    // between transactions, 0 disables the cache.
+    uint64_t object_cache_size{0};
+    // Pipelined writes let the WAL write of one commit overlap with the
+    // memtable write of another, which helps with many concurrent commits.
+    bool pipelined_write{false};
   } disk;
 
   std::string name;
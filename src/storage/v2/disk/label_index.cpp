@@ -51,6 +51,7 @@ DiskLabelIndex::DiskLabelIndex(Indices *indices, Constraints *constraints, const
   kvstore_ = std::make_unique<RocksDBStorage>();
   kvstore_->options_.create_if_missing = true;
   kvstore_->options_.comparator = new ComparatorWithU64TsImpl();
+  kvstore_->options_.enable_pipelined_write = config.disk.pipelined_write;
   logging::AssertRocksDBStatus(rocksdb::TransactionDB::Open(kvstore_->options_, rocksdb::TransactionDBOptions(),
                                                             config.disk.label_index_directory, &kvstore_->db_));
 }
@@ -78,11 +79,9 @@ std::unique_ptr<rocksdb::Transaction> DiskLabelIndex::CreateAllReadingRocksDBTra
   return tx;
 }
 
-bool DiskLabelIndex::SyncVertexToLabelIndexStorage(const Vertex &vertex, uint64_t commit_timestamp) const {
-  auto disk_transaction = CreateRocksDBTransaction();
-
+bool DiskLabelIndex::SyncVertexToLabelIndexStorage(const Vertex &vertex, rocksdb::Transaction &disk_transaction) const {
   if (auto maybe_old_disk_key = utils::GetOldDiskKeyOrNull(vertex.delta); maybe_old_disk_key.has_value()) {
-    if (!disk_transaction->Delete(maybe_old_disk_key.value()).ok()) {
+    if (!disk_transaction.Delete(maybe_old_disk_key.value()).ok()) {
       return false;
     }
   }
@@ -99,43 +98,39 @@ bool DiskLabelIndex::SyncVertexToLabelIndexStorage(const Vertex &vertex, uint64_
     }
   }
 
-  return CommitWithTimestamp(disk_transaction.get(), commit_timestamp);
+  return true;
 }
 
 /// TODO: this can probably be optimized
-bool DiskLabelIndex::ClearDeletedVertex(std::string_view gid, uint64_t transaction_commit_timestamp) const {
-  auto disk_transaction = CreateAllReadingRocksDBTransaction();
-
+bool DiskLabelIndex::ClearDeletedVertex(std::string_view gid, rocksdb::Transaction &disk_transaction) const {
   rocksdb::ReadOptions ro;
   std::string strTs = utils::StringTimestamp(std::numeric_limits<uint64_t>::max());
   rocksdb::Slice ts(strTs);
   ro.timestamp = &ts;
-  auto it = std::unique_ptr<rocksdb::Iterator>(disk_transaction->GetIterator(ro));
+  auto it = std::unique_ptr<rocksdb::Iterator>(disk_transaction.GetIterator(ro));
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
     if (std::string key = it->key().ToString(); gid == utils::ExtractGidFromLabelIndexStorage(key)) {
-      if (!disk_transaction->Delete(key).ok()) {
+      if (!disk_transaction.Delete(key).ok()) {
         return false;
       }
     }
   }
 
-  return CommitWithTimestamp(disk_transaction.get(), transaction_commit_timestamp);
+  return true;
 }
 
 bool DiskLabelIndex::DeleteVerticesWithRemovedIndexingLabel(uint64_t transaction_start_timestamp,
-                                                            uint64_t transaction_commit_timestamp) {
+                                                            rocksdb::Transaction &disk_transaction) {
   if (entries_for_deletion->empty()) {
     return true;
   }
 
-  auto disk_transaction = CreateAllReadingRocksDBTransaction();
-
   rocksdb::ReadOptions ro;
   std::string strTs = utils::StringTimestamp(std::numeric_limits<uint64_t>::max());
   rocksdb::Slice ts(strTs);
   ro.timestamp = &ts;
   bool deletion_success = entries_for_deletion.WithLock(
-      [transaction_start_timestamp, disk_transaction_ptr = disk_transaction.get()](auto &tx_to_entries_for_deletion) {
+      [transaction_start_timestamp, disk_transaction_ptr = &disk_transaction](auto &tx_to_entries_for_deletion) {
         if (auto tx_it = tx_to_entries_for_deletion.find(transaction_start_timestamp);
             tx_it != tx_to_entries_for_deletion.end()) {
           bool res = ClearTransactionEntriesWithRemovedIndexingLabel(*disk_transaction_ptr, tx_it->second);
@@ -144,10 +139,7 @@ bool DiskLabelIndex::DeleteVerticesWithRemovedIndexingLabel(uint64_t transaction
         }
         return true;
       });
-  if (deletion_success) {
-    return CommitWithTimestamp(disk_transaction.get(), transaction_commit_timestamp);
-  }
-  return false;
+  return deletion_success;
 }
 
 void DiskLabelIndex::UpdateOnAddLabel(LabelId added_label, Vertex *vertex_before_update, const Transaction &tx) {
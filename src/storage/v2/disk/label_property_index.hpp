@@ -29,12 +29,15 @@ class DiskLabelPropertyIndex : public storage::LabelPropertyIndex {
 
   std::unique_ptr<rocksdb::Transaction> CreateAllReadingRocksDBTransaction() const;
 
-  [[nodiscard]] bool SyncVertexToLabelPropertyIndexStorage(const Vertex &vertex, uint64_t commit_timestamp) const;
+  /// The following methods only write into the given transaction of the index storage, it is committed together
+  /// with the transaction of the main storage.
+  [[nodiscard]] bool SyncVertexToLabelPropertyIndexStorage(const Vertex &vertex,
+                                                           rocksdb::Transaction &disk_transaction) const;
 
-  [[nodiscard]] bool ClearDeletedVertex(std::string_view gid, uint64_t transaction_commit_timestamp) const;
+  [[nodiscard]] bool ClearDeletedVertex(std::string_view gid, rocksdb::Transaction &disk_transaction) const;
 
   [[nodiscard]] bool DeleteVerticesWithRemovedIndexingLabel(uint64_t transaction_start_timestamp,
-                                                            uint64_t transaction_commit_timestamp);
+                                                            rocksdb::Transaction &disk_transaction);
 
   void UpdateOnAddLabel(LabelId added_label, Vertex *vertex_after_update, const Transaction &tx) override;
 
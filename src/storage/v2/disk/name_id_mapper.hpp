@@ -38,7 +38,14 @@ class DiskNameIdMapper final : public NameIdMapper {
   }
 
   uint64_t NameToId(const std::string_view name) override {
+    auto &cached_ids = ThreadCachedIds();
+    if (auto cached = cached_ids.find(name); cached != cached_ids.end()) {
+      return cached->second;
+    }
     if (auto maybe_id = MaybeNameToId(name); maybe_id.has_value()) {
+      if (const auto *stored_name = id_to_name_.Find(maybe_id.value()); stored_name != nullptr) {
+        CacheNameToId(cached_ids, *stored_name, maybe_id.value());
+      }
       return maybe_id.value();
     }
     uint64_t res_id = 0;
@@ -58,16 +65,15 @@ class DiskNameIdMapper final : public NameIdMapper {
   }
 
   const std::string &IdToName(uint64_t id) override {
-    auto maybe_name = NameIdMapper::MaybeIdToName(id);
-    if (maybe_name.has_value()) {
-      return maybe_name.value();
+    if (const auto *name = id_to_name_.Find(id); name != nullptr) {
+      return *name;
     }
 
     auto maybe_name_from_disk = id_to_name_storage_->Get(std::to_string(id));
     MG_ASSERT(maybe_name_from_disk.has_value(), "Trying to get a name from disk for an invalid ID!");
 
-    InsertIdNameEntryToCache(id, maybe_name_from_disk.value());
-    return InsertNameIdEntryToCache(maybe_name_from_disk.value(), id);
+    InsertNameIdEntryToCache(maybe_name_from_disk.value(), id);
+    return InsertIdNameEntryToCache(id, maybe_name_from_disk.value());
   }
 
  private:
@@ -86,8 +92,7 @@ class DiskNameIdMapper final : public NameIdMapper {
   }
 
   const std::string &InsertIdNameEntryToCache(uint64_t id, const std::string &name) {
-    auto id_to_name_acc = id_to_name_.access();
-    return id_to_name_acc.insert({id, std::string(name)}).first->name;
+    return id_to_name_.Insert(id, name);
   }
 
   void InitializeFromDisk() {
@@ -0,0 +1,89 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "storage/v2/id_types.hpp"
+#include "utils/cache.hpp"
+
+namespace memgraph::storage {
+
+/// Committed objects of the disk storage shared between transactions, so that hot objects aren't read from RocksDB
+/// by every transaction. Objects are cached as the key and value stored in RocksDB and keyed by their gid.
+///
+/// An entry remembers the last invalidation timestamp at the time it was inserted. All commits that happened before
+/// that are already in the entry and every later commit of the object removes it, so the entry is visible to
+/// transactions that started at or after that timestamp.
+/// This class is thread safe.
+class DiskObjectCache {
+ public:
+  /// @param capacity maximum number of cached objects, 0 disables the cache.
+  explicit DiskObjectCache(uint64_t capacity) : capacity_(capacity), entries_(capacity ? capacity : 1) {}
+
+  /// Returns the key and value of the object if its entry is visible to the transaction started at start_timestamp.
+  std::optional<std::pair<std::string, std::string>> Find(Gid gid, uint64_t start_timestamp) {
+    if (capacity_ == 0) {
+      return std::nullopt;
+    }
+    std::lock_guard guard(lock_);
+    auto entry = entries_.Find(gid);
+    if (!entry || start_timestamp < entry->valid_from) {
+      return std::nullopt;
+    }
+    return std::make_pair(std::move(entry->key), std::move(entry->value));
+  }
+
+  /// Caches the object read by the transaction started at start_timestamp. The object isn't cached if something was
+  /// committed after the transaction started because the transaction could have read an older version.
+  void Insert(Gid gid, std::string key, std::string value, uint64_t start_timestamp) {
+    if (capacity_ == 0) {
+      return;
+    }
+    std::lock_guard guard(lock_);
+    if (start_timestamp < last_invalidation_timestamp_) {
+      return;
+    }
+    entries_.Insert(gid, Entry{std::move(key), std::move(value), last_invalidation_timestamp_});
+  }
+
+  /// Removes the object after a commit that changed it. Transactions started before timestamp won't cache their
+  /// reads anymore, so it must be larger than the start timestamp of every transaction that could have read the
+  /// object before the commit.
+  void Invalidate(Gid gid, uint64_t timestamp) {
+    if (capacity_ == 0) {
+      return;
+    }
+    std::lock_guard guard(lock_);
+    entries_.Erase(gid);
+    last_invalidation_timestamp_ = std::max(last_invalidation_timestamp_, timestamp);
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    std::string value;
+    uint64_t valid_from;
+  };
+
+  uint64_t capacity_;
+  std::mutex lock_;
+  utils::LruCache<Gid, Entry> entries_;
+  uint64_t last_invalidation_timestamp_{0};
+};
+
+}  // namespace memgraph::storage
@@ -12,6 +12,7 @@
 #include "rocksdb_storage.hpp"
 #include <string_view>
 #include "utils/rocksdb_serialization.hpp"
+#include "utils/string.hpp"
 
 namespace memgraph::storage {
 
@@ -80,6 +81,16 @@ int ComparatorWithU64TsImpl::CompareTimestamp(const rocksdb::Slice &ts1, const r
   return 0;
 }
 
+int AdjacencyComparatorWithU64TsImpl::CompareWithoutTimestamp(const rocksdb::Slice &a, bool a_has_ts,
+                                                              const rocksdb::Slice &b, bool b_has_ts) const {
+  const size_t ts_sz = timestamp_size();
+  assert(!a_has_ts || a.size() >= ts_sz);
+  assert(!b_has_ts || b.size() >= ts_sz);
+  rocksdb::Slice lhsUserKey = a_has_ts ? StripTimestampFromUserKey(a, ts_sz) : a;
+  rocksdb::Slice rhsUserKey = b_has_ts ? StripTimestampFromUserKey(b, ts_sz) : b;
+  return lhsUserKey.compare(rhsUserKey);
+}
+
 DiskEdgeKey::DiskEdgeKey(storage::EdgeAccessor *edge_acc) {
   auto from_gid = utils::SerializeIdType(edge_acc->FromVertex().Gid());
   auto to_gid = utils::SerializeIdType(edge_acc->ToVertex().Gid());
@@ -114,4 +125,34 @@ std::string DiskEdgeKey::GetVertexInGid() const {
 
 std::string DiskEdgeKey::GetEdgeGid() const { return key.substr(key.rfind('|') + 1); }
 
+std::string DiskEdgeKey::GetEdgeType() const {
+  auto edge_gid_start = key.rfind('|');
+  auto edge_type_start = key.rfind('|', edge_gid_start - 1) + 1;
+  return key.substr(edge_type_start, edge_gid_start - edge_type_start);
+}
+
+std::string DiskEdgeKey::GetOutAdjacencyKey() const {
+  return fmt::format("{}|{}|{}|{}|{}", utils::outEdgeDirection, GetVertexOutGid(), GetEdgeType(), GetVertexInGid(),
+                     GetEdgeGid());
+}
+
+std::string DiskEdgeKey::GetInAdjacencyKey() const {
+  return fmt::format("{}|{}|{}|{}|{}", utils::inEdgeDirection, GetVertexInGid(), GetEdgeType(), GetVertexOutGid(),
+                     GetEdgeGid());
+}
+
+std::string DiskEdgeKey::AdjacencyPrefix(storage::Gid vertex_gid, EdgeDirection edge_direction) {
+  return fmt::format("{}|{}|", edge_direction == EdgeDirection::OUT ? utils::outEdgeDirection : utils::inEdgeDirection,
+                     utils::SerializeIdType(vertex_gid));
+}
+
+DiskEdgeKey DiskEdgeKey::FromAdjacencyKey(std::string_view adjacency_key) {
+  const std::vector<std::string> parts = utils::Split(adjacency_key, "|");
+  MG_ASSERT(parts.size() == 5, "Invalid adjacency key {}", adjacency_key);
+  const bool is_out = parts[0] == utils::outEdgeDirection;
+  const auto &from_gid = is_out ? parts[1] : parts[3];
+  const auto &to_gid = is_out ? parts[3] : parts[1];
+  return DiskEdgeKey(fmt::format("{}|{}|{}|{}|{}", from_gid, to_gid, utils::outEdgeDirection, parts[2], parts[4]));
+}
+
 }  // namespace memgraph::storage
@@ -18,6 +18,9 @@
 #include <rocksdb/status.h>
 #include <rocksdb/utilities/transaction_db.h>
 
+#include <memory>
+#include <string_view>
+
 #include "storage/v2/edge_accessor.hpp"
 #include "storage/v2/edge_direction.hpp"
 #include "storage/v2/id_types.hpp"
@@ -50,6 +53,10 @@ struct RocksDBStorage {
   rocksdb::ColumnFamilyHandle *vertex_chandle = nullptr;
   rocksdb::ColumnFamilyHandle *edge_chandle = nullptr;
   rocksdb::ColumnFamilyHandle *default_chandle = nullptr;
+  /// Column family with two keys per edge, ordered by the vertex whose edges are expanded. Values are empty, the
+  /// edge itself is always read from the edge column family.
+  rocksdb::ColumnFamilyHandle *adjacency_chandle = nullptr;
+  std::unique_ptr<rocksdb::Comparator> adjacency_comparator_;
 };
 
 /// RocksDB comparator that compares keys with timestamps.
@@ -76,6 +83,19 @@ class ComparatorWithU64TsImpl : public rocksdb::Comparator {
   const Comparator *cmp_without_ts_{nullptr};
 };
 
+/// RocksDB comparator that compares keys with timestamps bytewise on the whole user key. Used by the adjacency
+/// column family so that keys sharing a prefix form a contiguous range.
+class AdjacencyComparatorWithU64TsImpl : public ComparatorWithU64TsImpl {
+ public:
+  static const char *kClassName() { return "adjacency"; }
+
+  const char *Name() const override { return kClassName(); }
+
+  using Comparator::CompareWithoutTimestamp;
+  int CompareWithoutTimestamp(const rocksdb::Slice &a, bool a_has_ts, const rocksdb::Slice &b,
+                              bool b_has_ts) const override;
+};
+
 struct DiskEdgeKey {
   DiskEdgeKey(const std::string_view keyView) : key(keyView) {}
 
@@ -93,7 +113,19 @@ struct DiskEdgeKey {
   std::string GetVertexInGid() const;
   std::string GetEdgeGid() const;
 
+  /// Keys of the edge in the adjacency column family:
+  /// direction | vertex_gid | edge_type | other_vertex_gid | GID | commit_timestamp
+  std::string GetOutAdjacencyKey() const;
+  std::string GetInAdjacencyKey() const;
+
+  /// Prefix shared by the adjacency keys of all edges of the vertex in the given direction.
+  static std::string AdjacencyPrefix(Gid vertex_gid, EdgeDirection edge_direction);
+
+  static DiskEdgeKey FromAdjacencyKey(std::string_view adjacency_key);
+
  private:
+  std::string GetEdgeType() const;
+
   // vertex_gid_1 | vertex_gid_2 | direction | edge_type | GID | commit_timestamp
   // Currently direction is only out.
   std::string key;
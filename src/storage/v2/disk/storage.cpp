@@ -9,19 +9,27 @@
 // by the Apache License, Version 2.0, included in the file
 // licenses/APL.txt.
 
+#include <algorithm>
 #include <atomic>
+#include <filesystem>
 #include <limits>
 #include <optional>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include <rocksdb/cache.h>
 #include <rocksdb/comparator.h>
 #include <rocksdb/db.h>
+#include <rocksdb/filter_policy.h>
 #include <rocksdb/slice.h>
+#include <rocksdb/sst_file_writer.h>
 
 #include <rocksdb/options.h>
+#include <rocksdb/statistics.h>
+#include <rocksdb/table.h>
 #include <rocksdb/utilities/transaction.h>
 #include <rocksdb/utilities/transaction_db.h>
 
@@ -45,6 +53,7 @@
 #include "storage/v2/vertex_accessor.hpp"
 #include "storage/v2/view.hpp"
 #include "utils/disk_utils.hpp"
+#include "utils/event_gauge.hpp"
 #include "utils/exceptions.hpp"
 #include "utils/file.hpp"
 #include "utils/logging.hpp"
@@ -58,6 +67,15 @@
 #include "utils/stat.hpp"
 #include "utils/string.hpp"
 
+namespace memgraph::metrics {
+extern const Event DiskBlockCacheHit;
+extern const Event DiskBlockCacheMiss;
+extern const Event DiskBloomFilterUseful;
+extern const Event DiskBytesRead;
+extern const Event DiskBytesWritten;
+extern const Event DiskCompactionBytesWritten;
+}  // namespace memgraph::metrics
+
 namespace memgraph::storage {
 
 using OOMExceptionEnabler = utils::MemoryTracker::OutOfMemoryExceptionEnabler;
@@ -68,6 +86,7 @@ constexpr const char *deserializeTimestamp = "0";
 constexpr const char *vertexHandle = "vertex";
 constexpr const char *edgeHandle = "edge";
 constexpr const char *defaultHandle = "default";
+constexpr const char *adjacencyHandle = "adjacency";
 constexpr const char *lastTransactionStartTimeStamp = "last_transaction_start_timestamp";
 constexpr const char *vertex_count_descr = "vertex_count";
 constexpr const char *edge_count_descr = "edge_count";
@@ -75,6 +94,10 @@ constexpr const char *label_index_str = "label_index";
 constexpr const char *label_property_index_str = "label_property_index";
 constexpr const char *existence_constraints_str = "existence_constraints";
 constexpr const char *unique_constraints_str = "unique_constraints";
+constexpr const char *edge_import_mode_str = "edge_import_mode";
+
+/// Number of edges whose adjacency entries are ingested as one SST file by the fix-up pass of the edge import mode.
+constexpr uint64_t kAdjacencyFixUpBatchSize = 1U << 20U;
 
 bool VertexNeedsToBeSerialized(const Vertex &vertex) {
   Delta *head = vertex.delta;
@@ -89,10 +112,62 @@ bool VertexNeedsToBeSerialized(const Vertex &vertex) {
   return false;
 }
 
+bool EdgeNeedsToBeSerialized(const Edge &edge) {
+  for (const Delta *head = edge.delta; head != nullptr; head = head->next) {
+    if (head->action == Delta::Action::SET_PROPERTY) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Returns the out-edges the transaction created from the vertex, whose creation is undone by REMOVE_OUT_EDGE deltas.
+std::vector<EdgeRef> CreatedOutEdges(const Vertex &vertex) {
+  std::vector<EdgeRef> edges;
+  for (const Delta *head = vertex.delta; head != nullptr; head = head->next) {
+    if (head->action == Delta::Action::REMOVE_OUT_EDGE) {
+      edges.push_back(head->vertex_edge.edge);
+    }
+  }
+  return edges;
+}
+
 bool VertexExistsInCache(const utils::SkipList<Vertex>::Accessor &accessor, Gid gid) {
   return accessor.find(gid) != accessor.end();
 }
 
+/// Sorts the entries by the comparator of the column family, writes them into the SST file and ingests it. Of the
+/// entries with keys equal by the comparator only the last one is kept, as it would be by consecutive writes.
+void IngestEntries(rocksdb::DB *db, const rocksdb::Options &options, rocksdb::ColumnFamilyHandle *chandle,
+                   std::vector<std::pair<std::string, std::string>> &&entries, uint64_t timestamp,
+                   const std::filesystem::path &file) {
+  if (entries.empty()) {
+    return;
+  }
+  const rocksdb::Comparator *comparator = chandle->GetComparator();
+  auto key_less = [comparator](const auto &lhs, const auto &rhs) {
+    return comparator->CompareWithoutTimestamp(lhs.first, /*a_has_ts=*/false, rhs.first, /*b_has_ts=*/false) < 0;
+  };
+  std::stable_sort(entries.begin(), entries.end(), key_less);
+
+  rocksdb::Options file_options(options);
+  file_options.comparator = comparator;
+  rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), file_options, chandle);
+  logging::AssertRocksDBStatus(writer.Open(file.string()));
+  const std::string strTs = utils::StringTimestamp(timestamp);
+  for (auto it = entries.begin(); it != entries.end(); ++it) {
+    if (auto next = std::next(it); next != entries.end() && !key_less(*it, *next)) {
+      continue;
+    }
+    logging::AssertRocksDBStatus(writer.Put(it->first, strTs, it->second));
+  }
+  logging::AssertRocksDBStatus(writer.Finish());
+
+  rocksdb::IngestExternalFileOptions ingest_options;
+  ingest_options.move_files = true;
+  logging::AssertRocksDBStatus(db->IngestExternalFile(chandle, {file.string()}, ingest_options));
+}
+
 bool VertexHasLabel(const Vertex &vertex, LabelId label, Transaction *transaction, View view) {
   bool deleted = vertex.deleted;
   bool has_label = std::find(vertex.labels.begin(), vertex.labels.end(), label) != vertex.labels.end();
@@ -262,23 +337,58 @@ void DiskStorage::LoadUniqueConstraintInfoIfExists() const {
 DiskStorage::DiskStorage(Config config)
     : Storage(config, StorageMode::ON_DISK_TRANSACTIONAL),
       kvstore_(std::make_unique<RocksDBStorage>()),
-      durability_kvstore_(std::make_unique<kvstore::KVStore>(config.disk.durability_directory)) {
+      durability_kvstore_(std::make_unique<kvstore::KVStore>(config.disk.durability_directory)),
+      vertex_cache_(config.disk.object_cache_size),
+      edge_cache_(config.disk.object_cache_size) {
+  // The light edges are only supported by the in-memory storage.
+  config_.items.light_edges = false;
   LoadTimestampIfExists();
   LoadVertexAndEdgeCountIfExists();
   LoadIndexInfoIfExists();
   LoadConstraintsInfoIfExists();
   kvstore_->options_.create_if_missing = true;
   kvstore_->options_.comparator = new ComparatorWithU64TsImpl();
+  kvstore_->options_.enable_pipelined_write = config_.disk.pipelined_write;
   kvstore_->options_.compression = rocksdb::kNoCompression;
   kvstore_->options_.wal_recovery_mode = rocksdb::WALRecoveryMode::kPointInTimeRecovery;
   kvstore_->options_.wal_dir = config_.disk.wal_directory;
   kvstore_->options_.wal_compression = rocksdb::kNoCompression;
+  // The column families are created from the same options, so they share the
+  // table factory and with it the block cache.
+  if (config_.disk.block_cache_size_mib > 0 || config_.disk.bloom_filter_bits_per_key > 0) {
+    rocksdb::BlockBasedTableOptions table_options;
+    if (config_.disk.block_cache_size_mib > 0) {
+      table_options.block_cache = rocksdb::NewLRUCache(config_.disk.block_cache_size_mib * 1024 * 1024);
+    }
+    if (config_.disk.bloom_filter_bits_per_key > 0) {
+      table_options.filter_policy.reset(
+          rocksdb::NewBloomFilterPolicy(static_cast<double>(config_.disk.bloom_filter_bits_per_key)));
+    }
+    kvstore_->options_.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
+  }
+  if (config_.disk.universal_compaction) {
+    kvstore_->options_.compaction_style = rocksdb::kCompactionStyleUniversal;
+  }
+  kvstore_->options_.statistics = rocksdb::CreateDBStatistics();
+  kvstore_->adjacency_comparator_ = std::make_unique<AdjacencyComparatorWithU64TsImpl>();
+  rocksdb::ColumnFamilyOptions adjacency_options(kvstore_->options_);
+  adjacency_options.comparator = kvstore_->adjacency_comparator_.get();
   std::vector<rocksdb::ColumnFamilyHandle *> column_handles;
   std::vector<rocksdb::ColumnFamilyDescriptor> column_families;
   if (utils::DirExists(config.disk.main_storage_directory)) {
+    std::vector<std::string> existing_column_families;
+    // Databases created before the adjacency column family existed get it created here and filled from the edges.
+    const bool has_adjacency =
+        rocksdb::DB::ListColumnFamilies(kvstore_->options_, config.disk.main_storage_directory,
+                                        &existing_column_families)
+            .ok() &&
+        std::find(existing_column_families.begin(), existing_column_families.end(), adjacencyHandle) !=
+            existing_column_families.end();
+    kvstore_->options_.create_missing_column_families = true;
     column_families.emplace_back(vertexHandle, kvstore_->options_);
     column_families.emplace_back(edgeHandle, kvstore_->options_);
     column_families.emplace_back(defaultHandle, kvstore_->options_);
+    column_families.emplace_back(adjacencyHandle, adjacency_options);
 
     logging::AssertRocksDBStatus(rocksdb::TransactionDB::Open(kvstore_->options_, rocksdb::TransactionDBOptions(),
                                                               config.disk.main_storage_directory, column_families,
@@ -286,6 +396,10 @@ DiskStorage::DiskStorage(Config config)
     kvstore_->vertex_chandle = column_handles[0];
     kvstore_->edge_chandle = column_handles[1];
     kvstore_->default_chandle = column_handles[2];
+    kvstore_->adjacency_chandle = column_handles[3];
+    if (!has_adjacency) {
+      BuildAdjacencyFromEdges();
+    }
   } else {
     logging::AssertRocksDBStatus(rocksdb::TransactionDB::Open(kvstore_->options_, rocksdb::TransactionDBOptions(),
                                                               config.disk.main_storage_directory, &kvstore_->db_));
@@ -293,7 +407,194 @@ DiskStorage::DiskStorage(Config config)
         kvstore_->db_->CreateColumnFamily(kvstore_->options_, vertexHandle, &kvstore_->vertex_chandle));
     logging::AssertRocksDBStatus(
         kvstore_->db_->CreateColumnFamily(kvstore_->options_, edgeHandle, &kvstore_->edge_chandle));
+    logging::AssertRocksDBStatus(
+        kvstore_->db_->CreateColumnFamily(adjacency_options, adjacencyHandle, &kvstore_->adjacency_chandle));
+  }
+  // The storage was closed in the edge import mode, so the adjacency of the imported edges is still missing.
+  if (durability_kvstore_->Get(edge_import_mode_str).has_value()) {
+    IngestAdjacencyFromEdges();
+    durability_kvstore_->Delete(edge_import_mode_str);
+  }
+}
+
+void DiskStorage::BuildAdjacencyFromEdges() {
+  rocksdb::ReadOptions ro;
+  std::string strTs = utils::StringTimestamp(std::numeric_limits<uint64_t>::max());
+  rocksdb::Slice ts(strTs);
+  ro.timestamp = &ts;
+  auto it = std::unique_ptr<rocksdb::Iterator>(kvstore_->db_->NewIterator(ro, kvstore_->edge_chandle));
+  auto disk_transaction = std::unique_ptr<rocksdb::Transaction>(
+      kvstore_->db_->BeginTransaction(rocksdb::WriteOptions(), rocksdb::TransactionOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    const DiskEdgeKey disk_edge_key(it->key().ToStringView());
+    logging::AssertRocksDBStatus(
+        disk_transaction->Put(kvstore_->adjacency_chandle, disk_edge_key.GetOutAdjacencyKey(), ""));
+    logging::AssertRocksDBStatus(
+        disk_transaction->Put(kvstore_->adjacency_chandle, disk_edge_key.GetInAdjacencyKey(), ""));
+  }
+  disk_transaction->SetCommitTimestamp(0);
+  logging::AssertRocksDBStatus(disk_transaction->Commit());
+}
+
+void DiskStorage::IngestAdjacencyFromEdges() {
+  rocksdb::ReadOptions ro;
+  std::string strTs = utils::StringTimestamp(std::numeric_limits<uint64_t>::max());
+  rocksdb::Slice ts(strTs);
+  ro.timestamp = &ts;
+  auto it = std::unique_ptr<rocksdb::Iterator>(kvstore_->db_->NewIterator(ro, kvstore_->edge_chandle));
+  const uint64_t timestamp = BulkImportTimestamp();
+  const auto directory = BulkImportDirectory();
+  utils::EnsureDirOrDie(directory);
+  std::vector<std::pair<std::string, std::string>> adjacency_entries;
+  uint64_t file_id = 0;
+  auto ingest = [&] {
+    IngestEntries(kvstore_->db_, kvstore_->options_, kvstore_->adjacency_chandle, std::move(adjacency_entries),
+                  timestamp, directory / fmt::format("adjacency_{}.sst", file_id++));
+    adjacency_entries.clear();
+  };
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    const DiskEdgeKey disk_edge_key(it->key().ToStringView());
+    adjacency_entries.emplace_back(disk_edge_key.GetOutAdjacencyKey(), "");
+    adjacency_entries.emplace_back(disk_edge_key.GetInAdjacencyKey(), "");
+    if (adjacency_entries.size() >= 2 * kAdjacencyFixUpBatchSize) {
+      ingest();
+    }
+  }
+  ingest();
+  utils::DeleteDir(directory);
+}
+
+void DiskStorage::SetEdgeImportMode(const bool active) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  if (active == edge_import_mode_active_.load(std::memory_order_acquire)) {
+    return;
+  }
+  if (active) {
+    // Persisted so that the adjacency is fixed up on the next start if the storage is closed in the mode.
+    durability_kvstore_->Put(edge_import_mode_str, "");
+  } else {
+    IngestAdjacencyFromEdges();
+    durability_kvstore_->Delete(edge_import_mode_str);
   }
+  edge_import_mode_active_.store(active, std::memory_order_release);
+}
+
+std::filesystem::path DiskStorage::BulkImportDirectory() const {
+  auto directory = config_.disk.main_storage_directory;
+  directory += "_bulk_import";
+  return directory;
+}
+
+uint64_t DiskStorage::BulkImportTimestamp() {
+  std::lock_guard guard(engine_lock_);
+  return CommitTimestamp(std::nullopt);
+}
+
+utils::BasicResult<StorageDataManipulationError, std::vector<Gid>> DiskStorage::BulkImportVertices(
+    const std::vector<BulkImportVertex> &vertices) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+
+  if (!constraints_.unique_constraints_->ListConstraints().empty()) {
+    throw utils::NotYetImplemented("Bulk import of vertices while there are unique constraints.");
+  }
+  const auto existence_constraints = constraints_.existence_constraints_->ListConstraints();
+  for (const auto &vertex : vertices) {
+    for (const auto &[label, property] : existence_constraints) {
+      if (utils::Contains(vertex.labels, label) && !vertex.properties.contains(property)) {
+        return StorageDataManipulationError{
+            ConstraintViolation{ConstraintViolation::Type::EXISTENCE, label, std::set<PropertyId>{property}}};
+      }
+    }
+  }
+
+  auto *disk_label_index = static_cast<DiskLabelIndex *>(indices_.label_index_.get());
+  auto *disk_label_property_index = static_cast<DiskLabelPropertyIndex *>(indices_.label_property_index_.get());
+  const auto label_indices = disk_label_index->ListIndices();
+  const auto label_property_indices = disk_label_property_index->ListIndices();
+
+  const uint64_t first_gid = vertex_id_.fetch_add(vertices.size(), std::memory_order_acq_rel);
+  std::vector<Gid> gids;
+  gids.reserve(vertices.size());
+  std::vector<std::pair<std::string, std::string>> vertex_entries;
+  vertex_entries.reserve(vertices.size());
+  std::vector<std::pair<std::string, std::string>> label_index_entries;
+  std::vector<std::pair<std::string, std::string>> label_property_index_entries;
+  for (const auto &vertex : vertices) {
+    const Gid gid = gids.emplace_back(Gid::FromUint(first_gid + gids.size()));
+    PropertyStore properties;
+    properties.InitProperties(vertex.properties);
+    vertex_entries.emplace_back(
+        utils::SerializeLabels(utils::TransformIDsToString(vertex.labels)) + "|" + utils::SerializeIdType(gid),
+        utils::SerializeProperties(properties));
+    for (const LabelId label : label_indices) {
+      if (utils::Contains(vertex.labels, label)) {
+        label_index_entries.emplace_back(utils::SerializeVertexAsKeyForLabelIndex(label, gid),
+                                         utils::SerializeVertexAsValueForLabelIndex(label, vertex.labels, properties));
+      }
+    }
+    for (const auto &[label, property] : label_property_indices) {
+      if (utils::Contains(vertex.labels, label) && properties.HasProperty(property)) {
+        label_property_index_entries.emplace_back(
+            utils::SerializeVertexAsKeyForLabelPropertyIndex(label, property, gid),
+            utils::SerializeVertexAsValueForLabelPropertyIndex(label, vertex.labels, properties));
+      }
+    }
+  }
+
+  const uint64_t timestamp = BulkImportTimestamp();
+  const auto directory = BulkImportDirectory();
+  utils::EnsureDirOrDie(directory);
+  IngestEntries(kvstore_->db_, kvstore_->options_, kvstore_->vertex_chandle, std::move(vertex_entries), timestamp,
+                directory / "vertices.sst");
+  auto *label_index_kvstore = disk_label_index->GetRocksDBStorage();
+  IngestEntries(label_index_kvstore->db_, label_index_kvstore->options_,
+                label_index_kvstore->db_->DefaultColumnFamily(), std::move(label_index_entries), timestamp,
+                directory / "label_index.sst");
+  auto *label_property_index_kvstore = disk_label_property_index->GetRocksDBStorage();
+  IngestEntries(label_property_index_kvstore->db_, label_property_index_kvstore->options_,
+                label_property_index_kvstore->db_->DefaultColumnFamily(), std::move(label_property_index_entries),
+                timestamp, directory / "label_property_index.sst");
+  utils::DeleteDir(directory);
+
+  vertex_count_.fetch_add(vertices.size(), std::memory_order_acq_rel);
+  return gids;
+}
+
+std::vector<Gid> DiskStorage::BulkImportEdges(const std::vector<BulkImportEdge> &edges) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+
+  const uint64_t first_gid = edge_id_.fetch_add(edges.size(), std::memory_order_acq_rel);
+  std::vector<Gid> gids;
+  gids.reserve(edges.size());
+  std::vector<std::pair<std::string, std::string>> edge_entries;
+  edge_entries.reserve(edges.size());
+  std::vector<std::pair<std::string, std::string>> adjacency_entries;
+  adjacency_entries.reserve(2 * edges.size());
+  for (const auto &edge : edges) {
+    const Gid gid = gids.emplace_back(Gid::FromUint(first_gid + gids.size()));
+    std::string value;
+    if (config_.items.properties_on_edges) {
+      PropertyStore properties;
+      properties.InitProperties(edge.properties);
+      value = utils::SerializeProperties(properties);
+    }
+    const DiskEdgeKey disk_edge_key(edge.from, edge.to, edge.edge_type, EdgeRef(gid), /*properties_on_edges=*/false);
+    adjacency_entries.emplace_back(disk_edge_key.GetOutAdjacencyKey(), "");
+    adjacency_entries.emplace_back(disk_edge_key.GetInAdjacencyKey(), "");
+    edge_entries.emplace_back(disk_edge_key.GetSerializedKey(), std::move(value));
+  }
+
+  const uint64_t timestamp = BulkImportTimestamp();
+  const auto directory = BulkImportDirectory();
+  utils::EnsureDirOrDie(directory);
+  IngestEntries(kvstore_->db_, kvstore_->options_, kvstore_->edge_chandle, std::move(edge_entries), timestamp,
+                directory / "edges.sst");
+  IngestEntries(kvstore_->db_, kvstore_->options_, kvstore_->adjacency_chandle, std::move(adjacency_entries),
+                timestamp, directory / "adjacency.sst");
+  utils::DeleteDir(directory);
+
+  edge_count_.fetch_add(edges.size(), std::memory_order_acq_rel);
+  return gids;
 }
 
 DiskStorage::~DiskStorage() {
@@ -302,6 +603,7 @@ DiskStorage::~DiskStorage() {
   durability_kvstore_->Put(edge_count_descr, std::to_string(edge_count_.load(std::memory_order_acquire)));
   logging::AssertRocksDBStatus(kvstore_->db_->DestroyColumnFamilyHandle(kvstore_->vertex_chandle));
   logging::AssertRocksDBStatus(kvstore_->db_->DestroyColumnFamilyHandle(kvstore_->edge_chandle));
+  logging::AssertRocksDBStatus(kvstore_->db_->DestroyColumnFamilyHandle(kvstore_->adjacency_chandle));
   if (kvstore_->default_chandle) {
     // We must destroy default column family handle only if it was read from existing database.
     // https://github.com/facebook/rocksdb/issues/5006#issuecomment-1003154821
@@ -448,7 +750,7 @@ VerticesIterable DiskStorage::DiskAccessor::Vertices(LabelId label, View view) {
 }
 
 std::unordered_set<Gid> DiskStorage::DiskAccessor::MergeVerticesFromMainCacheWithLabelIndexCache(
-    LabelId label, View view, std::list<Delta> &index_deltas, utils::SkipList<Vertex> *indexed_vertices) {
+    LabelId label, View view, utils::ChunkedList<Delta> &index_deltas, utils::SkipList<Vertex> *indexed_vertices) {
   auto main_cache_acc = vertices_.access();
   std::unordered_set<Gid> gids;
   gids.reserve(main_cache_acc.size());
@@ -472,7 +774,7 @@ std::unordered_set<Gid> DiskStorage::DiskAccessor::MergeVerticesFromMainCacheWit
 
 void DiskStorage::DiskAccessor::LoadVerticesFromDiskLabelIndex(LabelId label,
                                                                const std::unordered_set<storage::Gid> &gids,
-                                                               std::list<Delta> &index_deltas,
+                                                               utils::ChunkedList<Delta> &index_deltas,
                                                                utils::SkipList<Vertex> *indexed_vertices) {
   auto *disk_label_index = static_cast<DiskLabelIndex *>(storage_->indices_.label_index_.get());
   auto disk_index_transaction = disk_label_index->CreateRocksDBTransaction();
@@ -528,7 +830,7 @@ VerticesIterable DiskStorage::DiskAccessor::Vertices(LabelId label, PropertyId p
 }
 
 std::unordered_set<Gid> DiskStorage::DiskAccessor::MergeVerticesFromMainCacheWithLabelPropertyIndexCache(
-    LabelId label, PropertyId property, View view, std::list<Delta> &index_deltas,
+    LabelId label, PropertyId property, View view, utils::ChunkedList<Delta> &index_deltas,
     utils::SkipList<Vertex> *indexed_vertices, const auto &label_property_filter) {
   auto main_cache_acc = vertices_.access();
   std::unordered_set<storage::Gid> gids;
@@ -552,7 +854,7 @@ std::unordered_set<Gid> DiskStorage::DiskAccessor::MergeVerticesFromMainCacheWit
 
 void DiskStorage::DiskAccessor::LoadVerticesFromDiskLabelPropertyIndex(LabelId label, PropertyId property,
                                                                        const std::unordered_set<storage::Gid> &gids,
-                                                                       std::list<Delta> &index_deltas,
+                                                                       utils::ChunkedList<Delta> &index_deltas,
                                                                        utils::SkipList<Vertex> *indexed_vertices,
                                                                        const auto &label_property_filter) {
   auto *disk_label_property_index =
@@ -607,7 +909,7 @@ VerticesIterable DiskStorage::DiskAccessor::Vertices(LabelId label, PropertyId p
 
 void DiskStorage::DiskAccessor::LoadVerticesFromDiskLabelPropertyIndexWithPointValueLookup(
     LabelId label, PropertyId property, const std::unordered_set<storage::Gid> &gids, const PropertyValue &value,
-    std::list<Delta> &index_deltas, utils::SkipList<Vertex> *indexed_vertices) {
+    utils::ChunkedList<Delta> &index_deltas, utils::SkipList<Vertex> *indexed_vertices) {
   auto *disk_label_property_index =
       static_cast<DiskLabelPropertyIndex *>(storage_->indices_.label_property_index_.get());
   auto disk_index_transaction = disk_label_property_index->CreateRocksDBTransaction();
@@ -637,6 +939,66 @@ void DiskStorage::DiskAccessor::LoadVerticesFromDiskLabelPropertyIndexWithPointV
   }
 }
 
+VerticesIterable DiskStorage::DiskAccessor::Vertices(LabelId label, PropertyId property,
+                                                     const std::vector<PropertyValue> &values, View view) {
+  index_storage_.emplace_back(std::make_unique<utils::SkipList<storage::Vertex>>());
+  auto &indexed_vertices = index_storage_.back();
+  index_deltas_storage_.emplace_back();
+  auto &index_deltas = index_deltas_storage_.back();
+
+  auto sorted_values = values;
+  std::sort(sorted_values.begin(), sorted_values.end());
+
+  auto label_property_filter = [this, &sorted_values](const Vertex &vertex, LabelId label, PropertyId property,
+                                                      View view) -> bool {
+    if (!VertexHasLabel(vertex, label, &transaction_, view)) return false;
+    const auto value = GetVertexProperty(vertex, property, &transaction_, view);
+    return !value.IsNull() && std::binary_search(sorted_values.begin(), sorted_values.end(), value);
+  };
+
+  const auto gids = MergeVerticesFromMainCacheWithLabelPropertyIndexCache(
+      label, property, view, index_deltas, indexed_vertices.get(), label_property_filter);
+
+  LoadVerticesFromDiskLabelPropertyIndexWithPointValuesLookup(label, property, gids, sorted_values, index_deltas,
+                                                              indexed_vertices.get());
+
+  return VerticesIterable(AllVerticesIterable(indexed_vertices->access(), &transaction_, view, &storage_->indices_,
+                                              &storage_->constraints_, storage_->config_.items));
+}
+
+void DiskStorage::DiskAccessor::LoadVerticesFromDiskLabelPropertyIndexWithPointValuesLookup(
+    LabelId label, PropertyId property, const std::unordered_set<storage::Gid> &gids,
+    const std::vector<PropertyValue> &sorted_values, utils::ChunkedList<Delta> &index_deltas,
+    utils::SkipList<Vertex> *indexed_vertices) {
+  auto *disk_label_property_index =
+      static_cast<DiskLabelPropertyIndex *>(storage_->indices_.label_property_index_.get());
+  auto disk_index_transaction = disk_label_property_index->CreateRocksDBTransaction();
+  disk_index_transaction->SetReadTimestampForValidation(transaction_.start_timestamp);
+  rocksdb::ReadOptions ro;
+  std::string strTs = utils::StringTimestamp(transaction_.start_timestamp);
+  rocksdb::Slice ts(strTs);
+  ro.timestamp = &ts;
+  auto index_it = std::unique_ptr<rocksdb::Iterator>(disk_index_transaction->GetIterator(ro));
+
+  const auto label_property_prefix = utils::SerializeIdType(label) + "|" + utils::SerializeIdType(property);
+  for (index_it->SeekToFirst(); index_it->Valid(); index_it->Next()) {
+    std::string key = index_it->key().ToString();
+    if (!key.starts_with(label_property_prefix)) continue;
+    Gid curr_gid = Gid::FromUint(std::stoull(utils::ExtractGidFromLabelPropertyIndexStorage(key)));
+    if (utils::Contains(gids, curr_gid)) continue;
+    PropertyStore properties = utils::DeserializePropertiesFromLabelPropertyIndexStorage(index_it->value().ToString());
+    const auto value = properties.GetProperty(property);
+    if (!value.IsNull() && std::binary_search(sorted_values.begin(), sorted_values.end(), value)) {
+      // We should pass it->timestamp().ToString() instead of deserializeTimestamp
+      // This is hack until RocksDB will support timestamp() in WBWI iterator
+      LoadVertexToLabelPropertyIndexCache(
+          label, index_it->key().ToString(), index_it->value().ToString(),
+          CreateDeleteDeserializedIndexObjectDelta(&transaction_, index_deltas, key, deserializeTimestamp),
+          indexed_vertices->access());
+    }
+  }
+}
+
 VerticesIterable DiskStorage::DiskAccessor::Vertices(LabelId label, PropertyId property,
                                                      const std::optional<utils::Bound<PropertyValue>> &lower_bound,
                                                      const std::optional<utils::Bound<PropertyValue>> &upper_bound,
@@ -659,7 +1021,7 @@ VerticesIterable DiskStorage::DiskAccessor::Vertices(LabelId label, PropertyId p
 std::unordered_set<Gid>
 DiskStorage::DiskAccessor::MergeVerticesFromMainCacheWithLabelPropertyIndexCacheForIntervalSearch(
     LabelId label, PropertyId property, View view, const std::optional<utils::Bound<PropertyValue>> &lower_bound,
-    const std::optional<utils::Bound<PropertyValue>> &upper_bound, std::list<Delta> &index_deltas,
+    const std::optional<utils::Bound<PropertyValue>> &upper_bound, utils::ChunkedList<Delta> &index_deltas,
     utils::SkipList<Vertex> *indexed_vertices) {
   auto main_cache_acc = vertices_.access();
   std::unordered_set<storage::Gid> gids;
@@ -684,7 +1046,7 @@ DiskStorage::DiskAccessor::MergeVerticesFromMainCacheWithLabelPropertyIndexCache
 void DiskStorage::DiskAccessor::LoadVerticesFromDiskLabelPropertyIndexForIntervalSearch(
     LabelId label, PropertyId property, const std::unordered_set<storage::Gid> &gids,
     const std::optional<utils::Bound<PropertyValue>> &lower_bound,
-    const std::optional<utils::Bound<PropertyValue>> &upper_bound, std::list<Delta> &index_deltas,
+    const std::optional<utils::Bound<PropertyValue>> &upper_bound, utils::ChunkedList<Delta> &index_deltas,
     utils::SkipList<Vertex> *indexed_vertices) {
   auto *disk_label_property_index =
       static_cast<DiskLabelPropertyIndex *>(storage_->indices_.label_property_index_.get());
@@ -824,6 +1186,21 @@ StorageInfo DiskStorage::GetInfo() const {
     average_degree = 2.0 * edge_count / static_cast<double>(vertex_count);
   }
 
+  // The info is requested by the metrics endpoint, so the RocksDB statistics are exported with it.
+  if (const auto &statistics = kvstore_->options_.statistics) {
+    memgraph::metrics::SetGaugeValue(memgraph::metrics::DiskBlockCacheHit,
+                                     statistics->getTickerCount(rocksdb::BLOCK_CACHE_HIT));
+    memgraph::metrics::SetGaugeValue(memgraph::metrics::DiskBlockCacheMiss,
+                                     statistics->getTickerCount(rocksdb::BLOCK_CACHE_MISS));
+    memgraph::metrics::SetGaugeValue(memgraph::metrics::DiskBloomFilterUseful,
+                                     statistics->getTickerCount(rocksdb::BLOOM_FILTER_USEFUL));
+    memgraph::metrics::SetGaugeValue(memgraph::metrics::DiskBytesRead, statistics->getTickerCount(rocksdb::BYTES_READ));
+    memgraph::metrics::SetGaugeValue(memgraph::metrics::DiskBytesWritten,
+                                     statistics->getTickerCount(rocksdb::BYTES_WRITTEN));
+    memgraph::metrics::SetGaugeValue(memgraph::metrics::DiskCompactionBytesWritten,
+                                     statistics->getTickerCount(rocksdb::COMPACT_WRITE_BYTES));
+  }
+
   return {vertex_count, edge_count, average_degree, utils::GetMemoryUsage(), GetDiskSpaceUsage()};
 }
 
@@ -878,19 +1255,25 @@ std::optional<VertexAccessor> DiskStorage::DiskAccessor::FindVertex(storage::Gid
     }
   }
 
+  auto *disk_storage = static_cast<DiskStorage *>(storage_);
+  if (auto cached = disk_storage->vertex_cache_.Find(gid, transaction_.start_timestamp); cached.has_value()) {
+    return LoadVertexToMainMemoryCache(cached->first, cached->second, deserializeTimestamp);
+  }
+
   rocksdb::ReadOptions read_opts;
   auto strTs = utils::StringTimestamp(transaction_.start_timestamp);
   rocksdb::Slice ts(strTs);
   read_opts.timestamp = &ts;
-  auto *disk_storage = static_cast<DiskStorage *>(storage_);
   auto it = std::unique_ptr<rocksdb::Iterator>(
       disk_transaction_->GetIterator(read_opts, disk_storage->kvstore_->vertex_chandle));
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
     std::string key = it->key().ToString();
     if (Gid::FromUint(std::stoull(utils::ExtractGidFromKey(key))) == gid) {
+      std::string value = it->value().ToString();
+      disk_storage->vertex_cache_.Insert(gid, key, value, transaction_.start_timestamp);
       // We should pass it->timestamp().ToString() instead of deserializeTimestamp
       // This is hack until RocksDB will support timestamp() in WBWI iterator
-      return LoadVertexToMainMemoryCache(key, it->value().ToString(), deserializeTimestamp);
+      return LoadVertexToMainMemoryCache(key, value, deserializeTimestamp);
     }
   }
   return std::nullopt;
@@ -924,8 +1307,8 @@ DiskStorage::DiskAccessor::DetachDeleteVertex(VertexAccessor *vertex) {
 
   if (vertex_ptr->deleted) return std::optional<ReturnType>{};
 
-  std::vector<std::tuple<EdgeTypeId, Vertex *, EdgeRef>> in_edges{vertex_ptr->in_edges};
-  std::vector<std::tuple<EdgeTypeId, Vertex *, EdgeRef>> out_edges{vertex_ptr->out_edges};
+  const AdjacencyList in_edges{vertex_ptr->in_edges};
+  const AdjacencyList out_edges{vertex_ptr->out_edges};
 
   std::vector<EdgeAccessor> deleted_edges;
   for (const auto &item : in_edges) {
@@ -1003,16 +1386,28 @@ void DiskStorage::DiskAccessor::PrefetchEdges(const VertexAccessor &vertex_acc,
   rocksdb::Slice ts(strTs);
   read_opts.timestamp = &ts;
   auto *disk_storage = static_cast<DiskStorage *>(storage_);
+  // The adjacency keys of the vertex's edges in one direction are contiguous so only they are visited, instead of
+  // the whole edge column family.
+  const std::string prefix = DiskEdgeKey::AdjacencyPrefix(vertex_acc.Gid(), edge_direction);
   auto it = std::unique_ptr<rocksdb::Iterator>(
-      disk_transaction_->GetIterator(read_opts, disk_storage->kvstore_->edge_chandle));
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    const rocksdb::Slice &key = it->key();
-    auto keyStr = key.ToStringView();
-    if (PrefetchEdgeFilter(keyStr, vertex_acc, edge_direction)) {
-      // We should pass it->timestamp().ToString() instead of deserializeTimestamp
-      // This is hack until RocksDB will support timestamp() in WBWI iterator
-      DeserializeEdge(key, it->value(), deserializeTimestamp);
+      disk_transaction_->GetIterator(read_opts, disk_storage->kvstore_->adjacency_chandle));
+  std::string value;
+  for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix); it->Next()) {
+    const std::string edge_key = DiskEdgeKey::FromAdjacencyKey(it->key().ToStringView()).GetSerializedKey();
+    if (!PrefetchEdgeFilter(edge_key, vertex_acc, edge_direction)) {
+      continue;
     }
+    const Gid edge_gid = Gid::FromUint(std::stoull(DiskEdgeKey(edge_key).GetEdgeGid()));
+    if (auto cached = disk_storage->edge_cache_.Find(edge_gid, transaction_.start_timestamp); cached.has_value()) {
+      value = std::move(cached->second);
+    } else if (disk_transaction_->Get(read_opts, disk_storage->kvstore_->edge_chandle, edge_key, &value).ok()) {
+      disk_storage->edge_cache_.Insert(edge_gid, edge_key, value, transaction_.start_timestamp);
+    } else {
+      continue;
+    }
+    // We should pass it->timestamp().ToString() instead of deserializeTimestamp
+    // This is hack until RocksDB will support timestamp() in WBWI iterator
+    DeserializeEdge(edge_key, value, deserializeTimestamp);
   }
 }
 
@@ -1024,6 +1419,130 @@ void DiskStorage::DiskAccessor::PrefetchOutEdges(const VertexAccessor &vertex_ac
   PrefetchEdges(vertex_acc, EdgeDirection::OUT);
 }
 
+void DiskStorage::DiskAccessor::PrefetchEdges(const std::vector<VertexAccessor> &vertices,
+                                              EdgeDirection edge_direction) {
+  if (vertices.empty()) return;
+  rocksdb::ReadOptions read_opts;
+  auto strTs = utils::StringTimestamp(transaction_.start_timestamp);
+  rocksdb::Slice ts(strTs);
+  read_opts.timestamp = &ts;
+  auto *disk_storage = static_cast<DiskStorage *>(storage_);
+
+  // The adjacency ranges of the vertices are visited in the key order with one iterator, so the seeks only move
+  // forward.
+  std::vector<std::pair<std::string, const VertexAccessor *>> prefixes;
+  prefixes.reserve(vertices.size());
+  for (const auto &vertex_acc : vertices) {
+    prefixes.emplace_back(DiskEdgeKey::AdjacencyPrefix(vertex_acc.Gid(), edge_direction), &vertex_acc);
+  }
+  std::sort(prefixes.begin(), prefixes.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+  prefixes.erase(std::unique(prefixes.begin(), prefixes.end(),
+                             [](const auto &a, const auto &b) { return a.first == b.first; }),
+                 prefixes.end());
+
+  std::vector<std::string> edge_keys;
+  std::vector<Gid> edge_gids;
+  std::vector<std::optional<std::string>> values;
+  std::set<Gid> vertex_gids;
+  auto it = std::unique_ptr<rocksdb::Iterator>(
+      disk_transaction_->GetIterator(read_opts, disk_storage->kvstore_->adjacency_chandle));
+  for (const auto &[prefix, vertex_acc] : prefixes) {
+    for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix); it->Next()) {
+      std::string edge_key = DiskEdgeKey::FromAdjacencyKey(it->key().ToStringView()).GetSerializedKey();
+      if (!PrefetchEdgeFilter(edge_key, *vertex_acc, edge_direction)) {
+        continue;
+      }
+      const DiskEdgeKey disk_edge_key(edge_key);
+      const Gid edge_gid = Gid::FromUint(std::stoull(disk_edge_key.GetEdgeGid()));
+      vertex_gids.insert(Gid::FromUint(std::stoull(disk_edge_key.GetVertexOutGid())));
+      vertex_gids.insert(Gid::FromUint(std::stoull(disk_edge_key.GetVertexInGid())));
+      if (auto cached = disk_storage->edge_cache_.Find(edge_gid, transaction_.start_timestamp); cached.has_value()) {
+        values.emplace_back(std::move(cached->second));
+      } else {
+        values.emplace_back();
+      }
+      edge_keys.push_back(std::move(edge_key));
+      edge_gids.push_back(edge_gid);
+    }
+  }
+
+  // The edges which aren't cached are read together.
+  std::vector<size_t> missing;
+  std::vector<rocksdb::Slice> missing_keys;
+  for (size_t i = 0; i < edge_keys.size(); ++i) {
+    if (values[i]) continue;
+    missing.push_back(i);
+    missing_keys.emplace_back(edge_keys[i]);
+  }
+  if (!missing.empty()) {
+    std::vector<rocksdb::ColumnFamilyHandle *> column_families(missing_keys.size(),
+                                                                disk_storage->kvstore_->edge_chandle);
+    std::vector<std::string> missing_values;
+    auto statuses = disk_transaction_->MultiGet(read_opts, column_families, missing_keys, &missing_values);
+    for (size_t j = 0; j < missing.size(); ++j) {
+      if (!statuses[j].ok()) continue;
+      const auto i = missing[j];
+      disk_storage->edge_cache_.Insert(edge_gids[i], edge_keys[i], missing_values[j], transaction_.start_timestamp);
+      values[i] = std::move(missing_values[j]);
+    }
+  }
+
+  // The endpoints are loaded before the edges, so that deserializing an edge doesn't look for them one by one.
+  PrefetchVertices(vertex_gids);
+  for (size_t i = 0; i < edge_keys.size(); ++i) {
+    if (!values[i]) continue;
+    // We should pass it->timestamp().ToString() instead of deserializeTimestamp
+    // This is hack until RocksDB will support timestamp() in WBWI iterator
+    DeserializeEdge(edge_keys[i], *values[i], deserializeTimestamp);
+  }
+}
+
+void DiskStorage::DiskAccessor::PrefetchVertices(const std::set<Gid> &gids) {
+  auto *disk_storage = static_cast<DiskStorage *>(storage_);
+  std::set<Gid> missing;
+  auto acc = vertices_.access();
+  for (const auto gid : gids) {
+    if (acc.find(gid) != acc.end()) continue;
+    if (std::any_of(index_storage_.begin(), index_storage_.end(), [gid](const auto &index) {
+          auto index_acc = index->access();
+          return index_acc.find(gid) != index_acc.end();
+        })) {
+      continue;
+    }
+    if (auto cached = disk_storage->vertex_cache_.Find(gid, transaction_.start_timestamp); cached.has_value()) {
+      LoadVertexToMainMemoryCache(cached->first, cached->second, deserializeTimestamp);
+      continue;
+    }
+    missing.insert(gid);
+  }
+  if (missing.empty()) return;
+
+  rocksdb::ReadOptions read_opts;
+  auto strTs = utils::StringTimestamp(transaction_.start_timestamp);
+  rocksdb::Slice ts(strTs);
+  read_opts.timestamp = &ts;
+  auto it = std::unique_ptr<rocksdb::Iterator>(
+      disk_transaction_->GetIterator(read_opts, disk_storage->kvstore_->vertex_chandle));
+  for (it->SeekToFirst(); it->Valid() && !missing.empty(); it->Next()) {
+    std::string key = it->key().ToString();
+    const auto gid = Gid::FromUint(std::stoull(utils::ExtractGidFromKey(key)));
+    if (missing.erase(gid) == 0) continue;
+    std::string value = it->value().ToString();
+    disk_storage->vertex_cache_.Insert(gid, key, value, transaction_.start_timestamp);
+    // We should pass it->timestamp().ToString() instead of deserializeTimestamp
+    // This is hack until RocksDB will support timestamp() in WBWI iterator
+    LoadVertexToMainMemoryCache(key, value, deserializeTimestamp);
+  }
+}
+
+void DiskStorage::DiskAccessor::PrefetchInEdges(const std::vector<VertexAccessor> &vertices) {
+  PrefetchEdges(vertices, EdgeDirection::IN);
+}
+
+void DiskStorage::DiskAccessor::PrefetchOutEdges(const std::vector<VertexAccessor> &vertices) {
+  PrefetchEdges(vertices, EdgeDirection::OUT);
+}
+
 Result<EdgeAccessor> DiskStorage::DiskAccessor::CreateEdgeFromDisk(const VertexAccessor *from, const VertexAccessor *to,
                                                                    EdgeTypeId edge_type, storage::Gid gid,
                                                                    const std::string_view properties,
@@ -1118,15 +1637,9 @@ Result<std::optional<EdgeAccessor>> DiskStorage::DiskAccessor::DeleteEdge(EdgeAc
 
   auto delete_edge_from_storage = [&edge_type, &edge_ref, this](auto *vertex, auto *edges) {
     const std::tuple<EdgeTypeId, Vertex *, EdgeRef> link(edge_type, vertex, edge_ref);
-    auto it = std::find(edges->begin(), edges->end(), link);
-    if (config_.properties_on_edges) {
-      MG_ASSERT(it != edges->end(), "Invalid database state!");
-    } else if (it == edges->end()) {
-      return false;
-    }
-    std::swap(*it, *edges->rbegin());
-    edges->pop_back();
-    return true;
+    const bool removed = edges->erase(link);
+    MG_ASSERT(removed || !config_.properties_on_edges, "Invalid database state!");
+    return removed;
   };
 
   const auto op1 = delete_edge_from_storage(to_vertex, &from_vertex->out_edges);
@@ -1171,6 +1684,7 @@ bool DiskStorage::DiskAccessor::WriteVertexToDisk(const Vertex &vertex) {
   auto status = disk_transaction_->Put(disk_storage->kvstore_->vertex_chandle, utils::SerializeVertex(vertex),
                                        utils::SerializeProperties(vertex.properties));
   if (status.ok()) {
+    written_vertices_.push_back(vertex.gid);
     spdlog::trace("rocksdb: Saved vertex with key {} and ts {}", utils::SerializeVertex(vertex), *commit_timestamp_);
   } else if (status.IsBusy()) {
     spdlog::error("rocksdb: Vertex with key {} and ts {} was changed and committed in another transaction",
@@ -1185,7 +1699,8 @@ bool DiskStorage::DiskAccessor::WriteVertexToDisk(const Vertex &vertex) {
 }
 
 /// TODO: at which storage naming
-bool DiskStorage::DiskAccessor::WriteEdgeToDisk(const EdgeRef edge, const std::string &serializedEdgeKey) {
+bool DiskStorage::DiskAccessor::WriteEdgeToDisk(const EdgeRef edge, const std::string &serializedEdgeKey,
+                                                const bool write_adjacency) {
   MG_ASSERT(commit_timestamp_.has_value(), "Writing vertex to disk but commit timestamp not set.");
   auto *disk_storage = static_cast<DiskStorage *>(storage_);
   rocksdb::Status status;
@@ -1195,7 +1710,15 @@ bool DiskStorage::DiskAccessor::WriteEdgeToDisk(const EdgeRef edge, const std::s
   } else {
     status = disk_transaction_->Put(disk_storage->kvstore_->edge_chandle, serializedEdgeKey, "");
   }
+  const DiskEdgeKey disk_edge_key(serializedEdgeKey);
+  if (status.ok() && write_adjacency) {
+    status = disk_transaction_->Put(disk_storage->kvstore_->adjacency_chandle, disk_edge_key.GetOutAdjacencyKey(), "");
+  }
+  if (status.ok() && write_adjacency) {
+    status = disk_transaction_->Put(disk_storage->kvstore_->adjacency_chandle, disk_edge_key.GetInAdjacencyKey(), "");
+  }
   if (status.ok()) {
+    written_edges_.push_back(Gid::FromUint(std::stoull(disk_edge_key.GetEdgeGid())));
     spdlog::trace("rocksdb: Saved edge with key {} and ts {}", serializedEdgeKey, *commit_timestamp_);
   } else if (status.IsBusy()) {
     spdlog::error("rocksdb: Edge with key {} and ts {} was changed and committed in another transaction",
@@ -1212,6 +1735,7 @@ bool DiskStorage::DiskAccessor::DeleteVertexFromDisk(const std::string &vertex)
   auto *disk_storage = static_cast<DiskStorage *>(storage_);
   auto status = disk_transaction_->Delete(disk_storage->kvstore_->vertex_chandle, vertex);
   if (status.ok()) {
+    written_vertices_.push_back(Gid::FromUint(std::stoull(utils::ExtractGidFromKey(vertex))));
     spdlog::trace("rocksdb: Deleted vertex with key {}", vertex);
   } else if (status.IsBusy()) {
     spdlog::error("rocksdb: Vertex with key {} was changed and committed in another transaction", vertex);
@@ -1225,8 +1749,16 @@ bool DiskStorage::DiskAccessor::DeleteVertexFromDisk(const std::string &vertex)
 
 bool DiskStorage::DiskAccessor::DeleteEdgeFromDisk(const std::string &edge) {
   auto *disk_storage = static_cast<DiskStorage *>(storage_);
+  const DiskEdgeKey disk_edge_key(edge);
   auto status = disk_transaction_->Delete(disk_storage->kvstore_->edge_chandle, edge);
   if (status.ok()) {
+    status = disk_transaction_->Delete(disk_storage->kvstore_->adjacency_chandle, disk_edge_key.GetOutAdjacencyKey());
+  }
+  if (status.ok()) {
+    status = disk_transaction_->Delete(disk_storage->kvstore_->adjacency_chandle, disk_edge_key.GetInAdjacencyKey());
+  }
+  if (status.ok()) {
+    written_edges_.push_back(Gid::FromUint(std::stoull(disk_edge_key.GetEdgeGid())));
     spdlog::trace("rocksdb: Deleted edge with key {}", edge);
   } else if (status.IsBusy()) {
     spdlog::error("rocksdb: Edge with key {} was changed and committed in another transaction", edge);
@@ -1265,6 +1797,8 @@ DiskStorage::DiskAccessor::CheckVertexConstraintsBeforeCommit(
   auto *disk_label_property_index =
       static_cast<DiskLabelPropertyIndex *>(storage_->indices_.label_property_index_.get());
 
+  const bool edge_import_mode = static_cast<DiskStorage *>(storage_)->IsEdgeImportModeActive();
+
   /// TODO: andi I don't like that std::optional is used for checking errors but that's how it was before, refactor!
   for (Vertex &vertex : vertex_acc) {
     if (VertexNeedsToBeSerialized(vertex)) {
@@ -1291,15 +1825,23 @@ DiskStorage::DiskAccessor::CheckVertexConstraintsBeforeCommit(
         return StorageDataManipulationError{SerializationError{}};
       }
 
-      if (!disk_unique_constraints->SyncVertexToUniqueConstraintsStorage(vertex, *commit_timestamp_) ||
-          !disk_label_index->SyncVertexToLabelIndexStorage(vertex, *commit_timestamp_) ||
-          !disk_label_property_index->SyncVertexToLabelPropertyIndexStorage(vertex, *commit_timestamp_)) {
+      if (!disk_unique_constraints->SyncVertexToUniqueConstraintsStorage(vertex, *unique_constraints_transaction_) ||
+          !disk_label_index->SyncVertexToLabelIndexStorage(vertex, *label_index_transaction_) ||
+          !disk_label_property_index->SyncVertexToLabelPropertyIndexStorage(vertex,
+                                                                            *label_property_index_transaction_)) {
         return StorageDataManipulationError{SerializationError{}};
       }
     }
 
-    for (auto &edge_entry : vertex.out_edges) {
+    const auto created_out_edges = edge_import_mode ? CreatedOutEdges(vertex) : std::vector<EdgeRef>{};
+    for (const auto &edge_entry : vertex.out_edges) {
       EdgeRef edge = std::get<2>(edge_entry);
+      // In the edge import mode the unchanged edges aren't rewritten and the adjacency entries of the created ones
+      // are left to the fix-up pass when the mode is deactivated.
+      const bool created_edge = utils::Contains(created_out_edges, edge);
+      if (edge_import_mode && !created_edge && (!config_.properties_on_edges || !EdgeNeedsToBeSerialized(*edge.ptr))) {
+        continue;
+      }
       const DiskEdgeKey src_dest_key(vertex.gid, std::get<1>(edge_entry)->gid, std::get<0>(edge_entry), edge,
                                      config_.properties_on_edges);
 
@@ -1313,7 +1855,7 @@ DiskStorage::DiskAccessor::CheckVertexConstraintsBeforeCommit(
         }
       }
 
-      if (!WriteEdgeToDisk(edge, src_dest_key.GetSerializedKey())) {
+      if (!WriteEdgeToDisk(edge, src_dest_key.GetSerializedKey(), !created_edge || !edge_import_mode)) {
         return StorageDataManipulationError{SerializationError{}};
       }
 
@@ -1323,9 +1865,9 @@ DiskStorage::DiskAccessor::CheckVertexConstraintsBeforeCommit(
 
   for (const auto &[vertex_gid, serialized_vertex_to_delete] : vertices_to_delete_) {
     if (!DeleteVertexFromDisk(serialized_vertex_to_delete) ||
-        !disk_unique_constraints->ClearDeletedVertex(vertex_gid, *commit_timestamp_) ||
-        !disk_label_index->ClearDeletedVertex(vertex_gid, *commit_timestamp_) ||
-        !disk_label_property_index->ClearDeletedVertex(vertex_gid, *commit_timestamp_)) {
+        !disk_unique_constraints->ClearDeletedVertex(vertex_gid, *unique_constraints_transaction_) ||
+        !disk_label_index->ClearDeletedVertex(vertex_gid, *label_index_transaction_) ||
+        !disk_label_property_index->ClearDeletedVertex(vertex_gid, *label_property_index_transaction_)) {
       return StorageDataManipulationError{SerializationError{}};
     }
   }
@@ -1337,10 +1879,11 @@ DiskStorage::DiskAccessor::CheckVertexConstraintsBeforeCommit(
   }
 
   if (!disk_unique_constraints->DeleteVerticesWithRemovedConstraintLabel(transaction_.start_timestamp,
-                                                                         *commit_timestamp_) ||
-      !disk_label_index->DeleteVerticesWithRemovedIndexingLabel(transaction_.start_timestamp, *commit_timestamp_) ||
+                                                                         *unique_constraints_transaction_) ||
+      !disk_label_index->DeleteVerticesWithRemovedIndexingLabel(transaction_.start_timestamp,
+                                                                *label_index_transaction_) ||
       !disk_label_property_index->DeleteVerticesWithRemovedIndexingLabel(transaction_.start_timestamp,
-                                                                         *commit_timestamp_)) {
+                                                                         *label_property_index_transaction_)) {
     return StorageDataManipulationError{SerializationError{}};
   }
 
@@ -1356,9 +1899,29 @@ DiskStorage::DiskAccessor::CheckVertexConstraintsBeforeCommit(
   auto *disk_label_property_index =
       static_cast<DiskLabelPropertyIndex *>(storage_->indices_.label_property_index_.get());
 
+  const bool edge_import_mode = static_cast<DiskStorage *>(storage_)->IsEdgeImportModeActive();
+
   for (const auto &vec : index_storage_) {
     auto vertex_acc = vec->access();
     for (Vertex &vertex : vertex_acc) {
+      // In the edge import mode only the edges the transaction created are written, without their adjacency
+      // entries, and the vertices matched to connect them aren't rewritten.
+      if (edge_import_mode && !VertexNeedsToBeSerialized(vertex)) {
+        const auto created_out_edges = CreatedOutEdges(vertex);
+        for (const auto &edge_entry : vertex.out_edges) {
+          EdgeRef edge = std::get<2>(edge_entry);
+          if (!utils::Contains(created_out_edges, edge)) {
+            continue;
+          }
+          const DiskEdgeKey src_dest_key(vertex.gid, std::get<1>(edge_entry)->gid, std::get<0>(edge_entry), edge,
+                                         config_.properties_on_edges);
+          if (!WriteEdgeToDisk(edge, src_dest_key.GetSerializedKey(), /*write_adjacency=*/false)) {
+            return StorageDataManipulationError{SerializationError{}};
+          }
+        }
+        continue;
+      }
+
       if (auto check_result = CheckVertexConstraintsBeforeCommit(vertex, unique_storage); check_result.HasError()) {
         return check_result.GetError();
       }
@@ -1373,13 +1936,14 @@ DiskStorage::DiskAccessor::CheckVertexConstraintsBeforeCommit(
       }
 
       /// TODO: andi don't ignore the return value
-      if (!disk_unique_constraints->SyncVertexToUniqueConstraintsStorage(vertex, *commit_timestamp_) ||
-          !disk_label_index->SyncVertexToLabelIndexStorage(vertex, *commit_timestamp_) ||
-          !disk_label_property_index->SyncVertexToLabelPropertyIndexStorage(vertex, *commit_timestamp_)) {
+      if (!disk_unique_constraints->SyncVertexToUniqueConstraintsStorage(vertex, *unique_constraints_transaction_) ||
+          !disk_label_index->SyncVertexToLabelIndexStorage(vertex, *label_index_transaction_) ||
+          !disk_label_property_index->SyncVertexToLabelPropertyIndexStorage(vertex,
+                                                                            *label_property_index_transaction_)) {
         return StorageDataManipulationError{SerializationError{}};
       }
 
-      for (auto &edge_entry : vertex.out_edges) {
+      for (const auto &edge_entry : vertex.out_edges) {
         EdgeRef edge = std::get<2>(edge_entry);
         DiskEdgeKey src_dest_key(vertex.gid, std::get<1>(edge_entry)->gid, std::get<0>(edge_entry), edge,
                                  config_.properties_on_edges);
@@ -1455,8 +2019,16 @@ utils::BasicResult<StorageDataManipulationError, void> DiskStorage::DiskAccessor
       std::all_of(transaction_.deltas.begin(), transaction_.deltas.end(),
                   [](const Delta &delta) { return delta.action == Delta::Action::DELETE_DESERIALIZED_OBJECT; })) {
   } else {
-    std::unique_lock<utils::SpinLock> engine_guard(storage_->engine_lock_);
+    std::unique_lock engine_guard(storage_->engine_lock_);
     commit_timestamp_.emplace(disk_storage->CommitTimestamp(desired_commit_timestamp));
+    unique_constraints_transaction_ =
+        static_cast<DiskUniqueConstraints *>(storage_->constraints_.unique_constraints_.get())
+            ->CreateAllReadingRocksDBTransaction();
+    label_index_transaction_ =
+        static_cast<DiskLabelIndex *>(storage_->indices_.label_index_.get())->CreateAllReadingRocksDBTransaction();
+    label_property_index_transaction_ =
+        static_cast<DiskLabelPropertyIndex *>(storage_->indices_.label_property_index_.get())
+            ->CreateAllReadingRocksDBTransaction();
 
     if (auto res = FlushMainMemoryCache(); res.HasError()) {
       Abort();
@@ -1481,12 +2053,47 @@ utils::BasicResult<StorageDataManipulationError, void> DiskStorage::DiskAccessor
     return StorageDataManipulationError{SerializationError{}};
   }
   spdlog::trace("rocksdb: Commit successful");
+  CommitAuxiliaryTransactions();
+  InvalidateObjectCaches();
 
   is_transaction_active_ = false;
 
   return {};
 }
 
+void DiskStorage::DiskAccessor::CommitAuxiliaryTransactions() {
+  for (auto *auxiliary_transaction :
+       {&unique_constraints_transaction_, &label_index_transaction_, &label_property_index_transaction_}) {
+    if (!*auxiliary_transaction) {
+      continue;
+    }
+    logging::AssertRocksDBStatus((*auxiliary_transaction)->SetCommitTimestamp(*commit_timestamp_));
+    logging::AssertRocksDBStatus((*auxiliary_transaction)->Commit());
+    auxiliary_transaction->reset();
+  }
+}
+
+void DiskStorage::DiskAccessor::InvalidateObjectCaches() {
+  if (written_vertices_.empty() && written_edges_.empty()) {
+    return;
+  }
+  auto *disk_storage = static_cast<DiskStorage *>(storage_);
+  /// Transactions that have already started could have read the objects before the commit was written to RocksDB.
+  uint64_t next_start_timestamp = 0;
+  {
+    std::lock_guard guard(storage_->engine_lock_);
+    next_start_timestamp = storage_->timestamp_;
+  }
+  for (const Gid gid : written_vertices_) {
+    disk_storage->vertex_cache_.Invalidate(gid, next_start_timestamp);
+  }
+  for (const Gid gid : written_edges_) {
+    disk_storage->edge_cache_.Invalidate(gid, next_start_timestamp);
+  }
+  written_vertices_.clear();
+  written_edges_.clear();
+}
+
 std::vector<std::pair<std::string, std::string>> DiskStorage::SerializeVerticesForLabelIndex(LabelId label) {
   std::vector<std::pair<std::string, std::string>> vertices_to_be_indexed;
 
@@ -1604,6 +2211,10 @@ void DiskStorage::DiskAccessor::Abort() {
   disk_transaction_->ClearSnapshot();
   delete disk_transaction_;
   disk_transaction_ = nullptr;
+  // Uncommitted writes of the index and constraint storages are rolled back on destruction.
+  unique_constraints_transaction_.reset();
+  label_index_transaction_.reset();
+  label_property_index_transaction_.reset();
   is_transaction_active_ = false;
   UpdateObjectsCountOnAbort();
 }
@@ -1614,9 +2225,15 @@ void DiskStorage::DiskAccessor::FinalizeTransaction() {
   }
 }
 
+utils::BasicResult<StorageDataManipulationError, void> DiskStorage::DiskAccessor::PeriodicCommit() {
+  // The RocksDB transactions of the accessor would have to be recreated
+  // together with the storage transaction.
+  throw utils::NotYetImplemented("Periodic commit with the on-disk storage.");
+}
+
 utils::BasicResult<StorageIndexDefinitionError, void> DiskStorage::CreateIndex(
     LabelId label, const std::optional<uint64_t> /*desired_commit_timestamp*/) {
-  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  std::unique_lock<MainLock> storage_guard(main_lock_);
 
   auto *disk_label_index = static_cast<DiskLabelIndex *>(indices_.label_index_.get());
   if (!disk_label_index->CreateIndex(label, SerializeVerticesForLabelIndex(label))) {
@@ -1635,7 +2252,7 @@ utils::BasicResult<StorageIndexDefinitionError, void> DiskStorage::CreateIndex(
 
 utils::BasicResult<StorageIndexDefinitionError, void> DiskStorage::CreateIndex(
     LabelId label, PropertyId property, const std::optional<uint64_t> /*desired_commit_timestamp*/) {
-  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  std::unique_lock<MainLock> storage_guard(main_lock_);
 
   auto *disk_label_property_index = static_cast<DiskLabelPropertyIndex *>(indices_.label_property_index_.get());
   if (!disk_label_property_index->CreateIndex(label, property,
@@ -1655,7 +2272,7 @@ utils::BasicResult<StorageIndexDefinitionError, void> DiskStorage::CreateIndex(
 
 utils::BasicResult<StorageIndexDefinitionError, void> DiskStorage::DropIndex(
     LabelId label, const std::optional<uint64_t> /*desired_commit_timestamp*/) {
-  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  std::unique_lock<MainLock> storage_guard(main_lock_);
 
   if (!indices_.label_index_->DropIndex(label)) {
     return StorageIndexDefinitionError{IndexDefinitionError{}};
@@ -1673,7 +2290,7 @@ utils::BasicResult<StorageIndexDefinitionError, void> DiskStorage::DropIndex(
 
 utils::BasicResult<StorageIndexDefinitionError, void> DiskStorage::DropIndex(
     LabelId label, PropertyId property, const std::optional<uint64_t> /*desired_commit_timestamp*/) {
-  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  std::unique_lock<MainLock> storage_guard(main_lock_);
 
   if (!indices_.label_property_index_->DropIndex(label, property)) {
     return StorageIndexDefinitionError{IndexDefinitionError{}};
@@ -1691,7 +2308,7 @@ utils::BasicResult<StorageIndexDefinitionError, void> DiskStorage::DropIndex(
 
 utils::BasicResult<StorageExistenceConstraintDefinitionError, void> DiskStorage::CreateExistenceConstraint(
     LabelId label, PropertyId property, const std::optional<uint64_t> /*desired_commit_timestamp*/) {
-  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  std::unique_lock<MainLock> storage_guard(main_lock_);
 
   if (constraints_.existence_constraints_->ConstraintExists(label, property)) {
     return StorageExistenceConstraintDefinitionError{ConstraintDefinitionError{}};
@@ -1726,7 +2343,7 @@ utils::BasicResult<StorageExistenceConstraintDroppingError, void> DiskStorage::D
 utils::BasicResult<StorageUniqueConstraintDefinitionError, UniqueConstraints::CreationStatus>
 DiskStorage::CreateUniqueConstraint(LabelId label, const std::set<PropertyId> &properties,
                                     const std::optional<uint64_t> /*desired_commit_timestamp*/) {
-  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  std::unique_lock<MainLock> storage_guard(main_lock_);
 
   auto *disk_unique_constraints = static_cast<DiskUniqueConstraints *>(constraints_.unique_constraints_.get());
 
@@ -1754,7 +2371,7 @@ DiskStorage::CreateUniqueConstraint(LabelId label, const std::set<PropertyId> &p
 utils::BasicResult<StorageUniqueConstraintDroppingError, UniqueConstraints::DeletionStatus>
 DiskStorage::DropUniqueConstraint(LabelId label, const std::set<PropertyId> &properties,
                                   const std::optional<uint64_t> /*desired_commit_timestamp*/) {
-  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  std::unique_lock<MainLock> storage_guard(main_lock_);
   auto ret = constraints_.unique_constraints_->DropConstraint(label, properties);
   if (ret != UniqueConstraints::DeletionStatus::SUCCESS) {
     return ret;
@@ -1774,7 +2391,7 @@ Transaction DiskStorage::CreateTransaction(IsolationLevel isolation_level, Stora
   uint64_t transaction_id = 0;
   uint64_t start_timestamp = 0;
   {
-    std::lock_guard<utils::SpinLock> guard(engine_lock_);
+    std::lock_guard guard(engine_lock_);
     transaction_id = transaction_id_++;
     /// TODO: when we introduce replication to the disk storage, take care of start_timestamp
     start_timestamp = timestamp_++;
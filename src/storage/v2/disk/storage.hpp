@@ -13,6 +13,7 @@
 
 #include "kvstore/kvstore.hpp"
 #include "storage/v2/constraints/constraint_violation.hpp"
+#include "storage/v2/disk/object_cache.hpp"
 #include "storage/v2/disk/rocksdb_storage.hpp"
 #include "storage/v2/id_types.hpp"
 #include "storage/v2/isolation_level.hpp"
@@ -23,6 +24,8 @@
 
 #include <rocksdb/db.h>
 #include <rocksdb/slice.h>
+#include <map>
+#include <set>
 #include <unordered_set>
 
 namespace memgraph::storage {
@@ -62,21 +65,21 @@ class DiskStorage final : public Storage {
     VerticesIterable Vertices(LabelId label, View view) override;
 
     std::unordered_set<Gid> MergeVerticesFromMainCacheWithLabelIndexCache(LabelId label, View view,
-                                                                          std::list<Delta> &index_deltas,
+                                                                          utils::ChunkedList<Delta> &index_deltas,
                                                                           utils::SkipList<Vertex> *indexed_vertices);
 
     void LoadVerticesFromDiskLabelIndex(LabelId label, const std::unordered_set<storage::Gid> &gids,
-                                        std::list<Delta> &index_deltas, utils::SkipList<Vertex> *indexed_vertices);
+                                        utils::ChunkedList<Delta> &index_deltas, utils::SkipList<Vertex> *indexed_vertices);
 
     VerticesIterable Vertices(LabelId label, PropertyId property, View view) override;
 
     std::unordered_set<Gid> MergeVerticesFromMainCacheWithLabelPropertyIndexCache(
-        LabelId label, PropertyId property, View view, std::list<Delta> &index_deltas,
+        LabelId label, PropertyId property, View view, utils::ChunkedList<Delta> &index_deltas,
         utils::SkipList<Vertex> *indexed_vertices, const auto &label_property_filter);
 
     void LoadVerticesFromDiskLabelPropertyIndex(LabelId label, PropertyId property,
                                                 const std::unordered_set<storage::Gid> &gids,
-                                                std::list<Delta> &index_deltas,
+                                                utils::ChunkedList<Delta> &index_deltas,
                                                 utils::SkipList<Vertex> *indexed_vertices,
                                                 const auto &label_property_filter);
 
@@ -85,22 +88,54 @@ class DiskStorage final : public Storage {
     void LoadVerticesFromDiskLabelPropertyIndexWithPointValueLookup(LabelId label, PropertyId property,
                                                                     const std::unordered_set<storage::Gid> &gids,
                                                                     const PropertyValue &value,
-                                                                    std::list<Delta> &index_deltas,
+                                                                    utils::ChunkedList<Delta> &index_deltas,
                                                                     utils::SkipList<Vertex> *indexed_vertices);
 
+    VerticesIterable Vertices(LabelId label, PropertyId property, const std::vector<PropertyValue> &values,
+                              View view) override;
+
+    void LoadVerticesFromDiskLabelPropertyIndexWithPointValuesLookup(LabelId label, PropertyId property,
+                                                                     const std::unordered_set<storage::Gid> &gids,
+                                                                     const std::vector<PropertyValue> &sorted_values,
+                                                                     utils::ChunkedList<Delta> &index_deltas,
+                                                                     utils::SkipList<Vertex> *indexed_vertices);
+
     VerticesIterable Vertices(LabelId label, PropertyId property,
                               const std::optional<utils::Bound<PropertyValue>> &lower_bound,
                               const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view) override;
 
+    VerticesIterable Vertices(LabelId /*label*/, const std::vector<PropertyId> & /*properties*/,
+                              const std::vector<PropertyValue> & /*prefix*/,
+                              const std::optional<utils::Bound<PropertyValue>> & /*lower_bound*/,
+                              const std::optional<utils::Bound<PropertyValue>> & /*upper_bound*/,
+                              View /*view*/) override {
+      throw utils::NotYetImplemented("Composite label-property indices are not implemented for DiskStorage.");
+    }
+
+    EdgesIterable Edges(EdgeTypeId /*edge_type*/, View /*view*/) override {
+      throw utils::NotYetImplemented("Edge-type indices are not implemented for DiskStorage.");
+    }
+
+    EdgesIterable Edges(EdgeTypeId /*edge_type*/, PropertyId /*property*/, const PropertyValue & /*value*/,
+                        View /*view*/) override {
+      throw utils::NotYetImplemented("Edge-type+property indices are not implemented for DiskStorage.");
+    }
+
+    EdgesIterable Edges(EdgeTypeId /*edge_type*/, PropertyId /*property*/,
+                        const std::optional<utils::Bound<PropertyValue>> & /*lower_bound*/,
+                        const std::optional<utils::Bound<PropertyValue>> & /*upper_bound*/, View /*view*/) override {
+      throw utils::NotYetImplemented("Edge-type+property indices are not implemented for DiskStorage.");
+    }
+
     std::unordered_set<Gid> MergeVerticesFromMainCacheWithLabelPropertyIndexCacheForIntervalSearch(
         LabelId label, PropertyId property, View view, const std::optional<utils::Bound<PropertyValue>> &lower_bound,
-        const std::optional<utils::Bound<PropertyValue>> &upper_bound, std::list<Delta> &index_deltas,
+        const std::optional<utils::Bound<PropertyValue>> &upper_bound, utils::ChunkedList<Delta> &index_deltas,
         utils::SkipList<Vertex> *indexed_vertices);
 
     void LoadVerticesFromDiskLabelPropertyIndexForIntervalSearch(
         LabelId label, PropertyId property, const std::unordered_set<storage::Gid> &gids,
         const std::optional<utils::Bound<PropertyValue>> &lower_bound,
-        const std::optional<utils::Bound<PropertyValue>> &upper_bound, std::list<Delta> &index_deltas,
+        const std::optional<utils::Bound<PropertyValue>> &upper_bound, utils::ChunkedList<Delta> &index_deltas,
         utils::SkipList<Vertex> *indexed_vertices);
 
     uint64_t ApproximateVertexCount() const override;
@@ -120,6 +155,33 @@ class DiskStorage final : public Storage {
       return 10;
     }
 
+    uint64_t ApproximateVertexCount(LabelId /*label*/,
+                                    const std::vector<PropertyId> & /*properties*/) const override {
+      return 10;
+    }
+
+    uint64_t ApproximateEdgeCount(EdgeTypeId /*edge_type*/) const override { return 10; }
+
+    uint64_t ApproximateEdgeCount(EdgeTypeId /*edge_type*/, PropertyId /*property*/) const override { return 10; }
+
+    uint64_t ApproximateEdgeCount(EdgeTypeId /*edge_type*/, PropertyId /*property*/,
+                                  const PropertyValue & /*value*/) const override {
+      return 10;
+    }
+
+    uint64_t ApproximateEdgeCount(EdgeTypeId /*edge_type*/, PropertyId /*property*/,
+                                  const std::optional<utils::Bound<PropertyValue>> & /*lower*/,
+                                  const std::optional<utils::Bound<PropertyValue>> & /*upper*/) const override {
+      return 10;
+    }
+
+    uint64_t ApproximateVertexCount(LabelId /*label*/, const std::vector<PropertyId> & /*properties*/,
+                                    const std::vector<PropertyValue> & /*prefix*/,
+                                    const std::optional<utils::Bound<PropertyValue>> & /*lower*/,
+                                    const std::optional<utils::Bound<PropertyValue>> & /*upper*/) const override {
+      return 10;
+    }
+
     std::optional<storage::LabelIndexStats> GetIndexStats(const storage::LabelId & /*label*/) const override {
       return {};
     }
@@ -165,6 +227,10 @@ class DiskStorage final : public Storage {
 
     void PrefetchOutEdges(const VertexAccessor &vertex_acc) override;
 
+    void PrefetchInEdges(const std::vector<VertexAccessor> &vertices) override;
+
+    void PrefetchOutEdges(const std::vector<VertexAccessor> &vertices) override;
+
     Result<EdgeAccessor> CreateEdge(VertexAccessor *from, VertexAccessor *to, EdgeTypeId edge_type) override;
 
     Result<std::optional<EdgeAccessor>> DeleteEdge(EdgeAccessor *edge) override;
@@ -179,6 +245,42 @@ class DiskStorage final : public Storage {
       return disk_storage->indices_.label_property_index_->IndexExists(label, property);
     }
 
+    bool LabelPropertyCompositeIndexExists(LabelId /*label*/,
+                                           const std::vector<PropertyId> & /*properties*/) const override {
+      return false;
+    }
+
+    bool EdgeTypeIndexExists(EdgeTypeId /*edge_type*/) const override { return false; }
+
+    bool EdgeTypePropertyIndexExists(EdgeTypeId /*edge_type*/, PropertyId /*property*/) const override {
+      return false;
+    }
+
+    bool TextIndexExists(LabelId /*label*/, PropertyId /*property*/) const override { return false; }
+
+    std::vector<TextSearchResult> TextSearch(LabelId /*label*/, PropertyId /*property*/, std::string_view /*query*/,
+                                             uint64_t /*limit*/, View /*view*/) override {
+      throw utils::NotYetImplemented("Text indices are not implemented for DiskStorage.");
+    }
+
+    bool VectorIndexExists(LabelId /*label*/, PropertyId /*property*/) const override { return false; }
+
+    std::optional<std::vector<VectorSearchResult>> VectorSearch(LabelId /*label*/, PropertyId /*property*/,
+                                                                std::span<const float> /*query*/, uint64_t /*k*/,
+                                                                View /*view*/) override {
+      throw utils::NotYetImplemented("Vector indices are not implemented for DiskStorage.");
+    }
+
+    bool AggregateIndexExists(LabelId /*label*/, PropertyId /*group_property*/,
+                              PropertyId /*value_property*/) const override {
+      return false;
+    }
+
+    std::optional<std::vector<AggregateGroup>> AggregateIndexLookup(LabelId /*label*/, PropertyId /*group_property*/,
+                                                                    PropertyId /*value_property*/) override {
+      return std::nullopt;
+    }
+
     IndicesInfo ListAllIndices() const override {
       auto *disk_storage = static_cast<DiskStorage *>(storage_);
       return disk_storage->ListAllIndices();
@@ -199,6 +301,8 @@ class DiskStorage final : public Storage {
 
     void FinalizeTransaction() override;
 
+    utils::BasicResult<StorageDataManipulationError, void> PeriodicCommit() override;
+
     std::optional<storage::VertexAccessor> LoadVertexToLabelIndexCache(
         LabelId indexing_label, std::string &&key, std::string &&value, Delta *index_delta,
         utils::SkipList<storage::Vertex>::Accessor index_accessor);
@@ -221,6 +325,12 @@ class DiskStorage final : public Storage {
                             EdgeDirection edge_direction);
     void PrefetchEdges(const VertexAccessor &vertex_acc, EdgeDirection edge_direction);
 
+    void PrefetchEdges(const std::vector<VertexAccessor> &vertices, EdgeDirection edge_direction);
+
+    /// Loads the vertices which aren't in memory yet, looking for all of those
+    /// which aren't cached in one pass over the vertices on disk.
+    void PrefetchVertices(const std::set<Gid> &gids);
+
     Result<EdgeAccessor> CreateEdgeFromDisk(const VertexAccessor *from, const VertexAccessor *to, EdgeTypeId edge_type,
                                             storage::Gid gid, std::string_view properties,
                                             const std::string &old_disk_key, const std::string &ts);
@@ -235,22 +345,35 @@ class DiskStorage final : public Storage {
         const Vertex &vertex, std::vector<std::vector<PropertyValue>> &unique_storage) const;
 
     bool WriteVertexToDisk(const Vertex &vertex);
-    bool WriteEdgeToDisk(EdgeRef edge, const std::string &serializedEdgeKey);
+    bool WriteEdgeToDisk(EdgeRef edge, const std::string &serializedEdgeKey, bool write_adjacency = true);
     bool DeleteVertexFromDisk(const std::string &vertex);
     bool DeleteEdgeFromDisk(const std::string &edge);
 
+    /// Removes the vertices and edges written by the committed transaction from the shared object caches.
+    void InvalidateObjectCaches();
+
+    /// Commits the transactions of the index and constraint storages after the main storage transaction.
+    void CommitAuxiliaryTransactions();
+
     /// Main storage
     utils::SkipList<storage::Vertex> vertices_;
     std::vector<std::unique_ptr<utils::SkipList<storage::Vertex>>> index_storage_;
 
     /// We need them because query context for indexed reading is cleared after the query is done not after the
     /// transaction is done
-    std::vector<std::list<Delta>> index_deltas_storage_;
+    std::vector<utils::ChunkedList<Delta>> index_deltas_storage_;
     utils::SkipList<storage::Edge> edges_;
     Config::Items config_;
     std::unordered_set<std::string> edges_to_delete_;
     std::vector<std::pair<std::string, std::string>> vertices_to_delete_;
+    /// Gids of the vertices and edges written to the disk during the commit
+    std::vector<Gid> written_vertices_;
+    std::vector<Gid> written_edges_;
     rocksdb::Transaction *disk_transaction_;
+    /// All index and constraint writes of a commit go into one transaction per storage instead of one per vertex.
+    std::unique_ptr<rocksdb::Transaction> unique_constraints_transaction_;
+    std::unique_ptr<rocksdb::Transaction> label_index_transaction_;
+    std::unique_ptr<rocksdb::Transaction> label_property_index_transaction_;
     bool scanned_all_vertices_ = false;
   };
 
@@ -264,18 +387,114 @@ class DiskStorage final : public Storage {
 
   RocksDBStorage *GetRocksDBStorage() const { return kvstore_.get(); }
 
+  struct BulkImportVertex {
+    std::vector<LabelId> labels;
+    std::map<PropertyId, PropertyValue> properties;
+  };
+
+  struct BulkImportEdge {
+    Gid from;
+    Gid to;
+    EdgeTypeId edge_type;
+    std::map<PropertyId, PropertyValue> properties;
+  };
+
+  /// Imports the vertices bypassing transactions: the vertices and their label and label-property index entries are
+  /// sorted in memory, written into SST files and ingested into RocksDB. A large dataset should be imported in
+  /// batches that fit into memory, each batch becomes its own SST files which RocksDB compaction merges later.
+  /// Concurrent transactions are blocked during the import.
+  /// @return gids of the imported vertices in the order of the given vertices or a violated existence constraint
+  /// @throw utils::NotYetImplemented if there are unique constraints since they can't be checked without reading
+  utils::BasicResult<StorageDataManipulationError, std::vector<Gid>> BulkImportVertices(
+      const std::vector<BulkImportVertex> &vertices);
+
+  /// Imports the edges the same way as BulkImportVertices. The edge endpoints must be committed or imported vertices,
+  /// they aren't checked.
+  std::vector<Gid> BulkImportEdges(const std::vector<BulkImportEdge> &edges);
+
+  /// In the edge import mode the commits write the created edges into the edge column family without their adjacency
+  /// entries and without rewriting the endpoint vertices or their other edges. Expansions don't see the imported
+  /// edges, and deleting their endpoints with DETACH DELETE doesn't delete them, until the mode is deactivated, which
+  /// fills the adjacency column family from the edges in one pass. The mode is persisted, a storage closed in it
+  /// fixes up the adjacency and deactivates it when it's opened. Waits for the active transactions to finish.
+  void SetEdgeImportMode(bool active);
+
+  bool IsEdgeImportModeActive() const { return edge_import_mode_active_.load(std::memory_order_acquire); }
+
   utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(
       LabelId label, std::optional<uint64_t> desired_commit_timestamp) override;
 
   utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(
       LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp) override;
 
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(
+      LabelId /*label*/, const std::vector<PropertyId> & /*properties*/,
+      std::optional<uint64_t> /*desired_commit_timestamp*/) override {
+    throw utils::NotYetImplemented("Composite label-property indices are not implemented for DiskStorage.");
+  }
+
   utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(
       LabelId label, std::optional<uint64_t> desired_commit_timestamp) override;
 
   utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(
       LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp) override;
 
+  utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(
+      LabelId /*label*/, const std::vector<PropertyId> & /*properties*/,
+      std::optional<uint64_t> /*desired_commit_timestamp*/) override {
+    throw utils::NotYetImplemented("Composite label-property indices are not implemented for DiskStorage.");
+  }
+
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(EdgeTypeId /*edge_type*/) override {
+    throw utils::NotYetImplemented("Edge-type indices are not implemented for DiskStorage.");
+  }
+
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(EdgeTypeId /*edge_type*/,
+                                                                    PropertyId /*property*/) override {
+    throw utils::NotYetImplemented("Edge-type+property indices are not implemented for DiskStorage.");
+  }
+
+  utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(EdgeTypeId /*edge_type*/) override {
+    throw utils::NotYetImplemented("Edge-type indices are not implemented for DiskStorage.");
+  }
+
+  utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(EdgeTypeId /*edge_type*/,
+                                                                  PropertyId /*property*/) override {
+    throw utils::NotYetImplemented("Edge-type+property indices are not implemented for DiskStorage.");
+  }
+
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateTextIndex(
+      LabelId /*label*/, PropertyId /*property*/, std::optional<uint64_t> /*desired_commit_timestamp*/) override {
+    throw utils::NotYetImplemented("Text indices are not implemented for DiskStorage.");
+  }
+
+  utils::BasicResult<StorageIndexDefinitionError, void> DropTextIndex(
+      LabelId /*label*/, PropertyId /*property*/, std::optional<uint64_t> /*desired_commit_timestamp*/) override {
+    throw utils::NotYetImplemented("Text indices are not implemented for DiskStorage.");
+  }
+
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateVectorIndex(
+      LabelId /*label*/, PropertyId /*property*/, std::optional<uint64_t> /*desired_commit_timestamp*/) override {
+    throw utils::NotYetImplemented("Vector indices are not implemented for DiskStorage.");
+  }
+
+  utils::BasicResult<StorageIndexDefinitionError, void> DropVectorIndex(
+      LabelId /*label*/, PropertyId /*property*/, std::optional<uint64_t> /*desired_commit_timestamp*/) override {
+    throw utils::NotYetImplemented("Vector indices are not implemented for DiskStorage.");
+  }
+
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateAggregateIndex(
+      LabelId /*label*/, PropertyId /*group_property*/, PropertyId /*value_property*/,
+      std::optional<uint64_t> /*desired_commit_timestamp*/) override {
+    throw utils::NotYetImplemented("Aggregate indices are not implemented for DiskStorage.");
+  }
+
+  utils::BasicResult<StorageIndexDefinitionError, void> DropAggregateIndex(
+      LabelId /*label*/, PropertyId /*group_property*/, PropertyId /*value_property*/,
+      std::optional<uint64_t> /*desired_commit_timestamp*/) override {
+    throw utils::NotYetImplemented("Aggregate indices are not implemented for DiskStorage.");
+  }
+
   utils::BasicResult<StorageExistenceConstraintDefinitionError, void> CreateExistenceConstraint(
       LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp) override;
 
@@ -324,6 +543,17 @@ class DiskStorage final : public Storage {
 
   void LoadVertexAndEdgeCountIfExists();
 
+  /// Fills the adjacency column family from the edge column family.
+  void BuildAdjacencyFromEdges();
+
+  /// Ingests the adjacency entries of all edges in the edge column family, in batches of SST files.
+  void IngestAdjacencyFromEdges();
+
+  /// Directory for the SST files of a bulk import, removed after the files are ingested.
+  std::filesystem::path BulkImportDirectory() const;
+
+  uint64_t BulkImportTimestamp();
+
   [[nodiscard]] std::optional<ConstraintViolation> CheckExistingVerticesBeforeCreatingExistenceConstraint(
       LabelId label, PropertyId property) const;
 
@@ -337,7 +567,9 @@ class DiskStorage final : public Storage {
 
   StorageInfo GetInfo() const override;
 
-  void FreeMemory(std::unique_lock<utils::RWLock> /*lock*/) override {}
+  void FreeMemory(std::unique_lock<MainLock> /*lock*/) override {}
+
+  void RebuildAggregateIndices() override {}
 
   uint64_t CommitTimestamp(std::optional<uint64_t> desired_commit_timestamp = {});
 
@@ -357,7 +589,10 @@ class DiskStorage final : public Storage {
  private:
   std::unique_ptr<RocksDBStorage> kvstore_;
   std::unique_ptr<kvstore::KVStore> durability_kvstore_;
+  DiskObjectCache vertex_cache_;
+  DiskObjectCache edge_cache_;
   std::atomic<uint64_t> vertex_count_{0};
+  std::atomic<bool> edge_import_mode_active_{false};
 };
 
 }  // namespace memgraph::storage
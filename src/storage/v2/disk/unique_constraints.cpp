@@ -61,6 +61,7 @@ DiskUniqueConstraints::DiskUniqueConstraints(const Config &config) {
   utils::EnsureDirOrDie(config.disk.unique_constraints_directory);
   kvstore_->options_.create_if_missing = true;
   kvstore_->options_.comparator = new ComparatorWithU64TsImpl();
+  kvstore_->options_.enable_pipelined_write = config.disk.pipelined_write;
   logging::AssertRocksDBStatus(rocksdb::TransactionDB::Open(kvstore_->options_, rocksdb::TransactionDBOptions(),
                                                             config.disk.unique_constraints_directory, &kvstore_->db_));
 }
@@ -147,79 +148,50 @@ bool DiskUniqueConstraints::VertexIsUnique(const std::vector<PropertyValue> &pro
 }
 
 bool DiskUniqueConstraints::ClearDeletedVertex(const std::string_view gid,
-                                               uint64_t transaction_commit_timestamp) const {
-  auto disk_transaction = std::unique_ptr<rocksdb::Transaction>(
-      kvstore_->db_->BeginTransaction(rocksdb::WriteOptions(), rocksdb::TransactionOptions()));
-  disk_transaction->SetReadTimestampForValidation(std::numeric_limits<uint64_t>::max());
-
+                                               rocksdb::Transaction &disk_transaction) const {
   rocksdb::ReadOptions ro;
   std::string strTs = utils::StringTimestamp(std::numeric_limits<uint64_t>::max());
   rocksdb::Slice ts(strTs);
   ro.timestamp = &ts;
-  auto it = std::unique_ptr<rocksdb::Iterator>(disk_transaction->GetIterator(ro));
+  auto it = std::unique_ptr<rocksdb::Iterator>(disk_transaction.GetIterator(ro));
 
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
     if (std::string key = it->key().ToString(); gid == utils::ExtractGidFromUniqueConstraintStorage(key)) {
-      if (!disk_transaction->Delete(key).ok()) {
+      if (!disk_transaction.Delete(key).ok()) {
         return false;
       }
     }
   }
-  disk_transaction->SetCommitTimestamp(transaction_commit_timestamp);
-  auto status = disk_transaction->Commit();
-  if (!status.ok()) {
-    spdlog::error("rocksdb: {}", status.getState());
-  }
-  return status.ok();
+  return true;
 }
 
 bool DiskUniqueConstraints::DeleteVerticesWithRemovedConstraintLabel(uint64_t transaction_start_timestamp,
-                                                                     uint64_t transaction_commit_timestamp) {
+                                                                     rocksdb::Transaction &disk_transaction) {
   if (entries_for_deletion->empty()) {
     return true;
   }
 
-  auto disk_transaction = std::unique_ptr<rocksdb::Transaction>(
-      kvstore_->db_->BeginTransaction(rocksdb::WriteOptions(), rocksdb::TransactionOptions()));
-  disk_transaction->SetReadTimestampForValidation(std::numeric_limits<uint64_t>::max());
-
-  rocksdb::ReadOptions ro;
-  std::string strTs = utils::StringTimestamp(std::numeric_limits<uint64_t>::max());
-  rocksdb::Slice ts(strTs);
-  ro.timestamp = &ts;
-
   bool deletion_success = true;
   entries_for_deletion.WithLock([&deletion_success, transaction_start_timestamp,
-                                 disk_transaction_ptr = disk_transaction.get()](auto &tx_to_entries_for_deletion) {
+                                 disk_transaction_ptr = &disk_transaction](auto &tx_to_entries_for_deletion) {
     if (auto tx_it = tx_to_entries_for_deletion.find(transaction_start_timestamp);
         tx_it != tx_to_entries_for_deletion.end()) {
       deletion_success = ClearTransactionEntriesWithRemovedConstraintLabel(*disk_transaction_ptr, tx_it->second);
       tx_to_entries_for_deletion.erase(tx_it);
     }
   });
-  if (deletion_success) {
-    /// TODO: Extract to some useful method
-    disk_transaction->SetCommitTimestamp(transaction_commit_timestamp);
-    auto status = disk_transaction->Commit();
-    if (!status.ok()) {
-      spdlog::error("rocksdb: {}", status.getState());
-    }
-    return status.ok();
+  if (!deletion_success) {
+    spdlog::error("Deletion of vertices with removed constraint label failed.");
   }
-  spdlog::error("Deletion of vertices with removed constraint label failed.");
-  return false;
+  return deletion_success;
 }
 
 bool DiskUniqueConstraints::SyncVertexToUniqueConstraintsStorage(const Vertex &vertex,
-                                                                 uint64_t commit_timestamp) const {
-  /// TODO: create method for writing transaction
-  auto disk_transaction = std::unique_ptr<rocksdb::Transaction>(
-      kvstore_->db_->BeginTransaction(rocksdb::WriteOptions(), rocksdb::TransactionOptions()));
-
+                                                                 rocksdb::Transaction &disk_transaction) const {
   if (auto maybe_old_disk_key = utils::GetOldDiskKeyOrNull(vertex.delta); maybe_old_disk_key.has_value()) {
     spdlog::trace("Found old disk key {} for vertex {}", maybe_old_disk_key.value(),
                   utils::SerializeIdType(vertex.gid));
-    if (auto status = disk_transaction->Delete(maybe_old_disk_key.value()); !status.ok()) {
+    if (auto status = disk_transaction.Delete(maybe_old_disk_key.value()); !status.ok()) {
       return false;
     }
   }
@@ -229,18 +201,19 @@ bool DiskUniqueConstraints::SyncVertexToUniqueConstraintsStorage(const Vertex &v
       auto key = utils::SerializeVertexAsKeyForUniqueConstraint(constraint_label, constraint_properties,
                                                                 utils::SerializeIdType(vertex.gid));
       auto value = utils::SerializeVertexAsValueForUniqueConstraint(constraint_label, vertex.labels, vertex.properties);
-      if (!disk_transaction->Put(key, value).ok()) {
+      if (!disk_transaction.Put(key, value).ok()) {
         return false;
       }
     }
   }
-  /// TODO: extract and better message
-  disk_transaction->SetCommitTimestamp(commit_timestamp);
-  auto status = disk_transaction->Commit();
-  if (!status.ok()) {
-    spdlog::error("rocksdb: {}", status.getState());
-  }
-  return status.ok();
+  return true;
+}
+
+std::unique_ptr<rocksdb::Transaction> DiskUniqueConstraints::CreateAllReadingRocksDBTransaction() const {
+  auto disk_transaction = std::unique_ptr<rocksdb::Transaction>(
+      kvstore_->db_->BeginTransaction(rocksdb::WriteOptions(), rocksdb::TransactionOptions()));
+  disk_transaction->SetReadTimestampForValidation(std::numeric_limits<uint64_t>::max());
+  return disk_transaction;
 }
 
 DiskUniqueConstraints::CreationStatus DiskUniqueConstraints::CheckIfConstraintCanBeCreated(
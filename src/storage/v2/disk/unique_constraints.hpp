@@ -35,12 +35,17 @@ class DiskUniqueConstraints : public UniqueConstraints {
   std::optional<ConstraintViolation> Validate(const Vertex &vertex,
                                               std::vector<std::vector<PropertyValue>> &unique_storage) const;
 
-  [[nodiscard]] bool ClearDeletedVertex(std::string_view gid, uint64_t transaction_commit_timestamp) const;
+  /// The following methods only write into the given transaction of the constraints storage, it is committed
+  /// together with the transaction of the main storage.
+  [[nodiscard]] bool ClearDeletedVertex(std::string_view gid, rocksdb::Transaction &disk_transaction) const;
 
   [[nodiscard]] bool DeleteVerticesWithRemovedConstraintLabel(uint64_t transaction_start_timestamp,
-                                                              uint64_t transaction_commit_timestamp);
+                                                              rocksdb::Transaction &disk_transaction);
 
-  [[nodiscard]] bool SyncVertexToUniqueConstraintsStorage(const Vertex &vertex, uint64_t commit_timestamp) const;
+  [[nodiscard]] bool SyncVertexToUniqueConstraintsStorage(const Vertex &vertex,
+                                                          rocksdb::Transaction &disk_transaction) const;
+
+  std::unique_ptr<rocksdb::Transaction> CreateAllReadingRocksDBTransaction() const;
 
   DeletionStatus DropConstraint(LabelId label, const std::set<PropertyId> &properties) override;
 
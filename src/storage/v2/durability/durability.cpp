@@ -20,6 +20,8 @@
 #include <cstring>
 
 #include <algorithm>
+#include <limits>
+#include <thread>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -27,9 +29,14 @@
 #include "storage/v2/durability/paths.hpp"
 #include "storage/v2/durability/snapshot.hpp"
 #include "storage/v2/durability/wal.hpp"
+#include "storage/v2/inmemory/aggregate_index.hpp"
 #include "storage/v2/inmemory/label_index.hpp"
+#include "storage/v2/inmemory/label_property_composite_index.hpp"
 #include "storage/v2/inmemory/label_property_index.hpp"
+#include "storage/v2/inmemory/text_index.hpp"
 #include "storage/v2/inmemory/unique_constraints.hpp"
+#include "storage/v2/inmemory/vector_index.hpp"
+#include "utils/event_counter.hpp"
 #include "utils/event_histogram.hpp"
 #include "utils/logging.hpp"
 #include "utils/memory_tracker.hpp"
@@ -38,6 +45,8 @@
 
 namespace memgraph::metrics {
 extern const Event SnapshotRecoveryLatency_us;
+extern const Event WalRecoveryLatency_us;
+extern const Event WalDeltasRecovered;
 }  // namespace memgraph::metrics
 
 namespace memgraph::storage::durability {
@@ -135,8 +144,11 @@ void RecoverIndicesAndConstraints(const RecoveredIndicesAndConstraints &indices_
   spdlog::info("Recreating {} label indices from metadata.", indices_constraints.indices.label.size());
   for (const auto &item : indices_constraints.indices.label) {
     auto *mem_label_index = static_cast<InMemoryLabelIndex *>(indices->label_index_.get());
-    if (!mem_label_index->CreateIndex(item, vertices->access(), parallel_exec_info))
+    if (indices_constraints.indices.populated) {
+      if (!mem_label_index->PublishIndex(item)) throw RecoveryFailure("The label index must be populated here!");
+    } else if (!mem_label_index->CreateIndex(item, vertices->access(), parallel_exec_info)) {
       throw RecoveryFailure("The label index must be created here!");
+    }
 
     spdlog::info("A label index is recreated from metadata.");
   }
@@ -147,11 +159,59 @@ void RecoverIndicesAndConstraints(const RecoveredIndicesAndConstraints &indices_
                indices_constraints.indices.label_property.size());
   auto *mem_label_property_index = static_cast<InMemoryLabelPropertyIndex *>(indices->label_property_index_.get());
   for (const auto &item : indices_constraints.indices.label_property) {
-    if (!mem_label_property_index->CreateIndex(item.first, item.second, vertices->access(), parallel_exec_info))
+    if (indices_constraints.indices.populated) {
+      if (!mem_label_property_index->PublishIndex(item.first, item.second)) {
+        throw RecoveryFailure("The label+property index must be populated here!");
+      }
+    } else if (!mem_label_property_index->CreateIndex(item.first, item.second, vertices->access(),
+                                                      parallel_exec_info)) {
       throw RecoveryFailure("The label+property index must be created here!");
+    }
     spdlog::info("A label+property index is recreated from metadata.");
   }
   spdlog::info("Label+property indices are recreated.");
+
+  // Recover composite label+property indices.
+  spdlog::info("Recreating {} composite label+property indices from metadata.",
+               indices_constraints.indices.label_property_composite.size());
+  auto *mem_label_property_composite_index =
+      static_cast<InMemoryLabelPropertyCompositeIndex *>(indices->label_property_composite_index_.get());
+  for (const auto &item : indices_constraints.indices.label_property_composite) {
+    if (!mem_label_property_composite_index->CreateIndex(item.first, item.second, vertices->access()))
+      throw RecoveryFailure("The composite label+property index must be created here!");
+    spdlog::info("A composite label+property index is recreated from metadata.");
+  }
+  spdlog::info("Composite label+property indices are recreated.");
+
+  // Recover text indices.
+  spdlog::info("Recreating {} text indices from metadata.", indices_constraints.indices.text.size());
+  auto *mem_text_index = static_cast<InMemoryTextIndex *>(indices->text_index_.get());
+  for (const auto &item : indices_constraints.indices.text) {
+    if (!mem_text_index->CreateIndex(item.first, item.second, vertices->access()))
+      throw RecoveryFailure("The text index must be created here!");
+    spdlog::info("A text index is recreated from metadata.");
+  }
+  spdlog::info("Text indices are recreated.");
+
+  // Recover vector indices.
+  spdlog::info("Recreating {} vector indices from metadata.", indices_constraints.indices.vector.size());
+  auto *mem_vector_index = static_cast<InMemoryVectorIndex *>(indices->vector_index_.get());
+  for (const auto &item : indices_constraints.indices.vector) {
+    if (!mem_vector_index->CreateIndex(item.first, item.second, vertices->access()))
+      throw RecoveryFailure("The vector index must be created here!");
+    spdlog::info("A vector index is recreated from metadata.");
+  }
+  spdlog::info("Vector indices are recreated.");
+
+  // Recover aggregate indices.
+  spdlog::info("Recreating {} aggregate indices from metadata.", indices_constraints.indices.aggregate.size());
+  auto *mem_aggregate_index = static_cast<InMemoryAggregateIndex *>(indices->aggregate_index_.get());
+  for (const auto &item : indices_constraints.indices.aggregate) {
+    if (!mem_aggregate_index->CreateIndex(item, vertices->access()))
+      throw RecoveryFailure("The aggregate index must be created here!");
+    spdlog::info("An aggregate index is recreated from metadata.");
+  }
+  spdlog::info("Aggregate indices are recreated.");
   spdlog::info("Indices are recreated.");
 
   spdlog::info("Recreating constraints from metadata.");
@@ -186,6 +246,46 @@ void RecoverIndicesAndConstraints(const RecoveredIndicesAndConstraints &indices_
   spdlog::info("Constraints are recreated from metadata.");
 }
 
+namespace {
+
+// Deltas of a WAL file read ahead of applying them, or the reason why they
+// couldn't be read.
+struct ReadAheadWal {
+  std::optional<WalDeltas> deltas;
+  std::string error;
+};
+
+// Reads the deltas of up to `thread_count` WAL files starting at `first`, each
+// of them on its own thread. Each file is read as if all of the files before
+// it were already loaded.
+std::vector<ReadAheadWal> ReadWalsInParallel(const std::vector<WalDurabilityInfo> &wal_files, size_t first,
+                                             uint64_t thread_count, std::optional<uint64_t> last_loaded_timestamp) {
+  const auto count = std::min<size_t>(std::max<uint64_t>(thread_count, 1), wal_files.size() - first);
+  std::vector<ReadAheadWal> ret(count);
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      threads.emplace_back([&wal_file = wal_files[first + i], &result = ret[i], last_loaded_timestamp]() {
+        try {
+          result.deltas = ReadWalDeltas(wal_file.path, last_loaded_timestamp);
+        } catch (const RecoveryFailure &e) {
+          result.error = e.what();
+        }
+      });
+      // A file that has any newer deltas than the already loaded ones is loaded
+      // up to its last delta.
+      const auto to_timestamp = wal_files[first + i].to_timestamp;
+      if (!last_loaded_timestamp || to_timestamp > *last_loaded_timestamp) {
+        last_loaded_timestamp = to_timestamp;
+      }
+    }
+  }
+  return ret;
+}
+
+}  // namespace
+
 std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_directory,
                                         const std::filesystem::path &wal_directory, std::string *uuid,
                                         std::string *epoch_id,
@@ -217,16 +317,34 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
 
     // UUID used for durability is the UUID of the last snapshot file.
     *uuid = snapshot_files.back().uuid;
+    // The indices can only be populated while the snapshot is loaded if no WAL
+    // deltas are applied on top of it, because the WAL recovery doesn't keep
+    // the indices up to date.
+    std::optional<uint64_t> last_wal_timestamp;
+    if (config.durability.allow_parallel_index_creation && utils::DirExists(wal_directory)) {
+      auto wal_files = GetWalFiles(wal_directory, *uuid);
+      if (!wal_files) {
+        last_wal_timestamp = std::numeric_limits<uint64_t>::max();
+      } else {
+        for (const auto &wal_file : *wal_files) {
+          last_wal_timestamp = std::max(last_wal_timestamp.value_or(0), wal_file.to_timestamp);
+        }
+      }
+    }
     std::optional<RecoveredSnapshot> recovered_snapshot;
     for (auto it = snapshot_files.rbegin(); it != snapshot_files.rend(); ++it) {
-      const auto &[path, file_uuid, _] = *it;
+      const auto &[path, file_uuid, start_timestamp] = *it;
       if (file_uuid != *uuid) {
         spdlog::warn("The snapshot file {} isn't related to the latest snapshot file!", path);
         continue;
       }
       spdlog::info("Starting snapshot recovery from {}.", path);
       try {
-        recovered_snapshot = LoadSnapshot(path, vertices, edges, epoch_history, name_id_mapper, edge_count, config);
+        const bool populate_indices = config.durability.allow_parallel_index_creation &&
+                                      (!last_wal_timestamp || *last_wal_timestamp <= start_timestamp);
+        auto *populated_indices = populate_indices ? indices : nullptr;
+        recovered_snapshot = LoadSnapshot(path, vertices, edges, epoch_history, name_id_mapper, edge_count, config,
+                                          populated_indices);
         spdlog::info("Snapshot recovery successful!");
         break;
       } catch (const RecoveryFailure &e) {
@@ -336,7 +454,14 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
     std::optional<uint64_t> previous_seq_num;
     auto last_loaded_timestamp = snapshot_timestamp;
     spdlog::info("Trying to load WAL files.");
-    for (auto &wal_file : wal_files) {
+    utils::Timer wal_timer;
+    uint64_t wal_deltas_recovered = 0;
+    // With parallel WAL recovery the files are read in groups ahead of
+    // applying them, `read_ahead[i]` belongs to `wal_files[read_ahead_first + i]`.
+    std::vector<ReadAheadWal> read_ahead;
+    size_t read_ahead_first = 0;
+    for (size_t wal_index = 0; wal_index < wal_files.size(); ++wal_index) {
+      auto &wal_file = wal_files[wal_index];
       if (previous_seq_num && (wal_file.seq_num - *previous_seq_num) > 1) {
         LOG_FATAL("You are missing a WAL file with the sequence number {}!", *previous_seq_num + 1);
       }
@@ -353,8 +478,23 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
         *epoch_id = std::move(wal_file.epoch_id);
       }
       try {
-        auto info = LoadWal(wal_file.path, &indices_constraints, last_loaded_timestamp, vertices, edges, name_id_mapper,
-                            edge_count, config.items);
+        RecoveryInfo info;
+        if (config.durability.allow_parallel_wal_recovery) {
+          if (wal_index >= read_ahead_first + read_ahead.size()) {
+            read_ahead = ReadWalsInParallel(wal_files, wal_index, config.durability.recovery_thread_count,
+                                            last_loaded_timestamp);
+            read_ahead_first = wal_index;
+          }
+          auto &read = read_ahead[wal_index - read_ahead_first];
+          if (!read.deltas) throw RecoveryFailure(read.error);
+          info = ApplyWalDeltas(*read.deltas, &indices_constraints, vertices, edges, name_id_mapper, edge_count,
+                                config.items, config.durability.recovery_thread_count);
+          wal_deltas_recovered += read.deltas->deltas.size();
+          read.deltas.reset();
+        } else {
+          info = LoadWal(wal_file.path, &indices_constraints, last_loaded_timestamp, vertices, edges, name_id_mapper,
+                         edge_count, config.items);
+        }
         recovery_info.next_vertex_id = std::max(recovery_info.next_vertex_id, info.next_vertex_id);
         recovery_info.next_edge_id = std::max(recovery_info.next_edge_id, info.next_edge_id);
         recovery_info.next_timestamp = std::max(recovery_info.next_timestamp, info.next_timestamp);
@@ -372,6 +512,9 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
     // load any deltas from that file.
     *wal_seq_num = *previous_seq_num + 1;
 
+    memgraph::metrics::Measure(memgraph::metrics::WalRecoveryLatency_us,
+                               std::chrono::duration_cast<std::chrono::microseconds>(wal_timer.Elapsed()).count());
+    memgraph::metrics::IncrementCounter(memgraph::metrics::WalDeltasRecovered, wal_deltas_recovered);
     spdlog::info("All necessary WAL files are loaded successfully.");
   }
 
@@ -56,6 +56,14 @@ enum class Marker : uint8_t {
   DELTA_EXISTENCE_CONSTRAINT_DROP = 0x5e,
   DELTA_UNIQUE_CONSTRAINT_CREATE = 0x5f,
   DELTA_UNIQUE_CONSTRAINT_DROP = 0x60,
+  DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_CREATE = 0x61,
+  DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_DROP = 0x62,
+  DELTA_TEXT_INDEX_CREATE = 0x63,
+  DELTA_TEXT_INDEX_DROP = 0x64,
+  DELTA_VECTOR_INDEX_CREATE = 0x65,
+  DELTA_VECTOR_INDEX_DROP = 0x66,
+  DELTA_AGGREGATE_INDEX_CREATE = 0x67,
+  DELTA_AGGREGATE_INDEX_DROP = 0x68,
 
   VALUE_FALSE = 0x00,
   VALUE_TRUE = 0xff,
@@ -99,6 +107,14 @@ static const Marker kMarkersAll[] = {
     Marker::DELTA_EXISTENCE_CONSTRAINT_DROP,
     Marker::DELTA_UNIQUE_CONSTRAINT_CREATE,
     Marker::DELTA_UNIQUE_CONSTRAINT_DROP,
+    Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_CREATE,
+    Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_DROP,
+    Marker::DELTA_TEXT_INDEX_CREATE,
+    Marker::DELTA_TEXT_INDEX_DROP,
+    Marker::DELTA_VECTOR_INDEX_CREATE,
+    Marker::DELTA_VECTOR_INDEX_DROP,
+    Marker::DELTA_AGGREGATE_INDEX_CREATE,
+    Marker::DELTA_AGGREGATE_INDEX_DROP,
     Marker::VALUE_FALSE,
     Marker::VALUE_TRUE,
 };
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <optional>
 #include <set>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -39,6 +40,15 @@ struct RecoveredIndicesAndConstraints {
   struct {
     std::vector<LabelId> label;
     std::vector<std::pair<LabelId, PropertyId>> label_property;
+    std::vector<std::pair<LabelId, std::vector<PropertyId>>> label_property_composite;
+    std::vector<std::pair<LabelId, PropertyId>> text;
+    std::vector<std::pair<LabelId, PropertyId>> vector;
+    // The label, the group property and the value property.
+    std::vector<std::tuple<LabelId, PropertyId, PropertyId>> aggregate;
+    // Set if the label and label+property indices were registered and
+    // populated while the vertices were loaded, so they only have to be
+    // published.
+    bool populated{false};
   } indices;
 
   struct {
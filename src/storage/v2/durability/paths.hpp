@@ -20,9 +20,11 @@ namespace memgraph::storage::durability {
 
 static const std::string kSnapshotDirectory{"snapshots"};
 static const std::string kWalDirectory{"wal"};
+static const std::string kWalSegmentsDirectory{".segments"};
 static const std::string kBackupDirectory{".backup"};
 static const std::string kLockFile{".lock"};
 static const std::string kReplicationDirectory{"replication"};
+static const std::string kColdValuesDirectory{"cold_property_values"};
 
 // This is the prefix used for Snapshot and WAL filenames. It is a timestamp
 // format that equals to: YYYYmmddHHMMSSffffff
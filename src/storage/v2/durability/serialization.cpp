@@ -11,8 +11,13 @@
 
 #include "storage/v2/durability/serialization.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 #include "storage/v2/temporal.hpp"
+#include "utils/compressor.hpp"
 #include "utils/endian.hpp"
+#include "utils/logging.hpp"
 
 namespace memgraph::storage::durability {
 
@@ -21,122 +26,214 @@ namespace memgraph::storage::durability {
 //////////////////////////
 
 namespace {
-void WriteSize(Encoder *encoder, uint64_t size) {
+// The format is shared by `Encoder` and `BufferEncoder`, which only differ in
+// where `Write` puts the data.
+template <typename TEncoder>
+void WriteSize(TEncoder *encoder, uint64_t size) {
   size = utils::HostToLittleEndian(size);
   encoder->Write(reinterpret_cast<const uint8_t *>(&size), sizeof(size));
 }
-}  // namespace
-
-void Encoder::Initialize(const std::filesystem::path &path, const std::string_view magic, uint64_t version) {
-  file_.Open(path, utils::OutputFile::Mode::OVERWRITE_EXISTING);
-  Write(reinterpret_cast<const uint8_t *>(magic.data()), magic.size());
-  auto version_encoded = utils::HostToLittleEndian(version);
-  Write(reinterpret_cast<const uint8_t *>(&version_encoded), sizeof(version_encoded));
-}
-
-void Encoder::OpenExisting(const std::filesystem::path &path) {
-  file_.Open(path, utils::OutputFile::Mode::APPEND_TO_EXISTING);
-}
-
-void Encoder::Close() {
-  if (file_.IsOpen()) {
-    file_.Close();
-  }
-}
-
-void Encoder::Write(const uint8_t *data, uint64_t size) { file_.Write(data, size); }
 
-void Encoder::WriteMarker(Marker marker) {
+template <typename TEncoder>
+void WriteMarkerTo(TEncoder *encoder, Marker marker) {
   auto value = static_cast<uint8_t>(marker);
-  Write(&value, sizeof(value));
+  encoder->Write(&value, sizeof(value));
 }
 
-void Encoder::WriteBool(bool value) {
-  WriteMarker(Marker::TYPE_BOOL);
+template <typename TEncoder>
+void WriteBoolTo(TEncoder *encoder, bool value) {
+  encoder->WriteMarker(Marker::TYPE_BOOL);
   if (value) {
-    WriteMarker(Marker::VALUE_TRUE);
+    encoder->WriteMarker(Marker::VALUE_TRUE);
   } else {
-    WriteMarker(Marker::VALUE_FALSE);
+    encoder->WriteMarker(Marker::VALUE_FALSE);
   }
 }
 
-void Encoder::WriteUint(uint64_t value) {
+template <typename TEncoder>
+void WriteUintTo(TEncoder *encoder, uint64_t value) {
   value = utils::HostToLittleEndian(value);
-  WriteMarker(Marker::TYPE_INT);
-  Write(reinterpret_cast<const uint8_t *>(&value), sizeof(value));
+  encoder->WriteMarker(Marker::TYPE_INT);
+  encoder->Write(reinterpret_cast<const uint8_t *>(&value), sizeof(value));
 }
 
-void Encoder::WriteDouble(double value) {
+template <typename TEncoder>
+void WriteDoubleTo(TEncoder *encoder, double value) {
   auto value_uint = utils::MemcpyCast<uint64_t>(value);
   value_uint = utils::HostToLittleEndian(value_uint);
-  WriteMarker(Marker::TYPE_DOUBLE);
-  Write(reinterpret_cast<const uint8_t *>(&value_uint), sizeof(value_uint));
+  encoder->WriteMarker(Marker::TYPE_DOUBLE);
+  encoder->Write(reinterpret_cast<const uint8_t *>(&value_uint), sizeof(value_uint));
 }
 
-void Encoder::WriteString(const std::string_view value) {
-  WriteMarker(Marker::TYPE_STRING);
-  WriteSize(this, value.size());
-  Write(reinterpret_cast<const uint8_t *>(value.data()), value.size());
+template <typename TEncoder>
+void WriteStringTo(TEncoder *encoder, const std::string_view value) {
+  encoder->WriteMarker(Marker::TYPE_STRING);
+  WriteSize(encoder, value.size());
+  encoder->Write(reinterpret_cast<const uint8_t *>(value.data()), value.size());
 }
 
-void Encoder::WritePropertyValue(const PropertyValue &value) {
-  WriteMarker(Marker::TYPE_PROPERTY_VALUE);
+template <typename TEncoder>
+void WritePropertyValueTo(TEncoder *encoder, const PropertyValue &value) {
+  encoder->WriteMarker(Marker::TYPE_PROPERTY_VALUE);
   switch (value.type()) {
     case PropertyValue::Type::Null: {
-      WriteMarker(Marker::TYPE_NULL);
+      encoder->WriteMarker(Marker::TYPE_NULL);
       break;
     }
     case PropertyValue::Type::Bool: {
-      WriteBool(value.ValueBool());
+      encoder->WriteBool(value.ValueBool());
       break;
     }
     case PropertyValue::Type::Int: {
-      WriteUint(utils::MemcpyCast<uint64_t>(value.ValueInt()));
+      encoder->WriteUint(utils::MemcpyCast<uint64_t>(value.ValueInt()));
       break;
     }
     case PropertyValue::Type::Double: {
-      WriteDouble(value.ValueDouble());
+      encoder->WriteDouble(value.ValueDouble());
       break;
     }
     case PropertyValue::Type::String: {
-      WriteString(value.ValueString());
+      encoder->WriteString(value.ValueString());
       break;
     }
     case PropertyValue::Type::List: {
       const auto &list = value.ValueList();
-      WriteMarker(Marker::TYPE_LIST);
-      WriteSize(this, list.size());
+      encoder->WriteMarker(Marker::TYPE_LIST);
+      WriteSize(encoder, list.size());
       for (const auto &item : list) {
-        WritePropertyValue(item);
+        encoder->WritePropertyValue(item);
       }
       break;
     }
     case PropertyValue::Type::Map: {
       const auto &map = value.ValueMap();
-      WriteMarker(Marker::TYPE_MAP);
-      WriteSize(this, map.size());
+      encoder->WriteMarker(Marker::TYPE_MAP);
+      WriteSize(encoder, map.size());
       for (const auto &item : map) {
-        WriteString(item.first);
-        WritePropertyValue(item.second);
+        encoder->WriteString(item.first);
+        encoder->WritePropertyValue(item.second);
       }
       break;
     }
     case PropertyValue::Type::TemporalData: {
       const auto temporal_data = value.ValueTemporalData();
-      WriteMarker(Marker::TYPE_TEMPORAL_DATA);
-      WriteUint(static_cast<uint64_t>(temporal_data.type));
-      WriteUint(utils::MemcpyCast<uint64_t>(temporal_data.microseconds));
+      encoder->WriteMarker(Marker::TYPE_TEMPORAL_DATA);
+      encoder->WriteUint(static_cast<uint64_t>(temporal_data.type));
+      encoder->WriteUint(utils::MemcpyCast<uint64_t>(temporal_data.microseconds));
       break;
     }
   }
 }
+}  // namespace
 
-uint64_t Encoder::GetPosition() { return file_.GetPosition(); }
+void Encoder::Initialize(const std::filesystem::path &path, const std::string_view magic, uint64_t version) {
+  file_.Open(path, utils::OutputFile::Mode::OVERWRITE_EXISTING);
+  compressed_.reset();
+  Write(reinterpret_cast<const uint8_t *>(magic.data()), magic.size());
+  auto version_encoded = utils::HostToLittleEndian(version);
+  Write(reinterpret_cast<const uint8_t *>(&version_encoded), sizeof(version_encoded));
+}
+
+void Encoder::Initialize(const std::filesystem::path &path) {
+  file_.Open(path, utils::OutputFile::Mode::OVERWRITE_EXISTING);
+}
 
-void Encoder::SetPosition(uint64_t position) { file_.SetPosition(utils::OutputFile::Position::SET, position); }
+void Encoder::OpenExisting(const std::filesystem::path &path) {
+  file_.Open(path, utils::OutputFile::Mode::APPEND_TO_EXISTING);
+}
+
+void Encoder::Close() {
+  if (file_.IsOpen()) {
+    file_.Close();
+  }
+}
+
+void Encoder::Write(const uint8_t *data, uint64_t size) {
+  if (!compressed_) {
+    file_.Write(data, size);
+    return;
+  }
+  auto &buffer = compressed_->buffer;
+  while (size > 0) {
+    const auto to_copy = std::min(size, compressed_->block_size - buffer.size());
+    buffer.insert(buffer.end(), data, data + to_copy);
+    data += to_copy;
+    size -= to_copy;
+    if (buffer.size() == compressed_->block_size) WriteCompressedBlock();
+  }
+}
+
+void Encoder::WriteCompressedBlock() {
+  auto &buffer = compressed_->buffer;
+  auto block = utils::CompressBuffer(buffer.data(), buffer.size());
+  MG_ASSERT(block, "Couldn't compress a block of {} bytes!", buffer.size());
+  compressed_->blocks.emplace_back(file_.GetPosition(), block->size());
+  file_.Write(block->data(), block->size());
+  buffer.clear();
+}
+
+void Encoder::EnableBlockCompression(uint64_t block_size) {
+  MG_ASSERT(!compressed_ && block_size > 0, "Invalid block compression setup!");
+  compressed_.emplace();
+  compressed_->begin = file_.GetPosition();
+  compressed_->block_size = block_size;
+  compressed_->buffer.reserve(block_size);
+}
+
+uint64_t Encoder::FinishBlockCompression() {
+  MG_ASSERT(compressed_, "Block compression isn't enabled!");
+  // Only the last block can be smaller than `block_size`.
+  const auto end = GetPosition();
+  if (!compressed_->buffer.empty()) WriteCompressedBlock();
+  auto compressed = std::move(*compressed_);
+  compressed_.reset();
+
+  const auto offset = file_.GetPosition();
+  WriteUint(compressed.begin);
+  WriteUint(compressed.block_size);
+  WriteUint(end);
+  WriteUint(compressed.blocks.size());
+  for (const auto &[block_offset, block_size] : compressed.blocks) {
+    WriteUint(block_offset);
+    WriteUint(block_size);
+  }
+  return offset;
+}
+
+void Encoder::WriteMarker(Marker marker) { WriteMarkerTo(this, marker); }
+
+void Encoder::WriteBool(bool value) { WriteBoolTo(this, value); }
+
+void Encoder::WriteUint(uint64_t value) { WriteUintTo(this, value); }
+
+void Encoder::WriteDouble(double value) { WriteDoubleTo(this, value); }
+
+void Encoder::WriteString(const std::string_view value) { WriteStringTo(this, value); }
+
+void Encoder::WritePropertyValue(const PropertyValue &value) { WritePropertyValueTo(this, value); }
+
+uint64_t Encoder::GetPosition() {
+  if (compressed_) {
+    return compressed_->begin + (compressed_->blocks.size() * compressed_->block_size) + compressed_->buffer.size();
+  }
+  return file_.GetPosition();
+}
+
+void Encoder::SetPosition(uint64_t position) {
+  MG_ASSERT(!compressed_, "Can't change the position while writing compressed blocks!");
+  file_.SetPosition(utils::OutputFile::Position::SET, position);
+}
 
 void Encoder::Sync() { file_.Sync(); }
 
+bool Encoder::Preallocate(uint64_t size) { return file_.Preallocate(size); }
+
+void Encoder::EnableWriteback() { file_.EnableWriteback(); }
+
+void Encoder::SetRateLimiter(utils::RateLimiter *rate_limiter) { file_.SetRateLimiter(rate_limiter); }
+
+int Encoder::FlushAndDuplicateDescriptor() { return file_.FlushAndDuplicateDescriptor(); }
+
 void Encoder::Finalize() {
   file_.Sync();
   file_.Close();
@@ -152,6 +249,24 @@ std::pair<const uint8_t *, size_t> Encoder::CurrentFileBuffer() const { return f
 
 size_t Encoder::GetSize() { return file_.GetSize(); }
 
+////////////////////////////////
+// BufferEncoder implementation.
+////////////////////////////////
+
+void BufferEncoder::Write(const uint8_t *data, uint64_t size) { buffer_.insert(buffer_.end(), data, data + size); }
+
+void BufferEncoder::WriteMarker(Marker marker) { WriteMarkerTo(this, marker); }
+
+void BufferEncoder::WriteBool(bool value) { WriteBoolTo(this, value); }
+
+void BufferEncoder::WriteUint(uint64_t value) { WriteUintTo(this, value); }
+
+void BufferEncoder::WriteDouble(double value) { WriteDoubleTo(this, value); }
+
+void BufferEncoder::WriteString(const std::string_view value) { WriteStringTo(this, value); }
+
+void BufferEncoder::WritePropertyValue(const PropertyValue &value) { WritePropertyValueTo(this, value); }
+
 //////////////////////////
 // Decoder implementation.
 //////////////////////////
@@ -174,8 +289,10 @@ std::optional<uint64_t> ReadSize(Decoder *decoder) {
 }
 }  // namespace
 
-std::optional<uint64_t> Decoder::Initialize(const std::filesystem::path &path, const std::string &magic) {
-  if (!file_.Open(path)) return std::nullopt;
+std::optional<uint64_t> Decoder::Initialize(const std::filesystem::path &path, const std::string &magic,
+                                            bool memory_mapped) {
+  compressed_.reset();
+  if (!file_.Open(path, memory_mapped)) return std::nullopt;
   std::string file_magic(magic.size(), '\0');
   if (!Read(reinterpret_cast<uint8_t *>(file_magic.data()), file_magic.size())) return std::nullopt;
   if (file_magic != magic) return std::nullopt;
@@ -184,9 +301,86 @@ std::optional<uint64_t> Decoder::Initialize(const std::filesystem::path &path, c
   return utils::LittleEndianToHost(version_encoded);
 }
 
-bool Decoder::Read(uint8_t *data, size_t size) { return file_.Read(data, size); }
+bool Decoder::Read(uint8_t *data, size_t size) {
+  if (!compressed_) return file_.Read(data, size);
+  if (!Peek(data, size)) return false;
+  compressed_->position += size;
+  return true;
+}
 
-bool Decoder::Peek(uint8_t *data, size_t size) { return file_.Peek(data, size); }
+bool Decoder::Peek(uint8_t *data, size_t size) {
+  if (!compressed_) return file_.Peek(data, size);
+  auto &compressed = *compressed_;
+  if (compressed.position + size > compressed.end) return false;
+  auto position = compressed.position;
+  while (size > 0) {
+    uint64_t to_copy = 0;
+    if (position < compressed.begin) {
+      // The data before the first block isn't compressed.
+      to_copy = std::min<uint64_t>(size, compressed.begin - position);
+      if (!file_.SetPosition(utils::InputFile::Position::SET, static_cast<ssize_t>(position))) return false;
+      if (!file_.Read(data, to_copy)) return false;
+    } else {
+      const auto index = (position - compressed.begin) / compressed.block_size;
+      if (!LoadCompressedBlock(index)) return false;
+      const auto block_offset = position - compressed.begin - (index * compressed.block_size);
+      to_copy = std::min<uint64_t>(size, compressed.loaded_data.size() - block_offset);
+      std::memcpy(data, compressed.loaded_data.data() + block_offset, to_copy);
+    }
+    data += to_copy;
+    size -= to_copy;
+    position += to_copy;
+  }
+  return true;
+}
+
+bool Decoder::LoadCompressedBlock(uint64_t index) {
+  auto &compressed = *compressed_;
+  if (compressed.loaded_block == index) return true;
+  if (index >= compressed.blocks.size()) return false;
+  const auto [block_offset, block_size] = compressed.blocks[index];
+  const auto data_begin = compressed.begin + (index * compressed.block_size);
+  const auto data_size = std::min(compressed.block_size, compressed.end - data_begin);
+
+  std::vector<uint8_t> block(block_size);
+  if (!file_.SetPosition(utils::InputFile::Position::SET, static_cast<ssize_t>(block_offset))) return false;
+  if (!file_.Read(block.data(), block.size())) return false;
+  compressed.loaded_data.resize(data_size);
+  if (!utils::DecompressBuffer(block.data(), block.size(), compressed.loaded_data.data(), data_size)) {
+    compressed.loaded_block.reset();
+    return false;
+  }
+  compressed.loaded_block = index;
+  return true;
+}
+
+bool Decoder::EnableBlockDecompression(uint64_t offset) {
+  if (compressed_) return false;
+  const auto position = file_.GetPosition();
+  if (!file_.SetPosition(utils::InputFile::Position::SET, static_cast<ssize_t>(offset))) return false;
+
+  CompressedBlocks compressed;
+  auto begin = ReadUint();
+  auto block_size = ReadUint();
+  auto end = ReadUint();
+  auto blocks_count = ReadUint();
+  if (!begin || !block_size || !end || !blocks_count) return false;
+  if (*block_size == 0 || *begin > *end || *begin > offset) return false;
+  if (*blocks_count != (*end - *begin + *block_size - 1) / *block_size) return false;
+  compressed.begin = *begin;
+  compressed.block_size = *block_size;
+  compressed.end = *end;
+  compressed.blocks.reserve(*blocks_count);
+  for (uint64_t i = 0; i < *blocks_count; ++i) {
+    auto block_offset = ReadUint();
+    auto block_compressed_size = ReadUint();
+    if (!block_offset || !block_compressed_size) return false;
+    compressed.blocks.emplace_back(*block_offset, *block_compressed_size);
+  }
+  compressed.position = position;
+  compressed_.emplace(std::move(compressed));
+  return true;
+}
 
 std::optional<Marker> Decoder::PeekMarker() {
   uint8_t value;
@@ -350,6 +544,14 @@ std::optional<PropertyValue> Decoder::ReadPropertyValue() {
     case Marker::DELTA_EXISTENCE_CONSTRAINT_DROP:
     case Marker::DELTA_UNIQUE_CONSTRAINT_CREATE:
     case Marker::DELTA_UNIQUE_CONSTRAINT_DROP:
+    case Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+    case Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+    case Marker::DELTA_TEXT_INDEX_CREATE:
+    case Marker::DELTA_TEXT_INDEX_DROP:
+    case Marker::DELTA_VECTOR_INDEX_CREATE:
+    case Marker::DELTA_VECTOR_INDEX_DROP:
+    case Marker::DELTA_AGGREGATE_INDEX_CREATE:
+    case Marker::DELTA_AGGREGATE_INDEX_DROP:
     case Marker::VALUE_FALSE:
     case Marker::VALUE_TRUE:
       return std::nullopt;
@@ -449,16 +651,37 @@ bool Decoder::SkipPropertyValue() {
     case Marker::DELTA_EXISTENCE_CONSTRAINT_DROP:
     case Marker::DELTA_UNIQUE_CONSTRAINT_CREATE:
     case Marker::DELTA_UNIQUE_CONSTRAINT_DROP:
+    case Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+    case Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+    case Marker::DELTA_TEXT_INDEX_CREATE:
+    case Marker::DELTA_TEXT_INDEX_DROP:
+    case Marker::DELTA_VECTOR_INDEX_CREATE:
+    case Marker::DELTA_VECTOR_INDEX_DROP:
+    case Marker::DELTA_AGGREGATE_INDEX_CREATE:
+    case Marker::DELTA_AGGREGATE_INDEX_DROP:
     case Marker::VALUE_FALSE:
     case Marker::VALUE_TRUE:
       return false;
   }
 }
 
-std::optional<uint64_t> Decoder::GetSize() { return file_.GetSize(); }
+std::optional<uint64_t> Decoder::GetSize() {
+  if (compressed_) return compressed_->end;
+  return file_.GetSize();
+}
 
-std::optional<uint64_t> Decoder::GetPosition() { return file_.GetPosition(); }
+std::optional<uint64_t> Decoder::GetPosition() {
+  if (compressed_) return compressed_->position;
+  return file_.GetPosition();
+}
 
-bool Decoder::SetPosition(uint64_t position) { return !!file_.SetPosition(utils::InputFile::Position::SET, position); }
+bool Decoder::SetPosition(uint64_t position) {
+  if (compressed_) {
+    if (position > compressed_->end) return false;
+    compressed_->position = position;
+    return true;
+  }
+  return !!file_.SetPosition(utils::InputFile::Position::SET, position);
+}
 
 }  // namespace memgraph::storage::durability
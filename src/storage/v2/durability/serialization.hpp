@@ -13,7 +13,10 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <optional>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "storage/v2/config.hpp"
 #include "storage/v2/durability/marker.hpp"
@@ -43,6 +46,10 @@ class Encoder final : public BaseEncoder {
  public:
   void Initialize(const std::filesystem::path &path, std::string_view magic, uint64_t version);
 
+  // Opens the file without writing the header, used for data that is later
+  // appended to another file.
+  void Initialize(const std::filesystem::path &path);
+
   void OpenExisting(const std::filesystem::path &path);
 
   void Close();
@@ -62,6 +69,17 @@ class Encoder final : public BaseEncoder {
 
   void Sync();
 
+  // See `utils::OutputFile::Preallocate` and
+  // `utils::OutputFile::EnableWriteback`.
+  bool Preallocate(uint64_t size);
+  void EnableWriteback();
+
+  // See `utils::OutputFile::SetRateLimiter`.
+  void SetRateLimiter(utils::RateLimiter *rate_limiter);
+
+  // See `utils::OutputFile::FlushAndDuplicateDescriptor`.
+  int FlushAndDuplicateDescriptor();
+
   void Finalize();
 
   // Disable flushing of the internal buffer.
@@ -76,8 +94,53 @@ class Encoder final : public BaseEncoder {
   // Get the total size of the current file.
   size_t GetSize();
 
+  // Everything written after this call is compressed in blocks of
+  // `block_size` bytes. Each block is compressed independently so that it can
+  // be decompressed on its own. Positions returned by `GetPosition` stay the
+  // positions of the uncompressed data.
+  void EnableBlockCompression(uint64_t block_size);
+
+  // Compresses the remaining data and writes the table of the compressed
+  // blocks uncompressed after them. Returns the position of the table that has
+  // to be passed to `Decoder::EnableBlockDecompression`. Only the data written
+  // before `EnableBlockCompression` can be overwritten using `SetPosition`
+  // afterwards.
+  uint64_t FinishBlockCompression();
+
  private:
+  void WriteCompressedBlock();
+
+  struct CompressedBlocks {
+    // Position of the uncompressed data where the first block begins.
+    uint64_t begin;
+    uint64_t block_size;
+    // Position in the file and size of each compressed block.
+    std::vector<std::pair<uint64_t, uint64_t>> blocks;
+    std::vector<uint8_t> buffer;
+  };
+
   utils::OutputFile file_;
+  std::optional<CompressedBlocks> compressed_;
+};
+
+/// Encoder that generates the same data as `Encoder` in memory, used to
+/// encode data before it's known where it will be written.
+class BufferEncoder final : public BaseEncoder {
+ public:
+  void Write(const uint8_t *data, uint64_t size);
+
+  void WriteMarker(Marker marker) override;
+  void WriteBool(bool value) override;
+  void WriteUint(uint64_t value) override;
+  void WriteDouble(double value) override;
+  void WriteString(std::string_view value) override;
+  void WritePropertyValue(const PropertyValue &value) override;
+
+  const std::vector<uint8_t> &GetBuffer() const { return buffer_; }
+  std::vector<uint8_t> ReleaseBuffer() { return std::move(buffer_); }
+
+ private:
+  std::vector<uint8_t> buffer_;
 };
 
 /// Decoder interface class. Used to implement streams from different sources
@@ -101,7 +164,9 @@ class BaseDecoder {
 /// Decoder that is used to read a generated snapshot/WAL.
 class Decoder final : public BaseDecoder {
  public:
-  std::optional<uint64_t> Initialize(const std::filesystem::path &path, const std::string &magic);
+  // See `utils::InputFile::Open` for `memory_mapped`.
+  std::optional<uint64_t> Initialize(const std::filesystem::path &path, const std::string &magic,
+                                     bool memory_mapped = false);
 
   // Main read functions, the only one that are allowed to read from the `file_`
   // directly.
@@ -124,8 +189,28 @@ class Decoder final : public BaseDecoder {
   std::optional<uint64_t> GetPosition();
   bool SetPosition(uint64_t position);
 
+  // Reads the table of compressed blocks written by
+  // `Encoder::FinishBlockCompression` at `offset`. Afterwards the decoder
+  // transparently decompresses the blocks it reads from and all positions are
+  // positions of the uncompressed data.
+  bool EnableBlockDecompression(uint64_t offset);
+
  private:
+  bool LoadCompressedBlock(uint64_t index);
+
+  struct CompressedBlocks {
+    uint64_t begin;
+    uint64_t block_size;
+    // Size of the uncompressed data.
+    uint64_t end;
+    std::vector<std::pair<uint64_t, uint64_t>> blocks;
+    uint64_t position;
+    std::optional<uint64_t> loaded_block;
+    std::vector<uint8_t> loaded_data;
+  };
+
   utils::InputFile file_;
+  std::optional<CompressedBlocks> compressed_;
 };
 
 }  // namespace memgraph::storage::durability
@@ -11,7 +11,11 @@
 
 #include "storage/v2/durability/snapshot.hpp"
 
+#include <limits>
+#include <optional>
 #include <thread>
+#include <type_traits>
+#include <unordered_set>
 
 #include "storage/v2/durability/exceptions.hpp"
 #include "storage/v2/durability/paths.hpp"
@@ -22,6 +26,8 @@
 #include "storage/v2/edge_accessor.hpp"
 #include "storage/v2/edge_ref.hpp"
 #include "storage/v2/id_types.hpp"
+#include "storage/v2/inmemory/label_index.hpp"
+#include "storage/v2/inmemory/label_property_index.hpp"
 #include "storage/v2/mvcc.hpp"
 #include "storage/v2/vertex.hpp"
 #include "storage/v2/vertex_accessor.hpp"
@@ -29,9 +35,18 @@
 #include "utils/file.hpp"
 #include "utils/file_locker.hpp"
 #include "utils/logging.hpp"
+#include "utils/event_gauge.hpp"
 #include "utils/message.hpp"
+#include "utils/on_scope_exit.hpp"
 #include "utils/spin_lock.hpp"
 #include "utils/synchronized.hpp"
+#include "utils/thread.hpp"
+#include "utils/tracepoint.hpp"
+
+namespace memgraph::metrics {
+extern const Event SnapshotObjectsToWrite;
+extern const Event SnapshotObjectsWritten;
+}  // namespace memgraph::metrics
 
 namespace memgraph::storage::durability {
 
@@ -51,6 +66,8 @@ namespace memgraph::storage::durability {
 //     * offset to the metadata section
 //     * offset to the offset-count pair of the first edge batch (`0` if properties on edges are disabled)
 //     * offset to the offset-count pair of the first vertex batch
+//     * offset to the table of compressed blocks (`0` if the snapshot isn't
+//       compressed)
 //
 // 4) Encoded edges (if properties on edges are enabled); each edge is written
 //    in the following format:
@@ -76,6 +93,19 @@ namespace memgraph::storage::durability {
 //     * label+property indices
 //         * label
 //         * property
+//     * composite label+property indices (from version 16)
+//         * label
+//         * properties (in the order in which they are indexed)
+//     * text indices (from version 18)
+//         * label
+//         * property
+//     * vector indices (from version 19)
+//         * label
+//         * property
+//     * aggregate indices (from version 20)
+//         * label
+//         * group property
+//         * value property
 //
 // 7) Constraints
 //     * existence constraints
@@ -107,9 +137,32 @@ namespace memgraph::storage::durability {
 //        * starting offset of the batch
 //        * number of vertices in the batch
 //
+// When the snapshot is compressed, everything after the section offsets is
+// stored in independently compressed blocks followed by the table of the
+// blocks (see `Encoder::EnableBlockCompression`). All offsets are offsets of
+// the uncompressed data so the batches can still be read in parallel.
+//
 // IMPORTANT: When changing snapshot encoding/decoding bump the snapshot/WAL
 // version in `version.hpp`.
 
+// Size of the uncompressed data in each compressed block of the snapshot.
+constexpr uint64_t kSnapshotCompressionBlockSize = 1024 * 1024;
+
+// Describes how the partial loaders have to open the snapshot file.
+struct SnapshotReadOptions {
+  bool memory_mapped;
+  uint64_t offset_compressed_blocks;
+};
+
+void OpenSnapshot(Decoder &snapshot, const std::filesystem::path &path, const SnapshotReadOptions &options) {
+  if (!snapshot.Initialize(path, kSnapshotMagic, options.memory_mapped)) {
+    throw RecoveryFailure("Couldn't read snapshot magic and/or version!");
+  }
+  if (options.offset_compressed_blocks != 0 && !snapshot.EnableBlockDecompression(options.offset_compressed_blocks)) {
+    throw RecoveryFailure("Couldn't read compressed snapshot data!");
+  }
+}
+
 struct BatchInfo {
   uint64_t offset;
   uint64_t count;
@@ -131,15 +184,10 @@ SnapshotInfo ReadSnapshotInfo(const std::filesystem::path &path) {
     auto marker = snapshot.ReadMarker();
     if (!marker || *marker != Marker::SECTION_OFFSETS) throw RecoveryFailure("Invalid snapshot data!");
 
-    auto snapshot_size = snapshot.GetSize();
-    if (!snapshot_size) throw RecoveryFailure("Couldn't read data from snapshot!");
-
-    auto read_offset = [&snapshot, snapshot_size] {
+    auto read_offset = [&snapshot] {
       auto maybe_offset = snapshot.ReadUint();
       if (!maybe_offset) throw RecoveryFailure("Invalid snapshot format!");
-      auto offset = *maybe_offset;
-      if (offset > *snapshot_size) throw RecoveryFailure("Invalid snapshot format!");
-      return offset;
+      return *maybe_offset;
     };
 
     info.offset_edges = read_offset();
@@ -156,6 +204,19 @@ SnapshotInfo ReadSnapshotInfo(const std::filesystem::path &path) {
       info.offset_edge_batches = 0U;
       info.offset_vertex_batches = 0U;
     }
+    info.offset_compressed_blocks = *version >= kSnapshotCompressionVersion ? read_offset() : 0U;
+    if (info.offset_compressed_blocks != 0 && !snapshot.EnableBlockDecompression(info.offset_compressed_blocks)) {
+      throw RecoveryFailure("Couldn't read compressed snapshot data!");
+    }
+
+    // The offsets point into the uncompressed data.
+    auto snapshot_size = snapshot.GetSize();
+    if (!snapshot_size) throw RecoveryFailure("Couldn't read data from snapshot!");
+    for (const auto offset : {info.offset_edges, info.offset_vertices, info.offset_indices, info.offset_constraints,
+                              info.offset_mapper, info.offset_epoch_history, info.offset_metadata,
+                              info.offset_edge_batches, info.offset_vertex_batches}) {
+      if (offset > *snapshot_size) throw RecoveryFailure("Invalid snapshot format!");
+    }
   }
 
   // Read metadata.
@@ -184,6 +245,12 @@ SnapshotInfo ReadSnapshotInfo(const std::filesystem::path &path) {
     auto maybe_vertices = snapshot.ReadUint();
     if (!maybe_vertices) throw RecoveryFailure("Invalid snapshot data!");
     info.vertices_count = *maybe_vertices;
+
+    if (*version >= kLightEdgesVersion) {
+      auto maybe_light_edges = snapshot.ReadBool();
+      if (!maybe_light_edges) throw RecoveryFailure("Invalid snapshot data!");
+      info.light_edges = *maybe_light_edges;
+    }
   }
 
   return info;
@@ -213,13 +280,16 @@ std::vector<BatchInfo> ReadBatchInfos(Decoder &snapshot) {
 }
 
 template <typename TFunc>
-void LoadPartialEdges(const std::filesystem::path &path, utils::SkipList<Edge> &edges, const uint64_t from_offset,
-                      const uint64_t edges_count, const Config::Items items, TFunc get_property_from_id) {
+void LoadPartialEdges(const std::filesystem::path &path, const SnapshotReadOptions &read_options,
+                      utils::SkipList<Edge> &edges, const uint64_t from_offset, const uint64_t edges_count,
+                      const Config::Items items, TFunc get_property_from_id) {
   Decoder snapshot;
-  snapshot.Initialize(path, kSnapshotMagic);
+  OpenSnapshot(snapshot, path, read_options);
 
   // Recover edges.
   auto edge_acc = edges.access();
+  // The edges are stored sorted by their gids.
+  utils::SkipList<Edge>::InsertHint edge_hint;
   uint64_t last_edge_gid = 0;
   spdlog::info("Recovering {} edges.", edges_count);
   if (!snapshot.SetPosition(from_offset)) throw RecoveryFailure("Couldn't read data from snapshot!");
@@ -239,13 +309,15 @@ void LoadPartialEdges(const std::filesystem::path &path, utils::SkipList<Edge> &
 
     if (items.properties_on_edges) {
       spdlog::debug("Recovering edge {} with properties.", *gid);
-      auto [it, inserted] = edge_acc.insert(Edge{Gid::FromUint(*gid), nullptr});
+      auto props_size = snapshot.ReadUint();
+      if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
+      // A light edge only has an object if it has properties.
+      if (items.light_edges && *props_size == 0) continue;
+      auto [it, inserted] = edge_acc.insert(edge_hint, Edge{Gid::FromUint(*gid), nullptr});
       if (!inserted) throw RecoveryFailure("The edge must be inserted here!");
 
       // Recover properties.
       {
-        auto props_size = snapshot.ReadUint();
-        if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
         auto &props = it->properties;
         read_properties.clear();
         read_properties.reserve(*props_size);
@@ -274,16 +346,21 @@ void LoadPartialEdges(const std::filesystem::path &path, utils::SkipList<Edge> &
   spdlog::info("Partial edges are recovered.");
 }
 
-// Returns the gid of the last recovered vertex
+// Returns the gid of the last recovered vertex. The recovered vertices are
+// appended to `loaded_vertices` if it's set.
 template <typename TLabelFromIdFunc, typename TPropertyFromIdFunc>
-uint64_t LoadPartialVertices(const std::filesystem::path &path, utils::SkipList<Vertex> &vertices,
-                             const uint64_t from_offset, const uint64_t vertices_count,
-                             TLabelFromIdFunc get_label_from_id, TPropertyFromIdFunc get_property_from_id) {
+uint64_t LoadPartialVertices(const std::filesystem::path &path, const SnapshotReadOptions &read_options,
+                             utils::SkipList<Vertex> &vertices, const uint64_t from_offset,
+                             const uint64_t vertices_count, TLabelFromIdFunc get_label_from_id,
+                             TPropertyFromIdFunc get_property_from_id,
+                             std::vector<Vertex *> *loaded_vertices = nullptr) {
   Decoder snapshot;
-  snapshot.Initialize(path, kSnapshotMagic);
+  OpenSnapshot(snapshot, path, read_options);
   if (!snapshot.SetPosition(from_offset)) throw RecoveryFailure("Couldn't read data from snapshot!");
 
   auto vertex_acc = vertices.access();
+  // The vertices are stored sorted by their gids.
+  utils::SkipList<Vertex>::InsertHint vertex_hint;
   uint64_t last_vertex_gid = 0;
   spdlog::info("Recovering {} vertices.", vertices_count);
   std::vector<std::pair<PropertyId, PropertyValue>> read_properties;
@@ -301,8 +378,9 @@ uint64_t LoadPartialVertices(const std::filesystem::path &path, utils::SkipList<
     }
     last_vertex_gid = *gid;
     spdlog::debug("Recovering vertex {}.", *gid);
-    auto [it, inserted] = vertex_acc.insert(Vertex{Gid::FromUint(*gid), nullptr});
+    auto [it, inserted] = vertex_acc.insert(vertex_hint, Vertex{Gid::FromUint(*gid), nullptr});
     if (!inserted) throw RecoveryFailure("The vertex must be inserted here!");
+    if (loaded_vertices) loaded_vertices->push_back(&*it);
 
     // Recover labels.
     spdlog::trace("Recovering labels for vertex {}.", *gid);
@@ -377,12 +455,13 @@ struct LoadPartialConnectivityResult {
 
 template <typename TEdgeTypeFromIdFunc>
 LoadPartialConnectivityResult LoadPartialConnectivity(const std::filesystem::path &path,
+                                                      const SnapshotReadOptions &read_options,
                                                       utils::SkipList<Vertex> &vertices, utils::SkipList<Edge> &edges,
                                                       const uint64_t from_offset, const uint64_t vertices_count,
-                                                      const Config::Items items, const bool snapshot_has_edges,
+                                                      const Config::Items items, const bool snapshot_has_all_edges,
                                                       TEdgeTypeFromIdFunc get_edge_type_from_id) {
   Decoder snapshot;
-  snapshot.Initialize(path, kSnapshotMagic);
+  OpenSnapshot(snapshot, path, read_options);
   if (!snapshot.SetPosition(from_offset)) throw RecoveryFailure("Couldn't read data from snapshot!");
 
   auto vertex_acc = vertices.access();
@@ -464,11 +543,11 @@ LoadPartialConnectivityResult LoadPartialConnectivity(const std::filesystem::pat
         if (from_vertex == vertex_acc.end()) throw RecoveryFailure("Invalid from vertex!");
 
         EdgeRef edge_ref(Gid::FromUint(*edge_gid));
-        if (items.properties_on_edges) {
-          // The snapshot contains the individiual edges only if it was created with a config where properties are
-          // allowed on edges. That means the snapshots that were created without edge properties will only contain the
-          // edges in the in/out edges list of vertices, therefore the edges has to be created here.
-          if (snapshot_has_edges) {
+        if (items.EdgeRefsArePointers()) {
+          // The snapshot contains the individual edges only if it was created with a config where properties are
+          // allowed on edges, and only the edges with properties if it was also created with light edges. The other
+          // edges are only in the in/out edges lists of the vertices, therefore they have to be created here.
+          if (snapshot_has_all_edges) {
             auto edge = edge_acc.find(Gid::FromUint(*edge_gid));
             if (edge == edge_acc.end()) throw RecoveryFailure("Invalid edge!");
             edge_ref = EdgeRef(&*edge);
@@ -500,11 +579,11 @@ LoadPartialConnectivityResult LoadPartialConnectivity(const std::filesystem::pat
         if (to_vertex == vertex_acc.end()) throw RecoveryFailure("Invalid to vertex!");
 
         EdgeRef edge_ref(Gid::FromUint(*edge_gid));
-        if (items.properties_on_edges) {
-          // The snapshot contains the individiual edges only if it was created with a config where properties are
-          // allowed on edges. That means the snapshots that were created without edge properties will only contain the
-          // edges in the in/out edges list of vertices, therefore the edges has to be created here.
-          if (snapshot_has_edges) {
+        if (items.EdgeRefsArePointers()) {
+          // The snapshot contains the individual edges only if it was created with a config where properties are
+          // allowed on edges, and only the edges with properties if it was also created with light edges. The other
+          // edges are only in the in/out edges lists of the vertices, therefore they have to be created here.
+          if (snapshot_has_all_edges) {
             auto edge = edge_acc.find(Gid::FromUint(*edge_gid));
             if (edge == edge_acc.end()) throw RecoveryFailure("Invalid edge!");
             edge_ref = EdgeRef(&*edge);
@@ -543,7 +622,9 @@ void RecoverOnMultipleThreads(size_t thread_count, const TFunc &func, const std:
           }
           const auto &batch = batches[batch_index];
           try {
+            MG_TRACEPOINT(snapshot__batch__recovery__start, batch_index, batch.count);
             func(batch_index, batch);
+            MG_TRACEPOINT(snapshot__batch__recovery__done, batch_index, batch.count);
           } catch (RecoveryFailure &failure) {
             *maybe_error.Lock() = std::move(failure);
           }
@@ -629,6 +710,8 @@ RecoveredSnapshot LoadSnapshotVersion14(const std::filesystem::path &path, utils
   {
     // Recover edges.
     auto edge_acc = edges->access();
+    // The edges are stored sorted by their gids.
+    utils::SkipList<Edge>::InsertHint edge_hint;
     uint64_t last_edge_gid = 0;
     if (snapshot_has_edges) {
       spdlog::info("Recovering {} edges.", info.edges_count);
@@ -646,13 +729,15 @@ RecoveredSnapshot LoadSnapshotVersion14(const std::filesystem::path &path, utils
           if (i > 0 && *gid <= last_edge_gid) throw RecoveryFailure("Invalid snapshot data!");
           last_edge_gid = *gid;
           spdlog::debug("Recovering edge {} with properties.", *gid);
-          auto [it, inserted] = edge_acc.insert(Edge{Gid::FromUint(*gid), nullptr});
+          auto props_size = snapshot.ReadUint();
+          if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
+          // A light edge only has an object if it has properties.
+          if (items.light_edges && *props_size == 0) continue;
+          auto [it, inserted] = edge_acc.insert(edge_hint, Edge{Gid::FromUint(*gid), nullptr});
           if (!inserted) throw RecoveryFailure("The edge must be inserted here!");
 
           // Recover properties.
           {
-            auto props_size = snapshot.ReadUint();
-            if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
             auto &props = it->properties;
             for (uint64_t j = 0; j < *props_size; ++j) {
               auto key = snapshot.ReadUint();
@@ -689,6 +774,8 @@ RecoveredSnapshot LoadSnapshotVersion14(const std::filesystem::path &path, utils
     // Recover vertices (labels and properties).
     if (!snapshot.SetPosition(info.offset_vertices)) throw RecoveryFailure("Couldn't read data from snapshot!");
     auto vertex_acc = vertices->access();
+    // The vertices are stored sorted by their gids.
+    utils::SkipList<Vertex>::InsertHint vertex_hint;
     uint64_t last_vertex_gid = 0;
     spdlog::info("Recovering {} vertices.", info.vertices_count);
     for (uint64_t i = 0; i < info.vertices_count; ++i) {
@@ -705,7 +792,7 @@ RecoveredSnapshot LoadSnapshotVersion14(const std::filesystem::path &path, utils
       }
       last_vertex_gid = *gid;
       spdlog::debug("Recovering vertex {}.", *gid);
-      auto [it, inserted] = vertex_acc.insert(Vertex{Gid::FromUint(*gid), nullptr});
+      auto [it, inserted] = vertex_acc.insert(vertex_hint, Vertex{Gid::FromUint(*gid), nullptr});
       if (!inserted) throw RecoveryFailure("The vertex must be inserted here!");
 
       // Recover labels.
@@ -826,7 +913,8 @@ RecoveredSnapshot LoadSnapshotVersion14(const std::filesystem::path &path, utils
           if (from_vertex == vertex_acc.end()) throw RecoveryFailure("Invalid from vertex!");
 
           EdgeRef edge_ref(Gid::FromUint(*edge_gid));
-          if (items.properties_on_edges) {
+          if (items.EdgeRefsArePointers()) {
+            // Snapshots of this version were created before light edges, so they contain either all edges or none.
             if (snapshot_has_edges) {
               auto edge = edge_acc.find(Gid::FromUint(*edge_gid));
               if (edge == edge_acc.end()) throw RecoveryFailure("Invalid edge!");
@@ -862,7 +950,8 @@ RecoveredSnapshot LoadSnapshotVersion14(const std::filesystem::path &path, utils
           if (to_vertex == vertex_acc.end()) throw RecoveryFailure("Invalid to vertex!");
 
           EdgeRef edge_ref(Gid::FromUint(*edge_gid));
-          if (items.properties_on_edges) {
+          if (items.EdgeRefsArePointers()) {
+            // Snapshots of this version were created before light edges, so they contain either all edges or none.
             if (snapshot_has_edges) {
               auto edge = edge_acc.find(Gid::FromUint(*edge_gid));
               if (edge == edge_acc.end()) throw RecoveryFailure("Invalid edge!");
@@ -930,6 +1019,32 @@ RecoveredSnapshot LoadSnapshotVersion14(const std::filesystem::path &path, utils
       }
       spdlog::info("Metadata of label+property indices are recovered.");
     }
+
+    // Recover composite label+property indices.
+    if (*version >= kCompositeIndexVersion) {
+      auto size = snapshot.ReadUint();
+      if (!size) throw RecoveryFailure("Invalid snapshot data!");
+      spdlog::info("Recovering metadata of {} composite label+property indices.", *size);
+      for (uint64_t i = 0; i < *size; ++i) {
+        auto label = snapshot.ReadUint();
+        if (!label) throw RecoveryFailure("Invalid snapshot data!");
+        auto properties_count = snapshot.ReadUint();
+        if (!properties_count) throw RecoveryFailure("Invalid snapshot data!");
+        std::vector<PropertyId> properties;
+        properties.reserve(*properties_count);
+        for (uint64_t j = 0; j < *properties_count; ++j) {
+          auto property = snapshot.ReadUint();
+          if (!property) throw RecoveryFailure("Invalid snapshot data!");
+          properties.push_back(get_property_from_id(*property));
+        }
+        AddRecoveredIndexConstraint(&indices_constraints.indices.label_property_composite,
+                                    {get_label_from_id(*label), std::move(properties)},
+                                    "The composite label+property index already exists!");
+        SPDLOG_TRACE("Recovered metadata of composite label+property index for :{}",
+                     name_id_mapper->IdToName(snapshot_id_map.at(*label)));
+      }
+      spdlog::info("Metadata of composite label+property indices are recovered.");
+    }
     spdlog::info("Metadata of indices are recovered.");
   }
 
@@ -1028,12 +1143,13 @@ RecoveredSnapshot LoadSnapshotVersion14(const std::filesystem::path &path, utils
 RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipList<Vertex> *vertices,
                                utils::SkipList<Edge> *edges,
                                std::deque<std::pair<std::string, uint64_t>> *epoch_history,
-                               NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, const Config &config) {
+                               NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, const Config &config,
+                               Indices *indices) {
   RecoveryInfo recovery_info;
   RecoveredIndicesAndConstraints indices_constraints;
 
   Decoder snapshot;
-  const auto version = snapshot.Initialize(path, kSnapshotMagic);
+  const auto version = snapshot.Initialize(path, kSnapshotMagic, config.durability.snapshot_recovery_mmap);
   if (!version) throw RecoveryFailure("Couldn't read snapshot magic and/or version!");
 
   if (!IsVersionSupported(*version)) throw RecoveryFailure(fmt::format("Invalid snapshot version {}", *version));
@@ -1045,6 +1161,14 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
   bool success = false;
   utils::OnScopeExit cleanup([&] {
     if (!success) {
+      if (indices_constraints.indices.populated) {
+        for (const auto &label : indices_constraints.indices.label) {
+          indices->label_index_->DropIndex(label);
+        }
+        for (const auto &[label, property] : indices_constraints.indices.label_property) {
+          indices->label_property_index_->DropIndex(label, property);
+        }
+      }
       edges->clear();
       vertices->clear();
       epoch_history->clear();
@@ -1054,8 +1178,15 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
   // Read snapshot info.
   const auto info = ReadSnapshotInfo(path);
   spdlog::info("Recovering {} vertices and {} edges.", info.vertices_count, info.edges_count);
+  if (info.offset_compressed_blocks != 0 && !snapshot.EnableBlockDecompression(info.offset_compressed_blocks)) {
+    throw RecoveryFailure("Couldn't read compressed snapshot data!");
+  }
+  const SnapshotReadOptions read_options{.memory_mapped = config.durability.snapshot_recovery_mmap,
+                                         .offset_compressed_blocks = info.offset_compressed_blocks};
   // Check for edges.
   bool snapshot_has_edges = info.offset_edges != 0;
+  // A snapshot created with light edges leaves out the edges without properties.
+  const bool snapshot_has_all_edges = snapshot_has_edges && !info.light_edges;
 
   // Recover mapper.
   std::unordered_map<uint64_t, uint64_t> snapshot_id_map;
@@ -1095,6 +1226,160 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
     return EdgeTypeId::FromUint(it->second);
   };
 
+  // Recover indices.
+  {
+    spdlog::info("Recovering metadata of indices.");
+    if (!snapshot.SetPosition(info.offset_indices)) throw RecoveryFailure("Couldn't read data from snapshot!");
+
+    auto marker = snapshot.ReadMarker();
+    if (!marker || *marker != Marker::SECTION_INDICES) throw RecoveryFailure("Invalid snapshot data!");
+
+    // Recover label indices.
+    {
+      auto size = snapshot.ReadUint();
+      if (!size) throw RecoveryFailure("Invalid snapshot data!");
+      spdlog::info("Recovering metadata of {} label indices.", *size);
+      for (uint64_t i = 0; i < *size; ++i) {
+        auto label = snapshot.ReadUint();
+        if (!label) throw RecoveryFailure("Invalid snapshot data!");
+        AddRecoveredIndexConstraint(&indices_constraints.indices.label, get_label_from_id(*label),
+                                    "The label index already exists!");
+        SPDLOG_TRACE("Recovered metadata of label index for :{}", name_id_mapper->IdToName(snapshot_id_map.at(*label)));
+      }
+      spdlog::info("Metadata of label indices are recovered.");
+    }
+
+    // Recover label+property indices.
+    {
+      auto size = snapshot.ReadUint();
+      if (!size) throw RecoveryFailure("Invalid snapshot data!");
+      spdlog::info("Recovering metadata of {} label+property indices.", *size);
+      for (uint64_t i = 0; i < *size; ++i) {
+        auto label = snapshot.ReadUint();
+        if (!label) throw RecoveryFailure("Invalid snapshot data!");
+        auto property = snapshot.ReadUint();
+        if (!property) throw RecoveryFailure("Invalid snapshot data!");
+        AddRecoveredIndexConstraint(&indices_constraints.indices.label_property,
+                                    {get_label_from_id(*label), get_property_from_id(*property)},
+                                    "The label+property index already exists!");
+        SPDLOG_TRACE("Recovered metadata of label+property index for :{}({})",
+                     name_id_mapper->IdToName(snapshot_id_map.at(*label)),
+                     name_id_mapper->IdToName(snapshot_id_map.at(*property)));
+      }
+      spdlog::info("Metadata of label+property indices are recovered.");
+    }
+
+    // Recover composite label+property indices.
+    if (*version >= kCompositeIndexVersion) {
+      auto size = snapshot.ReadUint();
+      if (!size) throw RecoveryFailure("Invalid snapshot data!");
+      spdlog::info("Recovering metadata of {} composite label+property indices.", *size);
+      for (uint64_t i = 0; i < *size; ++i) {
+        auto label = snapshot.ReadUint();
+        if (!label) throw RecoveryFailure("Invalid snapshot data!");
+        auto properties_count = snapshot.ReadUint();
+        if (!properties_count) throw RecoveryFailure("Invalid snapshot data!");
+        std::vector<PropertyId> properties;
+        properties.reserve(*properties_count);
+        for (uint64_t j = 0; j < *properties_count; ++j) {
+          auto property = snapshot.ReadUint();
+          if (!property) throw RecoveryFailure("Invalid snapshot data!");
+          properties.push_back(get_property_from_id(*property));
+        }
+        AddRecoveredIndexConstraint(&indices_constraints.indices.label_property_composite,
+                                    {get_label_from_id(*label), std::move(properties)},
+                                    "The composite label+property index already exists!");
+        SPDLOG_TRACE("Recovered metadata of composite label+property index for :{}",
+                     name_id_mapper->IdToName(snapshot_id_map.at(*label)));
+      }
+      spdlog::info("Metadata of composite label+property indices are recovered.");
+    }
+
+    // Recover text indices.
+    if (*version >= kTextIndexVersion) {
+      auto size = snapshot.ReadUint();
+      if (!size) throw RecoveryFailure("Invalid snapshot data!");
+      spdlog::info("Recovering metadata of {} text indices.", *size);
+      for (uint64_t i = 0; i < *size; ++i) {
+        auto label = snapshot.ReadUint();
+        if (!label) throw RecoveryFailure("Invalid snapshot data!");
+        auto property = snapshot.ReadUint();
+        if (!property) throw RecoveryFailure("Invalid snapshot data!");
+        AddRecoveredIndexConstraint(&indices_constraints.indices.text,
+                                    {get_label_from_id(*label), get_property_from_id(*property)},
+                                    "The text index already exists!");
+        SPDLOG_TRACE("Recovered metadata of text index for :{}({})",
+                     name_id_mapper->IdToName(snapshot_id_map.at(*label)),
+                     name_id_mapper->IdToName(snapshot_id_map.at(*property)));
+      }
+      spdlog::info("Metadata of text indices are recovered.");
+    }
+
+    // Recover vector indices.
+    if (*version >= kVectorIndexVersion) {
+      auto size = snapshot.ReadUint();
+      if (!size) throw RecoveryFailure("Invalid snapshot data!");
+      spdlog::info("Recovering metadata of {} vector indices.", *size);
+      for (uint64_t i = 0; i < *size; ++i) {
+        auto label = snapshot.ReadUint();
+        if (!label) throw RecoveryFailure("Invalid snapshot data!");
+        auto property = snapshot.ReadUint();
+        if (!property) throw RecoveryFailure("Invalid snapshot data!");
+        AddRecoveredIndexConstraint(&indices_constraints.indices.vector,
+                                    {get_label_from_id(*label), get_property_from_id(*property)},
+                                    "The vector index already exists!");
+        SPDLOG_TRACE("Recovered metadata of vector index for :{}({})",
+                     name_id_mapper->IdToName(snapshot_id_map.at(*label)),
+                     name_id_mapper->IdToName(snapshot_id_map.at(*property)));
+      }
+      spdlog::info("Metadata of vector indices are recovered.");
+    }
+
+    // Recover aggregate indices.
+    if (*version >= kAggregateIndexVersion) {
+      auto size = snapshot.ReadUint();
+      if (!size) throw RecoveryFailure("Invalid snapshot data!");
+      spdlog::info("Recovering metadata of {} aggregate indices.", *size);
+      for (uint64_t i = 0; i < *size; ++i) {
+        auto label = snapshot.ReadUint();
+        if (!label) throw RecoveryFailure("Invalid snapshot data!");
+        auto group_property = snapshot.ReadUint();
+        if (!group_property) throw RecoveryFailure("Invalid snapshot data!");
+        auto value_property = snapshot.ReadUint();
+        if (!value_property) throw RecoveryFailure("Invalid snapshot data!");
+        AddRecoveredIndexConstraint(&indices_constraints.indices.aggregate,
+                                    {get_label_from_id(*label), get_property_from_id(*group_property),
+                                     get_property_from_id(*value_property)},
+                                    "The aggregate index already exists!");
+        SPDLOG_TRACE("Recovered metadata of aggregate index for :{}({}, {})",
+                     name_id_mapper->IdToName(snapshot_id_map.at(*label)),
+                     name_id_mapper->IdToName(snapshot_id_map.at(*group_property)),
+                     name_id_mapper->IdToName(snapshot_id_map.at(*value_property)));
+      }
+      spdlog::info("Metadata of aggregate indices are recovered.");
+    }
+    spdlog::info("Metadata of indices are recovered.");
+  }
+
+  // With parallel index recovery, the label and label+property indices are
+  // registered before the vertices are loaded and each batch of vertices is
+  // inserted into them by the thread that loaded it, instead of scanning all
+  // vertices again for each index once the snapshot is loaded.
+  auto *mem_label_index = indices ? static_cast<InMemoryLabelIndex *>(indices->label_index_.get()) : nullptr;
+  auto *mem_label_property_index =
+      indices ? static_cast<InMemoryLabelPropertyIndex *>(indices->label_property_index_.get()) : nullptr;
+  if (indices) {
+    indices_constraints.indices.populated = true;
+    for (const auto &label : indices_constraints.indices.label) {
+      if (!mem_label_index->RegisterIndex(label)) throw RecoveryFailure("The label index must be created here!");
+    }
+    for (const auto &[label, property] : indices_constraints.indices.label_property) {
+      if (!mem_label_property_index->RegisterIndex(label, property)) {
+        throw RecoveryFailure("The label+property index must be created here!");
+      }
+    }
+  }
+
   // Reset current edge count.
   edge_count->store(0, std::memory_order_release);
 
@@ -1114,9 +1399,9 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
 
       RecoverOnMultipleThreads(
           config.durability.recovery_thread_count,
-          [path, edges, items = config.items, &get_property_from_id](const size_t /*batch_index*/,
-                                                                     const BatchInfo &batch) {
-            LoadPartialEdges(path, *edges, batch.offset, batch.count, items, get_property_from_id);
+          [path, read_options, edges, items = config.items, &get_property_from_id](const size_t /*batch_index*/,
+                                                                                    const BatchInfo &batch) {
+            LoadPartialEdges(path, read_options, *edges, batch.offset, batch.count, items, get_property_from_id);
           },
           edge_batches);
     }
@@ -1133,13 +1418,24 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
     const auto vertex_batches = ReadBatchInfos(snapshot);
     RecoverOnMultipleThreads(
         config.durability.recovery_thread_count,
-        [path, vertices, &vertex_batches, &get_label_from_id, &get_property_from_id, &last_vertex_gid](
-            const size_t batch_index, const BatchInfo &batch) {
+        [path, read_options, vertices, &vertex_batches, &get_label_from_id, &get_property_from_id, &last_vertex_gid,
+         indices, mem_label_index, mem_label_property_index,
+         &indices_constraints](const size_t batch_index, const BatchInfo &batch) {
+          std::vector<Vertex *> loaded_vertices;
           const auto last_vertex_gid_in_batch =
-              LoadPartialVertices(path, *vertices, batch.offset, batch.count, get_label_from_id, get_property_from_id);
+              LoadPartialVertices(path, read_options, *vertices, batch.offset, batch.count, get_label_from_id,
+                                  get_property_from_id, indices ? &loaded_vertices : nullptr);
           if (batch_index == vertex_batches.size() - 1) {
             last_vertex_gid = last_vertex_gid_in_batch;
           }
+          if (indices) {
+            for (const auto &label : indices_constraints.indices.label) {
+              mem_label_index->PopulateIndex(label, loaded_vertices);
+            }
+            for (const auto &[label, property] : indices_constraints.indices.label_property) {
+              mem_label_property_index->PopulateIndex(label, property, loaded_vertices);
+            }
+          }
         },
         vertex_batches);
 
@@ -1155,10 +1451,10 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
 
     RecoverOnMultipleThreads(
         config.durability.recovery_thread_count,
-        [path, vertices, edges, edge_count, items = config.items, snapshot_has_edges, &get_edge_type_from_id,
-         &highest_edge_gid, &recovery_info](const size_t batch_index, const BatchInfo &batch) {
-          const auto result = LoadPartialConnectivity(path, *vertices, *edges, batch.offset, batch.count, items,
-                                                      snapshot_has_edges, get_edge_type_from_id);
+        [path, read_options, vertices, edges, edge_count, items = config.items, snapshot_has_all_edges,
+         &get_edge_type_from_id, &highest_edge_gid, &recovery_info](const size_t batch_index, const BatchInfo &batch) {
+          const auto result = LoadPartialConnectivity(path, read_options, *vertices, *edges, batch.offset, batch.count,
+                                                      items, snapshot_has_all_edges, get_edge_type_from_id);
           edge_count->fetch_add(result.edge_count);
           auto known_highest_edge_gid = highest_edge_gid.load();
           while (known_highest_edge_gid < result.highest_edge_id) {
@@ -1175,51 +1471,6 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
     recovery_info.next_vertex_id = last_vertex_gid + 1;
   }
 
-  // Recover indices.
-  {
-    spdlog::info("Recovering metadata of indices.");
-    if (!snapshot.SetPosition(info.offset_indices)) throw RecoveryFailure("Couldn't read data from snapshot!");
-
-    auto marker = snapshot.ReadMarker();
-    if (!marker || *marker != Marker::SECTION_INDICES) throw RecoveryFailure("Invalid snapshot data!");
-
-    // Recover label indices.
-    {
-      auto size = snapshot.ReadUint();
-      if (!size) throw RecoveryFailure("Invalid snapshot data!");
-      spdlog::info("Recovering metadata of {} label indices.", *size);
-      for (uint64_t i = 0; i < *size; ++i) {
-        auto label = snapshot.ReadUint();
-        if (!label) throw RecoveryFailure("Invalid snapshot data!");
-        AddRecoveredIndexConstraint(&indices_constraints.indices.label, get_label_from_id(*label),
-                                    "The label index already exists!");
-        SPDLOG_TRACE("Recovered metadata of label index for :{}", name_id_mapper->IdToName(snapshot_id_map.at(*label)));
-      }
-      spdlog::info("Metadata of label indices are recovered.");
-    }
-
-    // Recover label+property indices.
-    {
-      auto size = snapshot.ReadUint();
-      if (!size) throw RecoveryFailure("Invalid snapshot data!");
-      spdlog::info("Recovering metadata of {} label+property indices.", *size);
-      for (uint64_t i = 0; i < *size; ++i) {
-        auto label = snapshot.ReadUint();
-        if (!label) throw RecoveryFailure("Invalid snapshot data!");
-        auto property = snapshot.ReadUint();
-        if (!property) throw RecoveryFailure("Invalid snapshot data!");
-        AddRecoveredIndexConstraint(&indices_constraints.indices.label_property,
-                                    {get_label_from_id(*label), get_property_from_id(*property)},
-                                    "The label+property index already exists!");
-        SPDLOG_TRACE("Recovered metadata of label+property index for :{}({})",
-                     name_id_mapper->IdToName(snapshot_id_map.at(*label)),
-                     name_id_mapper->IdToName(snapshot_id_map.at(*property)));
-      }
-      spdlog::info("Metadata of label+property indices are recovered.");
-    }
-    spdlog::info("Metadata of indices are recovered.");
-  }
-
   // Recover constraints.
   {
     spdlog::info("Recovering metadata of constraints.");
@@ -1312,20 +1563,238 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
   return {info, recovery_info, std::move(indices_constraints)};
 }
 
-void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snapshot_directory,
-                    const std::filesystem::path &wal_directory, uint64_t snapshot_retention_count,
-                    utils::SkipList<Vertex> *vertices, utils::SkipList<Edge> *edges, NameIdMapper *name_id_mapper,
-                    Indices *indices, Constraints *constraints, const Config &config, const std::string &uuid,
-                    const std::string_view epoch_id, const std::deque<std::pair<std::string, uint64_t>> &epoch_history,
-                    utils::FileRetainer *file_retainer) {
+void SnapshotProgress::Start(uint64_t start_timestamp) {
+  std::lock_guard<utils::SpinLock> guard(lock_);
+  start_timestamp_ = start_timestamp;
+  phase_ = Phase::EDGES;
+  ranges_.reset();
+  ranges_count_ = 0;
+}
+
+void SnapshotProgress::Finish() {
+  std::lock_guard<utils::SpinLock> guard(lock_);
+  start_timestamp_ = std::nullopt;
+  ranges_.reset();
+  ranges_count_ = 0;
+}
+
+SnapshotProgress::Range *SnapshotProgress::StartEdges(const std::vector<std::pair<uint64_t, uint64_t>> &ranges) {
+  return StartRanges(Phase::EDGES, ranges);
+}
+
+SnapshotProgress::Range *SnapshotProgress::StartVertices(const std::vector<std::pair<uint64_t, uint64_t>> &ranges) {
+  return StartRanges(Phase::VERTICES, ranges);
+}
+
+SnapshotProgress::Range *SnapshotProgress::StartRanges(Phase phase,
+                                                       const std::vector<std::pair<uint64_t, uint64_t>> &ranges) {
+  std::lock_guard<utils::SpinLock> guard(lock_);
+  phase_ = phase;
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+  ranges_ = std::make_unique<Range[]>(ranges.size());
+  ranges_count_ = ranges.size();
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    ranges_[i].begin = ranges[i].first;
+    ranges_[i].end = ranges[i].second;
+    ranges_[i].next.store(ranges[i].first, std::memory_order_release);
+  }
+  return ranges_.get();
+}
+
+void SnapshotProgress::FinishObjects() {
+  std::lock_guard<utils::SpinLock> guard(lock_);
+  phase_ = Phase::DONE;
+  ranges_.reset();
+  ranges_count_ = 0;
+}
+
+std::optional<uint64_t> SnapshotProgress::StartTimestamp() const {
+  std::lock_guard<utils::SpinLock> guard(lock_);
+  return start_timestamp_;
+}
+
+bool SnapshotProgress::IsWritten(uint64_t start_timestamp, const Delta &delta) const {
+  // The chain can be read without taking the lock of its owner.
+  auto owner = delta.prev.Get();
+  while (owner.type == PreviousPtr::Type::DELTA) {
+    owner = owner.delta->prev.Get();
+  }
+
+  std::lock_guard<utils::SpinLock> guard(lock_);
+  if (start_timestamp_ != start_timestamp) return false;
+  if (phase_ == Phase::DONE) return true;
+
+  uint64_t gid = 0;
+  switch (owner.type) {
+    case PreviousPtr::Type::VERTEX:
+      if (phase_ == Phase::EDGES) return false;
+      gid = owner.vertex->gid.AsUint();
+      break;
+    case PreviousPtr::Type::EDGE:
+      if (phase_ == Phase::VERTICES) return true;
+      gid = owner.edge->gid.AsUint();
+      break;
+    case PreviousPtr::Type::DELTA:
+    case PreviousPtr::Type::NULLPTR:
+      return false;
+  }
+  for (size_t i = 0; i < ranges_count_; ++i) {
+    const auto &range = ranges_[i];
+    if (gid >= range.begin && gid < range.next.load(std::memory_order_acquire)) return true;
+  }
+  return false;
+}
+
+// Writes the objects from `objects` that `write_object` stores and returns the
+// batch infos of the written objects. With more than one thread, each thread
+// writes a gid range of the objects into a separate part file. The part files
+// are then appended to the snapshot in order, so the resulting snapshot is the
+// same as the one written by a single thread, apart from the batch borders.
+// The written objects are reported to `progress` if it's set.
+template <typename TObject, typename TWriteObject>
+std::vector<BatchInfo> WriteObjectsInParallel(Encoder *snapshot, const std::filesystem::path &path,
+                                              utils::RateLimiter *rate_limiter, SnapshotProgress *progress,
+                                              typename utils::SkipList<TObject>::Accessor &objects,
+                                              uint64_t thread_count, uint64_t items_per_batch,
+                                              std::unordered_set<uint64_t> *used_ids, uint64_t *count,
+                                              const TWriteObject &write_object) {
+  struct Part {
+    std::vector<BatchInfo> batches;
+    std::unordered_set<uint64_t> used_ids;
+    uint64_t count{0};
+  };
+
+  auto start_progress = [&](const std::vector<std::pair<uint64_t, uint64_t>> &ranges) -> SnapshotProgress::Range * {
+    if (!progress) return nullptr;
+    if constexpr (std::is_same_v<TObject, Vertex>) {
+      return progress->StartVertices(ranges);
+    } else {
+      return progress->StartEdges(ranges);
+    }
+  };
+
+  auto write_range = [&](Encoder &encoder, auto begin, std::optional<Gid> end, Part &part,
+                         SnapshotProgress::Range *range) {
+    uint64_t items_in_current_batch = 0;
+    uint64_t batch_start_offset = encoder.GetPosition();
+    for (auto it = begin; it != objects.end() && (!end || it->gid < *end); ++it) {
+      const bool written = write_object(encoder, part.used_ids, *it);
+      if (range) range->next.store(it->gid.AsUint() + 1, std::memory_order_release);
+      if (!written) continue;
+      ++part.count;
+      ++items_in_current_batch;
+      if (items_in_current_batch == items_per_batch) {
+        part.batches.push_back(BatchInfo{batch_start_offset, items_in_current_batch});
+        metrics::global_gauges[metrics::SnapshotObjectsWritten].fetch_add(items_in_current_batch);
+        MG_TRACEPOINT(snapshot__batch__written, batch_start_offset, items_in_current_batch);
+        batch_start_offset = encoder.GetPosition();
+        items_in_current_batch = 0;
+      }
+    }
+    if (items_in_current_batch > 0) {
+      part.batches.push_back(BatchInfo{batch_start_offset, items_in_current_batch});
+      metrics::global_gauges[metrics::SnapshotObjectsWritten].fetch_add(items_in_current_batch);
+      MG_TRACEPOINT(snapshot__batch__written, batch_start_offset, items_in_current_batch);
+    }
+    if (range) range->next.store(range->end, std::memory_order_release);
+  };
+
+  if (thread_count <= 1) {
+    Part part;
+    auto *range = start_progress({{0, std::numeric_limits<uint64_t>::max()}});
+    write_range(*snapshot, objects.begin(), std::nullopt, part, range);
+    used_ids->merge(part.used_ids);
+    *count += part.count;
+    return std::move(part.batches);
+  }
+
+  auto split_points = objects.partition_points(thread_count);
+  std::vector<typename utils::SkipList<TObject>::Iterator> range_begins{objects.begin()};
+  std::vector<std::optional<Gid>> range_ends;
+  for (const auto &point : split_points) {
+    range_ends.emplace_back(point->gid);
+    range_begins.push_back(point);
+  }
+  range_ends.emplace_back(std::nullopt);
+
+  std::vector<std::pair<uint64_t, uint64_t>> progress_ranges;
+  for (size_t i = 0; i < range_begins.size(); ++i) {
+    progress_ranges.emplace_back(i == 0 ? 0 : range_begins[i]->gid.AsUint(),
+                                 range_ends[i] ? range_ends[i]->AsUint() : std::numeric_limits<uint64_t>::max());
+  }
+  auto *ranges = start_progress(progress_ranges);
+
+  std::vector<Part> parts(range_begins.size());
+  std::vector<std::filesystem::path> part_paths;
+  part_paths.reserve(range_begins.size());
+  for (size_t i = 0; i < range_begins.size(); ++i) {
+    part_paths.emplace_back(path.string() + fmt::format(".part_{}", i));
+  }
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(range_begins.size());
+    for (size_t i = 0; i < range_begins.size(); ++i) {
+      threads.emplace_back([&, i]() {
+        Encoder encoder;
+        encoder.Initialize(part_paths[i]);
+        encoder.SetRateLimiter(rate_limiter);
+        write_range(encoder, range_begins[i], range_ends[i], parts[i], ranges ? &ranges[i] : nullptr);
+        encoder.Finalize();
+      });
+    }
+  }
+
+  std::vector<BatchInfo> batches;
+  std::vector<uint8_t> buffer(utils::kFileBufferSize);
+  for (size_t i = 0; i < parts.size(); ++i) {
+    const auto part_offset = snapshot->GetPosition();
+    {
+      utils::InputFile part_file;
+      MG_ASSERT(part_file.Open(part_paths[i]), "Couldn't open snapshot part {}!", part_paths[i]);
+      auto remaining = part_file.GetSize();
+      while (remaining > 0) {
+        const auto size = std::min(remaining, buffer.size());
+        MG_ASSERT(part_file.Read(buffer.data(), size), "Couldn't read snapshot part {}!", part_paths[i]);
+        snapshot->Write(buffer.data(), size);
+        remaining -= size;
+      }
+    }
+    utils::DeleteFile(part_paths[i]);
+    for (const auto &batch : parts[i].batches) {
+      batches.push_back(BatchInfo{part_offset + batch.offset, batch.count});
+    }
+    used_ids->merge(parts[i].used_ids);
+    *count += parts[i].count;
+  }
+  return batches;
+}
+
+void WriteSnapshot(Transaction *transaction, const std::filesystem::path &snapshot_directory,
+                   const std::filesystem::path &wal_directory, uint64_t snapshot_retention_count,
+                   utils::SkipList<Vertex> *vertices, utils::SkipList<Edge> *edges, NameIdMapper *name_id_mapper,
+                   Indices *indices, Constraints *constraints, const Config &config, const std::string &uuid,
+                   const std::string_view epoch_id, const std::deque<std::pair<std::string, uint64_t>> &epoch_history,
+                   utils::FileRetainer *file_retainer, utils::RateLimiter *rate_limiter, SnapshotProgress *progress,
+                   std::optional<uint64_t> replica_commit_timestamp) {
   // Ensure that the storage directory exists.
   utils::EnsureDirOrDie(snapshot_directory);
 
+  if (progress) progress->Start(transaction->start_timestamp);
+  utils::OnScopeExit finish_progress([progress] {
+    if (progress) progress->Finish();
+  });
+
   // Create snapshot file.
   auto path = snapshot_directory / MakeSnapshotName(transaction->start_timestamp);
   spdlog::info("Starting snapshot creation to {}", path);
   Encoder snapshot;
   snapshot.Initialize(path, kSnapshotMagic, kVersion);
+  snapshot.SetRateLimiter(rate_limiter);
+  if (config.durability.async_writeback) {
+    // Avoids piling up dirty pages that all have to be written by the final
+    // sync.
+    snapshot.EnableWriteback();
+  }
 
   // Write placeholder offsets.
   uint64_t offset_offsets = 0;
@@ -1338,6 +1807,7 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
   uint64_t offset_epoch_history = 0;
   uint64_t offset_edge_batches = 0;
   uint64_t offset_vertex_batches = 0;
+  uint64_t offset_compressed_blocks = 0;
   {
     snapshot.WriteMarker(Marker::SECTION_OFFSETS);
     offset_offsets = snapshot.GetPosition();
@@ -1350,11 +1820,20 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
     snapshot.WriteUint(offset_metadata);
     snapshot.WriteUint(offset_edge_batches);
     snapshot.WriteUint(offset_vertex_batches);
+    snapshot.WriteUint(offset_compressed_blocks);
+  }
+
+  // The section offsets stay uncompressed so that they can be overwritten.
+  if (config.durability.snapshot_compression) {
+    snapshot.EnableBlockCompression(kSnapshotCompressionBlockSize);
   }
 
   // Object counters.
   uint64_t edges_count = 0;
   uint64_t vertices_count = 0;
+  metrics::SetGaugeValue(metrics::SnapshotObjectsToWrite,
+                         vertices->size() + (config.items.properties_on_edges ? edges->size() : 0));
+  metrics::SetGaugeValue(metrics::SnapshotObjectsWritten, 0);
 
   // Mapper data.
   std::unordered_set<uint64_t> used_ids;
@@ -1363,154 +1842,144 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
     snapshot.WriteUint(mapping.AsUint());
   };
 
+  const auto thread_count =
+      config.durability.allow_parallel_snapshot_creation ? config.durability.recovery_thread_count : 1;
+
   std::vector<BatchInfo> edge_batch_infos;
-  auto items_in_current_batch{0UL};
-  auto batch_start_offset{0UL};
   // Store all edges.
   if (config.items.properties_on_edges) {
     offset_edges = snapshot.GetPosition();
-    batch_start_offset = offset_edges;
     auto acc = edges->access();
-    for (auto &edge : acc) {
-      // The edge visibility check must be done here manually because we don't
-      // allow direct access to the edges through the public API.
-      bool is_visible = true;
-      Delta *delta = nullptr;
-      {
-        std::lock_guard<utils::SpinLock> guard(edge.lock);
-        is_visible = !edge.deleted;
-        delta = edge.delta;
-      }
-      ApplyDeltasForRead(transaction, delta, View::OLD, [&is_visible](const Delta &delta) {
-        switch (delta.action) {
-          case Delta::Action::ADD_LABEL:
-          case Delta::Action::REMOVE_LABEL:
-          case Delta::Action::SET_PROPERTY:
-          case Delta::Action::ADD_IN_EDGE:
-          case Delta::Action::ADD_OUT_EDGE:
-          case Delta::Action::REMOVE_IN_EDGE:
-          case Delta::Action::REMOVE_OUT_EDGE:
-            break;
-          case Delta::Action::RECREATE_OBJECT: {
-            is_visible = true;
-            break;
+    edge_batch_infos = WriteObjectsInParallel<Edge>(
+        &snapshot, path, rate_limiter, progress, acc, thread_count, config.durability.items_per_batch, &used_ids,
+        &edges_count,
+        [&](Encoder &encoder, std::unordered_set<uint64_t> &part_used_ids, Edge &edge) {
+          // The edge visibility check must be done here manually because we don't
+          // allow direct access to the edges through the public API.
+          bool is_visible = true;
+          Delta *delta = nullptr;
+          {
+            std::lock_guard guard(edge.lock);
+            is_visible = !edge.deleted;
+            delta = edge.delta;
           }
-          case Delta::Action::DELETE_DESERIALIZED_OBJECT:
-          case Delta::Action::DELETE_OBJECT: {
-            is_visible = false;
-            break;
+          ApplyDeltasForRead(transaction, delta, View::OLD, [&is_visible](const Delta &delta) {
+            switch (delta.action) {
+              case Delta::Action::ADD_LABEL:
+              case Delta::Action::REMOVE_LABEL:
+              case Delta::Action::SET_PROPERTY:
+              case Delta::Action::ADD_IN_EDGE:
+              case Delta::Action::ADD_OUT_EDGE:
+              case Delta::Action::REMOVE_IN_EDGE:
+              case Delta::Action::REMOVE_OUT_EDGE:
+                break;
+              case Delta::Action::RECREATE_OBJECT: {
+                is_visible = true;
+                break;
+              }
+              case Delta::Action::DELETE_DESERIALIZED_OBJECT:
+              case Delta::Action::DELETE_OBJECT: {
+                is_visible = false;
+                break;
+              }
+            }
+          });
+          if (!is_visible) return false;
+          EdgeRef edge_ref = config.items.EdgeRefsArePointers() ? EdgeRef(&edge) : EdgeRef(edge.gid);
+          // Here we create an edge accessor that we will use to get the
+          // properties of the edge. The accessor is created with an invalid
+          // type and invalid from/to pointers because we don't know them here,
+          // but that isn't an issue because we won't use that part of the API
+          // here.
+          auto ea = EdgeAccessor{
+              edge_ref, EdgeTypeId::FromUint(0UL), nullptr, nullptr, transaction, indices, constraints, config.items};
+
+          // Get edge data.
+          auto maybe_props = ea.Properties(View::OLD);
+          MG_ASSERT(maybe_props.HasValue(), "Invalid database state!");
+          const auto &props = maybe_props.GetValue();
+          // The light edges without properties are only stored in the
+          // adjacency lists of their vertices.
+          if (config.items.light_edges && props.empty()) return false;
+
+          // Store the edge.
+          encoder.WriteMarker(Marker::SECTION_EDGE);
+          encoder.WriteUint(edge.gid.AsUint());
+          encoder.WriteUint(props.size());
+          for (const auto &item : props) {
+            part_used_ids.insert(item.first.AsUint());
+            encoder.WriteUint(item.first.AsUint());
+            encoder.WritePropertyValue(item.second);
           }
-        }
-      });
-      if (!is_visible) continue;
-      EdgeRef edge_ref(&edge);
-      // Here we create an edge accessor that we will use to get the
-      // properties of the edge. The accessor is created with an invalid
-      // type and invalid from/to pointers because we don't know them here,
-      // but that isn't an issue because we won't use that part of the API
-      // here.
-      auto ea = EdgeAccessor{
-          edge_ref, EdgeTypeId::FromUint(0UL), nullptr, nullptr, transaction, indices, constraints, config.items};
-
-      // Get edge data.
-      auto maybe_props = ea.Properties(View::OLD);
-      MG_ASSERT(maybe_props.HasValue(), "Invalid database state!");
-
-      // Store the edge.
-      {
-        snapshot.WriteMarker(Marker::SECTION_EDGE);
-        snapshot.WriteUint(edge.gid.AsUint());
-        const auto &props = maybe_props.GetValue();
-        snapshot.WriteUint(props.size());
-        for (const auto &item : props) {
-          write_mapping(item.first);
-          snapshot.WritePropertyValue(item.second);
-        }
-      }
-
-      ++edges_count;
-      ++items_in_current_batch;
-      if (items_in_current_batch == config.durability.items_per_batch) {
-        edge_batch_infos.push_back(BatchInfo{batch_start_offset, items_in_current_batch});
-        batch_start_offset = snapshot.GetPosition();
-        items_in_current_batch = 0;
-      }
-    }
-  }
-
-  if (items_in_current_batch > 0) {
-    edge_batch_infos.push_back(BatchInfo{batch_start_offset, items_in_current_batch});
+          return true;
+        });
   }
 
   std::vector<BatchInfo> vertex_batch_infos;
   // Store all vertices.
   {
-    items_in_current_batch = 0;
     offset_vertices = snapshot.GetPosition();
-    batch_start_offset = offset_vertices;
     auto acc = vertices->access();
-    for (auto &vertex : acc) {
-      // The visibility check is implemented for vertices so we use it here.
-      auto va = VertexAccessor::Create(&vertex, transaction, indices, constraints, config.items, View::OLD);
-      if (!va) continue;
-
-      // Get vertex data.
-      // TODO (mferencevic): All of these functions could be written into a
-      // single function so that we traverse the undo deltas only once.
-      auto maybe_labels = va->Labels(View::OLD);
-      MG_ASSERT(maybe_labels.HasValue(), "Invalid database state!");
-      auto maybe_props = va->Properties(View::OLD);
-      MG_ASSERT(maybe_props.HasValue(), "Invalid database state!");
-      auto maybe_in_edges = va->InEdges(View::OLD);
-      MG_ASSERT(maybe_in_edges.HasValue(), "Invalid database state!");
-      auto maybe_out_edges = va->OutEdges(View::OLD);
-      MG_ASSERT(maybe_out_edges.HasValue(), "Invalid database state!");
-
-      // Store the vertex.
-      {
-        snapshot.WriteMarker(Marker::SECTION_VERTEX);
-        snapshot.WriteUint(vertex.gid.AsUint());
-        const auto &labels = maybe_labels.GetValue();
-        snapshot.WriteUint(labels.size());
-        for (const auto &item : labels) {
-          write_mapping(item);
-        }
-        const auto &props = maybe_props.GetValue();
-        snapshot.WriteUint(props.size());
-        for (const auto &item : props) {
-          write_mapping(item.first);
-          snapshot.WritePropertyValue(item.second);
-        }
-        const auto &in_edges = maybe_in_edges.GetValue();
-        snapshot.WriteUint(in_edges.size());
-        for (const auto &item : in_edges) {
-          snapshot.WriteUint(item.Gid().AsUint());
-          snapshot.WriteUint(item.FromVertex().Gid().AsUint());
-          write_mapping(item.EdgeType());
-        }
-        const auto &out_edges = maybe_out_edges.GetValue();
-        snapshot.WriteUint(out_edges.size());
-        for (const auto &item : out_edges) {
-          snapshot.WriteUint(item.Gid().AsUint());
-          snapshot.WriteUint(item.ToVertex().Gid().AsUint());
-          write_mapping(item.EdgeType());
-        }
-      }
-
-      ++vertices_count;
-      ++items_in_current_batch;
-      if (items_in_current_batch == config.durability.items_per_batch) {
-        vertex_batch_infos.push_back(BatchInfo{batch_start_offset, items_in_current_batch});
-        batch_start_offset = snapshot.GetPosition();
-        items_in_current_batch = 0;
-      }
-    }
-
-    if (items_in_current_batch > 0) {
-      vertex_batch_infos.push_back(BatchInfo{batch_start_offset, items_in_current_batch});
-    }
+    vertex_batch_infos = WriteObjectsInParallel<Vertex>(
+        &snapshot, path, rate_limiter, progress, acc, thread_count, config.durability.items_per_batch, &used_ids,
+        &vertices_count,
+        [&](Encoder &encoder, std::unordered_set<uint64_t> &part_used_ids, Vertex &vertex) {
+          auto write_mapping = [&encoder, &part_used_ids](auto mapping) {
+            part_used_ids.insert(mapping.AsUint());
+            encoder.WriteUint(mapping.AsUint());
+          };
+
+          // The visibility check is implemented for vertices so we use it here.
+          auto va = VertexAccessor::Create(&vertex, transaction, indices, constraints, config.items, View::OLD);
+          if (!va) return false;
+
+          // Get vertex data.
+          // TODO (mferencevic): All of these functions could be written into a
+          // single function so that we traverse the undo deltas only once.
+          auto maybe_labels = va->Labels(View::OLD);
+          MG_ASSERT(maybe_labels.HasValue(), "Invalid database state!");
+          auto maybe_props = va->Properties(View::OLD);
+          MG_ASSERT(maybe_props.HasValue(), "Invalid database state!");
+          auto maybe_in_edges = va->InEdges(View::OLD);
+          MG_ASSERT(maybe_in_edges.HasValue(), "Invalid database state!");
+          auto maybe_out_edges = va->OutEdges(View::OLD);
+          MG_ASSERT(maybe_out_edges.HasValue(), "Invalid database state!");
+
+          // Store the vertex.
+          encoder.WriteMarker(Marker::SECTION_VERTEX);
+          encoder.WriteUint(vertex.gid.AsUint());
+          const auto &labels = maybe_labels.GetValue();
+          encoder.WriteUint(labels.size());
+          for (const auto &item : labels) {
+            write_mapping(item);
+          }
+          const auto &props = maybe_props.GetValue();
+          encoder.WriteUint(props.size());
+          for (const auto &item : props) {
+            write_mapping(item.first);
+            encoder.WritePropertyValue(item.second);
+          }
+          const auto &in_edges = maybe_in_edges.GetValue();
+          encoder.WriteUint(in_edges.size());
+          for (const auto &item : in_edges) {
+            encoder.WriteUint(item.Gid().AsUint());
+            encoder.WriteUint(item.FromVertex().Gid().AsUint());
+            write_mapping(item.EdgeType());
+          }
+          const auto &out_edges = maybe_out_edges.GetValue();
+          encoder.WriteUint(out_edges.size());
+          for (const auto &item : out_edges) {
+            encoder.WriteUint(item.Gid().AsUint());
+            encoder.WriteUint(item.ToVertex().Gid().AsUint());
+            write_mapping(item.EdgeType());
+          }
+          return true;
+        });
   }
 
+  // The rest of the snapshot doesn't read the delta chains.
+  if (progress) progress->FinishObjects();
+
   // Write indices.
   {
     offset_indices = snapshot.GetPosition();
@@ -1534,6 +2003,50 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
         write_mapping(item.second);
       }
     }
+
+    // Write composite label+property indices.
+    {
+      auto label_property_composite = indices->label_property_composite_index_->ListIndices();
+      snapshot.WriteUint(label_property_composite.size());
+      for (const auto &item : label_property_composite) {
+        write_mapping(item.first);
+        snapshot.WriteUint(item.second.size());
+        for (const auto &property : item.second) {
+          write_mapping(property);
+        }
+      }
+    }
+
+    // Write text indices.
+    {
+      auto text = indices->text_index_->ListIndices();
+      snapshot.WriteUint(text.size());
+      for (const auto &item : text) {
+        write_mapping(item.first);
+        write_mapping(item.second);
+      }
+    }
+
+    // Write vector indices.
+    {
+      auto vector = indices->vector_index_->ListIndices();
+      snapshot.WriteUint(vector.size());
+      for (const auto &item : vector) {
+        write_mapping(item.first);
+        write_mapping(item.second);
+      }
+    }
+
+    // Write aggregate indices.
+    {
+      auto aggregate = indices->aggregate_index_->ListIndices();
+      snapshot.WriteUint(aggregate.size());
+      for (const auto &[label, group_property, value_property] : aggregate) {
+        write_mapping(label);
+        write_mapping(group_property);
+        write_mapping(value_property);
+      }
+    }
   }
 
   // Write constraints.
@@ -1596,6 +2109,7 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
     snapshot.WriteUint(transaction->start_timestamp);
     snapshot.WriteUint(edges_count);
     snapshot.WriteUint(vertices_count);
+    snapshot.WriteBool(config.items.properties_on_edges && config.items.light_edges);
   }
 
   auto write_batch_infos = [&snapshot](const std::vector<BatchInfo> &batch_infos) {
@@ -1618,6 +2132,10 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
     write_batch_infos(vertex_batch_infos);
   }
 
+  if (config.durability.snapshot_compression) {
+    offset_compressed_blocks = snapshot.FinishBlockCompression();
+  }
+
   // Write true offsets.
   {
     snapshot.SetPosition(offset_offsets);
@@ -1630,6 +2148,7 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
     snapshot.WriteUint(offset_metadata);
     snapshot.WriteUint(offset_edge_batches);
     snapshot.WriteUint(offset_vertex_batches);
+    snapshot.WriteUint(offset_compressed_blocks);
   }
 
   // Finalize snapshot file.
@@ -1704,6 +2223,16 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
         break;
       }
     }
+    if (pos && *pos > 0 && replica_commit_timestamp) {
+      // Keep the WAL files with the deltas the replicas haven't received yet,
+      // so they can catch up without a snapshot transfer. The number of kept
+      // files is bounded because a replica may never come back.
+      uint64_t replica_pos = 0;
+      while (replica_pos < *pos && std::get<2>(wal_files[replica_pos]) <= *replica_commit_timestamp) ++replica_pos;
+      const auto max_retained = config.durability.replication_max_retained_wal_files;
+      const uint64_t min_pos = *pos > max_retained ? *pos - max_retained : 0;
+      pos = std::max(replica_pos, min_pos);
+    }
     if (pos && *pos > 0) {
       // We need to leave at least one WAL file that contains deltas that were
       // created before the oldest snapshot. Because we always leave at least
@@ -1718,4 +2247,36 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
   }
 }
 
+void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snapshot_directory,
+                    const std::filesystem::path &wal_directory, uint64_t snapshot_retention_count,
+                    utils::SkipList<Vertex> *vertices, utils::SkipList<Edge> *edges, NameIdMapper *name_id_mapper,
+                    Indices *indices, Constraints *constraints, const Config &config, const std::string &uuid,
+                    const std::string_view epoch_id, const std::deque<std::pair<std::string, uint64_t>> &epoch_history,
+                    utils::FileRetainer *file_retainer, SnapshotProgress *progress,
+                    std::optional<uint64_t> replica_commit_timestamp) {
+  utils::RateLimiter rate_limiter(config.durability.snapshot_write_rate_limit_mib * 1024 * 1024);
+  auto write_snapshot = [&] {
+    WriteSnapshot(transaction, snapshot_directory, wal_directory, snapshot_retention_count, vertices, edges,
+                  name_id_mapper, indices, constraints, config, uuid, epoch_id, epoch_history, file_retainer,
+                  &rate_limiter, progress, replica_commit_timestamp);
+  };
+  if (!config.durability.snapshot_low_priority) {
+    write_snapshot();
+    return;
+  }
+
+  // The priority of the calling thread couldn't be raised again afterwards, so
+  // the snapshot is written by a separate thread.
+  std::exception_ptr exception;
+  std::jthread([&] {
+    utils::ThreadSetLowestPriority();
+    try {
+      write_snapshot();
+    } catch (...) {
+      exception = std::current_exception();
+    }
+  }).join();
+  if (exception) std::rethrow_exception(exception);
+}
+
 }  // namespace memgraph::storage::durability
@@ -11,12 +11,17 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "storage/v2/config.hpp"
 #include "storage/v2/constraints/constraints.hpp"
+#include "storage/v2/delta.hpp"
 #include "storage/v2/durability/metadata.hpp"
 #include "storage/v2/edge.hpp"
 #include "storage/v2/indices/indices.hpp"
@@ -25,6 +30,7 @@
 #include "storage/v2/vertex.hpp"
 #include "utils/file_locker.hpp"
 #include "utils/skip_list.hpp"
+#include "utils/spin_lock.hpp"
 
 namespace memgraph::storage::durability {
 
@@ -39,12 +45,17 @@ struct SnapshotInfo {
   uint64_t offset_metadata;
   uint64_t offset_edge_batches;
   uint64_t offset_vertex_batches;
+  // `0` if the snapshot isn't compressed.
+  uint64_t offset_compressed_blocks;
 
   std::string uuid;
   std::string epoch_id;
   uint64_t start_timestamp;
   uint64_t edges_count;
   uint64_t vertices_count;
+  // Whether the edges without properties were left out of the edges section
+  // because the snapshot was created with light edges.
+  bool light_edges{false};
 };
 
 /// Structure used to hold information about the snapshot that has been
@@ -55,23 +66,77 @@ struct RecoveredSnapshot {
   RecoveredIndicesAndConstraints indices_constraints;
 };
 
+/// Class used to track which objects the snapshot that is being created has
+/// already written. The garbage collector uses it to collect the transactions
+/// that committed after the snapshot started as soon as the snapshot doesn't
+/// need their deltas anymore, instead of keeping them until the end of the
+/// snapshot.
+class SnapshotProgress {
+ public:
+  /// Objects are written in gid ranges, one for each writing thread.
+  struct Range {
+    uint64_t begin;
+    uint64_t end;
+    // The objects with a gid in [begin, next) are written.
+    std::atomic<uint64_t> next;
+  };
+
+  void Start(uint64_t start_timestamp);
+  void Finish();
+
+  /// Starts writing the edges or the vertices in the given ranges. The objects
+  /// of the previous kind are all written.
+  /// @return the ranges whose progress should be updated by the writers
+  Range *StartEdges(const std::vector<std::pair<uint64_t, uint64_t>> &ranges);
+  Range *StartVertices(const std::vector<std::pair<uint64_t, uint64_t>> &ranges);
+
+  /// Marks all objects as written.
+  void FinishObjects();
+
+  /// Returns the start timestamp of the snapshot that is being created.
+  std::optional<uint64_t> StartTimestamp() const;
+
+  /// Returns true if the snapshot with the given start timestamp has already
+  /// written the object that owns the delta chain of `delta`, so it won't read
+  /// the chain again.
+  bool IsWritten(uint64_t start_timestamp, const Delta &delta) const;
+
+ private:
+  enum class Phase : uint8_t { EDGES, VERTICES, DONE };
+
+  Range *StartRanges(Phase phase, const std::vector<std::pair<uint64_t, uint64_t>> &ranges);
+
+  mutable utils::SpinLock lock_;
+  std::optional<uint64_t> start_timestamp_;
+  Phase phase_{Phase::EDGES};
+  std::unique_ptr<Range[]> ranges_;
+  size_t ranges_count_{0};
+};
+
 /// Function used to read information about the snapshot file.
 /// @throw RecoveryFailure
 SnapshotInfo ReadSnapshotInfo(const std::filesystem::path &path);
 
-/// Function used to load the snapshot data into the storage.
+/// Function used to load the snapshot data into the storage. If `indices` is
+/// set, the label and label+property indices are populated while the vertices
+/// are loaded and only have to be published afterwards.
 /// @throw RecoveryFailure
 RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipList<Vertex> *vertices,
                                utils::SkipList<Edge> *edges,
                                std::deque<std::pair<std::string, uint64_t>> *epoch_history,
-                               NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, const Config &config);
+                               NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, const Config &config,
+                               Indices *indices = nullptr);
 
-/// Function used to create a snapshot using the given transaction.
+/// Function used to create a snapshot using the given transaction. The WAL
+/// files with deltas committed after `replica_commit_timestamp` are kept, up
+/// to `replication_max_retained_wal_files` of them, so that a replica can be
+/// recovered from them instead of the snapshot.
 void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snapshot_directory,
                     const std::filesystem::path &wal_directory, uint64_t snapshot_retention_count,
                     utils::SkipList<Vertex> *vertices, utils::SkipList<Edge> *edges, NameIdMapper *name_id_mapper,
                     Indices *indices, Constraints *constraints, const Config &config, const std::string &uuid,
                     std::string_view epoch_id, const std::deque<std::pair<std::string, uint64_t>> &epoch_history,
-                    utils::FileRetainer *file_retainer);
+                    utils::FileRetainer *file_retainer, SnapshotProgress *progress = nullptr,
+                    std::optional<uint64_t> replica_commit_timestamp = std::nullopt);
 
 }  // namespace memgraph::storage::durability
@@ -19,6 +19,14 @@ enum class StorageGlobalOperation {
   LABEL_INDEX_DROP,
   LABEL_PROPERTY_INDEX_CREATE,
   LABEL_PROPERTY_INDEX_DROP,
+  LABEL_PROPERTY_COMPOSITE_INDEX_CREATE,
+  LABEL_PROPERTY_COMPOSITE_INDEX_DROP,
+  TEXT_INDEX_CREATE,
+  TEXT_INDEX_DROP,
+  VECTOR_INDEX_CREATE,
+  VECTOR_INDEX_DROP,
+  AGGREGATE_INDEX_CREATE,
+  AGGREGATE_INDEX_DROP,
   EXISTENCE_CONSTRAINT_CREATE,
   EXISTENCE_CONSTRAINT_DROP,
   UNIQUE_CONSTRAINT_CREATE,
@@ -11,14 +11,29 @@
 
 #include "storage/v2/durability/wal.hpp"
 
+#include <cstring>
+#include <thread>
+
+
 #include "storage/v2/delta.hpp"
 #include "storage/v2/durability/exceptions.hpp"
 #include "storage/v2/durability/paths.hpp"
 #include "storage/v2/durability/version.hpp"
 #include "storage/v2/edge.hpp"
 #include "storage/v2/vertex.hpp"
+#include "utils/endian.hpp"
+#include "utils/event_histogram.hpp"
 #include "utils/file_locker.hpp"
 #include "utils/logging.hpp"
+#include "utils/spin_lock.hpp"
+#include "utils/synchronized.hpp"
+#include "utils/timer.hpp"
+#include "utils/tracepoint.hpp"
+#include "utils/uuid.hpp"
+
+namespace memgraph::metrics {
+extern const Event WalFsyncLatency_us;
+}  // namespace memgraph::metrics
 
 namespace memgraph::storage::durability {
 
@@ -63,12 +78,21 @@ namespace memgraph::storage::durability {
 //         * label index create, label index drop
 //              * label name
 //         * label property index create, label property index drop,
-//           existence constraint create, existence constraint drop
+//           existence constraint create, existence constraint drop,
+//           text index create, text index drop, vector index create,
+//           vector index drop
 //              * label name
 //              * property name
 //         * unique constraint create, unique constraint drop
 //              * label name
 //              * property names
+//         * composite label property index create, composite label property
+//           index drop
+//              * label name
+//              * property names (in the order in which they are indexed)
+//         * aggregate index create, aggregate index drop
+//              * label name
+//              * property names (the group property and the value property)
 //
 // IMPORTANT: When changing WAL encoding/decoding bump the snapshot/WAL version
 // in `version.hpp`.
@@ -93,6 +117,22 @@ Marker OperationToMarker(StorageGlobalOperation operation) {
       return Marker::DELTA_UNIQUE_CONSTRAINT_CREATE;
     case StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP:
       return Marker::DELTA_UNIQUE_CONSTRAINT_DROP;
+    case StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+      return Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_CREATE;
+    case StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+      return Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_DROP;
+    case StorageGlobalOperation::TEXT_INDEX_CREATE:
+      return Marker::DELTA_TEXT_INDEX_CREATE;
+    case StorageGlobalOperation::TEXT_INDEX_DROP:
+      return Marker::DELTA_TEXT_INDEX_DROP;
+    case StorageGlobalOperation::VECTOR_INDEX_CREATE:
+      return Marker::DELTA_VECTOR_INDEX_CREATE;
+    case StorageGlobalOperation::VECTOR_INDEX_DROP:
+      return Marker::DELTA_VECTOR_INDEX_DROP;
+    case StorageGlobalOperation::AGGREGATE_INDEX_CREATE:
+      return Marker::DELTA_AGGREGATE_INDEX_CREATE;
+    case StorageGlobalOperation::AGGREGATE_INDEX_DROP:
+      return Marker::DELTA_AGGREGATE_INDEX_DROP;
   }
 }
 
@@ -162,6 +202,22 @@ WalDeltaData::Type MarkerToWalDeltaDataType(Marker marker) {
       return WalDeltaData::Type::UNIQUE_CONSTRAINT_CREATE;
     case Marker::DELTA_UNIQUE_CONSTRAINT_DROP:
       return WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP;
+    case Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+      return WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE;
+    case Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+      return WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_DROP;
+    case Marker::DELTA_TEXT_INDEX_CREATE:
+      return WalDeltaData::Type::TEXT_INDEX_CREATE;
+    case Marker::DELTA_TEXT_INDEX_DROP:
+      return WalDeltaData::Type::TEXT_INDEX_DROP;
+    case Marker::DELTA_VECTOR_INDEX_CREATE:
+      return WalDeltaData::Type::VECTOR_INDEX_CREATE;
+    case Marker::DELTA_VECTOR_INDEX_DROP:
+      return WalDeltaData::Type::VECTOR_INDEX_DROP;
+    case Marker::DELTA_AGGREGATE_INDEX_CREATE:
+      return WalDeltaData::Type::AGGREGATE_INDEX_CREATE;
+    case Marker::DELTA_AGGREGATE_INDEX_DROP:
+      return WalDeltaData::Type::AGGREGATE_INDEX_DROP;
 
     case Marker::TYPE_NULL:
     case Marker::TYPE_BOOL:
@@ -276,7 +332,11 @@ WalDeltaData ReadSkipWalDeltaData(BaseDecoder *decoder) {
     case WalDeltaData::Type::LABEL_PROPERTY_INDEX_CREATE:
     case WalDeltaData::Type::LABEL_PROPERTY_INDEX_DROP:
     case WalDeltaData::Type::EXISTENCE_CONSTRAINT_CREATE:
-    case WalDeltaData::Type::EXISTENCE_CONSTRAINT_DROP: {
+    case WalDeltaData::Type::EXISTENCE_CONSTRAINT_DROP:
+    case WalDeltaData::Type::TEXT_INDEX_CREATE:
+    case WalDeltaData::Type::TEXT_INDEX_DROP:
+    case WalDeltaData::Type::VECTOR_INDEX_CREATE:
+    case WalDeltaData::Type::VECTOR_INDEX_DROP: {
       if constexpr (read_data) {
         auto label = decoder->ReadString();
         if (!label) throw RecoveryFailure("Invalid WAL data!");
@@ -310,6 +370,33 @@ WalDeltaData ReadSkipWalDeltaData(BaseDecoder *decoder) {
           if (!decoder->SkipString()) throw RecoveryFailure("Invalid WAL data!");
         }
       }
+      break;
+    }
+    case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+    case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+    case WalDeltaData::Type::AGGREGATE_INDEX_CREATE:
+    case WalDeltaData::Type::AGGREGATE_INDEX_DROP: {
+      if constexpr (read_data) {
+        auto label = decoder->ReadString();
+        if (!label) throw RecoveryFailure("Invalid WAL data!");
+        delta.operation_label_property_list.label = std::move(*label);
+        auto properties_count = decoder->ReadUint();
+        if (!properties_count) throw RecoveryFailure("Invalid WAL data!");
+        delta.operation_label_property_list.properties.reserve(*properties_count);
+        for (uint64_t i = 0; i < *properties_count; ++i) {
+          auto property = decoder->ReadString();
+          if (!property) throw RecoveryFailure("Invalid WAL data!");
+          delta.operation_label_property_list.properties.push_back(std::move(*property));
+        }
+      } else {
+        if (!decoder->SkipString()) throw RecoveryFailure("Invalid WAL data!");
+        auto properties_count = decoder->ReadUint();
+        if (!properties_count) throw RecoveryFailure("Invalid WAL data!");
+        for (uint64_t i = 0; i < *properties_count; ++i) {
+          if (!decoder->SkipString()) throw RecoveryFailure("Invalid WAL data!");
+        }
+      }
+      break;
     }
   }
 
@@ -451,12 +538,22 @@ bool operator==(const WalDeltaData &a, const WalDeltaData &b) {
     case WalDeltaData::Type::LABEL_PROPERTY_INDEX_DROP:
     case WalDeltaData::Type::EXISTENCE_CONSTRAINT_CREATE:
     case WalDeltaData::Type::EXISTENCE_CONSTRAINT_DROP:
+    case WalDeltaData::Type::TEXT_INDEX_CREATE:
+    case WalDeltaData::Type::TEXT_INDEX_DROP:
+    case WalDeltaData::Type::VECTOR_INDEX_CREATE:
+    case WalDeltaData::Type::VECTOR_INDEX_DROP:
       return a.operation_label_property.label == b.operation_label_property.label &&
              a.operation_label_property.property == b.operation_label_property.property;
     case WalDeltaData::Type::UNIQUE_CONSTRAINT_CREATE:
     case WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP:
       return a.operation_label_properties.label == b.operation_label_properties.label &&
              a.operation_label_properties.properties == b.operation_label_properties.properties;
+    case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+    case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+    case WalDeltaData::Type::AGGREGATE_INDEX_CREATE:
+    case WalDeltaData::Type::AGGREGATE_INDEX_DROP:
+      return a.operation_label_property_list.label == b.operation_label_property_list.label &&
+             a.operation_label_property_list.properties == b.operation_label_property_list.properties;
   }
 }
 bool operator!=(const WalDeltaData &a, const WalDeltaData &b) { return !(a == b); }
@@ -490,7 +587,7 @@ void EncodeDelta(BaseEncoder *encoder, NameIdMapper *name_id_mapper, Config::Ite
   // actions.
   encoder->WriteMarker(Marker::SECTION_DELTA);
   encoder->WriteUint(timestamp);
-  std::lock_guard<utils::SpinLock> guard(vertex.lock);
+  std::lock_guard guard(vertex.lock);
   switch (delta.action) {
     case Delta::Action::DELETE_DESERIALIZED_OBJECT:
     case Delta::Action::DELETE_OBJECT:
@@ -521,7 +618,7 @@ void EncodeDelta(BaseEncoder *encoder, NameIdMapper *name_id_mapper, Config::Ite
     case Delta::Action::ADD_OUT_EDGE:
     case Delta::Action::REMOVE_OUT_EDGE: {
       encoder->WriteMarker(VertexActionToMarker(delta.action));
-      if (items.properties_on_edges) {
+      if (items.EdgeRefsArePointers()) {
         encoder->WriteUint(delta.vertex_edge.edge.ptr->gid.AsUint());
       } else {
         encoder->WriteUint(delta.vertex_edge.edge.gid.AsUint());
@@ -546,7 +643,7 @@ void EncodeDelta(BaseEncoder *encoder, NameIdMapper *name_id_mapper, const Delta
   // actions.
   encoder->WriteMarker(Marker::SECTION_DELTA);
   encoder->WriteUint(timestamp);
-  std::lock_guard<utils::SpinLock> guard(edge.lock);
+  std::lock_guard guard(edge.lock);
   switch (delta.action) {
     case Delta::Action::SET_PROPERTY: {
       encoder->WriteMarker(Marker::DELTA_EDGE_SET_PROPERTY);
@@ -585,8 +682,23 @@ void EncodeTransactionEnd(BaseEncoder *encoder, uint64_t timestamp) {
   encoder->WriteMarker(Marker::DELTA_TRANSACTION_END);
 }
 
+void EncodedDeltas::SetTimestamp(uint64_t timestamp) {
+  // The header is the section marker followed by the timestamp, which the WAL
+  // and the replication encoders both write as the type marker and 8 bytes in
+  // little endian.
+  constexpr uint64_t kTimestampOffset = 2;
+  timestamp = utils::HostToLittleEndian(timestamp);
+  for (const auto header : headers) {
+    MG_ASSERT(header + kTimestampOffset + sizeof(timestamp) <= data.size() &&
+                  data[header] == static_cast<uint8_t>(Marker::SECTION_DELTA) &&
+                  data[header + 1] == static_cast<uint8_t>(Marker::TYPE_INT),
+              "Invalid encoded delta!");
+    std::memcpy(data.data() + header + kTimestampOffset, &timestamp, sizeof(timestamp));
+  }
+}
+
 void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, StorageGlobalOperation operation,
-                     LabelId label, const std::set<PropertyId> &properties, uint64_t timestamp) {
+                     LabelId label, const std::vector<PropertyId> &properties, uint64_t timestamp) {
   encoder->WriteMarker(Marker::SECTION_DELTA);
   encoder->WriteUint(timestamp);
   switch (operation) {
@@ -600,7 +712,11 @@ void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, Storage
     case StorageGlobalOperation::LABEL_PROPERTY_INDEX_CREATE:
     case StorageGlobalOperation::LABEL_PROPERTY_INDEX_DROP:
     case StorageGlobalOperation::EXISTENCE_CONSTRAINT_CREATE:
-    case StorageGlobalOperation::EXISTENCE_CONSTRAINT_DROP: {
+    case StorageGlobalOperation::EXISTENCE_CONSTRAINT_DROP:
+    case StorageGlobalOperation::TEXT_INDEX_CREATE:
+    case StorageGlobalOperation::TEXT_INDEX_DROP:
+    case StorageGlobalOperation::VECTOR_INDEX_CREATE:
+    case StorageGlobalOperation::VECTOR_INDEX_DROP: {
       MG_ASSERT(properties.size() == 1, "Invalid function call!");
       encoder->WriteMarker(OperationToMarker(operation));
       encoder->WriteString(name_id_mapper->IdToName(label.AsUint()));
@@ -608,7 +724,11 @@ void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, Storage
       break;
     }
     case StorageGlobalOperation::UNIQUE_CONSTRAINT_CREATE:
-    case StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP: {
+    case StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP:
+    case StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+    case StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+    case StorageGlobalOperation::AGGREGATE_INDEX_CREATE:
+    case StorageGlobalOperation::AGGREGATE_INDEX_DROP: {
       MG_ASSERT(!properties.empty(), "Invalid function call!");
       encoder->WriteMarker(OperationToMarker(operation));
       encoder->WriteString(name_id_mapper->IdToName(label.AsUint()));
@@ -621,6 +741,309 @@ void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, Storage
   }
 }
 
+namespace {
+
+// Applies a single WAL delta to the storage.
+// @throw RecoveryFailure
+void ApplyWalDelta(const WalDeltaData &delta, RecoveredIndicesAndConstraints *indices_constraints,
+                   utils::SkipList<Vertex>::Accessor &vertex_acc, utils::SkipList<Edge>::Accessor &edge_acc,
+                   NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, Config::Items items,
+                   RecoveryInfo *ret) {
+  switch (delta.type) {
+    case WalDeltaData::Type::VERTEX_CREATE: {
+      auto [vertex, inserted] = vertex_acc.insert(Vertex{delta.vertex_create_delete.gid, nullptr});
+      if (!inserted) throw RecoveryFailure("The vertex must be inserted here!");
+
+      ret->next_vertex_id = std::max(ret->next_vertex_id, delta.vertex_create_delete.gid.AsUint() + 1);
+
+      break;
+    }
+    case WalDeltaData::Type::VERTEX_DELETE: {
+      auto vertex = vertex_acc.find(delta.vertex_create_delete.gid);
+      if (vertex == vertex_acc.end()) throw RecoveryFailure("The vertex doesn't exist!");
+      if (!vertex->in_edges.empty() || !vertex->out_edges.empty())
+        throw RecoveryFailure("The vertex can't be deleted because it still has edges!");
+
+      if (!vertex_acc.remove(delta.vertex_create_delete.gid))
+        throw RecoveryFailure("The vertex must be removed here!");
+
+      break;
+    }
+    case WalDeltaData::Type::VERTEX_ADD_LABEL:
+    case WalDeltaData::Type::VERTEX_REMOVE_LABEL: {
+      auto vertex = vertex_acc.find(delta.vertex_add_remove_label.gid);
+      if (vertex == vertex_acc.end()) throw RecoveryFailure("The vertex doesn't exist!");
+
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.vertex_add_remove_label.label));
+      auto it = std::find(vertex->labels.begin(), vertex->labels.end(), label_id);
+
+      if (delta.type == WalDeltaData::Type::VERTEX_ADD_LABEL) {
+        if (it != vertex->labels.end()) throw RecoveryFailure("The vertex already has the label!");
+        vertex->labels.push_back(label_id);
+      } else {
+        if (it == vertex->labels.end()) throw RecoveryFailure("The vertex doesn't have the label!");
+        std::swap(*it, vertex->labels.back());
+        vertex->labels.pop_back();
+      }
+
+      break;
+    }
+    case WalDeltaData::Type::VERTEX_SET_PROPERTY: {
+      auto vertex = vertex_acc.find(delta.vertex_edge_set_property.gid);
+      if (vertex == vertex_acc.end()) throw RecoveryFailure("The vertex doesn't exist!");
+
+      auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.vertex_edge_set_property.property));
+      auto &property_value = delta.vertex_edge_set_property.value;
+
+      vertex->properties.SetProperty(property_id, property_value);
+
+      break;
+    }
+    case WalDeltaData::Type::EDGE_CREATE: {
+      auto from_vertex = vertex_acc.find(delta.edge_create_delete.from_vertex);
+      if (from_vertex == vertex_acc.end()) throw RecoveryFailure("The from vertex doesn't exist!");
+      auto to_vertex = vertex_acc.find(delta.edge_create_delete.to_vertex);
+      if (to_vertex == vertex_acc.end()) throw RecoveryFailure("The to vertex doesn't exist!");
+
+      auto edge_gid = delta.edge_create_delete.gid;
+      auto edge_type_id = EdgeTypeId::FromUint(name_id_mapper->NameToId(delta.edge_create_delete.edge_type));
+      EdgeRef edge_ref(edge_gid);
+      if (items.EdgeRefsArePointers()) {
+        auto [edge, inserted] = edge_acc.insert(Edge{edge_gid, nullptr});
+        if (!inserted) throw RecoveryFailure("The edge must be inserted here!");
+        edge_ref = EdgeRef(&*edge);
+      }
+      {
+        std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*to_vertex, edge_ref};
+        if (from_vertex->out_edges.contains(link)) throw RecoveryFailure("The from vertex already has this edge!");
+        from_vertex->out_edges.push_back(link);
+      }
+      {
+        std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*from_vertex, edge_ref};
+        if (to_vertex->in_edges.contains(link)) throw RecoveryFailure("The to vertex already has this edge!");
+        to_vertex->in_edges.push_back(link);
+      }
+
+      ret->next_edge_id = std::max(ret->next_edge_id, edge_gid.AsUint() + 1);
+
+      // Increment edge count.
+      edge_count->fetch_add(1, std::memory_order_acq_rel);
+
+      break;
+    }
+    case WalDeltaData::Type::EDGE_DELETE: {
+      auto from_vertex = vertex_acc.find(delta.edge_create_delete.from_vertex);
+      if (from_vertex == vertex_acc.end()) throw RecoveryFailure("The from vertex doesn't exist!");
+      auto to_vertex = vertex_acc.find(delta.edge_create_delete.to_vertex);
+      if (to_vertex == vertex_acc.end()) throw RecoveryFailure("The to vertex doesn't exist!");
+
+      auto edge_gid = delta.edge_create_delete.gid;
+      auto edge_type_id = EdgeTypeId::FromUint(name_id_mapper->NameToId(delta.edge_create_delete.edge_type));
+      EdgeRef edge_ref(edge_gid);
+      if (items.EdgeRefsArePointers()) {
+        auto edge = edge_acc.find(edge_gid);
+        if (edge == edge_acc.end()) throw RecoveryFailure("The edge doesn't exist!");
+        edge_ref = EdgeRef(&*edge);
+      }
+      {
+        std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*to_vertex, edge_ref};
+        if (!from_vertex->out_edges.erase(link)) throw RecoveryFailure("The from vertex doesn't have this edge!");
+      }
+      {
+        std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*from_vertex, edge_ref};
+        if (!to_vertex->in_edges.erase(link)) throw RecoveryFailure("The to vertex doesn't have this edge!");
+      }
+      if (items.EdgeRefsArePointers()) {
+        if (!edge_acc.remove(edge_gid)) throw RecoveryFailure("The edge must be removed here!");
+      } else if (items.properties_on_edges) {
+        // A light edge only has an object if a property was set on it.
+        edge_acc.remove(edge_gid);
+      }
+
+      // Decrement edge count.
+      edge_count->fetch_add(-1, std::memory_order_acq_rel);
+
+      break;
+    }
+    case WalDeltaData::Type::EDGE_SET_PROPERTY: {
+      if (!items.properties_on_edges)
+        throw RecoveryFailure(
+            "The WAL has properties on edges, but the storage is "
+            "configured without properties on edges!");
+      auto edge = edge_acc.find(delta.vertex_edge_set_property.gid);
+      if (items.light_edges && edge == edge_acc.end()) {
+        // The light edge gets its object when the first property is set on it.
+        edge = edge_acc.insert(Edge{delta.vertex_edge_set_property.gid, nullptr}).first;
+      }
+      if (edge == edge_acc.end()) throw RecoveryFailure("The edge doesn't exist!");
+      auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.vertex_edge_set_property.property));
+      auto &property_value = delta.vertex_edge_set_property.value;
+      edge->properties.SetProperty(property_id, property_value);
+      break;
+    }
+    case WalDeltaData::Type::TRANSACTION_END:
+      break;
+    case WalDeltaData::Type::LABEL_INDEX_CREATE: {
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label.label));
+      AddRecoveredIndexConstraint(&indices_constraints->indices.label, label_id, "The label index already exists!");
+      break;
+    }
+    case WalDeltaData::Type::LABEL_INDEX_DROP: {
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label.label));
+      RemoveRecoveredIndexConstraint(&indices_constraints->indices.label, label_id,
+                                     "The label index doesn't exist!");
+      break;
+    }
+    case WalDeltaData::Type::LABEL_PROPERTY_INDEX_CREATE: {
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
+      auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
+      AddRecoveredIndexConstraint(&indices_constraints->indices.label_property, {label_id, property_id},
+                                  "The label property index already exists!");
+      break;
+    }
+    case WalDeltaData::Type::LABEL_PROPERTY_INDEX_DROP: {
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
+      auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
+      RemoveRecoveredIndexConstraint(&indices_constraints->indices.label_property, {label_id, property_id},
+                                     "The label property index doesn't exist!");
+      break;
+    }
+    case WalDeltaData::Type::EXISTENCE_CONSTRAINT_CREATE: {
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
+      auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
+      AddRecoveredIndexConstraint(&indices_constraints->constraints.existence, {label_id, property_id},
+                                  "The existence constraint already exists!");
+      break;
+    }
+    case WalDeltaData::Type::EXISTENCE_CONSTRAINT_DROP: {
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
+      auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
+      RemoveRecoveredIndexConstraint(&indices_constraints->constraints.existence, {label_id, property_id},
+                                     "The existence constraint doesn't exist!");
+      break;
+    }
+    case WalDeltaData::Type::UNIQUE_CONSTRAINT_CREATE: {
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_properties.label));
+      std::set<PropertyId> property_ids;
+      for (const auto &prop : delta.operation_label_properties.properties) {
+        property_ids.insert(PropertyId::FromUint(name_id_mapper->NameToId(prop)));
+      }
+      AddRecoveredIndexConstraint(&indices_constraints->constraints.unique, {label_id, property_ids},
+                                  "The unique constraint already exists!");
+      break;
+    }
+    case WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP: {
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_properties.label));
+      std::set<PropertyId> property_ids;
+      for (const auto &prop : delta.operation_label_properties.properties) {
+        property_ids.insert(PropertyId::FromUint(name_id_mapper->NameToId(prop)));
+      }
+      RemoveRecoveredIndexConstraint(&indices_constraints->constraints.unique, {label_id, property_ids},
+                                     "The unique constraint doesn't exist!");
+      break;
+    }
+    case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE: {
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property_list.label));
+      std::vector<PropertyId> property_ids;
+      for (const auto &prop : delta.operation_label_property_list.properties) {
+        property_ids.push_back(PropertyId::FromUint(name_id_mapper->NameToId(prop)));
+      }
+      AddRecoveredIndexConstraint(&indices_constraints->indices.label_property_composite, {label_id, property_ids},
+                                  "The composite label property index already exists!");
+      break;
+    }
+    case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_DROP: {
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property_list.label));
+      std::vector<PropertyId> property_ids;
+      for (const auto &prop : delta.operation_label_property_list.properties) {
+        property_ids.push_back(PropertyId::FromUint(name_id_mapper->NameToId(prop)));
+      }
+      RemoveRecoveredIndexConstraint(&indices_constraints->indices.label_property_composite,
+                                     {label_id, property_ids},
+                                     "The composite label property index doesn't exist!");
+      break;
+    }
+    case WalDeltaData::Type::TEXT_INDEX_CREATE: {
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
+      auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
+      AddRecoveredIndexConstraint(&indices_constraints->indices.text, {label_id, property_id},
+                                  "The text index already exists!");
+      break;
+    }
+    case WalDeltaData::Type::TEXT_INDEX_DROP: {
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
+      auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
+      RemoveRecoveredIndexConstraint(&indices_constraints->indices.text, {label_id, property_id},
+                                     "The text index doesn't exist!");
+      break;
+    }
+    case WalDeltaData::Type::VECTOR_INDEX_CREATE: {
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
+      auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
+      AddRecoveredIndexConstraint(&indices_constraints->indices.vector, {label_id, property_id},
+                                  "The vector index already exists!");
+      break;
+    }
+    case WalDeltaData::Type::VECTOR_INDEX_DROP: {
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
+      auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
+      RemoveRecoveredIndexConstraint(&indices_constraints->indices.vector, {label_id, property_id},
+                                     "The vector index doesn't exist!");
+      break;
+    }
+    case WalDeltaData::Type::AGGREGATE_INDEX_CREATE: {
+      const auto &properties = delta.operation_label_property_list.properties;
+      if (properties.size() != 2) throw RecoveryFailure("Invalid WAL data!");
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property_list.label));
+      auto group_property_id = PropertyId::FromUint(name_id_mapper->NameToId(properties[0]));
+      auto value_property_id = PropertyId::FromUint(name_id_mapper->NameToId(properties[1]));
+      AddRecoveredIndexConstraint(&indices_constraints->indices.aggregate,
+                                  {label_id, group_property_id, value_property_id},
+                                  "The aggregate index already exists!");
+      break;
+    }
+    case WalDeltaData::Type::AGGREGATE_INDEX_DROP: {
+      const auto &properties = delta.operation_label_property_list.properties;
+      if (properties.size() != 2) throw RecoveryFailure("Invalid WAL data!");
+      auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property_list.label));
+      auto group_property_id = PropertyId::FromUint(name_id_mapper->NameToId(properties[0]));
+      auto value_property_id = PropertyId::FromUint(name_id_mapper->NameToId(properties[1]));
+      RemoveRecoveredIndexConstraint(&indices_constraints->indices.aggregate,
+                                     {label_id, group_property_id, value_property_id},
+                                     "The aggregate index doesn't exist!");
+      break;
+    }
+  }
+}
+
+// Whether the delta changes only the object it belongs to, in which case the
+// deltas of different objects can be applied independently.
+bool IsObjectLocalDelta(const WalDeltaData &delta) {
+  switch (delta.type) {
+    case WalDeltaData::Type::VERTEX_ADD_LABEL:
+    case WalDeltaData::Type::VERTEX_REMOVE_LABEL:
+    case WalDeltaData::Type::VERTEX_SET_PROPERTY:
+    case WalDeltaData::Type::EDGE_SET_PROPERTY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsDeleteDelta(const WalDeltaData &delta) {
+  return delta.type == WalDeltaData::Type::VERTEX_DELETE || delta.type == WalDeltaData::Type::EDGE_DELETE;
+}
+
+// The gid of the object that an object local delta changes.
+Gid ObjectLocalDeltaGid(const WalDeltaData &delta) {
+  if (delta.type == WalDeltaData::Type::VERTEX_ADD_LABEL || delta.type == WalDeltaData::Type::VERTEX_REMOVE_LABEL) {
+    return delta.vertex_add_remove_label.gid;
+  }
+  return delta.vertex_edge_set_property.gid;
+}
+
+}  // namespace
+
 RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConstraints *indices_constraints,
                      const std::optional<uint64_t> last_loaded_timestamp, utils::SkipList<Vertex> *vertices,
                      utils::SkipList<Edge> *edges, NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count,
@@ -656,218 +1079,173 @@ RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConst
     if (!last_loaded_timestamp || timestamp > *last_loaded_timestamp) {
       // This delta should be loaded.
       auto delta = ReadWalDeltaData(&wal);
-      switch (delta.type) {
-        case WalDeltaData::Type::VERTEX_CREATE: {
-          auto [vertex, inserted] = vertex_acc.insert(Vertex{delta.vertex_create_delete.gid, nullptr});
-          if (!inserted) throw RecoveryFailure("The vertex must be inserted here!");
+      ApplyWalDelta(delta, indices_constraints, vertex_acc, edge_acc, name_id_mapper, edge_count, items, &ret);
+      ret.next_timestamp = std::max(ret.next_timestamp, timestamp + 1);
+      ++deltas_applied;
+    } else {
+      // This delta should be skipped.
+      SkipWalDeltaData(&wal);
+    }
+  }
 
-          ret.next_vertex_id = std::max(ret.next_vertex_id, delta.vertex_create_delete.gid.AsUint() + 1);
+  spdlog::info("Applied {} deltas from WAL. Skipped {} deltas, because they were too old.", deltas_applied,
+               info.num_deltas - deltas_applied);
 
-          break;
-        }
-        case WalDeltaData::Type::VERTEX_DELETE: {
-          auto vertex = vertex_acc.find(delta.vertex_create_delete.gid);
-          if (vertex == vertex_acc.end()) throw RecoveryFailure("The vertex doesn't exist!");
-          if (!vertex->in_edges.empty() || !vertex->out_edges.empty())
-            throw RecoveryFailure("The vertex can't be deleted because it still has edges!");
+  return ret;
+}
 
-          if (!vertex_acc.remove(delta.vertex_create_delete.gid))
-            throw RecoveryFailure("The vertex must be removed here!");
+WalDeltas ReadWalDeltas(const std::filesystem::path &path, const std::optional<uint64_t> last_loaded_timestamp) {
+  WalDeltas ret;
 
-          break;
-        }
-        case WalDeltaData::Type::VERTEX_ADD_LABEL:
-        case WalDeltaData::Type::VERTEX_REMOVE_LABEL: {
-          auto vertex = vertex_acc.find(delta.vertex_add_remove_label.gid);
-          if (vertex == vertex_acc.end()) throw RecoveryFailure("The vertex doesn't exist!");
-
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.vertex_add_remove_label.label));
-          auto it = std::find(vertex->labels.begin(), vertex->labels.end(), label_id);
-
-          if (delta.type == WalDeltaData::Type::VERTEX_ADD_LABEL) {
-            if (it != vertex->labels.end()) throw RecoveryFailure("The vertex already has the label!");
-            vertex->labels.push_back(label_id);
-          } else {
-            if (it == vertex->labels.end()) throw RecoveryFailure("The vertex doesn't have the label!");
-            std::swap(*it, vertex->labels.back());
-            vertex->labels.pop_back();
-          }
+  Decoder wal;
+  auto version = wal.Initialize(path, kWalMagic);
+  if (!version) throw RecoveryFailure("Couldn't read WAL magic and/or version!");
+  if (!IsVersionSupported(*version)) throw RecoveryFailure("Invalid WAL version!");
 
-          break;
-        }
-        case WalDeltaData::Type::VERTEX_SET_PROPERTY: {
-          auto vertex = vertex_acc.find(delta.vertex_edge_set_property.gid);
-          if (vertex == vertex_acc.end()) throw RecoveryFailure("The vertex doesn't exist!");
+  ret.info = ReadWalInfo(path);
+  if (last_loaded_timestamp && ret.info.to_timestamp <= *last_loaded_timestamp) {
+    ret.skipped = ret.info.num_deltas;
+    return ret;
+  }
 
-          auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.vertex_edge_set_property.property));
-          auto &property_value = delta.vertex_edge_set_property.value;
+  wal.SetPosition(ret.info.offset_deltas);
+  ret.deltas.reserve(ret.info.num_deltas);
+  for (uint64_t i = 0; i < ret.info.num_deltas; ++i) {
+    auto timestamp = ReadWalDeltaHeader(&wal);
+    if (!last_loaded_timestamp || timestamp > *last_loaded_timestamp) {
+      ret.deltas.emplace_back(timestamp, ReadWalDeltaData(&wal));
+    } else {
+      SkipWalDeltaData(&wal);
+      ++ret.skipped;
+    }
+  }
+  return ret;
+}
 
-          vertex->properties.SetProperty(property_id, property_value);
+RecoveryInfo ApplyWalDeltas(const WalDeltas &wal, RecoveredIndicesAndConstraints *indices_constraints,
+                            utils::SkipList<Vertex> *vertices, utils::SkipList<Edge> *edges,
+                            NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, Config::Items items,
+                            uint64_t thread_count) {
+  spdlog::info("Applying {} deltas from WAL file {}.", wal.deltas.size(), wal.info.seq_num);
+  RecoveryInfo ret;
+  ret.last_commit_timestamp = wal.info.to_timestamp;
+  if (wal.deltas.empty()) return ret;
+
+  // The deltas are applied in three passes. Creating objects and the
+  // operations go first, then the label and property changes and the deletions
+  // last. Gids are never reused, so every object exists during the second pass
+  // and doesn't have any edges left when it's deleted in the third one. The
+  // second pass is done on multiple threads, each of them applying the
+  // changes of the objects whose gids belong to it, in the WAL order.
+  {
+    auto vertex_acc = vertices->access();
+    auto edge_acc = edges->access();
+    for (const auto &[timestamp, delta] : wal.deltas) {
+      ret.next_timestamp = std::max(ret.next_timestamp, timestamp + 1);
+      if (IsObjectLocalDelta(delta) || IsDeleteDelta(delta)) continue;
+      ApplyWalDelta(delta, indices_constraints, vertex_acc, edge_acc, name_id_mapper, edge_count, items, &ret);
+    }
+  }
 
-          break;
-        }
-        case WalDeltaData::Type::EDGE_CREATE: {
-          auto from_vertex = vertex_acc.find(delta.edge_create_delete.from_vertex);
-          if (from_vertex == vertex_acc.end()) throw RecoveryFailure("The from vertex doesn't exist!");
-          auto to_vertex = vertex_acc.find(delta.edge_create_delete.to_vertex);
-          if (to_vertex == vertex_acc.end()) throw RecoveryFailure("The to vertex doesn't exist!");
-
-          auto edge_gid = delta.edge_create_delete.gid;
-          auto edge_type_id = EdgeTypeId::FromUint(name_id_mapper->NameToId(delta.edge_create_delete.edge_type));
-          EdgeRef edge_ref(edge_gid);
-          if (items.properties_on_edges) {
-            auto [edge, inserted] = edge_acc.insert(Edge{edge_gid, nullptr});
-            if (!inserted) throw RecoveryFailure("The edge must be inserted here!");
-            edge_ref = EdgeRef(&*edge);
-          }
-          {
-            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*to_vertex, edge_ref};
-            auto it = std::find(from_vertex->out_edges.begin(), from_vertex->out_edges.end(), link);
-            if (it != from_vertex->out_edges.end()) throw RecoveryFailure("The from vertex already has this edge!");
-            from_vertex->out_edges.push_back(link);
-          }
-          {
-            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*from_vertex, edge_ref};
-            auto it = std::find(to_vertex->in_edges.begin(), to_vertex->in_edges.end(), link);
-            if (it != to_vertex->in_edges.end()) throw RecoveryFailure("The to vertex already has this edge!");
-            to_vertex->in_edges.push_back(link);
+  thread_count = std::max<uint64_t>(thread_count, 1);
+  utils::Synchronized<std::optional<RecoveryFailure>, utils::SpinLock> maybe_error{};
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(thread_count);
+    for (uint64_t thread_id = 0; thread_id < thread_count; ++thread_id) {
+      threads.emplace_back([&, thread_id]() {
+        auto vertex_acc = vertices->access();
+        auto edge_acc = edges->access();
+        // Only the creation deltas touch the recovery info.
+        RecoveryInfo unused;
+        try {
+          for (const auto &[timestamp, delta] : wal.deltas) {
+            if (!IsObjectLocalDelta(delta) || ObjectLocalDeltaGid(delta).AsUint() % thread_count != thread_id) {
+              continue;
+            }
+            ApplyWalDelta(delta, indices_constraints, vertex_acc, edge_acc, name_id_mapper, edge_count, items,
+                          &unused);
           }
-
-          ret.next_edge_id = std::max(ret.next_edge_id, edge_gid.AsUint() + 1);
-
-          // Increment edge count.
-          edge_count->fetch_add(1, std::memory_order_acq_rel);
-
-          break;
+        } catch (RecoveryFailure &failure) {
+          *maybe_error.Lock() = std::move(failure);
         }
-        case WalDeltaData::Type::EDGE_DELETE: {
-          auto from_vertex = vertex_acc.find(delta.edge_create_delete.from_vertex);
-          if (from_vertex == vertex_acc.end()) throw RecoveryFailure("The from vertex doesn't exist!");
-          auto to_vertex = vertex_acc.find(delta.edge_create_delete.to_vertex);
-          if (to_vertex == vertex_acc.end()) throw RecoveryFailure("The to vertex doesn't exist!");
-
-          auto edge_gid = delta.edge_create_delete.gid;
-          auto edge_type_id = EdgeTypeId::FromUint(name_id_mapper->NameToId(delta.edge_create_delete.edge_type));
-          EdgeRef edge_ref(edge_gid);
-          if (items.properties_on_edges) {
-            auto edge = edge_acc.find(edge_gid);
-            if (edge == edge_acc.end()) throw RecoveryFailure("The edge doesn't exist!");
-            edge_ref = EdgeRef(&*edge);
-          }
-          {
-            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*to_vertex, edge_ref};
-            auto it = std::find(from_vertex->out_edges.begin(), from_vertex->out_edges.end(), link);
-            if (it == from_vertex->out_edges.end()) throw RecoveryFailure("The from vertex doesn't have this edge!");
-            std::swap(*it, from_vertex->out_edges.back());
-            from_vertex->out_edges.pop_back();
-          }
-          {
-            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*from_vertex, edge_ref};
-            auto it = std::find(to_vertex->in_edges.begin(), to_vertex->in_edges.end(), link);
-            if (it == to_vertex->in_edges.end()) throw RecoveryFailure("The to vertex doesn't have this edge!");
-            std::swap(*it, to_vertex->in_edges.back());
-            to_vertex->in_edges.pop_back();
-          }
-          if (items.properties_on_edges) {
-            if (!edge_acc.remove(edge_gid)) throw RecoveryFailure("The edge must be removed here!");
-          }
+      });
+    }
+  }
+  if (maybe_error.Lock()->has_value()) {
+    throw RecoveryFailure((*maybe_error.Lock())->what());
+  }
 
-          // Decrement edge count.
-          edge_count->fetch_add(-1, std::memory_order_acq_rel);
+  {
+    auto vertex_acc = vertices->access();
+    auto edge_acc = edges->access();
+    for (const auto &[timestamp, delta] : wal.deltas) {
+      if (!IsDeleteDelta(delta)) continue;
+      ApplyWalDelta(delta, indices_constraints, vertex_acc, edge_acc, name_id_mapper, edge_count, items, &ret);
+    }
+  }
 
-          break;
-        }
-        case WalDeltaData::Type::EDGE_SET_PROPERTY: {
-          if (!items.properties_on_edges)
-            throw RecoveryFailure(
-                "The WAL has properties on edges, but the storage is "
-                "configured without properties on edges!");
-          auto edge = edge_acc.find(delta.vertex_edge_set_property.gid);
-          if (edge == edge_acc.end()) throw RecoveryFailure("The edge doesn't exist!");
-          auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.vertex_edge_set_property.property));
-          auto &property_value = delta.vertex_edge_set_property.value;
-          edge->properties.SetProperty(property_id, property_value);
-          break;
-        }
-        case WalDeltaData::Type::TRANSACTION_END:
-          break;
-        case WalDeltaData::Type::LABEL_INDEX_CREATE: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label.label));
-          AddRecoveredIndexConstraint(&indices_constraints->indices.label, label_id, "The label index already exists!");
-          break;
-        }
-        case WalDeltaData::Type::LABEL_INDEX_DROP: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label.label));
-          RemoveRecoveredIndexConstraint(&indices_constraints->indices.label, label_id,
-                                         "The label index doesn't exist!");
-          break;
-        }
-        case WalDeltaData::Type::LABEL_PROPERTY_INDEX_CREATE: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
-          auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
-          AddRecoveredIndexConstraint(&indices_constraints->indices.label_property, {label_id, property_id},
-                                      "The label property index already exists!");
-          break;
-        }
-        case WalDeltaData::Type::LABEL_PROPERTY_INDEX_DROP: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
-          auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
-          RemoveRecoveredIndexConstraint(&indices_constraints->indices.label_property, {label_id, property_id},
-                                         "The label property index doesn't exist!");
-          break;
-        }
-        case WalDeltaData::Type::EXISTENCE_CONSTRAINT_CREATE: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
-          auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
-          AddRecoveredIndexConstraint(&indices_constraints->constraints.existence, {label_id, property_id},
-                                      "The existence constraint already exists!");
-          break;
-        }
-        case WalDeltaData::Type::EXISTENCE_CONSTRAINT_DROP: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
-          auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
-          RemoveRecoveredIndexConstraint(&indices_constraints->constraints.existence, {label_id, property_id},
-                                         "The existence constraint doesn't exist!");
-          break;
-        }
-        case WalDeltaData::Type::UNIQUE_CONSTRAINT_CREATE: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_properties.label));
-          std::set<PropertyId> property_ids;
-          for (const auto &prop : delta.operation_label_properties.properties) {
-            property_ids.insert(PropertyId::FromUint(name_id_mapper->NameToId(prop)));
-          }
-          AddRecoveredIndexConstraint(&indices_constraints->constraints.unique, {label_id, property_ids},
-                                      "The unique constraint already exists!");
-          break;
-        }
-        case WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_properties.label));
-          std::set<PropertyId> property_ids;
-          for (const auto &prop : delta.operation_label_properties.properties) {
-            property_ids.insert(PropertyId::FromUint(name_id_mapper->NameToId(prop)));
-          }
-          RemoveRecoveredIndexConstraint(&indices_constraints->constraints.unique, {label_id, property_ids},
-                                         "The unique constraint doesn't exist!");
-          break;
-        }
-      }
-      ret.next_timestamp = std::max(ret.next_timestamp, timestamp + 1);
-      ++deltas_applied;
+  spdlog::info("Applied {} deltas from WAL. Skipped {} deltas, because they were too old.", wal.deltas.size(),
+               wal.skipped);
+  return ret;
+}
+
+WalSegmentPool::WalSegmentPool(std::filesystem::path directory, uint64_t segment_size, uint64_t segment_count)
+    : directory_(std::move(directory)), segment_size_(segment_size), segment_count_(segment_count) {
+  utils::EnsureDirOrDie(directory_);
+  // The segments left by the previous run are still empty and can be reused.
+  std::error_code error_code;
+  for (const auto &item : std::filesystem::directory_iterator(directory_, error_code)) {
+    std::error_code item_error_code;
+    if (item.is_regular_file() && item.file_size(item_error_code) == 0 && !item_error_code) {
+      segments_.push_back(item.path());
     } else {
-      // This delta should be skipped.
-      SkipWalDeltaData(&wal);
+      utils::DeleteFile(item.path());
     }
   }
+  MG_ASSERT(!error_code, "Couldn't read the WAL segments because of: {}", error_code.message());
+  worker_ = std::jthread([this](const std::stop_token &stop_token) { PrepareSegments(stop_token); });
+}
 
-  spdlog::info("Applied {} deltas from WAL. Skipped {} deltas, because they were too old.", deltas_applied,
-               info.num_deltas - deltas_applied);
+bool WalSegmentPool::TakeSegment(const std::filesystem::path &path) {
+  std::filesystem::path segment;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (segments_.empty()) return false;
+    segment = std::move(segments_.back());
+    segments_.pop_back();
+  }
+  segments_cv_.notify_one();
+  if (!utils::RenamePath(segment, path)) {
+    spdlog::warn("Couldn't use the WAL segment {}.", segment);
+    utils::DeleteFile(segment);
+    return false;
+  }
+  return true;
+}
 
-  return ret;
+void WalSegmentPool::PrepareSegments(const std::stop_token &stop_token) {
+  std::unique_lock<std::mutex> guard(lock_);
+  while (segments_cv_.wait(guard, stop_token, [this] { return segments_.size() < segment_count_; })) {
+    guard.unlock();
+    auto path = directory_ / utils::GenerateUUID();
+    {
+      utils::OutputFile segment;
+      segment.Open(path, utils::OutputFile::Mode::OVERWRITE_EXISTING);
+      if (!segment.Preallocate(segment_size_)) {
+        spdlog::trace("Couldn't preallocate the WAL segment {}.", path);
+      }
+      segment.Sync();
+      segment.Close();
+    }
+    guard.lock();
+    segments_.push_back(std::move(path));
+  }
 }
 
 WalFile::WalFile(const std::filesystem::path &wal_directory, const std::string_view uuid,
                  const std::string_view epoch_id, Config::Items items, NameIdMapper *name_id_mapper, uint64_t seq_num,
-                 utils::FileRetainer *file_retainer)
+                 utils::FileRetainer *file_retainer, WalSegmentPool *segment_pool)
     : items_(items),
       name_id_mapper_(name_id_mapper),
       path_(wal_directory / MakeWalName()),
@@ -880,6 +1258,7 @@ WalFile::WalFile(const std::filesystem::path &wal_directory, const std::string_v
   utils::EnsureDirOrDie(wal_directory);
 
   // Initialize the WAL file.
+  if (segment_pool) segment_pool->TakeSegment(path_);
   wal_.Initialize(path_, kWalMagic, kVersion);
 
   // Write placeholder offsets.
@@ -964,13 +1343,36 @@ void WalFile::AppendTransactionEnd(uint64_t timestamp) {
   UpdateStats(timestamp);
 }
 
-void WalFile::AppendOperation(StorageGlobalOperation operation, LabelId label, const std::set<PropertyId> &properties,
-                              uint64_t timestamp) {
+void WalFile::AppendEncodedDeltas(const EncodedDeltas &deltas, uint64_t timestamp) {
+  wal_.Write(deltas.data.data(), deltas.data.size());
+  for (uint64_t i = 0; i < deltas.headers.size(); ++i) {
+    UpdateStats(timestamp);
+  }
+}
+
+void WalFile::AppendOperation(StorageGlobalOperation operation, LabelId label,
+                              const std::vector<PropertyId> &properties, uint64_t timestamp) {
   EncodeOperation(&wal_, name_id_mapper_, operation, label, properties, timestamp);
   UpdateStats(timestamp);
 }
 
-void WalFile::Sync() { wal_.Sync(); }
+void WalFile::Sync() {
+  MG_TRACEPOINT(wal__fsync__start, seq_num_);
+  utils::Timer timer;
+  wal_.Sync();
+  MG_TRACEPOINT(wal__fsync__done, seq_num_);
+  metrics::Measure(metrics::WalFsyncLatency_us,
+                   std::chrono::duration_cast<std::chrono::microseconds>(timer.Elapsed()).count());
+}
+
+void WalFile::EnableAsyncWriteback(uint64_t size) {
+  if (!wal_.Preallocate(size)) {
+    spdlog::trace("Couldn't preallocate the WAL file {}.", path_);
+  }
+  wal_.EnableWriteback();
+}
+
+int WalFile::FlushAndDuplicateDescriptor() { return wal_.FlushAndDuplicateDescriptor(); }
 
 uint64_t WalFile::GetSize() { return wal_.GetSize(); }
 
@@ -11,10 +11,14 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <cstdint>
 #include <filesystem>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "storage/v2/config.hpp"
 #include "storage/v2/delta.hpp"
@@ -64,6 +68,14 @@ struct WalDeltaData {
     EXISTENCE_CONSTRAINT_DROP,
     UNIQUE_CONSTRAINT_CREATE,
     UNIQUE_CONSTRAINT_DROP,
+    LABEL_PROPERTY_COMPOSITE_INDEX_CREATE,
+    LABEL_PROPERTY_COMPOSITE_INDEX_DROP,
+    TEXT_INDEX_CREATE,
+    TEXT_INDEX_DROP,
+    VECTOR_INDEX_CREATE,
+    VECTOR_INDEX_DROP,
+    AGGREGATE_INDEX_CREATE,
+    AGGREGATE_INDEX_DROP,
   };
 
   Type type{Type::TRANSACTION_END};
@@ -103,6 +115,11 @@ struct WalDeltaData {
     std::string label;
     std::set<std::string> properties;
   } operation_label_properties;
+
+  struct {
+    std::string label;
+    std::vector<std::string> properties;
+  } operation_label_property_list;
 };
 
 bool operator==(const WalDeltaData &a, const WalDeltaData &b);
@@ -137,6 +154,14 @@ constexpr bool IsWalDeltaDataTypeTransactionEnd(const WalDeltaData::Type type) {
     case WalDeltaData::Type::EXISTENCE_CONSTRAINT_DROP:
     case WalDeltaData::Type::UNIQUE_CONSTRAINT_CREATE:
     case WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP:
+    case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+    case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+    case WalDeltaData::Type::TEXT_INDEX_CREATE:
+    case WalDeltaData::Type::TEXT_INDEX_DROP:
+    case WalDeltaData::Type::VECTOR_INDEX_CREATE:
+    case WalDeltaData::Type::VECTOR_INDEX_DROP:
+    case WalDeltaData::Type::AGGREGATE_INDEX_CREATE:
+    case WalDeltaData::Type::AGGREGATE_INDEX_DROP:
       return true;
   }
 }
@@ -175,7 +200,19 @@ void EncodeTransactionEnd(BaseEncoder *encoder, uint64_t timestamp);
 
 /// Function used to encode non-transactional operation.
 void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, StorageGlobalOperation operation,
-                     LabelId label, const std::set<PropertyId> &properties, uint64_t timestamp);
+                     LabelId label, const std::vector<PropertyId> &properties, uint64_t timestamp);
+
+/// Deltas of a transaction encoded before the transaction gets its commit
+/// timestamp, so that they don't have to be encoded while holding the engine
+/// lock. The timestamps in the headers of the deltas are written with
+/// `SetTimestamp` once the commit timestamp is known.
+struct EncodedDeltas {
+  std::vector<uint8_t> data;
+  /// Positions of the headers of the deltas in `data`.
+  std::vector<uint64_t> headers;
+
+  void SetTimestamp(uint64_t timestamp);
+};
 
 /// Function used to load the WAL data into the storage.
 /// @throw RecoveryFailure
@@ -184,11 +221,68 @@ RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConst
                      utils::SkipList<Edge> *edges, NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count,
                      Config::Items items);
 
+/// Deltas of a WAL file that have to be loaded, read by `ReadWalDeltas`.
+struct WalDeltas {
+  WalInfo info;
+  std::vector<std::pair<uint64_t, WalDeltaData>> deltas;
+  uint64_t skipped{0};
+};
+
+/// Function used to read the deltas of the WAL file that are newer than
+/// `last_loaded_timestamp`, without applying them to the storage.
+/// @throw RecoveryFailure
+WalDeltas ReadWalDeltas(const std::filesystem::path &path, std::optional<uint64_t> last_loaded_timestamp);
+
+/// Function used to apply the deltas read by `ReadWalDeltas` to the storage.
+/// The label and property changes are applied on `thread_count` threads that
+/// split the objects by their gids, so the changes of each object are still
+/// applied in the WAL order.
+/// @throw RecoveryFailure
+RecoveryInfo ApplyWalDeltas(const WalDeltas &wal, RecoveredIndicesAndConstraints *indices_constraints,
+                            utils::SkipList<Vertex> *vertices, utils::SkipList<Edge> *edges,
+                            NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, Config::Items items,
+                            uint64_t thread_count);
+
+/// Pool of empty files with preallocated disk space that new WAL files are
+/// created from. The files are created on a background thread, so the WAL
+/// rollover on the commit path only renames one of them instead of creating a
+/// new file and allocating its blocks.
+class WalSegmentPool {
+ public:
+  WalSegmentPool(std::filesystem::path directory, uint64_t segment_size, uint64_t segment_count);
+
+  WalSegmentPool(const WalSegmentPool &) = delete;
+  WalSegmentPool(WalSegmentPool &&) = delete;
+  WalSegmentPool &operator=(const WalSegmentPool &) = delete;
+  WalSegmentPool &operator=(WalSegmentPool &&) = delete;
+
+  ~WalSegmentPool() = default;
+
+  /// Moves a prepared segment to `path`. Returns `false` if no segment is
+  /// ready, the file then has to be created as usual.
+  bool TakeSegment(const std::filesystem::path &path);
+
+ private:
+  void PrepareSegments(const std::stop_token &stop_token);
+
+  std::filesystem::path directory_;
+  uint64_t segment_size_;
+  uint64_t segment_count_;
+
+  std::mutex lock_;
+  std::condition_variable_any segments_cv_;
+  std::vector<std::filesystem::path> segments_;
+
+  std::jthread worker_;
+};
+
 /// WalFile class used to append deltas and operations to the WAL file.
 class WalFile {
  public:
+  // The file is created from a segment of `segment_pool` if one is ready.
   WalFile(const std::filesystem::path &wal_directory, std::string_view uuid, std::string_view epoch_id,
-          Config::Items items, NameIdMapper *name_id_mapper, uint64_t seq_num, utils::FileRetainer *file_retainer);
+          Config::Items items, NameIdMapper *name_id_mapper, uint64_t seq_num, utils::FileRetainer *file_retainer,
+          WalSegmentPool *segment_pool = nullptr);
   WalFile(std::filesystem::path current_wal_path, Config::Items items, NameIdMapper *name_id_mapper, uint64_t seq_num,
           uint64_t from_timestamp, uint64_t to_timestamp, uint64_t count, utils::FileRetainer *file_retainer);
 
@@ -204,11 +298,24 @@ class WalFile {
 
   void AppendTransactionEnd(uint64_t timestamp);
 
-  void AppendOperation(StorageGlobalOperation operation, LabelId label, const std::set<PropertyId> &properties,
+  /// Appends the deltas, including the transaction end, whose timestamps are
+  /// already set to `timestamp`.
+  void AppendEncodedDeltas(const EncodedDeltas &deltas, uint64_t timestamp);
+
+  void AppendOperation(StorageGlobalOperation operation, LabelId label, const std::vector<PropertyId> &properties,
                        uint64_t timestamp);
 
   void Sync();
 
+  // Reserves disk space for `size` bytes of the file and writes the data back
+  // to the disk in the background as soon as it leaves the internal buffer, so
+  // that the syncs in the commit path have less work left.
+  void EnableAsyncWriteback(uint64_t size);
+
+  // Writes the buffered data to the file and returns a duplicate of its
+  // descriptor, see `utils::OutputFile::FlushAndDuplicateDescriptor`.
+  int FlushAndDuplicateDescriptor();
+
   uint64_t GetSize();
 
   uint64_t SequenceNumber() const;
@@ -17,7 +17,7 @@
 #include "storage/v2/id_types.hpp"
 #include "storage/v2/property_store.hpp"
 #include "utils/logging.hpp"
-#include "utils/spin_lock.hpp"
+#include "storage/v2/locks.hpp"
 
 namespace memgraph::storage {
 
@@ -34,14 +34,23 @@ struct Edge {
 
   PropertyStore properties;
 
-  mutable utils::SpinLock lock;
+  mutable ObjectLock lock;
   bool deleted;
-  // uint8_t PAD;
+  // The reads of the properties since the last tiering pass, halved by every
+  // pass. Only changed while holding the lock.
+  mutable uint8_t property_reads{0};
   // uint16_t PAD;
 
   Delta *delta;
 };
 
+/// Counts a read of the properties of the object, which must be locked. The
+/// large property values of the objects which are read often are kept in
+/// memory when the storage is tiered.
+inline void RecordPropertyRead(const Edge &object) {
+  if (object.property_reads < std::numeric_limits<uint8_t>::max()) ++object.property_reads;
+}
+
 static_assert(alignof(Edge) >= 8, "The Edge should be aligned to at least 8!");
 
 inline bool operator==(const Edge &first, const Edge &second) { return first.gid == second.gid; }
@@ -16,6 +16,7 @@
 #include <tuple>
 
 #include "storage/v2/delta.hpp"
+#include "storage/v2/indices/indices.hpp"
 #include "storage/v2/mvcc.hpp"
 #include "storage/v2/property_value.hpp"
 #include "storage/v2/result.hpp"
@@ -25,51 +26,16 @@
 namespace memgraph::storage {
 
 bool EdgeAccessor::IsVisible(const View view) const {
-  bool exists = true;
-  bool deleted = true;
-  // When edges don't have properties, their isolation level is still dictated by MVCC ->
-  // iterate over the deltas of the from_vertex_ and see which deltas can be applied on edges.
-  if (!config_.properties_on_edges) {
-    Delta *delta = nullptr;
-    {
-      std::lock_guard<utils::SpinLock> guard(from_vertex_->lock);
-      // Initialize deleted by checking if out edges contain edge_
-      deleted = std::find_if(from_vertex_->out_edges.begin(), from_vertex_->out_edges.end(), [&](const auto &out_edge) {
-                  return std::get<2>(out_edge) == edge_;
-                }) == from_vertex_->out_edges.end();
-      delta = from_vertex_->delta;
-    }
-    ApplyDeltasForRead(transaction_, delta, view, [&](const Delta &delta) {
-      switch (delta.action) {
-        case Delta::Action::ADD_LABEL:
-        case Delta::Action::REMOVE_LABEL:
-        case Delta::Action::SET_PROPERTY:
-        case Delta::Action::REMOVE_IN_EDGE:
-        case Delta::Action::ADD_IN_EDGE:
-        case Delta::Action::RECREATE_OBJECT:
-        case Delta::Action::DELETE_DESERIALIZED_OBJECT:
-        case Delta::Action::DELETE_OBJECT:
-          break;
-        case Delta::Action::ADD_OUT_EDGE: {  // relevant for the from_vertex_ -> we just deleted the edge
-          if (delta.vertex_edge.edge == edge_) {
-            deleted = false;
-          }
-          break;
-        }
-        case Delta::Action::REMOVE_OUT_EDGE: {  // also relevant for the from_vertex_ -> we just added the edge
-          if (delta.vertex_edge.edge == edge_) {
-            exists = false;
-          }
-          break;
-        }
-      }
-    });
+  if (!config_.EdgeRefsArePointers()) {
+    const auto [exists, deleted] = ExistsAndDeletedInAdjacency(view);
     return exists && (for_deleted_ || !deleted);
   }
 
+  bool exists = true;
+  bool deleted = true;
   Delta *delta = nullptr;
   {
-    std::lock_guard<utils::SpinLock> guard(edge_.ptr->lock);
+    std::lock_guard guard(edge_.ptr->lock);
     deleted = edge_.ptr->deleted;
     delta = edge_.ptr->delta;
   }
@@ -97,6 +63,70 @@ bool EdgeAccessor::IsVisible(const View view) const {
   return exists && (for_deleted_ || !deleted);
 }
 
+std::pair<bool, bool> EdgeAccessor::ExistsAndDeletedInAdjacency(const View view) const {
+  bool exists = true;
+  bool deleted = true;
+  // When edges don't have objects, their isolation level is still dictated by MVCC ->
+  // iterate over the deltas of the from_vertex_ and see which deltas can be applied on edges.
+  Delta *delta = nullptr;
+  {
+    std::lock_guard guard(from_vertex_->lock);
+    // Initialize deleted by checking if out edges contain edge_
+    deleted = !from_vertex_->out_edges.contains({edge_type_, to_vertex_, edge_});
+    delta = from_vertex_->delta;
+  }
+  ApplyDeltasForRead(transaction_, delta, view, [&](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::ADD_LABEL:
+      case Delta::Action::REMOVE_LABEL:
+      case Delta::Action::SET_PROPERTY:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::RECREATE_OBJECT:
+      case Delta::Action::DELETE_DESERIALIZED_OBJECT:
+      case Delta::Action::DELETE_OBJECT:
+        break;
+      case Delta::Action::ADD_OUT_EDGE: {  // relevant for the from_vertex_ -> we just deleted the edge
+        if (delta.vertex_edge.edge == edge_) {
+          deleted = false;
+        }
+        break;
+      }
+      case Delta::Action::REMOVE_OUT_EDGE: {  // also relevant for the from_vertex_ -> we just added the edge
+        if (delta.vertex_edge.edge == edge_) {
+          exists = false;
+        }
+        break;
+      }
+    }
+  });
+  return {exists, deleted};
+}
+
+Edge *EdgeAccessor::FindObject() const {
+  if (config_.EdgeRefsArePointers()) return edge_.ptr;
+  auto acc = transaction_->edges->access();
+  auto it = acc.find(edge_.gid);
+  return it != acc.end() ? &*it : nullptr;
+}
+
+Result<Edge *> EdgeAccessor::FindOrCreateObject() const {
+  if (auto *edge = FindObject()) return edge;
+  {
+    // The object is created while the from vertex is locked, so `DeleteEdge`,
+    // which locks the vertices, either removes the edge before the object is
+    // created or finds the object.
+    std::lock_guard guard(from_vertex_->lock);
+    if (from_vertex_->out_edges.contains({edge_type_, to_vertex_, edge_})) {
+      auto acc = transaction_->edges->access();
+      return &*acc.insert(Edge(edge_.gid, nullptr)).first;
+    }
+  }
+  // The edge was deleted either by this transaction or by a concurrent one.
+  if (for_deleted_ || !IsVisible(View::NEW)) return Error::DELETED_OBJECT;
+  return Error::SERIALIZATION_ERROR;
+}
+
 VertexAccessor EdgeAccessor::FromVertex() const {
   return VertexAccessor{from_vertex_, transaction_, indices_, constraints_, config_};
 }
@@ -109,13 +139,17 @@ Result<storage::PropertyValue> EdgeAccessor::SetProperty(PropertyId property, co
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
   if (!config_.properties_on_edges) return Error::PROPERTIES_DISABLED;
 
-  std::lock_guard<utils::SpinLock> guard(edge_.ptr->lock);
+  auto maybe_edge = FindOrCreateObject();
+  if (maybe_edge.HasError()) return maybe_edge.GetError();
+  auto *edge = *maybe_edge;
 
-  if (!PrepareForWrite(transaction_, edge_.ptr)) return Error::SERIALIZATION_ERROR;
+  auto guard = LockWithLoadedProperties(*edge);
 
-  if (edge_.ptr->deleted) return Error::DELETED_OBJECT;
+  if (!PrepareForWrite(transaction_, edge, property)) return Error::SERIALIZATION_ERROR;
 
-  auto current_value = edge_.ptr->properties.GetProperty(property);
+  if (edge->deleted) return Error::DELETED_OBJECT;
+
+  auto current_value = edge->properties.GetProperty(property);
   // We could skip setting the value if the previous one is the same to the new
   // one. This would save some memory as a delta would not be created as well as
   // avoid copying the value. The reason we are not doing that is because the
@@ -123,8 +157,9 @@ Result<storage::PropertyValue> EdgeAccessor::SetProperty(PropertyId property, co
   // "modify in-place". Additionally, the created delta will make other
   // transactions get a SERIALIZATION_ERROR.
 
-  CreateAndLinkDelta(transaction_, edge_.ptr, Delta::SetPropertyTag(), property, current_value);
-  edge_.ptr->properties.SetProperty(property, value);
+  CreateAndLinkDelta(transaction_, edge, Delta::SetPropertyTag(), property, current_value);
+  edge->properties.SetProperty(property, value);
+  indices_->UpdateOnSetEdgeProperty(edge_type_, property, value, from_vertex_, to_vertex_, edge, *transaction_);
 
   return std::move(current_value);
 }
@@ -133,15 +168,20 @@ Result<bool> EdgeAccessor::InitProperties(const std::map<storage::PropertyId, st
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
   if (!config_.properties_on_edges) return Error::PROPERTIES_DISABLED;
 
-  std::lock_guard<utils::SpinLock> guard(edge_.ptr->lock);
+  auto maybe_edge = FindOrCreateObject();
+  if (maybe_edge.HasError()) return maybe_edge.GetError();
+  auto *edge = *maybe_edge;
+
+  std::lock_guard guard(edge->lock);
 
-  if (!PrepareForWrite(transaction_, edge_.ptr)) return Error::SERIALIZATION_ERROR;
+  if (!PrepareForWrite(transaction_, edge)) return Error::SERIALIZATION_ERROR;
 
-  if (edge_.ptr->deleted) return Error::DELETED_OBJECT;
+  if (edge->deleted) return Error::DELETED_OBJECT;
 
-  if (!edge_.ptr->properties.InitProperties(properties)) return false;
-  for (const auto &[property, _] : properties) {
-    CreateAndLinkDelta(transaction_, edge_.ptr, Delta::SetPropertyTag(), property, PropertyValue());
+  if (!edge->properties.InitProperties(properties)) return false;
+  for (const auto &[property, value] : properties) {
+    CreateAndLinkDelta(transaction_, edge, Delta::SetPropertyTag(), property, PropertyValue());
+    indices_->UpdateOnSetEdgeProperty(edge_type_, property, value, from_vertex_, to_vertex_, edge, *transaction_);
   }
 
   return true;
@@ -152,16 +192,22 @@ Result<std::vector<std::tuple<PropertyId, PropertyValue, PropertyValue>>> EdgeAc
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
   if (!config_.properties_on_edges) return Error::PROPERTIES_DISABLED;
 
-  std::lock_guard<utils::SpinLock> guard(edge_.ptr->lock);
+  auto maybe_edge = FindOrCreateObject();
+  if (maybe_edge.HasError()) return maybe_edge.GetError();
+  auto *edge = *maybe_edge;
+
+  auto guard = LockWithLoadedProperties(*edge);
 
-  if (!PrepareForWrite(transaction_, edge_.ptr)) return Error::SERIALIZATION_ERROR;
+  if (!PrepareForWrite(transaction_, edge)) return Error::SERIALIZATION_ERROR;
 
-  if (edge_.ptr->deleted) return Error::DELETED_OBJECT;
+  if (edge->deleted) return Error::DELETED_OBJECT;
 
-  auto id_old_new_change = edge_.ptr->properties.UpdateProperties(properties);
+  auto id_old_new_change = edge->properties.UpdateProperties(properties);
 
   for (auto &[property, old_value, new_value] : id_old_new_change) {
-    CreateAndLinkDelta(transaction_, edge_.ptr, Delta::SetPropertyTag(), property, std::move(old_value));
+    indices_->UpdateOnSetEdgeProperty(edge_type_, property, new_value, from_vertex_, to_vertex_, edge,
+                                      *transaction_);
+    CreateAndLinkDelta(transaction_, edge, Delta::SetPropertyTag(), property, std::move(old_value));
   }
 
   return id_old_new_change;
@@ -170,33 +216,46 @@ Result<std::vector<std::tuple<PropertyId, PropertyValue, PropertyValue>>> EdgeAc
 Result<std::map<PropertyId, PropertyValue>> EdgeAccessor::ClearProperties() {
   if (!config_.properties_on_edges) return Error::PROPERTIES_DISABLED;
 
-  std::lock_guard<utils::SpinLock> guard(edge_.ptr->lock);
+  auto maybe_edge = FindOrCreateObject();
+  if (maybe_edge.HasError()) return maybe_edge.GetError();
+  auto *edge = *maybe_edge;
 
-  if (!PrepareForWrite(transaction_, edge_.ptr)) return Error::SERIALIZATION_ERROR;
+  auto guard = LockWithLoadedProperties(*edge);
 
-  if (edge_.ptr->deleted) return Error::DELETED_OBJECT;
+  if (!PrepareForWrite(transaction_, edge)) return Error::SERIALIZATION_ERROR;
 
-  auto properties = edge_.ptr->properties.Properties();
+  if (edge->deleted) return Error::DELETED_OBJECT;
+
+  auto properties = edge->properties.Properties();
   for (const auto &property : properties) {
-    CreateAndLinkDelta(transaction_, edge_.ptr, Delta::SetPropertyTag(), property.first, property.second);
+    CreateAndLinkDelta(transaction_, edge, Delta::SetPropertyTag(), property.first, property.second);
   }
 
-  edge_.ptr->properties.ClearProperties();
+  edge->properties.ClearProperties();
 
   return std::move(properties);
 }
 
 Result<PropertyValue> EdgeAccessor::GetProperty(PropertyId property, View view) const {
   if (!config_.properties_on_edges) return PropertyValue();
+  auto *edge = FindObject();
+  if (!edge) {
+    // A light edge without an object doesn't have any properties.
+    const auto [exists, deleted] = ExistsAndDeletedInAdjacency(view);
+    if (!exists) return Error::NONEXISTENT_OBJECT;
+    if (!for_deleted_ && deleted) return Error::DELETED_OBJECT;
+    return PropertyValue();
+  }
   bool exists = true;
   bool deleted = false;
   PropertyValue value;
   Delta *delta = nullptr;
   {
-    std::lock_guard<utils::SpinLock> guard(edge_.ptr->lock);
-    deleted = edge_.ptr->deleted;
-    value = edge_.ptr->properties.GetProperty(property);
-    delta = edge_.ptr->delta;
+    auto guard = LockWithLoadedProperties(*edge);
+    deleted = edge->deleted;
+    value = edge->properties.GetProperty(property);
+    RecordPropertyRead(*edge);
+    delta = edge->delta;
   }
   ApplyDeltasForRead(transaction_, delta, view, [&exists, &deleted, &value, property](const Delta &delta) {
     switch (delta.action) {
@@ -229,17 +288,79 @@ Result<PropertyValue> EdgeAccessor::GetProperty(PropertyId property, View view)
   return std::move(value);
 }
 
+Result<std::vector<PropertyValue>> EdgeAccessor::GetProperties(const std::vector<PropertyId> &properties,
+                                                               View view) const {
+  if (!config_.properties_on_edges) return std::vector<PropertyValue>(properties.size());
+  auto *edge = FindObject();
+  if (!edge) {
+    // A light edge without an object doesn't have any properties.
+    const auto [exists, deleted] = ExistsAndDeletedInAdjacency(view);
+    if (!exists) return Error::NONEXISTENT_OBJECT;
+    if (!for_deleted_ && deleted) return Error::DELETED_OBJECT;
+    return std::vector<PropertyValue>(properties.size());
+  }
+  bool exists = true;
+  bool deleted = false;
+  std::vector<PropertyValue> values;
+  Delta *delta = nullptr;
+  {
+    auto guard = LockWithLoadedProperties(*edge);
+    deleted = edge->deleted;
+    values = edge->properties.GetProperties(properties);
+    RecordPropertyRead(*edge);
+    delta = edge->delta;
+  }
+  ApplyDeltasForRead(transaction_, delta, view, [&exists, &deleted, &values, &properties](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::SET_PROPERTY: {
+        for (size_t i = 0; i < properties.size(); ++i) {
+          if (delta.property.key == properties[i]) values[i] = delta.property.value;
+        }
+        break;
+      }
+      case Delta::Action::DELETE_DESERIALIZED_OBJECT:
+      case Delta::Action::DELETE_OBJECT: {
+        exists = false;
+        break;
+      }
+      case Delta::Action::RECREATE_OBJECT: {
+        deleted = false;
+        break;
+      }
+      case Delta::Action::ADD_LABEL:
+      case Delta::Action::REMOVE_LABEL:
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::ADD_OUT_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::REMOVE_OUT_EDGE:
+        break;
+    }
+  });
+  if (!exists) return Error::NONEXISTENT_OBJECT;
+  if (!for_deleted_ && deleted) return Error::DELETED_OBJECT;
+  return std::move(values);
+}
+
 Result<std::map<PropertyId, PropertyValue>> EdgeAccessor::Properties(View view) const {
   if (!config_.properties_on_edges) return std::map<PropertyId, PropertyValue>{};
+  auto *edge = FindObject();
+  if (!edge) {
+    // A light edge without an object doesn't have any properties.
+    const auto [exists, deleted] = ExistsAndDeletedInAdjacency(view);
+    if (!exists) return Error::NONEXISTENT_OBJECT;
+    if (!for_deleted_ && deleted) return Error::DELETED_OBJECT;
+    return std::map<PropertyId, PropertyValue>{};
+  }
   bool exists = true;
   bool deleted = false;
   std::map<PropertyId, PropertyValue> properties;
   Delta *delta = nullptr;
   {
-    std::lock_guard<utils::SpinLock> guard(edge_.ptr->lock);
-    deleted = edge_.ptr->deleted;
-    properties = edge_.ptr->properties.Properties();
-    delta = edge_.ptr->delta;
+    auto guard = LockWithLoadedProperties(*edge);
+    deleted = edge->deleted;
+    properties = edge->properties.Properties();
+    RecordPropertyRead(*edge);
+    delta = edge->delta;
   }
   ApplyDeltasForRead(transaction_, delta, view, [&exists, &deleted, &properties](const Delta &delta) {
     switch (delta.action) {
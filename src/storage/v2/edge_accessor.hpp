@@ -12,6 +12,7 @@
 #pragma once
 
 #include <optional>
+#include <utility>
 
 #include "storage/v2/edge.hpp"
 #include "storage/v2/edge_ref.hpp"
@@ -73,11 +74,16 @@ class EdgeAccessor final {
   /// @throw std::bad_alloc
   Result<PropertyValue> GetProperty(PropertyId property, View view) const;
 
+  /// Returns the values of `properties` in the same order, reading all of them
+  /// in a single pass instead of one lookup per property.
+  /// @throw std::bad_alloc
+  Result<std::vector<PropertyValue>> GetProperties(const std::vector<PropertyId> &properties, View view) const;
+
   /// @throw std::bad_alloc
   Result<std::map<PropertyId, PropertyValue>> Properties(View view) const;
 
   Gid Gid() const noexcept {
-    if (config_.properties_on_edges) {
+    if (config_.EdgeRefsArePointers()) {
       return edge_.ptr->gid;
     } else {
       return edge_.gid;
@@ -91,6 +97,22 @@ class EdgeAccessor final {
   }
   bool operator!=(const EdgeAccessor &other) const noexcept { return !(*this == other); }
 
+ private:
+  /// Returns whether the edge exists and whether it is deleted in the `view`
+  /// as given by the adjacency list of its from vertex. Used for the edges
+  /// without objects.
+  std::pair<bool, bool> ExistsAndDeletedInAdjacency(View view) const;
+
+  /// Returns the object of the edge, or nullptr if it is a light edge without
+  /// an object.
+  Edge *FindObject() const;
+
+  /// Returns the object of the edge and creates it if it is a light edge
+  /// without an object.
+  Result<Edge *> FindOrCreateObject() const;
+
+ public:
+
   EdgeRef edge_;
   EdgeTypeId edge_type_;
   Vertex *from_vertex_;
@@ -0,0 +1,64 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/gid_allocator.hpp"
+
+#include <array>
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(storage_gid_block_size, 1,
+              "The number of consecutive vertex or edge ids reserved at once by each thread creating them, so the "
+              "threads don't contend for the ids, e.g. 65536 for parallel imports. The ids which a thread didn't "
+              "use are skipped. 1 allocates the ids one by one.");
+
+namespace memgraph::storage {
+
+namespace {
+struct GidBlock {
+  uint64_t allocator_id{0};
+  uint64_t generation{0};
+  uint64_t next{0};
+  uint64_t end{0};
+};
+
+// A thread usually creates the vertices and the edges of a single storage, so
+// only a few blocks are cached.
+constexpr size_t kCachedBlocks = 4;
+}  // namespace
+
+uint64_t GidAllocator::Next() {
+  const auto block_size = FLAGS_storage_gid_block_size;
+  if (block_size <= 1) return next_gid_->fetch_add(1, std::memory_order_acq_rel);
+
+  thread_local std::array<GidBlock, kCachedBlocks> blocks;
+  auto &block = blocks[id_ % kCachedBlocks];
+  while (true) {
+    const auto generation = generation_.load(std::memory_order_acquire);
+    if (block.allocator_id != id_ || block.generation != generation || block.next == block.end) {
+      block.allocator_id = id_;
+      block.generation = generation;
+      block.next = next_gid_->fetch_add(block_size, std::memory_order_acq_rel);
+      block.end = block.next + block_size;
+    }
+    const auto gid = block.next++;
+    // The blocks may have been discarded while the gid was taken, in which
+    // case it could be the gid of an object created with a given gid.
+    if (generation_.load(std::memory_order_acquire) == generation) return gid;
+  }
+}
+
+uint64_t GidAllocator::NewId() {
+  // The ids start from 1, so they differ from the one of an unused block.
+  static std::atomic<uint64_t> next_id{1};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace memgraph::storage
@@ -0,0 +1,64 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <gflags/gflags.h>
+
+DECLARE_uint64(storage_gid_block_size);
+
+namespace memgraph::storage {
+
+/// Allocates the gids of the new objects of one kind from the shared counter
+/// of the next gid.
+///
+/// If `storage_gid_block_size` is above 1, each thread reserves blocks of that
+/// many consecutive gids and allocates from them, so the threads creating
+/// objects in parallel don't contend on the counter and insert the objects
+/// into different parts of the skip list. The gids which a thread didn't use
+/// are skipped. The recovery continues after the highest gid, so the
+/// reservations don't have to be made durable.
+///
+/// This class is thread safe.
+class GidAllocator final {
+ public:
+  explicit GidAllocator(std::atomic<uint64_t> *next_gid) : next_gid_(next_gid) {}
+
+  GidAllocator(const GidAllocator &) = delete;
+  GidAllocator &operator=(const GidAllocator &) = delete;
+  GidAllocator(GidAllocator &&) = delete;
+  GidAllocator &operator=(GidAllocator &&) = delete;
+  ~GidAllocator() = default;
+
+  uint64_t Next();
+
+  /// Discards the blocks reserved by all threads. Has to be called before the
+  /// counter is raised for an object created with a given gid, which could be
+  /// in a reserved block. A gid taken from a block after the call is never
+  /// returned, so no thread hands out the given gid once the counter is
+  /// raised.
+  void DiscardBlocks() {
+    if (FLAGS_storage_gid_block_size > 1) generation_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+ private:
+  std::atomic<uint64_t> *next_gid_;
+  // Tells apart the allocators in the blocks cached by the threads.
+  uint64_t id_{NewId()};
+  std::atomic<uint64_t> generation_{0};
+
+  static uint64_t NewId();
+};
+
+}  // namespace memgraph::storage
@@ -0,0 +1,106 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/graph_changes.hpp"
+
+#include <algorithm>
+
+#include "storage/v2/delta.hpp"
+#include "storage/v2/edge.hpp"
+#include "storage/v2/transaction.hpp"
+#include "storage/v2/vertex.hpp"
+
+namespace memgraph::storage {
+
+namespace {
+template <typename TFunc>
+void ForEachDelta(const Delta *head, const Transaction &transaction, const TFunc &func) {
+  const auto transaction_id = transaction.transaction_id.load(std::memory_order_acquire);
+  for (const Delta *delta = head; delta != nullptr && delta->timestamp->load(std::memory_order_acquire) == transaction_id;
+       delta = delta->next.load(std::memory_order_acquire)) {
+    func(*delta);
+  }
+}
+}  // namespace
+
+void CollectGraphChanges(const Vertex &vertex, const Transaction &transaction, GraphFootprint *changes) {
+  changes->all_vertices = true;
+  // Any change is seen by the readers of the labels the vertex has now. The
+  // labels it had before are added from the deltas.
+  changes->labels.insert(vertex.labels.begin(), vertex.labels.end());
+  ForEachDelta(vertex.delta, transaction, [changes](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::ADD_LABEL:
+      case Delta::Action::REMOVE_LABEL:
+        changes->labels.insert(delta.label);
+        break;
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::ADD_OUT_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::REMOVE_OUT_EDGE:
+        changes->all_edges = true;
+        changes->edge_types.insert(delta.vertex_edge.edge_type);
+        break;
+      default:
+        break;
+    }
+  });
+}
+
+void CollectGraphChanges(const Edge &edge, const Transaction &transaction, GraphFootprint *changes) {
+  // The creation and the deletion of the edge are collected from the deltas of
+  // its vertices, which know its type.
+  ForEachDelta(edge.delta, transaction, [changes](const Delta &delta) {
+    if (delta.action == Delta::Action::SET_PROPERTY) changes->edge_properties = true;
+  });
+}
+
+void GraphChangeVersions::Enable(const uint64_t version) {
+  RecordAll(version);
+  enabled_.store(true, std::memory_order_release);
+}
+
+void GraphChangeVersions::Record(const GraphFootprint &changes, const uint64_t version) {
+  versions_.WithLock([&](auto &versions) {
+    if (changes.all_vertices) versions.vertices = version;
+    if (changes.all_edges) versions.edges = version;
+    if (changes.edge_properties) versions.edge_properties = version;
+    for (const auto label : changes.labels) versions.labels[label] = version;
+    for (const auto edge_type : changes.edge_types) versions.edge_types[edge_type] = version;
+  });
+}
+
+void GraphChangeVersions::RecordAll(const uint64_t version) {
+  versions_.WithLock([version](auto &versions) { versions.all = version; });
+}
+
+uint64_t GraphChangeVersions::LastChange(const GraphFootprint &footprint) const {
+  return versions_.WithLock([&footprint](const auto &versions) {
+    uint64_t last = versions.all;
+    if (footprint.all_vertices) last = std::max(last, versions.vertices);
+    for (const auto label : footprint.labels) {
+      if (auto it = versions.labels.find(label); it != versions.labels.end()) last = std::max(last, it->second);
+    }
+    // The changed edge properties can belong to an edge of any type.
+    if (footprint.all_edges || footprint.edge_properties || !footprint.edge_types.empty()) {
+      last = std::max(last, versions.edge_properties);
+    }
+    if (footprint.all_edges) last = std::max(last, versions.edges);
+    for (const auto edge_type : footprint.edge_types) {
+      if (auto it = versions.edge_types.find(edge_type); it != versions.edge_types.end()) {
+        last = std::max(last, it->second);
+      }
+    }
+    return last;
+  });
+}
+
+}  // namespace memgraph::storage
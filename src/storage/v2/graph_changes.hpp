@@ -0,0 +1,96 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Graph versions at which the committed changes last touched the vertices of
+/// each label and the edges of each edge type, from which the data derived
+/// from those parts of the graph can be invalidated.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "storage/v2/id_types.hpp"
+#include "utils/spin_lock.hpp"
+#include "utils/synchronized.hpp"
+
+namespace memgraph::storage {
+
+struct Edge;
+struct Transaction;
+struct Vertex;
+
+/// Part of the graph changed by a transaction or read by a query.
+struct GraphFootprint {
+  // Labels of the changed vertices, including the added and removed ones.
+  std::unordered_set<LabelId> labels;
+  // Types of the created and deleted edges.
+  std::unordered_set<EdgeTypeId> edge_types;
+  // Changed any vertex, or read vertices of any label.
+  bool all_vertices{false};
+  // Changed any edge, or read edges of any type.
+  bool all_edges{false};
+  // Changed the properties of edges, whose types aren't known from the deltas.
+  bool edge_properties{false};
+};
+
+/// Adds the changes which the transaction made to the vertex, or to the edge,
+/// to the footprint. The object must be changed by the transaction, which
+/// didn't commit yet, so its deltas can be read without taking its lock.
+void CollectGraphChanges(const Vertex &vertex, const Transaction &transaction, GraphFootprint *changes);
+void CollectGraphChanges(const Edge &edge, const Transaction &transaction, GraphFootprint *changes);
+
+/// Keeps the graph version of the last commit which changed each label and
+/// edge type. Data derived from a part of the graph at some version is still
+/// valid at a later version if `LastChange` of its footprint isn't newer than
+/// either of them.
+///
+/// The changes are only tracked once `Enable` is called, as collecting them
+/// from the deltas slows down the commits.
+///
+/// This class is thread safe.
+class GraphChangeVersions final {
+ public:
+  /// Starts tracking the changes. The changes committed before are treated as
+  /// if they were all committed at the version. Must be serialized with
+  /// `Record` in the same way.
+  void Enable(uint64_t version);
+  bool IsEnabled() const { return enabled_.load(std::memory_order_acquire); }
+
+  /// Records the changes committed at the graph version. The calls must be
+  /// serialized and their versions increasing, e.g. by holding the engine
+  /// lock.
+  void Record(const GraphFootprint &changes, uint64_t version);
+
+  /// Records that any part of the graph may have changed at the version, e.g.
+  /// by a change which wasn't made through the deltas.
+  void RecordAll(uint64_t version);
+
+  /// Returns the version of the last change to the read part of the graph.
+  uint64_t LastChange(const GraphFootprint &footprint) const;
+
+ private:
+  struct Versions {
+    uint64_t all{0};
+    uint64_t vertices{0};
+    uint64_t edges{0};
+    uint64_t edge_properties{0};
+    std::unordered_map<LabelId, uint64_t> labels;
+    std::unordered_map<EdgeTypeId, uint64_t> edge_types;
+  };
+
+  std::atomic<bool> enabled_{false};
+  mutable utils::Synchronized<Versions, utils::SpinLock> versions_;
+};
+
+}  // namespace memgraph::storage
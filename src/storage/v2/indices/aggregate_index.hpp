@@ -0,0 +1,65 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "storage/v2/id_types.hpp"
+#include "storage/v2/property_value.hpp"
+
+namespace memgraph::storage {
+
+/// The aggregates of the values of a property over the vertices with the same
+/// value of the group property.
+struct AggregateGroup {
+  PropertyValue group;
+  /// The number of vertices in the group.
+  uint64_t count{0};
+  /// The number of vertices in the group which have a value.
+  uint64_t value_count{0};
+  /// The sum of the values, which is an integer unless one of them is a
+  /// double, and null if one of them isn't a number.
+  PropertyValue sum;
+  /// The smallest and the largest of the values, null if there are none.
+  PropertyValue min;
+  PropertyValue max;
+};
+
+/// Aggregates of the values of a property over the vertices with a label,
+/// grouped by the value of another property, i.e. the results of
+/// `MATCH (n:Label) RETURN n.group, count(n), sum(n.value), min(n.value),
+/// max(n.value)`. The aggregates are maintained when the transactions commit,
+/// so looking them up doesn't scan the vertices.
+class AggregateIndex {
+ public:
+  /// The label, the group property and the value property.
+  using Key = std::tuple<LabelId, PropertyId, PropertyId>;
+
+  AggregateIndex() = default;
+
+  AggregateIndex(const AggregateIndex &) = delete;
+  AggregateIndex(AggregateIndex &&) = delete;
+  AggregateIndex &operator=(const AggregateIndex &) = delete;
+  AggregateIndex &operator=(AggregateIndex &&) = delete;
+
+  virtual ~AggregateIndex() = default;
+
+  virtual bool DropIndex(const Key &key) = 0;
+
+  virtual bool IndexExists(const Key &key) const = 0;
+
+  virtual std::vector<Key> ListIndices() const = 0;
+};
+
+}  // namespace memgraph::storage
@@ -0,0 +1,66 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "storage/v2/constraints/constraints.hpp"
+#include "storage/v2/edge.hpp"
+#include "storage/v2/edge_accessor.hpp"
+#include "storage/v2/transaction.hpp"
+#include "storage/v2/vertex.hpp"
+#include "utils/bound.hpp"
+
+namespace memgraph::storage {
+
+/// Index over the values of a property on edges of an edge type. Edge
+/// properties exist only when properties on edges are enabled, so the index
+/// can't be created otherwise.
+class EdgeTypePropertyIndex {
+ public:
+  EdgeTypePropertyIndex(Indices *indices, Constraints *constraints, const Config &config)
+      : indices_(indices), constraints_(constraints), config_(config) {}
+
+  EdgeTypePropertyIndex(const EdgeTypePropertyIndex &) = delete;
+  EdgeTypePropertyIndex(EdgeTypePropertyIndex &&) = delete;
+  EdgeTypePropertyIndex &operator=(const EdgeTypePropertyIndex &) = delete;
+  EdgeTypePropertyIndex &operator=(EdgeTypePropertyIndex &&) = delete;
+
+  virtual ~EdgeTypePropertyIndex() = default;
+
+  virtual void UpdateOnSetProperty(EdgeTypeId edge_type, PropertyId property, const PropertyValue &value,
+                                   Vertex *from, Vertex *to, Edge *edge, const Transaction &tx) = 0;
+
+  virtual bool DropIndex(EdgeTypeId edge_type, PropertyId property) = 0;
+
+  virtual bool IndexExists(EdgeTypeId edge_type, PropertyId property) const = 0;
+
+  virtual std::vector<std::pair<EdgeTypeId, PropertyId>> ListIndices() const = 0;
+
+  virtual uint64_t ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property) const = 0;
+
+  virtual uint64_t ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property,
+                                        const PropertyValue &value) const = 0;
+
+  virtual uint64_t ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property,
+                                        const std::optional<utils::Bound<PropertyValue>> &lower,
+                                        const std::optional<utils::Bound<PropertyValue>> &upper) const = 0;
+
+ protected:
+  Indices *indices_;
+  Constraints *constraints_;
+  Config config_;
+};
+
+}  // namespace memgraph::storage
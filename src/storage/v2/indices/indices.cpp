@@ -12,8 +12,14 @@
 #include "storage/v2/indices/indices.hpp"
 #include "storage/v2/disk/label_index.hpp"
 #include "storage/v2/disk/label_property_index.hpp"
+#include "storage/v2/inmemory/aggregate_index.hpp"
+#include "storage/v2/inmemory/edge_type_index.hpp"
+#include "storage/v2/inmemory/edge_type_property_index.hpp"
 #include "storage/v2/inmemory/label_index.hpp"
+#include "storage/v2/inmemory/label_property_composite_index.hpp"
 #include "storage/v2/inmemory/label_property_index.hpp"
+#include "storage/v2/inmemory/text_index.hpp"
+#include "storage/v2/inmemory/vector_index.hpp"
 
 namespace memgraph::storage {
 
@@ -21,11 +27,28 @@ void Indices::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) cons
   static_cast<InMemoryLabelIndex *>(label_index_.get())->RemoveObsoleteEntries(oldest_active_start_timestamp);
   static_cast<InMemoryLabelPropertyIndex *>(label_property_index_.get())
       ->RemoveObsoleteEntries(oldest_active_start_timestamp);
+  static_cast<InMemoryLabelPropertyCompositeIndex *>(label_property_composite_index_.get())
+      ->RemoveObsoleteEntries(oldest_active_start_timestamp);
+  static_cast<InMemoryEdgeTypeIndex *>(edge_type_index_.get())->RemoveObsoleteEntries(oldest_active_start_timestamp);
+  static_cast<InMemoryEdgeTypePropertyIndex *>(edge_type_property_index_.get())
+      ->RemoveObsoleteEntries(oldest_active_start_timestamp);
+  static_cast<InMemoryTextIndex *>(text_index_.get())->RemoveObsoleteEntries(oldest_active_start_timestamp);
+  static_cast<InMemoryVectorIndex *>(vector_index_.get())->RemoveObsoleteEntries(oldest_active_start_timestamp);
+  static_cast<InMemoryAggregateIndex *>(aggregate_index_.get())->RemoveObsoleteEntries(oldest_active_start_timestamp);
 }
 
 void Indices::UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx) const {
   label_index_->UpdateOnAddLabel(label, vertex, tx);
   label_property_index_->UpdateOnAddLabel(label, vertex, tx);
+  if (label_property_composite_index_) {
+    label_property_composite_index_->UpdateOnAddLabel(label, vertex, tx);
+  }
+  if (text_index_) {
+    text_index_->UpdateOnAddLabel(label, vertex, tx);
+  }
+  if (vector_index_) {
+    vector_index_->UpdateOnAddLabel(label, vertex, tx);
+  }
 }
 
 void Indices::UpdateOnRemoveLabel(LabelId label, Vertex *vertex, const Transaction &tx) const {
@@ -36,6 +59,29 @@ void Indices::UpdateOnRemoveLabel(LabelId label, Vertex *vertex, const Transacti
 void Indices::UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
                                   const Transaction &tx) const {
   label_property_index_->UpdateOnSetProperty(property, value, vertex, tx);
+  if (label_property_composite_index_) {
+    label_property_composite_index_->UpdateOnSetProperty(property, value, vertex, tx);
+  }
+  if (text_index_) {
+    text_index_->UpdateOnSetProperty(property, value, vertex, tx);
+  }
+  if (vector_index_) {
+    vector_index_->UpdateOnSetProperty(property, value, vertex, tx);
+  }
+}
+
+void Indices::UpdateOnEdgeCreation(Vertex *from, Vertex *to, EdgeRef edge_ref, EdgeTypeId edge_type,
+                                   const Transaction &tx) const {
+  if (edge_type_index_) {
+    edge_type_index_->UpdateOnEdgeCreation(from, to, edge_ref, edge_type, tx);
+  }
+}
+
+void Indices::UpdateOnSetEdgeProperty(EdgeTypeId edge_type, PropertyId property, const PropertyValue &value,
+                                      Vertex *from, Vertex *to, Edge *edge, const Transaction &tx) const {
+  if (edge_type_property_index_) {
+    edge_type_property_index_->UpdateOnSetProperty(edge_type, property, value, from, to, edge, tx);
+  }
 }
 
 Indices::Indices(Constraints *constraints, const Config &config, StorageMode storage_mode) {
@@ -43,6 +89,13 @@ Indices::Indices(Constraints *constraints, const Config &config, StorageMode sto
     if (storage_mode == StorageMode::IN_MEMORY_TRANSACTIONAL || storage_mode == StorageMode::IN_MEMORY_ANALYTICAL) {
       label_index_ = std::make_unique<InMemoryLabelIndex>(this, constraints, config);
       label_property_index_ = std::make_unique<InMemoryLabelPropertyIndex>(this, constraints, config);
+      label_property_composite_index_ =
+          std::make_unique<InMemoryLabelPropertyCompositeIndex>(this, constraints, config);
+      edge_type_index_ = std::make_unique<InMemoryEdgeTypeIndex>(this, constraints, config);
+      edge_type_property_index_ = std::make_unique<InMemoryEdgeTypePropertyIndex>(this, constraints, config);
+      text_index_ = std::make_unique<InMemoryTextIndex>(this, constraints, config);
+      vector_index_ = std::make_unique<InMemoryVectorIndex>(this, constraints, config);
+      aggregate_index_ = std::make_unique<InMemoryAggregateIndex>();
     } else {
       label_index_ = std::make_unique<DiskLabelIndex>(this, constraints, config);
       label_property_index_ = std::make_unique<DiskLabelPropertyIndex>(this, constraints, config);
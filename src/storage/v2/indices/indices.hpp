@@ -12,8 +12,14 @@
 #pragma once
 
 #include <memory>
+#include "storage/v2/indices/aggregate_index.hpp"
+#include "storage/v2/indices/edge_type_index.hpp"
+#include "storage/v2/indices/edge_type_property_index.hpp"
 #include "storage/v2/indices/label_index.hpp"
+#include "storage/v2/indices/label_property_composite_index.hpp"
 #include "storage/v2/indices/label_property_index.hpp"
+#include "storage/v2/indices/text_index.hpp"
+#include "storage/v2/indices/vector_index.hpp"
 #include "storage/v2/storage_mode.hpp"
 
 namespace memgraph::storage {
@@ -47,8 +53,30 @@ struct Indices {
   void UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
                            const Transaction &tx) const;
 
+  /// This function should be called whenever an edge is created.
+  /// @throw std::bad_alloc
+  void UpdateOnEdgeCreation(Vertex *from, Vertex *to, EdgeRef edge_ref, EdgeTypeId edge_type,
+                            const Transaction &tx) const;
+
+  /// This function should be called whenever a property is modified on an edge.
+  /// @throw std::bad_alloc
+  void UpdateOnSetEdgeProperty(EdgeTypeId edge_type, PropertyId property, const PropertyValue &value, Vertex *from,
+                               Vertex *to, Edge *edge, const Transaction &tx) const;
+
   std::unique_ptr<LabelIndex> label_index_;
   std::unique_ptr<LabelPropertyIndex> label_property_index_;
+  // Composite indices are supported only by the in-memory storage, so this is
+  // nullptr for the on-disk one.
+  std::unique_ptr<LabelPropertyCompositeIndex> label_property_composite_index_;
+  // Edge indices are supported only by the in-memory storage as well.
+  std::unique_ptr<EdgeTypeIndex> edge_type_index_;
+  std::unique_ptr<EdgeTypePropertyIndex> edge_type_property_index_;
+  // Text indices are supported only by the in-memory storage too.
+  std::unique_ptr<TextIndex> text_index_;
+  std::unique_ptr<VectorIndex> vector_index_;
+  // Aggregate indices are maintained from the deltas of the committed
+  // transactions, which only the in-memory storage has.
+  std::unique_ptr<AggregateIndex> aggregate_index_;
 };
 
 }  // namespace memgraph::storage
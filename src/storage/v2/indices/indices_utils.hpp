@@ -9,12 +9,20 @@
 // by the Apache License, Version 2.0, included in the file
 // licenses/APL.txt.
 
+#include <algorithm>
+#include <atomic>
+#include <optional>
 #include <thread>
+#include <vector>
 #include "storage/v2/delta.hpp"
+#include "storage/v2/edge.hpp"
+#include "storage/v2/long_delta_chains.hpp"
 #include "storage/v2/mvcc.hpp"
 #include "storage/v2/transaction.hpp"
 #include "storage/v2/vertex.hpp"
 #include "storage/v2/vertex_info_helpers.hpp"
+#include "utils/memory_tracker.hpp"
+#include "utils/skip_list.hpp"
 #include "utils/spin_lock.hpp"
 #include "utils/synchronized.hpp"
 
@@ -51,7 +59,7 @@ inline bool AnyVersionHasLabel(const Vertex &vertex, LabelId label, uint64_t tim
   bool deleted{false};
   const Delta *delta = nullptr;
   {
-    std::lock_guard<utils::SpinLock> guard(vertex.lock);
+    std::lock_guard guard(vertex.lock);
     has_label = utils::Contains(vertex.labels, label);
     deleted = vertex.deleted;
     delta = vertex.delta;
@@ -105,7 +113,7 @@ inline bool AnyVersionHasLabelProperty(const Vertex &vertex, LabelId label, Prop
   bool deleted{false};
   const Delta *delta = nullptr;
   {
-    std::lock_guard<utils::SpinLock> guard(vertex.lock);
+    std::lock_guard guard(vertex.lock);
     has_label = utils::Contains(vertex.labels, label);
     current_value_equal_to_value = vertex.properties.IsPropertyEqual(key, value);
     deleted = vertex.deleted;
@@ -157,6 +165,135 @@ inline bool AnyVersionHasLabelProperty(const Vertex &vertex, LabelId label, Prop
       });
 }
 
+/// Helper function for composite label-property index garbage collection.
+/// Returns true if there's a reachable version of the vertex that has the given
+/// label and property values.
+inline bool AnyVersionHasLabelProperties(const Vertex &vertex, LabelId label, const std::vector<PropertyId> &keys,
+                                         const std::vector<PropertyValue> &values, uint64_t timestamp) {
+  bool has_label{false};
+  std::vector<bool> current_values_equal_to_values(keys.size());
+  bool deleted{false};
+  const Delta *delta = nullptr;
+  {
+    std::lock_guard guard(vertex.lock);
+    has_label = utils::Contains(vertex.labels, label);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      current_values_equal_to_values[i] = vertex.properties.IsPropertyEqual(keys[i], values[i]);
+    }
+    deleted = vertex.deleted;
+    delta = vertex.delta;
+  }
+
+  const auto all_equal = [&current_values_equal_to_values] {
+    return std::all_of(current_values_equal_to_values.begin(), current_values_equal_to_values.end(),
+                       [](bool equal) { return equal; });
+  };
+
+  if (!deleted && has_label && all_equal()) {
+    return true;
+  }
+
+  return AnyVersionSatisfiesPredicate(timestamp, delta, [&](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::ADD_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(!has_label, "Invalid database state!");
+          has_label = true;
+        }
+        break;
+      case Delta::Action::REMOVE_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(has_label, "Invalid database state!");
+          has_label = false;
+        }
+        break;
+      case Delta::Action::SET_PROPERTY:
+        for (size_t i = 0; i < keys.size(); ++i) {
+          if (delta.property.key == keys[i]) {
+            current_values_equal_to_values[i] = delta.property.value == values[i];
+          }
+        }
+        break;
+      case Delta::Action::RECREATE_OBJECT: {
+        MG_ASSERT(deleted, "Invalid database state!");
+        deleted = false;
+        break;
+      }
+      case Delta::Action::DELETE_DESERIALIZED_OBJECT:
+      case Delta::Action::DELETE_OBJECT: {
+        MG_ASSERT(!deleted, "Invalid database state!");
+        deleted = true;
+        break;
+      }
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::ADD_OUT_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::REMOVE_OUT_EDGE:
+        break;
+    }
+    return !deleted && has_label && all_equal();
+  });
+}
+
+// Returns true if the property of the materialized version is equal to the
+// value, where a missing property is null.
+inline bool VersionPropertyEquals(const MaterializedVertexVersion &version, PropertyId key, const PropertyValue &value) {
+  auto it = version.properties.find(key);
+  return it == version.properties.end() ? value.IsNull() : it->second == value;
+}
+
+// Helper function for iterating through composite label-property index.
+// Returns true if this transaction can see the given vertex, and the visible
+// version has the given label and property values.
+inline bool CurrentVersionHasLabelProperties(const Vertex &vertex, LabelId label, const std::vector<PropertyId> &keys,
+                                             const std::vector<PropertyValue> &values, Transaction *transaction,
+                                             View view) {
+  bool exists = true;
+  bool deleted = false;
+  bool has_label = false;
+  std::vector<bool> current_values_equal_to_values(keys.size());
+  const Delta *delta = nullptr;
+  {
+    std::lock_guard guard(vertex.lock);
+    deleted = vertex.deleted;
+    has_label = utils::Contains(vertex.labels, label);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      current_values_equal_to_values[i] = vertex.properties.IsPropertyEqual(keys[i], values[i]);
+    }
+    delta = vertex.delta;
+  }
+
+  if (!delta) {
+    return !deleted && has_label &&
+           std::all_of(current_values_equal_to_values.begin(), current_values_equal_to_values.end(),
+                       [](bool equal) { return equal; });
+  }
+
+  if (auto version = FindMaterializedVersion(&vertex, delta, transaction); version) {
+    if (!version->exists || version->deleted || !utils::Contains(version->labels, label)) return false;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (!VersionPropertyEquals(*version, keys[i], values[i])) return false;
+    }
+    return true;
+  }
+
+  auto const n_processed = ApplyDeltasForRead(transaction, delta, view, [&, label](const Delta &delta) {
+    // clang-format off
+    DeltaDispatch(delta, utils::ChainedOverloaded{
+      Deleted_ActionMethod(deleted),
+      Exists_ActionMethod(exists),
+      HasLabel_ActionMethod(has_label, label),
+      PropertyValuesMatch_ActionMethod(current_values_equal_to_values, keys, values)
+    });
+    // clang-format on
+  });
+  RecordDeltaChain(&vertex, transaction, n_processed);
+
+  return exists && !deleted && has_label &&
+         std::all_of(current_values_equal_to_values.begin(), current_values_equal_to_values.end(),
+                     [](bool equal) { return equal; });
+}
+
 // Helper function for iterating through label-property index. Returns true if
 // this transaction can see the given vertex, and the visible version has the
 // given label and property.
@@ -168,7 +305,7 @@ inline bool CurrentVersionHasLabelProperty(const Vertex &vertex, LabelId label,
   bool current_value_equal_to_value = value.IsNull();
   const Delta *delta = nullptr;
   {
-    std::lock_guard<utils::SpinLock> guard(vertex.lock);
+    std::lock_guard guard(vertex.lock);
     deleted = vertex.deleted;
     has_label = utils::Contains(vertex.labels, label);
     current_value_equal_to_value = vertex.properties.IsPropertyEqual(key, value);
@@ -189,6 +326,10 @@ inline bool CurrentVersionHasLabelProperty(const Vertex &vertex, LabelId label,
         auto resProp = cache.GetProperty(view, &vertex, key);
         if (resProp && *resProp == value) return true;
       }
+      if (auto version = FindMaterializedVersion(&vertex, delta, transaction); version) {
+        return version->exists && !version->deleted && utils::Contains(version->labels, label) &&
+               VersionPropertyEquals(*version, key, value);
+      }
     }
 
     auto const n_processed = ApplyDeltasForRead(transaction, delta, view, [&, label, key](const Delta &delta) {
@@ -211,18 +352,104 @@ inline bool CurrentVersionHasLabelProperty(const Vertex &vertex, LabelId label,
         cache.StoreProperty(view, &vertex, key, value);
       }
     }
+    RecordDeltaChain(&vertex, transaction, n_processed);
   }
 
   return exists && !deleted && has_label && current_value_equal_to_value;
 }
 
+/// Helper function for edge-type index garbage collection. Returns true if
+/// there's a reachable version of the edge. If the adjacency lists don't
+/// reference the edge objects, the edge exists only in the adjacency lists, so
+/// the deltas of the `from` vertex are checked.
+inline bool AnyVersionHasEdge(const Vertex &from, const Vertex *to, EdgeRef edge, EdgeTypeId edge_type,
+                              bool edge_refs_are_pointers, uint64_t timestamp) {
+  if (edge_refs_are_pointers) {
+    bool deleted{false};
+    const Delta *delta = nullptr;
+    {
+      std::lock_guard guard(edge.ptr->lock);
+      deleted = edge.ptr->deleted;
+      delta = edge.ptr->delta;
+    }
+    if (!deleted) {
+      return true;
+    }
+    return AnyVersionSatisfiesPredicate(
+        timestamp, delta, [](const Delta &delta) { return delta.action == Delta::Action::RECREATE_OBJECT; });
+  }
+
+  bool exists{false};
+  const Delta *delta = nullptr;
+  {
+    std::lock_guard guard(from.lock);
+    exists = from.out_edges.contains({edge_type, const_cast<Vertex *>(to), edge});
+    delta = from.delta;
+  }
+  if (exists) {
+    return true;
+  }
+  return AnyVersionSatisfiesPredicate(timestamp, delta, [edge](const Delta &delta) {
+    return delta.action == Delta::Action::ADD_OUT_EDGE && delta.vertex_edge.edge == edge;
+  });
+}
+
+/// Helper function for edge-type-property index garbage collection. Returns
+/// true if there's a reachable version of the edge that has the given property
+/// value.
+inline bool AnyVersionHasEdgeProperty(const Edge &edge, PropertyId key, const PropertyValue &value,
+                                      uint64_t timestamp) {
+  bool deleted{false};
+  bool current_value_equal_to_value{false};
+  const Delta *delta = nullptr;
+  {
+    std::lock_guard guard(edge.lock);
+    current_value_equal_to_value = edge.properties.IsPropertyEqual(key, value);
+    deleted = edge.deleted;
+    delta = edge.delta;
+  }
+  if (!deleted && current_value_equal_to_value) {
+    return true;
+  }
+  return AnyVersionSatisfiesPredicate(
+      timestamp, delta, [&current_value_equal_to_value, &deleted, key, &value](const Delta &delta) {
+        switch (delta.action) {
+          case Delta::Action::SET_PROPERTY:
+            if (delta.property.key == key) {
+              current_value_equal_to_value = delta.property.value == value;
+            }
+            break;
+          case Delta::Action::RECREATE_OBJECT:
+            deleted = false;
+            break;
+          case Delta::Action::DELETE_DESERIALIZED_OBJECT:
+          case Delta::Action::DELETE_OBJECT:
+            deleted = true;
+            break;
+          case Delta::Action::ADD_LABEL:
+          case Delta::Action::REMOVE_LABEL:
+          case Delta::Action::ADD_IN_EDGE:
+          case Delta::Action::ADD_OUT_EDGE:
+          case Delta::Action::REMOVE_IN_EDGE:
+          case Delta::Action::REMOVE_OUT_EDGE:
+            break;
+        }
+        return !deleted && current_value_equal_to_value;
+      });
+}
+
 template <typename TIndexAccessor>
-inline void TryInsertLabelIndex(Vertex &vertex, LabelId label, TIndexAccessor &index_accessor) {
+inline void TryInsertLabelIndex(Vertex &vertex, LabelId label, TIndexAccessor &index_accessor,
+                                typename TIndexAccessor::InsertHint *hint = nullptr) {
   if (vertex.deleted || !utils::Contains(vertex.labels, label)) {
     return;
   }
 
-  index_accessor.insert({&vertex, 0});
+  if (hint != nullptr) {
+    index_accessor.insert(*hint, {&vertex, 0});
+  } else {
+    index_accessor.insert({&vertex, 0});
+  }
 }
 
 template <typename TIndexAccessor>
@@ -305,4 +532,97 @@ inline void CreateIndexOnMultipleThreads(utils::SkipList<Vertex>::Accessor &vert
   }
 }
 
+/// Helper function for populating an index created while other transactions
+/// keep running. Calls `callback` with every non-null value of the property
+/// `key` that some version of the vertex with the given label has, including
+/// the versions of the running transactions, so the same value can be passed
+/// more than once. Passing no property only checks the label and calls
+/// `callback` with a null value. The caller must hold the lock of the vertex,
+/// which also keeps the GC from unlinking its deltas.
+template <typename TCallback>
+inline void ForEachVersionWithLabel(const Vertex &vertex, LabelId label, std::optional<PropertyId> key,
+                                    const TCallback &callback) {
+  bool has_label = utils::Contains(vertex.labels, label);
+  bool deleted = vertex.deleted;
+  PropertyValue value = key ? vertex.properties.GetProperty(*key) : PropertyValue();
+  auto matches = [&] { return !deleted && has_label && (!key || !value.IsNull()); };
+  if (matches()) {
+    callback(value);
+  }
+  AnyVersionSatisfiesPredicate(0, vertex.delta, [&](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::ADD_LABEL:
+        if (delta.label == label) has_label = true;
+        break;
+      case Delta::Action::REMOVE_LABEL:
+        if (delta.label == label) has_label = false;
+        break;
+      case Delta::Action::SET_PROPERTY:
+        if (key && delta.property.key == *key) value = delta.property.value;
+        break;
+      case Delta::Action::RECREATE_OBJECT:
+        deleted = false;
+        break;
+      case Delta::Action::DELETE_DESERIALIZED_OBJECT:
+      case Delta::Action::DELETE_OBJECT:
+        deleted = true;
+        break;
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::ADD_OUT_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::REMOVE_OUT_EDGE:
+        break;
+    }
+    if (matches()) {
+      callback(value);
+    }
+    return false;
+  });
+}
+
+/// Calls the function returned by `make_visitor` for every vertex in
+/// `vertices`. The list is split into ranges at sampled vertices and every
+/// range is visited by its own thread, up to `thread_count` threads, each of
+/// which calls `make_visitor` once. The ranges are bounded by gids, so they
+/// don't overlap even if the vertices are concurrently modified.
+/// @throw utils::OutOfMemoryException
+template <typename TMakeVisitor>
+inline void ForEachVertexInParallel(utils::SkipList<Vertex>::Accessor &vertices, uint64_t thread_count,
+                                    const TMakeVisitor &make_visitor) {
+  auto split_points = vertices.partition_points(std::max<uint64_t>(thread_count, 1));
+  std::vector<utils::SkipList<Vertex>::Iterator> range_begins{vertices.begin()};
+  std::vector<std::optional<Gid>> range_ends;
+  for (const auto &point : split_points) {
+    range_ends.emplace_back(point->gid);
+    range_begins.push_back(point);
+  }
+  range_ends.emplace_back(std::nullopt);
+
+  std::atomic<bool> failed{false};
+  utils::Synchronized<std::optional<utils::OutOfMemoryException>, utils::SpinLock> maybe_error{};
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(range_begins.size());
+    for (size_t i = 0; i < range_begins.size(); ++i) {
+      threads.emplace_back([&, begin = range_begins[i], end = range_ends[i]]() {
+        utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+        try {
+          auto visitor = make_visitor();
+          for (auto it = begin; it != vertices.end() && (!end || it->gid < *end); ++it) {
+            if (failed.load(std::memory_order_relaxed)) return;
+            visitor(*it);
+          }
+        } catch (utils::OutOfMemoryException &failure) {
+          utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+          *maybe_error.Lock() = std::move(failure);
+          failed.store(true, std::memory_order_relaxed);
+        }
+      });
+    }
+  }
+  if (maybe_error.Lock()->has_value()) {
+    throw utils::OutOfMemoryException((*maybe_error.Lock())->what());
+  }
+}
+
 }  // namespace memgraph::storage
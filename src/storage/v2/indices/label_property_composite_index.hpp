@@ -0,0 +1,63 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include "storage/v2/constraints/constraints.hpp"
+#include "storage/v2/vertex.hpp"
+#include "storage/v2/vertex_accessor.hpp"
+
+namespace memgraph::storage {
+
+/// Index over a label and an ordered list of properties. A vertex is in the
+/// index if it has the label and all of the properties, and the entries are
+/// ordered lexicographically by the property values, in the order in which the
+/// properties were given.
+class LabelPropertyCompositeIndex {
+ public:
+  LabelPropertyCompositeIndex(Indices *indices, Constraints *constraints, const Config &config)
+      : indices_(indices), constraints_(constraints), config_(config) {}
+
+  LabelPropertyCompositeIndex(const LabelPropertyCompositeIndex &) = delete;
+  LabelPropertyCompositeIndex(LabelPropertyCompositeIndex &&) = delete;
+  LabelPropertyCompositeIndex &operator=(const LabelPropertyCompositeIndex &) = delete;
+  LabelPropertyCompositeIndex &operator=(LabelPropertyCompositeIndex &&) = delete;
+
+  virtual ~LabelPropertyCompositeIndex() = default;
+
+  virtual void UpdateOnAddLabel(LabelId added_label, Vertex *vertex_after_update, const Transaction &tx) = 0;
+
+  virtual void UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
+                                   const Transaction &tx) = 0;
+
+  virtual bool DropIndex(LabelId label, const std::vector<PropertyId> &properties) = 0;
+
+  virtual bool IndexExists(LabelId label, const std::vector<PropertyId> &properties) const = 0;
+
+  virtual std::vector<std::pair<LabelId, std::vector<PropertyId>>> ListIndices() const = 0;
+
+  virtual uint64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties) const = 0;
+
+  /// Estimated number of vertices whose values of the leading properties are
+  /// equal to `prefix`, and whose value of the following property (if any
+  /// bound is given) is inside of the bounds.
+  virtual uint64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties,
+                                          const std::vector<PropertyValue> &prefix,
+                                          const std::optional<utils::Bound<PropertyValue>> &lower,
+                                          const std::optional<utils::Bound<PropertyValue>> &upper) const = 0;
+
+ protected:
+  Indices *indices_;
+  Constraints *constraints_;
+  Config config_;
+};
+
+}  // namespace memgraph::storage
@@ -0,0 +1,62 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "storage/v2/constraints/constraints.hpp"
+#include "storage/v2/vertex.hpp"
+#include "storage/v2/vertex_accessor.hpp"
+
+namespace memgraph::storage {
+
+/// A vertex found by a full-text search, with the relevance of its value to
+/// the searched text.
+struct TextSearchResult {
+  VertexAccessor vertex;
+  double score;
+};
+
+/// Full-text index over the string values of a property of the vertices with
+/// a label. The values are split into tokens and the index maps each token to
+/// the vertices whose value contains it.
+class TextIndex {
+ public:
+  TextIndex(Indices *indices, Constraints *constraints, const Config &config)
+      : indices_(indices), constraints_(constraints), config_(config) {}
+
+  TextIndex(const TextIndex &) = delete;
+  TextIndex(TextIndex &&) = delete;
+  TextIndex &operator=(const TextIndex &) = delete;
+  TextIndex &operator=(TextIndex &&) = delete;
+
+  virtual ~TextIndex() = default;
+
+  virtual void UpdateOnAddLabel(LabelId added_label, Vertex *vertex_after_update, const Transaction &tx) = 0;
+
+  virtual void UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
+                                   const Transaction &tx) = 0;
+
+  virtual bool DropIndex(LabelId label, PropertyId property) = 0;
+
+  virtual bool IndexExists(LabelId label, PropertyId property) const = 0;
+
+  virtual std::vector<std::pair<LabelId, PropertyId>> ListIndices() const = 0;
+
+ protected:
+  Indices *indices_;
+  Constraints *constraints_;
+  Config config_;
+};
+
+}  // namespace memgraph::storage
@@ -0,0 +1,273 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/inmemory/aggregate_index.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+#include "utils/algorithm.hpp"
+#include "utils/logging.hpp"
+#include "utils/memory_tracker.hpp"
+
+namespace memgraph::storage {
+
+namespace {
+
+PropertyValue Sum(uint64_t double_count, uint64_t non_number_count, int64_t int_sum, double double_sum) {
+  if (non_number_count != 0) return {};
+  if (double_count != 0) return PropertyValue(double_sum + static_cast<double>(int_sum));
+  return PropertyValue(int_sum);
+}
+
+}  // namespace
+
+bool InMemoryAggregateIndex::CreateIndex(const Key &key, utils::SkipList<Vertex>::Accessor vertices) {
+  auto [it, emplaced] = index_.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple());
+  if (!emplaced) {
+    // Index already exists.
+    return false;
+  }
+
+  utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+  try {
+    Populate(&it->second, key, vertices);
+  } catch (const utils::OutOfMemoryException &) {
+    utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+    index_.erase(it);
+    throw;
+  }
+  return true;
+}
+
+void InMemoryAggregateIndex::RebuildIndices(utils::SkipList<Vertex>::Accessor vertices) {
+  for (auto &[key, container] : index_) {
+    container.groups.clear();
+    Populate(&container, key, vertices);
+  }
+}
+
+void InMemoryAggregateIndex::Populate(IndexContainer *container, const Key &key,
+                                      utils::SkipList<Vertex>::Accessor &vertices) {
+  const auto &[label, group_property, value_property] = key;
+  for (const Vertex &vertex : vertices) {
+    if (vertex.deleted || !utils::Contains(vertex.labels, label)) continue;
+    // All transactions started after the index is populated see the vertices.
+    Apply(container,
+          {vertex.properties.GetProperty(group_property), vertex.properties.GetProperty(value_property), true}, 0);
+  }
+}
+
+bool InMemoryAggregateIndex::DropIndex(const Key &key) { return index_.erase(key) > 0; }
+
+bool InMemoryAggregateIndex::IndexExists(const Key &key) const { return index_.find(key) != index_.end(); }
+
+std::vector<AggregateIndex::Key> InMemoryAggregateIndex::ListIndices() const {
+  std::vector<Key> ret;
+  ret.reserve(index_.size());
+  for (const auto &item : index_) {
+    ret.push_back(item.first);
+  }
+  return ret;
+}
+
+void InMemoryAggregateIndex::CollectChanges(const Vertex &vertex, const Transaction &transaction,
+                                            Changes *changes) const {
+  if (index_.empty()) return;
+
+  // The state of the vertex before the transaction is reconstructed by undoing
+  // its deltas. No one else can change the vertex until the transaction
+  // commits, so it's read without the lock.
+  const bool exists = !vertex.deleted;
+  bool existed = exists;
+  auto labels = vertex.labels;
+  std::map<PropertyId, PropertyValue> old_properties;
+  const auto transaction_id = transaction.transaction_id.load(std::memory_order_acquire);
+  for (const Delta *delta = vertex.delta;
+       delta != nullptr && delta->timestamp->load(std::memory_order_acquire) == transaction_id;
+       delta = delta->next.load(std::memory_order_acquire)) {
+    switch (delta->action) {
+      case Delta::Action::DELETE_OBJECT:
+        existed = false;
+        break;
+      case Delta::Action::RECREATE_OBJECT:
+        existed = true;
+        break;
+      case Delta::Action::ADD_LABEL:
+        labels.push_back(delta->label);
+        break;
+      case Delta::Action::REMOVE_LABEL: {
+        auto it = std::find(labels.begin(), labels.end(), delta->label);
+        if (it != labels.end()) labels.erase(it);
+        break;
+      }
+      case Delta::Action::SET_PROPERTY:
+        // The oldest delta of the property holds the value before the
+        // transaction.
+        old_properties[delta->property.key] = delta->property.value;
+        break;
+      default:
+        break;
+    }
+  }
+
+  auto old_property = [&](PropertyId property) {
+    auto it = old_properties.find(property);
+    return it != old_properties.end() ? it->second : vertex.properties.GetProperty(property);
+  };
+
+  for (const auto &[key, container] : index_) {
+    const auto &[label, group_property, value_property] = key;
+    const bool was_member = existed && utils::Contains(labels, label);
+    const bool is_member = exists && utils::Contains(vertex.labels, label);
+    if (!was_member && !is_member) continue;
+    if (was_member && is_member && !old_properties.contains(group_property) &&
+        !old_properties.contains(value_property)) {
+      continue;
+    }
+    auto &contributions = (*changes)[key];
+    if (was_member) {
+      contributions.push_back({old_property(group_property), old_property(value_property), false});
+    }
+    if (is_member) {
+      contributions.push_back(
+          {vertex.properties.GetProperty(group_property), vertex.properties.GetProperty(value_property), true});
+    }
+  }
+}
+
+void InMemoryAggregateIndex::ApplyChanges(const Changes &changes, const uint64_t commit_timestamp) {
+  // The transactions which see the commit are the ones started after it.
+  const auto visible_from = commit_timestamp + 1;
+  for (const auto &[key, contributions] : changes) {
+    auto it = index_.find(key);
+    if (it == index_.end()) continue;
+    std::unique_lock guard(it->second.lock);
+    for (const auto &contribution : contributions) {
+      Apply(&it->second, contribution, visible_from);
+    }
+  }
+}
+
+void InMemoryAggregateIndex::Apply(IndexContainer *container, const Contribution &contribution,
+                                   const uint64_t visible_from) {
+  auto &group = container->groups[contribution.group];
+  if (group.versions.empty() || group.versions.back().first != visible_from) {
+    auto summary = group.versions.empty() ? Summary{} : group.versions.back().second;
+    group.versions.emplace_back(visible_from, std::move(summary));
+  }
+  auto &summary = group.versions.back().second;
+
+  if (!contribution.added) {
+    MG_ASSERT(summary.count > 0, "Invalid aggregate index state!");
+    --summary.count;
+  } else {
+    ++summary.count;
+  }
+  const auto &value = contribution.value;
+  if (value.IsNull()) return;
+
+  if (contribution.added) {
+    ++summary.value_count;
+    ++group.values[value];
+  } else {
+    auto value_it = group.values.find(value);
+    MG_ASSERT(summary.value_count > 0 && value_it != group.values.end(), "Invalid aggregate index state!");
+    --summary.value_count;
+    if (--value_it->second == 0) group.values.erase(value_it);
+  }
+  if (value.IsInt()) {
+    // The sum wraps around like the unsigned integers, so that removing a value
+    // always undoes adding it.
+    const auto int_value = static_cast<uint64_t>(value.ValueInt());
+    const auto int_sum = static_cast<uint64_t>(summary.int_sum);
+    summary.int_sum = static_cast<int64_t>(contribution.added ? int_sum + int_value : int_sum - int_value);
+  } else if (value.IsDouble()) {
+    if (contribution.added) {
+      ++summary.double_count;
+      summary.double_sum += value.ValueDouble();
+    } else {
+      --summary.double_count;
+      summary.double_sum -= value.ValueDouble();
+    }
+    // The rounding errors of the removed values don't outlive them.
+    if (summary.double_count == 0) summary.double_sum = 0.0;
+  } else if (contribution.added) {
+    ++summary.non_number_count;
+  } else {
+    --summary.non_number_count;
+  }
+  if (group.values.empty()) {
+    summary.min = PropertyValue();
+    summary.max = PropertyValue();
+  } else {
+    summary.min = group.values.begin()->first;
+    summary.max = group.values.rbegin()->first;
+  }
+}
+
+std::optional<std::vector<AggregateGroup>> InMemoryAggregateIndex::Lookup(const Key &key,
+                                                                           const Transaction &transaction) const {
+  // The versions are snapshots of the committed transactions. They are what a
+  // transaction sees only if it doesn't see the uncommitted changes, including
+  // its own.
+  if (transaction.isolation_level != IsolationLevel::SNAPSHOT_ISOLATION ||
+      transaction.storage_mode != StorageMode::IN_MEMORY_TRANSACTIONAL || !transaction.deltas.empty() ||
+      !transaction.commutative_updates.empty()) {
+    return std::nullopt;
+  }
+  auto it = index_.find(key);
+  if (it == index_.end()) return std::nullopt;
+
+  std::vector<AggregateGroup> groups;
+  std::shared_lock guard(it->second.lock);
+  for (const auto &[group_value, group] : it->second.groups) {
+    // The latest version which was committed before the transaction started.
+    auto version = std::upper_bound(
+        group.versions.begin(), group.versions.end(), transaction.start_timestamp,
+        [](uint64_t start_timestamp, const auto &item) { return start_timestamp < item.first; });
+    if (version == group.versions.begin()) continue;
+    const auto &summary = std::prev(version)->second;
+    if (summary.count == 0) continue;
+    groups.push_back({.group = group_value,
+                      .count = summary.count,
+                      .value_count = summary.value_count,
+                      .sum = Sum(summary.double_count, summary.non_number_count, summary.int_sum, summary.double_sum),
+                      .min = summary.min,
+                      .max = summary.max});
+  }
+  return groups;
+}
+
+void InMemoryAggregateIndex::RemoveObsoleteEntries(const uint64_t oldest_active_start_timestamp) {
+  for (auto &[key, container] : index_) {
+    std::unique_lock guard(container.lock);
+    for (auto it = container.groups.begin(); it != container.groups.end();) {
+      auto &versions = it->second.versions;
+      // Every active transaction sees the latest version visible to the oldest
+      // one or a newer version.
+      auto version = std::upper_bound(
+          versions.begin(), versions.end(), oldest_active_start_timestamp,
+          [](uint64_t start_timestamp, const auto &item) { return start_timestamp < item.first; });
+      if (version != versions.begin()) {
+        versions.erase(versions.begin(), std::prev(version));
+      }
+      if (versions.size() == 1 && versions.front().first <= oldest_active_start_timestamp &&
+          versions.front().second.count == 0) {
+        it = container.groups.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+}
+
+}  // namespace memgraph::storage
@@ -0,0 +1,118 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include "storage/v2/indices/aggregate_index.hpp"
+#include "storage/v2/transaction.hpp"
+#include "storage/v2/vertex.hpp"
+#include "utils/skip_list.hpp"
+
+namespace memgraph::storage {
+
+/// Unlike the other indices, the aggregate index isn't updated while a
+/// transaction changes the vertices. The changes of the aggregates are
+/// collected from the deltas of a transaction when it commits, and applied
+/// together with the commit timestamp. Every change makes a new version of
+/// the changed groups which is visible to the transactions started after the
+/// commit, so the lookups are consistent with the snapshot of the
+/// transaction. The versions which no transaction sees are removed by the
+/// garbage collection.
+class InMemoryAggregateIndex : public storage::AggregateIndex {
+ public:
+  /// A vertex which enters or leaves a group of an index.
+  struct Contribution {
+    PropertyValue group;
+    PropertyValue value;
+    bool added;
+  };
+
+  /// The contributions of the vertices changed by a transaction to each
+  /// index.
+  using Changes = std::map<Key, std::vector<Contribution>>;
+
+  /// Creates the index from all vertices which aren't deleted, which must be
+  /// called while no transaction is active. Returns false if the index already
+  /// exists.
+  /// @throw std::bad_alloc
+  bool CreateIndex(const Key &key, utils::SkipList<Vertex>::Accessor vertices);
+
+  /// Recreates all indices, e.g. after the analytical transactions, which
+  /// don't have deltas, changed the vertices.
+  /// @throw std::bad_alloc
+  void RebuildIndices(utils::SkipList<Vertex>::Accessor vertices);
+
+  bool DropIndex(const Key &key) override;
+
+  bool IndexExists(const Key &key) const override;
+
+  std::vector<Key> ListIndices() const override;
+
+  bool Empty() const { return index_.empty(); }
+
+  /// Adds the contributions of the vertex changed by the transaction, which
+  /// is about to commit, to `changes`.
+  /// @throw std::bad_alloc
+  void CollectChanges(const Vertex &vertex, const Transaction &transaction, Changes *changes) const;
+
+  /// Applies the changes of the transaction committed with the timestamp, which
+  /// must be called in the order of the commit timestamps.
+  /// @throw std::bad_alloc
+  void ApplyChanges(const Changes &changes, uint64_t commit_timestamp);
+
+  /// Returns the groups of the index as the transaction sees them, or
+  /// std::nullopt if the index doesn't exist or the transaction doesn't see a
+  /// snapshot of the committed transactions, e.g. because it changed the graph
+  /// itself.
+  std::optional<std::vector<AggregateGroup>> Lookup(const Key &key, const Transaction &transaction) const;
+
+  void RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp);
+
+ private:
+  struct Summary {
+    uint64_t count{0};
+    uint64_t value_count{0};
+    uint64_t double_count{0};
+    uint64_t non_number_count{0};
+    int64_t int_sum{0};
+    double double_sum{0.0};
+    PropertyValue min;
+    PropertyValue max;
+  };
+
+  struct Group {
+    // The values of the latest version, which keep the minimum and the
+    // maximum after the extreme values are removed.
+    std::map<PropertyValue, uint64_t> values;
+    // The versions from the oldest one, with the start timestamp of the
+    // first transaction which sees each of them.
+    std::vector<std::pair<uint64_t, Summary>> versions;
+  };
+
+  struct IndexContainer {
+    mutable std::shared_mutex lock;
+    std::map<PropertyValue, Group> groups;
+  };
+
+  static void Populate(IndexContainer *container, const Key &key, utils::SkipList<Vertex>::Accessor &vertices);
+
+  static void Apply(IndexContainer *container, const Contribution &contribution, uint64_t visible_from);
+
+  std::map<Key, IndexContainer> index_;
+};
+
+}  // namespace memgraph::storage
@@ -0,0 +1,153 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/inmemory/edge_type_index.hpp"
+
+#include "storage/v2/indices/indices_utils.hpp"
+#include "utils/memory_tracker.hpp"
+
+namespace memgraph::storage {
+
+InMemoryEdgeTypeIndex::InMemoryEdgeTypeIndex(Indices *indices, Constraints *constraints, const Config &config)
+    : EdgeTypeIndex(indices, constraints, config) {}
+
+bool InMemoryEdgeTypeIndex::CreateIndex(EdgeTypeId edge_type, utils::SkipList<Vertex>::Accessor vertices) {
+  auto [it, emplaced] = index_.emplace(std::piecewise_construct, std::forward_as_tuple(edge_type),
+                                       std::forward_as_tuple());
+  if (!emplaced) {
+    // Index already exists.
+    return false;
+  }
+
+  utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+  try {
+    auto acc = it->second.access();
+    for (auto &from_vertex : vertices) {
+      if (from_vertex.deleted) {
+        continue;
+      }
+      for (const auto &[type, to_vertex, edge_ref] : from_vertex.out_edges) {
+        if (type != edge_type) {
+          continue;
+        }
+        acc.insert({&from_vertex, to_vertex, edge_ref, 0});
+      }
+    }
+  } catch (const utils::OutOfMemoryException &) {
+    utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+    index_.erase(it);
+    throw;
+  }
+  return true;
+}
+
+void InMemoryEdgeTypeIndex::UpdateOnEdgeCreation(Vertex *from, Vertex *to, EdgeRef edge_ref, EdgeTypeId edge_type,
+                                                 const Transaction &tx) {
+  auto it = index_.find(edge_type);
+  if (it == index_.end()) {
+    return;
+  }
+  auto acc = it->second.access();
+  acc.insert(Entry{from, to, edge_ref, tx.start_timestamp});
+}
+
+bool InMemoryEdgeTypeIndex::DropIndex(EdgeTypeId edge_type) { return index_.erase(edge_type) > 0; }
+
+bool InMemoryEdgeTypeIndex::IndexExists(EdgeTypeId edge_type) const { return index_.find(edge_type) != index_.end(); }
+
+std::vector<EdgeTypeId> InMemoryEdgeTypeIndex::ListIndices() const {
+  std::vector<EdgeTypeId> ret;
+  ret.reserve(index_.size());
+  for (const auto &item : index_) {
+    ret.push_back(item.first);
+  }
+  return ret;
+}
+
+void InMemoryEdgeTypeIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
+  for (auto &[edge_type, index] : index_) {
+    auto index_acc = index.access();
+    for (auto it = index_acc.begin(); it != index_acc.end();) {
+      auto next_it = it;
+      ++next_it;
+
+      if (it->timestamp >= oldest_active_start_timestamp) {
+        it = next_it;
+        continue;
+      }
+
+      if (!AnyVersionHasEdge(*it->from_vertex, it->to_vertex, it->edge, edge_type, config_.items.EdgeRefsArePointers(),
+                             oldest_active_start_timestamp)) {
+        index_acc.remove(*it);
+      }
+
+      it = next_it;
+    }
+  }
+}
+
+InMemoryEdgeTypeIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, EdgeTypeId edge_type,
+                                          View view, Transaction *transaction, Indices *indices,
+                                          Constraints *constraints, const Config &config)
+    : index_accessor_(std::move(index_accessor)),
+      edge_type_(edge_type),
+      view_(view),
+      transaction_(transaction),
+      indices_(indices),
+      constraints_(constraints),
+      config_(config) {}
+
+InMemoryEdgeTypeIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator)
+    : self_(self),
+      index_iterator_(index_iterator),
+      current_edge_accessor_(EdgeRef(nullptr), EdgeTypeId::FromUint(0), nullptr, nullptr, nullptr, nullptr, nullptr,
+                             self_->config_.items) {
+  AdvanceUntilValid();
+}
+
+InMemoryEdgeTypeIndex::Iterable::Iterator &InMemoryEdgeTypeIndex::Iterable::Iterator::operator++() {
+  ++index_iterator_;
+  AdvanceUntilValid();
+  return *this;
+}
+
+void InMemoryEdgeTypeIndex::Iterable::Iterator::AdvanceUntilValid() {
+  for (; index_iterator_ != self_->index_accessor_.end(); ++index_iterator_) {
+    EdgeAccessor edge_accessor(index_iterator_->edge, self_->edge_type_, index_iterator_->from_vertex,
+                               index_iterator_->to_vertex, self_->transaction_, self_->indices_, self_->constraints_,
+                               self_->config_.items);
+    if (edge_accessor.IsVisible(self_->view_)) {
+      current_edge_accessor_ = edge_accessor;
+      break;
+    }
+  }
+}
+
+uint64_t InMemoryEdgeTypeIndex::ApproximateEdgeCount(EdgeTypeId edge_type) const {
+  auto it = index_.find(edge_type);
+  MG_ASSERT(it != index_.end(), "Index for edge type {} doesn't exist", edge_type.AsUint());
+  return it->second.size();
+}
+
+void InMemoryEdgeTypeIndex::RunGC() {
+  for (auto &index_entry : index_) {
+    index_entry.second.run_gc();
+  }
+}
+
+InMemoryEdgeTypeIndex::Iterable InMemoryEdgeTypeIndex::Edges(EdgeTypeId edge_type, View view,
+                                                             Transaction *transaction) {
+  auto it = index_.find(edge_type);
+  MG_ASSERT(it != index_.end(), "Index for edge type {} doesn't exist", edge_type.AsUint());
+  return {it->second.access(), edge_type, view, transaction, indices_, constraints_, config_};
+}
+
+}  // namespace memgraph::storage
@@ -0,0 +1,285 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/inmemory/edge_type_property_index.hpp"
+
+#include "storage/v2/indices/indices_utils.hpp"
+#include "storage/v2/inmemory/label_property_index.hpp"
+#include "utils/memory_tracker.hpp"
+
+namespace memgraph::storage {
+
+bool InMemoryEdgeTypePropertyIndex::Entry::operator<(const Entry &rhs) const {
+  if (value < rhs.value) {
+    return true;
+  }
+  if (rhs.value < value) {
+    return false;
+  }
+  return std::make_tuple(edge, timestamp) < std::make_tuple(rhs.edge, rhs.timestamp);
+}
+
+bool InMemoryEdgeTypePropertyIndex::Entry::operator==(const Entry &rhs) const {
+  return value == rhs.value && edge == rhs.edge && timestamp == rhs.timestamp;
+}
+
+bool InMemoryEdgeTypePropertyIndex::Entry::operator<(const PropertyValue &rhs) const { return value < rhs; }
+
+bool InMemoryEdgeTypePropertyIndex::Entry::operator==(const PropertyValue &rhs) const { return value == rhs; }
+
+InMemoryEdgeTypePropertyIndex::InMemoryEdgeTypePropertyIndex(Indices *indices, Constraints *constraints,
+                                                             const Config &config)
+    : EdgeTypePropertyIndex(indices, constraints, config) {}
+
+bool InMemoryEdgeTypePropertyIndex::CreateIndex(EdgeTypeId edge_type, PropertyId property,
+                                                utils::SkipList<Vertex>::Accessor vertices) {
+  MG_ASSERT(config_.items.EdgeRefsArePointers(), "Edge property indices require the edge objects!");
+  auto [it, emplaced] =
+      index_.emplace(std::piecewise_construct, std::forward_as_tuple(edge_type, property), std::forward_as_tuple());
+  if (!emplaced) {
+    // Index already exists.
+    return false;
+  }
+
+  utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+  try {
+    auto acc = it->second.access();
+    for (auto &from_vertex : vertices) {
+      if (from_vertex.deleted) {
+        continue;
+      }
+      for (const auto &[type, to_vertex, edge_ref] : from_vertex.out_edges) {
+        if (type != edge_type || edge_ref.ptr->deleted) {
+          continue;
+        }
+        auto value = edge_ref.ptr->properties.GetProperty(property);
+        if (value.IsNull()) {
+          continue;
+        }
+        acc.insert({std::move(value), &from_vertex, to_vertex, edge_ref.ptr, 0});
+      }
+    }
+  } catch (const utils::OutOfMemoryException &) {
+    utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+    index_.erase(it);
+    throw;
+  }
+  indices_by_property_[property].emplace(edge_type, &it->second);
+  return true;
+}
+
+void InMemoryEdgeTypePropertyIndex::UpdateOnSetProperty(EdgeTypeId edge_type, PropertyId property,
+                                                        const PropertyValue &value, Vertex *from, Vertex *to,
+                                                        Edge *edge, const Transaction &tx) {
+  if (value.IsNull()) {
+    return;
+  }
+  auto property_it = indices_by_property_.find(property);
+  if (property_it == indices_by_property_.end()) {
+    return;
+  }
+  auto it = property_it->second.find(edge_type);
+  if (it == property_it->second.end()) {
+    return;
+  }
+  auto acc = it->second->access();
+  acc.insert(Entry{value, from, to, edge, tx.start_timestamp});
+}
+
+bool InMemoryEdgeTypePropertyIndex::DropIndex(EdgeTypeId edge_type, PropertyId property) {
+  if (auto it = indices_by_property_.find(property); it != indices_by_property_.end()) {
+    it->second.erase(edge_type);
+    if (it->second.empty()) {
+      indices_by_property_.erase(it);
+    }
+  }
+  return index_.erase({edge_type, property}) > 0;
+}
+
+bool InMemoryEdgeTypePropertyIndex::IndexExists(EdgeTypeId edge_type, PropertyId property) const {
+  return index_.find({edge_type, property}) != index_.end();
+}
+
+std::vector<std::pair<EdgeTypeId, PropertyId>> InMemoryEdgeTypePropertyIndex::ListIndices() const {
+  std::vector<std::pair<EdgeTypeId, PropertyId>> ret;
+  ret.reserve(index_.size());
+  for (const auto &item : index_) {
+    ret.push_back(item.first);
+  }
+  return ret;
+}
+
+void InMemoryEdgeTypePropertyIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
+  for (auto &[edge_type_property, index] : index_) {
+    auto index_acc = index.access();
+    for (auto it = index_acc.begin(); it != index_acc.end();) {
+      auto next_it = it;
+      ++next_it;
+
+      if (it->timestamp >= oldest_active_start_timestamp) {
+        it = next_it;
+        continue;
+      }
+
+      if ((next_it != index_acc.end() && it->edge == next_it->edge && it->value == next_it->value) ||
+          !AnyVersionHasEdgeProperty(*it->edge, edge_type_property.second, it->value, oldest_active_start_timestamp)) {
+        index_acc.remove(*it);
+      }
+
+      it = next_it;
+    }
+  }
+}
+
+InMemoryEdgeTypePropertyIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor,
+                                                  EdgeTypeId edge_type, PropertyId property,
+                                                  const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+                                                  const std::optional<utils::Bound<PropertyValue>> &upper_bound,
+                                                  View view, Transaction *transaction, Indices *indices,
+                                                  Constraints *constraints, const Config &config)
+    : index_accessor_(std::move(index_accessor)),
+      edge_type_(edge_type),
+      property_(property),
+      lower_bound_(lower_bound),
+      upper_bound_(upper_bound),
+      view_(view),
+      transaction_(transaction),
+      indices_(indices),
+      constraints_(constraints),
+      config_(config) {
+  bounds_valid_ = NormalizePropertyValueBounds(&lower_bound_, &upper_bound_);
+}
+
+InMemoryEdgeTypePropertyIndex::Iterable::Iterator::Iterator(Iterable *self,
+                                                            utils::SkipList<Entry>::Iterator index_iterator)
+    : self_(self),
+      index_iterator_(index_iterator),
+      current_edge_accessor_(EdgeRef(nullptr), EdgeTypeId::FromUint(0), nullptr, nullptr, nullptr, nullptr, nullptr,
+                             self_->config_.items),
+      current_edge_(nullptr) {
+  AdvanceUntilValid();
+}
+
+InMemoryEdgeTypePropertyIndex::Iterable::Iterator &InMemoryEdgeTypePropertyIndex::Iterable::Iterator::operator++() {
+  ++index_iterator_;
+  AdvanceUntilValid();
+  return *this;
+}
+
+void InMemoryEdgeTypePropertyIndex::Iterable::Iterator::AdvanceUntilValid() {
+  for (; index_iterator_ != self_->index_accessor_.end(); ++index_iterator_) {
+    if (index_iterator_->edge == current_edge_) {
+      continue;
+    }
+
+    if (self_->lower_bound_) {
+      if (index_iterator_->value < self_->lower_bound_->value()) {
+        continue;
+      }
+      if (!self_->lower_bound_->IsInclusive() && index_iterator_->value == self_->lower_bound_->value()) {
+        continue;
+      }
+    }
+    if (self_->upper_bound_) {
+      if (self_->upper_bound_->value() < index_iterator_->value) {
+        index_iterator_ = self_->index_accessor_.end();
+        break;
+      }
+      if (!self_->upper_bound_->IsInclusive() && index_iterator_->value == self_->upper_bound_->value()) {
+        index_iterator_ = self_->index_accessor_.end();
+        break;
+      }
+    }
+
+    EdgeAccessor edge_accessor(EdgeRef(index_iterator_->edge), self_->edge_type_, index_iterator_->from_vertex,
+                               index_iterator_->to_vertex, self_->transaction_, self_->indices_, self_->constraints_,
+                               self_->config_.items);
+    if (!edge_accessor.IsVisible(self_->view_)) {
+      continue;
+    }
+    auto value = edge_accessor.GetProperty(self_->property_, self_->view_);
+    if (value.HasError() || *value != index_iterator_->value) {
+      continue;
+    }
+    current_edge_ = index_iterator_->edge;
+    current_edge_accessor_ = edge_accessor;
+    break;
+  }
+}
+
+InMemoryEdgeTypePropertyIndex::Iterable::Iterator InMemoryEdgeTypePropertyIndex::Iterable::begin() {
+  // If the bounds are set and don't have comparable types we don't yield any
+  // items from the index.
+  if (!bounds_valid_) return {this, index_accessor_.end()};
+  auto index_iterator = index_accessor_.begin();
+  if (lower_bound_) {
+    index_iterator = index_accessor_.find_equal_or_greater(lower_bound_->value());
+  }
+  return {this, index_iterator};
+}
+
+InMemoryEdgeTypePropertyIndex::Iterable::Iterator InMemoryEdgeTypePropertyIndex::Iterable::end() {
+  return {this, index_accessor_.end()};
+}
+
+uint64_t InMemoryEdgeTypePropertyIndex::ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property) const {
+  auto it = index_.find({edge_type, property});
+  MG_ASSERT(it != index_.end(), "Index for edge type {} and property {} doesn't exist", edge_type.AsUint(),
+            property.AsUint());
+  return it->second.size();
+}
+
+uint64_t InMemoryEdgeTypePropertyIndex::ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property,
+                                                             const PropertyValue &value) const {
+  auto it = index_.find({edge_type, property});
+  MG_ASSERT(it != index_.end(), "Index for edge type {} and property {} doesn't exist", edge_type.AsUint(),
+            property.AsUint());
+  auto acc = it->second.access();
+  if (!value.IsNull()) {
+    // NOLINTNEXTLINE(bugprone-narrowing-conversions,cppcoreguidelines-narrowing-conversions)
+    return acc.estimate_count(value, utils::SkipListLayerForCountEstimation(acc.size()));
+  }
+  // Same as in the label-property index, `Null` is used to estimate the
+  // average number of equal elements in the list.
+  return acc.estimate_average_number_of_equals(
+      [](const auto &first, const auto &second) { return first.value == second.value; },
+      // NOLINTNEXTLINE(bugprone-narrowing-conversions,cppcoreguidelines-narrowing-conversions)
+      utils::SkipListLayerForAverageEqualsEstimation(acc.size()));
+}
+
+uint64_t InMemoryEdgeTypePropertyIndex::ApproximateEdgeCount(
+    EdgeTypeId edge_type, PropertyId property, const std::optional<utils::Bound<PropertyValue>> &lower,
+    const std::optional<utils::Bound<PropertyValue>> &upper) const {
+  auto it = index_.find({edge_type, property});
+  MG_ASSERT(it != index_.end(), "Index for edge type {} and property {} doesn't exist", edge_type.AsUint(),
+            property.AsUint());
+  auto acc = it->second.access();
+  // NOLINTNEXTLINE(bugprone-narrowing-conversions,cppcoreguidelines-narrowing-conversions)
+  return acc.estimate_range_count(lower, upper, utils::SkipListLayerForCountEstimation(acc.size()));
+}
+
+void InMemoryEdgeTypePropertyIndex::RunGC() {
+  for (auto &index_entry : index_) {
+    index_entry.second.run_gc();
+  }
+}
+
+InMemoryEdgeTypePropertyIndex::Iterable InMemoryEdgeTypePropertyIndex::Edges(
+    EdgeTypeId edge_type, PropertyId property, const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+    const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view, Transaction *transaction) {
+  auto it = index_.find({edge_type, property});
+  MG_ASSERT(it != index_.end(), "Index for edge type {} and property {} doesn't exist", edge_type.AsUint(),
+            property.AsUint());
+  return {it->second.access(), edge_type, property,     lower_bound, upper_bound, view,
+          transaction,         indices_,  constraints_, config_};
+}
+
+}  // namespace memgraph::storage
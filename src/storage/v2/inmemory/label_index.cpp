@@ -12,6 +12,11 @@
 #include "storage/v2/inmemory/label_index.hpp"
 #include "storage/v2/indices/indices_utils.hpp"
 
+#include <algorithm>
+#include <mutex>
+
+#include "utils/memory_tracker.hpp"
+
 namespace memgraph::storage {
 
 InMemoryLabelIndex::InMemoryLabelIndex(Indices *indices, Constraints *constraints, Config config)
@@ -22,6 +27,9 @@ void InMemoryLabelIndex::UpdateOnAddLabel(LabelId added_label, Vertex *vertex_af
   if (it == index_.end()) return;
   auto acc = it->second.access();
   acc.insert(Entry{vertex_after_update, tx.start_timestamp});
+  // The bit is set while the vertex is still locked by the caller, which
+  // `RemoveObsoleteEntries` relies on when clearing the bits.
+  bitsets_.at(added_label).access().Set(vertex_after_update->gid.AsUint());
 }
 
 bool InMemoryLabelIndex::CreateIndex(LabelId label, utils::SkipList<Vertex>::Accessor vertices,
@@ -30,9 +38,12 @@ bool InMemoryLabelIndex::CreateIndex(LabelId label, utils::SkipList<Vertex>::Acc
                                        std::map<LabelId, utils::SkipList<Entry>>::iterator it) {
     using IndexAccessor = decltype(it->second.access());
 
+    // The vertices are visited in gid order, which mostly matches the order of
+    // their addresses, so the entries tend to be inserted in sorted order.
+    IndexAccessor::InsertHint hint;
     CreateIndexOnSingleThread(vertices, it, index_, label,
-                              [](Vertex &vertex, LabelId label, IndexAccessor &index_accessor) {
-                                TryInsertLabelIndex(vertex, label, index_accessor);
+                              [&hint](Vertex &vertex, LabelId label, IndexAccessor &index_accessor) {
+                                TryInsertLabelIndex(vertex, label, index_accessor, &hint);
                               });
 
     return true;
@@ -58,19 +69,84 @@ bool InMemoryLabelIndex::CreateIndex(LabelId label, utils::SkipList<Vertex>::Acc
   }
 
   if (parallel_exec_info) {
-    return create_index_par(label, vertices, it, *parallel_exec_info);
+    create_index_par(label, vertices, it, *parallel_exec_info);
+  } else {
+    create_index_seq(label, vertices, it);
   }
-  return create_index_seq(label, vertices, it);
+
+  utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+  auto bitset_it =
+      bitsets_.emplace(std::piecewise_construct, std::forward_as_tuple(label), std::forward_as_tuple()).first;
+  try {
+    auto bitset_acc = bitset_it->second.access();
+    for (const auto &entry : it->second.access()) {
+      bitset_acc.Set(entry.vertex->gid.AsUint());
+    }
+  } catch (const utils::OutOfMemoryException &) {
+    utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+    bitsets_.erase(bitset_it);
+    index_.erase(it);
+    throw;
+  }
+  return true;
 }
 
-bool InMemoryLabelIndex::DropIndex(LabelId label) { return index_.erase(label) > 0; }
+bool InMemoryLabelIndex::RegisterIndex(LabelId label) {
+  auto [it, emplaced] = index_.emplace(std::piecewise_construct, std::forward_as_tuple(label), std::forward_as_tuple());
+  if (!emplaced) {
+    return false;
+  }
+  bitsets_.emplace(std::piecewise_construct, std::forward_as_tuple(label), std::forward_as_tuple());
+  pending_.insert(label);
+  return true;
+}
 
-bool InMemoryLabelIndex::IndexExists(LabelId label) const { return index_.find(label) != index_.end(); }
+auto InMemoryLabelIndex::MakePopulator(LabelId label) {
+  return [index_acc = index_.at(label).access(), bitset_acc = bitsets_.at(label).access(),
+          label](Vertex &vertex) mutable {
+    // The entry and the bit are set while the vertex is locked, like the ones
+    // of the running transactions, so the GC can't remove the vertex or clear
+    // the bit in between.
+    std::lock_guard guard(vertex.lock);
+    bool has_label = false;
+    ForEachVersionWithLabel(vertex, label, std::nullopt, [&has_label](const PropertyValue &) { has_label = true; });
+    if (!has_label) return;
+    index_acc.insert(Entry{&vertex, 0});
+    bitset_acc.Set(vertex.gid.AsUint());
+  };
+}
+
+void InMemoryLabelIndex::PopulateIndex(LabelId label, utils::SkipList<Vertex>::Accessor vertices,
+                                       uint64_t thread_count) {
+  ForEachVertexInParallel(vertices, thread_count, [this, label]() { return MakePopulator(label); });
+}
+
+void InMemoryLabelIndex::PopulateIndex(LabelId label, const std::vector<Vertex *> &vertices) {
+  auto populate = MakePopulator(label);
+  for (auto *vertex : vertices) {
+    populate(*vertex);
+  }
+}
+
+bool InMemoryLabelIndex::PublishIndex(LabelId label) { return pending_.erase(label) > 0 && index_.contains(label); }
+
+bool InMemoryLabelIndex::DropPendingIndex(LabelId label) { return pending_.contains(label) && DropIndex(label); }
+
+bool InMemoryLabelIndex::DropIndex(LabelId label) {
+  bitsets_.erase(label);
+  pending_.erase(label);
+  return index_.erase(label) > 0;
+}
+
+bool InMemoryLabelIndex::IndexExists(LabelId label) const {
+  return index_.find(label) != index_.end() && !pending_.contains(label);
+}
 
 std::vector<LabelId> InMemoryLabelIndex::ListIndices() const {
   std::vector<LabelId> ret;
   ret.reserve(index_.size());
   for (const auto &item : index_) {
+    if (pending_.contains(item.first)) continue;
     ret.push_back(item.first);
   }
   return ret;
@@ -79,6 +155,7 @@ std::vector<LabelId> InMemoryLabelIndex::ListIndices() const {
 void InMemoryLabelIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
   for (auto &label_storage : index_) {
     auto vertices_acc = label_storage.second.access();
+    auto bitset_acc = bitsets_.at(label_storage.first).access();
     for (auto it = vertices_acc.begin(); it != vertices_acc.end();) {
       auto next_it = it;
       ++next_it;
@@ -88,9 +165,19 @@ void InMemoryLabelIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_time
         continue;
       }
 
-      if ((next_it != vertices_acc.end() && it->vertex == next_it->vertex) ||
-          !AnyVersionHasLabel(*it->vertex, label_storage.first, oldest_active_start_timestamp)) {
+      if (next_it != vertices_acc.end() && it->vertex == next_it->vertex) {
+        vertices_acc.remove(*it);
+      } else if (!AnyVersionHasLabel(*it->vertex, label_storage.first, oldest_active_start_timestamp)) {
+        Vertex *vertex = it->vertex;
         vertices_acc.remove(*it);
+        // The label could have been added (and even removed again) after the
+        // check above, so the bit is cleared only if the vertex still doesn't
+        // have it and there are no deltas which could bring it back. Adding
+        // the label sets the bit under the same lock, so it can't be lost.
+        std::lock_guard guard(vertex->lock);
+        if (vertex->delta == nullptr && (vertex->deleted || !utils::Contains(vertex->labels, label_storage.first))) {
+          bitset_acc.Clear(vertex->gid.AsUint());
+        }
       }
 
       it = next_it;
@@ -100,14 +187,22 @@ void InMemoryLabelIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_time
 
 InMemoryLabelIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label, View view,
                                        Transaction *transaction, Indices *indices, Constraints *constraints,
-                                       const Config &config)
+                                       const Config &config,
+                                       std::vector<utils::SparseBitset::Accessor> filter_bitsets,
+                                       std::vector<PropertyId> filter_keys, std::vector<PropertyValue> filter_values,
+                                       Vertex *lower_bound, Vertex *upper_bound)
     : index_accessor_(std::move(index_accessor)),
       label_(label),
       view_(view),
       transaction_(transaction),
       indices_(indices),
       constraints_(constraints),
-      config_(config) {}
+      config_(config),
+      filter_bitsets_(std::move(filter_bitsets)),
+      filter_keys_(std::move(filter_keys)),
+      filter_values_(std::move(filter_values)),
+      lower_bound_(lower_bound),
+      upper_bound_(upper_bound) {}
 
 InMemoryLabelIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator)
     : self_(self),
@@ -125,9 +220,33 @@ InMemoryLabelIndex::Iterable::Iterator &InMemoryLabelIndex::Iterable::Iterator::
 
 void InMemoryLabelIndex::Iterable::Iterator::AdvanceUntilValid() {
   for (; index_iterator_ != self_->index_accessor_.end(); ++index_iterator_) {
+    // The next entry is already being prefetched by the skip list, so the
+    // vertex it points to is fetched while this one is checked.
+    if (const auto *next = index_iterator_.PeekNext()) PrefetchVertex(next->vertex);
+    if (self_->upper_bound_ && !std::less<Vertex *>{}(index_iterator_->vertex, self_->upper_bound_)) {
+      index_iterator_ = self_->index_accessor_.end();
+      break;
+    }
     if (index_iterator_->vertex == current_vertex_) {
       continue;
     }
+    const auto gid = index_iterator_->vertex->gid.AsUint();
+    if (!std::all_of(self_->filter_bitsets_.begin(), self_->filter_bitsets_.end(),
+                     [gid](const auto &bitset) { return bitset.Test(gid); })) {
+      continue;
+    }
+    if (!self_->filter_keys_.empty()) {
+      // The label and the properties are checked together on the visible
+      // version, so the vertex isn't read again through an accessor.
+      if (!CurrentVersionHasLabelProperties(*index_iterator_->vertex, self_->label_, self_->filter_keys_,
+                                            self_->filter_values_, self_->transaction_, self_->view_)) {
+        continue;
+      }
+      current_vertex_ = index_iterator_->vertex;
+      current_vertex_accessor_ = VertexAccessor{current_vertex_, self_->transaction_, self_->indices_,
+                                                self_->constraints_, self_->config_.items};
+      break;
+    }
     auto accessor = VertexAccessor{index_iterator_->vertex, self_->transaction_, self_->indices_, self_->constraints_,
                                    self_->config_.items};
     auto res = accessor.HasLabel(self_->label_, self_->view_);
@@ -157,32 +276,101 @@ InMemoryLabelIndex::Iterable InMemoryLabelIndex::Vertices(LabelId label, View vi
   return {it->second.access(), label, view, transaction, indices_, constraints_, config_};
 }
 
+InMemoryLabelIndex::Iterable InMemoryLabelIndex::Vertices(LabelId label, const std::vector<LabelId> &filter_labels,
+                                                          View view, Transaction *transaction) {
+  return Vertices(label, filter_labels, {}, view, transaction);
+}
+
+InMemoryLabelIndex::Iterable InMemoryLabelIndex::Vertices(
+    LabelId label, const std::vector<LabelId> &filter_labels,
+    const std::vector<std::pair<PropertyId, PropertyValue>> &filter_properties, View view, Transaction *transaction) {
+  const auto it = index_.find(label);
+  MG_ASSERT(it != index_.end(), "Index for label {} doesn't exist", label.AsUint());
+  std::vector<utils::SparseBitset::Accessor> filter_bitsets;
+  for (const auto filter_label : filter_labels) {
+    if (filter_label == label) continue;
+    if (auto bitset_it = bitsets_.find(filter_label); bitset_it != bitsets_.end()) {
+      filter_bitsets.push_back(bitset_it->second.access());
+    }
+  }
+  std::vector<PropertyId> filter_keys;
+  std::vector<PropertyValue> filter_values;
+  filter_keys.reserve(filter_properties.size());
+  filter_values.reserve(filter_properties.size());
+  for (const auto &[property, value] : filter_properties) {
+    filter_keys.push_back(property);
+    filter_values.push_back(value);
+  }
+  return {it->second.access(),
+          label,
+          view,
+          transaction,
+          indices_,
+          constraints_,
+          config_,
+          std::move(filter_bitsets),
+          std::move(filter_keys),
+          std::move(filter_values)};
+}
+
+std::vector<InMemoryLabelIndex::Iterable> InMemoryLabelIndex::PartitionVertices(LabelId label, View view,
+                                                                                 Transaction *transaction,
+                                                                                 uint64_t max_partitions) {
+  const auto it = index_.find(label);
+  MG_ASSERT(it != index_.end(), "Index for label {} doesn't exist", label.AsUint());
+  std::vector<Vertex *> split_vertices;
+  {
+    auto index_acc = it->second.access();
+    for (auto point : index_acc.partition_points(max_partitions)) {
+      // The entries of the same vertex are adjacent, so the ranges are split
+      // only between vertices.
+      if (split_vertices.empty() || split_vertices.back() != point->vertex) split_vertices.push_back(point->vertex);
+    }
+  }
+
+  std::vector<Iterable> partitions;
+  partitions.reserve(split_vertices.size() + 1);
+  Vertex *lower_bound = nullptr;
+  for (size_t i = 0; i <= split_vertices.size(); ++i) {
+    auto *upper_bound = i < split_vertices.size() ? split_vertices[i] : nullptr;
+    partitions.emplace_back(it->second.access(), label, view, transaction, indices_, constraints_, config_,
+                            std::vector<utils::SparseBitset::Accessor>{}, std::vector<PropertyId>{},
+                            std::vector<PropertyValue>{}, lower_bound, upper_bound);
+    lower_bound = upper_bound;
+  }
+  return partitions;
+}
+
 void InMemoryLabelIndex::SetIndexStats(const storage::LabelId &label, const storage::LabelIndexStats &stats) {
-  stats_[label] = stats;
+  auto locked_stats = stats_.Lock();
+  (*locked_stats)[label] = stats;
 }
 
 std::optional<LabelIndexStats> InMemoryLabelIndex::GetIndexStats(const storage::LabelId &label) const {
-  if (auto it = stats_.find(label); it != stats_.end()) {
+  auto locked_stats = stats_.ReadLock();
+  if (auto it = locked_stats->find(label); it != locked_stats->end()) {
     return it->second;
   }
   return {};
 }
 
 std::vector<LabelId> InMemoryLabelIndex::ClearIndexStats() {
+  auto locked_stats = stats_.Lock();
   std::vector<LabelId> deleted_indexes;
-  deleted_indexes.reserve(stats_.size());
-  std::transform(stats_.begin(), stats_.end(), std::back_inserter(deleted_indexes),
+  deleted_indexes.reserve(locked_stats->size());
+  std::transform(locked_stats->begin(), locked_stats->end(), std::back_inserter(deleted_indexes),
                  [](const auto &elem) { return elem.first; });
-  stats_.clear();
+  locked_stats->clear();
   return deleted_indexes;
 }
 
 std::vector<LabelId> InMemoryLabelIndex::DeleteIndexStats(const storage::LabelId &label) {
+  auto locked_stats = stats_.Lock();
   std::vector<LabelId> deleted_indexes;
-  for (auto it = stats_.cbegin(); it != stats_.cend();) {
+  for (auto it = locked_stats->cbegin(); it != locked_stats->cend();) {
     if (it->first == label) {
       deleted_indexes.push_back(it->first);
-      it = stats_.erase(it);
+      it = locked_stats->erase(it);
     } else {
       ++it;
     }
@@ -13,6 +13,9 @@
 
 #include "storage/v2/indices/label_index.hpp"
 #include "storage/v2/vertex.hpp"
+#include "utils/rw_lock.hpp"
+#include "utils/sparse_bitset.hpp"
+#include "utils/synchronized.hpp"
 
 namespace memgraph::storage {
 
@@ -48,6 +51,33 @@ class InMemoryLabelIndex : public storage::LabelIndex {
   bool CreateIndex(LabelId label, utils::SkipList<Vertex>::Accessor vertices,
                    const std::optional<ParallelizedIndexCreationInfo> &parallel_exec_info);
 
+  /// Creates an empty index which is kept up to date by the running
+  /// transactions but isn't used until `PublishIndex` is called. Returns false
+  /// if the index already exists. It must be called while no transaction is
+  /// running, but `PopulateIndex` below can run concurrently with them.
+  /// @throw std::bad_alloc
+  bool RegisterIndex(LabelId label);
+
+  /// Inserts all vertices which the index registered with `RegisterIndex` has
+  /// to contain, using up to `thread_count` threads.
+  /// @throw utils::OutOfMemoryException
+  void PopulateIndex(LabelId label, utils::SkipList<Vertex>::Accessor vertices, uint64_t thread_count);
+
+  /// Inserts the given vertices into the index registered with `RegisterIndex`
+  /// if they have to be in it. Used to index each batch of the vertices
+  /// recovered from a snapshot by the thread that loaded it.
+  /// @throw utils::OutOfMemoryException
+  void PopulateIndex(LabelId label, const std::vector<Vertex *> &vertices);
+
+  /// Makes the populated index visible. Returns false if it was dropped in the
+  /// meantime.
+  bool PublishIndex(LabelId label);
+
+  /// Drops the index if it was registered but not published yet. Used when
+  /// the population of the index fails. Returns false if there was no such
+  /// index.
+  bool DropPendingIndex(LabelId label);
+
   /// Returns false if there was no index to drop
   bool DropIndex(LabelId label) override;
 
@@ -60,7 +90,10 @@ class InMemoryLabelIndex : public storage::LabelIndex {
   class Iterable {
    public:
     Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label, View view, Transaction *transaction,
-             Indices *indices, Constraints *constraints, const Config &config);
+             Indices *indices, Constraints *constraints, const Config &config,
+             std::vector<utils::SparseBitset::Accessor> filter_bitsets = {},
+             std::vector<PropertyId> filter_keys = {}, std::vector<PropertyValue> filter_values = {},
+             Vertex *lower_bound = nullptr, Vertex *upper_bound = nullptr);
 
     class Iterator {
      public:
@@ -82,7 +115,10 @@ class InMemoryLabelIndex : public storage::LabelIndex {
       Vertex *current_vertex_;
     };
 
-    Iterator begin() { return {this, index_accessor_.begin()}; }
+    Iterator begin() {
+      return {this, lower_bound_ ? index_accessor_.find_equal_or_greater(Entry{lower_bound_, 0})
+                                 : index_accessor_.begin()};
+    }
     Iterator end() { return {this, index_accessor_.end()}; }
 
    private:
@@ -93,6 +129,15 @@ class InMemoryLabelIndex : public storage::LabelIndex {
     Indices *indices_;
     Constraints *constraints_;
     Config config_;
+    std::vector<utils::SparseBitset::Accessor> filter_bitsets_;
+    // Properties which the visible version of a vertex has to have equal to
+    // the values at the same positions.
+    std::vector<PropertyId> filter_keys_;
+    std::vector<PropertyValue> filter_values_;
+    // Only the entries of the vertices in `[lower_bound_, upper_bound_)` are
+    // iterated, a null bound doesn't limit the range.
+    Vertex *lower_bound_;
+    Vertex *upper_bound_;
   };
 
   uint64_t ApproximateVertexCount(LabelId label) const override;
@@ -101,6 +146,26 @@ class InMemoryLabelIndex : public storage::LabelIndex {
 
   Iterable Vertices(LabelId label, View view, Transaction *transaction);
 
+  /// Same as above, but vertices whose gids aren't in the bitsets of the
+  /// indexed labels among `filter_labels` are skipped without being read. The
+  /// remaining vertices aren't guaranteed to have the filter labels, they still
+  /// have to be checked by the caller.
+  Iterable Vertices(LabelId label, const std::vector<LabelId> &filter_labels, View view, Transaction *transaction);
+
+  /// Same as above, but vertices whose visible version doesn't have all of the
+  /// `filter_properties` equal to their values are skipped as well. They are
+  /// compared on the vertex's PropertyStore before an accessor is created.
+  Iterable Vertices(LabelId label, const std::vector<LabelId> &filter_labels,
+                    const std::vector<std::pair<PropertyId, PropertyValue>> &filter_properties, View view,
+                    Transaction *transaction);
+
+  /// Splits the vertices with the label into at most `max_partitions`
+  /// disjoint ranges by sampling the index entries, see
+  /// `utils::SkipList::Accessor::partition_points`. All entries of a vertex
+  /// are in the same range.
+  std::vector<Iterable> PartitionVertices(LabelId label, View view, Transaction *transaction,
+                                          uint64_t max_partitions);
+
   void SetIndexStats(const storage::LabelId &label, const storage::LabelIndexStats &stats);
 
   std::optional<storage::LabelIndexStats> GetIndexStats(const storage::LabelId &label) const;
@@ -110,8 +175,20 @@ class InMemoryLabelIndex : public storage::LabelIndex {
   std::vector<LabelId> DeleteIndexStats(const storage::LabelId &label);
 
  private:
+  /// Returns a function that inserts a vertex into the registered index of
+  /// `label` if any of its versions has the label.
+  auto MakePopulator(LabelId label);
+
   std::map<LabelId, utils::SkipList<Entry>> index_;
-  std::map<LabelId, storage::LabelIndexStats> stats_;
+  // For each indexed label, the gids of all vertices which have an entry in
+  // the index. A bit is cleared only once no version of its vertex can have
+  // the label anymore, so a clear bit means that the vertex doesn't have the
+  // label in any transaction.
+  std::map<LabelId, utils::SparseBitset> bitsets_;
+  // Written by ANALYZE GRAPH and the statistics refresh while the planner reads them.
+  utils::Synchronized<std::map<LabelId, storage::LabelIndexStats>, utils::WritePrioritizedRWLock> stats_;
+  // Registered indices which are still being populated.
+  std::set<LabelId> pending_;
 };
 
 }  // namespace memgraph::storage
@@ -0,0 +1,358 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/inmemory/label_property_composite_index.hpp"
+
+#include <algorithm>
+#include <optional>
+
+#include "storage/v2/indices/indices_utils.hpp"
+#include "storage/v2/inmemory/label_property_index.hpp"
+#include "utils/memory_tracker.hpp"
+
+namespace memgraph::storage {
+
+namespace {
+
+// Compares the first `size` values of both lists lexicographically.
+int CompareValues(const std::vector<PropertyValue> &lhs, const std::vector<PropertyValue> &rhs, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    if (lhs[i] < rhs[i]) return -1;
+    if (rhs[i] < lhs[i]) return 1;
+  }
+  return 0;
+}
+
+// Returns the values of all given properties, or std::nullopt if the vertex
+// doesn't have some of them. The vertex must be locked by the caller.
+std::optional<std::vector<PropertyValue>> GetIndexedValues(const Vertex &vertex,
+                                                           const std::vector<PropertyId> &properties) {
+  std::vector<PropertyValue> values;
+  values.reserve(properties.size());
+  for (const auto property : properties) {
+    auto value = vertex.properties.GetProperty(property);
+    if (value.IsNull()) return std::nullopt;
+    values.push_back(std::move(value));
+  }
+  return values;
+}
+
+}  // namespace
+
+bool InMemoryLabelPropertyCompositeIndex::Entry::operator<(const Entry &rhs) const {
+  MG_ASSERT(values.size() == rhs.values.size(), "Comparing entries of different indices!");
+  if (auto cmp = CompareValues(values, rhs.values, values.size()); cmp != 0) {
+    return cmp < 0;
+  }
+  return std::make_tuple(vertex, timestamp) < std::make_tuple(rhs.vertex, rhs.timestamp);
+}
+
+bool InMemoryLabelPropertyCompositeIndex::Entry::operator==(const Entry &rhs) const {
+  return values == rhs.values && vertex == rhs.vertex && timestamp == rhs.timestamp;
+}
+
+bool InMemoryLabelPropertyCompositeIndex::Entry::operator<(const std::vector<PropertyValue> &rhs) const {
+  return CompareValues(values, rhs, std::min(values.size(), rhs.size())) < 0;
+}
+
+bool InMemoryLabelPropertyCompositeIndex::Entry::operator==(const std::vector<PropertyValue> &rhs) const {
+  return CompareValues(values, rhs, std::min(values.size(), rhs.size())) == 0;
+}
+
+InMemoryLabelPropertyCompositeIndex::InMemoryLabelPropertyCompositeIndex(Indices *indices, Constraints *constraints,
+                                                                         const Config &config)
+    : LabelPropertyCompositeIndex(indices, constraints, config) {}
+
+bool InMemoryLabelPropertyCompositeIndex::CreateIndex(LabelId label, const std::vector<PropertyId> &properties,
+                                                      utils::SkipList<Vertex>::Accessor vertices) {
+  MG_ASSERT(properties.size() > 1, "Composite index needs at least two properties!");
+  auto [it, emplaced] = index_.emplace(std::piecewise_construct, std::forward_as_tuple(label, properties),
+                                       std::forward_as_tuple());
+  if (!emplaced) {
+    // Index already exists.
+    return false;
+  }
+
+  utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+  try {
+    auto acc = it->second.access();
+    for (Vertex &vertex : vertices) {
+      if (vertex.deleted || !utils::Contains(vertex.labels, label)) continue;
+      auto values = GetIndexedValues(vertex, properties);
+      if (!values) continue;
+      acc.insert({std::move(*values), &vertex, 0});
+    }
+  } catch (const utils::OutOfMemoryException &) {
+    utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+    index_.erase(it);
+    throw;
+  }
+
+  for (const auto property : properties) {
+    auto &by_property = indices_by_property_[property];
+    // The same property can't appear in the index twice, but guard against it
+    // anyway so that each update inserts a single entry.
+    if (std::none_of(by_property.begin(), by_property.end(),
+                     [&it](const auto &item) { return item.first == &it->first; })) {
+      by_property.emplace_back(&it->first, &it->second);
+    }
+  }
+  return true;
+}
+
+void InMemoryLabelPropertyCompositeIndex::UpdateOnAddLabel(LabelId added_label, Vertex *vertex_after_update,
+                                                           const Transaction &tx) {
+  for (auto &[key, storage] : index_) {
+    if (key.first != added_label) continue;
+    auto values = GetIndexedValues(*vertex_after_update, key.second);
+    if (!values) continue;
+    auto acc = storage.access();
+    acc.insert(Entry{std::move(*values), vertex_after_update, tx.start_timestamp});
+  }
+}
+
+void InMemoryLabelPropertyCompositeIndex::UpdateOnSetProperty(PropertyId property, const PropertyValue &value,
+                                                              Vertex *vertex, const Transaction &tx) {
+  if (value.IsNull()) {
+    return;
+  }
+
+  auto it = indices_by_property_.find(property);
+  if (it == indices_by_property_.end()) {
+    return;
+  }
+
+  for (const auto &[key, storage] : it->second) {
+    if (!utils::Contains(vertex->labels, key->first)) continue;
+    auto values = GetIndexedValues(*vertex, key->second);
+    if (!values) continue;
+    auto acc = storage->access();
+    acc.insert(Entry{std::move(*values), vertex, tx.start_timestamp});
+  }
+}
+
+bool InMemoryLabelPropertyCompositeIndex::DropIndex(LabelId label, const std::vector<PropertyId> &properties) {
+  auto it = index_.find({label, properties});
+  if (it == index_.end()) return false;
+
+  for (const auto property : properties) {
+    auto by_property_it = indices_by_property_.find(property);
+    if (by_property_it == indices_by_property_.end()) continue;
+    auto &by_property = by_property_it->second;
+    by_property.erase(std::remove_if(by_property.begin(), by_property.end(),
+                                     [&it](const auto &item) { return item.first == &it->first; }),
+                      by_property.end());
+    if (by_property.empty()) {
+      indices_by_property_.erase(by_property_it);
+    }
+  }
+
+  index_.erase(it);
+  return true;
+}
+
+bool InMemoryLabelPropertyCompositeIndex::IndexExists(LabelId label, const std::vector<PropertyId> &properties) const {
+  return index_.find({label, properties}) != index_.end();
+}
+
+std::vector<std::pair<LabelId, std::vector<PropertyId>>> InMemoryLabelPropertyCompositeIndex::ListIndices() const {
+  std::vector<std::pair<LabelId, std::vector<PropertyId>>> ret;
+  ret.reserve(index_.size());
+  for (const auto &item : index_) {
+    ret.push_back(item.first);
+  }
+  return ret;
+}
+
+void InMemoryLabelPropertyCompositeIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
+  for (auto &[key, index] : index_) {
+    auto index_acc = index.access();
+    for (auto it = index_acc.begin(); it != index_acc.end();) {
+      auto next_it = it;
+      ++next_it;
+
+      if (it->timestamp >= oldest_active_start_timestamp) {
+        it = next_it;
+        continue;
+      }
+
+      if ((next_it != index_acc.end() && it->vertex == next_it->vertex && it->values == next_it->values) ||
+          !AnyVersionHasLabelProperties(*it->vertex, key.first, key.second, it->values,
+                                        oldest_active_start_timestamp)) {
+        index_acc.remove(*it);
+      }
+      it = next_it;
+    }
+  }
+}
+
+InMemoryLabelPropertyCompositeIndex::Iterable::Iterator::Iterator(Iterable *self,
+                                                                  utils::SkipList<Entry>::Iterator index_iterator)
+    : self_(self),
+      index_iterator_(index_iterator),
+      current_vertex_accessor_(nullptr, nullptr, nullptr, nullptr, self_->config_.items),
+      current_vertex_(nullptr) {
+  AdvanceUntilValid();
+}
+
+InMemoryLabelPropertyCompositeIndex::Iterable::Iterator &
+InMemoryLabelPropertyCompositeIndex::Iterable::Iterator::operator++() {
+  ++index_iterator_;
+  AdvanceUntilValid();
+  return *this;
+}
+
+void InMemoryLabelPropertyCompositeIndex::Iterable::Iterator::AdvanceUntilValid() {
+  const auto prefix_size = self_->prefix_.size();
+  for (; index_iterator_ != self_->index_accessor_.end(); ++index_iterator_) {
+    if (index_iterator_->vertex == current_vertex_) {
+      continue;
+    }
+
+    // All entries with the prefix are next to each other and the iteration
+    // starts at the first one of them, so the first entry without the prefix
+    // ends the iteration.
+    if (CompareValues(index_iterator_->values, self_->prefix_, prefix_size) != 0) {
+      index_iterator_ = self_->index_accessor_.end();
+      break;
+    }
+
+    if (prefix_size < index_iterator_->values.size()) {
+      const auto &value = index_iterator_->values[prefix_size];
+      if (self_->lower_bound_) {
+        if (value < self_->lower_bound_->value()) {
+          continue;
+        }
+        if (!self_->lower_bound_->IsInclusive() && value == self_->lower_bound_->value()) {
+          continue;
+        }
+      }
+      if (self_->upper_bound_) {
+        if (self_->upper_bound_->value() < value) {
+          index_iterator_ = self_->index_accessor_.end();
+          break;
+        }
+        if (!self_->upper_bound_->IsInclusive() && value == self_->upper_bound_->value()) {
+          index_iterator_ = self_->index_accessor_.end();
+          break;
+        }
+      }
+    }
+
+    if (CurrentVersionHasLabelProperties(*index_iterator_->vertex, self_->label_, self_->properties_,
+                                         index_iterator_->values, self_->transaction_, self_->view_)) {
+      current_vertex_ = index_iterator_->vertex;
+      current_vertex_accessor_ = VertexAccessor(current_vertex_, self_->transaction_, self_->indices_,
+                                                self_->constraints_, self_->config_.items);
+      break;
+    }
+  }
+}
+
+InMemoryLabelPropertyCompositeIndex::Iterable::Iterable(
+    utils::SkipList<Entry>::Accessor index_accessor, LabelId label, std::vector<PropertyId> properties,
+    std::vector<PropertyValue> prefix, const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+    const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view, Transaction *transaction,
+    Indices *indices, Constraints *constraints, const Config &config)
+    : index_accessor_(std::move(index_accessor)),
+      label_(label),
+      properties_(std::move(properties)),
+      prefix_(std::move(prefix)),
+      lower_bound_(lower_bound),
+      upper_bound_(upper_bound),
+      view_(view),
+      transaction_(transaction),
+      indices_(indices),
+      constraints_(constraints),
+      config_(config) {
+  MG_ASSERT(prefix_.size() <= properties_.size(), "Prefix is longer than the list of indexed properties!");
+  MG_ASSERT(prefix_.size() < properties_.size() || (!lower_bound_ && !upper_bound_),
+            "Bounds are given without a property to apply them to!");
+  // `Null` is never stored in the index, so no vertex has it in the prefix.
+  if (std::any_of(prefix_.begin(), prefix_.end(), [](const auto &value) { return value.IsNull(); })) {
+    bounds_valid_ = false;
+    return;
+  }
+  bounds_valid_ = NormalizePropertyValueBounds(&lower_bound_, &upper_bound_);
+}
+
+InMemoryLabelPropertyCompositeIndex::Iterable::Iterator InMemoryLabelPropertyCompositeIndex::Iterable::begin() {
+  // If the bounds are set and don't have comparable types we don't yield any
+  // items from the index.
+  if (!bounds_valid_) return {this, index_accessor_.end()};
+  if (lower_bound_) {
+    auto key = prefix_;
+    key.push_back(lower_bound_->value());
+    return {this, index_accessor_.find_equal_or_greater(key)};
+  }
+  return {this, index_accessor_.find_equal_or_greater(prefix_)};
+}
+
+InMemoryLabelPropertyCompositeIndex::Iterable::Iterator InMemoryLabelPropertyCompositeIndex::Iterable::end() {
+  return {this, index_accessor_.end()};
+}
+
+uint64_t InMemoryLabelPropertyCompositeIndex::ApproximateVertexCount(LabelId label,
+                                                                     const std::vector<PropertyId> &properties) const {
+  auto it = index_.find({label, properties});
+  MG_ASSERT(it != index_.end(), "Composite index for label {} doesn't exist", label.AsUint());
+  return it->second.size();
+}
+
+uint64_t InMemoryLabelPropertyCompositeIndex::ApproximateVertexCount(
+    LabelId label, const std::vector<PropertyId> &properties, const std::vector<PropertyValue> &prefix,
+    const std::optional<utils::Bound<PropertyValue>> &lower,
+    const std::optional<utils::Bound<PropertyValue>> &upper) const {
+  auto it = index_.find({label, properties});
+  MG_ASSERT(it != index_.end(), "Composite index for label {} doesn't exist", label.AsUint());
+  if (std::any_of(prefix.begin(), prefix.end(), [](const auto &value) { return value.IsNull(); })) {
+    return 0;
+  }
+  auto acc = it->second.access();
+  auto lower_bound = lower;
+  auto upper_bound = upper;
+  if (!NormalizePropertyValueBounds(&lower_bound, &upper_bound)) {
+    return 0;
+  }
+  if (!lower_bound && !upper_bound) {
+    if (prefix.empty()) return acc.size();
+    // NOLINTNEXTLINE(bugprone-narrowing-conversions,cppcoreguidelines-narrowing-conversions)
+    return acc.estimate_count(prefix, utils::SkipListLayerForCountEstimation(acc.size()));
+  }
+  using PrefixBound = utils::Bound<std::vector<PropertyValue>>;
+  const auto extend_prefix = [&prefix](const auto &bound) -> std::optional<PrefixBound> {
+    if (!bound) return std::nullopt;
+    auto key = prefix;
+    key.push_back(bound->value());
+    return PrefixBound(std::move(key), bound->type());
+  };
+  // NOLINTNEXTLINE(bugprone-narrowing-conversions,cppcoreguidelines-narrowing-conversions)
+  return acc.estimate_range_count(extend_prefix(lower_bound), extend_prefix(upper_bound),
+                                  utils::SkipListLayerForCountEstimation(acc.size()));
+}
+
+void InMemoryLabelPropertyCompositeIndex::RunGC() {
+  for (auto &index_entry : index_) {
+    index_entry.second.run_gc();
+  }
+}
+
+InMemoryLabelPropertyCompositeIndex::Iterable InMemoryLabelPropertyCompositeIndex::Vertices(
+    LabelId label, const std::vector<PropertyId> &properties, const std::vector<PropertyValue> &prefix,
+    const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+    const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view, Transaction *transaction) {
+  auto it = index_.find({label, properties});
+  MG_ASSERT(it != index_.end(), "Composite index for label {} doesn't exist", label.AsUint());
+  return {it->second.access(), label, properties, prefix, lower_bound, upper_bound, view, transaction, indices_,
+          constraints_,        config_};
+}
+
+}  // namespace memgraph::storage
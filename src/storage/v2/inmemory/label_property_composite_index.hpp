@@ -0,0 +1,130 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include "storage/v2/indices/label_property_composite_index.hpp"
+
+namespace memgraph::storage {
+
+class InMemoryLabelPropertyCompositeIndex : public storage::LabelPropertyCompositeIndex {
+ private:
+  struct Entry {
+    std::vector<PropertyValue> values;
+    Vertex *vertex;
+    uint64_t timestamp;
+
+    bool operator<(const Entry &rhs) const;
+    bool operator==(const Entry &rhs) const;
+
+    // Compares only the leading `rhs.size()` values, so that all entries
+    // starting with the given values are equal to them.
+    bool operator<(const std::vector<PropertyValue> &rhs) const;
+    bool operator==(const std::vector<PropertyValue> &rhs) const;
+  };
+
+  using IndexKey = std::pair<LabelId, std::vector<PropertyId>>;
+
+ public:
+  InMemoryLabelPropertyCompositeIndex(Indices *indices, Constraints *constraints, const Config &config);
+
+  /// Creates the index with entries for all vertices which have the label and
+  /// all of the properties. Returns false if the index already exists.
+  /// @throw std::bad_alloc
+  bool CreateIndex(LabelId label, const std::vector<PropertyId> &properties,
+                   utils::SkipList<Vertex>::Accessor vertices);
+
+  /// @throw std::bad_alloc
+  void UpdateOnAddLabel(LabelId added_label, Vertex *vertex_after_update, const Transaction &tx) override;
+
+  /// @throw std::bad_alloc
+  void UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
+                           const Transaction &tx) override;
+
+  bool DropIndex(LabelId label, const std::vector<PropertyId> &properties) override;
+
+  bool IndexExists(LabelId label, const std::vector<PropertyId> &properties) const override;
+
+  std::vector<std::pair<LabelId, std::vector<PropertyId>>> ListIndices() const override;
+
+  void RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp);
+
+  class Iterable {
+   public:
+    Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label, std::vector<PropertyId> properties,
+             std::vector<PropertyValue> prefix, const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+             const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view, Transaction *transaction,
+             Indices *indices, Constraints *constraints, const Config &config);
+
+    class Iterator {
+     public:
+      Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator);
+
+      VertexAccessor operator*() const { return current_vertex_accessor_; }
+
+      bool operator==(const Iterator &other) const { return index_iterator_ == other.index_iterator_; }
+      bool operator!=(const Iterator &other) const { return index_iterator_ != other.index_iterator_; }
+
+      Iterator &operator++();
+
+     private:
+      void AdvanceUntilValid();
+
+      Iterable *self_;
+      utils::SkipList<Entry>::Iterator index_iterator_;
+      VertexAccessor current_vertex_accessor_;
+      Vertex *current_vertex_;
+    };
+
+    Iterator begin();
+    Iterator end();
+
+   private:
+    utils::SkipList<Entry>::Accessor index_accessor_;
+    LabelId label_;
+    std::vector<PropertyId> properties_;
+    // Values of the leading properties which all produced vertices have.
+    std::vector<PropertyValue> prefix_;
+    // Bounds of the value of the property following the prefix.
+    std::optional<utils::Bound<PropertyValue>> lower_bound_;
+    std::optional<utils::Bound<PropertyValue>> upper_bound_;
+    bool bounds_valid_{true};
+    View view_;
+    Transaction *transaction_;
+    Indices *indices_;
+    Constraints *constraints_;
+    Config config_;
+  };
+
+  uint64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties) const override;
+
+  uint64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties,
+                                  const std::vector<PropertyValue> &prefix,
+                                  const std::optional<utils::Bound<PropertyValue>> &lower,
+                                  const std::optional<utils::Bound<PropertyValue>> &upper) const override;
+
+  void RunGC();
+
+  /// Returns vertices whose values of the leading properties are equal to
+  /// `prefix`, and whose value of the following property is inside of the
+  /// bounds. The bounds may be given only if `prefix` is shorter than the list
+  /// of properties.
+  Iterable Vertices(LabelId label, const std::vector<PropertyId> &properties, const std::vector<PropertyValue> &prefix,
+                    const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+                    const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view, Transaction *transaction);
+
+ private:
+  std::map<IndexKey, utils::SkipList<Entry>> index_;
+  std::unordered_map<PropertyId, std::vector<std::pair<const IndexKey *, utils::SkipList<Entry> *>>>
+      indices_by_property_;
+};
+
+}  // namespace memgraph::storage
@@ -10,10 +10,171 @@
 // licenses/APL.txt.
 
 #include "storage/v2/inmemory/label_property_index.hpp"
+
+#include <algorithm>
+#include <numeric>
+
 #include "storage/v2/indices/indices_utils.hpp"
+#include "utils/math.hpp"
 
 namespace memgraph::storage {
 
+namespace {
+
+std::optional<double> NumericValue(const PropertyValue &value) {
+  if (value.IsInt()) return static_cast<double>(value.ValueInt());
+  if (value.IsDouble()) return value.ValueDouble();
+  return std::nullopt;
+}
+
+/// Returns the fraction of the histogram bucket between `lower` and `upper`
+/// whose values are smaller than (or equal to, if `or_equal` is set) `value`.
+double BucketFractionBelow(const PropertyValue &lower, const PropertyValue &upper, const PropertyValue &value,
+                           bool or_equal) {
+  if (or_equal ? value < lower : !(lower < value)) return 0.0;
+  if (or_equal ? !(value < upper) : upper < value) return 1.0;
+  const auto lower_number = NumericValue(lower);
+  const auto upper_number = NumericValue(upper);
+  const auto number = NumericValue(value);
+  if (lower_number && upper_number && number && *lower_number < *upper_number) {
+    return std::clamp((*number - *lower_number) / (*upper_number - *lower_number), 0.0, 1.0);
+  }
+  // Values which can't be interpolated are assumed to split the bucket in half.
+  return 0.5;
+}
+
+bool IsInBounds(const PropertyValue &value, const std::optional<utils::Bound<PropertyValue>> &lower,
+                const std::optional<utils::Bound<PropertyValue>> &upper) {
+  if (lower && (lower->IsInclusive() ? value < lower->value() : !(lower->value() < value))) return false;
+  if (upper && (upper->IsInclusive() ? upper->value() < value : !(value < upper->value()))) return false;
+  return true;
+}
+
+uint64_t MostCommonValuesCount(const LabelPropertyIndexStats &stats) {
+  return std::accumulate(stats.most_common_values.begin(), stats.most_common_values.end(), uint64_t{0},
+                         [](uint64_t sum, const auto &value_count) { return sum + value_count.second; });
+}
+
+}  // namespace
+
+void ComputeValueDistribution(const std::map<PropertyValue, int64_t> &value_counts, LabelPropertyIndexStats *stats) {
+  stats->most_common_values.clear();
+  stats->histogram_bounds.clear();
+  if (value_counts.empty()) return;
+
+  // Values which are more common than the average are kept exactly, up to the
+  // limit, starting from the most common ones.
+  using ValueCountIterator = std::map<PropertyValue, int64_t>::const_iterator;
+  const auto avg_group_size = static_cast<double>(stats->count) / static_cast<double>(value_counts.size());
+  std::vector<ValueCountIterator> most_common;
+  for (auto it = value_counts.begin(); it != value_counts.end(); ++it) {
+    if (static_cast<double>(it->second) > avg_group_size) most_common.push_back(it);
+  }
+  const auto most_common_size = std::min<uint64_t>(most_common.size(), kIndexStatsMostCommonValues);
+  std::partial_sort(most_common.begin(), most_common.begin() + most_common_size, most_common.end(),
+                    [](const auto &lhs, const auto &rhs) { return lhs->second > rhs->second; });
+  most_common.resize(most_common_size);
+  std::sort(most_common.begin(), most_common.end(),
+            [](const auto &lhs, const auto &rhs) { return lhs->first < rhs->first; });
+
+  stats->most_common_values.reserve(most_common.size());
+  std::vector<ValueCountIterator> remaining;
+  uint64_t remaining_count = 0;
+  auto next_most_common = most_common.begin();
+  for (auto it = value_counts.begin(); it != value_counts.end(); ++it) {
+    if (next_most_common != most_common.end() && *next_most_common == it) {
+      stats->most_common_values.emplace_back(it->first, it->second);
+      ++next_most_common;
+    } else {
+      remaining.push_back(it);
+      remaining_count += it->second;
+    }
+  }
+  if (remaining.empty()) return;
+
+  // The bounds are the first and the last value and the values at which the
+  // cumulative count of the remaining values reaches each of the buckets.
+  const auto buckets = std::min<uint64_t>(remaining.size(), kIndexStatsHistogramBuckets);
+  stats->histogram_bounds.reserve(buckets + 1);
+  stats->histogram_bounds.push_back(remaining.front()->first);
+  uint64_t cumulative_count = 0;
+  uint64_t bucket = 1;
+  for (size_t i = 0; i < remaining.size(); ++i) {
+    cumulative_count += remaining[i]->second;
+    if (i + 1 == remaining.size()) {
+      stats->histogram_bounds.push_back(remaining[i]->first);
+      break;
+    }
+    if (bucket < buckets && cumulative_count * buckets >= bucket * remaining_count) {
+      stats->histogram_bounds.push_back(remaining[i]->first);
+      while (bucket < buckets && cumulative_count * buckets >= bucket * remaining_count) ++bucket;
+    }
+  }
+}
+
+LabelPropertyIndexStats MakeLabelPropertyIndexStats(const std::map<PropertyValue, int64_t> &value_counts,
+                                                    uint64_t total_degree) {
+  const uint64_t count =
+      std::accumulate(value_counts.begin(), value_counts.end(), uint64_t{0},
+                      [](uint64_t sum, const auto &value_count) { return sum + value_count.second; });
+  const double avg_group_size =
+      value_counts.empty() ? 0 : static_cast<double>(count) / static_cast<double>(value_counts.size());
+  const double chi_squared_stat = std::accumulate(
+      value_counts.begin(), value_counts.end(), 0.0, [avg_group_size](double sum, const auto &value_count) {
+        return sum + utils::ChiSquaredValue(value_count.second, avg_group_size);
+      });
+  const double average_degree = count > 0 ? static_cast<double>(total_degree) / static_cast<double>(count) : 0;
+
+  LabelPropertyIndexStats stats{.count = count,
+                                .distinct_values_count = static_cast<uint64_t>(value_counts.size()),
+                                .statistic = chi_squared_stat,
+                                .avg_group_size = avg_group_size,
+                                .avg_degree = average_degree};
+  ComputeValueDistribution(value_counts, &stats);
+  return stats;
+}
+
+bool HasValueDistribution(const LabelPropertyIndexStats &stats) {
+  return !stats.most_common_values.empty() || !stats.histogram_bounds.empty();
+}
+
+double EstimateVertexCount(const LabelPropertyIndexStats &stats, const PropertyValue &value) {
+  auto found = std::lower_bound(stats.most_common_values.begin(), stats.most_common_values.end(), value,
+                                [](const auto &value_count, const auto &value) { return value_count.first < value; });
+  if (found != stats.most_common_values.end() && found->first == value) {
+    return static_cast<double>(found->second);
+  }
+  // The remaining values are assumed to be uniformly distributed.
+  if (stats.histogram_bounds.empty() || stats.distinct_values_count <= stats.most_common_values.size()) return 0.0;
+  if (value < stats.histogram_bounds.front() || stats.histogram_bounds.back() < value) return 0.0;
+  const auto remaining_count = static_cast<double>(stats.count - MostCommonValuesCount(stats));
+  return remaining_count / static_cast<double>(stats.distinct_values_count - stats.most_common_values.size());
+}
+
+double EstimateVertexCount(const LabelPropertyIndexStats &stats, std::optional<utils::Bound<PropertyValue>> lower,
+                           std::optional<utils::Bound<PropertyValue>> upper) {
+  if (!NormalizePropertyValueBounds(&lower, &upper)) return 0.0;
+  double count = 0.0;
+  for (const auto &[value, value_count] : stats.most_common_values) {
+    if (IsInBounds(value, lower, upper)) count += static_cast<double>(value_count);
+  }
+  if (stats.histogram_bounds.size() < 2) return count;
+
+  const auto buckets = stats.histogram_bounds.size() - 1;
+  const auto bucket_count =
+      static_cast<double>(stats.count - MostCommonValuesCount(stats)) / static_cast<double>(buckets);
+  for (size_t i = 0; i < buckets; ++i) {
+    const auto &bucket_lower = stats.histogram_bounds[i];
+    const auto &bucket_upper = stats.histogram_bounds[i + 1];
+    const auto below_upper =
+        upper ? BucketFractionBelow(bucket_lower, bucket_upper, upper->value(), upper->IsInclusive()) : 1.0;
+    const auto below_lower =
+        lower ? BucketFractionBelow(bucket_lower, bucket_upper, lower->value(), !lower->IsInclusive()) : 0.0;
+    count += std::max(0.0, below_upper - below_lower) * bucket_count;
+  }
+  return count;
+}
+
 bool InMemoryLabelPropertyIndex::Entry::operator<(const Entry &rhs) const {
   if (value < rhs.value) {
     return true;
@@ -82,6 +243,50 @@ bool InMemoryLabelPropertyIndex::CreateIndex(LabelId label, PropertyId property,
   return create_index_seq(label, property, vertices, it);
 }
 
+bool InMemoryLabelPropertyIndex::RegisterIndex(LabelId label, PropertyId property) {
+  auto [it, emplaced] =
+      index_.emplace(std::piecewise_construct, std::forward_as_tuple(label, property), std::forward_as_tuple());
+  if (!emplaced) {
+    return false;
+  }
+  indices_by_property_[property].insert({label, &it->second});
+  pending_.emplace(label, property);
+  return true;
+}
+
+auto InMemoryLabelPropertyIndex::MakePopulator(LabelId label, PropertyId property) {
+  return [index_acc = index_.at({label, property}).access(), label, property](Vertex &vertex) mutable {
+    // The entries are inserted while the vertex is locked, like the ones of
+    // the running transactions, so the GC can't remove the vertex in between.
+    std::lock_guard guard(vertex.lock);
+    ForEachVersionWithLabel(vertex, label, property, [&index_acc, &vertex](const PropertyValue &value) {
+      index_acc.insert(Entry{value, &vertex, 0});
+    });
+  };
+}
+
+void InMemoryLabelPropertyIndex::PopulateIndex(LabelId label, PropertyId property,
+                                               utils::SkipList<Vertex>::Accessor vertices, uint64_t thread_count) {
+  ForEachVertexInParallel(vertices, thread_count,
+                          [this, label, property]() { return MakePopulator(label, property); });
+}
+
+void InMemoryLabelPropertyIndex::PopulateIndex(LabelId label, PropertyId property,
+                                               const std::vector<Vertex *> &vertices) {
+  auto populate = MakePopulator(label, property);
+  for (auto *vertex : vertices) {
+    populate(*vertex);
+  }
+}
+
+bool InMemoryLabelPropertyIndex::PublishIndex(LabelId label, PropertyId property) {
+  return pending_.erase({label, property}) > 0 && index_.contains({label, property});
+}
+
+bool InMemoryLabelPropertyIndex::DropPendingIndex(LabelId label, PropertyId property) {
+  return pending_.contains({label, property}) && DropIndex(label, property);
+}
+
 void InMemoryLabelPropertyIndex::UpdateOnAddLabel(LabelId added_label, Vertex *vertex_after_update,
                                                   const Transaction &tx) {
   for (auto &[label_prop, storage] : index_) {
@@ -121,17 +326,19 @@ bool InMemoryLabelPropertyIndex::DropIndex(LabelId label, PropertyId property) {
     }
   }
 
+  pending_.erase({label, property});
   return index_.erase({label, property}) > 0;
 }
 
 bool InMemoryLabelPropertyIndex::IndexExists(LabelId label, PropertyId property) const {
-  return index_.find({label, property}) != index_.end();
+  return index_.find({label, property}) != index_.end() && !pending_.contains({label, property});
 }
 
 std::vector<std::pair<LabelId, PropertyId>> InMemoryLabelPropertyIndex::ListIndices() const {
   std::vector<std::pair<LabelId, PropertyId>> ret;
   ret.reserve(index_.size());
   for (const auto &item : index_) {
+    if (pending_.contains(item.first)) continue;
     ret.push_back(item.first);
   }
   return ret;
@@ -174,8 +381,29 @@ InMemoryLabelPropertyIndex::Iterable::Iterator &InMemoryLabelPropertyIndex::Iter
   return *this;
 }
 
+bool InMemoryLabelPropertyIndex::Iterable::Iterator::SeekValue() {
+  const auto &values = *self_->values_;
+  while (index_iterator_ != self_->index_accessor_.end()) {
+    if (values[value_] < index_iterator_->value) {
+      value_ = std::lower_bound(values.begin() + value_, values.end(), index_iterator_->value) - values.begin();
+      if (value_ == values.size()) {
+        index_iterator_ = self_->index_accessor_.end();
+        return false;
+      }
+    }
+    if (!(index_iterator_->value < values[value_])) return true;
+    // Jump over the entries between the values instead of checking them.
+    index_iterator_ = self_->index_accessor_.find_equal_or_greater(self_->hint_, values[value_]);
+  }
+  return false;
+}
+
 void InMemoryLabelPropertyIndex::Iterable::Iterator::AdvanceUntilValid() {
   for (; index_iterator_ != self_->index_accessor_.end(); ++index_iterator_) {
+    if (self_->values_ && !SeekValue()) break;
+    // The next entry is already being prefetched by the skip list, so the
+    // vertex it points to is fetched while this one is checked.
+    if (const auto *next = index_iterator_.PeekNext()) PrefetchVertex(next->vertex);
     if (index_iterator_->vertex == current_vertex_) {
       continue;
     }
@@ -222,22 +450,8 @@ const PropertyValue kSmallestMap = PropertyValue(std::map<std::string, PropertyV
 const PropertyValue kSmallestTemporalData =
     PropertyValue(TemporalData{static_cast<TemporalType>(0), std::numeric_limits<int64_t>::min()});
 
-InMemoryLabelPropertyIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label,
-                                               PropertyId property,
-                                               const std::optional<utils::Bound<PropertyValue>> &lower_bound,
-                                               const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view,
-                                               Transaction *transaction, Indices *indices, Constraints *constraints,
-                                               const Config &config)
-    : index_accessor_(std::move(index_accessor)),
-      label_(label),
-      property_(property),
-      lower_bound_(lower_bound),
-      upper_bound_(upper_bound),
-      view_(view),
-      transaction_(transaction),
-      indices_(indices),
-      constraints_(constraints),
-      config_(config) {
+bool NormalizePropertyValueBounds(std::optional<utils::Bound<PropertyValue>> *lower_bound,
+                                  std::optional<utils::Bound<PropertyValue>> *upper_bound) {
   // We have to fix the bounds that the user provided to us. If the user
   // provided only one bound we should make sure that only values of that type
   // are returned by the iterator. We ensure this by supplying either an
@@ -253,89 +467,131 @@ InMemoryLabelPropertyIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor
   static_assert(PropertyValue::Type::List < PropertyValue::Type::Map);
 
   // Remove any bounds that are set to `Null` because that isn't a valid value.
-  if (lower_bound_ && lower_bound_->value().IsNull()) {
-    lower_bound_ = std::nullopt;
+  if (*lower_bound && (*lower_bound)->value().IsNull()) {
+    *lower_bound = std::nullopt;
   }
-  if (upper_bound_ && upper_bound_->value().IsNull()) {
-    upper_bound_ = std::nullopt;
+  if (*upper_bound && (*upper_bound)->value().IsNull()) {
+    *upper_bound = std::nullopt;
   }
 
   // Check whether the bounds are of comparable types if both are supplied.
-  if (lower_bound_ && upper_bound_ &&
-      !PropertyValue::AreComparableTypes(lower_bound_->value().type(), upper_bound_->value().type())) {
-    bounds_valid_ = false;
-    return;
+  if (*lower_bound && *upper_bound &&
+      !PropertyValue::AreComparableTypes((*lower_bound)->value().type(), (*upper_bound)->value().type())) {
+    return false;
   }
 
   // Set missing bounds.
-  if (lower_bound_ && !upper_bound_) {
+  if (*lower_bound && !*upper_bound) {
     // Here we need to supply an upper bound. The upper bound is set to an
     // exclusive lower bound of the following type.
-    switch (lower_bound_->value().type()) {
+    switch ((*lower_bound)->value().type()) {
       case PropertyValue::Type::Null:
         // This shouldn't happen because of the nullopt-ing above.
         LOG_FATAL("Invalid database state!");
         break;
       case PropertyValue::Type::Bool:
-        upper_bound_ = utils::MakeBoundExclusive(kSmallestNumber);
+        *upper_bound = utils::MakeBoundExclusive(kSmallestNumber);
         break;
       case PropertyValue::Type::Int:
       case PropertyValue::Type::Double:
         // Both integers and doubles are treated as the same type in
         // `PropertyValue` and they are interleaved when sorted.
-        upper_bound_ = utils::MakeBoundExclusive(kSmallestString);
+        *upper_bound = utils::MakeBoundExclusive(kSmallestString);
         break;
       case PropertyValue::Type::String:
-        upper_bound_ = utils::MakeBoundExclusive(kSmallestList);
+        *upper_bound = utils::MakeBoundExclusive(kSmallestList);
         break;
       case PropertyValue::Type::List:
-        upper_bound_ = utils::MakeBoundExclusive(kSmallestMap);
+        *upper_bound = utils::MakeBoundExclusive(kSmallestMap);
         break;
       case PropertyValue::Type::Map:
-        upper_bound_ = utils::MakeBoundExclusive(kSmallestTemporalData);
+        *upper_bound = utils::MakeBoundExclusive(kSmallestTemporalData);
         break;
       case PropertyValue::Type::TemporalData:
         // This is the last type in the order so we leave the upper bound empty.
         break;
     }
   }
-  if (upper_bound_ && !lower_bound_) {
+  if (*upper_bound && !*lower_bound) {
     // Here we need to supply a lower bound. The lower bound is set to an
     // inclusive lower bound of the current type.
-    switch (upper_bound_->value().type()) {
+    switch ((*upper_bound)->value().type()) {
       case PropertyValue::Type::Null:
         // This shouldn't happen because of the nullopt-ing above.
         LOG_FATAL("Invalid database state!");
         break;
       case PropertyValue::Type::Bool:
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestBool);
+        *lower_bound = utils::MakeBoundInclusive(kSmallestBool);
         break;
       case PropertyValue::Type::Int:
       case PropertyValue::Type::Double:
         // Both integers and doubles are treated as the same type in
         // `PropertyValue` and they are interleaved when sorted.
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestNumber);
+        *lower_bound = utils::MakeBoundInclusive(kSmallestNumber);
         break;
       case PropertyValue::Type::String:
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestString);
+        *lower_bound = utils::MakeBoundInclusive(kSmallestString);
         break;
       case PropertyValue::Type::List:
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestList);
+        *lower_bound = utils::MakeBoundInclusive(kSmallestList);
         break;
       case PropertyValue::Type::Map:
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestMap);
+        *lower_bound = utils::MakeBoundInclusive(kSmallestMap);
         break;
       case PropertyValue::Type::TemporalData:
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestTemporalData);
+        *lower_bound = utils::MakeBoundInclusive(kSmallestTemporalData);
         break;
     }
   }
+  return true;
+}
+
+InMemoryLabelPropertyIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label,
+                                               PropertyId property,
+                                               const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+                                               const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view,
+                                               Transaction *transaction, Indices *indices, Constraints *constraints,
+                                               const Config &config)
+    : index_accessor_(std::move(index_accessor)),
+      label_(label),
+      property_(property),
+      lower_bound_(lower_bound),
+      upper_bound_(upper_bound),
+      view_(view),
+      transaction_(transaction),
+      indices_(indices),
+      constraints_(constraints),
+      config_(config) {
+  bounds_valid_ = NormalizePropertyValueBounds(&lower_bound_, &upper_bound_);
+}
+
+InMemoryLabelPropertyIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label,
+                                               PropertyId property, std::vector<PropertyValue> values, View view,
+                                               Transaction *transaction, Indices *indices, Constraints *constraints,
+                                               const Config &config)
+    : index_accessor_(std::move(index_accessor)),
+      label_(label),
+      property_(property),
+      view_(view),
+      transaction_(transaction),
+      indices_(indices),
+      constraints_(constraints),
+      config_(config) {
+  // `Null` isn't equal to any value.
+  std::erase_if(values, [](const auto &value) { return value.IsNull(); });
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  values_.emplace(std::move(values));
 }
 
 InMemoryLabelPropertyIndex::Iterable::Iterator InMemoryLabelPropertyIndex::Iterable::begin() {
   // If the bounds are set and don't have comparable types we don't yield any
   // items from the index.
   if (!bounds_valid_) return {this, index_accessor_.end()};
+  if (values_) {
+    if (values_->empty()) return {this, index_accessor_.end()};
+    return {this, index_accessor_.find_equal_or_greater(hint_, values_->front())};
+  }
   auto index_iterator = index_accessor_.begin();
   if (lower_bound_) {
     index_iterator = index_accessor_.find_equal_or_greater(lower_bound_->value());
@@ -383,21 +639,23 @@ uint64_t InMemoryLabelPropertyIndex::ApproximateVertexCount(
 }
 
 std::vector<std::pair<LabelId, PropertyId>> InMemoryLabelPropertyIndex::ClearIndexStats() {
+  auto locked_stats = stats_.Lock();
   std::vector<std::pair<LabelId, PropertyId>> deleted_indexes;
-  deleted_indexes.reserve(stats_.size());
-  std::transform(stats_.begin(), stats_.end(), std::back_inserter(deleted_indexes),
+  deleted_indexes.reserve(locked_stats->size());
+  std::transform(locked_stats->begin(), locked_stats->end(), std::back_inserter(deleted_indexes),
                  [](const auto &elem) { return elem.first; });
-  stats_.clear();
+  locked_stats->clear();
   return deleted_indexes;
 }
 
 std::vector<std::pair<LabelId, PropertyId>> InMemoryLabelPropertyIndex::DeleteIndexStats(
     const storage::LabelId &label) {
+  auto locked_stats = stats_.Lock();
   std::vector<std::pair<LabelId, PropertyId>> deleted_indexes;
-  for (auto it = stats_.cbegin(); it != stats_.cend();) {
+  for (auto it = locked_stats->cbegin(); it != locked_stats->cend();) {
     if (it->first.first == label) {
       deleted_indexes.push_back(it->first);
-      it = stats_.erase(it);
+      it = locked_stats->erase(it);
     } else {
       ++it;
     }
@@ -407,12 +665,14 @@ std::vector<std::pair<LabelId, PropertyId>> InMemoryLabelPropertyIndex::DeleteIn
 
 void InMemoryLabelPropertyIndex::SetIndexStats(const std::pair<storage::LabelId, storage::PropertyId> &key,
                                                const LabelPropertyIndexStats &stats) {
-  stats_[key] = stats;
+  auto locked_stats = stats_.Lock();
+  (*locked_stats)[key] = stats;
 }
 
 std::optional<LabelPropertyIndexStats> InMemoryLabelPropertyIndex::GetIndexStats(
     const std::pair<storage::LabelId, storage::PropertyId> &key) const {
-  if (auto it = stats_.find(key); it != stats_.end()) {
+  auto locked_stats = stats_.ReadLock();
+  if (auto it = locked_stats->find(key); it != locked_stats->end()) {
     return it->second;
   }
   return {};
@@ -433,4 +693,12 @@ InMemoryLabelPropertyIndex::Iterable InMemoryLabelPropertyIndex::Vertices(
           transaction,         indices_, constraints_, config_};
 }
 
+InMemoryLabelPropertyIndex::Iterable InMemoryLabelPropertyIndex::Vertices(LabelId label, PropertyId property,
+                                                                          const std::vector<PropertyValue> &values,
+                                                                          View view, Transaction *transaction) {
+  auto it = index_.find({label, property});
+  MG_ASSERT(it != index_.end(), "Index for label {} and property {} doesn't exist", label.AsUint(), property.AsUint());
+  return {it->second.access(), label, property, values, view, transaction, indices_, constraints_, config_};
+}
+
 }  // namespace memgraph::storage
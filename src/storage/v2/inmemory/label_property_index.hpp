@@ -11,19 +11,63 @@
 
 #pragma once
 
+#include <map>
+
 #include "storage/v2/indices/label_property_index.hpp"
+#include "utils/rw_lock.hpp"
+#include "utils/synchronized.hpp"
 
 namespace memgraph::storage {
 
 struct LabelPropertyIndexStats {
   uint64_t count, distinct_values_count;
   double statistic, avg_group_size, avg_degree;
+  /// Values which are more common than the average with the number of
+  /// vertices having each of them, sorted by value.
+  std::vector<std::pair<PropertyValue, uint64_t>> most_common_values{};
+  /// Bounds of the equi-depth histogram over the remaining values. Each pair
+  /// of consecutive bounds delimits a bucket with roughly the same number of
+  /// vertices.
+  std::vector<PropertyValue> histogram_bounds{};
 };
 
+/// Maximum number of most common values and histogram buckets kept in the
+/// statistics of a label-property index.
+inline constexpr uint64_t kIndexStatsMostCommonValues{100};
+inline constexpr uint64_t kIndexStatsHistogramBuckets{100};
+
+/// Fills the most common values and the histogram of the statistics from the
+/// number of vertices having each of the indexed values. `count` and
+/// `distinct_values_count` have to describe the same values.
+void ComputeValueDistribution(const std::map<PropertyValue, int64_t> &value_counts, LabelPropertyIndexStats *stats);
+
+/// Computes all statistics of an index from the number of vertices having
+/// each of the indexed values and the sum of the degrees of those vertices.
+LabelPropertyIndexStats MakeLabelPropertyIndexStats(const std::map<PropertyValue, int64_t> &value_counts,
+                                                    uint64_t total_degree);
+
+/// Returns true if the statistics hold the distribution of the indexed values,
+/// i.e. the estimations below can be used instead of reading the index.
+bool HasValueDistribution(const LabelPropertyIndexStats &stats);
+
+/// Estimates the number of vertices whose property is equal to the value.
+double EstimateVertexCount(const LabelPropertyIndexStats &stats, const PropertyValue &value);
+
+/// Estimates the number of vertices whose property is inside of the bounds.
+double EstimateVertexCount(const LabelPropertyIndexStats &stats, std::optional<utils::Bound<PropertyValue>> lower,
+                           std::optional<utils::Bound<PropertyValue>> upper);
+
 /// TODO: andi. Too many copies, extract at one place
 using ParallelizedIndexCreationInfo =
     std::pair<std::vector<std::pair<Gid, uint64_t>> /*vertex_recovery_info*/, uint64_t /*thread_count*/>;
 
+/// Prepares the bounds of a range over property values for an index lookup.
+/// `Null` bounds are removed, and if only one bound is given, the other one is
+/// set so that only values of the same type are in the range. Returns false if
+/// the bounds have incomparable types, in which case no values are in range.
+bool NormalizePropertyValueBounds(std::optional<utils::Bound<PropertyValue>> *lower_bound,
+                                  std::optional<utils::Bound<PropertyValue>> *upper_bound);
+
 class InMemoryLabelPropertyIndex : public storage::LabelPropertyIndex {
  private:
   struct Entry {
@@ -45,6 +89,34 @@ class InMemoryLabelPropertyIndex : public storage::LabelPropertyIndex {
   bool CreateIndex(LabelId label, PropertyId property, utils::SkipList<Vertex>::Accessor vertices,
                    const std::optional<ParallelizedIndexCreationInfo> &parallel_exec_info);
 
+  /// Creates an empty index which is kept up to date by the running
+  /// transactions but isn't used until `PublishIndex` is called. Returns false
+  /// if the index already exists. It must be called while no transaction is
+  /// running, but `PopulateIndex` below can run concurrently with them.
+  /// @throw std::bad_alloc
+  bool RegisterIndex(LabelId label, PropertyId property);
+
+  /// Inserts all versions of the vertices which the index registered with
+  /// `RegisterIndex` has to contain, using up to `thread_count` threads.
+  /// @throw utils::OutOfMemoryException
+  void PopulateIndex(LabelId label, PropertyId property, utils::SkipList<Vertex>::Accessor vertices,
+                     uint64_t thread_count);
+
+  /// Inserts all versions of the given vertices which the index registered
+  /// with `RegisterIndex` has to contain. Used to index each batch of the
+  /// vertices recovered from a snapshot by the thread that loaded it.
+  /// @throw utils::OutOfMemoryException
+  void PopulateIndex(LabelId label, PropertyId property, const std::vector<Vertex *> &vertices);
+
+  /// Makes the populated index visible. Returns false if it was dropped in the
+  /// meantime.
+  bool PublishIndex(LabelId label, PropertyId property);
+
+  /// Drops the index if it was registered but not published yet. Used when
+  /// the population of the index fails. Returns false if there was no such
+  /// index.
+  bool DropPendingIndex(LabelId label, PropertyId property);
+
   /// @throw std::bad_alloc
   void UpdateOnAddLabel(LabelId added_label, Vertex *vertex_after_update, const Transaction &tx) override;
 
@@ -69,6 +141,13 @@ class InMemoryLabelPropertyIndex : public storage::LabelPropertyIndex {
              const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view, Transaction *transaction,
              Indices *indices, Constraints *constraints, const Config &config);
 
+    /// Iterates over the vertices whose property is equal to one of the
+    /// values. The values are looked up in sorted order, each one starting
+    /// from the position of the previous one.
+    Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label, PropertyId property,
+             std::vector<PropertyValue> values, View view, Transaction *transaction, Indices *indices,
+             Constraints *constraints, const Config &config);
+
     class Iterator {
      public:
       Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator);
@@ -82,9 +161,14 @@ class InMemoryLabelPropertyIndex : public storage::LabelPropertyIndex {
 
      private:
       void AdvanceUntilValid();
+      // Moves to the first entry equal to one of the values, returns false if
+      // there are no more of them.
+      bool SeekValue();
 
       Iterable *self_;
       utils::SkipList<Entry>::Iterator index_iterator_;
+      // Position of the value the entries are compared with.
+      size_t value_{0};
       VertexAccessor current_vertex_accessor_;
       Vertex *current_vertex_;
     };
@@ -99,6 +183,9 @@ class InMemoryLabelPropertyIndex : public storage::LabelPropertyIndex {
     std::optional<utils::Bound<PropertyValue>> lower_bound_;
     std::optional<utils::Bound<PropertyValue>> upper_bound_;
     bool bounds_valid_{true};
+    // Sorted values looked up instead of the range, if any.
+    std::optional<std::vector<PropertyValue>> values_;
+    utils::SkipList<Entry>::InsertHint hint_;
     View view_;
     Transaction *transaction_;
     Indices *indices_;
@@ -133,10 +220,22 @@ class InMemoryLabelPropertyIndex : public storage::LabelPropertyIndex {
   Iterable Vertices(LabelId label, PropertyId property, const std::optional<utils::Bound<PropertyValue>> &lower_bound,
                     const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view, Transaction *transaction);
 
+  Iterable Vertices(LabelId label, PropertyId property, const std::vector<PropertyValue> &values, View view,
+                    Transaction *transaction);
+
  private:
+  /// Returns a function that inserts all versions of a vertex that the
+  /// registered index of `label` and `property` has to contain.
+  auto MakePopulator(LabelId label, PropertyId property);
+
   std::map<std::pair<LabelId, PropertyId>, utils::SkipList<Entry>> index_;
   std::unordered_map<PropertyId, std::unordered_map<LabelId, utils::SkipList<Entry> *>> indices_by_property_;
-  std::map<std::pair<LabelId, PropertyId>, storage::LabelPropertyIndexStats> stats_;
+  // Written by ANALYZE GRAPH and the statistics refresh while the planner reads them.
+  utils::Synchronized<std::map<std::pair<LabelId, PropertyId>, storage::LabelPropertyIndexStats>,
+                      utils::WritePrioritizedRWLock>
+      stats_;
+  // Registered indices which are still being populated.
+  std::set<std::pair<LabelId, PropertyId>> pending_;
 };
 
 }  // namespace memgraph::storage
@@ -54,37 +54,43 @@ void CurrentWalHandler::AppendFilename(const std::string &filename) {
 void CurrentWalHandler::AppendSize(const size_t size) {
   replication::Encoder encoder(stream_.GetBuilder());
   encoder.WriteUint(size);
+  encoder.WriteBool(self_->compression_);
 }
 
 void CurrentWalHandler::AppendFileData(utils::InputFile *file) {
   replication::Encoder encoder(stream_.GetBuilder());
-  encoder.WriteFileData(file);
+  encoder.WriteFileData(file, self_->compression_);
 }
 
 void CurrentWalHandler::AppendBufferData(const uint8_t *buffer, const size_t buffer_size) {
   replication::Encoder encoder(stream_.GetBuilder());
-  encoder.WriteBuffer(buffer, buffer_size);
+  if (self_->compression_) {
+    encoder.WriteCompressedBuffer(buffer, buffer_size);
+  } else {
+    encoder.WriteBuffer(buffer, buffer_size);
+  }
 }
 
 replication::CurrentWalRes CurrentWalHandler::Finalize() { return stream_.AwaitResponse(); }
 
 ////// ReplicationClient Helpers //////
 
-replication::WalFilesRes TransferWalFiles(rpc::Client &client, const std::vector<std::filesystem::path> &wal_files) {
+replication::WalFilesRes TransferWalFiles(rpc::Client &client, const std::vector<std::filesystem::path> &wal_files,
+                                          const bool compress) {
   MG_ASSERT(!wal_files.empty(), "Wal files list is empty!");
   auto stream = client.Stream<replication::WalFilesRpc>(wal_files.size());
   replication::Encoder encoder(stream.GetBuilder());
   for (const auto &wal : wal_files) {
     spdlog::debug("Sending wal file: {}", wal);
-    encoder.WriteFile(wal);
+    encoder.WriteFile(wal, compress);
   }
   return stream.AwaitResponse();
 }
 
-replication::SnapshotRes TransferSnapshot(rpc::Client &client, const std::filesystem::path &path) {
+replication::SnapshotRes TransferSnapshot(rpc::Client &client, const std::filesystem::path &path, const bool compress) {
   auto stream = client.Stream<replication::SnapshotRpc>();
   replication::Encoder encoder(stream.GetBuilder());
-  encoder.WriteFile(path);
+  encoder.WriteFile(path, compress);
   return stream.AwaitResponse();
 }
 
@@ -123,11 +129,11 @@ void InMemoryReplicationClient::RecoverReplica(uint64_t replica_commit) {
               using StepType = std::remove_cvref_t<T>;
               if constexpr (std::is_same_v<StepType, RecoverySnapshot>) {
                 spdlog::debug("Sending the latest snapshot file: {}", arg);
-                auto response = TransferSnapshot(rpc_client_, arg);
+                auto response = TransferSnapshot(rpc_client_, arg, compression_);
                 replica_commit = response.current_commit_timestamp;
               } else if constexpr (std::is_same_v<StepType, RecoveryWals>) {
                 spdlog::debug("Sending the latest wal files");
-                auto response = TransferWalFiles(rpc_client_, arg);
+                auto response = TransferWalFiles(rpc_client_, arg, compression_);
                 replica_commit = response.current_commit_timestamp;
                 spdlog::debug("Wal files successfully transferred.");
               } else if constexpr (std::is_same_v<StepType, RecoveryCurrentWal>) {
@@ -158,6 +164,7 @@ void InMemoryReplicationClient::RecoverReplica(uint64_t replica_commit) {
     }
 
     spdlog::trace("Current timestamp on replica: {}", replica_commit);
+    replica_commit_timestamp_.store(replica_commit);
     // To avoid the situation where we read a correct commit timestamp in
     // one thread, and after that another thread commits a different a
     // transaction and THEN we set the state to READY in the first thread,
@@ -15,6 +15,10 @@
 #include "storage/v2/durability/version.hpp"
 #include "storage/v2/inmemory/storage.hpp"
 #include "storage/v2/inmemory/unique_constraints.hpp"
+#include "utils/on_scope_exit.hpp"
+
+#include <future>
+#include <memory>
 
 namespace memgraph::storage {
 namespace {
@@ -37,23 +41,28 @@ InMemoryReplicationServer::InMemoryReplicationServer(InMemoryStorage *storage, m
     : ReplicationServer{std::move(endpoint), config}, storage_(storage) {
   rpc_server_.Register<replication::HeartbeatRpc>([this](auto *req_reader, auto *res_builder) {
     spdlog::debug("Received HeartbeatRpc");
+    std::lock_guard data_guard{data_lock_};
     this->HeartbeatHandler(req_reader, res_builder);
   });
 
   rpc_server_.Register<replication::AppendDeltasRpc>([this](auto *req_reader, auto *res_builder) {
     spdlog::debug("Received AppendDeltasRpc");
+    std::lock_guard data_guard{data_lock_};
     this->AppendDeltasHandler(req_reader, res_builder);
   });
   rpc_server_.Register<replication::SnapshotRpc>([this](auto *req_reader, auto *res_builder) {
     spdlog::debug("Received SnapshotRpc");
+    std::lock_guard data_guard{data_lock_};
     this->SnapshotHandler(req_reader, res_builder);
   });
   rpc_server_.Register<replication::WalFilesRpc>([this](auto *req_reader, auto *res_builder) {
     spdlog::debug("Received WalFilesRpc");
+    std::lock_guard data_guard{data_lock_};
     this->WalFilesHandler(req_reader, res_builder);
   });
   rpc_server_.Register<replication::CurrentWalRpc>([this](auto *req_reader, auto *res_builder) {
     spdlog::debug("Received CurrentWalRpc");
+    std::lock_guard data_guard{data_lock_};
     this->CurrentWalHandler(req_reader, res_builder);
   });
   rpc_server_.Register<replication::TimestampRpc>([this](auto *req_reader, auto *res_builder) {
@@ -62,6 +71,15 @@ InMemoryReplicationServer::InMemoryReplicationServer(InMemoryStorage *storage, m
   });
 }
 
+InMemoryReplicationServer::~InMemoryReplicationServer() {
+  // Handlers use `apply_pool_` so the RPC server has to be stopped before the pool is destroyed
+  if (rpc_server_.IsRunning()) {
+    rpc_server_.Shutdown();
+  }
+  rpc_server_.AwaitShutdown();
+  apply_pool_.Shutdown();
+}
+
 void InMemoryReplicationServer::HeartbeatHandler(slk::Reader *req_reader, slk::Builder *res_builder) {
   replication::HeartbeatReq req;
   slk::Load(&req, req_reader);
@@ -100,11 +118,13 @@ void InMemoryReplicationServer::AppendDeltasHandler(slk::Reader *req_reader, slk
 
   if (req.previous_commit_timestamp != storage_->replication_state_.last_commit_timestamp_.load()) {
     // Empty the stream
-    bool transaction_complete = false;
-    while (!transaction_complete) {
-      SPDLOG_INFO("Skipping delta");
-      const auto [timestamp, delta] = ReadDelta(&decoder);
-      transaction_complete = durability::IsWalDeltaDataTypeTransactionEnd(delta.type);
+    for (uint64_t i = 0; i < req.transactions; ++i) {
+      bool transaction_complete = false;
+      while (!transaction_complete) {
+        SPDLOG_INFO("Skipping delta");
+        const auto [timestamp, delta] = ReadDelta(&decoder);
+        transaction_complete = durability::IsWalDeltaDataTypeTransactionEnd(delta.type);
+      }
     }
 
     replication::AppendDeltasRes res{false, storage_->replication_state_.last_commit_timestamp_.load()};
@@ -112,7 +132,8 @@ void InMemoryReplicationServer::AppendDeltasHandler(slk::Reader *req_reader, slk
     return;
   }
 
-  ReadAndApplyDelta(storage_, &decoder);
+  // A batch is acknowledged as a whole with the commit timestamp of its last transaction.
+  ReadAndApplyTransactions(&decoder, req.transactions);
 
   replication::AppendDeltasRes res{true, storage_->replication_state_.last_commit_timestamp_.load()};
   slk::Save(res, res_builder);
@@ -131,18 +152,24 @@ void InMemoryReplicationServer::SnapshotHandler(slk::Reader *req_reader, slk::Bu
   MG_ASSERT(maybe_snapshot_path, "Failed to load snapshot!");
   spdlog::info("Received snapshot saved to {}", *maybe_snapshot_path);
 
-  std::unique_lock<utils::RWLock> storage_guard(storage_->main_lock_);
+  std::unique_lock<MainLock> storage_guard(storage_->main_lock_);
   spdlog::trace("Clearing database since recovering from snapshot.");
   // Clear the database
   storage_->vertices_.clear();
   storage_->edges_.clear();
 
   storage_->constraints_.existence_constraints_ = std::make_unique<ExistenceConstraints>();
-  storage_->constraints_.unique_constraints_ = std::make_unique<InMemoryUniqueConstraints>();
+  storage_->constraints_.unique_constraints_ = std::make_unique<InMemoryUniqueConstraints>(storage_->config_);
   storage_->indices_.label_index_ =
       std::make_unique<InMemoryLabelIndex>(&storage_->indices_, &storage_->constraints_, storage_->config_);
   storage_->indices_.label_property_index_ =
       std::make_unique<InMemoryLabelPropertyIndex>(&storage_->indices_, &storage_->constraints_, storage_->config_);
+  storage_->indices_.label_property_composite_index_ = std::make_unique<InMemoryLabelPropertyCompositeIndex>(
+      &storage_->indices_, &storage_->constraints_, storage_->config_);
+  storage_->indices_.edge_type_index_ =
+      std::make_unique<InMemoryEdgeTypeIndex>(&storage_->indices_, &storage_->constraints_, storage_->config_);
+  storage_->indices_.edge_type_property_index_ =
+      std::make_unique<InMemoryEdgeTypePropertyIndex>(&storage_->indices_, &storage_->constraints_, storage_->config_);
   try {
     spdlog::debug("Loading snapshot");
     auto &epoch =
@@ -157,6 +184,8 @@ void InMemoryReplicationServer::SnapshotHandler(slk::Reader *req_reader, slk::Bu
     storage_->uuid_ = std::move(recovered_snapshot.snapshot_info.uuid);
     epoch.id = std::move(recovered_snapshot.snapshot_info.epoch_id);
     const auto &recovery_info = recovered_snapshot.recovery_info;
+    storage_->vertex_gids_.DiscardBlocks();
+    storage_->edge_gids_.DiscardBlocks();
     storage_->vertex_id_ = recovery_info.next_vertex_id;
     storage_->edge_id_ = recovery_info.next_edge_id;
     storage_->timestamp_ = std::max(storage_->timestamp_, recovery_info.next_timestamp);
@@ -282,7 +311,46 @@ void InMemoryReplicationServer::TimestampHandler(slk::Reader *req_reader, slk::B
   slk::Save(res, res_builder);
 }
 
+void InMemoryReplicationServer::ReadAndApplyTransactions(durability::BaseDecoder *decoder, uint64_t transactions) {
+  if (transactions == 1) {
+    ReadAndApplyDelta(storage_, decoder);
+    return;
+  }
+
+  // At most one transaction is being applied while the next one is decoded from the stream. If decoding fails the
+  // transaction in flight still has to finish before the error is reported back, and its own result is dropped in
+  // favour of the decoding error.
+  std::future<uint64_t> applying;
+  utils::OnScopeExit drain_applying([&applying] {
+    if (applying.valid()) applying.wait();
+  });
+  for (uint64_t i = 0; i < transactions; ++i) {
+    auto deltas = ReadTransaction(decoder);
+    if (applying.valid()) applying.get();
+    auto task = std::make_shared<std::packaged_task<uint64_t()>>(
+        [storage = storage_, deltas = std::move(deltas)] { return ApplyTransaction(storage, deltas); });
+    applying = task->get_future();
+    apply_pool_.AddTask([task] { (*task)(); });
+  }
+  if (applying.valid()) applying.get();
+}
+
 uint64_t InMemoryReplicationServer::ReadAndApplyDelta(InMemoryStorage *storage, durability::BaseDecoder *decoder) {
+  return ApplyTransaction(storage, ReadTransaction(decoder));
+}
+
+InMemoryReplicationServer::TransactionDeltas InMemoryReplicationServer::ReadTransaction(
+    durability::BaseDecoder *decoder) {
+  TransactionDeltas deltas;
+  for (bool transaction_complete = false; !transaction_complete;) {
+    auto timestamp_and_delta = ReadDelta(decoder);
+    transaction_complete = durability::IsWalDeltaDataTypeTransactionEnd(timestamp_and_delta.second.type);
+    deltas.emplace_back(std::move(timestamp_and_delta));
+  }
+  return deltas;
+}
+
+uint64_t InMemoryReplicationServer::ApplyTransaction(InMemoryStorage *storage, const TransactionDeltas &deltas) {
   auto edge_acc = storage->edges_.access();
   auto vertex_acc = storage->vertices_.access();
 
@@ -302,14 +370,12 @@ uint64_t InMemoryReplicationServer::ReadAndApplyDelta(InMemoryStorage *storage,
   uint64_t applied_deltas = 0;
   auto max_commit_timestamp = storage->replication_state_.last_commit_timestamp_.load();
 
-  for (bool transaction_complete = false; !transaction_complete; ++applied_deltas) {
-    const auto [timestamp, delta] = ReadDelta(decoder);
+  for (const auto &[timestamp, delta] : deltas) {
+    ++applied_deltas;
     if (timestamp > max_commit_timestamp) {
       max_commit_timestamp = timestamp;
     }
 
-    transaction_complete = durability::IsWalDeltaDataTypeTransactionEnd(delta.type);
-
     if (timestamp < storage->timestamp_) {
       continue;
     }
@@ -409,6 +475,12 @@ uint64_t InMemoryReplicationServer::ReadAndApplyDelta(InMemoryStorage *storage,
         // yields an accessor that is only valid for managing the edge's
         // properties.
         auto edge = edge_acc.find(delta.vertex_edge_set_property.gid);
+        if (storage->config_.items.light_edges && edge == edge_acc.end()) {
+          // The light edge gets its object when the first property is set on
+          // it. The deltas are applied by a single thread, so the object can
+          // be created here without locking the from vertex.
+          edge = edge_acc.insert(Edge{delta.vertex_edge_set_property.gid, nullptr}).first;
+        }
         if (edge == edge_acc.end()) throw utils::BasicException("Invalid transaction!");
         // The edge visibility check must be done here manually because we
         // don't allow direct access to the edges through the public API.
@@ -416,7 +488,7 @@ uint64_t InMemoryReplicationServer::ReadAndApplyDelta(InMemoryStorage *storage,
           bool is_visible = true;
           Delta *delta = nullptr;
           {
-            std::lock_guard<utils::SpinLock> guard(edge->lock);
+            std::lock_guard guard(edge->lock);
             is_visible = !edge->deleted;
             delta = edge->delta;
           }
@@ -443,7 +515,7 @@ uint64_t InMemoryReplicationServer::ReadAndApplyDelta(InMemoryStorage *storage,
           });
           if (!is_visible) throw utils::BasicException("Invalid transaction!");
         }
-        EdgeRef edge_ref(&*edge);
+        EdgeRef edge_ref = storage->config_.items.EdgeRefsArePointers() ? EdgeRef(&*edge) : EdgeRef(edge->gid);
         // Here we create an edge accessor that we will use to get the
         // properties of the edge. The accessor is created with an invalid
         // type and invalid from/to pointers because we don't know them
@@ -562,6 +634,108 @@ uint64_t InMemoryReplicationServer::ReadAndApplyDelta(InMemoryStorage *storage,
           throw utils::BasicException("Invalid transaction!");
         break;
       }
+      case durability::WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE: {
+        std::stringstream ss;
+        utils::PrintIterable(ss, delta.operation_label_property_list.properties);
+        spdlog::trace("       Create composite label+property index on :{} ({})",
+                      delta.operation_label_property_list.label, ss.str());
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        std::vector<PropertyId> properties;
+        for (const auto &prop : delta.operation_label_property_list.properties) {
+          properties.push_back(storage->NameToProperty(prop));
+        }
+        if (storage->CreateIndex(storage->NameToLabel(delta.operation_label_property_list.label), properties, timestamp)
+                .HasError())
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_DROP: {
+        std::stringstream ss;
+        utils::PrintIterable(ss, delta.operation_label_property_list.properties);
+        spdlog::trace("       Drop composite label+property index on :{} ({})",
+                      delta.operation_label_property_list.label, ss.str());
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        std::vector<PropertyId> properties;
+        for (const auto &prop : delta.operation_label_property_list.properties) {
+          properties.push_back(storage->NameToProperty(prop));
+        }
+        if (storage->DropIndex(storage->NameToLabel(delta.operation_label_property_list.label), properties, timestamp)
+                .HasError())
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::TEXT_INDEX_CREATE: {
+        spdlog::trace("       Create text index on :{} ({})", delta.operation_label_property.label,
+                      delta.operation_label_property.property);
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        if (storage
+                ->CreateTextIndex(storage->NameToLabel(delta.operation_label_property.label),
+                                  storage->NameToProperty(delta.operation_label_property.property), timestamp)
+                .HasError())
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::TEXT_INDEX_DROP: {
+        spdlog::trace("       Drop text index on :{} ({})", delta.operation_label_property.label,
+                      delta.operation_label_property.property);
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        if (storage
+                ->DropTextIndex(storage->NameToLabel(delta.operation_label_property.label),
+                                storage->NameToProperty(delta.operation_label_property.property), timestamp)
+                .HasError())
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::VECTOR_INDEX_CREATE: {
+        spdlog::trace("       Create vector index on :{} ({})", delta.operation_label_property.label,
+                      delta.operation_label_property.property);
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        if (storage
+                ->CreateVectorIndex(storage->NameToLabel(delta.operation_label_property.label),
+                                  storage->NameToProperty(delta.operation_label_property.property), timestamp)
+                .HasError())
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::VECTOR_INDEX_DROP: {
+        spdlog::trace("       Drop vector index on :{} ({})", delta.operation_label_property.label,
+                      delta.operation_label_property.property);
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        if (storage
+                ->DropVectorIndex(storage->NameToLabel(delta.operation_label_property.label),
+                                storage->NameToProperty(delta.operation_label_property.property), timestamp)
+                .HasError())
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::AGGREGATE_INDEX_CREATE: {
+        const auto &properties = delta.operation_label_property_list.properties;
+        if (properties.size() != 2) throw utils::BasicException("Invalid transaction!");
+        spdlog::trace("       Create aggregate index on :{} ({}, {})", delta.operation_label_property_list.label,
+                      properties[0], properties[1]);
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        if (storage
+                ->CreateAggregateIndex(storage->NameToLabel(delta.operation_label_property_list.label),
+                                       storage->NameToProperty(properties[0]), storage->NameToProperty(properties[1]),
+                                       timestamp)
+                .HasError())
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::AGGREGATE_INDEX_DROP: {
+        const auto &properties = delta.operation_label_property_list.properties;
+        if (properties.size() != 2) throw utils::BasicException("Invalid transaction!");
+        spdlog::trace("       Drop aggregate index on :{} ({}, {})", delta.operation_label_property_list.label,
+                      properties[0], properties[1]);
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        if (storage
+                ->DropAggregateIndex(storage->NameToLabel(delta.operation_label_property_list.label),
+                                     storage->NameToProperty(properties[0]), storage->NameToProperty(properties[1]),
+                                     timestamp)
+                .HasError())
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
     }
   }
 
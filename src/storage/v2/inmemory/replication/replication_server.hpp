@@ -11,8 +11,13 @@
 
 #pragma once
 
+#include "storage/v2/durability/wal.hpp"
 #include "storage/v2/replication/replication_server.hpp"
 #include "storage/v2/replication/serialization.hpp"
+#include "utils/thread_pool.hpp"
+
+#include <utility>
+#include <vector>
 
 namespace memgraph::storage {
 
@@ -23,7 +28,16 @@ class InMemoryReplicationServer : public ReplicationServer {
   explicit InMemoryReplicationServer(InMemoryStorage *storage, io::network::Endpoint endpoint,
                                      const replication::ReplicationServerConfig &config);
 
+  InMemoryReplicationServer(const InMemoryReplicationServer &) = delete;
+  InMemoryReplicationServer(InMemoryReplicationServer &&) = delete;
+  InMemoryReplicationServer &operator=(const InMemoryReplicationServer &) = delete;
+  InMemoryReplicationServer &operator=(InMemoryReplicationServer &&) = delete;
+
+  ~InMemoryReplicationServer() override;
+
  private:
+  using TransactionDeltas = std::vector<std::pair<uint64_t, durability::WalDeltaData>>;
+
   // RPC handlers
   void HeartbeatHandler(slk::Reader *req_reader, slk::Builder *res_builder);
 
@@ -41,7 +55,17 @@ class InMemoryReplicationServer : public ReplicationServer {
 
   static uint64_t ReadAndApplyDelta(InMemoryStorage *storage, durability::BaseDecoder *decoder);
 
+  static TransactionDeltas ReadTransaction(durability::BaseDecoder *decoder);
+
+  static uint64_t ApplyTransaction(InMemoryStorage *storage, const TransactionDeltas &deltas);
+
+  // Applies `transactions` consecutive transactions. The next transaction is decoded while the previous one is
+  // being applied, transactions are committed in order.
+  void ReadAndApplyTransactions(durability::BaseDecoder *decoder, uint64_t transactions);
+
   InMemoryStorage *storage_;
+  // Single thread so the transactions are committed in the same order as on MAIN
+  utils::ThreadPool apply_pool_{1};
 };
 
 }  // namespace memgraph::storage
@@ -10,18 +10,58 @@
 // licenses/APL.txt.
 
 #include "storage/v2/inmemory/storage.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <latch>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <thread>
+
 #include "storage/v2/durability/durability.hpp"
 #include "storage/v2/durability/snapshot.hpp"
+#include "utils/event_gauge.hpp"
+#include "utils/memory_tracker.hpp"
+#include "utils/tracepoint.hpp"
 
 /// REPLICATION ///
 #include "storage/v2/inmemory/replication/replication_client.hpp"
 #include "storage/v2/inmemory/replication/replication_server.hpp"
 #include "storage/v2/inmemory/unique_constraints.hpp"
+#include "storage/v2/replication/serialization.hpp"
+
+namespace memgraph::metrics {
+extern const Event GCLatency_us;
+extern const Event GCPendingTransactions;
+extern const Event GCPendingDeltas;
+extern const Event GCPendingUndoBuffers;
+}  // namespace memgraph::metrics
 
 namespace memgraph::storage {
 
 using OOMExceptionEnabler = utils::MemoryTracker::OutOfMemoryExceptionEnabler;
 
+// Parallel GC doesn't split the unlinking of fewer deltas than this into
+// another task.
+constexpr size_t kGcMinDeltasPerTask = 4096;
+
+// The incremental GC runs a cycle after this many ticks without one even if
+// the backlog is small, so that the memory of already unlinked transactions
+// and aborted transactions is eventually released.
+constexpr uint64_t kGcMaxIdleTicks = 10;
+
+// When detach deleting vertices, a neighbor with the neighbor index erases its
+// links to them one by one if they are fewer than this fraction of its edges,
+// otherwise its adjacency list is compacted in a single pass.
+constexpr size_t kMaxIndexedRemovalRatio = 16;
+
+// The tiering loads the evicted property values of an object back into memory
+// once its properties were read this many times since its previous visit,
+// counting the halved reads from before it.
+constexpr uint8_t kHotPropertyReads = 2;
+
 InMemoryStorage::InMemoryStorage(Config config)
     : Storage(config, StorageMode::IN_MEMORY_TRANSACTIONAL),
       snapshot_directory_(config.durability.storage_directory / durability::kSnapshotDirectory),
@@ -96,6 +136,12 @@ InMemoryStorage::InMemoryStorage(Config config)
           "those files into a .backup directory inside the storage directory.");
     }
   }
+  if (config_.durability.snapshot_wal_mode == Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL &&
+      config_.durability.wal_segment_pool_size > 0) {
+    wal_segment_pool_.emplace(wal_directory_ / durability::kWalSegmentsDirectory,
+                              config_.durability.wal_file_size_kibibytes * 1024,
+                              config_.durability.wal_segment_pool_size);
+  }
   if (config_.durability.snapshot_wal_mode != Config::Durability::SnapshotWalMode::DISABLED) {
     snapshot_runner_.Run("Snapshot", config_.durability.snapshot_interval, [this] {
       if (auto maybe_error = this->CreateSnapshot({true}); maybe_error.HasError()) {
@@ -115,8 +161,38 @@ InMemoryStorage::InMemoryStorage(Config config)
       }
     });
   }
+  if (config_.gc.threads > 1) {
+    // The GC thread itself is one of the workers.
+    gc_thread_pool_ = std::make_unique<utils::ThreadPool>(config_.gc.threads - 1);
+  }
+  // The garbage held back by a late GC cycle keeps growing, so it runs before the other due tasks.
+  const utils::PeriodicTaskOptions gc_options{.priority = utils::PeriodicTaskPriority::HIGH};
   if (config_.gc.type == Config::Gc::Type::PERIODIC) {
-    gc_runner_.Run("Storage GC", config_.gc.interval, [this] { this->CollectGarbage<false>(); });
+    gc_runner_.Run(
+        "Storage GC", config_.gc.interval, [this] { this->CollectGarbage<false>(); }, gc_options);
+  } else if (config_.gc.type == Config::Gc::Type::INCREMENTAL) {
+    gc_runner_.Run(
+        "Storage GC", config_.gc.interval, [this] { this->RunIncrementalGc(); }, gc_options);
+  }
+  // The maintenance runs on the workers with the lowest CPU and I/O priority, and the jitter spreads the runs of
+  // the databases started together.
+  if (config_.index_stats.refresh_threshold > 0) {
+    index_stats_runner_.Run(
+        "Index stats", config_.index_stats.refresh_interval, [this] { this->RefreshIndexStats(); },
+        {.jitter = config_.index_stats.refresh_interval / 10, .priority = utils::PeriodicTaskPriority::LOW});
+  }
+  if (config_.defragmentation.budget > 0) {
+    defragmentation_runner_.Run(
+        "Defragmentation", config_.defragmentation.interval,
+        [this] { this->DefragmentMemory(config_.defragmentation.budget); },
+        {.jitter = config_.defragmentation.interval / 10, .priority = utils::PeriodicTaskPriority::LOW});
+  }
+  if (config_.tiering.budget > 0) {
+    cold_value_store_ =
+        std::make_unique<ColdValueStore>(config_.durability.storage_directory / durability::kColdValuesDirectory);
+    tiering_runner_.Run(
+        "Tiering", config_.tiering.interval, [this] { this->TierPropertyValues(config_.tiering.budget); },
+        {.jitter = config_.tiering.interval / 10, .priority = utils::PeriodicTaskPriority::LOW});
   }
 
   if (timestamp_ == kTimestampInitialId) {
@@ -124,6 +200,7 @@ InMemoryStorage::InMemoryStorage(Config config)
   } else {
     commit_log_.emplace(timestamp_);
   }
+  read_only_transactions_.Publish(timestamp_, graph_version_);
 
   if (config_.durability.restore_replication_state_on_startup) {
     spdlog::info("Replication configuration will be stored and will be automatically restored in case of a crash.");
@@ -148,7 +225,10 @@ InMemoryStorage::InMemoryStorage(Config config)
 }
 
 InMemoryStorage::~InMemoryStorage() {
-  if (config_.gc.type == Config::Gc::Type::PERIODIC) {
+  defragmentation_runner_.Stop();
+  tiering_runner_.Stop();
+  index_stats_runner_.Stop();
+  if (config_.gc.type != Config::Gc::Type::NONE) {
     gc_runner_.Stop();
   }
   {
@@ -181,8 +261,8 @@ InMemoryStorage::~InMemoryStorage() {
 }
 
 InMemoryStorage::InMemoryAccessor::InMemoryAccessor(InMemoryStorage *storage, IsolationLevel isolation_level,
-                                                    StorageMode storage_mode)
-    : Accessor(storage, isolation_level, storage_mode), config_(storage->config_.items) {}
+                                                    StorageMode storage_mode, bool read_only)
+    : Accessor(storage, isolation_level, storage_mode, read_only), config_(storage->config_.items) {}
 InMemoryStorage::InMemoryAccessor::InMemoryAccessor(InMemoryAccessor &&other) noexcept
     : Accessor(std::move(other)), config_(other.config_) {}
 
@@ -197,7 +277,7 @@ InMemoryStorage::InMemoryAccessor::~InMemoryAccessor() {
 VertexAccessor InMemoryStorage::InMemoryAccessor::CreateVertex() {
   OOMExceptionEnabler oom_exception;
   auto *mem_storage = static_cast<InMemoryStorage *>(storage_);
-  auto gid = mem_storage->vertex_id_.fetch_add(1, std::memory_order_acq_rel);
+  auto gid = mem_storage->vertex_gids_.Next();
   auto acc = mem_storage->vertices_.access();
 
   auto *delta = CreateDeleteObjectDelta(&transaction_);
@@ -213,15 +293,14 @@ VertexAccessor InMemoryStorage::InMemoryAccessor::CreateVertex() {
 
 VertexAccessor InMemoryStorage::InMemoryAccessor::CreateVertexEx(storage::Gid gid) {
   OOMExceptionEnabler oom_exception;
-  // NOTE: When we update the next `vertex_id_` here we perform a RMW
-  // (read-modify-write) operation that ISN'T atomic! But, that isn't an issue
-  // because this function is only called from the replication delta applier
-  // that runs single-threadedly and while this instance is set-up to apply
-  // threads (it is the replica), it is guaranteed that no other writes are
-  // possible.
+  // NOTE: The next `vertex_id_` is raised with a CAS loop because the CSV
+  // import tool creates vertices with given GIDs from multiple threads.
   auto *mem_storage = static_cast<InMemoryStorage *>(storage_);
-  mem_storage->vertex_id_.store(std::max(mem_storage->vertex_id_.load(std::memory_order_acquire), gid.AsUint() + 1),
-                                std::memory_order_release);
+  mem_storage->vertex_gids_.DiscardBlocks();
+  auto next_id = mem_storage->vertex_id_.load(std::memory_order_acquire);
+  while (next_id < gid.AsUint() + 1 &&
+         !mem_storage->vertex_id_.compare_exchange_weak(next_id, gid.AsUint() + 1, std::memory_order_acq_rel)) {
+  }
   auto acc = mem_storage->vertices_.access();
 
   auto *delta = CreateDeleteObjectDelta(&transaction_);
@@ -248,7 +327,7 @@ Result<std::optional<VertexAccessor>> InMemoryStorage::InMemoryAccessor::DeleteV
             "accessor when deleting a vertex!");
   auto *vertex_ptr = vertex->vertex_;
 
-  std::lock_guard<utils::SpinLock> guard(vertex_ptr->lock);
+  std::lock_guard guard(vertex_ptr->lock);
 
   if (!PrepareForWrite(&transaction_, vertex_ptr)) return Error::SERIALIZATION_ERROR;
 
@@ -261,6 +340,7 @@ Result<std::optional<VertexAccessor>> InMemoryStorage::InMemoryAccessor::DeleteV
   CreateAndLinkDelta(&transaction_, vertex_ptr, Delta::RecreateObjectTag());
   vertex_ptr->deleted = true;
   transaction_.manyDeltasCache.Invalidate(vertex_ptr);
+  if (transaction_.property_columns) transaction_.property_columns->Invalidate();
 
   // Need to inform the next CollectGarbage call that there are some
   // non-transactional deletions that need to be collected
@@ -282,11 +362,11 @@ InMemoryStorage::InMemoryAccessor::DetachDeleteVertex(VertexAccessor *vertex) {
             "accessor when deleting a vertex!");
   auto *vertex_ptr = vertex->vertex_;
 
-  std::vector<std::tuple<EdgeTypeId, Vertex *, EdgeRef>> in_edges;
-  std::vector<std::tuple<EdgeTypeId, Vertex *, EdgeRef>> out_edges;
+  AdjacencyList in_edges;
+  AdjacencyList out_edges;
 
   {
-    std::lock_guard<utils::SpinLock> guard(vertex_ptr->lock);
+    std::lock_guard guard(vertex_ptr->lock);
 
     if (!PrepareForWrite(&transaction_, vertex_ptr)) return Error::SERIALIZATION_ERROR;
 
@@ -326,7 +406,7 @@ InMemoryStorage::InMemoryAccessor::DetachDeleteVertex(VertexAccessor *vertex) {
     }
   }
 
-  std::lock_guard<utils::SpinLock> guard(vertex_ptr->lock);
+  std::lock_guard guard(vertex_ptr->lock);
 
   // We need to check again for serialization errors because we unlocked the
   // vertex. Some other transaction could have modified the vertex in the
@@ -339,6 +419,7 @@ InMemoryStorage::InMemoryAccessor::DetachDeleteVertex(VertexAccessor *vertex) {
   CreateAndLinkDelta(&transaction_, vertex_ptr, Delta::RecreateObjectTag());
   vertex_ptr->deleted = true;
   transaction_.manyDeltasCache.Invalidate(vertex_ptr);
+  if (transaction_.property_columns) transaction_.property_columns->Invalidate();
 
   // Need to inform the next CollectGarbage call that there are some
   // non-transactional deletions that need to be collected
@@ -352,6 +433,175 @@ InMemoryStorage::InMemoryAccessor::DetachDeleteVertex(VertexAccessor *vertex) {
       std::move(deleted_edges));
 }
 
+Result<std::pair<std::vector<VertexAccessor>, std::vector<EdgeAccessor>>>
+InMemoryStorage::InMemoryAccessor::DetachDeleteVertices(const std::vector<VertexAccessor *> &vertices) {
+  std::pair<std::vector<VertexAccessor>, std::vector<EdgeAccessor>> deleted;
+  auto &[deleted_vertices, deleted_edges] = deleted;
+
+  // The vertices are deleted in the order of their gids, each only once.
+  std::vector<Vertex *> targets;
+  targets.reserve(vertices.size());
+  for (auto *vertex : vertices) {
+    MG_ASSERT(vertex->transaction_ == &transaction_,
+              "VertexAccessor must be from the same transaction as the storage "
+              "accessor when deleting a vertex!");
+    targets.push_back(vertex->vertex_);
+  }
+  const auto by_gid = [](const Vertex *lhs, const Vertex *rhs) { return lhs->gid < rhs->gid; };
+  std::sort(targets.begin(), targets.end(), by_gid);
+  targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+  const auto is_target = [&](const Vertex *vertex) {
+    return std::binary_search(targets.begin(), targets.end(), vertex, by_gid);
+  };
+
+  bool deleted_edge_objects = false;
+  const auto delete_edge_object = [&](Edge *edge_ptr) {
+    std::lock_guard guard(edge_ptr->lock);
+    if (!PrepareForWrite(&transaction_, edge_ptr)) return false;
+    if (edge_ptr->deleted) return true;
+    CreateAndLinkDelta(&transaction_, edge_ptr, Delta::RecreateObjectTag());
+    edge_ptr->deleted = true;
+    deleted_edge_objects = true;
+    return true;
+  };
+  // A light edge only has an object if a property was set on it. The object
+  // is created while the from vertex is locked, so it's looked up with the
+  // from vertex locked, as in `DeleteEdge`.
+  const auto delete_light_edge_objects = [&](const std::vector<AdjacencyList::value_type> &out_links) {
+    if (!config_.properties_on_edges || config_.EdgeRefsArePointers()) return true;
+    auto acc = transaction_.edges->access();
+    for (const auto &[edge_type, to_vertex, edge_ref] : out_links) {
+      auto it = acc.find(edge_ref.gid);
+      if (it != acc.end() && !delete_edge_object(&*it)) return false;
+    }
+    return true;
+  };
+
+  // The links as they are stored in the adjacency lists of the neighbors which
+  // aren't deleted.
+  struct NeighborLink {
+    Vertex *neighbor;
+    EdgeDirection direction;
+    AdjacencyList::value_type link;
+  };
+  std::vector<NeighborLink> neighbor_links;
+
+  // 1. Every vertex drops all of its links at once. The edges between two of
+  // the vertices are removed from both of them here, each edge is counted with
+  // its from vertex.
+  std::vector<AdjacencyList::value_type> in_links;
+  std::vector<AdjacencyList::value_type> out_links;
+  for (auto *vertex : targets) {
+    {
+      std::lock_guard guard(vertex->lock);
+      if (!PrepareForWrite(&transaction_, vertex)) return Error::SERIALIZATION_ERROR;
+      if (vertex->deleted) continue;
+
+      in_links.assign(vertex->in_edges.begin(), vertex->in_edges.end());
+      out_links.assign(vertex->out_edges.begin(), vertex->out_edges.end());
+      if (!delete_light_edge_objects(out_links)) return Error::SERIALIZATION_ERROR;
+
+      vertex->in_edges.clear();
+      vertex->out_edges.clear();
+      for (const auto &[edge_type, from_vertex, edge_ref] : in_links) {
+        CreateAndLinkDelta(&transaction_, vertex, Delta::AddInEdgeTag(), edge_type, from_vertex, edge_ref);
+      }
+      for (const auto &[edge_type, to_vertex, edge_ref] : out_links) {
+        CreateAndLinkDelta(&transaction_, vertex, Delta::AddOutEdgeTag(), edge_type, to_vertex, edge_ref);
+      }
+      storage_->edge_count_.fetch_sub(out_links.size(), std::memory_order_acq_rel);
+
+      CreateAndLinkDelta(&transaction_, vertex, Delta::RecreateObjectTag());
+      vertex->deleted = true;
+      transaction_.manyDeltasCache.Invalidate(vertex);
+    }
+
+    deleted_vertices.emplace_back(vertex, &transaction_, &storage_->indices_, &storage_->constraints_, config_, true);
+    for (const auto &[edge_type, to_vertex, edge_ref] : out_links) {
+      deleted_edges.emplace_back(edge_ref, edge_type, vertex, to_vertex, &transaction_, &storage_->indices_,
+                                 &storage_->constraints_, config_, true);
+      if (!is_target(to_vertex)) {
+        neighbor_links.push_back({to_vertex, EdgeDirection::IN, {edge_type, vertex, edge_ref}});
+      }
+    }
+    for (const auto &[edge_type, from_vertex, edge_ref] : in_links) {
+      if (is_target(from_vertex)) continue;
+      deleted_edges.emplace_back(edge_ref, edge_type, from_vertex, vertex, &transaction_, &storage_->indices_,
+                                 &storage_->constraints_, config_, true);
+      neighbor_links.push_back({from_vertex, EdgeDirection::OUT, {edge_type, vertex, edge_ref}});
+    }
+  }
+  if (deleted_vertices.empty()) return deleted;
+
+  // 2. The edge objects are locked without holding a vertex lock, as in
+  // `DeleteEdge`.
+  if (config_.EdgeRefsArePointers()) {
+    for (const auto &edge : deleted_edges) {
+      if (!delete_edge_object(edge.edge_.ptr)) return Error::SERIALIZATION_ERROR;
+    }
+  }
+
+  // 3. Every neighbor drops its links to the vertices at once.
+  std::sort(neighbor_links.begin(), neighbor_links.end(),
+            [](const NeighborLink &lhs, const NeighborLink &rhs) { return lhs.neighbor->gid < rhs.neighbor->gid; });
+  for (auto run = neighbor_links.begin(); run != neighbor_links.end();) {
+    auto *vertex = run->neighbor;
+    auto run_end = std::find_if(run, neighbor_links.end(), [&](const auto &item) { return item.neighbor != vertex; });
+
+    std::lock_guard guard(vertex->lock);
+    if (!PrepareForWrite(&transaction_, vertex)) return Error::SERIALIZATION_ERROR;
+    MG_ASSERT(!vertex->deleted, "Invalid database state!");
+
+    in_links.clear();
+    out_links.clear();
+    for (auto it = run; it != run_end; ++it) {
+      (it->direction == EdgeDirection::OUT ? out_links : in_links).push_back(it->link);
+    }
+    if (!delete_light_edge_objects(out_links)) return Error::SERIALIZATION_ERROR;
+
+    const auto remove_links = [&](AdjacencyList *edges, const std::vector<AdjacencyList::value_type> &links) {
+      if (links.empty()) return;
+      // With the neighbor index a few links are found without scanning the
+      // list, otherwise the list is compacted in a single pass.
+      if (edges->HasNeighborIndex() && links.size() * kMaxIndexedRemovalRatio < edges->size()) {
+        for (const auto &link : links) {
+          const bool removed = edges->erase(link);
+          MG_ASSERT(removed || !config_.EdgeRefsArePointers(), "Invalid database state!");
+        }
+      } else {
+        const auto removed = edges->erase_if(
+            [&](const AdjacencyList::value_type &link) { return is_target(std::get<1>(link)); });
+        MG_ASSERT(removed == links.size() || !config_.EdgeRefsArePointers(), "Invalid database state!");
+      }
+    };
+    remove_links(&vertex->out_edges, out_links);
+    remove_links(&vertex->in_edges, in_links);
+
+    for (const auto &[edge_type, to_vertex, edge_ref] : out_links) {
+      CreateAndLinkDelta(&transaction_, vertex, Delta::AddOutEdgeTag(), edge_type, to_vertex, edge_ref);
+      transaction_.manyDeltasCache.Invalidate(vertex, edge_type, EdgeDirection::OUT);
+    }
+    for (const auto &[edge_type, from_vertex, edge_ref] : in_links) {
+      CreateAndLinkDelta(&transaction_, vertex, Delta::AddInEdgeTag(), edge_type, from_vertex, edge_ref);
+      transaction_.manyDeltasCache.Invalidate(vertex, edge_type, EdgeDirection::IN);
+    }
+    storage_->edge_count_.fetch_sub(out_links.size(), std::memory_order_acq_rel);
+
+    run = run_end;
+  }
+
+  if (transaction_.property_columns) transaction_.property_columns->Invalidate();
+  // Need to inform the next CollectGarbage call that there are some
+  // non-transactional deletions that need to be collected
+  if (transaction_.storage_mode == StorageMode::IN_MEMORY_ANALYTICAL) {
+    auto *mem_storage = static_cast<InMemoryStorage *>(storage_);
+    mem_storage->gc_full_scan_vertices_delete_ = true;
+    if (deleted_edge_objects) mem_storage->gc_full_scan_edges_delete_ = true;
+  }
+
+  return deleted;
+}
+
 Result<EdgeAccessor> InMemoryStorage::InMemoryAccessor::CreateEdge(VertexAccessor *from, VertexAccessor *to,
                                                                    EdgeTypeId edge_type) {
   OOMExceptionEnabler oom_exception;
@@ -366,8 +616,8 @@ Result<EdgeAccessor> InMemoryStorage::InMemoryAccessor::CreateEdge(VertexAccesso
   auto *to_vertex = to->vertex_;
 
   // Obtain the locks by `gid` order to avoid lock cycles.
-  std::unique_lock<utils::SpinLock> guard_from(from_vertex->lock, std::defer_lock);
-  std::unique_lock<utils::SpinLock> guard_to(to_vertex->lock, std::defer_lock);
+  std::unique_lock guard_from(from_vertex->lock, std::defer_lock);
+  std::unique_lock guard_to(to_vertex->lock, std::defer_lock);
   if (from_vertex->gid < to_vertex->gid) {
     guard_from.lock();
     guard_to.lock();
@@ -388,9 +638,9 @@ Result<EdgeAccessor> InMemoryStorage::InMemoryAccessor::CreateEdge(VertexAccesso
   }
 
   auto *mem_storage = static_cast<InMemoryStorage *>(storage_);
-  auto gid = storage::Gid::FromUint(mem_storage->edge_id_.fetch_add(1, std::memory_order_acq_rel));
+  auto gid = storage::Gid::FromUint(mem_storage->edge_gids_.Next());
   EdgeRef edge(gid);
-  if (config_.properties_on_edges) {
+  if (config_.EdgeRefsArePointers()) {
     auto acc = mem_storage->edges_.access();
     auto *delta = CreateDeleteObjectDelta(&transaction_);
     auto [it, inserted] = acc.insert(Edge(gid, delta));
@@ -411,6 +661,8 @@ Result<EdgeAccessor> InMemoryStorage::InMemoryAccessor::CreateEdge(VertexAccesso
   transaction_.manyDeltasCache.Invalidate(from_vertex, edge_type, EdgeDirection::OUT);
   transaction_.manyDeltasCache.Invalidate(to_vertex, edge_type, EdgeDirection::IN);
 
+  storage_->indices_.UpdateOnEdgeCreation(from_vertex, to_vertex, edge, edge_type, transaction_);
+
   // Increment edge count.
   storage_->edge_count_.fetch_add(1, std::memory_order_acq_rel);
 
@@ -432,8 +684,8 @@ Result<EdgeAccessor> InMemoryStorage::InMemoryAccessor::CreateEdgeEx(VertexAcces
   auto *to_vertex = to->vertex_;
 
   // Obtain the locks by `gid` order to avoid lock cycles.
-  std::unique_lock<utils::SpinLock> guard_from(from_vertex->lock, std::defer_lock);
-  std::unique_lock<utils::SpinLock> guard_to(to_vertex->lock, std::defer_lock);
+  std::unique_lock guard_from(from_vertex->lock, std::defer_lock);
+  std::unique_lock guard_to(to_vertex->lock, std::defer_lock);
   if (from_vertex->gid < to_vertex->gid) {
     guard_from.lock();
     guard_to.lock();
@@ -460,11 +712,12 @@ Result<EdgeAccessor> InMemoryStorage::InMemoryAccessor::CreateEdgeEx(VertexAcces
   // threads (it is the replica), it is guaranteed that no other writes are
   // possible.
   auto *mem_storage = static_cast<InMemoryStorage *>(storage_);
+  mem_storage->edge_gids_.DiscardBlocks();
   mem_storage->edge_id_.store(std::max(mem_storage->edge_id_.load(std::memory_order_acquire), gid.AsUint() + 1),
                               std::memory_order_release);
 
   EdgeRef edge(gid);
-  if (config_.properties_on_edges) {
+  if (config_.EdgeRefsArePointers()) {
     auto acc = mem_storage->edges_.access();
 
     auto *delta = CreateDeleteObjectDelta(&transaction_);
@@ -486,6 +739,8 @@ Result<EdgeAccessor> InMemoryStorage::InMemoryAccessor::CreateEdgeEx(VertexAcces
   transaction_.manyDeltasCache.Invalidate(from_vertex, edge_type, EdgeDirection::OUT);
   transaction_.manyDeltasCache.Invalidate(to_vertex, edge_type, EdgeDirection::IN);
 
+  storage_->indices_.UpdateOnEdgeCreation(from_vertex, to_vertex, edge, edge_type, transaction_);
+
   // Increment edge count.
   storage_->edge_count_.fetch_add(1, std::memory_order_acq_rel);
 
@@ -500,10 +755,11 @@ Result<std::optional<EdgeAccessor>> InMemoryStorage::InMemoryAccessor::DeleteEdg
   auto edge_ref = edge->edge_;
   auto edge_type = edge->edge_type_;
 
-  std::unique_lock<utils::SpinLock> guard;
-  if (config_.properties_on_edges) {
-    auto *edge_ptr = edge_ref.ptr;
-    guard = std::unique_lock<utils::SpinLock>(edge_ptr->lock);
+  Edge *edge_ptr = nullptr;
+  std::unique_lock<ObjectLock> guard;
+  if (config_.EdgeRefsArePointers()) {
+    edge_ptr = edge_ref.ptr;
+    guard = std::unique_lock(edge_ptr->lock);
 
     if (!PrepareForWrite(&transaction_, edge_ptr)) return Error::SERIALIZATION_ERROR;
 
@@ -514,8 +770,8 @@ Result<std::optional<EdgeAccessor>> InMemoryStorage::InMemoryAccessor::DeleteEdg
   auto *to_vertex = edge->to_vertex_;
 
   // Obtain the locks by `gid` order to avoid lock cycles.
-  std::unique_lock<utils::SpinLock> guard_from(from_vertex->lock, std::defer_lock);
-  std::unique_lock<utils::SpinLock> guard_to(to_vertex->lock, std::defer_lock);
+  std::unique_lock guard_from(from_vertex->lock, std::defer_lock);
+  std::unique_lock guard_to(to_vertex->lock, std::defer_lock);
   if (from_vertex->gid < to_vertex->gid) {
     guard_from.lock();
     guard_to.lock();
@@ -535,23 +791,32 @@ Result<std::optional<EdgeAccessor>> InMemoryStorage::InMemoryAccessor::DeleteEdg
     MG_ASSERT(!to_vertex->deleted, "Invalid database state!");
   }
 
+  if (config_.properties_on_edges && !config_.EdgeRefsArePointers()) {
+    // A light edge only has an object if a property was set on it. The object
+    // is created while the from vertex is locked, so it can't be missed here.
+    auto acc = transaction_.edges->access();
+    auto it = acc.find(edge_ref.gid);
+    if (it != acc.end()) {
+      edge_ptr = &*it;
+      guard = std::unique_lock(edge_ptr->lock);
+
+      if (!PrepareForWrite(&transaction_, edge_ptr)) return Error::SERIALIZATION_ERROR;
+
+      if (edge_ptr->deleted) return std::optional<EdgeAccessor>{};
+    }
+  }
+
   auto delete_edge_from_storage = [&edge_type, &edge_ref, this](auto *vertex, auto *edges) {
     std::tuple<EdgeTypeId, Vertex *, EdgeRef> link(edge_type, vertex, edge_ref);
-    auto it = std::find(edges->begin(), edges->end(), link);
-    if (config_.properties_on_edges) {
-      MG_ASSERT(it != edges->end(), "Invalid database state!");
-    } else if (it == edges->end()) {
-      return false;
-    }
-    std::swap(*it, *edges->rbegin());
-    edges->pop_back();
-    return true;
+    bool const removed = edges->erase(link);
+    MG_ASSERT(removed || !config_.EdgeRefsArePointers(), "Invalid database state!");
+    return removed;
   };
 
   auto op1 = delete_edge_from_storage(to_vertex, &from_vertex->out_edges);
   auto op2 = delete_edge_from_storage(from_vertex, &to_vertex->in_edges);
 
-  if (config_.properties_on_edges) {
+  if (config_.EdgeRefsArePointers()) {
     MG_ASSERT((op1 && op2), "Invalid database state!");
   } else {
     MG_ASSERT((op1 && op2) || (!op1 && !op2), "Invalid database state!");
@@ -561,8 +826,7 @@ Result<std::optional<EdgeAccessor>> InMemoryStorage::InMemoryAccessor::DeleteEdg
     }
   }
 
-  if (config_.properties_on_edges) {
-    auto *edge_ptr = edge_ref.ptr;
+  if (edge_ptr) {
     CreateAndLinkDelta(&transaction_, edge_ptr, Delta::RecreateObjectTag());
     edge_ptr->deleted = true;
 
@@ -587,6 +851,78 @@ Result<std::optional<EdgeAccessor>> InMemoryStorage::InMemoryAccessor::DeleteEdg
                                           &storage_->indices_, &storage_->constraints_, config_, true);
 }
 
+namespace {
+/// Returns the sum of the values as given by the `+` of Cypher, or nothing if
+/// they can't be added.
+std::optional<PropertyValue> AddPropertyValues(const PropertyValue &current, const PropertyValue &value) {
+  if (current.IsNull()) return PropertyValue();
+  if (current.IsList() || value.IsList()) {
+    std::vector<PropertyValue> list;
+    const auto append = [&list](const PropertyValue &item) {
+      if (item.IsList()) {
+        list.insert(list.end(), item.ValueList().begin(), item.ValueList().end());
+      } else {
+        list.push_back(item);
+      }
+    };
+    append(current);
+    append(value);
+    return PropertyValue(std::move(list));
+  }
+  if (current.IsInt() && value.IsInt()) {
+    int64_t sum = 0;
+    if (__builtin_add_overflow(current.ValueInt(), value.ValueInt(), &sum)) return std::nullopt;
+    return PropertyValue(sum);
+  }
+  if ((current.IsInt() || current.IsDouble()) && (value.IsInt() || value.IsDouble())) {
+    const auto as_double = [](const PropertyValue &number) {
+      return number.IsInt() ? static_cast<double>(number.ValueInt()) : number.ValueDouble();
+    };
+    return PropertyValue(as_double(current) + as_double(value));
+  }
+  return std::nullopt;
+}
+
+// The commutative updates wait for the transactions which are committing
+// changes of the same vertex, which don't hold the vertex for long. The wait is
+// bounded because a transaction may change a vertex and not commit for long.
+constexpr uint64_t kCommutativeUpdateAttempts = 1000;
+}  // namespace
+
+bool InMemoryStorage::InMemoryAccessor::ApplyCommutativeUpdates() {
+  for (const auto &update : transaction_.commutative_updates) {
+    auto *vertex = update.vertex;
+    for (uint64_t attempt = 0;; ++attempt) {
+      std::unique_lock guard(vertex->lock);
+      // Unlike `PrepareForWrite`, the changes committed after the transaction
+      // started don't conflict with the update, which is made to the latest
+      // committed value.
+      if (vertex->delta != nullptr) {
+        auto ts = vertex->delta->timestamp->load(std::memory_order_acquire);
+        if (ts >= kTransactionInitialId && ts != transaction_.transaction_id.load(std::memory_order_acquire)) {
+          guard.unlock();
+          if (attempt == kCommutativeUpdateAttempts) return false;
+          std::this_thread::yield();
+          continue;
+        }
+      }
+      if (vertex->deleted) return false;
+
+      auto current_value = vertex->properties.GetProperty(update.property);
+      auto new_value = AddPropertyValues(current_value, update.value);
+      if (!new_value) return false;
+      CreateAndLinkDelta(&transaction_, vertex, Delta::SetPropertyTag(), update.property, current_value);
+      vertex->properties.SetProperty(update.property, *new_value);
+      storage_->indices_.UpdateOnSetProperty(update.property, *new_value, vertex, transaction_);
+      transaction_.manyDeltasCache.Invalidate(vertex, update.property);
+      if (transaction_.property_columns) transaction_.property_columns->Invalidate();
+      break;
+    }
+  }
+  transaction_.commutative_updates.clear();
+  return true;
+}
+
 // NOLINTNEXTLINE(google-default-arguments)
 utils::BasicResult<StorageDataManipulationError, void> InMemoryStorage::InMemoryAccessor::Commit(
     const std::optional<uint64_t> desired_commit_timestamp) {
@@ -597,16 +933,34 @@ utils::BasicResult<StorageDataManipulationError, void> InMemoryStorage::InMemory
 
   auto *mem_storage = static_cast<InMemoryStorage *>(storage_);
 
-  if (transaction_.deltas.empty()) {
+  if (!transaction_.commutative_updates.empty() && !ApplyCommutativeUpdates()) {
+    Abort();
+    return StorageDataManipulationError{SerializationError{}};
+  }
+
+  if (transaction_.read_only_snapshot) {
+    MG_ASSERT(transaction_.deltas.empty(), "A read-only transaction can't change the graph!");
+    mem_storage->read_only_transactions_.Finish(*transaction_.read_only_snapshot);
+  } else if (transaction_.deltas.empty()) {
     // We don't have to update the commit timestamp here because no one reads
     // it.
     mem_storage->commit_log_->MarkFinished(transaction_.start_timestamp);
   } else {
+    const bool count_index_stats_changes = mem_storage->config_.index_stats.refresh_threshold > 0;
+    IndexStatsChanges index_stats_changes;
+    const bool collect_graph_changes = mem_storage->graph_changes_.IsEnabled();
+    GraphFootprint graph_changes;
+    auto *mem_aggregate_index = static_cast<InMemoryAggregateIndex *>(storage_->indices_.aggregate_index_.get());
+    InMemoryAggregateIndex::Changes aggregate_changes;
+
     // Validate that existence constraints are satisfied for all modified
     // vertices.
     for (const auto &delta : transaction_.deltas) {
       auto prev = delta.prev.Get();
       MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
+      if (prev.type == PreviousPtr::Type::EDGE && collect_graph_changes) {
+        CollectGraphChanges(*prev.edge, transaction_, &graph_changes);
+      }
       if (prev.type != PreviousPtr::Type::VERTEX) {
         continue;
       }
@@ -617,6 +971,13 @@ utils::BasicResult<StorageDataManipulationError, void> InMemoryStorage::InMemory
         Abort();
         return StorageDataManipulationError{*validation_result};
       }
+      if (count_index_stats_changes) {
+        CountIndexStatsChanges(*prev.vertex, transaction_, &index_stats_changes);
+      }
+      if (collect_graph_changes) {
+        CollectGraphChanges(*prev.vertex, transaction_, &graph_changes);
+      }
+      mem_aggregate_index->CollectChanges(*prev.vertex, transaction_, &aggregate_changes);
     }
 
     // Result of validating the vertex against unqiue constraints. It has to be
@@ -626,39 +987,59 @@ utils::BasicResult<StorageDataManipulationError, void> InMemoryStorage::InMemory
 
     // Save these so we can mark them used in the commit log.
     uint64_t start_timestamp = transaction_.start_timestamp;
+    // Number of transactions in the WAL up to and including this one, used to
+    // wait for the WAL sync with group commit.
+    uint64_t wal_written_transactions = 0;
+
+    // The deltas are encoded before taking the engine lock, so that only the
+    // commit timestamp is written into them while holding it.
+    const bool append_to_wal = mem_storage->replication_state_.GetRole() == replication::ReplicationRole::MAIN ||
+                               desired_commit_timestamp.has_value();
+    InMemoryStorage::EncodedTransaction encoded_transaction;
+    if (append_to_wal) {
+      MG_TRACEPOINT(wal__encode__start, utils::CurrentQueryId());
+      encoded_transaction = mem_storage->EncodeTransaction(transaction_);
+      MG_TRACEPOINT(wal__encode__done, utils::CurrentQueryId());
+    }
 
     {
-      std::unique_lock<utils::SpinLock> engine_guard(storage_->engine_lock_);
+      std::unique_lock engine_guard(storage_->engine_lock_);
       auto *mem_unique_constraints =
           static_cast<InMemoryUniqueConstraints *>(storage_->constraints_.unique_constraints_.get());
       commit_timestamp_.emplace(mem_storage->CommitTimestamp(desired_commit_timestamp));
 
-      // Before committing and validating vertices against unique constraints,
-      // we have to update unique constraints with the vertices that are going
-      // to be validated/committed.
-      for (const auto &delta : transaction_.deltas) {
-        auto prev = delta.prev.Get();
-        MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
-        if (prev.type != PreviousPtr::Type::VERTEX) {
-          continue;
+      // The deltas don't have to be traversed while holding the engine lock if
+      // there are no unique constraints. Constraints can't be created while
+      // this transaction holds the storage lock.
+      if (!mem_unique_constraints->Empty()) {
+        // Before committing and validating vertices against unique constraints,
+        // we have to update unique constraints with the vertices that are going
+        // to be validated/committed.
+        for (const auto &delta : transaction_.deltas) {
+          auto prev = delta.prev.Get();
+          MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
+          if (prev.type != PreviousPtr::Type::VERTEX) {
+            continue;
+          }
+          mem_unique_constraints->UpdateBeforeCommit(prev.vertex, transaction_);
         }
-        mem_unique_constraints->UpdateBeforeCommit(prev.vertex, transaction_);
-      }
 
-      // Validate that unique constraints are satisfied for all modified
-      // vertices.
-      for (const auto &delta : transaction_.deltas) {
-        auto prev = delta.prev.Get();
-        MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
-        if (prev.type != PreviousPtr::Type::VERTEX) {
-          continue;
-        }
+        // Validate that unique constraints are satisfied for all modified
+        // vertices.
+        for (const auto &delta : transaction_.deltas) {
+          auto prev = delta.prev.Get();
+          MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
+          if (prev.type != PreviousPtr::Type::VERTEX) {
+            continue;
+          }
 
-        // No need to take any locks here because we modified this vertex and no
-        // one else can touch it until we commit.
-        unique_constraint_violation = mem_unique_constraints->Validate(*prev.vertex, transaction_, *commit_timestamp_);
-        if (unique_constraint_violation) {
-          break;
+          // No need to take any locks here because we modified this vertex and no
+          // one else can touch it until we commit.
+          unique_constraint_violation =
+              mem_unique_constraints->Validate(*prev.vertex, transaction_, *commit_timestamp_);
+          if (unique_constraint_violation) {
+            break;
+          }
         }
       }
 
@@ -672,31 +1053,41 @@ utils::BasicResult<StorageDataManipulationError, void> InMemoryStorage::InMemory
         // modifications before they are written to disk.
         // Replica can log only the write transaction received from Main
         // so the Wal files are consistent
-        if (mem_storage->replication_state_.GetRole() == replication::ReplicationRole::MAIN ||
-            desired_commit_timestamp.has_value()) {
+        if (append_to_wal) {
+          MG_TRACEPOINT(wal__write__start, utils::CurrentQueryId(), *commit_timestamp_);
           could_replicate_all_sync_replicas =
-              mem_storage->AppendToWalDataManipulation(transaction_, *commit_timestamp_);
+              mem_storage->AppendToWalDataManipulation(transaction_, &encoded_transaction, *commit_timestamp_);
+          MG_TRACEPOINT(wal__write__done, utils::CurrentQueryId(), *commit_timestamp_);
+          wal_written_transactions = mem_storage->wal_written_transactions_;
         }
 
-        // Take committed_transactions lock while holding the engine lock to
-        // make sure that committed transactions are sorted by the commit
-        // timestamp in the list.
-        mem_storage->committed_transactions_.WithLock([&](auto & /*committed_transactions*/) {
-          // TODO: release lock, and update all deltas to have a local copy
-          // of the commit timestamp
-          MG_ASSERT(transaction_.commit_timestamp != nullptr, "Invalid database state!");
-          transaction_.commit_timestamp->store(*commit_timestamp_, std::memory_order_release);
-          // Replica can only update the last commit timestamp with
-          // the commits received from main.
-          if (mem_storage->replication_state_.GetRole() == replication::ReplicationRole::MAIN ||
-              desired_commit_timestamp.has_value()) {
-            // Update the last commit timestamp
-            mem_storage->replication_state_.last_commit_timestamp_.store(*commit_timestamp_);
-          }
-          // Release engine lock because we don't have to hold it anymore
-          // and emplace back could take a long time.
-          engine_guard.unlock();
-        });
+        // The commit timestamp is published while holding the engine lock, so
+        // that every transaction started after this point sees the changes.
+        // The transaction is handed over to the GC later, in
+        // `FinalizeTransaction`, without holding the engine lock.
+        MG_ASSERT(transaction_.commit_timestamp != nullptr, "Invalid database state!");
+        transaction_.commit_timestamp->store(*commit_timestamp_, std::memory_order_release);
+        // Replica can only update the last commit timestamp with
+        // the commits received from main.
+        if (mem_storage->replication_state_.GetRole() == replication::ReplicationRole::MAIN ||
+            desired_commit_timestamp.has_value()) {
+          // Update the last commit timestamp
+          mem_storage->replication_state_.last_commit_timestamp_.store(*commit_timestamp_);
+        }
+        mem_storage->graph_version_ = Storage::NewGraphVersion();
+        if (collect_graph_changes) {
+          mem_storage->graph_changes_.Record(graph_changes, mem_storage->graph_version_);
+        } else if (mem_storage->graph_changes_.IsEnabled()) {
+          // The tracking was enabled after the changes would have been
+          // collected.
+          mem_storage->graph_changes_.RecordAll(mem_storage->graph_version_);
+        }
+        // The new versions of the aggregates are visible to the same
+        // transactions as the changes.
+        if (!aggregate_changes.empty()) mem_aggregate_index->ApplyChanges(aggregate_changes, *commit_timestamp_);
+        mem_storage->read_only_transactions_.Publish(*commit_timestamp_ + 1, mem_storage->graph_version_);
+        // Release engine lock because we don't have to hold it anymore.
+        engine_guard.unlock();
 
         mem_storage->commit_log_->MarkFinished(start_timestamp);
       }
@@ -706,6 +1097,17 @@ utils::BasicResult<StorageDataManipulationError, void> InMemoryStorage::InMemory
       Abort();
       return StorageDataManipulationError{*unique_constraint_violation};
     }
+
+    if (!index_stats_changes.labels.empty() || !index_stats_changes.properties.empty()) {
+      mem_storage->index_stats_changes_.WithLock([&](auto &changes) {
+        for (const auto &[label, count] : index_stats_changes.labels) changes.labels[label] += count;
+        for (const auto &[property, count] : index_stats_changes.properties) changes.properties[property] += count;
+      });
+    }
+
+    if (mem_storage->config_.durability.wal_group_commit) {
+      mem_storage->WaitForWalSync(wal_written_transactions);
+    }
   }
 
   is_transaction_active_ = false;
@@ -720,6 +1122,14 @@ utils::BasicResult<StorageDataManipulationError, void> InMemoryStorage::InMemory
 void InMemoryStorage::InMemoryAccessor::Abort() {
   MG_ASSERT(is_transaction_active_, "The transaction is already terminated!");
 
+  // There is nothing to undo or to hand over to the GC.
+  if (transaction_.read_only_snapshot) {
+    MG_ASSERT(transaction_.deltas.empty(), "A read-only transaction can't change the graph!");
+    static_cast<InMemoryStorage *>(storage_)->read_only_transactions_.Finish(*transaction_.read_only_snapshot);
+    is_transaction_active_ = false;
+    return;
+  }
+
   // We collect vertices and edges we've created here and then splice them into
   // `deleted_vertices_` and `deleted_edges_` lists, instead of adding them one
   // by one and acquiring lock every time.
@@ -731,7 +1141,7 @@ void InMemoryStorage::InMemoryAccessor::Abort() {
     switch (prev.type) {
       case PreviousPtr::Type::VERTEX: {
         auto *vertex = prev.vertex;
-        std::lock_guard<utils::SpinLock> guard(vertex->lock);
+        std::lock_guard guard(vertex->lock);
         Delta *current = vertex->delta;
         while (current != nullptr && current->timestamp->load(std::memory_order_acquire) ==
                                          transaction_.transaction_id.load(std::memory_order_acquire)) {
@@ -756,16 +1166,14 @@ void InMemoryStorage::InMemoryAccessor::Abort() {
             case Delta::Action::ADD_IN_EDGE: {
               std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{current->vertex_edge.edge_type,
                                                              current->vertex_edge.vertex, current->vertex_edge.edge};
-              auto it = std::find(vertex->in_edges.begin(), vertex->in_edges.end(), link);
-              MG_ASSERT(it == vertex->in_edges.end(), "Invalid database state!");
+              MG_ASSERT(!vertex->in_edges.contains(link), "Invalid database state!");
               vertex->in_edges.push_back(link);
               break;
             }
             case Delta::Action::ADD_OUT_EDGE: {
               std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{current->vertex_edge.edge_type,
                                                              current->vertex_edge.vertex, current->vertex_edge.edge};
-              auto it = std::find(vertex->out_edges.begin(), vertex->out_edges.end(), link);
-              MG_ASSERT(it == vertex->out_edges.end(), "Invalid database state!");
+              MG_ASSERT(!vertex->out_edges.contains(link), "Invalid database state!");
               vertex->out_edges.push_back(link);
               // Increment edge count. We only increment the count here because
               // the information in `ADD_IN_EDGE` and `Edge/RECREATE_OBJECT` is
@@ -777,19 +1185,26 @@ void InMemoryStorage::InMemoryAccessor::Abort() {
             case Delta::Action::REMOVE_IN_EDGE: {
               std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{current->vertex_edge.edge_type,
                                                              current->vertex_edge.vertex, current->vertex_edge.edge};
-              auto it = std::find(vertex->in_edges.begin(), vertex->in_edges.end(), link);
-              MG_ASSERT(it != vertex->in_edges.end(), "Invalid database state!");
-              std::swap(*it, *vertex->in_edges.rbegin());
-              vertex->in_edges.pop_back();
+              bool const removed = vertex->in_edges.erase(link);
+              MG_ASSERT(removed, "Invalid database state!");
               break;
             }
             case Delta::Action::REMOVE_OUT_EDGE: {
               std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{current->vertex_edge.edge_type,
                                                              current->vertex_edge.vertex, current->vertex_edge.edge};
-              auto it = std::find(vertex->out_edges.begin(), vertex->out_edges.end(), link);
-              MG_ASSERT(it != vertex->out_edges.end(), "Invalid database state!");
-              std::swap(*it, *vertex->out_edges.rbegin());
-              vertex->out_edges.pop_back();
+              bool const removed = vertex->out_edges.erase(link);
+              MG_ASSERT(removed, "Invalid database state!");
+              if (transaction_.edges) {
+                // The object that the light edge got when a property was set
+                // on it is deleted together with the edge.
+                auto edge_acc = transaction_.edges->access();
+                auto edge = edge_acc.find(current->vertex_edge.edge.gid);
+                if (edge != edge_acc.end()) {
+                  std::lock_guard edge_guard(edge->lock);
+                  edge->deleted = true;
+                  my_deleted_edges.push_back(edge->gid);
+                }
+              }
               // Decrement edge count. We only decrement the count here because
               // the information in `REMOVE_IN_EDGE` and `Edge/DELETE_OBJECT` is
               // redundant. Also, `Edge/DELETE_OBJECT` isn't available when edge
@@ -819,7 +1234,7 @@ void InMemoryStorage::InMemoryAccessor::Abort() {
       }
       case PreviousPtr::Type::EDGE: {
         auto *edge = prev.edge;
-        std::lock_guard<utils::SpinLock> guard(edge->lock);
+        std::lock_guard guard(edge->lock);
         Delta *current = edge->delta;
         while (current != nullptr && current->timestamp->load(std::memory_order_acquire) ==
                                          transaction_.transaction_id.load(std::memory_order_acquire)) {
@@ -866,7 +1281,7 @@ void InMemoryStorage::InMemoryAccessor::Abort() {
 
   auto *mem_storage = static_cast<InMemoryStorage *>(storage_);
   {
-    std::unique_lock<utils::SpinLock> engine_guard(storage_->engine_lock_);
+    std::unique_lock engine_guard(storage_->engine_lock_);
     uint64_t mark_timestamp = storage_->timestamp_;
     // Take garbage_undo_buffers lock while holding the engine lock to make
     // sure that entries are sorted by mark timestamp in the list.
@@ -890,17 +1305,58 @@ void InMemoryStorage::InMemoryAccessor::FinalizeTransaction() {
   if (commit_timestamp_) {
     auto *mem_storage = static_cast<InMemoryStorage *>(storage_);
     mem_storage->commit_log_->MarkFinished(*commit_timestamp_);
-    mem_storage->committed_transactions_.WithLock(
+    mem_storage->gc_pending_deltas_.fetch_add(transaction_.deltas.size(), std::memory_order_acq_rel);
+    mem_storage->deltas_since_snapshot_.fetch_add(transaction_.deltas.size(), std::memory_order_acq_rel);
+    // Threads are assigned to the shards round-robin.
+    static std::atomic<size_t> next_shard{0};
+    thread_local size_t const shard = next_shard.fetch_add(1, std::memory_order_relaxed) % kCommittedTransactionsShards;
+    mem_storage->committed_transactions_[shard].WithLock(
         [&](auto &committed_transactions) { committed_transactions.emplace_back(std::move(transaction_)); });
     commit_timestamp_.reset();
   }
 }
 
+utils::BasicResult<StorageDataManipulationError, void> InMemoryStorage::InMemoryAccessor::PeriodicCommit() {
+  auto result = Commit();
+  FinalizeTransaction();
+
+  // The accessors point to the transaction object, so the new transaction is
+  // constructed in place of the committed one.
+  const auto isolation_level = transaction_.isolation_level;
+  const auto storage_mode = transaction_.storage_mode;
+  std::destroy_at(&transaction_);
+  std::construct_at(&transaction_, storage_->CreateTransaction(isolation_level, storage_mode));
+  commit_timestamp_.reset();
+  is_transaction_active_ = true;
+  return result;
+}
+
+uint64_t InMemoryStorage::IndexCreationThreadCount() const {
+  return config_.durability.allow_parallel_index_creation ? config_.durability.recovery_thread_count : 1;
+}
+
 utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::CreateIndex(
     LabelId label, const std::optional<uint64_t> desired_commit_timestamp) {
-  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
   auto *mem_label_index = static_cast<InMemoryLabelIndex *>(indices_.label_index_.get());
-  if (!mem_label_index->CreateIndex(label, vertices_.access(), std::nullopt)) {
+  {
+    std::unique_lock<MainLock> storage_guard(main_lock_);
+    if (!mem_label_index->RegisterIndex(label)) {
+      return StorageIndexDefinitionError{IndexDefinitionError{}};
+    }
+  }
+  try {
+    // The accessor keeps the deltas of the running transactions alive while the
+    // index is populated, the later changes are indexed by the update hooks.
+    auto acc = Access(std::nullopt);
+    mem_label_index->PopulateIndex(label, vertices_.access(), IndexCreationThreadCount());
+  } catch (const utils::OutOfMemoryException &) {
+    utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+    std::unique_lock<MainLock> storage_guard(main_lock_);
+    mem_label_index->DropPendingIndex(label);
+    throw;
+  }
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  if (!mem_label_index->PublishIndex(label)) {
     return StorageIndexDefinitionError{IndexDefinitionError{}};
   }
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
@@ -921,9 +1377,24 @@ utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::CreateInd
 
 utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::CreateIndex(
     LabelId label, PropertyId property, const std::optional<uint64_t> desired_commit_timestamp) {
-  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
   auto *mem_label_property_index = static_cast<InMemoryLabelPropertyIndex *>(indices_.label_property_index_.get());
-  if (!mem_label_property_index->CreateIndex(label, property, vertices_.access(), std::nullopt)) {
+  {
+    std::unique_lock<MainLock> storage_guard(main_lock_);
+    if (!mem_label_property_index->RegisterIndex(label, property)) {
+      return StorageIndexDefinitionError{IndexDefinitionError{}};
+    }
+  }
+  try {
+    auto acc = Access(std::nullopt);
+    mem_label_property_index->PopulateIndex(label, property, vertices_.access(), IndexCreationThreadCount());
+  } catch (const utils::OutOfMemoryException &) {
+    utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+    std::unique_lock<MainLock> storage_guard(main_lock_);
+    mem_label_property_index->DropPendingIndex(label, property);
+    throw;
+  }
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  if (!mem_label_property_index->PublishIndex(label, property)) {
     return StorageIndexDefinitionError{IndexDefinitionError{}};
   }
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
@@ -942,9 +1413,33 @@ utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::CreateInd
   return StorageIndexDefinitionError{ReplicationError{}};
 }
 
+utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::CreateIndex(
+    LabelId label, const std::vector<PropertyId> &properties, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  auto *mem_label_property_composite_index =
+      static_cast<InMemoryLabelPropertyCompositeIndex *>(indices_.label_property_composite_index_.get());
+  if (!mem_label_property_composite_index->CreateIndex(label, properties, vertices_.access())) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
+  }
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE,
+                                           label, properties, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  replication_state_.last_commit_timestamp_ = commit_timestamp;
+
+  // We don't care if there is a replication error because on main node the change will go through
+  memgraph::metrics::IncrementCounter(memgraph::metrics::ActiveLabelPropertyIndices);
+
+  if (success) {
+    return {};
+  }
+
+  return StorageIndexDefinitionError{ReplicationError{}};
+}
+
 utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::DropIndex(
     LabelId label, const std::optional<uint64_t> desired_commit_timestamp) {
-  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  std::unique_lock<MainLock> storage_guard(main_lock_);
   if (!indices_.label_index_->DropIndex(label)) {
     return StorageIndexDefinitionError{IndexDefinitionError{}};
   }
@@ -966,7 +1461,7 @@ utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::DropIndex
 
 utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::DropIndex(
     LabelId label, PropertyId property, const std::optional<uint64_t> desired_commit_timestamp) {
-  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  std::unique_lock<MainLock> storage_guard(main_lock_);
   if (!indices_.label_property_index_->DropIndex(label, property)) {
     return StorageIndexDefinitionError{IndexDefinitionError{}};
   }
@@ -988,105 +1483,337 @@ utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::DropIndex
   return StorageIndexDefinitionError{ReplicationError{}};
 }
 
-utils::BasicResult<StorageExistenceConstraintDefinitionError, void> InMemoryStorage::CreateExistenceConstraint(
-    LabelId label, PropertyId property, const std::optional<uint64_t> desired_commit_timestamp) {
-  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::DropIndex(
+    LabelId label, const std::vector<PropertyId> &properties, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  if (!indices_.label_property_composite_index_->DropIndex(label, properties)) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
+  }
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_DROP,
+                                           label, properties, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  replication_state_.last_commit_timestamp_ = commit_timestamp;
 
-  if (constraints_.existence_constraints_->ConstraintExists(label, property)) {
-    return StorageExistenceConstraintDefinitionError{ConstraintDefinitionError{}};
+  // We don't care if there is a replication error because on main node the change will go through
+  memgraph::metrics::DecrementCounter(memgraph::metrics::ActiveLabelPropertyIndices);
+
+  if (success) {
+    return {};
   }
 
-  if (auto violation = ExistenceConstraints::ValidateVerticesOnConstraint(vertices_.access(), label, property);
-      violation.has_value()) {
-    return StorageExistenceConstraintDefinitionError{violation.value()};
+  return StorageIndexDefinitionError{ReplicationError{}};
+}
+
+utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::CreateIndex(EdgeTypeId edge_type) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  auto *mem_edge_type_index = static_cast<InMemoryEdgeTypeIndex *>(indices_.edge_type_index_.get());
+  if (!mem_edge_type_index->CreateIndex(edge_type, vertices_.access())) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
   }
+  return {};
+}
 
-  constraints_.existence_constraints_->InsertConstraint(label, property);
+utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::CreateIndex(EdgeTypeId edge_type,
+                                                                                   PropertyId property) {
+  if (!config_.items.EdgeRefsArePointers()) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
+  }
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  auto *mem_edge_type_property_index =
+      static_cast<InMemoryEdgeTypePropertyIndex *>(indices_.edge_type_property_index_.get());
+  if (!mem_edge_type_property_index->CreateIndex(edge_type, property, vertices_.access())) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
+  }
+  return {};
+}
+
+utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::DropIndex(EdgeTypeId edge_type) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  if (!indices_.edge_type_index_->DropIndex(edge_type)) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
+  }
+  return {};
+}
+
+utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::DropIndex(EdgeTypeId edge_type,
+                                                                                 PropertyId property) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  if (!indices_.edge_type_property_index_->DropIndex(edge_type, property)) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
+  }
+  return {};
+}
 
+utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::CreateTextIndex(
+    LabelId label, PropertyId property, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  auto *mem_text_index = static_cast<InMemoryTextIndex *>(indices_.text_index_.get());
+  if (!mem_text_index->CreateIndex(label, property, vertices_.access())) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
+  }
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
-  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::EXISTENCE_CONSTRAINT_CREATE, label,
-                                           {property}, commit_timestamp);
+  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::TEXT_INDEX_CREATE, label, {property},
+                                           commit_timestamp);
   commit_log_->MarkFinished(commit_timestamp);
   replication_state_.last_commit_timestamp_ = commit_timestamp;
 
+  // We don't care if there is a replication error because on main node the change will go through
   if (success) {
     return {};
   }
 
-  return StorageExistenceConstraintDefinitionError{ReplicationError{}};
+  return StorageIndexDefinitionError{ReplicationError{}};
 }
 
-utils::BasicResult<StorageExistenceConstraintDroppingError, void> InMemoryStorage::DropExistenceConstraint(
+utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::DropTextIndex(
     LabelId label, PropertyId property, const std::optional<uint64_t> desired_commit_timestamp) {
-  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
-  if (!constraints_.existence_constraints_->DropConstraint(label, property)) {
-    return StorageExistenceConstraintDroppingError{ConstraintDefinitionError{}};
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  if (!indices_.text_index_->DropIndex(label, property)) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
   }
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
-  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::EXISTENCE_CONSTRAINT_DROP, label,
-                                           {property}, commit_timestamp);
+  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::TEXT_INDEX_DROP, label, {property},
+                                           commit_timestamp);
   commit_log_->MarkFinished(commit_timestamp);
   replication_state_.last_commit_timestamp_ = commit_timestamp;
 
+  // We don't care if there is a replication error because on main node the change will go through
   if (success) {
     return {};
   }
 
-  return StorageExistenceConstraintDroppingError{ReplicationError{}};
+  return StorageIndexDefinitionError{ReplicationError{}};
 }
 
-utils::BasicResult<StorageUniqueConstraintDefinitionError, UniqueConstraints::CreationStatus>
-InMemoryStorage::CreateUniqueConstraint(LabelId label, const std::set<PropertyId> &properties,
-                                        const std::optional<uint64_t> desired_commit_timestamp) {
-  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
-  auto *mem_unique_constraints = static_cast<InMemoryUniqueConstraints *>(constraints_.unique_constraints_.get());
-  auto ret = mem_unique_constraints->CreateConstraint(label, properties, vertices_.access());
-  if (ret.HasError()) {
-    return StorageUniqueConstraintDefinitionError{ret.GetError()};
-  }
-  if (ret.GetValue() != UniqueConstraints::CreationStatus::SUCCESS) {
-    return ret.GetValue();
+utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::CreateVectorIndex(
+    LabelId label, PropertyId property, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  auto *mem_vector_index = static_cast<InMemoryVectorIndex *>(indices_.vector_index_.get());
+  if (!mem_vector_index->CreateIndex(label, property, vertices_.access())) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
   }
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
-  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::UNIQUE_CONSTRAINT_CREATE, label,
-                                           properties, commit_timestamp);
+  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::VECTOR_INDEX_CREATE, label, {property},
+                                           commit_timestamp);
   commit_log_->MarkFinished(commit_timestamp);
   replication_state_.last_commit_timestamp_ = commit_timestamp;
 
+  // We don't care if there is a replication error because on main node the change will go through
   if (success) {
-    return UniqueConstraints::CreationStatus::SUCCESS;
+    return {};
   }
 
-  return StorageUniqueConstraintDefinitionError{ReplicationError{}};
+  return StorageIndexDefinitionError{ReplicationError{}};
 }
 
-utils::BasicResult<StorageUniqueConstraintDroppingError, UniqueConstraints::DeletionStatus>
-InMemoryStorage::DropUniqueConstraint(LabelId label, const std::set<PropertyId> &properties,
-                                      const std::optional<uint64_t> desired_commit_timestamp) {
-  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
-  auto ret = constraints_.unique_constraints_->DropConstraint(label, properties);
-  if (ret != UniqueConstraints::DeletionStatus::SUCCESS) {
-    return ret;
+utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::DropVectorIndex(
+    LabelId label, PropertyId property, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  if (!indices_.vector_index_->DropIndex(label, property)) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
   }
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
-  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP, label,
-                                           properties, commit_timestamp);
+  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::VECTOR_INDEX_DROP, label, {property},
+                                           commit_timestamp);
   commit_log_->MarkFinished(commit_timestamp);
   replication_state_.last_commit_timestamp_ = commit_timestamp;
 
+  // We don't care if there is a replication error because on main node the change will go through
   if (success) {
-    return UniqueConstraints::DeletionStatus::SUCCESS;
+    return {};
   }
 
-  return StorageUniqueConstraintDroppingError{ReplicationError{}};
+  return StorageIndexDefinitionError{ReplicationError{}};
 }
 
-VerticesIterable InMemoryStorage::InMemoryAccessor::Vertices(LabelId label, View view) {
-  auto *mem_label_index = static_cast<InMemoryLabelIndex *>(storage_->indices_.label_index_.get());
-  return VerticesIterable(mem_label_index->Vertices(label, view, &transaction_));
+utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::CreateAggregateIndex(
+    LabelId label, PropertyId group_property, PropertyId value_property,
+    const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  auto *mem_aggregate_index = static_cast<InMemoryAggregateIndex *>(indices_.aggregate_index_.get());
+  if (!mem_aggregate_index->CreateIndex({label, group_property, value_property}, vertices_.access())) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
+  }
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::AGGREGATE_INDEX_CREATE, label,
+                                           {group_property, value_property}, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  replication_state_.last_commit_timestamp_ = commit_timestamp;
+
+  // We don't care if there is a replication error because on main node the change will go through
+  if (success) {
+    return {};
+  }
+
+  return StorageIndexDefinitionError{ReplicationError{}};
 }
 
-VerticesIterable InMemoryStorage::InMemoryAccessor::Vertices(LabelId label, PropertyId property, View view) {
+utils::BasicResult<StorageIndexDefinitionError, void> InMemoryStorage::DropAggregateIndex(
+    LabelId label, PropertyId group_property, PropertyId value_property,
+    const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  if (!indices_.aggregate_index_->DropIndex({label, group_property, value_property})) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
+  }
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::AGGREGATE_INDEX_DROP, label,
+                                           {group_property, value_property}, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  replication_state_.last_commit_timestamp_ = commit_timestamp;
+
+  // We don't care if there is a replication error because on main node the change will go through
+  if (success) {
+    return {};
+  }
+
+  return StorageIndexDefinitionError{ReplicationError{}};
+}
+
+utils::BasicResult<StorageExistenceConstraintDefinitionError, void> InMemoryStorage::CreateExistenceConstraint(
+    LabelId label, PropertyId property, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+
+  if (constraints_.existence_constraints_->ConstraintExists(label, property)) {
+    return StorageExistenceConstraintDefinitionError{ConstraintDefinitionError{}};
+  }
+
+  if (auto violation = ExistenceConstraints::ValidateVerticesOnConstraint(vertices_.access(), label, property);
+      violation.has_value()) {
+    return StorageExistenceConstraintDefinitionError{violation.value()};
+  }
+
+  constraints_.existence_constraints_->InsertConstraint(label, property);
+
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::EXISTENCE_CONSTRAINT_CREATE, label,
+                                           {property}, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  replication_state_.last_commit_timestamp_ = commit_timestamp;
+
+  if (success) {
+    return {};
+  }
+
+  return StorageExistenceConstraintDefinitionError{ReplicationError{}};
+}
+
+utils::BasicResult<StorageExistenceConstraintDroppingError, void> InMemoryStorage::DropExistenceConstraint(
+    LabelId label, PropertyId property, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  if (!constraints_.existence_constraints_->DropConstraint(label, property)) {
+    return StorageExistenceConstraintDroppingError{ConstraintDefinitionError{}};
+  }
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::EXISTENCE_CONSTRAINT_DROP, label,
+                                           {property}, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  replication_state_.last_commit_timestamp_ = commit_timestamp;
+
+  if (success) {
+    return {};
+  }
+
+  return StorageExistenceConstraintDroppingError{ReplicationError{}};
+}
+
+utils::BasicResult<StorageUniqueConstraintDefinitionError, UniqueConstraints::CreationStatus>
+InMemoryStorage::CreateUniqueConstraint(LabelId label, const std::set<PropertyId> &properties,
+                                        const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  auto *mem_unique_constraints = static_cast<InMemoryUniqueConstraints *>(constraints_.unique_constraints_.get());
+  auto ret = mem_unique_constraints->CreateConstraint(label, properties, vertices_.access());
+  if (ret.HasError()) {
+    return StorageUniqueConstraintDefinitionError{ret.GetError()};
+  }
+  if (ret.GetValue() != UniqueConstraints::CreationStatus::SUCCESS) {
+    return ret.GetValue();
+  }
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::UNIQUE_CONSTRAINT_CREATE, label,
+                                           {properties.begin(), properties.end()}, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  replication_state_.last_commit_timestamp_ = commit_timestamp;
+
+  if (success) {
+    return UniqueConstraints::CreationStatus::SUCCESS;
+  }
+
+  return StorageUniqueConstraintDefinitionError{ReplicationError{}};
+}
+
+utils::BasicResult<StorageUniqueConstraintDroppingError, UniqueConstraints::DeletionStatus>
+InMemoryStorage::DropUniqueConstraint(LabelId label, const std::set<PropertyId> &properties,
+                                      const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<MainLock> storage_guard(main_lock_);
+  auto ret = constraints_.unique_constraints_->DropConstraint(label, properties);
+  if (ret != UniqueConstraints::DeletionStatus::SUCCESS) {
+    return ret;
+  }
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP, label,
+                                           {properties.begin(), properties.end()}, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  replication_state_.last_commit_timestamp_ = commit_timestamp;
+
+  if (success) {
+    return UniqueConstraints::DeletionStatus::SUCCESS;
+  }
+
+  return StorageUniqueConstraintDroppingError{ReplicationError{}};
+}
+
+std::vector<VerticesIterable> InMemoryStorage::InMemoryAccessor::PartitionVertices(View view,
+                                                                                  uint64_t max_partitions) {
+  auto *mem_storage = static_cast<InMemoryStorage *>(storage_);
+  std::vector<Gid> split_gids;
+  {
+    auto vertices_acc = mem_storage->vertices_.access();
+    for (auto it : vertices_acc.partition_points(max_partitions)) split_gids.push_back(it->gid);
+  }
+
+  std::vector<VerticesIterable> partitions;
+  partitions.reserve(split_gids.size() + 1);
+  std::optional<Gid> lower_bound;
+  for (size_t i = 0; i <= split_gids.size(); ++i) {
+    auto upper_bound = i < split_gids.size() ? std::optional<Gid>(split_gids[i]) : std::nullopt;
+    partitions.emplace_back(AllVerticesIterable(mem_storage->vertices_.access(), &transaction_, view,
+                                                &mem_storage->indices_, &mem_storage->constraints_,
+                                                mem_storage->config_.items, lower_bound, upper_bound));
+    lower_bound = upper_bound;
+  }
+  return partitions;
+}
+
+std::vector<VerticesIterable> InMemoryStorage::InMemoryAccessor::PartitionVertices(LabelId label, View view,
+                                                                                  uint64_t max_partitions) {
+  auto *mem_label_index = static_cast<InMemoryLabelIndex *>(storage_->indices_.label_index_.get());
+  auto index_partitions = mem_label_index->PartitionVertices(label, view, &transaction_, max_partitions);
+  std::vector<VerticesIterable> partitions;
+  partitions.reserve(index_partitions.size());
+  for (auto &partition : index_partitions) partitions.emplace_back(std::move(partition));
+  return partitions;
+}
+
+VerticesIterable InMemoryStorage::InMemoryAccessor::Vertices(LabelId label, View view) {
+  auto *mem_label_index = static_cast<InMemoryLabelIndex *>(storage_->indices_.label_index_.get());
+  return VerticesIterable(mem_label_index->Vertices(label, view, &transaction_));
+}
+
+VerticesIterable InMemoryStorage::InMemoryAccessor::Vertices(LabelId label, const std::vector<LabelId> &filter_labels,
+                                                             View view) {
+  auto *mem_label_index = static_cast<InMemoryLabelIndex *>(storage_->indices_.label_index_.get());
+  return VerticesIterable(mem_label_index->Vertices(label, filter_labels, view, &transaction_));
+}
+
+VerticesIterable InMemoryStorage::InMemoryAccessor::Vertices(
+    LabelId label, const std::vector<LabelId> &filter_labels,
+    const std::vector<std::pair<PropertyId, PropertyValue>> &filter_properties, View view) {
+  auto *mem_label_index = static_cast<InMemoryLabelIndex *>(storage_->indices_.label_index_.get());
+  return VerticesIterable(mem_label_index->Vertices(label, filter_labels, filter_properties, view, &transaction_));
+}
+
+VerticesIterable InMemoryStorage::InMemoryAccessor::Vertices(LabelId label, PropertyId property, View view) {
   auto *mem_label_property_index =
       static_cast<InMemoryLabelPropertyIndex *>(storage_->indices_.label_property_index_.get());
   return VerticesIterable(
@@ -1101,6 +1828,13 @@ VerticesIterable InMemoryStorage::InMemoryAccessor::Vertices(LabelId label, Prop
                                                              utils::MakeBoundInclusive(value), view, &transaction_));
 }
 
+VerticesIterable InMemoryStorage::InMemoryAccessor::Vertices(LabelId label, PropertyId property,
+                                                             const std::vector<PropertyValue> &values, View view) {
+  auto *mem_label_property_index =
+      static_cast<InMemoryLabelPropertyIndex *>(storage_->indices_.label_property_index_.get());
+  return VerticesIterable(mem_label_property_index->Vertices(label, property, values, view, &transaction_));
+}
+
 VerticesIterable InMemoryStorage::InMemoryAccessor::Vertices(
     LabelId label, PropertyId property, const std::optional<utils::Bound<PropertyValue>> &lower_bound,
     const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view) {
@@ -1110,15 +1844,76 @@ VerticesIterable InMemoryStorage::InMemoryAccessor::Vertices(
       mem_label_property_index->Vertices(label, property, lower_bound, upper_bound, view, &transaction_));
 }
 
+VerticesIterable InMemoryStorage::InMemoryAccessor::Vertices(
+    LabelId label, const std::vector<PropertyId> &properties, const std::vector<PropertyValue> &prefix,
+    const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+    const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view) {
+  auto *mem_label_property_composite_index =
+      static_cast<InMemoryLabelPropertyCompositeIndex *>(storage_->indices_.label_property_composite_index_.get());
+  return VerticesIterable(mem_label_property_composite_index->Vertices(label, properties, prefix, lower_bound,
+                                                                       upper_bound, view, &transaction_));
+}
+
+EdgesIterable InMemoryStorage::InMemoryAccessor::Edges(EdgeTypeId edge_type, View view) {
+  auto *mem_edge_type_index = static_cast<InMemoryEdgeTypeIndex *>(storage_->indices_.edge_type_index_.get());
+  return EdgesIterable(mem_edge_type_index->Edges(edge_type, view, &transaction_));
+}
+
+EdgesIterable InMemoryStorage::InMemoryAccessor::Edges(EdgeTypeId edge_type, PropertyId property,
+                                                       const PropertyValue &value, View view) {
+  auto *mem_edge_type_property_index =
+      static_cast<InMemoryEdgeTypePropertyIndex *>(storage_->indices_.edge_type_property_index_.get());
+  return EdgesIterable(mem_edge_type_property_index->Edges(edge_type, property, utils::MakeBoundInclusive(value),
+                                                           utils::MakeBoundInclusive(value), view, &transaction_));
+}
+
+EdgesIterable InMemoryStorage::InMemoryAccessor::Edges(EdgeTypeId edge_type, PropertyId property,
+                                                       const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+                                                       const std::optional<utils::Bound<PropertyValue>> &upper_bound,
+                                                       View view) {
+  auto *mem_edge_type_property_index =
+      static_cast<InMemoryEdgeTypePropertyIndex *>(storage_->indices_.edge_type_property_index_.get());
+  return EdgesIterable(
+      mem_edge_type_property_index->Edges(edge_type, property, lower_bound, upper_bound, view, &transaction_));
+}
+
+std::vector<TextSearchResult> InMemoryStorage::InMemoryAccessor::TextSearch(LabelId label, PropertyId property,
+                                                                            std::string_view query, uint64_t limit,
+                                                                            View view) {
+  auto *mem_text_index = static_cast<InMemoryTextIndex *>(storage_->indices_.text_index_.get());
+  return mem_text_index->Search(label, property, query, limit, view, &transaction_);
+}
+
+std::optional<std::vector<VectorSearchResult>> InMemoryStorage::InMemoryAccessor::VectorSearch(
+    LabelId label, PropertyId property, std::span<const float> query, uint64_t k, View view) {
+  auto *mem_vector_index = static_cast<InMemoryVectorIndex *>(storage_->indices_.vector_index_.get());
+  return mem_vector_index->Search(label, property, query, k, view, &transaction_);
+}
+
+std::optional<std::vector<AggregateGroup>> InMemoryStorage::InMemoryAccessor::AggregateIndexLookup(
+    LabelId label, PropertyId group_property, PropertyId value_property) {
+  auto *mem_aggregate_index = static_cast<InMemoryAggregateIndex *>(storage_->indices_.aggregate_index_.get());
+  return mem_aggregate_index->Lookup({label, group_property, value_property}, transaction_);
+}
+
 Transaction InMemoryStorage::CreateTransaction(IsolationLevel isolation_level, StorageMode storage_mode) {
   // We acquire the transaction engine lock here because we access (and
   // modify) the transaction engine variables (`transaction_id` and
   // `timestamp`) below.
   uint64_t transaction_id = 0;
   uint64_t start_timestamp = 0;
+  uint64_t graph_version = 0;
   {
-    std::lock_guard<utils::SpinLock> guard(engine_lock_);
+    std::lock_guard guard(engine_lock_);
     transaction_id = transaction_id_++;
+    // Changes made in the analytical mode are visible right away, so any such
+    // transaction may change the graph.
+    if (storage_mode == StorageMode::IN_MEMORY_ANALYTICAL) {
+      graph_version_ = NewGraphVersion();
+      if (graph_changes_.IsEnabled()) graph_changes_.RecordAll(graph_version_);
+      read_only_transactions_.Publish(read_only_transactions_.PublishedStartTimestamp(), graph_version_);
+    }
+    graph_version = graph_version_;
     // Replica should have only read queries and the write queries
     // can come from main instance with any past timestamp.
     // To preserve snapshot isolation we set the start timestamp
@@ -1131,11 +1926,160 @@ Transaction InMemoryStorage::CreateTransaction(IsolationLevel isolation_level, S
       start_timestamp = timestamp_++;
     }
   }
-  return {transaction_id, start_timestamp, isolation_level, storage_mode};
+  Transaction transaction{transaction_id, start_timestamp, isolation_level, storage_mode};
+  transaction.graph_version = graph_version;
+  transaction.long_delta_chains = &long_delta_chains_;
+  if (storage_mode == StorageMode::IN_MEMORY_ANALYTICAL) transaction.property_columns = &property_columns_;
+  if (config_.items.properties_on_edges && config_.items.light_edges) transaction.edges = &edges_;
+  return transaction;
+}
+
+Transaction InMemoryStorage::CreateReadOnlyTransaction(IsolationLevel isolation_level, StorageMode storage_mode) {
+  MG_ASSERT(isolation_level == IsolationLevel::SNAPSHOT_ISOLATION &&
+                storage_mode == StorageMode::IN_MEMORY_TRANSACTIONAL,
+            "Read-only transactions are only supported for the snapshot isolation in the transactional mode!");
+  const auto snapshot = read_only_transactions_.Start();
+  Transaction transaction{transaction_id_++, snapshot.start_timestamp, isolation_level, storage_mode};
+  transaction.graph_version = snapshot.graph_version;
+  transaction.long_delta_chains = &long_delta_chains_;
+  if (config_.items.properties_on_edges && config_.items.light_edges) transaction.edges = &edges_;
+  transaction.read_only_snapshot = snapshot;
+  return transaction;
 }
 
+namespace {
+
+// When unlinking a delta which is the first delta in its version chain,
+// special care has to be taken to avoid the following race condition:
+//
+// [Vertex] --> [Delta A]
+//
+//    GC thread: Delta A is the first in its chain, it must be unlinked from
+//               vertex and marked for deletion
+//    TX thread: Update vertex and add Delta B with Delta A as next
+//
+// [Vertex] --> [Delta B] <--> [Delta A]
+//
+//    GC thread: Unlink delta from Vertex
+//
+// [Vertex] --> (nullptr)
+//
+// When processing a delta that is the first one in its chain, we
+// obtain the corresponding vertex or edge lock, and then verify that this
+// delta still is the first in its chain.
+// When processing a delta that is in the middle of the chain we only
+// process the final delta of the given transaction in that chain. We
+// determine the owner of the chain (either a vertex or an edge), obtain the
+// corresponding lock, and then verify that this delta is still in the same
+// position as it was before taking the lock.
+//
+// Even though the delta chain is lock-free (both `next` and `prev`) the
+// chain should not be modified without taking the lock from the object that
+// owns the chain (either a vertex or an edge). Modifying the chain without
+// taking the lock will cause subtle race conditions that will leave the
+// chain in a broken state.
+// The chain can be only read without taking any locks.
+//
+// Vertices and edges whose deletion became final are appended to
+// `deleted_vertices` and `deleted_edges`.
+void UnlinkDelta(Delta &delta, uint64_t commit_timestamp, std::list<Gid> *deleted_vertices,
+                 std::list<Gid> *deleted_edges) {
+  while (true) {
+    auto prev = delta.prev.Get();
+    switch (prev.type) {
+      case PreviousPtr::Type::VERTEX: {
+        Vertex *vertex = prev.vertex;
+        std::lock_guard vertex_guard(vertex->lock);
+        if (vertex->delta != &delta) {
+          // Something changed, we're not the first delta in the chain
+          // anymore.
+          continue;
+        }
+        vertex->delta = nullptr;
+        if (vertex->deleted) {
+          deleted_vertices->push_back(vertex->gid);
+        }
+        break;
+      }
+      case PreviousPtr::Type::EDGE: {
+        Edge *edge = prev.edge;
+        std::lock_guard edge_guard(edge->lock);
+        if (edge->delta != &delta) {
+          // Something changed, we're not the first delta in the chain
+          // anymore.
+          continue;
+        }
+        edge->delta = nullptr;
+        if (edge->deleted) {
+          deleted_edges->push_back(edge->gid);
+        }
+        break;
+      }
+      case PreviousPtr::Type::DELTA: {
+        if (prev.delta->timestamp->load(std::memory_order_acquire) == commit_timestamp) {
+          // The delta that is newer than this one is also a delta from this
+          // transaction. We skip the current delta and will remove it as a
+          // part of the suffix later.
+          break;
+        }
+        std::unique_lock<ObjectLock> guard;
+        {
+          // We need to find the parent object in order to be able to use
+          // its lock.
+          auto parent = prev;
+          while (parent.type == PreviousPtr::Type::DELTA) {
+            parent = parent.delta->prev.Get();
+          }
+          switch (parent.type) {
+            case PreviousPtr::Type::VERTEX:
+              guard = std::unique_lock(parent.vertex->lock);
+              break;
+            case PreviousPtr::Type::EDGE:
+              guard = std::unique_lock(parent.edge->lock);
+              break;
+            case PreviousPtr::Type::DELTA:
+            case PreviousPtr::Type::NULLPTR:
+              LOG_FATAL("Invalid database state!");
+          }
+        }
+        if (delta.prev.Get() != prev) {
+          // Something changed, we could now be the first delta in the
+          // chain.
+          continue;
+        }
+        Delta *prev_delta = prev.delta;
+        prev_delta->next.store(nullptr, std::memory_order_release);
+        break;
+      }
+      case PreviousPtr::Type::NULLPTR: {
+        LOG_FATAL("Invalid pointer!");
+      }
+    }
+    break;
+  }
+}
+
+// Removes the objects that are deleted and have no deltas, which are left
+// behind by IN_MEMORY_ANALYTICAL deletions, starting from the object with the
+// `from` gid. Returns the gid at which the scan should be resumed if it
+// stopped after scanning `max_objects` objects.
+template <typename TObjects>
+std::optional<Gid> RemoveDeletedWithoutDeltas(TObjects &objects, Gid from, uint64_t max_objects) {
+  auto acc = objects.access();
+  uint64_t scanned = 0;
+  for (auto it = acc.find_equal_or_greater(from); it != acc.end(); ++it) {
+    if (scanned++ == max_objects) return it->gid;
+    if (it->delta == nullptr && it->deleted) {
+      acc.remove(*it);
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
 template <bool force>
-void InMemoryStorage::CollectGarbage(std::unique_lock<utils::RWLock> main_guard) {
+void InMemoryStorage::CollectGarbage(std::unique_lock<MainLock> main_guard) {
   // NOTE: You do not need to consider cleanup of deleted object that occurred in
   // different storage modes within the same CollectGarbage call. This is because
   // SetStorageMode will ensure CollectGarbage is called before any new transactions
@@ -1185,12 +2129,31 @@ void InMemoryStorage::CollectGarbage(std::unique_lock<utils::RWLock> main_guard)
   if (!gc_guard.owns_lock()) {
     return;
   }
-
-  uint64_t oldest_active_start_timestamp = commit_log_->OldestActive();
+  utils::Timer timer;
+
+  // The read-only transactions must be checked after the commit log, see
+  // `ReadOnlyTransactions::Start`.
+  uint64_t oldest_active_start_timestamp = read_only_transactions_.OldestActive(commit_log_->OldestActive());
+  MG_TRACEPOINT(gc__start, oldest_active_start_timestamp, force);
+  // The transaction of a snapshot that is being created is usually the oldest
+  // active one. The transactions that committed after it started are unlinked
+  // anyway once the snapshot has written all objects they changed, so the
+  // snapshot doesn't keep all newer deltas alive until it's finished. Their
+  // undo buffers are kept separately until they can be freed.
+  uint64_t unlink_timestamp = oldest_active_start_timestamp;
+  uint64_t oldest_active_except_snapshot = oldest_active_start_timestamp;
+  auto const snapshot_timestamp = snapshot_progress_.StartTimestamp();
+  if (snapshot_timestamp && *snapshot_timestamp == oldest_active_start_timestamp &&
+      (gc_snapshot_undo_buffers_.empty() || gc_snapshot_timestamp_ == *snapshot_timestamp)) {
+    gc_snapshot_timestamp_ = *snapshot_timestamp;
+    oldest_active_except_snapshot =
+        read_only_transactions_.OldestActive(commit_log_->OldestActiveExcept(*snapshot_timestamp));
+    unlink_timestamp = SnapshotUnlinkTimestamp(*snapshot_timestamp, oldest_active_except_snapshot);
+  }
   // We don't move undo buffers of unlinked transactions to garbage_undo_buffers
   // list immediately, because we would have to repeatedly take
   // garbage_undo_buffers lock.
-  std::list<std::pair<uint64_t, std::list<Delta>>> unlinked_undo_buffers;
+  std::list<std::pair<uint64_t, utils::ChunkedList<Delta>>> unlinked_undo_buffers;
 
   // We will only free vertices deleted up until now in this GC cycle, and we
   // will do it after cleaning-up the indices. That way we are sure that all
@@ -1200,144 +2163,168 @@ void InMemoryStorage::CollectGarbage(std::unique_lock<utils::RWLock> main_guard)
   deleted_vertices_->swap(current_deleted_vertices);
   deleted_edges_->swap(current_deleted_edges);
 
-  auto const need_full_scan_vertices = gc_full_scan_vertices_delete_.exchange(false);
-  auto const need_full_scan_edges = gc_full_scan_edges_delete_.exchange(false);
+  // The incremental GC bounds the work done in a single cycle, the rest is
+  // left for the following cycles.
+  bool const incremental = config_.gc.type == Config::Gc::Type::INCREMENTAL && !force;
+  uint64_t const budget = incremental ? config_.gc.incremental_budget : std::numeric_limits<uint64_t>::max();
+  // Set if there are transactions that could have been collected in this cycle
+  // but were left for the next one because of the budget.
+  bool budget_exhausted = false;
+  uint64_t unlinked_deltas = 0;
+
+  // An unfinished full scan is resumed before a new one is started. Requests
+  // made in the meantime stay pending and start another scan after it ends.
+  if (!gc_full_scan_vertices_next_ && gc_full_scan_vertices_delete_.exchange(false)) {
+    gc_full_scan_vertices_next_ = Gid::FromUint(0);
+  }
+  if (!gc_full_scan_edges_next_ && gc_full_scan_edges_delete_.exchange(false)) {
+    gc_full_scan_edges_next_ = Gid::FromUint(0);
+  }
+  auto const need_full_scan_vertices = gc_full_scan_vertices_next_.has_value();
+  auto const need_full_scan_edges = gc_full_scan_edges_next_.has_value();
 
   // Flag that will be used to determine whether the Index GC should be run. It
   // should be run when there were any items that were cleaned up (there were
   // updates between this run of the GC and the previous run of the GC). This
   // eliminates high CPU usage when the GC doesn't have to clean up anything.
-  bool run_index_cleanup = !committed_transactions_->empty() || !garbage_undo_buffers_->empty() ||
-                           need_full_scan_vertices || need_full_scan_edges;
-
-  while (true) {
-    // We don't want to hold the lock on committed transactions for too long,
-    // because that prevents other transactions from committing.
-    Transaction *transaction = nullptr;
-    {
-      auto committed_transactions_ptr = committed_transactions_.Lock();
-      if (committed_transactions_ptr->empty()) {
+  bool run_index_cleanup =
+      std::any_of(committed_transactions_.begin(), committed_transactions_.end(),
+                  [](auto &committed_transactions) { return !committed_transactions->empty(); }) ||
+      !garbage_undo_buffers_->empty() || need_full_scan_vertices || need_full_scan_edges;
+
+  // The transactions are unlinked in commit order across all shards: every
+  // transaction that committed before `unlink_cutoff` is unlinked in this
+  // cycle, wherever it is in its shard, and none of the later ones is. A
+  // transaction left linked behind a newer one whose undo buffer is freed
+  // would still point to its deltas. The budget of the incremental GC lowers
+  // the cutoff instead of stopping partway through the shards.
+  uint64_t unlink_cutoff = unlink_timestamp;
+  if (incremental) {
+    // The commit timestamps and sizes of the transactions that can be
+    // collected.
+    std::vector<std::pair<uint64_t, uint64_t>> candidates;
+    for (auto &shard_transactions : committed_transactions_) {
+      shard_transactions.WithLock([&](auto &committed_transactions) {
+        for (auto &transaction : committed_transactions) {
+          auto const commit_timestamp = transaction.commit_timestamp->load(std::memory_order_acquire);
+          if (commit_timestamp < unlink_timestamp) candidates.emplace_back(commit_timestamp, transaction.deltas.size());
+        }
+      });
+    }
+    std::sort(candidates.begin(), candidates.end());
+    uint64_t candidate_deltas = 0;
+    for (auto const &[commit_timestamp, deltas] : candidates) {
+      if (candidate_deltas >= budget) {
+        unlink_cutoff = commit_timestamp;
+        budget_exhausted = true;
         break;
       }
-      transaction = &committed_transactions_ptr->front();
+      candidate_deltas += deltas;
     }
+  }
 
-    auto commit_timestamp = transaction->commit_timestamp->load(std::memory_order_acquire);
-    if (commit_timestamp >= oldest_active_start_timestamp) {
-      break;
+  // The transactions collected from each shard. The list iterators stay valid
+  // while the committing transactions append to the shards, since only the GC
+  // removes from them.
+  using CommittedTransactionIt = std::list<Transaction>::iterator;
+  std::array<std::vector<CommittedTransactionIt>, kCommittedTransactionsShards> collected;
+  for (size_t shard = 0; shard < kCommittedTransactionsShards; ++shard) {
+    committed_transactions_[shard].WithLock([&](auto &committed_transactions) {
+      for (auto it = committed_transactions.begin(); it != committed_transactions.end(); ++it) {
+        if (it->commit_timestamp->load(std::memory_order_acquire) >= unlink_cutoff) continue;
+        collected[shard].push_back(it);
+        unlinked_deltas += it->deltas.size();
+      }
+    });
+  }
+
+  if (gc_thread_pool_) {
+    // The deltas of all collected transactions are unlinked by the GC workers
+    // together. Every delta is unlinked while holding the lock of the object
+    // that owns its chain and the chain is validated after taking the lock,
+    // and none of the undo buffers is freed before all of them are unlinked,
+    // so the deltas can be unlinked in any order.
+    std::vector<Delta *> deltas;
+    for (auto const &shard_collected : collected) {
+      for (auto const &transaction : shard_collected) {
+        for (Delta &delta : transaction->deltas) {
+          deltas.push_back(&delta);
+        }
+      }
     }
 
-    // When unlinking a delta which is the first delta in its version chain,
-    // special care has to be taken to avoid the following race condition:
-    //
-    // [Vertex] --> [Delta A]
-    //
-    //    GC thread: Delta A is the first in its chain, it must be unlinked from
-    //               vertex and marked for deletion
-    //    TX thread: Update vertex and add Delta B with Delta A as next
-    //
-    // [Vertex] --> [Delta B] <--> [Delta A]
-    //
-    //    GC thread: Unlink delta from Vertex
-    //
-    // [Vertex] --> (nullptr)
-    //
-    // When processing a delta that is the first one in its chain, we
-    // obtain the corresponding vertex or edge lock, and then verify that this
-    // delta still is the first in its chain.
-    // When processing a delta that is in the middle of the chain we only
-    // process the final delta of the given transaction in that chain. We
-    // determine the owner of the chain (either a vertex or an edge), obtain the
-    // corresponding lock, and then verify that this delta is still in the same
-    // position as it was before taking the lock.
-    //
-    // Even though the delta chain is lock-free (both `next` and `prev`) the
-    // chain should not be modified without taking the lock from the object that
-    // owns the chain (either a vertex or an edge). Modifying the chain without
-    // taking the lock will cause subtle race conditions that will leave the
-    // chain in a broken state.
-    // The chain can be only read without taking any locks.
-
-    for (Delta &delta : transaction->deltas) {
-      while (true) {
-        auto prev = delta.prev.Get();
-        switch (prev.type) {
-          case PreviousPtr::Type::VERTEX: {
-            Vertex *vertex = prev.vertex;
-            std::lock_guard<utils::SpinLock> vertex_guard(vertex->lock);
-            if (vertex->delta != &delta) {
-              // Something changed, we're not the first delta in the chain
-              // anymore.
-              continue;
-            }
-            vertex->delta = nullptr;
-            if (vertex->deleted) {
-              current_deleted_vertices.push_back(vertex->gid);
-            }
-            break;
-          }
-          case PreviousPtr::Type::EDGE: {
-            Edge *edge = prev.edge;
-            std::lock_guard<utils::SpinLock> edge_guard(edge->lock);
-            if (edge->delta != &delta) {
-              // Something changed, we're not the first delta in the chain
-              // anymore.
-              continue;
-            }
-            edge->delta = nullptr;
-            if (edge->deleted) {
-              current_deleted_edges.push_back(edge->gid);
-            }
-            break;
-          }
-          case PreviousPtr::Type::DELTA: {
-            if (prev.delta->timestamp->load(std::memory_order_acquire) == commit_timestamp) {
-              // The delta that is newer than this one is also a delta from this
-              // transaction. We skip the current delta and will remove it as a
-              // part of the suffix later.
-              break;
-            }
-            std::unique_lock<utils::SpinLock> guard;
-            {
-              // We need to find the parent object in order to be able to use
-              // its lock.
-              auto parent = prev;
-              while (parent.type == PreviousPtr::Type::DELTA) {
-                parent = parent.delta->prev.Get();
-              }
-              switch (parent.type) {
-                case PreviousPtr::Type::VERTEX:
-                  guard = std::unique_lock<utils::SpinLock>(parent.vertex->lock);
-                  break;
-                case PreviousPtr::Type::EDGE:
-                  guard = std::unique_lock<utils::SpinLock>(parent.edge->lock);
-                  break;
-                case PreviousPtr::Type::DELTA:
-                case PreviousPtr::Type::NULLPTR:
-                  LOG_FATAL("Invalid database state!");
-              }
-            }
-            if (delta.prev.Get() != prev) {
-              // Something changed, we could now be the first delta in the
-              // chain.
-              continue;
-            }
-            Delta *prev_delta = prev.delta;
-            prev_delta->next.store(nullptr, std::memory_order_release);
-            break;
-          }
-          case PreviousPtr::Type::NULLPTR: {
-            LOG_FATAL("Invalid pointer!");
-          }
+    auto const num_tasks = std::clamp<size_t>(deltas.size() / kGcMinDeltasPerTask, 1, config_.gc.threads);
+    auto const deltas_per_task = (deltas.size() + num_tasks - 1) / num_tasks;
+    std::vector<std::list<Gid>> task_deleted_vertices(num_tasks);
+    std::vector<std::list<Gid>> task_deleted_edges(num_tasks);
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(num_tasks);
+    for (size_t i = 0; i < num_tasks; ++i) {
+      tasks.emplace_back([&, i] {
+        auto const end = std::min(deltas.size(), (i + 1) * deltas_per_task);
+        for (auto pos = i * deltas_per_task; pos < end; ++pos) {
+          auto &delta = *deltas[pos];
+          UnlinkDelta(delta, delta.timestamp->load(std::memory_order_acquire), &task_deleted_vertices[i],
+                      &task_deleted_edges[i]);
         }
-        break;
+      });
+    }
+    RunGcTasks(tasks);
+    for (size_t i = 0; i < num_tasks; ++i) {
+      current_deleted_vertices.splice(current_deleted_vertices.end(), task_deleted_vertices[i]);
+      current_deleted_edges.splice(current_deleted_edges.end(), task_deleted_edges[i]);
+    }
+  } else {
+    // The shard locks aren't held while unlinking, because that would prevent
+    // other transactions from committing.
+    for (auto const &shard_collected : collected) {
+      for (auto const &transaction : shard_collected) {
+        auto commit_timestamp = transaction->commit_timestamp->load(std::memory_order_acquire);
+        for (Delta &delta : transaction->deltas) {
+          UnlinkDelta(delta, commit_timestamp, &current_deleted_vertices, &current_deleted_edges);
+        }
+      }
+    }
+  }
+
+  for (size_t shard = 0; shard < kCommittedTransactionsShards; ++shard) {
+    if (collected[shard].empty()) continue;
+    committed_transactions_[shard].WithLock([&](auto &committed_transactions) {
+      for (auto const &transaction : collected[shard]) {
+        unlinked_undo_buffers.emplace_back(transaction->commit_timestamp->load(std::memory_order_acquire),
+                                           std::move(transaction->deltas));
+        committed_transactions.erase(transaction);
+      }
+    });
+  }
+
+  gc_pending_deltas_.fetch_sub(unlinked_deltas, std::memory_order_acq_rel);
+  MG_TRACEPOINT(gc__unlink__done, unlinked_deltas, budget_exhausted);
+
+  // The undo buffers are tagged with the commit timestamps until they are
+  // marked. The ones committed after the snapshot started aren't read by it.
+  std::list<std::pair<uint64_t, utils::ChunkedList<Delta>>> snapshot_undo_buffers;
+  if (unlink_timestamp > oldest_active_start_timestamp) {
+    for (auto it = unlinked_undo_buffers.begin(); it != unlinked_undo_buffers.end();) {
+      auto next = std::next(it);
+      if (it->first > oldest_active_start_timestamp) {
+        snapshot_undo_buffers.splice(snapshot_undo_buffers.end(), unlinked_undo_buffers, it);
       }
+      it = next;
     }
+  }
 
-    committed_transactions_.WithLock([&](auto &committed_transactions) {
-      unlinked_undo_buffers.emplace_back(0, std::move(transaction->deltas));
-      committed_transactions.pop_front();
+  if (budget_exhausted) {
+    // Cleaning up the indices traverses all of them, so the incremental GC
+    // postpones it until the backlog is drained. The deleted vertices and
+    // edges have to wait for it in the meantime, since the edge indices point
+    // to the edges as well.
+    run_index_cleanup = false;
+    deleted_vertices_.WithLock([&](auto &deleted_vertices) {
+      deleted_vertices.splice(deleted_vertices.begin(), current_deleted_vertices);
     });
+    deleted_edges_.WithLock(
+        [&](auto &deleted_edges) { deleted_edges.splice(deleted_edges.begin(), current_deleted_edges); });
   }
 
   // After unlinking deltas from vertices, we refresh the indices. That way
@@ -1345,15 +2332,57 @@ void InMemoryStorage::CollectGarbage(std::unique_lock<utils::RWLock> main_guard)
   // appears in an index, and we can safely remove the from the main storage
   // after the last currently active transaction is finished.
   if (run_index_cleanup) {
+    MG_TRACEPOINT(gc__index__cleanup__start);
     // This operation is very expensive as it traverses through all of the items
     // in every index every time.
-    indices_.RemoveObsoleteEntries(oldest_active_start_timestamp);
     auto *mem_unique_constraints = static_cast<InMemoryUniqueConstraints *>(constraints_.unique_constraints_.get());
-    mem_unique_constraints->RemoveObsoleteEntries(oldest_active_start_timestamp);
+    if (gc_thread_pool_) {
+      // The indices and constraints are independent, so they are cleaned up
+      // in parallel.
+      std::vector<std::function<void()>> tasks{
+          [&] {
+            static_cast<InMemoryLabelIndex *>(indices_.label_index_.get())
+                ->RemoveObsoleteEntries(oldest_active_start_timestamp);
+          },
+          [&] {
+            static_cast<InMemoryLabelPropertyIndex *>(indices_.label_property_index_.get())
+                ->RemoveObsoleteEntries(oldest_active_start_timestamp);
+          },
+          [&] {
+            static_cast<InMemoryLabelPropertyCompositeIndex *>(indices_.label_property_composite_index_.get())
+                ->RemoveObsoleteEntries(oldest_active_start_timestamp);
+          },
+          [&] {
+            static_cast<InMemoryEdgeTypeIndex *>(indices_.edge_type_index_.get())
+                ->RemoveObsoleteEntries(oldest_active_start_timestamp);
+          },
+          [&] {
+            static_cast<InMemoryEdgeTypePropertyIndex *>(indices_.edge_type_property_index_.get())
+                ->RemoveObsoleteEntries(oldest_active_start_timestamp);
+          },
+          [&] {
+            static_cast<InMemoryTextIndex *>(indices_.text_index_.get())
+                ->RemoveObsoleteEntries(oldest_active_start_timestamp);
+          },
+          [&] {
+            static_cast<InMemoryVectorIndex *>(indices_.vector_index_.get())
+                ->RemoveObsoleteEntries(oldest_active_start_timestamp);
+          },
+          [&] {
+            static_cast<InMemoryAggregateIndex *>(indices_.aggregate_index_.get())
+                ->RemoveObsoleteEntries(oldest_active_start_timestamp);
+          },
+          [&] { mem_unique_constraints->RemoveObsoleteEntries(oldest_active_start_timestamp); }};
+      RunGcTasks(tasks);
+    } else {
+      indices_.RemoveObsoleteEntries(oldest_active_start_timestamp);
+      mem_unique_constraints->RemoveObsoleteEntries(oldest_active_start_timestamp);
+    }
+    MG_TRACEPOINT(gc__index__cleanup__done);
   }
 
   {
-    std::unique_lock<utils::SpinLock> guard(engine_lock_);
+    std::unique_lock guard(engine_lock_);
     uint64_t mark_timestamp = timestamp_;
     // Take garbage_undo_buffers lock while holding the engine lock to make
     // sure that entries are sorted by mark timestamp in the list.
@@ -1369,22 +2398,40 @@ void InMemoryStorage::CollectGarbage(std::unique_lock<utils::RWLock> main_guard)
       }
       garbage_undo_buffers.splice(garbage_undo_buffers.end(), unlinked_undo_buffers);
     });
+    for (auto &[timestamp, undo_buffer] : snapshot_undo_buffers) {
+      timestamp = mark_timestamp;
+    }
+    gc_snapshot_undo_buffers_.splice(gc_snapshot_undo_buffers_.end(), snapshot_undo_buffers);
     for (auto vertex : current_deleted_vertices) {
       garbage_vertices_.emplace_back(mark_timestamp, vertex);
     }
   }
 
+  // The expired undo buffers are only detached while holding the lock. Their
+  // deltas are destroyed and their chunks released once the lock is dropped.
+  std::list<std::pair<uint64_t, utils::ChunkedList<Delta>>> expired_undo_buffers;
   garbage_undo_buffers_.WithLock([&](auto &undo_buffers) {
     // if force is set to true we can simply delete all the leftover undos because
     // no transaction is active
     if constexpr (force) {
-      undo_buffers.clear();
+      expired_undo_buffers.splice(expired_undo_buffers.end(), undo_buffers);
     } else {
-      while (!undo_buffers.empty() && undo_buffers.front().first <= oldest_active_start_timestamp) {
-        undo_buffers.pop_front();
-      }
+      auto it = undo_buffers.begin();
+      while (it != undo_buffers.end() && it->first <= oldest_active_start_timestamp) ++it;
+      expired_undo_buffers.splice(expired_undo_buffers.end(), undo_buffers, undo_buffers.begin(), it);
     }
   });
+  if constexpr (force) {
+    expired_undo_buffers.splice(expired_undo_buffers.end(), gc_snapshot_undo_buffers_);
+  } else {
+    auto it = gc_snapshot_undo_buffers_.begin();
+    while (it != gc_snapshot_undo_buffers_.end() && it->first <= oldest_active_except_snapshot) ++it;
+    expired_undo_buffers.splice(expired_undo_buffers.end(), gc_snapshot_undo_buffers_,
+                                gc_snapshot_undo_buffers_.begin(), it);
+  }
+  MG_TRACEPOINT(gc__free__start, expired_undo_buffers.size());
+  expired_undo_buffers.clear();
+  long_delta_chains_.RemoveExpiredVersions(oldest_active_start_timestamp);
 
   {
     auto vertex_acc = vertices_.access();
@@ -1414,31 +2461,228 @@ void InMemoryStorage::CollectGarbage(std::unique_lock<utils::RWLock> main_guard)
   //  accessor.remove_if([](auto const & item){ return item.delta == nullptr && item.deleted;});
   //  alternatively, an auxiliary data structure within skip_list to track these, hence a full scan wouldn't be needed
   //  we will wait for evidence that this is needed before doing so.
+  //  The incremental GC splits the scans over several cycles.
   if (need_full_scan_vertices) {
-    auto vertex_acc = vertices_.access();
-    for (auto &vertex : vertex_acc) {
-      // a deleted vertex which as no deltas must have come from IN_MEMORY_ANALYTICAL deletion
-      if (vertex.delta == nullptr && vertex.deleted) {
-        vertex_acc.remove(vertex);
-      }
-    }
+    gc_full_scan_vertices_next_ = RemoveDeletedWithoutDeltas(vertices_, *gc_full_scan_vertices_next_, budget);
   }
 
   // EXPENSIVE full scan, is only run if an IN_MEMORY_ANALYTICAL transaction involved any deletions
   if (need_full_scan_edges) {
-    auto edge_acc = edges_.access();
-    for (auto &edge : edge_acc) {
-      // a deleted edge which as no deltas must have come from IN_MEMORY_ANALYTICAL deletion
-      if (edge.delta == nullptr && edge.deleted) {
-        edge_acc.remove(edge);
+    gc_full_scan_edges_next_ = RemoveDeletedWithoutDeltas(edges_, *gc_full_scan_edges_next_, budget);
+  }
+  gc_full_scan_unfinished_ = gc_full_scan_vertices_next_ || gc_full_scan_edges_next_;
+
+  uint64_t pending_transactions = 0;
+  for (auto &committed_transactions : committed_transactions_) {
+    pending_transactions += committed_transactions->size();
+  }
+  memgraph::metrics::SetGaugeValue(memgraph::metrics::GCPendingTransactions, pending_transactions);
+  memgraph::metrics::SetGaugeValue(memgraph::metrics::GCPendingUndoBuffers,
+                                   garbage_undo_buffers_->size() + gc_snapshot_undo_buffers_.size());
+  memgraph::metrics::SetGaugeValue(memgraph::metrics::GCPendingDeltas,
+                                   gc_pending_deltas_.load(std::memory_order_acquire));
+  memgraph::metrics::Measure(memgraph::metrics::GCLatency_us,
+                             std::chrono::duration_cast<std::chrono::microseconds>(timer.Elapsed()).count());
+  MG_TRACEPOINT(gc__done, pending_transactions);
+}
+
+uint64_t InMemoryStorage::SnapshotUnlinkTimestamp(uint64_t snapshot_timestamp,
+                                                  uint64_t oldest_active_except_snapshot) {
+  // The transactions are unlinked in the order of their commit timestamps, so
+  // the oldest one that changed an object the snapshot still has to write
+  // stops the unlinking in all shards.
+  uint64_t unlink_timestamp = oldest_active_except_snapshot;
+  for (auto &shard_transactions : committed_transactions_) {
+    // Only the GC removes transactions from the shards, so the pointers stay
+    // valid after the lock is released.
+    std::vector<Transaction *> transactions;
+    shard_transactions.WithLock([&](auto &committed_transactions) {
+      for (auto &transaction : committed_transactions) {
+        auto const commit_timestamp = transaction.commit_timestamp->load(std::memory_order_acquire);
+        if (commit_timestamp > snapshot_timestamp && commit_timestamp < unlink_timestamp) {
+          transactions.push_back(&transaction);
+        }
       }
+    });
+    for (auto *transaction : transactions) {
+      auto const commit_timestamp = transaction->commit_timestamp->load(std::memory_order_acquire);
+      if (commit_timestamp >= unlink_timestamp) continue;
+      bool written = true;
+      for (const Delta &delta : transaction->deltas) {
+        if (!snapshot_progress_.IsWritten(snapshot_timestamp, delta)) {
+          written = false;
+          break;
+        }
+      }
+      if (!written) unlink_timestamp = commit_timestamp;
     }
   }
+  return unlink_timestamp;
+}
+
+void InMemoryStorage::RunIncrementalGc() {
+  bool const has_work = gc_pending_deltas_.load(std::memory_order_acquire) >= config_.gc.incremental_backlog ||
+                        gc_full_scan_vertices_delete_ || gc_full_scan_edges_delete_ || gc_full_scan_unfinished_;
+  if (!has_work && ++gc_idle_ticks_ < kGcMaxIdleTicks) return;
+  gc_idle_ticks_ = 0;
+  CollectGarbage<false>();
+}
+
+void InMemoryStorage::CountIndexStatsChanges(const Vertex &vertex, const Transaction &transaction,
+                                             IndexStatsChanges *changes) {
+  const auto transaction_id = transaction.transaction_id.load(std::memory_order_acquire);
+  for (const Delta *delta = vertex.delta;
+       delta != nullptr && delta->timestamp->load(std::memory_order_acquire) == transaction_id;
+       delta = delta->next.load(std::memory_order_acquire)) {
+    switch (delta->action) {
+      case Delta::Action::ADD_LABEL:
+      case Delta::Action::REMOVE_LABEL:
+        ++changes->labels[delta->label];
+        break;
+      case Delta::Action::SET_PROPERTY:
+        ++changes->properties[delta->property.key];
+        break;
+      case Delta::Action::RECREATE_OBJECT:
+        // The vertex was deleted and it left all indices of its labels.
+        for (const auto label : vertex.labels) ++changes->labels[label];
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+uint64_t InMemoryStorage::DefragmentMemory(const uint64_t budget) {
+  std::lock_guard defragmentation_guard(defragmentation_lock_);
+  // Index creation and durability read the properties without the object
+  // locks. The objects without deltas aren't read by durability, and the
+  // shared lock keeps the index creation from running concurrently.
+  std::shared_lock<MainLock> storage_guard(main_lock_);
+
+  uint64_t moved = 0;
+  const auto defragment = [&moved, budget](auto &objects, Gid &next) {
+    auto acc = objects.access();
+    auto it = acc.find_equal_or_greater(next);
+    for (uint64_t visited = 0; it != acc.end() && visited < budget; ++it, ++visited) {
+      auto guard = std::lock_guard{it->lock};
+      if (it->delta != nullptr) continue;
+      if (it->properties.Defragment()) ++moved;
+    }
+    next = it != acc.end() ? it->gid : Gid::FromUint(0);
+  };
+  defragment(vertices_, defragmentation_next_vertex_);
+  if (config_.items.properties_on_edges) defragment(edges_, defragmentation_next_edge_);
+  return moved;
+}
+
+uint64_t InMemoryStorage::TierPropertyValues(const uint64_t budget) {
+  if (!cold_value_store_) return 0;
+  std::lock_guard tiering_guard(tiering_lock_);
+  // The same as for the defragmentation, index creation and durability read
+  // the properties without the object locks.
+  std::shared_lock<MainLock> storage_guard(main_lock_);
+
+  uint64_t evicted = 0;
+  const auto tier = [this, &evicted, budget](auto &objects, Gid &next) {
+    auto acc = objects.access();
+    auto it = acc.find_equal_or_greater(next);
+    for (uint64_t visited = 0; it != acc.end() && visited < budget; ++it, ++visited) {
+      auto guard = std::unique_lock{it->lock};
+      if (it->delta != nullptr) continue;
+      const auto reads = std::exchange(it->property_reads, it->property_reads / 2);
+      if (reads == 0) {
+        evicted += it->properties.EvictLargeValues(cold_value_store_.get());
+      } else if (reads >= kHotPropertyReads) {
+        guard.unlock();
+        try {
+          LockWithLoadedProperties(*it);
+        } catch (const ColdValueStoreException &e) {
+          // The values stay evicted and the readers of the object get the error.
+          spdlog::warn("The evicted property values of {} couldn't be loaded: {}", it->gid.AsUint(), e.what());
+        }
+      }
+    }
+    next = it != acc.end() ? it->gid : Gid::FromUint(0);
+  };
+  tier(vertices_, tiering_next_vertex_);
+  if (config_.items.properties_on_edges) tier(edges_, tiering_next_edge_);
+  // The values which were loaded back or replaced are deleted while no object
+  // is locked.
+  cold_value_store_->DeletePending();
+  return evicted;
+}
+
+void InMemoryStorage::RefreshIndexStats() {
+  const auto changes = index_stats_changes_.WithLock([](const auto &changes) { return changes; });
+  const auto changes_of = [](const auto &counts, const auto &key) -> uint64_t {
+    auto it = counts.find(key);
+    return it != counts.end() ? it->second : 0;
+  };
+  // Indices without statistics are refreshed on the first run and after any change.
+  const auto is_stale = [threshold = config_.index_stats.refresh_threshold](auto &refreshed, const auto &key,
+                                                                            uint64_t total_changes, uint64_t count) {
+    auto [it, inserted] = refreshed.try_emplace(key, total_changes);
+    if (inserted) return true;
+    const auto changed = total_changes - it->second;
+    if (changed == 0 || static_cast<double>(changed) < threshold * static_cast<double>(count)) return false;
+    it->second = total_changes;
+    return true;
+  };
+
+  auto acc = Access(std::optional<IsolationLevel>{});
+  const auto indices = acc->ListAllIndices();
+  auto *label_index = static_cast<InMemoryLabelIndex *>(indices_.label_index_.get());
+  auto *label_property_index = static_cast<InMemoryLabelPropertyIndex *>(indices_.label_property_index_.get());
+
+  for (const auto label : indices.label) {
+    const auto stats = label_index->GetIndexStats(label);
+    if (!is_stale(index_stats_refreshed_labels_, label, changes_of(changes.labels, label), stats ? stats->count : 0)) {
+      continue;
+    }
+    uint64_t count = 0;
+    uint64_t total_degree = 0;
+    for (auto vertex : acc->Vertices(label, View::OLD)) {
+      ++count;
+      total_degree += *vertex.OutDegree(View::OLD) + *vertex.InDegree(View::OLD);
+    }
+    const auto avg_degree = count > 0 ? static_cast<double>(total_degree) / static_cast<double>(count) : 0;
+    label_index->SetIndexStats(label, LabelIndexStats{.count = count, .avg_degree = avg_degree});
+  }
+
+  for (const auto &[label, property] : indices.label_property) {
+    const auto key = std::make_pair(label, property);
+    const auto stats = label_property_index->GetIndexStats(key);
+    const auto total_changes = changes_of(changes.labels, label) + changes_of(changes.properties, property);
+    if (!is_stale(index_stats_refreshed_label_properties_, key, total_changes, stats ? stats->count : 0)) {
+      continue;
+    }
+    std::map<PropertyValue, int64_t> value_counts;
+    uint64_t total_degree = 0;
+    for (auto vertex : acc->Vertices(label, property, View::OLD)) {
+      ++value_counts[*vertex.GetProperty(property, View::OLD)];
+      total_degree += *vertex.OutDegree(View::OLD) + *vertex.InDegree(View::OLD);
+    }
+    label_property_index->SetIndexStats(key, MakeLabelPropertyIndexStats(value_counts, total_degree));
+  }
+}
+
+void InMemoryStorage::RunGcTasks(std::vector<std::function<void()>> &tasks) {
+  if (tasks.empty()) return;
+  std::latch done(static_cast<std::ptrdiff_t>(tasks.size() - 1));
+  for (size_t i = 1; i < tasks.size(); ++i) {
+    gc_thread_pool_->AddTask([&task = tasks[i], &done] {
+      task();
+      done.count_down();
+    });
+  }
+  // The GC thread does its share of the work instead of just waiting.
+  tasks[0]();
+  done.wait();
 }
 
 // tell the linker he can find the CollectGarbage definitions here
-template void InMemoryStorage::CollectGarbage<true>(std::unique_lock<utils::RWLock>);
-template void InMemoryStorage::CollectGarbage<false>(std::unique_lock<utils::RWLock>);
+template void InMemoryStorage::CollectGarbage<true>(std::unique_lock<MainLock>);
+template void InMemoryStorage::CollectGarbage<false>(std::unique_lock<MainLock>);
 
 StorageInfo InMemoryStorage::GetInfo() const {
   auto vertex_count = vertices_.size();
@@ -1457,14 +2701,21 @@ bool InMemoryStorage::InitializeWalFile() {
     return false;
   if (!wal_file_) {
     wal_file_.emplace(wal_directory_, uuid_, replication_state_.GetEpoch().id, config_.items, name_id_mapper_.get(),
-                      wal_seq_num_++, &file_retainer_);
+                      wal_seq_num_++, &file_retainer_, wal_segment_pool_ ? &*wal_segment_pool_ : nullptr);
+    if (config_.durability.async_writeback) {
+      wal_file_->EnableAsyncWriteback(config_.durability.wal_file_size_kibibytes * 1024);
+    }
   }
   return true;
 }
 
 void InMemoryStorage::FinalizeWalFile() {
   ++wal_unsynced_transactions_;
-  if (wal_unsynced_transactions_ >= config_.durability.wal_file_flush_every_n_tx) {
+  ++wal_written_transactions_;
+  if (config_.durability.wal_group_commit) {
+    // The committing transactions sync the WAL themselves, see
+    // `WaitForWalSync`.
+  } else if (wal_unsynced_transactions_ >= config_.durability.wal_file_flush_every_n_tx) {
     wal_file_->Sync();
     wal_unsynced_transactions_ = 0;
   }
@@ -1481,178 +2732,289 @@ void InMemoryStorage::FinalizeWalFile() {
   }
 }
 
-bool InMemoryStorage::AppendToWalDataManipulation(const Transaction &transaction, uint64_t final_commit_timestamp) {
-  if (!InitializeWalFile()) {
-    return true;
+void InMemoryStorage::WaitForWalSync(uint64_t transactions) {
+  std::unique_lock<std::mutex> guard(wal_sync_lock_);
+  while (wal_synced_transactions_ < transactions) {
+    if (wal_sync_in_progress_) {
+      // Another thread is already syncing, it may or may not cover our
+      // transactions.
+      wal_sync_cv_.wait(guard);
+      continue;
+    }
+
+    wal_sync_in_progress_ = true;
+    guard.unlock();
+    uint64_t written = 0;
+    int fd = -1;
+    {
+      // Only the buffered data is written to the file while holding the engine
+      // lock, the much slower `fsync` is done without it so that other
+      // transactions can keep committing in the meantime and join the next
+      // sync. Finalized WAL files are synced when they are finalized.
+      std::lock_guard engine_guard(engine_lock_);
+      written = wal_written_transactions_;
+      if (wal_file_) fd = wal_file_->FlushAndDuplicateDescriptor();
+    }
+    if (fd != -1) utils::OutputFile::SyncDescriptor(fd);
+    guard.lock();
+    wal_synced_transactions_ = written;
+    wal_sync_in_progress_ = false;
+    wal_sync_cv_.notify_all();
   }
-  // Traverse deltas and append them to the WAL file.
-  // A single transaction will always be contained in a single WAL file.
+}
+
+namespace {
+// Calls the callback with the deltas of the transaction and the objects they
+// belong to, in the order they are written to the WAL.
+template <typename TCallback>
+void ForEachWalDelta(const Transaction &transaction, TCallback &&callback) {
   auto current_commit_timestamp = transaction.commit_timestamp->load(std::memory_order_acquire);
 
-  replication_state_.InitializeTransaction(wal_file_->SequenceNumber());
+  // Helper lambda that traverses the delta chain in order to find the first
+  // delta that should be processed and then appends all discovered deltas.
+  auto find_and_apply_deltas = [&](const auto *delta, const auto &parent, auto filter) {
+    while (true) {
+      auto *older = delta->next.load(std::memory_order_acquire);
+      if (older == nullptr || older->timestamp->load(std::memory_order_acquire) != current_commit_timestamp) break;
+      delta = older;
+    }
+    while (true) {
+      if (filter(delta->action)) {
+        callback(*delta, parent);
+      }
+      auto prev = delta->prev.Get();
+      MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
+      if (prev.type != PreviousPtr::Type::DELTA) break;
+      delta = prev.delta;
+    }
+  };
 
-  auto append_deltas = [&](auto callback) {
-    // Helper lambda that traverses the delta chain on order to find the first
-    // delta that should be processed and then appends all discovered deltas.
-    auto find_and_apply_deltas = [&](const auto *delta, const auto &parent, auto filter) {
-      while (true) {
-        auto *older = delta->next.load(std::memory_order_acquire);
-        if (older == nullptr || older->timestamp->load(std::memory_order_acquire) != current_commit_timestamp) break;
-        delta = older;
+  // The deltas are ordered correctly in the `transaction.deltas` buffer, but we
+  // don't traverse them in that order. That is because for each delta we need
+  // information about the vertex or edge they belong to and that information
+  // isn't stored in the deltas themselves. In order to find out information
+  // about the corresponding vertex or edge it is necessary to traverse the
+  // delta chain for each delta until a vertex or edge is encountered. This
+  // operation is very expensive as the chain grows.
+  // Instead, we traverse the edges until we find a vertex or edge and traverse
+  // their delta chains. This approach has a drawback because we lose the
+  // correct order of the operations. Because of that, we need to traverse the
+  // deltas several times and we have to manually ensure that the stored deltas
+  // will be ordered correctly.
+
+  // 1. Process all Vertex deltas and store all operations that create vertices
+  // and modify vertex data.
+  for (const auto &delta : transaction.deltas) {
+    auto prev = delta.prev.Get();
+    MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
+    if (prev.type != PreviousPtr::Type::VERTEX) continue;
+    find_and_apply_deltas(&delta, *prev.vertex, [](auto action) {
+      switch (action) {
+        case Delta::Action::DELETE_DESERIALIZED_OBJECT:
+        case Delta::Action::DELETE_OBJECT:
+        case Delta::Action::SET_PROPERTY:
+        case Delta::Action::ADD_LABEL:
+        case Delta::Action::REMOVE_LABEL:
+          return true;
+
+        case Delta::Action::RECREATE_OBJECT:
+        case Delta::Action::ADD_IN_EDGE:
+        case Delta::Action::ADD_OUT_EDGE:
+        case Delta::Action::REMOVE_IN_EDGE:
+        case Delta::Action::REMOVE_OUT_EDGE:
+          return false;
       }
-      while (true) {
-        if (filter(delta->action)) {
-          callback(*delta, parent, final_commit_timestamp);
-        }
-        auto prev = delta->prev.Get();
-        MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
-        if (prev.type != PreviousPtr::Type::DELTA) break;
-        delta = prev.delta;
+    });
+  }
+  // 2. Process all Vertex deltas and store all operations that create edges.
+  for (const auto &delta : transaction.deltas) {
+    auto prev = delta.prev.Get();
+    MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
+    if (prev.type != PreviousPtr::Type::VERTEX) continue;
+    find_and_apply_deltas(&delta, *prev.vertex, [](auto action) {
+      switch (action) {
+        case Delta::Action::REMOVE_OUT_EDGE:
+          return true;
+        case Delta::Action::DELETE_DESERIALIZED_OBJECT:
+        case Delta::Action::DELETE_OBJECT:
+        case Delta::Action::RECREATE_OBJECT:
+        case Delta::Action::SET_PROPERTY:
+        case Delta::Action::ADD_LABEL:
+        case Delta::Action::REMOVE_LABEL:
+        case Delta::Action::ADD_IN_EDGE:
+        case Delta::Action::ADD_OUT_EDGE:
+        case Delta::Action::REMOVE_IN_EDGE:
+          return false;
       }
-    };
+    });
+  }
+  // 3. Process all Edge deltas and store all operations that modify edge data.
+  for (const auto &delta : transaction.deltas) {
+    auto prev = delta.prev.Get();
+    MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
+    if (prev.type != PreviousPtr::Type::EDGE) continue;
+    find_and_apply_deltas(&delta, *prev.edge, [](auto action) {
+      switch (action) {
+        case Delta::Action::SET_PROPERTY:
+          return true;
+        case Delta::Action::DELETE_DESERIALIZED_OBJECT:
+        case Delta::Action::DELETE_OBJECT:
+        case Delta::Action::RECREATE_OBJECT:
+        case Delta::Action::ADD_LABEL:
+        case Delta::Action::REMOVE_LABEL:
+        case Delta::Action::ADD_IN_EDGE:
+        case Delta::Action::ADD_OUT_EDGE:
+        case Delta::Action::REMOVE_IN_EDGE:
+        case Delta::Action::REMOVE_OUT_EDGE:
+          return false;
+      }
+    });
+  }
+  // 4. Process all Vertex deltas and store all operations that delete edges.
+  for (const auto &delta : transaction.deltas) {
+    auto prev = delta.prev.Get();
+    MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
+    if (prev.type != PreviousPtr::Type::VERTEX) continue;
+    find_and_apply_deltas(&delta, *prev.vertex, [](auto action) {
+      switch (action) {
+        case Delta::Action::ADD_OUT_EDGE:
+          return true;
+        case Delta::Action::DELETE_DESERIALIZED_OBJECT:
+        case Delta::Action::DELETE_OBJECT:
+        case Delta::Action::RECREATE_OBJECT:
+        case Delta::Action::SET_PROPERTY:
+        case Delta::Action::ADD_LABEL:
+        case Delta::Action::REMOVE_LABEL:
+        case Delta::Action::ADD_IN_EDGE:
+        case Delta::Action::REMOVE_IN_EDGE:
+        case Delta::Action::REMOVE_OUT_EDGE:
+          return false;
+      }
+    });
+  }
+  // 5. Process all Vertex deltas and store all operations that delete vertices.
+  for (const auto &delta : transaction.deltas) {
+    auto prev = delta.prev.Get();
+    MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
+    if (prev.type != PreviousPtr::Type::VERTEX) continue;
+    find_and_apply_deltas(&delta, *prev.vertex, [](auto action) {
+      switch (action) {
+        case Delta::Action::RECREATE_OBJECT:
+          return true;
+        case Delta::Action::DELETE_DESERIALIZED_OBJECT:
+        case Delta::Action::DELETE_OBJECT:
+        case Delta::Action::SET_PROPERTY:
+        case Delta::Action::ADD_LABEL:
+        case Delta::Action::REMOVE_LABEL:
+        case Delta::Action::ADD_IN_EDGE:
+        case Delta::Action::ADD_OUT_EDGE:
+        case Delta::Action::REMOVE_IN_EDGE:
+        case Delta::Action::REMOVE_OUT_EDGE:
+          return false;
+      }
+    });
+  }
+}
 
-    // The deltas are ordered correctly in the `transaction.deltas` buffer, but we
-    // don't traverse them in that order. That is because for each delta we need
-    // information about the vertex or edge they belong to and that information
-    // isn't stored in the deltas themselves. In order to find out information
-    // about the corresponding vertex or edge it is necessary to traverse the
-    // delta chain for each delta until a vertex or edge is encountered. This
-    // operation is very expensive as the chain grows.
-    // Instead, we traverse the edges until we find a vertex or edge and traverse
-    // their delta chains. This approach has a drawback because we lose the
-    // correct order of the operations. Because of that, we need to traverse the
-    // deltas several times and we have to manually ensure that the stored deltas
-    // will be ordered correctly.
-
-    // 1. Process all Vertex deltas and store all operations that create vertices
-    // and modify vertex data.
-    for (const auto &delta : transaction.deltas) {
-      auto prev = delta.prev.Get();
-      MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
-      if (prev.type != PreviousPtr::Type::VERTEX) continue;
-      find_and_apply_deltas(&delta, *prev.vertex, [](auto action) {
-        switch (action) {
-          case Delta::Action::DELETE_DESERIALIZED_OBJECT:
-          case Delta::Action::DELETE_OBJECT:
-          case Delta::Action::SET_PROPERTY:
-          case Delta::Action::ADD_LABEL:
-          case Delta::Action::REMOVE_LABEL:
-            return true;
-
-          case Delta::Action::RECREATE_OBJECT:
-          case Delta::Action::ADD_IN_EDGE:
-          case Delta::Action::ADD_OUT_EDGE:
-          case Delta::Action::REMOVE_IN_EDGE:
-          case Delta::Action::REMOVE_OUT_EDGE:
-            return false;
-        }
-      });
-    }
-    // 2. Process all Vertex deltas and store all operations that create edges.
-    for (const auto &delta : transaction.deltas) {
-      auto prev = delta.prev.Get();
-      MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
-      if (prev.type != PreviousPtr::Type::VERTEX) continue;
-      find_and_apply_deltas(&delta, *prev.vertex, [](auto action) {
-        switch (action) {
-          case Delta::Action::REMOVE_OUT_EDGE:
-            return true;
-          case Delta::Action::DELETE_DESERIALIZED_OBJECT:
-          case Delta::Action::DELETE_OBJECT:
-          case Delta::Action::RECREATE_OBJECT:
-          case Delta::Action::SET_PROPERTY:
-          case Delta::Action::ADD_LABEL:
-          case Delta::Action::REMOVE_LABEL:
-          case Delta::Action::ADD_IN_EDGE:
-          case Delta::Action::ADD_OUT_EDGE:
-          case Delta::Action::REMOVE_IN_EDGE:
-            return false;
-        }
-      });
-    }
-    // 3. Process all Edge deltas and store all operations that modify edge data.
-    for (const auto &delta : transaction.deltas) {
-      auto prev = delta.prev.Get();
-      MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
-      if (prev.type != PreviousPtr::Type::EDGE) continue;
-      find_and_apply_deltas(&delta, *prev.edge, [](auto action) {
-        switch (action) {
-          case Delta::Action::SET_PROPERTY:
-            return true;
-          case Delta::Action::DELETE_DESERIALIZED_OBJECT:
-          case Delta::Action::DELETE_OBJECT:
-          case Delta::Action::RECREATE_OBJECT:
-          case Delta::Action::ADD_LABEL:
-          case Delta::Action::REMOVE_LABEL:
-          case Delta::Action::ADD_IN_EDGE:
-          case Delta::Action::ADD_OUT_EDGE:
-          case Delta::Action::REMOVE_IN_EDGE:
-          case Delta::Action::REMOVE_OUT_EDGE:
-            return false;
-        }
-      });
-    }
-    // 4. Process all Vertex deltas and store all operations that delete edges.
-    for (const auto &delta : transaction.deltas) {
-      auto prev = delta.prev.Get();
-      MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
-      if (prev.type != PreviousPtr::Type::VERTEX) continue;
-      find_and_apply_deltas(&delta, *prev.vertex, [](auto action) {
-        switch (action) {
-          case Delta::Action::ADD_OUT_EDGE:
-            return true;
-          case Delta::Action::DELETE_DESERIALIZED_OBJECT:
-          case Delta::Action::DELETE_OBJECT:
-          case Delta::Action::RECREATE_OBJECT:
-          case Delta::Action::SET_PROPERTY:
-          case Delta::Action::ADD_LABEL:
-          case Delta::Action::REMOVE_LABEL:
-          case Delta::Action::ADD_IN_EDGE:
-          case Delta::Action::REMOVE_IN_EDGE:
-          case Delta::Action::REMOVE_OUT_EDGE:
-            return false;
-        }
-      });
-    }
-    // 5. Process all Vertex deltas and store all operations that delete vertices.
-    for (const auto &delta : transaction.deltas) {
-      auto prev = delta.prev.Get();
-      MG_ASSERT(prev.type != PreviousPtr::Type::NULLPTR, "Invalid pointer!");
-      if (prev.type != PreviousPtr::Type::VERTEX) continue;
-      find_and_apply_deltas(&delta, *prev.vertex, [](auto action) {
-        switch (action) {
-          case Delta::Action::RECREATE_OBJECT:
-            return true;
-          case Delta::Action::DELETE_DESERIALIZED_OBJECT:
-          case Delta::Action::DELETE_OBJECT:
-          case Delta::Action::SET_PROPERTY:
-          case Delta::Action::ADD_LABEL:
-          case Delta::Action::REMOVE_LABEL:
-          case Delta::Action::ADD_IN_EDGE:
-          case Delta::Action::ADD_OUT_EDGE:
-          case Delta::Action::REMOVE_IN_EDGE:
-          case Delta::Action::REMOVE_OUT_EDGE:
-            return false;
-        }
-      });
+// Encodes the deltas of the transaction and its end with 0 in place of the
+// commit timestamp. `position` returns the position in the encoded data where the
+// next delta begins.
+template <typename TPosition>
+void EncodeTransactionDeltas(durability::BaseEncoder *encoder, NameIdMapper *name_id_mapper, Config::Items items,
+                             const Transaction &transaction, durability::EncodedDeltas *encoded,
+                             TPosition &&position) {
+  ForEachWalDelta(transaction, [&](const Delta &delta, const auto &parent) {
+    encoded->headers.push_back(position());
+    if constexpr (std::is_same_v<std::remove_cvref_t<decltype(parent)>, Vertex>) {
+      durability::EncodeDelta(encoder, name_id_mapper, items, delta, parent, 0);
+    } else {
+      durability::EncodeDelta(encoder, name_id_mapper, delta, parent, 0);
     }
-  };
+  });
+  // Add a delta that indicates that the transaction is fully written.
+  encoded->headers.push_back(position());
+  durability::EncodeTransactionEnd(encoder, 0);
+}
+
+durability::EncodedDeltas EncodeWalDeltas(const Transaction &transaction, NameIdMapper *name_id_mapper,
+                                          Config::Items items) {
+  durability::EncodedDeltas encoded;
+  durability::BufferEncoder encoder;
+  EncodeTransactionDeltas(&encoder, name_id_mapper, items, transaction, &encoded,
+                          [&encoder] { return encoder.GetBuffer().size(); });
+  encoded.data = encoder.ReleaseBuffer();
+  return encoded;
+}
 
-  append_deltas([&](const Delta &delta, const auto &parent, uint64_t timestamp) {
-    wal_file_->AppendDelta(delta, parent, timestamp);
-    replication_state_.AppendDelta(delta, parent, timestamp);
+durability::EncodedDeltas EncodeReplicationDeltas(const Transaction &transaction, NameIdMapper *name_id_mapper,
+                                                  Config::Items items) {
+  durability::EncodedDeltas encoded;
+  // Only the data of the segments is kept, the replica streams frame it again
+  // when they send it.
+  auto builder = std::make_unique<slk::Builder>([&encoded](const uint8_t *segment, size_t /*size*/,
+                                                           bool /*have_more*/) {
+    slk::SegmentSize data_size{0};
+    memcpy(&data_size, segment, sizeof(slk::SegmentSize));
+    const auto *data = segment + sizeof(slk::SegmentSize);
+    encoded.data.insert(encoded.data.end(), data, data + data_size);
+  });
+  replication::Encoder encoder(builder.get());
+  bool empty = true;
+  // The builder is flushed before each delta, so that the encoded data is
+  // complete when the position of the delta is taken.
+  EncodeTransactionDeltas(&encoder, name_id_mapper, items, transaction, &encoded, [&] {
+    if (!empty) builder->Finalize();
+    empty = false;
+    return encoded.data.size();
   });
+  builder->Finalize();
+  return encoded;
+}
+}  // namespace
 
-  // Add a delta that indicates that the transaction is fully written to the WAL
-  // file.replication_clients_.WithLock
-  wal_file_->AppendTransactionEnd(final_commit_timestamp);
+InMemoryStorage::EncodedTransaction InMemoryStorage::EncodeTransaction(const Transaction &transaction) {
+  EncodedTransaction encoded;
+  if (config_.durability.snapshot_wal_mode != Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL) {
+    return encoded;
+  }
+  encoded.wal = EncodeWalDeltas(transaction, name_id_mapper_.get(), config_.items);
+  if (replication_state_.GetRole() == replication::ReplicationRole::MAIN && replication_state_.HasReplicas()) {
+    encoded.replication = EncodeReplicationDeltas(transaction, name_id_mapper_.get(), config_.items);
+  }
+  return encoded;
+}
+
+bool InMemoryStorage::AppendToWalDataManipulation(const Transaction &transaction, EncodedTransaction *encoded,
+                                                  uint64_t final_commit_timestamp) {
+  if (!InitializeWalFile()) {
+    return true;
+  }
+  // A single transaction will always be contained in a single WAL file.
+  replication_state_.InitializeTransaction(wal_file_->SequenceNumber());
+
+  // The transaction is encoded here only if the replicas were registered or
+  // the role changed after it was encoded.
+  if (!encoded->wal) {
+    encoded->wal = EncodeWalDeltas(transaction, name_id_mapper_.get(), config_.items);
+  }
+  if (!encoded->replication && replication_state_.GetRole() == replication::ReplicationRole::MAIN &&
+      replication_state_.HasReplicas()) {
+    encoded->replication = EncodeReplicationDeltas(transaction, name_id_mapper_.get(), config_.items);
+  }
+
+  encoded->wal->SetTimestamp(final_commit_timestamp);
+  wal_file_->AppendEncodedDeltas(*encoded->wal, final_commit_timestamp);
+  if (encoded->replication) {
+    encoded->replication->SetTimestamp(final_commit_timestamp);
+    replication_state_.AppendEncodedDeltas(encoded->replication->data);
+  }
   FinalizeWalFile();
 
-  return replication_state_.FinalizeTransaction(final_commit_timestamp);
+  return replication_state_.FinalizeTransaction();
 }
 
 bool InMemoryStorage::AppendToWalDataDefinition(durability::StorageGlobalOperation operation, LabelId label,
-                                                const std::set<PropertyId> &properties,
+                                                const std::vector<PropertyId> &properties,
                                                 uint64_t final_commit_timestamp) {
   if (!InitializeWalFile()) {
     return true;
@@ -1660,10 +3022,27 @@ bool InMemoryStorage::AppendToWalDataDefinition(durability::StorageGlobalOperati
 
   wal_file_->AppendOperation(operation, label, properties, final_commit_timestamp);
   FinalizeWalFile();
+  if (config_.durability.wal_group_commit) {
+    // Operations are done while holding the unique storage lock, so there
+    // are no concurrent commits to wait for.
+    WaitForWalSync(wal_written_transactions_);
+  }
   return replication_state_.AppendOperation(wal_file_->SequenceNumber(), operation, label, properties,
                                             final_commit_timestamp);
 }
 
+bool InMemoryStorage::SkipPeriodicSnapshot() const {
+  if (config_.durability.snapshot_wal_mode != Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL ||
+      config_.durability.snapshot_min_changed_percent == 0) {
+    return false;
+  }
+  // Every delta changes at most one object, so this overestimates the number
+  // of changed objects, which only makes the snapshots more frequent.
+  const auto changed = deltas_since_snapshot_.load(std::memory_order_acquire);
+  const auto objects = vertices_.size() + edges_.size();
+  return changed * 100 < objects * config_.durability.snapshot_min_changed_percent;
+}
+
 utils::BasicResult<InMemoryStorage::CreateSnapshotError> InMemoryStorage::CreateSnapshot(
     std::optional<bool> is_periodic) {
   if (replication_state_.GetRole() != replication::ReplicationRole::MAIN) {
@@ -1673,12 +3052,15 @@ utils::BasicResult<InMemoryStorage::CreateSnapshotError> InMemoryStorage::Create
   auto snapshot_creator = [this]() {
     utils::Timer timer;
     const auto &epoch = replication_state_.GetEpoch();
+    // The changes of the transactions that are counted before the snapshot
+    // transaction starts are all visible to it.
+    deltas_since_snapshot_.store(0, std::memory_order_release);
     auto transaction = CreateTransaction(IsolationLevel::SNAPSHOT_ISOLATION, storage_mode_);
     // Create snapshot.
     durability::CreateSnapshot(&transaction, snapshot_directory_, wal_directory_,
                                config_.durability.snapshot_retention_count, &vertices_, &edges_, name_id_mapper_.get(),
                                &indices_, &constraints_, config_, uuid_, epoch.id, replication_state_.history,
-                               &file_retainer_);
+                               &file_retainer_, &snapshot_progress_, replication_state_.OldestReplicaCommitTimestamp());
     // Finalize snapshot transaction.
     commit_log_->MarkFinished(transaction.start_timestamp);
 
@@ -1688,11 +3070,16 @@ utils::BasicResult<InMemoryStorage::CreateSnapshotError> InMemoryStorage::Create
 
   std::lock_guard snapshot_guard(snapshot_lock_);
 
+  if (is_periodic && *is_periodic && SkipPeriodicSnapshot()) {
+    spdlog::info("Skipping the periodic snapshot, the changes since the last snapshot are kept in the WAL files.");
+    return {};
+  }
+
   auto should_try_shared{true};
   auto max_num_tries{10};
   while (max_num_tries) {
     if (should_try_shared) {
-      std::shared_lock<utils::RWLock> storage_guard(main_lock_);
+      std::shared_lock<MainLock> storage_guard(main_lock_);
       if (storage_mode_ == memgraph::storage::StorageMode::IN_MEMORY_TRANSACTIONAL) {
         snapshot_creator();
         return {};
@@ -1714,7 +3101,7 @@ utils::BasicResult<InMemoryStorage::CreateSnapshotError> InMemoryStorage::Create
   return CreateSnapshotError::ReachedMaxNumTries;
 }
 
-void InMemoryStorage::FreeMemory(std::unique_lock<utils::RWLock> main_guard) {
+void InMemoryStorage::FreeMemory(std::unique_lock<MainLock> main_guard) {
   CollectGarbage<true>(std::move(main_guard));
 
   // SkipList is already threadsafe
@@ -1723,6 +3110,14 @@ void InMemoryStorage::FreeMemory(std::unique_lock<utils::RWLock> main_guard) {
 
   static_cast<InMemoryLabelIndex *>(indices_.label_index_.get())->RunGC();
   static_cast<InMemoryLabelPropertyIndex *>(indices_.label_property_index_.get())->RunGC();
+  static_cast<InMemoryLabelPropertyCompositeIndex *>(indices_.label_property_composite_index_.get())->RunGC();
+  static_cast<InMemoryEdgeTypeIndex *>(indices_.edge_type_index_.get())->RunGC();
+  static_cast<InMemoryEdgeTypePropertyIndex *>(indices_.edge_type_property_index_.get())->RunGC();
+  static_cast<InMemoryTextIndex *>(indices_.text_index_.get())->RunGC();
+}
+
+void InMemoryStorage::RebuildAggregateIndices() {
+  static_cast<InMemoryAggregateIndex *>(indices_.aggregate_index_.get())->RebuildIndices(vertices_.access());
 }
 
 uint64_t InMemoryStorage::CommitTimestamp(const std::optional<uint64_t> desired_commit_timestamp) {
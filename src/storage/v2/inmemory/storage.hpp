@@ -11,10 +11,28 @@
 
 #pragma once
 
+#include <array>
+#include <condition_variable>
 #include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "storage/v2/cold_value_store.hpp"
+#include "storage/v2/durability/snapshot.hpp"
+#include "storage/v2/gid_allocator.hpp"
+#include "storage/v2/inmemory/aggregate_index.hpp"
+#include "storage/v2/inmemory/edge_type_index.hpp"
+#include "storage/v2/inmemory/edge_type_property_index.hpp"
 #include "storage/v2/inmemory/label_index.hpp"
+#include "storage/v2/inmemory/label_property_composite_index.hpp"
 #include "storage/v2/inmemory/label_property_index.hpp"
+#include "storage/v2/inmemory/text_index.hpp"
+#include "storage/v2/inmemory/vector_index.hpp"
+#include "storage/v2/read_only_transactions.hpp"
 #include "storage/v2/storage.hpp"
+#include "utils/thread_pool.hpp"
 
 /// REPLICATION ///
 #include "storage/v2/replication/config.hpp"
@@ -57,7 +75,8 @@ class InMemoryStorage final : public Storage {
    private:
     friend class InMemoryStorage;
 
-    explicit InMemoryAccessor(InMemoryStorage *storage, IsolationLevel isolation_level, StorageMode storage_mode);
+    explicit InMemoryAccessor(InMemoryStorage *storage, IsolationLevel isolation_level, StorageMode storage_mode,
+                              bool read_only = false);
 
    public:
     InMemoryAccessor(const InMemoryAccessor &) = delete;
@@ -82,16 +101,53 @@ class InMemoryStorage final : public Storage {
                                                   mem_storage->config_.items));
     }
 
+    VerticesIterable Vertices(Gid lower_bound, View view) override {
+      auto *mem_storage = static_cast<InMemoryStorage *>(storage_);
+      return VerticesIterable(AllVerticesIterable(mem_storage->vertices_.access(), &transaction_, view,
+                                                  &mem_storage->indices_, &mem_storage->constraints_,
+                                                  mem_storage->config_.items, lower_bound, std::nullopt));
+    }
+
+    /// Splits the vertices by sampling gids from the vertex skip list, see
+    /// `utils::SkipList::Accessor::partition_points`.
+    std::vector<VerticesIterable> PartitionVertices(View view, uint64_t max_partitions) override;
+
+    /// Splits the vertices by sampling the entries of the label index, see
+    /// `InMemoryLabelIndex::PartitionVertices`.
+    std::vector<VerticesIterable> PartitionVertices(LabelId label, View view, uint64_t max_partitions) override;
+
     VerticesIterable Vertices(LabelId label, View view) override;
 
+    VerticesIterable Vertices(LabelId label, const std::vector<LabelId> &filter_labels, View view) override;
+
+    VerticesIterable Vertices(LabelId label, const std::vector<LabelId> &filter_labels,
+                              const std::vector<std::pair<PropertyId, PropertyValue>> &filter_properties,
+                              View view) override;
+
     VerticesIterable Vertices(LabelId label, PropertyId property, View view) override;
 
     VerticesIterable Vertices(LabelId label, PropertyId property, const PropertyValue &value, View view) override;
 
+    VerticesIterable Vertices(LabelId label, PropertyId property, const std::vector<PropertyValue> &values,
+                              View view) override;
+
     VerticesIterable Vertices(LabelId label, PropertyId property,
                               const std::optional<utils::Bound<PropertyValue>> &lower_bound,
                               const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view) override;
 
+    VerticesIterable Vertices(LabelId label, const std::vector<PropertyId> &properties,
+                              const std::vector<PropertyValue> &prefix,
+                              const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+                              const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view) override;
+
+    EdgesIterable Edges(EdgeTypeId edge_type, View view) override;
+
+    EdgesIterable Edges(EdgeTypeId edge_type, PropertyId property, const PropertyValue &value, View view) override;
+
+    EdgesIterable Edges(EdgeTypeId edge_type, PropertyId property,
+                        const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+                        const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view) override;
+
     /// Return approximate number of all vertices in the database.
     /// Note that this is always an over-estimate and never an under-estimate.
     uint64_t ApproximateVertexCount() const override {
@@ -130,6 +186,53 @@ class InMemoryStorage final : public Storage {
           label, property, lower, upper);
     }
 
+    /// Return approximate number of vertices in the composite index on the
+    /// given label and properties.
+    uint64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties) const override {
+      return static_cast<InMemoryStorage *>(storage_)
+          ->indices_.label_property_composite_index_->ApproximateVertexCount(label, properties);
+    }
+
+    /// Return approximate number of vertices in the composite index on the
+    /// given label and properties, whose values of the leading properties are
+    /// equal to `prefix` and whose value of the following property is inside of
+    /// the bounds.
+    uint64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties,
+                                    const std::vector<PropertyValue> &prefix,
+                                    const std::optional<utils::Bound<PropertyValue>> &lower,
+                                    const std::optional<utils::Bound<PropertyValue>> &upper) const override {
+      return static_cast<InMemoryStorage *>(storage_)
+          ->indices_.label_property_composite_index_->ApproximateVertexCount(label, properties, prefix, lower, upper);
+    }
+
+    /// Return approximate number of edges in the edge-type index.
+    uint64_t ApproximateEdgeCount(EdgeTypeId edge_type) const override {
+      return static_cast<InMemoryStorage *>(storage_)->indices_.edge_type_index_->ApproximateEdgeCount(edge_type);
+    }
+
+    /// Return approximate number of edges in the edge-type+property index.
+    uint64_t ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property) const override {
+      return static_cast<InMemoryStorage *>(storage_)->indices_.edge_type_property_index_->ApproximateEdgeCount(
+          edge_type, property);
+    }
+
+    /// Return approximate number of edges with the given edge type and value
+    /// for the given property.
+    uint64_t ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property,
+                                  const PropertyValue &value) const override {
+      return static_cast<InMemoryStorage *>(storage_)->indices_.edge_type_property_index_->ApproximateEdgeCount(
+          edge_type, property, value);
+    }
+
+    /// Return approximate number of edges with the given edge type and value
+    /// for the given property in the range defined by the bounds.
+    uint64_t ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property,
+                                  const std::optional<utils::Bound<PropertyValue>> &lower,
+                                  const std::optional<utils::Bound<PropertyValue>> &upper) const override {
+      return static_cast<InMemoryStorage *>(storage_)->indices_.edge_type_property_index_->ApproximateEdgeCount(
+          edge_type, property, lower, upper);
+    }
+
     template <typename TResult, typename TIndex, typename TIndexKey>
     std::optional<TResult> GetIndexStatsForIndex(TIndex *index, TIndexKey &&key) const {
       return index->GetIndexStats(key);
@@ -208,10 +311,22 @@ class InMemoryStorage final : public Storage {
     Result<std::optional<std::pair<VertexAccessor, std::vector<EdgeAccessor>>>> DetachDeleteVertex(
         VertexAccessor *vertex) override;
 
+    /// Unlike deleting the vertices one by one, which locks both endpoints of
+    /// every edge, each of the vertices and their neighbors is locked and
+    /// changed once, and the edges are removed from the adjacency lists of the
+    /// neighbors in a single pass per list.
+    /// @throw std::bad_alloc
+    Result<std::pair<std::vector<VertexAccessor>, std::vector<EdgeAccessor>>> DetachDeleteVertices(
+        const std::vector<VertexAccessor *> &vertices) override;
+
     void PrefetchInEdges(const VertexAccessor &vertex_acc) override{};
 
     void PrefetchOutEdges(const VertexAccessor &vertex_acc) override{};
 
+    void PrefetchInEdges(const std::vector<VertexAccessor> &vertices) override {}
+
+    void PrefetchOutEdges(const std::vector<VertexAccessor> &vertices) override {}
+
     /// @throw std::bad_alloc
     Result<EdgeAccessor> CreateEdge(VertexAccessor *from, VertexAccessor *to, EdgeTypeId edge_type) override;
 
@@ -227,6 +342,43 @@ class InMemoryStorage final : public Storage {
       return static_cast<InMemoryStorage *>(storage_)->indices_.label_property_index_->IndexExists(label, property);
     }
 
+    bool LabelPropertyCompositeIndexExists(LabelId label, const std::vector<PropertyId> &properties) const override {
+      return static_cast<InMemoryStorage *>(storage_)->indices_.label_property_composite_index_->IndexExists(
+          label, properties);
+    }
+
+    bool EdgeTypeIndexExists(EdgeTypeId edge_type) const override {
+      return static_cast<InMemoryStorage *>(storage_)->indices_.edge_type_index_->IndexExists(edge_type);
+    }
+
+    bool EdgeTypePropertyIndexExists(EdgeTypeId edge_type, PropertyId property) const override {
+      return static_cast<InMemoryStorage *>(storage_)->indices_.edge_type_property_index_->IndexExists(edge_type,
+                                                                                                       property);
+    }
+
+    bool TextIndexExists(LabelId label, PropertyId property) const override {
+      return static_cast<InMemoryStorage *>(storage_)->indices_.text_index_->IndexExists(label, property);
+    }
+
+    std::vector<TextSearchResult> TextSearch(LabelId label, PropertyId property, std::string_view query,
+                                             uint64_t limit, View view) override;
+
+    bool VectorIndexExists(LabelId label, PropertyId property) const override {
+      return static_cast<InMemoryStorage *>(storage_)->indices_.vector_index_->IndexExists(label, property);
+    }
+
+    std::optional<std::vector<VectorSearchResult>> VectorSearch(LabelId label, PropertyId property,
+                                                                std::span<const float> query, uint64_t k,
+                                                                View view) override;
+
+    bool AggregateIndexExists(LabelId label, PropertyId group_property, PropertyId value_property) const override {
+      return static_cast<InMemoryStorage *>(storage_)->indices_.aggregate_index_->IndexExists(
+          {label, group_property, value_property});
+    }
+
+    std::optional<std::vector<AggregateGroup>> AggregateIndexLookup(LabelId label, PropertyId group_property,
+                                                                    PropertyId value_property) override;
+
     IndicesInfo ListAllIndices() const override {
       const auto *mem_storage = static_cast<InMemoryStorage *>(storage_);
       return mem_storage->ListAllIndices();
@@ -242,6 +394,8 @@ class InMemoryStorage final : public Storage {
     /// * `ReplicationError`: there is at least one SYNC replica that has not confirmed receiving the transaction.
     /// * `ConstraintViolation`: the changes made by this transaction violate an existence or unique constraint. In this
     /// case the transaction is automatically aborted.
+    /// * `SerializationError`: a commutative update of the transaction conflicts with another transaction, see
+    /// `VertexAccessor::AddToProperty`. In this case the transaction is automatically aborted.
     /// @throw std::bad_alloc
     // NOLINTNEXTLINE(google-default-arguments)
     utils::BasicResult<StorageDataManipulationError, void> Commit(
@@ -252,7 +406,15 @@ class InMemoryStorage final : public Storage {
 
     void FinalizeTransaction() override;
 
+    utils::BasicResult<StorageDataManipulationError, void> PeriodicCommit() override;
+
    protected:
+    /// Applies the commutative updates of the transaction, see
+    /// `VertexAccessor::AddToProperty`. Returns false if an update can't be
+    /// applied, in which case the transaction has to be aborted.
+    /// @throw std::bad_alloc
+    bool ApplyCommutativeUpdates();
+
     // TODO Better naming
     /// @throw std::bad_alloc
     VertexAccessor CreateVertexEx(storage::Gid gid);
@@ -284,6 +446,16 @@ class InMemoryStorage final : public Storage {
         new InMemoryAccessor{this, override_isolation_level.value_or(isolation_level_), storage_mode_});
   }
 
+  /// The read-only transactions of the snapshot isolation in the
+  /// transactional mode take the last published snapshot without the engine
+  /// lock and aren't added to the commit log.
+  std::unique_ptr<Storage::Accessor> ReadOnlyAccess(std::optional<IsolationLevel> override_isolation_level) override {
+    const auto isolation_level = override_isolation_level.value_or(isolation_level_);
+    const bool read_only =
+        isolation_level == IsolationLevel::SNAPSHOT_ISOLATION && storage_mode_ == StorageMode::IN_MEMORY_TRANSACTIONAL;
+    return std::unique_ptr<InMemoryAccessor>(new InMemoryAccessor{this, isolation_level, storage_mode_, read_only});
+  }
+
   /// Create an index.
   /// Returns void if the index has been created.
   /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
@@ -302,6 +474,17 @@ class InMemoryStorage final : public Storage {
   utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(
       LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp) override;
 
+  /// Create a composite index on the given label and at least two properties.
+  /// The order of the properties defines the order of the index entries.
+  /// Returns void if the index has been created.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
+  /// * `IndexDefinitionError`: the index already exists.
+  /// @throw std::bad_alloc
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(
+      LabelId label, const std::vector<PropertyId> &properties,
+      std::optional<uint64_t> desired_commit_timestamp) override;
+
   /// Drop an existing index.
   /// Returns void if the index has been dropped.
   /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
@@ -318,6 +501,101 @@ class InMemoryStorage final : public Storage {
   utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(
       LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp) override;
 
+  /// Drop an existing composite index.
+  /// Returns void if the index has been dropped.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
+  /// * `IndexDefinitionError`: the index does not exist.
+  utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(
+      LabelId label, const std::vector<PropertyId> &properties,
+      std::optional<uint64_t> desired_commit_timestamp) override;
+
+  /// Create an index on all edges of the given edge type.
+  /// Returns void if the index has been created.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `IndexDefinitionError`: the index already exists.
+  /// @throw std::bad_alloc
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(EdgeTypeId edge_type) override;
+
+  /// Create an index on the given property of the edges of the given edge
+  /// type. Requires properties on edges to be enabled.
+  /// Returns void if the index has been created.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `IndexDefinitionError`: the index already exists or properties on edges are disabled.
+  /// @throw std::bad_alloc
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(EdgeTypeId edge_type,
+                                                                    PropertyId property) override;
+
+  /// Drop an existing edge-type index.
+  /// Returns void if the index has been dropped.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `IndexDefinitionError`: the index does not exist.
+  utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(EdgeTypeId edge_type) override;
+
+  /// Drop an existing edge-type+property index.
+  /// Returns void if the index has been dropped.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `IndexDefinitionError`: the index does not exist.
+  utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(EdgeTypeId edge_type, PropertyId property) override;
+
+  /// Create a full-text index on the string values of the given property of
+  /// the vertices with the given label.
+  /// Returns void if the index has been created.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
+  /// * `IndexDefinitionError`: the index already exists.
+  /// @throw std::bad_alloc
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateTextIndex(
+      LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp) override;
+
+  /// Drop an existing full-text index.
+  /// Returns void if the index has been dropped.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
+  /// * `IndexDefinitionError`: the index does not exist.
+  utils::BasicResult<StorageIndexDefinitionError, void> DropTextIndex(
+      LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp) override;
+
+  /// Create an approximate nearest neighbour index on the vectors, which are
+  /// the list values of the given property of the vertices with the given
+  /// label.
+  /// Returns void if the index has been created.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
+  /// * `IndexDefinitionError`: the index already exists.
+  /// @throw std::bad_alloc
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateVectorIndex(
+      LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp) override;
+
+  /// Drop an existing vector index.
+  /// Returns void if the index has been dropped.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
+  /// * `IndexDefinitionError`: the index does not exist.
+  utils::BasicResult<StorageIndexDefinitionError, void> DropVectorIndex(
+      LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp) override;
+
+  /// Create an index of the count, the sum, the minimum and the maximum of the
+  /// values of `value_property` over the vertices with the given label,
+  /// grouped by the value of `group_property`.
+  /// Returns void if the index has been created.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
+  /// * `IndexDefinitionError`: the index already exists.
+  /// @throw std::bad_alloc
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateAggregateIndex(
+      LabelId label, PropertyId group_property, PropertyId value_property,
+      std::optional<uint64_t> desired_commit_timestamp) override;
+
+  /// Drop an existing aggregate index.
+  /// Returns void if the index has been dropped.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
+  /// * `IndexDefinitionError`: the index does not exist.
+  utils::BasicResult<StorageIndexDefinitionError, void> DropAggregateIndex(
+      LabelId label, PropertyId group_property, PropertyId value_property,
+      std::optional<uint64_t> desired_commit_timestamp) override;
+
   /// Returns void if the existence constraint has been created.
   /// Returns `StorageExistenceConstraintDefinitionError` if an error occures. Error can be:
   /// * `ReplicationError`: there is at least one SYNC replica that has not confirmed receiving the transaction.
@@ -360,7 +638,25 @@ class InMemoryStorage final : public Storage {
   utils::BasicResult<StorageUniqueConstraintDroppingError, UniqueConstraints::DeletionStatus> DropUniqueConstraint(
       LabelId label, const std::set<PropertyId> &properties, std::optional<uint64_t> desired_commit_timestamp) override;
 
-  void FreeMemory(std::unique_lock<utils::RWLock> main_guard) override;
+  void FreeMemory(std::unique_lock<MainLock> main_guard) override;
+
+  void RebuildAggregateIndices() override;
+
+  /// Moves the property buffers of at most `budget` vertices and at most
+  /// `budget` edges out of the sparsely used allocator extents, continuing
+  /// after the objects visited by the previous call. The objects with
+  /// uncommitted or unreclaimed changes are skipped. Returns the number of
+  /// moved buffers.
+  uint64_t DefragmentMemory(uint64_t budget);
+
+  /// Visits at most `budget` vertices and at most `budget` edges, continuing
+  /// after the objects visited by the previous call. The large property values
+  /// of the objects whose properties weren't read since the previous visit are
+  /// evicted to the cold value store, and the evicted values of the objects
+  /// which were read at least `kHotPropertyReads` times are loaded back. The
+  /// objects with uncommitted or unreclaimed changes are skipped. Returns the
+  /// number of evicted bytes.
+  uint64_t TierPropertyValues(uint64_t budget);
 
   utils::FileRetainer::FileLockerAccessor::ret_type IsPathLocked();
   utils::FileRetainer::FileLockerAccessor::ret_type LockPath();
@@ -370,6 +666,8 @@ class InMemoryStorage final : public Storage {
 
   Transaction CreateTransaction(IsolationLevel isolation_level, StorageMode storage_mode) override;
 
+  Transaction CreateReadOnlyTransaction(IsolationLevel isolation_level, StorageMode storage_mode) override;
+
   auto CreateReplicationClient(std::string name, io::network::Endpoint endpoint, replication::ReplicationMode mode,
                                replication::ReplicationClientConfig const &config)
       -> std::unique_ptr<ReplicationClient> override;
@@ -390,26 +688,94 @@ class InMemoryStorage final : public Storage {
   /// @throw std::system_error
   /// @throw std::bad_alloc
   template <bool force>
-  void CollectGarbage(std::unique_lock<utils::RWLock> main_guard = {});
+  void CollectGarbage(std::unique_lock<MainLock> main_guard = {});
+
+  /// Runs `tasks` on the calling thread and the GC thread pool and waits until
+  /// all of them are done.
+  void RunGcTasks(std::vector<std::function<void()>> &tasks);
+
+  /// Returns the timestamp before which the committed transactions can be
+  /// unlinked while the snapshot with `snapshot_timestamp` is being created
+  /// and it's the oldest active transaction. These are the transactions that
+  /// committed before the oldest other active transaction started and only
+  /// changed the objects the snapshot has already written.
+  uint64_t SnapshotUnlinkTimestamp(uint64_t snapshot_timestamp, uint64_t oldest_active_except_snapshot);
+
+  /// Called by the GC runner on every tick of the `INCREMENTAL` GC. Runs a GC
+  /// cycle only if there is enough pending work or nothing ran for a while.
+  void RunIncrementalGc();
+
+  /// Number of committed changes of the labels and the properties of vertices.
+  struct IndexStatsChanges {
+    std::map<LabelId, uint64_t> labels;
+    std::map<PropertyId, uint64_t> properties;
+  };
+
+  /// Counts the changes of the labels and the properties of the vertex done by
+  /// the transaction. The transaction has to be the last one that modified the
+  /// vertex and it must not be committed yet.
+  static void CountIndexStatsChanges(const Vertex &vertex, const Transaction &transaction, IndexStatsChanges *changes);
+
+  /// Called by the index statistics runner. Recomputes the statistics of the
+  /// indices whose label and property changed by more than
+  /// `config_.index_stats.refresh_threshold` of the indexed vertices since
+  /// their statistics were last refreshed.
+  void RefreshIndexStats();
 
   bool InitializeWalFile();
   void FinalizeWalFile();
 
+  /// Used with WAL group commit. Blocks until the first `transactions` written
+  /// to the WAL are synced to disk. One of the waiting threads syncs the WAL
+  /// on behalf of all of them while the others wait for it.
+  void WaitForWalSync(uint64_t transactions);
+
   StorageInfo GetInfo() const override;
 
+  /// The deltas of a transaction encoded for the WAL and for the replicas, see
+  /// `EncodeTransaction`.
+  struct EncodedTransaction {
+    std::optional<durability::EncodedDeltas> wal;
+    std::optional<durability::EncodedDeltas> replication;
+  };
+
+  /// Encodes the deltas of the transaction, which is about to commit, without
+  /// their commit timestamp. It's called before the engine lock is taken, so
+  /// that only the commit timestamp has to be written into the encoded deltas
+  /// while holding it. The deltas are encoded for the replicas only once, no
+  /// matter how many of them there are.
+  EncodedTransaction EncodeTransaction(const Transaction &transaction);
+
   /// Return true in all cases excepted if any sync replicas have not sent confirmation.
-  [[nodiscard]] bool AppendToWalDataManipulation(const Transaction &transaction, uint64_t final_commit_timestamp);
+  [[nodiscard]] bool AppendToWalDataManipulation(const Transaction &transaction, EncodedTransaction *encoded,
+                                                 uint64_t final_commit_timestamp);
   /// Return true in all cases excepted if any sync replicas have not sent confirmation.
   [[nodiscard]] bool AppendToWalDataDefinition(durability::StorageGlobalOperation operation, LabelId label,
-                                               const std::set<PropertyId> &properties, uint64_t final_commit_timestamp);
+                                               const std::vector<PropertyId> &properties,
+                                               uint64_t final_commit_timestamp);
 
   uint64_t CommitTimestamp(std::optional<uint64_t> desired_commit_timestamp = {});
 
+  /// Number of threads used to populate a new index while the storage keeps
+  /// serving transactions.
+  uint64_t IndexCreationThreadCount() const;
+
+  /// Whether a periodic snapshot can be skipped because too little changed
+  /// since the last one.
+  bool SkipPeriodicSnapshot() const;
+
   void EstablishNewEpoch() override;
 
+  // The large property values evicted by the tiering, if it's enabled. It's
+  // declared before the objects, whose property stores reference it.
+  std::unique_ptr<ColdValueStore> cold_value_store_;
+
   // Main object storage
   utils::SkipList<storage::Vertex> vertices_;
   utils::SkipList<storage::Edge> edges_;
+  // Allocate the gids from `vertex_id_` and `edge_id_`.
+  GidAllocator vertex_gids_{&vertex_id_};
+  GidAllocator edge_gids_{&edge_id_};
 
   // Durability
   std::filesystem::path snapshot_directory_;
@@ -419,14 +785,25 @@ class InMemoryStorage final : public Storage {
 
   utils::Scheduler snapshot_runner_;
   utils::SpinLock snapshot_lock_;
+  // Progress of the snapshot that is being created, used by the GC.
+  durability::SnapshotProgress snapshot_progress_;
 
   // UUID used to distinguish snapshots and to link snapshots to WALs
   std::string uuid_;
   // Sequence number used to keep track of the chain of WALs.
   uint64_t wal_seq_num_{0};
 
+  // Preallocated files that new WAL files are created from.
+  std::optional<durability::WalSegmentPool> wal_segment_pool_;
   std::optional<durability::WalFile> wal_file_;
   uint64_t wal_unsynced_transactions_{0};
+  // Number of transactions written to the WAL so far, guarded by `engine_lock_`.
+  uint64_t wal_written_transactions_{0};
+  // State of the WAL group commit, guarded by `wal_sync_lock_`.
+  std::mutex wal_sync_lock_;
+  std::condition_variable wal_sync_cv_;
+  uint64_t wal_synced_transactions_{0};
+  bool wal_sync_in_progress_{false};
 
   utils::FileRetainer file_retainer_;
 
@@ -438,12 +815,29 @@ class InMemoryStorage final : public Storage {
   // `timestamp_` in a sensible unit, something like TransactionClock or
   // whatever.
   std::optional<CommitLog> commit_log_;
-  utils::Synchronized<std::list<Transaction>, utils::SpinLock> committed_transactions_;
+  // The snapshot is published while holding the engine lock whenever a commit
+  // or a transaction of the analytical mode changes the graph.
+  ReadOnlyTransactions read_only_transactions_;
+  // Committed transactions whose deltas weren't unlinked yet. Every thread
+  // hands its transactions over to one of the shards, so that committing
+  // threads and the GC don't all contend on a single lock. Each shard is
+  // ordered by the time the transactions were handed over.
+  static constexpr size_t kCommittedTransactionsShards = 16;
+  std::array<utils::Synchronized<std::list<Transaction>, utils::SpinLock>, kCommittedTransactionsShards>
+      committed_transactions_;
   utils::Scheduler gc_runner_;
   std::mutex gc_lock_;
+  // Workers that help the GC thread when `config_.gc.threads` is larger than 1.
+  std::unique_ptr<utils::ThreadPool> gc_thread_pool_;
 
   // Undo buffers that were unlinked and now are waiting to be freed.
-  utils::Synchronized<std::list<std::pair<uint64_t, std::list<Delta>>>, utils::SpinLock> garbage_undo_buffers_;
+  utils::Synchronized<std::list<std::pair<uint64_t, utils::ChunkedList<Delta>>>, utils::SpinLock> garbage_undo_buffers_;
+  // Undo buffers of the transactions that committed after the snapshot with
+  // `gc_snapshot_timestamp_` started, which were unlinked while the snapshot
+  // was being created. The snapshot doesn't read them, so they only wait for
+  // the other transactions. Guarded by `gc_lock_`.
+  std::list<std::pair<uint64_t, utils::ChunkedList<Delta>>> gc_snapshot_undo_buffers_;
+  uint64_t gc_snapshot_timestamp_{0};
 
   // Vertices that are logically deleted but still have to be removed from
   // indices before removing them from the main storage.
@@ -460,6 +854,41 @@ class InMemoryStorage final : public Storage {
   // Flags to inform CollectGarbage that it needs to do the more expensive full scans
   std::atomic<bool> gc_full_scan_vertices_delete_ = false;
   std::atomic<bool> gc_full_scan_edges_delete_ = false;
+
+  // Number of deltas of committed transactions that weren't unlinked yet.
+  std::atomic<uint64_t> gc_pending_deltas_{0};
+  // Number of deltas committed since the start of the last snapshot, used to
+  // skip periodic snapshots of mostly unchanged data.
+  std::atomic<uint64_t> deltas_since_snapshot_{0};
+  // Number of consecutive `INCREMENTAL` GC ticks that didn't run a cycle. Only
+  // accessed by the GC runner.
+  uint64_t gc_idle_ticks_{0};
+  // Positions at which the `INCREMENTAL` GC resumes the unfinished full scans.
+  // Guarded by `gc_lock_`.
+  std::optional<Gid> gc_full_scan_vertices_next_;
+  std::optional<Gid> gc_full_scan_edges_next_;
+  std::atomic<bool> gc_full_scan_unfinished_ = false;
+
+  // Changes committed since the storage was started. Only counted when the
+  // index statistics refresh is enabled.
+  utils::Synchronized<IndexStatsChanges, utils::SpinLock> index_stats_changes_;
+  // Changes counted in `index_stats_changes_` when the statistics of each
+  // index were last refreshed. Only accessed by the index statistics runner.
+  std::map<LabelId, uint64_t> index_stats_refreshed_labels_;
+  std::map<std::pair<LabelId, PropertyId>, uint64_t> index_stats_refreshed_label_properties_;
+  utils::Scheduler index_stats_runner_;
+
+  // The objects from which the next defragmentation pass continues.
+  std::mutex defragmentation_lock_;
+  Gid defragmentation_next_vertex_{Gid::FromUint(0)};
+  Gid defragmentation_next_edge_{Gid::FromUint(0)};
+  utils::Scheduler defragmentation_runner_;
+
+  // The objects from which the next tiering pass continues.
+  std::mutex tiering_lock_;
+  Gid tiering_next_vertex_{Gid::FromUint(0)};
+  Gid tiering_next_edge_{Gid::FromUint(0)};
+  utils::Scheduler tiering_runner_;
 };
 
 }  // namespace memgraph::storage
@@ -0,0 +1,328 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/inmemory/text_index.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <optional>
+#include <unordered_set>
+
+#include "storage/v2/indices/indices_utils.hpp"
+#include "utils/memory_tracker.hpp"
+
+namespace memgraph::storage {
+
+namespace {
+
+// BM25 parameters which are commonly used by the search engines.
+constexpr double kTermFrequencySaturation = 1.2;
+constexpr double kLengthNormalization = 0.75;
+
+bool IsTokenByte(unsigned char c) { return std::isalnum(c) != 0 || c >= 0x80; }
+
+// Calls `callback` with each token of `text`. The token is only valid during
+// the call.
+template <typename TCallback>
+void ForEachToken(std::string_view text, const TCallback &callback) {
+  std::string token;
+  for (size_t i = 0; i < text.size();) {
+    if (!IsTokenByte(static_cast<unsigned char>(text[i]))) {
+      ++i;
+      continue;
+    }
+    token.clear();
+    for (; i < text.size() && IsTokenByte(static_cast<unsigned char>(text[i])); ++i) {
+      token.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(text[i]))));
+    }
+    callback(std::string_view{token});
+  }
+}
+
+std::vector<std::string> UniqueTokens(std::string_view text) {
+  auto tokens = InMemoryTextIndex::Tokenize(text);
+  std::sort(tokens.begin(), tokens.end());
+  tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+  return tokens;
+}
+
+bool ValueHasToken(const PropertyValue &value, std::string_view token) {
+  if (!value.IsString()) return false;
+  bool found = false;
+  ForEachToken(value.ValueString(), [&](std::string_view current) { found = found || current == token; });
+  return found;
+}
+
+// Returns true if there's a reachable version of the vertex that has the given
+// label and a value of the property which contains the token.
+bool AnyVersionHasLabelToken(const Vertex &vertex, LabelId label, PropertyId key, std::string_view token,
+                             uint64_t timestamp) {
+  bool has_label{false};
+  bool has_token{false};
+  bool deleted{false};
+  const Delta *delta = nullptr;
+  {
+    std::lock_guard guard(vertex.lock);
+    has_label = utils::Contains(vertex.labels, label);
+    has_token = ValueHasToken(vertex.properties.GetProperty(key), token);
+    deleted = vertex.deleted;
+    delta = vertex.delta;
+  }
+
+  if (!deleted && has_label && has_token) {
+    return true;
+  }
+
+  return AnyVersionSatisfiesPredicate(timestamp, delta, [&](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::ADD_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(!has_label, "Invalid database state!");
+          has_label = true;
+        }
+        break;
+      case Delta::Action::REMOVE_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(has_label, "Invalid database state!");
+          has_label = false;
+        }
+        break;
+      case Delta::Action::SET_PROPERTY:
+        if (delta.property.key == key) {
+          has_token = ValueHasToken(delta.property.value, token);
+        }
+        break;
+      case Delta::Action::RECREATE_OBJECT: {
+        MG_ASSERT(deleted, "Invalid database state!");
+        deleted = false;
+        break;
+      }
+      case Delta::Action::DELETE_DESERIALIZED_OBJECT:
+      case Delta::Action::DELETE_OBJECT: {
+        MG_ASSERT(!deleted, "Invalid database state!");
+        deleted = true;
+        break;
+      }
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::ADD_OUT_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::REMOVE_OUT_EDGE:
+        break;
+    }
+    return !deleted && has_label && has_token;
+  });
+}
+
+}  // namespace
+
+InMemoryTextIndex::InMemoryTextIndex(Indices *indices, Constraints *constraints, const Config &config)
+    : TextIndex(indices, constraints, config) {}
+
+std::vector<std::string> InMemoryTextIndex::Tokenize(std::string_view text) {
+  std::vector<std::string> tokens;
+  ForEachToken(text, [&tokens](std::string_view token) { tokens.emplace_back(token); });
+  return tokens;
+}
+
+bool InMemoryTextIndex::CreateIndex(LabelId label, PropertyId property, utils::SkipList<Vertex>::Accessor vertices) {
+  auto [it, emplaced] =
+      index_.emplace(std::piecewise_construct, std::forward_as_tuple(label, property), std::forward_as_tuple());
+  if (!emplaced) {
+    // Index already exists.
+    return false;
+  }
+
+  utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+  try {
+    auto acc = it->second.access();
+    for (Vertex &vertex : vertices) {
+      if (vertex.deleted || !utils::Contains(vertex.labels, label)) continue;
+      auto value = vertex.properties.GetProperty(property);
+      if (!value.IsString()) continue;
+      for (auto &token : UniqueTokens(value.ValueString())) {
+        acc.insert({std::move(token), &vertex, 0});
+      }
+    }
+  } catch (const utils::OutOfMemoryException &) {
+    utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+    index_.erase(it);
+    throw;
+  }
+  return true;
+}
+
+void InMemoryTextIndex::UpdateOnAddLabel(LabelId added_label, Vertex *vertex_after_update, const Transaction &tx) {
+  for (auto &[key, storage] : index_) {
+    if (key.first != added_label) continue;
+    auto value = vertex_after_update->properties.GetProperty(key.second);
+    if (!value.IsString()) continue;
+    auto acc = storage.access();
+    for (auto &token : UniqueTokens(value.ValueString())) {
+      acc.insert({std::move(token), vertex_after_update, tx.start_timestamp});
+    }
+  }
+}
+
+void InMemoryTextIndex::UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
+                                            const Transaction &tx) {
+  // The entries of the previous value are removed by the garbage collection
+  // once no transaction sees that value.
+  if (!value.IsString()) {
+    return;
+  }
+
+  std::optional<std::vector<std::string>> tokens;
+  for (auto &[key, storage] : index_) {
+    if (key.second != property || !utils::Contains(vertex->labels, key.first)) continue;
+    if (!tokens) tokens = UniqueTokens(value.ValueString());
+    auto acc = storage.access();
+    for (const auto &token : *tokens) {
+      acc.insert({token, vertex, tx.start_timestamp});
+    }
+  }
+}
+
+bool InMemoryTextIndex::DropIndex(LabelId label, PropertyId property) {
+  return index_.erase({label, property}) > 0;
+}
+
+bool InMemoryTextIndex::IndexExists(LabelId label, PropertyId property) const {
+  return index_.find({label, property}) != index_.end();
+}
+
+std::vector<std::pair<LabelId, PropertyId>> InMemoryTextIndex::ListIndices() const {
+  std::vector<std::pair<LabelId, PropertyId>> ret;
+  ret.reserve(index_.size());
+  for (const auto &item : index_) {
+    ret.push_back(item.first);
+  }
+  return ret;
+}
+
+void InMemoryTextIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
+  for (auto &[key, index] : index_) {
+    auto index_acc = index.access();
+    for (auto it = index_acc.begin(); it != index_acc.end();) {
+      auto next_it = it;
+      ++next_it;
+
+      if (it->timestamp >= oldest_active_start_timestamp) {
+        it = next_it;
+        continue;
+      }
+
+      if ((next_it != index_acc.end() && it->vertex == next_it->vertex && it->token == next_it->token) ||
+          !AnyVersionHasLabelToken(*it->vertex, key.first, key.second, it->token, oldest_active_start_timestamp)) {
+        index_acc.remove(*it);
+      }
+      it = next_it;
+    }
+  }
+}
+
+std::vector<TextSearchResult> InMemoryTextIndex::Search(LabelId label, PropertyId property, std::string_view query,
+                                                        uint64_t limit, View view, Transaction *transaction) {
+  auto it = index_.find({label, property});
+  MG_ASSERT(it != index_.end(), "Text index for label {} and property {} doesn't exist", label.AsUint(),
+            property.AsUint());
+  const auto tokens = UniqueTokens(query);
+  if (tokens.empty() || limit == 0) return {};
+
+  // The candidates are the vertices with an entry of any of the tokens. The
+  // entries of a vertex and a token are next to each other, so the document
+  // frequency of a token is the number of vertex changes in its entries.
+  auto acc = it->second.access();
+  std::vector<uint64_t> document_frequencies(tokens.size(), 0);
+  std::unordered_set<Vertex *> candidates;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    const Vertex *previous = nullptr;
+    for (auto entry = acc.find_equal_or_greater(std::string_view{tokens[i]});
+         entry != acc.end() && entry->token == tokens[i]; ++entry) {
+      if (entry->vertex == previous) continue;
+      previous = entry->vertex;
+      ++document_frequencies[i];
+      candidates.insert(entry->vertex);
+    }
+  }
+
+  // The entries are only hints, so the frequencies of the tokens are counted
+  // in the values which the transaction sees.
+  struct Match {
+    VertexAccessor vertex;
+    std::vector<uint64_t> term_frequencies;
+    uint64_t length;
+  };
+  std::vector<Match> matches;
+  matches.reserve(candidates.size());
+  uint64_t total_length = 0;
+  for (auto *vertex : candidates) {
+    VertexAccessor accessor(vertex, transaction, indices_, constraints_, config_.items);
+    auto has_label = accessor.HasLabel(label, view);
+    if (has_label.HasError() || !*has_label) continue;
+    auto value = accessor.GetProperty(property, view);
+    if (value.HasError() || !value->IsString()) continue;
+    std::vector<uint64_t> term_frequencies(tokens.size(), 0);
+    uint64_t length = 0;
+    bool matched = false;
+    ForEachToken(value->ValueString(), [&](std::string_view token) {
+      ++length;
+      auto found = std::lower_bound(tokens.begin(), tokens.end(), token);
+      if (found == tokens.end() || *found != token) return;
+      ++term_frequencies[found - tokens.begin()];
+      matched = true;
+    });
+    if (!matched) continue;
+    total_length += length;
+    matches.push_back({accessor, std::move(term_frequencies), length});
+  }
+  if (matches.empty()) return {};
+
+  // The number of entries is an over-estimate of the number of indexed
+  // vertices, which only raises the weight of all tokens equally.
+  const auto document_count = static_cast<double>(std::max<uint64_t>(acc.size(), matches.size()));
+  const auto average_length = static_cast<double>(total_length) / static_cast<double>(matches.size());
+  std::vector<TextSearchResult> results;
+  results.reserve(matches.size());
+  for (const auto &match : matches) {
+    const auto length_ratio = average_length > 0 ? static_cast<double>(match.length) / average_length : 1.0;
+    double score = 0;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+      if (match.term_frequencies[i] == 0) continue;
+      const auto frequency = static_cast<double>(match.term_frequencies[i]);
+      const auto idf = std::log(1.0 + (document_count - static_cast<double>(document_frequencies[i]) + 0.5) /
+                                          (static_cast<double>(document_frequencies[i]) + 0.5));
+      score += idf * frequency * (kTermFrequencySaturation + 1) /
+               (frequency + kTermFrequencySaturation * (1 - kLengthNormalization + kLengthNormalization * length_ratio));
+    }
+    results.push_back({match.vertex, score});
+  }
+
+  const auto better = [](const TextSearchResult &lhs, const TextSearchResult &rhs) {
+    if (lhs.score != rhs.score) return lhs.score > rhs.score;
+    return lhs.vertex.Gid() < rhs.vertex.Gid();
+  };
+  if (results.size() > limit) {
+    std::partial_sort(results.begin(), results.begin() + static_cast<std::ptrdiff_t>(limit), results.end(), better);
+    results.erase(results.begin() + static_cast<std::ptrdiff_t>(limit), results.end());
+  } else {
+    std::sort(results.begin(), results.end(), better);
+  }
+  return results;
+}
+
+void InMemoryTextIndex::RunGC() {
+  for (auto &index_entry : index_) {
+    index_entry.second.run_gc();
+  }
+}
+
+}  // namespace memgraph::storage
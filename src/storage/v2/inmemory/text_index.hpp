@@ -0,0 +1,88 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "storage/v2/indices/text_index.hpp"
+#include "utils/skip_list.hpp"
+
+namespace memgraph::storage {
+
+/// The entries are ordered by the token, so the vertices containing a token
+/// are next to each other. Like the other indices it is updated whenever a
+/// vertex changes and the visibility of the entries is checked when they are
+/// read, so the changed values are found only by the transactions which see
+/// them.
+class InMemoryTextIndex : public storage::TextIndex {
+ private:
+  struct Entry {
+    std::string token;
+    Vertex *vertex;
+    uint64_t timestamp;
+
+    bool operator<(const Entry &rhs) const {
+      return std::tie(token, vertex, timestamp) < std::tie(rhs.token, rhs.vertex, rhs.timestamp);
+    }
+    bool operator==(const Entry &rhs) const {
+      return token == rhs.token && vertex == rhs.vertex && timestamp == rhs.timestamp;
+    }
+
+    bool operator<(std::string_view rhs) const { return token < rhs; }
+    bool operator==(std::string_view rhs) const { return token == rhs; }
+  };
+
+ public:
+  InMemoryTextIndex(Indices *indices, Constraints *constraints, const Config &config);
+
+  /// Splits `text` into tokens. A token is a maximal run of ASCII letters and
+  /// digits and of non-ASCII bytes, so the words of other scripts stay whole.
+  /// The ASCII letters are lowercased.
+  static std::vector<std::string> Tokenize(std::string_view text);
+
+  /// Creates the index with entries for all vertices which have the label and
+  /// a string value of the property. Returns false if the index already
+  /// exists.
+  /// @throw std::bad_alloc
+  bool CreateIndex(LabelId label, PropertyId property, utils::SkipList<Vertex>::Accessor vertices);
+
+  /// @throw std::bad_alloc
+  void UpdateOnAddLabel(LabelId added_label, Vertex *vertex_after_update, const Transaction &tx) override;
+
+  /// @throw std::bad_alloc
+  void UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
+                           const Transaction &tx) override;
+
+  bool DropIndex(LabelId label, PropertyId property) override;
+
+  bool IndexExists(LabelId label, PropertyId property) const override;
+
+  std::vector<std::pair<LabelId, PropertyId>> ListIndices() const override;
+
+  void RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp);
+
+  /// Returns at most `limit` vertices whose value contains any token of
+  /// `query`, ordered by their BM25 score. The number of indexed vertices and
+  /// the average length of the values are estimated from the index and from
+  /// the found values, so the scores are comparable only within one search.
+  std::vector<TextSearchResult> Search(LabelId label, PropertyId property, std::string_view query, uint64_t limit,
+                                       View view, Transaction *transaction);
+
+  void RunGC();
+
+ private:
+  std::map<std::pair<LabelId, PropertyId>, utils::SkipList<Entry>> index_;
+};
+
+}  // namespace memgraph::storage
@@ -11,6 +11,8 @@
 
 #include "storage/v2/inmemory/unique_constraints.hpp"
 
+#include "utils/fnv.hpp"
+
 namespace memgraph::storage {
 
 namespace {
@@ -50,7 +52,7 @@ bool LastCommittedVersionHasLabelProperty(const Vertex &vertex, LabelId label, c
   bool deleted;
   bool has_label;
   {
-    std::lock_guard<utils::SpinLock> guard(vertex.lock);
+    std::lock_guard guard(vertex.lock);
     delta = vertex.delta;
     deleted = vertex.deleted;
     has_label = utils::Contains(vertex.labels, label);
@@ -136,7 +138,7 @@ bool AnyVersionHasLabelProperty(const Vertex &vertex, LabelId label, const std::
   bool deleted;
   Delta *delta;
   {
-    std::lock_guard<utils::SpinLock> guard(vertex.lock);
+    std::lock_guard guard(vertex.lock);
     has_label = utils::Contains(vertex.labels, label);
     deleted = vertex.deleted;
     delta = vertex.delta;
@@ -220,8 +222,129 @@ bool AnyVersionHasLabelProperty(const Vertex &vertex, LabelId label, const std::
   return false;
 }
 
+/// Hashes the property value consistently with its equality, so ints are
+/// hashed as doubles because 2 == 2.0.
+size_t HashPropertyValue(const PropertyValue &value) {
+  switch (value.type()) {
+    case PropertyValue::Type::Null:
+      return 31;
+    case PropertyValue::Type::Bool:
+      return std::hash<bool>{}(value.ValueBool());
+    case PropertyValue::Type::Int:
+      return std::hash<double>{}(static_cast<double>(value.ValueInt()));
+    case PropertyValue::Type::Double:
+      return std::hash<double>{}(value.ValueDouble());
+    case PropertyValue::Type::String:
+      return std::hash<std::string_view>{}(value.ValueString());
+    case PropertyValue::Type::List: {
+      size_t hash = 6543457;
+      for (const auto &item : value.ValueList()) {
+        hash = utils::HashCombine<size_t, size_t>{}(hash, HashPropertyValue(item));
+      }
+      return hash;
+    }
+    case PropertyValue::Type::Map: {
+      size_t hash = 6543457;
+      for (const auto &[key, item] : value.ValueMap()) {
+        hash = utils::HashCombine<size_t, size_t>{}(hash, std::hash<std::string_view>{}(key));
+        hash = utils::HashCombine<size_t, size_t>{}(hash, HashPropertyValue(item));
+      }
+      return hash;
+    }
+    case PropertyValue::Type::TemporalData: {
+      const auto &temporal = value.ValueTemporalData();
+      return utils::HashCombine<size_t, int64_t>{}(static_cast<size_t>(temporal.type), temporal.microseconds);
+    }
+  }
+  LOG_FATAL("Unhandled PropertyValue type in hash function");
+}
+
 }  // namespace
 
+size_t InMemoryUniqueConstraints::ValuesHash::operator()(const std::vector<PropertyValue> &values) const {
+  size_t hash = 14695981039346656037UL;
+  for (const auto &value : values) {
+    hash = utils::HashCombine<size_t, size_t>{}(hash, HashPropertyValue(value));
+  }
+  return hash;
+}
+
+template <typename TPred>
+bool InMemoryUniqueConstraints::ConstraintStorage::AnyVertex(const std::vector<PropertyValue> &values,
+                                                             const TPred &pred) {
+  if (!hashed_) {
+    auto acc = ordered_.access();
+    for (auto it = acc.find_equal_or_greater(values); it != acc.end() && !(values < it->values); ++it) {
+      if (pred(it->vertex)) return true;
+    }
+    return false;
+  }
+  auto &stripe = stripes_[ValuesHash{}(values) % kStripes];
+  std::lock_guard<utils::SpinLock> guard(stripe.lock);
+  auto found = stripe.entries.find(values);
+  if (found == stripe.entries.end()) return false;
+  return std::any_of(found->second.begin(), found->second.end(),
+                     [&pred](const auto &item) { return pred(item.first); });
+}
+
+void InMemoryUniqueConstraints::ConstraintStorage::Insert(std::vector<PropertyValue> values, const Vertex *vertex,
+                                                          uint64_t timestamp) {
+  if (!hashed_) {
+    auto acc = ordered_.access();
+    acc.insert(Entry{std::move(values), vertex, timestamp});
+    return;
+  }
+  auto &stripe = stripes_[ValuesHash{}(values) % kStripes];
+  std::lock_guard<utils::SpinLock> guard(stripe.lock);
+  auto &vertices = stripe.entries[std::move(values)];
+  // Unlike the skip list, the table keeps a single entry per vertex. The newest
+  // timestamp keeps it alive as long as any of the older entries would be.
+  auto found =
+      std::find_if(vertices.begin(), vertices.end(), [vertex](const auto &item) { return item.first == vertex; });
+  if (found != vertices.end()) {
+    found->second = std::max(found->second, timestamp);
+  } else {
+    vertices.emplace_back(vertex, timestamp);
+  }
+}
+
+template <typename TPred>
+void InMemoryUniqueConstraints::ConstraintStorage::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp,
+                                                                         const TPred &is_obsolete) {
+  if (!hashed_) {
+    auto acc = ordered_.access();
+    for (auto it = acc.begin(); it != acc.end();) {
+      auto next_it = it;
+      ++next_it;
+
+      if (it->timestamp >= oldest_active_start_timestamp) {
+        it = next_it;
+        continue;
+      }
+
+      if ((next_it != acc.end() && it->vertex == next_it->vertex && it->values == next_it->values) ||
+          is_obsolete(*it->vertex, it->values)) {
+        acc.remove(*it);
+      }
+      it = next_it;
+    }
+    return;
+  }
+  for (auto &stripe : stripes_) {
+    std::lock_guard<utils::SpinLock> guard(stripe.lock);
+    for (auto it = stripe.entries.begin(); it != stripe.entries.end();) {
+      std::erase_if(it->second, [&](const auto &item) {
+        return item.second < oldest_active_start_timestamp && is_obsolete(*item.first, it->first);
+      });
+      if (it->second.empty()) {
+        it = stripe.entries.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+}
+
 bool InMemoryUniqueConstraints::Entry::operator<(const Entry &rhs) const {
   if (values < rhs.values) {
     return true;
@@ -253,8 +376,7 @@ void InMemoryUniqueConstraints::UpdateBeforeCommit(const Vertex *vertex, const T
         continue;
       }
 
-      auto acc = storage->access();
-      acc.insert(Entry{std::move(*values), vertex, tx.start_timestamp});
+      storage->Insert(std::move(*values), vertex, tx.start_timestamp);
     }
   }
 }
@@ -269,8 +391,8 @@ InMemoryUniqueConstraints::CreateConstraint(LabelId label, const std::set<Proper
     return CreationStatus::PROPERTIES_SIZE_LIMIT_EXCEEDED;
   }
 
-  auto [constraint, emplaced] =
-      constraints_.emplace(std::piecewise_construct, std::forward_as_tuple(label, properties), std::forward_as_tuple());
+  auto [constraint, emplaced] = constraints_.emplace(
+      std::piecewise_construct, std::forward_as_tuple(label, properties), std::forward_as_tuple(hash_index_));
 
   if (!emplaced) {
     // Constraint already exists.
@@ -279,28 +401,23 @@ InMemoryUniqueConstraints::CreateConstraint(LabelId label, const std::set<Proper
 
   bool violation_found = false;
 
-  {
-    auto acc = constraint->second.access();
-
-    for (const Vertex &vertex : vertices) {
-      if (vertex.deleted || !utils::Contains(vertex.labels, label)) {
-        continue;
-      }
-      auto values = vertex.properties.ExtractPropertyValues(properties);
-      if (!values) {
-        continue;
-      }
-
-      // Check whether there already is a vertex with the same values for the
-      // given label and property.
-      auto it = acc.find_equal_or_greater(*values);
-      if (it != acc.end() && it->values == *values) {
-        violation_found = true;
-        break;
-      }
+  for (const Vertex &vertex : vertices) {
+    if (vertex.deleted || !utils::Contains(vertex.labels, label)) {
+      continue;
+    }
+    auto values = vertex.properties.ExtractPropertyValues(properties);
+    if (!values) {
+      continue;
+    }
 
-      acc.insert(Entry{std::move(*values), &vertex, 0});
+    // Check whether there already is a vertex with the same values for the
+    // given label and property.
+    if (constraint->second.AnyVertex(*values, [](const Vertex *) { return true; })) {
+      violation_found = true;
+      break;
     }
+
+    constraint->second.Insert(std::move(*values), &vertex, 0);
   }
 
   if (violation_found) {
@@ -362,21 +479,15 @@ std::optional<ConstraintViolation> InMemoryUniqueConstraints::Validate(const Ver
         continue;
       }
 
-      auto acc = storage->access();
-      auto it = acc.find_equal_or_greater(*value_array);
-      for (; it != acc.end(); ++it) {
-        if (*value_array < it->values) {
-          break;
-        }
-
-        // The `vertex` that is going to be committed violates a unique constraint
-        // if it's different than a vertex indexed in the list of constraints and
-        // has the same label and property value as the last committed version of
-        // the vertex from the list.
-        if (&vertex != it->vertex &&
-            LastCommittedVersionHasLabelProperty(*it->vertex, label, properties, *value_array, tx, commit_timestamp)) {
-          return ConstraintViolation{ConstraintViolation::Type::UNIQUE, label, properties};
-        }
+      // The `vertex` that is going to be committed violates a unique constraint
+      // if it's different than a vertex indexed in the list of constraints and
+      // has the same label and property value as the last committed version of
+      // the vertex from the list.
+      if (storage->AnyVertex(*value_array, [&, &properties = properties](const Vertex *other) {
+            return &vertex != other && LastCommittedVersionHasLabelProperty(*other, label, properties, *value_array,
+                                                                             tx, commit_timestamp);
+          })) {
+        return ConstraintViolation{ConstraintViolation::Type::UNIQUE, label, properties};
       }
     }
   }
@@ -395,23 +506,11 @@ std::vector<std::pair<LabelId, std::set<PropertyId>>> InMemoryUniqueConstraints:
 
 void InMemoryUniqueConstraints::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
   for (auto &[label_props, storage] : constraints_) {
-    auto acc = storage.access();
-    for (auto it = acc.begin(); it != acc.end();) {
-      auto next_it = it;
-      ++next_it;
-
-      if (it->timestamp >= oldest_active_start_timestamp) {
-        it = next_it;
-        continue;
-      }
-
-      if ((next_it != acc.end() && it->vertex == next_it->vertex && it->values == next_it->values) ||
-          !AnyVersionHasLabelProperty(*it->vertex, label_props.first, label_props.second, it->values,
-                                      oldest_active_start_timestamp)) {
-        acc.remove(*it);
-      }
-      it = next_it;
-    }
+    const auto label = label_props.first;
+    const auto &properties = label_props.second;
+    storage.RemoveObsoleteEntries(oldest_active_start_timestamp, [&](const Vertex &vertex, const auto &values) {
+      return !AnyVersionHasLabelProperty(vertex, label, properties, values, oldest_active_start_timestamp);
+    });
   }
 }
 
@@ -11,7 +11,13 @@
 
 #pragma once
 
+#include <array>
+#include <unordered_map>
+
+#include "storage/v2/config.hpp"
 #include "storage/v2/constraints/unique_constraints.hpp"
+#include "utils/skip_list.hpp"
+#include "utils/spin_lock.hpp"
 
 namespace memgraph::storage {
 
@@ -44,7 +50,50 @@ class InMemoryUniqueConstraints : public UniqueConstraints {
     bool operator==(const std::vector<PropertyValue> &rhs) const;
   };
 
+  struct ValuesHash {
+    size_t operator()(const std::vector<PropertyValue> &values) const;
+  };
+
+  /// Entries of a single constraint. They are kept in a skip list ordered by
+  /// the property values or, if `Config::Constraints::unique_hash_index` is
+  /// set, in a hash table split into `kStripes` separately locked stripes.
+  /// Uniqueness checks only look up equal values, so the hash table avoids the
+  /// ordered search done for every committed vertex.
+  class ConstraintStorage {
+   public:
+    explicit ConstraintStorage(bool hashed) : hashed_(hashed) {}
+
+    /// Returns true if any vertex stored with the given `values` satisfies
+    /// `pred`.
+    template <typename TPred>
+    bool AnyVertex(const std::vector<PropertyValue> &values, const TPred &pred);
+
+    /// @throw std::bad_alloc
+    void Insert(std::vector<PropertyValue> values, const Vertex *vertex, uint64_t timestamp);
+
+    /// Removes entries older than `oldest_active_start_timestamp` for which
+    /// `is_obsolete(vertex, values)` returns true.
+    template <typename TPred>
+    void RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp, const TPred &is_obsolete);
+
+   private:
+    static constexpr size_t kStripes = 64;
+
+    struct Stripe {
+      utils::SpinLock lock;
+      std::unordered_map<std::vector<PropertyValue>, std::vector<std::pair<const Vertex *, uint64_t>>, ValuesHash>
+          entries;
+    };
+
+    bool hashed_;
+    utils::SkipList<Entry> ordered_;
+    std::array<Stripe, kStripes> stripes_;
+  };
+
  public:
+  explicit InMemoryUniqueConstraints(const Config &config = {})
+      : hash_index_(config.constraints.unique_hash_index) {}
+
   /// Indexes the given vertex for relevant labels and properties.
   /// This method should be called before committing and validating vertices
   /// against unique constraints.
@@ -89,14 +138,18 @@ class InMemoryUniqueConstraints : public UniqueConstraints {
 
   std::vector<std::pair<LabelId, std::set<PropertyId>>> ListConstraints() const override;
 
+  /// Returns true if there are no unique constraints.
+  bool Empty() const { return constraints_.empty(); }
+
   /// GC method that removes outdated entries from constraints' storages.
   void RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp);
 
   void Clear() override;
 
  private:
-  std::map<std::pair<LabelId, std::set<PropertyId>>, utils::SkipList<Entry>> constraints_;
-  std::map<LabelId, std::map<std::set<PropertyId>, utils::SkipList<Entry> *>> constraints_by_label_;
+  bool hash_index_;
+  std::map<std::pair<LabelId, std::set<PropertyId>>, ConstraintStorage> constraints_;
+  std::map<LabelId, std::map<std::set<PropertyId>, ConstraintStorage *>> constraints_by_label_;
 };
 
 }  // namespace memgraph::storage
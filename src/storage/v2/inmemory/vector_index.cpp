@@ -0,0 +1,449 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/inmemory/vector_index.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "storage/v2/indices/indices_utils.hpp"
+#include "utils/memory_tracker.hpp"
+#include "utils/vector_distance.hpp"
+
+namespace memgraph::storage {
+
+namespace {
+
+// A node of the graph with its distance to the searched vector.
+using Candidate = std::pair<float, uint32_t>;
+
+size_t MaxNeighbours(size_t level) {
+  return level == 0 ? 2 * InMemoryVectorIndex::kMaxNeighbours : InMemoryVectorIndex::kMaxNeighbours;
+}
+
+// Returns the level of a new node. The number of nodes falls exponentially
+// with the level, so the expected number of levels is logarithmic.
+size_t RandomLevel(std::mt19937_64 *generator) {
+  static const double kLevelMultiplier = 1.0 / std::log(static_cast<double>(InMemoryVectorIndex::kMaxNeighbours));
+  std::uniform_real_distribution<double> distribution(std::numeric_limits<double>::min(), 1.0);
+  return static_cast<size_t>(-std::log(distribution(*generator)) * kLevelMultiplier);
+}
+
+bool ValueHasVector(const PropertyValue &value, std::span<const float> vector) {
+  auto value_vector = InMemoryVectorIndex::ToVector(value);
+  return value_vector && std::equal(value_vector->begin(), value_vector->end(), vector.begin(), vector.end());
+}
+
+// Returns true if there's a reachable version of the vertex that has the given
+// label and the vector as the value of the property.
+bool AnyVersionHasLabelVector(const Vertex &vertex, LabelId label, PropertyId key, std::span<const float> vector,
+                              uint64_t timestamp) {
+  bool has_label{false};
+  bool has_vector{false};
+  bool deleted{false};
+  const Delta *delta = nullptr;
+  {
+    std::lock_guard guard(vertex.lock);
+    has_label = utils::Contains(vertex.labels, label);
+    has_vector = ValueHasVector(vertex.properties.GetProperty(key), vector);
+    deleted = vertex.deleted;
+    delta = vertex.delta;
+  }
+
+  if (!deleted && has_label && has_vector) {
+    return true;
+  }
+
+  return AnyVersionSatisfiesPredicate(timestamp, delta, [&](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::ADD_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(!has_label, "Invalid database state!");
+          has_label = true;
+        }
+        break;
+      case Delta::Action::REMOVE_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(has_label, "Invalid database state!");
+          has_label = false;
+        }
+        break;
+      case Delta::Action::SET_PROPERTY:
+        if (delta.property.key == key) {
+          has_vector = ValueHasVector(delta.property.value, vector);
+        }
+        break;
+      case Delta::Action::RECREATE_OBJECT: {
+        MG_ASSERT(deleted, "Invalid database state!");
+        deleted = false;
+        break;
+      }
+      case Delta::Action::DELETE_DESERIALIZED_OBJECT:
+      case Delta::Action::DELETE_OBJECT: {
+        MG_ASSERT(!deleted, "Invalid database state!");
+        deleted = true;
+        break;
+      }
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::ADD_OUT_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::REMOVE_OUT_EDGE:
+        break;
+    }
+    return !deleted && has_label && has_vector;
+  });
+}
+
+template <typename TNodes>
+float Distance(const TNodes &nodes, uint32_t id, std::span<const float> vector) {
+  return utils::NormalizedCosineDistance(nodes[id].vector, vector);
+}
+
+// Returns the node nearest to `vector` which is reachable from `entry_point`
+// by moving to a nearer neighbour on the level.
+template <typename TNodes>
+Candidate SearchNearest(const TNodes &nodes, std::span<const float> vector, Candidate entry_point, size_t level) {
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (const auto neighbour : nodes[entry_point.second].neighbours[level]) {
+      const auto distance = Distance(nodes, neighbour, vector);
+      if (distance < entry_point.first) {
+        entry_point = {distance, neighbour};
+        changed = true;
+      }
+    }
+  }
+  return entry_point;
+}
+
+// Returns at most `count` nodes nearest to `vector` found by visiting the
+// neighbours on the level, ordered from the nearest one.
+template <typename TNodes>
+std::vector<Candidate> SearchLevel(const TNodes &nodes, std::span<const float> vector,
+                                   const std::vector<Candidate> &entry_points, size_t count, size_t level) {
+  std::unordered_set<uint32_t> visited;
+  std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> candidates;
+  // The farthest of the found nodes is on the top.
+  std::priority_queue<Candidate> found;
+  for (const auto &entry_point : entry_points) {
+    visited.insert(entry_point.second);
+    candidates.push(entry_point);
+    found.push(entry_point);
+  }
+  while (found.size() > count) found.pop();
+
+  while (!candidates.empty()) {
+    const auto current = candidates.top();
+    if (found.size() >= count && current.first > found.top().first) break;
+    candidates.pop();
+    for (const auto neighbour : nodes[current.second].neighbours[level]) {
+      if (!visited.insert(neighbour).second) continue;
+      const auto distance = Distance(nodes, neighbour, vector);
+      if (found.size() < count || distance < found.top().first) {
+        candidates.emplace(distance, neighbour);
+        found.emplace(distance, neighbour);
+        if (found.size() > count) found.pop();
+      }
+    }
+  }
+
+  std::vector<Candidate> result;
+  result.reserve(found.size());
+  for (; !found.empty(); found.pop()) {
+    result.push_back(found.top());
+  }
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+// Picks at most `count` of the candidates ordered by their distance. A
+// candidate is skipped if it's nearer to an already picked one than to the
+// searched vector, which keeps the neighbours in different directions, and the
+// skipped ones fill the remaining places.
+template <typename TNodes>
+std::vector<uint32_t> SelectNeighbours(const TNodes &nodes, const std::vector<Candidate> &candidates, size_t count) {
+  std::vector<uint32_t> selected;
+  std::vector<uint32_t> skipped;
+  for (const auto &[distance, id] : candidates) {
+    if (selected.size() >= count) break;
+    const bool diverse = std::all_of(selected.begin(), selected.end(),
+                                     [&nodes, distance = distance, id = id](auto other) {
+                                       return Distance(nodes, other, nodes[id].vector) >= distance;
+                                     });
+    (diverse ? selected : skipped).push_back(id);
+  }
+  for (size_t i = 0; i < skipped.size() && selected.size() < count; ++i) {
+    selected.push_back(skipped[i]);
+  }
+  return selected;
+}
+
+}  // namespace
+
+InMemoryVectorIndex::InMemoryVectorIndex(Indices *indices, Constraints *constraints, const Config &config)
+    : VectorIndex(indices, constraints, config) {}
+
+std::optional<std::vector<float>> InMemoryVectorIndex::ToVector(const PropertyValue &value) {
+  if (!value.IsList() || value.ValueList().empty()) return std::nullopt;
+  std::vector<float> vector;
+  vector.reserve(value.ValueList().size());
+  for (const auto &element : value.ValueList()) {
+    if (element.IsInt()) {
+      vector.push_back(static_cast<float>(element.ValueInt()));
+    } else if (element.IsDouble()) {
+      vector.push_back(static_cast<float>(element.ValueDouble()));
+    } else {
+      return std::nullopt;
+    }
+  }
+  utils::Normalize(vector);
+  return vector;
+}
+
+void InMemoryVectorIndex::Insert(Graph *graph, Vertex *vertex, std::vector<float> vector, uint64_t timestamp) {
+  auto &nodes = graph->nodes;
+  const auto id = static_cast<uint32_t>(nodes.size());
+  const auto level = RandomLevel(&graph->generator);
+  nodes.push_back({.vertex = vertex, .timestamp = timestamp, .vector = std::move(vector)});
+  nodes[id].neighbours.resize(level + 1);
+  if (!graph->entry_point) {
+    graph->entry_point = id;
+    return;
+  }
+
+  const std::span<const float> inserted = nodes[id].vector;
+  const auto top_level = nodes[*graph->entry_point].neighbours.size() - 1;
+  Candidate entry_point{Distance(nodes, *graph->entry_point, inserted), *graph->entry_point};
+  for (auto current = top_level; current > level; --current) {
+    entry_point = SearchNearest(nodes, inserted, entry_point, current);
+  }
+
+  std::vector<Candidate> entry_points{entry_point};
+  for (auto current = std::min(level, top_level) + 1; current-- > 0;) {
+    auto candidates = SearchLevel(nodes, inserted, entry_points, kConstructionCandidates, current);
+    nodes[id].neighbours[current] = SelectNeighbours(nodes, candidates, kMaxNeighbours);
+    for (const auto neighbour : nodes[id].neighbours[current]) {
+      auto &links = nodes[neighbour].neighbours[current];
+      links.push_back(id);
+      if (links.size() <= MaxNeighbours(current)) continue;
+      // The neighbour keeps its most diverse links.
+      std::vector<Candidate> neighbour_candidates;
+      neighbour_candidates.reserve(links.size());
+      for (const auto link : links) {
+        neighbour_candidates.emplace_back(Distance(nodes, link, nodes[neighbour].vector), link);
+      }
+      std::sort(neighbour_candidates.begin(), neighbour_candidates.end());
+      links = SelectNeighbours(nodes, neighbour_candidates, MaxNeighbours(current));
+    }
+    entry_points = std::move(candidates);
+  }
+
+  if (level > top_level) {
+    graph->entry_point = id;
+  }
+}
+
+bool InMemoryVectorIndex::CreateIndex(LabelId label, PropertyId property, utils::SkipList<Vertex>::Accessor vertices) {
+  auto [it, emplaced] =
+      index_.emplace(std::piecewise_construct, std::forward_as_tuple(label, property), std::forward_as_tuple());
+  if (!emplaced) {
+    // Index already exists.
+    return false;
+  }
+
+  utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+  try {
+    auto &graph = it->second.graph;
+    for (Vertex &vertex : vertices) {
+      if (vertex.deleted || !utils::Contains(vertex.labels, label)) continue;
+      auto vector = ToVector(vertex.properties.GetProperty(property));
+      if (!vector) continue;
+      if (graph.dimension == 0) graph.dimension = vector->size();
+      if (vector->size() != graph.dimension) continue;
+      Insert(&graph, &vertex, std::move(*vector), 0);
+    }
+  } catch (const utils::OutOfMemoryException &) {
+    utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+    index_.erase(it);
+    throw;
+  }
+  return true;
+}
+
+void InMemoryVectorIndex::UpdateOnAddLabel(LabelId added_label, Vertex *vertex_after_update, const Transaction &tx) {
+  for (auto &[key, container] : index_) {
+    if (key.first != added_label) continue;
+    auto vector = ToVector(vertex_after_update->properties.GetProperty(key.second));
+    if (!vector) continue;
+    std::unique_lock guard(container.lock);
+    auto &graph = container.graph;
+    if (graph.dimension == 0) graph.dimension = vector->size();
+    if (vector->size() != graph.dimension) continue;
+    Insert(&graph, vertex_after_update, std::move(*vector), tx.start_timestamp);
+  }
+}
+
+void InMemoryVectorIndex::UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
+                                              const Transaction &tx) {
+  // The nodes of the previous value are removed by the garbage collection once
+  // no transaction sees that value.
+  std::optional<std::vector<float>> vector;
+  for (auto &[key, container] : index_) {
+    if (key.second != property || !utils::Contains(vertex->labels, key.first)) continue;
+    if (!vector) {
+      vector = ToVector(value);
+      if (!vector) return;
+    }
+    std::unique_lock guard(container.lock);
+    auto &graph = container.graph;
+    if (graph.dimension == 0) graph.dimension = vector->size();
+    if (vector->size() != graph.dimension) continue;
+    Insert(&graph, vertex, *vector, tx.start_timestamp);
+  }
+}
+
+bool InMemoryVectorIndex::DropIndex(LabelId label, PropertyId property) {
+  return index_.erase({label, property}) > 0;
+}
+
+bool InMemoryVectorIndex::IndexExists(LabelId label, PropertyId property) const {
+  return index_.find({label, property}) != index_.end();
+}
+
+std::vector<std::pair<LabelId, PropertyId>> InMemoryVectorIndex::ListIndices() const {
+  std::vector<std::pair<LabelId, PropertyId>> ret;
+  ret.reserve(index_.size());
+  for (const auto &item : index_) {
+    ret.push_back(item.first);
+  }
+  return ret;
+}
+
+void InMemoryVectorIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
+  // The vertex locks are taken without holding the lock of the graph, because
+  // the writers hold a vertex lock while they insert into the graph. Only the
+  // garbage collection rebuilds the graph and the new nodes are appended, so
+  // the ids and the vectors of the nodes stay valid in the meantime.
+  struct ObsoleteCandidate {
+    uint32_t id;
+    Vertex *vertex;
+    std::span<const float> vector;
+  };
+
+  for (auto &[key, container] : index_) {
+    std::vector<ObsoleteCandidate> candidates;
+    std::vector<uint32_t> removed;
+    {
+      std::shared_lock guard(container.lock);
+      const auto &nodes = container.graph.nodes;
+      std::unordered_map<Vertex *, std::vector<uint32_t>> nodes_of_vertex;
+      for (uint32_t id = 0; id < nodes.size(); ++id) {
+        if (!nodes[id].removed) nodes_of_vertex[nodes[id].vertex].push_back(id);
+      }
+      for (const auto &[vertex, ids] : nodes_of_vertex) {
+        for (size_t i = 0; i < ids.size(); ++i) {
+          const auto &node = nodes[ids[i]];
+          if (node.timestamp >= oldest_active_start_timestamp) continue;
+          // A later node of the same value replaces the node.
+          const bool replaced = std::any_of(ids.begin() + static_cast<std::ptrdiff_t>(i) + 1, ids.end(),
+                                            [&](auto other) { return nodes[other].vector == node.vector; });
+          if (replaced) {
+            removed.push_back(ids[i]);
+          } else {
+            candidates.push_back({ids[i], vertex, node.vector});
+          }
+        }
+      }
+    }
+
+    for (const auto &candidate : candidates) {
+      if (!AnyVersionHasLabelVector(*candidate.vertex, key.first, key.second, candidate.vector,
+                                    oldest_active_start_timestamp)) {
+        removed.push_back(candidate.id);
+      }
+    }
+    if (removed.empty()) continue;
+
+    std::unique_lock guard(container.lock);
+    auto &graph = container.graph;
+    for (const auto id : removed) {
+      graph.nodes[id].removed = true;
+    }
+    graph.removed_count += removed.size();
+    if (graph.removed_count * 2 < graph.nodes.size()) continue;
+    Graph rebuilt{.dimension = graph.dimension, .generator = graph.generator};
+    for (auto &node : graph.nodes) {
+      if (node.removed) continue;
+      Insert(&rebuilt, node.vertex, std::move(node.vector), node.timestamp);
+    }
+    graph = std::move(rebuilt);
+  }
+}
+
+std::optional<std::vector<VectorSearchResult>> InMemoryVectorIndex::Search(LabelId label, PropertyId property,
+                                                                           std::span<const float> query, uint64_t k,
+                                                                           View view, Transaction *transaction) {
+  auto it = index_.find({label, property});
+  MG_ASSERT(it != index_.end(), "Vector index for label {} and property {} doesn't exist", label.AsUint(),
+            property.AsUint());
+  // The nodes found in the graph are checked after the lock of the graph is
+  // released, because the writers hold a vertex lock while they insert into
+  // the graph. Their vectors are copied because the garbage collection may
+  // rebuild the graph in the meantime.
+  struct Found {
+    float distance;
+    Vertex *vertex;
+    std::vector<float> vector;
+  };
+  std::vector<Found> candidates;
+  {
+    std::shared_lock guard(it->second.lock);
+    const auto &graph = it->second.graph;
+    if (!graph.entry_point || k == 0) return std::vector<VectorSearchResult>{};
+    if (query.size() != graph.dimension) return std::nullopt;
+
+    std::vector<float> normalized(query.begin(), query.end());
+    utils::Normalize(normalized);
+    const auto &nodes = graph.nodes;
+    Candidate entry_point{Distance(nodes, *graph.entry_point, normalized), *graph.entry_point};
+    for (auto level = nodes[*graph.entry_point].neighbours.size() - 1; level > 0; --level) {
+      entry_point = SearchNearest(nodes, normalized, entry_point, level);
+    }
+    const auto count = std::max<size_t>(k, kSearchCandidates);
+    for (const auto &[distance, id] : SearchLevel(nodes, normalized, {entry_point}, count, 0)) {
+      if (nodes[id].removed) continue;
+      candidates.push_back({distance, nodes[id].vertex, nodes[id].vector});
+    }
+  }
+
+  // The nodes are only hints, so the transaction has to see the value of the
+  // node.
+  std::vector<VectorSearchResult> results;
+  std::unordered_set<const Vertex *> found;
+  for (const auto &candidate : candidates) {
+    if (found.contains(candidate.vertex)) continue;
+    VertexAccessor accessor(candidate.vertex, transaction, indices_, constraints_, config_.items);
+    auto has_label = accessor.HasLabel(label, view);
+    if (has_label.HasError() || !*has_label) continue;
+    auto value = accessor.GetProperty(property, view);
+    if (value.HasError() || !ValueHasVector(*value, candidate.vector)) continue;
+    found.insert(candidate.vertex);
+    results.push_back({accessor, candidate.distance});
+    if (results.size() == k) break;
+  }
+  return results;
+}
+
+}  // namespace memgraph::storage
@@ -0,0 +1,115 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <random>
+#include <shared_mutex>
+#include <span>
+#include <vector>
+
+#include "storage/v2/indices/vector_index.hpp"
+#include "utils/skip_list.hpp"
+
+namespace memgraph::storage {
+
+/// Hierarchical navigable small world graph of the vectors. Every vector is a
+/// node with neighbours on each of its levels, and the search descends from
+/// the sparse top level to the bottom one which contains all nodes.
+///
+/// Like the other indices it is updated whenever a vertex changes, so a vertex
+/// has a node for each of its values and the search checks which value the
+/// transaction sees. The nodes of the values which no transaction sees are
+/// only marked as removed by the garbage collection, because the graph stays
+/// navigable through them, and the graph is rebuilt without them once they
+/// are the majority. The vectors whose dimension differs from the dimension of
+/// the first indexed one aren't indexed.
+class InMemoryVectorIndex : public storage::VectorIndex {
+ private:
+  struct Node {
+    Vertex *vertex;
+    uint64_t timestamp;
+    bool removed{false};
+    // The normalized vector.
+    std::vector<float> vector;
+    // The neighbours on each level of the node, starting with the bottom one.
+    std::vector<std::vector<uint32_t>> neighbours;
+  };
+
+  struct Graph {
+    // The dimension of the vectors, set by the first indexed one.
+    size_t dimension{0};
+    std::vector<Node> nodes;
+    std::optional<uint32_t> entry_point;
+    uint64_t removed_count{0};
+    std::mt19937_64 generator{0};
+  };
+
+  struct IndexContainer {
+    mutable std::shared_mutex lock;
+    Graph graph;
+  };
+
+ public:
+  /// The maximum number of neighbours of a node on the levels above the bottom
+  /// one, which has twice as many.
+  static constexpr size_t kMaxNeighbours = 16;
+  /// The number of candidates kept while looking for the neighbours of an
+  /// inserted node.
+  static constexpr size_t kConstructionCandidates = 100;
+  /// The minimum number of candidates kept by a search.
+  static constexpr size_t kSearchCandidates = 64;
+
+  InMemoryVectorIndex(Indices *indices, Constraints *constraints, const Config &config);
+
+  /// Returns the normalized vector of the value, or std::nullopt if the value
+  /// isn't a non-empty list of numbers.
+  static std::optional<std::vector<float>> ToVector(const PropertyValue &value);
+
+  /// Creates the index with nodes for all vertices which have the label and a
+  /// vector as the value of the property. Returns false if the index already
+  /// exists.
+  /// @throw std::bad_alloc
+  bool CreateIndex(LabelId label, PropertyId property, utils::SkipList<Vertex>::Accessor vertices);
+
+  /// @throw std::bad_alloc
+  void UpdateOnAddLabel(LabelId added_label, Vertex *vertex_after_update, const Transaction &tx) override;
+
+  /// @throw std::bad_alloc
+  void UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
+                           const Transaction &tx) override;
+
+  bool DropIndex(LabelId label, PropertyId property) override;
+
+  bool IndexExists(LabelId label, PropertyId property) const override;
+
+  std::vector<std::pair<LabelId, PropertyId>> ListIndices() const override;
+
+  void RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp);
+
+  /// Returns at most `k` vertices whose values are the nearest to `query` by
+  /// the cosine distance, ordered from the nearest one. The search is
+  /// approximate, so it may miss some of the nearest vertices. Returns
+  /// std::nullopt if the dimension of `query` differs from the dimension of
+  /// the indexed vectors.
+  std::optional<std::vector<VectorSearchResult>> Search(LabelId label, PropertyId property,
+                                                        std::span<const float> query, uint64_t k, View view,
+                                                        Transaction *transaction);
+
+ private:
+  static void Insert(Graph *graph, Vertex *vertex, std::vector<float> vector, uint64_t timestamp);
+
+  std::map<std::pair<LabelId, PropertyId>, IndexContainer> index_;
+};
+
+}  // namespace memgraph::storage
@@ -0,0 +1,49 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include "utils/event_histogram.hpp"
+#include "utils/rw_lock.hpp"
+#include "utils/spin_lock.hpp"
+#include "utils/wait_measured_lock.hpp"
+
+namespace memgraph::metrics {
+extern const Event MainLockWait_ns;
+extern const Event EngineLockWait_ns;
+extern const Event ObjectLockWait_ns;
+}  // namespace memgraph::metrics
+
+namespace memgraph::storage {
+
+struct MainLockWait {
+  static metrics::Event Histogram() { return metrics::MainLockWait_ns; }
+};
+
+struct EngineLockWait {
+  static metrics::Event Histogram() { return metrics::EngineLockWait_ns; }
+};
+
+struct ObjectLockWait {
+  static metrics::Event Histogram() { return metrics::ObjectLockWait_ns; }
+};
+
+/// Lock of the whole storage, which the accessors hold shared and the
+/// operations on indices, constraints and the storage mode hold unique.
+using MainLock = utils::WaitMeasuredLock<utils::ScalableRWLock, MainLockWait>;
+
+/// Lock of the transaction counters and the commit log of the storage.
+using EngineLock = utils::WaitMeasuredLock<utils::SpinLock, EngineLockWait>;
+
+/// Lock of a single vertex or edge.
+using ObjectLock = utils::WaitMeasuredLock<utils::SpinLock, ObjectLockWait>;
+
+}  // namespace memgraph::storage
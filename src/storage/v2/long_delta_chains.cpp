@@ -0,0 +1,180 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/long_delta_chains.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "storage/v2/delta.hpp"
+#include "storage/v2/mvcc.hpp"
+#include "storage/v2/result.hpp"
+#include "storage/v2/transaction.hpp"
+#include "storage/v2/vertex.hpp"
+#include "storage/v2/vertex_info_helpers.hpp"
+#include "utils/variant_helpers.hpp"
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(delta_chain_materialize_threshold, 0,
+              "The number of deltas applied by a read of a vertex after which the version of the vertex it read is "
+              "shared with the other readers of the same version, so they don't walk the delta chain again. Only "
+              "used for snapshot isolation. 0 disables sharing the versions.");
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(delta_chain_stats_max_objects, 100,
+              "The number of vertices with the longest delta chains returned by mg.delta_chains().");
+
+namespace memgraph::storage {
+
+namespace {
+// Bounds the memory of the versions if the GC doesn't run for a while.
+constexpr std::size_t kMaxMaterializedVersions = 1U << 16U;
+
+/// Materializes the version of the vertex seen by the transaction, so that the
+/// other transactions which see it don't have to walk the delta chain.
+void MaterializeVersion(Vertex const *vertex, Transaction const *transaction) {
+  auto version = std::make_shared<MaterializedVertexVersion>();
+  Delta *delta = nullptr;
+  {
+    std::lock_guard guard(vertex->lock);
+    version->gid = vertex->gid;
+    version->deleted = vertex->deleted;
+    version->labels = vertex->labels;
+    version->properties = vertex->properties.Properties();
+    version->in_degree = vertex->in_edges.size();
+    version->out_degree = vertex->out_edges.size();
+    delta = vertex->delta;
+  }
+  if (!delta ||
+      delta->timestamp->load(std::memory_order_acquire) == transaction->transaction_id.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  // Without changes of its own, the view doesn't change what the transaction
+  // sees.
+  const Delta *oldest_applied = nullptr;
+  ApplyDeltasForRead(transaction, delta, View::OLD, [&](const Delta &delta) {
+    // clang-format off
+    DeltaDispatch(delta, utils::ChainedOverloaded{
+      Deleted_ActionMethod(version->deleted),
+      Exists_ActionMethod(version->exists),
+      Labels_ActionMethod(version->labels),
+      Properties_ActionMethod(version->properties),
+      Degree_ActionMethod<EdgeDirection::IN>(version->in_degree),
+      Degree_ActionMethod<EdgeDirection::OUT>(version->out_degree)
+    });
+    // clang-format on
+    oldest_applied = &delta;
+  });
+  if (!oldest_applied) return;
+
+  // The version is seen by the transactions which see the change before the
+  // oldest applied delta and don't see the change of the oldest applied delta.
+  // The deltas are kept alive while the transaction is active.
+  const auto *const seen_delta = oldest_applied->next.load(std::memory_order_acquire);
+  version->from_timestamp = seen_delta ? seen_delta->timestamp->load(std::memory_order_acquire) : kTimestampInitialId;
+  const auto oldest_applied_timestamp = oldest_applied->timestamp->load(std::memory_order_acquire);
+  // The commit timestamp of an uncommitted change is greater than the start
+  // timestamp of any transaction started so far.
+  version->to_timestamp =
+      oldest_applied_timestamp < kTransactionInitialId ? oldest_applied_timestamp : transaction->start_timestamp;
+  transaction->long_delta_chains->StoreVersion(vertex, std::move(version));
+}
+}  // namespace
+
+void LongDeltaChains::Record(Gid gid, const uint64_t length, const uint64_t max_objects) {
+  if (max_objects == 0) return;
+  chains_.WithLock([&](auto &chains) {
+    auto it = chains.find(gid);
+    if (it == chains.end()) {
+      if (chains.size() >= max_objects) {
+        auto shortest = std::min_element(chains.begin(), chains.end(), [](const auto &lhs, const auto &rhs) {
+          return lhs.second.max_length < rhs.second.max_length;
+        });
+        if (shortest->second.max_length >= length) return;
+        chains.erase(shortest);
+      }
+      it = chains.emplace(gid, LongDeltaChainInfo{.gid = gid}).first;
+    }
+    auto &info = it->second;
+    info.max_length = std::max(info.max_length, length);
+    ++info.long_reads;
+  });
+}
+
+std::vector<LongDeltaChainInfo> LongDeltaChains::GetInfo() const {
+  std::vector<LongDeltaChainInfo> info;
+  chains_.WithLock([&info](const auto &chains) {
+    info.reserve(chains.size());
+    for (const auto &[gid, chain] : chains) info.push_back(chain);
+  });
+  std::sort(info.begin(), info.end(), [](const auto &lhs, const auto &rhs) { return lhs.max_length > rhs.max_length; });
+  return info;
+}
+
+std::shared_ptr<const MaterializedVertexVersion> LongDeltaChains::FindVersion(Vertex const *vertex,
+                                                                              const uint64_t start_timestamp) const {
+  auto version = versions_.WithLock([vertex](const auto &versions) -> std::shared_ptr<const MaterializedVertexVersion> {
+    auto it = versions.find(vertex);
+    if (it == versions.end()) return nullptr;
+    return it->second;
+  });
+  if (!version || version->gid != vertex->gid || start_timestamp <= version->from_timestamp ||
+      start_timestamp > version->to_timestamp) {
+    return nullptr;
+  }
+  return version;
+}
+
+void LongDeltaChains::StoreVersion(Vertex const *vertex, std::shared_ptr<const MaterializedVertexVersion> version) {
+  versions_.WithLock([&](auto &versions) {
+    if (versions.size() >= kMaxMaterializedVersions && !versions.contains(vertex)) return;
+    versions[vertex] = std::move(version);
+  });
+}
+
+void LongDeltaChains::RemoveExpiredVersions(const uint64_t oldest_active_start_timestamp) {
+  // The versions are destroyed once the lock is dropped.
+  std::vector<std::shared_ptr<const MaterializedVertexVersion>> expired;
+  versions_.WithLock([&](auto &versions) {
+    std::erase_if(versions, [&](auto &item) {
+      if (item.second->to_timestamp >= oldest_active_start_timestamp) return false;
+      expired.push_back(std::move(item.second));
+      return true;
+    });
+  });
+}
+
+std::size_t LongDeltaChains::VersionCount() const {
+  return versions_.WithLock([](const auto &versions) { return versions.size(); });
+}
+
+std::shared_ptr<const MaterializedVertexVersion> FindMaterializedVersion(Vertex const *vertex, Delta const *delta,
+                                                                         Transaction const *transaction) {
+  if (FLAGS_delta_chain_materialize_threshold == 0 || transaction->long_delta_chains == nullptr ||
+      transaction->isolation_level != IsolationLevel::SNAPSHOT_ISOLATION ||
+      delta->timestamp->load(std::memory_order_acquire) == transaction->transaction_id.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  return transaction->long_delta_chains->FindVersion(vertex, transaction->start_timestamp);
+}
+
+void RecordDeltaChain(Vertex const *vertex, Transaction const *transaction, const std::size_t n_processed) {
+  if (transaction->long_delta_chains == nullptr) return;
+  if (n_processed >= FLAGS_delta_chain_cache_threshold) {
+    transaction->long_delta_chains->Record(vertex->gid, n_processed, FLAGS_delta_chain_stats_max_objects);
+  }
+  if (FLAGS_delta_chain_materialize_threshold != 0 && n_processed >= FLAGS_delta_chain_materialize_threshold &&
+      transaction->isolation_level == IsolationLevel::SNAPSHOT_ISOLATION) {
+    MaterializeVersion(vertex, transaction);
+  }
+}
+
+}  // namespace memgraph::storage
@@ -0,0 +1,117 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Statistics of the vertices whose reads walk long delta chains and the
+/// versions of such vertices materialized for their readers.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include "storage/v2/id_types.hpp"
+#include "storage/v2/property_value.hpp"
+#include "utils/spin_lock.hpp"
+#include "utils/synchronized.hpp"
+
+DECLARE_uint64(delta_chain_materialize_threshold);
+DECLARE_uint64(delta_chain_stats_max_objects);
+
+namespace memgraph::storage {
+
+// forward declarations
+struct Delta;
+struct Transaction;
+struct Vertex;
+
+/// Vertex whose reads applied at least `delta_chain_cache_threshold` deltas.
+struct LongDeltaChainInfo {
+  Gid gid;
+  // The most deltas applied by a single read.
+  uint64_t max_length{0};
+  // The number of reads which applied at least `delta_chain_cache_threshold`
+  // deltas.
+  uint64_t long_reads{0};
+};
+
+/// Version of a vertex seen by the snapshot isolation transactions with a
+/// start timestamp in `(from_timestamp, to_timestamp]` which didn't change the
+/// vertex themselves. The version is immutable, because the newer changes
+/// of the vertex are only added to the head of its delta chain. Unlike the
+/// `VertexInfoCache` of a transaction, it's shared by all such readers.
+struct MaterializedVertexVersion {
+  Gid gid;
+  uint64_t from_timestamp{0};
+  uint64_t to_timestamp{0};
+  bool exists{true};
+  bool deleted{false};
+  std::vector<LabelId> labels;
+  std::map<PropertyId, PropertyValue> properties;
+  std::size_t in_degree{0};
+  std::size_t out_degree{0};
+};
+
+/// Keeps the vertices with the longest delta chains and, if
+/// `delta_chain_materialize_threshold` is set, the versions of the vertices
+/// whose reads applied at least that many deltas. The readers of a
+/// materialized version copy it instead of walking the chain, so the reads of
+/// hot vertices stay cheap while long-running transactions keep their chains
+/// from being collected.
+/// This class is thread safe.
+class LongDeltaChains final {
+ public:
+  /// Adds a long read of the vertex. If `max_objects` vertices are already
+  /// tracked, the one with the shortest chain is removed to make room for a new
+  /// one.
+  void Record(Gid gid, uint64_t length, uint64_t max_objects);
+
+  /// Returns the tracked vertices, sorted by their longest chain.
+  std::vector<LongDeltaChainInfo> GetInfo() const;
+
+  /// Returns the materialized version of the vertex seen by a transaction with
+  /// the start timestamp, if there's one.
+  std::shared_ptr<const MaterializedVertexVersion> FindVersion(Vertex const *vertex, uint64_t start_timestamp) const;
+
+  /// Replaces the materialized version of the vertex.
+  void StoreVersion(Vertex const *vertex, std::shared_ptr<const MaterializedVertexVersion> version);
+
+  /// Removes the versions which no active or future transaction can see.
+  void RemoveExpiredVersions(uint64_t oldest_active_start_timestamp);
+
+  std::size_t VersionCount() const;
+
+ private:
+  mutable utils::Synchronized<std::unordered_map<Gid, LongDeltaChainInfo>, utils::SpinLock> chains_;
+  // The versions are keyed by the address of the vertex, which is reused once
+  // the vertex is freed, so the gid of the vertex is checked as well.
+  mutable utils::Synchronized<std::unordered_map<Vertex const *, std::shared_ptr<const MaterializedVertexVersion>>,
+                              utils::SpinLock>
+      versions_;
+};
+
+/// Returns the version of the vertex materialized by another reader if the
+/// transaction sees the same version. The versions don't include the changes
+/// of the transaction itself, which are always at the head of the chain, so
+/// `delta` is the head of the chain read by the transaction.
+std::shared_ptr<const MaterializedVertexVersion> FindMaterializedVersion(Vertex const *vertex, Delta const *delta,
+                                                                         Transaction const *transaction);
+
+/// Records a read of the vertex which applied `n_processed` deltas, and
+/// materializes the version it read if the chain is long enough.
+void RecordDeltaChain(Vertex const *vertex, Transaction const *transaction, std::size_t n_processed);
+
+}  // namespace memgraph::storage
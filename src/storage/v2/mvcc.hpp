@@ -17,9 +17,25 @@
 #include "storage/v2/property_value.hpp"
 #include "storage/v2/transaction.hpp"
 #include "storage/v2/view.hpp"
+#include "utils/event_histogram.hpp"
+
+namespace memgraph::metrics {
+extern const Event DeltaChainLength;
+}  // namespace memgraph::metrics
 
 namespace memgraph::storage {
 
+/// Measures the number of deltas applied by one in `kDeltaChainSampleInterval`
+/// of the reads of each thread which applied any, so that the reads don't all
+/// contend on the histogram.
+inline void MeasureDeltaChainLength(std::size_t n_processed) {
+  constexpr uint32_t kDeltaChainSampleInterval = 64;
+  static thread_local uint32_t reads = 0;
+  if ((++reads & (kDeltaChainSampleInterval - 1)) == 0) {
+    metrics::Measure(metrics::DeltaChainLength, n_processed);
+  }
+}
+
 /// This function iterates through the undo buffers from an object (starting
 /// from the supplied delta) and determines what deltas should be applied to get
 /// the currently visible version of the object. When the function finds a delta
@@ -57,11 +73,16 @@ inline std::size_t ApplyDeltasForRead(Transaction const *transaction, const Delt
       break;
     }
 
+    // Our changes are skipped instead of ending the traversal, because the
+    // changes of the properties we didn't change, which other transactions
+    // committed after we started, may follow them, see `PrepareForWrite`.
+
     // We shouldn't undo our newest changes because the user requested a NEW
     // view of the database.
     auto cid = delta->command_id;
     if (view == View::NEW && ts == commit_timestamp && cid <= transaction->command_id) {
-      break;
+      delta = delta->next.load(std::memory_order_acquire);
+      continue;
     }
 
     // We shouldn't undo our older changes because the user requested a OLD view
@@ -69,7 +90,8 @@ inline std::size_t ApplyDeltasForRead(Transaction const *transaction, const Delt
     if (view == View::OLD && ts == commit_timestamp &&
         (cid < transaction->command_id ||
          (cid == transaction->command_id && delta->action == Delta::Action::DELETE_DESERIALIZED_OBJECT))) {
-      break;
+      delta = delta->next.load(std::memory_order_acquire);
+      continue;
     }
 
     // This delta must be applied, call the callback.
@@ -79,6 +101,7 @@ inline std::size_t ApplyDeltasForRead(Transaction const *transaction, const Delt
     // Move to the next delta.
     delta = delta->next.load(std::memory_order_acquire);
   }
+  if (n_processed > 0) MeasureDeltaChainLength(n_processed);
   return n_processed;
 }
 
@@ -99,6 +122,36 @@ inline bool PrepareForWrite(Transaction *transaction, TObj *object) {
   return false;
 }
 
+/// Prepares the object for a write of the property. Unlike `PrepareForWrite`,
+/// the changes which other transactions committed after this one started
+/// don't conflict with the write if they only set the other properties of the
+/// object, so concurrent transactions setting different properties of the
+/// same object don't abort each other. The changes of uncommitted transactions
+/// still conflict with any write.
+template <typename TObj>
+inline bool PrepareForWrite(Transaction *transaction, TObj *object, PropertyId property) {
+  if (object->delta == nullptr) return true;
+  auto ts = object->delta->timestamp->load(std::memory_order_acquire);
+  if (ts == transaction->transaction_id.load(std::memory_order_acquire) || ts < transaction->start_timestamp) {
+    return true;
+  }
+
+  // The uncommitted changes are always at the head of the chain.
+  if (ts < kTransactionInitialId) {
+    const Delta *delta = object->delta;
+    while (delta != nullptr && delta->timestamp->load(std::memory_order_acquire) >= transaction->start_timestamp &&
+           delta->action == Delta::Action::SET_PROPERTY && delta->property.key != property) {
+      delta = delta->next.load(std::memory_order_acquire);
+    }
+    if (delta == nullptr || delta->timestamp->load(std::memory_order_acquire) < transaction->start_timestamp) {
+      return true;
+    }
+  }
+
+  transaction->must_abort = true;
+  return false;
+}
+
 /// This function creates a `DELETE_OBJECT` delta in the transaction and returns
 /// a pointer to the created delta. It doesn't perform any linking of the delta
 /// and is primarily used to create the first delta for an object (that must be
@@ -120,13 +173,13 @@ inline Delta *CreateDeleteDeserializedObjectDelta(Transaction *transaction, std:
   return &transaction->deltas.emplace_back(Delta::DeleteDeserializedObjectTag(), std::stoull(ts), old_disk_key);
 }
 
-inline Delta *CreateDeleteDeserializedIndexObjectDelta(Transaction *transaction, std::list<Delta> &deltas,
+inline Delta *CreateDeleteDeserializedIndexObjectDelta(Transaction *transaction, utils::ChunkedList<Delta> &deltas,
                                                        std::optional<std::string> old_disk_key, const uint64_t ts) {
   return &deltas.emplace_back(Delta::DeleteDeserializedObjectTag(), ts, old_disk_key);
 }
 
 /// TODO: what if in-memory analytical
-inline Delta *CreateDeleteDeserializedIndexObjectDelta(Transaction *transaction, std::list<Delta> &deltas,
+inline Delta *CreateDeleteDeserializedIndexObjectDelta(Transaction *transaction, utils::ChunkedList<Delta> &deltas,
                                                        std::optional<std::string> old_disk_key, const std::string &ts) {
   // Should use utils::DecodeFixed64(ts.c_str()) once we will move to RocksDB real timestamps
   return CreateDeleteDeserializedIndexObjectDelta(transaction, deltas, old_disk_key, std::stoull(ts));
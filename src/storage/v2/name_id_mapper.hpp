@@ -11,9 +11,15 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <bit>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
 
 #include "utils/logging.hpp"
 #include "utils/skip_list.hpp"
@@ -33,15 +39,73 @@ class NameIdMapper {
     bool operator==(const std::string_view other) const { return name == other; }
   };
 
-  struct MapIdToName {
-    uint64_t id;
-    std::string name;
+  /// Maps the dense ids to the names without locks. The slots are in chunks
+  /// which double in size, so growing the table allocates a new chunk and
+  /// never moves the slots or the names the readers use. Nothing is freed
+  /// before the table is destroyed.
+  class IdToNameTable {
+   public:
+    IdToNameTable() = default;
+
+    IdToNameTable(const IdToNameTable &) = delete;
+    IdToNameTable &operator=(const IdToNameTable &) = delete;
+    IdToNameTable(IdToNameTable &&) = delete;
+    IdToNameTable &operator=(IdToNameTable &&) = delete;
+
+    ~IdToNameTable() {
+      for (size_t chunk = 0; chunk < kChunks; ++chunk) {
+        auto *slots = chunks_[chunk].load(std::memory_order_relaxed);
+        if (slots == nullptr) continue;
+        for (uint64_t offset = 0; offset < ChunkSize(chunk); ++offset) {
+          delete slots[offset].load(std::memory_order_relaxed);
+        }
+        delete[] slots;
+      }
+    }
+
+    const std::string *Find(uint64_t id) const {
+      const auto [chunk, offset] = Position(id);
+      const auto *slots = chunks_[chunk].load(std::memory_order_acquire);
+      if (slots == nullptr) return nullptr;
+      return slots[offset].load(std::memory_order_acquire);
+    }
+
+    /// Returns the name stored for the id, which is the given one unless
+    /// another thread stored the id first.
+    const std::string &Insert(uint64_t id, std::string_view name) {
+      const auto [chunk, offset] = Position(id);
+      auto *slots = chunks_[chunk].load(std::memory_order_acquire);
+      if (slots == nullptr) {
+        auto *new_slots = new std::atomic<std::string *>[ChunkSize(chunk)]();
+        if (chunks_[chunk].compare_exchange_strong(slots, new_slots, std::memory_order_acq_rel)) {
+          slots = new_slots;
+        } else {
+          delete[] new_slots;
+        }
+      }
+      auto *existing = slots[offset].load(std::memory_order_acquire);
+      if (existing != nullptr) return *existing;
+      auto new_name = std::make_unique<std::string>(name);
+      if (slots[offset].compare_exchange_strong(existing, new_name.get(), std::memory_order_acq_rel)) {
+        return *new_name.release();
+      }
+      return *existing;
+    }
+
+   private:
+    static constexpr uint64_t kFirstChunkBits = 10;
+    static constexpr size_t kChunks = 64 - kFirstChunkBits;
 
-    bool operator<(const MapIdToName &other) const { return id < other.id; }
-    bool operator==(const MapIdToName &other) const { return id == other.id; }
+    static constexpr uint64_t ChunkSize(size_t chunk) { return uint64_t{1} << (chunk + kFirstChunkBits); }
 
-    bool operator<(uint64_t other) const { return id < other; }
-    bool operator==(uint64_t other) const { return id == other; }
+    /// The chunk k holds the ids from 2^(k+10) - 2^10 on.
+    static std::pair<size_t, uint64_t> Position(uint64_t id) {
+      const uint64_t index = id + ChunkSize(0);
+      const size_t chunk = std::bit_width(index) - 1 - kFirstChunkBits;
+      return {chunk, index - ChunkSize(chunk)};
+    }
+
+    std::array<std::atomic<std::atomic<std::string *> *>, kChunks> chunks_{};
   };
 
  public:
@@ -56,6 +120,10 @@ class NameIdMapper {
 
   /// @throw std::bad_alloc if unable to insert a new mapping
   virtual uint64_t NameToId(const std::string_view name) {
+    auto &cached_ids = ThreadCachedIds();
+    if (auto cached = cached_ids.find(name); cached != cached_ids.end()) {
+      return cached->second;
+    }
     auto name_to_id_acc = name_to_id_.access();
     auto found = name_to_id_acc.find(name);
     uint64_t id;
@@ -71,45 +139,83 @@ class NameIdMapper {
     } else {
       id = found->id;
     }
-    auto id_to_name_acc = id_to_name_.access();
     // We have to try to insert the ID to name mapping even if we are not the
     // one who assigned the ID because we have to make sure that after this
     // method returns that both mappings exist.
-    if (id_to_name_acc.find(id) == id_to_name_acc.end()) {
-      // We first try to find the `id` in the map to avoid making an unnecessary
-      // temporary memory allocation when the object already exists.
-      id_to_name_acc.insert({id, std::string(name)});
-    }
+    CacheNameToId(cached_ids, id_to_name_.Insert(id, name), id);
     return id;
   }
 
+  /// Returns the ID of the name, or `std::nullopt` if the name was never
+  /// mapped. Unlike `NameToId` no mapping is created.
+  std::optional<uint64_t> FindId(const std::string_view name) const {
+    auto &cached_ids = ThreadCachedIds();
+    if (auto cached = cached_ids.find(name); cached != cached_ids.end()) {
+      return cached->second;
+    }
+    auto name_to_id_acc = name_to_id_.access();
+    auto found = name_to_id_acc.find(name);
+    if (found == name_to_id_acc.end()) {
+      return std::nullopt;
+    }
+    return found->id;
+  }
+
   // NOTE: Currently this function returns a `const std::string &` instead of a
   // `std::string` to avoid making unnecessary copies of the string.
-  // Usually, this wouldn't be correct because the accessor to the
-  // `utils::SkipList` is destroyed in this function and that removes the
-  // guarantee that the reference to the value contained in the list will be
-  // valid.
-  // Currently, we never delete anything from the `utils::SkipList` so the
-  // references will always be valid. If you change this class to remove unused
-  // names, be sure to change the signature of this function.
+  // The names are never removed from the table, so the references will always
+  // be valid. If you change this class to remove unused names, be sure to
+  // change the signature of this function.
   virtual const std::string &IdToName(uint64_t id) {
-    auto maybe_name = MaybeIdToName(id);
-    MG_ASSERT(maybe_name.has_value(), "Trying to get a name for an invalid ID!");
-    return maybe_name.value();
+    const auto *name = id_to_name_.Find(id);
+    MG_ASSERT(name != nullptr, "Trying to get a name for an invalid ID!");
+    return *name;
   }
 
  protected:
-  std::optional<std::reference_wrapper<const std::string>> MaybeIdToName(uint64_t id) const {
-    auto id_to_name_acc = id_to_name_.access();
-    auto result = id_to_name_acc.find(id);
-    if (result == id_to_name_acc.end()) {
-      return std::nullopt;
+  using CachedIds = std::unordered_map<std::string_view, uint64_t>;
+
+  /// The ids of the names the thread looked up in this mapper recently. The
+  /// keys point to the names in `id_to_name_`, which live as long as the
+  /// mapper, and the cache of a destroyed mapper is only cleared.
+  CachedIds &ThreadCachedIds() const {
+    struct ThreadCache {
+      uint64_t mapper_id{0};
+      CachedIds ids;
+    };
+    thread_local std::array<ThreadCache, kCachedMappers> caches;
+    auto &cache = caches[mapper_id_ % kCachedMappers];
+    if (cache.mapper_id != mapper_id_) {
+      cache.mapper_id = mapper_id_;
+      cache.ids.clear();
+    }
+    return cache.ids;
+  }
+
+  static void CacheNameToId(CachedIds &cached_ids, const std::string &stored_name, uint64_t id) {
+    if (cached_ids.size() >= kMaxCachedNames) {
+      cached_ids.clear();
     }
-    return result->name;
+    cached_ids.emplace(stored_name, id);
   }
 
+  // A thread usually works with the names of a single storage, so only a few
+  // mappers are cached.
+  static constexpr size_t kCachedMappers = 4;
+  static constexpr size_t kMaxCachedNames = 4096;
+
   std::atomic<uint64_t> counter_{0};
   utils::SkipList<MapNameToId> name_to_id_;
-  utils::SkipList<MapIdToName> id_to_name_;
+  IdToNameTable id_to_name_;
+
+ private:
+  static uint64_t NewMapperId() {
+    // The ids start from 1, so they differ from the one of an unused cache.
+    static std::atomic<uint64_t> next_id{1};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Tells apart the mappers in the caches of the threads.
+  const uint64_t mapper_id_{NewMapperId()};
 };
 }  // namespace memgraph::storage
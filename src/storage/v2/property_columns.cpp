@@ -0,0 +1,55 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/property_columns.hpp"
+
+#include "utils/on_scope_exit.hpp"
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_property_columns, false,
+            "In the analytical mode, the aggregations of a property of the vertices with an indexed label read the "
+            "values of the property from a column which is cached until any vertex is changed.");
+
+namespace memgraph::storage {
+
+std::shared_ptr<const PropertyColumn> PropertyColumns::Get(const LabelId label, const PropertyId property,
+                                                           const std::function<PropertyColumn()> &build) {
+  const auto key = std::make_pair(label, property);
+  auto column = columns_.WithLock([&](const auto &columns) -> std::shared_ptr<const PropertyColumn> {
+    auto it = columns.find(key);
+    return it != columns.end() ? it->second : nullptr;
+  });
+  if (column) return column;
+
+  // The build is registered before the generation is read, so every change
+  // which the build might not see either changes the generation or is made
+  // before the build started.
+  builds_.fetch_add(1, std::memory_order_seq_cst);
+  utils::OnScopeExit unregister{[this] { builds_.fetch_sub(1, std::memory_order_seq_cst); }};
+  const auto generation = generation_.load(std::memory_order_seq_cst);
+  column = std::make_shared<const PropertyColumn>(build());
+  columns_.WithLock([&](auto &columns) {
+    if (generation_.load(std::memory_order_seq_cst) != generation) return;
+    columns.emplace(key, column);
+    cached_.store(true, std::memory_order_seq_cst);
+  });
+  return column;
+}
+
+void PropertyColumns::Clear() {
+  columns_.WithLock([&](auto &columns) {
+    generation_.fetch_add(1, std::memory_order_seq_cst);
+    columns.clear();
+    cached_.store(false, std::memory_order_seq_cst);
+  });
+}
+
+}  // namespace memgraph::storage
@@ -0,0 +1,83 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Columns of the property values of the vertices with a label, which the
+/// analytical queries read instead of decoding the property store of every
+/// vertex.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include "storage/v2/id_types.hpp"
+#include "storage/v2/property_value.hpp"
+#include "utils/spin_lock.hpp"
+#include "utils/synchronized.hpp"
+
+DECLARE_bool(storage_property_columns);
+
+namespace memgraph::storage {
+
+/// Values of a property of the vertices with a label, in the order of the
+/// vertices in the label index. The integers and the doubles are kept in
+/// typed arrays, the values of the other types are kept as they are. The
+/// vertices without the property aren't in the column.
+struct PropertyColumn {
+  // The number of vertices with the label.
+  uint64_t vertex_count{0};
+  std::vector<int64_t> ints;
+  std::vector<double> doubles;
+  std::vector<PropertyValue> others;
+};
+
+/// Caches the property columns of a storage in the analytical mode until any
+/// vertex is changed. The vertices are only changed in place in that mode, so
+/// the columns are dropped by every change made while some columns are
+/// cached or being built. The changes made while no column is cached only
+/// read two atomics.
+///
+/// This class is thread safe.
+class PropertyColumns final {
+ public:
+  /// Returns the cached column of `property` of the vertices with `label`. If
+  /// it isn't cached, it is built by `build` and cached.
+  std::shared_ptr<const PropertyColumn> Get(LabelId label, PropertyId property,
+                                            const std::function<PropertyColumn()> &build);
+
+  /// Has to be called after a vertex was changed, once the change is visible
+  /// to the other transactions.
+  void Invalidate() {
+    if (cached_.load(std::memory_order_seq_cst) || builds_.load(std::memory_order_seq_cst) != 0) Clear();
+  }
+
+  /// Drops all columns.
+  void Clear();
+
+ private:
+  std::atomic<bool> cached_{false};
+  std::atomic<uint64_t> builds_{0};
+  // Changed by every `Clear`, so the columns built while the vertices were
+  // changed aren't cached.
+  std::atomic<uint64_t> generation_{0};
+  utils::Synchronized<std::map<std::pair<LabelId, PropertyId>, std::shared_ptr<const PropertyColumn>>,
+                      utils::SpinLock>
+      columns_;
+};
+
+}  // namespace memgraph::storage
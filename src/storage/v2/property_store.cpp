@@ -11,18 +11,25 @@
 
 #include "storage/v2/property_store.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <numeric>
 #include <optional>
 #include <sstream>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 
+#include "memory/memory_control.hpp"
+#include "storage/v2/cold_value_store.hpp"
 #include "storage/v2/temporal.hpp"
 #include "utils/cast.hpp"
+#include "utils/compressor.hpp"
 #include "utils/logging.hpp"
 
 namespace memgraph::storage {
@@ -85,6 +92,22 @@ namespace {
 // each and every ID to value mapping. That is why every possible bit is used
 // to store some useful information. Increasing the size of the metadata field
 // will increase memory usage for every stored ID to value mapping.
+//
+// Large values (strings, lists and maps whose encoded size is at least
+// `kExternalValueThreshold` bytes) aren't stored in the buffer itself. They are
+// encoded into a separately allocated block and the buffer only holds a pointer
+// to that block. Because of that, looking up, setting or removing any other
+// property only has to skip over (or move) the 8 byte pointer instead of the
+// whole large value. The buffer returned by `StringBuffer` never contains
+// out-of-line values, they are encoded inline so that the buffer can be
+// persisted.
+//
+// Buffers that hold at least `kIndexMinProperties` properties start with a
+// sparse index of property offsets. The index stores the ID and the offset of
+// every `kIndexStride`-th property, so a lookup is a binary search through the
+// index followed by decoding at most `kIndexStride` properties instead of
+// decoding all of the properties that precede the seeked one. The index is
+// rebuilt on every modification of the buffer (which is O(n) anyway).
 
 enum class Size : uint8_t {
   INT8 = 0x00,
@@ -105,9 +128,36 @@ enum class Type : uint8_t {
   STRING = 0x50,
   LIST = 0x60,
   MAP = 0x70,
-  TEMPORAL_DATA = 0x80
+  TEMPORAL_DATA = 0x80,
+  EXTERNAL = 0x90,  // Pointer to an out-of-line encoded value.
+  INDEX = 0xa0,     // Sparse property offsets index; only at buffer start.
 };
 
+// Values that are at least this large (when encoded) are stored out-of-line.
+const uint64_t kExternalValueThreshold = 128;
+
+// Out-of-line values that are at least this large (when encoded) are
+// compressed if compression is enabled.
+const uint64_t kCompressionThreshold = 512;
+// Set in the encoded value size of compressed out-of-line blocks.
+const uint64_t kCompressedBlockFlag = 1ULL << 63U;
+// Set in the encoded value size of out-of-line blocks evicted to a
+// `ColdValueStore`.
+const uint64_t kColdBlockFlag = 1ULL << 62U;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<bool> compression_enabled{false};
+
+// The number of out-of-line blocks of the process which are evicted to a
+// `ColdValueStore`, so the stores don't have to be scanned while it's 0.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<uint64_t> evicted_blocks{0};
+
+// Buffers with at least this many properties get a sparse offsets index.
+const uint64_t kIndexMinProperties = 16;
+// Every `kIndexStride`-th property is recorded in the index.
+const uint64_t kIndexStride = 8;
+
 const uint8_t kMaskType = 0xf0;
 const uint8_t kMaskIdSize = 0x0c;
 const uint8_t kMaskPayloadSize = 0x03;
@@ -167,6 +217,28 @@ const uint8_t kShiftIdSize = 2;
 //         or `uint64_t`
 //       + encoded temporal data type value
 //       + encoded microseconds value
+//   * INDEX
+//     - type; id size and payload size aren't used
+//     - number of index entries (always 2 bytes)
+//     - index entries
+//       + property ID (always 4 bytes)
+//       + offset of the property relative to the end of the index (always 4
+//         bytes)
+//   * EXTERNAL
+//     - type; payload size isn't used
+//     - encoded property ID
+//     - pointer to the out-of-line block (always 8 bytes)
+//       + encoded value size (always 8 bytes); the highest bit is set if the
+//         block is compressed
+//       + type; id size is not used; payload size is used as described above
+//         for the stored type
+//       + encoded value data
+//     - compressed out-of-line blocks store the compressed size (always 8
+//       bytes) after the encoded value size, followed by the zlib compressed
+//       type and encoded value data
+//     - evicted out-of-line blocks have the second highest bit of the encoded
+//       value size set, followed by the pointer to the `ColdValueStore` and the
+//       key of the original block in it (always 8 bytes each)
 
 struct Metadata {
   Type type{Type::EMPTY};
@@ -249,6 +321,10 @@ class Writer {
     return WriteBytes(reinterpret_cast<const uint8_t *>(data), size);
   }
 
+  bool WriteExternalBlock(const uint8_t *block) {
+    return WriteBytes(reinterpret_cast<const uint8_t *>(&block), sizeof(block));
+  }
+
   uint64_t Written() const { return pos_; }
 
  private:
@@ -379,6 +455,12 @@ class Reader {
     return true;
   }
 
+  std::optional<const uint8_t *> ReadExternalBlock() {
+    const uint8_t *block = nullptr;
+    if (!ReadBytes(reinterpret_cast<uint8_t *>(&block), sizeof(block))) return std::nullopt;
+    return block;
+  }
+
   uint64_t GetPosition() const { return pos_; }
 
  private:
@@ -472,6 +554,126 @@ std::optional<std::pair<Type, Size>> EncodePropertyValue(Writer *writer, const P
   }
 }
 
+// Returns the encoded size of `value` if the value should be stored
+// out-of-line. Only strings, lists and maps are candidates because they are
+// the only values that can grow arbitrarily large.
+std::optional<uint64_t> ExternalValueSize(const PropertyValue &value) {
+  if (!value.IsString() && !value.IsList() && !value.IsMap()) return std::nullopt;
+  Writer writer;
+  EncodePropertyValue(&writer, value);
+  if (writer.Written() < kExternalValueThreshold) return std::nullopt;
+  return writer.Written();
+}
+
+// Replaces the out-of-line `block` with a compressed one if compression is
+// enabled and it makes the block smaller.
+// @throw std::bad_alloc
+void CompressExternalBlock(std::unique_ptr<uint8_t[]> *block, uint64_t value_size) {
+  if (!compression_enabled.load(std::memory_order_relaxed) || value_size + 1 < kCompressionThreshold) return;
+  auto compressed = utils::CompressBuffer(block->get() + sizeof(uint64_t), value_size + 1);
+  if (!compressed || sizeof(uint64_t) + compressed->size() >= value_size + 1) return;
+  auto compressed_block = std::make_unique<uint8_t[]>(2 * sizeof(uint64_t) + compressed->size());
+  auto flagged_value_size = value_size | kCompressedBlockFlag;
+  uint64_t compressed_size = compressed->size();
+  memcpy(compressed_block.get(), &flagged_value_size, sizeof(uint64_t));
+  memcpy(compressed_block.get() + sizeof(uint64_t), &compressed_size, sizeof(uint64_t));
+  memcpy(compressed_block.get() + 2 * sizeof(uint64_t), compressed->data(), compressed_size);
+  *block = std::move(compressed_block);
+}
+
+// Allocates an out-of-line block and encodes `value` into it. The block must
+// be released with `delete[]`.
+// @throw std::bad_alloc
+std::unique_ptr<uint8_t[]> CreateExternalBlock(const PropertyValue &value, uint64_t value_size) {
+  auto block = std::make_unique<uint8_t[]>(sizeof(uint64_t) + 1 + value_size);
+  memcpy(block.get(), &value_size, sizeof(uint64_t));
+  Writer writer(block.get() + sizeof(uint64_t) + 1, value_size);
+  auto type_size = EncodePropertyValue(&writer, value);
+  MG_ASSERT(type_size, "Invalid database state!");
+  Writer::MetadataHandle(block.get() + sizeof(uint64_t)).Set({type_size->first, Size::INT8, type_size->second});
+  CompressExternalBlock(&block, value_size);
+  return block;
+}
+
+// Returns the size of the out-of-line `block` in bytes.
+uint64_t ExternalBlockSize(const uint8_t *block) {
+  uint64_t value_size;
+  memcpy(&value_size, block, sizeof(uint64_t));
+  if (value_size & kColdBlockFlag) return sizeof(uint64_t) + sizeof(ColdValueStore *) + sizeof(uint64_t);
+  if (!(value_size & kCompressedBlockFlag)) return sizeof(uint64_t) + 1 + value_size;
+  uint64_t compressed_size;
+  memcpy(&compressed_size, block + sizeof(uint64_t), sizeof(uint64_t));
+  return 2 * sizeof(uint64_t) + compressed_size;
+}
+
+// Returns the cold store and the key of the evicted out-of-line `block`.
+std::pair<ColdValueStore *, uint64_t> ColdBlockLocation(const uint8_t *block) {
+  ColdValueStore *cold_store = nullptr;
+  uint64_t key = 0;
+  memcpy(&cold_store, block + sizeof(uint64_t), sizeof(cold_store));
+  memcpy(&key, block + sizeof(uint64_t) + sizeof(cold_store), sizeof(key));
+  return {cold_store, key};
+}
+
+// Reads the original block of the value stored under `key` in `cold_store`.
+// @throw ColdValueStoreException
+// @throw std::bad_alloc
+std::unique_ptr<uint8_t[]> ReadColdBlock(const ColdValueStore &cold_store, uint64_t key) {
+  auto value = cold_store.Get(key);
+  if (!value || value->size() < sizeof(uint64_t)) {
+    throw ColdValueStoreException("The evicted property value {} couldn't be read from the disk.", key);
+  }
+  auto cold_block = std::make_unique<uint8_t[]>(value->size());
+  memcpy(cold_block.get(), value->data(), value->size());
+  return cold_block;
+}
+
+// Releases the out-of-line `block`. If it was evicted, its original block is
+// deleted from the cold store later, so that the caller doesn't wait for the
+// disk while holding the lock of the object.
+void FreeExternalBlock(const uint8_t *block) {
+  if (block == nullptr) return;
+  uint64_t value_size;
+  memcpy(&value_size, block, sizeof(uint64_t));
+  if (value_size & kColdBlockFlag) {
+    const auto [cold_store, key] = ColdBlockLocation(block);
+    cold_store->DeleteLater(key);
+    evicted_blocks.fetch_sub(1, std::memory_order_relaxed);
+  }
+  delete[] block;
+}
+
+// Returns a reader positioned at the metadata of the value stored in the
+// out-of-line `block`. Compressed blocks are decompressed into `decompressed`,
+// which has to outlive the returned reader.
+// @throw ColdValueStoreException
+// @throw std::bad_alloc
+std::optional<Reader> ExternalBlockReader(const uint8_t *block, std::unique_ptr<uint8_t[]> *decompressed) {
+  uint64_t value_size;
+  memcpy(&value_size, block, sizeof(uint64_t));
+  if (value_size & kColdBlockFlag) {
+    // The evicted block is read from the cold store on every read until it's
+    // loaded back into memory. The accessors load it back before they lock
+    // the object, so only the readers which don't lock the object get here.
+    const auto [cold_store, key] = ColdBlockLocation(block);
+    auto cold_block = ReadColdBlock(*cold_store, key);
+    std::unique_ptr<uint8_t[]> cold_decompressed;
+    auto reader = ExternalBlockReader(cold_block.get(), &cold_decompressed);
+    if (!reader) return std::nullopt;
+    *decompressed = cold_decompressed ? std::move(cold_decompressed) : std::move(cold_block);
+    return reader;
+  }
+  if (!(value_size & kCompressedBlockFlag)) return Reader(block + sizeof(uint64_t), value_size + 1);
+  value_size &= ~kCompressedBlockFlag;
+  uint64_t compressed_size;
+  memcpy(&compressed_size, block + sizeof(uint64_t), sizeof(uint64_t));
+  *decompressed = std::make_unique<uint8_t[]>(value_size + 1);
+  if (!utils::DecompressBuffer(block + 2 * sizeof(uint64_t), compressed_size, decompressed->get(), value_size + 1)) {
+    return std::nullopt;
+  }
+  return Reader(decompressed->get(), value_size + 1);
+}
+
 namespace {
 std::optional<TemporalData> DecodeTemporalData(Reader &reader) {
   auto metadata = reader.ReadMetadata();
@@ -606,6 +808,23 @@ std::optional<TemporalData> DecodeTemporalData(Reader &reader) {
 
       return true;
     }
+    case Type::INDEX: {
+      // The index isn't a value, it's skipped before decoding properties.
+      return false;
+    }
+    case Type::EXTERNAL: {
+      auto block = reader->ReadExternalBlock();
+      if (!block) return false;
+      if (value) {
+        std::unique_ptr<uint8_t[]> decompressed;
+        auto block_reader = ExternalBlockReader(*block, &decompressed);
+        if (!block_reader) return false;
+        auto metadata = block_reader->ReadMetadata();
+        if (!metadata) return false;
+        return DecodePropertyValue(&*block_reader, metadata->type, metadata->payload_size, value);
+      }
+      return true;
+    }
   }
 }
 
@@ -706,6 +925,19 @@ std::optional<TemporalData> DecodeTemporalData(Reader &reader) {
 
       return *maybe_temporal_data == value.ValueTemporalData();
     }
+    case Type::INDEX: {
+      return false;
+    }
+    case Type::EXTERNAL: {
+      auto block = reader->ReadExternalBlock();
+      if (!block) return false;
+      std::unique_ptr<uint8_t[]> decompressed;
+      auto block_reader = ExternalBlockReader(*block, &decompressed);
+      if (!block_reader) return false;
+      auto metadata = block_reader->ReadMetadata();
+      if (!metadata) return false;
+      return ComparePropertyValue(&*block_reader, metadata->type, metadata->payload_size, value);
+    }
   }
 }
 
@@ -725,6 +957,21 @@ bool EncodeProperty(Writer *writer, PropertyId property, const PropertyValue &va
   return true;
 }
 
+// Function used to encode a property whose value is stored in the out-of-line
+// `block` into a byte stream.
+bool EncodeExternalProperty(Writer *writer, PropertyId property, const uint8_t *block) {
+  auto metadata = writer->WriteMetadata();
+  if (!metadata) return false;
+
+  auto id_size = writer->WriteUint(property.AsUint());
+  if (!id_size) return false;
+
+  if (!writer->WriteExternalBlock(block)) return false;
+
+  metadata->Set({Type::EXTERNAL, *id_size, Size::INT64});
+  return true;
+}
+
 // Enum used to return status from the `DecodeExpectedProperty` function.
 enum class DecodeExpectedPropertyStatus {
   MISSING_DATA,
@@ -872,6 +1119,159 @@ SpecificPropertyAndBufferInfo FindSpecificPropertyAndBufferInfo(Reader *reader,
   return {property_begin, property_end, property_end - property_begin, all_begin, all_end, all_end - all_begin};
 }
 
+// Function used to find the property value of the property whose ID is
+// `property` when looking up multiple properties in ascending order of their
+// IDs. Unlike `FindSpecificProperty`, the reader is left positioned before the
+// first property with a greater ID, so the next lookup can continue from there.
+//
+// @sa FindSpecificProperty
+[[nodiscard]] DecodeExpectedPropertyStatus FindNextProperty(Reader *reader, PropertyId property,
+                                                            PropertyValue *value) {
+  while (true) {
+    auto before = *reader;
+    auto ret = DecodeExpectedProperty(reader, property, value);
+    if (ret == DecodeExpectedPropertyStatus::SMALLER) continue;
+    if (ret != DecodeExpectedPropertyStatus::EQUAL) *reader = before;
+    return ret;
+  }
+}
+
+struct IndexEntry {
+  uint32_t property_id;
+  uint32_t offset;
+};
+
+const uint64_t kIndexHeaderSize = sizeof(uint8_t) + sizeof(uint16_t);
+
+// Returns the size of the index stored at the start of `data` or 0 if the
+// buffer doesn't have an index.
+uint64_t IndexSize(const uint8_t *data, uint64_t size) {
+  if (size < kIndexHeaderSize || static_cast<Type>(data[0] & kMaskType) != Type::INDEX) return 0;
+  uint16_t count;
+  memcpy(&count, data + sizeof(uint8_t), sizeof(uint16_t));
+  return kIndexHeaderSize + count * sizeof(IndexEntry);
+}
+
+// Returns the offset (relative to the end of the index) of the last indexed
+// property whose ID isn't greater than `property`. Decoding of the properties
+// can start at that offset when seeking `property`.
+uint64_t IndexLookup(const uint8_t *data, uint64_t index_size, PropertyId property) {
+  if (index_size == 0) return 0;
+  const auto count = (index_size - kIndexHeaderSize) / sizeof(IndexEntry);
+  const auto *entries = data + kIndexHeaderSize;
+  auto entry_at = [entries](uint64_t i) {
+    IndexEntry entry;
+    memcpy(&entry, entries + i * sizeof(IndexEntry), sizeof(IndexEntry));
+    return entry;
+  };
+  // Find the first entry with a greater ID, the one before it is the result.
+  uint64_t begin = 0;
+  uint64_t end = count;
+  while (begin < end) {
+    auto mid = begin + (end - begin) / 2;
+    if (entry_at(mid).property_id <= property.AsUint()) {
+      begin = mid + 1;
+    } else {
+      end = mid;
+    }
+  }
+  if (begin == 0) return 0;
+  return entry_at(begin - 1).offset;
+}
+
+// Returns a reader for the properties encoded in `data` (skipping the index)
+// that starts at the best position for seeking `property`.
+Reader PropertiesReaderFor(const uint8_t *data, uint64_t size, PropertyId property) {
+  auto index_size = IndexSize(data, size);
+  auto offset = index_size + IndexLookup(data, index_size, property);
+  return {data + offset, size - offset};
+}
+
+// Returns a reader for all of the properties encoded in `data` (skipping the
+// index).
+Reader PropertiesReader(const uint8_t *data, uint64_t size) {
+  auto index_size = IndexSize(data, size);
+  return {data + index_size, size - index_size};
+}
+
+// Collects the index entries for the properties encoded in `data`. Returns an
+// empty vector if the buffer shouldn't be indexed. The end of the encoded
+// properties is stored in `properties_end`.
+std::vector<IndexEntry> CollectIndexEntries(const uint8_t *data, uint64_t size, uint64_t *properties_end) {
+  std::vector<IndexEntry> entries;
+  Reader reader(data, size);
+  uint64_t count = 0;
+  bool indexable = true;
+  while (true) {
+    auto position = reader.GetPosition();
+    auto property = DecodeAnyProperty(&reader, nullptr);
+    if (!property) break;
+    if (count % kIndexStride == 0) {
+      if (property->AsUint() > std::numeric_limits<uint32_t>::max() ||
+          position > std::numeric_limits<uint32_t>::max()) {
+        indexable = false;
+      }
+      entries.push_back({static_cast<uint32_t>(property->AsUint()), static_cast<uint32_t>(position)});
+    }
+    ++count;
+  }
+  *properties_end = reader.GetPosition();
+  if (!indexable || count < kIndexMinProperties || entries.size() > std::numeric_limits<uint16_t>::max()) return {};
+  return entries;
+}
+
+// Calls `callback` with every out-of-line block referenced from the encoded
+// properties in `data`.
+template <typename TCallback>
+void ForEachExternalBlock(const uint8_t *data, uint64_t size, const TCallback &callback) {
+  auto reader = PropertiesReader(data, size);
+  while (true) {
+    auto metadata = reader.ReadMetadata();
+    if (!metadata || metadata->type == Type::EMPTY) return;
+    if (!reader.ReadUint(metadata->id_size)) return;
+    if (metadata->type == Type::EXTERNAL) {
+      auto block = reader.ReadExternalBlock();
+      if (!block) return;
+      callback(*block);
+    } else if (!DecodePropertyValue(&reader, metadata->type, metadata->payload_size, nullptr)) {
+      return;
+    }
+  }
+}
+
+// Calls `callback` with the location of the pointer to every out-of-line block
+// referenced from the encoded properties in `data`, so that the block can be
+// replaced.
+template <typename TCallback>
+void ForEachExternalBlockPointer(uint8_t *data, uint64_t size, const TCallback &callback) {
+  auto index_size = IndexSize(data, size);
+  Reader reader(data + index_size, size - index_size);
+  while (true) {
+    auto metadata = reader.ReadMetadata();
+    if (!metadata || metadata->type == Type::EMPTY) return;
+    if (!reader.ReadUint(metadata->id_size)) return;
+    if (metadata->type == Type::EXTERNAL) {
+      auto *pointer = data + index_size + reader.GetPosition();
+      if (!reader.ReadExternalBlock()) return;
+      callback(pointer);
+    } else if (!DecodePropertyValue(&reader, metadata->type, metadata->payload_size, nullptr)) {
+      return;
+    }
+  }
+}
+
+// Releases all out-of-line blocks referenced from the encoded properties in
+// `data`.
+void FreeExternalBlocks(const uint8_t *data, uint64_t size) {
+  ForEachExternalBlock(data, size, [](const uint8_t *block) { FreeExternalBlock(block); });
+}
+
+bool HasExternalBlocks(const uint8_t *data, uint64_t size) {
+  bool found = false;
+  ForEachExternalBlock(data, size, [&found](const uint8_t * /*block*/) { found = true; });
+  return found;
+}
+
 // All data buffers will be allocated to a power of 8 size.
 uint64_t ToPowerOf8(uint64_t size) {
   uint64_t mod = size % 8;
@@ -925,10 +1325,58 @@ void SetSizeData(uint8_t *buffer, uint64_t size, uint8_t *data) {
   memcpy(buffer + sizeof(uint64_t), &data, sizeof(uint8_t *));
 }
 
+// Removes the index from the start of the external buffer (if there is one).
+// The properties are moved to the start of the buffer, the size of the buffer
+// is unchanged.
+void RemoveIndex(uint8_t *buffer) {
+  auto [size, data] = GetSizeData(buffer);
+  if (size % 8 != 0) return;
+  auto index_size = IndexSize(data, size);
+  if (index_size == 0) return;
+  memmove(data, data + index_size, size - index_size);
+  // Zeros act as the tombstone.
+  memset(data + size - index_size, 0, index_size);
+}
+
+// Builds the index at the start of the external buffer if the buffer holds
+// enough properties. The buffer mustn't already have an index.
+// @throw std::bad_alloc
+void BuildIndex(uint8_t *buffer) {
+  auto [size, data] = GetSizeData(buffer);
+  // Local buffers are too small to hold enough properties.
+  if (size % 8 != 0 || size == 0) return;
+  uint64_t properties_end = 0;
+  auto entries = CollectIndexEntries(data, size, &properties_end);
+  if (entries.empty()) return;
+
+  auto index_size = kIndexHeaderSize + entries.size() * sizeof(IndexEntry);
+  auto new_size = ToPowerOf8(index_size + properties_end);
+  if (new_size > size) {
+    auto *new_data = new uint8_t[new_size];
+    memcpy(new_data + index_size, data, properties_end);
+    memset(new_data + index_size + properties_end, 0, new_size - index_size - properties_end);
+    delete[] data;
+    SetSizeData(buffer, new_size, new_data);
+    data = new_data;
+  } else {
+    memmove(data + index_size, data, properties_end);
+    memset(data + index_size + properties_end, 0, size - index_size - properties_end);
+  }
+
+  data[0] = static_cast<uint8_t>(Type::INDEX);
+  auto count = static_cast<uint16_t>(entries.size());
+  memcpy(data + sizeof(uint8_t), &count, sizeof(uint16_t));
+  memcpy(data + kIndexHeaderSize, entries.data(), entries.size() * sizeof(IndexEntry));
+}
+
 }  // namespace
 
 PropertyStore::PropertyStore() { memset(buffer_, 0, sizeof(buffer_)); }
 
+void PropertyStore::EnableCompression(bool enabled) { compression_enabled.store(enabled, std::memory_order_relaxed); }
+
+bool PropertyStore::IsCompressionEnabled() { return compression_enabled.load(std::memory_order_relaxed); }
+
 PropertyStore::PropertyStore(PropertyStore &&other) noexcept {
   memcpy(buffer_, other.buffer_, sizeof(buffer_));
   memset(other.buffer_, 0, sizeof(other.buffer_));
@@ -940,7 +1388,10 @@ PropertyStore &PropertyStore::operator=(PropertyStore &&other) noexcept {
   std::tie(size, data) = GetSizeData(buffer_);
   if (size % 8 == 0) {
     // We are storing the data in an external buffer.
+    FreeExternalBlocks(data, size);
     delete[] data;
+  } else {
+    FreeExternalBlocks(&buffer_[1], sizeof(buffer_) - 1);
   }
 
   memcpy(buffer_, other.buffer_, sizeof(buffer_));
@@ -955,7 +1406,10 @@ PropertyStore::~PropertyStore() {
   std::tie(size, data) = GetSizeData(buffer_);
   if (size % 8 == 0) {
     // We are storing the data in an external buffer.
+    FreeExternalBlocks(data, size);
     delete[] data;
+  } else {
+    FreeExternalBlocks(&buffer_[1], sizeof(buffer_) - 1);
   }
 }
 
@@ -968,12 +1422,42 @@ PropertyValue PropertyStore::GetProperty(PropertyId property) const {
     size = sizeof(buffer_) - 1;
     data = &buffer_[1];
   }
-  Reader reader(data, size);
+  auto reader = PropertiesReaderFor(data, size, property);
   PropertyValue value;
   if (FindSpecificProperty(&reader, property, &value) != DecodeExpectedPropertyStatus::EQUAL) return PropertyValue();
   return value;
 }
 
+std::vector<PropertyValue> PropertyStore::GetProperties(const std::vector<PropertyId> &properties) const {
+  std::vector<PropertyValue> values(properties.size());
+  if (properties.empty()) return values;
+  uint64_t size;
+  const uint8_t *data;
+  std::tie(size, data) = GetSizeData(buffer_);
+  if (size % 8 != 0) {
+    // We are storing the data in the local buffer.
+    size = sizeof(buffer_) - 1;
+    data = &buffer_[1];
+  }
+  // The buffer is sorted by ID, so the properties are looked up in that order
+  // to decode it in a single pass.
+  std::vector<size_t> order(properties.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&properties](auto a, auto b) { return properties[a] < properties[b]; });
+  auto reader = PropertiesReaderFor(data, size, properties[order.front()]);
+  for (size_t i = 0; i < order.size(); ++i) {
+    auto &value = values[order[i]];
+    if (i > 0 && properties[order[i]] == properties[order[i - 1]]) {
+      value = values[order[i - 1]];
+      continue;
+    }
+    if (FindNextProperty(&reader, properties[order[i]], &value) != DecodeExpectedPropertyStatus::EQUAL) {
+      value = PropertyValue();
+    }
+  }
+  return values;
+}
+
 bool PropertyStore::HasProperty(PropertyId property) const {
   uint64_t size;
   const uint8_t *data;
@@ -983,13 +1467,25 @@ bool PropertyStore::HasProperty(PropertyId property) const {
     size = sizeof(buffer_) - 1;
     data = &buffer_[1];
   }
-  Reader reader(data, size);
+  auto reader = PropertiesReaderFor(data, size, property);
   return FindSpecificProperty(&reader, property, nullptr) == DecodeExpectedPropertyStatus::EQUAL;
 }
 
-/// TODO: andi write a unit test for it
 bool PropertyStore::HasAllProperties(const std::set<PropertyId> &properties) const {
-  return std::all_of(properties.begin(), properties.end(), [this](const auto &prop) { return HasProperty(prop); });
+  if (properties.empty()) return true;
+  uint64_t size;
+  const uint8_t *data;
+  std::tie(size, data) = GetSizeData(buffer_);
+  if (size % 8 != 0) {
+    // We are storing the data in the local buffer.
+    size = sizeof(buffer_) - 1;
+    data = &buffer_[1];
+  }
+  // Both the set and the buffer are sorted by ID, so a single pass suffices.
+  auto reader = PropertiesReaderFor(data, size, *properties.begin());
+  return std::all_of(properties.begin(), properties.end(), [&reader](const auto &prop) {
+    return FindNextProperty(&reader, prop, nullptr) == DecodeExpectedPropertyStatus::EQUAL;
+  });
 }
 
 /// TODO: andi write a unit test for it
@@ -1009,10 +1505,21 @@ bool PropertyStore::HasAllPropertyValues(const std::vector<PropertyValue> &prope
 std::optional<std::vector<PropertyValue>> PropertyStore::ExtractPropertyValues(
     const std::set<PropertyId> &properties) const {
   std::vector<PropertyValue> value_array;
+  if (properties.empty()) return value_array;
+  uint64_t size;
+  const uint8_t *data;
+  std::tie(size, data) = GetSizeData(buffer_);
+  if (size % 8 != 0) {
+    // We are storing the data in the local buffer.
+    size = sizeof(buffer_) - 1;
+    data = &buffer_[1];
+  }
   value_array.reserve(properties.size());
+  // Both the set and the buffer are sorted by ID, so a single pass suffices.
+  auto reader = PropertiesReaderFor(data, size, *properties.begin());
   for (const auto &prop : properties) {
-    auto value = GetProperty(prop);
-    if (value.IsNull()) {
+    PropertyValue value;
+    if (FindNextProperty(&reader, prop, &value) != DecodeExpectedPropertyStatus::EQUAL || value.IsNull()) {
       return std::nullopt;
     }
     value_array.emplace_back(std::move(value));
@@ -1029,12 +1536,15 @@ bool PropertyStore::IsPropertyEqual(PropertyId property, const PropertyValue &va
     size = sizeof(buffer_) - 1;
     data = &buffer_[1];
   }
-  Reader reader(data, size);
-  auto info = FindSpecificPropertyAndBufferInfo(&reader, property);
-  if (info.property_size == 0) return value.IsNull();
-  Reader prop_reader(data + info.property_begin, info.property_size);
-  if (!CompareExpectedProperty(&prop_reader, property, value)) return false;
-  return prop_reader.GetPosition() == info.property_size;
+  auto reader = PropertiesReaderFor(data, size, property);
+  while (true) {
+    auto property_reader = reader;
+    auto ret = DecodeExpectedProperty(&reader, property, nullptr);
+    if (ret == DecodeExpectedPropertyStatus::SMALLER) continue;
+    if (ret != DecodeExpectedPropertyStatus::EQUAL) return value.IsNull();
+    if (!CompareExpectedProperty(&property_reader, property, value)) return false;
+    return property_reader.GetPosition() == reader.GetPosition();
+  }
 }
 
 std::map<PropertyId, PropertyValue> PropertyStore::Properties() const {
@@ -1046,7 +1556,7 @@ std::map<PropertyId, PropertyValue> PropertyStore::Properties() const {
     size = sizeof(buffer_) - 1;
     data = &buffer_[1];
   }
-  Reader reader(data, size);
+  auto reader = PropertiesReader(data, size);
   std::map<PropertyId, PropertyValue> props;
   while (true) {
     PropertyValue value;
@@ -1058,12 +1568,26 @@ std::map<PropertyId, PropertyValue> PropertyStore::Properties() const {
 }
 
 bool PropertyStore::SetProperty(PropertyId property, const PropertyValue &value) {
+  std::unique_ptr<uint8_t[]> external_block;
   uint64_t property_size = 0;
   if (!value.IsNull()) {
     Writer writer;
-    EncodeProperty(&writer, property, value);
+    if (auto value_size = ExternalValueSize(value)) {
+      external_block = CreateExternalBlock(value, *value_size);
+      EncodeExternalProperty(&writer, property, external_block.get());
+    } else {
+      EncodeProperty(&writer, property, value);
+    }
     property_size = writer.Written();
   }
+  auto const encode_property = [&](Writer *writer) {
+    // The buffer takes ownership of the out-of-line block once it's encoded.
+    if (external_block) return EncodeExternalProperty(writer, property, external_block.release());
+    return EncodeProperty(writer, property, value);
+  };
+
+  // The index is rebuilt once the property is set.
+  RemoveIndex(buffer_);
 
   bool in_local_buffer = false;
   uint64_t size;
@@ -1101,7 +1625,7 @@ bool PropertyStore::SetProperty(PropertyId property, const PropertyValue &value)
 
       // Encode the property into the data buffer.
       Writer writer(data, size);
-      MG_ASSERT(EncodeProperty(&writer, property, value), "Invalid database state!");
+      MG_ASSERT(encode_property(&writer), "Invalid database state!");
       auto metadata = writer.WriteMetadata();
       if (metadata) {
         // If there is any space left in the buffer we add a tombstone to
@@ -1116,6 +1640,11 @@ bool PropertyStore::SetProperty(PropertyId property, const PropertyValue &value)
     Reader reader(data, size);
     auto info = FindSpecificPropertyAndBufferInfo(&reader, property);
     existed = info.property_size != 0;
+    // The old out-of-line value (if any) is released once the old encoding is
+    // overwritten.
+    const uint8_t *old_external_block = nullptr;
+    ForEachExternalBlock(data + info.property_begin, info.property_size,
+                         [&old_external_block](const uint8_t *block) { old_external_block = block; });
     auto new_size = info.all_size - info.property_size + property_size;
     auto new_size_to_power_of_8 = ToPowerOf8(new_size);
     if (new_size_to_power_of_8 == 0) {
@@ -1166,7 +1695,7 @@ bool PropertyStore::SetProperty(PropertyId property, const PropertyValue &value)
     if (!value.IsNull()) {
       // We need to encode the new value.
       Writer writer(data + info.property_begin, property_size);
-      MG_ASSERT(EncodeProperty(&writer, property, value), "Invalid database state!");
+      MG_ASSERT(encode_property(&writer), "Invalid database state!");
     }
 
     // We need to recreate the tombstone (if possible).
@@ -1175,8 +1704,12 @@ bool PropertyStore::SetProperty(PropertyId property, const PropertyValue &value)
     if (metadata) {
       metadata->Set({Type::EMPTY});
     }
+
+    FreeExternalBlock(old_external_block);
   }
 
+  BuildIndex(buffer_);
+
   return !existed;
 }
 
@@ -1190,13 +1723,24 @@ bool PropertyStore::DoInitProperties(const TContainer &properties) {
   }
 
   uint64_t property_size = 0;
+  // Out-of-line blocks of large values, one (possibly empty) entry for each
+  // property in `properties`.
+  std::vector<std::unique_ptr<uint8_t[]>> external_blocks;
+  external_blocks.reserve(properties.size());
   {
     Writer writer;
     for (const auto &[property, value] : properties) {
       if (value.IsNull()) {
+        external_blocks.emplace_back();
         continue;
       }
-      EncodeProperty(&writer, property, value);
+      if (auto value_size = ExternalValueSize(value)) {
+        external_blocks.emplace_back(CreateExternalBlock(value, *value_size));
+        EncodeExternalProperty(&writer, property, external_blocks.back().get());
+      } else {
+        external_blocks.emplace_back();
+        EncodeProperty(&writer, property, value);
+      }
       property_size = writer.Written();
     }
   }
@@ -1221,12 +1765,17 @@ bool PropertyStore::DoInitProperties(const TContainer &properties) {
   // Encode the property into the data buffer.
   Writer writer(data, size);
 
+  auto external_block = external_blocks.begin();
   for (const auto &[property, value] : properties) {
+    auto &block = *external_block++;
     if (value.IsNull()) {
       continue;
     }
-    MG_ASSERT(EncodeProperty(&writer, property, value), "Invalid database state!");
-    writer.Written();
+    if (block) {
+      MG_ASSERT(EncodeExternalProperty(&writer, property, block.release()), "Invalid database state!");
+    } else {
+      MG_ASSERT(EncodeProperty(&writer, property, value), "Invalid database state!");
+    }
   }
 
   auto metadata = writer.WriteMetadata();
@@ -1236,6 +1785,8 @@ bool PropertyStore::DoInitProperties(const TContainer &properties) {
     metadata->Set({Type::EMPTY});
   }
 
+  BuildIndex(buffer_);
+
   return true;
 }
 
@@ -1291,11 +1842,117 @@ bool PropertyStore::ClearProperties() {
     in_local_buffer = true;
   }
   if (!size) return false;
+  FreeExternalBlocks(data, size);
   if (!in_local_buffer) delete[] data;
   SetSizeData(buffer_, 0, nullptr);
   return true;
 }
 
+bool PropertyStore::Defragment() {
+  auto [size, data] = GetSizeData(buffer_);
+  // The local buffer is a part of the object which owns the store.
+  if (size % 8 != 0 || size == 0) return false;
+  if (!memory::IsFragmentedAllocation(data)) return false;
+  auto *new_data = static_cast<uint8_t *>(memory::AllocateForRelocation(size));
+  if (new_data == nullptr) return false;
+  memcpy(new_data, data, size);
+  delete[] data;
+  SetSizeData(buffer_, size, new_data);
+  return true;
+}
+
+uint64_t PropertyStore::EvictLargeValues(ColdValueStore *cold_store) {
+  auto [size, data] = GetSizeData(buffer_);
+  if (size % 8 != 0) {
+    size = sizeof(buffer_) - 1;
+    data = &buffer_[1];
+  }
+  if (size == 0) return 0;
+  uint64_t evicted = 0;
+  ForEachExternalBlockPointer(data, size, [&](uint8_t *pointer) {
+    const uint8_t *block = nullptr;
+    memcpy(&block, pointer, sizeof(block));
+    uint64_t value_size;
+    memcpy(&value_size, block, sizeof(uint64_t));
+    if (value_size & kColdBlockFlag) return;
+    const auto block_size = ExternalBlockSize(block);
+    auto key = cold_store->Put({reinterpret_cast<const char *>(block), block_size});
+    if (!key) return;
+    auto *cold_block = new uint8_t[sizeof(uint64_t) + sizeof(cold_store) + sizeof(*key)];
+    const auto flagged_value_size = (value_size & ~kCompressedBlockFlag) | kColdBlockFlag;
+    memcpy(cold_block, &flagged_value_size, sizeof(uint64_t));
+    memcpy(cold_block + sizeof(uint64_t), &cold_store, sizeof(cold_store));
+    memcpy(cold_block + sizeof(uint64_t) + sizeof(cold_store), &*key, sizeof(*key));
+    memcpy(pointer, &cold_block, sizeof(cold_block));
+    delete[] block;
+    evicted_blocks.fetch_add(1, std::memory_order_relaxed);
+    evicted += block_size;
+  });
+  return evicted;
+}
+
+bool PropertyStore::LoadColdValues() {
+  const auto values = EvictedValues();
+  if (values.empty()) return false;
+  RestoreEvictedValues(values, ReadEvictedValues(values));
+  return true;
+}
+
+std::vector<PropertyStore::EvictedValue> PropertyStore::EvictedValues() const {
+  std::vector<EvictedValue> values;
+  // The counter is changed while the lock of the evicted object is held, so
+  // it's up to date for the holder of the lock.
+  if (evicted_blocks.load(std::memory_order_relaxed) == 0) return values;
+  auto [size, data] = GetSizeData(buffer_);
+  if (size % 8 != 0) {
+    size = sizeof(buffer_) - 1;
+    data = &buffer_[1];
+  }
+  if (size == 0) return values;
+  ForEachExternalBlock(data, size, [&values](const uint8_t *block) {
+    uint64_t value_size;
+    memcpy(&value_size, block, sizeof(uint64_t));
+    if (!(value_size & kColdBlockFlag)) return;
+    const auto [cold_store, key] = ColdBlockLocation(block);
+    values.push_back({cold_store, key});
+  });
+  return values;
+}
+
+std::vector<std::unique_ptr<uint8_t[]>> PropertyStore::ReadEvictedValues(const std::vector<EvictedValue> &values) {
+  std::vector<std::unique_ptr<uint8_t[]>> blocks;
+  blocks.reserve(values.size());
+  for (const auto &value : values) blocks.push_back(ReadColdBlock(*value.cold_store, value.key));
+  return blocks;
+}
+
+void PropertyStore::RestoreEvictedValues(const std::vector<EvictedValue> &values,
+                                         std::vector<std::unique_ptr<uint8_t[]>> blocks) {
+  auto [size, data] = GetSizeData(buffer_);
+  if (size % 8 != 0) {
+    size = sizeof(buffer_) - 1;
+    data = &buffer_[1];
+  }
+  if (size == 0) return;
+  ForEachExternalBlockPointer(data, size, [&values, &blocks](uint8_t *pointer) {
+    const uint8_t *block = nullptr;
+    memcpy(&block, pointer, sizeof(block));
+    uint64_t value_size;
+    memcpy(&value_size, block, sizeof(uint64_t));
+    if (!(value_size & kColdBlockFlag)) return;
+    // The keys aren't reused, so a value which is still evicted under the same
+    // key wasn't changed since it was read.
+    const auto [cold_store, key] = ColdBlockLocation(block);
+    auto it = std::find_if(values.begin(), values.end(), [cold_store, key](const auto &value) {
+      return value.cold_store == cold_store && value.key == key;
+    });
+    if (it == values.end()) return;
+    auto *loaded_block = blocks[it - values.begin()].release();
+    memcpy(pointer, &loaded_block, sizeof(loaded_block));
+    FreeExternalBlock(block);
+  });
+}
+
 std::string PropertyStore::StringBuffer() const {
   uint64_t size = 0;
   const uint8_t *data = nullptr;
@@ -1304,6 +1961,21 @@ std::string PropertyStore::StringBuffer() const {
     size = sizeof(buffer_) - 1;
     data = &buffer_[1];
   }
+  if (HasExternalBlocks(data, size)) {
+    // Out-of-line values can't be persisted, so all of the values are encoded
+    // inline into the returned buffer.
+    auto properties = Properties();
+    Writer size_writer;
+    for (const auto &[property, value] : properties) EncodeProperty(&size_writer, property, value);
+    // The encoded values are larger than the local buffer, so the buffer size
+    // has to be a multiple of 8 to be loaded back with `SetBuffer`.
+    std::string arr(ToPowerOf8(size_writer.Written()), '\0');
+    Writer writer(reinterpret_cast<uint8_t *>(arr.data()), arr.size());
+    for (const auto &[property, value] : properties) {
+      MG_ASSERT(EncodeProperty(&writer, property, value), "Invalid database state!");
+    }
+    return arr;
+  }
   std::string arr(size, ' ');
   for (uint i = 0; i < size; ++i) {
     arr[i] = static_cast<char>(data[i]);
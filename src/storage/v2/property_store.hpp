@@ -12,13 +12,18 @@
 #pragma once
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <vector>
 
 #include "storage/v2/id_types.hpp"
 #include "storage/v2/property_value.hpp"
 
 namespace memgraph::storage {
 
+class ColdValueStore;
+
 class PropertyStore {
   static_assert(std::endian::native == std::endian::little,
                 "PropertyStore supports only architectures using little-endian.");
@@ -39,18 +44,36 @@ class PropertyStore {
 
   ~PropertyStore();
 
+  /// Enables or disables compression of large out-of-line property values for
+  /// all property stores in the process. Compressed values are decompressed
+  /// only when they are read. Values that are already stored keep their
+  /// current encoding until they are set again. The setting isn't part of the
+  /// storage config; it's set once at startup from the
+  /// `--storage-property-store-compression-enabled` flag.
+  static void EnableCompression(bool enabled);
+
+  static bool IsCompressionEnabled();
+
   /// Returns the currently stored value for property `property`. If the
   /// property doesn't exist a Null value is returned. The time complexity of
-  /// this function is O(n).
+  /// this function is O(n), or O(log(n)) once the store holds enough
+  /// properties to be indexed.
   /// @throw std::bad_alloc
   PropertyValue GetProperty(PropertyId property) const;
 
+  /// Returns the currently stored values for the properties `properties`, in
+  /// the same order. Null is returned for properties that don't exist. The
+  /// buffer is decoded in a single pass, so the time complexity of this
+  /// function is O(n + k*log(k)) where k is the size of `properties`.
+  /// @throw std::bad_alloc
+  std::vector<PropertyValue> GetProperties(const std::vector<PropertyId> &properties) const;
+
   /// Checks whether the property `property` exists in the store. The time
-  /// complexity of this function is O(n).
+  /// complexity of this function is O(n), or O(log(n)) for indexed stores.
   bool HasProperty(PropertyId property) const;
 
   /// Checks whether all properties in the set `properties` exist in the store. The time
-  /// complexity of this function is O(n^2).
+  /// complexity of this function is O(n + k) where k is the size of `properties`.
   bool HasAllProperties(const std::set<PropertyId> &properties) const;
 
   /// Checks whether all property values in the vector `property_values` exist in the store. The time
@@ -59,13 +82,13 @@ class PropertyStore {
   bool HasAllPropertyValues(const std::vector<PropertyValue> &property_values) const;
 
   /// Extracts property values for all property ids in the set `properties`. The time
-  /// complexity of this function is O(n^2).
+  /// complexity of this function is O(n + k) where k is the size of `properties`.
   std::optional<std::vector<PropertyValue>> ExtractPropertyValues(const std::set<PropertyId> &properties) const;
 
   /// Checks whether the property `property` is equal to the specified value
   /// `value`. This function doesn't perform any memory allocations while
-  /// performing the equality check. The time complexity of this function is
-  /// O(n).
+  /// performing the equality check, unless the stored value is compressed. The time complexity of this function is
+  /// O(n), or O(log(n)) for indexed stores.
   bool IsPropertyEqual(PropertyId property, const PropertyValue &value) const;
 
   /// Returns all properties currently stored in the store. The time complexity
@@ -105,6 +128,47 @@ class PropertyStore {
   /// @throw std::bad_alloc
   bool ClearProperties();
 
+  /// Moves the out-of-line buffer of the properties to a new allocation if the
+  /// allocator reports that it is in a sparsely used extent, and returns
+  /// whether it was moved. The blocks of the large values aren't moved. The
+  /// buffer mustn't be read concurrently.
+  bool Defragment();
+
+  /// Moves the out-of-line blocks of the large values to `cold_store`, which
+  /// has to outlive the store, and returns the number of moved bytes. The
+  /// evicted values are read from the cold store on every read until they are
+  /// loaded back with `LoadColdValues` or `RestoreEvictedValues`. The values
+  /// replaced or removed later are deleted from the cold store by
+  /// `ColdValueStore::DeletePending`. Reads of an evicted value which can't be
+  /// read from the disk throw `ColdValueStoreException`. The buffer mustn't be
+  /// read concurrently.
+  uint64_t EvictLargeValues(ColdValueStore *cold_store);
+
+  /// Moves the evicted out-of-line blocks back to memory and returns whether
+  /// there were any. The buffer mustn't be read concurrently.
+  /// @throw ColdValueStoreException if an evicted value can't be read
+  bool LoadColdValues();
+
+  /// The place of an evicted value in its cold store.
+  struct EvictedValue {
+    ColdValueStore *cold_store;
+    uint64_t key;
+  };
+
+  /// Returns the places of the evicted values. The buffer is only scanned if
+  /// any value of the process is evicted.
+  std::vector<EvictedValue> EvictedValues() const;
+
+  /// Reads the evicted values from their cold stores. No store is accessed,
+  /// so the lock of the object which owns the store doesn't have to be held.
+  /// @throw ColdValueStoreException if a value can't be read
+  static std::vector<std::unique_ptr<uint8_t[]>> ReadEvictedValues(const std::vector<EvictedValue> &values);
+
+  /// Moves the values read by `ReadEvictedValues` back to memory. The values
+  /// which were replaced or evicted again in the meantime are skipped. The
+  /// buffer mustn't be read concurrently.
+  void RestoreEvictedValues(const std::vector<EvictedValue> &values, std::vector<std::unique_ptr<uint8_t[]>> blocks);
+
   /// Return property buffer as a string
   std::string StringBuffer() const;
 
@@ -118,4 +182,20 @@ class PropertyStore {
   uint8_t buffer_[sizeof(uint64_t) + sizeof(uint8_t *)];
 };
 
+/// Locks the vertex or edge once none of its property values are evicted and
+/// returns the lock. The evicted values are read while the lock isn't held,
+/// so the other users of the object don't wait for the disk.
+/// @throw ColdValueStoreException if an evicted value can't be read
+template <typename TObject>
+std::unique_lock<decltype(TObject::lock)> LockWithLoadedProperties(TObject &object) {
+  std::unique_lock guard(object.lock);
+  for (auto values = object.properties.EvictedValues(); !values.empty(); values = object.properties.EvictedValues()) {
+    guard.unlock();
+    auto blocks = PropertyStore::ReadEvictedValues(values);
+    guard.lock();
+    object.properties.RestoreEvictedValues(values, std::move(blocks));
+  }
+  return guard;
+}
+
 }  // namespace memgraph::storage
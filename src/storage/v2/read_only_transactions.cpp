@@ -0,0 +1,64 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/read_only_transactions.hpp"
+
+#include <algorithm>
+
+namespace memgraph::storage {
+
+void ReadOnlyTransactions::Publish(const uint64_t start_timestamp, const uint64_t graph_version) {
+  const auto sequence = sequence_.load(std::memory_order_relaxed);
+  sequence_.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  start_timestamp_.store(start_timestamp, std::memory_order_relaxed);
+  graph_version_.store(graph_version, std::memory_order_relaxed);
+  sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+ReadOnlySnapshot ReadOnlyTransactions::Start() {
+  // Threads are assigned to the shards round-robin.
+  static std::atomic<size_t> next_shard{0};
+  thread_local size_t const shard = next_shard.fetch_add(1, std::memory_order_relaxed) % kShards;
+  while (true) {
+    const auto sequence = sequence_.load(std::memory_order_acquire);
+    if (sequence % 2 != 0) continue;
+    ReadOnlySnapshot snapshot{.start_timestamp = start_timestamp_.load(std::memory_order_acquire),
+                              .graph_version = graph_version_.load(std::memory_order_acquire),
+                              .shard = shard};
+    // If no snapshot was published until the transaction was registered, every
+    // commit newer than the snapshot finishes after that, so the GC sees the
+    // transaction before it can collect any of the deltas the transaction
+    // reads.
+    const bool registered = active_[shard].WithLock([&](auto &active) {
+      auto it = active.insert(snapshot.start_timestamp);
+      if (sequence_.load(std::memory_order_acquire) == sequence) return true;
+      active.erase(it);
+      return false;
+    });
+    if (registered) return snapshot;
+  }
+}
+
+void ReadOnlyTransactions::Finish(const ReadOnlySnapshot &snapshot) {
+  active_[snapshot.shard].WithLock([&](auto &active) { active.erase(active.find(snapshot.start_timestamp)); });
+}
+
+uint64_t ReadOnlyTransactions::OldestActive(uint64_t oldest_active) const {
+  for (auto &shard : active_) {
+    shard.WithLock([&](const auto &active) {
+      if (!active.empty()) oldest_active = std::min(oldest_active, *active.begin());
+    });
+  }
+  return oldest_active;
+}
+
+}  // namespace memgraph::storage
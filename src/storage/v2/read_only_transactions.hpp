@@ -0,0 +1,77 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Snapshots of the read-only transactions, which are started without the
+/// engine lock and aren't tracked by the commit log.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <set>
+
+#include "utils/spin_lock.hpp"
+#include "utils/synchronized.hpp"
+
+namespace memgraph::storage {
+
+/// Snapshot seen by a read-only transaction.
+struct ReadOnlySnapshot {
+  uint64_t start_timestamp;
+  uint64_t graph_version;
+  // The shard in which the transaction is registered.
+  size_t shard;
+};
+
+/// Publishes the snapshot which the read-only transactions start from and
+/// keeps the start timestamps of the active ones, so that the GC doesn't free
+/// the deltas they can still read.
+///
+/// The published start timestamp is the one after the commit timestamp of the
+/// last finished commit. Unlike the start timestamp of a regular transaction,
+/// it isn't taken from the transaction engine, so the commits whose timestamp
+/// was taken but which are still being written to the WAL aren't seen until
+/// they are finished.
+///
+/// This class is thread safe.
+class ReadOnlyTransactions final {
+ public:
+  /// Publishes a new snapshot. The calls must be serialized, e.g. by holding
+  /// the engine lock.
+  void Publish(uint64_t start_timestamp, uint64_t graph_version);
+
+  /// The start timestamp of the last published snapshot.
+  uint64_t PublishedStartTimestamp() const { return start_timestamp_.load(std::memory_order_acquire); }
+
+  /// Registers a new read-only transaction and returns its snapshot.
+  ReadOnlySnapshot Start();
+
+  /// Unregisters a read-only transaction returned by `Start`.
+  void Finish(const ReadOnlySnapshot &snapshot);
+
+  /// Returns the oldest start timestamp of the active read-only transactions
+  /// or `oldest_active` if it's older. Must be called after `oldest_active`
+  /// was read from the commit log.
+  uint64_t OldestActive(uint64_t oldest_active) const;
+
+ private:
+  static constexpr size_t kShards = 16;
+
+  // Even while no snapshot is being published. The snapshot is consistent if
+  // the sequence didn't change while it was read.
+  std::atomic<uint64_t> sequence_{0};
+  std::atomic<uint64_t> start_timestamp_{0};
+  std::atomic<uint64_t> graph_version_{0};
+  mutable std::array<utils::Synchronized<std::multiset<uint64_t>, utils::SpinLock>, kShards> active_;
+};
+
+}  // namespace memgraph::storage
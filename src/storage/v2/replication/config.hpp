@@ -30,6 +30,9 @@ struct ReplicationClientConfig {
   };
 
   std::optional<SSL> ssl;
+
+  // Compress snapshot and WAL files sent to the replica during its recovery
+  bool compression{false};
 };
 
 struct ReplicationServerConfig {
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <deque>
 #include <string>
@@ -60,6 +61,17 @@ struct ReplicaInfo {
   io::network::Endpoint endpoint;
   replication::ReplicaState state;
   TimestampInfo timestamp_info;
+  // Time it took the replica to acknowledge the last replicated transactions
+  std::chrono::microseconds acknowledgement_latency{0};
+};
+
+// Lag of a replica as last observed by MAIN, which is read without contacting
+// the replica.
+struct ReplicaLag {
+  std::string name;
+  replication::ReplicaState state;
+  uint64_t timestamps_behind_main;
+  std::chrono::microseconds acknowledgement_latency{0};
 };
 
 }  // namespace memgraph::storage
@@ -38,7 +38,8 @@ std::string RegisterReplicaErrorToString(ReplicationState::RegisterReplicaError
 }
 }  // namespace
 
-storage::ReplicationState::ReplicationState(bool restore, std::filesystem::path durability_dir) {
+storage::ReplicationState::ReplicationState(bool restore, std::filesystem::path durability_dir, uint64_t sync_quorum)
+    : sync_quorum_(sync_quorum) {
   if (restore) {
     utils::EnsureDirOrDie(durability_dir / durability::kReplicationDirectory);
     durability_ = std::make_unique<kvstore::KVStore>(durability_dir / durability::kReplicationDirectory);
@@ -85,27 +86,36 @@ bool storage::ReplicationState::SetMainReplicationRole(storage::Storage *storage
 }
 
 bool storage::ReplicationState::AppendOperation(const uint64_t seq_num, durability::StorageGlobalOperation operation,
-                                                LabelId label, const std::set<PropertyId> &properties,
+                                                LabelId label, const std::vector<PropertyId> &properties,
                                                 uint64_t final_commit_timestamp) {
   bool finalized_on_all_replicas = true;
+  std::optional<QuorumCommit> quorum;
   // TODO Should we return true if not MAIN?
   if (GetRole() == replication::ReplicationRole::MAIN) {
     replication_clients_.WithLock([&](auto &clients) {
+      quorum = StartQuorumCommit(clients);
       for (auto &client : clients) {
         client->StartTransactionReplication(seq_num);
         client->IfStreamingTransaction(
             [&](auto &stream) { stream.AppendOperation(operation, label, properties, final_commit_timestamp); });
 
-        const auto finalized = client->FinalizeTransactionReplication();
+        const auto finalized = FinalizeOnClient(*client, quorum);
         if (client->Mode() == replication::ReplicationMode::SYNC) {
           finalized_on_all_replicas = finalized && finalized_on_all_replicas;
         }
       }
     });
   }
+  if (quorum) {
+    finalized_on_all_replicas = quorum->acknowledgements->Wait(quorum->required);
+  }
   return finalized_on_all_replicas;
 }
 
+bool storage::ReplicationState::HasReplicas() {
+  return replication_clients_.WithLock([](auto &clients) { return !clients.empty(); });
+}
+
 void storage::ReplicationState::InitializeTransaction(uint64_t seq_num) {
   if (GetRole() == replication::ReplicationRole::MAIN) {
     replication_clients_.WithLock([&](auto &clients) {
@@ -116,37 +126,54 @@ void storage::ReplicationState::InitializeTransaction(uint64_t seq_num) {
   }
 }
 
-void storage::ReplicationState::AppendDelta(const Delta &delta, const Edge &parent, uint64_t timestamp) {
+void storage::ReplicationState::AppendEncodedDeltas(const std::vector<uint8_t> &deltas) {
   replication_clients_.WithLock([&](auto &clients) {
     for (auto &client : clients) {
-      client->IfStreamingTransaction([&](auto &stream) { stream.AppendDelta(delta, parent, timestamp); });
+      client->IfStreamingTransaction([&](auto &stream) { stream.AppendEncodedDeltas(deltas); });
     }
   });
 }
 
-void storage::ReplicationState::AppendDelta(const Delta &delta, const Vertex &parent, uint64_t timestamp) {
-  replication_clients_.WithLock([&](auto &clients) {
-    for (auto &client : clients) {
-      client->IfStreamingTransaction([&](auto &stream) { stream.AppendDelta(delta, parent, timestamp); });
-    }
-  });
-}
-
-bool storage::ReplicationState::FinalizeTransaction(uint64_t timestamp) {
+bool storage::ReplicationState::FinalizeTransaction() {
   bool finalized_on_all_replicas = true;
+  std::optional<QuorumCommit> quorum;
   replication_clients_.WithLock([&](auto &clients) {
+    quorum = StartQuorumCommit(clients);
     for (auto &client : clients) {
-      client->IfStreamingTransaction([&](auto &stream) { stream.AppendTransactionEnd(timestamp); });
-      const auto finalized = client->FinalizeTransactionReplication();
+      const auto finalized = FinalizeOnClient(*client, quorum);
 
       if (client->Mode() == replication::ReplicationMode::SYNC) {
         finalized_on_all_replicas = finalized && finalized_on_all_replicas;
       }
     }
   });
+  // The clients aren't locked while waiting so the replicas can be registered and unregistered meanwhile
+  if (quorum) {
+    finalized_on_all_replicas = quorum->acknowledgements->Wait(quorum->required);
+  }
   return finalized_on_all_replicas;
 }
 
+std::optional<storage::ReplicationState::QuorumCommit> storage::ReplicationState::StartQuorumCommit(
+    const std::vector<std::unique_ptr<ReplicationClient>> &clients) const {
+  if (sync_quorum_ == 0) return std::nullopt;
+  const auto sync_replicas = std::count_if(clients.begin(), clients.end(), [](const auto &client) {
+    return client->Mode() == replication::ReplicationMode::SYNC;
+  });
+  if (sync_replicas == 0) return std::nullopt;
+  return QuorumCommit{.acknowledgements = std::make_shared<CommitAcknowledgements>(sync_replicas),
+                      .required = std::min<uint64_t>(sync_quorum_, sync_replicas)};
+}
+
+bool storage::ReplicationState::FinalizeOnClient(ReplicationClient &client, const std::optional<QuorumCommit> &quorum) {
+  if (!quorum || client.Mode() != replication::ReplicationMode::SYNC) {
+    return client.FinalizeTransactionReplication();
+  }
+  // The confirmation counts as a failure if the client drops it without confirming
+  (void)client.FinalizeTransactionReplication(std::make_shared<CommitConfirmation>(quorum->acknowledgements));
+  return true;
+}
+
 utils::BasicResult<ReplicationState::RegisterReplicaError> ReplicationState::RegisterReplica(
     std::string name, io::network::Endpoint endpoint, const replication::ReplicationMode replication_mode,
     const replication::RegistrationMode registration_mode, const replication::ReplicationClientConfig &config,
@@ -178,7 +205,8 @@ utils::BasicResult<ReplicationState::RegisterReplicaError> ReplicationState::Reg
                                        .sync_mode = replication_mode,
                                        .replica_check_frequency = config.replica_check_frequency,
                                        .ssl = config.ssl,
-                                       .role = replication::ReplicationRole::REPLICA});
+                                       .role = replication::ReplicationRole::REPLICA,
+                                       .compression = config.compression});
     if (!durability_->Put(name, data.dump())) {
       spdlog::error("Error when saving replica {} in settings.", name);
       return RegisterReplicaError::COULD_NOT_BE_PERSISTED;
@@ -283,12 +311,40 @@ std::vector<ReplicaInfo> ReplicationState::ReplicasInfo() {
     replica_info.reserve(clients.size());
     std::transform(
         clients.begin(), clients.end(), std::back_inserter(replica_info), [](const auto &client) -> ReplicaInfo {
-          return {client->Name(), client->Mode(), client->Endpoint(), client->State(), client->GetTimestampInfo()};
+          return {client->Name(), client->Mode(), client->Endpoint(), client->State(), client->GetTimestampInfo(),
+                  client->AcknowledgementLatency()};
         });
     return replica_info;
   });
 }
 
+std::vector<ReplicaLag> ReplicationState::ReplicasLag() {
+  const auto main_commit = last_commit_timestamp_.load();
+  return replication_clients_.WithLock([main_commit](auto &clients) {
+    std::vector<ReplicaLag> replica_lag;
+    replica_lag.reserve(clients.size());
+    std::transform(clients.begin(), clients.end(), std::back_inserter(replica_lag),
+                   [main_commit](const auto &client) -> ReplicaLag {
+                     const auto replica_commit = client->ReplicaCommitTimestamp();
+                     return {client->Name(), client->State(),
+                             main_commit > replica_commit ? main_commit - replica_commit : 0,
+                             client->AcknowledgementLatency()};
+                   });
+    return replica_lag;
+  });
+}
+
+std::optional<uint64_t> ReplicationState::OldestReplicaCommitTimestamp() {
+  return replication_clients_.WithLock([](auto &clients) -> std::optional<uint64_t> {
+    std::optional<uint64_t> oldest;
+    for (const auto &client : clients) {
+      const auto replica_commit = client->ReplicaCommitTimestamp();
+      if (!oldest || replica_commit < *oldest) oldest = replica_commit;
+    }
+    return oldest;
+  });
+}
+
 void ReplicationState::RestoreReplicationRole(Storage *storage) {
   if (!ShouldStoreAndRestoreReplicationState()) {
     return;
@@ -358,6 +414,7 @@ void ReplicationState::RestoreReplicas(Storage *storage) {
                         {
                             .replica_check_frequency = replica_status.replica_check_frequency,
                             .ssl = replica_status.ssl,
+                            .compression = replica_status.compression,
                         },
                         storage);
 
@@ -29,6 +29,7 @@ namespace memgraph::storage {
 class Storage;
 class ReplicationServer;
 class ReplicationClient;
+class CommitAcknowledgements;
 
 struct ReplicationState {
   enum class RegisterReplicaError : uint8_t {
@@ -39,7 +40,7 @@ struct ReplicationState {
   };
 
   // TODO: This mirrors the logic in InMemoryConstructor; make it independent
-  ReplicationState(bool restore, std::filesystem::path durability_dir);
+  ReplicationState(bool restore, std::filesystem::path durability_dir, uint64_t sync_quorum = 0);
 
   // Generic API
   void Reset();
@@ -55,11 +56,12 @@ struct ReplicationState {
 
   // MAIN actually doing the replication
   bool AppendOperation(uint64_t seq_num, durability::StorageGlobalOperation operation, LabelId label,
-                       const std::set<PropertyId> &properties, uint64_t final_commit_timestamp);
+                       const std::vector<PropertyId> &properties, uint64_t final_commit_timestamp);
+  bool HasReplicas();
   void InitializeTransaction(uint64_t seq_num);
-  void AppendDelta(const Delta &delta, const Vertex &parent, uint64_t timestamp);
-  void AppendDelta(const Delta &delta, const Edge &parent, uint64_t timestamp);
-  bool FinalizeTransaction(uint64_t timestamp);
+  // Appends the deltas of the transaction, including its end, which are encoded only once for all replicas
+  void AppendEncodedDeltas(const std::vector<uint8_t> &deltas);
+  bool FinalizeTransaction();
 
   // MAIN connecting to replicas
   utils::BasicResult<RegisterReplicaError> RegisterReplica(std::string name, io::network::Endpoint endpoint,
@@ -76,6 +78,9 @@ struct ReplicationState {
   // TODO make into const (problem with SpinLock and WithReadLock)
   std::optional<replication::ReplicaState> GetReplicaState(std::string_view name);
   std::vector<ReplicaInfo> ReplicasInfo();
+  std::vector<ReplicaLag> ReplicasLag();
+  // Oldest commit timestamp among the registered replicas, nullopt if there are none
+  std::optional<uint64_t> OldestReplicaCommitTimestamp();
 
   const ReplicationEpoch &GetEpoch() const { return epoch_; }
   ReplicationEpoch &GetEpoch() { return epoch_; }
@@ -97,6 +102,16 @@ struct ReplicationState {
  private:
   bool ShouldStoreAndRestoreReplicationState() const { return nullptr != durability_; }
 
+  // Commit that waits only for a quorum of the SYNC replicas
+  struct QuorumCommit {
+    std::shared_ptr<CommitAcknowledgements> acknowledgements;
+    uint64_t required;
+  };
+
+  std::optional<QuorumCommit> StartQuorumCommit(const std::vector<std::unique_ptr<ReplicationClient>> &clients) const;
+
+  static bool FinalizeOnClient(ReplicationClient &client, const std::optional<QuorumCommit> &quorum);
+
   void SetRole(replication::ReplicationRole role) { return replication_role_.store(role); }
 
   // NOTE: Server is not in MAIN it is in REPLICA
@@ -119,6 +134,9 @@ struct ReplicationState {
 
   std::unique_ptr<kvstore::KVStore> durability_;
 
+  // Number of SYNC replicas awaited on commit, 0 means all of them
+  uint64_t sync_quorum_;
+
   ReplicationEpoch epoch_;
 };
 
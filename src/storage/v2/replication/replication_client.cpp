@@ -12,6 +12,8 @@
 #include "storage/v2/replication/replication_client.hpp"
 
 #include <algorithm>
+#include <cstring>
+#include <iterator>
 #include <type_traits>
 
 #include "storage/v2/durability/durability.hpp"
@@ -21,10 +23,37 @@
 #include "storage/v2/transaction.hpp"
 #include "utils/file_locker.hpp"
 #include "utils/logging.hpp"
+#include "utils/event_histogram.hpp"
 #include "utils/message.hpp"
 
+namespace memgraph::metrics {
+extern const Event ReplicaAcknowledgementLatency_us;
+}  // namespace memgraph::metrics
+
 namespace memgraph::storage {
 
+void CommitAcknowledgements::Acknowledge(const bool success) {
+  {
+    std::lock_guard guard(lock_);
+    MG_ASSERT(remaining_ > 0, "More acknowledgements than replicas of a commit");
+    --remaining_;
+    if (success) ++confirmed_;
+  }
+  cv_.notify_all();
+}
+
+bool CommitAcknowledgements::Wait(const uint64_t required) {
+  std::unique_lock guard(lock_);
+  cv_.wait(guard, [&] { return confirmed_ >= required || confirmed_ + remaining_ < required; });
+  return confirmed_ >= required;
+}
+
+void CommitConfirmation::Confirm(const bool success) {
+  if (!acknowledgements_) return;
+  acknowledgements_->Acknowledge(success);
+  acknowledgements_.reset();
+}
+
 static auto CreateClientContext(const replication::ReplicationClientConfig &config) -> communication::ClientContext {
   return (config.ssl) ? communication::ClientContext{config.ssl->key_file, config.ssl->cert_file}
                       : communication::ClientContext{};
@@ -35,8 +64,10 @@ ReplicationClient::ReplicationClient(Storage *storage, std::string name, memgrap
                                      replication::ReplicationClientConfig const &config)
     : name_{std::move(name)},
       rpc_context_{CreateClientContext(config)},
-      rpc_client_{std::move(endpoint), &rpc_context_},
+      rpc_client_{endpoint, &rpc_context_},
+      control_rpc_client_{std::move(endpoint), &rpc_context_},
       replica_check_frequency_{config.replica_check_frequency},
+      compression_{config.compression},
       mode_{mode},
       storage_{storage} {}
 
@@ -82,6 +113,7 @@ void ReplicationClient::InitializeClient() {
   }
 
   current_commit_timestamp = replica.current_commit_timestamp;
+  replica_commit_timestamp_.store(current_commit_timestamp);
   spdlog::trace("Current timestamp on replica {}: {}", name_, current_commit_timestamp);
   spdlog::trace("Current timestamp on main: {}", storage_->replication_state_.last_commit_timestamp_.load());
   if (current_commit_timestamp == storage_->replication_state_.last_commit_timestamp_.load()) {
@@ -104,7 +136,7 @@ TimestampInfo ReplicationClient::GetTimestampInfo() {
   info.current_number_of_timestamp_behind_master = 0;
 
   try {
-    auto stream{rpc_client_.Stream<replication::TimestampRpc>()};
+    auto stream{control_rpc_client_.Stream<replication::TimestampRpc>()};
     const auto response = stream.AwaitResponse();
     const auto is_success = response.success;
     if (!is_success) {
@@ -112,6 +144,7 @@ TimestampInfo ReplicationClient::GetTimestampInfo() {
       HandleRpcFailure();
     }
     auto main_time_stamp = storage_->replication_state_.last_commit_timestamp_.load();
+    replica_commit_timestamp_.store(response.current_commit_timestamp);
     info.current_timestamp_of_replica = response.current_commit_timestamp;
     info.current_number_of_timestamp_behind_master = response.current_commit_timestamp - main_time_stamp;
   } catch (const rpc::RpcFailedException &) {
@@ -157,6 +190,14 @@ void ReplicationClient::StartTransactionReplication(const uint64_t current_wal_s
       spdlog::debug("Replica {} is behind MAIN instance", name_);
       return;
     case replication::ReplicaState::REPLICATING:
+      if (mode_ == replication::ReplicationMode::ASYNC || awaits_quorum_) {
+        // The previous AppendDeltasRpc is still in flight so the transaction is encoded into memory and sent
+        // together with all other transactions committed until the replica acknowledges the previous ones.
+        MG_ASSERT(!batched_stream_);
+        batched_stream_.emplace(ReplicaStream::Buffered(
+            this, storage_->replication_state_.last_commit_timestamp_.load(), current_wal_seq_num));
+        return;
+      }
       spdlog::debug("Replica {} missed a transaction", name_);
       // We missed a transaction because we're still replicating
       // the previous transaction so we need to go to RECOVERY
@@ -175,6 +216,7 @@ void ReplicationClient::StartTransactionReplication(const uint64_t current_wal_s
       try {
         replica_stream_.emplace(
             ReplicaStream{this, storage_->replication_state_.last_commit_timestamp_.load(), current_wal_seq_num});
+        replica_stream_start_ = std::chrono::steady_clock::now();
         replica_state_.store(replication::ReplicaState::REPLICATING);
       } catch (const rpc::RpcFailedException &) {
         replica_state_.store(replication::ReplicaState::INVALID);
@@ -186,7 +228,51 @@ void ReplicationClient::StartTransactionReplication(const uint64_t current_wal_s
 
 auto ReplicationClient::GetEpochId() const -> std::string const & { return storage_->replication_state_.GetEpoch().id; }
 
-bool ReplicationClient::FinalizeTransactionReplication() {
+bool ReplicationClient::FinalizeTransactionReplication(std::shared_ptr<CommitConfirmation> confirmation) {
+  std::vector<std::shared_ptr<CommitConfirmation>> confirmations;
+  if (confirmation) {
+    awaits_quorum_ = true;
+    confirmations.push_back(std::move(confirmation));
+  }
+
+  if (batched_stream_) {
+    auto batch = batched_stream_->ReleaseBatch();
+    batched_stream_.reset();
+    batch.confirmations = std::move(confirmations);
+
+    std::unique_lock client_guard(client_lock_);
+    switch (replica_state_.load()) {
+      case replication::ReplicaState::REPLICATING:
+        break;
+      case replication::ReplicaState::READY:
+        // The in-flight AppendDeltasRpc was acknowledged while this transaction was being encoded.
+        replica_state_.store(replication::ReplicaState::REPLICATING);
+        thread_pool_.AddTask([this] { (void)this->ProcessReplicaStream({}); });
+        break;
+      case replication::ReplicaState::RECOVERY:
+      case replication::ReplicaState::INVALID:
+        // The recovery process will send the transaction from the WAL files
+        return false;
+    }
+
+    if (pending_batch_.transactions == 0) {
+      pending_batch_ = std::move(batch);
+      return true;
+    }
+    if (pending_batch_.deltas.size() + batch.deltas.size() > kMaxPendingBatchSize) {
+      spdlog::debug("Replica {} is too far behind MAIN instance", name_);
+      // The replication task will start the recovery process once it's done with the in-flight transactions
+      pending_batch_ = {};
+      replica_state_.store(replication::ReplicaState::RECOVERY);
+      return false;
+    }
+    pending_batch_.deltas.insert(pending_batch_.deltas.end(), batch.deltas.begin(), batch.deltas.end());
+    pending_batch_.seq_num = batch.seq_num;
+    pending_batch_.transactions += batch.transactions;
+    std::move(batch.confirmations.begin(), batch.confirmations.end(), std::back_inserter(pending_batch_.confirmations));
+    return true;
+  }
+
   // We can only check the state because it guarantees to be only
   // valid during a single transaction replication (if the assumption
   // that this and other transaction replication functions can only be
@@ -195,42 +281,87 @@ bool ReplicationClient::FinalizeTransactionReplication() {
     return false;
   }
 
-  auto task = [this]() {
-    MG_ASSERT(replica_stream_, "Missing stream for transaction deltas");
+  if (mode_ == replication::ReplicationMode::ASYNC || !confirmations.empty()) {
+    thread_pool_.AddTask([this, confirmations = std::move(confirmations)] {
+      (void)this->ProcessReplicaStream(confirmations);
+    });
+    return true;
+  }
+
+  return ProcessReplicaStream({});
+}
+
+bool ReplicationClient::ProcessReplicaStream(std::vector<std::shared_ptr<CommitConfirmation>> confirmations) {
+  // Waits for the in-flight AppendDeltasRpc and keeps sending the transactions batched in the meantime. The replica
+  // acknowledges each batch with the commit timestamp of its last transaction.
+  while (true) {
     try {
+      if (!replica_stream_) {
+        ReplicaBatch batch;
+        {
+          std::unique_lock client_guard(client_lock_);
+          if (replica_state_ == replication::ReplicaState::RECOVERY) {
+            // The batch was dropped before it was sent so the replica is asked where to recover from
+            pending_batch_ = {};
+            client_guard.unlock();
+            InitializeClient();
+            return false;
+          }
+          if (replica_state_ != replication::ReplicaState::REPLICATING) {
+            pending_batch_ = {};
+            return false;
+          }
+          if (pending_batch_.transactions == 0) {
+            replica_state_.store(replication::ReplicaState::READY);
+            return true;
+          }
+          batch = std::exchange(pending_batch_, {});
+        }
+        spdlog::trace("Sending {} batched transactions to replica {}", batch.transactions, name_);
+        confirmations = std::move(batch.confirmations);
+        replica_stream_.emplace(
+            ReplicaStream{this, batch.previous_commit_timestamp, batch.seq_num, batch.transactions});
+        replica_stream_start_ = std::chrono::steady_clock::now();
+        replica_stream_->AppendEncodedDeltas(batch.deltas);
+      }
+
       auto response = replica_stream_->Finalize();
       replica_stream_.reset();
+      const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                                 replica_stream_start_);
+      acknowledgement_latency_us_.store(latency.count());
+      memgraph::metrics::Measure(memgraph::metrics::ReplicaAcknowledgementLatency_us, latency.count());
       std::unique_lock client_guard(client_lock_);
       if (!response.success || replica_state_ == replication::ReplicaState::RECOVERY) {
+        pending_batch_ = {};
         replica_state_.store(replication::ReplicaState::RECOVERY);
-        thread_pool_.AddTask([&, this] { this->RecoverReplica(response.current_commit_timestamp); });
-      } else {
-        replica_state_.store(replication::ReplicaState::READY);
-        return true;
+        thread_pool_.AddTask([this, replica_commit = response.current_commit_timestamp] {
+          this->RecoverReplica(replica_commit);
+        });
+        return false;
       }
+      replica_commit_timestamp_.store(response.current_commit_timestamp);
+      for (auto &confirmation : confirmations) {
+        confirmation->Confirm(true);
+      }
+      confirmations.clear();
     } catch (const rpc::RpcFailedException &) {
       replica_stream_.reset();
       {
         std::unique_lock client_guard(client_lock_);
+        pending_batch_ = {};
         replica_state_.store(replication::ReplicaState::INVALID);
       }
       HandleRpcFailure();
+      return false;
     }
-    return false;
-  };
-
-  if (mode_ == replication::ReplicationMode::ASYNC) {
-    thread_pool_.AddTask([=] { (void)task(); });
-    return true;
   }
-
-  return task();
 }
 
 void ReplicationClient::FrequentCheck() {
   const auto is_success = std::invoke([this]() {
     try {
-      auto stream{rpc_client_.Stream<replication::FrequentHeartbeatRpc>()};
+      auto stream{control_rpc_client_.Stream<replication::FrequentHeartbeatRpc>()};
       const auto response = stream.AwaitResponse();
       return response.success;
     } catch (const rpc::RpcFailedException &) {
@@ -260,11 +391,19 @@ void ReplicationClient::Start() {
 
   // Help the user to get the most accurate replica state possible.
   if (replica_check_frequency_ > std::chrono::seconds(0)) {
-    replica_checker_.Run("Replica Checker", replica_check_frequency_, [this] { this->FrequentCheck(); });
+    replica_checker_.Run(
+        "Replica Checker", replica_check_frequency_, [this] { this->FrequentCheck(); },
+        {.priority = utils::PeriodicTaskPriority::HIGH});
   }
 }
 
 void ReplicationClient::IfStreamingTransaction(const std::function<void(ReplicaStream &)> &callback) {
+  // Batched transaction is kept even if the in-flight AppendDeltasRpc finishes in the meantime
+  if (batched_stream_) {
+    callback(*batched_stream_);
+    return;
+  }
+
   // We can only check the state because it guarantees to be only
   // valid during a single transaction replication (if the assumption
   // that this and other transaction replication functions can only be
@@ -286,36 +425,57 @@ void ReplicationClient::IfStreamingTransaction(const std::function<void(ReplicaS
 
 ////// ReplicaStream //////
 ReplicaStream::ReplicaStream(ReplicationClient *self, const uint64_t previous_commit_timestamp,
-                             const uint64_t current_seq_num)
+                             const uint64_t current_seq_num, const uint64_t transactions)
     : self_(self),
-      stream_(self_->rpc_client_.Stream<replication::AppendDeltasRpc>(previous_commit_timestamp, current_seq_num)) {
-  replication::Encoder encoder{stream_.GetBuilder()};
+      stream_(self_->rpc_client_.Stream<replication::AppendDeltasRpc>(previous_commit_timestamp, current_seq_num,
+                                                                        transactions)) {
+  replication::Encoder encoder{stream_->GetBuilder()};
 
   encoder.WriteString(self_->GetEpochId());
 }
 
-void ReplicaStream::AppendDelta(const Delta &delta, const Vertex &vertex, uint64_t final_commit_timestamp) {
-  replication::Encoder encoder(stream_.GetBuilder());
-  auto *storage = self_->GetStorage();
-  EncodeDelta(&encoder, storage->name_id_mapper_.get(), storage->config_.items, delta, vertex, final_commit_timestamp);
-}
+ReplicaStream::ReplicaStream(ReplicationClient *self, std::unique_ptr<Buffer> buffer)
+    : self_(self), buffer_(std::move(buffer)) {}
 
-void ReplicaStream::AppendDelta(const Delta &delta, const Edge &edge, uint64_t final_commit_timestamp) {
-  replication::Encoder encoder(stream_.GetBuilder());
-  EncodeDelta(&encoder, self_->GetStorage()->name_id_mapper_.get(), delta, edge, final_commit_timestamp);
+ReplicaStream ReplicaStream::Buffered(ReplicationClient *self, const uint64_t previous_commit_timestamp,
+                                      const uint64_t current_seq_num) {
+  auto buffer = std::make_unique<Buffer>();
+  buffer->batch.previous_commit_timestamp = previous_commit_timestamp;
+  buffer->batch.seq_num = current_seq_num;
+  buffer->batch.transactions = 1;
+  return ReplicaStream{self, std::move(buffer)};
 }
 
-void ReplicaStream::AppendTransactionEnd(uint64_t final_commit_timestamp) {
-  replication::Encoder encoder(stream_.GetBuilder());
-  EncodeTransactionEnd(&encoder, final_commit_timestamp);
-}
+ReplicaStream::Buffer::Buffer()
+    : builder([this](const uint8_t *segment, size_t /*size*/, bool /*have_more*/) {
+        // Only the data of the segment is kept, the stream the batch is sent with frames it again.
+        slk::SegmentSize data_size{0};
+        memcpy(&data_size, segment, sizeof(slk::SegmentSize));
+        const auto *data = segment + sizeof(slk::SegmentSize);
+        batch.deltas.insert(batch.deltas.end(), data, data + data_size);
+      }) {}
+
+slk::Builder *ReplicaStream::GetBuilder() { return buffer_ ? &buffer_->builder : stream_->GetBuilder(); }
 
 void ReplicaStream::AppendOperation(durability::StorageGlobalOperation operation, LabelId label,
-                                    const std::set<PropertyId> &properties, uint64_t timestamp) {
-  replication::Encoder encoder(stream_.GetBuilder());
+                                    const std::vector<PropertyId> &properties, uint64_t timestamp) {
+  replication::Encoder encoder(GetBuilder());
   EncodeOperation(&encoder, self_->GetStorage()->name_id_mapper_.get(), operation, label, properties, timestamp);
 }
 
-replication::AppendDeltasRes ReplicaStream::Finalize() { return stream_.AwaitResponse(); }
+void ReplicaStream::AppendEncodedDeltas(const std::vector<uint8_t> &deltas) {
+  GetBuilder()->Save(deltas.data(), deltas.size());
+}
+
+replication::AppendDeltasRes ReplicaStream::Finalize() {
+  MG_ASSERT(stream_, "Buffered replica stream can't be finalized");
+  return stream_->AwaitResponse();
+}
+
+ReplicaBatch ReplicaStream::ReleaseBatch() {
+  MG_ASSERT(buffer_, "Only buffered replica stream holds a batch");
+  buffer_->builder.Finalize();
+  return std::move(buffer_->batch);
+}
 
 }  // namespace memgraph::storage
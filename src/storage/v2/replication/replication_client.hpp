@@ -18,13 +18,19 @@
 #include "storage/v2/replication/enums.hpp"
 #include "storage/v2/replication/global.hpp"
 #include "storage/v2/replication/rpc.hpp"
+#include "storage/v2/transaction.hpp"
 #include "utils/file_locker.hpp"
 #include "utils/scheduler.hpp"
 #include "utils/thread_pool.hpp"
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
+#include <vector>
 #include <string>
 
 namespace memgraph::storage {
@@ -35,30 +41,92 @@ struct Edge;
 class Storage;
 class ReplicationClient;
 
+// Responses of the SYNC replicas to a single commit that only waits for a quorum of them.
+class CommitAcknowledgements {
+ public:
+  explicit CommitAcknowledgements(uint64_t replicas) : remaining_(replicas) {}
+
+  void Acknowledge(bool success);
+
+  // Blocks until `required` replicas confirmed the commit or it can't happen anymore. Returns whether the commit was
+  // confirmed by enough replicas.
+  bool Wait(uint64_t required);
+
+ private:
+  std::mutex lock_;
+  std::condition_variable cv_;
+  uint64_t confirmed_{0};
+  uint64_t remaining_;
+};
+
+// Acknowledgement of a single replica. If it's destroyed before `Confirm` is called, e.g. because the transaction
+// was dropped or the replica was unregistered, the replica is counted as failed.
+class CommitConfirmation {
+ public:
+  explicit CommitConfirmation(std::shared_ptr<CommitAcknowledgements> acknowledgements)
+      : acknowledgements_(std::move(acknowledgements)) {}
+
+  CommitConfirmation(const CommitConfirmation &) = delete;
+  CommitConfirmation(CommitConfirmation &&) = delete;
+  CommitConfirmation &operator=(const CommitConfirmation &) = delete;
+  CommitConfirmation &operator=(CommitConfirmation &&) = delete;
+
+  ~CommitConfirmation() { Confirm(false); }
+
+  void Confirm(bool success);
+
+ private:
+  std::shared_ptr<CommitAcknowledgements> acknowledgements_;
+};
+
+// Transactions committed while an AppendDeltasRpc is in flight. They are encoded back to back and sent to the
+// replica with a single AppendDeltasRpc once the previous one is acknowledged.
+struct ReplicaBatch {
+  std::vector<uint8_t> deltas;
+  uint64_t previous_commit_timestamp{0};
+  uint64_t seq_num{0};
+  uint64_t transactions{0};
+  std::vector<std::shared_ptr<CommitConfirmation>> confirmations;
+};
+
 // Handler used for transferring the current transaction.
 class ReplicaStream {
  public:
-  explicit ReplicaStream(ReplicationClient *self, uint64_t previous_commit_timestamp, uint64_t current_seq_num);
+  explicit ReplicaStream(ReplicationClient *self, uint64_t previous_commit_timestamp, uint64_t current_seq_num,
+                         uint64_t transactions = 1);
 
-  /// @throw rpc::RpcFailedException
-  void AppendDelta(const Delta &delta, const Vertex &vertex, uint64_t final_commit_timestamp);
+  // Creates a stream that encodes the transaction into memory instead of sending it. The encoded transaction is
+  // taken with `ReleaseBatch` and sent later together with other batched transactions.
+  static ReplicaStream Buffered(ReplicationClient *self, uint64_t previous_commit_timestamp, uint64_t current_seq_num);
 
   /// @throw rpc::RpcFailedException
-  void AppendDelta(const Delta &delta, const Edge &edge, uint64_t final_commit_timestamp);
-
-  /// @throw rpc::RpcFailedException
-  void AppendTransactionEnd(uint64_t final_commit_timestamp);
+  void AppendOperation(durability::StorageGlobalOperation operation, LabelId label,
+                       const std::vector<PropertyId> &properties, uint64_t timestamp);
 
+  /// Appends already encoded deltas of whole transactions, see `durability::EncodedDeltas`.
   /// @throw rpc::RpcFailedException
-  void AppendOperation(durability::StorageGlobalOperation operation, LabelId label,
-                       const std::set<PropertyId> &properties, uint64_t timestamp);
+  void AppendEncodedDeltas(const std::vector<uint8_t> &deltas);
 
   /// @throw rpc::RpcFailedException
   replication::AppendDeltasRes Finalize();
 
+  ReplicaBatch ReleaseBatch();
+
  private:
+  struct Buffer {
+    Buffer();
+
+    ReplicaBatch batch;
+    slk::Builder builder;
+  };
+
+  explicit ReplicaStream(ReplicationClient *self, std::unique_ptr<Buffer> buffer);
+
+  slk::Builder *GetBuilder();
+
   ReplicationClient *self_;
-  rpc::Client::StreamHandler<replication::AppendDeltasRpc> stream_;
+  std::optional<rpc::Client::StreamHandler<replication::AppendDeltasRpc>> stream_;
+  std::unique_ptr<Buffer> buffer_;
 };
 
 class ReplicationClient {
@@ -81,6 +149,12 @@ class ReplicationClient {
   auto Endpoint() const -> io::network::Endpoint const & { return rpc_client_.Endpoint(); }
   auto State() const -> replication::ReplicaState { return replica_state_.load(); }
   auto GetTimestampInfo() -> TimestampInfo;
+  // Time it took the replica to acknowledge the last replicated transactions
+  auto AcknowledgementLatency() const -> std::chrono::microseconds {
+    return std::chrono::microseconds{acknowledgement_latency_us_.load()};
+  }
+  // Last commit timestamp the replica reported, i.e. the deltas the replica already has
+  auto ReplicaCommitTimestamp() const -> uint64_t { return replica_commit_timestamp_.load(); }
 
   void Start();
   void StartTransactionReplication(const uint64_t current_wal_seq_num);
@@ -91,7 +165,9 @@ class ReplicationClient {
   // StartTransactionReplication, stream is created.
   void IfStreamingTransaction(const std::function<void(ReplicaStream &)> &callback);
   // Return whether the transaction could be finalized on the replication client or not.
-  [[nodiscard]] bool FinalizeTransactionReplication();
+  // If `confirmation` is passed, the commit doesn't wait for the replica. The confirmation
+  // is confirmed once the replica acknowledges the transaction.
+  [[nodiscard]] bool FinalizeTransactionReplication(std::shared_ptr<CommitConfirmation> confirmation = nullptr);
 
  protected:
   virtual void RecoverReplica(uint64_t replica_commit) = 0;
@@ -104,16 +180,35 @@ class ReplicationClient {
   void TryInitializeClientAsync();
   void TryInitializeClientSync();
   void FrequentCheck();
+  bool ProcessReplicaStream(std::vector<std::shared_ptr<CommitConfirmation>> confirmations);
+
+  // Upper bound on the size of `pending_batch_`. A replica that falls this far behind goes to RECOVERY.
+  static constexpr uint64_t kMaxPendingBatchSize = 64ULL * 1024 * 1024;
 
   std::string name_;
   communication::ClientContext rpc_context_;
   rpc::Client rpc_client_;
+  // Separate connection for the heartbeats and timestamp checks so they aren't
+  // blocked behind the data streams, e.g. a snapshot transfer.
+  rpc::Client control_rpc_client_;
   std::chrono::seconds replica_check_frequency_;
+  bool compression_;
 
   std::optional<ReplicaStream> replica_stream_;
+  // When `replica_stream_` was opened
+  std::chrono::steady_clock::time_point replica_stream_start_;
+  std::atomic<uint64_t> acknowledgement_latency_us_{0};
+  std::atomic<uint64_t> replica_commit_timestamp_{kTimestampInitialId};
+  // Stream of the current transaction when it's being batched. Only used by the committing thread.
+  std::optional<ReplicaStream> batched_stream_;
+  // Set once the commits stop waiting for this SYNC replica since only a quorum of SYNC replicas is
+  // awaited. Only used by the committing thread.
+  bool awaits_quorum_{false};
   replication::ReplicationMode mode_{replication::ReplicationMode::SYNC};
 
   utils::SpinLock client_lock_;
+  // Protected by `client_lock_`
+  ReplicaBatch pending_batch_;
   // This thread pool is used for background tasks so we don't
   // block the main storage thread
   // We use only 1 thread for 2 reasons:
@@ -23,6 +23,7 @@ inline constexpr auto *kCheckFrequency = "replica_check_frequency";
 inline constexpr auto *kSSLKeyFile = "replica_ssl_key_file";
 inline constexpr auto *kSSLCertFile = "replica_ssl_cert_file";
 inline constexpr auto *kReplicationRole = "replication_role";
+inline constexpr auto *kCompression = "replica_compression";
 }  // namespace
 
 namespace memgraph::storage::replication {
@@ -49,6 +50,8 @@ nlohmann::json ReplicationStatusToJSON(ReplicationStatus &&status) {
     data[kReplicationRole] = *status.role;
   }
 
+  data[kCompression] = status.compression;
+
   return data;
 }
 
@@ -82,6 +85,11 @@ std::optional<ReplicationStatus> JSONToReplicationStatus(nlohmann::json &&data)
       replica_status.role = replication::ReplicationRole::MAIN;
       data.at(kReplicationRole).get_to(replica_status.role.value());
     }
+
+    // Replicas persisted before compression was configurable don't have the field
+    if (data.find(kCompression) != data.end()) {
+      data.at(kCompression).get_to(replica_status.compression);
+    }
   } catch (const nlohmann::json::type_error &exception) {
     spdlog::error(get_failed_message("Invalid type conversion", exception.what()));
     return std::nullopt;
@@ -35,6 +35,7 @@ struct ReplicationStatus {
   std::chrono::seconds replica_check_frequency;
   std::optional<ReplicationClientConfig::SSL> ssl;
   std::optional<ReplicationRole> role;
+  bool compression{false};
 
   friend bool operator==(const ReplicationStatus &, const ReplicationStatus &) = default;
 };
@@ -23,11 +23,13 @@ auto CreateServerContext(const replication::ReplicationServerConfig &config) ->
                       : communication::ServerContext{};
 }
 
-// NOTE: The replication server must have a single thread for processing
-// because there is no need for more processing threads - each replica can
-// have only a single main server. Also, the single-threaded guarantee
-// simplifies the rest of the implementation.
-constexpr auto kReplictionServerThreads = 1;
+// NOTE: Each replica can have only a single main server which opens one
+// connection for the data RPCs and one for the control RPCs (heartbeats and
+// timestamp checks). The second thread answers the control RPCs while a long
+// data RPC, e.g. a snapshot transfer, is being processed. The data RPCs still
+// run one at a time because their handlers hold `data_lock_`, and that
+// single-threaded guarantee simplifies the rest of the implementation.
+constexpr auto kReplictionServerThreads = 2;
 }  // namespace
 
 ReplicationServer::ReplicationServer(io::network::Endpoint endpoint, const replication::ReplicationServerConfig &config)
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "rpc/server.hpp"
 #include "slk/streams.hpp"
 #include "storage/v2/replication/config.hpp"
@@ -35,6 +37,9 @@ class ReplicationServer {
 
   communication::ServerContext rpc_server_context_;
   rpc::Server rpc_server_;
+  // Held by the handlers of the data RPCs, so they are processed one at a
+  // time while the control RPCs are answered by the other server thread.
+  std::mutex data_lock_;
 };
 
 }  // namespace memgraph::storage
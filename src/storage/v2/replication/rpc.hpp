@@ -32,11 +32,12 @@ struct AppendDeltasReq {
   static void Load(AppendDeltasReq *self, memgraph::slk::Reader *reader);
   static void Save(const AppendDeltasReq &self, memgraph::slk::Builder *builder);
   AppendDeltasReq() {}
-  AppendDeltasReq(uint64_t previous_commit_timestamp, uint64_t seq_num)
-      : previous_commit_timestamp(previous_commit_timestamp), seq_num(seq_num) {}
+  AppendDeltasReq(uint64_t previous_commit_timestamp, uint64_t seq_num, uint64_t transactions)
+      : previous_commit_timestamp(previous_commit_timestamp), seq_num(seq_num), transactions(transactions) {}
 
   uint64_t previous_commit_timestamp;
   uint64_t seq_num;
+  uint64_t transactions;
 };
 
 struct AppendDeltasRes {
@@ -11,6 +11,10 @@
 
 #include "storage/v2/replication/serialization.hpp"
 
+#include <vector>
+
+#include "utils/compressor.hpp"
+
 namespace memgraph::storage::replication {
 ////// Encoder //////
 void Encoder::WriteMarker(durability::Marker marker) { slk::Save(marker, builder_); }
@@ -42,18 +46,45 @@ void Encoder::WritePropertyValue(const PropertyValue &value) {
 
 void Encoder::WriteBuffer(const uint8_t *buffer, const size_t buffer_size) { builder_->Save(buffer, buffer_size); }
 
-void Encoder::WriteFileData(utils::InputFile *file) {
-  auto file_size = file->GetSize();
+void Encoder::WriteCompressedBuffer(const uint8_t *buffer, size_t buffer_size) {
+  while (buffer_size > 0) {
+    const auto chunk_size = std::min(buffer_size, utils::kFileBufferSize);
+    WriteUint(chunk_size);
+    auto compressed = utils::CompressBuffer(buffer, chunk_size);
+    if (compressed && compressed->size() < chunk_size) {
+      WriteUint(compressed->size());
+      WriteBuffer(compressed->data(), compressed->size());
+    } else {
+      // Compressed size 0 marks a chunk that is sent as it is
+      WriteUint(0);
+      WriteBuffer(buffer, chunk_size);
+    }
+    buffer += chunk_size;
+    buffer_size -= chunk_size;
+  }
+}
+
+void Encoder::WriteFileData(utils::InputFile *file, const bool compress) {
+  const auto position = file->GetPosition();
+  MG_ASSERT(position <= file->GetSize(), "Invalid file position!");
+  auto file_size = file->GetSize() - position;
+  if (!compress) {
+    // The data isn't changed, so the builder writes it straight from the file.
+    builder_->SaveFile(file->fd(), position, file_size);
+    MG_ASSERT(file->SetPosition(utils::InputFile::Position::SET, static_cast<ssize_t>(position + file_size)),
+              "Failed to set the position in the file {}", file->path());
+    return;
+  }
   uint8_t buffer[utils::kFileBufferSize];
   while (file_size > 0) {
     const auto chunk_size = std::min(file_size, utils::kFileBufferSize);
     file->Read(buffer, chunk_size);
-    WriteBuffer(buffer, chunk_size);
+    WriteCompressedBuffer(buffer, chunk_size);
     file_size -= chunk_size;
   }
 }
 
-void Encoder::WriteFile(const std::filesystem::path &path) {
+void Encoder::WriteFile(const std::filesystem::path &path, const bool compress) {
   utils::InputFile file;
   MG_ASSERT(file.Open(path), "Failed to open file {}", path);
   MG_ASSERT(path.has_filename(), "Path does not have a filename!");
@@ -61,7 +92,8 @@ void Encoder::WriteFile(const std::filesystem::path &path) {
   WriteString(filename);
   auto file_size = file.GetSize();
   WriteUint(file_size);
-  WriteFileData(&file);
+  WriteBool(compress);
+  WriteFileData(&file, compress);
   file.Close();
 }
 
@@ -110,8 +142,9 @@ std::optional<PropertyValue> Decoder::ReadPropertyValue() {
 
 bool Decoder::SkipString() {
   if (const auto marker = ReadMarker(); !marker || marker != durability::Marker::TYPE_STRING) return false;
-  std::string value;
-  slk::Load(&value, reader_);
+  std::string_view value;
+  std::string storage;
+  slk::LoadView(&value, &storage, reader_);
   return true;
 }
 
@@ -136,10 +169,32 @@ std::optional<std::filesystem::path> Decoder::ReadFile(const std::filesystem::pa
   std::optional<size_t> maybe_file_size = ReadUint();
   MG_ASSERT(maybe_file_size, "File size missing");
   auto file_size = *maybe_file_size;
+  const auto maybe_compressed = ReadBool();
+  MG_ASSERT(maybe_compressed, "File compression flag missing");
   uint8_t buffer[utils::kFileBufferSize];
+  std::vector<uint8_t> compressed_buffer;
   while (file_size > 0) {
-    const auto chunk_size = std::min(file_size, utils::kFileBufferSize);
-    reader_->Load(buffer, chunk_size);
+    auto chunk_size = std::min(file_size, utils::kFileBufferSize);
+    if (!*maybe_compressed) {
+      reader_->Load(buffer, chunk_size);
+      file.Write(buffer, chunk_size);
+      file_size -= chunk_size;
+      continue;
+    }
+
+    const auto maybe_chunk_size = ReadUint();
+    const auto maybe_compressed_size = ReadUint();
+    MG_ASSERT(maybe_chunk_size && maybe_compressed_size, "Compressed chunk header missing");
+    MG_ASSERT(*maybe_chunk_size > 0 && *maybe_chunk_size <= chunk_size, "Invalid compressed chunk size");
+    chunk_size = *maybe_chunk_size;
+    if (*maybe_compressed_size == 0) {
+      reader_->Load(buffer, chunk_size);
+    } else {
+      compressed_buffer.resize(*maybe_compressed_size);
+      reader_->Load(compressed_buffer.data(), compressed_buffer.size());
+      MG_ASSERT(utils::DecompressBuffer(compressed_buffer.data(), compressed_buffer.size(), buffer, chunk_size),
+                "Failed to decompress file data");
+    }
     file.Write(buffer, chunk_size);
     file_size -= chunk_size;
   }
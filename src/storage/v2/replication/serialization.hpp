@@ -39,9 +39,17 @@ class Encoder final : public durability::BaseEncoder {
 
   void WriteBuffer(const uint8_t *buffer, size_t buffer_size);
 
-  void WriteFileData(utils::InputFile *file);
+  /// Writes the buffer as a sequence of chunks, each of them compressed
+  /// unless the compression doesn't make it smaller.
+  void WriteCompressedBuffer(const uint8_t *buffer, size_t buffer_size);
 
-  void WriteFile(const std::filesystem::path &path);
+  /// Writes the data of the file from its current position to the end. The
+  /// data which isn't compressed is written by the builder straight from the
+  /// file, e.g. with `sendfile`, so a transfer can also resume from an offset
+  /// set with `InputFile::SetPosition`.
+  void WriteFileData(utils::InputFile *file, bool compress = false);
+
+  void WriteFile(const std::filesystem::path &path, bool compress = false);
 
  private:
   slk::Builder *builder_;
@@ -67,7 +75,8 @@ class Decoder final : public durability::BaseDecoder {
 
   bool SkipPropertyValue() override;
 
-  /// Read the file and save it inside the specified directory.
+  /// Read the file and save it inside the specified directory. Compressed
+  /// file data is decompressed while it's being saved.
   /// @param directory Directory which will contain the read file.
   /// @param suffix Suffix to be added to the received file's filename.
   /// @return If the read was successful, path to the read file.
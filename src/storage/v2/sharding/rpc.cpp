@@ -0,0 +1,110 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/sharding/rpc.hpp"
+
+#include "storage/v2/replication/slk.hpp"
+#include "utils/typeinfo.hpp"
+
+namespace memgraph {
+
+namespace storage::sharding {
+
+void ExpandReq::Save(const ExpandReq &self, memgraph::slk::Builder *builder) { memgraph::slk::Save(self, builder); }
+void ExpandReq::Load(ExpandReq *self, memgraph::slk::Reader *reader) { memgraph::slk::Load(self, reader); }
+void ExpandRes::Save(const ExpandRes &self, memgraph::slk::Builder *builder) { memgraph::slk::Save(self, builder); }
+void ExpandRes::Load(ExpandRes *self, memgraph::slk::Reader *reader) { memgraph::slk::Load(self, reader); }
+void ScanReq::Save(const ScanReq &self, memgraph::slk::Builder *builder) { memgraph::slk::Save(self, builder); }
+void ScanReq::Load(ScanReq *self, memgraph::slk::Reader *reader) { memgraph::slk::Load(self, reader); }
+void ScanRes::Save(const ScanRes &self, memgraph::slk::Builder *builder) { memgraph::slk::Save(self, builder); }
+void ScanRes::Load(ScanRes *self, memgraph::slk::Reader *reader) { memgraph::slk::Load(self, reader); }
+
+}  // namespace storage::sharding
+
+constexpr utils::TypeInfo storage::sharding::ExpandReq::kType{utils::TypeId::SHARD_EXPAND_REQ, "ExpandReq", nullptr};
+
+constexpr utils::TypeInfo storage::sharding::ExpandRes::kType{utils::TypeId::SHARD_EXPAND_RES, "ExpandRes", nullptr};
+
+constexpr utils::TypeInfo storage::sharding::ScanReq::kType{utils::TypeId::SHARD_SCAN_REQ, "ScanReq", nullptr};
+
+constexpr utils::TypeInfo storage::sharding::ScanRes::kType{utils::TypeId::SHARD_SCAN_RES, "ScanRes", nullptr};
+
+namespace slk {
+
+void Save(const memgraph::storage::sharding::ExpandReq &self, memgraph::slk::Builder *builder) {
+  memgraph::slk::Save(self.vertex_gids, builder);
+  memgraph::slk::Save(self.direction, builder);
+  memgraph::slk::Save(self.edge_types, builder);
+}
+
+void Load(memgraph::storage::sharding::ExpandReq *self, memgraph::slk::Reader *reader) {
+  memgraph::slk::Load(&self->vertex_gids, reader);
+  memgraph::slk::Load(&self->direction, reader);
+  memgraph::slk::Load(&self->edge_types, reader);
+}
+
+void Save(const memgraph::storage::sharding::ExpandRes &self, memgraph::slk::Builder *builder) {
+  memgraph::slk::Save(self.edge_types, builder);
+  const uint64_t size = self.edges.size();
+  memgraph::slk::Save(size, builder);
+  for (const auto &edge : self.edges) {
+    memgraph::slk::Save(edge.vertex_gid, builder);
+    memgraph::slk::Save(edge.edge_gid, builder);
+    memgraph::slk::Save(edge.edge_type, builder);
+    memgraph::slk::Save(edge.other_vertex_gid, builder);
+  }
+}
+
+void Load(memgraph::storage::sharding::ExpandRes *self, memgraph::slk::Reader *reader) {
+  memgraph::slk::Load(&self->edge_types, reader);
+  uint64_t size = 0;
+  memgraph::slk::Load(&size, reader);
+  self->edges.resize(size);
+  for (auto &edge : self->edges) {
+    memgraph::slk::Load(&edge.vertex_gid, reader);
+    memgraph::slk::Load(&edge.edge_gid, reader);
+    memgraph::slk::Load(&edge.edge_type, reader);
+    memgraph::slk::Load(&edge.other_vertex_gid, reader);
+  }
+}
+
+void Save(const memgraph::storage::sharding::ScanReq &self, memgraph::slk::Builder *builder) {
+  memgraph::slk::Save(self.label, builder);
+  memgraph::slk::Save(self.property, builder);
+  memgraph::slk::Save(self.value, builder);
+  memgraph::slk::Save(self.after_gid, builder);
+  memgraph::slk::Save(self.limit, builder);
+  memgraph::slk::Save(self.count_only, builder);
+}
+
+void Load(memgraph::storage::sharding::ScanReq *self, memgraph::slk::Reader *reader) {
+  memgraph::slk::Load(&self->label, reader);
+  memgraph::slk::Load(&self->property, reader);
+  memgraph::slk::Load(&self->value, reader);
+  memgraph::slk::Load(&self->after_gid, reader);
+  memgraph::slk::Load(&self->limit, reader);
+  memgraph::slk::Load(&self->count_only, reader);
+}
+
+void Save(const memgraph::storage::sharding::ScanRes &self, memgraph::slk::Builder *builder) {
+  memgraph::slk::Save(self.vertex_gids, builder);
+  memgraph::slk::Save(self.count, builder);
+  memgraph::slk::Save(self.has_more, builder);
+}
+
+void Load(memgraph::storage::sharding::ScanRes *self, memgraph::slk::Reader *reader) {
+  memgraph::slk::Load(&self->vertex_gids, reader);
+  memgraph::slk::Load(&self->count, reader);
+  memgraph::slk::Load(&self->has_more, reader);
+}
+
+}  // namespace slk
+}  // namespace memgraph
@@ -0,0 +1,132 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rpc/messages.hpp"
+#include "slk/serialization.hpp"
+#include "slk/streams.hpp"
+#include "storage/v2/edge_direction.hpp"
+#include "storage/v2/property_value.hpp"
+
+namespace memgraph::storage::sharding {
+
+// NOTE: The labels, edge types and properties are sent by their names because
+// each shard has its own name to ID mapping.
+
+/// Edge of a vertex which is stored on a remote shard.
+struct RemoteEdge {
+  uint64_t vertex_gid;
+  uint64_t edge_gid;
+  /// Index of the edge type in `ExpandRes::edge_types`.
+  uint32_t edge_type;
+  uint64_t other_vertex_gid;
+};
+
+/// Returns the edges of a batch of vertices, so that a traversal makes one
+/// request per shard instead of one per vertex.
+struct ExpandReq {
+  static const utils::TypeInfo kType;
+  static const utils::TypeInfo &GetTypeInfo() { return kType; }
+
+  static void Load(ExpandReq *self, memgraph::slk::Reader *reader);
+  static void Save(const ExpandReq &self, memgraph::slk::Builder *builder);
+  ExpandReq() {}
+  ExpandReq(std::vector<uint64_t> vertex_gids, EdgeDirection direction, std::vector<std::string> edge_types)
+      : vertex_gids(std::move(vertex_gids)), direction(direction), edge_types(std::move(edge_types)) {}
+
+  std::vector<uint64_t> vertex_gids;
+  EdgeDirection direction{EdgeDirection::OUT};
+  /// Edges of all types are returned if it's empty.
+  std::vector<std::string> edge_types;
+};
+
+struct ExpandRes {
+  static const utils::TypeInfo kType;
+  static const utils::TypeInfo &GetTypeInfo() { return kType; }
+
+  static void Load(ExpandRes *self, memgraph::slk::Reader *reader);
+  static void Save(const ExpandRes &self, memgraph::slk::Builder *builder);
+  ExpandRes() {}
+  ExpandRes(std::vector<std::string> edge_types, std::vector<RemoteEdge> edges)
+      : edge_types(std::move(edge_types)), edges(std::move(edges)) {}
+
+  std::vector<std::string> edge_types;
+  std::vector<RemoteEdge> edges;
+};
+
+using ExpandRpc = rpc::RequestResponse<ExpandReq, ExpandRes>;
+
+/// Scans the vertices of a shard. The filter is evaluated on the shard, and if
+/// only the count is requested, the vertices aren't sent at all.
+struct ScanReq {
+  static const utils::TypeInfo kType;
+  static const utils::TypeInfo &GetTypeInfo() { return kType; }
+
+  static void Load(ScanReq *self, memgraph::slk::Reader *reader);
+  static void Save(const ScanReq &self, memgraph::slk::Builder *builder);
+  ScanReq() {}
+
+  std::optional<std::string> label;
+  /// If it's set, only the vertices whose property equals `value` are scanned.
+  std::optional<std::string> property;
+  PropertyValue value;
+  /// The scan continues after the vertex with this Gid.
+  std::optional<uint64_t> after_gid;
+  /// Maximum number of returned vertices. It's ignored if `count_only` is set.
+  uint64_t limit{0};
+  bool count_only{false};
+};
+
+struct ScanRes {
+  static const utils::TypeInfo kType;
+  static const utils::TypeInfo &GetTypeInfo() { return kType; }
+
+  static void Load(ScanRes *self, memgraph::slk::Reader *reader);
+  static void Save(const ScanRes &self, memgraph::slk::Builder *builder);
+  ScanRes() {}
+
+  std::vector<uint64_t> vertex_gids;
+  uint64_t count{0};
+  /// Set if the scan stopped because of the limit.
+  bool has_more{false};
+};
+
+using ScanRpc = rpc::RequestResponse<ScanReq, ScanRes>;
+
+}  // namespace memgraph::storage::sharding
+
+// SLK serialization declarations
+namespace memgraph::slk {
+
+void Save(const memgraph::storage::sharding::ExpandReq &self, memgraph::slk::Builder *builder);
+
+void Load(memgraph::storage::sharding::ExpandReq *self, memgraph::slk::Reader *reader);
+
+void Save(const memgraph::storage::sharding::ExpandRes &self, memgraph::slk::Builder *builder);
+
+void Load(memgraph::storage::sharding::ExpandRes *self, memgraph::slk::Reader *reader);
+
+void Save(const memgraph::storage::sharding::ScanReq &self, memgraph::slk::Builder *builder);
+
+void Load(memgraph::storage::sharding::ScanReq *self, memgraph::slk::Reader *reader);
+
+void Save(const memgraph::storage::sharding::ScanRes &self, memgraph::slk::Builder *builder);
+
+void Load(memgraph::storage::sharding::ScanRes *self, memgraph::slk::Reader *reader);
+
+}  // namespace memgraph::slk
@@ -0,0 +1,113 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/sharding/shard_client.hpp"
+
+#include <future>
+#include <numeric>
+#include <type_traits>
+
+#include "storage/v2/sharding/rpc.hpp"
+
+namespace memgraph::storage::sharding {
+
+namespace {
+ScanReq MakeScanReq(const ScanFilter &filter) {
+  ScanReq req;
+  req.label = filter.label;
+  req.property = filter.property;
+  req.value = filter.value;
+  return req;
+}
+
+/// Runs `call(shard)` for all of the `shards` at the same time, so a request
+/// waits for the slowest shard instead of for all of them in turn. The
+/// results are in the order of `shards`. The first exception is rethrown
+/// once every call has finished.
+template <typename TCall>
+auto CallShards(const std::vector<size_t> &shards, const TCall &call) {
+  std::vector<std::future<std::invoke_result_t<const TCall &, size_t>>> futures;
+  futures.reserve(shards.size());
+  for (const auto shard : shards) futures.push_back(std::async(std::launch::async, call, shard));
+  std::vector<std::invoke_result_t<const TCall &, size_t>> results;
+  results.reserve(futures.size());
+  for (auto &future : futures) results.push_back(future.get());
+  return results;
+}
+}  // namespace
+
+ShardClient::ShardClient(ShardMap shard_map) : shard_map_(std::move(shard_map)) {
+  clients_.reserve(shard_map_.shards().size());
+  for (const auto &shard : shard_map_.shards()) {
+    clients_.push_back(std::make_unique<rpc::Client>(shard.endpoint, &rpc_client_context_));
+  }
+}
+
+std::vector<ShardEdge> ShardClient::Expand(const std::vector<Gid> &vertices, const EdgeDirection direction,
+                                           const std::vector<std::string> &edge_types) {
+  const auto groups = shard_map_.GroupByShard(vertices);
+  std::vector<size_t> shards;
+  for (size_t shard = 0; shard < groups.size(); ++shard) {
+    if (!groups[shard].empty()) shards.push_back(shard);
+  }
+  auto responses = CallShards(shards, [&](const size_t shard) {
+    std::vector<uint64_t> vertex_gids;
+    vertex_gids.reserve(groups[shard].size());
+    for (const auto gid : groups[shard]) vertex_gids.push_back(gid.AsUint());
+    return clients_[shard]->Call<ExpandRpc>(std::move(vertex_gids), direction, edge_types);
+  });
+
+  std::vector<ShardEdge> edges;
+  for (const auto &res : responses) {
+    for (const auto &edge : res.edges) {
+      edges.push_back({Gid::FromUint(edge.vertex_gid), Gid::FromUint(edge.edge_gid), res.edge_types.at(edge.edge_type),
+                       Gid::FromUint(edge.other_vertex_gid)});
+    }
+  }
+  return edges;
+}
+
+std::vector<Gid> ShardClient::Scan(const ScanFilter &filter, const uint64_t batch_size) {
+  auto shard_vertices = CallShards(AllShards(), [&](const size_t shard) {
+    std::vector<Gid> vertices;
+    auto req = MakeScanReq(filter);
+    req.limit = batch_size;
+    while (true) {
+      auto res = clients_[shard]->Call<ScanRpc>(req);
+      for (const auto gid : res.vertex_gids) vertices.push_back(Gid::FromUint(gid));
+      if (!res.has_more || res.vertex_gids.empty()) break;
+      req.after_gid = res.vertex_gids.back();
+    }
+    return vertices;
+  });
+
+  std::vector<Gid> vertices;
+  for (const auto &shard : shard_vertices) vertices.insert(vertices.end(), shard.begin(), shard.end());
+  return vertices;
+}
+
+uint64_t ShardClient::Count(const ScanFilter &filter) {
+  auto req = MakeScanReq(filter);
+  req.count_only = true;
+  const auto counts =
+      CallShards(AllShards(), [&](const size_t shard) { return clients_[shard]->Call<ScanRpc>(req).count; });
+  uint64_t count = 0;
+  for (const auto shard_count : counts) count += shard_count;
+  return count;
+}
+
+std::vector<size_t> ShardClient::AllShards() const {
+  std::vector<size_t> shards(clients_.size());
+  std::iota(shards.begin(), shards.end(), 0);
+  return shards;
+}
+
+}  // namespace memgraph::storage::sharding
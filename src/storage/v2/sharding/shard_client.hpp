@@ -0,0 +1,76 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "communication/context.hpp"
+#include "rpc/client.hpp"
+#include "storage/v2/edge_direction.hpp"
+#include "storage/v2/id_types.hpp"
+#include "storage/v2/property_value.hpp"
+#include "storage/v2/sharding/shard_map.hpp"
+
+namespace memgraph::storage::sharding {
+
+struct ShardEdge {
+  Gid vertex;
+  Gid edge;
+  std::string edge_type;
+  Gid other_vertex;
+};
+
+/// Filter of a scan which is evaluated by the shards.
+struct ScanFilter {
+  std::optional<std::string> label;
+  /// The name of the property and the value it must be equal to.
+  std::optional<std::string> property;
+  PropertyValue value;
+};
+
+/// Sends the scans and expansions over a sharded graph to the shards which
+/// store the vertices. The shards are called in parallel, each from its own
+/// thread.
+/// @throw rpc::RpcFailedException from all methods if a shard can't be reached.
+class ShardClient final {
+ public:
+  explicit ShardClient(ShardMap shard_map);
+
+  /// Returns the edges of the vertices in `direction`, with one of the
+  /// `edge_types` if they are given. Each shard is sent a single request with
+  /// all of its vertices.
+  std::vector<ShardEdge> Expand(const std::vector<Gid> &vertices, EdgeDirection direction,
+                                const std::vector<std::string> &edge_types = {});
+
+  /// Returns the vertices of all shards which pass the filter, ordered by the
+  /// shard and then by Gid. Each request returns at most `batch_size` vertices.
+  std::vector<Gid> Scan(const ScanFilter &filter, uint64_t batch_size);
+
+  /// Returns the number of vertices which pass the filter. The vertices are
+  /// counted by the shards, so only the counts are sent.
+  uint64_t Count(const ScanFilter &filter);
+
+  const ShardMap &shard_map() const { return shard_map_; }
+
+ private:
+  std::vector<size_t> AllShards() const;
+
+  ShardMap shard_map_;
+  communication::ClientContext rpc_client_context_;
+  std::vector<std::unique_ptr<rpc::Client>> clients_;
+};
+
+}  // namespace memgraph::storage::sharding
@@ -0,0 +1,63 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/sharding/shard_map.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+#include "utils/string.hpp"
+
+namespace memgraph::storage::sharding {
+
+std::optional<ShardMap> ShardMap::Create(std::vector<Shard> shards) {
+  if (shards.empty()) return std::nullopt;
+  std::sort(shards.begin(), shards.end(),
+            [](const auto &lhs, const auto &rhs) { return lhs.first_gid < rhs.first_gid; });
+  if (shards.front().first_gid != Gid::FromUint(0)) return std::nullopt;
+  const auto duplicate = std::adjacent_find(
+      shards.begin(), shards.end(), [](const auto &lhs, const auto &rhs) { return lhs.first_gid == rhs.first_gid; });
+  if (duplicate != shards.end()) return std::nullopt;
+  return ShardMap(std::move(shards));
+}
+
+std::optional<ShardMap> ShardMap::Parse(const std::string_view description) {
+  std::vector<Shard> shards;
+  for (const auto &item : utils::Split(description, ",")) {
+    const auto parts = utils::Split(utils::Trim(item), "=", 1);
+    if (parts.size() != 2) return std::nullopt;
+    uint64_t first_gid = 0;
+    const auto *end = parts[0].data() + parts[0].size();
+    if (auto [ptr, error] = std::from_chars(parts[0].data(), end, first_gid); error != std::errc{} || ptr != end) {
+      return std::nullopt;
+    }
+    const auto address = io::network::Endpoint::ParseSocketOrIpAddress(parts[1], std::nullopt);
+    if (!address) return std::nullopt;
+    shards.push_back({Gid::FromUint(first_gid), io::network::Endpoint(address->first, address->second)});
+  }
+  return Create(std::move(shards));
+}
+
+size_t ShardMap::ShardOf(const Gid gid) const {
+  // The first shard starts at Gid 0, so there is always a shard before the
+  // upper bound.
+  const auto it = std::upper_bound(shards_.begin(), shards_.end(), gid,
+                                   [](const Gid gid, const Shard &shard) { return gid < shard.first_gid; });
+  return std::distance(shards_.begin(), it) - 1;
+}
+
+std::vector<std::vector<Gid>> ShardMap::GroupByShard(const std::vector<Gid> &gids) const {
+  std::vector<std::vector<Gid>> groups(shards_.size());
+  for (const auto gid : gids) groups[ShardOf(gid)].push_back(gid);
+  return groups;
+}
+
+}  // namespace memgraph::storage::sharding
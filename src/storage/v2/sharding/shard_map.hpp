@@ -0,0 +1,60 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "io/network/endpoint.hpp"
+#include "storage/v2/id_types.hpp"
+
+namespace memgraph::storage::sharding {
+
+/// Instance which stores the vertices whose Gids are in
+/// [`first_gid`, `first_gid` of the next shard).
+struct Shard {
+  Gid first_gid;
+  io::network::Endpoint endpoint;
+};
+
+/// Partitioning of the vertices of a graph into Gid ranges, each of them stored
+/// by one instance. Each shard stores the edges of its vertices, so an
+/// expansion from a vertex is answered by the shard which owns the vertex.
+class ShardMap final {
+ public:
+  /// Returns std::nullopt if there are no shards, or the first shard doesn't
+  /// start at Gid 0, or two shards start at the same Gid.
+  static std::optional<ShardMap> Create(std::vector<Shard> shards);
+
+  /// Parses a comma separated list of `first_gid=address:port` shards, e.g.
+  /// "0=10.0.0.1:10000,1000000=10.0.0.2:10000".
+  static std::optional<ShardMap> Parse(std::string_view description);
+
+  /// Returns the index of the shard which owns the vertex.
+  size_t ShardOf(Gid gid) const;
+
+  /// Splits the Gids into one list per shard, so that each shard is sent a
+  /// single batch.
+  std::vector<std::vector<Gid>> GroupByShard(const std::vector<Gid> &gids) const;
+
+  const std::vector<Shard> &shards() const { return shards_; }
+
+ private:
+  explicit ShardMap(std::vector<Shard> shards) : shards_(std::move(shards)) {}
+
+  // Sorted by the first Gid.
+  std::vector<Shard> shards_;
+};
+
+}  // namespace memgraph::storage::sharding
@@ -0,0 +1,131 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/sharding/shard_server.hpp"
+
+#include <unordered_map>
+
+#include "storage/v2/sharding/rpc.hpp"
+#include "storage/v2/storage.hpp"
+#include "utils/logging.hpp"
+
+namespace memgraph::storage::sharding {
+
+ShardServer::ShardServer(io::network::Endpoint endpoint, Storage *storage, const uint64_t threads)
+    : storage_(storage), rpc_server_{std::move(endpoint), &rpc_server_context_, threads} {
+  rpc_server_.Register<ExpandRpc>(
+      [this](auto *req_reader, auto *res_builder) { ExpandHandler(req_reader, res_builder); });
+  rpc_server_.Register<ScanRpc>([this](auto *req_reader, auto *res_builder) { ScanHandler(req_reader, res_builder); });
+}
+
+ShardServer::~ShardServer() {
+  if (rpc_server_.IsRunning()) {
+    const auto &endpoint = rpc_server_.endpoint();
+    spdlog::trace("Closing shard server on {}:{}", endpoint.address, endpoint.port);
+    rpc_server_.Shutdown();
+  }
+  rpc_server_.AwaitShutdown();
+}
+
+bool ShardServer::Start() { return rpc_server_.Start(); }
+
+void ShardServer::ExpandHandler(slk::Reader *req_reader, slk::Builder *res_builder) {
+  ExpandReq req;
+  slk::Load(&req, req_reader);
+
+  auto accessor = storage_->ReadOnlyAccess(std::nullopt);
+  // Edge types which the shard has never seen have no edges on it, so they are
+  // skipped instead of being mapped.
+  std::vector<EdgeTypeId> edge_types;
+  edge_types.reserve(req.edge_types.size());
+  for (const auto &name : req.edge_types) {
+    if (auto edge_type = accessor->FindEdgeType(name)) edge_types.push_back(*edge_type);
+  }
+
+  ExpandRes res;
+  if (!req.edge_types.empty() && edge_types.empty()) {
+    slk::Save(res, res_builder);
+    return;
+  }
+  std::unordered_map<EdgeTypeId, uint32_t> edge_type_indices;
+  for (const auto vertex_gid : req.vertex_gids) {
+    auto vertex = accessor->FindVertex(Gid::FromUint(vertex_gid), View::OLD);
+    if (!vertex) continue;
+    auto edges = req.direction == EdgeDirection::OUT ? vertex->OutEdges(View::OLD, edge_types)
+                                                     : vertex->InEdges(View::OLD, edge_types);
+    if (edges.HasError()) continue;
+    for (const auto &edge : *edges) {
+      auto [it, inserted] = edge_type_indices.try_emplace(edge.EdgeType(), res.edge_types.size());
+      if (inserted) res.edge_types.push_back(accessor->EdgeTypeToName(edge.EdgeType()));
+      const auto other = req.direction == EdgeDirection::OUT ? edge.ToVertex() : edge.FromVertex();
+      res.edges.push_back({vertex_gid, edge.Gid().AsUint(), it->second, other.Gid().AsUint()});
+    }
+  }
+  slk::Save(res, res_builder);
+}
+
+void ShardServer::ScanHandler(slk::Reader *req_reader, slk::Builder *res_builder) {
+  ScanReq req;
+  slk::Load(&req, req_reader);
+
+  auto accessor = storage_->ReadOnlyAccess(std::nullopt);
+  // No vertex can match a label or a property which the shard has never seen.
+  std::optional<LabelId> label;
+  std::optional<PropertyId> property;
+  if (req.label) label = accessor->FindLabel(*req.label);
+  if (req.property) property = accessor->FindProperty(*req.property);
+  if ((req.label && !label) || (req.property && !property)) {
+    slk::Save(ScanRes{}, res_builder);
+    return;
+  }
+
+  auto matches = [&](const VertexAccessor &vertex) {
+    if (label) {
+      auto has_label = vertex.HasLabel(*label, View::OLD);
+      if (has_label.HasError() || !*has_label) return false;
+    }
+    if (property) {
+      auto value = vertex.GetProperty(*property, View::OLD);
+      if (value.HasError() || *value != req.value) return false;
+    }
+    return true;
+  };
+
+  ScanRes res;
+  if (req.count_only) {
+    // The order of the vertices doesn't matter, so the label index is used if
+    // it exists.
+    auto vertices = label && accessor->LabelIndexExists(*label) ? accessor->Vertices(*label, View::OLD)
+                                                                 : accessor->Vertices(View::OLD);
+    for (const auto &vertex : vertices) {
+      if (matches(vertex)) ++res.count;
+    }
+  } else {
+    // The scan of all vertices is ordered by Gid, which the paging relies on.
+    // The next page starts with a seek, storages that can't seek return the
+    // earlier vertices as well.
+    auto vertices = req.after_gid ? accessor->Vertices(Gid::FromUint(*req.after_gid + 1), View::OLD)
+                                  : accessor->Vertices(View::OLD);
+    for (const auto &vertex : vertices) {
+      if (req.after_gid && vertex.Gid().AsUint() <= *req.after_gid) continue;
+      if (!matches(vertex)) continue;
+      if (req.limit != 0 && res.vertex_gids.size() == req.limit) {
+        res.has_more = true;
+        break;
+      }
+      res.vertex_gids.push_back(vertex.Gid().AsUint());
+    }
+    res.count = res.vertex_gids.size();
+  }
+  slk::Save(res, res_builder);
+}
+
+}  // namespace memgraph::storage::sharding
@@ -0,0 +1,53 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstdint>
+
+#include "communication/context.hpp"
+#include "io/network/endpoint.hpp"
+#include "rpc/server.hpp"
+#include "slk/streams.hpp"
+
+namespace memgraph::storage {
+
+class Storage;
+
+namespace sharding {
+
+/// Answers the scans and expansions of the other instances over the vertices
+/// of the shard stored by `storage`. Each request is answered in its own
+/// read-only transaction.
+class ShardServer final {
+ public:
+  ShardServer(io::network::Endpoint endpoint, Storage *storage, uint64_t threads);
+  ShardServer(const ShardServer &) = delete;
+  ShardServer(ShardServer &&) = delete;
+  ShardServer &operator=(const ShardServer &) = delete;
+  ShardServer &operator=(ShardServer &&) = delete;
+  ~ShardServer();
+
+  bool Start();
+
+  const io::network::Endpoint &endpoint() const { return rpc_server_.endpoint(); }
+
+ private:
+  void ExpandHandler(slk::Reader *req_reader, slk::Builder *res_builder);
+  void ScanHandler(slk::Reader *req_reader, slk::Builder *res_builder);
+
+  Storage *storage_;
+  communication::ServerContext rpc_server_context_;
+  rpc::Server rpc_server_;
+};
+
+}  // namespace sharding
+}  // namespace memgraph::storage
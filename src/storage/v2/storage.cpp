@@ -9,6 +9,10 @@
 // by the Apache License, Version 2.0, included in the file
 // licenses/APL.txt.
 
+#include <chrono>
+#include <iterator>
+#include <thread>
+
 #include "spdlog/spdlog.h"
 
 #include "storage/v2/disk/name_id_mapper.hpp"
@@ -53,15 +57,17 @@ Storage::Storage(Config config, StorageMode storage_mode)
       constraints_(config, storage_mode),
       id_(config.name),
       replication_state_(config_.durability.restore_replication_state_on_startup,
-                         config_.durability.storage_directory) {}
+                         config_.durability.storage_directory, config_.durability.replication_sync_quorum) {}
 
-Storage::Accessor::Accessor(Storage *storage, IsolationLevel isolation_level, StorageMode storage_mode)
+Storage::Accessor::Accessor(Storage *storage, IsolationLevel isolation_level, StorageMode storage_mode,
+                            bool read_only)
     : storage_(storage),
       // The lock must be acquired before creating the transaction object to
       // prevent freshly created transactions from dangling in an active state
       // during exclusive operations.
       storage_guard_(storage_->main_lock_),
-      transaction_(storage->CreateTransaction(isolation_level, storage_mode)),
+      transaction_(read_only ? storage->CreateReadOnlyTransaction(isolation_level, storage_mode)
+                             : storage->CreateTransaction(isolation_level, storage_mode)),
       is_transaction_active_(true),
       creation_storage_mode_(storage_mode) {}
 
@@ -78,12 +84,23 @@ Storage::Accessor::Accessor(Accessor &&other) noexcept
 }
 
 IndicesInfo Storage::ListAllIndices() const {
-  std::shared_lock<utils::RWLock> storage_guard_(main_lock_);
-  return {indices_.label_index_->ListIndices(), indices_.label_property_index_->ListIndices()};
+  std::shared_lock<MainLock> storage_guard_(main_lock_);
+  if (!indices_.label_property_composite_index_) {
+    return {indices_.label_index_->ListIndices(), indices_.label_property_index_->ListIndices(), {}, {}, {}, {}, {},
+            {}};
+  }
+  return {indices_.label_index_->ListIndices(),
+          indices_.label_property_index_->ListIndices(),
+          indices_.label_property_composite_index_->ListIndices(),
+          indices_.edge_type_index_->ListIndices(),
+          indices_.edge_type_property_index_->ListIndices(),
+          indices_.text_index_->ListIndices(),
+          indices_.vector_index_->ListIndices(),
+          indices_.aggregate_index_->ListIndices()};
 }
 
 ConstraintsInfo Storage::ListAllConstraints() const {
-  std::shared_lock<utils::RWLock> storage_guard_(main_lock_);
+  std::shared_lock<MainLock> storage_guard_(main_lock_);
   return {constraints_.existence_constraints_->ListConstraints(), constraints_.unique_constraints_->ListConstraints()};
 }
 
@@ -95,6 +112,11 @@ void Storage::SetStorageMode(StorageMode storage_mode) {
       (storage_mode == StorageMode::IN_MEMORY_ANALYTICAL || storage_mode == StorageMode::IN_MEMORY_TRANSACTIONAL));
   if (storage_mode_ != storage_mode) {
     storage_mode_ = storage_mode;
+    // The columns aren't dropped by the changes made in the transactional mode.
+    property_columns_.Clear();
+    // The aggregate indices are maintained from the deltas, which the
+    // analytical transactions don't have.
+    if (storage_mode == StorageMode::IN_MEMORY_TRANSACTIONAL) RebuildAggregateIndices();
     FreeMemory(std::move(main_guard));
   }
 }
@@ -113,6 +135,45 @@ utils::BasicResult<Storage::SetIsolationLevelError> Storage::SetIsolationLevel(I
   return {};
 }
 
+VerticesIterable Storage::Accessor::Vertices(Gid /*lower_bound*/, View view) { return Vertices(view); }
+
+std::vector<VerticesIterable> Storage::Accessor::PartitionVertices(View view, uint64_t /*max_partitions*/) {
+  std::vector<VerticesIterable> partitions;
+  partitions.push_back(Vertices(view));
+  return partitions;
+}
+
+std::vector<VerticesIterable> Storage::Accessor::PartitionVertices(LabelId label, View view,
+                                                                   uint64_t /*max_partitions*/) {
+  std::vector<VerticesIterable> partitions;
+  partitions.push_back(Vertices(label, view));
+  return partitions;
+}
+
+VerticesIterable Storage::Accessor::Vertices(LabelId label, const std::vector<LabelId> & /*filter_labels*/,
+                                             View view) {
+  return Vertices(label, view);
+}
+
+VerticesIterable Storage::Accessor::Vertices(
+    LabelId label, const std::vector<LabelId> &filter_labels,
+    const std::vector<std::pair<PropertyId, PropertyValue>> & /*filter_properties*/, View view) {
+  return Vertices(label, filter_labels, view);
+}
+
+Result<std::pair<std::vector<VertexAccessor>, std::vector<EdgeAccessor>>> Storage::Accessor::DetachDeleteVertices(
+    const std::vector<VertexAccessor *> &vertices) {
+  std::pair<std::vector<VertexAccessor>, std::vector<EdgeAccessor>> deleted;
+  for (auto *vertex : vertices) {
+    auto res = DetachDeleteVertex(vertex);
+    if (res.HasError()) return res.GetError();
+    if (!*res) continue;
+    deleted.first.push_back(std::move((*res)->first));
+    std::move((*res)->second.begin(), (*res)->second.end(), std::back_inserter(deleted.second));
+  }
+  return deleted;
+}
+
 StorageMode Storage::Accessor::GetCreationStorageMode() const { return creation_storage_mode_; }
 
 std::optional<uint64_t> Storage::Accessor::GetTransactionId() const {
@@ -122,9 +183,73 @@ std::optional<uint64_t> Storage::Accessor::GetTransactionId() const {
   return {};
 }
 
+std::optional<uint64_t> Storage::Accessor::GraphVersion() const {
+  if (!is_transaction_active_ || !transaction_.deltas.empty() ||
+      transaction_.isolation_level != IsolationLevel::SNAPSHOT_ISOLATION ||
+      transaction_.storage_mode != StorageMode::IN_MEMORY_TRANSACTIONAL ||
+      storage_->GetReplicationRole() == replication::ReplicationRole::REPLICA) {
+    return std::nullopt;
+  }
+  return transaction_.graph_version;
+}
+
+std::optional<uint64_t> Storage::Accessor::LastGraphChange(const GraphFootprint &footprint) const {
+  if (!storage_->graph_changes_.IsEnabled() || !GraphVersion()) return std::nullopt;
+  return storage_->graph_changes_.LastChange(footprint);
+}
+
+std::shared_ptr<const PropertyColumn> Storage::Accessor::GetPropertyColumn(LabelId label, PropertyId property) {
+  if (!FLAGS_storage_property_columns || transaction_.property_columns == nullptr || !LabelIndexExists(label)) {
+    return nullptr;
+  }
+  return transaction_.property_columns->Get(label, property, [&] {
+    PropertyColumn column;
+    for (auto vertex : Vertices(label, View::OLD)) {
+      ++column.vertex_count;
+      auto value = vertex.GetProperty(property, View::OLD);
+      if (value.HasError()) continue;
+      switch (value->type()) {
+        case PropertyValue::Type::Null:
+          break;
+        case PropertyValue::Type::Int:
+          column.ints.push_back(value->ValueInt());
+          break;
+        case PropertyValue::Type::Double:
+          column.doubles.push_back(value->ValueDouble());
+          break;
+        default:
+          column.others.push_back(std::move(*value));
+          break;
+      }
+    }
+    return column;
+  });
+}
+
+uint64_t Storage::NewGraphVersion() {
+  static std::atomic<uint64_t> last_version{0};
+  return last_version.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void Storage::EnableGraphChangeTracking() {
+  std::lock_guard guard(engine_lock_);
+  if (!graph_changes_.IsEnabled()) graph_changes_.Enable(graph_version_);
+}
+
 void Storage::Accessor::AdvanceCommand() {
   transaction_.manyDeltasCache.Clear();  // TODO: Just invalidate the View::OLD cache, NEW should still be fine
   ++transaction_.command_id;
 }
 
+bool Storage::WaitForCommitTimestamp(uint64_t timestamp, std::chrono::milliseconds timeout) const {
+  // The replica publishes the commit timestamp while holding the engine lock,
+  // so the transactions started after it's observed see the changes.
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (LastCommitTimestamp() < timestamp) {
+    if (std::chrono::steady_clock::now() >= deadline) return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
 }  // namespace memgraph::storage
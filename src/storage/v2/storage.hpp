@@ -22,8 +22,13 @@
 #include "storage/v2/durability/paths.hpp"
 #include "storage/v2/durability/wal.hpp"
 #include "storage/v2/edge_accessor.hpp"
+#include "storage/v2/edges_iterable.hpp"
+#include "storage/v2/graph_changes.hpp"
 #include "storage/v2/indices/indices.hpp"
+#include "storage/v2/locks.hpp"
+#include "storage/v2/long_delta_chains.hpp"
 #include "storage/v2/mvcc.hpp"
+#include "storage/v2/property_columns.hpp"
 #include "storage/v2/replication/config.hpp"
 #include "storage/v2/replication/enums.hpp"
 #include "storage/v2/replication/replication.hpp"
@@ -53,6 +58,12 @@ class EdgeAccessor;
 struct IndicesInfo {
   std::vector<LabelId> label;
   std::vector<std::pair<LabelId, PropertyId>> label_property;
+  std::vector<std::pair<LabelId, std::vector<PropertyId>>> label_property_composite;
+  std::vector<EdgeTypeId> edge_type;
+  std::vector<std::pair<EdgeTypeId, PropertyId>> edge_type_property;
+  std::vector<std::pair<LabelId, PropertyId>> text;
+  std::vector<std::pair<LabelId, PropertyId>> vector;
+  std::vector<std::tuple<LabelId, PropertyId, PropertyId>> aggregate;
 };
 
 struct ConstraintsInfo {
@@ -86,7 +97,9 @@ class Storage {
 
   class Accessor {
    public:
-    Accessor(Storage *storage, IsolationLevel isolation_level, StorageMode storage_mode);
+    /// A read-only accessor starts its transaction with
+    /// `CreateReadOnlyTransaction`.
+    Accessor(Storage *storage, IsolationLevel isolation_level, StorageMode storage_mode, bool read_only = false);
     Accessor(const Accessor &) = delete;
     Accessor &operator=(const Accessor &) = delete;
     Accessor &operator=(Accessor &&other) = delete;
@@ -101,16 +114,60 @@ class Storage {
 
     virtual VerticesIterable Vertices(View view) = 0;
 
+    /// Iterates over the vertices whose gid is at least `lower_bound` in gid
+    /// order. By default all vertices are returned, so the caller still has to
+    /// skip the smaller gids if the storage can't seek.
+    virtual VerticesIterable Vertices(Gid lower_bound, View view);
+
+    /// Splits all vertices into at most `max_partitions` disjoint ranges. The
+    /// ranges may be iterated concurrently from different threads as long as
+    /// the transaction isn't modified in the meantime. By default a single
+    /// range with all vertices is returned.
+    virtual std::vector<VerticesIterable> PartitionVertices(View view, uint64_t max_partitions);
+
+    /// Same as above, but only the vertices with the label are split. By
+    /// default a single range with all of them is returned.
+    virtual std::vector<VerticesIterable> PartitionVertices(LabelId label, View view, uint64_t max_partitions);
+
     virtual VerticesIterable Vertices(LabelId label, View view) = 0;
 
+    /// Returns vertices with the given label, skipping vertices which are
+    /// known not to have some of the `filter_labels`. The returned vertices
+    /// may still lack the filter labels, so they have to be checked by the
+    /// caller. By default no vertices are skipped.
+    virtual VerticesIterable Vertices(LabelId label, const std::vector<LabelId> &filter_labels, View view);
+
+    /// Same as above, but vertices whose visible version doesn't have one of
+    /// the `filter_properties` equal to its value may be skipped as well. The
+    /// comparison is done on the stored properties, before the vertices are
+    /// returned. By default only the filter labels are used.
+    virtual VerticesIterable Vertices(LabelId label, const std::vector<LabelId> &filter_labels,
+                                      const std::vector<std::pair<PropertyId, PropertyValue>> &filter_properties,
+                                      View view);
+
     virtual VerticesIterable Vertices(LabelId label, PropertyId property, View view) = 0;
 
     virtual VerticesIterable Vertices(LabelId label, PropertyId property, const PropertyValue &value, View view) = 0;
 
+    /// Returns vertices whose property is equal to any of the `values`, each
+    /// vertex once. The values don't have to be sorted or distinct, and `Null`
+    /// values are ignored.
+    virtual VerticesIterable Vertices(LabelId label, PropertyId property, const std::vector<PropertyValue> &values,
+                                      View view) = 0;
+
     virtual VerticesIterable Vertices(LabelId label, PropertyId property,
                                       const std::optional<utils::Bound<PropertyValue>> &lower_bound,
                                       const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view) = 0;
 
+    /// Returns vertices from the composite index on the given label and
+    /// properties, whose values of the leading properties are equal to
+    /// `prefix` and whose value of the property following the prefix is inside
+    /// of the bounds.
+    virtual VerticesIterable Vertices(LabelId label, const std::vector<PropertyId> &properties,
+                                      const std::vector<PropertyValue> &prefix,
+                                      const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+                                      const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view) = 0;
+
     virtual uint64_t ApproximateVertexCount() const = 0;
 
     virtual uint64_t ApproximateVertexCount(LabelId label) const = 0;
@@ -123,6 +180,39 @@ class Storage {
                                             const std::optional<utils::Bound<PropertyValue>> &lower,
                                             const std::optional<utils::Bound<PropertyValue>> &upper) const = 0;
 
+    virtual uint64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties) const = 0;
+
+    virtual uint64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties,
+                                            const std::vector<PropertyValue> &prefix,
+                                            const std::optional<utils::Bound<PropertyValue>> &lower,
+                                            const std::optional<utils::Bound<PropertyValue>> &upper) const = 0;
+
+    /// Returns edges with the given edge type from the edge-type index.
+    virtual EdgesIterable Edges(EdgeTypeId edge_type, View view) = 0;
+
+    /// Returns edges with the given edge type from the edge-type+property
+    /// index, whose value of the property is equal to `value`.
+    virtual EdgesIterable Edges(EdgeTypeId edge_type, PropertyId property, const PropertyValue &value,
+                                View view) = 0;
+
+    /// Returns edges with the given edge type from the edge-type+property
+    /// index, whose value of the property is inside of the bounds. Without any
+    /// bounds all edges with the property are returned.
+    virtual EdgesIterable Edges(EdgeTypeId edge_type, PropertyId property,
+                                const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+                                const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view) = 0;
+
+    virtual uint64_t ApproximateEdgeCount(EdgeTypeId edge_type) const = 0;
+
+    virtual uint64_t ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property) const = 0;
+
+    virtual uint64_t ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property,
+                                          const PropertyValue &value) const = 0;
+
+    virtual uint64_t ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property,
+                                          const std::optional<utils::Bound<PropertyValue>> &lower,
+                                          const std::optional<utils::Bound<PropertyValue>> &upper) const = 0;
+
     virtual std::optional<storage::LabelIndexStats> GetIndexStats(const storage::LabelId &label) const = 0;
 
     virtual std::optional<storage::LabelPropertyIndexStats> GetIndexStats(
@@ -147,10 +237,23 @@ class Storage {
     virtual Result<std::optional<std::pair<VertexAccessor, std::vector<EdgeAccessor>>>> DetachDeleteVertex(
         VertexAccessor *vertex) = 0;
 
+    /// Deletes the vertices together with all their edges. The vertices which
+    /// are already deleted, or given more than once, are skipped.
+    /// @return Accessors to the deleted vertices and edges
+    /// @throw std::bad_alloc
+    virtual Result<std::pair<std::vector<VertexAccessor>, std::vector<EdgeAccessor>>> DetachDeleteVertices(
+        const std::vector<VertexAccessor *> &vertices);
+
     virtual void PrefetchInEdges(const VertexAccessor &vertex_acc) = 0;
 
     virtual void PrefetchOutEdges(const VertexAccessor &vertex_acc) = 0;
 
+    /// Prefetches the edges of all the vertices together, which needs fewer
+    /// reads than prefetching them vertex by vertex.
+    virtual void PrefetchInEdges(const std::vector<VertexAccessor> &vertices) = 0;
+
+    virtual void PrefetchOutEdges(const std::vector<VertexAccessor> &vertices) = 0;
+
     virtual Result<EdgeAccessor> CreateEdge(VertexAccessor *from, VertexAccessor *to, EdgeTypeId edge_type) = 0;
 
     virtual Result<std::optional<EdgeAccessor>> DeleteEdge(EdgeAccessor *edge) = 0;
@@ -159,6 +262,40 @@ class Storage {
 
     virtual bool LabelPropertyIndexExists(LabelId label, PropertyId property) const = 0;
 
+    virtual bool LabelPropertyCompositeIndexExists(LabelId label, const std::vector<PropertyId> &properties) const = 0;
+
+    virtual bool EdgeTypeIndexExists(EdgeTypeId edge_type) const = 0;
+
+    virtual bool EdgeTypePropertyIndexExists(EdgeTypeId edge_type, PropertyId property) const = 0;
+
+    virtual bool TextIndexExists(LabelId label, PropertyId property) const = 0;
+
+    /// Returns at most `limit` vertices from the text index on the given label
+    /// and property whose value contains any of the tokens of `query`, ordered
+    /// from the most relevant one.
+    virtual std::vector<TextSearchResult> TextSearch(LabelId label, PropertyId property, std::string_view query,
+                                                     uint64_t limit, View view) = 0;
+
+    virtual bool VectorIndexExists(LabelId label, PropertyId property) const = 0;
+
+    /// Returns at most `k` vertices from the vector index on the given label
+    /// and property whose values are the nearest to `query`, ordered from the
+    /// nearest one. Returns std::nullopt if the dimension of `query` differs
+    /// from the dimension of the indexed vectors.
+    virtual std::optional<std::vector<VectorSearchResult>> VectorSearch(LabelId label, PropertyId property,
+                                                                        std::span<const float> query, uint64_t k,
+                                                                        View view) = 0;
+
+    virtual bool AggregateIndexExists(LabelId label, PropertyId group_property, PropertyId value_property) const = 0;
+
+    /// Returns the groups of the aggregate index on the given label and
+    /// properties as of the start of the transaction. Returns std::nullopt if
+    /// there is no such index or the transaction doesn't read a snapshot of
+    /// the committed transactions, e.g. because it changed the graph, in which
+    /// case the groups have to be computed from the vertices.
+    virtual std::optional<std::vector<AggregateGroup>> AggregateIndexLookup(LabelId label, PropertyId group_property,
+                                                                            PropertyId value_property) = 0;
+
     virtual IndicesInfo ListAllIndices() const = 0;
 
     virtual ConstraintsInfo ListAllConstraints() const = 0;
@@ -171,10 +308,48 @@ class Storage {
 
     virtual void FinalizeTransaction() = 0;
 
+    /// Commits the changes made so far and continues in a new transaction.
+    /// The new transaction takes the place of the committed one, so that the
+    /// vertex and edge accessors created by this accessor stay usable. It is
+    /// started even if the commit fails.
+    virtual utils::BasicResult<StorageDataManipulationError, void> PeriodicCommit() = 0;
+
     std::optional<uint64_t> GetTransactionId() const;
 
+    /// Returns the version of the graph seen by the transaction. Transactions
+    /// with the same version see the same vertices, edges and properties, so
+    /// the version can be used to cache data derived from the graph. A new
+    /// version is given to every committed change, and versions are unique
+    /// across all storages. Nothing is returned if the transaction made changes
+    /// of its own or may see the changes of other transactions while running,
+    /// which is the case for all isolation levels except snapshot isolation
+    /// and all storage modes except the in-memory transactional mode.
+    std::optional<uint64_t> GraphVersion() const;
+
+    /// Returns the graph version of the last commit which changed the part of
+    /// the graph, see `GraphChangeVersions`. Data derived from the part at the
+    /// version of this transaction is still valid if the returned version
+    /// isn't newer. Nothing is returned if the changes aren't tracked or the
+    /// transaction has no version.
+    std::optional<uint64_t> LastGraphChange(const GraphFootprint &footprint) const;
+
+    /// Returns the vertices whose reads applied the most deltas.
+    std::vector<LongDeltaChainInfo> LongDeltaChainsInfo() const { return storage_->long_delta_chains_.GetInfo(); }
+
+    /// Returns the column of `property` of the vertices with `label` if the
+    /// property columns are enabled, the transaction runs in the analytical
+    /// mode and `label` is indexed. Otherwise nullptr is returned.
+    std::shared_ptr<const PropertyColumn> GetPropertyColumn(LabelId label, PropertyId property);
+
     void AdvanceCommand();
 
+    /// Turns off the cache of the vertex states rebuilt from long delta chains
+    /// while the transaction is read by parallel workers, see
+    /// `VertexInfoCache::Suspend`.
+    void SuspendVertexInfoCache() { transaction_.manyDeltasCache.Suspend(); }
+
+    void ResumeVertexInfoCache() { transaction_.manyDeltasCache.Resume(); }
+
     const std::string &LabelToName(LabelId label) const { return storage_->LabelToName(label); }
 
     const std::string &PropertyToName(PropertyId property) const { return storage_->PropertyToName(property); }
@@ -187,13 +362,19 @@ class Storage {
 
     EdgeTypeId NameToEdgeType(std::string_view name) { return storage_->NameToEdgeType(name); }
 
+    std::optional<LabelId> FindLabel(std::string_view name) const { return storage_->FindLabel(name); }
+
+    std::optional<PropertyId> FindProperty(std::string_view name) const { return storage_->FindProperty(name); }
+
+    std::optional<EdgeTypeId> FindEdgeType(std::string_view name) const { return storage_->FindEdgeType(name); }
+
     StorageMode GetCreationStorageMode() const;
 
     const std::string &id() const { return storage_->id(); }
 
    protected:
     Storage *storage_;
-    std::shared_lock<utils::RWLock> storage_guard_;
+    std::shared_lock<MainLock> storage_guard_;
     Transaction transaction_;
     std::optional<uint64_t> commit_timestamp_;
     bool is_transaction_active_;
@@ -220,17 +401,49 @@ class Storage {
     return EdgeTypeId::FromUint(name_id_mapper_->NameToId(name));
   }
 
+  /// The `Find*` functions return `std::nullopt` for a name that was never
+  /// mapped instead of creating a new mapping, so they can be used by readers
+  /// that mustn't change the storage.
+  std::optional<LabelId> FindLabel(const std::string_view name) const {
+    auto id = name_id_mapper_->FindId(name);
+    if (!id) return std::nullopt;
+    return LabelId::FromUint(*id);
+  }
+
+  std::optional<PropertyId> FindProperty(const std::string_view name) const {
+    auto id = name_id_mapper_->FindId(name);
+    if (!id) return std::nullopt;
+    return PropertyId::FromUint(*id);
+  }
+
+  std::optional<EdgeTypeId> FindEdgeType(const std::string_view name) const {
+    auto id = name_id_mapper_->FindId(name);
+    if (!id) return std::nullopt;
+    return EdgeTypeId::FromUint(*id);
+  }
+
   void SetStorageMode(StorageMode storage_mode);
 
   StorageMode GetStorageMode() const;
 
-  virtual void FreeMemory(std::unique_lock<utils::RWLock> main_guard) = 0;
+  virtual void FreeMemory(std::unique_lock<MainLock> main_guard) = 0;
 
   void FreeMemory() { FreeMemory({}); }
 
+  /// Recomputes the aggregate indices from the vertices, which must be called
+  /// while holding the unique main lock.
+  virtual void RebuildAggregateIndices() = 0;
+
   virtual std::unique_ptr<Accessor> Access(std::optional<IsolationLevel> override_isolation_level) = 0;
   std::unique_ptr<Accessor> Access() { return Access(std::optional<IsolationLevel>{}); }
 
+  /// Returns an accessor for a transaction which only reads the graph. The
+  /// storage can start such a transaction cheaper than a regular one, but it
+  /// must not make any changes. By default it's a regular transaction.
+  virtual std::unique_ptr<Accessor> ReadOnlyAccess(std::optional<IsolationLevel> override_isolation_level) {
+    return Access(override_isolation_level);
+  }
+
   virtual utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(
       LabelId label, std::optional<uint64_t> desired_commit_timestamp) = 0;
 
@@ -245,6 +458,14 @@ class Storage {
     return CreateIndex(label, property, std::optional<uint64_t>{});
   }
 
+  virtual utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(
+      LabelId label, const std::vector<PropertyId> &properties, std::optional<uint64_t> desired_commit_timestamp) = 0;
+
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(LabelId label,
+                                                                    const std::vector<PropertyId> &properties) {
+    return CreateIndex(label, properties, std::optional<uint64_t>{});
+  }
+
   virtual utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(
       LabelId label, std::optional<uint64_t> desired_commit_timestamp) = 0;
 
@@ -259,6 +480,72 @@ class Storage {
     return DropIndex(label, property, std::optional<uint64_t>{});
   }
 
+  virtual utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(
+      LabelId label, const std::vector<PropertyId> &properties, std::optional<uint64_t> desired_commit_timestamp) = 0;
+
+  utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(LabelId label,
+                                                                  const std::vector<PropertyId> &properties) {
+    return DropIndex(label, properties, std::optional<uint64_t>{});
+  }
+
+  /// Edge indices aren't persisted in the WAL and snapshots, nor are they
+  /// replicated, so they have to be recreated after a restart.
+  virtual utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(EdgeTypeId edge_type) = 0;
+
+  virtual utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(EdgeTypeId edge_type,
+                                                                            PropertyId property) = 0;
+
+  virtual utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(EdgeTypeId edge_type) = 0;
+
+  virtual utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(EdgeTypeId edge_type,
+                                                                          PropertyId property) = 0;
+
+  virtual utils::BasicResult<StorageIndexDefinitionError, void> CreateTextIndex(
+      LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp) = 0;
+
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateTextIndex(LabelId label, PropertyId property) {
+    return CreateTextIndex(label, property, std::optional<uint64_t>{});
+  }
+
+  virtual utils::BasicResult<StorageIndexDefinitionError, void> DropTextIndex(
+      LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp) = 0;
+
+  utils::BasicResult<StorageIndexDefinitionError, void> DropTextIndex(LabelId label, PropertyId property) {
+    return DropTextIndex(label, property, std::optional<uint64_t>{});
+  }
+
+  virtual utils::BasicResult<StorageIndexDefinitionError, void> CreateVectorIndex(
+      LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp) = 0;
+
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateVectorIndex(LabelId label, PropertyId property) {
+    return CreateVectorIndex(label, property, std::optional<uint64_t>{});
+  }
+
+  virtual utils::BasicResult<StorageIndexDefinitionError, void> DropVectorIndex(
+      LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp) = 0;
+
+  utils::BasicResult<StorageIndexDefinitionError, void> DropVectorIndex(LabelId label, PropertyId property) {
+    return DropVectorIndex(label, property, std::optional<uint64_t>{});
+  }
+
+  virtual utils::BasicResult<StorageIndexDefinitionError, void> CreateAggregateIndex(
+      LabelId label, PropertyId group_property, PropertyId value_property,
+      std::optional<uint64_t> desired_commit_timestamp) = 0;
+
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateAggregateIndex(LabelId label, PropertyId group_property,
+                                                                             PropertyId value_property) {
+    return CreateAggregateIndex(label, group_property, value_property, std::optional<uint64_t>{});
+  }
+
+  virtual utils::BasicResult<StorageIndexDefinitionError, void> DropAggregateIndex(
+      LabelId label, PropertyId group_property, PropertyId value_property,
+      std::optional<uint64_t> desired_commit_timestamp) = 0;
+
+  utils::BasicResult<StorageIndexDefinitionError, void> DropAggregateIndex(LabelId label, PropertyId group_property,
+                                                                           PropertyId value_property) {
+    return DropAggregateIndex(label, group_property, value_property, std::optional<uint64_t>{});
+  }
+
   IndicesInfo ListAllIndices() const;
 
   virtual utils::BasicResult<StorageExistenceConstraintDefinitionError, void> CreateExistenceConstraint(
@@ -286,6 +573,11 @@ class Storage {
 
   virtual Transaction CreateTransaction(IsolationLevel isolation_level, StorageMode storage_mode) = 0;
 
+  /// Starts the transaction of a read-only accessor, see `ReadOnlyAccess`.
+  virtual Transaction CreateReadOnlyTransaction(IsolationLevel isolation_level, StorageMode storage_mode) {
+    return CreateTransaction(isolation_level, storage_mode);
+  }
+
   virtual void EstablishNewEpoch() = 0;
 
   virtual auto CreateReplicationClient(std::string name, io::network::Endpoint endpoint,
@@ -316,9 +608,15 @@ class Storage {
   bool UnregisterReplica(const std::string &name) { return replication_state_.UnregisterReplica(name); }
   replication::ReplicationRole GetReplicationRole() const { return replication_state_.GetRole(); }
   auto ReplicasInfo() { return replication_state_.ReplicasInfo(); }
+  auto ReplicasLag() { return replication_state_.ReplicasLag(); }
   std::optional<replication::ReplicaState> GetReplicaState(std::string_view name) {
     return replication_state_.GetReplicaState(name);
   }
+  // On a REPLICA it's the last commit received from the MAIN
+  uint64_t LastCommitTimestamp() const { return replication_state_.last_commit_timestamp_.load(); }
+  // Wait until the transaction committed at `timestamp` is visible to new transactions.
+  // Return false if that didn't happen before the `timeout`.
+  bool WaitForCommitTimestamp(uint64_t timestamp, std::chrono::milliseconds timeout) const;
 
  protected:
   void RestoreReplicas() { return replication_state_.RestoreReplicas(this); }
@@ -330,7 +628,7 @@ class Storage {
   // creation of new accessors by taking a unique lock. This is used when doing
   // operations on storage that affect the global state, for example index
   // creation.
-  mutable utils::RWLock main_lock_{utils::RWLock::Priority::WRITE};
+  mutable MainLock main_lock_;
 
   // Even though the edge count is already kept in the `edges_` SkipList, the
   // list is used only when properties are enabled for edges. Because of that we
@@ -342,9 +640,23 @@ class Storage {
   Config config_;
 
   // Transaction engine
-  utils::SpinLock engine_lock_;
+  EngineLock engine_lock_;
   uint64_t timestamp_{kTimestampInitialId};
-  uint64_t transaction_id_{kTransactionInitialId};
+  // Also taken without the engine lock by the read-only transactions.
+  std::atomic<uint64_t> transaction_id_{kTransactionInitialId};
+  // Changed while holding the engine lock whenever changes become visible to
+  // new transactions.
+  uint64_t graph_version_{NewGraphVersion()};
+
+  /// Returns a graph version which wasn't returned before.
+  static uint64_t NewGraphVersion();
+
+  /// Starts tracking the parts of the graph changed by the commits, which is
+  /// needed by `Accessor::LastGraphChange`.
+  void EnableGraphChangeTracking();
+
+  // Only tracked by the in-memory storage.
+  GraphChangeVersions graph_changes_;
 
   IsolationLevel isolation_level_;
   StorageMode storage_mode_;
@@ -352,6 +664,11 @@ class Storage {
   Indices indices_;
   Constraints constraints_;
 
+  // Only used by the in-memory storage.
+  LongDeltaChains long_delta_chains_;
+  // Only used by the in-memory storage in the analytical mode.
+  PropertyColumns property_columns_;
+
   std::atomic<uint64_t> vertex_id_{0};
   std::atomic<uint64_t> edge_id_{0};
   const std::string id_;  //!< High-level assigned ID
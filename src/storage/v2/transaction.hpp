@@ -13,15 +13,18 @@
 
 #include <atomic>
 #include <limits>
-#include <list>
 #include <memory>
+#include <optional>
+#include <vector>
 
+#include "utils/chunked_list.hpp"
 #include "utils/skip_list.hpp"
 
 #include "storage/v2/delta.hpp"
 #include "storage/v2/edge.hpp"
 #include "storage/v2/isolation_level.hpp"
 #include "storage/v2/property_value.hpp"
+#include "storage/v2/read_only_transactions.hpp"
 #include "storage/v2/storage_mode.hpp"
 #include "storage/v2/vertex.hpp"
 #include "storage/v2/vertex_info_cache.hpp"
@@ -29,9 +32,20 @@
 
 namespace memgraph::storage {
 
+class LongDeltaChains;
+class PropertyColumns;
+
 const uint64_t kTimestampInitialId = 0;
 const uint64_t kTransactionInitialId = 1ULL << 63U;
 
+/// Addition to a vertex property, which is applied when the transaction
+/// commits, see `VertexAccessor::AddToProperty`.
+struct CommutativeUpdate {
+  Vertex *vertex;
+  PropertyId property;
+  PropertyValue value;
+};
+
 struct Transaction {
   Transaction(uint64_t transaction_id, uint64_t start_timestamp, IsolationLevel isolation_level,
               StorageMode storage_mode)
@@ -51,6 +65,12 @@ struct Transaction {
         must_abort(other.must_abort),
         isolation_level(other.isolation_level),
         storage_mode(other.storage_mode),
+        graph_version(other.graph_version),
+        long_delta_chains(other.long_delta_chains),
+        property_columns(other.property_columns),
+        edges(other.edges),
+        commutative_updates(std::move(other.commutative_updates)),
+        read_only_snapshot(other.read_only_snapshot),
         manyDeltasCache{std::move(other.manyDeltasCache)} {}
 
   Transaction(const Transaction &) = delete;
@@ -73,10 +93,29 @@ struct Transaction {
   // `commited_transactions_` list for GC.
   std::unique_ptr<std::atomic<uint64_t>> commit_timestamp;
   uint64_t command_id;
-  std::list<Delta> deltas;
+  utils::ChunkedList<Delta> deltas;
   bool must_abort;
   IsolationLevel isolation_level;
   StorageMode storage_mode;
+  // Version of the graph when the transaction was started, see
+  // `Storage::Accessor::GraphVersion`.
+  uint64_t graph_version{0};
+  // Statistics and the shared versions of the vertices with long delta chains
+  // of the storage, if it keeps them.
+  LongDeltaChains *long_delta_chains{nullptr};
+  // The property columns of the storage, which have to be invalidated by the
+  // changes of the vertices. Only set in the in-memory analytical mode.
+  PropertyColumns *property_columns{nullptr};
+  // The edge objects of the storage, which the light edges get once a
+  // property is set on them. Only set with light edges, see
+  // `Config::Items::light_edges`.
+  utils::SkipList<Edge> *edges{nullptr};
+  // Applied in the order they were made when the transaction commits.
+  std::vector<CommutativeUpdate> commutative_updates;
+  // Set if the transaction was started as a read-only one, see
+  // `InMemoryStorage::ReadOnlyAccess`. Such a transaction isn't in the commit
+  // log and must not make any changes.
+  std::optional<ReadOnlySnapshot> read_only_snapshot;
 
   // A cache which is consistent to the current transaction_id + command_id.
   // Used to speedup getting info about a vertex when there is a long delta
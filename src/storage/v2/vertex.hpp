@@ -12,14 +12,14 @@
 #pragma once
 
 #include <limits>
-#include <tuple>
 #include <vector>
 
+#include "storage/v2/adjacency_list.hpp"
 #include "storage/v2/delta.hpp"
 #include "storage/v2/edge_ref.hpp"
 #include "storage/v2/id_types.hpp"
 #include "storage/v2/property_store.hpp"
-#include "utils/spin_lock.hpp"
+#include "storage/v2/locks.hpp"
 
 namespace memgraph::storage {
 
@@ -35,17 +35,26 @@ struct Vertex {
   std::vector<LabelId> labels;
   PropertyStore properties;
 
-  std::vector<std::tuple<EdgeTypeId, Vertex *, EdgeRef>> in_edges;
-  std::vector<std::tuple<EdgeTypeId, Vertex *, EdgeRef>> out_edges;
+  AdjacencyList in_edges;
+  AdjacencyList out_edges;
 
-  mutable utils::SpinLock lock;
+  mutable ObjectLock lock;
   bool deleted;
-  // uint8_t PAD;
+  // The reads of the properties since the last tiering pass, halved by every
+  // pass. Only changed while holding the lock.
+  mutable uint8_t property_reads{0};
   // uint16_t PAD;
 
   Delta *delta;
 };
 
+/// Counts a read of the properties of the object, which must be locked. The
+/// large property values of the objects which are read often are kept in
+/// memory when the storage is tiered.
+inline void RecordPropertyRead(const Vertex &object) {
+  if (object.property_reads < std::numeric_limits<uint8_t>::max()) ++object.property_reads;
+}
+
 static_assert(alignof(Vertex) >= 8, "The Vertex should be aligned to at least 8!");
 
 inline bool operator==(const Vertex &first, const Vertex &second) { return first.gid == second.gid; }
@@ -53,4 +62,12 @@ inline bool operator<(const Vertex &first, const Vertex &second) { return first.
 inline bool operator==(const Vertex &first, const Gid &second) { return first.gid == second; }
 inline bool operator<(const Vertex &first, const Gid &second) { return first.gid < second; }
 
+/// Prefetches the parts of `vertex` which an accessor reads first, the gid at
+/// the beginning and the lock and the delta at the end, which are in
+/// different cache lines. The vertex isn't dereferenced.
+inline void PrefetchVertex(const Vertex *vertex) {
+  __builtin_prefetch(vertex);
+  __builtin_prefetch(&vertex->delta);
+}
+
 }  // namespace memgraph::storage
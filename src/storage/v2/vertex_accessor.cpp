@@ -18,7 +18,9 @@
 #include "storage/v2/edge_accessor.hpp"
 #include "storage/v2/id_types.hpp"
 #include "storage/v2/indices/indices.hpp"
+#include "storage/v2/long_delta_chains.hpp"
 #include "storage/v2/mvcc.hpp"
+#include "storage/v2/property_columns.hpp"
 #include "storage/v2/property_value.hpp"
 #include "storage/v2/result.hpp"
 #include "storage/v2/vertex_info_cache.hpp"
@@ -29,13 +31,21 @@
 
 namespace memgraph::storage {
 
+namespace {
+// The neighbors of the returned edges are usually read right after the edges,
+// so their cache misses are overlapped by prefetching them while the
+// accessors are built. Beyond this many the first ones would be evicted from
+// the cache before they are read.
+constexpr size_t kMaxPrefetchedNeighbors = 512;
+}  // namespace
+
 namespace detail {
 std::pair<bool, bool> IsVisible(Vertex const *vertex, Transaction const *transaction, View view) {
   bool exists = true;
   bool deleted = false;
   Delta *delta = nullptr;
   {
-    std::lock_guard<utils::SpinLock> guard(vertex->lock);
+    std::lock_guard guard(vertex->lock);
     deleted = vertex->deleted;
     delta = vertex->delta;
   }
@@ -52,6 +62,9 @@ std::pair<bool, bool> IsVisible(Vertex const *vertex, Transaction const *transac
       auto existsRes = cache.GetExists(view, vertex);
       auto deletedRes = cache.GetDeleted(view, vertex);
       if (existsRes && deletedRes) return {*existsRes, *deletedRes};
+      if (auto version = FindMaterializedVersion(vertex, delta, transaction); version) {
+        return {version->exists, version->deleted};
+      }
     }
 
     auto const n_processed = ApplyDeltasForRead(transaction, delta, view, [&](const Delta &delta) {
@@ -68,6 +81,7 @@ std::pair<bool, bool> IsVisible(Vertex const *vertex, Transaction const *transac
       cache.StoreExists(view, vertex, exists);
       cache.StoreDeleted(view, vertex, deleted);
     }
+    RecordDeltaChain(vertex, transaction, n_processed);
   }
 
   return {exists, deleted};
@@ -90,7 +104,7 @@ bool VertexAccessor::IsVisible(View view) const {
 
 Result<bool> VertexAccessor::AddLabel(LabelId label) {
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
-  std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+  std::lock_guard guard(vertex_->lock);
 
   if (!PrepareForWrite(transaction_, vertex_)) return Error::SERIALIZATION_ERROR;
   if (vertex_->deleted) return Error::DELETED_OBJECT;
@@ -103,13 +117,14 @@ Result<bool> VertexAccessor::AddLabel(LabelId label) {
   constraints_->unique_constraints_->UpdateOnAddLabel(label, *vertex_, transaction_->start_timestamp);
   indices_->UpdateOnAddLabel(label, vertex_, *transaction_);
   transaction_->manyDeltasCache.Invalidate(vertex_, label);
+  if (transaction_->property_columns) transaction_->property_columns->Invalidate();
 
   return true;
 }
 
 /// TODO: move to after update and change naming to vertex after update
 Result<bool> VertexAccessor::RemoveLabel(LabelId label) {
-  std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+  std::lock_guard guard(vertex_->lock);
 
   if (!PrepareForWrite(transaction_, vertex_)) return Error::SERIALIZATION_ERROR;
   if (vertex_->deleted) return Error::DELETED_OBJECT;
@@ -125,6 +140,7 @@ Result<bool> VertexAccessor::RemoveLabel(LabelId label) {
   constraints_->unique_constraints_->UpdateOnRemoveLabel(label, *vertex_, transaction_->start_timestamp);
   indices_->UpdateOnRemoveLabel(label, vertex_, *transaction_);
   transaction_->manyDeltasCache.Invalidate(vertex_, label);
+  if (transaction_->property_columns) transaction_->property_columns->Invalidate();
 
   return true;
 }
@@ -135,7 +151,7 @@ Result<bool> VertexAccessor::HasLabel(LabelId label, View view) const {
   bool has_label = false;
   Delta *delta = nullptr;
   {
-    std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+    std::lock_guard guard(vertex_->lock);
     deleted = vertex_->deleted;
     has_label = std::find(vertex_->labels.begin(), vertex_->labels.end(), label) != vertex_->labels.end();
     delta = vertex_->delta;
@@ -151,6 +167,11 @@ Result<bool> VertexAccessor::HasLabel(LabelId label, View view) const {
       auto const &cache = transaction_->manyDeltasCache;
       if (auto resError = HasError(view, cache, vertex_, for_deleted_); resError) return *resError;
       if (auto resLabel = cache.GetHasLabel(view, vertex_, label); resLabel) return {resLabel.value()};
+      if (auto version = FindMaterializedVersion(vertex_, delta, transaction_); version) {
+        if (!version->exists) return Error::NONEXISTENT_OBJECT;
+        if (!for_deleted_ && version->deleted) return Error::DELETED_OBJECT;
+        return std::find(version->labels.begin(), version->labels.end(), label) != version->labels.end();
+      }
     }
 
     auto const n_processed = ApplyDeltasForRead(transaction_, delta, view, [&, label](const Delta &delta) {
@@ -169,6 +190,7 @@ Result<bool> VertexAccessor::HasLabel(LabelId label, View view) const {
       cache.StoreDeleted(view, vertex_, deleted);
       cache.StoreHasLabel(view, vertex_, label, has_label);
     }
+    RecordDeltaChain(vertex_, transaction_, n_processed);
   }
 
   if (!exists) return Error::NONEXISTENT_OBJECT;
@@ -182,7 +204,7 @@ Result<std::vector<LabelId>> VertexAccessor::Labels(View view) const {
   std::vector<LabelId> labels;
   Delta *delta = nullptr;
   {
-    std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+    std::lock_guard guard(vertex_->lock);
     deleted = vertex_->deleted;
     labels = vertex_->labels;
     delta = vertex_->delta;
@@ -198,6 +220,11 @@ Result<std::vector<LabelId>> VertexAccessor::Labels(View view) const {
       auto const &cache = transaction_->manyDeltasCache;
       if (auto resError = HasError(view, cache, vertex_, for_deleted_); resError) return *resError;
       if (auto resLabels = cache.GetLabels(view, vertex_); resLabels) return {*resLabels};
+      if (auto version = FindMaterializedVersion(vertex_, delta, transaction_); version) {
+        if (!version->exists) return Error::NONEXISTENT_OBJECT;
+        if (!for_deleted_ && version->deleted) return Error::DELETED_OBJECT;
+        return version->labels;
+      }
     }
 
     auto const n_processed = ApplyDeltasForRead(transaction_, delta, view, [&](const Delta &delta) {
@@ -216,6 +243,7 @@ Result<std::vector<LabelId>> VertexAccessor::Labels(View view) const {
       cache.StoreDeleted(view, vertex_, deleted);
       cache.StoreLabels(view, vertex_, labels);
     }
+    RecordDeltaChain(vertex_, transaction_, n_processed);
   }
 
   if (!exists) return Error::NONEXISTENT_OBJECT;
@@ -225,9 +253,9 @@ Result<std::vector<LabelId>> VertexAccessor::Labels(View view) const {
 
 Result<PropertyValue> VertexAccessor::SetProperty(PropertyId property, const PropertyValue &value) {
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
-  std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+  auto guard = LockWithLoadedProperties(*vertex_);
 
-  if (!PrepareForWrite(transaction_, vertex_)) return Error::SERIALIZATION_ERROR;
+  if (!PrepareForWrite(transaction_, vertex_, property)) return Error::SERIALIZATION_ERROR;
 
   if (vertex_->deleted) return Error::DELETED_OBJECT;
 
@@ -244,13 +272,32 @@ Result<PropertyValue> VertexAccessor::SetProperty(PropertyId property, const Pro
 
   indices_->UpdateOnSetProperty(property, value, vertex_, *transaction_);
   transaction_->manyDeltasCache.Invalidate(vertex_, property);
+  if (transaction_->property_columns) transaction_->property_columns->Invalidate();
 
   return std::move(current_value);
 }
 
+Result<bool> VertexAccessor::AddToProperty(PropertyId property, const PropertyValue &value) {
+  utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+  // The disk storage doesn't keep the versions of its vertices in memory, so
+  // it can't merge the additions when committing.
+  if (transaction_->storage_mode == StorageMode::ON_DISK_TRANSACTIONAL) return false;
+  if (!value.IsInt() && !value.IsDouble() && !value.IsList()) return false;
+
+  auto guard = LockWithLoadedProperties(*vertex_);
+  if (vertex_->deleted) return Error::DELETED_OBJECT;
+  const auto current_value = vertex_->properties.GetProperty(property);
+  if (!current_value.IsNull() && !current_value.IsInt() && !current_value.IsDouble() && !current_value.IsList()) {
+    return false;
+  }
+
+  transaction_->commutative_updates.push_back(CommutativeUpdate{vertex_, property, value});
+  return true;
+}
+
 Result<bool> VertexAccessor::InitProperties(const std::map<storage::PropertyId, storage::PropertyValue> &properties) {
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
-  std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+  std::lock_guard guard(vertex_->lock);
 
   if (!PrepareForWrite(transaction_, vertex_)) return Error::SERIALIZATION_ERROR;
 
@@ -262,6 +309,7 @@ Result<bool> VertexAccessor::InitProperties(const std::map<storage::PropertyId,
     indices_->UpdateOnSetProperty(property, value, vertex_, *transaction_);
     transaction_->manyDeltasCache.Invalidate(vertex_, property);
   }
+  if (transaction_->property_columns) transaction_->property_columns->Invalidate();
 
   return true;
 }
@@ -269,7 +317,7 @@ Result<bool> VertexAccessor::InitProperties(const std::map<storage::PropertyId,
 Result<std::vector<std::tuple<PropertyId, PropertyValue, PropertyValue>>> VertexAccessor::UpdateProperties(
     std::map<storage::PropertyId, storage::PropertyValue> &properties) const {
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
-  std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+  auto guard = LockWithLoadedProperties(*vertex_);
 
   if (!PrepareForWrite(transaction_, vertex_)) return Error::SERIALIZATION_ERROR;
 
@@ -282,12 +330,13 @@ Result<std::vector<std::tuple<PropertyId, PropertyValue, PropertyValue>>> Vertex
     CreateAndLinkDelta(transaction_, vertex_, Delta::SetPropertyTag(), id, std::move(old_value));
     transaction_->manyDeltasCache.Invalidate(vertex_, id);
   }
+  if (transaction_->property_columns) transaction_->property_columns->Invalidate();
 
   return id_old_new_change;
 }
 
 Result<std::map<PropertyId, PropertyValue>> VertexAccessor::ClearProperties() {
-  std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+  auto guard = LockWithLoadedProperties(*vertex_);
 
   if (!PrepareForWrite(transaction_, vertex_)) return Error::SERIALIZATION_ERROR;
 
@@ -301,6 +350,7 @@ Result<std::map<PropertyId, PropertyValue>> VertexAccessor::ClearProperties() {
   }
 
   vertex_->properties.ClearProperties();
+  if (transaction_->property_columns) transaction_->property_columns->Invalidate();
 
   return std::move(properties);
 }
@@ -311,9 +361,10 @@ Result<PropertyValue> VertexAccessor::GetProperty(PropertyId property, View view
   PropertyValue value;
   Delta *delta = nullptr;
   {
-    std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+    auto guard = LockWithLoadedProperties(*vertex_);
     deleted = vertex_->deleted;
     value = vertex_->properties.GetProperty(property);
+    RecordPropertyRead(*vertex_);
     delta = vertex_->delta;
   }
 
@@ -327,6 +378,12 @@ Result<PropertyValue> VertexAccessor::GetProperty(PropertyId property, View view
       auto const &cache = transaction_->manyDeltasCache;
       if (auto resError = HasError(view, cache, vertex_, for_deleted_); resError) return *resError;
       if (auto resProperty = cache.GetProperty(view, vertex_, property); resProperty) return {*resProperty};
+      if (auto version = FindMaterializedVersion(vertex_, delta, transaction_); version) {
+        if (!version->exists) return Error::NONEXISTENT_OBJECT;
+        if (!for_deleted_ && version->deleted) return Error::DELETED_OBJECT;
+        auto it = version->properties.find(property);
+        return it != version->properties.end() ? it->second : PropertyValue();
+      }
     }
 
     auto const n_processed =
@@ -346,6 +403,7 @@ Result<PropertyValue> VertexAccessor::GetProperty(PropertyId property, View view
       cache.StoreDeleted(view, vertex_, deleted);
       cache.StoreProperty(view, vertex_, property, value);
     }
+    RecordDeltaChain(vertex_, transaction_, n_processed);
   }
 
   if (!exists) return Error::NONEXISTENT_OBJECT;
@@ -353,15 +411,47 @@ Result<PropertyValue> VertexAccessor::GetProperty(PropertyId property, View view
   return std::move(value);
 }
 
+Result<std::vector<PropertyValue>> VertexAccessor::GetProperties(const std::vector<PropertyId> &properties,
+                                                                 View view) const {
+  bool exists = true;
+  bool deleted = false;
+  std::vector<PropertyValue> values;
+  Delta *delta = nullptr;
+  {
+    auto guard = LockWithLoadedProperties(*vertex_);
+    deleted = vertex_->deleted;
+    values = vertex_->properties.GetProperties(properties);
+    RecordPropertyRead(*vertex_);
+    delta = vertex_->delta;
+  }
+
+  if (delta && transaction_->isolation_level != IsolationLevel::READ_UNCOMMITTED) {
+    ApplyDeltasForRead(transaction_, delta, view, [&exists, &deleted, &values, &properties](const Delta &delta) {
+      // clang-format off
+      DeltaDispatch(delta, utils::ChainedOverloaded{
+        Deleted_ActionMethod(deleted),
+        Exists_ActionMethod(exists),
+        PropertyValues_ActionMethod(values, properties)
+      });
+      // clang-format on
+    });
+  }
+
+  if (!exists) return Error::NONEXISTENT_OBJECT;
+  if (!for_deleted_ && deleted) return Error::DELETED_OBJECT;
+  return std::move(values);
+}
+
 Result<std::map<PropertyId, PropertyValue>> VertexAccessor::Properties(View view) const {
   bool exists = true;
   bool deleted = false;
   std::map<PropertyId, PropertyValue> properties;
   Delta *delta = nullptr;
   {
-    std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+    auto guard = LockWithLoadedProperties(*vertex_);
     deleted = vertex_->deleted;
     properties = vertex_->properties.Properties();
+    RecordPropertyRead(*vertex_);
     delta = vertex_->delta;
   }
 
@@ -375,6 +465,11 @@ Result<std::map<PropertyId, PropertyValue>> VertexAccessor::Properties(View view
       auto const &cache = transaction_->manyDeltasCache;
       if (auto resError = HasError(view, cache, vertex_, for_deleted_); resError) return *resError;
       if (auto resProperties = cache.GetProperties(view, vertex_); resProperties) return {*resProperties};
+      if (auto version = FindMaterializedVersion(vertex_, delta, transaction_); version) {
+        if (!version->exists) return Error::NONEXISTENT_OBJECT;
+        if (!for_deleted_ && version->deleted) return Error::DELETED_OBJECT;
+        return version->properties;
+      }
     }
 
     auto const n_processed =
@@ -394,6 +489,7 @@ Result<std::map<PropertyId, PropertyValue>> VertexAccessor::Properties(View view
       cache.StoreDeleted(view, vertex_, deleted);
       cache.StoreProperties(view, vertex_, properties);
     }
+    RecordDeltaChain(vertex_, transaction_, n_processed);
   }
 
   if (!exists) return Error::NONEXISTENT_OBJECT;
@@ -412,6 +508,7 @@ Result<std::vector<EdgeAccessor>> VertexAccessor::InEdges(View view, const std::
     auto ret = std::vector<EdgeAccessor>{};
     ret.reserve(edges.size());
     for (auto const &[edge_type, from_vertex, edge] : edges) {
+      if (ret.size() < kMaxPrefetchedNeighbors) PrefetchVertex(from_vertex);
       ret.emplace_back(edge, edge_type, from_vertex, vertex_, transaction_, indices_, constraints_, config_);
     }
     return ret;
@@ -424,17 +521,22 @@ Result<std::vector<EdgeAccessor>> VertexAccessor::InEdges(View view, const std::
   auto in_edges = edge_store{};
   Delta *delta = nullptr;
   {
-    std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+    std::lock_guard guard(vertex_->lock);
     deleted = vertex_->deleted;
-    // TODO: a better filter copy
     if (edge_types.empty() && !destination) {
-      in_edges = vertex_->in_edges;
+      in_edges.assign(vertex_->in_edges.begin(), vertex_->in_edges.end());
+    } else if (destination) {
+      // Supernodes keep a neighbor index, so this doesn't have to scan all of the edges.
+      vertex_->in_edges.AppendEdgesTo(destination_vertex, edge_types, &in_edges);
     } else {
-      for (const auto &[edge_type, from_vertex, edge] : vertex_->in_edges) {
-        if (destination && from_vertex != destination_vertex) continue;
-        if (!edge_types.empty() && std::find(edge_types.begin(), edge_types.end(), edge_type) == edge_types.end())
-          continue;
-        in_edges.emplace_back(edge_type, from_vertex, edge);
+      // Edges are grouped by type, so only the groups of the requested types are visited.
+      for (auto type_it = edge_types.begin(); type_it != edge_types.end(); ++type_it) {
+        const auto requested_type = *type_it;
+        if (std::find(edge_types.begin(), type_it, requested_type) != type_it) continue;
+        auto [begin, end] = vertex_->in_edges.EdgeTypeRange(requested_type);
+        for (auto it = begin; it != end; ++it) {
+          in_edges.emplace_back(requested_type, it.vertex(), it.edge());
+        }
       }
     }
     delta = vertex_->delta;
@@ -471,6 +573,7 @@ Result<std::vector<EdgeAccessor>> VertexAccessor::InEdges(View view, const std::
       cache.StoreDeleted(view, vertex_, deleted);
       cache.StoreInEdges(view, vertex_, destination_vertex, edge_types, in_edges);
     }
+    RecordDeltaChain(vertex_, transaction_, n_processed);
   }
 
   if (!exists) return Error::NONEXISTENT_OBJECT;
@@ -488,6 +591,7 @@ Result<std::vector<EdgeAccessor>> VertexAccessor::OutEdges(View view, const std:
     auto ret = std::vector<EdgeAccessor>{};
     ret.reserve(out_edges.size());
     for (const auto &[edge_type, to_vertex, edge] : out_edges) {
+      if (ret.size() < kMaxPrefetchedNeighbors) PrefetchVertex(to_vertex);
       ret.emplace_back(edge, edge_type, vertex_, to_vertex, transaction_, indices_, constraints_, config_);
     }
     return ret;
@@ -500,16 +604,22 @@ Result<std::vector<EdgeAccessor>> VertexAccessor::OutEdges(View view, const std:
   auto out_edges = edge_store{};
   Delta *delta = nullptr;
   {
-    std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+    std::lock_guard guard(vertex_->lock);
     deleted = vertex_->deleted;
     if (edge_types.empty() && !destination) {
-      out_edges = vertex_->out_edges;
+      out_edges.assign(vertex_->out_edges.begin(), vertex_->out_edges.end());
+    } else if (destination) {
+      // Supernodes keep a neighbor index, so this doesn't have to scan all of the edges.
+      vertex_->out_edges.AppendEdgesTo(dst_vertex, edge_types, &out_edges);
     } else {
-      for (const auto &[edge_type, to_vertex, edge] : vertex_->out_edges) {
-        if (destination && to_vertex != dst_vertex) continue;
-        if (!edge_types.empty() && std::find(edge_types.begin(), edge_types.end(), edge_type) == edge_types.end())
-          continue;
-        out_edges.emplace_back(edge_type, to_vertex, edge);
+      // Edges are grouped by type, so only the groups of the requested types are visited.
+      for (auto type_it = edge_types.begin(); type_it != edge_types.end(); ++type_it) {
+        const auto requested_type = *type_it;
+        if (std::find(edge_types.begin(), type_it, requested_type) != type_it) continue;
+        auto [begin, end] = vertex_->out_edges.EdgeTypeRange(requested_type);
+        for (auto it = begin; it != end; ++it) {
+          out_edges.emplace_back(requested_type, it.vertex(), it.edge());
+        }
       }
     }
     delta = vertex_->delta;
@@ -545,6 +655,7 @@ Result<std::vector<EdgeAccessor>> VertexAccessor::OutEdges(View view, const std:
       cache.StoreDeleted(view, vertex_, deleted);
       cache.StoreOutEdges(view, vertex_, dst_vertex, edge_types, out_edges);
     }
+    RecordDeltaChain(vertex_, transaction_, n_processed);
   }
 
   if (!exists) return Error::NONEXISTENT_OBJECT;
@@ -558,7 +669,7 @@ Result<size_t> VertexAccessor::InDegree(View view) const {
   size_t degree = 0;
   Delta *delta = nullptr;
   {
-    std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+    std::lock_guard guard(vertex_->lock);
     deleted = vertex_->deleted;
     degree = vertex_->in_edges.size();
     delta = vertex_->delta;
@@ -574,6 +685,11 @@ Result<size_t> VertexAccessor::InDegree(View view) const {
       auto const &cache = transaction_->manyDeltasCache;
       if (auto resError = HasError(view, cache, vertex_, for_deleted_); resError) return *resError;
       if (auto resInDegree = cache.GetInDegree(view, vertex_); resInDegree) return {*resInDegree};
+      if (auto version = FindMaterializedVersion(vertex_, delta, transaction_); version) {
+        if (!version->exists) return Error::NONEXISTENT_OBJECT;
+        if (!for_deleted_ && version->deleted) return Error::DELETED_OBJECT;
+        return version->in_degree;
+      }
     }
 
     auto const n_processed =
@@ -593,6 +709,7 @@ Result<size_t> VertexAccessor::InDegree(View view) const {
       cache.StoreDeleted(view, vertex_, deleted);
       cache.StoreInDegree(view, vertex_, degree);
     }
+    RecordDeltaChain(vertex_, transaction_, n_processed);
   }
 
   if (!exists) return Error::NONEXISTENT_OBJECT;
@@ -606,7 +723,7 @@ Result<size_t> VertexAccessor::OutDegree(View view) const {
   size_t degree = 0;
   Delta *delta = nullptr;
   {
-    std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+    std::lock_guard guard(vertex_->lock);
     deleted = vertex_->deleted;
     degree = vertex_->out_edges.size();
     delta = vertex_->delta;
@@ -622,6 +739,11 @@ Result<size_t> VertexAccessor::OutDegree(View view) const {
       auto const &cache = transaction_->manyDeltasCache;
       if (auto resError = HasError(view, cache, vertex_, for_deleted_); resError) return *resError;
       if (auto resOutDegree = cache.GetOutDegree(view, vertex_); resOutDegree) return {*resOutDegree};
+      if (auto version = FindMaterializedVersion(vertex_, delta, transaction_); version) {
+        if (!version->exists) return Error::NONEXISTENT_OBJECT;
+        if (!for_deleted_ && version->deleted) return Error::DELETED_OBJECT;
+        return version->out_degree;
+      }
     }
 
     auto const n_processed =
@@ -641,6 +763,7 @@ Result<size_t> VertexAccessor::OutDegree(View view) const {
       cache.StoreDeleted(view, vertex_, deleted);
       cache.StoreOutDegree(view, vertex_, degree);
     }
+    RecordDeltaChain(vertex_, transaction_, n_processed);
   }
 
   if (!exists) return Error::NONEXISTENT_OBJECT;
@@ -648,4 +771,14 @@ Result<size_t> VertexAccessor::OutDegree(View view) const {
   return degree;
 }
 
+size_t VertexAccessor::ApproximateInDegree() const {
+  std::lock_guard guard(vertex_->lock);
+  return vertex_->in_edges.size();
+}
+
+size_t VertexAccessor::ApproximateOutDegree() const {
+  std::lock_guard guard(vertex_->lock);
+  return vertex_->out_edges.size();
+}
+
 }  // namespace memgraph::storage
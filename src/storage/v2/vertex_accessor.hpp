@@ -68,6 +68,16 @@ class VertexAccessor final {
   /// @throw std::bad_alloc
   Result<PropertyValue> SetProperty(PropertyId property, const PropertyValue &value);
 
+  /// Adds the value to the property when the transaction commits instead of
+  /// setting the property right away, as in `SET n.views = n.views + 1`. The
+  /// addition is made to the latest committed value of the property, so the
+  /// additions of concurrent transactions don't conflict with each other.
+  /// Numbers are added and lists are concatenated, for the other values false
+  /// is returned and the property has to be set instead. The transaction
+  /// doesn't see the addition itself.
+  /// @throw std::bad_alloc
+  Result<bool> AddToProperty(PropertyId property, const PropertyValue &value);
+
   /// Set property values only if property store is empty. Returns `true` if successully set all values,
   /// `false` otherwise.
   /// @throw std::bad_alloc
@@ -83,6 +93,11 @@ class VertexAccessor final {
   /// @throw std::bad_alloc
   Result<PropertyValue> GetProperty(PropertyId property, View view) const;
 
+  /// Returns the values of `properties` in the same order, reading all of them
+  /// in a single pass instead of one lookup per property.
+  /// @throw std::bad_alloc
+  Result<std::vector<PropertyValue>> GetProperties(const std::vector<PropertyId> &properties, View view) const;
+
   /// @throw std::bad_alloc
   Result<std::map<PropertyId, PropertyValue>> Properties(View view) const;
 
@@ -102,6 +117,14 @@ class VertexAccessor final {
 
   Result<size_t> OutDegree(View view) const;
 
+  /// Number of in edges in the latest version of the vertex, without applying
+  /// the deltas. Cheap enough to pick which end of an edge to look it up from.
+  size_t ApproximateInDegree() const;
+
+  /// Number of out edges in the latest version of the vertex, without applying
+  /// the deltas.
+  size_t ApproximateOutDegree() const;
+
   Gid Gid() const noexcept { return vertex_->gid; }
 
   bool operator==(const VertexAccessor &other) const noexcept {
@@ -27,6 +27,7 @@ namespace memgraph::storage {
 template <typename Ret, typename Func, typename... Keys>
 auto FetchHelper(VertexInfoCache const &caches, Func &&getCache, View view, Keys &&...keys)
     -> std::optional<std::conditional_t<std::is_trivially_copyable_v<Ret>, Ret, std::reference_wrapper<Ret const>>> {
+  if (caches.suspended_) return std::nullopt;
   auto const &cache = (view == View::OLD) ? getCache(caches.old_) : getCache(caches.new_);
   // check empty first, cheaper than the relative cost of doing an actual hash + find
   if (cache.empty()) return std::nullopt;
@@ -46,6 +47,7 @@ auto FetchHelper(VertexInfoCache const &caches, Func &&getCache, View view, Keys
 
 template <typename Value, typename Func, typename... Keys>
 void Store(Value &&value, VertexInfoCache &caches, Func &&getCache, View view, Keys &&...keys) {
+  if (caches.suspended_) return;
   auto &cache = (view == View::OLD) ? getCache(caches.old_) : getCache(caches.new_);
   using key_type = typename std::remove_cvref_t<decltype(cache)>::key_type;
   cache.emplace(key_type{std::forward<Keys>(keys)...}, std::forward<Value>(value));
@@ -70,6 +72,7 @@ void VertexInfoCache::StoreDeleted(View view, Vertex const *vertex, bool res) {
 }
 
 void VertexInfoCache::Invalidate(Vertex const *vertex) {
+  if (suspended_) return;
   new_.existsCache_.erase(vertex);
   new_.deletedCache_.erase(vertex);
   new_.labelCache_.erase(vertex);
@@ -98,6 +101,7 @@ void VertexInfoCache::StoreHasLabel(View view, Vertex const *vertex, LabelId lab
   Store(res, *this, std::mem_fn(&Caches::hasLabelCache_), view, vertex, label);
 }
 void VertexInfoCache::Invalidate(Vertex const *vertex, LabelId label) {
+  if (suspended_) return;
   new_.labelCache_.erase(vertex);
   new_.hasLabelCache_.erase(std::tuple{vertex, label});
 }
@@ -117,6 +121,7 @@ void VertexInfoCache::StoreProperties(View view, Vertex const *vertex, std::map<
   Store(std::move(properties), *this, std::mem_fn(&Caches::propertiesCache_), view, vertex);
 }
 void VertexInfoCache::Invalidate(Vertex const *vertex, PropertyId property_key) {
+  if (suspended_) return;
   new_.propertiesCache_.erase(vertex);
   new_.propertyValueCache_.erase(std::tuple{vertex, property_key});
 }
@@ -159,6 +164,7 @@ void VertexInfoCache::StoreOutDegree(View view, Vertex const *vertex, std::size_
 }
 
 void VertexInfoCache::Invalidate(Vertex const *vertex, EdgeTypeId /*unused*/, EdgeDirection direction) {
+  if (suspended_) return;
   // EdgeTypeId is currently unused but could be used to be more precise in future
   if (direction == EdgeDirection::IN) {
     new_.inDegreeCache_.erase(vertex);
@@ -174,6 +180,13 @@ void VertexInfoCache::Clear() {
   new_.Clear();
 }
 
+void VertexInfoCache::Suspend() {
+  Clear();
+  suspended_ = true;
+}
+
+void VertexInfoCache::Resume() { suspended_ = false; }
+
 void VertexInfoCache::Caches::Clear() {
   existsCache_.clear();
   deletedCache_.clear();
@@ -112,6 +112,14 @@ struct VertexInfoCache final {
 
   void Clear();
 
+  /// `Suspend` clears the cache and turns it off until `Resume` turns it back
+  /// on. While the cache is suspended nothing is stored, nothing is
+  /// invalidated and every lookup misses, so several threads may read and
+  /// change the transaction at once. Neither call may run concurrently with
+  /// any other use of the cache.
+  void Suspend();
+  void Resume();
+
  private:
   /// Note: not a tuple because need a canonical form for the edge types
   struct EdgeKey {
@@ -157,6 +165,7 @@ struct VertexInfoCache final {
   };
   Caches old_;
   Caches new_;
+  bool suspended_{false};
 
   // Helpers
   template <typename Ret, typename Func, typename... Keys>
@@ -118,6 +118,15 @@ inline auto PropertyValue_ActionMethod(PropertyValue &value, PropertyId property
   });
 }
 
+inline auto PropertyValues_ActionMethod(std::vector<PropertyValue> &values, std::vector<PropertyId> const &properties) {
+  using enum Delta::Action;
+  return ActionMethod<SET_PROPERTY>([&](Delta const &delta) {
+    for (size_t i = 0; i < properties.size(); ++i) {
+      if (delta.property.key == properties[i]) values[i] = delta.property.value;
+    }
+  });
+}
+
 inline auto PropertyValueMatch_ActionMethod(bool &match, PropertyId property, PropertyValue const &value) {
   using enum Delta::Action;
   return ActionMethod<SET_PROPERTY>([&, property](Delta const &delta) {
@@ -125,6 +134,16 @@ inline auto PropertyValueMatch_ActionMethod(bool &match, PropertyId property, Pr
   });
 }
 
+inline auto PropertyValuesMatch_ActionMethod(std::vector<bool> &matches, std::vector<PropertyId> const &properties,
+                                             std::vector<PropertyValue> const &values) {
+  using enum Delta::Action;
+  return ActionMethod<SET_PROPERTY>([&](Delta const &delta) {
+    for (size_t i = 0; i < properties.size(); ++i) {
+      if (delta.property.key == properties[i]) matches[i] = (values[i] == delta.property.value);
+    }
+  });
+}
+
 inline auto Properties_ActionMethod(std::map<PropertyId, PropertyValue> &properties) {
   using enum Delta::Action;
   return ActionMethod<SET_PROPERTY>([&](Delta const &delta) {
@@ -26,6 +26,12 @@ VerticesIterable::VerticesIterable(InMemoryLabelPropertyIndex::Iterable vertices
   new (&in_memory_vertices_by_label_property_) InMemoryLabelPropertyIndex::Iterable(std::move(vertices));
 }
 
+VerticesIterable::VerticesIterable(InMemoryLabelPropertyCompositeIndex::Iterable vertices)
+    : type_(Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY) {
+  new (&in_memory_vertices_by_label_property_composite_)
+      InMemoryLabelPropertyCompositeIndex::Iterable(std::move(vertices));
+}
+
 VerticesIterable::VerticesIterable(VerticesIterable &&other) noexcept : type_(other.type_) {
   switch (other.type_) {
     case Type::ALL:
@@ -38,6 +44,11 @@ VerticesIterable::VerticesIterable(VerticesIterable &&other) noexcept : type_(ot
       new (&in_memory_vertices_by_label_property_)
           InMemoryLabelPropertyIndex::Iterable(std::move(other.in_memory_vertices_by_label_property_));
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY:
+      new (&in_memory_vertices_by_label_property_composite_)
+          InMemoryLabelPropertyCompositeIndex::Iterable(
+              std::move(other.in_memory_vertices_by_label_property_composite_));
+      break;
   }
 }
 
@@ -52,6 +63,9 @@ VerticesIterable &VerticesIterable::operator=(VerticesIterable &&other) noexcept
     case Type::BY_LABEL_PROPERTY_IN_MEMORY:
       in_memory_vertices_by_label_property_.InMemoryLabelPropertyIndex::Iterable::~Iterable();
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY:
+      in_memory_vertices_by_label_property_composite_.InMemoryLabelPropertyCompositeIndex::Iterable::~Iterable();
+      break;
   }
   type_ = other.type_;
   switch (other.type_) {
@@ -65,6 +79,11 @@ VerticesIterable &VerticesIterable::operator=(VerticesIterable &&other) noexcept
       new (&in_memory_vertices_by_label_property_)
           InMemoryLabelPropertyIndex::Iterable(std::move(other.in_memory_vertices_by_label_property_));
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY:
+      new (&in_memory_vertices_by_label_property_composite_)
+          InMemoryLabelPropertyCompositeIndex::Iterable(
+              std::move(other.in_memory_vertices_by_label_property_composite_));
+      break;
   }
   return *this;
 }
@@ -80,6 +99,9 @@ VerticesIterable::~VerticesIterable() {
     case Type::BY_LABEL_PROPERTY_IN_MEMORY:
       in_memory_vertices_by_label_property_.InMemoryLabelPropertyIndex::Iterable::~Iterable();
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY:
+      in_memory_vertices_by_label_property_composite_.InMemoryLabelPropertyCompositeIndex::Iterable::~Iterable();
+      break;
   }
 }
 
@@ -91,6 +113,8 @@ VerticesIterable::Iterator VerticesIterable::begin() {
       return Iterator(in_memory_vertices_by_label_.begin());
     case Type::BY_LABEL_PROPERTY_IN_MEMORY:
       return Iterator(in_memory_vertices_by_label_property_.begin());
+    case Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY:
+      return Iterator(in_memory_vertices_by_label_property_composite_.begin());
   }
 }
 
@@ -102,6 +126,8 @@ VerticesIterable::Iterator VerticesIterable::end() {
       return Iterator(in_memory_vertices_by_label_.end());
     case Type::BY_LABEL_PROPERTY_IN_MEMORY:
       return Iterator(in_memory_vertices_by_label_property_.end());
+    case Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY:
+      return Iterator(in_memory_vertices_by_label_property_composite_.end());
   }
 }
 
@@ -121,6 +147,13 @@ VerticesIterable::Iterator::Iterator(InMemoryLabelPropertyIndex::Iterable::Itera
   new (&in_memory_by_label_property_it_) InMemoryLabelPropertyIndex::Iterable::Iterator(std::move(it));
 }
 
+VerticesIterable::Iterator::Iterator(InMemoryLabelPropertyCompositeIndex::Iterable::Iterator it)
+    : type_(Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY) {
+  // NOLINTNEXTLINE(hicpp-move-const-arg,performance-move-const-arg)
+  new (&in_memory_by_label_property_composite_it_)
+      InMemoryLabelPropertyCompositeIndex::Iterable::Iterator(std::move(it));
+}
+
 VerticesIterable::Iterator::Iterator(const VerticesIterable::Iterator &other) : type_(other.type_) {
   switch (other.type_) {
     case Type::ALL:
@@ -133,6 +166,10 @@ VerticesIterable::Iterator::Iterator(const VerticesIterable::Iterator &other) :
       new (&in_memory_by_label_property_it_)
           InMemoryLabelPropertyIndex::Iterable::Iterator(other.in_memory_by_label_property_it_);
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY:
+      new (&in_memory_by_label_property_composite_it_)
+          InMemoryLabelPropertyCompositeIndex::Iterable::Iterator(other.in_memory_by_label_property_composite_it_);
+      break;
   }
 }
 
@@ -151,6 +188,10 @@ VerticesIterable::Iterator &VerticesIterable::Iterator::operator=(const Vertices
       new (&in_memory_by_label_property_it_)
           InMemoryLabelPropertyIndex::Iterable::Iterator(other.in_memory_by_label_property_it_);
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY:
+      new (&in_memory_by_label_property_composite_it_)
+          InMemoryLabelPropertyCompositeIndex::Iterable::Iterator(other.in_memory_by_label_property_composite_it_);
+      break;
   }
   return *this;
 }
@@ -170,6 +211,12 @@ VerticesIterable::Iterator::Iterator(VerticesIterable::Iterator &&other) noexcep
           // NOLINTNEXTLINE(hicpp-move-const-arg,performance-move-const-arg)
           InMemoryLabelPropertyIndex::Iterable::Iterator(std::move(other.in_memory_by_label_property_it_));
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY:
+      new (&in_memory_by_label_property_composite_it_)
+          // NOLINTNEXTLINE(hicpp-move-const-arg,performance-move-const-arg)
+          InMemoryLabelPropertyCompositeIndex::Iterable::Iterator(
+              std::move(other.in_memory_by_label_property_composite_it_));
+      break;
   }
 }
 
@@ -190,6 +237,12 @@ VerticesIterable::Iterator &VerticesIterable::Iterator::operator=(VerticesIterab
           // NOLINTNEXTLINE(hicpp-move-const-arg,performance-move-const-arg)
           InMemoryLabelPropertyIndex::Iterable::Iterator(std::move(other.in_memory_by_label_property_it_));
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY:
+      new (&in_memory_by_label_property_composite_it_)
+          // NOLINTNEXTLINE(hicpp-move-const-arg,performance-move-const-arg)
+          InMemoryLabelPropertyCompositeIndex::Iterable::Iterator(
+              std::move(other.in_memory_by_label_property_composite_it_));
+      break;
   }
   return *this;
 }
@@ -207,6 +260,9 @@ void VerticesIterable::Iterator::Destroy() noexcept {
     case Type::BY_LABEL_PROPERTY_IN_MEMORY:
       in_memory_by_label_property_it_.InMemoryLabelPropertyIndex::Iterable::Iterator::~Iterator();
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY:
+      in_memory_by_label_property_composite_it_.InMemoryLabelPropertyCompositeIndex::Iterable::Iterator::~Iterator();
+      break;
   }
 }
 
@@ -218,6 +274,8 @@ VertexAccessor VerticesIterable::Iterator::operator*() const {
       return *in_memory_by_label_it_;
     case Type::BY_LABEL_PROPERTY_IN_MEMORY:
       return *in_memory_by_label_property_it_;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY:
+      return *in_memory_by_label_property_composite_it_;
   }
 }
 
@@ -232,6 +290,9 @@ VerticesIterable::Iterator &VerticesIterable::Iterator::operator++() {
     case Type::BY_LABEL_PROPERTY_IN_MEMORY:
       ++in_memory_by_label_property_it_;
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY:
+      ++in_memory_by_label_property_composite_it_;
+      break;
   }
   return *this;
 }
@@ -244,6 +305,8 @@ bool VerticesIterable::Iterator::operator==(const Iterator &other) const {
       return in_memory_by_label_it_ == other.in_memory_by_label_it_;
     case Type::BY_LABEL_PROPERTY_IN_MEMORY:
       return in_memory_by_label_property_it_ == other.in_memory_by_label_property_it_;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE_IN_MEMORY:
+      return in_memory_by_label_property_composite_it_ == other.in_memory_by_label_property_composite_it_;
   }
 }
 
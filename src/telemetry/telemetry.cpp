@@ -37,7 +37,9 @@ Telemetry::Telemetry(std::string url, std::filesystem::path storage_directory, s
   StoreData("startup", utils::GetSystemInfo());
   AddCollector("resources", GetResourceUsage);
   AddCollector("uptime", [&]() -> nlohmann::json { return GetUptime(); });
-  scheduler_.Run("Telemetry", refresh_interval, [&] { CollectData(); });
+  // Sending the data can wait for the network, so it doesn't hold up the workers of the other periodic tasks.
+  scheduler_.Run(
+      "Telemetry", refresh_interval, [&] { CollectData(); }, {.priority = utils::PeriodicTaskPriority::LOW});
 }
 
 void Telemetry::AddCollector(const std::string &name, const std::function<const nlohmann::json(void)> &func) {
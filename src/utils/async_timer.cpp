@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <limits>
 
+#include "utils/interrupt.hpp"
 #include "utils/skip_list.hpp"
 #include "utils/spin_lock.hpp"
 #include "utils/synchronized.hpp"
@@ -72,6 +73,7 @@ void MarkDone(const uint64_t flag_id) {
   auto flag = weak_flag.lock();
   if (flag != nullptr) {
     flag->store(true, std::memory_order_relaxed);
+    memgraph::utils::NotifyInterrupt();
   }
 }
 }  // namespace
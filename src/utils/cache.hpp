@@ -86,6 +86,22 @@ class LruList {
     }
   }
 
+  void RemovePage(Node<TKey, TValue> *page) {
+    MG_ASSERT(front_ != nullptr && rear_ != nullptr, "Both front_ and rear_ must be valid");
+    if (page == rear_) {
+      RemoveRearPage();
+      return;
+    }
+    if (page == front_) {
+      front_ = front_->next;
+      front_->prev = nullptr;
+    } else {
+      page->prev->next = page->next;
+      page->next->prev = page->prev;
+    }
+    delete page;
+  }
+
   Node<TKey, TValue> *Rear() { return rear_; }
 
   void Clear() {
@@ -153,6 +169,16 @@ class LruCache {
     access_map_.emplace(key, page);
   }
 
+  /// Removes the given key from the cache if it is present.
+  void Erase(const TKey &key) {
+    auto found = access_map_.find(key);
+    if (found == access_map_.end()) {
+      return;
+    }
+    lru_order_.RemovePage(found->second);
+    access_map_.erase(found);
+  }
+
   void Clear() {
     access_map_.clear();
     lru_order_.Clear();
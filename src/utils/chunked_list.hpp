@@ -0,0 +1,185 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace memgraph::utils {
+
+/// Append-only list that stores its elements in a chain of chunks.
+///
+/// Chunks double in capacity (from `kMinChunkCapacity` up to
+/// `kMaxChunkCapacity` elements), so appending n elements does O(log(n))
+/// allocations for small lists and one allocation per `kMaxChunkCapacity`
+/// elements for large ones. Elements are never moved once they are created,
+/// so pointers and references to them stay valid for the lifetime of the list,
+/// including after the list itself is moved. All elements are destroyed and
+/// all chunks are released together when the list is cleared or destroyed.
+///
+/// The list isn't thread-safe.
+template <typename T, size_t kMinChunkCapacity = 2, size_t kMaxChunkCapacity = 512>
+class ChunkedList final {
+  static_assert(kMinChunkCapacity > 0 && kMinChunkCapacity <= kMaxChunkCapacity,
+                "Invalid ChunkedList chunk capacities!");
+
+  struct Chunk {
+    Chunk *next;
+    size_t size;
+    size_t capacity;
+
+    T *Elements() { return reinterpret_cast<T *>(reinterpret_cast<std::byte *>(this) + kElementsOffset); }
+  };
+
+  static constexpr size_t kElementsOffset = (sizeof(Chunk) + alignof(T) - 1) / alignof(T) * alignof(T);
+  static constexpr std::align_val_t kChunkAlignment{std::max(alignof(Chunk), alignof(T))};
+
+  template <bool IsConst>
+  class Iterator final {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<IsConst, const T *, T *>;
+    using reference = std::conditional_t<IsConst, const T &, T &>;
+
+    Iterator() = default;
+
+    // Allows conversion from a mutable to a const iterator.
+    template <bool OtherIsConst, typename = std::enable_if_t<IsConst && !OtherIsConst>>
+    Iterator(const Iterator<OtherIsConst> &other) : chunk_(other.chunk_), pos_(other.pos_) {}
+
+    reference operator*() const { return chunk_->Elements()[pos_]; }
+    pointer operator->() const { return &chunk_->Elements()[pos_]; }
+
+    Iterator &operator++() {
+      if (++pos_ == chunk_->size) {
+        chunk_ = chunk_->next;
+        pos_ = 0;
+        // Only the last chunk can be empty (if constructing its first element
+        // threw), and it is the end of the list then.
+        if (chunk_ && chunk_->size == 0) chunk_ = nullptr;
+      }
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto copy = *this;
+      ++(*this);
+      return copy;
+    }
+
+    friend bool operator==(const Iterator &a, const Iterator &b) { return a.chunk_ == b.chunk_ && a.pos_ == b.pos_; }
+    friend bool operator!=(const Iterator &a, const Iterator &b) { return !(a == b); }
+
+   private:
+    friend class ChunkedList;
+    template <bool>
+    friend class Iterator;
+
+    Iterator(Chunk *chunk, size_t pos) : chunk_(chunk), pos_(pos) {}
+
+    Chunk *chunk_{nullptr};
+    size_t pos_{0};
+  };
+
+ public:
+  using value_type = T;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  ChunkedList() = default;
+
+  ChunkedList(const ChunkedList &) = delete;
+  ChunkedList &operator=(const ChunkedList &) = delete;
+
+  ChunkedList(ChunkedList &&other) noexcept
+      : head_(std::exchange(other.head_, nullptr)),
+        tail_(std::exchange(other.tail_, nullptr)),
+        size_(std::exchange(other.size_, 0)) {}
+
+  ChunkedList &operator=(ChunkedList &&other) noexcept {
+    if (this == &other) return *this;
+    clear();
+    head_ = std::exchange(other.head_, nullptr);
+    tail_ = std::exchange(other.tail_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    return *this;
+  }
+
+  ~ChunkedList() { clear(); }
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  iterator begin() { return empty() ? end() : iterator(head_, 0); }
+  iterator end() { return {}; }
+  const_iterator begin() const { return empty() ? end() : const_iterator(head_, 0); }
+  const_iterator end() const { return {}; }
+
+  T &front() { return *head_->Elements(); }
+  const T &front() const { return *head_->Elements(); }
+  T &back() { return tail_->Elements()[tail_->size - 1]; }
+  const T &back() const { return tail_->Elements()[tail_->size - 1]; }
+
+  /// Constructs a new element at the end of the list and returns a reference
+  /// to it.
+  /// @throw std::bad_alloc
+  template <typename... Args>
+  T &emplace_back(Args &&...args) {
+    if (!tail_ || tail_->size == tail_->capacity) AllocateChunk();
+    auto *element = new (tail_->Elements() + tail_->size) T(std::forward<Args>(args)...);
+    ++tail_->size;
+    ++size_;
+    return *element;
+  }
+
+  /// Destroys all elements in insertion order and releases all chunks.
+  void clear() noexcept {
+    auto *chunk = head_;
+    while (chunk) {
+      auto *next = chunk->next;
+      auto *elements = chunk->Elements();
+      for (size_t i = 0; i < chunk->size; ++i) elements[i].~T();
+      ::operator delete(chunk, kChunkAlignment);
+      chunk = next;
+    }
+    head_ = nullptr;
+    tail_ = nullptr;
+    size_ = 0;
+  }
+
+ private:
+  void AllocateChunk() {
+    auto capacity = tail_ ? std::min(tail_->capacity * 2, kMaxChunkCapacity) : kMinChunkCapacity;
+    auto *chunk = static_cast<Chunk *>(::operator new(kElementsOffset + capacity * sizeof(T), kChunkAlignment));
+    chunk->next = nullptr;
+    chunk->size = 0;
+    chunk->capacity = capacity;
+    if (tail_) {
+      tail_->next = chunk;
+    } else {
+      head_ = chunk;
+    }
+    tail_ = chunk;
+  }
+
+  Chunk *head_{nullptr};
+  Chunk *tail_{nullptr};
+  size_t size_{0};
+};
+
+}  // namespace memgraph::utils
@@ -0,0 +1,109 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "utils/compressor.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <new>
+
+#include <zlib.h>
+
+namespace memgraph::utils {
+
+std::optional<std::vector<uint8_t>> CompressBuffer(const uint8_t *data, uint64_t size) {
+  if (size > std::numeric_limits<uLong>::max()) return std::nullopt;
+  auto compressed_size = compressBound(static_cast<uLong>(size));
+  std::vector<uint8_t> compressed(compressed_size);
+  if (compress2(compressed.data(), &compressed_size, data, static_cast<uLong>(size), Z_BEST_SPEED) != Z_OK) {
+    return std::nullopt;
+  }
+  compressed.resize(compressed_size);
+  return compressed;
+}
+
+bool DecompressBuffer(const uint8_t *data, uint64_t size, uint8_t *output, uint64_t output_size) {
+  if (size > std::numeric_limits<uLong>::max() || output_size > std::numeric_limits<uLongf>::max()) return false;
+  auto decompressed_size = static_cast<uLongf>(output_size);
+  if (uncompress(output, &decompressed_size, data, static_cast<uLong>(size)) != Z_OK) return false;
+  return decompressed_size == output_size;
+}
+
+namespace {
+// Size by which the output grows while it doesn't fit the (de)compressed data.
+constexpr size_t kStreamOutputStep = 16 * 1024;
+}  // namespace
+
+struct StreamCompressor::State {
+  z_stream stream{};
+};
+
+StreamCompressor::StreamCompressor() : state_(std::make_unique<State>()) {
+  if (deflateInit(&state_->stream, Z_BEST_SPEED) != Z_OK) throw std::bad_alloc();
+}
+
+StreamCompressor::~StreamCompressor() { deflateEnd(&state_->stream); }
+
+bool StreamCompressor::Compress(const uint8_t *data, size_t size, bool flush, std::vector<uint8_t> &output) {
+  auto &stream = state_->stream;
+  while (true) {
+    // zlib takes the sizes as `uInt`, so large inputs are compressed in parts.
+    const auto input_size = std::min<size_t>(size, std::numeric_limits<uInt>::max());
+    stream.next_in = const_cast<uint8_t *>(data);
+    stream.avail_in = static_cast<uInt>(input_size);
+    const bool last = input_size == size;
+    const int mode = last && flush ? Z_SYNC_FLUSH : Z_NO_FLUSH;
+    do {
+      const auto offset = output.size();
+      output.resize(offset + std::max<size_t>(deflateBound(&stream, stream.avail_in), kStreamOutputStep));
+      stream.next_out = output.data() + offset;
+      stream.avail_out = static_cast<uInt>(output.size() - offset);
+      const auto ret = deflate(&stream, mode);
+      output.resize(output.size() - stream.avail_out);
+      if (ret == Z_STREAM_ERROR) return false;
+      // The output is full if zlib has more pending data to write.
+    } while (stream.avail_out == 0 || stream.avail_in > 0);
+    if (last) return true;
+    data += input_size;
+    size -= input_size;
+  }
+}
+
+struct StreamDecompressor::State {
+  z_stream stream{};
+};
+
+StreamDecompressor::StreamDecompressor() : state_(std::make_unique<State>()) {
+  if (inflateInit(&state_->stream) != Z_OK) throw std::bad_alloc();
+}
+
+StreamDecompressor::~StreamDecompressor() { inflateEnd(&state_->stream); }
+
+bool StreamDecompressor::Decompress(const uint8_t *data, size_t size, std::vector<uint8_t> &output) {
+  auto &stream = state_->stream;
+  stream.next_in = const_cast<uint8_t *>(data);
+  stream.avail_in = static_cast<uInt>(size);
+  do {
+    const auto offset = output.size();
+    output.resize(offset + kStreamOutputStep);
+    stream.next_out = output.data() + offset;
+    stream.avail_out = static_cast<uInt>(kStreamOutputStep);
+    const auto ret = inflate(&stream, Z_NO_FLUSH);
+    output.resize(output.size() - stream.avail_out);
+    if (ret != Z_OK && ret != Z_BUF_ERROR && ret != Z_STREAM_END) return false;
+    // Z_BUF_ERROR means that no progress was possible, i.e. all the input was
+    // consumed and the output has room.
+    if (ret == Z_BUF_ERROR && stream.avail_out > 0) break;
+  } while (stream.avail_in > 0 || stream.avail_out == 0);
+  return true;
+}
+
+}  // namespace memgraph::utils
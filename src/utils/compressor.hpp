@@ -0,0 +1,78 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace memgraph::utils {
+
+/// Compresses `size` bytes starting at `data` using zlib. The compression
+/// level favors speed over ratio. Returns `std::nullopt` if the compression
+/// failed.
+/// @throw std::bad_alloc
+std::optional<std::vector<uint8_t>> CompressBuffer(const uint8_t *data, uint64_t size);
+
+/// Decompresses `size` bytes of zlib data starting at `data` into `output`,
+/// which must be exactly `output_size` bytes large. Returns false if the data is
+/// corrupted or doesn't decompress to exactly `output_size` bytes.
+bool DecompressBuffer(const uint8_t *data, uint64_t size, uint8_t *output, uint64_t output_size);
+
+/// Compresses a stream of data using zlib, so that the data repeating across
+/// the calls is compressed too.
+class StreamCompressor {
+ public:
+  /// @throw std::bad_alloc
+  StreamCompressor();
+  ~StreamCompressor();
+
+  StreamCompressor(const StreamCompressor &) = delete;
+  StreamCompressor &operator=(const StreamCompressor &) = delete;
+  StreamCompressor(StreamCompressor &&) = delete;
+  StreamCompressor &operator=(StreamCompressor &&) = delete;
+
+  /// Compresses `size` bytes starting at `data` and appends the compressed
+  /// data to `output`. If `flush` is set, all the data compressed so far is
+  /// appended, so the receiver can decompress it without waiting for more.
+  /// Returns false if the compression failed.
+  bool Compress(const uint8_t *data, size_t size, bool flush, std::vector<uint8_t> &output);
+
+ private:
+  struct State;
+  std::unique_ptr<State> state_;
+};
+
+/// Decompresses a stream of data compressed by `StreamCompressor`.
+class StreamDecompressor {
+ public:
+  /// @throw std::bad_alloc
+  StreamDecompressor();
+  ~StreamDecompressor();
+
+  StreamDecompressor(const StreamDecompressor &) = delete;
+  StreamDecompressor &operator=(const StreamDecompressor &) = delete;
+  StreamDecompressor(StreamDecompressor &&) = delete;
+  StreamDecompressor &operator=(StreamDecompressor &&) = delete;
+
+  /// Decompresses `size` bytes starting at `data` and appends the
+  /// decompressed data to `output`. Returns false if the data is corrupted.
+  bool Decompress(const uint8_t *data, size_t size, std::vector<uint8_t> &output);
+
+ private:
+  struct State;
+  std::unique_ptr<State> state_;
+};
+
+}  // namespace memgraph::utils
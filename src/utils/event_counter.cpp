@@ -16,6 +16,7 @@
   M(ReadQuery, QueryType, "Number of read-only queries executed.")                                                   \
   M(WriteQuery, QueryType, "Number of write-only queries executed.")                                                 \
   M(ReadWriteQuery, QueryType, "Number of read-write queries executed.")                                             \
+  M(CachedQueryResults, QueryType, "Number of read-only queries served from the result cache.")                      \
                                                                                                                      \
   M(OnceOperator, Operator, "Number of times Once operator was used.")                                               \
   M(CreateNodeOperator, Operator, "Number of times CreateNode operator was used.")                                   \
@@ -23,11 +24,18 @@
   M(ScanAllOperator, Operator, "Number of times ScanAll operator was used.")                                         \
   M(ScanAllByLabelOperator, Operator, "Number of times ScanAllByLabel operator was used.")                           \
   M(ScanAllByLabelPropertyRangeOperator, Operator, "Number of times ScanAllByLabelPropertyRange operator was used.") \
+  M(ScanAllByLabelPropertyCompositeOperator, Operator,                                                               \
+    "Number of times ScanAllByLabelPropertyComposite operator was used.")                                            \
   M(ScanAllByLabelPropertyValueOperator, Operator, "Number of times ScanAllByLabelPropertyValue operator was used.") \
+  M(ScanAllByLabelPropertyValuesOperator, Operator,                                                                  \
+    "Number of times ScanAllByLabelPropertyValues operator was used.")                                               \
   M(ScanAllByLabelPropertyOperator, Operator, "Number of times ScanAllByLabelProperty operator was used.")           \
   M(ScanAllByIdOperator, Operator, "Number of times ScanAllById operator was used.")                                 \
+  M(ScanAllByEdgeTypeOperator, Operator, "Number of times ScanAllByEdgeType operator was used.")                     \
+  M(ScanAllByEdgeTypePropertyOperator, Operator, "Number of times ScanAllByEdgeTypeProperty operator was used.")     \
   M(ExpandOperator, Operator, "Number of times Expand operator was used.")                                           \
   M(ExpandVariableOperator, Operator, "Number of times ExpandVariable operator was used.")                           \
+  M(IntersectExpandOperator, Operator, "Number of times IntersectExpand operator was used.")                         \
   M(ConstructNamedPathOperator, Operator, "Number of times ConstructNamedPath operator was used.")                   \
   M(FilterOperator, Operator, "Number of times Filter operator was used.")                                           \
   M(ProduceOperator, Operator, "Number of times Produce operator was used.")                                         \
@@ -47,31 +55,46 @@
   M(MergeOperator, Operator, "Number of times Merge operator was used.")                                             \
   M(OptionalOperator, Operator, "Number of times Optional operator was used.")                                       \
   M(UnwindOperator, Operator, "Number of times Unwind operator was used.")                                           \
+  M(UnwindMergeOperator, Operator, "Number of times UnwindMerge operator was used.")                                 \
   M(DistinctOperator, Operator, "Number of times Distinct operator was used.")                                       \
   M(UnionOperator, Operator, "Number of times Union operator was used.")                                             \
   M(CartesianOperator, Operator, "Number of times Cartesian operator was used.")                                     \
+  M(HashJoinOperator, Operator, "Number of times HashJoin operator was used.")                                       \
   M(CallProcedureOperator, Operator, "Number of times CallProcedure operator was used.")                             \
   M(ForeachOperator, Operator, "Number of times Foreach operator was used.")                                         \
   M(EvaluatePatternFilterOperator, Operator, "Number of times EvaluatePatternFilter operator was used.")             \
   M(ApplyOperator, Operator, "Number of times ApplyOperator operator was used.")                                     \
+  M(PeriodicCommitOperator, Operator, "Number of times PeriodicCommit operator was used.")                           \
                                                                                                                      \
   M(ActiveLabelIndices, Index, "Number of active label indices in the system.")                                      \
   M(ActiveLabelPropertyIndices, Index, "Number of active label property indices in the system<.")                    \
                                                                                                                      \
+  M(WalDeltasRecovered, Snapshot, "Number of WAL deltas applied during recovery.")                                   \
+                                                                                                                     \
   M(StreamsCreated, Stream, "Number of Streams created.")                                                            \
   M(MessagesConsumed, Stream, "Number of consumed streamed messages.")                                               \
                                                                                                                      \
   M(TriggersCreated, Trigger, "Number of Triggers created.")                                                         \
   M(TriggersExecuted, Trigger, "Number of Triggers executed.")                                                       \
+  M(AfterCommitTriggerBackpressure, Trigger,                                                                         \
+    "Number of commits which waited for the backlog of AFTER COMMIT triggers to shrink.")                            \
+                                                                                                                     \
+  M(DroppedAuditLogEntries, Audit, "Number of audit log entries dropped because the audit log buffer was full.")     \
                                                                                                                      \
   M(ActiveSessions, Session, "Number of active connections.")                                                        \
   M(ActiveBoltSessions, Session, "Number of active Bolt connections.")                                               \
   M(ActiveTCPSessions, Session, "Number of active TCP connections.")                                                 \
   M(ActiveSSLSessions, Session, "Number of active SSL connections.")                                                 \
+  M(SSLHandshakes, Session, "Number of full SSL handshakes.")                                                        \
+  M(SSLResumedHandshakes, Session, "Number of SSL handshakes which resumed an earlier session.")                     \
+  M(SSLFailedHandshakes, Session, "Number of failed SSL handshakes.")                                                \
+  M(SSLKernelOffloadedSessions, Session, "Number of SSL connections encrypted by the kernel.")                       \
   M(ActiveWebSocketSessions, Session, "Number of active websocket connections.")                                     \
   M(BoltMessages, Session, "Number of Bolt messages sent.")                                                          \
                                                                                                                      \
   M(ActiveTransactions, Transaction, "Number of active transactions.")                                               \
+  M(QueuedQueries, Transaction, "Number of queries waiting to be admitted for execution.")                           \
+  M(RejectedQueries, Transaction, "Number of queries which weren't admitted for execution.")                         \
   M(CommitedTransactions, Transaction, "Number of committed transactions.")                                          \
   M(RollbackedTransactions, Transaction, "Number of rollbacked transactions.")                                       \
   M(FailedQuery, Transaction, "Number of times executing a query failed.")
@@ -11,8 +11,20 @@
 
 #include "utils/event_gauge.hpp"
 
-// We don't have any gauges for now
-#define APPLY_FOR_GAUGES(M)
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define APPLY_FOR_GAUGES(M)                                                                                            \
+  M(GCPendingTransactions, GC, "Number of committed transactions whose deltas weren't unlinked by the last GC cycle.") \
+  M(GCPendingUndoBuffers, GC, "Number of unlinked undo buffers that weren't freed by the last GC cycle.")              \
+  M(GCPendingDeltas, GC, "Number of deltas of committed transactions that weren't unlinked by the last GC cycle.")     \
+  M(SnapshotObjectsToWrite, Snapshot, "Number of objects the last started snapshot has to write.")                     \
+  M(SnapshotObjectsWritten, Snapshot, "Number of objects the last started snapshot has written so far.")               \
+  M(DiskBlockCacheHit, Disk, "Number of RocksDB block cache hits since the on-disk storage was opened.")               \
+  M(DiskBlockCacheMiss, Disk, "Number of RocksDB block cache misses since the on-disk storage was opened.")            \
+  M(DiskBloomFilterUseful, Disk, "Number of RocksDB reads of an SST file avoided by its bloom filter.")                \
+  M(DiskBytesRead, Disk, "Number of bytes RocksDB read since the on-disk storage was opened.")                         \
+  M(DiskBytesWritten, Disk, "Number of bytes RocksDB wrote since the on-disk storage was opened.")                     \
+  M(DiskCompactionBytesWritten, Disk, "Number of bytes written by the RocksDB compactions of the on-disk storage.")    \
+  M(AfterCommitTriggerBacklog, Trigger, "Number of committed transactions with unfinished AFTER COMMIT triggers.")
 
 namespace memgraph::metrics {
 
@@ -12,10 +12,32 @@
 #include "utils/event_histogram.hpp"
 
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
-#define APPLY_FOR_HISTOGRAMS(M)                                                                    \
-  M(QueryExecutionLatency_us, Query, "Query execution latency in microseconds", 50, 90, 99)        \
-  M(SnapshotCreationLatency_us, Snapshot, "Snapshot creation latency in microseconds", 50, 90, 99) \
-  M(SnapshotRecoveryLatency_us, Snapshot, "Snapshot recovery latency in microseconds", 50, 90, 99)
+#define APPLY_FOR_HISTOGRAMS(M)                                                                                   \
+  M(QueryExecutionLatency_us, Query, "Query execution latency in microseconds", 50, 90, 99)                       \
+  M(AdmissionWaitTime_us, Query, "Time queued queries waited to be admitted for execution", 50, 90, 99)           \
+  M(SnapshotCreationLatency_us, Snapshot, "Snapshot creation latency in microseconds", 50, 90, 99)                \
+  M(SnapshotRecoveryLatency_us, Snapshot, "Snapshot recovery latency in microseconds", 50, 90, 99)                \
+  M(WalRecoveryLatency_us, Snapshot, "WAL files recovery latency in microseconds", 50, 90, 99)                    \
+  M(GCLatency_us, GC, "Garbage collection cycle latency in microseconds", 50, 90, 99)                             \
+  M(SSLHandshakeLatency_us, Session, "SSL handshake latency in microseconds", 50, 90, 99)                         \
+  M(ReplicaAcknowledgementLatency_us, Replication, "Replica acknowledgement latency in microseconds", 50, 90, 99) \
+  M(ProcedureTimeToFirstRecord_us, Query, "Time until a procedure call yielded its first records", 50, 90, 99)    \
+  M(ProcedureResultBuffer_bytes, Query, "Peak size of the buffered records of a procedure call", 50, 90, 99)      \
+  M(AfterCommitTriggerLag_us, Trigger, "AFTER COMMIT trigger wait time for a worker in microseconds", 50, 90, 99) \
+  M(TransactionPeakMemory_bytes, Transaction, "Peak memory allocated by a transaction in bytes", 50, 90, 99)      \
+  M(ScanPullLatency_ns, Operator, "Sampled pull latency of scan operators in nanoseconds", 50, 90, 99)            \
+  M(ExpandPullLatency_ns, Operator, "Sampled pull latency of expand operators in nanoseconds", 50, 90, 99)        \
+  M(FilterPullLatency_ns, Operator, "Sampled pull latency of filter operators in nanoseconds", 50, 90, 99)        \
+  M(AggregationPullLatency_ns, Operator, "Sampled pull latency of aggregations and sorts in ns", 50, 90, 99)      \
+  M(WritePullLatency_ns, Operator, "Sampled pull latency of write operators in nanoseconds", 50, 90, 99)          \
+  M(ProducePullLatency_ns, Operator, "Sampled pull latency of Produce in nanoseconds", 50, 90, 99)                \
+  M(MainLockWait_ns, Transaction, "Wait time for the contended storage main lock in ns", 50, 90, 99)              \
+  M(EngineLockWait_ns, Transaction, "Wait time for the contended storage engine lock in ns", 50, 90, 99)          \
+  M(ObjectLockWait_ns, Transaction, "Wait time for the contended lock of a vertex or an edge in ns", 50, 90, 99)  \
+  M(DeltaChainLength, Transaction, "Sampled number of deltas applied to read a vertex or an edge", 50, 90, 99)    \
+  M(WalFsyncLatency_us, Snapshot, "WAL file fsync latency in microseconds", 50, 90, 99)                           \
+  M(PeriodicTaskRunTime_us, Scheduler, "Run time of periodic background tasks in microseconds", 50, 90, 99)       \
+  M(PeriodicTaskLateness_us, Scheduler, "Delay of periodic background tasks after they were due in us", 50, 90, 99)
 
 namespace memgraph::metrics {
 
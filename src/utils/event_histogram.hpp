@@ -67,6 +67,12 @@ class Histogram {
 
   std::mutex samples_mutex_;
 
+  static double Compress(uint64_t value) {
+    double boosted = 1.0 + static_cast<double>(value);
+    double ln = std::log(boosted);
+    return (kPrecision * ln) + 0.5;
+  }
+
  public:
   Histogram() {
     samples_.resize(kSampleLimit, 0);
@@ -83,9 +89,7 @@ class Histogram {
 
   void Measure(uint64_t value) {
     // "compression" logic
-    double boosted = 1.0 + static_cast<double>(value);
-    double ln = std::log(boosted);
-    double compressed = (kPrecision * ln) + 0.5;
+    double compressed = Compress(value);
 
     MG_ASSERT(compressed < kSampleLimit, "compressing value {} to {} is invalid", value, compressed);
     auto sample_index = static_cast<uint16_t>(compressed);
@@ -110,6 +114,31 @@ class Histogram {
     return percentile_yield;
   }
 
+  // Returns the number of measured values which are at most each of the
+  // increasing `bounds`, followed by the number of all measured values. The
+  // values are compared with the bounds after compressing both of them, so
+  // the counts have the same precision as the percentiles.
+  std::vector<uint64_t> CumulativeCounts(const std::vector<uint64_t> &bounds) const {
+    std::vector<uint64_t> counts;
+    counts.reserve(bounds.size() + 1);
+
+    uint64_t scanned = 0;
+    int i = 0;
+    for (const auto bound : bounds) {
+      const auto last_index = std::min(static_cast<int>(Compress(bound)), kSampleLimit - 1);
+      for (; i <= last_index; i++) {
+        scanned += samples_[i];
+      }
+      counts.push_back(scanned);
+    }
+    for (; i < kSampleLimit; i++) {
+      scanned += samples_[i];
+    }
+    counts.push_back(scanned);
+
+    return counts;
+  }
+
   uint64_t Percentile(double percentile) const {
     MG_ASSERT(percentile <= 100.0, "percentiles must not exceed 100.0");
     MG_ASSERT(percentile >= 0.0, "percentiles must be greater than or equal to 0.0");
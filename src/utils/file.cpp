@@ -12,6 +12,7 @@
 #include "utils/file.hpp"
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -93,6 +94,7 @@ InputFile::InputFile(InputFile &&other) noexcept
       path_(std::move(other.path_)),
       file_size_(other.file_size_),
       file_position_(other.file_position_),
+      mapping_(other.mapping_),
       buffer_start_(other.buffer_start_),
       buffer_size_(other.buffer_size_),
       buffer_position_(other.buffer_position_) {
@@ -100,6 +102,7 @@ InputFile::InputFile(InputFile &&other) noexcept
   other.fd_ = -1;
   other.file_size_ = 0;
   other.file_position_ = 0;
+  other.mapping_ = nullptr;
   other.buffer_start_ = std::nullopt;
   other.buffer_size_ = 0;
   other.buffer_position_ = 0;
@@ -112,6 +115,7 @@ InputFile &InputFile::operator=(InputFile &&other) noexcept {
   path_ = std::move(other.path_);
   file_size_ = other.file_size_;
   file_position_ = other.file_position_;
+  mapping_ = other.mapping_;
   buffer_start_ = other.buffer_start_;
   buffer_size_ = other.buffer_size_;
   buffer_position_ = other.buffer_position_;
@@ -120,6 +124,7 @@ InputFile &InputFile::operator=(InputFile &&other) noexcept {
   other.fd_ = -1;
   other.file_size_ = 0;
   other.file_position_ = 0;
+  other.mapping_ = nullptr;
   other.buffer_start_ = std::nullopt;
   other.buffer_size_ = 0;
   other.buffer_position_ = 0;
@@ -127,7 +132,7 @@ InputFile &InputFile::operator=(InputFile &&other) noexcept {
   return *this;
 }
 
-bool InputFile::Open(const std::filesystem::path &path) {
+bool InputFile::Open(const std::filesystem::path &path, bool memory_mapped) {
   if (IsOpen()) return false;
 
   path_ = path;
@@ -154,6 +159,18 @@ bool InputFile::Open(const std::filesystem::path &path) {
   }
   file_size_ = *size;
 
+  if (memory_mapped && file_size_ > 0) {
+    auto *mapping = mmap(nullptr, file_size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (mapping == MAP_FAILED) {
+      Close();
+      return false;
+    }
+    // The files are mostly read front to back, so the kernel can read ahead
+    // aggressively and drop the pages that were already read.
+    madvise(mapping, file_size_, MADV_SEQUENTIAL);
+    mapping_ = static_cast<const uint8_t *>(mapping);
+  }
+
   return true;
 }
 
@@ -162,6 +179,13 @@ bool InputFile::IsOpen() const { return fd_ != -1; }
 const std::filesystem::path &InputFile::path() const { return path_; }
 
 bool InputFile::Read(uint8_t *data, size_t size) {
+  if (mapping_) {
+    if (file_position_ > file_size_ || size > file_size_ - file_position_) return false;
+    memcpy(data, mapping_ + file_position_, size);
+    file_position_ += size;
+    return true;
+  }
+
   size_t offset = 0;
 
   while (size > 0) {
@@ -181,6 +205,12 @@ bool InputFile::Read(uint8_t *data, size_t size) {
 }
 
 bool InputFile::Peek(uint8_t *data, size_t size) {
+  if (mapping_) {
+    if (file_position_ > file_size_ || size > file_size_ - file_position_) return false;
+    memcpy(data, mapping_ + file_position_, size);
+    return true;
+  }
+
   auto old_buffer_start = buffer_start_;
   auto old_buffer_position = buffer_position_;
   auto real_position = GetPosition();
@@ -207,6 +237,25 @@ size_t InputFile::GetPosition() {
 }
 
 std::optional<size_t> InputFile::SetPosition(Position position, ssize_t offset) {
+  if (mapping_) {
+    ssize_t base = 0;
+    switch (position) {
+      case Position::SET:
+        break;
+      case Position::RELATIVE_TO_CURRENT:
+        base = static_cast<ssize_t>(file_position_);
+        break;
+      case Position::RELATIVE_TO_END:
+        base = static_cast<ssize_t>(file_size_);
+        break;
+    }
+    // Like `lseek`, positions past the end of the file are allowed, reading
+    // from them fails.
+    if (base + offset < 0) return std::nullopt;
+    file_position_ = base + offset;
+    return file_position_;
+  }
+
   int whence;
   switch (position) {
     case Position::SET:
@@ -236,6 +285,11 @@ std::optional<size_t> InputFile::SetPosition(Position position, ssize_t offset)
 void InputFile::Close() noexcept {
   if (!IsOpen()) return;
 
+  if (mapping_) {
+    munmap(const_cast<uint8_t *>(mapping_), file_size_);
+    mapping_ = nullptr;
+  }
+
   int ret = 0;
   while (true) {
     ret = close(fd_);
@@ -295,10 +349,16 @@ OutputFile::~OutputFile() {
 }
 
 OutputFile::OutputFile(OutputFile &&other) noexcept
-    : fd_(other.fd_), written_since_last_sync_(other.written_since_last_sync_), path_(std::move(other.path_)) {
+    : fd_(other.fd_),
+      writeback_(other.writeback_),
+      rate_limiter_(other.rate_limiter_),
+      written_since_last_sync_(other.written_since_last_sync_),
+      path_(std::move(other.path_)) {
   memcpy(buffer_, other.buffer_, kFileBufferSize);
   buffer_position_.store(other.buffer_position_.load());
   other.fd_ = -1;
+  other.writeback_ = false;
+  other.rate_limiter_ = nullptr;
   other.written_since_last_sync_ = 0;
   other.buffer_position_ = 0;
 }
@@ -307,12 +367,16 @@ OutputFile &OutputFile::operator=(OutputFile &&other) noexcept {
   if (IsOpen()) Close();
 
   fd_ = other.fd_;
+  writeback_ = other.writeback_;
+  rate_limiter_ = other.rate_limiter_;
   written_since_last_sync_ = other.written_since_last_sync_;
   path_ = std::move(other.path_);
   buffer_position_ = other.buffer_position_.load();
   memcpy(buffer_, other.buffer_, kFileBufferSize);
 
   other.fd_ = -1;
+  other.writeback_ = false;
+  other.rate_limiter_ = nullptr;
   other.written_since_last_sync_ = 0;
   other.buffer_position_ = 0;
 
@@ -325,6 +389,8 @@ void OutputFile::Open(const std::filesystem::path &path, Mode mode) {
             " used a handle that already has {} opened in it!",
             path, path_);
   path_ = path;
+  writeback_ = false;
+  rate_limiter_ = nullptr;
   written_since_last_sync_ = 0;
 
   int flags = O_WRONLY | O_CLOEXEC | O_CREAT;
@@ -475,6 +541,53 @@ void OutputFile::Sync() {
   written_since_last_sync_ = 0;
 }
 
+bool OutputFile::Preallocate(size_t size) {
+  MG_ASSERT(IsOpen(), "Trying to preallocate an unopened file!");
+  int ret = 0;
+  while (true) {
+    ret = fallocate(fd_, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(size));
+    if (ret == -1 && errno == EINTR) {
+      // The call was interrupted, try again...
+      continue;
+    }
+    break;
+  }
+  // The preallocation is only an optimization, the file works without it.
+  return ret == 0;
+}
+
+void OutputFile::EnableWriteback() {
+  MG_ASSERT(IsOpen(), "Trying to enable writeback of an unopened file!");
+  writeback_ = true;
+}
+
+void OutputFile::SetRateLimiter(RateLimiter *rate_limiter) { rate_limiter_ = rate_limiter; }
+
+int OutputFile::FlushAndDuplicateDescriptor() {
+  FlushBuffer(true);
+  int fd = dup(fd_);
+  MG_ASSERT(fd != -1, "While trying to duplicate the descriptor of {} an error occurred: {} ({})", path_,
+            strerror(errno), errno);
+  return fd;
+}
+
+void OutputFile::SyncDescriptor(int fd) {
+  int ret = 0;
+  while (true) {
+    // The file size is the only metadata needed to read the data back and
+    // `fdatasync` syncs it as well.
+    ret = fdatasync(fd);
+    if (ret == -1 && errno == EINTR) {
+      // The call was interrupted, try again...
+      continue;
+    }
+    break;
+  }
+  // Any error except EINTR is fatal for the same reasons as in `Sync`.
+  MG_ASSERT(ret == 0, "While trying to sync a file, an error occurred: {} ({}).", strerror(errno), errno);
+  close(fd);
+}
+
 void OutputFile::Close() noexcept {
   FlushBuffer(true);
 
@@ -497,6 +610,8 @@ void OutputFile::Close() noexcept {
             path_, strerror(errno), errno, written_since_last_sync_);
 
   fd_ = -1;
+  writeback_ = false;
+  rate_limiter_ = nullptr;
   written_since_last_sync_ = 0;
   path_ = "";
 }
@@ -518,6 +633,7 @@ void OutputFile::FlushBufferInternal() {
 
   auto *buffer = buffer_;
   auto buffer_position = buffer_position_.load();
+  if (rate_limiter_ && buffer_position > 0) rate_limiter_->Acquire(buffer_position);
   while (buffer_position > 0) {
     auto written = write(fd_, buffer, buffer_position_);
     if (written == -1 && errno == EINTR) {
@@ -533,8 +649,15 @@ void OutputFile::FlushBufferInternal() {
     buffer_position -= written;
     buffer += written;
   }
+  const bool flushed = buffer != buffer_;
 
   buffer_position_.store(buffer_position);
+
+  if (writeback_ && flushed) {
+    // Only starts the writeback of the dirty pages, errors are reported by
+    // the next sync.
+    sync_file_range(fd_, 0, 0, SYNC_FILE_RANGE_WRITE);
+  }
 }
 
 void OutputFile::DisableFlushing() { flush_lock_.lock_shared(); }
@@ -24,6 +24,7 @@
 #include <string_view>
 #include <vector>
 
+#include "utils/rate_limiter.hpp"
 #include "utils/rw_lock.hpp"
 
 namespace memgraph::utils {
@@ -97,8 +98,11 @@ class InputFile {
   InputFile &operator=(InputFile &&other) noexcept;
 
   /// This method opens the file used for reading. If the file can't be opened
-  /// or doesn't exist it returns `false`.
-  bool Open(const std::filesystem::path &path);
+  /// or doesn't exist it returns `false`. When `memory_mapped` is set the whole
+  /// file is mapped into memory and the reads are served from the mapping
+  /// instead of the internal buffer. The file mustn't be modified while it's
+  /// mapped.
+  bool Open(const std::filesystem::path &path, bool memory_mapped = false);
 
   /// Returns a boolean indicating whether a file is opened.
   bool IsOpen() const;
@@ -120,6 +124,10 @@ class InputFile {
   /// This method gets the size of the file.
   size_t GetSize();
 
+  /// Returns the file descriptor of the opened file, which can be used to read
+  /// the file data without the internal buffer, e.g. with `sendfile`.
+  int fd() const { return fd_; }
+
   /// This method gets the current absolute position in the file.
   size_t GetPosition();
 
@@ -140,6 +148,10 @@ class InputFile {
   size_t file_size_{0};
   size_t file_position_{0};
 
+  // Set when the file is memory mapped, `file_position_` is then the only
+  // position that is used.
+  const uint8_t *mapping_{nullptr};
+
   uint8_t buffer_[kFileBufferSize];
   std::optional<size_t> buffer_start_;
   size_t buffer_size_{0};
@@ -235,6 +247,31 @@ class OutputFile {
   /// and misuse it crashes the program.
   void Sync();
 
+  /// Reserves disk space for the first `size` bytes of the file without
+  /// changing its size, so that later writes and syncs don't have to allocate
+  /// blocks. Returns `false` if the file system doesn't support it.
+  bool Preallocate(size_t size);
+
+  /// Starts writing the data back to the disk asynchronously every time the
+  /// internal buffer is written to the file. The data isn't durable until the
+  /// file is synced, but the sync has less work left.
+  void EnableWriteback();
+
+  /// Every write of the internal buffer to the file first acquires its size
+  /// from `rate_limiter`. The limiter must outlive the use of the file.
+  void SetRateLimiter(RateLimiter *rate_limiter);
+
+  /// Writes the internal buffer to the currently opened file and returns a
+  /// duplicate of its file descriptor. The data written up to this point can
+  /// then be synced with `SyncDescriptor` without accessing this object, even
+  /// after the file is closed. On failure and misuse it crashes the program.
+  int FlushAndDuplicateDescriptor();
+
+  /// Syncs the file behind a descriptor returned by
+  /// `FlushAndDuplicateDescriptor` and closes the descriptor. On failure it
+  /// crashes the program.
+  static void SyncDescriptor(int fd);
+
   /// Closes the currently opened file. It doesn't perform a `Sync` on the
   /// file. On failure and misuse it crashes the program.
   void Close() noexcept;
@@ -263,6 +300,8 @@ class OutputFile {
   size_t SeekFile(Position position, ssize_t offset);
 
   int fd_{-1};
+  bool writeback_{false};
+  RateLimiter *rate_limiter_{nullptr};
   size_t written_since_last_sync_{0};
   std::filesystem::path path_;
   uint8_t buffer_[kFileBufferSize];
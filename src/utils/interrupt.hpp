@@ -0,0 +1,31 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace memgraph::utils {
+
+/// Number of the times an execution was asked to stop, by its timer expiring,
+/// its transaction being terminated or the database shutting down. The
+/// executions check whether they have to stop only when the epoch changes, so
+/// checking it costs a single load as long as nothing is interrupted.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+inline std::atomic<uint64_t> interrupt_epoch{0};
+
+/// Advances the interrupt epoch, after the cause of the interrupt is visible.
+inline void NotifyInterrupt() noexcept { interrupt_epoch.fetch_add(1, std::memory_order_release); }
+
+inline uint64_t InterruptEpoch() noexcept { return interrupt_epoch.load(std::memory_order_acquire); }
+
+}  // namespace memgraph::utils
@@ -55,6 +55,7 @@ MonotonicBufferResource::MonotonicBufferResource(MonotonicBufferResource &&other
       next_buffer_size_(other.next_buffer_size_),
       allocated_(other.allocated_) {
   other.current_buffer_ = nullptr;
+  other.initial_buffer_ = nullptr;
 }
 
 MonotonicBufferResource &MonotonicBufferResource::operator=(MonotonicBufferResource &&other) noexcept {
@@ -67,6 +68,7 @@ MonotonicBufferResource &MonotonicBufferResource::operator=(MonotonicBufferResou
   next_buffer_size_ = other.next_buffer_size_;
   allocated_ = other.allocated_;
   other.current_buffer_ = nullptr;
+  other.initial_buffer_ = nullptr;
   other.allocated_ = 0U;
   return *this;
 }
@@ -140,8 +142,55 @@ void *MonotonicBufferResource::DoAllocate(size_t bytes, size_t alignment) {
   return aligned_ptr;
 }
 
+size_t MonotonicBufferResource::GetFootprint() const {
+  size_t footprint = initial_buffer_ ? initial_size_ : 0U;
+  for (const auto *b = current_buffer_; b; b = b->next) footprint += b->capacity;
+  return footprint;
+}
+
 // MonotonicBufferResource END
 
+// MonotonicBufferCache
+
+MonotonicBufferCache::MonotonicBufferCache(size_t min_size, size_t max_size, MemoryResource *memory)
+    : memory_(memory), min_size_(min_size), max_size_(std::max(min_size, max_size)) {}
+
+MonotonicBufferCache::~MonotonicBufferCache() {
+  MG_ASSERT(!in_use_, "MonotonicBufferCache destroyed while its buffer is in use");
+  if (buffer_) memory_->Deallocate(buffer_, size_);
+}
+
+MonotonicBufferResource MonotonicBufferCache::Acquire(MemoryResource *upstream) {
+  if (in_use_) return MonotonicBufferResource(min_size_, upstream);
+  if (!buffer_) {
+    size_ = std::clamp(high_water_mark_, min_size_, max_size_);
+    buffer_ = memory_->Allocate(size_);
+  }
+  in_use_ = true;
+  return MonotonicBufferResource(buffer_, size_, upstream);
+}
+
+void MonotonicBufferCache::Recycle(MonotonicBufferResource *resource) {
+  if (!in_use_ || !buffer_ || resource->initial_buffer_ != buffer_) {
+    resource->Release();
+    return;
+  }
+  high_water_mark_ = std::max(resource->GetFootprint(), high_water_mark_ - high_water_mark_ / kDecay);
+  resource->Release();
+  resource->initial_buffer_ = nullptr;
+  in_use_ = false;
+
+  // The buffer is allocated again with the new size on the next use if the
+  // resources outgrew it or use much less of it.
+  const auto size = std::clamp(high_water_mark_, min_size_, max_size_);
+  if (size > size_ || size < size_ / 4) {
+    memory_->Deallocate(buffer_, size_);
+    buffer_ = nullptr;
+  }
+}
+
+// MonotonicBufferCache END
+
 // PoolResource
 //
 // Implementation is partially based on "Small Object Allocation" implementation
@@ -355,4 +404,81 @@ void PoolResource::Release() {
 
 // PoolResource END
 
+// ConcurrentPoolResource
+
+ConcurrentPoolResource::ConcurrentPoolResource(size_t max_block_size, MemoryResource *memory)
+    : memory_(memory),
+      max_block_size_(Ceil2(std::clamp(max_block_size, kMinBlockSize, kMaxBlockSize))),
+      slots_(std::make_unique<std::array<ThreadSlot, kThreadSlots>>()) {}
+
+void ConcurrentPoolResource::Refill(FreeList *free_list, size_t size_class) {
+  std::lock_guard<SpinLock> guard(lock_);
+  auto &shared_list = free_lists_[size_class];
+  if (!shared_list.head) {
+    const auto block_size = ClassBlockSize(size_class);
+    const auto chunk_size = std::max(kChunkSize, block_size * kBatchSize);
+    chunks_.reserve(chunks_.size() + 1);
+    auto *chunk = static_cast<char *>(memory_->Allocate(chunk_size, block_size));
+    chunks_.push_back({chunk, chunk_size, block_size});
+    for (size_t offset = chunk_size; offset > 0; offset -= block_size) shared_list.Push(chunk + offset - block_size);
+  }
+  shared_list.MoveTo(free_list, kBatchSize);
+}
+
+void *ConcurrentPoolResource::DoAllocate(size_t bytes, size_t alignment) {
+  const size_t block_size = std::max(bytes, alignment);
+  if (block_size > max_block_size_) {
+    std::lock_guard<SpinLock> guard(lock_);
+    unpooled_.reserve(unpooled_.size() + 1);
+    Block big_block{memory_->Allocate(bytes, alignment), bytes, alignment};
+    auto it = std::lower_bound(unpooled_.begin(), unpooled_.end(), big_block,
+                               [](const auto &a, const auto &b) { return a.data < b.data; });
+    unpooled_.insert(it, big_block);
+    return big_block.data;
+  }
+  const auto size_class = SizeClass(block_size);
+  auto &slot = (*slots_)[ThreadSlotIndex()];
+  std::lock_guard<SpinLock> guard(slot.lock);
+  auto &free_list = slot.free_lists[size_class];
+  if (!free_list.head) Refill(&free_list, size_class);
+  return free_list.Pop();
+}
+
+void ConcurrentPoolResource::DoDeallocate(void *p, size_t bytes, size_t alignment) {
+  const size_t block_size = std::max(bytes, alignment);
+  if (block_size > max_block_size_) {
+    std::lock_guard<SpinLock> guard(lock_);
+    Block big_block{p, bytes, alignment};
+    auto it = std::lower_bound(unpooled_.begin(), unpooled_.end(), big_block,
+                               [](const auto &a, const auto &b) { return a.data < b.data; });
+    MG_ASSERT(it != unpooled_.end(), "Failed deallocation");
+    MG_ASSERT(it->data == p && it->bytes == bytes && it->alignment == alignment, "Failed deallocation");
+    unpooled_.erase(it);
+    memory_->Deallocate(p, bytes, alignment);
+    return;
+  }
+  const auto size_class = SizeClass(block_size);
+  auto &slot = (*slots_)[ThreadSlotIndex()];
+  std::lock_guard<SpinLock> guard(slot.lock);
+  auto &free_list = slot.free_lists[size_class];
+  free_list.Push(p);
+  // Give the blocks back once the slot holds more than two batches, e.g. when
+  // the thread deallocates what the others allocated.
+  if (free_list.size > 2 * kBatchSize) {
+    std::lock_guard<SpinLock> shared_guard(lock_);
+    free_list.MoveTo(&free_lists_[size_class], kBatchSize);
+  }
+}
+
+void ConcurrentPoolResource::Release() {
+  for (auto &slot : *slots_) slot.free_lists = {};
+  free_lists_ = {};
+  for (const auto &chunk : chunks_) memory_->Deallocate(chunk.data, chunk.bytes, chunk.alignment);
+  chunks_.clear();
+  for (const auto &big_block : unpooled_) memory_->Deallocate(big_block.data, big_block.bytes, big_block.alignment);
+  unpooled_.clear();
+}
+
+// ConcurrentPoolResource END
+
 }  // namespace memgraph::utils
@@ -15,6 +15,8 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <memory>
 #include <mutex>
@@ -348,7 +350,13 @@ class MonotonicBufferResource final : public MemoryResource {
 
   MemoryResource *GetUpstreamResource() const { return memory_; }
 
+  /// Returns the size of all buffers the resource allocates from, including the
+  /// initial buffer.
+  size_t GetFootprint() const;
+
  private:
+  friend class MonotonicBufferCache;
+
   struct Buffer {
     Buffer *next;
     size_t capacity;
@@ -378,6 +386,51 @@ class MonotonicBufferResource final : public MemoryResource {
   bool DoIsEqual(const MemoryResource &other) const noexcept override { return this == &other; }
 };
 
+/// Initial buffer which consecutive `MonotonicBufferResource`s reuse, like the
+/// ones of the queries of a session, so that the resources don't allocate
+/// from upstream when what they allocate fits into the buffer.
+///
+/// The buffer is sized to the high-water mark of the footprints of the
+/// resources which used it, which decays with each use so that the buffer
+/// shrinks again after a few large queries. It's kept between `min_size` and
+/// `max_size` and allocated from `memory`.
+///
+/// MonotonicBufferCache is not thread-safe!
+class MonotonicBufferCache final {
+ public:
+  MonotonicBufferCache(size_t min_size, size_t max_size, MemoryResource *memory = NewDeleteResource());
+
+  MonotonicBufferCache(const MonotonicBufferCache &) = delete;
+  MonotonicBufferCache &operator=(const MonotonicBufferCache &) = delete;
+  MonotonicBufferCache(MonotonicBufferCache &&) = delete;
+  MonotonicBufferCache &operator=(MonotonicBufferCache &&) = delete;
+
+  ~MonotonicBufferCache();
+
+  /// Returns a resource with the cached buffer as its initial buffer, or a
+  /// resource with `min_size` large buffers if another resource is using the
+  /// cached buffer. Additional buffers are allocated from `upstream`.
+  MonotonicBufferResource Acquire(MemoryResource *upstream);
+
+  /// Releases the memory of the resource and takes the cached buffer back if
+  /// the resource was using it.
+  void Recycle(MonotonicBufferResource *resource);
+
+  size_t GetBufferSize() const { return size_; }
+
+ private:
+  // The high-water mark decays by 1/kDecay on each use.
+  static constexpr size_t kDecay = 8;
+
+  MemoryResource *memory_;
+  size_t min_size_;
+  size_t max_size_;
+  void *buffer_{nullptr};
+  size_t size_{0};
+  size_t high_water_mark_{0};
+  bool in_use_{false};
+};
+
 namespace impl {
 
 template <class T>
@@ -539,6 +592,125 @@ class SynchronizedPoolResource final : public MemoryResource {
   bool DoIsEqual(const MemoryResource &other) const noexcept override { return this == &other; }
 };
 
+/// MemoryResource which serves allocation requests for different block sizes
+/// from multiple threads at the same time, e.g. from the workers of a
+/// parallel operator which share the memory of a query.
+///
+/// This class has the following properties with regards to memory management.
+///
+///   * Requests are served from power of 2 size classes up to
+///     `max_block_size`, which is rounded up to a power of 2 and at most
+///     kMaxBlockSize. Blocks are aligned to their size, so any alignment up to
+///     the block size is supported.
+///   * Each thread allocates from and deallocates to the free lists of its
+///     slot, which are only locked by the threads sharing the slot.
+///   * A slot refills its free lists from the shared free lists in batches,
+///     and gives the blocks back to them when it holds too many, so that the
+///     blocks deallocated on one thread can be used by the others.
+///   * The shared free lists are filled by chunks allocated from the upstream
+///     `memory`. Requests exceeding the maximum block size are forwarded to
+///     upstream. The upstream is only used under a lock, so it doesn't need
+///     to be thread-safe.
+///   * All allocated memory will be freed upon destruction, even if Deallocate
+///     has not been called for some of the allocated blocks.
+class ConcurrentPoolResource final : public MemoryResource {
+ public:
+  static constexpr size_t kMaxBlockSize = 4096;
+
+  explicit ConcurrentPoolResource(size_t max_block_size, MemoryResource *memory = NewDeleteResource());
+
+  ConcurrentPoolResource(const ConcurrentPoolResource &) = delete;
+  ConcurrentPoolResource &operator=(const ConcurrentPoolResource &) = delete;
+  ConcurrentPoolResource(ConcurrentPoolResource &&) = delete;
+  ConcurrentPoolResource &operator=(ConcurrentPoolResource &&) = delete;
+
+  ~ConcurrentPoolResource() override { Release(); }
+
+  MemoryResource *GetUpstreamResource() const { return memory_; }
+
+  /// Release all allocated memory. Must not be called while other threads use
+  /// the resource.
+  void Release();
+
+ private:
+  static constexpr size_t kMinBlockSize = 8;
+  static constexpr size_t kSizeClasses = Log2(kMaxBlockSize) - Log2(kMinBlockSize) + 1;
+  static constexpr size_t kThreadSlots = 32;
+  // Number of blocks moved between a slot and the shared free lists at once.
+  static constexpr size_t kBatchSize = 32;
+  static constexpr size_t kChunkSize = 64UL * 1024UL;
+
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  struct FreeList {
+    FreeBlock *head{nullptr};
+    size_t size{0};
+
+    void Push(void *block) {
+      head = new (block) FreeBlock{head};
+      ++size;
+    }
+
+    void *Pop() {
+      auto *block = head;
+      head = block->next;
+      --size;
+      return block;
+    }
+
+    // Moves up to `count` blocks from this list to `other`.
+    void MoveTo(FreeList *other, size_t count) {
+      for (; count > 0 && head; --count) other->Push(Pop());
+    }
+  };
+
+  struct alignas(64) ThreadSlot {
+    SpinLock lock;
+    std::array<FreeList, kSizeClasses> free_lists;
+  };
+
+  struct Block {
+    void *data;
+    size_t bytes;
+    size_t alignment;
+  };
+
+  static size_t ThreadSlotIndex() {
+    thread_local const size_t slot = next_slot_.fetch_add(1, std::memory_order_relaxed) % kThreadSlots;
+    return slot;
+  }
+
+  static size_t SizeClass(size_t block_size) {
+    return Log2(Ceil2(std::max(block_size, kMinBlockSize))) - Log2(kMinBlockSize);
+  }
+
+  static size_t ClassBlockSize(size_t size_class) { return kMinBlockSize << size_class; }
+
+  // Moves a batch of blocks of the size class from the shared free lists to
+  // `free_list`, allocating a new chunk if they are empty.
+  void Refill(FreeList *free_list, size_t size_class);
+
+  void *DoAllocate(size_t bytes, size_t alignment) override;
+
+  void DoDeallocate(void *p, size_t bytes, size_t alignment) override;
+
+  bool DoIsEqual(const MemoryResource &other) const noexcept override { return this == &other; }
+
+  MemoryResource *memory_;
+  size_t max_block_size_;
+  std::unique_ptr<std::array<ThreadSlot, kThreadSlots>> slots_;
+  // Protects the members below.
+  SpinLock lock_;
+  std::array<FreeList, kSizeClasses> free_lists_;
+  std::vector<Block> chunks_;
+  // Blocks larger than the max block size, sorted by the data pointer.
+  std::vector<Block> unpooled_;
+
+  inline static std::atomic<size_t> next_slot_{0};
+};
+
 class LimitedMemoryResource final : public utils::MemoryResource {
  public:
   explicit LimitedMemoryResource(utils::MemoryResource *memory, size_t max_allocated_bytes)
@@ -587,4 +759,41 @@ class ResourceWithOutOfMemoryException : public MemoryResource {
 
   MemoryResource *upstream_{utils::NewDeleteResource()};
 };
+
+// Counts the memory allocated from the upstream resource in a
+// `MemoryTracker`, which throws an OutOfMemoryException when the allocation
+// puts the tracked amount over its hard limit and the exception is enabled.
+// The memory isn't also added to the tracker of the thread's scope.
+class TrackedMemoryResource final : public MemoryResource {
+ public:
+  explicit TrackedMemoryResource(MemoryTracker *tracker, MemoryResource *upstream = NewDeleteResource())
+      : tracker_(tracker), upstream_(upstream) {}
+
+  MemoryTracker *GetTracker() const noexcept { return tracker_; }
+
+ private:
+  void *DoAllocate(size_t bytes, size_t alignment) override {
+    tracker_->Alloc(static_cast<int64_t>(bytes));
+    try {
+      const MemoryTracker::ThreadScope untracked{nullptr};
+      return upstream_->Allocate(bytes, alignment);
+    } catch (...) {
+      tracker_->Free(static_cast<int64_t>(bytes));
+      throw;
+    }
+  }
+
+  void DoDeallocate(void *p, size_t bytes, size_t alignment) override {
+    {
+      const MemoryTracker::ThreadScope untracked{nullptr};
+      upstream_->Deallocate(p, bytes, alignment);
+    }
+    tracker_->Free(static_cast<int64_t>(bytes));
+  }
+
+  bool DoIsEqual(const MemoryResource &other) const noexcept override { return this == &other; }
+
+  MemoryTracker *tracker_;
+  MemoryResource *upstream_;
+};
 }  // namespace memgraph::utils
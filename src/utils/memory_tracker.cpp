@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -14,6 +14,7 @@
 #include <atomic>
 #include <exception>
 #include <stdexcept>
+#include <utility>
 
 #include "utils/likely.hpp"
 #include "utils/logging.hpp"
@@ -42,6 +43,58 @@ MemoryTracker::OutOfMemoryExceptionBlocker::OutOfMemoryExceptionBlocker() { ++co
 MemoryTracker::OutOfMemoryExceptionBlocker::~OutOfMemoryExceptionBlocker() { --counter_; }
 bool MemoryTracker::OutOfMemoryExceptionBlocker::IsBlocked() { return counter_ > 0; }
 
+thread_local MemoryTracker *MemoryTracker::ThreadScope::tracker_ = nullptr;
+thread_local int64_t MemoryTracker::ThreadScope::pending_ = 0;
+
+MemoryTracker::ThreadScope::ThreadScope(MemoryTracker *tracker) : previous_(tracker_) {
+  Flush();
+  tracker_ = tracker;
+}
+
+MemoryTracker::ThreadScope::~ThreadScope() {
+  Flush();
+  tracker_ = previous_;
+}
+
+void MemoryTracker::ThreadScope::Alloc(const int64_t size) {
+  if (!tracker_) return;
+  pending_ += size;
+  if (pending_ < kBatchSize) [[likely]] {
+    return;
+  }
+  // The pending amount is taken first, so that allocations made while the tracker throws are counted again.
+  const auto pending = std::exchange(pending_, 0);
+  try {
+    tracker_->Alloc(pending);
+  } catch (...) {
+    pending_ += pending - size;
+    throw;
+  }
+}
+
+void MemoryTracker::ThreadScope::Free(const int64_t size) noexcept {
+  if (!tracker_) return;
+  pending_ -= size;
+  if (pending_ > -kBatchSize) [[likely]] {
+    return;
+  }
+  tracker_->Free(-std::exchange(pending_, 0));
+}
+
+void MemoryTracker::ThreadScope::Flush() noexcept {
+  const auto pending = std::exchange(pending_, 0);
+  if (!tracker_ || pending == 0) return;
+  if (pending < 0) {
+    tracker_->Free(-pending);
+    return;
+  }
+  try {
+    MemoryTracker::OutOfMemoryExceptionBlocker exception_blocker;
+    tracker_->Alloc(pending);
+  } catch (...) {
+  }
+}
+
 MemoryTracker total_memory_tracker;
 
 // TODO (antonio2368): Define how should the peak memory be logged.
@@ -97,6 +150,17 @@ void MemoryTracker::SetMaximumHardLimit(const int64_t limit) {
   maximum_hard_limit_ = limit;
 }
 
+MemoryTracker::~MemoryTracker() {
+  if (parent_) parent_->Free(Amount());
+}
+
+void MemoryTracker::Reset() {
+  if (ThreadScope::tracker_ == this) ThreadScope::pending_ = 0;
+  const auto amount = amount_.exchange(0, std::memory_order_relaxed);
+  if (parent_) parent_->Free(amount);
+  peak_.store(0, std::memory_order_relaxed);
+}
+
 void MemoryTracker::Alloc(const int64_t size) {
   MG_ASSERT(size >= 0, "Negative size passed to the MemoryTracker.");
 
@@ -115,9 +179,21 @@ void MemoryTracker::Alloc(const int64_t size) {
                     GetReadableSize(size), GetReadableSize(will_be), GetReadableSize(current_hard_limit)));
   }
 
+  if (parent_) {
+    try {
+      parent_->Alloc(size);
+    } catch (...) {
+      amount_.fetch_sub(size, std::memory_order_relaxed);
+      throw;
+    }
+  }
+
   UpdatePeak(will_be);
 }
 
-void MemoryTracker::Free(const int64_t size) { amount_.fetch_sub(size, std::memory_order_relaxed); }
+void MemoryTracker::Free(const int64_t size) {
+  amount_.fetch_sub(size, std::memory_order_relaxed);
+  if (parent_) parent_->Free(size);
+}
 
 }  // namespace memgraph::utils
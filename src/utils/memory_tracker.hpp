@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -29,6 +29,9 @@ class MemoryTracker final {
   std::atomic<int64_t> hard_limit_{0};
   // Maximum possible value of a hard limit. If it's set to 0, no upper bound on the hard limit is set.
   int64_t maximum_hard_limit_{0};
+  // Tracker to which every allocation is also added, e.g. the tracker of the database for the tracker of a
+  // transaction. An allocation over the limit of any of the trackers fails.
+  MemoryTracker *parent_{nullptr};
 
   void UpdatePeak(int64_t will_be);
 
@@ -38,7 +41,9 @@ class MemoryTracker final {
   void LogPeakMemoryUsage() const;
 
   MemoryTracker() = default;
-  ~MemoryTracker() = default;
+  explicit MemoryTracker(MemoryTracker *parent) : parent_(parent) {}
+  // Frees the amount which is still tracked from the parents.
+  ~MemoryTracker();
 
   MemoryTracker(const MemoryTracker &) = delete;
   MemoryTracker &operator=(const MemoryTracker &) = delete;
@@ -58,6 +63,40 @@ class MemoryTracker final {
   void TryRaiseHardLimit(int64_t limit);
   void SetMaximumHardLimit(int64_t limit);
 
+  // Frees the tracked amount from the parents and resets the amount and the peak, which is done when the
+  // tracked work, like a transaction, finishes.
+  void Reset();
+
+  // By creating an object of this class, the allocations the thread makes with `new` in its scope are added to
+  // the tracker, or aren't added to any tracker if it's null. The allocations are summed in a thread-local
+  // counter and added to the tracker in batches, so that allocations on the thread don't touch the atomics of
+  // the tracker. The tracker throws for a whole batch if it goes over the hard limit.
+  class ThreadScope final {
+   public:
+    ThreadScope(const ThreadScope &) = delete;
+    ThreadScope &operator=(const ThreadScope &) = delete;
+    ThreadScope(ThreadScope &&) = delete;
+    ThreadScope &operator=(ThreadScope &&) = delete;
+
+    explicit ThreadScope(MemoryTracker *tracker);
+    ~ThreadScope();
+
+    static void Alloc(int64_t size);
+    static void Free(int64_t size) noexcept;
+
+   private:
+    friend class MemoryTracker;
+
+    static constexpr int64_t kBatchSize = 64L * 1024L;
+
+    static void Flush() noexcept;
+
+    MemoryTracker *previous_;
+
+    static thread_local MemoryTracker *tracker_;
+    static thread_local int64_t pending_;
+  };
+
   // By creating an object of this class, every allocation in its scope that goes over
   // the set hard limit produces an OutOfMemoryException.
   class OutOfMemoryExceptionEnabler final {
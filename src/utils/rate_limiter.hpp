@@ -0,0 +1,52 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace memgraph::utils {
+
+/// Limits the rate at which some amount (e.g. written bytes) is consumed to
+/// `rate` units per second. `Acquire` blocks the calling thread until the
+/// previously acquired amounts fit into the budget. A rate of `0` disables the
+/// limit. This class is threadsafe.
+class RateLimiter {
+ public:
+  explicit RateLimiter(uint64_t rate) : rate_(rate) {}
+
+  void Acquire(uint64_t amount) {
+    if (rate_ == 0) return;
+    const auto cost = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(static_cast<double>(amount) / static_cast<double>(rate_)));
+    const auto now = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point start;
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      // Unused budget isn't accumulated, so there are no bursts after idle
+      // periods.
+      start = std::max(next_free_, now);
+      next_free_ = start + cost;
+    }
+    if (start > now) std::this_thread::sleep_until(start);
+  }
+
+ private:
+  uint64_t rate_;
+  std::mutex lock_;
+  std::chrono::steady_clock::time_point next_free_{};
+};
+
+}  // namespace memgraph::utils
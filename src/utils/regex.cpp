@@ -0,0 +1,121 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "utils/regex.hpp"
+
+#include <cctype>
+
+namespace memgraph::utils {
+
+namespace {
+constexpr std::string_view kAnyString = ".*";
+
+// Reads the literal character at `*pos` of `pattern` and moves `*pos` past
+// it. Returns nullopt if the pattern has a special meaning there.
+std::optional<char> ReadLiteral(std::string_view pattern, size_t *pos) {
+  constexpr std::string_view kSpecial = "^$\\.*+?()[]{}|";
+  const char c = pattern[*pos];
+  if (c == '\\') {
+    if (*pos + 1 == pattern.size()) return std::nullopt;
+    const char escaped = pattern[*pos + 1];
+    // The escaped letters and digits are classes, references or control
+    // characters.
+    if (std::isalnum(static_cast<unsigned char>(escaped))) return std::nullopt;
+    *pos += 2;
+    return escaped;
+  }
+  if (kSpecial.find(c) != std::string_view::npos) return std::nullopt;
+  ++*pos;
+  return c;
+}
+
+bool IsQuantifier(char c) { return c == '*' || c == '+' || c == '?' || c == '{'; }
+}  // namespace
+
+Regex::Regex(const std::string_view pattern)
+    : regex_(pattern.begin(), pattern.end(), std::regex::ECMAScript | std::regex::optimize) {
+  size_t pos = 0;
+  const bool any_prefix = pattern.starts_with(kAnyString);
+  if (any_prefix) pos = kAnyString.size();
+  bool any_suffix = false;
+  std::string literal;
+  while (pos < pattern.size()) {
+    if (pattern.substr(pos) == kAnyString) {
+      any_suffix = true;
+      break;
+    }
+    auto c = ReadLiteral(pattern, &pos);
+    if (!c) return;
+    literal.push_back(*c);
+  }
+  literal_ = std::move(literal);
+  if (any_prefix && any_suffix) {
+    kind_ = Kind::CONTAINS;
+  } else if (any_prefix) {
+    kind_ = Kind::SUFFIX;
+  } else if (any_suffix) {
+    kind_ = Kind::PREFIX;
+  } else {
+    kind_ = Kind::EXACT;
+  }
+}
+
+bool Regex::Match(const std::string_view target) const {
+  switch (kind_) {
+    case Kind::REGEX:
+      return std::regex_match(target.begin(), target.end(), regex_);
+    case Kind::EXACT:
+      return target == literal_;
+    case Kind::PREFIX:
+      if (!target.starts_with(literal_)) return false;
+      break;
+    case Kind::SUFFIX:
+      if (!target.ends_with(literal_)) return false;
+      break;
+    case Kind::CONTAINS:
+      if (target.find(literal_) == std::string_view::npos) return false;
+      break;
+  }
+  // `.` doesn't match the line terminators, so the rare strings with them are
+  // left to the full matcher.
+  if (target.find_first_of("\n\r") == std::string_view::npos) return true;
+  return std::regex_match(target.begin(), target.end(), regex_);
+}
+
+std::string RegexLiteralPrefix(const std::string_view pattern) {
+  // The alternatives don't have to share the prefix.
+  if (pattern.find('|') != std::string_view::npos) return {};
+  std::string prefix;
+  size_t pos = 0;
+  while (pos < pattern.size()) {
+    auto c = ReadLiteral(pattern, &pos);
+    if (!c) break;
+    // A quantified character may be repeated zero times.
+    if (pos < pattern.size() && IsQuantifier(pattern[pos])) break;
+    prefix.push_back(*c);
+  }
+  return prefix;
+}
+
+std::optional<std::string> PrefixUpperBound(const std::string_view prefix) {
+  std::string bound(prefix);
+  while (!bound.empty()) {
+    // The strings are compared by their bytes as unsigned characters.
+    if (static_cast<unsigned char>(bound.back()) != 0xFF) {
+      bound.back() = static_cast<char>(static_cast<unsigned char>(bound.back()) + 1);
+      return bound;
+    }
+    bound.pop_back();
+  }
+  return std::nullopt;
+}
+
+}  // namespace memgraph::utils
@@ -0,0 +1,51 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+
+namespace memgraph::utils {
+
+/// A regular expression in the ECMAScript syntax of `std::regex`, which is
+/// matched against whole strings like `std::regex_match` does.
+///
+/// The patterns which consist of a literal with an optional `.*` at either
+/// end, e.g. `.*@corp\.com`, are matched by comparing the strings, which
+/// takes linear time. The other patterns are matched by `std::regex`.
+class Regex final {
+ public:
+  /// Throws `std::regex_error` if the pattern is invalid.
+  explicit Regex(std::string_view pattern);
+
+  bool Match(std::string_view target) const;
+
+ private:
+  enum class Kind : uint8_t { REGEX, EXACT, PREFIX, SUFFIX, CONTAINS };
+
+  std::regex regex_;
+  Kind kind_{Kind::REGEX};
+  std::string literal_;
+};
+
+/// Returns the literal which all the strings matched by the pattern start
+/// with. Returns an empty string if the pattern doesn't start with a literal.
+std::string RegexLiteralPrefix(std::string_view pattern);
+
+/// Returns the smallest string which is greater than all the strings that
+/// start with `prefix`, or nullopt if there is no such string.
+std::optional<std::string> PrefixUpperBound(std::string_view prefix);
+
+}  // namespace memgraph::utils
@@ -15,7 +15,12 @@
 #include <pthread.h>
 #include <unistd.h>
 
+#include <array>
+#include <atomic>
 #include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
 
 #include "utils/logging.hpp"
 
@@ -126,4 +131,109 @@ class WritePrioritizedRWLock final : public RWLock {
   WritePrioritizedRWLock() : RWLock{Priority::WRITE} {};
 };
 
+/// A reader-writer lock with write priority whose shared locking doesn't
+/// write to a cache line shared by all threads, unlike `RWLock`.
+///
+/// Each reader counts itself in one of several counters, each on its own
+/// cache line, which is picked by the thread that locks. A reader only reads
+/// the writer flag afterwards, so readers on different cores don't contend as
+/// long as there is no writer. A writer sets the flag, which turns new readers
+/// away until it unlocks, and waits for the counters to drain. Exclusive
+/// locking is therefore much more expensive than with `RWLock`, which suits
+/// locks taken exclusively only for rare operations.
+///
+/// The shared lock may be released by a different thread than the one which
+/// locked it. The lock must not be locked recursively.
+class ScalableRWLock {
+ public:
+  ScalableRWLock() = default;
+
+  ScalableRWLock(const ScalableRWLock &) = delete;
+  ScalableRWLock &operator=(const ScalableRWLock &) = delete;
+  ScalableRWLock(ScalableRWLock &&) = delete;
+  ScalableRWLock &operator=(ScalableRWLock &&) = delete;
+
+  ~ScalableRWLock() = default;
+
+  void lock() {
+    bool expected = false;
+    while (!writer_.compare_exchange_weak(expected, true, std::memory_order_seq_cst)) {
+      if (expected) writer_.wait(true, std::memory_order_relaxed);
+      expected = false;
+    }
+    while (true) {
+      const auto released = released_.load(std::memory_order_seq_cst);
+      if (Readers() == 0) return;
+      released_.wait(released, std::memory_order_relaxed);
+    }
+  }
+
+  bool try_lock() {
+    bool expected = false;
+    if (!writer_.compare_exchange_strong(expected, true, std::memory_order_seq_cst)) return false;
+    if (Readers() == 0) return true;
+    unlock();
+    return false;
+  }
+
+  void unlock() {
+    writer_.store(false, std::memory_order_seq_cst);
+    writer_.notify_all();
+  }
+
+  void lock_shared() {
+    while (!try_lock_shared()) {
+      writer_.wait(true, std::memory_order_relaxed);
+    }
+  }
+
+  bool try_lock_shared() {
+    auto &readers = readers_[ThreadSlot()].count;
+    readers.fetch_add(1, std::memory_order_seq_cst);
+    if (!writer_.load(std::memory_order_seq_cst)) return true;
+    Release(readers);
+    return false;
+  }
+
+  void unlock_shared() { Release(readers_[ThreadSlot()].count); }
+
+ private:
+  static constexpr size_t kReaderSlots = 64;
+
+  struct alignas(64) ReaderSlot {
+    // Can be negative when the readers counted in a slot unlocked on threads
+    // using another slot, only the sum of all slots is meaningful.
+    std::atomic<int64_t> count{0};
+  };
+
+  static size_t ThreadSlot() {
+    thread_local const size_t slot = next_slot_.fetch_add(1, std::memory_order_relaxed) % kReaderSlots;
+    return slot;
+  }
+
+  // Once the writer flag is set, readers can only leave, so the sum can't go
+  // from positive to zero and back before the writer notices.
+  int64_t Readers() const {
+    int64_t readers = 0;
+    for (const auto &slot : readers_) readers += slot.count.load(std::memory_order_seq_cst);
+    return readers;
+  }
+
+  void Release(std::atomic<int64_t> &readers) {
+    readers.fetch_sub(1, std::memory_order_seq_cst);
+    if (writer_.load(std::memory_order_seq_cst)) {
+      released_.fetch_add(1, std::memory_order_seq_cst);
+      released_.notify_all();
+    }
+  }
+
+  inline static std::atomic<size_t> next_slot_{0};
+
+  std::array<ReaderSlot, kReaderSlots> readers_;
+  alignas(64) std::atomic<bool> writer_{false};
+  // Bumped by the readers which leave while there's a writer, which is waiting
+  // for them.
+  std::atomic<uint64_t> released_{0};
+};
+
 }  // namespace memgraph::utils
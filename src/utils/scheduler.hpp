@@ -13,78 +13,68 @@
 
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
-#include <ctime>
 #include <functional>
-#include <thread>
+#include <memory>
+#include <mutex>
+#include <string>
 
 #include "utils/logging.hpp"
-#include "utils/thread.hpp"
+#include "utils/timer_wheel.hpp"
 
 namespace memgraph::utils {
 
 /**
- * Class used to run scheduled function execution.
+ * Class used to run scheduled function execution. The functions of all
+ * schedulers are run by the workers of the global timer wheel.
  */
 class Scheduler {
  public:
-  Scheduler() {}
+  // The wheel is created before the scheduler, so that it is destroyed after
+  // it even if both are static.
+  Scheduler() : wheel_(&TimerWheel::Global()) {}
+
+  Scheduler(const Scheduler &) = delete;
+  Scheduler &operator=(const Scheduler &) = delete;
+  Scheduler(Scheduler &&) = delete;
+  Scheduler &operator=(Scheduler &&) = delete;
+
   /**
    * @param pause - Duration between two function executions. If function is
    * still running when it should be ran again, it will run right after it
    * finishes its previous run.
    * @param f - Function
+   * @param options - Jitter and priority of the runs.
    * @Tparam TRep underlying arithmetic type in duration
    * @Tparam TPeriod duration in seconds between two ticks
-   * @throw std::system_error if thread could not be started.
    * @throw std::bad_alloc
    */
   template <typename TRep, typename TPeriod>
   void Run(const std::string &service_name, const std::chrono::duration<TRep, TPeriod> &pause,
-           const std::function<void()> &f) {
-    DMG_ASSERT(is_working_ == false, "Thread already running.");
+           const std::function<void()> &f, const PeriodicTaskOptions options = {}) {
+    DMG_ASSERT(is_working_ == false, "Scheduler already running.");
     DMG_ASSERT(pause > std::chrono::seconds(0), "Pause is invalid.");
 
+    // First wait then execute the function. We do that in that order because
+    // most of the schedulers are started at the beginning of the program and
+    // there is probably no work to do in scheduled function at the start of
+    // the program.
+    std::lock_guard guard(mutex_);
+    task_ = wheel_->Register(service_name, std::chrono::duration_cast<std::chrono::steady_clock::duration>(pause), f,
+                             options);
     is_working_ = true;
-    thread_ = std::thread([this, pause, f, service_name]() {
-      auto start_time = std::chrono::system_clock::now();
-
-      utils::ThreadSetName(service_name);
-
-      while (true) {
-        // First wait then execute the function. We do that in that order
-        // because most of the schedulers are started at the beginning of the
-        // program and there is probably no work to do in scheduled function at
-        // the start of the program. Since Server will log some messages on
-        // the program start we let him log first and we make sure by first
-        // waiting that funcion f will not log before it.
-        std::unique_lock<std::mutex> lk(mutex_);
-        auto now = std::chrono::system_clock::now();
-        start_time += pause;
-        if (start_time > now) {
-          condition_variable_.wait_for(lk, start_time - now, [&] { return is_working_.load() == false; });
-        } else {
-          start_time = now;
-        }
-
-        if (!is_working_) break;
-        f();
-      }
-    });
   }
 
   /**
-   * @brief Stops the thread execution. This is a blocking call and may take as
-   * much time as one call to the function given previously to Run takes.
-   * @throw std::system_error
+   * @brief Stops the execution. This is a blocking call and may take as much
+   * time as one call to the function given previously to Run takes.
    */
   void Stop() {
     is_working_.store(false);
-    {
-      std::unique_lock<std::mutex> lk(mutex_);
-      condition_variable_.notify_one();
+    std::lock_guard guard(mutex_);
+    if (task_) {
+      TimerWheel::Cancel(task_);
+      task_.reset();
     }
-    if (thread_.joinable()) thread_.join();
   }
 
   /**
@@ -95,26 +85,16 @@ class Scheduler {
   ~Scheduler() { Stop(); }
 
  private:
+  TimerWheel *wheel_;
+
   /**
-   * Variable is true when thread is running.
+   * Variable is true when the function is scheduled.
    */
   std::atomic<bool> is_working_{false};
 
-  /**
-   * Mutex used to synchronize threads using condition variable.
-   */
   std::mutex mutex_;
 
-  /**
-   * Condition variable is used to stop waiting until the end of the
-   * time interval if destructor is called.
-   */
-  std::condition_variable condition_variable_;
-
-  /**
-   * Thread which runs function.
-   */
-  std::thread thread_;
+  std::shared_ptr<TimerWheel::Task> task_;
 };
 
 }  // namespace memgraph::utils
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <cmath>
 #include <cstdint>
@@ -20,6 +21,7 @@
 #include <optional>
 #include <random>
 #include <utility>
+#include <vector>
 
 #include "spdlog/spdlog.h"
 #include "utils/bound.hpp"
@@ -141,6 +143,20 @@ size_t SkipListNodeSize(const SkipListNode<TObj> &node) {
   return sizeof(node) + node.height * sizeof(std::atomic<SkipListNode<TObj> *>);
 }
 
+/// Prefetches the node that follows `node` on the lowest layer, so that its
+/// cache misses overlap with the work done on `node` while iterating. The next
+/// pointer is only used as a hint here, the node isn't dereferenced.
+template <typename TObj>
+inline void PrefetchNext(const SkipListNode<TObj> *node) {
+  if (node == nullptr) return;
+  const auto *next = node->nexts[0].load(std::memory_order_relaxed);
+  if (next == nullptr) return;
+  __builtin_prefetch(next);
+  // Iteration reads the flags and the lowest layer pointer, which are behind
+  // the object and end up in another cache line for larger objects.
+  if constexpr (sizeof(SkipListNode<TObj>) > 64) __builtin_prefetch(&next->nexts[0]);
+}
+
 /// A helper function for determining the skip list layer used for estimating
 /// the number of elements in, e.g. a database index. The lower layer we use,
 /// the better approximation we get (if we use the lowest layer, we get the
@@ -605,11 +621,22 @@ class SkipList final : detail::SkipListNode_base {
         if (node_ != nullptr && node_->marked.load(std::memory_order_acquire)) {
           continue;
         } else {
+          PrefetchNext(node_);
           return *this;
         }
       }
     }
 
+    /// Returns the object of the node that follows on the lowest layer, or
+    /// nullptr at the end. The node may be already removed from the list, but
+    /// stays allocated while the accessor is alive. Only the fields of the
+    /// object which never change may be read, e.g. to prefetch what they point
+    /// to.
+    const TObj *PeekNext() const {
+      const auto *next = node_->nexts[0].load(std::memory_order_acquire);
+      return next != nullptr ? &next->obj : nullptr;
+    }
+
    private:
     TNode *node_;
   };
@@ -637,15 +664,48 @@ class SkipList final : detail::SkipListNode_base {
         if (node_ != nullptr && node_->marked.load(std::memory_order_acquire)) {
           continue;
         } else {
+          PrefetchNext(node_);
           return *this;
         }
       }
     }
 
+    /// Returns the object of the node that follows on the lowest layer, or
+    /// nullptr at the end. The node may be already removed from the list, but
+    /// stays allocated while the accessor is alive. Only the fields of the
+    /// object which never change may be read, e.g. to prefetch what they point
+    /// to.
+    const TObj *PeekNext() const {
+      const auto *next = node_->nexts[0].load(std::memory_order_acquire);
+      return next != nullptr ? &next->obj : nullptr;
+    }
+
    private:
     TNode *node_;
   };
 
+  /// Remembers the position of the last insertion done with it. Consecutive
+  /// insertions of increasing objects that share a hint start searching from
+  /// the previous position instead of from the head of the list, so inserting
+  /// already sorted input takes expected O(1) time per object instead of
+  /// O(log(n)). The hint is only an optimization, insertions in any order stay
+  /// correct, they just don't benefit from it.
+  ///
+  /// Searches for increasing keys with `find_equal_or_greater` can share a
+  /// hint the same way, which makes them a finger search: each one starts from
+  /// the previous position, so it only walks over the part of the list
+  /// between the previous key and the next one.
+  ///
+  /// A hint may only be used with a single list and only while the accessor
+  /// it was first used with is alive, because the nodes it points to may be
+  /// freed after that.
+  class InsertHint final {
+   private:
+    friend class SkipList;
+
+    TNode *preds_[kSkipListMaxHeight]{};
+  };
+
   class Accessor final {
    private:
     friend class SkipList;
@@ -653,6 +713,8 @@ class SkipList final : detail::SkipListNode_base {
     explicit Accessor(SkipList *skiplist) : skiplist_(skiplist), id_(skiplist->gc_.AllocateId()) {}
 
    public:
+    using InsertHint = typename SkipList::InsertHint;
+
     ~Accessor() {
       if (skiplist_ != nullptr) skiplist_->gc_.ReleaseId(id_);
     }
@@ -690,6 +752,14 @@ class SkipList final : detail::SkipListNode_base {
     ///         bool indicates whether the item was inserted into the list
     std::pair<Iterator, bool> insert(TObj &&object) { return skiplist_->insert(std::move(object)); }
 
+    /// Inserts an object into the list the same way `insert` does, but starts
+    /// the search from the position remembered in `hint` and updates it. See
+    /// `InsertHint`.
+    std::pair<Iterator, bool> insert(InsertHint &hint, const TObj &object) { return skiplist_->insert(object, &hint); }
+    std::pair<Iterator, bool> insert(InsertHint &hint, TObj &&object) {
+      return skiplist_->insert(std::move(object), &hint);
+    }
+
     /// Checks whether the key exists in the list.
     ///
     /// @return bool indicating whether the item exists
@@ -717,6 +787,14 @@ class SkipList final : detail::SkipListNode_base {
       return skiplist_->template find_equal_or_greater(key);
     }
 
+    /// Finds the key or the first larger key the same way as above, but
+    /// starts the search from the position remembered in `hint` and updates
+    /// it. See `InsertHint`.
+    template <typename TKey>
+    Iterator find_equal_or_greater(InsertHint &hint, const TKey &key) const {
+      return skiplist_->template find_equal_or_greater(key, &hint);
+    }
+
     /// Estimates the number of items that are contained in the list that are
     /// identical to the key determined using the equality operator. The default
     /// layer is chosen to optimize duration vs. precision. The lower the layer
@@ -770,6 +848,20 @@ class SkipList final : detail::SkipListNode_base {
       return skiplist_->template remove(key);
     }
 
+    /// Returns up to `num_partitions - 1` iterators to items that split the
+    /// list into `num_partitions` ranges of roughly equal size, ordered from
+    /// the smallest. The split points are sampled from the highest layer that
+    /// has enough items, so the time complexity is proportional to
+    /// `num_partitions` instead of to the size of the list. Fewer split points
+    /// are returned when the list is too small to be split that many times.
+    ///
+    /// The ranges are `[begin(), points[0])`, `[points[0], points[1])`, ...,
+    /// `[points.back(), end())`; they are disjoint but items inserted after the
+    /// call may end up in any of them.
+    std::vector<Iterator> partition_points(uint64_t num_partitions) const {
+      return skiplist_->partition_points(num_partitions);
+    }
+
     /// Returns the number of items contained in the list.
     ///
     /// @return size of the list
@@ -843,6 +935,11 @@ class SkipList final : detail::SkipListNode_base {
       return skiplist_->template estimate_average_number_of_equals(equal_cmp, max_layer_for_estimation);
     }
 
+    std::vector<ConstIterator> partition_points(uint64_t num_partitions) const {
+      auto points = skiplist_->partition_points(num_partitions);
+      return {points.begin(), points.end()};
+    }
+
     uint64_t size() const { return skiplist_->size(); }
 
    private:
@@ -937,10 +1034,21 @@ class SkipList final : detail::SkipListNode_base {
 
  private:
   template <typename TKey>
-  int find_node(const TKey &key, TNode *preds[], TNode *succs[]) const {
+  int find_node(const TKey &key, TNode *preds[], TNode *succs[], const InsertHint *hint = nullptr) const {
     int layer_found = -1;
     TNode *pred = head_;
     for (int layer = kSkipListMaxHeight - 1; layer >= 0; --layer) {
+      if (hint != nullptr) {
+        // Continue from the hinted node if it is further than `pred` but still
+        // before the key. The hinted node was a predecessor on this layer, and
+        // if it isn't marked it is still linked on this layer.
+        TNode *hinted = hint->preds_[layer];
+        if (hinted != nullptr && hinted != head_ && hinted != pred &&
+            !hinted->marked.load(std::memory_order_acquire) && hinted->obj < key &&
+            (pred == head_ || pred->obj < hinted->obj)) {
+          pred = hinted;
+        }
+      }
       TNode *curr = pred->nexts[layer].load(std::memory_order_acquire);
       // Existence test is missing in the paper.
       while (curr != nullptr && curr->obj < key) {
@@ -959,17 +1067,18 @@ class SkipList final : detail::SkipListNode_base {
   }
 
   template <typename TObjUniv>
-  std::pair<Iterator, bool> insert(TObjUniv &&object) {
+  std::pair<Iterator, bool> insert(TObjUniv &&object, InsertHint *hint = nullptr) {
     int top_layer = gen_height();
     TNode *preds[kSkipListMaxHeight], *succs[kSkipListMaxHeight];
     if (top_layer >= kSkipListGcHeightTrigger) gc_.Run();
     while (true) {
-      int layer_found = find_node(object, preds, succs);
+      int layer_found = find_node(object, preds, succs, hint);
       if (layer_found != -1) {
         TNode *node_found = succs[layer_found];
         if (!node_found->marked.load(std::memory_order_acquire)) {
           while (!node_found->fully_linked.load(std::memory_order_acquire))
             ;
+          if (hint != nullptr) std::copy(preds, preds + kSkipListMaxHeight, hint->preds_);
           return {Iterator{node_found}, false};
         }
         continue;
@@ -1013,6 +1122,12 @@ class SkipList final : detail::SkipListNode_base {
 
       new_node->fully_linked.store(true, std::memory_order_release);
       size_.fetch_add(1, std::memory_order_acq_rel);
+      if (hint != nullptr) {
+        // The next (larger) object will be inserted after the new node on all
+        // of its layers.
+        std::fill(hint->preds_, hint->preds_ + top_layer, new_node);
+        std::copy(preds + top_layer, preds + kSkipListMaxHeight, hint->preds_ + top_layer);
+      }
       return {Iterator{new_node}, true};
     }
   }
@@ -1037,9 +1152,10 @@ class SkipList final : detail::SkipListNode_base {
   }
 
   template <typename TKey>
-  Iterator find_equal_or_greater(const TKey &key) const {
+  Iterator find_equal_or_greater(const TKey &key, InsertHint *hint = nullptr) const {
     TNode *preds[kSkipListMaxHeight], *succs[kSkipListMaxHeight];
-    find_node(key, preds, succs);
+    find_node(key, preds, succs, hint);
+    if (hint != nullptr) std::copy(preds, preds + kSkipListMaxHeight, hint->preds_);
     if (succs[0] && succs[0]->fully_linked.load(std::memory_order_acquire) &&
         !succs[0]->marked.load(std::memory_order_acquire)) {
       return Iterator{succs[0]};
@@ -1145,6 +1261,28 @@ class SkipList final : detail::SkipListNode_base {
     return count;
   }
 
+  std::vector<Iterator> partition_points(uint64_t num_partitions) const {
+    // Sample a few nodes per partition so that the partitions stay balanced
+    // even though the nodes on a single layer aren't evenly spaced.
+    constexpr uint64_t kSamplesPerPartition = 4;
+    std::vector<TNode *> samples;
+    if (num_partitions <= 1) return {};
+    for (int layer = kSkipListMaxHeight - 1; layer >= 0; --layer) {
+      samples.clear();
+      for (TNode *curr = head_->nexts[layer].load(std::memory_order_acquire); curr != nullptr;
+           curr = curr->nexts[layer].load(std::memory_order_acquire)) {
+        if (!curr->marked.load(std::memory_order_acquire)) samples.push_back(curr);
+      }
+      if (samples.size() >= num_partitions * kSamplesPerPartition) break;
+    }
+    const auto parts = std::min<uint64_t>(num_partitions, samples.size());
+    std::vector<Iterator> points;
+    if (parts <= 1) return points;
+    points.reserve(parts - 1);
+    for (uint64_t i = 1; i < parts; ++i) points.push_back(Iterator{samples[i * samples.size() / parts]});
+    return points;
+  }
+
   template <typename TCallable>
   uint64_t estimate_average_number_of_equals(const TCallable &equal_cmp, int max_layer_for_estimation) const {
     MG_ASSERT(max_layer_for_estimation >= 1 && max_layer_for_estimation <= kSkipListMaxHeight,
@@ -0,0 +1,118 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "utils/skip_list.hpp"
+
+namespace memgraph::utils {
+
+/// Concurrent set of unsigned integers stored as a bitmap split into blocks.
+///
+/// Each block covers `kBitsPerBlock` consecutive values and is allocated only
+/// once a value inside of it is set, so ranges without any set values don't
+/// take any memory. The blocks are kept in a `SkipList`, which makes it safe
+/// to set, clear and test values from multiple threads at the same time.
+/// Blocks are never released before the whole bitset is destroyed, even if
+/// all of their values get cleared.
+///
+/// The bitset is meant for dense, mostly increasing values (e.g. `Gid`s of
+/// in-memory objects), for which clustered values end up in the same blocks.
+class SparseBitset final {
+ public:
+  static constexpr uint64_t kBitsPerBlock = 4096;
+
+ private:
+  static constexpr uint64_t kBitsPerWord = 64;
+  static constexpr uint64_t kWordsPerBlock = kBitsPerBlock / kBitsPerWord;
+
+  struct Block {
+    uint64_t index;
+    std::unique_ptr<std::atomic<uint64_t>[]> words;
+
+    bool operator<(const Block &other) const { return index < other.index; }
+    bool operator==(const Block &other) const { return index == other.index; }
+    bool operator<(uint64_t other) const { return index < other; }
+    bool operator==(uint64_t other) const { return index == other; }
+  };
+
+ public:
+  /// Accessor through which the bitset is used. The accessor remembers the
+  /// last block it has used, so consecutive calls with values from the same
+  /// block don't have to look it up again.
+  class Accessor final {
+   public:
+    /// @throw std::bad_alloc
+    void Set(uint64_t value) {
+      auto *words = FindOrCreateBlock(value / kBitsPerBlock);
+      words[WordOffset(value)].fetch_or(BitMask(value), std::memory_order_acq_rel);
+    }
+
+    void Clear(uint64_t value) {
+      auto *words = FindBlock(value / kBitsPerBlock);
+      if (!words) return;
+      words[WordOffset(value)].fetch_and(~BitMask(value), std::memory_order_acq_rel);
+    }
+
+    bool Test(uint64_t value) const {
+      const auto *words = FindBlock(value / kBitsPerBlock);
+      if (!words) return false;
+      return (words[WordOffset(value)].load(std::memory_order_acquire) & BitMask(value)) != 0;
+    }
+
+    /// Number of allocated blocks.
+    uint64_t BlockCount() const { return blocks_.size(); }
+
+   private:
+    friend class SparseBitset;
+
+    explicit Accessor(SkipList<Block>::Accessor blocks) : blocks_(std::move(blocks)) {}
+
+    static uint64_t WordOffset(uint64_t value) { return (value % kBitsPerBlock) / kBitsPerWord; }
+    static uint64_t BitMask(uint64_t value) { return uint64_t{1} << (value % kBitsPerWord); }
+
+    std::atomic<uint64_t> *FindBlock(uint64_t index) const {
+      if (last_words_ && last_index_ == index) return last_words_;
+      auto it = blocks_.find(index);
+      if (it == blocks_.end()) return nullptr;
+      last_index_ = index;
+      last_words_ = it->words.get();
+      return last_words_;
+    }
+
+    std::atomic<uint64_t> *FindOrCreateBlock(uint64_t index) {
+      if (auto *words = FindBlock(index)) return words;
+      auto words = std::make_unique<std::atomic<uint64_t>[]>(kWordsPerBlock);
+      for (uint64_t i = 0; i < kWordsPerBlock; ++i) words[i].store(0, std::memory_order_relaxed);
+      // If another thread inserted the same block in the meantime, its block
+      // is returned and the one created here is discarded.
+      auto it = blocks_.insert(Block{index, std::move(words)}).first;
+      last_index_ = index;
+      last_words_ = it->words.get();
+      return last_words_;
+    }
+
+    SkipList<Block>::Accessor blocks_;
+    mutable uint64_t last_index_{0};
+    mutable std::atomic<uint64_t> *last_words_{nullptr};
+  };
+
+  Accessor access() { return Accessor{blocks_.access()}; }
+
+ private:
+  SkipList<Block> blocks_;
+};
+
+}  // namespace memgraph::utils
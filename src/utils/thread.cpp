@@ -11,9 +11,21 @@
 
 #include "utils/thread.hpp"
 
+#include <pthread.h>
+#include <sched.h>
 #include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <thread>
 
 #include "utils/logging.hpp"
+#include "utils/string.hpp"
 
 namespace memgraph::utils {
 
@@ -26,4 +38,83 @@ void ThreadSetName(const std::string &name) {
   }
 }
 
+void ThreadSetLowestPriority() {
+  // With the thread id `setpriority` changes only the calling thread on Linux.
+  const auto tid = static_cast<id_t>(syscall(SYS_gettid));
+  if (setpriority(PRIO_PROCESS, tid, 19) != 0) {
+    spdlog::warn("Couldn't lower the CPU priority of the thread!");
+  }
+  // Values from `linux/ioprio.h`, `0` selects the calling thread.
+  constexpr int kIoprioWhoProcess = 1;
+  constexpr int kIoprioClassBestEffort = 2;
+  constexpr int kIoprioClassShift = 13;
+  constexpr int kIoprioLowestLevel = 7;
+  constexpr int kIoprio = (kIoprioClassBestEffort << kIoprioClassShift) | kIoprioLowestLevel;
+  if (syscall(SYS_ioprio_set, kIoprioWhoProcess, 0, kIoprio) != 0) {
+    spdlog::warn("Couldn't lower the I/O priority of the thread!");
+  }
+}
+
+namespace {
+// Parses a CPU list in the format of sysfs, e.g. `0-3,8,10-11`.
+std::vector<int> ParseCpuList(const std::string &list) {
+  std::vector<int> cpus;
+  for (const auto &range : Split(Trim(list), ",")) {
+    if (range.empty()) continue;
+    const auto bounds = Split(range, "-");
+    try {
+      const auto first = std::stoi(bounds.front());
+      const auto last = std::stoi(bounds.back());
+      for (auto cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+    } catch (const std::exception &) {
+      return {};
+    }
+  }
+  return cpus;
+}
+}  // namespace
+
+std::vector<std::vector<int>> NumaNodeCpus() {
+  std::vector<std::vector<int>> nodes;
+  std::error_code error_code;
+  for (const auto &entry : std::filesystem::directory_iterator("/sys/devices/system/node", error_code)) {
+    const auto name = entry.path().filename().string();
+    if (!StartsWith(name, "node") || name.size() == 4 ||
+        !std::all_of(name.begin() + 4, name.end(), [](const char c) { return std::isdigit(c); })) {
+      continue;
+    }
+    std::ifstream file(entry.path() / "cpulist");
+    std::string list;
+    std::getline(file, list);
+    auto cpus = ParseCpuList(list);
+    // The nodes with memory only don't have CPUs to run on.
+    if (!cpus.empty()) nodes.push_back(std::move(cpus));
+  }
+  if (nodes.empty()) {
+    auto &cpus = nodes.emplace_back();
+    const auto count = std::max(std::thread::hardware_concurrency(), 1U);
+    for (unsigned cpu = 0; cpu < count; ++cpu) cpus.push_back(static_cast<int>(cpu));
+  }
+  return nodes;
+}
+
+std::vector<int> NumaNodesWithMemory() {
+  std::ifstream file("/sys/devices/system/node/has_memory");
+  std::string list;
+  std::getline(file, list);
+  // The node lists have the same format as the CPU lists.
+  return ParseCpuList(list);
+}
+
+bool ThreadPinToNumaNode(const size_t index) {
+  // The nodes don't change while the process runs.
+  static const auto nodes = NumaNodeCpus();
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : nodes[index % nodes.size()]) {
+    if (cpu < CPU_SETSIZE) CPU_SET(cpu, &cpu_set);
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+}
+
 }  // namespace memgraph::utils
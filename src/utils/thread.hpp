@@ -12,7 +12,9 @@
 /// @file
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace memgraph::utils {
 
@@ -22,4 +24,23 @@ constexpr size_t GetMaxThreadNameSize() { return 16; }
 /// Beware, the name length limit is 16 characters!
 void ThreadSetName(const std::string &name);
 
+/// This function sets the CPU and I/O priority of the calling thread to the
+/// lowest best-effort level. The threads it creates afterwards inherit the
+/// priorities. Beware, the priorities can't be raised again without
+/// privileges!
+void ThreadSetLowestPriority();
+
+/// Returns the CPUs of each online NUMA node. Returns a single node with all
+/// online CPUs if the kernel doesn't report the nodes.
+std::vector<std::vector<int>> NumaNodeCpus();
+
+/// Returns the ids of the online NUMA nodes which have memory. Returns an
+/// empty vector if the kernel doesn't report the nodes.
+std::vector<int> NumaNodesWithMemory();
+
+/// This function pins the calling thread to the CPUs of the NUMA node
+/// `index` modulo the number of nodes. Returns false if the thread couldn't
+/// be pinned.
+bool ThreadPinToNumaNode(size_t index);
+
 };  // namespace memgraph::utils
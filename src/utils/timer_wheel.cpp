@@ -0,0 +1,247 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "utils/timer_wheel.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include "utils/event_histogram.hpp"
+#include "utils/thread.hpp"
+
+namespace memgraph::metrics {
+extern const Event PeriodicTaskRunTime_us;
+extern const Event PeriodicTaskLateness_us;
+}  // namespace memgraph::metrics
+
+namespace memgraph::utils {
+
+class TimerWheel::Task {
+ public:
+  Task(std::string name, Clock::duration period, std::function<void()> function, PeriodicTaskOptions options)
+      : name(std::move(name)), period(period), function(std::move(function)), options(options) {}
+
+  const std::string name;
+  const Clock::duration period;
+  std::function<void()> function;
+  const PeriodicTaskOptions options;
+  /// The time of the previous run without the jitter, changed only by the
+  /// worker which runs the task.
+  Clock::time_point base;
+
+  std::mutex mutex;
+  std::condition_variable run_finished;
+  bool running{false};
+  bool cancelled{false};
+};
+
+namespace {
+constexpr size_t kMinWorkers = 2;
+constexpr size_t kLowPriorityWorkers = 2;
+
+uint64_t Microseconds(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+}  // namespace
+
+TimerWheel::TimerWheel(const size_t workers, const size_t low_priority_workers) {
+  threads_.emplace_back([this] { TimerLoop(); });
+  for (size_t i = 0; i < workers; ++i) {
+    threads_.emplace_back([this] { WorkerLoop(false); });
+  }
+  for (size_t i = 0; i < low_priority_workers; ++i) {
+    threads_.emplace_back([this] { WorkerLoop(true); });
+  }
+}
+
+TimerWheel::~TimerWheel() {
+  {
+    std::lock_guard guard(mutex_);
+    stop_ = true;
+  }
+  timer_cv_.notify_all();
+  workers_cv_.notify_all();
+  low_priority_workers_cv_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+TimerWheel &TimerWheel::Global() {
+  static TimerWheel wheel(std::max<size_t>(kMinWorkers, std::thread::hardware_concurrency() / 4),
+                          kLowPriorityWorkers);
+  return wheel;
+}
+
+std::shared_ptr<TimerWheel::Task> TimerWheel::Register(std::string name, const Clock::duration period,
+                                                       std::function<void()> function,
+                                                       const PeriodicTaskOptions options) {
+  auto task = std::make_shared<Task>(std::move(name), period, std::move(function), options);
+  Schedule(task, Clock::now());
+  return task;
+}
+
+void TimerWheel::Cancel(const std::shared_ptr<Task> &task) {
+  std::unique_lock guard(task->mutex);
+  task->cancelled = true;
+  task->run_finished.wait(guard, [&] { return !task->running; });
+  // The entry of the next run can outlive the task, but not what the function
+  // captured.
+  task->function = nullptr;
+}
+
+void TimerWheel::Schedule(const std::shared_ptr<Task> &task, const Clock::time_point base) {
+  task->base = base;
+  {
+    std::lock_guard guard(mutex_);
+    auto due = base + task->period;
+    if (const auto jitter = task->options.jitter.count(); jitter > 0) {
+      due += std::chrono::milliseconds(std::uniform_int_distribution<int64_t>(0, jitter)(random_));
+    }
+    Insert({task, due, task->options.priority});
+  }
+  // The timer thread could be sleeping past the new entry.
+  timer_cv_.notify_one();
+}
+
+void TimerWheel::Insert(Entry &&entry) {
+  // The entry is in the first slot at or after its due time.
+  const auto due_tick = static_cast<uint64_t>(std::max((entry.due - start_ + kTick - Clock::duration(1)) / kTick,
+                                                       static_cast<Clock::rep>(0)));
+  if (due_tick <= current_tick_) {
+    MakeReady(std::move(entry));
+    return;
+  }
+  const uint64_t delta = due_tick - current_tick_;
+  uint64_t level = 0;
+  while (level + 1 < kLevels && delta >= (uint64_t{1} << (kLevelBits * (level + 1)))) {
+    ++level;
+  }
+  // The entries beyond the last level wait in its farthest slot and are
+  // inserted again when it's cascaded.
+  const uint64_t slot_tick = std::min(due_tick, current_tick_ + (uint64_t{1} << (kLevelBits * kLevels)) - 1);
+  const uint64_t slot = (slot_tick >> (kLevelBits * level)) & (kSlots - 1);
+  wheel_[level][slot].push_back(std::move(entry));
+  occupied_slots_[level] |= uint64_t{1} << slot;
+}
+
+void TimerWheel::MakeReady(Entry &&entry) {
+  if (entry.priority == PeriodicTaskPriority::LOW) {
+    low_priority_ready_.push(std::move(entry));
+    low_priority_workers_cv_.notify_one();
+  } else {
+    ready_.push(std::move(entry));
+    workers_cv_.notify_one();
+  }
+}
+
+void TimerWheel::Advance() {
+  ++current_tick_;
+  // When the slots of a level wrap around, the next slot of the level above
+  // is spread over the levels below.
+  for (uint64_t level = 1; level < kLevels; ++level) {
+    if ((current_tick_ & ((uint64_t{1} << (kLevelBits * level)) - 1)) != 0) break;
+    const uint64_t slot = (current_tick_ >> (kLevelBits * level)) & (kSlots - 1);
+    auto entries = std::move(wheel_[level][slot]);
+    wheel_[level][slot].clear();
+    occupied_slots_[level] &= ~(uint64_t{1} << slot);
+    for (auto &entry : entries) {
+      Insert(std::move(entry));
+    }
+  }
+  const uint64_t slot = current_tick_ & (kSlots - 1);
+  auto entries = std::move(wheel_[0][slot]);
+  wheel_[0][slot].clear();
+  occupied_slots_[0] &= ~(uint64_t{1} << slot);
+  for (auto &entry : entries) {
+    MakeReady(std::move(entry));
+  }
+}
+
+std::optional<uint64_t> TimerWheel::NextTick() const {
+  std::optional<uint64_t> next;
+  if (occupied_slots_[0] != 0) {
+    // The entries of the first level are due in less than `kSlots` ticks.
+    const auto next_slot = static_cast<int>((current_tick_ + 1) & (kSlots - 1));
+    next = current_tick_ + 1 + std::countr_zero(std::rotr(occupied_slots_[0], next_slot));
+  }
+  if (std::any_of(occupied_slots_.begin() + 1, occupied_slots_.end(), [](uint64_t slots) { return slots != 0; })) {
+    const uint64_t cascade_tick = (current_tick_ | (kSlots - 1)) + 1;
+    next = next ? std::min(*next, cascade_tick) : cascade_tick;
+  }
+  return next;
+}
+
+void TimerWheel::TimerLoop() {
+  utils::ThreadSetName("Timer wheel");
+  std::unique_lock guard(mutex_);
+  while (!stop_) {
+    const auto now_tick = static_cast<uint64_t>((Clock::now() - start_) / kTick);
+    while (current_tick_ < now_tick) {
+      Advance();
+    }
+    if (const auto next_tick = NextTick(); next_tick) {
+      timer_cv_.wait_until(guard, start_ + *next_tick * kTick);
+    } else {
+      timer_cv_.wait(guard);
+    }
+  }
+}
+
+void TimerWheel::WorkerLoop(const bool low_priority) {
+  utils::ThreadSetName("Periodic tasks");
+  if (low_priority) {
+    utils::ThreadSetLowestPriority();
+  }
+  auto &ready = low_priority ? low_priority_ready_ : ready_;
+  auto &ready_cv = low_priority ? low_priority_workers_cv_ : workers_cv_;
+  std::unique_lock guard(mutex_);
+  while (true) {
+    ready_cv.wait(guard, [&] { return stop_ || !ready.empty(); });
+    if (stop_) return;
+    const auto entry = ready.top();
+    ready.pop();
+    guard.unlock();
+    Run(entry);
+    guard.lock();
+  }
+}
+
+void TimerWheel::Run(const Entry &entry) {
+  auto &task = *entry.task;
+  {
+    std::lock_guard guard(task.mutex);
+    if (task.cancelled) return;
+    task.running = true;
+  }
+  const auto start = Clock::now();
+  if (start > entry.due) {
+    metrics::Measure(metrics::PeriodicTaskLateness_us, Microseconds(start - entry.due));
+  }
+  // The workers run the tasks of all services, so they are named after the
+  // one they are running.
+  utils::ThreadSetName(task.name);
+  task.function();
+  utils::ThreadSetName("Periodic tasks");
+  const auto end = Clock::now();
+  metrics::Measure(metrics::PeriodicTaskRunTime_us, Microseconds(end - start));
+  {
+    std::lock_guard guard(task.mutex);
+    task.running = false;
+    task.run_finished.notify_all();
+    if (task.cancelled) return;
+  }
+  // The next run is a period after this one was due, or right away if that
+  // has already passed.
+  Schedule(entry.task, std::max(task.base + task.period, end - task.period));
+}
+
+}  // namespace memgraph::utils
@@ -0,0 +1,139 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace memgraph::utils {
+
+enum class PeriodicTaskPriority : uint8_t {
+  /// Runs on the workers with the lowest CPU and I/O priority, which run only
+  /// these tasks, e.g. for maintenance which can wait.
+  LOW,
+  NORMAL,
+  /// Runs before the due tasks with the normal priority.
+  HIGH
+};
+
+struct PeriodicTaskOptions {
+  /// Every run is delayed by a random duration up to the jitter, which spreads
+  /// the runs of the tasks with the same period, e.g. of different databases.
+  /// The delays don't accumulate over the runs.
+  std::chrono::milliseconds jitter{0};
+  PeriodicTaskPriority priority{PeriodicTaskPriority::NORMAL};
+};
+
+/// Runs the periodic tasks of the whole process on a small pool of workers
+/// instead of a sleeping thread per task. A single thread finds the due tasks
+/// with a hierarchical timer wheel and sleeps until the next occupied slot, so
+/// the tasks don't wake up the process separately. A task doesn't run
+/// concurrently with itself: if it's still running when it should run again,
+/// it runs right after it finishes. The run time and the lateness of the runs
+/// are measured in the PeriodicTaskRunTime_us and PeriodicTaskLateness_us
+/// histograms.
+///
+/// This class is thread safe.
+class TimerWheel final {
+ public:
+  class Task;
+
+  TimerWheel(size_t workers, size_t low_priority_workers);
+
+  TimerWheel(const TimerWheel &) = delete;
+  TimerWheel &operator=(const TimerWheel &) = delete;
+  TimerWheel(TimerWheel &&) = delete;
+  TimerWheel &operator=(TimerWheel &&) = delete;
+
+  /// Stops the workers, the registered tasks aren't run anymore.
+  ~TimerWheel();
+
+  /// The wheel shared by all schedulers.
+  static TimerWheel &Global();
+
+  /// Registers the task, which first runs a period from now.
+  /// @throw std::bad_alloc
+  std::shared_ptr<Task> Register(std::string name, std::chrono::steady_clock::duration period,
+                                 std::function<void()> function, PeriodicTaskOptions options);
+
+  /// Stops the task, waiting for its current run to finish. The task isn't run
+  /// after this returns. Mustn't be called from the task itself.
+  static void Cancel(const std::shared_ptr<Task> &task);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    std::shared_ptr<Task> task;
+    Clock::time_point due;
+    PeriodicTaskPriority priority;
+  };
+
+  /// Orders the due entries by the priority and then by the time they were
+  /// due, for the top of the priority queue.
+  struct RunsLater {
+    bool operator()(const Entry &lhs, const Entry &rhs) const {
+      if (lhs.priority != rhs.priority) return lhs.priority < rhs.priority;
+      return lhs.due > rhs.due;
+    }
+  };
+
+  using ReadyQueue = std::priority_queue<Entry, std::vector<Entry>, RunsLater>;
+
+  static constexpr Clock::duration kTick = std::chrono::milliseconds(10);
+  static constexpr uint64_t kLevelBits = 6;
+  static constexpr uint64_t kSlots = uint64_t{1} << kLevelBits;
+  static constexpr uint64_t kLevels = 4;
+
+  /// Schedules the next run of the task a period after `base`, with a new
+  /// jitter.
+  void Schedule(const std::shared_ptr<Task> &task, Clock::time_point base);
+
+  /// The following methods are called with `mutex_` held.
+  void Insert(Entry &&entry);
+  void MakeReady(Entry &&entry);
+  void Advance();
+  std::optional<uint64_t> NextTick() const;
+
+  void TimerLoop();
+  void WorkerLoop(bool low_priority);
+  void Run(const Entry &entry);
+
+  const Clock::time_point start_{Clock::now()};
+  std::mutex mutex_;
+  std::condition_variable timer_cv_;
+  std::condition_variable workers_cv_;
+  std::condition_variable low_priority_workers_cv_;
+  bool stop_{false};
+  uint64_t current_tick_{0};
+  /// The level `l` has the entries due in up to `kSlots^(l+1)` ticks, in the
+  /// slots indexed by the bits of the due tick above `l * kLevelBits`.
+  std::array<std::array<std::vector<Entry>, kSlots>, kLevels> wheel_;
+  std::array<uint64_t, kLevels> occupied_slots_{};
+  ReadyQueue ready_;
+  ReadyQueue low_priority_ready_;
+  std::minstd_rand random_{std::random_device{}()};
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace memgraph::utils
@@ -0,0 +1,74 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// USDT probes of the `memgraph` provider, which perf, bpftrace and the other
+/// eBPF tools can attach to without rebuilding, e.g.
+///
+///   bpftrace -e 'usdt:./memgraph:memgraph:query__start { printf("%d %s\n", arg0, str(arg1)); }'
+///
+/// A probe which isn't attached is a single nop, so the probes are placed on
+/// the hot paths as well. Their arguments are still evaluated, so they must be
+/// cheap to compute. The probes are compiled out if `sys/sdt.h` isn't
+/// available or the build has `USE_USDT_PROBES` off.
+///
+/// The probes fired on the thread of a query carry the id of the query, see
+/// `CurrentQueryId`, including the storage ones made while committing, like
+/// `wal__write__start`. The other storage probes, like the GC, snapshot and
+/// WAL fsync ones, don't carry a query id.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#ifdef MG_USDT_PROBES
+#include <sys/sdt.h>
+
+/// Fires the probe `memgraph:name` with up to 12 integer or pointer arguments.
+#define MG_TRACEPOINT(name, ...) STAP_PROBEV(memgraph, name __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define MG_TRACEPOINT(name, ...) \
+  do {                           \
+  } while (false)
+#endif
+
+namespace memgraph::utils {
+
+namespace detail {
+inline thread_local uint64_t current_query_id{0};
+inline std::atomic<uint64_t> next_query_id{1};
+}  // namespace detail
+
+/// Returns a new id, unique among the queries executed since the start.
+inline uint64_t NextQueryId() { return detail::next_query_id.fetch_add(1, std::memory_order_relaxed); }
+
+/// Id of the query which the thread is preparing or pulling, or 0 if it isn't
+/// executing a query.
+inline uint64_t CurrentQueryId() { return detail::current_query_id; }
+
+/// Sets the query which the thread executes in its scope.
+class QueryIdScope final {
+ public:
+  explicit QueryIdScope(uint64_t query_id) : previous_(detail::current_query_id) {
+    detail::current_query_id = query_id;
+  }
+  ~QueryIdScope() { detail::current_query_id = previous_; }
+
+  QueryIdScope(const QueryIdScope &) = delete;
+  QueryIdScope &operator=(const QueryIdScope &) = delete;
+  QueryIdScope(QueryIdScope &&) = delete;
+  QueryIdScope &operator=(QueryIdScope &&) = delete;
+
+ private:
+  uint64_t previous_;
+};
+
+}  // namespace memgraph::utils
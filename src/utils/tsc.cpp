@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -26,6 +26,12 @@ std::optional<double> GetTSCFrequency() {
   return result == 0 ? std::optional{rdtsc_get_tsc_hz()} : std::nullopt;
 }
 
+std::optional<uint64_t> TSCCyclesToNanoseconds(uint64_t cycles) {
+  static const auto frequency = GetTSCFrequency();
+  if (!frequency) return std::nullopt;
+  return static_cast<uint64_t>(static_cast<double>(cycles) * 1e9 / *frequency);
+}
+
 TSCTimer::TSCTimer(std::optional<double> frequency) : frequency_(frequency) {
   if (!frequency_) return;
   start_value_ = utils::ReadTSC();
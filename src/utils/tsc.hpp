@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -22,6 +22,10 @@ uint64_t ReadTSC();
 
 std::optional<double> GetTSCFrequency();
 
+/// Converts TSC cycles to nanoseconds. Returns nullopt if the TSC frequency is
+/// unknown.
+std::optional<uint64_t> TSCCyclesToNanoseconds(uint64_t cycles);
+
 /// Class that is used to measure elapsed time using the TSC directly. It has
 /// almost zero overhead and is appropriate for use in performance critical
 /// paths.
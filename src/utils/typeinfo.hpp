@@ -29,12 +29,18 @@ enum class TypeId : uint64_t {
   SCAN_ALL_BY_LABEL,
   SCAN_ALL_BY_LABEL_PROPERTY_RANGE,
   SCAN_ALL_BY_LABEL_PROPERTY_VALUE,
+  SCAN_ALL_BY_LABEL_PROPERTY_VALUES,
   SCAN_ALL_BY_LABEL_PROPERTY,
+  SCAN_ALL_BY_LABEL_PROPERTY_COMPOSITE,
+  SCAN_ALL_BY_EDGE_TYPE,
+  SCAN_ALL_BY_EDGE_TYPE_PROPERTY,
   SCAN_ALL_BY_ID,
   EXPAND_COMMON,
   EXPAND,
   EXPANSION_LAMBDA,
   EXPAND_VARIABLE,
+  INTERSECT_EDGE,
+  INTERSECT_EXPAND,
   CONSTRUCT_NAMED_PATH,
   FILTER,
   PRODUCE,
@@ -56,15 +62,19 @@ enum class TypeId : uint64_t {
   MERGE,
   OPTIONAL,
   UNWIND,
+  UNWIND_MERGE,
   DISTINCT,
   UNION,
   CARTESIAN,
+  HASH_JOIN,
   OUTPUT_TABLE,
   OUTPUT_TABLE_STREAM,
   CALL_PROCEDURE,
   LOAD_CSV,
+  LOAD_ARROW,
   FOREACH,
   APPLY,
+  PERIODIC_COMMIT,
 
   // Replication
   REP_APPEND_DELTAS_REQ,
@@ -82,6 +92,12 @@ enum class TypeId : uint64_t {
   REP_TIMESTAMP_REQ,
   REP_TIMESTAMP_RES,
 
+  // Sharding
+  SHARD_EXPAND_REQ,
+  SHARD_EXPAND_RES,
+  SHARD_SCAN_REQ,
+  SHARD_SCAN_RES,
+
   // AST
   AST_LABELIX,
   AST_PROPERTYIX,
@@ -146,7 +162,12 @@ enum class TypeId : uint64_t {
   AST_CYPHER_QUERY,
   AST_EXPLAIN_QUERY,
   AST_PROFILE_QUERY,
+  AST_EXPORT_QUERY,
   AST_INDEX_QUERY,
+  AST_EDGE_INDEX_QUERY,
+  AST_TEXT_INDEX_QUERY,
+  AST_VECTOR_INDEX_QUERY,
+  AST_AGGREGATE_INDEX_QUERY,
   AST_CREATE,
   AST_CALL_PROCEDURE,
   AST_MATCH,
@@ -170,6 +191,7 @@ enum class TypeId : uint64_t {
   AST_REPLICATION_QUERY,
   AST_LOCK_PATH_QUERY,
   AST_LOAD_CSV,
+  AST_LOAD_ARROW,
   AST_FREE_MEMORY_QUERY,
   AST_TRIGGER_QUERY,
   AST_ISOLATION_LEVEL_QUERY,
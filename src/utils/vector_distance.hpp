@@ -0,0 +1,70 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+namespace memgraph::utils {
+
+/// Number of independent sums kept by the kernels below. The floating point
+/// additions can't be reordered by the compiler, so the separate sums are what
+/// lets it put the lanes of one SIMD register to use on any target.
+inline constexpr size_t kVectorKernelLanes = 8;
+
+/// Returns the dot product of two vectors of the same size.
+inline float DotProduct(std::span<const float> lhs, std::span<const float> rhs) {
+  std::array<float, kVectorKernelLanes> sums{};
+  const size_t size = lhs.size();
+  const size_t vectorized = size - size % kVectorKernelLanes;
+  for (size_t i = 0; i < vectorized; i += kVectorKernelLanes) {
+    for (size_t lane = 0; lane < kVectorKernelLanes; ++lane) {
+      sums[lane] += lhs[i + lane] * rhs[i + lane];
+    }
+  }
+  float result = 0;
+  for (size_t i = vectorized; i < size; ++i) {
+    result += lhs[i] * rhs[i];
+  }
+  for (const auto sum : sums) {
+    result += sum;
+  }
+  return result;
+}
+
+/// Scales the vector to unit length, so the cosine similarity of two
+/// normalized vectors is their dot product. The zero vector is left as is.
+inline void Normalize(std::span<float> vector) {
+  const auto norm = std::sqrt(DotProduct(vector, vector));
+  if (norm == 0) return;
+  for (auto &value : vector) {
+    value /= norm;
+  }
+}
+
+/// Returns the cosine distance, 1 minus the cosine similarity, of two
+/// normalized vectors of the same size.
+inline float NormalizedCosineDistance(std::span<const float> lhs, std::span<const float> rhs) {
+  return 1 - DotProduct(lhs, rhs);
+}
+
+/// Returns the cosine distance of two vectors of the same size. The distance
+/// to the zero vector is 1.
+inline float CosineDistance(std::span<const float> lhs, std::span<const float> rhs) {
+  const auto norms = std::sqrt(DotProduct(lhs, lhs) * DotProduct(rhs, rhs));
+  if (norms == 0) return 1;
+  return 1 - DotProduct(lhs, rhs) / norms;
+}
+
+}  // namespace memgraph::utils
@@ -0,0 +1,71 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstdint>
+
+#include "utils/event_histogram.hpp"
+#include "utils/tsc.hpp"
+
+namespace memgraph::utils {
+
+/// Lock which measures how long the threads waited to acquire it in the
+/// histogram returned by `TWait::Histogram()`. Only the acquisitions which
+/// find the lock taken are measured, so an uncontended acquisition costs a
+/// single `try_lock` of `TLock`.
+template <class TLock, class TWait>
+class WaitMeasuredLock {
+ public:
+  WaitMeasuredLock() = default;
+  WaitMeasuredLock(WaitMeasuredLock &&) noexcept = default;
+  WaitMeasuredLock &operator=(WaitMeasuredLock &&) noexcept = default;
+  WaitMeasuredLock(const WaitMeasuredLock &) = delete;
+  WaitMeasuredLock &operator=(const WaitMeasuredLock &) = delete;
+  ~WaitMeasuredLock() = default;
+
+  void lock() {
+    if (lock_.try_lock()) [[likely]] {
+      return;
+    }
+    const auto start = ReadTSC();
+    lock_.lock();
+    MeasureWait(start);
+  }
+
+  bool try_lock() { return lock_.try_lock(); }
+
+  void unlock() { lock_.unlock(); }
+
+  void lock_shared() {
+    if (lock_.try_lock_shared()) [[likely]] {
+      return;
+    }
+    const auto start = ReadTSC();
+    lock_.lock_shared();
+    MeasureWait(start);
+  }
+
+  bool try_lock_shared() { return lock_.try_lock_shared(); }
+
+  void unlock_shared() { lock_.unlock_shared(); }
+
+ private:
+  static void MeasureWait(uint64_t start) {
+    if (const auto wait = TSCCyclesToNanoseconds(ReadTSC() - start)) {
+      metrics::Measure(TWait::Histogram(), *wait);
+    }
+  }
+
+  TLock lock_;
+};
+
+}  // namespace memgraph::utils
@@ -10,14 +10,24 @@
 // licenses/APL.txt.
 
 #include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <gflags/gflags.h>
 
 #include "communication/result_stream_faker.hpp"
+#include "memory/memory_control.hpp"
 #include "query/config.hpp"
 #include "query/interpreter.hpp"
 #include "query/typed_value.hpp"
 #include "storage/v2/inmemory/storage.hpp"
 #include "storage/v2/isolation_level.hpp"
 
+// The runs with and without these flags show the effect of the page placement
+// on the scans and the expansions.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(huge_pages, false, "Back the graph with transparent huge pages.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(numa_interleave, false, "Interleave the pages of the graph across the NUMA nodes.");
+
 class ExpansionBenchFixture : public benchmark::Fixture {
  protected:
   std::optional<memgraph::query::InterpreterContext> interpreter_context;
@@ -87,8 +97,84 @@ BENCHMARK_REGISTER_F(ExpansionBenchFixture, Expand)
     ->Range(1, 1 << 20)
     ->Unit(benchmark::kMillisecond);
 
+// A ring of vertices, each connected to the next few ones, so the paths of
+// the variable expansions are long and return to the edges they already went
+// over.
+class VariableExpansionBenchFixture : public benchmark::Fixture {
+ protected:
+  static constexpr int kRingSize = 64;
+  static constexpr int kRingDegree = 3;
+
+  std::optional<memgraph::query::InterpreterContext> interpreter_context;
+  std::optional<memgraph::query::Interpreter> interpreter;
+  std::filesystem::path data_directory{std::filesystem::temp_directory_path() / "variable-expansion-benchmark"};
+
+  void SetUp(const benchmark::State &) override {
+    interpreter_context.emplace(memgraph::storage::Config{}, memgraph::query::InterpreterConfig{}, data_directory);
+    auto *db = interpreter_context->db.get();
+
+    auto label = db->NameToLabel("Starting");
+
+    {
+      auto dba = db->Access();
+      auto edge_type = dba->NameToEdgeType("edge_type");
+      std::vector<memgraph::storage::VertexAccessor> ring;
+      ring.reserve(kRingSize);
+      for (int i = 0; i < kRingSize; i++) ring.push_back(dba->CreateVertex());
+      MG_ASSERT(ring.front().AddLabel(label).HasValue());
+      for (int i = 0; i < kRingSize; i++) {
+        for (int j = 1; j <= kRingDegree; j++) {
+          MG_ASSERT(dba->CreateEdge(&ring[i], &ring[(i + j) % kRingSize], edge_type).HasValue());
+        }
+      }
+      MG_ASSERT(!dba->Commit().HasError());
+    }
+
+    MG_ASSERT(!db->CreateIndex(label).HasError());
+
+    interpreter.emplace(&*interpreter_context);
+  }
+
+  void TearDown(const benchmark::State &) override {
+    interpreter = std::nullopt;
+    interpreter_context = std::nullopt;
+    std::filesystem::remove_all(data_directory);
+  }
+};
+
+BENCHMARK_DEFINE_F(VariableExpansionBenchFixture, ExpandVariable)(benchmark::State &state) {
+  auto query = fmt::format("MATCH (s:Starting)-[*1..{}]-(d) RETURN count(d)", state.range(0));
+
+  while (state.KeepRunning()) {
+    ResultStreamFaker results(interpreter_context->db.get());
+    interpreter->Prepare(query, {}, nullptr);
+    interpreter->PullAll(&results);
+  }
+}
+
+BENCHMARK_REGISTER_F(VariableExpansionBenchFixture, ExpandVariable)
+    ->DenseRange(2, 8, 2)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(VariableExpansionBenchFixture, ExpandTwoVariable)(benchmark::State &state) {
+  // The edges of the two paths are checked for uniqueness between them too.
+  auto query = fmt::format("MATCH (s:Starting)-[*{0}]-(m)-[*{0}]-(d) RETURN count(d)", state.range(0));
+
+  while (state.KeepRunning()) {
+    ResultStreamFaker results(interpreter_context->db.get());
+    interpreter->Prepare(query, {}, nullptr);
+    interpreter->PullAll(&results);
+  }
+}
+
+BENCHMARK_REGISTER_F(VariableExpansionBenchFixture, ExpandTwoVariable)
+    ->DenseRange(1, 4, 1)
+    ->Unit(benchmark::kMillisecond);
+
 int main(int argc, char **argv) {
   ::benchmark::Initialize(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  memgraph::memory::SetPagePlacement({.huge_pages = FLAGS_huge_pages, .numa_interleave = FLAGS_numa_interleave});
   ::benchmark::RunSpecifiedBenchmarks();
   return 0;
 }
@@ -12,6 +12,7 @@
 #include <benchmark/benchmark.h>
 
 #include "query/db_accessor.hpp"
+#include "query/interpret/compiled_expression.hpp"
 #include "query/interpret/eval.hpp"
 #include "query/interpreter.hpp"
 #include "storage/v2/inmemory/storage.hpp"
@@ -90,4 +91,80 @@ BENCHMARK_TEMPLATE(AdditionOperator, NewDeleteResource)->Range(1024, 1U << 15U)-
 
 BENCHMARK_TEMPLATE(AdditionOperator, MonotonicBufferResource)->Range(1024, 1U << 15U)->Unit(benchmark::kMicrosecond);
 
+template <class TMemory>
+// NOLINTNEXTLINE(google-runtime-references)
+static void AdditionOperatorCompiled(benchmark::State &state) {
+  memgraph::query::AstStorage ast;
+  memgraph::query::SymbolTable symbol_table;
+  TMemory memory;
+  memgraph::query::Frame frame(symbol_table.max_position(), memory.get());
+  std::unique_ptr<memgraph::storage::Storage> db(new memgraph::storage::InMemoryStorage());
+  auto storage_dba = db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  memgraph::query::Expression *expr = ast.Create<memgraph::query::PrimitiveLiteral>(0);
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    expr = ast.Create<memgraph::query::AdditionOperator>(expr, ast.Create<memgraph::query::PrimitiveLiteral>(i));
+  }
+  memgraph::query::EvaluationContext evaluation_context{memory.get()};
+  memgraph::query::ExpressionEvaluator evaluator(&frame, symbol_table, evaluation_context, &dba,
+                                                 memgraph::storage::View::NEW);
+  memgraph::query::CompiledExpression compiled(expr, symbol_table, evaluation_context);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(compiled.Evaluate(frame, evaluator));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(AdditionOperatorCompiled, NewDeleteResource)->Range(1024, 1U << 15U)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(AdditionOperatorCompiled, MonotonicBufferResource)
+    ->Range(1024, 1U << 15U)
+    ->Unit(benchmark::kMicrosecond);
+
+// Evaluates `n.prop0 >= 0 AND n.prop1 >= 0 AND ...` on a single vertex, with
+// the evaluator when `compile` is false and with the compiled expression
+// otherwise.
+template <bool compile>
+// NOLINTNEXTLINE(google-runtime-references)
+static void PropertyFilter(benchmark::State &state) {
+  memgraph::query::AstStorage ast;
+  memgraph::query::SymbolTable symbol_table;
+  const auto symbol = symbol_table.CreateSymbol("n", true);
+  auto *identifier = ast.Create<memgraph::query::Identifier>("n");
+  identifier->MapTo(symbol);
+  MonotonicBufferResource memory;
+  memgraph::query::Frame frame(symbol_table.max_position(), memory.get());
+  std::unique_ptr<memgraph::storage::Storage> db(new memgraph::storage::InMemoryStorage());
+  auto storage_dba = db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  auto vertex = dba.InsertVertex();
+  memgraph::query::Expression *expr = nullptr;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    const auto name = "prop" + std::to_string(i);
+    MG_ASSERT(vertex.SetProperty(dba.NameToProperty(name), memgraph::storage::PropertyValue(i)).HasValue());
+    auto *filter = ast.Create<memgraph::query::GreaterEqualOperator>(
+        ast.Create<memgraph::query::PropertyLookup>(identifier, ast.GetPropertyIx(name)),
+        ast.Create<memgraph::query::PrimitiveLiteral>(0));
+    expr = expr ? ast.Create<memgraph::query::AndOperator>(expr, filter) : filter;
+  }
+  frame[symbol] = memgraph::query::TypedValue(vertex);
+  memgraph::query::EvaluationContext evaluation_context{memory.get()};
+  evaluation_context.properties = memgraph::query::NamesToProperties(ast.properties_, &dba);
+  memgraph::query::ExpressionEvaluator evaluator(&frame, symbol_table, evaluation_context, &dba,
+                                                 memgraph::storage::View::NEW);
+  memgraph::query::CompiledExpression compiled(expr, symbol_table, evaluation_context);
+  while (state.KeepRunning()) {
+    if constexpr (compile) {
+      benchmark::DoNotOptimize(compiled.Evaluate(frame, evaluator));
+    } else {
+      benchmark::DoNotOptimize(expr->Accept(evaluator));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(PropertyFilter, false)->Range(1, 64)->Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(PropertyFilter, true)->Range(1, 64)->Unit(benchmark::kNanosecond);
+
 BENCHMARK_MAIN();
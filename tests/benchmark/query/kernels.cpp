@@ -0,0 +1,90 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "query/interpret/kernels.hpp"
+#include "query/typed_value.hpp"
+
+// The kernels are compared with the same operations on TypedValues, which is
+// how the operators compute them for each row.
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void CompareTypedValues(benchmark::State &state) {
+  std::vector<memgraph::query::TypedValue> values;
+  for (int64_t i = 0; i < state.range(0); ++i) values.emplace_back(i);
+  const memgraph::query::TypedValue constant(state.range(0) / 2);
+  std::vector<uint8_t> out(values.size());
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < values.size(); ++i) out[i] = (values[i] < constant).ValueBool();
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(CompareTypedValues)->Range(256, 4096)->Unit(benchmark::kNanosecond);
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void CompareKernel(benchmark::State &state) {
+  std::vector<int64_t> values;
+  for (int64_t i = 0; i < state.range(0); ++i) values.push_back(i);
+  std::vector<uint8_t> out(values.size());
+  while (state.KeepRunning()) {
+    memgraph::query::kernels::Compare(memgraph::query::kernels::Comparison::LESS, values.data(), values.size(),
+                                      state.range(0) / 2, false, out.data());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(CompareKernel)->Range(256, 4096)->Unit(benchmark::kNanosecond);
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void SumTypedValues(benchmark::State &state) {
+  std::vector<memgraph::query::TypedValue> values;
+  for (int64_t i = 0; i < state.range(0); ++i) values.emplace_back(i);
+  while (state.KeepRunning()) {
+    memgraph::query::TypedValue sum(0);
+    for (const auto &value : values) sum = sum + value;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(SumTypedValues)->Range(256, 4096)->Unit(benchmark::kNanosecond);
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void SumKernel(benchmark::State &state) {
+  std::vector<int64_t> values;
+  for (int64_t i = 0; i < state.range(0); ++i) values.push_back(i);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(memgraph::query::kernels::Sum(values.data(), values.size()));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(SumKernel)->Range(256, 4096)->Unit(benchmark::kNanosecond);
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void MinKernel(benchmark::State &state) {
+  std::vector<double> values;
+  for (int64_t i = 0; i < state.range(0); ++i) values.push_back(static_cast<double>((i * 7919) % 1000));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(memgraph::query::kernels::Min(1000.0, values.data(), values.size()));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(MinKernel)->Range(256, 4096)->Unit(benchmark::kNanosecond);
+
+BENCHMARK_MAIN();
@@ -9,8 +9,11 @@
 // by the Apache License, Version 2.0, included in the file
 // licenses/APL.txt.
 
+#include <memory>
 #include <optional>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -77,6 +80,61 @@ static void BenchmarkRpcPool(benchmark::State &state) {
   state.SetItemsProcessed(state.iterations());
 }
 
+static void BenchmarkRpcLarge(benchmark::State &state) {
+  std::string data(state.range(0), 'a');
+  while (state.KeepRunning()) {
+    clients[state.thread_index()]->Call<Echo>(data);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Serializes and deserializes a large string in memory. The
+// first argument is the size of the string and the second one selects the
+// scatter-gather builder and the reader views instead of the copies.
+static void BenchmarkSlk(benchmark::State &state) {
+  std::string data(state.range(0), 'a');
+  const bool scatter_gather = state.range(1) != 0;
+  std::vector<uint8_t> stream;
+  stream.reserve(data.size() + memgraph::slk::kSegmentMaxTotalSize);
+  // The stream the reader loads is built once, the builder in the loop only
+  // counts the written bytes.
+  memgraph::slk::Builder stream_builder(
+      [&stream](const uint8_t *segment, size_t size, bool) { stream.insert(stream.end(), segment, segment + size); });
+  memgraph::slk::Save(data, &stream_builder);
+  stream_builder.Finalize();
+
+  uint64_t written = 0;
+  memgraph::slk::Builder::VectorWriteFunction vector_write;
+  if (scatter_gather) {
+    vector_write = [&written](const iovec *iov, size_t iovcnt, bool) {
+      for (size_t i = 0; i < iovcnt; ++i) written += iov[i].iov_len;
+    };
+  }
+  auto builder = std::make_unique<memgraph::slk::Builder>(
+      [&written](const uint8_t *, size_t size, bool) { written += size; }, memgraph::slk::Builder::FileWriteFunction{},
+      vector_write);
+  std::string storage;
+  while (state.KeepRunning()) {
+    memgraph::slk::Save(data, builder.get());
+    builder->Finalize();
+
+    memgraph::slk::Reader reader(stream.data(), stream.size());
+    if (scatter_gather) {
+      std::string_view view;
+      memgraph::slk::LoadView(&view, &storage, &reader);
+      benchmark::DoNotOptimize(view);
+    } else {
+      std::string loaded;
+      memgraph::slk::Load(&loaded, &reader);
+      benchmark::DoNotOptimize(loaded);
+    }
+    reader.Finalize();
+  }
+  benchmark::DoNotOptimize(written);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
 BENCHMARK(BenchmarkRpc)
     ->RangeMultiplier(4)
     ->Range(4, 1 << 13)
@@ -91,6 +149,18 @@ BENCHMARK(BenchmarkRpcPool)
     ->Unit(benchmark::kNanosecond)
     ->UseRealTime();
 
+BENCHMARK(BenchmarkRpcLarge)
+    ->RangeMultiplier(4)
+    ->Range(1 << 14, 1 << 22)
+    ->ThreadRange(1, 4)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+BENCHMARK(BenchmarkSlk)
+    ->RangeMultiplier(16)
+    ->Ranges({{1 << 10, 1 << 22}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
 int main(int argc, char **argv) {
   ::benchmark::Initialize(&argc, argv);
   gflags::AllowCommandLineReparsing();
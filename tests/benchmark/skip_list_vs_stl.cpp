@@ -9,10 +9,14 @@
 // by the Apache License, Version 2.0, included in the file
 // licenses/APL.txt.
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <map>
+#include <numeric>
+#include <random>
 #include <set>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -57,6 +61,36 @@ BENCHMARK_REGISTER_F(SkipListSetInsertFixture, Insert)
     ->Unit(benchmark::kNanosecond)
     ->UseRealTime();
 
+///////////////////////////////////////////////////////////////////////////////
+// memgraph::utils::SkipList set sorted bulk load (e.g. snapshot recovery)
+///////////////////////////////////////////////////////////////////////////////
+
+static void SkipListSetSortedInsert(benchmark::State &state) {
+  for (auto _ : state) {
+    memgraph::utils::SkipList<uint64_t> list;
+    auto acc = list.access();
+    for (uint64_t i = 0; i < static_cast<uint64_t>(state.range(0)); ++i) {
+      acc.insert(i);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void SkipListSetSortedInsertWithHint(benchmark::State &state) {
+  for (auto _ : state) {
+    memgraph::utils::SkipList<uint64_t> list;
+    auto acc = list.access();
+    memgraph::utils::SkipList<uint64_t>::InsertHint hint;
+    for (uint64_t i = 0; i < static_cast<uint64_t>(state.range(0)); ++i) {
+      acc.insert(hint, i);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(SkipListSetSortedInsert)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(SkipListSetSortedInsertWithHint)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
 ///////////////////////////////////////////////////////////////////////////////
 // std::set Insert
 ///////////////////////////////////////////////////////////////////////////////
@@ -459,4 +493,64 @@ BENCHMARK_REGISTER_F(StdMapWithPoolAllocatorFindFixture, Find)
     ->Unit(benchmark::kNanosecond)
     ->UseRealTime();
 
+///////////////////////////////////////////////////////////////////////////////
+// memgraph::utils::SkipList set full scan
+///////////////////////////////////////////////////////////////////////////////
+
+// The lists are filled in random order so that neighbouring nodes aren't
+// neighbours in memory, the same as `vertices_` after a while.
+std::vector<uint64_t> ShuffledRange(uint64_t size) {
+  std::vector<uint64_t> values(size);
+  std::iota(values.begin(), values.end(), 0);
+  std::shuffle(values.begin(), values.end(), std::mt19937(42));
+  return values;
+}
+
+static void SkipListSetScan(benchmark::State &state) {
+  memgraph::utils::SkipList<uint64_t> list;
+  {
+    auto acc = list.access();
+    for (auto value : ShuffledRange(state.range(0))) acc.insert(value);
+  }
+  for (auto _ : state) {
+    auto acc = list.access();
+    uint64_t sum = 0;
+    for (auto value : acc) sum += value;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void StdSetScan(benchmark::State &state) {
+  std::set<uint64_t> container;
+  for (auto value : ShuffledRange(state.range(0))) container.insert(value);
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    for (auto value : container) sum += value;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Same as above, but the list is filled in order, so neighbouring nodes are
+// mostly allocated next to each other.
+static void SkipListSetScanSortedFill(benchmark::State &state) {
+  memgraph::utils::SkipList<uint64_t> list;
+  {
+    auto acc = list.access();
+    for (uint64_t i = 0; i < static_cast<uint64_t>(state.range(0)); ++i) acc.insert(i);
+  }
+  for (auto _ : state) {
+    auto acc = list.access();
+    uint64_t sum = 0;
+    for (auto value : acc) sum += value;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(SkipListSetScan)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(SkipListSetScanSortedFill)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(StdSetScan)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_MAIN();
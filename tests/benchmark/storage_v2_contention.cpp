@@ -0,0 +1,209 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <variant>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "storage/v2/inmemory/storage.hpp"
+#include "storage/v2/property_value.hpp"
+#include "storage/v2/storage.hpp"
+#include "utils/logging.hpp"
+
+// Commit throughput of concurrent write transactions. Every thread runs one
+// transaction per iteration against the same storage, so the results show
+// how the commit path scales and how often the transactions which write the
+// same vertices fail with a serialization error.
+
+namespace {
+
+const int kMaxThreads = 16;
+
+// The storage is shared by all the threads of a benchmark run. It's created
+// and destroyed by the first thread outside of the timed loop, which all the
+// threads enter and leave together, so the other threads may use it only
+// inside of the loop.
+std::unique_ptr<memgraph::storage::Storage> storage;
+std::vector<memgraph::storage::Gid> hot_vertices;
+memgraph::storage::EdgeTypeId edge_type;
+memgraph::storage::PropertyId property;
+
+const auto kDurabilityDirectory = std::filesystem::temp_directory_path() / "MG_benchmark_storage_v2_contention";
+
+void SetUpStorage(const benchmark::State &state, memgraph::storage::Config config, const int64_t num_hot_vertices) {
+  if (state.thread_index() != 0) return;
+  storage = std::make_unique<memgraph::storage::InMemoryStorage>(std::move(config));
+  edge_type = storage->NameToEdgeType("EDGE");
+  property = storage->NameToProperty("property");
+  auto acc = storage->Access();
+  hot_vertices.clear();
+  for (int64_t i = 0; i < num_hot_vertices; ++i) {
+    hot_vertices.push_back(acc->CreateVertex().Gid());
+  }
+  MG_ASSERT(!acc->Commit().HasError());
+}
+
+void TearDownStorage(const benchmark::State &state) {
+  if (state.thread_index() != 0) return;
+  storage.reset();
+  hot_vertices.clear();
+  std::filesystem::remove_all(kDurabilityDirectory);
+}
+
+bool IsSerializationError(const memgraph::storage::StorageDataManipulationError &error) {
+  return std::holds_alternative<memgraph::storage::SerializationError>(error);
+}
+
+// Reports the committed transactions as items and the transactions which
+// failed with a serialization error as `conflicts`.
+void ReportCommits(benchmark::State &state, const int64_t commits, const int64_t conflicts) {
+  state.SetItemsProcessed(commits);
+  state.counters["conflicts"] = benchmark::Counter(static_cast<double>(conflicts));
+  state.counters["conflict_rate"] =
+      benchmark::Counter(static_cast<double>(conflicts) / static_cast<double>(std::max<int64_t>(state.iterations(), 1)),
+                         benchmark::Counter::kAvgThreads);
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void CreateVertex(benchmark::State &state) {
+  SetUpStorage(state, {}, 0);
+  int64_t commits = 0;
+  for (auto _ : state) {
+    auto acc = storage->Access();
+    benchmark::DoNotOptimize(acc->CreateVertex());
+    MG_ASSERT(!acc->Commit().HasError());
+    ++commits;
+  }
+  ReportCommits(state, commits, 0);
+  TearDownStorage(state);
+}
+
+// Every transaction connects two random vertices out of `state.range(0)` hot
+// vertices. Creating an edge writes both of its vertices, so the fewer hot
+// vertices there are, the more transactions conflict.
+// NOLINTNEXTLINE(google-runtime-references)
+static void CreateEdgeBetweenHotVertices(benchmark::State &state) {
+  SetUpStorage(state, {}, state.range(0));
+  std::mt19937 gen(state.thread_index());
+  std::uniform_int_distribution<size_t> vertex_dist(0, static_cast<size_t>(state.range(0)) - 1);
+  int64_t commits = 0;
+  int64_t conflicts = 0;
+  for (auto _ : state) {
+    auto acc = storage->Access();
+    auto from = acc->FindVertex(hot_vertices[vertex_dist(gen)], memgraph::storage::View::OLD);
+    auto to = acc->FindVertex(hot_vertices[vertex_dist(gen)], memgraph::storage::View::OLD);
+    MG_ASSERT(from && to);
+    auto edge = acc->CreateEdge(&*from, &*to, edge_type);
+    if (edge.HasError()) {
+      MG_ASSERT(edge.GetError() == memgraph::storage::Error::SERIALIZATION_ERROR);
+      acc->Abort();
+      ++conflicts;
+      continue;
+    }
+    auto result = acc->Commit();
+    if (result.HasError()) {
+      MG_ASSERT(IsSerializationError(result.GetError()));
+      ++conflicts;
+      continue;
+    }
+    ++commits;
+  }
+  ReportCommits(state, commits, conflicts);
+  TearDownStorage(state);
+}
+
+// Every transaction sets a property of a random vertex out of `state.range(0)`
+// shared vertices.
+// NOLINTNEXTLINE(google-runtime-references)
+static void SetPropertyOnSharedVertices(benchmark::State &state) {
+  SetUpStorage(state, {}, state.range(0));
+  std::mt19937 gen(state.thread_index());
+  std::uniform_int_distribution<size_t> vertex_dist(0, static_cast<size_t>(state.range(0)) - 1);
+  int64_t commits = 0;
+  int64_t conflicts = 0;
+  for (auto _ : state) {
+    auto acc = storage->Access();
+    auto vertex = acc->FindVertex(hot_vertices[vertex_dist(gen)], memgraph::storage::View::OLD);
+    MG_ASSERT(vertex);
+    auto old_value = vertex->SetProperty(property, memgraph::storage::PropertyValue(commits));
+    if (old_value.HasError()) {
+      MG_ASSERT(old_value.GetError() == memgraph::storage::Error::SERIALIZATION_ERROR);
+      acc->Abort();
+      ++conflicts;
+      continue;
+    }
+    auto result = acc->Commit();
+    if (result.HasError()) {
+      MG_ASSERT(IsSerializationError(result.GetError()));
+      ++conflicts;
+      continue;
+    }
+    ++commits;
+  }
+  ReportCommits(state, commits, conflicts);
+  TearDownStorage(state);
+}
+
+// Commits a transaction which creates a vertex with a property with
+// `state.range(0)` selecting the durability: 0 without the WAL, 1 with the WAL
+// and 2 with the WAL and group commit, where every commit waits for `fsync`.
+// NOLINTNEXTLINE(google-runtime-references)
+static void CommitWithWal(benchmark::State &state) {
+  memgraph::storage::Config config;
+  if (state.range(0) > 0) {
+    if (state.thread_index() == 0) std::filesystem::remove_all(kDurabilityDirectory);
+    config.durability.storage_directory = kDurabilityDirectory;
+    config.durability.snapshot_wal_mode =
+        memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL;
+    // Only the WAL is measured.
+    config.durability.snapshot_interval = std::chrono::hours(24);
+    config.durability.wal_group_commit = state.range(0) == 2;
+  }
+  SetUpStorage(state, std::move(config), 0);
+  int64_t commits = 0;
+  for (auto _ : state) {
+    auto acc = storage->Access();
+    auto vertex = acc->CreateVertex();
+    MG_ASSERT(vertex.SetProperty(property, memgraph::storage::PropertyValue(commits)).HasValue());
+    MG_ASSERT(!acc->Commit().HasError());
+    ++commits;
+  }
+  ReportCommits(state, commits, 0);
+  TearDownStorage(state);
+}
+
+BENCHMARK(CreateVertex)->ThreadRange(1, kMaxThreads)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK(CreateEdgeBetweenHotVertices)
+    ->RangeMultiplier(16)
+    ->Range(1, 1 << 12)
+    ->ThreadRange(1, kMaxThreads)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+BENCHMARK(SetPropertyOnSharedVertices)
+    ->RangeMultiplier(16)
+    ->Range(1, 1 << 12)
+    ->ThreadRange(1, kMaxThreads)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+BENCHMARK(CommitWithWal)->DenseRange(0, 2)->ThreadRange(1, kMaxThreads)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_MAIN();
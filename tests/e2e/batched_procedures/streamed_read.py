@@ -0,0 +1,62 @@
+# Copyright 2023 Memgraph Ltd.
+#
+# Use of this software is governed by the Business Source License
+# included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+# License, and you may not use this file except in compliance with the Business Source License.
+#
+# As of the Change Date specified in that file, in accordance with
+# the Business Source License, use of this software will be governed
+# by the Apache License, Version 2.0, included in the file
+# licenses/APL.txt.
+
+# isort: off
+import sys
+import pytest
+
+from common import execute_and_fetch_all
+from conftest import get_connection
+from mgclient import DatabaseError
+
+# More records than fit into the default result buffer of a procedure call.
+NUM_RECORDS = 2500
+
+
+def test_all_records_are_streamed(connection):
+    cursor = connection.cursor()
+    result = execute_and_fetch_all(cursor, f"CALL stream_py_read.numbers({NUM_RECORDS}) YIELD output RETURN output")
+    assert [row[0] for row in result] == list(range(NUM_RECORDS))
+
+
+def test_stream_stops_when_no_longer_pulled(connection):
+    cursor = connection.cursor()
+    result = execute_and_fetch_all(
+        cursor, f"CALL stream_py_read.numbers({NUM_RECORDS}) YIELD output RETURN output LIMIT 3"
+    )
+    assert [row[0] for row in result] == [0, 1, 2]
+    # The connection can run the next query after the interrupted call.
+    assert execute_and_fetch_all(cursor, "CALL stream_py_read.numbers(2) YIELD output RETURN count(*)") == [(2,)]
+
+
+def test_nested_streamed_calls(connection):
+    cursor = connection.cursor()
+    result = execute_and_fetch_all(
+        cursor,
+        f"CALL stream_py_read.numbers({NUM_RECORDS}) YIELD output WITH output "
+        "CALL stream_py_read.numbers(2) YIELD output AS inner "
+        "CALL mg.procedures() YIELD name WITH name WHERE name = 'stream_py_read.numbers' "
+        "RETURN count(*)",
+    )
+    assert result == [(2 * NUM_RECORDS,)]
+
+
+def test_error_after_streamed_records(connection):
+    cursor = connection.cursor()
+    with pytest.raises(DatabaseError):
+        execute_and_fetch_all(cursor, f"CALL stream_py_read.fail_after({NUM_RECORDS}) YIELD output RETURN output")
+    connection = get_connection()
+    cursor = connection.cursor()
+    assert execute_and_fetch_all(cursor, "CALL stream_py_read.numbers(2) YIELD output RETURN count(*)") == [(2,)]
+
+
+if __name__ == "__main__":
+    sys.exit(pytest.main([__file__, "-rA"]))
@@ -0,0 +1,39 @@
+import multiprocessing
+import sys
+
+import mgclient
+import pytest
+
+query = "CALL libmodule_test.hacker_news(1, 2, 1.0) YIELD score RETURN score;"
+number_of_clients = 8
+
+
+def call_module(barrier, results):
+    connection = mgclient.connect(host="127.0.0.1", port=7687)
+    connection.autocommit = True
+    cursor = connection.cursor()
+    # All clients make the first call of the module at the same time, so they
+    # all wait for the same load.
+    barrier.wait()
+    cursor.execute(query)
+    results.put(cursor.fetchall())
+
+
+def test_concurrent_first_calls_load_module_once():
+    barrier = multiprocessing.Barrier(number_of_clients)
+    results = multiprocessing.Queue()
+    clients = [
+        multiprocessing.Process(target=call_module, args=(barrier, results)) for _ in range(number_of_clients)
+    ]
+    for client in clients:
+        client.start()
+    for client in clients:
+        client.join()
+        assert client.exitcode == 0
+
+    for _ in range(number_of_clients):
+        assert results.get(timeout=1) == [(250000.0,)]
+
+
+if __name__ == "__main__":
+    sys.exit(pytest.main([__file__, "-rA"]))
@@ -0,0 +1,21 @@
+import sys
+
+import mgclient
+import pytest
+
+query = "CALL libmodule_test.hacker_news(1, 2, 1.0) YIELD score RETURN score;"
+
+
+def test_first_call_loads_module():
+    connection = mgclient.connect(host="127.0.0.1", port=7687)
+    connection.autocommit = True
+    cursor = connection.cursor()
+    # The module is only registered at startup, the first call loads it.
+    cursor.execute(query)
+    assert cursor.fetchall() == [(250000.0,)]
+    cursor.execute(query)
+    assert cursor.fetchall() == [(250000.0,)]
+
+
+if __name__ == "__main__":
+    sys.exit(pytest.main([__file__, "-rA"]))
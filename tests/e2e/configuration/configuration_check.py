@@ -39,6 +39,7 @@ def test_does_default_config_match():
 
         # The default value of these is dependent on the given machine.
         machine_dependent_configurations = [
+            "bolt_num_io_workers",
             "bolt_num_workers",
             "data_directory",
             "log_file",
@@ -34,6 +34,16 @@ startup_config_dict = {
         "The regular expression that should be used to match the entire entered password to ensure its strength.",
     ),
     "allow_load_csv": ("true", "true", "Controls whether LOAD CSV clause is allowed in queries."),
+    "arrow_address": (
+        "0.0.0.0",
+        "0.0.0.0",
+        "IP address on which the HTTP server returning query results in the Arrow format should listen.",
+    ),
+    "arrow_port": (
+        "0",
+        "0",
+        "Port on which the HTTP server returning query results in the Arrow format should listen. The server isn't started if the port is 0.",
+    ),
     "audit_buffer_flush_interval_ms": (
         "200",
         "200",
@@ -41,20 +51,55 @@ startup_config_dict = {
     ),
     "audit_buffer_size": ("100000", "100000", "Maximum number of items in the audit log buffer."),
     "audit_enabled": ("false", "false", "Set to true to enable audit logging."),
+    "audit_overload_policy": (
+        "BLOCK",
+        "BLOCK",
+        "What to do with new audit log entries when the audit log buffer is full. BLOCK waits until the buffer is flushed, DROP drops the entries. Allowed values: BLOCK, DROP",
+    ),
     "auth_user_or_role_name_regex": (
         "[a-zA-Z0-9_.+-@]+",
         "[a-zA-Z0-9_.+-@]+",
         "Set to the regular expression that each user or role name must fulfill.",
     ),
     "bolt_address": ("0.0.0.0", "0.0.0.0", "IP address on which the Bolt server should listen."),
+    "bolt_allow_compression": (
+        "true",
+        "true",
+        "Allow the Bolt clients to request zlib compression of the messages which they receive with the 'compression' field of the HELLO message.",
+    ),
     "bolt_cert_file": ("", "", "Certificate file which should be used for the Bolt server."),
+    "bolt_io_thread_per_core": (
+        "false",
+        "false",
+        "Run each of the --bolt-num-io-workers workers on its own core with its own listener, which shares the Bolt port through SO_REUSEPORT. A connection is then handled by the core that accepted it.",
+    ),
     "bolt_key_file": ("", "", "Key file which should be used for the Bolt server."),
+    "bolt_long_execution_threshold_ms": (
+        "100",
+        "100",
+        "Time in milliseconds after which the execution of a Bolt message counts as long. The next messages of such a session are executed after the short ones and on at most three quarters of the workers.",
+    ),
+    "bolt_num_io_workers": (
+        "3",
+        "3",
+        "Number of workers which do the network I/O of the Bolt server, while the queries are executed by the --bolt-num-workers workers. By default, this will be a quarter of the number of processing units available on the machine.",
+    ),
     "bolt_num_workers": (
         "12",
         "12",
-        "Number of workers used by the Bolt server. By default, this will be the number of processing units available on the machine.",
+        "Number of workers which execute the queries of the Bolt server. By default, this will be the number of processing units available on the machine.",
+    ),
+    "bolt_pin_workers_to_numa_nodes": (
+        "false",
+        "false",
+        "Pin the --bolt-num-workers workers to the NUMA nodes in turns, so each of them runs on the cores of a single socket.",
     ),
     "bolt_port": ("7687", "7687", "Port on which the Bolt server should listen."),
+    "bolt_pull_buffer_size": (
+        "1048576",
+        "1048576",
+        "Number of bytes of records which a session produces ahead while the previous records of a PULL are sent to the client. If 0, the records are produced and sent one after another.",
+    ),
     "bolt_server_name_for_init": (
         "",
         "",
@@ -65,6 +110,16 @@ startup_config_dict = {
         "1800",
         "Time in seconds after which inactive Bolt sessions will be closed.",
     ),
+    "bolt_tls_kernel_offload": (
+        "false",
+        "false",
+        "Let the kernel encrypt the SSL connections of the Bolt server (kTLS), if both the OpenSSL library and the kernel support it.",
+    ),
+    "bolt_tls_session_timeout_sec": (
+        "300",
+        "300",
+        "Time in seconds for which the clients of the Bolt server can resume their SSL sessions instead of doing the full handshake. 0 disables the resumption.",
+    ),
     "data_directory": ("mg_data", "mg_data", "Path to directory in which to save all permanent data."),
     "data_recovery_on_startup": (
         "false",
@@ -76,22 +131,52 @@ startup_config_dict = {
         "SNAPSHOT_ISOLATION",
         "Default isolation level used for the transactions. Allowed values: SNAPSHOT_ISOLATION, READ_COMMITTED, READ_UNCOMMITTED",
     ),
+    "kafka_adaptive_batching": (
+        "false",
+        "false",
+        "Tune the size and the interval of the batches of the Kafka streams from the processing latency and the consumer lag. The batch size and interval of a stream are the starting point, and the interval is never longer than the one of the stream.",
+    ),
+    "kafka_adaptive_batching_max_size": (
+        "10000",
+        "10000",
+        "Largest batch size of the Kafka streams when --kafka-adaptive-batching is enabled.",
+    ),
+    "kafka_adaptive_batching_target_latency_ms": (
+        "1000",
+        "1000",
+        "Processing latency in milliseconds above which the batches of the Kafka streams are made smaller when --kafka-adaptive-batching is enabled.",
+    ),
     "kafka_bootstrap_servers": (
         "",
         "",
         "List of default Kafka brokers as a comma separated list of broker host or host:port.",
     ),
+    "kafka_partition_workers": (
+        "1",
+        "1",
+        "Number of workers which process the batches of the newly created Kafka streams in parallel. The messages of a partition are always processed in order by the same worker, in a separate transaction from the messages of the partitions processed by the other workers.",
+    ),
     "log_file": ("", "", "Path to where the log should be stored."),
     "log_level": (
         "WARNING",
         "TRACE",
         "Minimum log level. Allowed values: TRACE, DEBUG, INFO, WARNING, ERROR, CRITICAL",
     ),
+    "memory_huge_pages": (
+        "false",
+        "false",
+        "Advise the kernel to back the memory which the allocator maps from now on with transparent huge pages, which reduces the TLB misses of the random accesses to the graph. Has an effect only if the transparent huge pages are enabled in the madvise or the always mode.",
+    ),
     "memory_limit": (
         "0",
         "0",
         "Total memory limit in MiB. Set to 0 to use the default values which are 100% of the phyisical memory if the swap is enabled and 90% of the physical memory otherwise.",
     ),
+    "memory_numa_interleave": (
+        "false",
+        "false",
+        "Interleave the pages of the memory which the allocator maps from now on across all NUMA nodes, so the accesses to the graph from all sockets see the same average latency.",
+    ),
     "memory_warning_threshold": (
         "1024",
         "1024",
@@ -114,8 +199,70 @@ startup_config_dict = {
         "false",
         "Controls whether the index creation can be done in a multithreaded fashion.",
     ),
+    "storage_parallel_wal_recovery": (
+        "false",
+        "false",
+        "Controls whether the WAL files are read and applied in a multithreaded fashion during recovery, using "
+        "'storage_recovery_thread_count' threads.",
+    ),
+    "storage_parallel_snapshot_creation": (
+        "false",
+        "false",
+        "Controls whether the snapshots are written in a multithreaded fashion, using "
+        "'storage_recovery_thread_count' threads.",
+    ),
     "password_encryption_algorithm": ("bcrypt", "bcrypt", "The password encryption algorithm used for authentication."),
     "pulsar_service_url": ("", "", "Default URL used while connecting to Pulsar brokers."),
+    "query_admission_default_memory_mb": (
+        "100",
+        "100",
+        "Memory in MiB reserved for admission control by a query without a QUERY MEMORY LIMIT.",
+    ),
+    "query_admission_max_concurrent": (
+        "0",
+        "0",
+        "Maximum number of queries executed on a database at the same time, further queries wait until they are admitted. Value of 0 means no limit.",
+    ),
+    "query_admission_max_concurrent_per_user": (
+        "0",
+        "0",
+        "Maximum number of queries of a single user executed on a database at the same time. Value of 0 means no limit.",
+    ),
+    "query_admission_max_memory_mb": (
+        "0",
+        "0",
+        "Maximum memory in MiB reserved by the queries executed on a database at the same time. A query reserves its QUERY MEMORY LIMIT or --query-admission-default-memory-mb. Value of 0 means no limit.",
+    ),
+    "query_admission_max_memory_per_user_mb": (
+        "0",
+        "0",
+        "Maximum memory in MiB reserved by the queries of a single user executed on a database at the same time. Value of 0 means no limit.",
+    ),
+    "query_admission_queue_size": (
+        "1000",
+        "1000",
+        "Maximum number of queries waiting to be admitted on a database. Further queries fail at once.",
+    ),
+    "query_admission_timeout_ms": (
+        "10000",
+        "10000",
+        "Maximum time in milliseconds a query waits to be admitted for execution. The query fails afterwards.",
+    ),
+    "query_bookmark_wait_timeout_ms": (
+        "10000",
+        "10000",
+        "Maximum time a transaction waits for the instance to apply the transaction referenced by the client's bookmark, e.g. when a REPLICA is behind the MAIN. The transaction fails afterwards.",
+    ),
+    "query_database_memory_limit_mb": (
+        "0",
+        "0",
+        "Memory in MiB the queries running on a single database may allocate for their execution together. Queries going over the limit are aborted. Value of 0 means no limit.",
+    ),
+    "query_commutative_increments": (
+        "false",
+        "false",
+        "Makes SET n.p = n.p + x add to the vertex property when the transaction commits, so the transactions incrementing the same property don't conflict with each other. The transaction doesn't see its own increments, and they aren't passed to the triggers.",
+    ),
     "query_execution_timeout_sec": (
         "600",
         "600",
@@ -126,26 +273,183 @@ startup_config_dict = {
         "",
         "Directory where modules with custom query procedures are stored. NOTE: Multiple comma-separated directories can be defined.",
     ),
+    "query_parallel_execution_threads": (
+        "0",
+        "0",
+        "Maximum number of threads used by a query with the USING PARALLEL EXECUTION hint. Value of 0 means the number of hardware threads.",
+    ),
+    "query_procedure_result_buffer_size": (
+        "1000",
+        "1000",
+        "Number of records a read procedure may yield before it is suspended until the query pulls them. Value of 0 means that each procedure call keeps all of its records in memory.",
+    ),
+    "query_slow_log_size": ("100", "100", "Number of the most recent slow queries kept in the slow query log."),
+    "query_slow_log_threshold_ms": (
+        "0",
+        "0",
+        "Queries which execute longer are logged with their plans and returned by mg.slow_queries(). The next execution of a logged query is profiled. Value of 0 disables the slow query log.",
+    ),
+    "query_stats_max_queries": (
+        "1000",
+        "1000",
+        "Number of distinct queries whose execution statistics are returned by mg.query_stats(). The query with the fewest executions is dropped to make room for a new one. Value of 0 disables the statistics.",
+    ),
+    "query_transaction_memory_limit_mb": (
+        "0",
+        "0",
+        "Memory in MiB a single transaction may allocate, counting both its query execution and the storage objects it creates. Transactions going over the limit are aborted. Value of 0 means no limit.",
+    ),
+    "replication_compression": (
+        "false",
+        "false",
+        "Compress the snapshot and WAL files sent to REPLICA instances while they are being recovered. Applies to replicas registered while the flag is set.",
+    ),
+    "replication_max_retained_wal_files": (
+        "100",
+        "100",
+        "Maximum number of WAL files older than the oldest snapshot that are kept because a REPLICA still needs them. Such replicas are recovered from the WAL files instead of the whole snapshot.",
+    ),
     "replication_replica_check_frequency_sec": (
         "1",
         "1",
         "The time duration between two replica checks/pings. If < 1, replicas will NOT be checked at all. NOTE: The MAIN instance allocates a new thread for each REPLICA.",
     ),
+    "replication_sync_quorum": (
+        "0",
+        "0",
+        "Number of SYNC replicas that have to confirm a transaction before its commit is acknowledged. The remaining SYNC replicas are replicated to in the background. Value of 0 waits for all SYNC replicas.",
+    ),
+    "storage_async_writeback": (
+        "false",
+        "false",
+        "Controls whether the WAL files are preallocated and whether the WAL and snapshot data is written back to the disk in the background as soon as it is written to the files, so that the syncs have less work left.",
+    ),
+    "storage_defragmentation_budget": (
+        "0",
+        "0",
+        "The number of vertices and edges whose property buffers are moved out of the sparsely used memory extents in each background defragmentation pass. Value of 0 disables the defragmentation.",
+    ),
+    "storage_defragmentation_interval_sec": (
+        "10",
+        "10",
+        "Interval (in seconds) of the background memory defragmentation passes.",
+    ),
+    "storage_disk_block_cache_size_mib": (
+        "0",
+        "0",
+        "Size of the RocksDB block cache shared by the vertices and edges of the ON_DISK_TRANSACTIONAL storage mode. Value of 0 keeps the RocksDB default.",
+    ),
+    "storage_disk_bloom_filter_bits_per_key": (
+        "0",
+        "0",
+        "Bits per key of the RocksDB bloom filters used by the ON_DISK_TRANSACTIONAL storage mode, e.g. 10 for about 1% false positives. Value of 0 disables the bloom filters.",
+    ),
+    "storage_disk_object_cache_size": (
+        "0",
+        "0",
+        "Number of committed vertices, and separately of committed edges, of the ON_DISK_TRANSACTIONAL storage mode kept in memory between transactions. Value of 0 disables the cache.",
+    ),
+    "storage_disk_pipelined_write": (
+        "false",
+        "false",
+        "Controls whether the ON_DISK_TRANSACTIONAL storage mode uses RocksDB pipelined writes, which overlap the WAL and memtable writes of concurrent commits.",
+    ),
+    "storage_disk_universal_compaction": (
+        "false",
+        "false",
+        "Controls whether the ON_DISK_TRANSACTIONAL storage mode uses RocksDB universal compaction instead of level compaction.",
+    ),
     "storage_gc_cycle_sec": ("30", "30", "Storage garbage collector interval (in seconds)."),
+    "storage_gc_threads": ("1", "1", "Number of threads used by the storage garbage collector."),
+    "storage_gc_incremental": (
+        "false",
+        "false",
+        "Controls whether the storage garbage collector runs bounded cycles driven by the amount of garbage instead of full cycles every storage_gc_cycle_sec seconds.",
+    ),
+    "storage_gid_block_size": (
+        "1",
+        "1",
+        "The number of consecutive vertex or edge ids reserved at once by each thread creating them, so the threads don't contend for the ids, e.g. 65536 for parallel imports. The ids which a thread didn't use are skipped. 1 allocates the ids one by one.",
+    ),
+    "storage_index_stats_refresh_interval_sec": (
+        "60",
+        "60",
+        "Interval (in seconds) at which the index statistics are checked for the refresh.",
+    ),
+    "storage_index_stats_refresh_threshold": (
+        "0",
+        "0",
+        "Fraction of the vertices in an index that have to change before its statistics are recomputed in the background. Value of 0 disables the refresh.",
+    ),
     "storage_items_per_batch": (
         "1000000",
         "1000000",
         "The number of edges and vertices stored in a batch in a snapshot file.",
     ),
+    "storage_light_edges": (
+        "false",
+        "false",
+        "With properties on edges, an edge is stored as a separate object only once a property is set on it, which saves memory for the edges without properties. Edge type property indices can't be created.",
+    ),
     "storage_properties_on_edges": ("false", "true", "Controls whether edges have properties."),
+    "storage_property_columns": (
+        "false",
+        "false",
+        "In the analytical mode, the aggregations of a property of the vertices with an indexed label read the values of the property from a column which is cached until any vertex is changed.",
+    ),
+    "storage_property_store_compression_enabled": (
+        "false",
+        "false",
+        "Controls whether large string, list and map property values are stored compressed. The setting applies to all databases.",
+    ),
     "storage_recovery_thread_count": ("12", "12", "The number of threads used to recover persisted data from disk."),
+    "storage_snapshot_compression": (
+        "false",
+        "false",
+        "Controls whether the snapshot files are compressed. The data is compressed in independent blocks so the snapshots can still be recovered in parallel.",
+    ),
     "storage_snapshot_interval_sec": (
         "0",
         "300",
         "Storage snapshot creation interval (in seconds). Set to 0 to disable periodic snapshot creation.",
     ),
     "storage_snapshot_on_exit": ("false", "false", "Controls whether the storage creates another snapshot on exit."),
+    "storage_snapshot_low_priority": (
+        "false",
+        "false",
+        "Controls whether the snapshots are written with the lowest CPU and I/O priority, so that they interfere less with the queries and the WAL.",
+    ),
+    "storage_snapshot_min_changed_percent": (
+        "0",
+        "0",
+        "The percentage of vertices and edges that have to be changed since the last snapshot before a periodic snapshot is written. Until then the changes are kept only in the WAL files. Set to 0 to write every periodic snapshot.",
+    ),
+    "storage_snapshot_recovery_mmap": (
+        "false",
+        "false",
+        "Controls whether the snapshot files are memory mapped instead of read through a buffer during recovery.",
+    ),
     "storage_snapshot_retention_count": ("3", "3", "The number of snapshots that should always be kept."),
+    "storage_snapshot_write_rate_limit_mib": (
+        "0",
+        "0",
+        "The maximum rate at which the snapshot files are written in MiB per second. Set to 0 to disable the limit.",
+    ),
+    "storage_tiering_budget": (
+        "0",
+        "0",
+        "The number of vertices and edges visited in each background tiering pass. The large property values of the objects whose properties weren't read since the previous visit are evicted to disk, and read back from it until the objects are read often again. Value of 0 keeps all values in memory.",
+    ),
+    "storage_tiering_interval_sec": (
+        "10",
+        "10",
+        "Interval (in seconds) of the background tiering passes.",
+    ),
+    "storage_unique_constraints_hash_index": (
+        "false",
+        "false",
+        "Controls whether unique constraints keep their entries in a hash table instead of a skip list. Only equal values are looked up when checking uniqueness, so this makes commits cheaper.",
+    ),
     "storage_wal_enabled": (
         "false",
         "true",
@@ -157,11 +461,26 @@ startup_config_dict = {
         "Issue a 'fsync' call after this amount of transactions are written to the WAL file. Set to 1 for fully synchronous operation.",
     ),
     "storage_wal_file_size_kib": ("20480", "20480", "Minimum file size of each WAL file."),
+    "storage_wal_group_commit": (
+        "false",
+        "false",
+        "Controls whether every commit waits for its WAL records to be synced to disk. Transactions that commit concurrently are synced together with a single 'fsync' call.",
+    ),
+    "storage_wal_segment_pool_size": (
+        "0",
+        "0",
+        "The number of empty files with preallocated disk space that are kept ready for new WAL files, so that switching to a new WAL file doesn't have to create and allocate one. Set to 0 to disable the pool.",
+    ),
     "storage_delete_on_drop": (
         "true",
         "true",
         "If set to true the query 'DROP DATABASE x' will delete the underlying storage as well.",
     ),
+    "stream_batch_queries": (
+        "false",
+        "false",
+        "Execute consecutive rows of a stream transformation result which have the same query as a single query that unwinds their parameters, if the query only writes to the database.",
+    ),
     "stream_transaction_conflict_retries": (
         "30",
         "30",
@@ -177,8 +496,23 @@ startup_config_dict = {
         "false",
         "Set to true to enable telemetry. We collect information about the running system (CPU and memory information) and information about the database runtime (vertex and edge counts and resource usage) to allow for easier improvement of the product.",
     ),
+    "trigger_after_commit_max_backlog": (
+        "0",
+        "0",
+        "Number of committed transactions whose AFTER COMMIT triggers may wait to be run before the commits wait for them. Value of 0 means no limit.",
+    ),
+    "trigger_after_commit_workers": (
+        "1",
+        "1",
+        "Number of threads running the AFTER COMMIT triggers. Each trigger always runs on the same thread, so its runs keep the order of the commits.",
+    ),
     "query_cost_planner": ("true", "true", "Use the cost-estimating query planner."),
     "query_plan_cache_ttl": ("60", "60", "Time to live for cached query plans, in seconds."),
+    "query_plan_cardinality_feedback_threshold": (
+        "10",
+        "10",
+        "How many times the number of rows of an operator observed by PROFILE has to differ from the estimated one for the cached plans of the query to be made again with the observed cardinalities. 0 disables the feedback.",
+    ),
     "query_vertex_count_to_expand_existing": (
         "10",
         "10",
@@ -207,4 +541,14 @@ startup_config_dict = {
         "128",
         "The threshold for when to cache long delta chains. This is used for heavy read + write workloads where repeated processing of delta chains can become costly.",
     ),
+    "delta_chain_materialize_threshold": (
+        "0",
+        "0",
+        "The number of deltas applied by a read of a vertex after which the version of the vertex it read is shared with the other readers of the same version, so they don't walk the delta chain again. Only used for snapshot isolation. 0 disables sharing the versions.",
+    ),
+    "delta_chain_stats_max_objects": (
+        "100",
+        "100",
+        "The number of vertices with the longest delta chains returned by mg.delta_chains().",
+    ),
 }
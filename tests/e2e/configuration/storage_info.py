@@ -24,6 +24,8 @@ default_storage_info_dict = {
     "disk_usage": "",  # machine dependent
     "memory_allocated": "",  # machine dependent
     "allocation_limit": "",  # machine dependent
+    "query_memory_allocated": "",  # machine dependent
+    "query_memory_limit": 0,
     "global_isolation_level": "SNAPSHOT_ISOLATION",
     "session_isolation_level": "",
     "next_session_isolation_level": "",
@@ -53,10 +55,16 @@ def test_does_default_config_match():
     config = cursor.fetchall()
 
     # The default value of these is dependent on the given machine.
-    machine_dependent_configurations = ["memory_usage", "disk_usage", "memory_allocated", "allocation_limit"]
+    machine_dependent_configurations = [
+        "memory_usage",
+        "disk_usage",
+        "memory_allocated",
+        "allocation_limit",
+        "query_memory_allocated",
+    ]
 
     # Number of different data-points returned by SHOW STORAGE INFO
-    assert len(config) == 12
+    assert len(config) == 14
 
     for conf in config:
         conf_name = conf[0]
@@ -389,6 +389,28 @@ def test_load_c_transformations(connection, transformation):
     assert result[0][0] == transformation
 
 
+@pytest.mark.parametrize(
+    "transformation,message",
+    [
+        ("json_transform.mapped", b'{"user": {"id": 1, "name": "alice"}}'),
+        ("json_transform.unmapped", b'{"id": 1, "name": "alice"}'),
+    ],
+)
+def test_json_transformations(kafka_producer, kafka_topics, connection, transformation, message):
+    assert len(kafka_topics) > 0
+    cursor = connection.cursor()
+    common.execute_and_fetch_all(
+        cursor,
+        f"CREATE KAFKA STREAM test TOPICS {kafka_topics[0]} TRANSFORM {transformation}",
+    )
+    common.start_stream(cursor, "test")
+    time.sleep(5)
+
+    kafka_producer.send(kafka_topics[0], message).get(timeout=60)
+
+    common.check_vertex_exists_with_properties(cursor, {"id": 1, "name": "'alice'"})
+
+
 def test_check_stream_same_number_of_queries_than_messages(kafka_producer, kafka_topics, connection):
     assert len(kafka_topics) > 0
 
@@ -0,0 +1,16 @@
+CREATE INDEX ON :__mg_vertex__(__mg_id__);
+CREATE (:__mg_vertex__:`Person` {__mg_id__: 0, `age`: 30, `name`: "Alice", `id`: "1"});
+CREATE (:__mg_vertex__:`Person` {__mg_id__: 1, `age`: 25, `name`: "Bob", `id`: "2"});
+CREATE (:__mg_vertex__:`Person`:`Manager` {__mg_id__: 2, `age`: 41, `name`: "Carol", `id`: "3"});
+CREATE (:__mg_vertex__:`Person` {__mg_id__: 3, `age`: 35, `name`: "Dave", `id`: "4"});
+CREATE (:__mg_vertex__:`Person` {__mg_id__: 4, `age`: 28, `name`: "Erin", `id`: "5"});
+CREATE (:__mg_vertex__:`Person`:`Manager` {__mg_id__: 5, `age`: 52, `name`: "Frank", `id`: "6"});
+CREATE (:__mg_vertex__:`Person` {__mg_id__: 6, `age`: 33, `name`: "Grace", `id`: "7"});
+MATCH (u:__mg_vertex__), (v:__mg_vertex__) WHERE u.__mg_id__ = 0 AND v.__mg_id__ = 1 CREATE (u)-[:`KNOWS` {`since`: 2010}]->(v);
+MATCH (u:__mg_vertex__), (v:__mg_vertex__) WHERE u.__mg_id__ = 1 AND v.__mg_id__ = 2 CREATE (u)-[:`KNOWS` {`since`: 2011}]->(v);
+MATCH (u:__mg_vertex__), (v:__mg_vertex__) WHERE u.__mg_id__ = 2 AND v.__mg_id__ = 3 CREATE (u)-[:`MANAGES` {`since`: 2012}]->(v);
+MATCH (u:__mg_vertex__), (v:__mg_vertex__) WHERE u.__mg_id__ = 3 AND v.__mg_id__ = 4 CREATE (u)-[:`KNOWS` {`since`: 2013}]->(v);
+MATCH (u:__mg_vertex__), (v:__mg_vertex__) WHERE u.__mg_id__ = 5 AND v.__mg_id__ = 6 CREATE (u)-[:`MANAGES` {`since`: 2015}]->(v);
+MATCH (u:__mg_vertex__), (v:__mg_vertex__) WHERE u.__mg_id__ = 6 AND v.__mg_id__ = 0 CREATE (u)-[:`KNOWS` {`since`: 2016}]->(v);
+DROP INDEX ON :__mg_vertex__(__mg_id__);
+MATCH (u) REMOVE u:__mg_vertex__, u.__mg_id__;
\ No newline at end of file
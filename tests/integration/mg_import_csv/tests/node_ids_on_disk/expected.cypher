@@ -0,0 +1,10 @@
+CREATE INDEX ON :__mg_vertex__(__mg_id__);
+CREATE (:__mg_vertex__:`Person` {__mg_id__: 0, `name`: "Alice", `id`: "1"});
+CREATE (:__mg_vertex__:`Person` {__mg_id__: 1, `name`: "Bob", `id`: "2"});
+CREATE (:__mg_vertex__:`City` {__mg_id__: 3, `name`: "Zagreb", `id`: "1"});
+CREATE (:__mg_vertex__:`City` {__mg_id__: 4, `name`: "Split", `id`: "2"});
+MATCH (u:__mg_vertex__), (v:__mg_vertex__) WHERE u.__mg_id__ = 0 AND v.__mg_id__ = 4 CREATE (u)-[:`LIVES_IN`]->(v);
+MATCH (u:__mg_vertex__), (v:__mg_vertex__) WHERE u.__mg_id__ = 1 AND v.__mg_id__ = 3 CREATE (u)-[:`LIVES_IN`]->(v);
+MATCH (u:__mg_vertex__), (v:__mg_vertex__) WHERE u.__mg_id__ = 1 AND v.__mg_id__ = 0 CREATE (u)-[:`KNOWS`]->(v);
+DROP INDEX ON :__mg_vertex__(__mg_id__);
+MATCH (u) REMOVE u:__mg_vertex__, u.__mg_id__;
\ No newline at end of file
@@ -33,7 +33,8 @@ class QueryClient:
         set_cpus("client-cpu-ids", self.client, args)
         self.default_num_workers = default_num_workers
 
-    def __call__(self, queries, database, num_workers=None):
+    def __call__(self, queries, database, num_workers=None,
+                 print_records=False):
         if num_workers is None: num_workers = self.default_num_workers
         self.log.debug("execute('%s')", str(queries))
 
@@ -56,6 +57,8 @@ class QueryClient:
         client_args = ["--port", database.args.port,
                        "--num-workers", str(num_workers),
                        "--output", output]
+        if print_records:
+            client_args += ["--print-records"]
 
         cpu_time_start = database.database_bin.get_usage()["cpu"]
         # TODO make the timeout configurable per query or something
@@ -33,6 +33,7 @@ DEFINE_int32(port, 7687, "Server port");
 DEFINE_string(username, "", "Username for the database");
 DEFINE_string(password, "", "Password for the database");
 DEFINE_bool(use_ssl, false, "Set to true to connect with SSL to the server.");
+DEFINE_bool(print_records, false, "Set to true to include the records returned by the queries in the output.");
 
 using memgraph::communication::bolt::Value;
 
@@ -45,10 +46,15 @@ void PrintJsonMetadata(std::ostream &os, const std::vector<std::map<std::string,
   os << "]";
 }
 
-void PrintSummary(std::ostream &os, double duration, const std::vector<std::map<std::string, Value>> &metadata) {
+void PrintSummary(std::ostream &os, double duration, const std::vector<std::map<std::string, Value>> &metadata,
+                  const std::vector<Value> &records) {
   os << "{\"wall_time\": " << duration << ", "
      << "\"metadatas\": ";
   PrintJsonMetadata(os, metadata);
+  if (FLAGS_print_records) {
+    os << ", \"records\": ";
+    PrintJsonValue(os, Value(records));
+  }
   os << "}\n";
 }
 
@@ -58,8 +64,11 @@ void ExecuteQueries(const std::vector<std::string> &queries, std::ostream &ostre
   memgraph::utils::SpinLock spinlock;
   uint64_t last = 0;
   std::vector<std::map<std::string, Value>> metadata;
+  // The records of each query as a list of rows.
+  std::vector<Value> records;
 
   metadata.resize(queries.size());
+  records.resize(queries.size());
 
   memgraph::utils::Timer timer;
 
@@ -82,7 +91,14 @@ void ExecuteQueries(const std::vector<std::string> &queries, std::ostream &ostre
           str = queries[pos];
         }
         try {
-          metadata[pos] = ExecuteNTimesTillSuccess(client, str, {}, MAX_RETRIES).first.metadata;
+          auto result = ExecuteNTimesTillSuccess(client, str, {}, MAX_RETRIES).first;
+          metadata[pos] = std::move(result.metadata);
+          if (FLAGS_print_records) {
+            std::vector<Value> rows;
+            rows.reserve(result.records.size());
+            for (auto &row : result.records) rows.emplace_back(std::move(row));
+            records[pos] = Value(std::move(rows));
+          }
         } catch (const memgraph::utils::BasicException &e) {
           LOG_FATAL("Could not execute query '{}' {} times! Error message: {}", str, MAX_RETRIES, e.what());
         }
@@ -98,7 +114,7 @@ void ExecuteQueries(const std::vector<std::string> &queries, std::ostream &ostre
   auto elapsed = timer.Elapsed();
   double duration = elapsed.count();
 
-  PrintSummary(ostream, duration, metadata);
+  PrintSummary(ostream, duration, metadata, records);
 }
 
 int main(int argc, char **argv) {
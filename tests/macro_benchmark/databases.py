@@ -53,7 +53,7 @@ class Memgraph:
         self.name = "memgraph"
         set_cpus("database-cpu-ids", self.database_bin, args)
 
-    def start(self):
+    def start(self, extra_args=None, timeout=600):
         self.log.info("start")
         database_args = ["--bolt-port", self.args.port,
                          "--query-execution-timeout-sec", "0"]
@@ -65,13 +65,18 @@ class Memgraph:
             database_args += ["--storage-recover-on-startup"]
         if self.args.storage_snapshot_on_exit:
             database_args += ["--storage-snapshot-on-exit"]
+        if extra_args:
+            database_args += extra_args
 
         # find executable path
         runner_bin = self.args.runner_bin
 
-        # start memgraph
-        self.database_bin.run(runner_bin, database_args, timeout=600)
-        wait_for_server(self.args.port)
+        # start memgraph, the startup time includes the recovery of the data
+        start_time = time.time()
+        self.database_bin.run(runner_bin, database_args, timeout=timeout)
+        wait_for_server(self.args.port, 0)
+        self.startup_time = time.time() - start_time
+        time.sleep(0.1)
 
     def stop(self):
         self.database_bin.send_signal(jail.SIGTERM)
@@ -0,0 +1,234 @@
+# Copyright 2023 Memgraph Ltd.
+#
+# Use of this software is governed by the Business Source License
+# included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+# License, and you may not use this file except in compliance with the Business Source License.
+#
+# As of the Change Date specified in that file, in accordance with
+# the Business Source License, use of this software will be governed
+# by the Apache License, Version 2.0, included in the file
+# licenses/APL.txt.
+
+import logging
+import shutil
+import tempfile
+import time
+from argparse import ArgumentParser
+from collections import defaultdict
+from statistics import mean, median, stdev
+from common import WALL_TIME, MAX_MEMORY
+from databases import Memgraph
+from clients import QueryClient
+
+log = logging.getLogger(__name__)
+
+# Periodic snapshots are disabled with the interval 0. The WAL can't be
+# enabled without them, so it uses the longest interval to keep them out of
+# the measurements.
+NO_SNAPSHOTS = ["--storage-snapshot-interval-sec", "0",
+                "--storage-wal-enabled=false"]
+WAL_ONLY = ["--storage-snapshot-interval-sec", str(7 * 24 * 3600),
+            "--storage-wal-enabled"]
+OBJECTS_PER_SECOND = "objects_per_second"
+
+
+class DurabilitySuite:
+    """
+    Measures the durability paths of the database on a generated graph:
+        snapshot_create - the CREATE SNAPSHOT query,
+        snapshot_recovery - the startup with the recovery from a snapshot,
+        wal_recovery - the startup with the replay of the WAL files,
+        replica_recovery - the time until a newly registered replica has all
+            the data of the main.
+    The phase of a scenario is given by its run.json file, and the size of
+    the graph by the group config.json, which can be overridden with the
+    --vertices and --edges-per-vertex flags. The peak memory is the one of
+    the measured process, which for snapshot_create includes the generation
+    of the graph.
+    """
+    KNOWN_KEYS = {"config", "run"}
+    FORMAT = ["{:>24}", "{:>28}", "{:>16}", "{:>16}", "{:>20}"]
+    FULL_FORMAT = "".join(FORMAT) + "\n"
+    headers = ["group_name", "scenario_name", WALL_TIME, MAX_MEMORY,
+               OBJECTS_PER_SECOND]
+    summary = FULL_FORMAT.format(*headers)
+
+    def __init__(self, args):
+        argp = ArgumentParser("DurabilitySuiteArgumentParser")
+        argp.add_argument("--vertices", type=int,
+                          help="Number of vertices of the generated graph")
+        argp.add_argument("--edges-per-vertex", type=int,
+                          help="Number of edges going out of each vertex")
+        self.args, _ = argp.parse_known_args(args)
+
+    def run(self, scenario, group_name, scenario_name, runner):
+        config = next(scenario.get("config")())
+        phase = next(scenario.get("run")())["phase"]
+        vertices = self.args.vertices or config["vertices"]
+        edges_per_vertex = self.args.edges_per_vertex
+        if edges_per_vertex is None:
+            edges_per_vertex = config["edges_per_vertex"]
+        objects = vertices * (1 + edges_per_vertex)
+        log.info("Measuring %s on a graph with %d vertices and %d edges",
+                 phase, vertices, vertices * edges_per_vertex)
+
+        measurements = defaultdict(list)
+        for iteration in range(config.get("iterations", 3)):
+            wall_time, max_memory = runner.measure(
+                phase, config, vertices, edges_per_vertex)
+            log.info("\t%s iteration %d done in %.2f seconds", phase,
+                     iteration, wall_time)
+            measurements[WALL_TIME].append(wall_time)
+            measurements[MAX_MEMORY].append(max_memory)
+            measurements[OBJECTS_PER_SECOND].append(objects / wall_time)
+
+        self.summary += self.FORMAT[0].format(group_name)
+        self.summary += self.FORMAT[1].format(scenario_name)
+        self.summary += self.FORMAT[2].format(
+            "{:.6f}".format(median(measurements[WALL_TIME])))
+        self.summary += self.FORMAT[3].format(
+            int(median(measurements[MAX_MEMORY])))
+        self.summary += self.FORMAT[4].format(
+            "{:.2f}".format(median(measurements[OBJECTS_PER_SECOND])))
+        self.summary += "\n"
+
+        results = {}
+        for key, samples in measurements.items():
+            results[key] = {"mean": mean(samples),
+                            "median": median(samples),
+                            "stdev": stdev(samples) if len(samples) > 1
+                            else 0.0,
+                            "count": len(samples)}
+        results["group_name"] = group_name
+        results["scenario_name"] = scenario_name
+        return results
+
+    def runners(self):
+        return {"MemgraphRunner": MemgraphRunner}
+
+    def groups(self):
+        return ["durability"]
+
+
+class MemgraphRunner:
+    """
+    Starts a main and, for the replica recovery, a replica instance, each in
+    a new data directory for every measurement.
+    """
+    def __init__(self, args):
+        argp = ArgumentParser("DurabilityRunnerArgumentParser")
+        argp.add_argument("--replica-port", default="7688",
+                          help="Bolt port of the replica")
+        argp.add_argument("--replication-port", default="10000",
+                          help="Replication port of the replica")
+        argp.add_argument("--timeout", type=int, default=3600,
+                          help="Maximum lifetime of a database process")
+        self.args, remaining_args = argp.parse_known_args(args)
+        self.main = Memgraph(remaining_args, 1)
+        self.replica = Memgraph(
+            remaining_args + ["--port", self.args.replica_port], 1)
+        self.query_client = QueryClient(remaining_args, 1)
+
+    def measure(self, phase, config, vertices, edges_per_vertex):
+        """ Returns the wall time and the peak memory of the phase """
+        directories = [tempfile.mkdtemp(), tempfile.mkdtemp()]
+        try:
+            return getattr(self, "_" + phase)(
+                directories, config, vertices, edges_per_vertex)
+        finally:
+            for directory in directories:
+                shutil.rmtree(directory, ignore_errors=True)
+
+    def _start(self, database, directory, flags):
+        database.start(["--data-directory", directory] + flags,
+                       timeout=self.args.timeout)
+
+    def _generate(self, config, vertices, edges_per_vertex):
+        batch_size = config.get("batch_size", 100000)
+        batches = [(start, min(start + batch_size, vertices) - 1)
+                   for start in range(0, vertices, batch_size)]
+        self.query_client(["CREATE INDEX ON :Node(id)"], self.main)
+        self.query_client(
+            ["UNWIND range({}, {}) AS i CREATE (:Node {{id: i, "
+             "name: 'node' + toString(i)}})".format(*batch)
+             for batch in batches], self.main)
+        # The ends of the edges are spread over the whole graph.
+        self.query_client(
+            ["UNWIND range({}, {}) AS i MATCH (a:Node {{id: i}}), "
+             "(b:Node {{id: (i * 7919 + {}) % {}}}) "
+             "CREATE (a)-[:EDGE {{weight: {}}}]->(b)".format(
+                 *batch, k, vertices, k)
+             for batch in batches for k in range(edges_per_vertex)],
+            self.main)
+
+    def _snapshot_create(self, directories, config, vertices,
+                         edges_per_vertex):
+        self._start(self.main, directories[0], NO_SNAPSHOTS)
+        try:
+            self._generate(config, vertices, edges_per_vertex)
+            result = self.query_client(["CREATE SNAPSHOT"], self.main)
+            return result["groups"][0][WALL_TIME], result[MAX_MEMORY]
+        finally:
+            self.main.stop()
+
+    def _recover(self, directory):
+        self._start(self.main, directory,
+                    NO_SNAPSHOTS + ["--storage-recover-on-startup"])
+        try:
+            return (self.main.startup_time,
+                    self.main.database_bin.get_usage()["max_memory"])
+        finally:
+            self.main.stop()
+
+    def _snapshot_recovery(self, directories, config, vertices,
+                           edges_per_vertex):
+        self._start(self.main, directories[0], NO_SNAPSHOTS)
+        try:
+            self._generate(config, vertices, edges_per_vertex)
+            self.query_client(["CREATE SNAPSHOT"], self.main)
+        finally:
+            self.main.stop()
+        return self._recover(directories[0])
+
+    def _wal_recovery(self, directories, config, vertices, edges_per_vertex):
+        self._start(self.main, directories[0], WAL_ONLY)
+        try:
+            self._generate(config, vertices, edges_per_vertex)
+        finally:
+            self.main.stop()
+        return self._recover(directories[0])
+
+    def _replica_recovery(self, directories, config, vertices,
+                          edges_per_vertex):
+        expected = [vertices, vertices * edges_per_vertex]
+        self._start(self.main, directories[0], WAL_ONLY)
+        try:
+            self._generate(config, vertices, edges_per_vertex)
+            # The replica receives the snapshot and the WAL files written
+            # after it.
+            self.query_client(["CREATE SNAPSHOT"], self.main)
+            self._start(self.replica, directories[1], [])
+            try:
+                self.query_client(
+                    ["SET REPLICATION ROLE TO REPLICA WITH PORT {}".format(
+                        self.args.replication_port)], self.replica)
+                start_time = time.time()
+                self.query_client(
+                    ["REGISTER REPLICA replica ASYNC TO "
+                     "'127.0.0.1:{}'".format(self.args.replication_port)],
+                    self.main)
+                while self._counts(self.replica) != expected:
+                    time.sleep(0.1)
+                return (time.time() - start_time,
+                        self.replica.database_bin.get_usage()["max_memory"])
+            finally:
+                self.replica.stop()
+        finally:
+            self.main.stop()
+
+    def _counts(self, database):
+        """ Returns the numbers of vertices and edges in the database """
+        result = self.query_client(["SHOW STORAGE INFO"], database,
+                                   print_records=True)
+        info = dict(result["groups"][0]["records"][0])
+        return [info["vertex_count"], info["edge_count"]]
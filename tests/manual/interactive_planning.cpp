@@ -199,6 +199,19 @@ class InteractiveDbAccessor {
     return ReadVertexCount("label '" + label + "' and property '" + property + "' in range " + range_string.str());
   }
 
+  int64_t VerticesCount(memgraph::storage::LabelId label_id,
+                        const std::vector<memgraph::storage::PropertyId> &property_ids) {
+    return 0;
+  }
+
+  int64_t VerticesCount(memgraph::storage::LabelId label_id,
+                        const std::vector<memgraph::storage::PropertyId> &property_ids,
+                        const std::vector<memgraph::storage::PropertyValue> &prefix,
+                        const std::optional<memgraph::utils::Bound<memgraph::storage::PropertyValue>> &lower,
+                        const std::optional<memgraph::utils::Bound<memgraph::storage::PropertyValue>> &upper) {
+    return 0;
+  }
+
   bool LabelIndexExists(memgraph::storage::LabelId label) { return true; }
 
   bool LabelPropertyIndexExists(memgraph::storage::LabelId label_id, memgraph::storage::PropertyId property_id) {
@@ -213,6 +226,29 @@ class InteractiveDbAccessor {
     return label_property_index_.at(key);
   }
 
+  // Edge indices aren't simulated, so the planner never uses them.
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId edge_type) { return 0; }
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId edge_type, memgraph::storage::PropertyId property) { return 0; }
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId edge_type, memgraph::storage::PropertyId property,
+                     const memgraph::storage::PropertyValue &value) {
+    return 0;
+  }
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId edge_type, memgraph::storage::PropertyId property,
+                     const std::optional<memgraph::utils::Bound<memgraph::storage::PropertyValue>> &lower,
+                     const std::optional<memgraph::utils::Bound<memgraph::storage::PropertyValue>> &upper) {
+    return 0;
+  }
+  bool EdgeTypeIndexExists(memgraph::storage::EdgeTypeId edge_type) { return false; }
+  bool EdgeTypePropertyIndexExists(memgraph::storage::EdgeTypeId edge_type, memgraph::storage::PropertyId property) {
+    return false;
+  }
+
+  // Composite indices aren't simulated, so the planner never uses them.
+  std::vector<std::vector<memgraph::storage::PropertyId>> LabelPropertyCompositeIndices(
+      memgraph::storage::LabelId label_id) {
+    return {};
+  }
+
   std::optional<memgraph::storage::LabelIndexStats> GetIndexStats(const memgraph::storage::LabelId label) const {
     return dba_->GetIndexStats(label);
   }
@@ -140,6 +140,36 @@ def parse_args():
         help="Execute defined number of queries (based on single-threaded-runtime-sec) for a defined duration in of wall-clock time",
     )
 
+    benchmark_parser.add_argument(
+        "--target-throughput",
+        type=float,
+        default=0,
+        help="""Run the mixed and realistic workloads open-loop, starting this many queries per second regardless
+        of how long the previous queries take. The latency percentiles are then reported for each type of queries,
+        for the whole run and over time.""",
+    )
+
+    benchmark_parser.add_argument(
+        "--latency-window-sec",
+        type=float,
+        default=1.0,
+        help="Length of the windows of the latency timeline of the open-loop workloads",
+    )
+
+    benchmark_parser.add_argument(
+        "--background-query",
+        default=None,
+        help="""Query executed periodically during the open-loop workloads, e.g. 'CREATE SNAPSHOT;' or
+        'FREE MEMORY;', to measure the latencies while the database takes snapshots or collects garbage""",
+    )
+
+    benchmark_parser.add_argument(
+        "--background-query-interval-sec",
+        type=float,
+        default=10.0,
+        help="Interval between the executions of --background-query",
+    )
+
     benchmark_parser.add_argument(
         "--performance-tracking",
         action="store_true",
@@ -226,6 +256,19 @@ def warmup(condition: str, client: runners.BaseRunner, queries: list = None):
     log.log("Finished warm-up procedure to match database condition: {} ".format(condition))
 
 
+def open_loop_args(benchmark_context: BenchmarkContext):
+    if benchmark_context.target_throughput <= 0:
+        return {}
+    args = {
+        "target_throughput": benchmark_context.target_throughput,
+        "latency_window_sec": benchmark_context.latency_window_sec,
+    }
+    if benchmark_context.background_query:
+        args["background_query"] = benchmark_context.background_query
+        args["background_query_interval_sec"] = benchmark_context.background_query_interval_sec
+    return args
+
+
 def mixed_workload(
     vendor: runners.BaseRunner, client: runners.BaseClient, dataset, group, queries, benchmark_context: BenchmarkContext
 ):
@@ -292,13 +335,14 @@ def mixed_workload(
             function_type = random.choices(population=options, weights=percentage_distribution, k=num_of_queries)
 
             for t in function_type:
-                # Get the appropriate functions with same probabilty
+                # Get the appropriate functions with same probabilty, each
+                # query is tagged with its function for the latency statistics
                 if t == "query":
-                    full_workload.append(base_query())
+                    full_workload.append((*base_query(), query))
                 else:
                     funcname = random.choices(queries_by_type[t], k=1)[0]
                     additional_query = getattr(dataset, funcname)
-                    full_workload.append(additional_query())
+                    full_workload.append((*additional_query(), funcname))
 
             vendor.start_db(
                 dataset.NAME + dataset.get_variant() + "_" + "mixed" + "_" + query + "_" + config_distribution
@@ -307,6 +351,7 @@ def mixed_workload(
             ret = client.execute(
                 queries=full_workload,
                 num_workers=benchmark_context.num_workers_for_benchmark,
+                open_loop=open_loop_args(benchmark_context),
             )[0]
             usage_workload = vendor.stop_db(
                 dataset.NAME + dataset.get_variant() + "_" + "mixed" + "_" + query + "_" + config_distribution
@@ -333,13 +378,14 @@ def mixed_workload(
             # Get the appropriate functions with same probability
             funcname = random.choices(queries_by_type[t], k=1)[0]
             additional_query = getattr(dataset, funcname)
-            full_workload.append(additional_query())
+            full_workload.append((*additional_query(), funcname))
 
         vendor.start_db(dataset.NAME + dataset.get_variant() + "_" + "realistic" + "_" + config_distribution)
         warmup(benchmark_context.warm_up, client=client)
         ret = client.execute(
             queries=full_workload,
             num_workers=benchmark_context.num_workers_for_benchmark,
+            open_loop=open_loop_args(benchmark_context),
         )[0]
         usage_workload = vendor.stop_db(
             dataset.NAME + dataset.get_variant() + "_" + "realistic" + "_" + config_distribution
@@ -352,6 +398,16 @@ def mixed_workload(
             "num_workers": ret["num_workers"],
             "database": usage_workload,
         }
+        # The open-loop execution measures the tail latencies by query type.
+        for key in [
+            "target_throughput",
+            "latency_stats",
+            "latency_stats_by_type",
+            "latency_timeline",
+            "background_queries",
+        ]:
+            if key in ret:
+                mixed_workload[key] = ret[key]
         results_key = [
             dataset.NAME,
             dataset.get_variant(),
@@ -437,6 +493,7 @@ if __name__ == "__main__":
     assert (
         args.workload_realistic == None or args.workload_mixed == None
     ), "Cannot run both realistic and mixed workload, only one mode run at the time"
+    assert args.target_throughput >= 0 and args.latency_window_sec > 0
 
     temp_dir = pathlib.Path.cwd() / ".temp"
     temp_dir.mkdir(parents=True, exist_ok=True)
@@ -456,6 +513,10 @@ if __name__ == "__main__":
         workload_mixed=args.workload_mixed,
         workload_realistic=args.workload_realistic,
         time_dependent_execution=args.time_depended_execution,
+        target_throughput=args.target_throughput,
+        latency_window_sec=args.latency_window_sec,
+        background_query=args.background_query,
+        background_query_interval_sec=args.background_query_interval_sec,
         warm_up=args.warm_up,
         performance_tracking=args.performance_tracking,
         no_authorization=args.no_authorization,
@@ -33,6 +33,10 @@ class BenchmarkContext:
         workload_mixed: str = None,  # Default mode is isolated, mixed None
         workload_realistic: str = None,  # Default mode is isolated, realistic None
         time_dependent_execution: int = 0,
+        target_throughput: float = 0,
+        latency_window_sec: float = 1.0,
+        background_query: str = None,
+        background_query_interval_sec: float = 10.0,
         warm_up: str = None,
         performance_tracking: bool = False,
         no_authorization: bool = True,
@@ -63,6 +67,10 @@ class BenchmarkContext:
             self.mode_config = "Isolated run does not have a config."
 
         self.time_dependent_execution = time_dependent_execution
+        self.target_throughput = target_throughput
+        self.latency_window_sec = latency_window_sec
+        self.background_query = background_query
+        self.background_query_interval_sec = background_query_interval_sec
         self.performance_tracking = performance_tracking
         self.warm_up = warm_up
         self.no_authorization = no_authorization
@@ -62,6 +62,18 @@ DEFINE_int64(time_dependent_execution, 0,
              "Time-dependent executions execute the queries for a specified number of seconds."
              "If all queries are executed, and there is still time, queries are rerun again."
              "If the time runs out, the client is done with the job and returning results.");
+DEFINE_double(target_throughput, 0.0,
+              "Number of queries per second that are started regardless of how long the previous queries take "
+              "(open-loop execution). The latency of a query is measured from the time it was due, so it includes "
+              "the time it waited for a free worker. By default, a worker starts the next query when the previous one "
+              "is done.");
+DEFINE_double(latency_window_sec, 1.0, "Length of the windows of the latency timeline of the open-loop execution.");
+DEFINE_string(background_query, "",
+              "Query which is executed on a separate connection during the open-loop execution, e.g. a query which "
+              "creates a snapshot or frees memory, so that its impact on the latencies shows in the timeline.");
+DEFINE_double(background_query_interval_sec, 10.0, "Interval between the executions of --background-query.");
+
+using Queries = std::vector<std::pair<std::string, std::map<std::string, memgraph::communication::bolt::Value>>>;
 
 std::pair<std::map<std::string, memgraph::communication::bolt::Value>, uint64_t> ExecuteNTimesTillSuccess(
     memgraph::communication::bolt::Client *client, const std::string &query,
@@ -195,6 +207,26 @@ class Metadata final {
   std::map<std::string, Record> storage_;
 };
 
+// Sorts the latencies and returns their distribution.
+nlohmann::json Percentiles(std::vector<double> &latencies) {
+  nlohmann::json statistics = nlohmann::json::object();
+  auto iterations = latencies.size();
+  statistics["iterations"] = iterations;
+  if (iterations == 0) return statistics;
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double p) { return latencies[std::min<size_t>(floor(iterations * p), iterations - 1)]; };
+  statistics["min"] = latencies.front();
+  statistics["max"] = latencies.back();
+  statistics["mean"] = std::accumulate(latencies.begin(), latencies.end(), 0.0) / iterations;
+  statistics["p999"] = percentile(0.999);
+  statistics["p99"] = percentile(0.99);
+  statistics["p95"] = percentile(0.95);
+  statistics["p90"] = percentile(0.90);
+  statistics["p75"] = percentile(0.75);
+  statistics["p50"] = percentile(0.50);
+  return statistics;
+}
+
 nlohmann::json LatencyStatistics(std::vector<std::vector<double>> &worker_query_latency) {
   nlohmann::json statistics = nlohmann::json::object();
   std::vector<double> query_latency;
@@ -206,17 +238,7 @@ nlohmann::json LatencyStatistics(std::vector<std::vector<double>> &worker_query_
   auto iterations = query_latency.size();
   const int lower_bound = 10;
   if (iterations > lower_bound) {
-    std::sort(query_latency.begin(), query_latency.end());
-    statistics["iterations"] = iterations;
-    statistics["min"] = query_latency.front();
-    statistics["max"] = query_latency.back();
-    statistics["mean"] = std::accumulate(query_latency.begin(), query_latency.end(), 0.0) / iterations;
-    statistics["p99"] = query_latency[floor(iterations * 0.99)];
-    statistics["p95"] = query_latency[floor(iterations * 0.95)];
-    statistics["p90"] = query_latency[floor(iterations * 0.90)];
-    statistics["p75"] = query_latency[floor(iterations * 0.75)];
-    statistics["p50"] = query_latency[floor(iterations * 0.50)];
-
+    statistics = Percentiles(query_latency);
   } else {
     spdlog::info("To few iterations to calculate latency values!");
     statistics["iterations"] = iterations;
@@ -416,6 +438,165 @@ void ExecuteWorkload(
   (*stream) << summary.dump() << std::endl;
 }
 
+/// Starts the queries at the rate of --target-throughput, so that the
+/// arrivals don't slow down when the database does, like the requests of many
+/// independent users. The latencies of each type of queries are reported for
+/// the whole run and for each window of --latency-window-sec by the time the
+/// queries were due, together with the executions of --background-query.
+void ExecuteOpenLoopWorkload(const Queries &queries, const std::vector<std::string> &query_types,
+                             std::ostream *stream) {
+  struct Sample {
+    uint64_t position;
+    double latency;
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(FLAGS_num_workers);
+
+  std::vector<uint64_t> worker_retries(FLAGS_num_workers, 0);
+  std::vector<Metadata> worker_metadata(FLAGS_num_workers, Metadata());
+  std::vector<std::vector<Sample>> worker_samples(FLAGS_num_workers);
+
+  // With a time limit, the queries are repeated until the last one due before
+  // the limit.
+  const auto size = queries.size();
+  const uint64_t arrivals = FLAGS_time_dependent_execution > 0
+                                ? static_cast<uint64_t>(FLAGS_target_throughput * FLAGS_time_dependent_execution)
+                                : size;
+  const std::chrono::duration<double> interval(1.0 / FLAGS_target_throughput);
+
+  std::atomic<bool> run(false);
+  std::atomic<bool> done(false);
+  std::atomic<uint64_t> ready(0);
+  std::atomic<uint64_t> position(0);
+  std::chrono::steady_clock::time_point workload_start;
+
+  for (int worker = 0; worker < FLAGS_num_workers; ++worker) {
+    threads.push_back(std::thread([&, worker]() {
+      memgraph::io::network::Endpoint endpoint(FLAGS_address, FLAGS_port);
+      memgraph::communication::ClientContext context(FLAGS_use_ssl);
+      memgraph::communication::bolt::Client client(context);
+      client.Connect(endpoint, FLAGS_username, FLAGS_password);
+
+      ready.fetch_add(1, std::memory_order_acq_rel);
+      while (!run.load(std::memory_order_acq_rel))
+        ;
+
+      auto &retries = worker_retries[worker];
+      auto &metadata = worker_metadata[worker];
+      auto &samples = worker_samples[worker];
+      while (true) {
+        auto pos = position.fetch_add(1, std::memory_order_acq_rel);
+        if (pos >= arrivals) break;
+        const auto due =
+            workload_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval * pos);
+        std::this_thread::sleep_until(due);
+        const auto &query = queries[pos % size];
+        auto ret = ExecuteNTimesTillSuccess(&client, query.first, query.second, FLAGS_max_retries);
+        samples.push_back({pos, std::chrono::duration<double>(std::chrono::steady_clock::now() - due).count()});
+        retries += ret.second;
+        metadata.Append(ret.first);
+      }
+      client.Close();
+    }));
+  }
+
+  // The background query runs on its own connection, between the workers'
+  // queries.
+  nlohmann::json background = nlohmann::json::array();
+  std::thread background_thread;
+  if (!FLAGS_background_query.empty()) {
+    background_thread = std::thread([&]() {
+      memgraph::io::network::Endpoint endpoint(FLAGS_address, FLAGS_port);
+      memgraph::communication::ClientContext context(FLAGS_use_ssl);
+      memgraph::communication::bolt::Client client(context);
+      client.Connect(endpoint, FLAGS_username, FLAGS_password);
+
+      ready.fetch_add(1, std::memory_order_acq_rel);
+      while (!run.load(std::memory_order_acq_rel))
+        ;
+
+      const std::chrono::duration<double> background_interval(FLAGS_background_query_interval_sec);
+      for (uint64_t i = 1;; ++i) {
+        const auto due =
+            workload_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(background_interval * i);
+        while (!done.load(std::memory_order_acquire) && std::chrono::steady_clock::now() < due) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        if (done.load(std::memory_order_acquire)) break;
+        const auto start = std::chrono::steady_clock::now();
+        ExecuteNTimesTillSuccess(&client, FLAGS_background_query, {}, FLAGS_max_retries);
+        const auto end = std::chrono::steady_clock::now();
+        nlohmann::json execution = nlohmann::json::object();
+        execution["start"] = std::chrono::duration<double>(start - workload_start).count();
+        execution["duration"] = std::chrono::duration<double>(end - start).count();
+        background.push_back(execution);
+      }
+      client.Close();
+    });
+  }
+
+  // Synchronize workers and collect runtime.
+  const uint64_t connections = FLAGS_num_workers + (background_thread.joinable() ? 1 : 0);
+  while (ready.load(std::memory_order_acq_rel) < connections)
+    ;
+  workload_start = std::chrono::steady_clock::now();
+  run.store(true, std::memory_order_acq_rel);
+
+  for (int i = 0; i < FLAGS_num_workers; ++i) {
+    threads[i].join();
+  }
+  const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - workload_start).count();
+  done.store(true, std::memory_order_release);
+  if (background_thread.joinable()) background_thread.join();
+
+  // Group the latencies by the query type, and by the window in which the
+  // queries were due.
+  Metadata final_metadata;
+  uint64_t final_retries = 0;
+  std::map<std::string, std::vector<double>> latencies_by_type;
+  std::map<uint64_t, std::map<std::string, std::vector<double>>> latencies_by_window;
+  std::vector<double> latencies;
+  const double window_arrivals = FLAGS_target_throughput * FLAGS_latency_window_sec;
+  for (int i = 0; i < FLAGS_num_workers; ++i) {
+    final_metadata += worker_metadata[i];
+    final_retries += worker_retries[i];
+    for (const auto &sample : worker_samples[i]) {
+      const auto &type = query_types[sample.position % size];
+      latencies.push_back(sample.latency);
+      latencies_by_type[type].push_back(sample.latency);
+      latencies_by_window[static_cast<uint64_t>(sample.position / window_arrivals)][type].push_back(sample.latency);
+    }
+  }
+
+  nlohmann::json summary = nlohmann::json::object();
+  summary["count"] = latencies.size();
+  summary["duration"] = duration;
+  summary["target_throughput"] = FLAGS_target_throughput;
+  summary["throughput"] = latencies.size() / duration;
+  summary["retries"] = final_retries;
+  summary["metadata"] = final_metadata.Export();
+  summary["num_workers"] = FLAGS_num_workers;
+  summary["latency_stats"] = Percentiles(latencies);
+  nlohmann::json by_type = nlohmann::json::object();
+  for (auto &[type, type_latencies] : latencies_by_type) {
+    by_type[type] = Percentiles(type_latencies);
+  }
+  summary["latency_stats_by_type"] = by_type;
+  nlohmann::json timeline = nlohmann::json::array();
+  for (auto &[window, window_latencies] : latencies_by_window) {
+    nlohmann::json entry = nlohmann::json::object();
+    entry["start"] = window * FLAGS_latency_window_sec;
+    for (auto &[type, type_latencies] : window_latencies) {
+      entry["latency_stats_by_type"][type] = Percentiles(type_latencies);
+    }
+    timeline.push_back(entry);
+  }
+  summary["latency_timeline"] = timeline;
+  summary["background_queries"] = background;
+  (*stream) << summary.dump() << std::endl;
+}
+
 nlohmann::json BoltRecordsToJSONStrings(std::vector<std::vector<memgraph::communication::bolt::Value>> &results) {
   nlohmann::json res = nlohmann::json::object();
   std::ostringstream oss;
@@ -482,6 +663,7 @@ int main(int argc, char **argv) {
   spdlog::info("Output: {}", FLAGS_output);
   spdlog::info("Validation: {}", FLAGS_validation);
   spdlog::info("Time dependend execution: {}", FLAGS_time_dependent_execution);
+  spdlog::info("Target throughput: {}", FLAGS_target_throughput);
 
   memgraph::communication::SSLInit sslInit;
 
@@ -502,7 +684,10 @@ int main(int argc, char **argv) {
     ostream = &ofile;
   }
 
-  std::vector<std::pair<std::string, std::map<std::string, memgraph::communication::bolt::Value>>> queries;
+  Queries queries;
+  // The type of each query, by which the open-loop execution groups the
+  // latencies.
+  std::vector<std::string> query_types;
   if (!FLAGS_queries_json) {
     // Load simple queries.
     std::string query;
@@ -511,9 +696,11 @@ int main(int argc, char **argv) {
       if (trimmed == "" || trimmed == ";") {
         ExecuteWorkload(queries, ostream);
         queries.clear();
+        query_types.clear();
         continue;
       }
       queries.emplace_back(query, std::map<std::string, memgraph::communication::bolt::Value>{});
+      query_types.emplace_back("query");
     }
   } else {
     // Load advanced queries.
@@ -523,15 +710,17 @@ int main(int argc, char **argv) {
       MG_ASSERT(data.is_array() && data.size() > 0,
                 "The root item of the loaded JSON queries must be a non-empty "
                 "array!");
-      MG_ASSERT(data.is_array() && data.size() == 2, "Each item of the loaded JSON queries must be an array!");
+      MG_ASSERT(data.is_array() && (data.size() == 2 || data.size() == 3),
+                "Each item of the loaded JSON queries must be an array!");
       if (data.size() == 0) {
         ExecuteWorkload(queries, ostream);
         queries.clear();
+        query_types.clear();
         continue;
       }
-      MG_ASSERT(data.size() == 2,
+      MG_ASSERT(data.size() == 2 || data.size() == 3,
                 "Each item of the loaded JSON queries that has "
-                "data must be an array of length 2!");
+                "data must be an array of length 2, or 3 with the query type!");
       const auto &query = data[0];
       const auto &param = data[1];
       MG_ASSERT(query.is_string() && param.is_object(),
@@ -540,11 +729,21 @@ int main(int argc, char **argv) {
       auto bolt_param = JsonToBoltValue(param);
       MG_ASSERT(bolt_param.IsMap(), "The Bolt parameters must be a map!");
       queries.emplace_back(query, std::move(bolt_param.ValueMap()));
+      if (data.size() == 3) {
+        MG_ASSERT(data[2].is_string(), "The query type must be a string!");
+        query_types.emplace_back(data[2].get<std::string>());
+      } else {
+        query_types.emplace_back("query");
+      }
     }
   }
 
   if (FLAGS_validation) {
     ExecuteValidation(queries, ostream);
+  } else if (FLAGS_target_throughput > 0) {
+    MG_ASSERT(!queries.empty(), "The open-loop execution needs at least one query!");
+    MG_ASSERT(FLAGS_latency_window_sec > 0, "The latency window must be positive!");
+    ExecuteOpenLoopWorkload(queries, query_types, ostream);
   } else if (FLAGS_time_dependent_execution > 0) {
     ExecuteTimeDependentWorkload(queries, ostream);
   } else {
@@ -125,6 +125,7 @@ class BoltClient(BaseClient):
         max_retries: int = 10000,
         validation: bool = False,
         time_dependent_execution: int = 0,
+        open_loop: dict = {},
     ):
         check_db_query = Path(self._directory.name) / "check_db_query.json"
         with open(check_db_query, "w") as f:
@@ -177,6 +178,7 @@ class BoltClient(BaseClient):
             port=self._bolt_port,
             validation=validation,
             time_dependent_execution=time_dependent_execution,
+            **open_loop,
         )
 
         ret = None
@@ -245,6 +247,7 @@ class BoltClientDocker(BaseClient):
         max_retries: int = 50,
         validation: bool = False,
         time_dependent_execution: int = 0,
+        open_loop: dict = {},
     ):
         if (queries is None and file_path is None) or (queries is not None and file_path is not None):
             raise ValueError("Either queries or input_path must be specified!")
@@ -327,6 +330,7 @@ class BoltClientDocker(BaseClient):
             port=self._bolt_port,
             validation=validation,
             time_dependent_execution=time_dependent_execution,
+            **open_loop,
         )
 
         self._create_container(*args)
@@ -0,0 +1,49 @@
+# Copyright 2023 Memgraph Ltd.
+#
+# Use of this software is governed by the Business Source License
+# included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+# License, and you may not use this file except in compliance with the Business Source License.
+#
+# As of the Change Date specified in that file, in accordance with
+# the Business Source License, use of this software will be governed
+# by the Apache License, Version 2.0, included in the file
+# licenses/APL.txt.
+
+import random
+
+from workloads.base import Workload
+
+
+class UnwindMerge(Workload):
+    NAME = "unwind_merge"
+    CARDINALITY = 100000
+    BATCH_SIZE = 10000
+
+    def indexes_generator(self):
+        return [
+            ("CREATE INDEX ON :User;", {}),
+            ("CREATE INDEX ON :User(id);", {}),
+        ]
+
+    def dataset_generator(self):
+        queries = []
+        for i in range(0, UnwindMerge.CARDINALITY, 2):
+            queries.append(("CREATE (:User {id: $id});", {"id": i}))
+        return queries
+
+    def _rows(self):
+        # Half of the keys exist and some of the keys repeat within the batch,
+        # like in the batches sent by the importers.
+        return [
+            {
+                "id": random.randrange(UnwindMerge.CARDINALITY),
+                "props": {"name": f"user{i}", "score": i},
+            }
+            for i in range(UnwindMerge.BATCH_SIZE)
+        ]
+
+    def benchmark__test__unwind_merge(self):
+        return ("UNWIND $rows AS row MERGE (n:User {id: row.id});", {"rows": self._rows()})
+
+    def benchmark__test__unwind_merge_set_properties(self):
+        return ("UNWIND $rows AS row MERGE (n:User {id: row.id}) SET n += row.props;", {"rows": self._rows()})
@@ -225,4 +225,24 @@ TYPED_TEST(FineGrainedAuthCheckerFixture, GrantAndDenySpecificEdgeTypes) {
   ASSERT_FALSE(auth_checker.Has(this->r3, memgraph::query::AuthQuery::FineGrainedPrivilege::READ));
   ASSERT_FALSE(auth_checker.Has(this->r4, memgraph::query::AuthQuery::FineGrainedPrivilege::READ));
 }
+
+TYPED_TEST(FineGrainedAuthCheckerFixture, RepeatedChecksOfDifferentPrivileges) {
+  memgraph::auth::User user{"test"};
+  user.fine_grained_access_handler().label_permissions().Grant("l1", memgraph::auth::FineGrainedPermission::READ);
+  user.fine_grained_access_handler().edge_type_permissions().Grant("edge_type_1",
+                                                                   memgraph::auth::FineGrainedPermission::UPDATE);
+  memgraph::glue::FineGrainedAuthChecker auth_checker{user, &this->dba};
+
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_TRUE(auth_checker.Has(this->v1, memgraph::storage::View::OLD,
+                                 memgraph::query::AuthQuery::FineGrainedPrivilege::READ));
+    ASSERT_FALSE(auth_checker.Has(this->v1, memgraph::storage::View::OLD,
+                                  memgraph::query::AuthQuery::FineGrainedPrivilege::UPDATE));
+    ASSERT_FALSE(auth_checker.Has(this->v2, memgraph::storage::View::OLD,
+                                  memgraph::query::AuthQuery::FineGrainedPrivilege::READ));
+    ASSERT_TRUE(auth_checker.Has(this->r1, memgraph::query::AuthQuery::FineGrainedPrivilege::UPDATE));
+    ASSERT_TRUE(auth_checker.Has(this->r1, memgraph::query::AuthQuery::FineGrainedPrivilege::READ));
+    ASSERT_FALSE(auth_checker.Has(this->r1, memgraph::query::AuthQuery::FineGrainedPrivilege::CREATE_DELETE));
+  }
+}
 #endif
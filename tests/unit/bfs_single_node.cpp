@@ -127,6 +127,63 @@ INSTANTIATE_TEST_CASE_P(FilterLambda, SingleNodeBfsTestInMemory,
                                                          FilterLambdaType::USE_FRAME_NULL, FilterLambdaType::USE_CTX,
                                                          FilterLambdaType::ERROR)));
 
+// Wide frontiers are expanded by several threads when parallel execution is
+// requested, which must give the same results as the serial expansion.
+TEST(SingleNodeBfsTestInMemory, ParallelFrontier) {
+  constexpr int64_t kWidth = 3000;
+  memgraph::storage::InMemoryStorage db;
+  auto storage_dba = db.Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  const auto edge_type = dba.NameToEdgeType("a");
+  auto source = dba.InsertVertex();
+  auto sink = dba.InsertVertex();
+  for (int64_t i = 0; i < kWidth; ++i) {
+    auto first = dba.InsertVertex();
+    auto second = dba.InsertVertex();
+    ASSERT_TRUE(dba.InsertEdge(&source, &first, edge_type).HasValue());
+    ASSERT_TRUE(dba.InsertEdge(&first, &second, edge_type).HasValue());
+    ASSERT_TRUE(dba.InsertEdge(&second, &sink, edge_type).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  for (const bool known_sink : {false, true}) {
+    std::vector<std::vector<std::pair<int64_t, size_t>>> results;
+    for (const uint64_t parallelism : {1, 4}) {
+      memgraph::query::ExecutionContext context{.db_accessor = &dba, .parallelism = parallelism};
+      auto source_sym = context.symbol_table.CreateSymbol("source", true);
+      auto sink_sym = context.symbol_table.CreateSymbol("sink", true);
+      auto edges_sym = context.symbol_table.CreateSymbol("edges", true);
+      auto inner_node_sym = context.symbol_table.CreateSymbol("inner_node", true);
+      auto inner_edge_sym = context.symbol_table.CreateSymbol("inner_edge", true);
+      std::vector<memgraph::query::Symbol> yielded{source_sym};
+      std::vector<memgraph::query::TypedValue> row{memgraph::query::TypedValue(source)};
+      if (known_sink) {
+        yielded.push_back(sink_sym);
+        row.emplace_back(sink);
+      }
+      auto input_op =
+          std::make_shared<Yield>(nullptr, yielded, std::vector<std::vector<memgraph::query::TypedValue>>{row});
+      auto bfs = std::make_shared<ExpandVariable>(
+          input_op, source_sym, sink_sym, edges_sym, EdgeAtom::Type::BREADTH_FIRST, EdgeAtom::Direction::OUT,
+          std::vector<memgraph::storage::EdgeTypeId>{}, false, nullptr, nullptr, known_sink,
+          ExpansionLambda{inner_edge_sym, inner_node_sym, nullptr}, std::nullopt, std::nullopt);
+      auto &result = results.emplace_back();
+      for (const auto &pulled : PullResults(bfs.get(), &context, {sink_sym, edges_sym})) {
+        result.emplace_back(pulled[0].ValueVertex().Gid().AsInt(), pulled[1].ValueList().size());
+      }
+      std::sort(result.begin(), result.end());
+    }
+    if (known_sink) {
+      ASSERT_EQ(results[0].size(), 1U);
+      EXPECT_EQ(results[0][0].second, 3U);
+    } else {
+      EXPECT_EQ(results[0].size(), static_cast<size_t>(2 * kWidth + 1));
+    }
+    EXPECT_EQ(results[0], results[1]);
+  }
+  dba.Abort();
+}
+
 class SingleNodeBfsTestOnDisk
     : public ::testing::TestWithParam<
           std::tuple<int, int, EdgeAtom::Direction, std::vector<std::string>, bool, FilterLambdaType>> {
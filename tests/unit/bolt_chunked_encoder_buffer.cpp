@@ -109,3 +109,118 @@ TEST_F(BoltChunkedEncoderBuffer, OneAndAHalfOfMaxChunk) {
   VerifyChunkOfTestData(output, kChunkMaxDataSize);
   VerifyChunkOfTestData(output + kChunkWholeSize, kTestDataSize - kChunkMaxDataSize, kChunkMaxDataSize);
 }
+
+TEST_F(BoltChunkedEncoderBuffer, FlushWithMoreKeepsChunks) {
+  TestOutputStream output_stream;
+  BufferT buffer(output_stream);
+
+  // chunks flushed with more data following stay in the buffer
+  buffer.Write(test_data, 100);
+  buffer.Flush(true);
+  buffer.Write(test_data + 100, 200);
+  buffer.Flush(true);
+  ASSERT_TRUE(output_stream.output.empty());
+
+  buffer.Flush();
+  auto data = output_stream.output.data();
+  ASSERT_EQ(output_stream.output.size(), 3 * kChunkHeaderSize + 300);
+  VerifyChunkOfTestData(data, 100);
+  VerifyChunkOfTestData(data + kChunkHeaderSize + 100, 200, 100);
+  ASSERT_EQ(data[2 * kChunkHeaderSize + 300], 0);
+  ASSERT_EQ(data[2 * kChunkHeaderSize + 301], 0);
+}
+
+TEST_F(BoltChunkedEncoderBuffer, ClearKeepsFlushedChunks) {
+  TestOutputStream output_stream;
+  BufferT buffer(output_stream);
+
+  buffer.Write(test_data, 100);
+  buffer.Flush(true);
+  buffer.Write(test_data + 100, 200);
+  buffer.Clear();
+  ASSERT_FALSE(buffer.HasData());
+  buffer.Write(test_data + 100, 50);
+  buffer.Flush();
+
+  auto data = output_stream.output.data();
+  ASSERT_EQ(output_stream.output.size(), 2 * kChunkHeaderSize + 150);
+  VerifyChunkOfTestData(data, 100);
+  VerifyChunkOfTestData(data + kChunkHeaderSize + 100, 50, 100);
+}
+
+TEST_F(BoltChunkedEncoderBuffer, HoldKeepsFlushedChunks) {
+  TestOutputStream output_stream;
+  BufferT buffer(output_stream);
+
+  // messages which end while the buffer is held are sent when it's released
+  buffer.Hold();
+  buffer.Write(test_data, 100);
+  buffer.Flush(true);
+  buffer.Flush();
+  buffer.Write(test_data + 100, 200);
+  buffer.Flush(true);
+  buffer.Flush();
+  ASSERT_TRUE(output_stream.output.empty());
+
+  ASSERT_TRUE(buffer.Release());
+  auto data = output_stream.output.data();
+  ASSERT_EQ(output_stream.output.size(), 4 * kChunkHeaderSize + 300);
+  VerifyChunkOfTestData(data, 100);
+  VerifyChunkOfTestData(data + 2 * kChunkHeaderSize + 100, 200, 100);
+
+  // after the release flushes send the chunks again
+  buffer.Write(test_data, 100);
+  buffer.Flush();
+  ASSERT_EQ(output_stream.output.size(), 5 * kChunkHeaderSize + 400);
+  ASSERT_TRUE(buffer.Release());
+  ASSERT_EQ(output_stream.output.size(), 5 * kChunkHeaderSize + 400);
+}
+
+TEST_F(BoltChunkedEncoderBuffer, WriteReference) {
+  TestOutputStream output_stream;
+  BufferT buffer(output_stream);
+
+  // referenced data is chunked like copied data and is sent on the next flush
+  buffer.Write(test_data, 100);
+  buffer.WriteReference(test_data + 100, kTestDataSize - 100);
+  buffer.Flush(true);
+
+  auto output = output_stream.output.data();
+  ASSERT_EQ(output_stream.output.size(), 2 * kChunkHeaderSize + kTestDataSize);
+  VerifyChunkOfTestData(output, kChunkMaxDataSize);
+  VerifyChunkOfTestData(output + kChunkWholeSize, kTestDataSize - kChunkMaxDataSize, kChunkMaxDataSize);
+}
+
+/// Output stream which also takes the chunks in a single vectored write.
+class TestVectoredOutputStream : public TestOutputStream {
+ public:
+  using TestOutputStream::Write;
+
+  bool Write(std::span<const iovec> buffers, bool /*have_more*/) {
+    ++vectored_writes;
+    for (const auto &buffer : buffers) {
+      if (!Write(static_cast<const uint8_t *>(buffer.iov_base), buffer.iov_len)) return false;
+    }
+    return true;
+  }
+
+  int vectored_writes{0};
+};
+
+TEST_F(BoltChunkedEncoderBuffer, VectoredWrite) {
+  TestVectoredOutputStream output_stream;
+  memgraph::communication::bolt::ChunkedEncoderBuffer<TestVectoredOutputStream> buffer(output_stream);
+
+  buffer.Write(test_data, 100);
+  buffer.WriteReference(test_data + 100, 10000);
+  buffer.Write(test_data + 10100, 100);
+  buffer.Flush();
+
+  ASSERT_EQ(output_stream.vectored_writes, 1);
+  ASSERT_EQ(output_stream.output.size(), kChunkHeaderSize + 10200);
+  VerifyChunkOfTestData(output_stream.output.data(), 10200);
+
+  output_stream.SetWriteSuccess(false);
+  buffer.Write(test_data, 100);
+  ASSERT_FALSE(buffer.Flush());
+}
@@ -58,12 +58,14 @@ class TestOutputStream {
   bool Write(const uint8_t *data, size_t len, bool have_more = false) {
     if (!write_success_) return false;
     for (size_t i = 0; i < len; ++i) output.push_back(data[i]);
+    ++writes;
     return true;
   }
 
   void SetWriteSuccess(bool success) { write_success_ = success; }
 
   std::vector<uint8_t> output;
+  int writes{0};
 
  protected:
   bool write_success_{true};
@@ -18,7 +18,11 @@
 #include "communication/bolt/v1/codes.hpp"
 #include "communication/bolt/v1/encoder/encoder.hpp"
 #include "disk_test_utils.hpp"
+#include "communication/bolt/v1/exceptions.hpp"
 #include "glue/communication.hpp"
+#include "glue/typed_value_encoder.hpp"
+#include "query/graph.hpp"
+#include "query/path.hpp"
 #include "storage/v2/disk/storage.hpp"
 #include "storage/v2/inmemory/storage.hpp"
 #include "storage/v2/storage.hpp"
@@ -243,6 +247,92 @@ TEST_F(BoltEncoder, VertexAndEdgeOnDiskStorage) {
   disk_test_utils::RemoveRocksDbDirs(testSuite);
 }
 
+void TestTypedValueEncoderWithDifferentStorages(std::unique_ptr<memgraph::storage::Storage> &&db) {
+  using memgraph::query::TypedValue;
+  auto dba = db->Access();
+  auto va1 = dba->CreateVertex();
+  auto va2 = dba->CreateVertex();
+  ASSERT_TRUE(va1.AddLabel(dba->NameToLabel("label")).HasValue());
+  // The properties are created in the reverse order of their names.
+  ASSERT_TRUE(va1.SetProperty(dba->NameToProperty("zeta"), memgraph::storage::PropertyValue("text")).HasValue());
+  ASSERT_TRUE(va1.SetProperty(dba->NameToProperty("alpha"),
+                              memgraph::storage::PropertyValue(std::vector<memgraph::storage::PropertyValue>{
+                                  memgraph::storage::PropertyValue(1), memgraph::storage::PropertyValue(2.5)}))
+                  .HasValue());
+  ASSERT_TRUE(va2.SetProperty(dba->NameToProperty("date"),
+                              memgraph::storage::PropertyValue(memgraph::storage::TemporalData(
+                                  memgraph::storage::TemporalType::Date, 86400000000)))
+                  .HasValue());
+  auto ea = dba->CreateEdge(&va1, &va2, dba->NameToEdgeType("edgetype")).GetValue();
+  ASSERT_TRUE(ea.SetProperty(dba->NameToProperty("weight"), memgraph::storage::PropertyValue(42)).HasValue());
+
+  const memgraph::query::VertexAccessor v1(va1);
+  const memgraph::query::VertexAccessor v2(va2);
+  const memgraph::query::EdgeAccessor e(ea);
+  // The path goes back over the same edge, which is written once.
+  const memgraph::query::Path path(v1, e, v2, e, v1);
+  memgraph::query::Graph graph(memgraph::utils::NewDeleteResource());
+  graph.InsertVertex(v1);
+  graph.InsertVertex(v2);
+  graph.InsertEdge(e);
+
+  std::vector<TypedValue> values;
+  values.emplace_back();
+  values.emplace_back(true);
+  values.emplace_back(1234567);
+  values.emplace_back(3.14);
+  values.emplace_back("string");
+  values.emplace_back(std::vector<TypedValue>{TypedValue(1), TypedValue(v2)});
+  values.emplace_back(std::map<std::string, TypedValue>{{"b", TypedValue(e)}, {"a", TypedValue("x")}});
+  values.emplace_back(v1);
+  values.emplace_back(e);
+  values.emplace_back(path);
+  values.emplace_back(memgraph::utils::Date(86400000000));
+  values.emplace_back(memgraph::utils::Duration(1234));
+  values.emplace_back(std::move(graph));
+
+  for (const int major_version : {1, 4, 5}) {
+    SCOPED_TRACE(major_version);
+    output.clear();
+    bolt_encoder.UpdateVersion(major_version);
+    std::vector<Value> bolt_values;
+    for (const auto &value : values) {
+      bolt_values.push_back(*memgraph::glue::ToBoltValue(value, *db, memgraph::storage::View::NEW));
+    }
+    bolt_encoder.MessageRecord(bolt_values);
+    const auto expected = output;
+
+    output.clear();
+    memgraph::glue::TypedValueEncoder encoder(*db, memgraph::storage::View::NEW, major_version);
+    encoder.EncodeFields(values);
+    bolt_encoder.MessageRecord(encoder.data(), encoder.size());
+    EXPECT_EQ(output, expected);
+  }
+  bolt_encoder.UpdateVersion(0);
+  output.clear();
+
+  auto deleted = dba->CreateVertex();
+  ASSERT_TRUE(dba->DeleteVertex(&deleted).HasValue());
+  memgraph::glue::TypedValueEncoder encoder(*db, memgraph::storage::View::NEW, 4);
+  EXPECT_THROW(encoder.EncodeFields({TypedValue(memgraph::query::VertexAccessor(deleted))}),
+               memgraph::communication::bolt::ClientError);
+}
+
+TEST_F(BoltEncoder, TypedValueEncoderInMemoryStorage) {
+  std::unique_ptr<memgraph::storage::Storage> db{new memgraph::storage::InMemoryStorage()};
+  TestTypedValueEncoderWithDifferentStorages(std::move(db));
+}
+
+TEST_F(BoltEncoder, TypedValueEncoderOnDiskStorage) {
+  const std::string testSuite = "bolt_encoder";
+  memgraph::storage::Config config = disk_test_utils::GenerateOnDiskConfig(testSuite);
+
+  std::unique_ptr<memgraph::storage::Storage> db{new memgraph::storage::DiskStorage(config)};
+  TestTypedValueEncoderWithDifferentStorages(std::move(db));
+
+  disk_test_utils::RemoveRocksDbDirs(testSuite);
+}
+
 TEST_F(BoltEncoder, BoltV1ExampleMessages) {
   // this test checks example messages from: http://boltprotocol.org/v1/
 
@@ -18,6 +18,7 @@
 #include "communication/bolt/v1/session.hpp"
 #include "communication/exceptions.hpp"
 #include "query/exceptions.hpp"
+#include "utils/compressor.hpp"
 #include "utils/logging.hpp"
 
 using memgraph::communication::bolt::ChunkedEncoderBuffer;
@@ -107,7 +108,10 @@ class TestSession final : public Session<TestInputStream, TestOutputStream> {
       if (!metadata.empty()) md_ = metadata;
     }
   }
-  void CommitTransaction() override { md_.clear(); }
+  std::map<std::string, Value> CommitTransaction() override {
+    md_.clear();
+    return {};
+  }
   void RollbackTransaction() override { md_.clear(); }
 
   void Abort() override { md_.clear(); }
@@ -116,6 +120,8 @@ class TestSession final : public Session<TestInputStream, TestOutputStream> {
 
   std::optional<std::string> GetServerNameForInit() override { return std::nullopt; }
 
+  bool IsCompressionAllowed() override { return true; }
+
   void Configure(const std::map<std::string, memgraph::communication::bolt::Value> &) override {}
   std::string GetDatabaseName() const override { return ""; }
 
@@ -904,6 +910,74 @@ TEST(BoltSession, MultipleChunksInOneExecute) {
   ASSERT_EQ(num, 3);
 }
 
+TEST(BoltSession, PipelinedMessages) {
+  INIT_VARS;
+
+  ExecuteHandshake(input_stream, session, output);
+  ExecuteInit(input_stream, session, output);
+
+  // both queries are received before the session is executed
+  for (int i = 0; i < 2; ++i) {
+    WriteRunRequest(input_stream, kQueryReturn42);
+    WriteChunkHeader(input_stream, sizeof(pullall_req));
+    input_stream.Write(pullall_req, sizeof(pullall_req));
+    WriteChunkTail(input_stream);
+  }
+  output_stream.writes = 0;
+  session.Execute();
+
+  ASSERT_EQ(session.state_, State::Idle);
+  PrintOutput(output);
+
+  // all the responses are sent at once
+  ASSERT_EQ(output_stream.writes, 1);
+  int len, num = 0;
+  while (output.size() > 0) {
+    len = (output[0] << 8) + output[1];
+    output.erase(output.begin(), output.begin() + len + 4);
+    ++num;
+  }
+  ASSERT_EQ(num, 6);
+}
+
+TEST(BoltSession, Compression) {
+  INIT_VARS;
+
+  ExecuteHandshake(input_stream, session, output, v4::handshake_req, v4::handshake_resp);
+  // HELLO {user_agent: "a", scheme: "none", compression: "zlib"}
+  const std::string hello =
+      "\xb1\x01\xa3\x8auser_agent\x81"
+      "a\x86scheme\x84none\x8b"
+      "compression\x84zlib";
+  ExecuteCommand(input_stream, session, reinterpret_cast<const uint8_t *>(hello.data()), hello.size());
+  ASSERT_EQ(session.state_, State::Idle);
+
+  // The success message confirms the compression and isn't compressed.
+  const char hello_resp[] =
+      "\x00\x29\xb1\x70\xa2\x8b"
+      "compression\x84zlib\x8d"
+      "connection_id\x86"
+      "bolt-1\x00\x00";
+  CheckOutput(output, reinterpret_cast<const uint8_t *>(hello_resp), sizeof(hello_resp) - 1);
+
+  WriteRunRequest(input_stream, kQueryReturn42, true);
+  ExecuteCommand(input_stream, session, v4::pullall_req, sizeof(v4::pullall_req));
+  ASSERT_EQ(session.state_, State::Idle);
+
+  std::vector<uint8_t> decompressed;
+  memgraph::utils::StreamDecompressor decompressor;
+  ASSERT_TRUE(decompressor.Decompress(output.data(), output.size(), decompressed));
+  int len, num = 0;
+  while (decompressed.size() > 0) {
+    ASSERT_GE(decompressed.size(), 4);
+    len = (decompressed[0] << 8) + decompressed[1];
+    decompressed.erase(decompressed.begin(), decompressed.begin() + len + 4);
+    ++num;
+  }
+  // the header, the record and the summary
+  ASSERT_EQ(num, 3);
+}
+
 TEST(BoltSession, PartialPull) {
   INIT_VARS;
 
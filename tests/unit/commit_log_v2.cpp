@@ -79,3 +79,24 @@ TEST(CommitLog, TrackAfterInitialId) {
     check_marking_ids(&log, i);
   }
 }
+
+TEST(CommitLog, OldestActiveExcept) {
+  memgraph::storage::CommitLog log;
+  EXPECT_EQ(log.OldestActiveExcept(0), 1);
+
+  for (uint64_t i = 1; i < ids_per_block + 10; ++i) {
+    log.MarkFinished(i);
+  }
+  EXPECT_EQ(log.OldestActive(), 0);
+  EXPECT_EQ(log.OldestActiveExcept(0), ids_per_block + 10);
+  EXPECT_EQ(log.OldestActiveExcept(5), 0);
+
+  log.MarkFinished(ids_per_block + 11);
+  EXPECT_EQ(log.OldestActiveExcept(0), ids_per_block + 10);
+  log.MarkFinished(ids_per_block + 10);
+  EXPECT_EQ(log.OldestActiveExcept(0), ids_per_block + 12);
+
+  log.MarkFinished(0);
+  EXPECT_EQ(log.OldestActive(), ids_per_block + 12);
+  EXPECT_EQ(log.OldestActiveExcept(ids_per_block + 12), ids_per_block + 13);
+}
@@ -0,0 +1,110 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <latch>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "communication/v2/execution_pool.hpp"
+
+using memgraph::communication::v2::ExecutionPool;
+using namespace std::chrono_literals;
+
+TEST(ExecutionPool, PriorityOf) {
+  ExecutionPool pool(4, 100ms);
+  EXPECT_EQ(pool.PriorityOf(10ms), ExecutionPool::Priority::SHORT);
+  EXPECT_EQ(pool.PriorityOf(100ms), ExecutionPool::Priority::LONG);
+  EXPECT_EQ(pool.PriorityOf(std::chrono::duration<double>(1.5)), ExecutionPool::Priority::LONG);
+  EXPECT_EQ(pool.MaxLongWorkers(), 3);
+  EXPECT_EQ(ExecutionPool(1, 100ms).MaxLongWorkers(), 1);
+  EXPECT_EQ(ExecutionPool(2, 100ms).MaxLongWorkers(), 1);
+}
+
+TEST(ExecutionPool, ExecutesAllTasks) {
+  ExecutionPool pool(4, 100ms);
+  pool.Run();
+  constexpr int kTasks = 1000;
+  std::atomic<int> executed{0};
+  std::latch done(kTasks);
+  for (int i = 0; i < kTasks; ++i) {
+    pool.Schedule(i % 2 ? ExecutionPool::Priority::SHORT : ExecutionPool::Priority::LONG, [&] {
+      ++executed;
+      done.count_down();
+    });
+  }
+  done.wait();
+  EXPECT_EQ(executed, kTasks);
+  pool.Shutdown();
+  pool.AwaitShutdown();
+  EXPECT_FALSE(pool.IsRunning());
+}
+
+TEST(ExecutionPool, LongTasksLeaveWorkersForShortOnes) {
+  ExecutionPool pool(4, 100ms);
+  pool.Run();
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::atomic<int> long_running{0};
+  for (size_t i = 0; i < pool.MaxLongWorkers() + 2; ++i) {
+    pool.Schedule(ExecutionPool::Priority::LONG, [&long_running, released] {
+      ++long_running;
+      released.wait();
+    });
+  }
+
+  // A short task gets a worker while the long ones are blocked.
+  std::promise<void> short_done;
+  pool.Schedule(ExecutionPool::Priority::SHORT, [&] { short_done.set_value(); });
+  ASSERT_EQ(short_done.get_future().wait_for(10s), std::future_status::ready);
+  EXPECT_LE(long_running, pool.MaxLongWorkers());
+
+  release.set_value();
+  pool.Shutdown();
+  pool.AwaitShutdown();
+}
+
+TEST(ExecutionPool, PinnedWorkersRunOnOneNode) {
+  const auto nodes = memgraph::utils::NumaNodeCpus();
+  // The affinity can be narrower than the node if the process is restricted
+  // to some of its CPUs.
+  const auto pinned_to_node = [&nodes](const cpu_set_t &cpu_set) {
+    return std::any_of(nodes.begin(), nodes.end(), [&cpu_set](const auto &cpus) {
+      const auto on_node = std::count_if(cpus.begin(), cpus.end(),
+                                         [&cpu_set](const auto cpu) { return CPU_ISSET(cpu, &cpu_set); });
+      return on_node > 0 && on_node == CPU_COUNT(&cpu_set);
+    });
+  };
+  ExecutionPool pool(4, 100ms, true);
+  pool.Run();
+  constexpr int kTasks = 100;
+  std::atomic<int> pinned{0};
+  std::latch done(kTasks);
+  for (int i = 0; i < kTasks; ++i) {
+    pool.Schedule(ExecutionPool::Priority::SHORT, [&] {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0 && pinned_to_node(cpu_set)) ++pinned;
+      done.count_down();
+    });
+  }
+  done.wait();
+  EXPECT_EQ(pinned, kTasks);
+  pool.Shutdown();
+  pool.AwaitShutdown();
+}
@@ -367,6 +367,96 @@ TEST_P(CsvReaderTest, EmptyColumns) {
   }
 }
 
+TEST_P(CsvReaderTest, QuotedFields) {
+  // create a file with quoted fields containing delimiters, escaped quotes and
+  // parts of a multi-character quote;
+  // parser should return the unquoted values
+  const auto filepath = csv_directory / "bla.csv";
+  auto writer = FileWriter(filepath, GetParam().newline, GetParam().compressionMethod);
+
+  memgraph::utils::MemoryResource *mem(memgraph::utils::NewDeleteResource());
+
+  writer.WriteLine("\"a long quoted value, with delimiters\",plain,\"with \"\"escaped\"\" quotes\"");
+  writer.WriteLine("$$x$y$$,$$$$$$$$");
+
+  writer.Close();
+
+  {
+    const Reader::Config cfg(false, false, memgraph::utils::pmr::string{",", mem},
+                             memgraph::utils::pmr::string{"\"", mem});
+    auto reader = Reader(FileCsvSource{filepath}, cfg);
+    const auto parsed_row = reader.GetNextRow(mem);
+    ASSERT_TRUE(parsed_row.has_value());
+    ASSERT_EQ(*parsed_row, ToPmrColumns({"a long quoted value, with delimiters", "plain", "with \"escaped\" quotes"}));
+  }
+
+  {
+    const Reader::Config cfg(false, false, memgraph::utils::pmr::string{",", mem},
+                             memgraph::utils::pmr::string{"$$", mem});
+    auto reader = Reader(FileCsvSource{filepath}, cfg);
+    ASSERT_TRUE(reader.GetNextRow(mem).has_value());
+    const auto parsed_row = reader.GetNextRow(mem);
+    ASSERT_TRUE(parsed_row.has_value());
+    ASSERT_EQ(*parsed_row, ToPmrColumns({"x$y", "$$"}));
+  }
+}
+
+TEST_P(CsvReaderTest, ParallelParsing) {
+  // create a file which is split into several chunks, with multiline quoted
+  // strings and bad rows in between;
+  // the parallel parser should return the same rows as the sequential one
+  const auto filepath = csv_directory / "bla.csv";
+  auto writer = FileWriter(filepath, GetParam().newline, GetParam().compressionMethod);
+
+  memgraph::utils::MemoryResource *mem(memgraph::utils::NewDeleteResource());
+
+  const memgraph::utils::pmr::string delimiter{",", mem};
+  const memgraph::utils::pmr::string quote{"\"", mem};
+
+  writer.WriteLine(CreateRow({"A", "B", "C"}, delimiter));
+  for (auto i = 0; i < 100000; ++i) {
+    const auto value = std::to_string(i);
+    if (i % 37 == 0) {
+      writer.WriteLine(CreateRow({value, "\"bad\"" + value, "C"}, delimiter));
+    } else if (i % 10 == 0) {
+      writer.WriteLine(CreateRow({value, "\"multi", "line\"\"" + value}, delimiter));
+      writer.WriteLine(CreateRow({"\"", "C"}, delimiter));
+    } else {
+      writer.WriteLine(CreateRow({value, "\"" + value + "\"", "C"}, delimiter));
+    }
+  }
+
+  writer.Close();
+
+  const auto read_rows = [&](const bool ignore_bad, const uint64_t parallelism) {
+    auto cfg = Reader::Config(true, ignore_bad, delimiter, quote);
+    cfg.parallelism = parallelism;
+    auto reader = Reader(FileCsvSource{filepath}, cfg);
+    std::vector<Reader::Row> rows;
+    while (auto parsed_row = reader.GetNextRow(mem)) {
+      rows.push_back(std::move(*parsed_row));
+    }
+    return rows;
+  };
+
+  const auto rows = read_rows(true, 1);
+  ASSERT_EQ(rows.size(), 100000 - 2703);
+  ASSERT_EQ(rows[9], ToPmrColumns({"10", "multi,line\"10", "C"}));
+  ASSERT_EQ(read_rows(true, 4), rows);
+
+  try {
+    read_rows(false, 1);
+    FAIL() << "Expected a bad row";
+  } catch (const CsvReadException &sequential_error) {
+    try {
+      read_rows(false, 4);
+      FAIL() << "Expected a bad row";
+    } catch (const CsvReadException &parallel_error) {
+      ASSERT_STREQ(parallel_error.what(), sequential_error.what());
+    }
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(NewlineParameterizedTest, CsvReaderTest,
                         ::testing::Values(TestParam{"\n", CompressionMethod::NONE},
                                           TestParam{"\r\n", CompressionMethod::NONE},
@@ -1807,7 +1807,58 @@ TEST_P(CypherMainVisitorTest, DropIndexWithoutProperties) {
 
 TEST_P(CypherMainVisitorTest, DropIndexWithMultipleProperties) {
   auto &ast_generator = *GetParam();
-  EXPECT_THROW(ast_generator.ParseQuery("dRoP InDeX oN :mirko(slavko, pero)"), SyntaxException);
+  auto *index_query = dynamic_cast<IndexQuery *>(ast_generator.ParseQuery("dRoP InDeX oN :mirko(slavko, pero)"));
+  ASSERT_TRUE(index_query);
+  EXPECT_EQ(index_query->action_, IndexQuery::Action::DROP);
+  EXPECT_EQ(index_query->label_, ast_generator.Label("mirko"));
+  std::vector<PropertyIx> expected_properties{ast_generator.Prop("slavko"), ast_generator.Prop("pero")};
+  EXPECT_EQ(index_query->properties_, expected_properties);
+}
+
+TEST_P(CypherMainVisitorTest, CreateIndexWithMultipleProperties) {
+  auto &ast_generator = *GetParam();
+  auto *index_query = dynamic_cast<IndexQuery *>(ast_generator.ParseQuery("Create InDeX oN :mirko(slavko, pero)"));
+  ASSERT_TRUE(index_query);
+  EXPECT_EQ(index_query->action_, IndexQuery::Action::CREATE);
+  EXPECT_EQ(index_query->label_, ast_generator.Label("mirko"));
+  std::vector<PropertyIx> expected_properties{ast_generator.Prop("slavko"), ast_generator.Prop("pero")};
+  EXPECT_EQ(index_query->properties_, expected_properties);
+}
+
+TEST_P(CypherMainVisitorTest, CreateIndexWithRepeatedProperty) {
+  auto &ast_generator = *GetParam();
+  EXPECT_THROW(ast_generator.ParseQuery("Create InDeX oN :mirko(slavko, slavko)"), SemanticException);
+}
+
+TEST_P(CypherMainVisitorTest, CreateEdgeIndex) {
+  auto &ast_generator = *GetParam();
+  {
+    auto *index_query = dynamic_cast<EdgeIndexQuery *>(ast_generator.ParseQuery("Create EdGe InDeX oN :mirko"));
+    ASSERT_TRUE(index_query);
+    EXPECT_EQ(index_query->action_, EdgeIndexQuery::Action::CREATE);
+    EXPECT_EQ(index_query->edge_type_, ast_generator.EdgeType("mirko"));
+    EXPECT_TRUE(index_query->properties_.empty());
+  }
+  {
+    auto *index_query =
+        dynamic_cast<EdgeIndexQuery *>(ast_generator.ParseQuery("Create EdGe InDeX oN :mirko(slavko)"));
+    ASSERT_TRUE(index_query);
+    EXPECT_EQ(index_query->action_, EdgeIndexQuery::Action::CREATE);
+    EXPECT_EQ(index_query->edge_type_, ast_generator.EdgeType("mirko"));
+    std::vector<PropertyIx> expected_properties{ast_generator.Prop("slavko")};
+    EXPECT_EQ(index_query->properties_, expected_properties);
+  }
+}
+
+TEST_P(CypherMainVisitorTest, DropEdgeIndex) {
+  auto &ast_generator = *GetParam();
+  auto *index_query = dynamic_cast<EdgeIndexQuery *>(ast_generator.ParseQuery("dRoP EdGe InDeX oN :mirko(slavko)"));
+  ASSERT_TRUE(index_query);
+  EXPECT_EQ(index_query->action_, EdgeIndexQuery::Action::DROP);
+  EXPECT_EQ(index_query->edge_type_, ast_generator.EdgeType("mirko"));
+  std::vector<PropertyIx> expected_properties{ast_generator.Prop("slavko")};
+  EXPECT_EQ(index_query->properties_, expected_properties);
+  EXPECT_THROW(ast_generator.ParseQuery("Create EdGe InDeX oN :mirko(slavko, pero)"), SyntaxException);
 }
 
 TEST_P(CypherMainVisitorTest, ReturnAll) {
@@ -2831,6 +2882,11 @@ TEST_P(CypherMainVisitorTest, DumpDatabase) {
   auto &ast_generator = *GetParam();
   auto *query = dynamic_cast<DumpQuery *>(ast_generator.ParseQuery("DUMP DATABASE"));
   ASSERT_TRUE(query);
+  EXPECT_FALSE(query->parallel_execution_);
+  auto *parallel_query =
+      dynamic_cast<DumpQuery *>(ast_generator.ParseQuery("DUMP DATABASE USING PARALLEL EXECUTION"));
+  ASSERT_TRUE(parallel_query);
+  EXPECT_TRUE(parallel_query->parallel_execution_);
 }
 
 namespace {
@@ -3530,6 +3586,54 @@ TEST_P(CypherMainVisitorTest, TestLoadCsvClause) {
   }
 }
 
+TEST_P(CypherMainVisitorTest, ParallelExecution) {
+  auto &ast_generator = *GetParam();
+
+  ASSERT_THROW(ast_generator.ParseQuery("USING PARALLEL MATCH (n) RETURN count(n)"), SyntaxException);
+  ASSERT_THROW(ast_generator.ParseQuery("MATCH (n) RETURN count(n) USING PARALLEL EXECUTION"), SyntaxException);
+  ASSERT_THROW(ast_generator.ParseQuery("MATCH (n) CALL { USING PARALLEL EXECUTION MATCH (m) RETURN m } RETURN n"),
+               SyntaxException);
+
+  {
+    auto *query = dynamic_cast<CypherQuery *>(ast_generator.ParseQuery("MATCH (n) RETURN count(n)"));
+    ASSERT_TRUE(query);
+    ASSERT_FALSE(query->parallel_execution_);
+  }
+
+  {
+    auto *query = dynamic_cast<CypherQuery *>(
+        ast_generator.ParseQuery("USING PARALLEL EXECUTION MATCH (n) RETURN count(n) QUERY MEMORY LIMIT 12MB"));
+    ASSERT_TRUE(query);
+    ASSERT_TRUE(query->parallel_execution_);
+    ASSERT_TRUE(query->memory_limit_);
+  }
+}
+
+TEST_P(CypherMainVisitorTest, PeriodicCommit) {
+  auto &ast_generator = *GetParam();
+
+  ASSERT_THROW(ast_generator.ParseQuery("USING PERIODIC UNWIND range(1, 10) AS x CREATE ()"), SyntaxException);
+  ASSERT_THROW(ast_generator.ParseQuery("UNWIND range(1, 10) AS x CREATE () USING PERIODIC COMMIT 5"),
+               SyntaxException);
+  ASSERT_THROW(ast_generator.ParseQuery("MATCH (n) CALL { USING PERIODIC COMMIT 5 CREATE () } RETURN n"),
+               SyntaxException);
+  ASSERT_THROW(ast_generator.ParseQuery("USING PERIODIC COMMIT 5 CREATE () UNION CREATE ()"), SemanticException);
+
+  {
+    auto *query = dynamic_cast<CypherQuery *>(ast_generator.ParseQuery("UNWIND range(1, 10) AS x CREATE ()"));
+    ASSERT_TRUE(query);
+    ASSERT_FALSE(query->commit_frequency_);
+  }
+
+  {
+    auto *query = dynamic_cast<CypherQuery *>(ast_generator.ParseQuery(
+        "USING PERIODIC COMMIT 5 UNWIND range(1, 10) AS x CREATE () QUERY MEMORY LIMIT 12MB"));
+    ASSERT_TRUE(query);
+    ast_generator.CheckLiteral(query->commit_frequency_, 5);
+    ASSERT_TRUE(query->memory_limit_);
+  }
+}
+
 TEST_P(CypherMainVisitorTest, MemoryLimit) {
   auto &ast_generator = *GetParam();
 
@@ -0,0 +1,64 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "integrations/adaptive_batching.hpp"
+
+using memgraph::integrations::AdaptiveBatching;
+using memgraph::integrations::AdaptiveBatchingConfig;
+using namespace std::chrono_literals;
+
+TEST(AdaptiveBatching, WithoutConfig) {
+  AdaptiveBatching batching{100, 100ms, std::nullopt};
+  batching.Update(100, 10s, 1000);
+  EXPECT_EQ(batching.BatchSize(), 100);
+  EXPECT_EQ(batching.BatchInterval(), 100ms);
+  EXPECT_EQ(batching.Stats().last_batch_size, 100);
+  EXPECT_EQ(batching.Stats().last_batch_latency, 10s);
+  EXPECT_EQ(batching.Stats().lag, 1000);
+}
+
+TEST(AdaptiveBatching, GrowsWhileLagging) {
+  AdaptiveBatching batching{100, 100ms, AdaptiveBatchingConfig{.max_batch_size = 300, .target_latency = 1s}};
+  batching.Update(100, 10ms, 1000);
+  EXPECT_EQ(batching.BatchSize(), 200);
+  batching.Update(200, 10ms, 1000);
+  EXPECT_EQ(batching.BatchSize(), 300);
+  EXPECT_EQ(batching.BatchInterval(), 100ms);
+
+  // Without lag the size stays the same.
+  batching.Update(300, 10ms, 0);
+  EXPECT_EQ(batching.BatchSize(), 300);
+}
+
+TEST(AdaptiveBatching, ShrinksWhenSlow) {
+  AdaptiveBatching batching{100, 100ms, AdaptiveBatchingConfig{.max_batch_size = 300, .target_latency = 1s}};
+  batching.Update(100, 2s, 1000);
+  EXPECT_EQ(batching.BatchSize(), 50);
+  for (int i = 0; i < 10; ++i) batching.Update(batching.BatchSize(), 2s, 1000);
+  EXPECT_EQ(batching.BatchSize(), memgraph::integrations::kMinimumSize);
+}
+
+TEST(AdaptiveBatching, ShortensIntervalWhenNotFull) {
+  AdaptiveBatching batching{100, 100ms, AdaptiveBatchingConfig{.max_batch_size = 300, .target_latency = 1s}};
+  batching.Update(10, 10ms, 0);
+  EXPECT_EQ(batching.BatchInterval(), 50ms);
+  batching.Update(10, 10ms, 0);
+  EXPECT_EQ(batching.BatchInterval(), 25ms);
+  batching.Update(100, 10ms, 0);
+  EXPECT_EQ(batching.BatchInterval(), 50ms);
+  batching.Update(100, 10ms, 0);
+  batching.Update(100, 10ms, 0);
+  EXPECT_EQ(batching.BatchInterval(), 100ms);
+}
@@ -10,6 +10,7 @@
 // licenses/APL.txt.
 
 #include <chrono>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -309,6 +310,46 @@ TEST_F(ConsumerTest, InvalidBatchSize) {
   EXPECT_NO_THROW(Consumer(info, kDummyConsumerFunction));
 }
 
+TEST_F(ConsumerTest, InvalidPartitionWorkers) {
+  auto info = CreateDefaultConsumerInfo();
+
+  info.partition_workers = 0;
+  EXPECT_THROW(Consumer(info, kDummyConsumerFunction), ConsumerFailedToInitializeException);
+
+  info.partition_workers = 4;
+  EXPECT_NO_THROW(Consumer(info, kDummyConsumerFunction));
+}
+
+TEST_F(ConsumerTest, PartitionWorkersKeepPartitionOrder) {
+  auto info = CreateDefaultConsumerInfo();
+  info.partition_workers = 4;
+  std::mutex received_mutex;
+  std::vector<int> received_messages;
+  auto consumer_function = [&](const std::vector<Message> &messages) {
+    std::lock_guard guard{received_mutex};
+    for (const auto &message : messages) {
+      received_messages.push_back(SpanToInt(message.Payload()));
+    }
+  };
+
+  auto consumer = CreateConsumer(std::move(info), std::move(consumer_function));
+  consumer->Start();
+  ASSERT_TRUE(consumer->IsRunning());
+
+  static constexpr auto kMessageCount = 100;
+  for (auto i = 1; i <= kMessageCount; ++i) {
+    SeedTopicWithInt(kTopicName, i);
+  }
+  std::this_thread::sleep_for(kDefaultBatchInterval * 10);
+  consumer->Stop();
+
+  std::lock_guard guard{received_mutex};
+  ASSERT_EQ(received_messages.size(), kMessageCount);
+  for (auto i = 0; i < kMessageCount; ++i) {
+    EXPECT_EQ(received_messages[i], i + 1);
+  }
+}
+
 TEST_F(ConsumerTest, DISABLED_StartsFromPreviousOffset) {
   static constexpr auto kBatchSize = 1;
   auto info = CreateDefaultConsumerInfo();
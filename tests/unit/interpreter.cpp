@@ -57,7 +57,8 @@ class InterpreterTest : public ::testing::Test {
   InterpreterTest()
       : data_directory(std::filesystem::temp_directory_path() / "MG_tests_unit_interpreter"),
         interpreter_context(std::make_unique<StorageType>(disk_test_utils::GenerateOnDiskConfig(testSuite)),
-                            {.execution_timeout_sec = 600}, data_directory) {}
+                            {.execution_timeout_sec = 600, .bookmark_wait_timeout = std::chrono::milliseconds(100)},
+                            data_directory) {}
 
   std::filesystem::path data_directory;
   memgraph::query::InterpreterContext interpreter_context;
@@ -629,6 +630,37 @@ TYPED_TEST(InterpreterTest, UniqueConstraintTest) {
   this->Interpret("DROP CONSTRAINT ON (n:A) ASSERT n.a, n.b IS UNIQUE;");
 }
 
+TYPED_TEST(InterpreterTest, PeriodicCommit) {
+  // Periodic commit isn't supported with the on-disk storage.
+  if (std::is_same<TypeParam, memgraph::storage::DiskStorage>::value) return;
+
+  this->Interpret("USING PERIODIC COMMIT 2 UNWIND range(1, 5) AS x CREATE (:A {x: x})");
+  {
+    auto stream = this->Interpret("MATCH (n:A) RETURN count(n)");
+    ASSERT_EQ(stream.GetResults()[0][0].ValueInt(), 5);
+  }
+  {
+    auto stream = this->Interpret("USING PERIODIC COMMIT 2 MATCH (n:A) SET n.y = n.x RETURN n.y");
+    ASSERT_EQ(stream.GetResults().size(), 5U);
+  }
+
+  // The batches committed before the constraint violation stay committed.
+  this->Interpret("CREATE CONSTRAINT ON (n:B) ASSERT n.x IS UNIQUE");
+  ASSERT_THROW(this->Interpret("USING PERIODIC COMMIT 2 UNWIND [1, 2, 3, 3] AS x CREATE (:B {x: x})"),
+               memgraph::query::QueryException);
+  {
+    auto stream = this->Interpret("MATCH (n:B) RETURN count(n)");
+    ASSERT_EQ(stream.GetResults()[0][0].ValueInt(), 2);
+  }
+
+  ASSERT_THROW(this->Interpret("USING PERIODIC COMMIT 0 CREATE ()"), memgraph::query::QueryRuntimeException);
+
+  this->Interpret("BEGIN");
+  ASSERT_THROW(this->Interpret("USING PERIODIC COMMIT 2 CREATE ()"),
+               memgraph::query::ExplicitTransactionUsageException);
+  this->Interpret("ROLLBACK");
+}
+
 TYPED_TEST(InterpreterTest, ExplainQuery) {
   EXPECT_EQ(this->interpreter_context.plan_cache.size(), 0U);
   EXPECT_EQ(this->interpreter_context.ast_cache.size(), 0U);
@@ -877,6 +909,75 @@ TYPED_TEST(InterpreterTest, Transactions) {
   }
 }
 
+TYPED_TEST(InterpreterTest, Bookmarks) {
+  auto &interpreter = this->default_interpreter.interpreter;
+  auto [stream, qid] = this->Prepare("CREATE ()");
+  this->Pull(&stream);
+  ASSERT_EQ(stream.GetSummary().count("bookmark"), 1);
+  const auto timestamp =
+      memgraph::query::BookmarkToCommitTimestamp(stream.GetSummary().at("bookmark").ValueString());
+  ASSERT_TRUE(timestamp);
+  // The bookmark is returned only once
+  ASSERT_FALSE(interpreter.TakeBookmark());
+
+  // The bookmarked transaction is already visible
+  interpreter.BeginTransaction({.bookmark_timestamp = timestamp});
+  interpreter.CommitTransaction();
+  const auto bookmark = interpreter.TakeBookmark();
+  ASSERT_TRUE(bookmark);
+  ASSERT_GE(memgraph::query::BookmarkToCommitTimestamp(*bookmark), timestamp);
+
+  ASSERT_THROW(interpreter.BeginTransaction({.bookmark_timestamp = *timestamp + 1000}),
+               memgraph::query::BookmarkWaitTimeoutException);
+  ASSERT_FALSE(memgraph::query::BookmarkToCommitTimestamp("FB:kcwQ"));
+  ASSERT_FALSE(memgraph::query::BookmarkToCommitTimestamp("memgraph:12x"));
+}
+
+TYPED_TEST(InterpreterTest, PreparedStatements) {
+  auto &interpreter = this->default_interpreter.interpreter;
+  auto run = [&](const std::string &query, const std::string &statement_id,
+                 const std::map<std::string, memgraph::storage::PropertyValue> &params) {
+    ResultStreamFaker stream(this->interpreter_context.db.get());
+    const auto [header, _1, qid, _2] = interpreter.Prepare(query, params, nullptr, {.statement_id = statement_id});
+    stream.Header(header);
+    stream.Summary(interpreter.Pull(&stream, {}, qid));
+    return stream;
+  };
+
+  {
+    auto stream = run("RETURN $x + 1 AS y", "add", {{"x", memgraph::storage::PropertyValue(1)}});
+    ASSERT_EQ(stream.GetHeader().size(), 1U);
+    EXPECT_EQ(stream.GetHeader()[0], "y");
+    ASSERT_EQ(stream.GetResults().size(), 1U);
+    EXPECT_EQ(stream.GetResults()[0][0].ValueInt(), 2);
+  }
+
+  // The prepared statement doesn't need the AST cache anymore.
+  {
+    auto access = this->interpreter_context.ast_cache.access();
+    for (auto &kv : access) access.remove(kv.first);
+  }
+  {
+    auto stream = run("", "add", {{"x", memgraph::storage::PropertyValue(41)}});
+    ASSERT_EQ(stream.GetHeader().size(), 1U);
+    EXPECT_EQ(stream.GetHeader()[0], "y");
+    ASSERT_EQ(stream.GetResults().size(), 1U);
+    EXPECT_EQ(stream.GetResults()[0][0].ValueInt(), 42);
+    EXPECT_EQ(this->interpreter_context.ast_cache.size(), 0U);
+  }
+
+  ASSERT_THROW(run("", "add", {}), memgraph::query::UnprovidedParameterError);
+  ASSERT_THROW(run("", "unknown", {}), memgraph::query::PreparedStatementException);
+
+  // Preparing the statement again replaces it.
+  run("RETURN $x * 2 AS y", "add", {{"x", memgraph::storage::PropertyValue(1)}});
+  {
+    auto stream = run("", "add", {{"x", memgraph::storage::PropertyValue(21)}});
+    ASSERT_EQ(stream.GetResults().size(), 1U);
+    EXPECT_EQ(stream.GetResults()[0][0].ValueInt(), 42);
+  }
+}
+
 TYPED_TEST(InterpreterTest, Qid) {
   auto &interpreter = this->default_interpreter.interpreter;
   {
@@ -1081,6 +1182,50 @@ TYPED_TEST(InterpreterTest, CacheableQueries) {
   }
 }
 
+TYPED_TEST(InterpreterTest, ParameterSensitivePlanCache) {
+  this->Interpret("CREATE INDEX ON :Node(id)");
+  this->Interpret("CREATE (:Node {id: 1})");
+  this->Interpret("UNWIND range(1, 1000) AS x CREATE (:Node {id: 2})");
+
+  const std::string query = "MATCH (n:Node {id: $id}) RETURN count(n)";
+  auto count_plans = [&] {
+    size_t plans = 0;
+    auto access = this->interpreter_context.plan_cache.access();
+    for (const auto &entry : access) plans += entry.second->size();
+    return plans;
+  };
+  memgraph::query::InvalidatePlanCache(&this->interpreter_context.plan_cache);
+
+  {
+    SCOPED_TRACE("Leaf value");
+    auto stream = this->Interpret(query, {{"id", memgraph::storage::PropertyValue(1)}});
+    ASSERT_EQ(stream.GetResults().size(), 1U);
+    EXPECT_EQ(stream.GetResults()[0][0].ValueInt(), 1);
+    EXPECT_EQ(this->interpreter_context.plan_cache.size(), 1U);
+    EXPECT_EQ(count_plans(), 1U);
+  }
+  {
+    SCOPED_TRACE("Hub value");
+    auto stream = this->Interpret(query, {{"id", memgraph::storage::PropertyValue(2)}});
+    ASSERT_EQ(stream.GetResults().size(), 1U);
+    EXPECT_EQ(stream.GetResults()[0][0].ValueInt(), 1000);
+    EXPECT_EQ(this->interpreter_context.plan_cache.size(), 1U);
+    EXPECT_EQ(count_plans(), 2U);
+  }
+  {
+    SCOPED_TRACE("Value of the same selectivity");
+    auto stream = this->Interpret(query, {{"id", memgraph::storage::PropertyValue(3)}});
+    ASSERT_EQ(stream.GetResults().size(), 1U);
+    EXPECT_EQ(stream.GetResults()[0][0].ValueInt(), 0);
+    EXPECT_EQ(count_plans(), 2U);
+  }
+  {
+    SCOPED_TRACE("Schema change");
+    this->Interpret("CREATE CONSTRAINT ON (n:Node) ASSERT EXISTS (n.id)");
+    EXPECT_EQ(this->interpreter_context.plan_cache.size(), 0U);
+  }
+}
+
 TYPED_TEST(InterpreterTest, AllowLoadCsvConfig) {
   const auto check_load_csv_queries = [&](const bool allow_load_csv) {
     TmpDirManager directory_manager{"allow_load_csv"};
@@ -1199,6 +1344,14 @@ TYPED_TEST(InterpreterTest, ExecutionStatsValues) {
     ASSERT_EQ(stats["properties-set"].ValueInt(), 3);
     AssertAllValuesAreZero(stats, {"properties-set"});
   }
+  {
+    auto [stream, qid] = this->Prepare("MATCH (n:L1) SET n.name='test', n.value=42;");
+    this->Pull(&stream);
+
+    auto stats = stream.GetSummary().at("stats").ValueMap();
+    ASSERT_EQ(stats["properties-set"].ValueInt(), 6);
+    AssertAllValuesAreZero(stats, {"properties-set"});
+  }
 }
 
 TYPED_TEST(InterpreterTest, NotificationsValidStructure) {
@@ -0,0 +1,120 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "query/admission_controller.hpp"
+#include "query/exceptions.hpp"
+
+using memgraph::query::AdmissionController;
+using memgraph::query::AdmissionRejectedException;
+using namespace std::chrono_literals;
+
+namespace {
+AdmissionController::Config MakeConfig() {
+  return {.max_concurrent_queries = 0,
+          .max_concurrent_queries_per_user = 0,
+          .max_memory_in_flight = 0,
+          .max_memory_in_flight_per_user = 0,
+          .default_query_memory = 10,
+          .max_queue_size = 10,
+          .queue_timeout = 10s};
+}
+}  // namespace
+
+TEST(AdmissionController, Disabled) {
+  AdmissionController controller(MakeConfig());
+  EXPECT_FALSE(controller.Enabled());
+  auto ticket = controller.Admit("user", std::nullopt);
+  EXPECT_EQ(controller.RunningQueries(), 0);
+}
+
+TEST(AdmissionController, QueuesUntilReleased) {
+  auto config = MakeConfig();
+  config.max_concurrent_queries = 1;
+  AdmissionController controller(config);
+
+  auto first = controller.Admit(std::nullopt, std::nullopt);
+  EXPECT_EQ(controller.RunningQueries(), 1);
+  EXPECT_EQ(controller.MemoryInFlight(), 10);
+
+  auto second = std::async(std::launch::async, [&] { return controller.Admit(std::nullopt, 5); });
+  while (controller.QueuedQueries() == 0) std::this_thread::sleep_for(1ms);
+  EXPECT_EQ(second.wait_for(10ms), std::future_status::timeout);
+
+  first.Release();
+  auto ticket = second.get();
+  EXPECT_EQ(controller.QueuedQueries(), 0);
+  EXPECT_EQ(controller.RunningQueries(), 1);
+  EXPECT_EQ(controller.MemoryInFlight(), 5);
+  ticket.Release();
+  EXPECT_EQ(controller.RunningQueries(), 0);
+}
+
+TEST(AdmissionController, RejectsOnTimeoutAndFullQueue) {
+  auto config = MakeConfig();
+  config.max_concurrent_queries = 1;
+  config.max_queue_size = 1;
+  config.queue_timeout = 50ms;
+  AdmissionController controller(config);
+
+  auto running = controller.Admit(std::nullopt, std::nullopt);
+  EXPECT_THROW(controller.Admit(std::nullopt, std::nullopt), AdmissionRejectedException);
+
+  auto queued = std::async(std::launch::async, [&] { return controller.Admit(std::nullopt, std::nullopt); });
+  while (controller.QueuedQueries() == 0) std::this_thread::sleep_for(1ms);
+  EXPECT_THROW(controller.Admit(std::nullopt, std::nullopt), AdmissionRejectedException);
+  EXPECT_THROW(queued.get(), AdmissionRejectedException);
+  EXPECT_EQ(controller.RunningQueries(), 1);
+}
+
+TEST(AdmissionController, PerUserLimits) {
+  auto config = MakeConfig();
+  config.max_concurrent_queries_per_user = 1;
+  config.queue_timeout = 10ms;
+  AdmissionController controller(config);
+
+  auto alice = controller.Admit("alice", std::nullopt);
+  EXPECT_THROW(controller.Admit("alice", std::nullopt), AdmissionRejectedException);
+  auto bob = controller.Admit("bob", std::nullopt);
+  // Unauthenticated sessions aren't limited per user.
+  auto anonymous1 = controller.Admit(std::nullopt, std::nullopt);
+  auto anonymous2 = controller.Admit(std::nullopt, std::nullopt);
+  EXPECT_EQ(controller.RunningQueries(), 4);
+
+  alice.Release();
+  auto alice_again = controller.Admit("alice", std::nullopt);
+  EXPECT_EQ(controller.RunningQueries(), 4);
+}
+
+TEST(AdmissionController, MemoryInFlight) {
+  auto config = MakeConfig();
+  config.max_memory_in_flight = 100;
+  config.queue_timeout = 10ms;
+  AdmissionController controller(config);
+
+  // A query reserving more than the limit runs alone.
+  auto large = controller.Admit(std::nullopt, 1000);
+  EXPECT_THROW(controller.Admit(std::nullopt, 1), AdmissionRejectedException);
+  large.Release();
+
+  auto first = controller.Admit(std::nullopt, 60);
+  auto second = controller.Admit(std::nullopt, 40);
+  EXPECT_THROW(controller.Admit(std::nullopt, std::nullopt), AdmissionRejectedException);
+  EXPECT_EQ(controller.MemoryInFlight(), 100);
+  second.Release();
+  auto third = controller.Admit(std::nullopt, std::nullopt);
+  EXPECT_EQ(controller.MemoryInFlight(), 70);
+}
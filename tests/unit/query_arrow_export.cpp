@@ -0,0 +1,77 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "query/arrow_export.hpp"
+#include "query/arrow_reader.hpp"
+#include "query/exceptions.hpp"
+#include "query/typed_value.hpp"
+
+using memgraph::query::ArrowFileExport;
+using memgraph::query::ArrowReader;
+using memgraph::query::QueryRuntimeException;
+using memgraph::query::TypedValue;
+
+class ArrowFileExportTest : public ::testing::Test {
+ protected:
+  void SetUp() override { std::filesystem::remove_all(directory_); }
+  void TearDown() override { std::filesystem::remove_all(directory_); }
+
+  /// Returns the integers of the only column of the file.
+  static std::vector<int64_t> ReadFile(const std::string &path) {
+    std::ifstream input(path, std::ios::binary);
+    ArrowReader reader(input, nullptr);
+    std::vector<int64_t> values;
+    while (auto batch = reader.ReadBatch()) {
+      for (const auto &value : reader.Decode(*batch).columns.at(0)) values.push_back(value.ValueInt());
+    }
+    return values;
+  }
+
+  std::filesystem::path directory_{std::filesystem::temp_directory_path() / "MG_tests_unit_query_arrow_export"};
+};
+
+TEST_F(ArrowFileExportTest, Partitions) {
+  std::vector<ArrowFileExport::File> files;
+  {
+    ArrowFileExport exporter(directory_ / "out", {"x"}, 2, 3);
+    for (int64_t i = 0; i < 8; ++i) exporter.Result({TypedValue(i)});
+    files = exporter.Finish();
+  }
+  ASSERT_EQ(files.size(), 3);
+  EXPECT_EQ(files[0].path, (directory_ / "out" / "part-00000.arrows").string());
+  EXPECT_EQ(files[2].path, (directory_ / "out" / "part-00002.arrows").string());
+  EXPECT_EQ(files[0].rows, 3);
+  EXPECT_EQ(files[2].rows, 2);
+  EXPECT_EQ(ReadFile(files[0].path), (std::vector<int64_t>{0, 1, 2}));
+  EXPECT_EQ(ReadFile(files[1].path), (std::vector<int64_t>{3, 4, 5}));
+  EXPECT_EQ(ReadFile(files[2].path), (std::vector<int64_t>{6, 7}));
+}
+
+TEST_F(ArrowFileExportTest, NoResults) {
+  ArrowFileExport exporter(directory_, {"x"}, 1);
+  const auto files = exporter.Finish();
+  ASSERT_EQ(files.size(), 1);
+  EXPECT_EQ(files[0].rows, 0);
+  EXPECT_TRUE(ReadFile(files[0].path).empty());
+}
+
+TEST_F(ArrowFileExportTest, NonEmptyDirectory) {
+  std::filesystem::create_directories(directory_);
+  std::ofstream(directory_ / "file") << "data";
+  EXPECT_THROW(ArrowFileExport(directory_, {"x"}, 1), QueryRuntimeException);
+}
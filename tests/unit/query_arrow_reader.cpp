@@ -0,0 +1,118 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "query/arrow_reader.hpp"
+#include "query/arrow_stream.hpp"
+#include "query/exceptions.hpp"
+#include "query/typed_value.hpp"
+#include "utils/temporal.hpp"
+
+using memgraph::query::ArrowReader;
+using memgraph::query::ArrowResultStream;
+using memgraph::query::QueryRuntimeException;
+using memgraph::query::TypedValue;
+
+namespace {
+
+/// Reads and decodes all the batches of the stream.
+std::vector<ArrowReader::DecodedBatch> ReadAll(ArrowReader &reader) {
+  std::vector<ArrowReader::DecodedBatch> batches;
+  while (auto batch = reader.ReadBatch()) {
+    batches.push_back(reader.Decode(*batch));
+  }
+  return batches;
+}
+
+}  // namespace
+
+TEST(ArrowReader, AllTypes) {
+  ArrowResultStream stream({"b", "i", "f", "s", "n", "d", "t", "dt", "dur"});
+  stream.Result({TypedValue(true), TypedValue(1), TypedValue(1.5), TypedValue("a"), TypedValue(),
+                 TypedValue(memgraph::utils::Date({1970, 1, 2})), TypedValue(memgraph::utils::LocalTime(1000)),
+                 TypedValue(memgraph::utils::LocalDateTime(2000)), TypedValue(memgraph::utils::Duration(3000))});
+  stream.Result({TypedValue(), TypedValue(), TypedValue(), TypedValue(), TypedValue(), TypedValue(), TypedValue(),
+                 TypedValue(), TypedValue()});
+  std::istringstream input(stream.Finish());
+
+  ArrowReader reader(input, nullptr);
+  EXPECT_EQ(reader.ColumnNames(), (std::vector<std::string>{"b", "i", "f", "s", "n", "d", "t", "dt", "dur"}));
+  const auto batches = ReadAll(reader);
+  ASSERT_EQ(batches.size(), 1);
+  const auto &batch = batches[0];
+  ASSERT_EQ(batch.rows, 2);
+  ASSERT_EQ(batch.columns.size(), 9);
+
+  EXPECT_EQ(batch.columns[0][0].ValueBool(), true);
+  EXPECT_EQ(batch.columns[1][0].ValueInt(), 1);
+  EXPECT_EQ(batch.columns[2][0].ValueDouble(), 1.5);
+  EXPECT_EQ(batch.columns[3][0].ValueString(), "a");
+  EXPECT_TRUE(batch.columns[4][0].IsNull());
+  EXPECT_EQ(batch.columns[5][0].ValueDate(), memgraph::utils::Date({1970, 1, 2}));
+  EXPECT_EQ(batch.columns[6][0].ValueLocalTime(), memgraph::utils::LocalTime(1000));
+  EXPECT_EQ(batch.columns[7][0].ValueLocalDateTime(), memgraph::utils::LocalDateTime(2000));
+  EXPECT_EQ(batch.columns[8][0].ValueDuration(), memgraph::utils::Duration(3000));
+  for (const auto &column : batch.columns) {
+    EXPECT_TRUE(column[1].IsNull());
+  }
+}
+
+TEST(ArrowReader, ProjectionAndBatches) {
+  ArrowResultStream stream({"s", "x", "y"}, 2);
+  stream.Result({TypedValue("ab"), TypedValue(1), TypedValue(true)});
+  stream.Result({TypedValue(), TypedValue(2), TypedValue(false)});
+  stream.Result({TypedValue("c"), TypedValue(3), TypedValue()});
+  std::istringstream input(stream.Finish());
+
+  // Columns which aren't in the schema are left out.
+  const std::vector<std::string> columns{"x", "s", "missing"};
+  ArrowReader reader(input, &columns);
+  EXPECT_EQ(reader.ColumnNames(), (std::vector<std::string>{"s", "x"}));
+  const auto batches = ReadAll(reader);
+  ASSERT_EQ(batches.size(), 2);
+  ASSERT_EQ(batches[0].rows, 2);
+  ASSERT_EQ(batches[1].rows, 1);
+  EXPECT_EQ(batches[0].columns[0][0].ValueString(), "ab");
+  EXPECT_TRUE(batches[0].columns[0][1].IsNull());
+  EXPECT_EQ(batches[0].columns[1][1].ValueInt(), 2);
+  EXPECT_EQ(batches[1].columns[0][0].ValueString(), "c");
+  EXPECT_EQ(batches[1].columns[1][0].ValueInt(), 3);
+}
+
+TEST(ArrowReader, NoBatches) {
+  ArrowResultStream stream({"x"});
+  std::istringstream input(stream.Finish());
+  ArrowReader reader(input, nullptr);
+  EXPECT_EQ(reader.ColumnNames(), std::vector<std::string>{"x"});
+  EXPECT_FALSE(reader.ReadBatch());
+}
+
+TEST(ArrowReader, InvalidStream) {
+  {
+    std::istringstream input("not an arrow stream");
+    EXPECT_THROW(ArrowReader(input, nullptr), QueryRuntimeException);
+  }
+  {
+    // The stream ends in the middle of a batch.
+    ArrowResultStream stream({"x"});
+    stream.Result({TypedValue(1)});
+    auto data = stream.Finish();
+    data.resize(data.size() - 16);
+    std::istringstream input(data);
+    ArrowReader reader(input, nullptr);
+    EXPECT_THROW(ReadAll(reader), QueryRuntimeException);
+  }
+}
@@ -0,0 +1,234 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "query/arrow_stream.hpp"
+#include "query/exceptions.hpp"
+#include "query/typed_value.hpp"
+#include "utils/temporal.hpp"
+
+using memgraph::query::ArrowResultStream;
+using memgraph::query::QueryRuntimeException;
+using memgraph::query::TypedValue;
+
+namespace {
+
+template <class T>
+T Read(const std::string &buffer, size_t pos) {
+  T value;
+  std::memcpy(&value, buffer.data() + pos, sizeof(T));
+  return value;
+}
+
+/// Minimal reader of flatbuffer tables, enough to check the Arrow metadata.
+struct Table {
+  const std::string *buffer;
+  size_t pos;
+
+  size_t Field(uint16_t id) const {
+    const auto vtable = pos - Read<int32_t>(*buffer, pos);
+    if (sizeof(uint16_t) * (2 + id) >= Read<uint16_t>(*buffer, vtable)) return 0;
+    const auto offset = Read<uint16_t>(*buffer, vtable + sizeof(uint16_t) * (2 + id));
+    return offset == 0 ? 0 : pos + offset;
+  }
+
+  template <class T>
+  T Scalar(uint16_t id, T default_value = 0) const {
+    const auto field = Field(id);
+    if (field == 0) return default_value;
+    EXPECT_EQ(field % sizeof(T), 0);
+    return Read<T>(*buffer, field);
+  }
+
+  size_t Indirect(uint16_t id) const {
+    const auto field = Field(id);
+    EXPECT_NE(field, 0);
+    return field + Read<uint32_t>(*buffer, field);
+  }
+
+  Table Child(uint16_t id) const { return {buffer, Indirect(id)}; }
+
+  uint32_t VectorSize(uint16_t id) const { return Read<uint32_t>(*buffer, Indirect(id)); }
+
+  Table TableAt(uint16_t id, size_t index) const {
+    const auto element = Indirect(id) + sizeof(uint32_t) * (1 + index);
+    return {buffer, element + Read<uint32_t>(*buffer, element)};
+  }
+
+  std::pair<int64_t, int64_t> StructAt(uint16_t id, size_t index) const {
+    const auto element = Indirect(id) + sizeof(uint32_t) + 2 * sizeof(int64_t) * index;
+    EXPECT_EQ(element % sizeof(int64_t), 0);
+    return {Read<int64_t>(*buffer, element), Read<int64_t>(*buffer, element + sizeof(int64_t))};
+  }
+
+  std::string String(uint16_t id) const {
+    const auto string = Indirect(id);
+    return buffer->substr(string + sizeof(uint32_t), Read<uint32_t>(*buffer, string));
+  }
+};
+
+struct Message {
+  std::string metadata;
+  std::string body;
+
+  Table Root() const { return {&metadata, Read<uint32_t>(metadata, 0)}; }
+  Table Header() const { return Root().Child(2); }
+
+  template <class T>
+  std::vector<T> Buffer(size_t index) const {
+    const auto [offset, length] = Header().StructAt(2, index);
+    EXPECT_EQ(offset % 8, 0);
+    std::vector<T> values(length / sizeof(T));
+    std::memcpy(values.data(), body.data() + offset, values.size() * sizeof(T));
+    return values;
+  }
+};
+
+/// Splits the stream into its messages, checking that it ends with the
+/// end-of-stream marker.
+std::vector<Message> ReadStream(const std::string &stream) {
+  std::vector<Message> messages;
+  size_t pos = 0;
+  while (true) {
+    EXPECT_EQ(pos % 8, 0);
+    EXPECT_LE(pos + 8, stream.size());
+    EXPECT_EQ(Read<uint32_t>(stream, pos), 0xFFFFFFFF);
+    const auto size = Read<int32_t>(stream, pos + 4);
+    if (size == 0) break;
+    Message message{.metadata = stream.substr(pos + 8, size)};
+    const auto body_length = message.Root().Scalar<int64_t>(3);
+    message.body = stream.substr(pos + 8 + size, body_length);
+    messages.push_back(std::move(message));
+    pos += 8 + size + body_length;
+  }
+  EXPECT_EQ(pos + 8, stream.size());
+  return messages;
+}
+
+}  // namespace
+
+TEST(ArrowResultStream, Schema) {
+  ArrowResultStream stream({"b", "i", "f", "s", "n", "d", "t", "dt", "dur"});
+  stream.Result({TypedValue(true), TypedValue(1), TypedValue(1.5), TypedValue("a"), TypedValue(),
+                 TypedValue(memgraph::utils::Date({1970, 1, 2})), TypedValue(memgraph::utils::LocalTime(1000)),
+                 TypedValue(memgraph::utils::LocalDateTime(2000)), TypedValue(memgraph::utils::Duration(3000))});
+  const auto messages = ReadStream(stream.Finish());
+  ASSERT_EQ(messages.size(), 2);
+
+  const auto message = messages[0].Root();
+  EXPECT_EQ(message.Scalar<int16_t>(0), 4);
+  EXPECT_EQ(message.Scalar<uint8_t>(1), 1);
+  EXPECT_EQ(message.Scalar<int64_t>(3), 0);
+  const auto schema = message.Child(2);
+  EXPECT_EQ(schema.Scalar<int16_t>(0), 0);
+  ASSERT_EQ(schema.VectorSize(1), 9);
+
+  const std::vector<std::pair<std::string, uint8_t>> expected{{"b", 6}, {"i", 2},  {"f", 3},  {"s", 5},  {"n", 1},
+                                                              {"d", 8}, {"t", 9}, {"dt", 10}, {"dur", 18}};
+  for (size_t i = 0; i < expected.size(); ++i) {
+    const auto field = schema.TableAt(1, i);
+    EXPECT_EQ(field.String(0), expected[i].first);
+    EXPECT_TRUE(field.Scalar<uint8_t>(1));
+    EXPECT_EQ(field.Scalar<uint8_t>(2), expected[i].second);
+    EXPECT_EQ(field.VectorSize(5), 0);
+  }
+  const auto type = [&](size_t i) { return schema.TableAt(1, i).Child(3); };
+  EXPECT_EQ(type(1).Scalar<int32_t>(0), 64);
+  EXPECT_TRUE(type(1).Scalar<uint8_t>(1));
+  EXPECT_EQ(type(2).Scalar<int16_t>(0), 2);
+  EXPECT_EQ(type(5).Scalar<int16_t>(0, 1), 0);
+  EXPECT_EQ(type(6).Scalar<int16_t>(0), 2);
+  EXPECT_EQ(type(6).Scalar<int32_t>(1), 64);
+  EXPECT_EQ(type(7).Scalar<int16_t>(0), 2);
+  EXPECT_EQ(type(7).Field(1), 0);
+  EXPECT_EQ(type(8).Scalar<int16_t>(0), 2);
+
+  const auto &batch = messages[1];
+  EXPECT_EQ(batch.Root().Scalar<uint8_t>(1), 3);
+  EXPECT_EQ(batch.Header().Scalar<int64_t>(0), 1);
+  ASSERT_EQ(batch.Header().VectorSize(1), 9);
+  EXPECT_EQ(batch.Header().StructAt(1, 4), std::make_pair(int64_t{1}, int64_t{1}));
+  // The null column has no buffers and the strings have three.
+  ASSERT_EQ(batch.Header().VectorSize(2), 17);
+  EXPECT_EQ(batch.Buffer<uint8_t>(1), std::vector<uint8_t>{1});
+  EXPECT_EQ(batch.Buffer<int64_t>(3), std::vector<int64_t>{1});
+  EXPECT_EQ(batch.Buffer<double>(5), std::vector<double>{1.5});
+  EXPECT_EQ(batch.Buffer<int32_t>(7), (std::vector<int32_t>{0, 1}));
+  EXPECT_EQ(batch.Buffer<char>(8), std::vector<char>{'a'});
+  EXPECT_EQ(batch.Buffer<int32_t>(10), std::vector<int32_t>{1});
+  EXPECT_EQ(batch.Buffer<int64_t>(12), std::vector<int64_t>{1000});
+  EXPECT_EQ(batch.Buffer<int64_t>(14), std::vector<int64_t>{2000});
+  EXPECT_EQ(batch.Buffer<int64_t>(16), std::vector<int64_t>{3000});
+}
+
+TEST(ArrowResultStream, Batches) {
+  ArrowResultStream stream({"s", "x"}, 2);
+  stream.Result({TypedValue("ab"), TypedValue()});
+  stream.Result({TypedValue(), TypedValue(1)});
+  stream.Result({TypedValue("c"), TypedValue(2.5)});
+  stream.Result({TypedValue("def"), TypedValue(3)});
+  stream.Result({TypedValue("g"), TypedValue()});
+  const auto messages = ReadStream(stream.Finish());
+  ASSERT_EQ(messages.size(), 4);
+
+  // The integers before the first float are converted too.
+  EXPECT_EQ(messages[0].Root().Child(2).TableAt(1, 1).Scalar<uint8_t>(2), 3);
+
+  const auto &first = messages[1];
+  EXPECT_EQ(first.Header().Scalar<int64_t>(0), 2);
+  EXPECT_EQ(first.Header().StructAt(1, 0), std::make_pair(int64_t{2}, int64_t{1}));
+  EXPECT_EQ(first.Buffer<uint8_t>(0), std::vector<uint8_t>{0b01});
+  EXPECT_EQ(first.Buffer<int32_t>(1), (std::vector<int32_t>{0, 2, 2}));
+  EXPECT_EQ(first.Buffer<char>(2), (std::vector<char>{'a', 'b'}));
+  EXPECT_EQ(first.Buffer<uint8_t>(3), std::vector<uint8_t>{0b10});
+  EXPECT_EQ(first.Buffer<double>(4), (std::vector<double>{0.0, 1.0}));
+
+  const auto &second = messages[2];
+  EXPECT_EQ(second.Header().StructAt(1, 0), std::make_pair(int64_t{2}, int64_t{0}));
+  EXPECT_EQ(second.Header().StructAt(2, 0).second, 0);
+  EXPECT_EQ(second.Buffer<int32_t>(1), (std::vector<int32_t>{0, 1, 4}));
+  EXPECT_EQ(second.Buffer<char>(2), (std::vector<char>{'c', 'd', 'e', 'f'}));
+  EXPECT_EQ(second.Buffer<double>(4), (std::vector<double>{2.5, 3.0}));
+
+  const auto &third = messages[3];
+  EXPECT_EQ(third.Header().Scalar<int64_t>(0), 1);
+  EXPECT_EQ(third.Buffer<int32_t>(1), (std::vector<int32_t>{0, 1}));
+  EXPECT_EQ(third.Header().StructAt(1, 1), std::make_pair(int64_t{1}, int64_t{1}));
+}
+
+TEST(ArrowResultStream, NoResults) {
+  ArrowResultStream stream({"x"});
+  const auto messages = ReadStream(stream.Finish());
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_EQ(messages[0].Root().Child(2).TableAt(1, 0).Scalar<uint8_t>(2), 1);
+}
+
+TEST(ArrowResultStream, UnsupportedValues) {
+  {
+    ArrowResultStream stream({"x"});
+    EXPECT_THROW(stream.Result({TypedValue(std::vector<TypedValue>{})}), QueryRuntimeException);
+  }
+  {
+    ArrowResultStream stream({"x"});
+    stream.Result({TypedValue(1)});
+    EXPECT_THROW(stream.Result({TypedValue("a")}), QueryRuntimeException);
+  }
+  {
+    ArrowResultStream stream({"x"});
+    stream.Result({TypedValue(1.5)});
+    EXPECT_THROW(stream.Result({TypedValue(true)}), QueryRuntimeException);
+  }
+}
@@ -196,7 +196,7 @@ auto GetEdgeVariable(AstStorage &storage, const std::string &name, EdgeAtom::Typ
   r_val->filter_lambda_.inner_node =
       flambda_inner_node ? flambda_inner_node : storage.Create<Identifier>(memgraph::utils::RandomString(20));
 
-  if (type == EdgeAtom::Type::WEIGHTED_SHORTEST_PATH) {
+  if (type == EdgeAtom::Type::WEIGHTED_SHORTEST_PATH || type == EdgeAtom::Type::ALL_SHORTEST_PATHS) {
     r_val->weight_lambda_.inner_edge =
         wlambda_inner_edge ? wlambda_inner_edge : storage.Create<Identifier>(memgraph::utils::RandomString(20));
     r_val->weight_lambda_.inner_node =
@@ -15,6 +15,7 @@
 #include "query/db_accessor.hpp"
 #include "query/frontend/ast/ast.hpp"
 #include "query/frontend/semantic/symbol_table.hpp"
+#include "query/plan/cardinality_feedback.hpp"
 #include "query/plan/cost_estimator.hpp"
 #include "query/plan/operator.hpp"
 #include "storage/v2/inmemory/storage.hpp"
@@ -74,8 +75,8 @@ class QueryCostEstimator : public ::testing::Test {
     dba->AdvanceCommand();
   }
 
-  auto Cost() {
-    CostEstimator<memgraph::query::DbAccessor> cost_estimator(&*dba, symbol_table_, parameters_);
+  auto Cost(const CardinalityCorrections &corrections = {}) {
+    CostEstimator<memgraph::query::DbAccessor> cost_estimator(&*dba, symbol_table_, parameters_, corrections);
     last_op_->Accept(cost_estimator);
     return cost_estimator.cost();
   }
@@ -133,12 +134,46 @@ TEST_F(QueryCostEstimator, ScanAllByLabelPropertyValueConstExpr) {
   AddVertices(100, 30, 20);
   for (auto const_val : {Literal(12), Parameter(12)}) {
     MakeOp<ScanAllByLabelPropertyValue>(nullptr, NextSymbol(), label, property, "property",
-                                        // once we make expression const-folding this test case will fail
                                         storage_.Create<UnaryPlusOperator>(const_val));
-    EXPECT_COST(20 * CardParam::kFilter * CostParam::MakeScanAllByLabelPropertyValue);
+    EXPECT_COST(1 * CostParam::MakeScanAllByLabelPropertyValue);
+  }
+}
+
+TEST_F(QueryCostEstimator, ScanAllByLabelPropertyValueFunctionOfConstant) {
+  AddVertices(100, 30, 20);
+  for (auto const_val : {Literal("12"), Parameter("12")}) {
+    MakeOp<ScanAllByLabelPropertyValue>(nullptr, NextSymbol(), label, property, "property",
+                                        storage_.Create<Function>("TOINTEGER", std::vector<Expression *>{const_val}));
+    EXPECT_COST(1 * CostParam::MakeScanAllByLabelPropertyValue);
   }
 }
 
+TEST_F(QueryCostEstimator, ScanAllByLabelPropertyValueNonConstExpr) {
+  AddVertices(100, 30, 20);
+  MakeOp<ScanAllByLabelPropertyValue>(nullptr, NextSymbol(), label, property, "property",
+                                      storage_.Create<UnaryPlusOperator>(storage_.Create<Identifier>("n")));
+  EXPECT_COST(20 * CardParam::kFilter * CostParam::MakeScanAllByLabelPropertyValue);
+  MakeOp<ScanAllByLabelPropertyValue>(nullptr, NextSymbol(), label, property, "property",
+                                      storage_.Create<Function>("RAND", std::vector<Expression *>{}));
+  EXPECT_COST(20 * CardParam::kFilter * CostParam::MakeScanAllByLabelPropertyValue);
+}
+
+TEST_F(QueryCostEstimator, ScanAllByLabelPropertyValuesConstant) {
+  AddVertices(100, 30, 20);
+  // The duplicates and Nulls don't have vertices of their own.
+  auto *list = storage_.Create<ListLiteral>(std::vector<Expression *>{
+      Literal(12), Literal(13), Literal(12), Literal(memgraph::storage::PropertyValue()), Literal(100)});
+  MakeOp<ScanAllByLabelPropertyValues>(nullptr, NextSymbol(), label, property, "property", list);
+  EXPECT_COST(2 * CostParam::MakeScanAllByLabelPropertyValues);
+}
+
+TEST_F(QueryCostEstimator, ScanAllByLabelPropertyValuesNonConstExpr) {
+  AddVertices(100, 30, 20);
+  MakeOp<ScanAllByLabelPropertyValues>(nullptr, NextSymbol(), label, property, "property",
+                                       storage_.Create<Identifier>("n"));
+  EXPECT_COST(MiscParam::kUnwindNoLiteral * 20 * CardParam::kFilter * CostParam::MakeScanAllByLabelPropertyValues);
+}
+
 TEST_F(QueryCostEstimator, ScanAllByLabelPropertyRangeUpperConstant) {
   AddVertices(100, 30, 20);
   for (auto const_val : {Literal(12), Parameter(12)}) {
@@ -165,7 +200,8 @@ TEST_F(QueryCostEstimator, ScanAllByLabelPropertyRangeConstExpr) {
     auto bound = std::make_optional(
         memgraph::utils::MakeBoundInclusive(static_cast<Expression *>(storage_.Create<UnaryPlusOperator>(const_val))));
     MakeOp<ScanAllByLabelPropertyRange>(nullptr, NextSymbol(), label, property, "property", bound, nullopt);
-    EXPECT_COST(20 * CardParam::kFilter * CostParam::MakeScanAllByLabelPropertyRange);
+    // cardinality estimation is exact for very small indexes
+    EXPECT_COST(8 * CostParam::MakeScanAllByLabelPropertyRange);
   }
 }
 
@@ -256,6 +292,54 @@ TEST_F(QueryCostEstimator, UnwindNoLiteral) {
           MiscParam::kUnwindNoLiteral);
 }
 
+TEST_F(QueryCostEstimator, CorrectedCardinalities) {
+  AddVertices(100, 30);
+  MakeOp<ScanAll>(last_op_, NextSymbol());
+  MakeOp<Filter>(last_op_, std::vector<std::shared_ptr<LogicalOperator>>{}, Literal(true));
+  MakeOp<Expand>(last_op_, NextSymbol(), NextSymbol(), NextSymbol(), EdgeAtom::Direction::IN,
+                 std::vector<memgraph::storage::EdgeTypeId>{}, false, memgraph::storage::View::OLD);
+  const CardinalityCorrections corrections{.filter_selectivity = 0.1, .expand_degree = 5};
+  EXPECT_FLOAT_EQ(Cost(corrections),
+                  100 * CostParam::kScanAll + 100 * CostParam::kFilter + 100 * 0.1 * 5 * CostParam::kExpand);
+}
+
+TEST_F(QueryCostEstimator, CardinalityFeedback) {
+  AddVertices(100, 30);
+  MakeOp<ScanAll>(last_op_, NextSymbol());
+  MakeOp<Filter>(last_op_, std::vector<std::shared_ptr<LogicalOperator>>{}, Literal(true));
+
+  // The filter passed 5 of the 100 scanned vertices, and every operator was
+  // pulled once more after its last row.
+  ProfilingStats once_stats{.actual_hits = 2, .name = "Once"};
+  ProfilingStats scan_stats{.actual_hits = 101, .name = "ScanAll", .children = {once_stats}};
+  ProfilingStats filter_stats{.actual_hits = 6, .name = "Filter", .children = {scan_stats}};
+
+  auto cardinalities = CompareCardinalities(*last_op_, filter_stats, &*dba, symbol_table_, parameters_);
+  ASSERT_EQ(cardinalities.size(), 3);
+  EXPECT_EQ(cardinalities[0].op, last_op_.get());
+  EXPECT_FLOAT_EQ(cardinalities[0].estimated, 100 * CardParam::kFilter);
+  EXPECT_FLOAT_EQ(cardinalities[0].actual, 5);
+  EXPECT_EQ(cardinalities[0].actual_input, 100);
+  EXPECT_FLOAT_EQ(cardinalities[1].estimated, 100);
+  EXPECT_FLOAT_EQ(cardinalities[1].actual, 100);
+  EXPECT_FLOAT_EQ(CardinalityError(cardinalities[0].estimated, cardinalities[0].actual), 5);
+  EXPECT_FLOAT_EQ(CardinalityError(cardinalities[1].estimated, cardinalities[1].actual), 1);
+
+  auto corrections = CorrectCardinalities(cardinalities);
+  ASSERT_TRUE(corrections.filter_selectivity);
+  EXPECT_FLOAT_EQ(*corrections.filter_selectivity, 0.05);
+  EXPECT_FALSE(corrections.expand_degree);
+
+  // The corrected estimates match the observed cardinalities.
+  cardinalities = CompareCardinalities(*last_op_, filter_stats, &*dba, symbol_table_, parameters_, corrections);
+  ASSERT_EQ(cardinalities.size(), 3);
+  EXPECT_FLOAT_EQ(cardinalities[0].estimated, 5);
+
+  // Stats which don't belong to the plan aren't compared.
+  filter_stats.name = "Produce";
+  EXPECT_TRUE(CompareCardinalities(*last_op_, filter_stats, &*dba, symbol_table_, parameters_).empty());
+}
+
 #undef TEST_OP
 #undef EXPECT_COST
 //
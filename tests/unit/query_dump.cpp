@@ -564,6 +564,35 @@ TYPED_TEST(DumpTest, IndicesKeys) {
   }
 }
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TYPED_TEST(DumpTest, CompositeIndicesKeys) {
+  if constexpr (std::is_same_v<TypeParam, memgraph::storage::InMemoryStorage>) {
+    {
+      auto dba = this->context.db->Access();
+      CreateVertex(dba.get(), {"Label1"}, {{"p", memgraph::storage::PropertyValue(1)}}, false);
+      ASSERT_FALSE(dba->Commit().HasError());
+    }
+    ASSERT_FALSE(this->context.db
+                     ->CreateIndex(this->context.db->NameToLabel("Label1"),
+                                   std::vector<memgraph::storage::PropertyId>{
+                                       this->context.db->NameToProperty("prop"), this->context.db->NameToProperty("p")})
+                     .HasError());
+
+    {
+      ResultStreamFaker stream(this->context.db.get());
+      memgraph::query::AnyStream query_stream(&stream, memgraph::utils::NewDeleteResource());
+      {
+        auto acc = this->context.db->Access();
+        memgraph::query::DbAccessor dba(acc.get());
+        memgraph::query::DumpDatabaseToCypherQueries(&dba, &query_stream);
+      }
+      VerifyQueries(stream.GetResults(), "CREATE INDEX ON :`Label1`(`prop`, `p`);", kCreateInternalIndex,
+                    "CREATE (:__mg_vertex__:`Label1` {__mg_id__: 0, `p`: 1});", kDropInternalIndex,
+                    kRemoveInternalLabelProperty);
+    }
+  }
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TYPED_TEST(DumpTest, ExistenceConstraints) {
   {
@@ -977,3 +1006,51 @@ TYPED_TEST(DumpTest, MultiplePartialPulls) {
   check_next(kDropInternalIndex);
   check_next(kRemoveInternalLabelProperty);
 }
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TYPED_TEST(DumpTest, ParallelDumpCheckState) {
+  {
+    auto dba = this->context.db->Access();
+    std::vector<memgraph::storage::VertexAccessor> vertices;
+    for (int i = 0; i < 2500; ++i) {
+      std::vector<std::string> labels;
+      if (i % 3 != 0) labels.emplace_back("Person");
+      if (i % 3 == 2) labels.emplace_back("Student");
+      vertices.push_back(CreateVertex(dba.get(), labels, {{"name", memgraph::storage::PropertyValue(i)}}, false));
+    }
+    for (int i = 0; i + 1 < 2500; ++i) {
+      std::map<std::string, memgraph::storage::PropertyValue> props;
+      if (i % 2 == 0) props.emplace("since", memgraph::storage::PropertyValue(i));
+      CreateEdge(dba.get(), &vertices[i], &vertices[i + 1], i % 5 == 0 ? "Likes" : "Knows", props, false);
+    }
+    ASSERT_FALSE(dba->Commit().HasError());
+  }
+  ASSERT_FALSE(
+      this->context.db->CreateIndex(this->context.db->NameToLabel("Person"), this->context.db->NameToProperty("name"))
+          .HasError());
+
+  const auto &db_initial_state = GetState(this->context.db.get());
+  auto data_directory = std::filesystem::temp_directory_path() / "MG_tests_unit_query_dump";
+  memgraph::query::InterpreterContext interpreter_context(std::make_unique<TypeParam>(),
+                                                          memgraph::query::InterpreterConfig{}, data_directory);
+  {
+    ResultStreamFaker stream(this->context.db.get());
+    memgraph::query::AnyStream query_stream(&stream, memgraph::utils::NewDeleteResource());
+    {
+      auto acc = this->context.db->Access();
+      memgraph::query::DbAccessor dba(acc.get());
+      memgraph::query::PullPlanDump pull_plan(&dba, 4);
+      while (!pull_plan.Pull(&query_stream, 3)) {
+      }
+    }
+    const auto &results = stream.GetResults();
+    // The vertices and the edges are created by batched queries.
+    ASSERT_LT(results.size(), 100);
+    for (const auto &item : results) {
+      ASSERT_EQ(item.size(), 1);
+      ASSERT_TRUE(item[0].IsString());
+      Execute(&interpreter_context, item[0].ValueString());
+    }
+  }
+  ASSERT_EQ(GetState(interpreter_context.db.get()), db_initial_state);
+}
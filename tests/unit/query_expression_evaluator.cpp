@@ -25,6 +25,7 @@
 #include "query/frontend/ast/ast.hpp"
 #include "query/frontend/opencypher/parser.hpp"
 #include "query/interpret/awesome_memgraph_functions.hpp"
+#include "query/interpret/compiled_expression.hpp"
 #include "query/interpret/eval.hpp"
 #include "query/interpret/frame.hpp"
 #include "query/path.hpp"
@@ -92,6 +93,15 @@ class ExpressionEvaluatorTest : public ::testing::Test {
                                                   "EvaluationContext for allocations!";
     return value;
   }
+
+  auto EvalCompiled(Expression *expr) {
+    ctx.properties = NamesToProperties(storage.properties_, &dba);
+    ctx.labels = NamesToLabels(storage.labels_, &dba);
+    CompiledExpression compiled(expr, symbol_table, ctx);
+    auto value = compiled.Evaluate(frame, eval);
+    EXPECT_EQ(value.GetMemoryResource(), &mem);
+    return value;
+  }
 };
 
 // using StorageTypes = ::testing::Types<memgraph::storage::InMemoryStorage, memgraph::storage::DiskStorage>;
@@ -149,6 +159,99 @@ TYPED_TEST(ExpressionEvaluatorTest, AndOperatorShortCircuit) {
   }
 }
 
+TYPED_TEST(ExpressionEvaluatorTest, CompiledAndOperatorShortCircuit) {
+  {
+    auto *op = this->storage.template Create<AndOperator>(this->storage.template Create<PrimitiveLiteral>(false),
+                                                          this->storage.template Create<PrimitiveLiteral>(5));
+    EXPECT_EQ(this->EvalCompiled(op).ValueBool(), false);
+  }
+  {
+    auto *op = this->storage.template Create<AndOperator>(this->storage.template Create<PrimitiveLiteral>(5),
+                                                          this->storage.template Create<PrimitiveLiteral>(false));
+    EXPECT_THROW(this->EvalCompiled(op), QueryRuntimeException);
+  }
+  {
+    // The result of the AND is used by the enclosing operator whether it was
+    // short-circuited or not.
+    auto *a = this->CreateIdentifierWithValue("a", TypedValue(false));
+    auto *op = this->storage.template Create<NotOperator>(this->storage.template Create<AndOperator>(
+        a, this->storage.template Create<PrimitiveLiteral>(true)));
+    EXPECT_EQ(this->EvalCompiled(op).ValueBool(), true);
+    this->frame[this->symbol_table.at(*a)] = TypedValue(true);
+    EXPECT_EQ(this->EvalCompiled(op).ValueBool(), false);
+  }
+}
+
+TYPED_TEST(ExpressionEvaluatorTest, CompiledExpression) {
+  auto *a = this->CreateIdentifierWithValue("a", TypedValue(2));
+  auto *sum = this->storage.template Create<AdditionOperator>(a, this->storage.template Create<PrimitiveLiteral>(2));
+  // (a + 2) * 3 > 10 AND NOT a IS NULL AND [1, a][1] = a
+  auto *op = this->storage.template Create<AndOperator>(
+      this->storage.template Create<AndOperator>(
+          this->storage.template Create<GreaterOperator>(
+              this->storage.template Create<MultiplicationOperator>(sum,
+                                                                    this->storage.template Create<PrimitiveLiteral>(3)),
+              this->storage.template Create<PrimitiveLiteral>(10)),
+          this->storage.template Create<NotOperator>(this->storage.template Create<IsNullOperator>(a))),
+      this->storage.template Create<EqualOperator>(
+          this->storage.template Create<SubscriptOperator>(
+              this->storage.template Create<ListLiteral>(
+                  std::vector<Expression *>{this->storage.template Create<PrimitiveLiteral>(1), a}),
+              this->storage.template Create<PrimitiveLiteral>(1)),
+          a));
+  EXPECT_EQ(this->EvalCompiled(op).ValueBool(), true);
+  EXPECT_EQ(this->Eval(op).ValueBool(), true);
+  this->frame[this->symbol_table.at(*a)] = TypedValue(1);
+  EXPECT_EQ(this->EvalCompiled(op).ValueBool(), false);
+  EXPECT_EQ(this->Eval(op).ValueBool(), false);
+  this->frame[this->symbol_table.at(*a)] = TypedValue("a");
+  EXPECT_THROW(this->EvalCompiled(op), QueryRuntimeException);
+
+  auto v1 = this->dba.InsertVertex();
+  ASSERT_TRUE(v1.SetProperty(this->dba.NameToProperty("age"), memgraph::storage::PropertyValue(10)).HasValue());
+  this->dba.AdvanceCommand();
+  auto *n = this->CreateIdentifierWithValue("n", TypedValue(v1));
+  auto *age = this->storage.template Create<PropertyLookup>(n, this->storage.GetPropertyIx("age"));
+  EXPECT_EQ(this->EvalCompiled(this->storage.template Create<UnaryMinusOperator>(age)).ValueInt(), -10);
+  EXPECT_EQ(this->EvalCompiled(n).ValueVertex(), v1);
+}
+
+TYPED_TEST(ExpressionEvaluatorTest, CompiledFilterBatch) {
+  auto *a = this->CreateIdentifierWithValue("a", TypedValue());
+  const auto &symbol = this->symbol_table.at(*a);
+  // 2 < a AND a <= 7
+  auto *op = this->storage.template Create<AndOperator>(
+      this->storage.template Create<LessOperator>(this->storage.template Create<PrimitiveLiteral>(2), a),
+      this->storage.template Create<LessEqualOperator>(a, this->storage.template Create<PrimitiveLiteral>(7)));
+  this->ctx.properties = NamesToProperties(this->storage.properties_, &this->dba);
+  CompiledExpression compiled(op, this->symbol_table, this->ctx);
+  ASSERT_TRUE(compiled.CanFilterBatch());
+
+  const std::vector<TypedValue> values{TypedValue(1), TypedValue(5),   TypedValue(),  TypedValue(10),
+                                       TypedValue(2.5), TypedValue(7), TypedValue(3)};
+  FrameBatch batch(this->frame.elems().size(), values.size(), &this->mem);
+  std::vector<int64_t> expected;
+  for (const auto &value : values) {
+    this->frame[symbol] = value;
+    batch.Append(this->frame);
+    if (compiled.EvaluateFilter(this->frame, this->eval)) expected.push_back(static_cast<int64_t>(batch.size()) - 1);
+  }
+  EXPECT_THAT(expected, ElementsAre(1, 4, 5, 6));
+  compiled.FilterBatch(batch, this->eval);
+  ASSERT_EQ(batch.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_TRUE(TypedValue::BoolEqual{}(batch[i][symbol], values[expected[i]]));
+  }
+
+  this->frame[symbol] = TypedValue("a");
+  batch.Clear();
+  batch.Append(this->frame);
+  EXPECT_THROW(compiled.FilterBatch(batch, this->eval), QueryRuntimeException);
+
+  auto *or_op = this->storage.template Create<OrOperator>(op, op);
+  EXPECT_FALSE(CompiledExpression(or_op, this->symbol_table, this->ctx).CanFilterBatch());
+}
+
 TYPED_TEST(ExpressionEvaluatorTest, AndOperatorNull) {
   {
     // Null doesn't short circuit
@@ -517,6 +620,30 @@ TYPED_TEST(ExpressionEvaluatorTest, MapProjectionAllPropertiesLookupAfter) {
   EXPECT_EQ(value.ValueInt(), 1);
 }
 
+TYPED_TEST(ExpressionEvaluatorTest, MapProjectionVertexProperties) {
+  auto v1 = this->dba.InsertVertex();
+  ASSERT_TRUE(v1.SetProperty(this->dba.NameToProperty("a"), memgraph::storage::PropertyValue(1)).HasValue());
+  ASSERT_TRUE(v1.SetProperty(this->dba.NameToProperty("b"), memgraph::storage::PropertyValue("b")).HasValue());
+  this->dba.AdvanceCommand();
+  auto *identifier = this->CreateIdentifierWithValue("n", TypedValue(v1));
+  auto *map_projection_literal = this->storage.template Create<MapProjectionLiteral>(
+      identifier, std::unordered_map<PropertyIx, Expression *>{
+                      {this->storage.GetPropertyIx("a"), this->storage.template Create<PropertyLookup>(
+                                                             identifier, this->storage.GetPropertyIx("a"))},
+                      {this->storage.GetPropertyIx("b"), this->storage.template Create<PropertyLookup>(
+                                                             identifier, this->storage.GetPropertyIx("b"))},
+                      {this->storage.GetPropertyIx("c"), this->storage.template Create<PropertyLookup>(
+                                                             identifier, this->storage.GetPropertyIx("c"))},
+                      {this->storage.GetPropertyIx("d"), this->storage.template Create<PrimitiveLiteral>(4)}});
+  auto value = this->Eval(map_projection_literal);
+  const auto &map = value.ValueMap();
+  ASSERT_EQ(map.size(), 4);
+  EXPECT_EQ(map.at("a").ValueInt(), 1);
+  EXPECT_EQ(map.at("b").ValueString(), "b");
+  EXPECT_TRUE(map.at("c").IsNull());
+  EXPECT_EQ(map.at("d").ValueInt(), 4);
+}
+
 TYPED_TEST(ExpressionEvaluatorTest, VertexAndEdgeIndexing) {
   auto edge_type = this->dba.NameToEdgeType("edge_type");
   auto prop = this->dba.NameToProperty("prop");
@@ -553,6 +680,19 @@ TYPED_TEST(ExpressionEvaluatorTest, VertexAndEdgeIndexing) {
     auto value2 = this->Eval(op2);
     EXPECT_TRUE(value2.IsNull());
   }
+  {
+    // Repeated indexing with alternating keys reads the ids resolved by the
+    // previous lookups.
+    auto *op1 = this->storage.template Create<SubscriptOperator>(
+        vertex_id, this->storage.template Create<PrimitiveLiteral>("prop"));
+    auto *op2 = this->storage.template Create<SubscriptOperator>(
+        vertex_id, this->storage.template Create<PrimitiveLiteral>("blah"));
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_EQ(this->Eval(op1).ValueInt(), 42);
+      EXPECT_TRUE(this->Eval(op2).IsNull());
+    }
+    EXPECT_EQ(this->ctx.property_names.Resolve("prop", &this->dba), prop);
+  }
   {
     // Wrong key type.
     auto *op1 =
@@ -2010,6 +2150,19 @@ TYPED_TEST(FunctionTest, Counter) {
   EXPECT_THROW(this->EvaluateFunction("COUNTER", "c6", 0, 0), QueryRuntimeException);
 }
 
+TYPED_TEST(FunctionTest, ConstantFunctionIsEvaluatedOnce) {
+  // The counter isn't marked as constant by the planner, it only shows how
+  // many times the function is called.
+  auto *counter = this->storage.template Create<Function>(
+      "COUNTER", std::vector<Expression *>{this->storage.template Create<PrimitiveLiteral>("c"),
+                                           this->storage.template Create<PrimitiveLiteral>(0)});
+  counter->is_constant_ = true;
+  EXPECT_EQ(this->Eval(counter).ValueInt(), 0);
+  EXPECT_EQ(this->Eval(counter).ValueInt(), 0);
+  counter->is_constant_ = false;
+  EXPECT_EQ(this->Eval(counter).ValueInt(), 1);
+}
+
 TYPED_TEST(FunctionTest, Id) {
   auto va = this->dba.InsertVertex();
   auto ea = this->dba.InsertEdge(&va, &va, this->dba.NameToEdgeType("edge"));
@@ -0,0 +1,110 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "query/interpret/kernels.hpp"
+#include "query/typed_value.hpp"
+
+using memgraph::query::TypedValue;
+namespace kernels = memgraph::query::kernels;
+
+namespace {
+
+// Compares the values like the comparison operators of TypedValue do.
+bool CompareTypedValues(kernels::Comparison comparison, const TypedValue &lhs, const TypedValue &rhs) {
+  switch (comparison) {
+    case kernels::Comparison::LESS:
+      return (lhs < rhs).ValueBool();
+    case kernels::Comparison::LESS_EQUAL:
+      return (lhs <= rhs).ValueBool();
+    case kernels::Comparison::GREATER:
+      return (lhs > rhs).ValueBool();
+    case kernels::Comparison::GREATER_EQUAL:
+      return (lhs >= rhs).ValueBool();
+    case kernels::Comparison::EQUAL:
+      return (lhs == rhs).ValueBool();
+    case kernels::Comparison::NOT_EQUAL:
+      return (lhs != rhs).ValueBool();
+  }
+  return false;
+}
+
+constexpr kernels::Comparison kComparisons[] = {
+    kernels::Comparison::LESS,          kernels::Comparison::LESS_EQUAL, kernels::Comparison::GREATER,
+    kernels::Comparison::GREATER_EQUAL, kernels::Comparison::EQUAL,      kernels::Comparison::NOT_EQUAL};
+
+}  // namespace
+
+TEST(QueryKernels, CompareInts) {
+  std::vector<int64_t> values;
+  // More values than fit in a vector register, and a tail.
+  for (int64_t i = -40; i < 43; ++i) values.push_back(i % 9);
+  values.push_back(std::numeric_limits<int64_t>::min());
+  values.push_back(std::numeric_limits<int64_t>::max());
+  std::vector<uint8_t> out(values.size());
+  for (const auto comparison : kComparisons) {
+    for (const bool constant_on_left : {false, true}) {
+      kernels::Compare(comparison, values.data(), values.size(), 3, constant_on_left, out.data());
+      for (size_t i = 0; i < values.size(); ++i) {
+        const auto expected = constant_on_left ? CompareTypedValues(comparison, TypedValue(3), TypedValue(values[i]))
+                                               : CompareTypedValues(comparison, TypedValue(values[i]), TypedValue(3));
+        EXPECT_EQ(out[i], expected) << i;
+      }
+    }
+  }
+}
+
+TEST(QueryKernels, CompareDoubles) {
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> values;
+  for (int i = 0; i < 37; ++i) values.push_back(i % 2 ? nan : i * 0.25);
+  std::vector<uint8_t> out(values.size());
+  for (const auto constant : {1.5, nan}) {
+    for (const auto comparison : kComparisons) {
+      kernels::Compare(comparison, values.data(), values.size(), constant, false, out.data());
+      for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(out[i], CompareTypedValues(comparison, TypedValue(values[i]), TypedValue(constant))) << i;
+      }
+    }
+  }
+}
+
+TEST(QueryKernels, Aggregations) {
+  std::vector<int64_t> ints;
+  for (int64_t i = 0; i < 101; ++i) ints.push_back((i * 37) % 101 - 50);
+  EXPECT_EQ(kernels::Sum(ints.data(), ints.size()), 0);
+  EXPECT_EQ(kernels::Min(ints.data(), ints.size()), -50);
+  EXPECT_EQ(kernels::Max(ints.data(), ints.size()), 50);
+
+  // The sum wraps around like the sum of two TypedValue integers.
+  const std::vector<int64_t> overflow{std::numeric_limits<int64_t>::max(), 1};
+  EXPECT_EQ(kernels::Sum(overflow.data(), overflow.size()), std::numeric_limits<int64_t>::min());
+
+  const std::vector<double> doubles{0.1, 0.2, 0.3, -7.5, 1e20, -1e20};
+  double sum = 1.0;
+  for (const auto value : doubles) sum += value;
+  EXPECT_EQ(kernels::Sum(1.0, doubles.data(), doubles.size()), sum);
+  EXPECT_EQ(kernels::Min(0.0, doubles.data(), doubles.size()), -1e20);
+  EXPECT_EQ(kernels::Max(0.0, doubles.data(), doubles.size()), 1e20);
+
+  // No value is smaller than NaN, while every value is greater than NaN and
+  // NaN is greater than every value, since `>` is the negation of `<=`.
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_TRUE(std::isnan(kernels::Min(nan, doubles.data(), doubles.size())));
+  const std::vector<double> with_nan{2.0, nan, 1.0};
+  EXPECT_EQ(kernels::Min(3.0, with_nan.data(), with_nan.size()), 1.0);
+  EXPECT_EQ(kernels::Max(0.0, with_nan.data(), with_nan.size()), 1.0);
+}
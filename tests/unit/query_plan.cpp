@@ -190,6 +190,44 @@ TYPED_TEST(TestPlanner, MatchPathReturn) {
   CheckPlan(planner.plan(), symbol_table, ExpectScanAll(), ExpectExpand(), ExpectProduce());
 }
 
+TYPED_TEST(TestPlanner, MatchEdgeTypeIndex) {
+  // Test MATCH (n) -[r :relationship]-> (m) RETURN n
+  FakeDbAccessor dba;
+  auto relationship = "relationship";
+  auto *as_n = NEXPR("n", IDENT("n"));
+  auto *query = QUERY(
+      SINGLE_QUERY(MATCH(PATTERN(NODE("n"), EDGE("r", Direction::OUT, {relationship}), NODE("m"))), RETURN(as_n)));
+  {
+    // Without created edge type index
+    auto symbol_table = memgraph::query::MakeSymbolTable(query);
+    auto planner = MakePlanner<TypeParam>(&dba, this->storage, symbol_table, query);
+    CheckPlan(planner.plan(), symbol_table, ExpectScanAll(), ExpectExpand(), ExpectProduce());
+  }
+  {
+    // With created edge type index
+    dba.SetEdgeIndexCount(dba.NameToEdgeType(relationship), 0);
+    auto symbol_table = memgraph::query::MakeSymbolTable(query);
+    auto planner = MakePlanner<TypeParam>(&dba, this->storage, symbol_table, query);
+    CheckPlan(planner.plan(), symbol_table, ExpectScanAllByEdgeType(dba.NameToEdgeType(relationship)),
+              ExpectProduce());
+  }
+}
+
+TYPED_TEST(TestPlanner, MatchEdgeTypePropertyIndex) {
+  // Test MATCH (n) <-[r :relationship]- (m) WHERE r.property = 42 RETURN n
+  FakeDbAccessor dba;
+  auto relationship = dba.NameToEdgeType("relationship");
+  auto property = dba.Property("property");
+  dba.SetEdgeIndexCount(relationship, property, 0);
+  auto *as_n = NEXPR("n", IDENT("n"));
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n"), EDGE("r", Direction::IN, {"relationship"}), NODE("m"))),
+                                   WHERE(EQ(PROPERTY_LOOKUP(dba, "r", property), LITERAL(42))), RETURN(as_n)));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, this->storage, symbol_table, query);
+  CheckPlan(planner.plan(), symbol_table, ExpectScanAllByEdgeTypeProperty(relationship, property),
+            ExpectProduce());
+}
+
 TYPED_TEST(TestPlanner, MatchNamedPatternReturn) {
   // Test MATCH p = (n) -[r :relationship]- (m) RETURN p
   FakeDbAccessor dba;
@@ -263,6 +301,25 @@ TYPED_TEST(TestPlanner, MatchNodeSet) {
                        ExpectSetLabels(), ExpectEmptyResult());
 }
 
+TYPED_TEST(TestPlanner, MatchNodeSetMultipleProperties) {
+  FakeDbAccessor dba;
+  auto prop = dba.Property("prop");
+  auto other = dba.Property("other");
+  {
+    // Test MATCH (n) SET n.prop = 42, n.other = $other
+    auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n"))), SET(PROPERTY_LOOKUP(dba, "n", prop), LITERAL(42)),
+                                     SET(PROPERTY_LOOKUP(dba, "n", other), PARAMETER_LOOKUP(0))));
+    CheckPlan<TypeParam>(query, this->storage, ExpectScanAll(), ExpectSetProperties(), ExpectEmptyResult());
+  }
+  {
+    // Test MATCH (n) SET n.prop = 42, n.other = n.prop
+    auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n"))), SET(PROPERTY_LOOKUP(dba, "n", prop), LITERAL(42)),
+                                     SET(PROPERTY_LOOKUP(dba, "n", other), PROPERTY_LOOKUP(dba, "n", prop))));
+    CheckPlan<TypeParam>(query, this->storage, ExpectScanAll(), ExpectSetProperty(), ExpectSetProperty(),
+                         ExpectEmptyResult());
+  }
+}
+
 TYPED_TEST(TestPlanner, MatchRemove) {
   // Test MATCH (n) REMOVE n.prop REMOVE n :label
   FakeDbAccessor dba;
@@ -303,6 +360,18 @@ TYPED_TEST(TestPlanner, MatchMultiPatternSameExpandStart) {
                        ExpectEdgeUniquenessFilter(), ExpectProduce());
 }
 
+TYPED_TEST(TestPlanner, MatchTriangle) {
+  // Test MATCH (a) -[r]-> (b) -[e]-> (c) -[f]-> (a) RETURN a
+  auto *query = QUERY(SINGLE_QUERY(
+      MATCH(PATTERN(NODE("a"), EDGE("r", Direction::OUT), NODE("b"), EDGE("e", Direction::OUT), NODE("c"),
+                    EDGE("f", Direction::OUT), NODE("a"))),
+      RETURN("a")));
+  // The last node is matched by intersecting the edges of the other two, one
+  // uniqueness filter is expected for each of the intersected edges.
+  CheckPlan<TypeParam>(query, this->storage, ExpectScanAll(), ExpectExpand(), ExpectIntersectExpand(),
+                       ExpectEdgeUniquenessFilter(), ExpectEdgeUniquenessFilter(), ExpectProduce());
+}
+
 TYPED_TEST(TestPlanner, MultiMatch) {
   // Test MATCH (n) -[r]- (m) MATCH (j) -[e]- (i) -[f]- (h) RETURN n
   FakeDbAccessor dba;
@@ -663,6 +732,27 @@ TYPED_TEST(TestPlanner, ReturnDistinctOrderBySkipLimit) {
                        ExpectLimit());
 }
 
+TYPED_TEST(TestPlanner, MatchReturnOrderBySkipLimit) {
+  // Test MATCH (n) RETURN n ORDER BY n.prop SKIP 2 LIMIT $limit
+  FakeDbAccessor dba;
+  auto prop = dba.Property("prop");
+  {
+    auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n"))),
+                                     RETURN(IDENT("n"), AS("n"), ORDER_BY(PROPERTY_LOOKUP(dba, "n", prop)),
+                                            SKIP(LITERAL(2)), LIMIT(PARAMETER_LOOKUP(0)))));
+    CheckPlan<TypeParam>(query, this->storage, ExpectScanAll(), ExpectProduce(), ExpectOrderByRowsToKeep(true, true),
+                         ExpectSkip(), ExpectLimit());
+  }
+  {
+    // OrderBy keeps all rows when the limit may change between evaluations.
+    auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n"))),
+                                     RETURN(IDENT("n"), AS("n"), ORDER_BY(PROPERTY_LOOKUP(dba, "n", prop)),
+                                            LIMIT(ADD(LITERAL(1), LITERAL(2))))));
+    CheckPlan<TypeParam>(query, this->storage, ExpectScanAll(), ExpectProduce(), ExpectOrderByRowsToKeep(false, false),
+                         ExpectLimit());
+  }
+}
+
 TYPED_TEST(TestPlanner, CreateWithDistinctSumWhereReturn) {
   // Test CREATE (n) WITH DISTINCT SUM(n.prop) AS s WHERE s < 42 RETURN s
   FakeDbAccessor dba;
@@ -690,9 +780,28 @@ TYPED_TEST(TestPlanner, MatchCrossReferenceVariable) {
   auto n_prop = PROPERTY_LOOKUP(dba, "n", prop.second);
   std::get<0>(node_m->properties_)[this->storage.GetPropertyIx(prop.first)] = n_prop;
   auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(node_n), PATTERN(node_m)), RETURN("n")));
-  // We expect both ScanAll to come before filters (2 are joined into one),
-  // because they need to populate the symbol values.
-  CheckPlan<TypeParam>(query, this->storage, ExpectScanAll(), ExpectScanAll(), ExpectFilter(), ExpectProduce());
+  // We expect both ScanAll to be hash joined on one of the equalities, while
+  // the other one stays in the filter above the join.
+  std::list<BaseOpChecker *> left{new ExpectScanAll()};
+  std::list<BaseOpChecker *> right{new ExpectScanAll()};
+  CheckPlan<TypeParam>(query, this->storage, ExpectHashJoin(left, right), ExpectFilter(), ExpectProduce());
+  DeleteListContent(&left);
+  DeleteListContent(&right);
+}
+
+TYPED_TEST(TestPlanner, MatchWhereHashJoin) {
+  // Test MATCH (n), (m) WHERE n.prop = m.prop RETURN n, m
+  FakeDbAccessor dba;
+  auto prop = dba.Property("prop");
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n")), PATTERN(NODE("m"))),
+                                   WHERE(EQ(PROPERTY_LOOKUP(dba, "n", prop), PROPERTY_LOOKUP(dba, "m", prop))),
+                                   RETURN("n", "m")));
+  // The whole filter is used as the join condition, so it is removed.
+  std::list<BaseOpChecker *> left{new ExpectScanAll()};
+  std::list<BaseOpChecker *> right{new ExpectScanAll()};
+  CheckPlan<TypeParam>(query, this->storage, ExpectHashJoin(left, right), ExpectProduce());
+  DeleteListContent(&left);
+  DeleteListContent(&right);
 }
 
 TYPED_TEST(TestPlanner, MatchWhereBeforeExpand) {
@@ -1060,6 +1169,29 @@ TYPED_TEST(TestPlanner, BestPropertyIndexed) {
             ExpectProduce());
 }
 
+TYPED_TEST(TestPlanner, CompositeIndexedLabelProperties) {
+  // Test MATCH (n :label) WHERE n.first = 1 AND n.second > 42 AND n.other = 0 RETURN n
+  FakeDbAccessor dba;
+  auto label = dba.Label("label");
+  auto first = PROPERTY_PAIR(dba, "first");
+  auto second = PROPERTY_PAIR(dba, "second");
+  auto other = PROPERTY_PAIR(dba, "other");
+  dba.SetIndexCount(label, first.second, 1);
+  dba.SetIndexCount(label, {first.second, second.second, other.second}, 1);
+  auto *query = QUERY(SINGLE_QUERY(
+      MATCH(PATTERN(NODE("n", "label"))),
+      WHERE(AND(AND(EQ(PROPERTY_LOOKUP(dba, "n", first), LITERAL(1)),
+                    GREATER(PROPERTY_LOOKUP(dba, "n", second), LITERAL(42))),
+                EQ(PROPERTY_LOOKUP(dba, "n", other), LITERAL(0)))),
+      RETURN("n")));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, this->storage, symbol_table, query);
+  // The range ends the usable prefix of the index, so `other` is still filtered.
+  CheckPlan(planner.plan(), symbol_table,
+            ExpectScanAllByLabelPropertyComposite(label, {first.second, second.second, other.second}, 1, true),
+            ExpectFilter(), ExpectProduce());
+}
+
 TYPED_TEST(TestPlanner, MultiPropertyIndexScan) {
   // Test MATCH (n :label1), (m :label2) WHERE n.prop1 = 1 AND m.prop2 = 2
   //      RETURN n, m
@@ -1159,6 +1291,25 @@ TYPED_TEST(TestPlanner, UnableToUsePropertyIndex) {
   CheckPlan(planner.plan(), symbol_table, ExpectScanAllByLabel(), ExpectFilter(), ExpectProduce());
 }
 
+TYPED_TEST(TestPlanner, MatchFilterPropertiesOnLabelScan) {
+  // Test MATCH (n :label) WHERE n.property = 42 AND n.other = n.property RETURN n
+  FakeDbAccessor dba;
+  auto label = dba.Label("label");
+  auto property = dba.Property("property");
+  auto other = dba.Property("other");
+  dba.SetIndexCount(label, 0);
+  auto *other_eq_property = EQ(PROPERTY_LOOKUP(dba, "n", other), PROPERTY_LOOKUP(dba, "n", property));
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n", "label"))),
+                                   WHERE(AND(EQ(PROPERTY_LOOKUP(dba, "n", property), LITERAL(42)), other_eq_property)),
+                                   RETURN("n")));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, this->storage, symbol_table, query);
+  // Without a property index, the equality with the literal is compared by the
+  // storage during the label scan, and the Filter still checks both of them.
+  CheckPlan(planner.plan(), symbol_table, ExpectScanAllByLabelFilterProperties(label, {property}), ExpectFilter(),
+            ExpectProduce());
+}
+
 TYPED_TEST(TestPlanner, SecondPropertyIndex) {
   // Test MATCH (n :label), (m :label) WHERE m.property = n.property RETURN n
   FakeDbAccessor dba;
@@ -1252,6 +1403,30 @@ TYPED_TEST(TestPlanner, MatchExpandVariableTotalWeightSymbol) {
   EXPECT_TRUE(memgraph::utils::Contains(names, "total_weight"));
 }
 
+TYPED_TEST(TestPlanner, MatchAllShortestPathsCount) {
+  // Test MATCH p = (n)-[r *allShortest (e, v | 1)]->(m) RETURN count(p) AS c
+  FakeDbAccessor dba;
+  auto edge = EDGE_VARIABLE("r", Type::ALL_SHORTEST_PATHS, Direction::OUT);
+  auto *query = QUERY(SINGLE_QUERY(MATCH(NAMED_PATTERN("p", NODE("n"), edge, NODE("m"))),
+                                   RETURN(COUNT(IDENT("p"), false), AS("c"))));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, this->storage, symbol_table, query);
+  // The expansion counts its paths, so the path isn't constructed and the
+  // counts are summed.
+  auto *produce = dynamic_cast<Produce *>(&planner.plan());
+  ASSERT_TRUE(produce);
+  auto *aggregate = dynamic_cast<Aggregate *>(produce->input().get());
+  ASSERT_TRUE(aggregate);
+  ASSERT_EQ(aggregate->aggregations_.size(), 1);
+  EXPECT_EQ(aggregate->aggregations_[0].op, memgraph::query::Aggregation::Op::SUM);
+  auto *expand = dynamic_cast<ExpandVariable *>(aggregate->input().get());
+  ASSERT_TRUE(expand);
+  ASSERT_TRUE(expand->path_count_symbol_);
+  auto *identifier = dynamic_cast<memgraph::query::Identifier *>(aggregate->aggregations_[0].value);
+  ASSERT_TRUE(identifier);
+  EXPECT_EQ(symbol_table.at(*identifier), *expand->path_count_symbol_);
+}
+
 TYPED_TEST(TestPlanner, UnwindMatchVariable) {
   // Test UNWIND [1,2,3] AS depth MATCH (n) -[r*d]-> (m) RETURN r
   auto edge = EDGE_VARIABLE("r", Type::DEPTH_FIRST, Direction::OUT);
@@ -1546,8 +1721,8 @@ TYPED_TEST(TestPlanner, LabelPropertyInListValidOptimization) {
     dba.SetIndexCount(label, property.second, 1);
     auto symbol_table = memgraph::query::MakeSymbolTable(query);
     auto planner = MakePlanner<TypeParam>(&dba, this->storage, symbol_table, query);
-    CheckPlan(planner.plan(), symbol_table, ExpectUnwind(),
-              ExpectScanAllByLabelPropertyValue(label, property, lit_list_a), ExpectProduce());
+    CheckPlan(planner.plan(), symbol_table, ExpectScanAllByLabelPropertyValues(label, property, lit_list_a),
+              ExpectProduce());
   }
 }
 
@@ -10,6 +10,7 @@
 // licenses/APL.txt.
 
 #include <algorithm>
+#include <filesystem>
 #include <iterator>
 #include <memory>
 #include <vector>
@@ -64,8 +65,10 @@ class QueryPlanTest : public testing::Test {
       auto named_expr =
           NEXPR("", IDENT("aggregation")->MapTo(aggr_sym))->MapTo(symbol_table.CreateSymbol("named_expression", true));
       named_expressions.push_back(named_expr);
-      // the key expression is only used in COLLECT_MAP
-      Expression *key_expr_ptr = aggr_op == Aggregation::Op::COLLECT_MAP ? LITERAL("key") : nullptr;
+      // the key expression is only used in COLLECT_MAP and APPROX_PERCENTILE
+      Expression *key_expr_ptr = nullptr;
+      if (aggr_op == Aggregation::Op::COLLECT_MAP) key_expr_ptr = LITERAL("key");
+      if (aggr_op == Aggregation::Op::APPROX_PERCENTILE) key_expr_ptr = LITERAL(0.5);
       aggregates.emplace_back(Aggregate::Element{*aggr_inputs_it++, key_expr_ptr, aggr_op, aggr_sym, distinct});
     }
 
@@ -375,6 +378,37 @@ TYPED_TEST(QueryPlanTest, AggregateGroupByValues) {
                                   TypedValue::BoolEqual{}));
 }
 
+TYPED_TEST(QueryPlanTest, AggregateGroupByMixedNumbers) {
+  // Tests that the groups of integers and of equal doubles are the same,
+  // regardless of which of them comes first.
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  auto prop = dba.NameToProperty("prop");
+  auto name = dba.NameToProperty("name");
+  for (int i = 0; i < 600; ++i) {
+    auto vertex = dba.InsertVertex();
+    const auto value = (i / 3) % 2 == 0 ? memgraph::storage::PropertyValue(i % 3)
+                                        : memgraph::storage::PropertyValue(static_cast<double>(i % 3));
+    ASSERT_TRUE(vertex.SetProperty(prop, value).HasValue());
+    ASSERT_TRUE(vertex.SetProperty(name, memgraph::storage::PropertyValue(i % 2 == 0 ? "even" : "odd")).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  SymbolTable symbol_table;
+  auto n = MakeScanAll(this->storage, symbol_table, "n");
+  auto n_p = PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), prop);
+  auto n_name = PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), name);
+  auto produce =
+      this->MakeAggregationProduce(n.op_, symbol_table, {nullptr}, {Aggregation::Op::COUNT}, {n_p, n_name}, {}, false);
+  auto context = MakeContext(this->storage, symbol_table, &dba);
+  auto results = CollectProduce(*produce, &context);
+  ASSERT_EQ(results.size(), 6);
+  for (const auto &row : results) {
+    ASSERT_EQ(row.size(), 3);
+    EXPECT_EQ(row[0].ValueInt(), 100);
+  }
+}
+
 TYPED_TEST(QueryPlanTest, AggregateMultipleGroupBy) {
   // in this test we have 3 different properties that have different values
   // for different records and assert that we get the correct combination
@@ -1010,3 +1044,244 @@ TYPED_TEST(QueryPlanTest, AggregateTypesWithDistinct) {
   EXPECT_THROW(aggregate(n_p2, Aggregation::Op::AVG), QueryRuntimeException);
   EXPECT_THROW(aggregate(n_p2, Aggregation::Op::SUM), QueryRuntimeException);
 }
+
+TYPED_TEST(QueryPlanTest, AggregateParallel) {
+  // Tests that the results of the aggregations don't depend on the number of
+  // threads that pull the input of the aggregation.
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  auto prop_x = dba.NameToProperty("x");
+  auto prop_y = dba.NameToProperty("y");
+  for (int i = 0; i < 2000; ++i) {
+    auto vertex = dba.InsertVertex();
+    ASSERT_TRUE(vertex.SetProperty(prop_x, memgraph::storage::PropertyValue(i % 7)).HasValue());
+    // every fifth vertex has a null value
+    if (i % 5 != 0) ASSERT_TRUE(vertex.SetProperty(prop_y, memgraph::storage::PropertyValue(i)).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  SymbolTable symbol_table;
+  auto n = MakeScanAll(this->storage, symbol_table, "n");
+  auto n_x = PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), prop_x);
+  auto n_y = PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), prop_y);
+  auto produce = this->MakeAggregationProduce(
+      n.op_, symbol_table, {n_y, n_y, n_y, n_y, n_y, n_y},
+      {Aggregation::Op::COUNT, Aggregation::Op::SUM, Aggregation::Op::MIN, Aggregation::Op::MAX, Aggregation::Op::AVG,
+       Aggregation::Op::COLLECT_LIST},
+      {n_x}, {}, false);
+
+  auto aggregate = [&](uint64_t parallelism) {
+    auto context = MakeContext(this->storage, symbol_table, &dba);
+    context.parallelism = parallelism;
+    context.is_profile_query = true;
+    auto results = CollectProduce(*produce, &context);
+    for (auto &row : results) {
+      auto &list = row[5].ValueList();
+      std::sort(list.begin(), list.end(), [](const auto &a, const auto &b) { return a.ValueInt() < b.ValueInt(); });
+    }
+    std::sort(results.begin(), results.end(),
+              [](const auto &a, const auto &b) { return a[6].ValueInt() < b[6].ValueInt(); });
+
+    // Produce -> Aggregate -> ScanAll
+    const auto &scan_stats = context.stats.children.at(0).children.at(0);
+    if constexpr (std::is_same_v<TypeParam, memgraph::storage::InMemoryStorage>) {
+      EXPECT_EQ(scan_stats.num_threads, parallelism);
+    } else {
+      // The disk storage doesn't split the vertices, so there is nothing to pull in parallel.
+      EXPECT_EQ(scan_stats.num_threads, 1);
+    }
+    return results;
+  };
+
+  auto sequential = aggregate(1);
+  auto parallel = aggregate(4);
+  ASSERT_EQ(sequential.size(), 7);
+  ASSERT_EQ(parallel.size(), sequential.size());
+  for (size_t i = 0; i < sequential.size(); ++i) {
+    ASSERT_EQ(parallel[i].size(), sequential[i].size());
+    for (size_t j = 0; j < sequential[i].size(); ++j) {
+      EXPECT_TRUE(TypedValue::BoolEqual{}(parallel[i][j], sequential[i][j]));
+    }
+  }
+}
+
+TYPED_TEST(QueryPlanTest, AggregateParallelByLabel) {
+  // Tests that the morsels of a label scan contain each vertex with the label
+  // exactly once.
+  auto label = this->db->NameToLabel("label");
+  [[maybe_unused]] auto _ = this->db->CreateIndex(label);
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  auto prop = dba.NameToProperty("prop");
+  int64_t expected_sum = 0;
+  for (int i = 0; i < 3000; ++i) {
+    auto vertex = dba.InsertVertex();
+    ASSERT_TRUE(vertex.SetProperty(prop, memgraph::storage::PropertyValue(i)).HasValue());
+    if (i % 3 == 0) {
+      ASSERT_TRUE(vertex.AddLabel(label).HasValue());
+      expected_sum += i;
+    }
+  }
+  dba.AdvanceCommand();
+
+  SymbolTable symbol_table;
+  auto n = MakeScanAllByLabel(this->storage, symbol_table, "n", label);
+  auto n_p = PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), prop);
+  auto produce = this->MakeAggregationProduce(n.op_, symbol_table, {nullptr, n_p},
+                                              {Aggregation::Op::COUNT, Aggregation::Op::SUM}, {}, {}, false);
+  for (const uint64_t parallelism : {1, 4}) {
+    auto context = MakeContext(this->storage, symbol_table, &dba);
+    context.parallelism = parallelism;
+    auto results = CollectProduce(*produce, &context);
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0][0].ValueInt(), 1000);
+    EXPECT_EQ(results[0][1].ValueInt(), expected_sum);
+  }
+}
+
+TYPED_TEST(QueryPlanTest, AggregateSpill) {
+  // Tests that the results of the aggregations don't depend on whether the
+  // groups are spilled to disk.
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  auto prop_x = dba.NameToProperty("x");
+  auto prop_y = dba.NameToProperty("y");
+  for (int i = 0; i < 500; ++i) {
+    auto vertex = dba.InsertVertex();
+    ASSERT_TRUE(vertex.SetProperty(prop_x, memgraph::storage::PropertyValue(i % 37)).HasValue());
+    // every fifth vertex has a null value
+    if (i % 5 != 0) ASSERT_TRUE(vertex.SetProperty(prop_y, memgraph::storage::PropertyValue(i)).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  SymbolTable symbol_table;
+  auto n = MakeScanAll(this->storage, symbol_table, "n");
+  auto n_x = PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), prop_x);
+  auto n_y = PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), prop_y);
+  auto produce = this->MakeAggregationProduce(
+      n.op_, symbol_table, {n_y, n_y, n_y, n_y, n_y, n_y},
+      {Aggregation::Op::COUNT, Aggregation::Op::SUM, Aggregation::Op::MIN, Aggregation::Op::MAX, Aggregation::Op::AVG,
+       Aggregation::Op::COLLECT_LIST},
+      {n_x}, {}, false);
+
+  const auto spill_directory = std::filesystem::temp_directory_path() / "MG_test_unit_query_plan_aggregate_spill";
+  auto aggregate = [&](uint64_t spill_memory_limit) {
+    auto context = MakeContext(this->storage, symbol_table, &dba);
+    context.spill_memory_limit = spill_memory_limit;
+    context.spill_directory = spill_directory;
+    auto results = CollectProduce(*produce, &context);
+    for (auto &row : results) {
+      auto &list = row[5].ValueList();
+      std::sort(list.begin(), list.end(), [](const auto &a, const auto &b) { return a.ValueInt() < b.ValueInt(); });
+    }
+    std::sort(results.begin(), results.end(),
+              [](const auto &a, const auto &b) { return a[6].ValueInt() < b[6].ValueInt(); });
+    return results;
+  };
+
+  auto in_memory = aggregate(0);
+  auto spilled = aggregate(1024);
+  ASSERT_EQ(in_memory.size(), 37);
+  ASSERT_EQ(spilled.size(), in_memory.size());
+  for (size_t i = 0; i < in_memory.size(); ++i) {
+    ASSERT_EQ(spilled[i].size(), in_memory[i].size());
+    for (size_t j = 0; j < in_memory[i].size(); ++j) {
+      EXPECT_TRUE(TypedValue::BoolEqual{}(spilled[i][j], in_memory[i][j]));
+    }
+  }
+  // The temporary files are removed along with the cursor.
+  EXPECT_TRUE(std::filesystem::is_empty(spill_directory));
+  std::filesystem::remove_all(spill_directory);
+}
+
+TYPED_TEST(QueryPlanTest, AggregateApproximate) {
+  // Tests that the approximate aggregations are close to the exact results
+  // and that their sketches are merged when the input is pulled in parallel.
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  auto prop_x = dba.NameToProperty("x");
+  auto prop_y = dba.NameToProperty("y");
+  for (int i = 0; i < 5000; ++i) {
+    auto vertex = dba.InsertVertex();
+    ASSERT_TRUE(vertex.SetProperty(prop_x, memgraph::storage::PropertyValue(i % 1000)).HasValue());
+    ASSERT_TRUE(vertex.SetProperty(prop_y, memgraph::storage::PropertyValue(i)).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  SymbolTable symbol_table;
+  auto n = MakeScanAll(this->storage, symbol_table, "n");
+  auto n_x = PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), prop_x);
+  auto n_y = PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), prop_y);
+  auto produce = this->MakeAggregationProduce(
+      n.op_, symbol_table, {n_x, n_y}, {Aggregation::Op::APPROX_COUNT_DISTINCT, Aggregation::Op::APPROX_PERCENTILE},
+      {}, {}, false);
+
+  std::optional<int64_t> sequential_count;
+  for (const uint64_t parallelism : {1, 4}) {
+    auto context = MakeContext(this->storage, symbol_table, &dba);
+    context.parallelism = parallelism;
+    auto results = CollectProduce(*produce, &context);
+    ASSERT_EQ(results.size(), 1);
+    const auto count = results[0][0].ValueInt();
+    EXPECT_NEAR(count, 1000, 20);
+    // The registers of the sketches don't depend on the order of the values.
+    if (sequential_count) EXPECT_EQ(count, *sequential_count);
+    sequential_count = count;
+    EXPECT_NEAR(results[0][1].ValueDouble(), 2500, 50);
+  }
+
+  // There's nothing to estimate when all the values are null.
+  auto n_z = PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), dba.NameToProperty("z"));
+  auto empty_produce = this->MakeAggregationProduce(
+      n.op_, symbol_table, {n_z, n_z}, {Aggregation::Op::APPROX_COUNT_DISTINCT, Aggregation::Op::APPROX_PERCENTILE},
+      {}, {}, false);
+  auto context = MakeContext(this->storage, symbol_table, &dba);
+  auto results = CollectProduce(*empty_produce, &context);
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(results[0][0].ValueInt(), 0);
+  EXPECT_TRUE(results[0][1].IsNull());
+}
+
+TYPED_TEST(QueryPlanTest, AggregateBatches) {
+  // Tests that aggregating the input in batches gives the same results as
+  // aggregating it row by row, which the profiling does.
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  auto prop_x = dba.NameToProperty("x");
+  for (int i = 0; i < 2000; ++i) {
+    auto vertex = dba.InsertVertex();
+    // every seventh vertex has a null value, the integers are followed by
+    // doubles, and both are in a batch of the input
+    if (i % 7 == 0) continue;
+    const auto value = i < 1100 ? memgraph::storage::PropertyValue(1000 - i)
+                                : memgraph::storage::PropertyValue(static_cast<double>(i) / 3.0);
+    ASSERT_TRUE(vertex.SetProperty(prop_x, value).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  SymbolTable symbol_table;
+  auto n = MakeScanAll(this->storage, symbol_table, "n");
+  auto n_x = PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), prop_x);
+  auto produce = this->MakeAggregationProduce(
+      n.op_, symbol_table, {nullptr, n_x, n_x, n_x, n_x, n_x},
+      {Aggregation::Op::COUNT, Aggregation::Op::COUNT, Aggregation::Op::SUM, Aggregation::Op::MIN,
+       Aggregation::Op::MAX, Aggregation::Op::AVG},
+      {}, {}, false);
+
+  auto aggregate = [&](bool is_profile_query) {
+    auto context = MakeContext(this->storage, symbol_table, &dba);
+    context.is_profile_query = is_profile_query;
+    return CollectProduce(*produce, &context);
+  };
+
+  auto rows = aggregate(true);
+  auto batches = aggregate(false);
+  ASSERT_EQ(rows.size(), 1);
+  ASSERT_EQ(batches.size(), 1);
+  ASSERT_EQ(batches[0].size(), rows[0].size());
+  EXPECT_EQ(rows[0][0].ValueInt(), 2000);
+  for (size_t i = 0; i < rows[0].size(); ++i) {
+    EXPECT_EQ(batches[0][i].type(), rows[0][i].type());
+    EXPECT_TRUE(TypedValue::BoolEqual{}(batches[0][i], rows[0][i]));
+  }
+}
@@ -15,8 +15,10 @@
 //
 
 #include <algorithm>
+#include <filesystem>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <vector>
 
 #include "disk_test_utils.hpp"
@@ -255,6 +257,73 @@ TYPED_TEST(QueryPlanTest, OrderByMultiple) {
   }
 }
 
+TYPED_TEST(QueryPlanTest, OrderBySkipLimit) {
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  SymbolTable symbol_table;
+  auto prop = dba.NameToProperty("prop");
+
+  std::vector<int> values(100);
+  std::iota(values.begin(), values.end(), 0);
+  std::random_shuffle(values.begin(), values.end());
+  for (const auto value : values) {
+    ASSERT_TRUE(dba.InsertVertex().SetProperty(prop, memgraph::storage::PropertyValue(value)).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  auto check = [&](int64_t skip, int64_t limit, const std::vector<int64_t> &expected) {
+    auto n = MakeScanAll(this->storage, symbol_table, "n");
+    auto n_p = PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), prop);
+    // OrderBy keeps only the first skip + limit rows, Skip and Limit drop the rest.
+    auto order_by = std::make_shared<plan::OrderBy>(n.op_, std::vector<SortItem>{{Ordering::DESC, n_p}},
+                                                    std::vector<Symbol>{n.sym_}, LITERAL(skip), LITERAL(limit));
+    auto skip_op = std::make_shared<plan::Skip>(order_by, LITERAL(skip));
+    auto limit_op = std::make_shared<plan::Limit>(skip_op, LITERAL(limit));
+    auto n_p_ne = NEXPR("n.p", n_p)->MapTo(symbol_table.CreateSymbol("n.p", true));
+    auto produce = MakeProduce(limit_op, n_p_ne);
+    auto context = MakeContext(this->storage, symbol_table, &dba);
+    auto results = CollectProduce(*produce, &context);
+    ASSERT_EQ(results.size(), expected.size());
+    for (size_t i = 0; i < results.size(); ++i) EXPECT_EQ(results[i][0].ValueInt(), expected[i]);
+  };
+  check(0, 3, {99, 98, 97});
+  check(5, 3, {94, 93, 92});
+  check(98, 5, {1, 0});
+  check(0, 0, {});
+}
+
+TYPED_TEST(QueryPlanTest, OrderBySpill) {
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  SymbolTable symbol_table;
+  auto prop = dba.NameToProperty("prop");
+
+  std::vector<int> values(1000);
+  std::iota(values.begin(), values.end(), 0);
+  std::random_shuffle(values.begin(), values.end());
+  for (const auto value : values) {
+    ASSERT_TRUE(dba.InsertVertex().SetProperty(prop, memgraph::storage::PropertyValue(value)).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  // The sorted runs spilled to disk are merged with the rows left in memory.
+  auto n = MakeScanAll(this->storage, symbol_table, "n");
+  auto n_p = PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), prop);
+  auto order_by = std::make_shared<plan::OrderBy>(n.op_, std::vector<SortItem>{{Ordering::ASC, n_p}},
+                                                  std::vector<Symbol>{n.sym_});
+  auto n_p_ne = NEXPR("n.p", n_p)->MapTo(symbol_table.CreateSymbol("n.p", true));
+  auto produce = MakeProduce(order_by, n_p_ne);
+  const auto spill_directory = std::filesystem::temp_directory_path() / "MG_test_unit_query_plan_order_by_spill";
+  auto context = MakeContext(this->storage, symbol_table, &dba);
+  context.spill_memory_limit = 4096;
+  context.spill_directory = spill_directory;
+  auto results = CollectProduce(*produce, &context);
+  ASSERT_EQ(results.size(), values.size());
+  for (size_t i = 0; i < results.size(); ++i) EXPECT_EQ(results[i][0].ValueInt(), static_cast<int64_t>(i));
+  EXPECT_TRUE(std::filesystem::is_empty(spill_directory));
+  std::filesystem::remove_all(spill_directory);
+}
+
 TYPED_TEST(QueryPlanTest, OrderByExceptions) {
   auto storage_dba = this->db->Access();
   memgraph::query::DbAccessor dba(storage_dba.get());
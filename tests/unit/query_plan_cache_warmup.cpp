@@ -0,0 +1,108 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "query/frontend/stripped.hpp"
+#include "query/interpreter.hpp"
+#include "query/plan_cache_warmup.hpp"
+#include "query/query_stats.hpp"
+#include "storage/v2/inmemory/storage.hpp"
+
+using memgraph::query::WarmUpQuery;
+using Type = memgraph::storage::PropertyValue::Type;
+
+class PlanCacheWarmUpTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::filesystem::remove_all(directory_);
+    std::filesystem::create_directories(directory_);
+  }
+  void TearDown() override { std::filesystem::remove_all(directory_); }
+
+  std::filesystem::path directory_{std::filesystem::temp_directory_path() / "MG_tests_unit_query_plan_cache_warmup"};
+};
+
+TEST_F(PlanCacheWarmUpTest, SaveAndLoad) {
+  const std::vector<WarmUpQuery> queries{{"MATCH (n {id: 0}) RETURN n", {}},
+                                         {"MATCH (n) WHERE n.x = $x AND n.y IN $y RETURN n",
+                                          {{"x", Type::String}, {"y", Type::List}}}};
+  const auto path = directory_ / "queries.json";
+  ASSERT_TRUE(memgraph::query::SaveWarmUpQueries(path, queries));
+  const auto loaded = memgraph::query::LoadWarmUpQueries(path);
+  ASSERT_EQ(loaded.size(), 2);
+  EXPECT_EQ(loaded[0].query, queries[0].query);
+  EXPECT_TRUE(loaded[0].parameter_types.empty());
+  EXPECT_EQ(loaded[1].query, queries[1].query);
+  EXPECT_EQ(loaded[1].parameter_types, queries[1].parameter_types);
+  EXPECT_FALSE(std::filesystem::exists(directory_ / "queries.json.tmp"));
+}
+
+TEST_F(PlanCacheWarmUpTest, InvalidFile) {
+  EXPECT_TRUE(memgraph::query::LoadWarmUpQueries(directory_ / "missing.json").empty());
+  const auto path = directory_ / "invalid.json";
+  std::ofstream(path) << R"({"version": 1, "queries": [{"query": "RETURN 1"}]})";
+  EXPECT_TRUE(memgraph::query::LoadWarmUpQueries(path).empty());
+}
+
+TEST_F(PlanCacheWarmUpTest, PlaceholderParameters) {
+  const auto parameters = memgraph::query::PlaceholderParameters(
+      {{"a", Type::Null}, {"b", Type::Int}, {"c", Type::String}, {"d", Type::Map}, {"e", Type::TemporalData}});
+  ASSERT_EQ(parameters.size(), 5);
+  EXPECT_EQ(parameters.at("a").type(), Type::Null);
+  EXPECT_EQ(parameters.at("b").type(), Type::Int);
+  EXPECT_EQ(parameters.at("c").type(), Type::String);
+  EXPECT_EQ(parameters.at("d").type(), Type::Map);
+  EXPECT_EQ(parameters.at("e").type(), Type::TemporalData);
+}
+
+TEST_F(PlanCacheWarmUpTest, HottestQueries) {
+  memgraph::query::gQueryStats.Record("a", {.query_hash = 1}, 10, {{"x", Type::Int}});
+  memgraph::query::gQueryStats.Record("b", {.query_hash = 2}, 10);
+  memgraph::query::gQueryStats.Record("b", {.query_hash = 2}, 10);
+  const std::vector<WarmUpQuery> previous{{"a", {}}, {"c", {}}, {"d", {}}};
+
+  const auto queries = memgraph::query::HottestQueries(3, previous);
+  ASSERT_EQ(queries.size(), 3);
+  EXPECT_EQ(queries[0].query, "b");
+  EXPECT_EQ(queries[1].query, "a");
+  EXPECT_EQ(queries[1].parameter_types, (memgraph::query::QueryParameterTypes{{"x", Type::Int}}));
+  EXPECT_EQ(queries[2].query, "c");
+
+  const auto hottest = memgraph::query::HottestQueries(1, previous);
+  ASSERT_EQ(hottest.size(), 1);
+  EXPECT_EQ(hottest[0].query, "b");
+}
+
+TEST_F(PlanCacheWarmUpTest, WarmUpPlanCache) {
+  memgraph::query::InterpreterContext interpreter_context(std::make_unique<memgraph::storage::InMemoryStorage>(),
+                                                          memgraph::query::InterpreterConfig{}, directory_);
+  const memgraph::query::frontend::StrippedQuery stripped("MATCH (n:L {id: $id}) WHERE n.x > 5 RETURN n");
+  const std::vector<WarmUpQuery> queries{{stripped.query(), {{"id", Type::Int}}},
+                                         // Syntax error.
+                                         {"MATCH (n RETURN n", {}},
+                                         // Not a Cypher query.
+                                         {"CREATE INDEX ON :L(id)", {}},
+                                         // Missing parameter.
+                                         {"RETURN $y", {}}};
+
+  EXPECT_EQ(memgraph::query::WarmUpPlanCache(&interpreter_context, queries, 2), 1);
+  auto plan_cache = interpreter_context.plan_cache.access();
+  EXPECT_EQ(plan_cache.size(), 1);
+  // The plan is cached under the hash of the original query.
+  EXPECT_NE(plan_cache.find(stripped.hash()), plan_cache.end());
+}
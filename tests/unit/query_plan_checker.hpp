@@ -60,11 +60,16 @@ class PlanChecker : public virtual HierarchicalLogicalOperatorVisitor {
   PRE_VISIT(ScanAll);
   PRE_VISIT(ScanAllByLabel);
   PRE_VISIT(ScanAllByLabelPropertyValue);
+  PRE_VISIT(ScanAllByLabelPropertyValues);
   PRE_VISIT(ScanAllByLabelPropertyRange);
   PRE_VISIT(ScanAllByLabelProperty);
+  PRE_VISIT(ScanAllByLabelPropertyComposite);
   PRE_VISIT(ScanAllById);
+  PRE_VISIT(ScanAllByEdgeType);
+  PRE_VISIT(ScanAllByEdgeTypeProperty);
   PRE_VISIT(Expand);
   PRE_VISIT(ExpandVariable);
+  PRE_VISIT(IntersectExpand);
   PRE_VISIT(ConstructNamedPath);
   PRE_VISIT(EmptyResult);
   PRE_VISIT(Produce);
@@ -114,6 +119,11 @@ class PlanChecker : public virtual HierarchicalLogicalOperatorVisitor {
     return false;
   }
 
+  bool PreVisit(HashJoin &op) override {
+    CheckOp(op);
+    return false;
+  }
+
   bool PreVisit(Apply &op) override {
     CheckOp(op);
     op.input()->Accept(*this);
@@ -159,6 +169,7 @@ using ExpectScanAll = OpChecker<ScanAll>;
 using ExpectScanAllByLabel = OpChecker<ScanAllByLabel>;
 using ExpectScanAllById = OpChecker<ScanAllById>;
 using ExpectExpand = OpChecker<Expand>;
+using ExpectIntersectExpand = OpChecker<IntersectExpand>;
 using ExpectConstructNamedPath = OpChecker<ConstructNamedPath>;
 using ExpectProduce = OpChecker<Produce>;
 using ExpectEmptyResult = OpChecker<EmptyResult>;
@@ -336,6 +347,37 @@ class ExpectOptional : public OpChecker<Optional> {
   const std::list<BaseOpChecker *> &optional_;
 };
 
+class ExpectOrderByRowsToKeep : public OpChecker<OrderBy> {
+ public:
+  ExpectOrderByRowsToKeep(bool has_skip, bool has_limit) : has_skip_(has_skip), has_limit_(has_limit) {}
+
+  void ExpectOp(OrderBy &order_by, const SymbolTable &) override {
+    EXPECT_EQ(order_by.skip_ != nullptr, has_skip_);
+    EXPECT_EQ(order_by.limit_ != nullptr, has_limit_);
+  }
+
+ private:
+  bool has_skip_;
+  bool has_limit_;
+};
+
+class ExpectScanAllByLabelFilterProperties : public OpChecker<ScanAllByLabel> {
+ public:
+  ExpectScanAllByLabelFilterProperties(memgraph::storage::LabelId label,
+                                       const std::vector<memgraph::storage::PropertyId> &filter_properties)
+      : label_(label), filter_properties_(filter_properties) {}
+
+  void ExpectOp(ScanAllByLabel &scan_all, const SymbolTable &) override {
+    EXPECT_EQ(scan_all.label_, label_);
+    EXPECT_EQ(scan_all.filter_properties_, filter_properties_);
+    EXPECT_EQ(scan_all.filter_values_.size(), filter_properties_.size());
+  }
+
+ private:
+  memgraph::storage::LabelId label_;
+  std::vector<memgraph::storage::PropertyId> filter_properties_;
+};
+
 class ExpectScanAllByLabelPropertyValue : public OpChecker<ScanAllByLabelPropertyValue> {
  public:
   ExpectScanAllByLabelPropertyValue(memgraph::storage::LabelId label,
@@ -356,6 +398,26 @@ class ExpectScanAllByLabelPropertyValue : public OpChecker<ScanAllByLabelPropert
   memgraph::query::Expression *expression_;
 };
 
+class ExpectScanAllByLabelPropertyValues : public OpChecker<ScanAllByLabelPropertyValues> {
+ public:
+  ExpectScanAllByLabelPropertyValues(memgraph::storage::LabelId label,
+                                     const std::pair<std::string, memgraph::storage::PropertyId> &prop_pair,
+                                     memgraph::query::Expression *expression)
+      : label_(label), property_(prop_pair.second), expression_(expression) {}
+
+  void ExpectOp(ScanAllByLabelPropertyValues &scan_all, const SymbolTable &) override {
+    EXPECT_EQ(scan_all.label_, label_);
+    EXPECT_EQ(scan_all.property_, property_);
+    // TODO: Proper expression equality
+    EXPECT_EQ(typeid(scan_all.expression_).hash_code(), typeid(expression_).hash_code());
+  }
+
+ private:
+  memgraph::storage::LabelId label_;
+  memgraph::storage::PropertyId property_;
+  memgraph::query::Expression *expression_;
+};
+
 class ExpectScanAllByLabelPropertyRange : public OpChecker<ScanAllByLabelPropertyRange> {
  public:
   ExpectScanAllByLabelPropertyRange(memgraph::storage::LabelId label, memgraph::storage::PropertyId property,
@@ -403,6 +465,54 @@ class ExpectScanAllByLabelProperty : public OpChecker<ScanAllByLabelProperty> {
   memgraph::storage::PropertyId property_;
 };
 
+class ExpectScanAllByLabelPropertyComposite : public OpChecker<ScanAllByLabelPropertyComposite> {
+ public:
+  ExpectScanAllByLabelPropertyComposite(memgraph::storage::LabelId label,
+                                        const std::vector<memgraph::storage::PropertyId> &properties,
+                                        size_t prefix_size, bool has_bounds)
+      : label_(label), properties_(properties), prefix_size_(prefix_size), has_bounds_(has_bounds) {}
+
+  void ExpectOp(ScanAllByLabelPropertyComposite &scan_all, const SymbolTable &) override {
+    EXPECT_EQ(scan_all.label_, label_);
+    EXPECT_EQ(scan_all.properties_, properties_);
+    EXPECT_EQ(scan_all.prefix_.size(), prefix_size_);
+    EXPECT_EQ(scan_all.lower_bound_ || scan_all.upper_bound_, has_bounds_);
+  }
+
+ private:
+  memgraph::storage::LabelId label_;
+  std::vector<memgraph::storage::PropertyId> properties_;
+  size_t prefix_size_;
+  bool has_bounds_;
+};
+
+class ExpectScanAllByEdgeType : public OpChecker<ScanAllByEdgeType> {
+ public:
+  explicit ExpectScanAllByEdgeType(memgraph::storage::EdgeTypeId edge_type) : edge_type_(edge_type) {}
+
+  void ExpectOp(ScanAllByEdgeType &scan_all, const SymbolTable &) override {
+    EXPECT_EQ(scan_all.edge_type_, edge_type_);
+  }
+
+ private:
+  memgraph::storage::EdgeTypeId edge_type_;
+};
+
+class ExpectScanAllByEdgeTypeProperty : public OpChecker<ScanAllByEdgeTypeProperty> {
+ public:
+  ExpectScanAllByEdgeTypeProperty(memgraph::storage::EdgeTypeId edge_type, memgraph::storage::PropertyId property)
+      : edge_type_(edge_type), property_(property) {}
+
+  void ExpectOp(ScanAllByEdgeTypeProperty &scan_all, const SymbolTable &) override {
+    EXPECT_EQ(scan_all.edge_type_, edge_type_);
+    EXPECT_EQ(scan_all.property_, property_);
+  }
+
+ private:
+  memgraph::storage::EdgeTypeId edge_type_;
+  memgraph::storage::PropertyId property_;
+};
+
 class ExpectCartesian : public OpChecker<Cartesian> {
  public:
   ExpectCartesian(const std::list<std::unique_ptr<BaseOpChecker>> &left,
@@ -423,6 +533,25 @@ class ExpectCartesian : public OpChecker<Cartesian> {
   const std::list<std::unique_ptr<BaseOpChecker>> &right_;
 };
 
+class ExpectHashJoin : public OpChecker<HashJoin> {
+ public:
+  ExpectHashJoin(const std::list<BaseOpChecker *> &left, const std::list<BaseOpChecker *> &right)
+      : left_(left), right_(right) {}
+
+  void ExpectOp(HashJoin &op, const SymbolTable &symbol_table) override {
+    ASSERT_TRUE(op.left_op_);
+    PlanChecker left_checker(left_, symbol_table);
+    op.left_op_->Accept(left_checker);
+    ASSERT_TRUE(op.right_op_);
+    PlanChecker right_checker(right_, symbol_table);
+    op.right_op_->Accept(right_checker);
+  }
+
+ private:
+  std::list<BaseOpChecker *> left_;
+  std::list<BaseOpChecker *> right_;
+};
+
 class ExpectCallProcedure : public OpChecker<CallProcedure> {
  public:
   ExpectCallProcedure(const std::string &name, const std::vector<memgraph::query::Expression *> &args,
@@ -472,6 +601,8 @@ TPlanner MakePlanner(TDbAccessor *dba, AstStorage &storage, SymbolTable &symbol_
 
 class FakeDbAccessor {
  public:
+  int64_t VerticesCount() const { return 0; }
+
   int64_t VerticesCount(memgraph::storage::LabelId label) const {
     auto found = label_index_.find(label);
     if (found != label_index_.end()) return found->second;
@@ -487,6 +618,17 @@ class FakeDbAccessor {
     return 0;
   }
 
+  int64_t VerticesCount(memgraph::storage::LabelId label, memgraph::storage::PropertyId property,
+                        const memgraph::storage::PropertyValue &) const {
+    return VerticesCount(label, property);
+  }
+
+  int64_t VerticesCount(memgraph::storage::LabelId label, memgraph::storage::PropertyId property,
+                        const std::optional<memgraph::utils::Bound<memgraph::storage::PropertyValue>> &,
+                        const std::optional<memgraph::utils::Bound<memgraph::storage::PropertyValue>> &) const {
+    return VerticesCount(label, property);
+  }
+
   bool LabelIndexExists(memgraph::storage::LabelId label) const {
     return label_index_.find(label) != label_index_.end();
   }
@@ -509,8 +651,100 @@ class FakeDbAccessor {
     return memgraph::storage::LabelIndexStats{.count = 0, .avg_degree = 0};  // unique id
   }
 
+  int64_t VerticesCount(memgraph::storage::LabelId label,
+                        const std::vector<memgraph::storage::PropertyId> &properties) const {
+    for (auto &index : label_property_composite_index_) {
+      if (std::get<0>(index) == label && std::get<1>(index) == properties) {
+        return std::get<2>(index);
+      }
+    }
+    return 0;
+  }
+
+  int64_t VerticesCount(memgraph::storage::LabelId label, const std::vector<memgraph::storage::PropertyId> &properties,
+                        const std::vector<memgraph::storage::PropertyValue> &,
+                        const std::optional<memgraph::utils::Bound<memgraph::storage::PropertyValue>> &,
+                        const std::optional<memgraph::utils::Bound<memgraph::storage::PropertyValue>> &) const {
+    return VerticesCount(label, properties);
+  }
+
+  std::vector<std::vector<memgraph::storage::PropertyId>> LabelPropertyCompositeIndices(
+      memgraph::storage::LabelId label) const {
+    std::vector<std::vector<memgraph::storage::PropertyId>> indices;
+    for (auto &index : label_property_composite_index_) {
+      if (std::get<0>(index) == label) indices.push_back(std::get<1>(index));
+    }
+    return indices;
+  }
+
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId edge_type) const {
+    auto found = edge_type_index_.find(edge_type);
+    if (found != edge_type_index_.end()) return found->second;
+    return 0;
+  }
+
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId edge_type, memgraph::storage::PropertyId property) const {
+    for (auto &index : edge_type_property_index_) {
+      if (std::get<0>(index) == edge_type && std::get<1>(index) == property) {
+        return std::get<2>(index);
+      }
+    }
+    return 0;
+  }
+
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId edge_type, memgraph::storage::PropertyId property,
+                     const memgraph::storage::PropertyValue &) const {
+    return EdgesCount(edge_type, property);
+  }
+
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId edge_type, memgraph::storage::PropertyId property,
+                     const std::optional<memgraph::utils::Bound<memgraph::storage::PropertyValue>> &,
+                     const std::optional<memgraph::utils::Bound<memgraph::storage::PropertyValue>> &) const {
+    return EdgesCount(edge_type, property);
+  }
+
+  bool EdgeTypeIndexExists(memgraph::storage::EdgeTypeId edge_type) const {
+    return edge_type_index_.find(edge_type) != edge_type_index_.end();
+  }
+
+  bool EdgeTypePropertyIndexExists(memgraph::storage::EdgeTypeId edge_type,
+                                   memgraph::storage::PropertyId property) const {
+    for (auto &index : edge_type_property_index_) {
+      if (std::get<0>(index) == edge_type && std::get<1>(index) == property) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void SetEdgeIndexCount(memgraph::storage::EdgeTypeId edge_type, int64_t count) {
+    edge_type_index_[edge_type] = count;
+  }
+
+  void SetEdgeIndexCount(memgraph::storage::EdgeTypeId edge_type, memgraph::storage::PropertyId property,
+                         int64_t count) {
+    for (auto &index : edge_type_property_index_) {
+      if (std::get<0>(index) == edge_type && std::get<1>(index) == property) {
+        std::get<2>(index) = count;
+        return;
+      }
+    }
+    edge_type_property_index_.emplace_back(edge_type, property, count);
+  }
+
   void SetIndexCount(memgraph::storage::LabelId label, int64_t count) { label_index_[label] = count; }
 
+  void SetIndexCount(memgraph::storage::LabelId label, const std::vector<memgraph::storage::PropertyId> &properties,
+                     int64_t count) {
+    for (auto &index : label_property_composite_index_) {
+      if (std::get<0>(index) == label && std::get<1>(index) == properties) {
+        std::get<2>(index) = count;
+        return;
+      }
+    }
+    label_property_composite_index_.emplace_back(label, properties, count);
+  }
+
   void SetIndexCount(memgraph::storage::LabelId label, memgraph::storage::PropertyId property, int64_t count) {
     for (auto &index : label_property_index_) {
       if (std::get<0>(index) == label && std::get<1>(index) == property) {
@@ -559,6 +793,11 @@ class FakeDbAccessor {
 
   std::unordered_map<memgraph::storage::LabelId, int64_t> label_index_;
   std::vector<std::tuple<memgraph::storage::LabelId, memgraph::storage::PropertyId, int64_t>> label_property_index_;
+  std::vector<std::tuple<memgraph::storage::LabelId, std::vector<memgraph::storage::PropertyId>, int64_t>>
+      label_property_composite_index_;
+  std::unordered_map<memgraph::storage::EdgeTypeId, int64_t> edge_type_index_;
+  std::vector<std::tuple<memgraph::storage::EdgeTypeId, memgraph::storage::PropertyId, int64_t>>
+      edge_type_property_index_;
 };
 
 }  // namespace memgraph::query::plan
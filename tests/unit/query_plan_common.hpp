@@ -171,6 +171,25 @@ ScanAllTuple MakeScanAllByLabelPropertyValue(AstStorage &storage, SymbolTable &s
   return ScanAllTuple{node, logical_op, symbol};
 }
 
+/**
+ * Creates and returns a tuple of stuff for a scan-all starting from the node
+ * with the given name and label whose property value is in the given list.
+ *
+ * Returns ScanAllTuple(node_atom, scan_all_logical_op, symbol).
+ */
+ScanAllTuple MakeScanAllByLabelPropertyValues(AstStorage &storage, SymbolTable &symbol_table, std::string identifier,
+                                              memgraph::storage::LabelId label, memgraph::storage::PropertyId property,
+                                              const std::string &property_name, Expression *values,
+                                              std::shared_ptr<LogicalOperator> input = {nullptr},
+                                              memgraph::storage::View view = memgraph::storage::View::OLD) {
+  auto node = memgraph::query::test_common::GetNode(storage, identifier);
+  auto symbol = symbol_table.CreateSymbol(identifier, true);
+  node->identifier_->MapTo(symbol);
+  auto logical_op =
+      std::make_shared<ScanAllByLabelPropertyValues>(input, symbol, label, property, property_name, values, view);
+  return ScanAllTuple{node, logical_op, symbol};
+}
+
 struct ExpandTuple {
   EdgeAtom *edge_;
   Symbol edge_sym_;
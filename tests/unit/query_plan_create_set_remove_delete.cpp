@@ -1649,6 +1649,85 @@ TYPED_TEST(QueryPlanTest, MergeNoInput) {
   EXPECT_EQ(1, CountIterable(dba.Vertices(memgraph::storage::View::OLD)));
 }
 
+TYPED_TEST(QueryPlanTest, UnwindMerge) {
+  // UNWIND [...] AS row MERGE (n:User {id: row.id}) SET n += row.props
+  // where one of the keys already exists and another one is repeated
+  auto label = this->db->NameToLabel("User");
+  auto id = this->db->NameToProperty("id");
+  [[maybe_unused]] auto _ = this->db->CreateIndex(label, id);
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  auto existing = dba.InsertVertex();
+  ASSERT_TRUE(existing.AddLabel(label).HasValue());
+  ASSERT_TRUE(existing.SetProperty(id, memgraph::storage::PropertyValue(1)).HasValue());
+  dba.AdvanceCommand();
+
+  auto name = PROPERTY_PAIR(dba, "name");
+  auto age = PROPERTY_PAIR(dba, "age");
+  auto row = [&](memgraph::query::Expression *key, auto prop, memgraph::query::Expression *value) {
+    return MAP({this->storage.GetPropertyIx("id"), key},
+               {this->storage.GetPropertyIx("props"), MAP({this->storage.GetPropertyIx(prop.first), value})});
+  };
+
+  auto make_plan = [&](memgraph::query::Expression *rows, SymbolTable &symbol_table) {
+    auto row_sym = symbol_table.CreateSymbol("row", true);
+    auto node_sym = symbol_table.CreateSymbol("n", true);
+    auto key = PROPERTY_LOOKUP(dba, IDENT("row")->MapTo(row_sym), "id");
+    auto props = PROPERTY_LOOKUP(dba, IDENT("row")->MapTo(row_sym), "props");
+    auto unwind = std::make_shared<plan::Unwind>(nullptr, rows, row_sym);
+    auto scan = std::make_shared<ScanAllByLabelPropertyValue>(std::make_shared<Once>(), node_sym, label, id, "id", key,
+                                                              memgraph::storage::View::NEW);
+    NodeCreationInfo node;
+    node.symbol = node_sym;
+    node.labels.emplace_back(label);
+    std::get<PropertiesMapList>(node.properties).emplace_back(id, key);
+    auto create = std::make_shared<CreateNode>(std::make_shared<Once>(), node);
+    auto merge = std::make_shared<plan::Merge>(unwind, scan, create);
+    auto set = std::make_shared<plan::SetProperties>(merge, node_sym, props, plan::SetProperties::Op::UPDATE);
+    return std::make_shared<plan::UnwindMerge>(nullptr, rows, row_sym, node_sym, label, id, key, props, set);
+  };
+
+  auto get_vertex = [&](const memgraph::storage::PropertyValue &key) {
+    std::vector<memgraph::query::VertexAccessor> vertices;
+    for (auto vertex : dba.Vertices(memgraph::storage::View::OLD, label, id, key)) vertices.push_back(vertex);
+    EXPECT_EQ(vertices.size(), 1);
+    return vertices.front();
+  };
+
+  {
+    SymbolTable symbol_table;
+    auto unwind_merge = make_plan(
+        LIST(row(LITERAL(2), name, LITERAL("b")), row(LITERAL(1), name, LITERAL("a")), row(LITERAL(2), age, LITERAL(3)),
+             row(LITERAL(2), name, LITERAL("c"))),
+        symbol_table);
+    auto context = MakeContext(this->storage, symbol_table, &dba);
+    EXPECT_EQ(4, PullAll(*unwind_merge, &context));
+    dba.AdvanceCommand();
+  }
+  EXPECT_EQ(2, CountIterable(dba.Vertices(memgraph::storage::View::OLD)));
+  auto v1 = get_vertex(memgraph::storage::PropertyValue(1));
+  EXPECT_EQ(v1.Gid(), existing.Gid());
+  EXPECT_EQ(v1.GetProperty(memgraph::storage::View::OLD, name.second)->ValueString(), "a");
+  auto v2 = get_vertex(memgraph::storage::PropertyValue(2));
+  EXPECT_EQ(v2.GetProperty(memgraph::storage::View::OLD, name.second)->ValueString(), "c");
+  EXPECT_EQ(v2.GetProperty(memgraph::storage::View::OLD, age.second)->ValueInt(), 3);
+
+  {
+    // The double key is ingested by the original plan.
+    SymbolTable symbol_table;
+    auto unwind_merge =
+        make_plan(LIST(row(LITERAL(2), age, LITERAL(4)), row(LITERAL(1.5), name, LITERAL("d"))), symbol_table);
+    auto context = MakeContext(this->storage, symbol_table, &dba);
+    EXPECT_EQ(2, PullAll(*unwind_merge, &context));
+    dba.AdvanceCommand();
+  }
+  EXPECT_EQ(3, CountIterable(dba.Vertices(memgraph::storage::View::OLD)));
+  v2 = get_vertex(memgraph::storage::PropertyValue(2));
+  EXPECT_EQ(v2.GetProperty(memgraph::storage::View::OLD, age.second)->ValueInt(), 4);
+  auto v3 = get_vertex(memgraph::storage::PropertyValue(1.5));
+  EXPECT_EQ(v3.GetProperty(memgraph::storage::View::OLD, name.second)->ValueString(), "d");
+}
+
 TYPED_TEST(QueryPlanTest, SetPropertyOnNull) {
   // SET (Null).prop = 42
   auto storage_dba = this->db->Access();
@@ -1858,6 +1937,71 @@ TYPED_TEST(QueryPlanTest, DeleteRemoveProperty) {
   EXPECT_THROW(PullAll(*rem_op, &context), QueryRuntimeException);
 }
 
+TEST(QueryPlanParallelWrites, UnwindCreateSet) {
+  // UNWIND range(0, 999) AS x CREATE (n {x: x}) SET n.y = x, pulled in parallel
+  // in the analytical mode, followed by MATCH (n) SET n.z = n.x.
+  memgraph::storage::Config config;
+  std::unique_ptr<memgraph::storage::Storage> db = std::make_unique<memgraph::storage::InMemoryStorage>(config);
+  db->SetStorageMode(memgraph::storage::StorageMode::IN_MEMORY_ANALYTICAL);
+  AstStorage storage;
+  auto storage_dba = db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  auto prop_x = dba.NameToProperty("x");
+  auto prop_y = dba.NameToProperty("y");
+  auto prop_z = dba.NameToProperty("z");
+
+  constexpr int64_t kCount = 1000;
+  std::vector<Expression *> elements;
+  for (int64_t i = 0; i < kCount; ++i) elements.push_back(storage.Create<PrimitiveLiteral>(i));
+
+  SymbolTable symbol_table;
+  auto x = symbol_table.CreateSymbol("x", true);
+  auto unwind = std::make_shared<plan::Unwind>(nullptr, storage.Create<memgraph::query::ListLiteral>(elements), x);
+  NodeCreationInfo node;
+  node.symbol = symbol_table.CreateSymbol("n", true);
+  std::get<std::vector<std::pair<memgraph::storage::PropertyId, Expression *>>>(node.properties)
+      .emplace_back(prop_x, storage.Create<Identifier>("x")->MapTo(x));
+  auto create = std::make_shared<CreateNode>(unwind, node);
+  auto n_y = storage.Create<PropertyLookup>(storage.Create<Identifier>("n")->MapTo(node.symbol),
+                                            storage.GetPropertyIx("y"));
+  auto set_y = std::make_shared<plan::SetProperty>(create, prop_y, n_y, storage.Create<Identifier>("x")->MapTo(x));
+  auto context = MakeContext(storage, symbol_table, &dba);
+  context.parallelism = 4;
+  context.is_profile_query = true;
+  PullAll(EmptyResult(set_y), &context);
+  EXPECT_EQ(context.execution_stats[ExecutionStats::Key::CREATED_NODES], kCount);
+  EXPECT_EQ(context.execution_stats[ExecutionStats::Key::UPDATED_PROPERTIES], kCount);
+  dba.AdvanceCommand();
+
+  SymbolTable scan_symbol_table;
+  auto n = MakeScanAll(storage, scan_symbol_table, "n");
+  auto n_x = storage.Create<PropertyLookup>(storage.Create<Identifier>("n")->MapTo(n.sym_),
+                                            storage.GetPropertyIx("x"));
+  auto n_z = storage.Create<PropertyLookup>(storage.Create<Identifier>("n")->MapTo(n.sym_),
+                                            storage.GetPropertyIx("z"));
+  auto set_z = std::make_shared<plan::SetProperty>(n.op_, prop_z, n_z, n_x);
+  auto scan_context = MakeContext(storage, scan_symbol_table, &dba);
+  scan_context.parallelism = 4;
+  PullAll(EmptyResult(set_z), &scan_context);
+  EXPECT_EQ(scan_context.execution_stats[ExecutionStats::Key::UPDATED_PROPERTIES], kCount);
+  dba.AdvanceCommand();
+
+  std::vector<bool> seen(kCount, false);
+  for (auto vertex : dba.Vertices(memgraph::storage::View::OLD)) {
+    auto value = vertex.GetProperty(memgraph::storage::View::OLD, prop_x);
+    ASSERT_TRUE(value.HasValue());
+    ASSERT_TRUE(value->IsInt());
+    const auto i = value->ValueInt();
+    ASSERT_GE(i, 0);
+    ASSERT_LT(i, kCount);
+    EXPECT_FALSE(seen[i]);
+    seen[i] = true;
+    EXPECT_EQ(*vertex.GetProperty(memgraph::storage::View::OLD, prop_y), memgraph::storage::PropertyValue(i));
+    EXPECT_EQ(*vertex.GetProperty(memgraph::storage::View::OLD, prop_z), memgraph::storage::PropertyValue(i));
+  }
+  EXPECT_EQ(std::count(seen.begin(), seen.end(), true), kCount);
+}
+
 //////////////////////////////////////////////
 ////     FINE GRAINED AUTHORIZATION      /////
 //////////////////////////////////////////////
@@ -13,9 +13,12 @@
 #include "query/frontend/ast/ast.hpp"
 #include "query_plan_common.hpp"
 
+#include <algorithm>
+#include <filesystem>
 #include <iterator>
 #include <memory>
 #include <optional>
+#include <set>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -284,6 +287,94 @@ TYPED_TEST(QueryPlan, StandaloneReturn) {
   EXPECT_EQ(results[0][0].ValueInt(), 42);
 }
 
+TYPED_TEST(QueryPlan, PullBatch) {
+  // Tests that pulling in batches gives the same rows as pulling row by row,
+  // also when the rows don't fit into a single batch.
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+
+  auto prop = dba.NameToProperty("prop");
+  auto edge_type = dba.NameToEdgeType("Edge");
+  std::vector<memgraph::query::VertexAccessor> vertices;
+  for (int i = 0; i < 300; ++i) {
+    vertices.push_back(dba.InsertVertex());
+    ASSERT_TRUE(vertices.back().SetProperty(prop, memgraph::storage::PropertyValue(i)).HasValue());
+  }
+  for (int i = 0; i < 300; ++i) {
+    ASSERT_TRUE(dba.InsertEdge(&vertices[i], &vertices[(i + 1) % 300], edge_type).HasValue());
+    ASSERT_TRUE(dba.InsertEdge(&vertices[i], &vertices[(i + 7) % 300], edge_type).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  SymbolTable symbol_table;
+  auto n = MakeScanAll(this->storage, symbol_table, "n");
+  auto r_m = MakeExpand(this->storage, symbol_table, n.op_, n.sym_, "r", EdgeAtom::Direction::OUT, {}, "m", false,
+                        memgraph::storage::View::OLD);
+  auto *filter_expr = LESS(PROPERTY_LOOKUP(dba, IDENT("m")->MapTo(r_m.node_sym_), prop), LITERAL(150));
+  auto filter = std::make_shared<Filter>(r_m.op_, std::vector<std::shared_ptr<LogicalOperator>>{}, filter_expr);
+
+  auto pull_rows = [&](bool batched) {
+    std::vector<std::pair<int64_t, int64_t>> rows;
+    auto add_row = [&](const Frame &frame) {
+      const auto &from = frame[n.sym_].ValueVertex();
+      const auto &to = frame[r_m.node_sym_].ValueVertex();
+      rows.emplace_back(from.GetProperty(memgraph::storage::View::OLD, prop)->ValueInt(),
+                        to.GetProperty(memgraph::storage::View::OLD, prop)->ValueInt());
+    };
+
+    auto context = MakeContext(this->storage, symbol_table, &dba);
+    Frame frame(symbol_table.max_position());
+    auto cursor = filter->MakeCursor(memgraph::utils::NewDeleteResource());
+    if (batched) {
+      FrameBatch batch(symbol_table.max_position(), FrameBatch::kDefaultCapacity,
+                       memgraph::utils::NewDeleteResource());
+      while (cursor->PullBatch(frame, batch, context)) {
+        EXPECT_FALSE(batch.empty());
+        for (size_t i = 0; i < batch.size(); ++i) add_row(batch[i]);
+      }
+    } else {
+      while (cursor->Pull(frame, context)) add_row(frame);
+    }
+    return rows;
+  };
+
+  auto rows = pull_rows(false);
+  EXPECT_EQ(rows.size(), 300);
+  for (const auto &[from, to] : rows) EXPECT_LT(to, 150);
+  EXPECT_EQ(pull_rows(true), rows);
+}
+
+TYPED_TEST(QueryPlan, ProduceFromBatchKeepsInputSymbols) {
+  // The operators after Produce may read the symbols of its input, e.g. ORDER
+  // BY in `RETURN n.prop AS x ORDER BY n.other`.
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+
+  auto prop = dba.NameToProperty("prop");
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(dba.InsertVertex().SetProperty(prop, memgraph::storage::PropertyValue(i)).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  SymbolTable symbol_table;
+  auto n = MakeScanAll(this->storage, symbol_table, "n");
+  auto output_sym = symbol_table.CreateSymbol("named_expression_1", true);
+  auto output = NEXPR("x", PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), prop))->MapTo(output_sym);
+  auto produce = MakeProduce(n.op_, output);
+
+  auto context = MakeContext(this->storage, symbol_table, &dba);
+  Frame frame(symbol_table.max_position());
+  auto cursor = produce->MakeCursor(memgraph::utils::NewDeleteResource());
+  int count = 0;
+  while (cursor->Pull(frame, context)) {
+    ASSERT_TRUE(frame[n.sym_].IsVertex());
+    EXPECT_EQ(frame[n.sym_].ValueVertex().GetProperty(memgraph::storage::View::OLD, prop)->ValueInt(),
+              frame[output_sym].ValueInt());
+    ++count;
+  }
+  EXPECT_EQ(count, 3);
+}
+
 TYPED_TEST(QueryPlan, NodeFilterLabelsAndProperties) {
   auto storage_dba = this->db->Access();
   memgraph::query::DbAccessor dba(storage_dba.get());
@@ -484,6 +575,71 @@ TYPED_TEST(QueryPlan, CartesianThreeWay) {
   }
 }
 
+TYPED_TEST(QueryPlan, HashJoin) {
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  auto prop = dba.NameToProperty("prop");
+
+  // The vertex without the property doesn't join with anything, the vertices
+  // with 2 join with each other and with themselves.
+  std::vector<memgraph::query::VertexAccessor> vertices;
+  for (const auto &value : {memgraph::storage::PropertyValue(1), memgraph::storage::PropertyValue(2),
+                            memgraph::storage::PropertyValue(2.0), memgraph::storage::PropertyValue()}) {
+    auto vertex = dba.InsertVertex();
+    ASSERT_TRUE(vertex.SetProperty(prop, value).HasValue());
+    vertices.push_back(vertex);
+  }
+  dba.AdvanceCommand();
+
+  SymbolTable symbol_table;
+
+  auto n = MakeScanAll(this->storage, symbol_table, "n");
+  auto m = MakeScanAll(this->storage, symbol_table, "m");
+  auto return_n = NEXPR("n", IDENT("n")->MapTo(n.sym_))->MapTo(symbol_table.CreateSymbol("named_expression_1", true));
+  auto return_m = NEXPR("m", IDENT("m")->MapTo(m.sym_))->MapTo(symbol_table.CreateSymbol("named_expression_2", true));
+
+  std::vector<Symbol> left_symbols{n.sym_};
+  std::vector<Symbol> right_symbols{m.sym_};
+  auto *condition = EQ(PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), prop),
+                       PROPERTY_LOOKUP(dba, IDENT("m")->MapTo(m.sym_), prop));
+  auto hash_join_op = std::make_shared<HashJoin>(n.op_, left_symbols, m.op_, right_symbols, condition);
+
+  auto produce = MakeProduce(hash_join_op, return_n, return_m);
+  auto context = MakeContext(this->storage, symbol_table, &dba);
+  auto results = CollectProduce(*produce, &context);
+  ASSERT_EQ(results.size(), 5);
+  std::multiset<std::pair<int, int>> joined;
+  for (const auto &row : results) {
+    auto left = std::find(vertices.begin(), vertices.end(), row[0].ValueVertex()) - vertices.begin();
+    auto right = std::find(vertices.begin(), vertices.end(), row[1].ValueVertex()) - vertices.begin();
+    joined.emplace(left, right);
+  }
+  EXPECT_EQ(joined, (std::multiset<std::pair<int, int>>{{0, 0}, {1, 1}, {1, 2}, {2, 1}, {2, 2}}));
+}
+
+TYPED_TEST(QueryPlan, HashJoinEmptySet) {
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  auto prop = dba.NameToProperty("prop");
+  SymbolTable symbol_table;
+
+  auto n = MakeScanAll(this->storage, symbol_table, "n");
+  auto m = MakeScanAll(this->storage, symbol_table, "m");
+  auto return_n = NEXPR("n", IDENT("n")->MapTo(n.sym_))->MapTo(symbol_table.CreateSymbol("named_expression_1", true));
+  auto return_m = NEXPR("m", IDENT("m")->MapTo(m.sym_))->MapTo(symbol_table.CreateSymbol("named_expression_2", true));
+
+  std::vector<Symbol> left_symbols{n.sym_};
+  std::vector<Symbol> right_symbols{m.sym_};
+  auto *condition = EQ(PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(n.sym_), prop),
+                       PROPERTY_LOOKUP(dba, IDENT("m")->MapTo(m.sym_), prop));
+  auto hash_join_op = std::make_shared<HashJoin>(n.op_, left_symbols, m.op_, right_symbols, condition);
+
+  auto produce = MakeProduce(hash_join_op, return_n, return_m);
+  auto context = MakeContext(this->storage, symbol_table, &dba);
+  auto results = CollectProduce(*produce, &context);
+  EXPECT_EQ(results.size(), 0);
+}
+
 template <typename StorageType>
 class ExpandFixture : public testing::Test {
  protected:
@@ -1119,6 +1275,48 @@ TYPED_TEST(QueryPlanExpandVariable, EdgeUniquenessTwoVariableExpansions) {
   EXPECT_EQ(test_expand(0, EdgeAtom::Direction::OUT, 2, 2, true), (map_int{{2, 5 * 8}}));
 }
 
+TYPED_TEST(QueryPlanExpandVariable, EdgeUniquenessTwoLongVariableExpansions) {
+  // The paths are long enough for their edges to be compared through a set.
+  // An edge parallel to one of the first layer is added, so paths of these
+  // lengths without common edges exist.
+  auto first_layer = this->dba.Vertices(memgraph::storage::View::OLD, this->labels[0]);
+  auto second_layer = this->dba.Vertices(memgraph::storage::View::OLD, this->labels[1]);
+  auto from = *first_layer.begin();
+  auto to = *second_layer.begin();
+  ASSERT_TRUE(this->dba.InsertEdge(&from, &to, this->dba.NameToEdgeType("edge_type_1")).HasValue());
+  this->dba.AdvanceCommand();
+
+  auto e1 = this->Edge("r1", EdgeAtom::Direction::BOTH);
+  auto first = this->template AddMatch<ExpandVariable>(nullptr, "n1", 0, EdgeAtom::Direction::BOTH, {}, 4, 4, e1, "m1",
+                                                       memgraph::storage::View::OLD);
+  auto e2 = this->Edge("r2", EdgeAtom::Direction::BOTH);
+  auto second = this->template AddMatch<ExpandVariable>(first, "n2", 0, EdgeAtom::Direction::BOTH, {}, 5, 5, e2, "m2",
+                                                        memgraph::storage::View::OLD);
+
+  // Count the pairs of paths without common edges by comparing them directly.
+  int expected = 0;
+  {
+    Frame frame(this->symbol_table.max_position());
+    auto cursor = second->MakeCursor(memgraph::utils::NewDeleteResource());
+    auto context = MakeContext(this->storage, this->symbol_table, &this->dba);
+    while (cursor->Pull(frame, context)) {
+      const auto &path1 = frame[e1].ValueList();
+      const auto &path2 = frame[e2].ValueList();
+      ASSERT_EQ(path1.size(), 4);
+      ASSERT_EQ(path2.size(), 5);
+      const auto has_common_edge = std::any_of(path1.begin(), path1.end(), [&path2](const auto &edge1) {
+        return std::any_of(path2.begin(), path2.end(),
+                           [&edge1](const auto &edge2) { return edge1.ValueEdge() == edge2.ValueEdge(); });
+      });
+      if (!has_common_edge) ++expected;
+    }
+  }
+  ASSERT_GT(expected, 0);
+
+  auto last_op = std::make_shared<EdgeUniquenessFilter>(second, e2, std::vector<Symbol>{e1});
+  EXPECT_EQ(this->GetEdgeListSizes(last_op, e2), (map_int{{5, expected}}));
+}
+
 #ifdef MG_ENTERPRISE
 TYPED_TEST(QueryPlanExpandVariable, FineGrainedEdgeUniquenessTwoVariableExpansions) {
   auto test_expand = [&](int layer, EdgeAtom::Direction direction, std::optional<size_t> lower,
@@ -2235,6 +2433,71 @@ TYPED_TEST(QueryPlanExpandWeightedShortestPath, FineGrainedFiltering) {
 }
 #endif
 
+// Weights read directly from an edge property are expanded with delta-stepping
+// when parallel execution is requested, which must find the same paths.
+TEST(QueryPlanExpandWeightedShortestPathParallel, MatchesSerial) {
+  constexpr int kWidth = 5000;
+  memgraph::storage::InMemoryStorage db;
+  auto storage_dba = db.Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  AstStorage storage;
+  auto prop = PROPERTY_PAIR(dba, "weight");
+  const auto edge_type = dba.NameToEdgeType("edge_type");
+  const auto label = dba.NameToLabel("source");
+  auto source = dba.InsertVertex();
+  ASSERT_TRUE(source.AddLabel(label).HasValue());
+  std::vector<memgraph::query::VertexAccessor> first;
+  for (int i = 0; i < kWidth; ++i) {
+    first.push_back(dba.InsertVertex());
+    auto second = dba.InsertVertex();
+    auto add_edge = [&](auto *from, auto *to, double weight) {
+      auto edge = dba.InsertEdge(from, to, edge_type);
+      ASSERT_TRUE(edge.HasValue());
+      ASSERT_TRUE(edge->SetProperty(prop.second, memgraph::storage::PropertyValue(weight)).HasValue());
+    };
+    add_edge(&source, &first.back(), 1 + i % 7);
+    add_edge(&first.back(), &second, i % 5);
+    if (i > 0) add_edge(&first[i - 1], &first[i], 1);
+  }
+  dba.AdvanceCommand();
+
+  std::vector<std::vector<std::tuple<int64_t, double, size_t>>> results;
+  for (const uint64_t parallelism : {1, 4}) {
+    SymbolTable symbol_table;
+    auto source_sym = symbol_table.CreateSymbol("source", true);
+    auto node_sym = symbol_table.CreateSymbol("node", true);
+    auto edge_list_sym = symbol_table.CreateSymbol("edgelist_", true);
+    auto weight_edge = symbol_table.CreateSymbol("w_edge", true);
+    auto weight_node = symbol_table.CreateSymbol("w_node", true);
+    auto total_weight = symbol_table.CreateSymbol("total_weight", true);
+    auto ident_e = IDENT("e");
+    ident_e->MapTo(weight_edge);
+    auto expand = std::make_shared<ExpandVariable>(
+        std::make_shared<ScanAllByLabel>(nullptr, source_sym, label), source_sym, node_sym, edge_list_sym,
+        EdgeAtom::Type::WEIGHTED_SHORTEST_PATH, EdgeAtom::Direction::OUT, std::vector<memgraph::storage::EdgeTypeId>{},
+        false, nullptr, nullptr, false, ExpansionLambda{symbol_table.CreateSymbol("f_edge", true),
+                                                        symbol_table.CreateSymbol("f_node", true), nullptr},
+        ExpansionLambda{weight_edge, weight_node, PROPERTY_LOOKUP(dba, ident_e, prop)}, total_weight);
+    auto context = MakeContext(storage, symbol_table, &dba);
+    context.parallelism = parallelism;
+    Frame frame(symbol_table.max_position());
+    auto cursor = expand->MakeCursor(memgraph::utils::NewDeleteResource());
+    auto &result = results.emplace_back();
+    double last_weight = 0;
+    while (cursor->Pull(frame, context)) {
+      const auto weight = frame[total_weight].ValueDouble();
+      // The paths from a vertex are found in the order of their weight.
+      EXPECT_GE(weight, last_weight);
+      last_weight = weight;
+      result.emplace_back(frame[node_sym].ValueVertex().Gid().AsInt(), weight,
+                          frame[edge_list_sym].ValueList().size());
+    }
+    std::sort(result.begin(), result.end());
+  }
+  EXPECT_EQ(results[0].size(), 2 * kWidth);
+  EXPECT_EQ(results[0], results[1]);
+}
+
 /** A test fixture for all shortest paths expansion */
 template <typename StorageType>
 class QueryPlanExpandAllShortestPaths : public testing::Test {
@@ -2352,6 +2615,30 @@ class QueryPlanExpandAllShortestPaths : public testing::Test {
     return results;
   }
 
+  // performs an all shortest paths expansion from v[0] which only counts the
+  // paths
+  int64_t CountAllShortest(EdgeAtom::Direction direction, std::optional<int> max_depth) {
+    auto n = MakeScanAll(storage, symbol_table, "n");
+    auto last_op = std::make_shared<Filter>(n.op_, std::vector<std::shared_ptr<LogicalOperator>>{},
+                                            EQ(PROPERTY_LOOKUP(dba, n.node_->identifier_, prop), LITERAL(0)));
+    auto ident_e = IDENT("e");
+    ident_e->MapTo(weight_edge);
+    auto expand = std::make_shared<ExpandVariable>(
+        last_op, n.sym_, symbol_table.CreateSymbol("node", true), symbol_table.CreateSymbol("edgelist_", true),
+        EdgeAtom::Type::ALL_SHORTEST_PATHS, direction, std::vector<memgraph::storage::EdgeTypeId>{}, false, nullptr,
+        max_depth ? LITERAL(max_depth.value()) : nullptr, false, ExpansionLambda{filter_edge, filter_node, nullptr},
+        ExpansionLambda{weight_edge, weight_node, PROPERTY_LOOKUP(dba, ident_e, prop)}, total_weight);
+    auto path_count = symbol_table.CreateSymbol("path_count", true);
+    expand->path_count_symbol_ = path_count;
+
+    Frame frame(symbol_table.max_position());
+    auto cursor = expand->MakeCursor(memgraph::utils::NewDeleteResource());
+    auto context = MakeContext(storage, symbol_table, &dba);
+    int64_t count = 0;
+    while (cursor->Pull(frame, context)) count += frame[path_count].ValueInt();
+    return count;
+  }
+
   template <typename TAccessor>
   auto GetProp(const TAccessor &accessor) {
     return accessor.GetProperty(memgraph::storage::View::OLD, prop.second)->ValueInt();
@@ -2615,6 +2902,24 @@ TYPED_TEST(QueryPlanExpandAllShortestPaths, MultiEdge) {
   EXPECT_EQ(results[5].total_weight, 9);
 }
 
+TYPED_TEST(QueryPlanExpandAllShortestPaths, CountPaths) {
+  // Double the edges 2->-3 and 3->-4 as in MultiEdge, giving 4 paths to v[4].
+  for (const auto &[from, to] : {std::make_pair(2, 3), std::make_pair(3, 4)}) {
+    auto edge = this->dba.InsertEdge(&this->v[from], &this->v[to], this->edge_type);
+    ASSERT_TRUE(edge.HasValue());
+    ASSERT_TRUE(edge->SetProperty(this->prop.second, memgraph::storage::PropertyValue(3)).HasValue());
+  }
+  this->dba.AdvanceCommand();
+
+  for (const auto direction : {EdgeAtom::Direction::OUT, EdgeAtom::Direction::IN, EdgeAtom::Direction::BOTH}) {
+    for (const auto max_depth : {std::optional<int>{}, std::optional<int>{1}, std::optional<int>{2}}) {
+      const auto paths = this->ExpandAllShortest(direction, max_depth, nullptr);
+      EXPECT_EQ(this->CountAllShortest(direction, max_depth), static_cast<int64_t>(paths.size()));
+    }
+  }
+  EXPECT_EQ(this->CountAllShortest(EdgeAtom::Direction::OUT, std::nullopt), 8);
+}
+
 #ifdef MG_ENTERPRISE
 TYPED_TEST(QueryPlanExpandAllShortestPaths, BasicWithFineGrainedFiltering) {
   // All edge_types and labels allowed
@@ -2869,6 +3174,110 @@ TYPED_TEST(QueryPlan, ExpandExistingNode) {
   test_existing(false, 2);
 }
 
+TYPED_TEST(QueryPlan, ExpandExistingNodeFromSmallerEnd) {
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+
+  // make a star with a hub connected to each leaf with one edge of the
+  // expanded type, one of another type and one in the reverse direction, so
+  // the hub has many more edges than any leaf
+  const int kLeaves = 200;
+  auto hub_label = dba.NameToLabel("hub");
+  auto leaf_label = dba.NameToLabel("leaf");
+  auto edge_type = dba.NameToEdgeType("Edge");
+  auto other_type = dba.NameToEdgeType("Other");
+  auto hub = dba.InsertVertex();
+  ASSERT_TRUE(hub.AddLabel(hub_label).HasValue());
+  for (int i = 0; i < kLeaves; ++i) {
+    auto leaf = dba.InsertVertex();
+    ASSERT_TRUE(leaf.AddLabel(leaf_label).HasValue());
+    ASSERT_TRUE(dba.InsertEdge(&hub, &leaf, edge_type).HasValue());
+    ASSERT_TRUE(dba.InsertEdge(&hub, &leaf, other_type).HasValue());
+    ASSERT_TRUE(dba.InsertEdge(&leaf, &hub, edge_type).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  SymbolTable symbol_table;
+
+  // MATCH (h:hub), (l:leaf), (x)-[r:Edge]->(y) where x and y are h and l in
+  // either order, so the edges are read from the hub in one case
+  auto test_expand = [&](bool from_hub, EdgeAtom::Direction direction) {
+    auto h = MakeScanAllByLabel(this->storage, symbol_table, "h", hub_label);
+    auto l = MakeScanAllByLabel(this->storage, symbol_table, "l", leaf_label, h.op_);
+    auto input_sym = from_hub ? h.sym_ : l.sym_;
+    auto existing_sym = from_hub ? l.sym_ : h.sym_;
+    auto r_sym = symbol_table.CreateSymbol("r", true);
+    auto expand = std::make_shared<Expand>(l.op_, input_sym, existing_sym, r_sym, direction,
+                                           std::vector<memgraph::storage::EdgeTypeId>{edge_type}, true,
+                                           memgraph::storage::View::OLD);
+    auto context = MakeContext(this->storage, symbol_table, &dba);
+    return PullAll(*expand, &context);
+  };
+
+  EXPECT_EQ(test_expand(true, EdgeAtom::Direction::OUT), kLeaves);
+  EXPECT_EQ(test_expand(false, EdgeAtom::Direction::OUT), kLeaves);
+  EXPECT_EQ(test_expand(true, EdgeAtom::Direction::IN), kLeaves);
+  EXPECT_EQ(test_expand(false, EdgeAtom::Direction::IN), kLeaves);
+  EXPECT_EQ(test_expand(true, EdgeAtom::Direction::BOTH), 2 * kLeaves);
+  EXPECT_EQ(test_expand(false, EdgeAtom::Direction::BOTH), 2 * kLeaves);
+}
+
+TYPED_TEST(QueryPlan, IntersectExpand) {
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+
+  // make a hub with an edge to each leaf, a cycle through the leaves and an
+  // edge back to the hub from every other leaf, so that the hub with some of
+  // the pairs of consecutive leaves forms a triangle
+  const int kLeaves = 200;
+  auto edge_type = dba.NameToEdgeType("Edge");
+  auto hub = dba.InsertVertex();
+  std::vector<memgraph::query::VertexAccessor> leaves;
+  for (int i = 0; i < kLeaves; ++i) leaves.push_back(dba.InsertVertex());
+  for (int i = 0; i < kLeaves; ++i) {
+    ASSERT_TRUE(dba.InsertEdge(&hub, &leaves[i], edge_type).HasValue());
+    ASSERT_TRUE(dba.InsertEdge(&leaves[i], &leaves[(i + 1) % kLeaves], edge_type).HasValue());
+    if (i % 2 == 0) ASSERT_TRUE(dba.InsertEdge(&leaves[i], &hub, edge_type).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  SymbolTable symbol_table;
+
+  // MATCH (a)-[r]-(b)-[e]-(c)-[f]-(a) with c either expanded from b and then
+  // checked against a, or found by intersecting the edges of a and b
+  auto count_triangles = [&](bool intersect, EdgeAtom::Direction direction) {
+    auto a = MakeScanAll(this->storage, symbol_table, "a");
+    auto r_b = MakeExpand(this->storage, symbol_table, a.op_, a.sym_, "r", direction, {}, "b", false,
+                          memgraph::storage::View::OLD);
+    auto e_sym = symbol_table.CreateSymbol("e", true);
+    auto f_sym = symbol_table.CreateSymbol("f", true);
+    auto c_sym = symbol_table.CreateSymbol("c", true);
+    std::shared_ptr<LogicalOperator> last_op;
+    if (intersect) {
+      // f goes from c to a, so from a it goes in the reverse direction
+      auto reverse = direction == EdgeAtom::Direction::OUT ? EdgeAtom::Direction::IN : direction;
+      std::vector<IntersectEdge> edges{{r_b.node_sym_, e_sym, direction, {}}, {a.sym_, f_sym, reverse, {}}};
+      last_op = std::make_shared<IntersectExpand>(r_b.op_, c_sym, edges, memgraph::storage::View::OLD);
+    } else {
+      auto e_c = std::make_shared<Expand>(r_b.op_, r_b.node_sym_, c_sym, e_sym, direction,
+                                          std::vector<memgraph::storage::EdgeTypeId>{}, false,
+                                          memgraph::storage::View::OLD);
+      last_op = std::make_shared<Expand>(e_c, c_sym, a.sym_, f_sym, direction,
+                                         std::vector<memgraph::storage::EdgeTypeId>{}, true,
+                                         memgraph::storage::View::OLD);
+    }
+    last_op = std::make_shared<EdgeUniquenessFilter>(last_op, e_sym, std::vector<Symbol>{r_b.edge_sym_});
+    last_op = std::make_shared<EdgeUniquenessFilter>(last_op, f_sym, std::vector<Symbol>{r_b.edge_sym_, e_sym});
+    auto context = MakeContext(this->storage, symbol_table, &dba);
+    return PullAll(*last_op, &context);
+  };
+
+  // Each triangle is matched once from each of its nodes.
+  EXPECT_EQ(count_triangles(true, EdgeAtom::Direction::OUT), 3 * kLeaves / 2);
+  EXPECT_EQ(count_triangles(false, EdgeAtom::Direction::OUT), 3 * kLeaves / 2);
+  EXPECT_EQ(count_triangles(true, EdgeAtom::Direction::BOTH), count_triangles(false, EdgeAtom::Direction::BOTH));
+}
+
 TYPED_TEST(QueryPlan, ExpandBothCycleEdgeCase) {
   // we're testing that expanding on BOTH
   // does only one expansion for a cycle
@@ -3079,6 +3488,38 @@ TYPED_TEST(QueryPlan, Distinct) {
       {TypedValue(3), TypedValue("two"), TypedValue(), TypedValue(true), TypedValue(false), TypedValue("TWO")}, false);
 }
 
+TYPED_TEST(QueryPlan, DistinctSpill) {
+  // test queries like
+  // UNWIND [0, 1, ..., 299, 0, 1, ...] AS x RETURN DISTINCT x
+  // with the seen rows spilled to disk
+
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  SymbolTable symbol_table;
+
+  std::vector<TypedValue> input;
+  for (int i = 0; i < 2000; ++i) input.emplace_back(i % 300);
+  auto x = symbol_table.CreateSymbol("x", true);
+  auto unwind = std::make_shared<plan::Unwind>(nullptr, LITERAL(TypedValue(input)), x);
+  auto distinct = std::make_shared<plan::Distinct>(unwind, std::vector<Symbol>{x});
+  auto x_ne = NEXPR("x", IDENT("x")->MapTo(x))->MapTo(symbol_table.CreateSymbol("x_ne", true));
+  auto produce = MakeProduce(distinct, x_ne);
+
+  const auto spill_directory = std::filesystem::temp_directory_path() / "MG_test_unit_query_plan_distinct_spill";
+  auto context = MakeContext(this->storage, symbol_table, &dba);
+  context.spill_memory_limit = 1024;
+  context.spill_directory = spill_directory;
+  auto results = CollectProduce(*produce, &context);
+  ASSERT_EQ(results.size(), 300);
+  std::set<int64_t> values;
+  for (const auto &row : results) values.insert(row[0].ValueInt());
+  EXPECT_EQ(values.size(), 300);
+  EXPECT_EQ(*values.begin(), 0);
+  EXPECT_EQ(*values.rbegin(), 299);
+  EXPECT_TRUE(std::filesystem::is_empty(spill_directory));
+  std::filesystem::remove_all(spill_directory);
+}
+
 TYPED_TEST(QueryPlan, ScanAllByLabel) {
   auto label = this->db->NameToLabel("label");
   [[maybe_unused]] auto _ = this->db->CreateIndex(label);
@@ -3105,6 +3546,42 @@ TYPED_TEST(QueryPlan, ScanAllByLabel) {
   EXPECT_EQ(result_vertex.Gid(), labeled_vertex.Gid());
 }
 
+#ifdef MG_ENTERPRISE
+TYPED_TEST(QueryPlan, ScanAllByLabelWithLabelFiltering) {
+  memgraph::license::global_license_checker.EnableTesting();
+  auto label = this->db->NameToLabel("label");
+  auto other_label = this->db->NameToLabel("other_label");
+  [[maybe_unused]] auto _ = this->db->CreateIndex(label);
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  auto vertex = dba.InsertVertex();
+  ASSERT_TRUE(vertex.AddLabel(label).HasValue());
+  auto other_vertex = dba.InsertVertex();
+  ASSERT_TRUE(other_vertex.AddLabel(label).HasValue());
+  ASSERT_TRUE(other_vertex.AddLabel(other_label).HasValue());
+  dba.AdvanceCommand();
+
+  auto test_scan = [&](const memgraph::auth::User &user) {
+    SymbolTable symbol_table;
+    auto scan_all_by_label = MakeScanAllByLabel(this->storage, symbol_table, "n", label);
+    auto output = NEXPR("n", IDENT("n")->MapTo(scan_all_by_label.sym_))->MapTo(symbol_table.CreateSymbol("n", true));
+    auto produce = MakeProduce(scan_all_by_label.op_, output);
+    memgraph::glue::FineGrainedAuthChecker auth_checker{user, &dba};
+    auto context = MakeContextWithFineGrainedChecker(this->storage, symbol_table, &dba, &auth_checker);
+    return PullAll(*produce, &context);
+  };
+
+  memgraph::auth::User user{"test"};
+  user.fine_grained_access_handler().label_permissions().Grant("*", memgraph::auth::FineGrainedPermission::READ);
+  EXPECT_EQ(2, test_scan(user));
+  user.fine_grained_access_handler().label_permissions().Grant("other_label",
+                                                               memgraph::auth::FineGrainedPermission::NOTHING);
+  EXPECT_EQ(1, test_scan(user));
+  user.fine_grained_access_handler().label_permissions().Grant("label", memgraph::auth::FineGrainedPermission::NOTHING);
+  EXPECT_EQ(0, test_scan(user));
+}
+#endif
+
 TYPED_TEST(QueryPlan, ScanAllByLabelProperty) {
   // Add 5 vertices with same label, but with different property values.
   auto label = this->db->NameToLabel("label");
@@ -3266,6 +3743,66 @@ TYPED_TEST(QueryPlan, ScanAllByLabelPropertyEqualityNoError) {
   EXPECT_TRUE(eq(value, TypedValue(42)));
 }
 
+TYPED_TEST(QueryPlan, ScanAllByLabelPropertyValues) {
+  auto label = this->db->NameToLabel("label");
+  auto prop = this->db->NameToProperty("prop");
+  {
+    auto storage_dba = this->db->Access();
+    memgraph::query::DbAccessor dba(storage_dba.get());
+    for (int i = 0; i < 5; ++i) {
+      auto vertex = dba.InsertVertex();
+      ASSERT_TRUE(vertex.AddLabel(label).HasValue());
+      ASSERT_TRUE(vertex.SetProperty(prop, memgraph::storage::PropertyValue(i)).HasValue());
+    }
+    ASSERT_FALSE(dba.Commit().HasError());
+  }
+  [[maybe_unused]] auto _ = this->db->CreateIndex(label, prop);
+
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  // MATCH (n :label) WHERE n.prop IN [3, 1, 1, null, 10]
+  SymbolTable symbol_table;
+  auto scan_all =
+      MakeScanAllByLabelPropertyValues(this->storage, symbol_table, "n", label, prop, "prop",
+                                       LIST(LITERAL(3), LITERAL(1), LITERAL(1), LITERAL(TypedValue()), LITERAL(10)));
+  // RETURN n.prop
+  auto output = NEXPR("n.prop", PROPERTY_LOOKUP(dba, IDENT("n")->MapTo(scan_all.sym_), prop))
+                    ->MapTo(symbol_table.CreateSymbol("n.prop", true));
+  auto produce = MakeProduce(scan_all.op_, output);
+  auto context = MakeContext(this->storage, symbol_table, &dba);
+  auto results = CollectProduce(*produce, &context);
+  std::vector<int64_t> values;
+  for (const auto &row : results) {
+    ASSERT_EQ(row.size(), 1);
+    values.push_back(row[0].ValueInt());
+  }
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ(values, (std::vector<int64_t>{1, 3}));
+}
+
+TYPED_TEST(QueryPlan, ScanAllByLabelPropertyValuesError) {
+  auto label = this->db->NameToLabel("label");
+  auto prop = this->db->NameToProperty("prop");
+  [[maybe_unused]] auto _ = this->db->CreateIndex(label, prop);
+
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  SymbolTable symbol_table;
+  {
+    // The values aren't a list
+    auto scan_all = MakeScanAllByLabelPropertyValues(this->storage, symbol_table, "n", label, prop, "prop", LITERAL(1));
+    auto context = MakeContext(this->storage, symbol_table, &dba);
+    EXPECT_THROW(PullAll(*scan_all.op_, &context), QueryRuntimeException);
+  }
+  {
+    // Null produces no vertices
+    auto scan_all =
+        MakeScanAllByLabelPropertyValues(this->storage, symbol_table, "n", label, prop, "prop", LITERAL(TypedValue()));
+    auto context = MakeContext(this->storage, symbol_table, &dba);
+    EXPECT_EQ(PullAll(*scan_all.op_, &context), 0);
+  }
+}
+
 TYPED_TEST(QueryPlan, ScanAllByLabelPropertyValueError) {
   auto label = this->db->NameToLabel("label");
   auto prop = this->db->NameToProperty("prop");
@@ -20,6 +20,7 @@
 #include "storage/v2/disk/storage.hpp"
 #include "storage/v2/inmemory/storage.hpp"
 #include "test_utils.hpp"
+#include "utils/on_scope_exit.hpp"
 
 template <typename StorageType>
 class PyModule : public testing::Test {
@@ -264,6 +265,68 @@ TYPED_TEST(PyModule, PyPath) {
   ASSERT_FALSE(dba.Commit().HasError());
 }
 
+TYPED_TEST(PyModule, PyGraphProjection) {
+  std::vector<int64_t> vertex_ids;
+  {
+    auto dba = this->db->Access();
+    auto v1 = dba->CreateVertex();
+    auto v2 = dba->CreateVertex();
+    auto v3 = dba->CreateVertex();
+    for (const auto *vertex : {&v1, &v2, &v3}) vertex_ids.push_back(vertex->Gid().AsInt());
+    auto e1 = dba->CreateEdge(&v1, &v2, dba->NameToEdgeType("type"));
+    ASSERT_TRUE(e1.HasValue());
+    ASSERT_TRUE(e1->SetProperty(dba->NameToProperty("weight"), memgraph::storage::PropertyValue(2.5)).HasValue());
+    ASSERT_TRUE(dba->CreateEdge(&v3, &v1, dba->NameToEdgeType("type")).HasValue());
+    ASSERT_FALSE(dba->Commit().HasError());
+  }
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  mgp_memory memory{memgraph::utils::NewDeleteResource()};
+  mgp_graph graph{&dba, memgraph::storage::View::OLD, nullptr};
+  auto gil = memgraph::py::EnsureGIL();
+  memgraph::py::Object py_graph(memgraph::query::procedure::MakePyGraph(&graph, &memory));
+  ASSERT_TRUE(py_graph);
+  memgraph::py::Object no_names(PyTuple_New(0));
+  memgraph::py::Object weight_property(PyUnicode_FromString("weight"));
+  memgraph::py::Object default_weight(PyFloat_FromDouble(1.0));
+  memgraph::py::Object py_projection(
+      py_graph.CallMethod("project", no_names, no_names, weight_property, default_weight));
+  ASSERT_TRUE(py_projection);
+  AssertPickleAndCopyAreNotSupported(py_projection.Ptr());
+  {
+    memgraph::py::Object unweighted(py_graph.CallMethod("project", no_names, no_names, Py_None, default_weight));
+    ASSERT_TRUE(unweighted);
+    EXPECT_EQ(unweighted.CallMethod("weights").Ptr(), Py_None);
+  }
+  // The projection doesn't depend on the graph, which is invalidated after
+  // the procedure call.
+  ASSERT_TRUE(py_graph.CallMethod("invalidate"));
+
+  auto check_array = [&py_projection](const char *method, const char *format, const auto &expected) {
+    using TValue = std::decay_t<decltype(expected.front())>;
+    memgraph::py::Object memory_view(py_projection.CallMethod(method));
+    ASSERT_TRUE(memory_view);
+    ASSERT_TRUE(PyMemoryView_Check(memory_view.Ptr()));
+    Py_buffer buffer;
+    // The arrays can't be written to.
+    ASSERT_NE(PyObject_GetBuffer(memory_view.Ptr(), &buffer, PyBUF_WRITABLE), 0);
+    ASSERT_TRUE(memgraph::py::FetchError());
+    ASSERT_EQ(PyObject_GetBuffer(memory_view.Ptr(), &buffer, PyBUF_RECORDS_RO), 0);
+    memgraph::utils::OnScopeExit release([&buffer] { PyBuffer_Release(&buffer); });
+    EXPECT_EQ(std::string(buffer.format), format);
+    EXPECT_EQ(buffer.itemsize, sizeof(TValue));
+    ASSERT_EQ(buffer.ndim, 1);
+    ASSERT_EQ(buffer.shape[0], expected.size());
+    const auto *values = static_cast<const TValue *>(buffer.buf);
+    EXPECT_EQ(std::vector<TValue>(values, values + expected.size()), expected);
+  };
+  check_array("vertex_ids", "q", vertex_ids);
+  check_array("offsets", "Q", std::vector<uint64_t>{0, 1, 1, 2});
+  check_array("targets", "Q", std::vector<uint64_t>{1, 0});
+  check_array("weights", "d", std::vector<double>{2.5, 1.0});
+  ASSERT_FALSE(dba.Commit().HasError());
+}
+
 TYPED_TEST(PyModule, PyObjectToMgpValue) {
   mgp_memory memory{memgraph::utils::NewDeleteResource()};
   auto gil = memgraph::py::EnsureGIL();
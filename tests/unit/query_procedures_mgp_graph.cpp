@@ -10,9 +10,13 @@
 // licenses/APL.txt.
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <iterator>
 #include <list>
 #include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
 #include <gmock/gmock.h>
@@ -23,6 +27,7 @@
 #include "query/db_accessor.hpp"
 #include "query/plan/operator.hpp"
 #include "query/procedure/mg_procedure_impl.hpp"
+#include "query/procedure/procedure_stats.hpp"
 #include "storage/v2/disk/storage.hpp"
 #include "storage/v2/id_types.hpp"
 #include "storage/v2/inmemory/storage.hpp"
@@ -77,11 +82,20 @@ struct MgpValueDeleter {
   }
 };
 
+struct MgpGraphProjectionDeleter {
+  void operator()(mgp_graph_projection *projection) {
+    if (projection != nullptr) {
+      mgp_graph_projection_destroy(projection);
+    }
+  }
+};
+
 using MgpEdgePtr = std::unique_ptr<mgp_edge, MgpEdgeDeleter>;
 using MgpEdgesIteratorPtr = std::unique_ptr<mgp_edges_iterator, MgpEdgesIteratorDeleter>;
 using MgpVertexPtr = std::unique_ptr<mgp_vertex, MgpVertexDeleter>;
 using MgpVerticesIteratorPtr = std::unique_ptr<mgp_vertices_iterator, MgpVerticesIteratorDeleter>;
 using MgpValuePtr = std::unique_ptr<mgp_value, MgpValueDeleter>;
+using MgpGraphProjectionPtr = std::unique_ptr<mgp_graph_projection, MgpGraphProjectionDeleter>;
 
 template <typename TMaybeIterable>
 size_t CountMaybeIterables(TMaybeIterable &&maybe_iterable) {
@@ -613,6 +627,281 @@ TYPED_TEST(MgpGraphTest, EdgesIterator) {
   }
 }
 
+TYPED_TEST(MgpGraphTest, BatchIteration) {
+  std::vector<memgraph::storage::Gid> vertex_ids;
+  {
+    auto accessor = this->CreateDbAccessor(memgraph::storage::IsolationLevel::SNAPSHOT_ISOLATION);
+    const auto property = accessor.NameToProperty("x");
+    for (int64_t i = 0; i < 5; ++i) {
+      auto vertex = accessor.InsertVertex();
+      if (i != 3) ASSERT_TRUE(vertex.SetProperty(property, memgraph::storage::PropertyValue(i)).HasValue());
+      vertex_ids.push_back(vertex.Gid());
+    }
+    auto from = accessor.FindVertex(vertex_ids[0], memgraph::storage::View::NEW);
+    for (size_t i = 1; i < vertex_ids.size(); ++i) {
+      auto to = accessor.FindVertex(vertex_ids[i], memgraph::storage::View::NEW);
+      ASSERT_TRUE(accessor.InsertEdge(&*from, &*to, accessor.NameToEdgeType(i % 2 ? "ODD" : "EVEN")).HasValue());
+    }
+    ASSERT_FALSE(accessor.Commit().HasError());
+  }
+  mgp_graph graph = this->CreateGraph(memgraph::storage::View::OLD);
+
+  std::vector<mgp_vertex_id> ids(5);
+  {
+    MgpVerticesIteratorPtr vertices_iter{
+        EXPECT_MGP_NO_ERROR(mgp_vertices_iterator *, mgp_graph_iter_vertices, &graph, &this->memory)};
+    EXPECT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_vertices_iterator_next_batch, vertices_iter.get(), ids.data(), 2), 2);
+    // The vertex after the batch is the current vertex of the iterator.
+    auto *current = EXPECT_MGP_NO_ERROR(mgp_vertex *, mgp_vertices_iterator_get, vertices_iter.get());
+    ASSERT_NE(current, nullptr);
+    const auto current_id = EXPECT_MGP_NO_ERROR(mgp_vertex_id, mgp_vertex_get_id, current).as_int;
+    EXPECT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_vertices_iterator_next_batch, vertices_iter.get(), ids.data() + 2, 5),
+              3);
+    EXPECT_EQ(EXPECT_MGP_NO_ERROR(mgp_vertex *, mgp_vertices_iterator_get, vertices_iter.get()), nullptr);
+    EXPECT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_vertices_iterator_next_batch, vertices_iter.get(), ids.data(), 5), 0);
+    EXPECT_EQ(ids[2].as_int, current_id);
+    std::vector<int64_t> returned_ids;
+    for (const auto &id : ids) returned_ids.push_back(id.as_int);
+    std::sort(returned_ids.begin(), returned_ids.end());
+    std::vector<int64_t> expected_ids;
+    for (const auto &gid : vertex_ids) expected_ids.push_back(gid.AsInt());
+    EXPECT_EQ(returned_ids, expected_ids);
+  }
+  {
+    MgpVertexPtr from{EXPECT_MGP_NO_ERROR(mgp_vertex *, mgp_graph_get_vertex_by_id, &graph,
+                                          mgp_vertex_id{vertex_ids[0].AsInt()}, &this->memory)};
+    std::vector<mgp_edge_id> edge_ids(2);
+    std::vector<mgp_vertex_id> neighbor_ids(2);
+    std::vector<mgp_edge_type> types(2);
+    size_t count = 0;
+    EXPECT_EQ(mgp_vertex_out_edges_batch(from.get(), edge_ids.data(), neighbor_ids.data(), types.data(), 2, &count),
+              mgp_error::MGP_ERROR_INSUFFICIENT_BUFFER);
+    EXPECT_EQ(count, 4);
+    edge_ids.resize(count);
+    neighbor_ids.resize(count);
+    types.resize(count);
+    EXPECT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_vertex_out_edges_batch, from.get(), edge_ids.data(), neighbor_ids.data(),
+                                  types.data(), count),
+              4);
+    std::set<std::pair<int64_t, std::string>> neighbors;
+    for (size_t i = 0; i < count; ++i) neighbors.emplace(neighbor_ids[i].as_int, types[i].name);
+    EXPECT_EQ(neighbors, (std::set<std::pair<int64_t, std::string>>{{vertex_ids[1].AsInt(), "ODD"},
+                                                                    {vertex_ids[2].AsInt(), "EVEN"},
+                                                                    {vertex_ids[3].AsInt(), "ODD"},
+                                                                    {vertex_ids[4].AsInt(), "EVEN"}}));
+    EXPECT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_vertex_in_edges_batch, from.get(), nullptr, nullptr, nullptr, 0), 0);
+
+    MgpVertexPtr to{EXPECT_MGP_NO_ERROR(mgp_vertex *, mgp_graph_get_vertex_by_id, &graph,
+                                        mgp_vertex_id{vertex_ids[1].AsInt()}, &this->memory)};
+    EXPECT_EQ(
+        EXPECT_MGP_NO_ERROR(size_t, mgp_vertex_in_edges_batch, to.get(), nullptr, neighbor_ids.data(), nullptr, 1), 1);
+    EXPECT_EQ(neighbor_ids[0].as_int, vertex_ids[0].AsInt());
+  }
+  {
+    for (size_t i = 0; i < ids.size(); ++i) ids[i] = mgp_vertex_id{vertex_ids[i].AsInt()};
+    std::vector<mgp_value *> values(ids.size());
+    EXPECT_SUCCESS(
+        mgp_graph_get_vertices_property(&graph, ids.data(), ids.size(), "x", &this->memory, values.data()));
+    for (size_t i = 0; i < values.size(); ++i) {
+      MgpValuePtr value{values[i]};
+      if (i == 3) {
+        EXPECT_NE(EXPECT_MGP_NO_ERROR(int, mgp_value_is_null, value.get()), 0);
+      } else {
+        EXPECT_EQ(EXPECT_MGP_NO_ERROR(int64_t, mgp_value_get_int, value.get()), static_cast<int64_t>(i));
+      }
+    }
+    const mgp_vertex_id missing{vertex_ids.back().AsInt() + 1};
+    EXPECT_EQ(mgp_graph_get_vertices_property(&graph, &missing, 1, "x", &this->memory, values.data()),
+              mgp_error::MGP_ERROR_OUT_OF_RANGE);
+  }
+}
+
+TYPED_TEST(MgpGraphTest, ParallelForVertices) {
+  constexpr int64_t kVertexCount = 1000;
+  std::vector<int64_t> expected_ids;
+  {
+    auto accessor = this->CreateDbAccessor(memgraph::storage::IsolationLevel::SNAPSHOT_ISOLATION);
+    for (int64_t i = 0; i < kVertexCount; ++i) expected_ids.push_back(accessor.InsertVertex().Gid().AsInt());
+    ASSERT_FALSE(accessor.Commit().HasError());
+  }
+  mgp_graph graph = this->CreateGraph(memgraph::storage::View::NEW);
+  ASSERT_NE(EXPECT_MGP_NO_ERROR(int, mgp_graph_is_mutable, &graph), 0);
+
+  constexpr size_t kWorkers = 4;
+  struct Visited {
+    std::array<std::vector<int64_t>, kWorkers> ids;
+    std::atomic<bool> mutable_graph{false};
+    std::atomic<bool> invalid_worker{false};
+  } visited;
+  auto callback = [](mgp_vertices_iterator *vertices, mgp_graph *worker_graph, mgp_memory * /*memory*/,
+                     size_t worker_id, void *data) {
+    auto &visited = *static_cast<Visited *>(data);
+    int is_mutable = 0;
+    if (mgp_graph_is_mutable(worker_graph, &is_mutable) != mgp_error::MGP_ERROR_NO_ERROR || is_mutable) {
+      visited.mutable_graph = true;
+    }
+    if (worker_id >= kWorkers) {
+      visited.invalid_worker = true;
+      return;
+    }
+    mgp_vertex *vertex = nullptr;
+    mgp_vertices_iterator_get(vertices, &vertex);
+    while (vertex) {
+      mgp_vertex_id id{};
+      mgp_vertex_get_id(vertex, &id);
+      visited.ids[worker_id].push_back(id.as_int);
+      mgp_vertices_iterator_next(vertices, &vertex);
+    }
+  };
+  EXPECT_EQ(mgp_graph_parallel_for_vertices(&graph, kWorkers, callback, &visited, &this->memory),
+            mgp_error::MGP_ERROR_NO_ERROR);
+  EXPECT_FALSE(visited.mutable_graph);
+  EXPECT_FALSE(visited.invalid_worker);
+  std::vector<int64_t> visited_ids;
+  for (const auto &ids : visited.ids) visited_ids.insert(visited_ids.end(), ids.begin(), ids.end());
+  std::sort(visited_ids.begin(), visited_ids.end());
+  EXPECT_EQ(visited_ids, expected_ids);
+  // The graph of the procedure stays mutable.
+  EXPECT_NE(EXPECT_MGP_NO_ERROR(int, mgp_graph_is_mutable, &graph), 0);
+
+  auto throwing_callback = [](mgp_vertices_iterator * /*vertices*/, mgp_graph * /*graph*/, mgp_memory * /*memory*/,
+                              size_t /*worker_id*/, void * /*data*/) { throw std::bad_alloc(); };
+  EXPECT_EQ(mgp_graph_parallel_for_vertices(&graph, kWorkers, throwing_callback, nullptr, &this->memory),
+            mgp_error::MGP_ERROR_UNABLE_TO_ALLOCATE);
+}
+
+TYPED_TEST(MgpGraphTest, GraphAccessCounters) {
+  const auto vertex_ids = this->CreateEdge();
+  mgp_graph graph = this->CreateGraph(memgraph::storage::View::NEW);
+  memgraph::query::procedure::GraphAccessCounters counters;
+  graph.access_counters = &counters;
+
+  MgpEdgePtr edge;
+  this->GetFirstOutEdge(graph, vertex_ids[0], edge);
+  EXPECT_EQ(counters.vertices, 1);
+  EXPECT_EQ(counters.edges, 1);
+
+  MgpVerticesIteratorPtr vertices_iter{
+      EXPECT_MGP_NO_ERROR(mgp_vertices_iterator *, mgp_graph_iter_vertices, &graph, &this->memory)};
+  ASSERT_NE(vertices_iter, nullptr);
+  while (EXPECT_MGP_NO_ERROR(mgp_vertex *, mgp_vertices_iterator_next, vertices_iter.get())) {
+  }
+  EXPECT_EQ(counters.vertices, 3);
+  EXPECT_EQ(counters.edges, 1);
+}
+
+TEST(ProcedureStats, RecordCalls) {
+  memgraph::query::procedure::ProcedureStats stats;
+  EXPECT_TRUE(stats.GetInfo().empty());
+  stats.Record("module.b", {.wall_time_us = 10, .cpu_time_us = 5, .allocated_bytes = 100, .vertices = 2, .edges = 1});
+  stats.Record("module.a", {.wall_time_us = 1, .failed = true});
+  stats.Record("module.b", {.wall_time_us = 30, .cpu_time_us = 15, .allocated_bytes = 50, .vertices = 3});
+
+  const auto info = stats.GetInfo();
+  ASSERT_EQ(info.size(), 2);
+  EXPECT_EQ(info[0].name, "module.a");
+  EXPECT_EQ(info[0].calls, 1);
+  EXPECT_EQ(info[0].failed_calls, 1);
+  EXPECT_EQ(info[1].name, "module.b");
+  EXPECT_EQ(info[1].calls, 2);
+  EXPECT_EQ(info[1].failed_calls, 0);
+  EXPECT_EQ(info[1].wall_time_us, 40);
+  EXPECT_EQ(info[1].cpu_time_us, 20);
+  EXPECT_EQ(info[1].allocated_bytes, 150);
+  EXPECT_EQ(info[1].vertices, 5);
+  EXPECT_EQ(info[1].edges, 1);
+  ASSERT_EQ(info[1].wall_time_percentiles.size(), 3);
+  EXPECT_EQ(info[1].wall_time_percentiles[0].first, 50);
+}
+
+TYPED_TEST(MgpGraphTest, GraphProjection) {
+  std::vector<memgraph::storage::Gid> vertex_ids;
+  {
+    auto accessor = this->CreateDbAccessor(memgraph::storage::IsolationLevel::SNAPSHOT_ISOLATION);
+    for (const auto *label : {"A", "A", "B", ""}) {
+      auto vertex = accessor.InsertVertex();
+      if (*label != '\0') ASSERT_TRUE(vertex.AddLabel(accessor.NameToLabel(label)).HasValue());
+      vertex_ids.push_back(vertex.Gid());
+    }
+    const auto weight = accessor.NameToProperty("w");
+    auto create_edge = [&](size_t from, size_t to, const char *type,
+                           std::optional<memgraph::storage::PropertyValue> value) {
+      auto from_vertex = accessor.FindVertex(vertex_ids[from], memgraph::storage::View::NEW);
+      auto to_vertex = accessor.FindVertex(vertex_ids[to], memgraph::storage::View::NEW);
+      auto edge = accessor.InsertEdge(&*from_vertex, &*to_vertex, accessor.NameToEdgeType(type));
+      ASSERT_TRUE(edge.HasValue());
+      if (value) ASSERT_TRUE(edge->SetProperty(weight, *value).HasValue());
+    };
+    create_edge(0, 1, "T", memgraph::storage::PropertyValue(2));
+    create_edge(0, 2, "T", memgraph::storage::PropertyValue(1.5));
+    create_edge(1, 0, "T", std::nullopt);
+    create_edge(1, 0, "U", memgraph::storage::PropertyValue(3));
+    create_edge(0, 3, "T", memgraph::storage::PropertyValue(4));
+    ASSERT_FALSE(accessor.Commit().HasError());
+  }
+  mgp_graph graph = this->CreateGraph(memgraph::storage::View::OLD);
+
+  const std::array<const char *, 2> labels{"A", "B"};
+  const std::array<const char *, 1> types{"T"};
+  MgpGraphProjectionPtr projection{EXPECT_MGP_NO_ERROR(mgp_graph_projection *, mgp_graph_project, &graph,
+                                                       labels.data(), labels.size(), types.data(), types.size(), "w",
+                                                       0.5, &this->memory)};
+  ASSERT_NE(projection, nullptr);
+  ASSERT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_graph_projection_vertex_count, projection.get()), 3);
+  ASSERT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_graph_projection_edge_count, projection.get()), 3);
+  const auto *ids = EXPECT_MGP_NO_ERROR(const mgp_vertex_id *, mgp_graph_projection_vertex_ids, projection.get());
+  const auto *offsets = EXPECT_MGP_NO_ERROR(const size_t *, mgp_graph_projection_offsets, projection.get());
+  const auto *targets = EXPECT_MGP_NO_ERROR(const size_t *, mgp_graph_projection_targets, projection.get());
+  const auto *weights = EXPECT_MGP_NO_ERROR(const double *, mgp_graph_projection_weights, projection.get());
+  ASSERT_NE(weights, nullptr);
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(ids[i].as_int, vertex_ids[i].AsInt());
+    EXPECT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_graph_projection_ordinal, projection.get(), ids[i]), i);
+  }
+  EXPECT_EQ(offsets[0], 0);
+  EXPECT_EQ(offsets[1], 2);
+  EXPECT_EQ(offsets[2], 3);
+  EXPECT_EQ(offsets[3], 3);
+  std::set<std::pair<size_t, double>> edges_of_first;
+  for (size_t i = offsets[0]; i < offsets[1]; ++i) edges_of_first.emplace(targets[i], weights[i]);
+  EXPECT_EQ(edges_of_first, (std::set<std::pair<size_t, double>>{{1, 2.0}, {2, 1.5}}));
+  EXPECT_EQ(targets[2], 0);
+  EXPECT_EQ(weights[2], 0.5);
+  size_t ordinal = 0;
+  EXPECT_EQ(mgp_graph_projection_ordinal(projection.get(), mgp_vertex_id{vertex_ids[3].AsInt()}, &ordinal),
+            mgp_error::MGP_ERROR_OUT_OF_RANGE);
+
+  {
+    MgpGraphProjectionPtr all{EXPECT_MGP_NO_ERROR(mgp_graph_projection *, mgp_graph_project, &graph, nullptr, 0,
+                                                  nullptr, 0, nullptr, 1.0, &this->memory)};
+    EXPECT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_graph_projection_vertex_count, all.get()), 4);
+    EXPECT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_graph_projection_edge_count, all.get()), 5);
+    EXPECT_EQ(EXPECT_MGP_NO_ERROR(const double *, mgp_graph_projection_weights, all.get()), nullptr);
+  }
+
+  if (!std::is_same<TypeParam, memgraph::storage::InMemoryStorage>::value) return;
+  // The projection of the unchanged graph is shared.
+  {
+    mgp_graph other_graph = this->CreateGraph(memgraph::storage::View::OLD);
+    MgpGraphProjectionPtr cached{EXPECT_MGP_NO_ERROR(mgp_graph_projection *, mgp_graph_project, &other_graph,
+                                                     labels.data(), labels.size(), types.data(), types.size(), "w",
+                                                     0.5, &this->memory)};
+    EXPECT_EQ(EXPECT_MGP_NO_ERROR(const size_t *, mgp_graph_projection_offsets, cached.get()), offsets);
+  }
+  {
+    auto accessor = this->CreateDbAccessor(memgraph::storage::IsolationLevel::SNAPSHOT_ISOLATION);
+    ASSERT_TRUE(accessor.InsertVertex().AddLabel(accessor.NameToLabel("B")).HasValue());
+    ASSERT_FALSE(accessor.Commit().HasError());
+  }
+  {
+    mgp_graph new_graph = this->CreateGraph(memgraph::storage::View::OLD);
+    MgpGraphProjectionPtr changed{EXPECT_MGP_NO_ERROR(mgp_graph_projection *, mgp_graph_project, &new_graph,
+                                                      labels.data(), labels.size(), types.data(), types.size(), "w",
+                                                      0.5, &this->memory)};
+    EXPECT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_graph_projection_vertex_count, changed.get()), 4);
+  }
+}
+
 TYPED_TEST(MgpGraphTest, EdgeSetProperty) {
   if (std::is_same<TypeParam, memgraph::storage::DiskStorage>::value) {
     // DiskStorage doesn't support READ_UNCOMMITTED isolation level
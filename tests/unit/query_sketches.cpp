@@ -0,0 +1,74 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "gtest/gtest.h"
+
+#include "query/plan/sketches.hpp"
+#include "utils/memory.hpp"
+
+using memgraph::query::TypedValue;
+namespace plan = memgraph::query::plan;
+
+TEST(HyperLogLog, EstimatesDistinctValues) {
+  auto *memory = memgraph::utils::NewDeleteResource();
+  for (const int64_t distinct : {0, 10, 1000, 100000}) {
+    auto sketch = plan::HyperLogLogCreate(memory);
+    // Each value is added several times.
+    for (int64_t i = 0; i < 3 * distinct; ++i) plan::HyperLogLogAdd(&sketch, std::hash<int64_t>{}(i % distinct));
+    const auto estimate = plan::HyperLogLogEstimate(sketch);
+    EXPECT_NEAR(estimate, distinct, 0.05 * static_cast<double>(distinct)) << distinct;
+  }
+}
+
+TEST(HyperLogLog, Merge) {
+  auto *memory = memgraph::utils::NewDeleteResource();
+  auto whole = plan::HyperLogLogCreate(memory);
+  auto first = plan::HyperLogLogCreate(memory);
+  auto second = plan::HyperLogLogCreate(memory);
+  // The parts overlap, the values in both are counted once.
+  for (int64_t i = 0; i < 20000; ++i) {
+    plan::HyperLogLogAdd(&whole, std::hash<int64_t>{}(i));
+    plan::HyperLogLogAdd(i < 12000 ? &first : &second, std::hash<int64_t>{}(i));
+    if (i >= 8000 && i < 12000) plan::HyperLogLogAdd(&second, std::hash<int64_t>{}(i));
+  }
+  plan::HyperLogLogMerge(&first, second);
+  EXPECT_EQ(first, whole);
+  EXPECT_NEAR(plan::HyperLogLogEstimate(whole), 20000, 1000);
+}
+
+TEST(TDigest, Percentiles) {
+  auto *memory = memgraph::utils::NewDeleteResource();
+  TypedValue::TString digest(memory);
+  EXPECT_FALSE(plan::TDigestPercentile(digest, 0.5));
+  constexpr int kValues = 100000;
+  for (int i = 0; i < kValues; ++i) plan::TDigestAdd(&digest, static_cast<double>((i * 7919) % kValues));
+  plan::TDigestAdd(&digest, std::numeric_limits<double>::quiet_NaN());
+  // The digest stays small no matter how many values are added.
+  EXPECT_LE(digest.size(), (plan::kTDigestBufferedCentroids + 1) * 2 * sizeof(double));
+  for (const double percentile : {0.0, 0.01, 0.25, 0.5, 0.75, 0.99, 1.0}) {
+    EXPECT_NEAR(*plan::TDigestPercentile(digest, percentile), percentile * kValues, 0.01 * kValues) << percentile;
+  }
+}
+
+TEST(TDigest, Merge) {
+  auto *memory = memgraph::utils::NewDeleteResource();
+  TypedValue::TString first(memory);
+  TypedValue::TString second(memory);
+  for (int i = 0; i < 10000; ++i) plan::TDigestAdd(&first, i);
+  for (int i = 10000; i < 30000; ++i) plan::TDigestAdd(&second, i);
+  plan::TDigestMerge(&first, second);
+  EXPECT_NEAR(*plan::TDigestPercentile(first, 0.5), 15000, 300);
+  EXPECT_NEAR(*plan::TDigestPercentile(first, 0.9), 27000, 300);
+}
@@ -0,0 +1,79 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <gtest/gtest.h>
+
+#include "query/query_stats.hpp"
+
+using memgraph::query::QueryExecutionInfo;
+using memgraph::query::QueryStats;
+using memgraph::query::SlowQueryInfo;
+
+TEST(QueryStats, AggregatesExecutions) {
+  QueryStats stats;
+  stats.Record("MATCH (n) RETURN n", {.query_hash = 1, .plan_hash = 10, .time_us = 100, .rows = 5, .memory_bytes = 50},
+               10);
+  stats.Record("MATCH (n) RETURN n", {.query_hash = 1, .plan_hash = 11, .time_us = 300, .rows = 7, .memory_bytes = 20},
+               10);
+  stats.Record("CREATE ()", {.query_hash = 2, .plan_hash = 20, .time_us = 1000, .rows = 0, .memory_bytes = 10}, 10);
+
+  const auto info = stats.GetInfo();
+  ASSERT_EQ(info.size(), 2);
+  EXPECT_EQ(info[0].query_hash, 2);
+  EXPECT_EQ(info[1].query, "MATCH (n) RETURN n");
+  EXPECT_EQ(info[1].plan_hash, 11);
+  EXPECT_EQ(info[1].calls, 2);
+  EXPECT_EQ(info[1].total_time_us, 400);
+  EXPECT_EQ(info[1].max_time_us, 300);
+  EXPECT_EQ(info[1].rows, 12);
+  EXPECT_EQ(info[1].max_memory_bytes, 50);
+}
+
+TEST(QueryStats, EvictsLeastCalledQuery) {
+  QueryStats stats;
+  stats.Record("a", {.query_hash = 1, .time_us = 1}, 2);
+  stats.Record("a", {.query_hash = 1, .time_us = 1}, 2);
+  stats.Record("b", {.query_hash = 2, .time_us = 1}, 2);
+  stats.Record("c", {.query_hash = 3, .time_us = 1}, 2);
+
+  const auto info = stats.GetInfo();
+  ASSERT_EQ(info.size(), 2);
+  for (const auto &query : info) EXPECT_NE(query.query_hash, 2);
+
+  stats.Record("d", {.query_hash = 4, .time_us = 1}, 0);
+  EXPECT_EQ(stats.GetInfo().size(), 2);
+}
+
+TEST(QueryStats, SlowQueryLog) {
+  QueryStats stats;
+  for (uint64_t i = 0; i < 3; ++i) {
+    stats.LogSlowQuery(SlowQueryInfo{.query = "q", .execution = {.query_hash = i}, .plan = "plan"}, 2);
+  }
+  const auto slow_queries = stats.GetSlowQueries();
+  ASSERT_EQ(slow_queries.size(), 2);
+  EXPECT_EQ(slow_queries[0].execution.query_hash, 1);
+  EXPECT_EQ(slow_queries[1].execution.query_hash, 2);
+  EXPECT_EQ(slow_queries[1].plan, "plan");
+}
+
+TEST(QueryStats, ProfilesNextExecutionOfSlowQuery) {
+  QueryStats stats;
+  EXPECT_FALSE(stats.TakeProfileRequest(1));
+
+  stats.LogSlowQuery(SlowQueryInfo{.execution = {.query_hash = 1}}, 10);
+  EXPECT_FALSE(stats.TakeProfileRequest(2));
+  EXPECT_TRUE(stats.TakeProfileRequest(1));
+  EXPECT_FALSE(stats.TakeProfileRequest(1));
+
+  stats.LogSlowQuery(SlowQueryInfo{.execution = {.query_hash = 1}, .profile = "{}"}, 10);
+  EXPECT_FALSE(stats.TakeProfileRequest(1));
+  EXPECT_EQ(stats.GetSlowQueries().size(), 2);
+}
@@ -0,0 +1,102 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "query/interpret/frame.hpp"
+#include "query/plan/subquery_cache.hpp"
+#include "utils/memory.hpp"
+
+using memgraph::query::Frame;
+using memgraph::query::Symbol;
+using memgraph::query::TypedValue;
+using memgraph::query::plan::SubqueryResultCache;
+
+namespace {
+
+SubqueryResultCache::Rows MakeRows(SubqueryResultCache &cache, const std::vector<int64_t> &values) {
+  SubqueryResultCache::Rows rows(cache.memory());
+  for (const auto value : values) {
+    auto &row = rows.emplace_back();
+    row.emplace_back(value);
+  }
+  return rows;
+}
+
+}  // namespace
+
+TEST(SubqueryResultCache, KeyedByCorrelatedValues) {
+  SubqueryResultCache cache(memgraph::utils::NewDeleteResource());
+  Frame frame(3);
+  const std::vector<Symbol> symbols{Symbol("a", 0, true), Symbol("b", 2, true)};
+  frame[symbols[0]] = TypedValue(1);
+  frame[symbols[1]] = TypedValue("x");
+
+  const auto key = cache.MakeKey(frame, symbols);
+  ASSERT_EQ(key.size(), 2);
+  EXPECT_EQ(cache.Find(key), nullptr);
+  cache.Insert(key, MakeRows(cache, {1, 2}));
+  ASSERT_NE(cache.Find(key), nullptr);
+  EXPECT_EQ(cache.Find(key)->size(), 2);
+
+  // The symbol which isn't correlated doesn't change the key.
+  frame.elems()[1] = TypedValue(42);
+  EXPECT_NE(cache.Find(cache.MakeKey(frame, symbols)), nullptr);
+
+  frame[symbols[1]] = TypedValue("y");
+  EXPECT_EQ(cache.Find(cache.MakeKey(frame, symbols)), nullptr);
+}
+
+TEST(SubqueryResultCache, ValuesOfDifferentTypesAreDifferentKeys) {
+  SubqueryResultCache cache(memgraph::utils::NewDeleteResource());
+  Frame frame(1);
+  const std::vector<Symbol> symbols{Symbol("a", 0, true)};
+  frame[symbols[0]] = TypedValue(1);
+  cache.Insert(cache.MakeKey(frame, symbols), MakeRows(cache, {1}));
+
+  frame[symbols[0]] = TypedValue(1.0);
+  EXPECT_EQ(cache.Find(cache.MakeKey(frame, symbols)), nullptr);
+  frame[symbols[0]] = TypedValue();
+  EXPECT_EQ(cache.Find(cache.MakeKey(frame, symbols)), nullptr);
+}
+
+TEST(SubqueryResultCache, EmptyResultIsMemoized) {
+  SubqueryResultCache cache(memgraph::utils::NewDeleteResource());
+  Frame frame(0);
+  const auto key = cache.MakeKey(frame, {});
+  cache.Insert(key, MakeRows(cache, {}));
+  ASSERT_NE(cache.Find(key), nullptr);
+  EXPECT_TRUE(cache.Find(key)->empty());
+}
+
+TEST(SubqueryResultCache, StopsMemoizingWhenFull) {
+  SubqueryResultCache cache(memgraph::utils::NewDeleteResource());
+  Frame frame(1);
+  const std::vector<Symbol> symbols{Symbol("a", 0, true)};
+  frame[symbols[0]] = TypedValue(0);
+  cache.Insert(cache.MakeKey(frame, symbols),
+               MakeRows(cache, std::vector<int64_t>(SubqueryResultCache::kMaxRows - 1, 0)));
+  // Empty results count as one row.
+  frame[symbols[0]] = TypedValue(1);
+  cache.Insert(cache.MakeKey(frame, symbols), MakeRows(cache, {}));
+  frame[symbols[0]] = TypedValue(2);
+  cache.Insert(cache.MakeKey(frame, symbols), MakeRows(cache, {}));
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.Find(cache.MakeKey(frame, symbols)), nullptr);
+
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0);
+  cache.Insert(cache.MakeKey(frame, symbols), MakeRows(cache, {2}));
+  EXPECT_NE(cache.Find(cache.MakeKey(frame, symbols)), nullptr);
+}
@@ -893,6 +893,48 @@ TYPED_TEST(TriggerContextTest, Filtering) {
   }
 }
 
+// Objects are only kept for the identifiers which the triggers read, while the triggers still run on the events.
+TYPED_TEST(TriggerContextTest, KeepOnlyReadObjects) {
+  using TIT = memgraph::query::TriggerIdentifierTag;
+  memgraph::query::TriggerContextCollector collector{kAllEventTypes, {TIT::CREATED_EDGES, TIT::DELETED_EDGES}};
+  memgraph::query::DbAccessor dba{this->StartTransaction()};
+
+  std::vector<memgraph::query::VertexAccessor> vertices;
+  for (size_t i = 0; i < 4; ++i) {
+    vertices.push_back(dba.InsertVertex());
+  }
+  auto maybe_edge_to_delete = dba.InsertEdge(&vertices[0], &vertices[1], dba.NameToEdgeType("EDGE"));
+  ASSERT_FALSE(maybe_edge_to_delete.HasError());
+  dba.AdvanceCommand();
+
+  for (size_t i = 0; i < 3; ++i) {
+    auto created_vertex = dba.InsertVertex();
+    collector.RegisterCreatedObject(created_vertex);
+    auto maybe_created_edge = dba.InsertEdge(&vertices[0], &created_vertex, dba.NameToEdgeType("EDGE"));
+    ASSERT_FALSE(maybe_created_edge.HasError());
+    collector.RegisterCreatedObject(*maybe_created_edge);
+    // Changes on the created objects are ignored even if the objects aren't kept.
+    collector.RegisterSetObjectProperty(created_vertex, dba.NameToProperty("PROPERTY"), memgraph::query::TypedValue{},
+                                        memgraph::query::TypedValue{1});
+  }
+  collector.RegisterDeletedObject(dba.RemoveEdge(&*maybe_edge_to_delete).GetValue().value());
+  for (size_t i = 1; i < 4; ++i) {
+    collector.RegisterDeletedObject(dba.DetachRemoveVertex(&vertices[i]).GetValue().value().first);
+  }
+  dba.AdvanceCommand();
+
+  const auto trigger_context = std::move(collector).TransformToTriggerContext();
+  CheckTypedValueSize(trigger_context, TIT::CREATED_VERTICES, 1, dba);
+  CheckTypedValueSize(trigger_context, TIT::CREATED_EDGES, 3, dba);
+  CheckTypedValueSize(trigger_context, TIT::DELETED_VERTICES, 1, dba);
+  CheckTypedValueSize(trigger_context, TIT::DELETED_EDGES, 1, dba);
+  CheckTypedValueSize(trigger_context, TIT::SET_VERTEX_PROPERTIES, 0, dba);
+  ASSERT_TRUE(trigger_context.ShouldEventTrigger(memgraph::query::TriggerEventType::VERTEX_CREATE));
+  ASSERT_TRUE(trigger_context.ShouldEventTrigger(memgraph::query::TriggerEventType::VERTEX_DELETE));
+  ASSERT_FALSE(trigger_context.ShouldEventTrigger(memgraph::query::TriggerEventType::UPDATE));
+  dba.Abort();
+}
+
 template <typename StorageType>
 class TriggerStoreTest : public ::testing::Test {
  protected:
@@ -1054,6 +1096,23 @@ TYPED_TEST(TriggerStoreTest, AddTrigger) {
   ASSERT_EQ(store.AfterCommitTriggers().size(), 0);
 }
 
+TYPED_TEST(TriggerStoreTest, IdentifierTags) {
+  using TIT = memgraph::query::TriggerIdentifierTag;
+  memgraph::query::TriggerStore store{this->testing_directory};
+  ASSERT_TRUE(store.GetIdentifierTags().empty());
+
+  store.AddTrigger("trigger", "UNWIND createdVertices AS v RETURN v", {}, memgraph::query::TriggerEventType::ANY,
+                   memgraph::query::TriggerPhase::BEFORE_COMMIT, &this->ast_cache, &*this->dba,
+                   memgraph::query::InterpreterConfig::Query{}, std::nullopt, &this->auth_checker);
+  store.AddTrigger("trigger_after", "RETURN size(deletedObjects), 1", {}, memgraph::query::TriggerEventType::DELETE,
+                   memgraph::query::TriggerPhase::AFTER_COMMIT, &this->ast_cache, &*this->dba,
+                   memgraph::query::InterpreterConfig::Query{}, std::nullopt, &this->auth_checker);
+  store.AddTrigger("trigger_without_identifiers", "RETURN 1", {}, memgraph::query::TriggerEventType::UPDATE,
+                   memgraph::query::TriggerPhase::AFTER_COMMIT, &this->ast_cache, &*this->dba,
+                   memgraph::query::InterpreterConfig::Query{}, std::nullopt, &this->auth_checker);
+  ASSERT_EQ(store.GetIdentifierTags(), (std::unordered_set{TIT::CREATED_VERTICES, TIT::DELETED_OBJECTS}));
+}
+
 TYPED_TEST(TriggerStoreTest, DropTrigger) {
   memgraph::query::TriggerStore store{this->testing_directory};
 
@@ -0,0 +1,90 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <latch>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "query/trigger_executor.hpp"
+
+using memgraph::query::AfterCommitTriggerExecutor;
+using namespace std::chrono_literals;
+
+TEST(AfterCommitTriggerExecutor, FinishesWithoutWorkers) {
+  AfterCommitTriggerExecutor executor(2, 0);
+  bool finished = false;
+  executor.Schedule({}, [](size_t) { FAIL(); }, [&] { finished = true; });
+  EXPECT_TRUE(finished);
+  EXPECT_EQ(executor.Backlog(), 0);
+}
+
+TEST(AfterCommitTriggerExecutor, KeepsOrderOnWorker) {
+  static constexpr size_t kWorkers = 4;
+  static constexpr size_t kTransactions = 100;
+  AfterCommitTriggerExecutor executor(kWorkers, 0);
+
+  std::mutex mutex;
+  std::vector<std::vector<size_t>> runs(kWorkers);
+  std::latch finished(kTransactions);
+  std::vector<size_t> all_workers(kWorkers);
+  for (size_t i = 0; i < kWorkers; ++i) all_workers[i] = i;
+
+  for (size_t transaction = 0; transaction < kTransactions; ++transaction) {
+    executor.Schedule(
+        all_workers,
+        [&, transaction](size_t worker) {
+          std::lock_guard lock(mutex);
+          runs[worker].push_back(transaction);
+        },
+        [&] { finished.count_down(); });
+  }
+  finished.wait();
+
+  for (const auto &worker_runs : runs) {
+    ASSERT_EQ(worker_runs.size(), kTransactions);
+    EXPECT_TRUE(std::is_sorted(worker_runs.begin(), worker_runs.end()));
+  }
+  EXPECT_EQ(executor.Backlog(), 0);
+}
+
+TEST(AfterCommitTriggerExecutor, SameWorkerForTrigger) {
+  AfterCommitTriggerExecutor executor(8, 0);
+  EXPECT_EQ(executor.Worker("trigger"), executor.Worker("trigger"));
+  EXPECT_LT(executor.Worker("trigger"), 8);
+}
+
+TEST(AfterCommitTriggerExecutor, WaitsForBacklog) {
+  AfterCommitTriggerExecutor executor(1, 1);
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  executor.Schedule({0}, [released](size_t) { released.wait(); }, [] {});
+  EXPECT_EQ(executor.Backlog(), 1);
+
+  std::atomic<bool> scheduled{false};
+  auto second = std::async(std::launch::async, [&] {
+    executor.Schedule({0}, [](size_t) {}, [] {});
+    scheduled = true;
+  });
+  EXPECT_EQ(second.wait_for(50ms), std::future_status::timeout);
+  EXPECT_FALSE(scheduled);
+
+  release.set_value();
+  second.get();
+  EXPECT_TRUE(scheduled);
+  while (executor.Backlog() != 0) std::this_thread::sleep_for(1ms);
+}
@@ -158,6 +158,30 @@ TYPED_TEST(TestVariableStartPlanner, MatchTripletPatternReturn) {
   }
 }
 
+TYPED_TEST(TestVariableStartPlanner, MatchChainPatternCostOrdered) {
+  auto storage_dba = this->db->Access();
+  memgraph::query::DbAccessor dba(storage_dba.get());
+  // Make a graph (v1) -[:r]-> (v2) -[:r]-> (v3) -[:r]-> (v4)
+  auto v1 = dba.InsertVertex();
+  auto v2 = dba.InsertVertex();
+  auto v3 = dba.InsertVertex();
+  auto v4 = dba.InsertVertex();
+  ASSERT_TRUE(dba.InsertEdge(&v1, &v2, dba.NameToEdgeType("r")).HasValue());
+  ASSERT_TRUE(dba.InsertEdge(&v2, &v3, dba.NameToEdgeType("r")).HasValue());
+  ASSERT_TRUE(dba.InsertEdge(&v3, &v4, dba.NameToEdgeType("r")).HasValue());
+  dba.AdvanceCommand();
+  // Test `MATCH (n) -[r]-> (m) -[e]-> (l) -[f]-> (k) RETURN n`
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n"), EDGE("r", Direction::OUT), NODE("m"),
+                                                 EDGE("e", Direction::OUT), NODE("l"), EDGE("f", Direction::OUT),
+                                                 NODE("k"))),
+                                   RETURN("n")));
+  // We have 4 nodes from which we could start and an additional plan with
+  // expansions ordered by their estimated cost.
+  CheckPlansProduce(5, query, this->storage, &dba, [&](const auto &results) {
+    AssertRows(results, {{TypedValue(memgraph::query::VertexAccessor(v1))}}, dba);
+  });
+}
+
 TYPED_TEST(TestVariableStartPlanner, MatchOptionalMatchReturn) {
   auto storage_dba = this->db->Access();
   memgraph::query::DbAccessor dba(storage_dba.get());
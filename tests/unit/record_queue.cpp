@@ -0,0 +1,79 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "glue/record_queue.hpp"
+
+using memgraph::glue::RecordQueue;
+
+namespace {
+std::vector<std::vector<uint8_t>> PopAll(RecordQueue &queue) {
+  std::vector<std::vector<uint8_t>> records;
+  std::vector<uint8_t> buffer;
+  std::vector<size_t> record_ends;
+  while (queue.Pop(buffer, record_ends)) {
+    size_t begin = 0;
+    for (auto end : record_ends) {
+      records.emplace_back(buffer.begin() + begin, buffer.begin() + end);
+      begin = end;
+    }
+  }
+  return records;
+}
+}  // namespace
+
+TEST(RecordQueue, PopsRecordsInOrder) {
+  RecordQueue queue(16);
+  std::thread producer([&] {
+    for (uint8_t i = 0; i < 100; ++i) {
+      const std::vector<uint8_t> record(i % 7 + 1, i);
+      queue.Push(record.data(), record.size());
+    }
+    queue.Finish();
+  });
+  auto records = PopAll(queue);
+  producer.join();
+
+  ASSERT_EQ(records.size(), 100);
+  for (uint8_t i = 0; i < 100; ++i) {
+    EXPECT_EQ(records[i], std::vector<uint8_t>(i % 7 + 1, i));
+  }
+}
+
+TEST(RecordQueue, RethrowsAfterRecords) {
+  RecordQueue queue(1024);
+  const uint8_t record[] = {1, 2, 3};
+  queue.Push(record, sizeof(record));
+  queue.Finish(std::make_exception_ptr(std::runtime_error("failed")));
+
+  std::vector<uint8_t> buffer;
+  std::vector<size_t> record_ends;
+  ASSERT_TRUE(queue.Pop(buffer, record_ends));
+  EXPECT_EQ(buffer, std::vector<uint8_t>(record, record + sizeof(record)));
+  EXPECT_THROW(queue.Pop(buffer, record_ends), std::runtime_error);
+}
+
+TEST(RecordQueue, CancelUnblocksProducer) {
+  RecordQueue queue(1);
+  std::thread producer([&] {
+    const uint8_t record = 0;
+    for (int i = 0; i < 100; ++i) queue.Push(&record, 1);
+    queue.Finish();
+  });
+  // The producer blocks on the second record until the queue is cancelled,
+  // and the cancel waits until it finishes.
+  queue.Cancel();
+  producer.join();
+}
@@ -30,14 +30,15 @@ class ReplicationPersistanceHelperTest : public testing::Test {
   ReplicationStatus CreateReplicationStatus(std::string name, std::string ip_address, uint16_t port,
                                             ReplicationMode sync_mode, std::chrono::seconds replica_check_frequency,
                                             std::optional<ReplicationClientConfig::SSL> ssl,
-                                            std::optional<ReplicationRole> role) const {
+                                            std::optional<ReplicationRole> role, bool compression = false) const {
     return ReplicationStatus{.name = name,
                              .ip_address = ip_address,
                              .port = port,
                              .sync_mode = sync_mode,
                              .replica_check_frequency = replica_check_frequency,
                              .ssl = ssl,
-                             .role = role};
+                             .role = role,
+                             .compression = compression};
   }
 
   static_assert(
@@ -98,3 +99,26 @@ TEST_F(ReplicationPersistanceHelperTest, BasicTestAllAttributesButReplicationRol
 
   ASSERT_EQ(replicas_status, *replicas_status_converted);
 }
+
+TEST_F(ReplicationPersistanceHelperTest, BasicTestCompressionInitialized) {
+  auto replicas_status =
+      CreateReplicationStatus("name", "ip_address", 0, ReplicationMode::ASYNC, std::chrono::seconds(1), std::nullopt,
+                              ReplicationRole::REPLICA, true);
+
+  auto json_status = ReplicationStatusToJSON(ReplicationStatus(replicas_status));
+  auto replicas_status_converted = JSONToReplicationStatus(std::move(json_status));
+
+  ASSERT_EQ(replicas_status, *replicas_status_converted);
+}
+
+TEST_F(ReplicationPersistanceHelperTest, BasicTestMissingCompression) {
+  // Replicas persisted before compression was configurable
+  auto replicas_status = CreateReplicationStatus("name", "ip_address", 0, ReplicationMode::SYNC,
+                                                 std::chrono::seconds(1), std::nullopt, ReplicationRole::REPLICA);
+
+  auto json_status = ReplicationStatusToJSON(ReplicationStatus(replicas_status));
+  json_status.erase("replica_compression");
+  auto replicas_status_converted = JSONToReplicationStatus(std::move(json_status));
+
+  ASSERT_EQ(replicas_status, *replicas_status_converted);
+}
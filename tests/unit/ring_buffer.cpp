@@ -94,3 +94,20 @@ TEST(RingBuffer, NonCopyable) {
 
   std::unique_ptr<std::string> a(new std::string("bla"));
 }
+
+TEST(RingBuffer, TryEmplace) {
+  RingBuffer<std::unique_ptr<std::string>> buffer{2};
+  EXPECT_TRUE(buffer.try_emplace(std::make_unique<std::string>("string")));
+  EXPECT_TRUE(buffer.try_emplace(std::make_unique<std::string>("kifla")));
+
+  // The element isn't moved from when the buffer is full.
+  auto element = std::make_unique<std::string>("bla");
+  EXPECT_FALSE(buffer.try_emplace(std::move(element)));
+  ASSERT_TRUE(element);
+
+  EXPECT_EQ(**buffer.pop(), "string");
+  EXPECT_TRUE(buffer.try_emplace(std::move(element)));
+  EXPECT_EQ(**buffer.pop(), "kifla");
+  EXPECT_EQ(**buffer.pop(), "bla");
+  EXPECT_FALSE(buffer.pop());
+}
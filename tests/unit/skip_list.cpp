@@ -446,6 +446,45 @@ TEST(SkipList, Inception) {
   }
 }
 
+TEST(SkipList, InsertWithHint) {
+  memgraph::utils::SkipList<int64_t> list;
+  auto acc = list.access();
+  memgraph::utils::SkipList<int64_t>::InsertHint hint;
+
+  // Sorted input.
+  for (int64_t i = 0; i < 10000; i += 2) {
+    auto res = acc.insert(hint, i);
+    ASSERT_EQ(*res.first, i);
+    ASSERT_TRUE(res.second);
+  }
+  // Existing items aren't inserted again.
+  for (int64_t i = 0; i < 10000; i += 100) {
+    auto res = acc.insert(hint, i);
+    ASSERT_EQ(*res.first, i);
+    ASSERT_FALSE(res.second);
+  }
+  // The hint is only an optimization, any order is fine.
+  for (int64_t i = 9999; i > 0; i -= 2) {
+    auto res = acc.insert(hint, i);
+    ASSERT_EQ(*res.first, i);
+    ASSERT_TRUE(res.second);
+  }
+  // Removed nodes that the hint points to are skipped.
+  ASSERT_TRUE(acc.remove(9999));
+  ASSERT_TRUE(acc.remove(9998));
+  ASSERT_TRUE(acc.insert(hint, 9998).second);
+  ASSERT_TRUE(acc.insert(hint, 10000).second);
+
+  ASSERT_EQ(acc.size(), 10000);
+  int64_t expected = 0;
+  for (auto item : acc) {
+    if (expected == 9999) ++expected;
+    ASSERT_EQ(item, expected);
+    ++expected;
+  }
+  ASSERT_EQ(expected, 10001);
+}
+
 TEST(SkipList, FindEqualOrGreater) {
   memgraph::utils::SkipList<uint64_t> list;
 
@@ -478,6 +517,41 @@ TEST(SkipList, FindEqualOrGreater) {
   }
 }
 
+TEST(SkipList, PartitionPoints) {
+  memgraph::utils::SkipList<uint64_t> list;
+
+  {
+    auto acc = list.access();
+    ASSERT_TRUE(acc.partition_points(8).empty());
+    acc.insert(5);
+    ASSERT_TRUE(acc.partition_points(8).empty());
+    for (uint64_t i = 0; i < 100000; ++i) acc.insert(i);
+    ASSERT_TRUE(acc.partition_points(1).empty());
+  }
+
+  {
+    auto acc = list.access();
+    auto points = acc.partition_points(8);
+    ASSERT_EQ(points.size(), 7);
+    uint64_t begin = 0;
+    for (auto it : points) {
+      ASSERT_NE(it, acc.end());
+      ASSERT_GT(*it, begin);
+      // Each of the 8 partitions should have roughly 12500 items.
+      ASSERT_GT(*it - begin, 2500);
+      ASSERT_LT(*it - begin, 50000);
+      begin = *it;
+    }
+    ASSERT_GT(100000 - begin, 2500);
+
+    // Fewer points are returned for a list that is too small.
+    memgraph::utils::SkipList<uint64_t> small;
+    auto small_acc = small.access();
+    for (uint64_t i = 0; i < 3; ++i) small_acc.insert(i);
+    ASSERT_EQ(small_acc.partition_points(8).size(), 2);
+  }
+}
+
 struct Counter {
   int64_t key;
   int64_t value;
@@ -10,7 +10,10 @@
 // licenses/APL.txt.
 
 #include <gtest/gtest.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
 #include <memory>
 #include <random>
@@ -136,6 +139,105 @@ TEST(Builder, MultipleSegments) {
   ASSERT_EQ(splits[4], footer_expected);
 }
 
+TEST(Builder, SaveFile) {
+  auto input = GetRandomData(memgraph::slk::kSegmentMaxDataSize + 100);
+  auto *file = std::tmpfile();
+  ASSERT_NE(file, nullptr);
+  const auto fd = fileno(file);
+  ASSERT_EQ(write(fd, input.data(), input.size()), static_cast<ssize_t>(input.size()));
+
+  auto prefix = GetRandomData(5);
+
+  std::vector<uint8_t> saved;
+  memgraph::slk::Builder save_builder([&saved](const uint8_t *data, size_t size, bool have_more) {
+    for (size_t i = 0; i < size; ++i) saved.push_back(data[i]);
+  });
+  save_builder.Save(prefix.data(), prefix.size());
+  save_builder.Save(input.data() + 10, input.size() - 10);
+  save_builder.Finalize();
+
+  // Without the file write function the stream is the same as if the data was
+  // saved from memory.
+  std::vector<uint8_t> read;
+  memgraph::slk::Builder read_builder([&read](const uint8_t *data, size_t size, bool have_more) {
+    for (size_t i = 0; i < size; ++i) read.push_back(data[i]);
+  });
+  read_builder.Save(prefix.data(), prefix.size());
+  read_builder.SaveFile(fd, 10, input.size() - 10);
+  read_builder.Finalize();
+  ASSERT_EQ(read, saved);
+
+  // With the file write function the segments are split differently, but
+  // they hold the same data.
+  std::vector<uint8_t> sent;
+  memgraph::slk::Builder send_builder(
+      [&sent](const uint8_t *data, size_t size, bool have_more) {
+        for (size_t i = 0; i < size; ++i) sent.push_back(data[i]);
+      },
+      [&sent](int fd, uint64_t offset, uint64_t size) {
+        const auto pos = sent.size();
+        sent.resize(pos + size);
+        ASSERT_EQ(pread(fd, sent.data() + pos, size, static_cast<off_t>(offset)), static_cast<ssize_t>(size));
+      });
+  send_builder.Save(prefix.data(), prefix.size());
+  send_builder.SaveFile(fd, 10, input.size() - 10);
+  send_builder.Finalize();
+  std::fclose(file);
+
+  auto status = memgraph::slk::CheckStreamComplete(sent.data(), sent.size());
+  ASSERT_EQ(status.status, memgraph::slk::StreamStatus::COMPLETE);
+  ASSERT_EQ(status.stream_size, sent.size());
+  ASSERT_EQ(status.encoded_data_size, prefix.size() + input.size() - 10);
+
+  memgraph::slk::Reader reader(sent.data(), sent.size());
+  auto expected = prefix + BinaryData(input.data() + 10, input.size() - 10);
+  std::unique_ptr<uint8_t[]> loaded(new uint8_t[expected.size()]);
+  reader.Load(loaded.get(), expected.size());
+  reader.Finalize();
+  ASSERT_EQ(BinaryData(std::move(loaded), expected.size()), expected);
+}
+
+TEST(Builder, SaveInPlace) {
+  auto small = GetRandomData(5);
+  auto large = GetRandomData(2 * memgraph::slk::kSegmentMaxDataSize + 100);
+
+  std::vector<uint8_t> buffer;
+  std::vector<const uint8_t *> in_place;
+  memgraph::slk::Builder builder(
+      [&buffer](const uint8_t *data, size_t size, bool have_more) {
+        for (size_t i = 0; i < size; ++i) buffer.push_back(data[i]);
+      },
+      {},
+      [&buffer, &in_place](const iovec *iov, size_t iovcnt, bool have_more) {
+        ASSERT_TRUE(have_more);
+        for (size_t i = 0; i < iovcnt; ++i) {
+          const auto *data = static_cast<const uint8_t *>(iov[i].iov_base);
+          in_place.push_back(data);
+          buffer.insert(buffer.end(), data, data + iov[i].iov_len);
+        }
+      });
+  builder.Save(small.data(), small.size());
+  builder.Save(large.data(), large.size());
+  builder.Finalize();
+
+  // The large data is written straight from where it's stored.
+  ASSERT_TRUE(std::find(in_place.begin(), in_place.end(), large.data()) != in_place.end());
+
+  auto splits = BufferToBinaryData(
+      buffer.data(), buffer.size(),
+      {sizeof(memgraph::slk::SegmentSize), small.size(), sizeof(memgraph::slk::SegmentSize),
+       memgraph::slk::kSegmentMaxDataSize, sizeof(memgraph::slk::SegmentSize), memgraph::slk::kSegmentMaxDataSize,
+       sizeof(memgraph::slk::SegmentSize), 100, sizeof(memgraph::slk::SegmentSize)});
+  ASSERT_EQ(buffer.size(), small.size() + large.size() + 5 * sizeof(memgraph::slk::SegmentSize));
+  ASSERT_EQ(splits[0], SizeToBinaryData(small.size()));
+  ASSERT_EQ(splits[1], small);
+  ASSERT_EQ(splits[2], SizeToBinaryData(memgraph::slk::kSegmentMaxDataSize));
+  ASSERT_EQ(splits[4], SizeToBinaryData(memgraph::slk::kSegmentMaxDataSize));
+  ASSERT_EQ(splits[6], SizeToBinaryData(100));
+  ASSERT_EQ(splits[3] + splits[5] + splits[7], large);
+  ASSERT_EQ(splits[8], SizeToBinaryData(0));
+}
+
 TEST(Reader, SingleSegment) {
   std::vector<uint8_t> buffer;
   memgraph::slk::Builder builder([&buffer](const uint8_t *data, size_t size, bool have_more) {
@@ -296,6 +398,30 @@ TEST(Reader, MultipleSegments) {
   }
 }
 
+TEST(Reader, TryLoadView) {
+  auto first = GetRandomData(5);
+  auto second = GetRandomData(10);
+  auto stream = SizeToBinaryData(first.size()) + first + SizeToBinaryData(second.size()) + second + SizeToBinaryData(0);
+
+  memgraph::slk::Reader reader(stream.data(), stream.size());
+  auto view = reader.TryLoadView(3);
+  ASSERT_TRUE(view);
+  ASSERT_EQ(reinterpret_cast<const uint8_t *>(view->data()), stream.data() + sizeof(memgraph::slk::SegmentSize));
+  ASSERT_EQ(BinaryData(reinterpret_cast<const uint8_t *>(view->data()), view->size()), BinaryData(first.data(), 3));
+
+  // The data spans both segments, so it can't be viewed and stays unread.
+  ASSERT_FALSE(reader.TryLoadView(4));
+  uint8_t rest[4];
+  reader.Load(rest, sizeof(rest));
+  ASSERT_EQ(BinaryData(rest, sizeof(rest)), BinaryData(first.data() + 3, 2) + BinaryData(second.data(), 2));
+
+  view = reader.TryLoadView(8);
+  ASSERT_TRUE(view);
+  ASSERT_EQ(BinaryData(reinterpret_cast<const uint8_t *>(view->data()), view->size()),
+            BinaryData(second.data() + 2, 8));
+  reader.Finalize();
+}
+
 TEST(CheckStreamComplete, SingleSegment) {
   std::vector<uint8_t> buffer;
   memgraph::slk::Builder builder([&buffer](const uint8_t *data, size_t size, bool have_more) {
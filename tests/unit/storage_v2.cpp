@@ -14,6 +14,9 @@
 
 #include <filesystem>
 #include <limits>
+#include <set>
+#include <thread>
+#include <vector>
 
 #include "disk_test_utils.hpp"
 #include "storage/v2/disk/storage.hpp"
@@ -263,6 +266,50 @@ TYPED_TEST(StorageV2Test, AccessorMove) {
   }
 }
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TYPED_TEST(StorageV2Test, PartitionVertices) {
+  constexpr uint64_t kNumVertices = 1000;
+  {
+    auto acc = this->store->Access();
+    for (uint64_t i = 0; i < kNumVertices; ++i) acc->CreateVertex();
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  {
+    auto acc = this->store->Access();
+    // Vertices created by the transaction itself are seen only with View::NEW.
+    auto new_vertex_gid = acc->CreateVertex().Gid();
+    auto partitions = acc->PartitionVertices(memgraph::storage::View::OLD, 4);
+    ASSERT_GE(partitions.size(), 1);
+    ASSERT_LE(partitions.size(), 4);
+    if (std::is_same<TypeParam, memgraph::storage::InMemoryStorage>::value) {
+      ASSERT_EQ(partitions.size(), 4);
+    }
+
+    std::vector<std::vector<memgraph::storage::Gid>> gids(partitions.size());
+    {
+      std::vector<std::jthread> threads;
+      for (size_t i = 0; i < partitions.size(); ++i) {
+        threads.emplace_back([&partition = partitions[i], &partition_gids = gids[i]] {
+          for (auto vertex : partition) partition_gids.push_back(vertex.Gid());
+        });
+      }
+    }
+    std::set<memgraph::storage::Gid> all_gids;
+    for (const auto &partition_gids : gids) {
+      for (auto gid : partition_gids) ASSERT_TRUE(all_gids.insert(gid).second);
+    }
+    ASSERT_EQ(all_gids.size(), kNumVertices);
+    ASSERT_FALSE(all_gids.contains(new_vertex_gid));
+
+    uint64_t count = 0;
+    for (auto &partition : acc->PartitionVertices(memgraph::storage::View::NEW, 4)) {
+      for ([[maybe_unused]] auto vertex : partition) ++count;
+    }
+    ASSERT_EQ(count, kNumVertices + 1);
+    acc->Abort();
+  }
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TYPED_TEST(StorageV2Test, VertexDeleteCommit) {
   memgraph::storage::Gid gid = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
@@ -2646,3 +2693,200 @@ TYPED_TEST(StorageV2Test, DeletedVertexAccessor) {
     ASSERT_EQ(property_value, *maybe_property);
   }
 }
+
+TYPED_TEST(StorageV2Test, GraphVersion) {
+  auto acc = this->store->Access();
+  if (std::is_same<TypeParam, memgraph::storage::DiskStorage>::value) {
+    // The versions are only tracked by the in-memory storage.
+    EXPECT_FALSE(acc->GraphVersion().has_value());
+    return;
+  }
+  const auto version = acc->GraphVersion();
+  ASSERT_TRUE(version.has_value());
+  {
+    auto other_acc = this->store->Access();
+    EXPECT_EQ(other_acc->GraphVersion(), version);
+    other_acc->CreateVertex();
+    EXPECT_FALSE(other_acc->GraphVersion().has_value());
+    ASSERT_FALSE(other_acc->Commit().HasError());
+  }
+  // The running transaction still sees the graph without the new vertex.
+  EXPECT_EQ(acc->GraphVersion(), version);
+  {
+    auto new_acc = this->store->Access();
+    ASSERT_TRUE(new_acc->GraphVersion().has_value());
+    EXPECT_NE(new_acc->GraphVersion(), version);
+  }
+  {
+    auto read_committed_acc = this->store->Access(memgraph::storage::IsolationLevel::READ_COMMITTED);
+    EXPECT_FALSE(read_committed_acc->GraphVersion().has_value());
+  }
+}
+
+TEST(StorageV2InMemory, LastGraphChange) {
+  std::unique_ptr<memgraph::storage::Storage> store{std::make_unique<memgraph::storage::InMemoryStorage>()};
+  const auto label = store->NameToLabel("label");
+  const auto other_label = store->NameToLabel("other_label");
+  const auto edge_type = store->NameToEdgeType("edge_type");
+  memgraph::storage::GraphFootprint label_footprint;
+  label_footprint.labels.insert(label);
+  memgraph::storage::GraphFootprint other_label_footprint;
+  other_label_footprint.labels.insert(other_label);
+  memgraph::storage::GraphFootprint edge_type_footprint;
+  edge_type_footprint.edge_types.insert(edge_type);
+
+  {
+    // The changes aren't tracked until they're enabled.
+    auto acc = store->Access();
+    EXPECT_FALSE(acc->LastGraphChange(label_footprint).has_value());
+  }
+  store->EnableGraphChangeTracking();
+
+  memgraph::storage::Gid gid;
+  {
+    auto acc = store->Access();
+    auto vertex = acc->CreateVertex();
+    gid = vertex.Gid();
+    ASSERT_FALSE(vertex.AddLabel(label).HasError());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  auto acc = store->Access();
+  const auto version = acc->GraphVersion();
+  ASSERT_TRUE(version.has_value());
+  EXPECT_EQ(acc->LastGraphChange(label_footprint), version);
+  EXPECT_LT(*acc->LastGraphChange(other_label_footprint), *version);
+  EXPECT_LT(*acc->LastGraphChange(edge_type_footprint), *version);
+
+  {
+    auto other_acc = store->Access();
+    auto vertex = other_acc->FindVertex(gid, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex);
+    auto other_vertex = other_acc->CreateVertex();
+    ASSERT_FALSE(other_vertex.AddLabel(other_label).HasError());
+    ASSERT_FALSE(other_acc->CreateEdge(&*vertex, &other_vertex, edge_type).HasError());
+    ASSERT_FALSE(other_acc->Commit().HasError());
+  }
+  // The edge changed the vertices of both labels.
+  EXPECT_GT(*acc->LastGraphChange(label_footprint), *version);
+  EXPECT_GT(*acc->LastGraphChange(other_label_footprint), *version);
+  EXPECT_GT(*acc->LastGraphChange(edge_type_footprint), *version);
+}
+
+TEST(StorageV2InMemory, ConcurrentWritesOfDifferentProperties) {
+  std::unique_ptr<memgraph::storage::Storage> store{std::make_unique<memgraph::storage::InMemoryStorage>()};
+  memgraph::storage::Gid gid;
+  memgraph::storage::PropertyId first;
+  memgraph::storage::PropertyId second;
+  {
+    auto acc = store->Access();
+    auto vertex = acc->CreateVertex();
+    gid = vertex.Gid();
+    first = acc->NameToProperty("first");
+    second = acc->NameToProperty("second");
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  auto acc1 = store->Access();
+  auto acc2 = store->Access();
+  auto vertex1 = acc1->FindVertex(gid, memgraph::storage::View::OLD);
+  auto vertex2 = acc2->FindVertex(gid, memgraph::storage::View::OLD);
+  ASSERT_TRUE(vertex1 && vertex2);
+  ASSERT_FALSE(vertex1->SetProperty(first, memgraph::storage::PropertyValue(1)).HasError());
+  ASSERT_FALSE(acc1->Commit().HasError());
+
+  // The same property was changed after the transaction started.
+  auto acc3 = store->Access();
+  {
+    auto res = vertex2->SetProperty(first, memgraph::storage::PropertyValue(2));
+    ASSERT_TRUE(res.HasError());
+    ASSERT_EQ(res.GetError(), memgraph::storage::Error::SERIALIZATION_ERROR);
+  }
+  acc2->Abort();
+
+  auto acc4 = store->Access();
+  auto vertex3 = acc3->FindVertex(gid, memgraph::storage::View::OLD);
+  auto vertex4 = acc4->FindVertex(gid, memgraph::storage::View::OLD);
+  ASSERT_TRUE(vertex3 && vertex4);
+  ASSERT_FALSE(vertex3->SetProperty(second, memgraph::storage::PropertyValue(2)).HasError());
+  ASSERT_FALSE(acc3->Commit().HasError());
+  // A different property was changed after the transaction started.
+  ASSERT_FALSE(vertex4->SetProperty(first, memgraph::storage::PropertyValue(3)).HasError());
+  ASSERT_EQ(*vertex4->GetProperty(second, memgraph::storage::View::NEW), memgraph::storage::PropertyValue());
+  ASSERT_FALSE(acc4->Commit().HasError());
+
+  auto acc = store->Access();
+  auto vertex = acc->FindVertex(gid, memgraph::storage::View::OLD);
+  ASSERT_TRUE(vertex);
+  ASSERT_EQ(*vertex->GetProperty(first, memgraph::storage::View::OLD), memgraph::storage::PropertyValue(3));
+  ASSERT_EQ(*vertex->GetProperty(second, memgraph::storage::View::OLD), memgraph::storage::PropertyValue(2));
+}
+
+TEST(StorageV2InMemory, CommutativeIncrements) {
+  std::unique_ptr<memgraph::storage::Storage> store{std::make_unique<memgraph::storage::InMemoryStorage>()};
+  memgraph::storage::Gid gid;
+  memgraph::storage::PropertyId property;
+  {
+    auto acc = store->Access();
+    auto vertex = acc->CreateVertex();
+    gid = vertex.Gid();
+    property = acc->NameToProperty("count");
+    ASSERT_FALSE(vertex.SetProperty(property, memgraph::storage::PropertyValue(0)).HasError());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  auto acc1 = store->Access();
+  auto acc2 = store->Access();
+  auto vertex1 = acc1->FindVertex(gid, memgraph::storage::View::OLD);
+  auto vertex2 = acc2->FindVertex(gid, memgraph::storage::View::OLD);
+  ASSERT_TRUE(vertex1 && vertex2);
+  ASSERT_TRUE(*vertex1->AddToProperty(property, memgraph::storage::PropertyValue(1)));
+  ASSERT_TRUE(*vertex2->AddToProperty(property, memgraph::storage::PropertyValue(2)));
+  ASSERT_TRUE(*vertex2->AddToProperty(property, memgraph::storage::PropertyValue(3)));
+  ASSERT_FALSE(*vertex1->AddToProperty(property, memgraph::storage::PropertyValue("a")));
+  ASSERT_FALSE(acc1->Commit().HasError());
+  ASSERT_FALSE(acc2->Commit().HasError());
+
+  auto acc = store->Access();
+  auto vertex = acc->FindVertex(gid, memgraph::storage::View::OLD);
+  ASSERT_TRUE(vertex);
+  ASSERT_EQ(*vertex->GetProperty(property, memgraph::storage::View::OLD), memgraph::storage::PropertyValue(6));
+}
+
+TEST(StorageV2InMemory, ReadOnlyTransaction) {
+  std::unique_ptr<memgraph::storage::Storage> store{std::make_unique<memgraph::storage::InMemoryStorage>()};
+  memgraph::storage::Gid gid;
+  memgraph::storage::PropertyId property;
+  {
+    auto acc = store->Access();
+    auto vertex = acc->CreateVertex();
+    gid = vertex.Gid();
+    property = acc->NameToProperty("property");
+    ASSERT_FALSE(vertex.SetProperty(property, memgraph::storage::PropertyValue(1)).HasError());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  auto read_only_acc = store->ReadOnlyAccess(std::nullopt);
+  {
+    auto acc = store->Access();
+    EXPECT_EQ(read_only_acc->GraphVersion(), acc->GraphVersion());
+    auto vertex = acc->FindVertex(gid, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex);
+    ASSERT_FALSE(vertex->SetProperty(property, memgraph::storage::PropertyValue(2)).HasError());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  {
+    auto vertex = read_only_acc->FindVertex(gid, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex);
+    ASSERT_EQ(*vertex->GetProperty(property, memgraph::storage::View::OLD), memgraph::storage::PropertyValue(1));
+    ASSERT_FALSE(read_only_acc->Commit().HasError());
+  }
+
+  auto new_read_only_acc = store->ReadOnlyAccess(std::nullopt);
+  auto vertex = new_read_only_acc->FindVertex(gid, memgraph::storage::View::OLD);
+  ASSERT_TRUE(vertex);
+  ASSERT_EQ(*vertex->GetProperty(property, memgraph::storage::View::OLD), memgraph::storage::PropertyValue(2));
+  {
+    auto acc = store->Access();
+    EXPECT_EQ(new_read_only_acc->GraphVersion(), acc->GraphVersion());
+  }
+}
@@ -0,0 +1,202 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "storage/v2/adjacency_list.hpp"
+
+using memgraph::storage::AdjacencyList;
+using memgraph::storage::EdgeRef;
+using memgraph::storage::EdgeTypeId;
+using memgraph::storage::Gid;
+using memgraph::storage::Vertex;
+
+namespace {
+AdjacencyList::value_type MakeLink(uint64_t edge_type, uint64_t vertex, uint64_t edge) {
+  // The list never dereferences the vertex pointers, so fake ones are fine.
+  return {EdgeTypeId::FromUint(edge_type), reinterpret_cast<Vertex *>(vertex * 8), EdgeRef(Gid::FromUint(edge))};
+}
+
+std::vector<AdjacencyList::value_type> Collect(const AdjacencyList &list) {
+  return {list.begin(), list.end()};
+}
+
+bool SameLinks(std::vector<AdjacencyList::value_type> a, std::vector<AdjacencyList::value_type> b) {
+  auto cmp = [](const auto &x, const auto &y) {
+    return std::make_tuple(std::get<0>(x), std::get<1>(x), std::get<2>(x).gid) <
+           std::make_tuple(std::get<0>(y), std::get<1>(y), std::get<2>(y).gid);
+  };
+  std::sort(a.begin(), a.end(), cmp);
+  std::sort(b.begin(), b.end(), cmp);
+  return a == b;
+}
+}  // namespace
+
+TEST(AdjacencyList, Empty) {
+  AdjacencyList list;
+  ASSERT_TRUE(list.empty());
+  ASSERT_EQ(list.size(), 0);
+  ASSERT_EQ(list.begin(), list.end());
+  ASSERT_FALSE(list.contains(MakeLink(1, 1, 1)));
+  ASSERT_FALSE(list.erase(MakeLink(1, 1, 1)));
+  auto [begin, end] = list.EdgeTypeRange(EdgeTypeId::FromUint(1));
+  ASSERT_EQ(begin, end);
+}
+
+TEST(AdjacencyList, GroupedByEdgeType) {
+  AdjacencyList list;
+  list.push_back(MakeLink(3, 1, 1));
+  list.push_back(MakeLink(1, 2, 2));
+  list.push_back(MakeLink(3, 3, 3));
+  list.push_back(MakeLink(2, 4, 4));
+  list.push_back(MakeLink(1, 5, 5));
+  ASSERT_EQ(list.size(), 5);
+  ASSERT_EQ(list.edge_type_count(), 3);
+
+  std::vector<uint64_t> types;
+  for (const auto &[edge_type, vertex, edge] : list) types.push_back(edge_type.AsUint());
+  ASSERT_THAT(types, ::testing::ElementsAre(1, 1, 2, 3, 3));
+
+  auto [begin, end] = list.EdgeTypeRange(EdgeTypeId::FromUint(3));
+  std::vector<AdjacencyList::value_type> range(begin, end);
+  ASSERT_TRUE(SameLinks(range, {MakeLink(3, 1, 1), MakeLink(3, 3, 3)}));
+
+  auto [missing_begin, missing_end] = list.EdgeTypeRange(EdgeTypeId::FromUint(4));
+  ASSERT_EQ(missing_begin, missing_end);
+}
+
+TEST(AdjacencyList, EraseAndCopy) {
+  AdjacencyList list;
+  list.push_back(MakeLink(1, 1, 1));
+  list.push_back(MakeLink(2, 2, 2));
+  list.push_back(MakeLink(1, 3, 3));
+
+  AdjacencyList copy(list);
+  ASSERT_TRUE(list.erase(MakeLink(2, 2, 2)));
+  ASSERT_FALSE(list.erase(MakeLink(2, 2, 2)));
+  ASSERT_EQ(list.edge_type_count(), 1);
+  ASSERT_TRUE(SameLinks(Collect(list), {MakeLink(1, 1, 1), MakeLink(1, 3, 3)}));
+  ASSERT_TRUE(SameLinks(Collect(copy), {MakeLink(1, 1, 1), MakeLink(2, 2, 2), MakeLink(1, 3, 3)}));
+
+  ASSERT_TRUE(list.erase(MakeLink(1, 1, 1)));
+  ASSERT_TRUE(list.erase(MakeLink(1, 3, 3)));
+  ASSERT_TRUE(list.empty());
+  ASSERT_EQ(list.begin(), list.end());
+
+  AdjacencyList moved(std::move(copy));
+  ASSERT_EQ(moved.size(), 3);
+  moved.shrink_to_fit();
+  ASSERT_TRUE(moved.contains(MakeLink(2, 2, 2)));
+}
+
+TEST(AdjacencyList, RandomizedAgainstVector) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<uint64_t> type_dist(0, 7);
+  std::uniform_int_distribution<int> op_dist(0, 2);
+
+  AdjacencyList list;
+  std::vector<AdjacencyList::value_type> expected;
+  uint64_t next_edge = 0;
+  for (int i = 0; i < 5000; ++i) {
+    if (op_dist(gen) != 0 || expected.empty()) {
+      auto link = MakeLink(type_dist(gen), next_edge % 97, next_edge);
+      ++next_edge;
+      list.push_back(link);
+      expected.push_back(link);
+    } else {
+      std::uniform_int_distribution<size_t> idx_dist(0, expected.size() - 1);
+      auto idx = idx_dist(gen);
+      ASSERT_TRUE(list.erase(expected[idx]));
+      std::swap(expected[idx], expected.back());
+      expected.pop_back();
+    }
+    ASSERT_EQ(list.size(), expected.size());
+  }
+  ASSERT_TRUE(SameLinks(Collect(list), expected));
+  for (uint64_t type = 0; type <= 7; ++type) {
+    auto [begin, end] = list.EdgeTypeRange(EdgeTypeId::FromUint(type));
+    for (auto it = begin; it != end; ++it) ASSERT_EQ(it.edge_type().AsUint(), type);
+    auto count = std::count_if(expected.begin(), expected.end(),
+                               [type](const auto &link) { return std::get<0>(link).AsUint() == type; });
+    ASSERT_EQ(std::distance(begin, end), count);
+  }
+}
+
+TEST(AdjacencyList, NeighborIndex) {
+  AdjacencyList list;
+  auto const threshold = AdjacencyList::kNeighborIndexThreshold;
+  for (uint64_t i = 0; i < threshold - 1; ++i) list.push_back(MakeLink(i % 3, i % 10, i));
+  ASSERT_FALSE(list.HasNeighborIndex());
+
+  std::vector<AdjacencyList::value_type> without_index;
+  list.AppendEdgesTo(std::get<1>(MakeLink(0, 4, 0)), {EdgeTypeId::FromUint(1)}, &without_index);
+
+  list.push_back(MakeLink(0, 11, threshold - 1));
+  ASSERT_TRUE(list.HasNeighborIndex());
+  std::vector<AdjacencyList::value_type> with_index;
+  list.AppendEdgesTo(std::get<1>(MakeLink(0, 4, 0)), {EdgeTypeId::FromUint(1)}, &with_index);
+  ASSERT_FALSE(with_index.empty());
+  ASSERT_TRUE(SameLinks(with_index, without_index));
+  for (const auto &[edge_type, vertex, edge] : with_index) {
+    ASSERT_EQ(edge_type.AsUint(), 1);
+    ASSERT_EQ(vertex, std::get<1>(MakeLink(0, 4, 0)));
+  }
+
+  std::vector<AdjacencyList::value_type> all_types;
+  list.AppendEdgesTo(std::get<1>(MakeLink(0, 11, 0)), {}, &all_types);
+  ASSERT_TRUE(SameLinks(all_types, {MakeLink(0, 11, threshold - 1)}));
+
+  // The index survives copies and goes away once the list shrinks enough.
+  AdjacencyList copy(list);
+  ASSERT_TRUE(copy.HasNeighborIndex());
+  for (uint64_t i = 0; i < threshold - 1; ++i) ASSERT_TRUE(list.erase(MakeLink(i % 3, i % 10, i)));
+  ASSERT_FALSE(list.HasNeighborIndex());
+  ASSERT_TRUE(SameLinks(Collect(list), {MakeLink(0, 11, threshold - 1)}));
+  ASSERT_TRUE(copy.contains(MakeLink(2, 5, 5)));
+}
+
+TEST(AdjacencyList, EraseIf) {
+  AdjacencyList list;
+  std::vector<AdjacencyList::value_type> expected;
+  auto const threshold = AdjacencyList::kNeighborIndexThreshold;
+  for (uint64_t i = 0; i < 2 * threshold; ++i) {
+    auto link = MakeLink(i % 4, i % 10, i);
+    list.push_back(link);
+    if (i % 4 != 1 && i % 10 >= 3) expected.push_back(link);
+  }
+  ASSERT_TRUE(list.HasNeighborIndex());
+
+  // A whole group and some links of the other groups.
+  auto const removed = list.erase_if([](const AdjacencyList::value_type &link) {
+    return std::get<0>(link).AsUint() == 1 || std::get<1>(link) < std::get<1>(MakeLink(0, 3, 0));
+  });
+  ASSERT_EQ(removed, 2 * threshold - expected.size());
+  ASSERT_EQ(list.size(), expected.size());
+  ASSERT_EQ(list.edge_type_count(), 3);
+  ASSERT_TRUE(SameLinks(Collect(list), expected));
+  ASSERT_TRUE(list.HasNeighborIndex());
+  std::vector<AdjacencyList::value_type> to_neighbor;
+  list.AppendEdgesTo(std::get<1>(MakeLink(0, 4, 0)), {}, &to_neighbor);
+  ASSERT_EQ(to_neighbor.size(), std::count_if(expected.begin(), expected.end(), [](const auto &link) {
+              return std::get<1>(link) == std::get<1>(MakeLink(0, 4, 0));
+            }));
+
+  ASSERT_EQ(list.erase_if([](const auto &) { return false; }), 0);
+  ASSERT_EQ(list.erase_if([](const auto &) { return true; }), expected.size());
+  ASSERT_TRUE(list.empty());
+  ASSERT_EQ(list.edge_type_count(), 0);
+  ASSERT_FALSE(list.HasNeighborIndex());
+}
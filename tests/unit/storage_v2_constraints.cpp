@@ -1072,3 +1072,60 @@ TYPED_TEST(ConstraintsTest, UniqueConstraintsClearOldData) {
     ASSERT_EQ(disk_test_utils::GetRealNumberOfEntriesInRocksDB(tx_db), 1);
   }
 }
+
+TYPED_TEST(ConstraintsTest, UniqueConstraintsHashIndex) {
+  if constexpr ((std::is_same_v<TypeParam, memgraph::storage::InMemoryStorage>)) {
+    memgraph::storage::Config config;
+    config.constraints.unique_hash_index = true;
+    this->storage = std::make_unique<memgraph::storage::InMemoryStorage>(config);
+    {
+      auto res = this->storage->CreateUniqueConstraint(this->label1, {this->prop1, this->prop2}, {});
+      ASSERT_TRUE(res.HasValue());
+      ASSERT_EQ(res.GetValue(), UniqueConstraints::CreationStatus::SUCCESS);
+    }
+
+    Gid gid;
+    {
+      auto acc = this->storage->Access();
+      auto vertex = acc->CreateVertex();
+      gid = vertex.Gid();
+      ASSERT_NO_ERROR(vertex.AddLabel(this->label1));
+      ASSERT_NO_ERROR(vertex.SetProperty(this->prop1, PropertyValue(1)));
+      ASSERT_NO_ERROR(vertex.SetProperty(this->prop2, PropertyValue("a")));
+      ASSERT_NO_ERROR(acc->Commit());
+    }
+
+    {
+      // Equal values of different numeric types violate the constraint.
+      auto acc = this->storage->Access();
+      auto vertex = acc->CreateVertex();
+      ASSERT_NO_ERROR(vertex.AddLabel(this->label1));
+      ASSERT_NO_ERROR(vertex.SetProperty(this->prop1, PropertyValue(1.0)));
+      ASSERT_NO_ERROR(vertex.SetProperty(this->prop2, PropertyValue("a")));
+      auto res = acc->Commit();
+      ASSERT_TRUE(res.HasError());
+      EXPECT_EQ(std::get<ConstraintViolation>(res.GetError()),
+                (ConstraintViolation{ConstraintViolation::Type::UNIQUE, this->label1,
+                                     std::set<PropertyId>{this->prop1, this->prop2}}));
+    }
+
+    {
+      auto acc = this->storage->Access();
+      auto vertex = acc->FindVertex(gid, View::OLD);
+      ASSERT_TRUE(vertex);
+      ASSERT_NO_ERROR(vertex->SetProperty(this->prop1, PropertyValue(2)));
+      ASSERT_NO_ERROR(acc->Commit());
+    }
+    this->storage->FreeMemory();
+
+    {
+      // The old values are free once their vertex changed them.
+      auto acc = this->storage->Access();
+      auto vertex = acc->CreateVertex();
+      ASSERT_NO_ERROR(vertex.AddLabel(this->label1));
+      ASSERT_NO_ERROR(vertex.SetProperty(this->prop1, PropertyValue(1)));
+      ASSERT_NO_ERROR(vertex.SetProperty(this->prop2, PropertyValue("a")));
+      ASSERT_NO_ERROR(acc->Commit());
+    }
+  }
+}
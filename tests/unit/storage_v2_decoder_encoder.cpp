@@ -12,9 +12,12 @@
 #include <gtest/gtest.h>
 
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <limits>
 
 #include "storage/v2/durability/serialization.hpp"
+#include "storage/v2/durability/wal.hpp"
 #include "storage/v2/property_value.hpp"
 #include "storage/v2/temporal.hpp"
 
@@ -355,6 +358,14 @@ TEST_F(DecoderEncoderTest, PropertyValueInvalidMarker) {
         case memgraph::storage::durability::Marker::DELTA_EXISTENCE_CONSTRAINT_DROP:
         case memgraph::storage::durability::Marker::DELTA_UNIQUE_CONSTRAINT_CREATE:
         case memgraph::storage::durability::Marker::DELTA_UNIQUE_CONSTRAINT_DROP:
+        case memgraph::storage::durability::Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+        case memgraph::storage::durability::Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+        case memgraph::storage::durability::Marker::DELTA_TEXT_INDEX_CREATE:
+        case memgraph::storage::durability::Marker::DELTA_TEXT_INDEX_DROP:
+        case memgraph::storage::durability::Marker::DELTA_VECTOR_INDEX_CREATE:
+        case memgraph::storage::durability::Marker::DELTA_VECTOR_INDEX_DROP:
+        case memgraph::storage::durability::Marker::DELTA_AGGREGATE_INDEX_CREATE:
+        case memgraph::storage::durability::Marker::DELTA_AGGREGATE_INDEX_DROP:
         case memgraph::storage::durability::Marker::VALUE_FALSE:
         case memgraph::storage::durability::Marker::VALUE_TRUE:
           valid_marker = false;
@@ -459,3 +470,100 @@ TEST_F(DecoderEncoderTest, EncoderPosition) {
     ASSERT_EQ(pos, decoder.GetSize());
   }
 }
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(DecoderEncoderTest, BlockCompression) {
+  const uint64_t kBlockSize = 64;
+  const uint64_t kValues = 100;
+  uint64_t offset_values = 0;
+  uint64_t offset_last_value = 0;
+  uint64_t offset_blocks = 0;
+  {
+    memgraph::storage::durability::Encoder encoder;
+    encoder.Initialize(storage_file, kTestMagic, kTestVersion);
+    encoder.WriteUint(0);
+    encoder.EnableBlockCompression(kBlockSize);
+    offset_values = encoder.GetPosition();
+    for (uint64_t i = 0; i < kValues; ++i) {
+      if (i == kValues - 1) offset_last_value = encoder.GetPosition();
+      encoder.WriteString("value " + std::to_string(i));
+    }
+    offset_blocks = encoder.FinishBlockCompression();
+    encoder.SetPosition(kTestMagic.size() + sizeof(kTestVersion));
+    encoder.WriteUint(offset_blocks);
+    encoder.Finalize();
+  }
+  {
+    memgraph::storage::durability::Decoder decoder;
+    auto version = decoder.Initialize(storage_file, kTestMagic);
+    ASSERT_TRUE(version);
+    ASSERT_EQ(*version, kTestVersion);
+    auto offset = decoder.ReadUint();
+    ASSERT_TRUE(offset);
+    ASSERT_EQ(*offset, offset_blocks);
+    ASSERT_TRUE(decoder.EnableBlockDecompression(*offset));
+    ASSERT_EQ(decoder.GetPosition(), offset_values);
+    for (uint64_t i = 0; i < kValues; ++i) {
+      auto decoded = decoder.ReadString();
+      ASSERT_TRUE(decoded);
+      ASSERT_EQ(*decoded, "value " + std::to_string(i));
+    }
+    ASSERT_EQ(decoder.GetPosition(), decoder.GetSize());
+    ASSERT_FALSE(decoder.ReadString());
+
+    // Blocks can be read in any order.
+    ASSERT_TRUE(decoder.SetPosition(offset_last_value));
+    auto last = decoder.ReadString();
+    ASSERT_TRUE(last);
+    ASSERT_EQ(*last, "value " + std::to_string(kValues - 1));
+    ASSERT_TRUE(decoder.SetPosition(offset_values));
+    auto first = decoder.ReadString();
+    ASSERT_TRUE(first);
+    ASSERT_EQ(*first, "value 0");
+  }
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(DecoderEncoderTest, BufferEncoder) {
+  auto write = [](memgraph::storage::durability::BaseEncoder *encoder) {
+    encoder->WriteMarker(memgraph::storage::durability::Marker::SECTION_DELTA);
+    encoder->WriteBool(true);
+    encoder->WriteUint(42);
+    encoder->WriteDouble(1.5);
+    encoder->WriteString("hello");
+    encoder->WritePropertyValue(memgraph::storage::PropertyValue(std::vector<memgraph::storage::PropertyValue>{
+        memgraph::storage::PropertyValue(), memgraph::storage::PropertyValue("world"),
+        memgraph::storage::PropertyValue(std::map<std::string, memgraph::storage::PropertyValue>{
+            {"key", memgraph::storage::PropertyValue(-1)}})}));
+  };
+  {
+    memgraph::storage::durability::Encoder encoder;
+    encoder.Initialize(storage_file);
+    write(&encoder);
+    encoder.Finalize();
+  }
+  memgraph::storage::durability::BufferEncoder buffer_encoder;
+  write(&buffer_encoder);
+
+  std::ifstream file(storage_file, std::ios::binary);
+  std::vector<uint8_t> file_data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  ASSERT_EQ(buffer_encoder.GetBuffer(), file_data);
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(DecoderEncoderTest, EncodedDeltasTimestamp) {
+  memgraph::storage::durability::EncodedDeltas deltas;
+  memgraph::storage::durability::BufferEncoder encoder;
+  for (int i = 0; i < 2; ++i) {
+    deltas.headers.push_back(encoder.GetBuffer().size());
+    memgraph::storage::durability::EncodeTransactionEnd(&encoder, 0);
+  }
+  deltas.data = encoder.ReleaseBuffer();
+  deltas.SetTimestamp(42);
+
+  memgraph::storage::durability::BufferEncoder expected;
+  for (int i = 0; i < 2; ++i) {
+    memgraph::storage::durability::EncodeTransactionEnd(&expected, 42);
+  }
+  ASSERT_EQ(deltas.data, expected.GetBuffer());
+}
@@ -14,8 +14,13 @@
 #include "disk_test_utils.hpp"
 #include "storage/v2/disk/storage.hpp"
 #include "storage/v2/inmemory/storage.hpp"
+#include "utils/event_gauge.hpp"
 #include "utils/file.hpp"
 
+namespace memgraph::metrics {
+extern const Event DiskBytesWritten;
+}  // namespace memgraph::metrics
+
 class DiskStorageTest : public ::testing::TestWithParam<bool> {};
 
 TEST_F(DiskStorageTest, CreateDiskStorageInDataDirectory) {
@@ -27,3 +32,318 @@ TEST_F(DiskStorageTest, CreateDiskStorageInDataDirectory) {
 
   disk_test_utils::RemoveRocksDbDirs(testSuite);
 }
+
+TEST_F(DiskStorageTest, TunedRocksDBOptions) {
+  const std::string testSuite = "storage_v2_disk_tuned";
+
+  memgraph::storage::Config config = disk_test_utils::GenerateOnDiskConfig(testSuite);
+  config.disk.block_cache_size_mib = 8;
+  config.disk.bloom_filter_bits_per_key = 10;
+  config.disk.universal_compaction = true;
+  memgraph::storage::Gid gid;
+  {
+    std::unique_ptr<memgraph::storage::Storage> storage(new memgraph::storage::DiskStorage(config));
+    auto acc = storage->Access();
+    gid = acc->CreateVertex().Gid();
+    ASSERT_FALSE(acc->Commit().HasError());
+    // RocksDB statistics are exported together with the storage info
+    storage->GetInfo();
+    ASSERT_GT(memgraph::metrics::global_gauges[memgraph::metrics::DiskBytesWritten].load(), 0);
+  }
+  {
+    std::unique_ptr<memgraph::storage::Storage> storage(new memgraph::storage::DiskStorage(config));
+    auto acc = storage->Access();
+    ASSERT_TRUE(acc->FindVertex(gid, memgraph::storage::View::OLD));
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  disk_test_utils::RemoveRocksDbDirs(testSuite);
+}
+
+TEST_F(DiskStorageTest, ObjectCacheVisibility) {
+  memgraph::storage::DiskObjectCache cache(2);
+  const auto gid = memgraph::storage::Gid::FromUint(1);
+
+  cache.Insert(gid, "key", "value", 5);
+  ASSERT_EQ(cache.Find(gid, 6), std::make_optional(std::make_pair(std::string("key"), std::string("value"))));
+
+  // Transactions started before the commit can't cache what they read anymore.
+  cache.Invalidate(gid, 10);
+  ASSERT_FALSE(cache.Find(gid, 11));
+  cache.Insert(gid, "key", "old", 7);
+  ASSERT_FALSE(cache.Find(gid, 11));
+
+  cache.Insert(gid, "key", "new", 10);
+  ASSERT_FALSE(cache.Find(gid, 9));
+  ASSERT_EQ(cache.Find(gid, 10)->second, "new");
+
+  // Least recently used entries are evicted.
+  cache.Insert(memgraph::storage::Gid::FromUint(2), "key", "value", 10);
+  cache.Insert(memgraph::storage::Gid::FromUint(3), "key", "value", 10);
+  ASSERT_FALSE(cache.Find(gid, 10));
+}
+
+TEST_F(DiskStorageTest, ObjectCacheSeesCommittedChanges) {
+  const std::string testSuite = "storage_v2_disk_object_cache";
+
+  memgraph::storage::Config config = disk_test_utils::GenerateOnDiskConfig(testSuite);
+  config.disk.object_cache_size = 16;
+  std::unique_ptr<memgraph::storage::Storage> storage(new memgraph::storage::DiskStorage(config));
+  memgraph::storage::Gid gid;
+  memgraph::storage::PropertyId property;
+  {
+    auto acc = storage->Access();
+    auto vertex = acc->CreateVertex();
+    gid = vertex.Gid();
+    property = acc->NameToProperty("property");
+    ASSERT_TRUE(vertex.SetProperty(property, memgraph::storage::PropertyValue(1)).HasValue());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  {
+    auto acc = storage->Access();
+    auto vertex = acc->FindVertex(gid, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex);
+    ASSERT_EQ(*vertex->GetProperty(property, memgraph::storage::View::OLD), memgraph::storage::PropertyValue(1));
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  auto old_acc = storage->Access();
+  {
+    auto acc = storage->Access();
+    auto vertex = acc->FindVertex(gid, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex);
+    ASSERT_TRUE(vertex->SetProperty(property, memgraph::storage::PropertyValue(2)).HasValue());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  {
+    auto acc = storage->Access();
+    auto vertex = acc->FindVertex(gid, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex);
+    ASSERT_EQ(*vertex->GetProperty(property, memgraph::storage::View::OLD), memgraph::storage::PropertyValue(2));
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  {
+    auto vertex = old_acc->FindVertex(gid, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex);
+    ASSERT_EQ(*vertex->GetProperty(property, memgraph::storage::View::OLD), memgraph::storage::PropertyValue(1));
+    ASSERT_FALSE(old_acc->Commit().HasError());
+  }
+  old_acc.reset();
+  storage.reset();
+
+  disk_test_utils::RemoveRocksDbDirs(testSuite);
+}
+
+TEST_F(DiskStorageTest, BulkImport) {
+  const std::string testSuite = "storage_v2_disk_bulk_import";
+
+  memgraph::storage::Config config = disk_test_utils::GenerateOnDiskConfig(testSuite);
+  config.items.properties_on_edges = true;
+  std::unique_ptr<memgraph::storage::Storage> storage(new memgraph::storage::DiskStorage(config));
+  const auto label = storage->NameToLabel("label");
+  const auto property = storage->NameToProperty("property");
+  const auto edge_type = storage->NameToEdgeType("edge_type");
+  ASSERT_FALSE(storage->CreateIndex(label).HasError());
+
+  auto *disk_storage = static_cast<memgraph::storage::DiskStorage *>(storage.get());
+  auto vertices = disk_storage->BulkImportVertices(
+      {{.labels = {label}, .properties = {{property, memgraph::storage::PropertyValue(1)}}},
+       {.labels = {}, .properties = {}}});
+  ASSERT_FALSE(vertices.HasError());
+  ASSERT_EQ(vertices->size(), 2);
+  const auto gid_from = (*vertices)[0];
+  const auto gid_to = (*vertices)[1];
+  auto edges = disk_storage->BulkImportEdges({{.from = gid_from,
+                                               .to = gid_to,
+                                               .edge_type = edge_type,
+                                               .properties = {{property, memgraph::storage::PropertyValue(2)}}}});
+  ASSERT_EQ(edges.size(), 1);
+
+  {
+    auto acc = storage->Access();
+    uint64_t indexed = 0;
+    for (auto vertex : acc->Vertices(label, memgraph::storage::View::OLD)) {
+      ASSERT_TRUE(*vertex.HasLabel(label, memgraph::storage::View::OLD));
+      ++indexed;
+    }
+    ASSERT_EQ(indexed, 1);
+
+    auto vertex_from = acc->FindVertex(gid_from, memgraph::storage::View::OLD);
+    auto vertex_to = acc->FindVertex(gid_to, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex_from);
+    ASSERT_TRUE(vertex_to);
+    ASSERT_TRUE(*vertex_from->HasLabel(label, memgraph::storage::View::OLD));
+    ASSERT_EQ(*vertex_from->GetProperty(property, memgraph::storage::View::OLD), memgraph::storage::PropertyValue(1));
+
+    acc->PrefetchOutEdges(*vertex_from);
+    acc->PrefetchInEdges(*vertex_to);
+    auto out_edges = vertex_from->OutEdges(memgraph::storage::View::OLD).GetValue();
+    ASSERT_EQ(out_edges.size(), 1);
+    ASSERT_EQ(out_edges[0].Gid(), edges[0]);
+    ASSERT_EQ(out_edges[0].EdgeType(), edge_type);
+    ASSERT_EQ(*out_edges[0].GetProperty(property, memgraph::storage::View::OLD), memgraph::storage::PropertyValue(2));
+    ASSERT_EQ(vertex_to->InEdges(memgraph::storage::View::OLD)->size(), 1);
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  ASSERT_EQ(storage->GetInfo().vertex_count, 2);
+  ASSERT_EQ(storage->GetInfo().edge_count, 1);
+  storage.reset();
+
+  disk_test_utils::RemoveRocksDbDirs(testSuite);
+}
+
+TEST_F(DiskStorageTest, IndexWritesCommittedWithTransaction) {
+  const std::string testSuite = "storage_v2_disk_index_writes";
+
+  memgraph::storage::Config config = disk_test_utils::GenerateOnDiskConfig(testSuite);
+  config.disk.pipelined_write = true;
+  std::unique_ptr<memgraph::storage::Storage> storage(new memgraph::storage::DiskStorage(config));
+  const auto label = storage->NameToLabel("label");
+  const auto property = storage->NameToProperty("property");
+  ASSERT_FALSE(storage->CreateIndex(label).HasError());
+  ASSERT_FALSE(storage->CreateIndex(label, property).HasError());
+
+  auto count_indexed = [&](auto &acc) {
+    uint64_t label_count = 0;
+    for ([[maybe_unused]] auto vertex : acc->Vertices(label, memgraph::storage::View::OLD)) {
+      ++label_count;
+    }
+    uint64_t label_property_count = 0;
+    for ([[maybe_unused]] auto vertex : acc->Vertices(label, property, memgraph::storage::View::OLD)) {
+      ++label_property_count;
+    }
+    return std::make_pair(label_count, label_property_count);
+  };
+
+  memgraph::storage::Gid gid;
+  {
+    auto acc = storage->Access();
+    auto vertex = acc->CreateVertex();
+    gid = vertex.Gid();
+    ASSERT_TRUE(vertex.AddLabel(label).HasValue());
+    ASSERT_TRUE(vertex.SetProperty(property, memgraph::storage::PropertyValue(1)).HasValue());
+    acc->Abort();
+  }
+  {
+    auto acc = storage->Access();
+    ASSERT_EQ(count_indexed(acc), std::make_pair(uint64_t{0}, uint64_t{0}));
+    auto vertex = acc->CreateVertex();
+    gid = vertex.Gid();
+    ASSERT_TRUE(vertex.AddLabel(label).HasValue());
+    ASSERT_TRUE(vertex.SetProperty(property, memgraph::storage::PropertyValue(1)).HasValue());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  {
+    auto acc = storage->Access();
+    ASSERT_EQ(count_indexed(acc), std::make_pair(uint64_t{1}, uint64_t{1}));
+    auto vertex = acc->FindVertex(gid, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex);
+    ASSERT_TRUE(acc->DeleteVertex(&*vertex).HasValue());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  {
+    auto acc = storage->Access();
+    ASSERT_EQ(count_indexed(acc), std::make_pair(uint64_t{0}, uint64_t{0}));
+  }
+  storage.reset();
+
+  disk_test_utils::RemoveRocksDbDirs(testSuite);
+}
+
+TEST_F(DiskStorageTest, PrefetchEdgesOfVertices) {
+  const std::string testSuite = "storage_v2_disk_prefetch_edges";
+
+  memgraph::storage::Config config = disk_test_utils::GenerateOnDiskConfig(testSuite);
+  config.items.properties_on_edges = true;
+  std::unique_ptr<memgraph::storage::Storage> storage(new memgraph::storage::DiskStorage(config));
+  const auto edge_type = storage->NameToEdgeType("edge_type");
+  memgraph::storage::Gid gid_a;
+  memgraph::storage::Gid gid_b;
+  memgraph::storage::Gid gid_c;
+  {
+    auto acc = storage->Access();
+    auto a = acc->CreateVertex();
+    auto b = acc->CreateVertex();
+    auto c = acc->CreateVertex();
+    gid_a = a.Gid();
+    gid_b = b.Gid();
+    gid_c = c.Gid();
+    ASSERT_TRUE(acc->CreateEdge(&a, &b, edge_type).HasValue());
+    ASSERT_TRUE(acc->CreateEdge(&a, &c, edge_type).HasValue());
+    ASSERT_TRUE(acc->CreateEdge(&b, &c, edge_type).HasValue());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  {
+    auto acc = storage->Access();
+    auto a = acc->FindVertex(gid_a, memgraph::storage::View::OLD);
+    auto b = acc->FindVertex(gid_b, memgraph::storage::View::OLD);
+    ASSERT_TRUE(a);
+    ASSERT_TRUE(b);
+    acc->PrefetchOutEdges(std::vector<memgraph::storage::VertexAccessor>{*a, *b});
+    ASSERT_EQ(a->OutEdges(memgraph::storage::View::OLD)->size(), 2);
+    ASSERT_EQ(b->OutEdges(memgraph::storage::View::OLD)->size(), 1);
+
+    // The edges which are already loaded aren't loaded again.
+    auto c = acc->FindVertex(gid_c, memgraph::storage::View::OLD);
+    ASSERT_TRUE(c);
+    ASSERT_EQ(c->InEdges(memgraph::storage::View::OLD)->size(), 2);
+    acc->PrefetchInEdges(std::vector<memgraph::storage::VertexAccessor>{*b, *c});
+    ASSERT_EQ(b->InEdges(memgraph::storage::View::OLD)->size(), 1);
+    ASSERT_EQ(c->InEdges(memgraph::storage::View::OLD)->size(), 2);
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  storage.reset();
+
+  disk_test_utils::RemoveRocksDbDirs(testSuite);
+}
+
+TEST_F(DiskStorageTest, EdgeImportMode) {
+  const std::string testSuite = "storage_v2_disk_edge_import_mode";
+
+  memgraph::storage::Config config = disk_test_utils::GenerateOnDiskConfig(testSuite);
+  std::unique_ptr<memgraph::storage::Storage> storage(new memgraph::storage::DiskStorage(config));
+  auto *disk_storage = static_cast<memgraph::storage::DiskStorage *>(storage.get());
+  const auto edge_type = storage->NameToEdgeType("edge_type");
+  memgraph::storage::Gid gid_a;
+  memgraph::storage::Gid gid_b;
+  {
+    auto acc = storage->Access();
+    gid_a = acc->CreateVertex().Gid();
+    gid_b = acc->CreateVertex().Gid();
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  auto create_edge = [&] {
+    auto acc = storage->Access();
+    auto a = acc->FindVertex(gid_a, memgraph::storage::View::OLD);
+    auto b = acc->FindVertex(gid_b, memgraph::storage::View::OLD);
+    ASSERT_TRUE(a);
+    ASSERT_TRUE(b);
+    ASSERT_TRUE(acc->CreateEdge(&*a, &*b, edge_type).HasValue());
+    ASSERT_FALSE(acc->Commit().HasError());
+  };
+  auto out_degree = [&] {
+    auto acc = storage->Access();
+    auto a = acc->FindVertex(gid_a, memgraph::storage::View::OLD);
+    return a ? a->OutEdges(memgraph::storage::View::OLD)->size() : size_t{0};
+  };
+
+  disk_storage->SetEdgeImportMode(true);
+  ASSERT_TRUE(disk_storage->IsEdgeImportModeActive());
+  create_edge();
+  // The imported edge doesn't have its adjacency entries until the mode is deactivated.
+  ASSERT_EQ(out_degree(), 0);
+  disk_storage->SetEdgeImportMode(false);
+  ASSERT_FALSE(disk_storage->IsEdgeImportModeActive());
+  ASSERT_EQ(out_degree(), 1);
+
+  // A storage closed in the mode fixes up the adjacency when it's opened.
+  disk_storage->SetEdgeImportMode(true);
+  create_edge();
+  storage.reset();
+  storage.reset(new memgraph::storage::DiskStorage(config));
+  disk_storage = static_cast<memgraph::storage::DiskStorage *>(storage.get());
+  ASSERT_FALSE(disk_storage->IsEdgeImportModeActive());
+  ASSERT_EQ(out_degree(), 2);
+  storage.reset();
+
+  disk_test_utils::RemoveRocksDbDirs(testSuite);
+}
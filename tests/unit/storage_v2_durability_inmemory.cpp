@@ -699,6 +699,40 @@ TEST_P(DurabilityTest, SnapshotOnExit) {
   }
 }
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(DurabilityTest, SnapshotOnExitParallelIndexRecovery) {
+  // Create snapshot.
+  {
+    std::unique_ptr<memgraph::storage::Storage> store(new memgraph::storage::InMemoryStorage(
+        {.items = {.properties_on_edges = GetParam()},
+         .durability = {.storage_directory = storage_directory, .snapshot_on_exit = true, .items_per_batch = 13}}));
+    CreateBaseDataset(store.get(), GetParam());
+    CreateExtendedDataset(store.get());
+    VerifyDataset(store.get(), DatasetType::BASE_WITH_EXTENDED, GetParam());
+  }
+
+  ASSERT_EQ(GetSnapshotsList().size(), 1);
+  ASSERT_EQ(GetWalsList().size(), 0);
+
+  // Recover snapshot, the indices are populated while the vertices are loaded.
+  std::unique_ptr<memgraph::storage::Storage> store(new memgraph::storage::InMemoryStorage(
+      {.items = {.properties_on_edges = GetParam()},
+       .durability = {.storage_directory = storage_directory,
+                      .recover_on_startup = true,
+                      .items_per_batch = 13,
+                      .recovery_thread_count = 4,
+                      .allow_parallel_index_creation = true}}));
+  VerifyDataset(store.get(), DatasetType::BASE_WITH_EXTENDED, GetParam());
+
+  // Try to use the storage.
+  {
+    auto acc = store->Access();
+    auto vertex = acc->CreateVertex();
+    ASSERT_TRUE(vertex.AddLabel(store->NameToLabel("base_indexed")).HasValue());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TEST_P(DurabilityTest, SnapshotPeriodic) {
   // Create snapshot.
@@ -1193,6 +1227,50 @@ TEST_P(DurabilityTest, WalBasic) {
   }
 }
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(DurabilityTest, WalGroupCommit) {
+  const uint64_t kThreads = 4;
+  const uint64_t kTransactionsPerThread = 500;
+  // Create WALs from concurrent commits. The small WAL files make sure that
+  // some syncs race with finalizing the current WAL file.
+  {
+    std::unique_ptr<memgraph::storage::Storage> store(new memgraph::storage::InMemoryStorage(
+        {.items = {.properties_on_edges = GetParam()},
+         .durability = {
+             .storage_directory = storage_directory,
+             .snapshot_wal_mode = memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL,
+             .snapshot_interval = std::chrono::minutes(20),
+             .wal_file_size_kibibytes = 1,
+             .wal_group_commit = true}}));
+    std::vector<std::thread> threads;
+    threads.reserve(kThreads);
+    for (uint64_t i = 0; i < kThreads; ++i) {
+      threads.emplace_back([&] {
+        for (uint64_t j = 0; j < kTransactionsPerThread; ++j) {
+          auto acc = store->Access();
+          acc->CreateVertex();
+          MG_ASSERT(!acc->Commit().HasError(), "Couldn't commit transaction!");
+        }
+      });
+    }
+    for (auto &thread : threads) thread.join();
+  }
+
+  ASSERT_EQ(GetSnapshotsList().size(), 0);
+  ASSERT_GE(GetWalsList().size(), 2);
+
+  // Recover WALs.
+  std::unique_ptr<memgraph::storage::Storage> store(new memgraph::storage::InMemoryStorage(
+      {.items = {.properties_on_edges = GetParam()},
+       .durability = {.storage_directory = storage_directory, .recover_on_startup = true}}));
+  uint64_t count = 0;
+  auto acc = store->Access();
+  for ([[maybe_unused]] auto vertex : acc->Vertices(memgraph::storage::View::OLD)) {
+    ++count;
+  }
+  ASSERT_EQ(count, kThreads * kTransactionsPerThread);
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TEST_P(DurabilityTest, WalBackup) {
   // Create WALs.
@@ -3412,6 +3412,87 @@ TEST_P(StorageEdgeTest, VertexDetachDeleteSingleCommit) {
   }
 }
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(StorageEdgeTest, VertexDetachDeleteManyAbortAndCommit) {
+  std::unique_ptr<memgraph::storage::Storage> store(
+      new memgraph::storage::InMemoryStorage({.items = {.properties_on_edges = GetParam()}}));
+  // The hub has enough edges for the neighbor index of its adjacency lists.
+  const uint64_t kLeaves = 300;
+  memgraph::storage::Gid gid_hub;
+  memgraph::storage::Gid gid_target1;
+  memgraph::storage::Gid gid_target2;
+
+  {
+    auto acc = store->Access();
+    auto et = acc->NameToEdgeType("et");
+    auto hub = acc->CreateVertex();
+    auto target1 = acc->CreateVertex();
+    auto target2 = acc->CreateVertex();
+    gid_hub = hub.Gid();
+    gid_target1 = target1.Gid();
+    gid_target2 = target2.Gid();
+    for (uint64_t i = 0; i < kLeaves; ++i) {
+      auto leaf = acc->CreateVertex();
+      ASSERT_TRUE(acc->CreateEdge(&hub, &leaf, et).HasValue());
+    }
+    ASSERT_TRUE(acc->CreateEdge(&hub, &target1, et).HasValue());
+    ASSERT_TRUE(acc->CreateEdge(&target2, &hub, et).HasValue());
+    ASSERT_TRUE(acc->CreateEdge(&target1, &target2, et).HasValue());
+    ASSERT_TRUE(acc->CreateEdge(&target1, &target1, et).HasValue());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  ASSERT_EQ(store->GetInfo().edge_count, kLeaves + 4);
+
+  auto detach_delete = [&](auto *acc) {
+    auto hub = acc->FindVertex(gid_hub, memgraph::storage::View::OLD);
+    auto target1 = acc->FindVertex(gid_target1, memgraph::storage::View::OLD);
+    auto target2 = acc->FindVertex(gid_target2, memgraph::storage::View::OLD);
+    ASSERT_TRUE(hub && target1 && target2);
+    auto ret = acc->DetachDeleteVertices({&*target2, &*target1, &*target2});
+    ASSERT_TRUE(ret.HasValue());
+    ASSERT_EQ(ret->first.size(), 2);
+    ASSERT_EQ(ret->second.size(), 4);
+    ASSERT_EQ(*hub->OutDegree(memgraph::storage::View::NEW), kLeaves);
+    ASSERT_EQ(*hub->InDegree(memgraph::storage::View::NEW), 0);
+    ASSERT_EQ(*hub->OutDegree(memgraph::storage::View::OLD), kLeaves + 1);
+    ASSERT_EQ(*hub->InDegree(memgraph::storage::View::OLD), 1);
+    ASSERT_EQ(target1->OutEdges(memgraph::storage::View::NEW).GetError(), memgraph::storage::Error::DELETED_OBJECT);
+    ASSERT_EQ(*target1->OutDegree(memgraph::storage::View::OLD), 2);
+    ASSERT_EQ(*target1->InDegree(memgraph::storage::View::OLD), 2);
+    // Deleting them again deletes nothing.
+    auto again = acc->DetachDeleteVertices({&*target1});
+    ASSERT_TRUE(again.HasValue());
+    ASSERT_TRUE(again->first.empty());
+    ASSERT_TRUE(again->second.empty());
+  };
+
+  {
+    auto acc = store->Access();
+    detach_delete(acc.get());
+    acc->Abort();
+  }
+  ASSERT_EQ(store->GetInfo().edge_count, kLeaves + 4);
+  {
+    auto acc = store->Access();
+    auto hub = acc->FindVertex(gid_hub, memgraph::storage::View::OLD);
+    ASSERT_TRUE(hub);
+    ASSERT_EQ(*hub->OutDegree(memgraph::storage::View::OLD), kLeaves + 1);
+    ASSERT_EQ(*hub->InDegree(memgraph::storage::View::OLD), 1);
+    detach_delete(acc.get());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  ASSERT_EQ(store->GetInfo().edge_count, kLeaves);
+  {
+    auto acc = store->Access();
+    auto hub = acc->FindVertex(gid_hub, memgraph::storage::View::OLD);
+    ASSERT_TRUE(hub);
+    ASSERT_FALSE(acc->FindVertex(gid_target1, memgraph::storage::View::OLD));
+    ASSERT_FALSE(acc->FindVertex(gid_target2, memgraph::storage::View::OLD));
+    ASSERT_EQ(*hub->OutDegree(memgraph::storage::View::OLD), kLeaves);
+    ASSERT_EQ(*hub->InDegree(memgraph::storage::View::OLD), 0);
+  }
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TEST_P(StorageEdgeTest, VertexDetachDeleteMultipleCommit) {
   std::unique_ptr<memgraph::storage::Storage> store(
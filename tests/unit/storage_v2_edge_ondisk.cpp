@@ -5813,3 +5813,69 @@ TEST(StorageWithProperties, EdgeNonexistentPropertyAPI) {
   ASSERT_FALSE(acc->Commit().HasError());
   disk_test_utils::RemoveRocksDbDirs(testSuite);
 }
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(StorageEdgeTest, EdgePrefetchOnlyVertexEdges) {
+  auto config = disk_test_utils::GenerateOnDiskConfig(testSuite);
+  config.items.properties_on_edges = GetParam();
+  std::unique_ptr<memgraph::storage::Storage> store(new memgraph::storage::DiskStorage(config));
+  memgraph::storage::Gid gid_a = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
+  memgraph::storage::Gid gid_b = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
+  memgraph::storage::Gid gid_c = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
+  memgraph::storage::Gid gid_ab = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
+
+  {
+    auto acc = store->Access();
+    auto vertex_a = acc->CreateVertex();
+    auto vertex_b = acc->CreateVertex();
+    auto vertex_c = acc->CreateVertex();
+    gid_a = vertex_a.Gid();
+    gid_b = vertex_b.Gid();
+    gid_c = vertex_c.Gid();
+    auto et = acc->NameToEdgeType("et");
+    auto edge_ab = acc->CreateEdge(&vertex_a, &vertex_b, et);
+    ASSERT_TRUE(edge_ab.HasValue());
+    gid_ab = edge_ab->Gid();
+    ASSERT_TRUE(acc->CreateEdge(&vertex_a, &vertex_c, et).HasValue());
+    ASSERT_TRUE(acc->CreateEdge(&vertex_c, &vertex_a, et).HasValue());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  {
+    auto acc = store->Access();
+    auto vertex_a = acc->FindVertex(gid_a, memgraph::storage::View::OLD);
+    auto vertex_b = acc->FindVertex(gid_b, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex_a);
+    ASSERT_TRUE(vertex_b);
+    acc->PrefetchOutEdges(*vertex_a);
+    acc->PrefetchInEdges(*vertex_a);
+    acc->PrefetchOutEdges(*vertex_b);
+    acc->PrefetchInEdges(*vertex_b);
+    ASSERT_EQ(vertex_a->OutEdges(memgraph::storage::View::OLD)->size(), 2);
+    ASSERT_EQ(vertex_a->InEdges(memgraph::storage::View::OLD)->size(), 1);
+    ASSERT_EQ(vertex_b->OutEdges(memgraph::storage::View::OLD)->size(), 0);
+    ASSERT_EQ(vertex_b->InEdges(memgraph::storage::View::OLD)->size(), 1);
+
+    auto edges = vertex_b->InEdges(memgraph::storage::View::OLD).GetValue();
+    ASSERT_EQ(edges[0].Gid(), gid_ab);
+    ASSERT_TRUE(acc->DeleteEdge(&edges[0]).HasValue());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  {
+    auto acc = store->Access();
+    auto vertex_a = acc->FindVertex(gid_a, memgraph::storage::View::OLD);
+    auto vertex_b = acc->FindVertex(gid_b, memgraph::storage::View::OLD);
+    auto vertex_c = acc->FindVertex(gid_c, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex_a);
+    ASSERT_TRUE(vertex_b);
+    ASSERT_TRUE(vertex_c);
+    acc->PrefetchOutEdges(*vertex_a);
+    acc->PrefetchInEdges(*vertex_b);
+    acc->PrefetchInEdges(*vertex_c);
+    ASSERT_EQ(vertex_a->OutEdges(memgraph::storage::View::OLD)->size(), 1);
+    ASSERT_EQ(vertex_b->InEdges(memgraph::storage::View::OLD)->size(), 0);
+    ASSERT_EQ(vertex_c->InEdges(memgraph::storage::View::OLD)->size(), 1);
+  }
+  disk_test_utils::RemoveRocksDbDirs(testSuite);
+}
@@ -12,6 +12,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <thread>
+
 #include "storage/v2/inmemory/storage.hpp"
 
 using testing::UnorderedElementsAre;
@@ -200,3 +202,209 @@ TEST(StorageV2Gc, Indices) {
     EXPECT_EQ(gids.size(), 1000);
   }
 }
+
+// Same as the sanity checks above, but with enough deltas to be unlinked by
+// several GC threads.
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(StorageV2Gc, ParallelCollection) {
+  std::unique_ptr<memgraph::storage::Storage> storage(
+      std::make_unique<memgraph::storage::InMemoryStorage>(memgraph::storage::Config{
+          .gc = {.type = memgraph::storage::Config::Gc::Type::PERIODIC,
+                 .interval = std::chrono::milliseconds(100),
+                 .threads = 4}}));
+
+  ASSERT_FALSE(storage->CreateIndex(storage->NameToLabel("label")).HasError());
+
+  std::vector<memgraph::storage::Gid> gids;
+  {
+    auto acc = storage->Access();
+    for (uint64_t i = 0; i < 20000; ++i) {
+      auto vertex = acc->CreateVertex();
+      ASSERT_TRUE(*vertex.AddLabel(acc->NameToLabel("label")));
+      auto id = memgraph::storage::PropertyValue(static_cast<int64_t>(i));
+      ASSERT_FALSE(vertex.SetProperty(acc->NameToProperty("id"), id).HasError());
+      gids.push_back(vertex.Gid());
+    }
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  {
+    auto acc = storage->Access();
+    for (uint64_t i = 0; i < gids.size(); i += 2) {
+      auto vertex = acc->FindVertex(gids[i], memgraph::storage::View::OLD);
+      ASSERT_TRUE(vertex);
+      ASSERT_FALSE(acc->DeleteVertex(&*vertex).HasError());
+    }
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  // Wait for GC.
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  auto acc = storage->Access();
+  for (uint64_t i = 0; i < gids.size(); ++i) {
+    auto vertex = acc->FindVertex(gids[i], memgraph::storage::View::OLD);
+    if (i % 2 == 0) {
+      ASSERT_FALSE(vertex);
+    } else {
+      ASSERT_TRUE(vertex);
+      ASSERT_EQ(*vertex->GetProperty(acc->NameToProperty("id"), memgraph::storage::View::OLD),
+                memgraph::storage::PropertyValue(static_cast<int64_t>(i)));
+    }
+  }
+  uint64_t count = 0;
+  for (auto vertex : acc->Vertices(acc->NameToLabel("label"), memgraph::storage::View::OLD)) {
+    ASSERT_TRUE(*vertex.HasLabel(acc->NameToLabel("label"), memgraph::storage::View::OLD));
+    ++count;
+  }
+  ASSERT_EQ(count, gids.size() / 2);
+}
+
+// The incremental GC collects a large backlog over several bounded cycles.
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(StorageV2Gc, IncrementalCollection) {
+  std::unique_ptr<memgraph::storage::Storage> storage(
+      std::make_unique<memgraph::storage::InMemoryStorage>(memgraph::storage::Config{
+          .gc = {.type = memgraph::storage::Config::Gc::Type::INCREMENTAL,
+                 .interval = std::chrono::milliseconds(10),
+                 .incremental_backlog = 1,
+                 .incremental_budget = 100}}));
+
+  ASSERT_FALSE(storage->CreateIndex(storage->NameToLabel("label")).HasError());
+
+  std::vector<memgraph::storage::Gid> gids;
+  {
+    auto acc = storage->Access();
+    for (uint64_t i = 0; i < 1000; ++i) {
+      auto vertex = acc->CreateVertex();
+      ASSERT_TRUE(*vertex.AddLabel(acc->NameToLabel("label")));
+      gids.push_back(vertex.Gid());
+    }
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  // Many small transactions, so that a single cycle can't unlink all of them.
+  for (uint64_t i = 0; i < gids.size(); i += 10) {
+    auto acc = storage->Access();
+    for (uint64_t j = i; j < i + 10; j += 2) {
+      auto vertex = acc->FindVertex(gids[j], memgraph::storage::View::OLD);
+      ASSERT_TRUE(vertex);
+      ASSERT_FALSE(acc->DeleteVertex(&*vertex).HasError());
+    }
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  // Wait for GC.
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  ASSERT_EQ(storage->GetInfo().vertex_count, gids.size() / 2);
+
+  auto acc = storage->Access();
+  for (uint64_t i = 0; i < gids.size(); ++i) {
+    auto vertex = acc->FindVertex(gids[i], memgraph::storage::View::OLD);
+    ASSERT_EQ(vertex.has_value(), i % 2 != 0);
+  }
+  uint64_t count = 0;
+  for (auto vertex : acc->Vertices(acc->NameToLabel("label"), memgraph::storage::View::OLD)) {
+    ASSERT_TRUE(*vertex.HasLabel(acc->NameToLabel("label"), memgraph::storage::View::OLD));
+    ++count;
+  }
+  ASSERT_EQ(count, gids.size() / 2);
+}
+
+// Transactions committed from many threads end up in different shards of the
+// committed transactions list, the GC has to collect all of them.
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(StorageV2Gc, ConcurrentCommits) {
+  std::unique_ptr<memgraph::storage::Storage> storage(
+      std::make_unique<memgraph::storage::InMemoryStorage>(memgraph::storage::Config{
+          .gc = {.type = memgraph::storage::Config::Gc::Type::PERIODIC, .interval = std::chrono::milliseconds(100)}}));
+
+  constexpr uint64_t kThreads = 8;
+  constexpr uint64_t kVerticesPerThread = 500;
+  std::vector<std::thread> threads;
+  threads.reserve(kThreads);
+  for (uint64_t i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&storage] {
+      for (uint64_t j = 0; j < kVerticesPerThread; ++j) {
+        auto acc = storage->Access();
+        auto vertex = acc->CreateVertex();
+        auto gid = vertex.Gid();
+        ASSERT_FALSE(acc->Commit().HasError());
+
+        // Every other vertex is deleted again in a separate transaction.
+        if (j % 2 == 0) continue;
+        auto delete_acc = storage->Access();
+        auto to_delete = delete_acc->FindVertex(gid, memgraph::storage::View::OLD);
+        ASSERT_TRUE(to_delete);
+        ASSERT_FALSE(delete_acc->DeleteVertex(&*to_delete).HasError());
+        ASSERT_FALSE(delete_acc->Commit().HasError());
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+
+  // Wait for GC.
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  ASSERT_EQ(storage->GetInfo().vertex_count, kThreads * kVerticesPerThread / 2);
+
+  auto acc = storage->Access();
+  uint64_t count = 0;
+  for (auto vertex : acc->Vertices(memgraph::storage::View::OLD)) {
+    ++count;
+  }
+  ASSERT_EQ(count, kThreads * kVerticesPerThread / 2);
+}
+
+// Transactions from different shards change the same vertices while the
+// incremental GC unlinks a few of them at a time. The older transactions must
+// be unlinked no later than the newer ones, since their deltas point to the
+// newer deltas of the same chains.
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(StorageV2Gc, IncrementalConcurrentCommits) {
+  std::unique_ptr<memgraph::storage::Storage> storage(
+      std::make_unique<memgraph::storage::InMemoryStorage>(memgraph::storage::Config{
+          .gc = {.type = memgraph::storage::Config::Gc::Type::INCREMENTAL,
+                 .interval = std::chrono::milliseconds(1),
+                 .incremental_backlog = 1,
+                 .incremental_budget = 8}}));
+
+  constexpr uint64_t kVertices = 4;
+  std::vector<memgraph::storage::Gid> gids;
+  {
+    auto acc = storage->Access();
+    for (uint64_t i = 0; i < kVertices; ++i) gids.push_back(acc->CreateVertex().Gid());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  constexpr uint64_t kThreads = 8;
+  constexpr uint64_t kUpdatesPerThread = 500;
+  auto const property = storage->NameToProperty("value");
+  std::vector<std::thread> threads;
+  threads.reserve(kThreads);
+  for (uint64_t i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&, i] {
+      for (uint64_t j = 0; j < kUpdatesPerThread; ++j) {
+        auto acc = storage->Access();
+        auto vertex = acc->FindVertex(gids[(i + j) % kVertices], memgraph::storage::View::OLD);
+        ASSERT_TRUE(vertex);
+        // Conflicting updates are aborted, the others build up the chains.
+        if (vertex->SetProperty(property, memgraph::storage::PropertyValue(static_cast<int64_t>(j))).HasError()) {
+          continue;
+        }
+        (void)acc->Commit();
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+
+  // Wait for GC.
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  auto acc = storage->Access();
+  for (auto const gid : gids) {
+    auto vertex = acc->FindVertex(gid, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex);
+    ASSERT_EQ(vertex->GetProperty(property, memgraph::storage::View::OLD)->type(),
+              memgraph::storage::PropertyValue::Type::Int);
+  }
+}
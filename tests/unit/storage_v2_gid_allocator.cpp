@@ -0,0 +1,73 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "storage/v2/gid_allocator.hpp"
+#include "storage/v2/inmemory/storage.hpp"
+
+using memgraph::storage::GidAllocator;
+
+class StorageV2GidAllocatorTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    block_size_ = FLAGS_storage_gid_block_size;
+    FLAGS_storage_gid_block_size = 4;
+  }
+
+  void TearDown() override { FLAGS_storage_gid_block_size = block_size_; }
+
+ private:
+  uint64_t block_size_{0};
+};
+
+TEST_F(StorageV2GidAllocatorTest, ThreadsAllocateFromBlocks) {
+  std::atomic<uint64_t> next_gid{0};
+  GidAllocator allocator{&next_gid};
+  EXPECT_EQ(allocator.Next(), 0);
+  EXPECT_EQ(allocator.Next(), 1);
+  EXPECT_EQ(next_gid, 4);
+
+  uint64_t other_thread_gid = 0;
+  std::thread([&] { other_thread_gid = allocator.Next(); }).join();
+  EXPECT_EQ(other_thread_gid, 4);
+  EXPECT_EQ(allocator.Next(), 2);
+  EXPECT_EQ(allocator.Next(), 3);
+  EXPECT_EQ(allocator.Next(), 8);
+
+  allocator.DiscardBlocks();
+  next_gid = 20;
+  EXPECT_EQ(allocator.Next(), 20);
+}
+
+TEST_F(StorageV2GidAllocatorTest, ParallelVertexCreation) {
+  std::unique_ptr<memgraph::storage::Storage> storage{std::make_unique<memgraph::storage::InMemoryStorage>()};
+  constexpr int kThreads = 4;
+  constexpr int kVertices = 100;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&storage] {
+      auto acc = storage->Access();
+      for (int j = 0; j < kVertices; ++j) acc->CreateVertex();
+      ASSERT_FALSE(acc->Commit().HasError());
+    });
+  }
+  for (auto &thread : threads) thread.join();
+
+  auto acc = storage->Access();
+  std::set<memgraph::storage::Gid> gids;
+  for (auto vertex : acc->Vertices(memgraph::storage::View::OLD)) gids.insert(vertex.Gid());
+  EXPECT_EQ(gids.size(), kThreads * kVertices);
+}
@@ -13,6 +13,8 @@
 #include <gtest/gtest-typed-test.h>
 #include <gtest/gtest.h>
 #include <gtest/internal/gtest-type-util.h>
+#include <atomic>
+#include <thread>
 
 #include "disk_test_utils.hpp"
 #include "storage/v2/disk/label_index.hpp"
@@ -467,6 +469,97 @@ TYPED_TEST(IndexTest, LabelIndexRemoveAndAddIndexedLabel) {
   }
 }
 
+TYPED_TEST(IndexTest, LabelIndexFilterLabels) {
+  if constexpr ((std::is_same_v<TypeParam, memgraph::storage::InMemoryStorage>)) {
+    EXPECT_FALSE(this->storage->CreateIndex(this->label1).HasError());
+    {
+      auto acc = this->storage->Access();
+      auto vertex0 = this->CreateVertex(acc.get());
+      ASSERT_NO_ERROR(vertex0.AddLabel(this->label1));
+      auto vertex1 = this->CreateVertex(acc.get());
+      ASSERT_NO_ERROR(vertex1.AddLabel(this->label1));
+      ASSERT_NO_ERROR(vertex1.AddLabel(this->label2));
+      auto vertex2 = this->CreateVertex(acc.get());
+      ASSERT_NO_ERROR(vertex2.AddLabel(this->label2));
+      ASSERT_NO_ERROR(acc->Commit());
+    }
+    // Filter labels without an index don't skip any vertices.
+    {
+      auto acc = this->storage->Access();
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, {this->label2}, View::OLD)), UnorderedElementsAre(0, 1));
+    }
+
+    // The index on the filter label is created after its vertices already exist.
+    EXPECT_FALSE(this->storage->CreateIndex(this->label2).HasError());
+    {
+      auto acc = this->storage->Access();
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, {this->label2}, View::OLD)), UnorderedElementsAre(1));
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label2, {this->label1}, View::OLD)), UnorderedElementsAre(1));
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, {this->label1}, View::OLD)), UnorderedElementsAre(0, 1));
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, std::vector<LabelId>{}, View::OLD)),
+                  UnorderedElementsAre(0, 1));
+
+      // Labels added in the transaction are seen by it.
+      for (auto vertex : acc->Vertices(View::OLD)) {
+        if (vertex.GetProperty(this->prop_id, View::OLD)->ValueInt() == 0) {
+          ASSERT_NO_ERROR(vertex.AddLabel(this->label2));
+        }
+      }
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, {this->label2}, View::NEW), View::NEW),
+                  UnorderedElementsAre(0, 1));
+      ASSERT_NO_ERROR(acc->Commit());
+    }
+    {
+      auto acc = this->storage->Access();
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, {this->label2}, View::OLD)), UnorderedElementsAre(0, 1));
+    }
+  }
+}
+
+TYPED_TEST(IndexTest, LabelIndexFilterProperties) {
+  if constexpr ((std::is_same_v<TypeParam, memgraph::storage::InMemoryStorage>)) {
+    EXPECT_FALSE(this->storage->CreateIndex(this->label1).HasError());
+    {
+      auto acc = this->storage->Access();
+      for (int i = 0; i < 6; ++i) {
+        auto vertex = this->CreateVertex(acc.get());
+        ASSERT_NO_ERROR(vertex.AddLabel(i < 5 ? this->label1 : this->label2));
+        ASSERT_NO_ERROR(vertex.SetProperty(this->prop_val, i == 4 ? PropertyValue(1.0) : PropertyValue(i % 2)));
+      }
+      ASSERT_NO_ERROR(acc->Commit());
+    }
+    {
+      auto acc = this->storage->Access();
+      const std::vector<LabelId> no_labels;
+      const std::vector<std::pair<PropertyId, PropertyValue>> val_one{{this->prop_val, PropertyValue(1)}};
+      const std::vector<std::pair<PropertyId, PropertyValue>> id_three_val_one{{this->prop_id, PropertyValue(3)},
+                                                                               {this->prop_val, PropertyValue(1)}};
+      const std::vector<std::pair<PropertyId, PropertyValue>> val_string{{this->prop_val, PropertyValue("1")}};
+      // Integer and double values are compared the same way as in PropertyValue.
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, no_labels, val_one, View::OLD)),
+                  UnorderedElementsAre(1, 3, 4));
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, no_labels, id_three_val_one, View::OLD)),
+                  UnorderedElementsAre(3));
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, no_labels, val_string, View::OLD)), IsEmpty());
+
+      // Properties changed in the transaction are seen by it.
+      for (auto vertex : acc->Vertices(View::OLD)) {
+        if (vertex.GetProperty(this->prop_id, View::OLD)->ValueInt() == 0) {
+          ASSERT_NO_ERROR(vertex.SetProperty(this->prop_val, PropertyValue(1)));
+        }
+        if (vertex.GetProperty(this->prop_id, View::OLD)->ValueInt() == 1) {
+          ASSERT_NO_ERROR(vertex.SetProperty(this->prop_val, PropertyValue()));
+        }
+      }
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, no_labels, val_one, View::OLD)),
+                  UnorderedElementsAre(1, 3, 4));
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, no_labels, val_one, View::NEW), View::NEW),
+                  UnorderedElementsAre(0, 3, 4));
+      ASSERT_NO_ERROR(acc->Commit());
+    }
+  }
+}
+
 TYPED_TEST(IndexTest, LabelIndexClearOldDataFromDisk) {
   if constexpr ((std::is_same_v<TypeParam, memgraph::storage::DiskStorage>)) {
     auto *disk_label_index =
@@ -784,6 +877,45 @@ TYPED_TEST(IndexTest, LabelPropertyIndexFiltering) {
   }
 }
 
+TYPED_TEST(IndexTest, LabelPropertyIndexPointValues) {
+  // We insert vertices with values:
+  // 0 0.0 1 1.0 2 2.0 3 3.0 4 4.0
+  // Then we look up lists of values, which may be unsorted, have duplicates,
+  // Nulls and values that no vertex has.
+
+  EXPECT_FALSE(this->storage->CreateIndex(this->label1, this->prop_val).HasError());
+
+  {
+    auto acc = this->storage->Access();
+
+    for (int i = 0; i < 10; ++i) {
+      auto vertex = this->CreateVertex(acc.get());
+      ASSERT_NO_ERROR(vertex.AddLabel(this->label1));
+      ASSERT_NO_ERROR(vertex.SetProperty(this->prop_val, i % 2 ? PropertyValue(i / 2) : PropertyValue(i / 2.0)));
+    }
+    ASSERT_NO_ERROR(acc->Commit());
+  }
+  {
+    auto acc = this->storage->Access();
+    EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, this->prop_val, std::vector<PropertyValue>{}, View::OLD)),
+                IsEmpty());
+
+    EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, this->prop_val, std::vector{PropertyValue(3)}, View::OLD)),
+                UnorderedElementsAre(6, 7));
+
+    EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, this->prop_val,
+                                           std::vector{PropertyValue(3), PropertyValue(1), PropertyValue(1.0),
+                                                       PropertyValue(), PropertyValue(7), PropertyValue("a"),
+                                                       PropertyValue(4)},
+                                           View::OLD)),
+                UnorderedElementsAre(2, 3, 6, 7, 8, 9));
+
+    EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, this->prop_val,
+                                           std::vector{PropertyValue(-1), PropertyValue(5)}, View::OLD)),
+                IsEmpty());
+  }
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TYPED_TEST(IndexTest, LabelPropertyIndexCountEstimate) {
   if constexpr ((std::is_same_v<TypeParam, memgraph::storage::InMemoryStorage>)) {
@@ -1130,3 +1262,526 @@ TYPED_TEST(IndexTest, LabelPropertyIndexClearOldDataFromDisk) {
     ASSERT_EQ(disk_test_utils::GetRealNumberOfEntriesInRocksDB(tx_db), 1);
   }
 }
+
+TYPED_TEST(IndexTest, LabelPropertyCompositeIndexBasic) {
+  if constexpr ((std::is_same_v<TypeParam, memgraph::storage::InMemoryStorage>)) {
+    PropertyId prop_other;
+    {
+      auto acc = this->storage->Access();
+      prop_other = acc->NameToProperty("other");
+    }
+    const std::vector<PropertyId> properties{this->prop_val, prop_other};
+    EXPECT_FALSE(this->storage->CreateIndex(this->label1, properties).HasError());
+    EXPECT_TRUE(this->storage->CreateIndex(this->label1, properties).HasError());
+    {
+      auto acc = this->storage->Access();
+      EXPECT_TRUE(acc->LabelPropertyCompositeIndexExists(this->label1, properties));
+      EXPECT_FALSE(acc->LabelPropertyCompositeIndexExists(this->label1, {prop_other, this->prop_val}));
+      EXPECT_EQ(acc->ListAllIndices().label_property_composite.size(), 1);
+    }
+
+    {
+      auto acc = this->storage->Access();
+      for (int i = 0; i < 10; ++i) {
+        auto vertex = this->CreateVertex(acc.get());
+        ASSERT_NO_ERROR(vertex.AddLabel(this->label1));
+        ASSERT_NO_ERROR(vertex.SetProperty(this->prop_val, PropertyValue(i % 2)));
+        // Vertices without all of the properties aren't indexed.
+        if (i < 8) ASSERT_NO_ERROR(vertex.SetProperty(prop_other, PropertyValue(i)));
+      }
+      ASSERT_NO_ERROR(acc->Commit());
+    }
+    {
+      auto acc = this->storage->Access();
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, properties, {PropertyValue(0)}, std::nullopt, std::nullopt,
+                                             View::OLD)),
+                  UnorderedElementsAre(0, 2, 4, 6));
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, properties, {PropertyValue(1), PropertyValue(3)},
+                                             std::nullopt, std::nullopt, View::OLD)),
+                  UnorderedElementsAre(3));
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, properties, {PropertyValue(1)},
+                                             memgraph::utils::MakeBoundInclusive(PropertyValue(3)),
+                                             memgraph::utils::MakeBoundExclusive(PropertyValue(7)), View::OLD)),
+                  UnorderedElementsAre(3, 5));
+      EXPECT_EQ(acc->ApproximateVertexCount(this->label1, properties), 8);
+      EXPECT_EQ(acc->ApproximateVertexCount(this->label1, properties, {PropertyValue(0)}, std::nullopt, std::nullopt),
+                4);
+
+      // Changes made in the transaction are seen by it.
+      for (auto vertex : acc->Vertices(View::OLD)) {
+        if (vertex.GetProperty(this->prop_id, View::OLD)->ValueInt() == 8) {
+          ASSERT_NO_ERROR(vertex.SetProperty(prop_other, PropertyValue(8)));
+        }
+      }
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, properties, {PropertyValue(0)}, std::nullopt, std::nullopt,
+                                             View::NEW),
+                               View::NEW),
+                  UnorderedElementsAre(0, 2, 4, 6, 8));
+      EXPECT_THAT(this->GetIds(acc->Vertices(this->label1, properties, {PropertyValue(0)}, std::nullopt, std::nullopt,
+                                             View::OLD)),
+                  UnorderedElementsAre(0, 2, 4, 6));
+      ASSERT_NO_ERROR(acc->Commit());
+    }
+
+    EXPECT_FALSE(this->storage->DropIndex(this->label1, properties).HasError());
+    EXPECT_TRUE(this->storage->DropIndex(this->label1, properties).HasError());
+    {
+      auto acc = this->storage->Access();
+      EXPECT_FALSE(acc->LabelPropertyCompositeIndexExists(this->label1, properties));
+      EXPECT_TRUE(acc->ListAllIndices().label_property_composite.empty());
+    }
+  }
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TYPED_TEST(IndexTest, EdgeTypeIndexBasic) {
+  if constexpr ((std::is_same_v<TypeParam, memgraph::storage::InMemoryStorage>)) {
+    EdgeTypeId edge_type1;
+    EdgeTypeId edge_type2;
+    {
+      auto acc = this->storage->Access();
+      edge_type1 = acc->NameToEdgeType("edge_type1");
+      edge_type2 = acc->NameToEdgeType("edge_type2");
+    }
+    EXPECT_FALSE(this->storage->CreateIndex(edge_type1).HasError());
+    EXPECT_TRUE(this->storage->CreateIndex(edge_type1).HasError());
+    EXPECT_FALSE(this->storage->CreateIndex(edge_type1, this->prop_val).HasError());
+    {
+      auto acc = this->storage->Access();
+      EXPECT_TRUE(acc->EdgeTypeIndexExists(edge_type1));
+      EXPECT_FALSE(acc->EdgeTypeIndexExists(edge_type2));
+      EXPECT_TRUE(acc->EdgeTypePropertyIndexExists(edge_type1, this->prop_val));
+      EXPECT_EQ(acc->ListAllIndices().edge_type.size(), 1);
+      EXPECT_EQ(acc->ListAllIndices().edge_type_property.size(), 1);
+    }
+
+    {
+      auto acc = this->storage->Access();
+      auto from = this->CreateVertex(acc.get());
+      for (int i = 0; i < 10; ++i) {
+        auto to = this->CreateVertex(acc.get());
+        auto edge = acc->CreateEdge(&from, &to, i % 2 == 0 ? edge_type1 : edge_type2);
+        ASSERT_NO_ERROR(edge);
+        ASSERT_NO_ERROR(edge->SetProperty(this->prop_val, PropertyValue(i)));
+      }
+      // Edges created in the transaction are seen only through the new view.
+      int64_t count = 0;
+      for ([[maybe_unused]] auto edge : acc->Edges(edge_type1, View::OLD)) ++count;
+      EXPECT_EQ(count, 0);
+      for (auto edge : acc->Edges(edge_type1, View::NEW)) {
+        EXPECT_EQ(edge.EdgeType(), edge_type1);
+        EXPECT_EQ(edge.FromVertex(), from);
+        ++count;
+      }
+      EXPECT_EQ(count, 5);
+      ASSERT_NO_ERROR(acc->Commit());
+    }
+    {
+      auto acc = this->storage->Access();
+      EXPECT_EQ(acc->ApproximateEdgeCount(edge_type1), 5);
+      EXPECT_EQ(acc->ApproximateEdgeCount(edge_type1, this->prop_val), 5);
+      std::vector<int64_t> values;
+      for (auto edge : acc->Edges(edge_type1, this->prop_val, memgraph::utils::MakeBoundInclusive(PropertyValue(2)),
+                                  memgraph::utils::MakeBoundExclusive(PropertyValue(8)), View::OLD)) {
+        values.push_back(edge.GetProperty(this->prop_val, View::OLD)->ValueInt());
+      }
+      EXPECT_THAT(values, UnorderedElementsAre(2, 4, 6));
+      values.clear();
+      for (auto edge : acc->Edges(edge_type1, this->prop_val, PropertyValue(4), View::OLD)) {
+        values.push_back(edge.GetProperty(this->prop_val, View::OLD)->ValueInt());
+      }
+      EXPECT_THAT(values, UnorderedElementsAre(4));
+    }
+
+    EXPECT_FALSE(this->storage->DropIndex(edge_type1).HasError());
+    EXPECT_TRUE(this->storage->DropIndex(edge_type1).HasError());
+    EXPECT_FALSE(this->storage->DropIndex(edge_type1, this->prop_val).HasError());
+    {
+      auto acc = this->storage->Access();
+      EXPECT_FALSE(acc->EdgeTypeIndexExists(edge_type1));
+      EXPECT_FALSE(acc->EdgeTypePropertyIndexExists(edge_type1, this->prop_val));
+      EXPECT_TRUE(acc->ListAllIndices().edge_type.empty());
+    }
+  }
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TYPED_TEST(IndexTest, CreateIndexWhileWriting) {
+  if constexpr ((std::is_same_v<TypeParam, memgraph::storage::InMemoryStorage>)) {
+    this->config_.durability.allow_parallel_index_creation = true;
+    this->config_.durability.recovery_thread_count = 4;
+    this->storage = std::make_unique<TypeParam>(this->config_);
+    {
+      auto acc = this->storage->Access();
+      this->prop_id = acc->NameToProperty("id");
+      this->prop_val = acc->NameToProperty("val");
+      this->label1 = acc->NameToLabel("label1");
+    }
+
+    constexpr int64_t kInitialVertices = 10000;
+    {
+      auto acc = this->storage->Access();
+      for (int64_t i = 0; i < kInitialVertices; ++i) {
+        auto vertex = this->CreateVertex(acc.get());
+        ASSERT_NO_ERROR(vertex.AddLabel(this->label1));
+        ASSERT_NO_ERROR(vertex.SetProperty(this->prop_val, PropertyValue(i)));
+      }
+      ASSERT_NO_ERROR(acc->Commit());
+    }
+
+    // The vertices written while the indices are populated have to end up in
+    // them as well.
+    std::atomic<bool> done{false};
+    std::jthread creator([&] {
+      EXPECT_FALSE(this->storage->CreateIndex(this->label1).HasError());
+      EXPECT_FALSE(this->storage->CreateIndex(this->label1, this->prop_val).HasError());
+      done = true;
+    });
+    int64_t written = 0;
+    while (!done) {
+      auto acc = this->storage->Access();
+      auto vertex = this->CreateVertex(acc.get());
+      ASSERT_NO_ERROR(vertex.AddLabel(this->label1));
+      ASSERT_NO_ERROR(vertex.SetProperty(this->prop_val, PropertyValue(kInitialVertices + written)));
+      ASSERT_NO_ERROR(acc->Commit());
+      ++written;
+    }
+    creator.join();
+
+    auto acc = this->storage->Access();
+    EXPECT_TRUE(acc->LabelIndexExists(this->label1));
+    EXPECT_TRUE(acc->LabelPropertyIndexExists(this->label1, this->prop_val));
+    EXPECT_EQ(this->GetIds(acc->Vertices(this->label1, View::OLD)).size(), kInitialVertices + written);
+    EXPECT_EQ(this->GetIds(acc->Vertices(this->label1, this->prop_val, View::OLD)).size(), kInitialVertices + written);
+  }
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(IndexStatsTest, ValueDistributionEstimates) {
+  // Value 0 is much more common than the rest, values 1 to 1000 appear once.
+  std::map<PropertyValue, int64_t> value_counts{{PropertyValue(0), 1000}};
+  for (int64_t i = 1; i <= 1000; ++i) {
+    value_counts.emplace(PropertyValue(i), 1);
+  }
+  LabelPropertyIndexStats stats{.count = 2000, .distinct_values_count = 1001};
+  ComputeValueDistribution(value_counts, &stats);
+  ASSERT_TRUE(HasValueDistribution(stats));
+  ASSERT_EQ(stats.most_common_values.size(), 1);
+  EXPECT_EQ(stats.most_common_values[0], std::make_pair(PropertyValue(0), uint64_t{1000}));
+  ASSERT_EQ(stats.histogram_bounds.size(), kIndexStatsHistogramBuckets + 1);
+  EXPECT_EQ(stats.histogram_bounds.front(), PropertyValue(1));
+  EXPECT_EQ(stats.histogram_bounds.back(), PropertyValue(1000));
+
+  EXPECT_DOUBLE_EQ(EstimateVertexCount(stats, PropertyValue(0)), 1000);
+  EXPECT_DOUBLE_EQ(EstimateVertexCount(stats, PropertyValue(500)), 1);
+  EXPECT_DOUBLE_EQ(EstimateVertexCount(stats, PropertyValue(5000)), 0);
+  EXPECT_DOUBLE_EQ(EstimateVertexCount(stats, PropertyValue("string")), 0);
+
+  auto range_count = [&stats](std::optional<utils::Bound<PropertyValue>> lower,
+                              std::optional<utils::Bound<PropertyValue>> upper) {
+    return EstimateVertexCount(stats, std::move(lower), std::move(upper));
+  };
+  EXPECT_NEAR(range_count(utils::MakeBoundInclusive(PropertyValue(0)), std::nullopt), 2000, 1);
+  EXPECT_NEAR(range_count(utils::MakeBoundExclusive(PropertyValue(0)), std::nullopt), 1000, 1);
+  EXPECT_NEAR(range_count(std::nullopt, utils::MakeBoundInclusive(PropertyValue(500))), 1500, 15);
+  EXPECT_NEAR(range_count(utils::MakeBoundInclusive(PropertyValue(251)), utils::MakeBoundInclusive(PropertyValue(750))),
+              500, 15);
+  EXPECT_DOUBLE_EQ(range_count(utils::MakeBoundInclusive(PropertyValue("a")), std::nullopt), 0);
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(IndexStatsTest, BackgroundRefresh) {
+  std::unique_ptr<Storage> storage(new InMemoryStorage(
+      {.index_stats = {.refresh_threshold = 0.5, .refresh_interval = std::chrono::milliseconds(10)}}));
+  const auto label = storage->NameToLabel("label");
+  const auto property = storage->NameToProperty("property");
+  ASSERT_NO_ERROR(storage->CreateIndex(label));
+  ASSERT_NO_ERROR(storage->CreateIndex(label, property));
+
+  auto create_vertices = [&](int64_t count) {
+    auto acc = storage->Access();
+    for (int64_t i = 0; i < count; ++i) {
+      auto vertex = acc->CreateVertex();
+      ASSERT_NO_ERROR(vertex.AddLabel(label));
+      ASSERT_NO_ERROR(vertex.SetProperty(property, PropertyValue(i % 10)));
+    }
+    ASSERT_NO_ERROR(acc->Commit());
+  };
+  auto wait_for_count = [&](uint64_t count) {
+    for (int i = 0; i < 1000; ++i) {
+      auto acc = storage->Access();
+      auto label_stats = acc->GetIndexStats(label);
+      auto label_property_stats = acc->GetIndexStats(label, property);
+      if (label_stats && label_stats->count == count && label_property_stats && label_property_stats->count == count) {
+        EXPECT_EQ(label_property_stats->distinct_values_count, 10);
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+  };
+
+  create_vertices(100);
+  ASSERT_TRUE(wait_for_count(100));
+
+  // Changing less than the threshold keeps the statistics.
+  create_vertices(10);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  {
+    auto acc = storage->Access();
+    EXPECT_EQ(acc->GetIndexStats(label)->count, 100);
+  }
+
+  // Reaching the threshold refreshes them.
+  create_vertices(50);
+  ASSERT_TRUE(wait_for_count(160));
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(TextIndexTest, SearchAndVisibility) {
+  std::unique_ptr<Storage> storage(new InMemoryStorage());
+  const auto label = storage->NameToLabel("label");
+  const auto other_label = storage->NameToLabel("other");
+  const auto property = storage->NameToProperty("text");
+  const auto id = storage->NameToProperty("id");
+
+  auto create_vertex = [&](Storage::Accessor *acc, int64_t vertex_id, const std::string &text, LabelId vertex_label) {
+    auto vertex = acc->CreateVertex();
+    ASSERT_NO_ERROR(vertex.AddLabel(vertex_label));
+    ASSERT_NO_ERROR(vertex.SetProperty(id, PropertyValue(vertex_id)));
+    ASSERT_NO_ERROR(vertex.SetProperty(property, PropertyValue(text)));
+  };
+  auto search = [&](Storage::Accessor *acc, std::string_view query, uint64_t limit = 10) {
+    std::vector<int64_t> ids;
+    for (auto &result : acc->TextSearch(label, property, query, limit, View::NEW)) {
+      ids.push_back(result.vertex.GetProperty(id, View::NEW)->ValueInt());
+    }
+    return ids;
+  };
+
+  // The existing vertices are indexed when the index is created.
+  {
+    auto acc = storage->Access();
+    create_vertex(acc.get(), 0, "The quick brown fox", label);
+    create_vertex(acc.get(), 1, "A lazy dog sleeps", label);
+    create_vertex(acc.get(), 2, "fox", other_label);
+    ASSERT_NO_ERROR(acc->Commit());
+  }
+  ASSERT_NO_ERROR(storage->CreateTextIndex(label, property));
+  ASSERT_TRUE(storage->CreateTextIndex(label, property).HasError());
+  EXPECT_THAT(storage->ListAllIndices().text, UnorderedElementsAre(std::make_pair(label, property)));
+  {
+    auto acc = storage->Access();
+    EXPECT_TRUE(acc->TextIndexExists(label, property));
+    create_vertex(acc.get(), 3, "Fox, fox and another FOX!", label);
+    EXPECT_EQ(search(acc.get(), "fox"), (std::vector<int64_t>{3, 0}));
+    EXPECT_EQ(search(acc.get(), "fox", 1), (std::vector<int64_t>{3}));
+    EXPECT_EQ(search(acc.get(), "DOG"), (std::vector<int64_t>{1}));
+    EXPECT_TRUE(search(acc.get(), "cat").empty());
+    ASSERT_NO_ERROR(acc->Commit());
+  }
+
+  // The transactions only find the values they see.
+  auto reader = storage->Access();
+  {
+    auto acc = storage->Access();
+    for (auto vertex : acc->Vertices(View::OLD)) {
+      if (vertex.GetProperty(id, View::OLD)->ValueInt() == 0) {
+        ASSERT_NO_ERROR(vertex.SetProperty(property, PropertyValue("a green turtle")));
+      }
+    }
+    ASSERT_NO_ERROR(acc->Commit());
+  }
+  EXPECT_EQ(search(reader.get(), "fox"), (std::vector<int64_t>{3, 0}));
+  EXPECT_TRUE(search(reader.get(), "turtle").empty());
+  reader->Abort();
+  reader.reset();
+  storage->FreeMemory();
+  {
+    auto acc = storage->Access();
+    EXPECT_EQ(search(acc.get(), "fox"), (std::vector<int64_t>{3}));
+    EXPECT_EQ(search(acc.get(), "turtle"), (std::vector<int64_t>{0}));
+  }
+
+  ASSERT_NO_ERROR(storage->DropTextIndex(label, property));
+  ASSERT_TRUE(storage->DropTextIndex(label, property).HasError());
+  EXPECT_THAT(storage->ListAllIndices().text, IsEmpty());
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(TextIndexTest, Tokenize) {
+  EXPECT_EQ(InMemoryTextIndex::Tokenize("Hello, World! 42x"), (std::vector<std::string>{"hello", "world", "42x"}));
+  EXPECT_EQ(InMemoryTextIndex::Tokenize("Grüße-Welt"), (std::vector<std::string>{"grüße", "welt"}));
+  EXPECT_TRUE(InMemoryTextIndex::Tokenize(" .,;").empty());
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(VectorIndexTest, SearchAndVisibility) {
+  std::unique_ptr<Storage> storage(new InMemoryStorage());
+  const auto label = storage->NameToLabel("label");
+  const auto other_label = storage->NameToLabel("other");
+  const auto property = storage->NameToProperty("embedding");
+  const auto id = storage->NameToProperty("id");
+
+  auto to_value = [](const std::vector<double> &vector) {
+    std::vector<PropertyValue> values;
+    for (const auto element : vector) values.emplace_back(element);
+    return PropertyValue(std::move(values));
+  };
+  auto create_vertex = [&](Storage::Accessor *acc, int64_t vertex_id, const std::vector<double> &vector,
+                           LabelId vertex_label) {
+    auto vertex = acc->CreateVertex();
+    ASSERT_NO_ERROR(vertex.AddLabel(vertex_label));
+    ASSERT_NO_ERROR(vertex.SetProperty(id, PropertyValue(vertex_id)));
+    ASSERT_NO_ERROR(vertex.SetProperty(property, to_value(vector)));
+  };
+  auto search = [&](Storage::Accessor *acc, const std::vector<float> &query, uint64_t k = 10) {
+    std::vector<int64_t> ids;
+    for (auto &result : *acc->VectorSearch(label, property, query, k, View::NEW)) {
+      ids.push_back(result.vertex.GetProperty(id, View::NEW)->ValueInt());
+    }
+    return ids;
+  };
+
+  // The existing vertices are indexed when the index is created.
+  {
+    auto acc = storage->Access();
+    create_vertex(acc.get(), 0, {1, 0, 0}, label);
+    create_vertex(acc.get(), 1, {0, 1, 0}, label);
+    create_vertex(acc.get(), 2, {1, 1, 0}, other_label);
+    ASSERT_NO_ERROR(acc->Commit());
+  }
+  ASSERT_NO_ERROR(storage->CreateVectorIndex(label, property));
+  ASSERT_TRUE(storage->CreateVectorIndex(label, property).HasError());
+  EXPECT_THAT(storage->ListAllIndices().vector, UnorderedElementsAre(std::make_pair(label, property)));
+  {
+    auto acc = storage->Access();
+    EXPECT_TRUE(acc->VectorIndexExists(label, property));
+    create_vertex(acc.get(), 3, {2, 1, 0}, label);
+    // The vectors of another dimension aren't indexed.
+    create_vertex(acc.get(), 4, {1, 0}, label);
+    EXPECT_EQ(search(acc.get(), {1, 0.1, 0}), (std::vector<int64_t>{0, 3, 1}));
+    EXPECT_EQ(search(acc.get(), {1, 0.1, 0}, 2), (std::vector<int64_t>{0, 3}));
+    EXPECT_EQ(search(acc.get(), {0, 3, 0}, 1), (std::vector<int64_t>{1}));
+    EXPECT_FALSE(acc->VectorSearch(label, property, std::vector<float>{1, 0}, 10, View::NEW));
+    ASSERT_NO_ERROR(acc->Commit());
+  }
+
+  // The transactions only find the values they see.
+  auto reader = storage->Access();
+  {
+    auto acc = storage->Access();
+    for (auto vertex : acc->Vertices(View::OLD)) {
+      if (vertex.GetProperty(id, View::OLD)->ValueInt() == 0) {
+        ASSERT_NO_ERROR(vertex.SetProperty(property, to_value({0, 0, 1})));
+      }
+    }
+    ASSERT_NO_ERROR(acc->Commit());
+  }
+  EXPECT_EQ(search(reader.get(), {1, 0, 0}, 1), (std::vector<int64_t>{0}));
+  EXPECT_EQ(search(reader.get(), {1, 0.1, 0}), (std::vector<int64_t>{0, 3, 1}));
+  reader->Abort();
+  reader.reset();
+  storage->FreeMemory();
+  {
+    auto acc = storage->Access();
+    EXPECT_EQ(search(acc.get(), {1, 0, 0}, 1), (std::vector<int64_t>{3}));
+    EXPECT_EQ(search(acc.get(), {0, 0, 1}, 1), (std::vector<int64_t>{0}));
+  }
+
+  ASSERT_NO_ERROR(storage->DropVectorIndex(label, property));
+  ASSERT_TRUE(storage->DropVectorIndex(label, property).HasError());
+  EXPECT_THAT(storage->ListAllIndices().vector, IsEmpty());
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(VectorIndexTest, ToVector) {
+  auto vector = InMemoryVectorIndex::ToVector(PropertyValue(std::vector<PropertyValue>{
+      PropertyValue(3), PropertyValue(4.0)}));
+  ASSERT_TRUE(vector);
+  EXPECT_FLOAT_EQ((*vector)[0], 0.6);
+  EXPECT_FLOAT_EQ((*vector)[1], 0.8);
+  EXPECT_FALSE(InMemoryVectorIndex::ToVector(PropertyValue(std::vector<PropertyValue>{})));
+  EXPECT_FALSE(InMemoryVectorIndex::ToVector(PropertyValue(std::vector<PropertyValue>{PropertyValue("x")})));
+  EXPECT_FALSE(InMemoryVectorIndex::ToVector(PropertyValue(1.0)));
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(AggregateIndexTest, Lookup) {
+  std::unique_ptr<Storage> storage(new InMemoryStorage());
+  const auto label = storage->NameToLabel("label");
+  const auto other_label = storage->NameToLabel("other");
+  const auto group = storage->NameToProperty("group");
+  const auto value = storage->NameToProperty("value");
+
+  auto create_vertex = [&](Storage::Accessor *acc, LabelId vertex_label, const PropertyValue &group_value,
+                           const PropertyValue &vertex_value) {
+    auto vertex = acc->CreateVertex();
+    ASSERT_NO_ERROR(vertex.AddLabel(vertex_label));
+    ASSERT_NO_ERROR(vertex.SetProperty(group, group_value));
+    ASSERT_NO_ERROR(vertex.SetProperty(value, vertex_value));
+  };
+  using Groups = std::vector<std::tuple<PropertyValue, uint64_t, PropertyValue, PropertyValue, PropertyValue>>;
+  // Returns the group, the count, the sum, the minimum and the maximum of each
+  // group.
+  auto lookup = [&](Storage::Accessor *acc) {
+    Groups groups;
+    for (const auto &item : *acc->AggregateIndexLookup(label, group, value)) {
+      groups.emplace_back(item.group, item.count, item.sum, item.min, item.max);
+    }
+    return groups;
+  };
+
+  // The existing vertices are aggregated when the index is created.
+  {
+    auto acc = storage->Access();
+    create_vertex(acc.get(), label, PropertyValue("a"), PropertyValue(1));
+    create_vertex(acc.get(), label, PropertyValue("a"), PropertyValue(5));
+    create_vertex(acc.get(), label, PropertyValue("b"), PropertyValue(2));
+    create_vertex(acc.get(), other_label, PropertyValue("a"), PropertyValue(100));
+    ASSERT_NO_ERROR(acc->Commit());
+  }
+  ASSERT_NO_ERROR(storage->CreateAggregateIndex(label, group, value));
+  ASSERT_TRUE(storage->CreateAggregateIndex(label, group, value).HasError());
+  EXPECT_THAT(storage->ListAllIndices().aggregate, UnorderedElementsAre(std::make_tuple(label, group, value)));
+  {
+    auto acc = storage->Access();
+    EXPECT_TRUE(acc->AggregateIndexExists(label, group, value));
+    EXPECT_EQ(lookup(acc.get()),
+              (Groups{{PropertyValue("a"), 2, PropertyValue(6), PropertyValue(1), PropertyValue(5)},
+                      {PropertyValue("b"), 1, PropertyValue(2), PropertyValue(2), PropertyValue(2)}}));
+    // A transaction which changed the graph doesn't see the aggregates.
+    create_vertex(acc.get(), label, PropertyValue("b"), PropertyValue(0.5));
+    EXPECT_FALSE(acc->AggregateIndexLookup(label, group, value));
+    ASSERT_NO_ERROR(acc->Commit());
+  }
+
+  // The transactions see the aggregates of their snapshot.
+  auto reader = storage->Access();
+  {
+    auto acc = storage->Access();
+    for (auto vertex : acc->Vertices(View::OLD)) {
+      if (*vertex.GetProperty(value, View::OLD) == PropertyValue(5)) {
+        ASSERT_NO_ERROR(vertex.SetProperty(group, PropertyValue("b")));
+      } else if (*vertex.GetProperty(value, View::OLD) == PropertyValue(1)) {
+        ASSERT_NO_ERROR(acc->DeleteVertex(&vertex));
+      }
+    }
+    ASSERT_NO_ERROR(acc->Commit());
+  }
+  EXPECT_EQ(lookup(reader.get()),
+            (Groups{{PropertyValue("a"), 2, PropertyValue(6), PropertyValue(1), PropertyValue(5)},
+                    {PropertyValue("b"), 2, PropertyValue(2.5), PropertyValue(0.5), PropertyValue(2)}}));
+  reader->Abort();
+  reader.reset();
+  storage->FreeMemory();
+  {
+    auto acc = storage->Access();
+    EXPECT_EQ(lookup(acc.get()),
+              (Groups{{PropertyValue("b"), 3, PropertyValue(7.5), PropertyValue(0.5), PropertyValue(5)}}));
+  }
+
+  ASSERT_NO_ERROR(storage->DropAggregateIndex(label, group, value));
+  ASSERT_TRUE(storage->DropAggregateIndex(label, group, value).HasError());
+  EXPECT_THAT(storage->ListAllIndices().aggregate, IsEmpty());
+}
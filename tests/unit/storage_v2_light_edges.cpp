@@ -0,0 +1,198 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/v2/durability/paths.hpp"
+#include "storage/v2/durability/snapshot.hpp"
+#include "storage/v2/inmemory/storage.hpp"
+
+using memgraph::storage::Error;
+using memgraph::storage::PropertyValue;
+using memgraph::storage::View;
+
+class StorageV2LightEdgesTest : public testing::Test {
+ protected:
+  void SetUp() override { Clear(); }
+
+  void TearDown() override { Clear(); }
+
+  void Clear() {
+    if (!std::filesystem::exists(storage_directory_)) return;
+    std::filesystem::remove_all(storage_directory_);
+  }
+
+  memgraph::storage::Config MakeConfig(bool light_edges) const {
+    return {.items = {.properties_on_edges = true, .light_edges = light_edges},
+            .durability = {.storage_directory = storage_directory_}};
+  }
+
+  // Creates two vertices with an edge without properties and an edge with a
+  // property between them.
+  void CreateEdges(memgraph::storage::Storage *store) {
+    auto acc = store->Access();
+    auto from = acc->CreateVertex();
+    auto to = acc->CreateVertex();
+    auto plain = acc->CreateEdge(&from, &to, store->NameToEdgeType("plain"));
+    ASSERT_TRUE(plain.HasValue());
+    auto with_property = acc->CreateEdge(&from, &to, store->NameToEdgeType("with_property"));
+    ASSERT_TRUE(with_property.HasValue());
+    ASSERT_TRUE(with_property->SetProperty(store->NameToProperty("weight"), PropertyValue(5)).HasValue());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  // Returns the values of the `weight` property of the edges ordered by the
+  // name of their edge type.
+  std::vector<PropertyValue> Weights(memgraph::storage::Storage *store) {
+    auto acc = store->Access();
+    std::vector<PropertyValue> weights;
+    for (auto vertex : acc->Vertices(View::OLD)) {
+      auto edges = vertex.OutEdges(View::OLD);
+      if (!edges.HasValue() || edges->empty()) continue;
+      std::vector<std::pair<std::string, PropertyValue>> values;
+      for (auto &edge : *edges) {
+        auto value = edge.GetProperty(store->NameToProperty("weight"), View::OLD);
+        if (!value.HasValue()) continue;
+        values.emplace_back(store->EdgeTypeToName(edge.EdgeType()), *value);
+      }
+      std::sort(values.begin(), values.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+      for (auto &[name, value] : values) weights.push_back(value);
+    }
+    return weights;
+  }
+
+  std::filesystem::path storage_directory_{std::filesystem::temp_directory_path() /
+                                           "MG_test_unit_storage_v2_light_edges"};
+};
+
+TEST_F(StorageV2LightEdgesTest, PropertiesAreVersioned) {
+  std::unique_ptr<memgraph::storage::Storage> store(new memgraph::storage::InMemoryStorage(MakeConfig(true)));
+  CreateEdges(store.get());
+  EXPECT_EQ(Weights(store.get()), (std::vector<PropertyValue>{PropertyValue(), PropertyValue(5)}));
+
+  auto weight = store->NameToProperty("weight");
+  auto reader = store->Access();
+  {
+    // The edge without properties gets its object here.
+    auto acc = store->Access();
+    for (auto vertex : acc->Vertices(View::OLD)) {
+      auto edges = vertex.OutEdges(View::OLD);
+      ASSERT_TRUE(edges.HasValue());
+      for (auto &edge : *edges) {
+        ASSERT_TRUE(edge.SetProperty(weight, PropertyValue(1)).HasValue());
+        EXPECT_EQ(*edge.GetProperty(weight, View::NEW), PropertyValue(1));
+      }
+    }
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  EXPECT_EQ(Weights(store.get()), (std::vector<PropertyValue>{PropertyValue(1), PropertyValue(1)}));
+
+  // The transaction started before the change still sees the old values.
+  for (auto vertex : reader->Vertices(View::OLD)) {
+    auto edges = vertex.OutEdges(View::OLD);
+    ASSERT_TRUE(edges.HasValue());
+    for (auto &edge : *edges) {
+      auto expected = store->EdgeTypeToName(edge.EdgeType()) == "plain" ? PropertyValue() : PropertyValue(5);
+      EXPECT_EQ(*edge.GetProperty(weight, View::OLD), expected);
+      EXPECT_EQ(edge.SetProperty(weight, PropertyValue(2)).GetError(), Error::SERIALIZATION_ERROR);
+    }
+  }
+  reader->Abort();
+}
+
+TEST_F(StorageV2LightEdgesTest, DeleteAndAbort) {
+  std::unique_ptr<memgraph::storage::Storage> store(new memgraph::storage::InMemoryStorage(MakeConfig(true)));
+  CreateEdges(store.get());
+  auto weight = store->NameToProperty("weight");
+
+  {
+    // The edges created by an aborted transaction are removed with their
+    // objects.
+    auto acc = store->Access();
+    auto vertex = acc->CreateVertex();
+    auto edge = acc->CreateEdge(&vertex, &vertex, store->NameToEdgeType("aborted"));
+    ASSERT_TRUE(edge.HasValue());
+    ASSERT_TRUE(edge->SetProperty(weight, PropertyValue(3)).HasValue());
+    acc->Abort();
+  }
+  store->FreeMemory();
+
+  {
+    auto acc = store->Access();
+    for (auto vertex : acc->Vertices(View::OLD)) {
+      auto edges = vertex.OutEdges(View::OLD);
+      ASSERT_TRUE(edges.HasValue());
+      for (auto &edge : *edges) {
+        auto deleted = acc->DeleteEdge(&edge);
+        ASSERT_TRUE(deleted.HasValue());
+        ASSERT_TRUE(deleted->has_value());
+        EXPECT_EQ(edge.GetProperty(weight, View::NEW).GetError(), Error::DELETED_OBJECT);
+        EXPECT_EQ(edge.SetProperty(weight, PropertyValue(4)).GetError(), Error::DELETED_OBJECT);
+      }
+    }
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+  store->FreeMemory();
+  EXPECT_EQ(store->GetInfo().edge_count, 0);
+  EXPECT_TRUE(Weights(store.get()).empty());
+}
+
+TEST_F(StorageV2LightEdgesTest, EdgeTypePropertyIndexIsDisabled) {
+  std::unique_ptr<memgraph::storage::Storage> store(new memgraph::storage::InMemoryStorage(MakeConfig(true)));
+  EXPECT_TRUE(store->CreateIndex(store->NameToEdgeType("et"), store->NameToProperty("weight")).HasError());
+}
+
+TEST_F(StorageV2LightEdgesTest, SnapshotRecovery) {
+  // The snapshots written with and without light edges can be recovered in
+  // both modes.
+  for (const auto &[create_light, recover_light] :
+       std::vector<std::pair<bool, bool>>{{true, true}, {true, false}, {false, true}}) {
+    Clear();
+    {
+      auto config = MakeConfig(create_light);
+      config.durability.snapshot_on_exit = true;
+      std::unique_ptr<memgraph::storage::Storage> store(new memgraph::storage::InMemoryStorage(config));
+      CreateEdges(store.get());
+    }
+    auto config = MakeConfig(recover_light);
+    config.durability.recover_on_startup = true;
+    std::unique_ptr<memgraph::storage::Storage> store(new memgraph::storage::InMemoryStorage(config));
+    EXPECT_EQ(store->GetInfo().edge_count, 2);
+    EXPECT_EQ(Weights(store.get()), (std::vector<PropertyValue>{PropertyValue(), PropertyValue(5)}));
+  }
+}
+
+TEST_F(StorageV2LightEdgesTest, SnapshotRecordsLightEdges) {
+  // Only the snapshots without light edges must contain an object for every
+  // edge, so the recovery checks that the objects exist only for them.
+  for (const auto light_edges : {true, false}) {
+    Clear();
+    {
+      auto config = MakeConfig(light_edges);
+      config.durability.snapshot_on_exit = true;
+      std::unique_ptr<memgraph::storage::Storage> store(new memgraph::storage::InMemoryStorage(config));
+      CreateEdges(store.get());
+    }
+    std::vector<std::filesystem::path> snapshots;
+    for (const auto &entry :
+         std::filesystem::directory_iterator(storage_directory_ / memgraph::storage::durability::kSnapshotDirectory)) {
+      snapshots.push_back(entry.path());
+    }
+    ASSERT_EQ(snapshots.size(), 1);
+    EXPECT_EQ(memgraph::storage::durability::ReadSnapshotInfo(snapshots[0]).light_edges, light_edges);
+  }
+}
@@ -0,0 +1,203 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <gtest/gtest.h>
+
+#include "storage/v2/inmemory/storage.hpp"
+#include "storage/v2/long_delta_chains.hpp"
+#include "storage/v2/vertex_info_cache.hpp"
+
+using memgraph::storage::Gid;
+using memgraph::storage::LongDeltaChains;
+using memgraph::storage::PropertyValue;
+using memgraph::storage::View;
+
+TEST(StorageV2LongDeltaChains, KeepsLongestChains) {
+  LongDeltaChains chains;
+  chains.Record(Gid::FromUint(1), 200, 2);
+  chains.Record(Gid::FromUint(1), 150, 2);
+  chains.Record(Gid::FromUint(2), 300, 2);
+  chains.Record(Gid::FromUint(3), 100, 2);
+  chains.Record(Gid::FromUint(4), 400, 2);
+
+  const auto info = chains.GetInfo();
+  ASSERT_EQ(info.size(), 2);
+  EXPECT_EQ(info[0].gid, Gid::FromUint(4));
+  EXPECT_EQ(info[1].gid, Gid::FromUint(2));
+  EXPECT_EQ(info[1].max_length, 300);
+  EXPECT_EQ(info[1].long_reads, 1);
+
+  chains.Record(Gid::FromUint(5), 1000, 0);
+  EXPECT_EQ(chains.GetInfo().size(), 2);
+}
+
+class StorageV2LongDeltaChainsTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    cache_threshold_ = FLAGS_delta_chain_cache_threshold;
+    materialize_threshold_ = FLAGS_delta_chain_materialize_threshold;
+    FLAGS_delta_chain_cache_threshold = 10;
+    FLAGS_delta_chain_materialize_threshold = 10;
+  }
+
+  void TearDown() override {
+    FLAGS_delta_chain_cache_threshold = cache_threshold_;
+    FLAGS_delta_chain_materialize_threshold = materialize_threshold_;
+  }
+
+  std::unique_ptr<memgraph::storage::Storage> storage_{std::make_unique<memgraph::storage::InMemoryStorage>()};
+
+ private:
+  uint64_t cache_threshold_{0};
+  uint64_t materialize_threshold_{0};
+};
+
+TEST_F(StorageV2LongDeltaChainsTest, ReadersShareMaterializedVersion) {
+  Gid gid;
+  memgraph::storage::PropertyId property;
+  {
+    auto acc = storage_->Access();
+    auto vertex = acc->CreateVertex();
+    gid = vertex.Gid();
+    property = acc->NameToProperty("views");
+    ASSERT_FALSE(vertex.SetProperty(property, PropertyValue(0)).HasError());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  auto first_reader = storage_->Access();
+  auto second_reader = storage_->Access();
+  for (int64_t i = 1; i <= 20; ++i) {
+    auto acc = storage_->Access();
+    auto vertex = acc->FindVertex(gid, View::OLD);
+    ASSERT_TRUE(vertex);
+    ASSERT_FALSE(vertex->SetProperty(property, PropertyValue(i)).HasError());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  {
+    auto vertex = first_reader->FindVertex(gid, View::OLD);
+    ASSERT_TRUE(vertex);
+    EXPECT_EQ(*vertex->GetProperty(property, View::OLD), PropertyValue(0));
+  }
+  EXPECT_EQ(storage_->long_delta_chains_.VersionCount(), 1);
+  const auto info = first_reader->LongDeltaChainsInfo();
+  ASSERT_EQ(info.size(), 1);
+  EXPECT_EQ(info[0].gid, gid);
+  EXPECT_EQ(info[0].max_length, 20);
+
+  {
+    auto vertex = second_reader->FindVertex(gid, View::OLD);
+    ASSERT_TRUE(vertex);
+    EXPECT_EQ(*vertex->GetProperty(property, View::OLD), PropertyValue(0));
+    EXPECT_EQ(vertex->Properties(View::OLD)->size(), 1);
+  }
+  // The second reader didn't walk the chain.
+  EXPECT_EQ(second_reader->LongDeltaChainsInfo()[0].long_reads, info[0].long_reads);
+
+  {
+    auto acc = storage_->Access();
+    auto vertex = acc->FindVertex(gid, View::OLD);
+    ASSERT_TRUE(vertex);
+    EXPECT_EQ(*vertex->GetProperty(property, View::OLD), PropertyValue(20));
+  }
+
+  first_reader->Abort();
+  second_reader->Abort();
+  first_reader.reset();
+  second_reader.reset();
+  storage_->FreeMemory();
+  EXPECT_EQ(storage_->long_delta_chains_.VersionCount(), 0);
+}
+
+TEST_F(StorageV2LongDeltaChainsTest, ReadersShareMaterializedDegree) {
+  Gid gid;
+  memgraph::storage::EdgeTypeId edge_type;
+  {
+    auto acc = storage_->Access();
+    gid = acc->CreateVertex().Gid();
+    edge_type = acc->NameToEdgeType("LIKES");
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  auto first_reader = storage_->Access();
+  auto second_reader = storage_->Access();
+  for (int64_t i = 0; i < 20; ++i) {
+    auto acc = storage_->Access();
+    auto hub = acc->FindVertex(gid, View::OLD);
+    ASSERT_TRUE(hub);
+    auto other = acc->CreateVertex();
+    ASSERT_FALSE(acc->CreateEdge(&other, &*hub, edge_type).HasError());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  {
+    auto vertex = first_reader->FindVertex(gid, View::OLD);
+    ASSERT_TRUE(vertex);
+    EXPECT_EQ(*vertex->InDegree(View::OLD), 0);
+  }
+  const auto long_reads = first_reader->LongDeltaChainsInfo()[0].long_reads;
+  {
+    auto vertex = second_reader->FindVertex(gid, View::OLD);
+    ASSERT_TRUE(vertex);
+    EXPECT_EQ(*vertex->InDegree(View::OLD), 0);
+    EXPECT_EQ(*vertex->OutDegree(View::OLD), 0);
+  }
+  // The second reader didn't walk the chain.
+  EXPECT_EQ(second_reader->LongDeltaChainsInfo()[0].long_reads, long_reads);
+
+  {
+    auto acc = storage_->Access();
+    auto vertex = acc->FindVertex(gid, View::OLD);
+    ASSERT_TRUE(vertex);
+    EXPECT_EQ(*vertex->InDegree(View::OLD), 20);
+  }
+}
+
+TEST_F(StorageV2LongDeltaChainsTest, IndexReadersShareMaterializedVersion) {
+  Gid gid;
+  const auto label = storage_->NameToLabel("Page");
+  const auto property = storage_->NameToProperty("views");
+  ASSERT_FALSE(storage_->CreateIndex(label, property).HasError());
+  {
+    auto acc = storage_->Access();
+    auto vertex = acc->CreateVertex();
+    gid = vertex.Gid();
+    ASSERT_FALSE(vertex.AddLabel(label).HasError());
+    ASSERT_FALSE(vertex.SetProperty(property, PropertyValue(0)).HasError());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  auto first_reader = storage_->Access();
+  auto second_reader = storage_->Access();
+  for (int64_t i = 1; i <= 20; ++i) {
+    auto acc = storage_->Access();
+    auto vertex = acc->FindVertex(gid, View::OLD);
+    ASSERT_TRUE(vertex);
+    ASSERT_FALSE(vertex->SetProperty(property, PropertyValue(i)).HasError());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  auto count = [&](auto &acc, const PropertyValue &value) {
+    size_t count = 0;
+    for (auto vertex : acc->Vertices(label, property, value, View::OLD)) {
+      EXPECT_EQ(vertex.Gid(), gid);
+      ++count;
+    }
+    return count;
+  };
+  EXPECT_EQ(count(first_reader, PropertyValue(0)), 1);
+  EXPECT_EQ(count(first_reader, PropertyValue(20)), 0);
+  const auto long_reads = first_reader->LongDeltaChainsInfo()[0].long_reads;
+  EXPECT_EQ(count(second_reader, PropertyValue(0)), 1);
+  EXPECT_EQ(count(second_reader, PropertyValue(20)), 0);
+  // The second reader didn't walk the chain.
+  EXPECT_EQ(second_reader->LongDeltaChainsInfo()[0].long_reads, long_reads);
+}
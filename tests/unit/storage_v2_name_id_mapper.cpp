@@ -45,3 +45,22 @@ TEST(NameIdMapper, Correctness) {
   ASSERT_EQ(mapper.IdToName(1), "n2");
   ASSERT_EQ(mapper.IdToName(0), "n1");
 }
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(NameIdMapper, ManyNamesAndMappers) {
+  // The names span several chunks of the id table.
+  memgraph::storage::NameIdMapper mapper;
+  for (uint64_t i = 0; i < 5000; ++i) {
+    ASSERT_EQ(mapper.NameToId("n" + std::to_string(i)), i);
+  }
+  for (uint64_t i = 0; i < 5000; ++i) {
+    ASSERT_EQ(mapper.IdToName(i), "n" + std::to_string(i));
+    ASSERT_EQ(mapper.NameToId("n" + std::to_string(i)), i);
+  }
+
+  // The names cached by the thread for one mapper aren't used for another.
+  memgraph::storage::NameIdMapper other_mapper;
+  ASSERT_EQ(other_mapper.NameToId("n4999"), 0);
+  ASSERT_EQ(other_mapper.IdToName(0), "n4999");
+  ASSERT_EQ(mapper.NameToId("n4999"), 4999);
+}
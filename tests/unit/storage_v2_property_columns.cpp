@@ -0,0 +1,93 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <gtest/gtest.h>
+
+#include "storage/v2/inmemory/storage.hpp"
+#include "storage/v2/property_columns.hpp"
+
+using memgraph::storage::PropertyValue;
+using memgraph::storage::StorageMode;
+
+class StorageV2PropertyColumnsTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    enabled_ = FLAGS_storage_property_columns;
+    FLAGS_storage_property_columns = true;
+    storage_->SetStorageMode(StorageMode::IN_MEMORY_ANALYTICAL);
+    label_ = storage_->NameToLabel("label");
+    property_ = storage_->NameToProperty("property");
+    ASSERT_FALSE(storage_->CreateIndex(label_).HasError());
+  }
+
+  void TearDown() override { FLAGS_storage_property_columns = enabled_; }
+
+  std::unique_ptr<memgraph::storage::Storage> storage_{std::make_unique<memgraph::storage::InMemoryStorage>()};
+  memgraph::storage::LabelId label_;
+  memgraph::storage::PropertyId property_;
+
+ private:
+  bool enabled_{false};
+};
+
+TEST_F(StorageV2PropertyColumnsTest, ColumnsAreTypedAndCached) {
+  {
+    auto acc = storage_->Access();
+    for (int64_t i = 0; i < 10; ++i) {
+      auto vertex = acc->CreateVertex();
+      ASSERT_TRUE(vertex.AddLabel(label_).HasValue());
+      if (i % 5 == 0) continue;
+      const auto value = i % 3 == 0 ? PropertyValue(0.5 * static_cast<double>(i)) : PropertyValue(i);
+      ASSERT_TRUE(vertex.SetProperty(property_, value).HasValue());
+    }
+    // A vertex without the label isn't in the column.
+    ASSERT_TRUE(acc->CreateVertex().SetProperty(property_, PropertyValue(100)).HasValue());
+    auto vertex = acc->CreateVertex();
+    ASSERT_TRUE(vertex.AddLabel(label_).HasValue());
+    ASSERT_TRUE(vertex.SetProperty(property_, PropertyValue("text")).HasValue());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  auto acc = storage_->Access();
+  auto column = acc->GetPropertyColumn(label_, property_);
+  ASSERT_TRUE(column);
+  EXPECT_EQ(column->vertex_count, 11);
+  EXPECT_EQ(column->ints, (std::vector<int64_t>{1, 2, 4, 7, 8}));
+  EXPECT_EQ(column->doubles, (std::vector<double>{1.5, 3.0, 4.5}));
+  ASSERT_EQ(column->others.size(), 1);
+  EXPECT_EQ(column->others[0], PropertyValue("text"));
+  EXPECT_EQ(acc->GetPropertyColumn(label_, property_), column);
+
+  // The columns are rebuilt after any change.
+  auto vertex = acc->CreateVertex();
+  ASSERT_TRUE(vertex.AddLabel(label_).HasValue());
+  auto rebuilt = acc->GetPropertyColumn(label_, property_);
+  ASSERT_TRUE(rebuilt);
+  EXPECT_NE(rebuilt, column);
+  EXPECT_EQ(rebuilt->vertex_count, 12);
+  ASSERT_TRUE(vertex.SetProperty(property_, PropertyValue(9)).HasValue());
+  EXPECT_EQ(acc->GetPropertyColumn(label_, property_)->ints.size(), 6);
+  ASSERT_FALSE(acc->Commit().HasError());
+}
+
+TEST_F(StorageV2PropertyColumnsTest, OnlyInAnalyticalModeWithIndex) {
+  auto unindexed = storage_->NameToLabel("unindexed");
+  {
+    auto acc = storage_->Access();
+    EXPECT_FALSE(acc->GetPropertyColumn(unindexed, property_));
+    EXPECT_TRUE(acc->GetPropertyColumn(label_, property_));
+  }
+  storage_->SetStorageMode(StorageMode::IN_MEMORY_TRANSACTIONAL);
+  {
+    auto acc = storage_->Access();
+    EXPECT_FALSE(acc->GetPropertyColumn(label_, property_));
+  }
+}
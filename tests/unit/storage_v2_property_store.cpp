@@ -12,8 +12,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <filesystem>
 #include <limits>
+#include <mutex>
 
+#include "storage/v2/cold_value_store.hpp"
 #include "storage/v2/id_types.hpp"
 #include "storage/v2/property_store.hpp"
 #include "storage/v2/property_value.hpp"
@@ -704,6 +707,30 @@ TEST(PropertyStore, HasAllProperties) {
                               memgraph::storage::PropertyId::FromInt(3)}));
 }
 
+TEST(PropertyStore, GetProperties) {
+  const std::vector<std::pair<memgraph::storage::PropertyId, memgraph::storage::PropertyValue>> data{
+      {memgraph::storage::PropertyId::FromInt(1), memgraph::storage::PropertyValue(true)},
+      {memgraph::storage::PropertyId::FromInt(2), memgraph::storage::PropertyValue(123)},
+      {memgraph::storage::PropertyId::FromInt(3), memgraph::storage::PropertyValue("three")},
+      {memgraph::storage::PropertyId::FromInt(5), memgraph::storage::PropertyValue(0.0)}};
+
+  memgraph::storage::PropertyStore store;
+  EXPECT_TRUE(store.InitProperties(data));
+  // The values are returned in the requested order, including duplicates and
+  // properties which aren't in the store.
+  const auto values = store.GetProperties(
+      {memgraph::storage::PropertyId::FromInt(5), memgraph::storage::PropertyId::FromInt(4),
+       memgraph::storage::PropertyId::FromInt(1), memgraph::storage::PropertyId::FromInt(5),
+       memgraph::storage::PropertyId::FromInt(3)});
+  ASSERT_EQ(values.size(), 5);
+  EXPECT_EQ(values[0], memgraph::storage::PropertyValue(0.0));
+  EXPECT_TRUE(values[1].IsNull());
+  EXPECT_EQ(values[2], memgraph::storage::PropertyValue(true));
+  EXPECT_EQ(values[3], memgraph::storage::PropertyValue(0.0));
+  EXPECT_EQ(values[4], memgraph::storage::PropertyValue("three"));
+  EXPECT_TRUE(store.GetProperties({}).empty());
+}
+
 TEST(PropertyStore, HasAllPropertyValues) {
   const std::vector<std::pair<memgraph::storage::PropertyId, memgraph::storage::PropertyValue>> data{
       {memgraph::storage::PropertyId::FromInt(1), memgraph::storage::PropertyValue(true)},
@@ -727,3 +754,303 @@ TEST(PropertyStore, HasAnyProperties) {
   EXPECT_FALSE(store.HasAllPropertyValues({memgraph::storage::PropertyValue(0.0), memgraph::storage::PropertyValue(123),
                                            memgraph::storage::PropertyValue("three")}));
 }
+
+TEST(PropertyStore, LargeValuesOutOfLine) {
+  auto small_prop = memgraph::storage::PropertyId::FromInt(1);
+  auto string_prop = memgraph::storage::PropertyId::FromInt(2);
+  auto list_prop = memgraph::storage::PropertyId::FromInt(3);
+  auto last_prop = memgraph::storage::PropertyId::FromInt(4);
+
+  const auto small_value = memgraph::storage::PropertyValue(42);
+  const auto string_value = memgraph::storage::PropertyValue(std::string(100000, 'x'));
+  std::vector<memgraph::storage::PropertyValue> list;
+  for (int i = 0; i < 1000; ++i) list.emplace_back(i);
+  const auto list_value = memgraph::storage::PropertyValue(list);
+  const auto last_value = memgraph::storage::PropertyValue("last");
+
+  memgraph::storage::PropertyStore props;
+  ASSERT_TRUE(props.SetProperty(string_prop, string_value));
+  ASSERT_TRUE(props.SetProperty(small_prop, small_value));
+  ASSERT_TRUE(props.SetProperty(list_prop, list_value));
+  ASSERT_TRUE(props.SetProperty(last_prop, last_value));
+  ASSERT_EQ(props.GetProperty(string_prop), string_value);
+  ASSERT_EQ(props.GetProperty(list_prop), list_value);
+  ASSERT_EQ(props.GetProperty(last_prop), last_value);
+  TestIsPropertyEqual(props, string_prop, string_value);
+  TestIsPropertyEqual(props, list_prop, list_value);
+  ASSERT_FALSE(props.IsPropertyEqual(string_prop, memgraph::storage::PropertyValue(std::string(99999, 'x'))));
+
+  // Updating a small property keeps the large ones intact.
+  ASSERT_FALSE(props.SetProperty(small_prop, memgraph::storage::PropertyValue(43)));
+  ASSERT_EQ(props.GetProperty(small_prop), memgraph::storage::PropertyValue(43));
+  ASSERT_EQ(props.GetProperty(string_prop), string_value);
+
+  // Replacing a large value with a small one and vice versa.
+  ASSERT_FALSE(props.SetProperty(string_prop, memgraph::storage::PropertyValue("short")));
+  ASSERT_EQ(props.GetProperty(string_prop), memgraph::storage::PropertyValue("short"));
+  ASSERT_FALSE(props.SetProperty(small_prop, string_value));
+  ASSERT_EQ(props.GetProperty(small_prop), string_value);
+
+  // The persisted buffer has all of the values inline.
+  auto restored = memgraph::storage::PropertyStore::CreateFromBuffer(props.StringBuffer());
+  ASSERT_EQ(restored.Properties(), props.Properties());
+
+  ASSERT_FALSE(props.SetProperty(list_prop, memgraph::storage::PropertyValue()));
+  ASSERT_FALSE(props.HasProperty(list_prop));
+  ASSERT_EQ(props.GetProperty(last_prop), last_value);
+
+  memgraph::storage::PropertyStore moved(std::move(props));
+  ASSERT_EQ(moved.GetProperty(small_prop), string_value);
+  ASSERT_TRUE(moved.ClearProperties());
+  ASSERT_EQ(moved.Properties().size(), 0);
+
+  memgraph::storage::PropertyStore initialized;
+  ASSERT_TRUE(initialized.InitProperties(
+      std::map<memgraph::storage::PropertyId, memgraph::storage::PropertyValue>{{string_prop, string_value},
+                                                                                 {list_prop, list_value}}));
+  ASSERT_EQ(initialized.GetProperty(string_prop), string_value);
+  ASSERT_EQ(initialized.GetProperty(list_prop), list_value);
+}
+
+TEST(PropertyStore, ManyPropertiesIndexed) {
+  memgraph::storage::PropertyStore props;
+  auto const value_for = [](uint64_t id) {
+    if (id % 3 == 0) return memgraph::storage::PropertyValue(std::string(id % 20, 'a'));
+    if (id % 3 == 1) return memgraph::storage::PropertyValue(static_cast<int64_t>(id * 1000));
+    return memgraph::storage::PropertyValue(static_cast<double>(id) / 7);
+  };
+
+  // Properties are set in a scattered order so that the index gets rebuilt at
+  // different sizes.
+  std::map<memgraph::storage::PropertyId, memgraph::storage::PropertyValue> expected;
+  for (uint64_t i = 0; i < 60; ++i) {
+    auto id = (i * 37) % 61 + 1;
+    auto prop = memgraph::storage::PropertyId::FromUint(id);
+    ASSERT_TRUE(props.SetProperty(prop, value_for(id)));
+    expected.emplace(prop, value_for(id));
+  }
+  ASSERT_EQ(props.Properties(), expected);
+  for (uint64_t id = 0; id <= 63; ++id) {
+    auto prop = memgraph::storage::PropertyId::FromUint(id);
+    auto it = expected.find(prop);
+    if (it == expected.end()) {
+      ASSERT_FALSE(props.HasProperty(prop));
+      ASSERT_TRUE(props.GetProperty(prop).IsNull());
+      ASSERT_TRUE(props.IsPropertyEqual(prop, memgraph::storage::PropertyValue()));
+    } else {
+      ASSERT_TRUE(props.HasProperty(prop));
+      ASSERT_EQ(props.GetProperty(prop), it->second);
+      TestIsPropertyEqual(props, prop, it->second);
+    }
+  }
+
+  std::set<memgraph::storage::PropertyId> present{memgraph::storage::PropertyId::FromUint(2),
+                                                  memgraph::storage::PropertyId::FromUint(30),
+                                                  memgraph::storage::PropertyId::FromUint(59)};
+  ASSERT_TRUE(props.HasAllProperties(present));
+  auto values = props.ExtractPropertyValues(present);
+  ASSERT_TRUE(values);
+  ASSERT_THAT(*values, ::testing::ElementsAre(value_for(2), value_for(30), value_for(59)));
+  present.insert(memgraph::storage::PropertyId::FromUint(63));
+  ASSERT_FALSE(props.HasAllProperties(present));
+  ASSERT_FALSE(props.ExtractPropertyValues(present));
+
+  // Updating and removing keeps the store consistent.
+  for (uint64_t id = 1; id <= 61; id += 2) {
+    auto prop = memgraph::storage::PropertyId::FromUint(id);
+    auto it = expected.find(prop);
+    if (it == expected.end()) continue;
+    ASSERT_FALSE(props.SetProperty(prop, memgraph::storage::PropertyValue()));
+    expected.erase(it);
+  }
+  ASSERT_FALSE(props.SetProperty(memgraph::storage::PropertyId::FromUint(10),
+                                 memgraph::storage::PropertyValue(std::string(100, 'b'))));
+  expected[memgraph::storage::PropertyId::FromUint(10)] = memgraph::storage::PropertyValue(std::string(100, 'b'));
+  ASSERT_EQ(props.Properties(), expected);
+  for (const auto &[prop, value] : expected) ASSERT_EQ(props.GetProperty(prop), value);
+
+  auto restored = memgraph::storage::PropertyStore::CreateFromBuffer(props.StringBuffer());
+  ASSERT_EQ(restored.Properties(), expected);
+  ASSERT_EQ(restored.GetProperty(memgraph::storage::PropertyId::FromUint(10)), expected.at(
+                                                                                   memgraph::storage::PropertyId::FromUint(10)));
+
+  memgraph::storage::PropertyStore initialized;
+  ASSERT_TRUE(initialized.InitProperties(expected));
+  for (const auto &[prop, value] : expected) ASSERT_EQ(initialized.GetProperty(prop), value);
+  ASSERT_FALSE(initialized.HasProperty(memgraph::storage::PropertyId::FromUint(1)));
+}
+
+TEST(PropertyStore, CompressedValues) {
+  memgraph::storage::PropertyStore::EnableCompression(true);
+  auto const text_prop = memgraph::storage::PropertyId::FromInt(1);
+  auto const list_prop = memgraph::storage::PropertyId::FromInt(2);
+  auto const small_prop = memgraph::storage::PropertyId::FromInt(3);
+  std::string text;
+  for (int i = 0; i < 500; ++i) text += "a repetitive sentence ";
+  auto const text_value = memgraph::storage::PropertyValue(text);
+  auto const list_value = memgraph::storage::PropertyValue(
+      std::vector<memgraph::storage::PropertyValue>(300, memgraph::storage::PropertyValue("item")));
+  auto const small_value = memgraph::storage::PropertyValue(std::string(600, 'z'));
+
+  memgraph::storage::PropertyStore props;
+  ASSERT_TRUE(props.SetProperty(text_prop, text_value));
+  ASSERT_TRUE(props.SetProperty(list_prop, list_value));
+  memgraph::storage::PropertyStore::EnableCompression(false);
+  // Values stored while compression is disabled stay uncompressed.
+  ASSERT_TRUE(props.SetProperty(small_prop, small_value));
+  memgraph::storage::PropertyStore::EnableCompression(true);
+
+  ASSERT_EQ(props.GetProperty(text_prop), text_value);
+  ASSERT_EQ(props.GetProperty(list_prop), list_value);
+  ASSERT_EQ(props.GetProperty(small_prop), small_value);
+  TestIsPropertyEqual(props, text_prop, text_value);
+  TestIsPropertyEqual(props, list_prop, list_value);
+  ASSERT_FALSE(props.IsPropertyEqual(text_prop, memgraph::storage::PropertyValue(text + "x")));
+
+  ASSERT_FALSE(props.SetProperty(text_prop, list_value));
+  ASSERT_EQ(props.GetProperty(text_prop), list_value);
+  ASSERT_EQ(props.Properties().size(), 3);
+
+  auto restored = memgraph::storage::PropertyStore::CreateFromBuffer(props.StringBuffer());
+  ASSERT_EQ(restored.Properties(), props.Properties());
+
+  ASSERT_TRUE(props.ClearProperties());
+  ASSERT_EQ(props.Properties().size(), 0);
+  memgraph::storage::PropertyStore::EnableCompression(false);
+}
+
+TEST(PropertyStore, Defragment) {
+  memgraph::storage::PropertyStore props;
+  // The empty and the small stores don't have a buffer to move.
+  ASSERT_FALSE(props.Defragment());
+  auto const small_prop = memgraph::storage::PropertyId::FromInt(1);
+  ASSERT_TRUE(props.SetProperty(small_prop, memgraph::storage::PropertyValue(true)));
+  ASSERT_FALSE(props.Defragment());
+
+  auto const large_prop = memgraph::storage::PropertyId::FromInt(2);
+  auto const large_value = memgraph::storage::PropertyValue(std::string(100, 'a'));
+  ASSERT_TRUE(props.SetProperty(large_prop, large_value));
+  // Whether the buffer is moved depends on the allocator, the properties stay
+  // the same either way.
+  props.Defragment();
+  ASSERT_EQ(props.GetProperty(small_prop), memgraph::storage::PropertyValue(true));
+  ASSERT_EQ(props.GetProperty(large_prop), large_value);
+  ASSERT_EQ(props.Properties().size(), 2);
+}
+
+TEST(PropertyStore, EvictedValues) {
+  const auto directory = std::filesystem::temp_directory_path() / "MG_test_unit_storage_v2_property_store_cold";
+  {
+    memgraph::storage::ColdValueStore cold_store(directory);
+    memgraph::storage::PropertyStore::EnableCompression(true);
+    auto const text_prop = memgraph::storage::PropertyId::FromInt(1);
+    auto const list_prop = memgraph::storage::PropertyId::FromInt(2);
+    auto const small_prop = memgraph::storage::PropertyId::FromInt(3);
+    std::string text;
+    for (int i = 0; i < 500; ++i) text += "a repetitive sentence ";
+    auto const text_value = memgraph::storage::PropertyValue(text);
+    auto const list_value = memgraph::storage::PropertyValue(
+        std::vector<memgraph::storage::PropertyValue>(40, memgraph::storage::PropertyValue("item")));
+    auto const small_value = memgraph::storage::PropertyValue(42);
+
+    memgraph::storage::PropertyStore props;
+    ASSERT_TRUE(props.SetProperty(text_prop, text_value));
+    memgraph::storage::PropertyStore::EnableCompression(false);
+    ASSERT_TRUE(props.SetProperty(list_prop, list_value));
+    ASSERT_TRUE(props.SetProperty(small_prop, small_value));
+    const auto properties = props.Properties();
+
+    ASSERT_GT(props.EvictLargeValues(&cold_store), 0);
+    ASSERT_EQ(cold_store.Count(), 2);
+    // The evicted values are already in the cold store.
+    ASSERT_EQ(props.EvictLargeValues(&cold_store), 0);
+    ASSERT_EQ(props.GetProperty(text_prop), text_value);
+    ASSERT_EQ(props.GetProperty(list_prop), list_value);
+    TestIsPropertyEqual(props, text_prop, text_value);
+    ASSERT_EQ(props.Properties(), properties);
+    auto restored = memgraph::storage::PropertyStore::CreateFromBuffer(props.StringBuffer());
+    ASSERT_EQ(restored.Properties(), properties);
+
+    ASSERT_TRUE(props.LoadColdValues());
+    // The loaded values are deleted from the cold store later.
+    ASSERT_EQ(cold_store.Count(), 2);
+    cold_store.DeletePending();
+    ASSERT_EQ(cold_store.Count(), 0);
+    ASSERT_FALSE(props.LoadColdValues());
+    ASSERT_EQ(props.Properties(), properties);
+
+    // Overwritten and cleared values are removed from the cold store.
+    ASSERT_GT(props.EvictLargeValues(&cold_store), 0);
+    ASSERT_FALSE(props.SetProperty(text_prop, small_value));
+    cold_store.DeletePending();
+    ASSERT_EQ(cold_store.Count(), 1);
+    ASSERT_EQ(props.GetProperty(list_prop), list_value);
+    ASSERT_TRUE(props.ClearProperties());
+    cold_store.DeletePending();
+    ASSERT_EQ(cold_store.Count(), 0);
+  }
+  std::filesystem::remove_all(directory);
+}
+
+TEST(PropertyStore, EvictedValuesLoadedWithoutLock) {
+  const auto directory = std::filesystem::temp_directory_path() / "MG_test_unit_storage_v2_property_store_cold";
+  {
+    memgraph::storage::ColdValueStore cold_store(directory);
+    struct Object {
+      std::mutex lock;
+      memgraph::storage::PropertyStore properties;
+    } object;
+    auto const prop = memgraph::storage::PropertyId::FromInt(1);
+    auto const value = memgraph::storage::PropertyValue(std::string(1000, 'a'));
+    ASSERT_TRUE(object.properties.SetProperty(prop, value));
+
+    ASSERT_GT(object.properties.EvictLargeValues(&cold_store), 0);
+    ASSERT_EQ(object.properties.EvictedValues().size(), 1);
+    {
+      auto guard = memgraph::storage::LockWithLoadedProperties(object);
+      ASSERT_TRUE(guard.owns_lock());
+      ASSERT_TRUE(object.properties.EvictedValues().empty());
+      ASSERT_EQ(object.properties.GetProperty(prop), value);
+    }
+    cold_store.DeletePending();
+    ASSERT_EQ(cold_store.Count(), 0);
+
+    // A value changed after it was read isn't replaced by the read one.
+    ASSERT_GT(object.properties.EvictLargeValues(&cold_store), 0);
+    const auto evicted = object.properties.EvictedValues();
+    auto blocks = memgraph::storage::PropertyStore::ReadEvictedValues(evicted);
+    ASSERT_FALSE(object.properties.SetProperty(prop, memgraph::storage::PropertyValue(42)));
+    object.properties.RestoreEvictedValues(evicted, std::move(blocks));
+    ASSERT_EQ(object.properties.GetProperty(prop), memgraph::storage::PropertyValue(42));
+  }
+  std::filesystem::remove_all(directory);
+}
+
+TEST(PropertyStore, FailedEvictedValueRead) {
+  const auto directory = std::filesystem::temp_directory_path() / "MG_test_unit_storage_v2_property_store_cold";
+  {
+    memgraph::storage::ColdValueStore cold_store(directory);
+    struct Object {
+      std::mutex lock;
+      memgraph::storage::PropertyStore properties;
+    } object;
+    auto const prop = memgraph::storage::PropertyId::FromInt(1);
+    ASSERT_TRUE(object.properties.SetProperty(prop, memgraph::storage::PropertyValue(std::string(1000, 'a'))));
+    ASSERT_GT(object.properties.EvictLargeValues(&cold_store), 0);
+
+    // The evicted value disappears from the disk, so it can't be read back.
+    const auto evicted = object.properties.EvictedValues();
+    ASSERT_EQ(evicted.size(), 1);
+    cold_store.Delete(evicted[0].key);
+
+    ASSERT_THROW(object.properties.GetProperty(prop), memgraph::storage::ColdValueStoreException);
+    ASSERT_THROW(object.properties.Properties(), memgraph::storage::ColdValueStoreException);
+    ASSERT_THROW(memgraph::storage::LockWithLoadedProperties(object), memgraph::storage::ColdValueStoreException);
+    ASSERT_THROW(object.properties.LoadColdValues(), memgraph::storage::ColdValueStoreException);
+    // The value stays evicted and the lock isn't left held.
+    ASSERT_EQ(object.properties.EvictedValues().size(), 1);
+    ASSERT_TRUE(object.lock.try_lock());
+    object.lock.unlock();
+  }
+  std::filesystem::remove_all(directory);
+}
@@ -18,10 +18,17 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <storage/v2/durability/paths.hpp>
 #include <storage/v2/inmemory/storage.hpp>
 #include <storage/v2/property_value.hpp>
 #include <storage/v2/replication/enums.hpp>
+#include "communication/context.hpp"
+#include "rpc/client.hpp"
+#include "storage/v2/durability/wal.hpp"
+#include "storage/v2/name_id_mapper.hpp"
 #include "storage/v2/replication/config.hpp"
+#include "storage/v2/replication/rpc.hpp"
+#include "storage/v2/replication/serialization.hpp"
 #include "storage/v2/storage.hpp"
 #include "storage/v2/view.hpp"
 
@@ -517,6 +524,112 @@ TEST_F(ReplicationTest, RecoveryProcess) {
   }
 }
 
+TEST_F(ReplicationTest, CompressedRecoveryProcess) {
+  std::vector<memgraph::storage::Gid> vertex_gids;
+  {
+    // Force the creation of snapshot
+    std::unique_ptr<memgraph::storage::Storage> main_store{new memgraph::storage::InMemoryStorage(
+        {.durability = {
+             .storage_directory = storage_directory,
+             .snapshot_wal_mode = memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL,
+             .snapshot_on_exit = true,
+         }})};
+    auto acc = main_store->Access();
+    for (int i = 0; i < 1000; ++i) {
+      vertex_gids.emplace_back(acc->CreateVertex().Gid());
+    }
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  std::unique_ptr<memgraph::storage::Storage> main_store{new memgraph::storage::InMemoryStorage(
+      {.durability = {
+           .storage_directory = storage_directory,
+           .recover_on_startup = true,
+           .snapshot_wal_mode = memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL,
+       }})};
+  auto *main_mem_store = static_cast<memgraph::storage::InMemoryStorage *>(main_store.get());
+  {
+    // Force the creation of current WAL file
+    auto acc = main_store->Access();
+    vertex_gids.emplace_back(acc->CreateVertex().Gid());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  std::filesystem::path replica_storage_directory{std::filesystem::temp_directory_path() /
+                                                  "MG_test_unit_storage_v2_replication_replica"};
+  memgraph::utils::OnScopeExit replica_directory_cleaner(
+      [&]() { std::filesystem::remove_all(replica_storage_directory); });
+
+  std::unique_ptr<memgraph::storage::Storage> replica_store{new memgraph::storage::InMemoryStorage(
+      {.durability = {.storage_directory = replica_storage_directory,
+                      .snapshot_wal_mode =
+                          memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL}})};
+  auto *replica_mem_store = static_cast<memgraph::storage::InMemoryStorage *>(replica_store.get());
+  replica_mem_store->SetReplicaRole(memgraph::io::network::Endpoint{local_host, ports[0]},
+                                    memgraph::storage::replication::ReplicationServerConfig{});
+
+  ASSERT_FALSE(main_mem_store
+                   ->RegisterReplica(replicas[0], memgraph::io::network::Endpoint{local_host, ports[0]},
+                                     memgraph::storage::replication::ReplicationMode::SYNC,
+                                     memgraph::storage::replication::RegistrationMode::MUST_BE_INSTANTLY_VALID,
+                                     memgraph::storage::replication::ReplicationClientConfig{.compression = true})
+                   .HasError());
+
+  while (main_mem_store->GetReplicaState(replicas[0]) != memgraph::storage::replication::ReplicaState::READY) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  auto acc = replica_store->Access();
+  for (const auto &vertex_gid : vertex_gids) {
+    ASSERT_TRUE(acc->FindVertex(vertex_gid, memgraph::storage::View::OLD));
+  }
+  ASSERT_FALSE(acc->Commit().HasError());
+}
+
+TEST_F(ReplicationTest, QuorumSynchronousReplicationTest) {
+  auto main_config = configuration;
+  main_config.durability.replication_sync_quorum = 1;
+  std::unique_ptr<memgraph::storage::Storage> main_store{new memgraph::storage::InMemoryStorage(main_config)};
+  auto *main_mem_store = static_cast<memgraph::storage::InMemoryStorage *>(main_store.get());
+
+  std::vector<std::unique_ptr<memgraph::storage::Storage>> replica_stores;
+  for (size_t i = 0; i < replicas.size(); ++i) {
+    auto &replica_store = replica_stores.emplace_back(new memgraph::storage::InMemoryStorage(configuration));
+    static_cast<memgraph::storage::InMemoryStorage *>(replica_store.get())
+        ->SetReplicaRole(memgraph::io::network::Endpoint{local_host, ports[i]},
+                         memgraph::storage::replication::ReplicationServerConfig{});
+    ASSERT_FALSE(main_mem_store
+                     ->RegisterReplica(replicas[i], memgraph::io::network::Endpoint{local_host, ports[i]},
+                                       memgraph::storage::replication::ReplicationMode::SYNC,
+                                       memgraph::storage::replication::RegistrationMode::MUST_BE_INSTANTLY_VALID,
+                                       memgraph::storage::replication::ReplicationClientConfig{})
+                     .HasError());
+  }
+
+  static constexpr size_t vertices_create_num = 100;
+  std::vector<memgraph::storage::Gid> created_vertices;
+  for (size_t i = 0; i < vertices_create_num; ++i) {
+    auto acc = main_store->Access();
+    created_vertices.push_back(acc->CreateVertex().Gid());
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+
+  for (const auto &replica : replicas) {
+    // The replicas that weren't awaited catch up in the background
+    while (main_mem_store->GetReplicaState(replica) != memgraph::storage::replication::ReplicaState::READY) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  for (const auto &replica_store : replica_stores) {
+    auto acc = replica_store->Access();
+    for (const auto &vertex_gid : created_vertices) {
+      ASSERT_TRUE(acc->FindVertex(vertex_gid, memgraph::storage::View::OLD));
+    }
+    ASSERT_FALSE(acc->Commit().HasError());
+  }
+}
+
 TEST_F(ReplicationTest, BasicAsynchronousReplicationTest) {
   std::unique_ptr<memgraph::storage::Storage> main_store{new memgraph::storage::InMemoryStorage(configuration)};
   auto *main_mem_store = static_cast<memgraph::storage::InMemoryStorage *>(main_store.get());
@@ -548,7 +661,8 @@ TEST_F(ReplicationTest, BasicAsynchronousReplicationTest) {
       ASSERT_EQ(main_mem_store->GetReplicaState("REPLICA_ASYNC"),
                 memgraph::storage::replication::ReplicaState::REPLICATING);
     } else {
-      ASSERT_EQ(main_mem_store->GetReplicaState("REPLICA_ASYNC"),
+      // Transactions committed while the previous one is being replicated are batched
+      ASSERT_NE(main_mem_store->GetReplicaState("REPLICA_ASYNC"),
                 memgraph::storage::replication::ReplicaState::RECOVERY);
     }
   }
@@ -566,6 +680,85 @@ TEST_F(ReplicationTest, BasicAsynchronousReplicationTest) {
   }));
 }
 
+TEST_F(ReplicationTest, RecoveryKeepsWalFilesNeededByReplica) {
+  memgraph::storage::Config main_config{
+      .durability = {
+          .storage_directory = storage_directory,
+          .snapshot_wal_mode = memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL,
+          .snapshot_retention_count = 1,
+          .wal_file_size_kibibytes = 1,
+      }};
+  std::unique_ptr<memgraph::storage::Storage> main_store{new memgraph::storage::InMemoryStorage(main_config)};
+  auto *main_mem_store = static_cast<memgraph::storage::InMemoryStorage *>(main_store.get());
+
+  std::filesystem::path replica_storage_directory{std::filesystem::temp_directory_path() /
+                                                  "MG_test_unit_storage_v2_replication_replica"};
+  memgraph::utils::OnScopeExit replica_directory_cleaner(
+      [&]() { std::filesystem::remove_all(replica_storage_directory); });
+  memgraph::storage::Config replica_config{
+      .durability = {.storage_directory = replica_storage_directory,
+                     .recover_on_startup = true,
+                     .snapshot_wal_mode =
+                         memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL}};
+
+  const auto property = main_store->NameToProperty("property");
+  const memgraph::storage::PropertyValue value{std::string(2048, 'a')};
+  std::vector<memgraph::storage::Gid> vertex_gids;
+  const auto create_vertex = [&] {
+    auto acc = main_store->Access();
+    auto v = acc->CreateVertex();
+    ASSERT_TRUE(v.SetProperty(property, value).HasValue());
+    vertex_gids.emplace_back(v.Gid());
+    ASSERT_FALSE(acc->Commit().HasError());
+  };
+
+  {
+    std::unique_ptr<memgraph::storage::Storage> replica_store{new memgraph::storage::InMemoryStorage(replica_config)};
+    static_cast<memgraph::storage::InMemoryStorage *>(replica_store.get())
+        ->SetReplicaRole(memgraph::io::network::Endpoint{local_host, ports[0]},
+                         memgraph::storage::replication::ReplicationServerConfig{});
+    ASSERT_FALSE(main_mem_store
+                     ->RegisterReplica(replicas[0], memgraph::io::network::Endpoint{local_host, ports[0]},
+                                       memgraph::storage::replication::ReplicationMode::ASYNC,
+                                       memgraph::storage::replication::RegistrationMode::MUST_BE_INSTANTLY_VALID,
+                                       memgraph::storage::replication::ReplicationClientConfig{})
+                     .HasError());
+    create_vertex();
+    while (main_mem_store->GetReplicaState(replicas[0]) != memgraph::storage::replication::ReplicaState::READY) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  // The replica is down while the WAL files are rotated and the snapshots are created
+  static constexpr size_t vertices_create_num = 10;
+  for (size_t i = 0; i < vertices_create_num; ++i) {
+    create_vertex();
+  }
+  while (main_mem_store->GetReplicaState(replicas[0]) != memgraph::storage::replication::ReplicaState::INVALID) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_FALSE(main_mem_store->CreateSnapshot({}).HasError());
+  ASSERT_FALSE(main_mem_store->CreateSnapshot({}).HasError());
+
+  const auto wal_directory = storage_directory / memgraph::storage::durability::kWalDirectory;
+  const auto wal_files = std::distance(std::filesystem::directory_iterator(wal_directory), {});
+  ASSERT_GT(wal_files, 1);
+
+  std::unique_ptr<memgraph::storage::Storage> replica_store{new memgraph::storage::InMemoryStorage(replica_config)};
+  static_cast<memgraph::storage::InMemoryStorage *>(replica_store.get())
+      ->SetReplicaRole(memgraph::io::network::Endpoint{local_host, ports[0]},
+                       memgraph::storage::replication::ReplicationServerConfig{});
+  while (main_mem_store->GetReplicaState(replicas[0]) != memgraph::storage::replication::ReplicaState::READY) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  auto acc = replica_store->Access();
+  for (const auto &vertex_gid : vertex_gids) {
+    ASSERT_TRUE(acc->FindVertex(vertex_gid, memgraph::storage::View::OLD));
+  }
+  ASSERT_FALSE(acc->Commit().HasError());
+}
+
 TEST_F(ReplicationTest, EpochTest) {
   std::unique_ptr<memgraph::storage::Storage> main_store{new memgraph::storage::InMemoryStorage(configuration)};
   std::unique_ptr<memgraph::storage::Storage> replica_store1{new memgraph::storage::InMemoryStorage(configuration)};
@@ -909,3 +1102,48 @@ TEST_F(ReplicationTest, AddingInvalidReplica) {
                                     memgraph::storage::replication::ReplicationClientConfig{})
                   .GetError() == memgraph::storage::ReplicationState::RegisterReplicaError::CONNECTION_FAILED);
 }
+
+TEST_F(ReplicationTest, ReplicaAppliesTransactionBatch) {
+  std::unique_ptr<memgraph::storage::Storage> replica_store =
+      std::make_unique<memgraph::storage::InMemoryStorage>(configuration);
+  auto *replica_mem_store = static_cast<memgraph::storage::InMemoryStorage *>(replica_store.get());
+  replica_mem_store->SetReplicaRole(memgraph::io::network::Endpoint{local_host, ports[0]},
+                                    memgraph::storage::replication::ReplicationServerConfig{});
+
+  memgraph::communication::ClientContext client_context;
+  memgraph::rpc::Client client{memgraph::io::network::Endpoint{local_host, ports[0]}, &client_context};
+  memgraph::storage::NameIdMapper name_id_mapper;
+
+  // Every label index creation is a transaction of its own, so `labels` are sent as one transaction each while the
+  // request header announces `transactions` of them.
+  const auto send_batch = [&](uint64_t previous_commit_timestamp, uint64_t transactions,
+                              const std::vector<std::string> &labels) {
+    auto stream = client.Stream<memgraph::storage::replication::AppendDeltasRpc>(previous_commit_timestamp, 0,
+                                                                                 transactions);
+    memgraph::storage::replication::Encoder encoder{stream.GetBuilder()};
+    encoder.WriteString("main epoch");
+    for (uint64_t i = 0; i < labels.size(); ++i) {
+      memgraph::storage::durability::EncodeOperation(
+          &encoder, &name_id_mapper, memgraph::storage::durability::StorageGlobalOperation::LABEL_INDEX_CREATE,
+          memgraph::storage::LabelId::FromUint(name_id_mapper.NameToId(labels[i])), {},
+          previous_commit_timestamp + i + 1);
+    }
+    return stream.AwaitResponse();
+  };
+  const auto index_exists = [&](const std::string &label) {
+    return replica_store->Access()->LabelIndexExists(replica_store->NameToLabel(label));
+  };
+
+  const auto res = send_batch(0, 3, {"L1", "L2", "L3"});
+  ASSERT_TRUE(res.success);
+  ASSERT_EQ(res.current_commit_timestamp, 3);
+  ASSERT_TRUE(index_exists("L1"));
+  ASSERT_TRUE(index_exists("L2"));
+  ASSERT_TRUE(index_exists("L3"));
+
+  // The stream ends after two of the three announced transactions. Both of them are applied by the time the replica
+  // drops the connection.
+  ASSERT_THROW(send_batch(3, 3, {"L4", "L5"}), memgraph::rpc::RpcFailedException);
+  ASSERT_TRUE(index_exists("L4"));
+  ASSERT_TRUE(index_exists("L5"));
+}
@@ -0,0 +1,160 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "storage/v2/inmemory/storage.hpp"
+#include "storage/v2/sharding/shard_client.hpp"
+#include "storage/v2/sharding/shard_map.hpp"
+#include "storage/v2/sharding/shard_server.hpp"
+
+using memgraph::storage::EdgeDirection;
+using memgraph::storage::Gid;
+using memgraph::storage::PropertyValue;
+using memgraph::storage::sharding::ScanFilter;
+using memgraph::storage::sharding::ShardMap;
+
+TEST(StorageV2Sharding, ShardMap) {
+  const auto shard_map = ShardMap::Parse("100=127.0.0.1:10001, 0=127.0.0.1:10000,1000=127.0.0.1:10002");
+  ASSERT_TRUE(shard_map);
+  ASSERT_EQ(shard_map->shards().size(), 3);
+  EXPECT_EQ(shard_map->shards()[0].endpoint.port, 10000);
+  EXPECT_EQ(shard_map->ShardOf(Gid::FromUint(0)), 0);
+  EXPECT_EQ(shard_map->ShardOf(Gid::FromUint(99)), 0);
+  EXPECT_EQ(shard_map->ShardOf(Gid::FromUint(100)), 1);
+  EXPECT_EQ(shard_map->ShardOf(Gid::FromUint(5000)), 2);
+
+  const auto groups = shard_map->GroupByShard({Gid::FromUint(1), Gid::FromUint(2000), Gid::FromUint(2)});
+  ASSERT_EQ(groups.size(), 3);
+  EXPECT_EQ(groups[0], (std::vector<Gid>{Gid::FromUint(1), Gid::FromUint(2)}));
+  EXPECT_TRUE(groups[1].empty());
+  EXPECT_EQ(groups[2], (std::vector<Gid>{Gid::FromUint(2000)}));
+}
+
+TEST(StorageV2Sharding, InvalidShardMap) {
+  EXPECT_FALSE(ShardMap::Parse(""));
+  EXPECT_FALSE(ShardMap::Parse("1=127.0.0.1:10000"));
+  EXPECT_FALSE(ShardMap::Parse("0=127.0.0.1:10000,0=127.0.0.1:10001"));
+  EXPECT_FALSE(ShardMap::Parse("0=127.0.0.1"));
+  EXPECT_FALSE(ShardMap::Parse("x=127.0.0.1:10000"));
+}
+
+class StorageV2ShardingTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    // The first shard stores the vertices 0, 1 and 2 with the edges 0->1 and
+    // 0->2.
+    {
+      auto acc = storages_[0]->Access();
+      auto v0 = acc->CreateVertex();
+      auto v1 = acc->CreateVertex();
+      auto v2 = acc->CreateVertex();
+      for (auto *vertex : {&v0, &v1, &v2}) ASSERT_FALSE(vertex->AddLabel(acc->NameToLabel("Person")).HasError());
+      ASSERT_FALSE(v1.SetProperty(acc->NameToProperty("age"), PropertyValue(30)).HasError());
+      ASSERT_FALSE(acc->CreateEdge(&v0, &v1, acc->NameToEdgeType("KNOWS")).HasError());
+      ASSERT_FALSE(acc->CreateEdge(&v0, &v2, acc->NameToEdgeType("LIKES")).HasError());
+      ASSERT_FALSE(acc->Commit().HasError());
+    }
+    // The second shard stores the vertices 100 and 101.
+    {
+      auto acc = storages_[1]->Access();
+      std::vector<memgraph::storage::VertexAccessor> vertices;
+      for (int i = 0; i < 102; ++i) vertices.push_back(acc->CreateVertex());
+      for (int i = 0; i < 100; ++i) ASSERT_FALSE(acc->DeleteVertex(&vertices[i]).HasError());
+      ASSERT_FALSE(vertices[100].AddLabel(acc->NameToLabel("Person")).HasError());
+      ASSERT_FALSE(vertices[100].SetProperty(acc->NameToProperty("age"), PropertyValue(30)).HasError());
+      ASSERT_FALSE(acc->CreateEdge(&vertices[101], &vertices[100], acc->NameToEdgeType("KNOWS")).HasError());
+      ASSERT_FALSE(acc->Commit().HasError());
+    }
+
+    std::vector<memgraph::storage::sharding::Shard> shards;
+    for (size_t i = 0; i < storages_.size(); ++i) {
+      servers_.push_back(std::make_unique<memgraph::storage::sharding::ShardServer>(
+          memgraph::io::network::Endpoint{"127.0.0.1", 0}, storages_[i].get(), 1));
+      ASSERT_TRUE(servers_.back()->Start());
+      shards.push_back({Gid::FromUint(i * 100), servers_.back()->endpoint()});
+    }
+    auto shard_map = ShardMap::Create(std::move(shards));
+    ASSERT_TRUE(shard_map);
+    client_ = std::make_unique<memgraph::storage::sharding::ShardClient>(std::move(*shard_map));
+  }
+
+  std::vector<std::unique_ptr<memgraph::storage::Storage>> storages_ = [] {
+    std::vector<std::unique_ptr<memgraph::storage::Storage>> storages;
+    storages.push_back(std::make_unique<memgraph::storage::InMemoryStorage>());
+    storages.push_back(std::make_unique<memgraph::storage::InMemoryStorage>());
+    return storages;
+  }();
+  std::vector<std::unique_ptr<memgraph::storage::sharding::ShardServer>> servers_;
+  std::unique_ptr<memgraph::storage::sharding::ShardClient> client_;
+};
+
+TEST_F(StorageV2ShardingTest, Expand) {
+  auto edges = client_->Expand({Gid::FromUint(0), Gid::FromUint(1), Gid::FromUint(101)}, EdgeDirection::OUT);
+  ASSERT_EQ(edges.size(), 3);
+  std::sort(edges.begin(), edges.end(), [](const auto &lhs, const auto &rhs) {
+    return std::make_pair(lhs.vertex, lhs.other_vertex) < std::make_pair(rhs.vertex, rhs.other_vertex);
+  });
+  EXPECT_EQ(edges[0].other_vertex, Gid::FromUint(1));
+  EXPECT_EQ(edges[0].edge_type, "KNOWS");
+  EXPECT_EQ(edges[1].other_vertex, Gid::FromUint(2));
+  EXPECT_EQ(edges[1].edge_type, "LIKES");
+  EXPECT_EQ(edges[2].vertex, Gid::FromUint(101));
+  EXPECT_EQ(edges[2].other_vertex, Gid::FromUint(100));
+
+  const auto known = client_->Expand({Gid::FromUint(1), Gid::FromUint(100)}, EdgeDirection::IN, {"KNOWS"});
+  ASSERT_EQ(known.size(), 2);
+  EXPECT_EQ(known[0].other_vertex, Gid::FromUint(0));
+  EXPECT_EQ(known[1].other_vertex, Gid::FromUint(101));
+
+  EXPECT_TRUE(client_->Expand({Gid::FromUint(0)}, EdgeDirection::OUT, {"MISSING"}).empty());
+}
+
+TEST_F(StorageV2ShardingTest, ScanAndCount) {
+  EXPECT_EQ(client_->Scan({}, 1),
+            (std::vector<Gid>{Gid::FromUint(0), Gid::FromUint(1), Gid::FromUint(2), Gid::FromUint(100),
+                              Gid::FromUint(101)}));
+  EXPECT_EQ(client_->Count({}), 5);
+
+  const ScanFilter people{.label = "Person"};
+  EXPECT_EQ(client_->Scan(people, 2),
+            (std::vector<Gid>{Gid::FromUint(0), Gid::FromUint(1), Gid::FromUint(2), Gid::FromUint(100)}));
+  EXPECT_EQ(client_->Count(people), 4);
+
+  const ScanFilter aged{.label = "Person", .property = "age", .value = PropertyValue(30)};
+  EXPECT_EQ(client_->Scan(aged, 10), (std::vector<Gid>{Gid::FromUint(1), Gid::FromUint(100)}));
+  EXPECT_EQ(client_->Count(aged), 2);
+}
+
+TEST_F(StorageV2ShardingTest, UnknownNamesAreNotMapped) {
+  EXPECT_TRUE(client_->Expand({Gid::FromUint(0), Gid::FromUint(101)}, EdgeDirection::OUT, {"MISSING"}).empty());
+  EXPECT_EQ(client_->Expand({Gid::FromUint(0)}, EdgeDirection::OUT, {"MISSING", "LIKES"}).size(), 1);
+
+  const ScanFilter missing_label{.label = "Missing"};
+  EXPECT_TRUE(client_->Scan(missing_label, 10).empty());
+  EXPECT_EQ(client_->Count(missing_label), 0);
+
+  const ScanFilter missing_property{.property = "missing", .value = PropertyValue()};
+  EXPECT_TRUE(client_->Scan(missing_property, 10).empty());
+  EXPECT_EQ(client_->Count(missing_property), 0);
+
+  for (const auto &storage : storages_) {
+    auto acc = storage->Access();
+    EXPECT_FALSE(acc->FindEdgeType("MISSING"));
+    EXPECT_FALSE(acc->FindLabel("Missing"));
+    EXPECT_FALSE(acc->FindProperty("missing"));
+    EXPECT_TRUE(acc->FindLabel("Person"));
+  }
+}
@@ -14,10 +14,15 @@
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <map>
+#include <set>
 #include <string_view>
+#include <thread>
 
 #include "storage/v2/durability/exceptions.hpp"
+#include "storage/v2/durability/paths.hpp"
 #include "storage/v2/durability/version.hpp"
 #include "storage/v2/durability/wal.hpp"
 #include "storage/v2/mvcc.hpp"
@@ -47,6 +52,22 @@ memgraph::storage::durability::WalDeltaData::Type StorageGlobalOperationToWalDel
       return memgraph::storage::durability::WalDeltaData::Type::UNIQUE_CONSTRAINT_CREATE;
     case memgraph::storage::durability::StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP:
       return memgraph::storage::durability::WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP;
+    case memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+      return memgraph::storage::durability::WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE;
+    case memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+      return memgraph::storage::durability::WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_DROP;
+    case memgraph::storage::durability::StorageGlobalOperation::TEXT_INDEX_CREATE:
+      return memgraph::storage::durability::WalDeltaData::Type::TEXT_INDEX_CREATE;
+    case memgraph::storage::durability::StorageGlobalOperation::TEXT_INDEX_DROP:
+      return memgraph::storage::durability::WalDeltaData::Type::TEXT_INDEX_DROP;
+    case memgraph::storage::durability::StorageGlobalOperation::VECTOR_INDEX_CREATE:
+      return memgraph::storage::durability::WalDeltaData::Type::VECTOR_INDEX_CREATE;
+    case memgraph::storage::durability::StorageGlobalOperation::VECTOR_INDEX_DROP:
+      return memgraph::storage::durability::WalDeltaData::Type::VECTOR_INDEX_DROP;
+    case memgraph::storage::durability::StorageGlobalOperation::AGGREGATE_INDEX_CREATE:
+      return memgraph::storage::durability::WalDeltaData::Type::AGGREGATE_INDEX_CREATE;
+    case memgraph::storage::durability::StorageGlobalOperation::AGGREGATE_INDEX_DROP:
+      return memgraph::storage::durability::WalDeltaData::Type::AGGREGATE_INDEX_DROP;
   }
 }
 
@@ -210,11 +231,11 @@ class DeltaGenerator final {
   }
 
   void AppendOperation(memgraph::storage::durability::StorageGlobalOperation operation, const std::string &label,
-                       const std::set<std::string> properties = {}) {
+                       const std::vector<std::string> properties = {}) {
     auto label_id = memgraph::storage::LabelId::FromUint(mapper_.NameToId(label));
-    std::set<memgraph::storage::PropertyId> property_ids;
+    std::vector<memgraph::storage::PropertyId> property_ids;
     for (const auto &property : properties) {
-      property_ids.insert(memgraph::storage::PropertyId::FromUint(mapper_.NameToId(property)));
+      property_ids.push_back(memgraph::storage::PropertyId::FromUint(mapper_.NameToId(property)));
     }
     wal_file_.AppendOperation(operation, label_id, property_ids, timestamp_);
     if (valid_) {
@@ -230,12 +251,24 @@ class DeltaGenerator final {
         case memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTY_INDEX_DROP:
         case memgraph::storage::durability::StorageGlobalOperation::EXISTENCE_CONSTRAINT_CREATE:
         case memgraph::storage::durability::StorageGlobalOperation::EXISTENCE_CONSTRAINT_DROP:
+        case memgraph::storage::durability::StorageGlobalOperation::TEXT_INDEX_CREATE:
+        case memgraph::storage::durability::StorageGlobalOperation::TEXT_INDEX_DROP:
+        case memgraph::storage::durability::StorageGlobalOperation::VECTOR_INDEX_CREATE:
+        case memgraph::storage::durability::StorageGlobalOperation::VECTOR_INDEX_DROP:
           data.operation_label_property.label = label;
           data.operation_label_property.property = *properties.begin();
         case memgraph::storage::durability::StorageGlobalOperation::UNIQUE_CONSTRAINT_CREATE:
         case memgraph::storage::durability::StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP:
           data.operation_label_properties.label = label;
-          data.operation_label_properties.properties = properties;
+          data.operation_label_properties.properties = {properties.begin(), properties.end()};
+          break;
+        case memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+        case memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+        case memgraph::storage::durability::StorageGlobalOperation::AGGREGATE_INDEX_CREATE:
+        case memgraph::storage::durability::StorageGlobalOperation::AGGREGATE_INDEX_DROP:
+          data.operation_label_property_list.label = label;
+          data.operation_label_property_list.properties = properties;
+          break;
       }
       data_.emplace_back(timestamp_, data);
     }
@@ -527,6 +560,14 @@ GENERATE_SIMPLE_TEST(AllGlobalOperations, {
   OPERATION(EXISTENCE_CONSTRAINT_DROP, "hello", {"world"});
   OPERATION(UNIQUE_CONSTRAINT_CREATE, "hello", {"world", "and", "universe"});
   OPERATION(UNIQUE_CONSTRAINT_DROP, "hello", {"world", "and", "universe"});
+  OPERATION(LABEL_PROPERTY_COMPOSITE_INDEX_CREATE, "hello", {"world", "and", "universe"});
+  OPERATION(LABEL_PROPERTY_COMPOSITE_INDEX_DROP, "hello", {"world", "and", "universe"});
+  OPERATION(TEXT_INDEX_CREATE, "hello", {"world"});
+  OPERATION(TEXT_INDEX_DROP, "hello", {"world"});
+  OPERATION(VECTOR_INDEX_CREATE, "hello", {"world"});
+  OPERATION(VECTOR_INDEX_DROP, "hello", {"world"});
+  OPERATION(AGGREGATE_INDEX_CREATE, "hello", {"world", "universe"});
+  OPERATION(AGGREGATE_INDEX_DROP, "hello", {"world", "universe"});
 });
 
 // NOLINTNEXTLINE(hicpp-special-member-functions)
@@ -538,6 +579,95 @@ GENERATE_SIMPLE_TEST(InvalidTransactionOrdering, {
   TRANSACTION(true, { tx.CreateVertex(); });
 });
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(WalFileTest, ParallelApplyMatchesSequentialLoad) {
+  {
+    DeltaGenerator gen(storage_directory, GetParam(), 5);
+    std::vector<memgraph::storage::Vertex *> vertices;
+    TRANSACTION(true, {
+      for (int i = 0; i < 100; ++i) vertices.push_back(tx.CreateVertex());
+    });
+    for (int round = 0; round < 3; ++round) {
+      TRANSACTION(true, {
+        for (size_t i = 0; i < vertices.size(); ++i) {
+          tx.SetProperty(vertices[i], "value", memgraph::storage::PropertyValue(static_cast<int64_t>(i * round)));
+          if (round == 0) tx.AddLabel(vertices[i], fmt::format("label{}", i % 3));
+        }
+      });
+    }
+    TRANSACTION(true, {
+      for (size_t i = 0; i < vertices.size(); i += 2) tx.RemoveLabel(vertices[i], fmt::format("label{}", i % 3));
+    });
+    TRANSACTION(true, {
+      for (size_t i = 0; i < vertices.size(); i += 5) tx.DeleteVertex(vertices[i]);
+    });
+  }
+  auto wal_files = GetFilesList();
+  ASSERT_EQ(wal_files.size(), 1);
+
+  using Result = std::map<uint64_t, std::pair<std::set<std::string>, std::map<std::string, int64_t>>>;
+  auto load = [&](bool parallel) {
+    memgraph::utils::SkipList<memgraph::storage::Vertex> vertices;
+    memgraph::utils::SkipList<memgraph::storage::Edge> edges;
+    memgraph::storage::NameIdMapper mapper;
+    std::atomic<uint64_t> edge_count{0};
+    memgraph::storage::durability::RecoveredIndicesAndConstraints indices_constraints;
+    memgraph::storage::durability::RecoveryInfo info;
+    if (parallel) {
+      auto deltas = memgraph::storage::durability::ReadWalDeltas(wal_files.front(), std::nullopt);
+      info = memgraph::storage::durability::ApplyWalDeltas(deltas, &indices_constraints, &vertices, &edges, &mapper,
+                                                           &edge_count, {.properties_on_edges = GetParam()}, 4);
+    } else {
+      info = memgraph::storage::durability::LoadWal(wal_files.front(), &indices_constraints, std::nullopt, &vertices,
+                                                    &edges, &mapper, &edge_count, {.properties_on_edges = GetParam()});
+    }
+    Result ret;
+    for (auto &vertex : vertices.access()) {
+      auto &[labels, properties] = ret[vertex.gid.AsUint()];
+      for (auto label : vertex.labels) labels.insert(mapper.IdToName(label.AsUint()));
+      for (const auto &[id, value] : vertex.properties.Properties()) {
+        properties[mapper.IdToName(id.AsUint())] = value.ValueInt();
+      }
+    }
+    return std::make_pair(info.next_timestamp, ret);
+  };
+
+  auto sequential = load(false);
+  auto parallel = load(true);
+  ASSERT_EQ(sequential.second.size(), 80);
+  ASSERT_EQ(sequential, parallel);
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(WalFileTest, SegmentPool) {
+  const auto segments_directory = storage_directory / memgraph::storage::durability::kWalSegmentsDirectory;
+  auto count_segments = [&] {
+    return std::distance(std::filesystem::directory_iterator(segments_directory),
+                         std::filesystem::directory_iterator());
+  };
+  auto wait_for_segments = [&](int64_t count) {
+    for (int i = 0; i < 1000 && count_segments() != count; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(count_segments(), count);
+  };
+  {
+    memgraph::storage::durability::WalSegmentPool pool(segments_directory, 1024 * 1024, 2);
+    wait_for_segments(2);
+    const auto wal_path = storage_directory / "wal_from_segment";
+    ASSERT_TRUE(pool.TakeSegment(wal_path));
+    ASSERT_TRUE(std::filesystem::exists(wal_path));
+    ASSERT_EQ(std::filesystem::file_size(wal_path), 0);
+    wait_for_segments(2);
+  }
+  // The segments of the previous pool are reused.
+  const auto segments = count_segments();
+  memgraph::storage::durability::WalSegmentPool pool(segments_directory, 1024 * 1024, 2);
+  ASSERT_EQ(count_segments(), segments);
+  ASSERT_TRUE(pool.TakeSegment(storage_directory / "another_wal_from_segment"));
+  wait_for_segments(2);
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TEST_P(WalFileTest, InvalidMarker) {
   memgraph::storage::durability::WalInfo info;
@@ -228,6 +228,12 @@ TEST(QueryStripper, UnescapedName2) {
   EXPECT_EQ(stripped.query(), "MATCH ( n : \xEF\xBF\x95\xD3\x82\xD3\x82pero\x78pe )");
 }
 
+TEST(QueryStripper, KeywordPrefixedName) {
+  StrippedQuery stripped("MATCH (matches)\t/* c */ RETURN matches.returned, `as`");
+  EXPECT_EQ(stripped.query(), "MATCH ( matches ) RETURN matches . returned , `as`");
+  EXPECT_THAT(stripped.named_expressions(), UnorderedElementsAre(Pair(4, "matches.returned"), Pair(8, "`as`")));
+}
+
 TEST(QueryStripper, MixedCaseKeyword) {
   StrippedQuery stripped("MaTch (n:peropero)");
   EXPECT_EQ(stripped.literals().size(), 0);
@@ -16,6 +16,7 @@
 #include "gtest/gtest.h"
 
 #include "utils/async_timer.hpp"
+#include "utils/interrupt.hpp"
 
 using AsyncTimer = memgraph::utils::AsyncTimer;
 
@@ -147,3 +148,14 @@ TEST(AsyncTimer, TimersWithExtremeValues) {
   const double expected_maximum_value = std::nexttoward(std::numeric_limits<time_t>::max(), 0.0);
   AsyncTimer timer_with_max_value{expected_maximum_value};
 }
+
+TEST(AsyncTimer, ExpirationAdvancesInterruptEpoch) {
+  const auto epoch = memgraph::utils::InterruptEpoch();
+  AsyncTimer timer{kIntervalInSeconds};
+  while (!timer.IsExpired()) {
+  }
+  // The epoch is advanced after the flag is set.
+  while (memgraph::utils::InterruptEpoch() == epoch) {
+  }
+  EXPECT_GT(memgraph::utils::InterruptEpoch(), epoch);
+}
@@ -0,0 +1,102 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utils/chunked_list.hpp"
+
+using memgraph::utils::ChunkedList;
+
+TEST(ChunkedList, Empty) {
+  ChunkedList<int> list;
+  ASSERT_TRUE(list.empty());
+  ASSERT_EQ(list.size(), 0);
+  ASSERT_EQ(list.begin(), list.end());
+  list.clear();
+  ASSERT_TRUE(list.empty());
+}
+
+TEST(ChunkedList, StableReferences) {
+  ChunkedList<std::string> list;
+  std::vector<std::string *> pointers;
+  for (int i = 0; i < 5000; ++i) {
+    auto &element = list.emplace_back(std::to_string(i));
+    pointers.push_back(&element);
+  }
+  ASSERT_EQ(list.size(), 5000);
+  ASSERT_EQ(list.front(), "0");
+  ASSERT_EQ(list.back(), "4999");
+
+  ChunkedList<std::string> moved(std::move(list));
+  ASSERT_TRUE(list.empty());
+  ASSERT_EQ(moved.size(), 5000);
+  int i = 0;
+  for (auto &element : moved) {
+    ASSERT_EQ(&element, pointers[i]);
+    ASSERT_EQ(element, std::to_string(i));
+    ++i;
+  }
+  ASSERT_EQ(i, 5000);
+
+  const auto &const_moved = moved;
+  ASSERT_EQ(std::count_if(const_moved.begin(), const_moved.end(), [](const auto &s) { return s.size() == 1; }), 10);
+}
+
+TEST(ChunkedList, DestroysInOrder) {
+  struct Tracker {
+    Tracker(std::vector<int> *destroyed, int id) : destroyed(destroyed), id(id) {}
+    Tracker(const Tracker &) = delete;
+    Tracker &operator=(const Tracker &) = delete;
+    ~Tracker() { destroyed->push_back(id); }
+    std::vector<int> *destroyed;
+    int id;
+  };
+
+  std::vector<int> destroyed;
+  {
+    ChunkedList<Tracker> list;
+    for (int i = 0; i < 100; ++i) list.emplace_back(&destroyed, i);
+    ChunkedList<Tracker> other;
+    other.emplace_back(&destroyed, 100);
+    other = std::move(list);
+    ASSERT_EQ(destroyed, std::vector<int>{100});
+    destroyed.clear();
+  }
+  ASSERT_EQ(destroyed.size(), 100);
+  ASSERT_TRUE(std::is_sorted(destroyed.begin(), destroyed.end()));
+}
+
+TEST(ChunkedList, ThrowingConstructor) {
+  struct Throwing {
+    explicit Throwing(bool do_throw) {
+      if (do_throw) throw std::runtime_error("throwing");
+    }
+  };
+
+  ChunkedList<Throwing, 2, 2> list;
+  list.emplace_back(false);
+  list.emplace_back(false);
+  // The next element needs a new chunk which stays empty.
+  ASSERT_THROW(list.emplace_back(true), std::runtime_error);
+  ASSERT_EQ(list.size(), 2);
+  ASSERT_EQ(std::distance(list.begin(), list.end()), 2);
+  list.emplace_back(false);
+  ASSERT_EQ(std::distance(list.begin(), list.end()), 3);
+
+  ChunkedList<Throwing> first_throws;
+  ASSERT_THROW(first_throws.emplace_back(true), std::runtime_error);
+  ASSERT_EQ(first_throws.begin(), first_throws.end());
+}
@@ -268,6 +268,19 @@ TEST_F(UtilsFileTest, OutputFileMove) {
   original.Close();
 }
 
+TEST_F(UtilsFileTest, OutputFileSyncDescriptor) {
+  const auto path = storage / "existing_dir_777" / "existing_file_777";
+  memgraph::utils::OutputFile handle;
+  handle.Open(path, memgraph::utils::OutputFile::Mode::OVERWRITE_EXISTING);
+  handle.Write("hello world!\n");
+  auto fd = handle.FlushAndDuplicateDescriptor();
+  // The buffered data is written to the file and the descriptor outlives the
+  // file handle.
+  handle.Close();
+  memgraph::utils::OutputFile::SyncDescriptor(fd);
+  ASSERT_EQ(memgraph::utils::ReadLines(path), std::vector<std::string>{"hello world!"});
+}
+
 TEST_F(UtilsFileTest, OutputFileDescriptorLeackage) {
   for (int i = 0; i < 100000; ++i) {
     memgraph::utils::OutputFile handle;
@@ -276,6 +289,74 @@ TEST_F(UtilsFileTest, OutputFileDescriptorLeackage) {
   }
 }
 
+TEST_F(UtilsFileTest, InputFileMemoryMapped) {
+  const auto file_path = storage / "existing_dir_777" / "mapped_file";
+  std::vector<uint8_t> data(3 * memgraph::utils::kFileBufferSize + 17);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i * 31);
+  }
+  {
+    memgraph::utils::OutputFile handle;
+    handle.Open(file_path, memgraph::utils::OutputFile::Mode::OVERWRITE_EXISTING);
+    handle.Write(data.data(), data.size());
+    handle.Sync();
+    handle.Close();
+  }
+
+  for (const auto memory_mapped : {false, true}) {
+    memgraph::utils::InputFile handle;
+    ASSERT_TRUE(handle.Open(file_path, memory_mapped));
+    ASSERT_EQ(handle.GetSize(), data.size());
+
+    std::vector<uint8_t> read(data.size());
+    ASSERT_TRUE(handle.Peek(read.data(), 10));
+    ASSERT_EQ(handle.GetPosition(), 0);
+    ASSERT_TRUE(handle.Read(read.data(), read.size()));
+    ASSERT_EQ(read, data);
+    ASSERT_EQ(handle.GetPosition(), data.size());
+    uint8_t byte = 0;
+    ASSERT_FALSE(handle.Read(&byte, 1));
+
+    ASSERT_EQ(handle.SetPosition(memgraph::utils::InputFile::Position::SET, 5), 5);
+    ASSERT_TRUE(handle.Read(&byte, 1));
+    ASSERT_EQ(byte, data[5]);
+    ASSERT_EQ(handle.SetPosition(memgraph::utils::InputFile::Position::RELATIVE_TO_END, -1), data.size() - 1);
+    ASSERT_TRUE(handle.Read(&byte, 1));
+    ASSERT_EQ(byte, data.back());
+    ASSERT_EQ(handle.SetPosition(memgraph::utils::InputFile::Position::RELATIVE_TO_CURRENT, 2), data.size() + 2);
+    ASSERT_FALSE(handle.Read(&byte, 1));
+    handle.Close();
+  }
+}
+
+TEST_F(UtilsFileTest, OutputFilePreallocateAndWriteback) {
+  const auto file_path = storage / "existing_dir_777" / "preallocated_file";
+  std::vector<uint8_t> data(2 * memgraph::utils::kFileBufferSize + 5);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i * 7);
+  }
+  {
+    memgraph::utils::OutputFile handle;
+    handle.Open(file_path, memgraph::utils::OutputFile::Mode::OVERWRITE_EXISTING);
+    // The file system doesn't have to support the preallocation, the size of
+    // the file mustn't change either way.
+    handle.Preallocate(4 * memgraph::utils::kFileBufferSize);
+    ASSERT_EQ(handle.GetSize(), 0);
+    handle.EnableWriteback();
+    handle.Write(data.data(), data.size());
+    ASSERT_EQ(handle.GetSize(), data.size());
+    handle.Sync();
+    handle.Close();
+  }
+  ASSERT_EQ(std::filesystem::file_size(file_path), data.size());
+
+  memgraph::utils::InputFile handle;
+  ASSERT_TRUE(handle.Open(file_path));
+  std::vector<uint8_t> read(data.size());
+  ASSERT_TRUE(handle.Read(read.data(), read.size()));
+  ASSERT_EQ(read, data);
+}
+
 TEST_F(UtilsFileTest, ConcurrentReadingAndWritting) {
   const auto file_path = storage / "existing_dir_777" / "existing_file_777";
   memgraph::utils::OutputFile handle;
@@ -45,3 +45,18 @@ TEST(Histogram, BasicFunctionality) {
 
   ASSERT_NEAR(diff, 0, 0.01);
 }
+
+TEST(Histogram, CumulativeCounts) {
+  memgraph::metrics::Histogram histo{};
+
+  for (int i = 0; i < 10; i++) {
+    histo.Measure(3);
+  }
+  for (int i = 0; i < 5; i++) {
+    histo.Measure(100);
+  }
+  histo.Measure(100000);
+
+  ASSERT_THAT(histo.CumulativeCounts({1, 4, 1000}), ::testing::ElementsAre(0, 10, 15, 16));
+  ASSERT_THAT(histo.CumulativeCounts({}), ::testing::ElementsAre(16));
+}
@@ -12,10 +12,13 @@
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "utils/memory.hpp"
+#include "utils/pmr/vector.hpp"
 
 class TestMemory final : public memgraph::utils::MemoryResource {
  public:
@@ -353,6 +356,150 @@ TEST(MonotonicBufferResource, ResetGrowthFactor) {
   ASSERT_EQ(test_mem.allocated_sizes_.front(), test_mem.allocated_sizes_.back());
 }
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(TrackedMemoryResource, TracksUpstreamAllocations) {
+  memgraph::utils::MemoryTracker tracker;
+  tracker.SetHardLimit(1024);
+  memgraph::utils::TrackedMemoryResource tracked(&tracker);
+  memgraph::utils::MonotonicBufferResource mem(512, &tracked);
+  mem.Allocate(256);
+  EXPECT_GE(tracker.Amount(), 256);
+  {
+    memgraph::utils::MemoryTracker::OutOfMemoryExceptionEnabler exception_enabler;
+    EXPECT_THROW(mem.Allocate(2048), memgraph::utils::OutOfMemoryException);
+  }
+  // Without the exception enabled the allocation goes over the limit.
+  mem.Allocate(2048);
+  EXPECT_GT(tracker.Amount(), 1024);
+  mem.Release();
+  EXPECT_EQ(tracker.Amount(), 0);
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(MonotonicBufferCache, ReusesBuffer) {
+  TestMemory cache_mem;
+  TestMemory upstream_mem;
+  {
+    memgraph::utils::MonotonicBufferCache cache(1024, 64 * 1024, &cache_mem);
+    {
+      auto mem = cache.Acquire(&upstream_mem);
+      mem.Allocate(512);
+      cache.Recycle(&mem);
+    }
+    EXPECT_EQ(cache_mem.new_count_, 1);
+    EXPECT_EQ(cache.GetBufferSize(), 1024);
+
+    // The next resource allocates from the same buffer.
+    {
+      auto mem = cache.Acquire(&upstream_mem);
+      mem.Allocate(512);
+      // Another resource can't use the buffer while it's in use.
+      auto other_mem = cache.Acquire(&upstream_mem);
+      other_mem.Allocate(512);
+      EXPECT_EQ(upstream_mem.new_count_, 1);
+      cache.Recycle(&other_mem);
+      cache.Recycle(&mem);
+    }
+    EXPECT_EQ(cache_mem.new_count_, 1);
+    EXPECT_EQ(cache_mem.delete_count_, 0);
+    EXPECT_EQ(upstream_mem.delete_count_, 1);
+
+    // The buffer grows to what the resource used.
+    {
+      auto mem = cache.Acquire(&upstream_mem);
+      mem.Allocate(8 * 1024);
+      cache.Recycle(&mem);
+    }
+    {
+      auto mem = cache.Acquire(&upstream_mem);
+      EXPECT_GT(cache.GetBufferSize(), 8 * 1024);
+      EXPECT_LE(cache.GetBufferSize(), 64 * 1024);
+      const auto upstream_allocations = upstream_mem.new_count_;
+      mem.Allocate(8 * 1024);
+      EXPECT_EQ(upstream_mem.new_count_, upstream_allocations);
+      cache.Recycle(&mem);
+    }
+    EXPECT_EQ(cache_mem.new_count_, 2);
+    EXPECT_EQ(upstream_mem.new_count_, upstream_mem.delete_count_);
+  }
+  EXPECT_EQ(cache_mem.new_count_, cache_mem.delete_count_);
+}
+
+TEST(ConcurrentPoolResource, Allocations) {
+  TestMemory test_mem;
+  {
+    memgraph::utils::ConcurrentPoolResource mem(1024, &test_mem);
+    std::vector<void *> blocks;
+    for (size_t size = 1; size <= 1024; size *= 2) {
+      auto *block = mem.Allocate(size, std::min<size_t>(size, 64));
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % std::min<size_t>(size, 64), 0);
+      memset(block, 0xFF, size);
+      blocks.push_back(block);
+    }
+    const auto chunks = test_mem.new_count_;
+    // Blocks are reused after they are deallocated.
+    for (size_t size = 1, i = 0; size <= 1024; size *= 2, ++i) {
+      mem.Deallocate(blocks[i], size, std::min<size_t>(size, 64));
+    }
+    for (size_t size = 1; size <= 1024; size *= 2) mem.Allocate(size, std::min<size_t>(size, 64));
+    EXPECT_EQ(test_mem.new_count_, chunks);
+    // Big blocks are allocated from upstream.
+    auto *big_block = mem.Allocate(2048);
+    EXPECT_EQ(test_mem.new_count_, chunks + 1);
+    mem.Deallocate(big_block, 2048);
+    EXPECT_EQ(test_mem.delete_count_, 1);
+    mem.Allocate(2048);
+  }
+  EXPECT_EQ(test_mem.new_count_, test_mem.delete_count_);
+}
+
+TEST(ConcurrentPoolResource, MultipleThreads) {
+  static constexpr size_t kThreads = 8;
+  static constexpr size_t kBlocks = 10000;
+  TestMemory test_mem;
+  {
+    memgraph::utils::ConcurrentPoolResource mem(512, &test_mem);
+    std::vector<std::vector<uint64_t *>> blocks(kThreads);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kThreads; ++i) {
+      threads.emplace_back([&, i] {
+        for (size_t j = 0; j < kBlocks; ++j) {
+          const size_t size = 8 * (1 + j % 64);
+          auto *block = static_cast<uint64_t *>(mem.Allocate(size, alignof(uint64_t)));
+          for (size_t k = 0; k < size / 8; ++k) block[k] = i;
+          blocks[i].push_back(block);
+        }
+      });
+    }
+    for (auto &thread : threads) thread.join();
+    threads.clear();
+    // Each thread checks and deallocates the blocks another thread allocated.
+    for (size_t i = 0; i < kThreads; ++i) {
+      threads.emplace_back([&, i] {
+        const auto owner = (i + 1) % kThreads;
+        for (size_t j = 0; j < kBlocks; ++j) {
+          const size_t size = 8 * (1 + j % 64);
+          for (size_t k = 0; k < size / 8; ++k) ASSERT_EQ(blocks[owner][j][k], owner);
+          mem.Deallocate(blocks[owner][j], size, alignof(uint64_t));
+        }
+      });
+    }
+    for (auto &thread : threads) thread.join();
+    EXPECT_EQ(test_mem.delete_count_, 0);
+  }
+  EXPECT_EQ(test_mem.new_count_, test_mem.delete_count_);
+}
+
+TEST(ConcurrentPoolResource, WithAllocator) {
+  memgraph::utils::ConcurrentPoolResource mem(1024);
+  memgraph::utils::pmr::vector<memgraph::utils::pmr::vector<int>> vectors(&mem);
+  for (int i = 0; i < 100; ++i) {
+    auto &vector = vectors.emplace_back();
+    for (int j = 0; j < i; ++j) vector.push_back(j);
+  }
+  for (int i = 0; i < 100; ++i) ASSERT_EQ(vectors[i].size(), i);
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 class ContainerWithAllocatorLast final {
  public:
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -9,10 +9,13 @@
 // by the Apache License, Version 2.0, included in the file
 // licenses/APL.txt.
 
+#include <cstdint>
+#include <new>
 #include <thread>
 
 #include <gtest/gtest.h>
 
+#include <memory/memory_control.hpp>
 #include <utils/memory_tracker.hpp>
 #include <utils/on_scope_exit.hpp>
 
@@ -68,3 +71,91 @@ TEST(MemoryTrackerTest, ExceptionBlocker) {
   }
   ASSERT_THROW(memory_tracker.Alloc(hard_limit + 1), memgraph::utils::OutOfMemoryException);
 }
+
+TEST(MemoryTrackerTest, Parent) {
+  memgraph::utils::MemoryTracker parent;
+  parent.SetHardLimit(10);
+
+  memgraph::utils::MemoryTracker::OutOfMemoryExceptionEnabler exception_enabler;
+  {
+    memgraph::utils::MemoryTracker child{&parent};
+    child.Alloc(6);
+    ASSERT_EQ(child.Amount(), 6);
+    ASSERT_EQ(parent.Amount(), 6);
+
+    // The allocation fails because of the limit of the parent.
+    ASSERT_THROW(child.Alloc(6), memgraph::utils::OutOfMemoryException);
+    ASSERT_EQ(child.Amount(), 6);
+    ASSERT_EQ(parent.Amount(), 6);
+
+    child.Free(2);
+    ASSERT_EQ(child.Amount(), 4);
+    ASSERT_EQ(parent.Amount(), 4);
+
+    child.Reset();
+    ASSERT_EQ(child.Amount(), 0);
+    ASSERT_EQ(child.Peak(), 0);
+    ASSERT_EQ(parent.Amount(), 0);
+
+    child.Alloc(3);
+  }
+  // The destroyed child frees what it still tracked.
+  ASSERT_EQ(parent.Amount(), 0);
+}
+
+TEST(MemoryTrackerTest, ThreadScope) {
+  using ThreadScope = memgraph::utils::MemoryTracker::ThreadScope;
+  memgraph::utils::MemoryTracker memory_tracker;
+  {
+    const ThreadScope scope{&memory_tracker};
+    ThreadScope::Alloc(100);
+    // Small allocations are added to the tracker in batches.
+    ASSERT_EQ(memory_tracker.Amount(), 0);
+    {
+      const ThreadScope untracked{nullptr};
+      ASSERT_EQ(memory_tracker.Amount(), 100);
+      ThreadScope::Alloc(1000);
+    }
+    ThreadScope::Free(50);
+    ThreadScope::Alloc(1024 * 1024);
+    ASSERT_EQ(memory_tracker.Amount(), 100 - 50 + 1024 * 1024);
+  }
+  ASSERT_EQ(memory_tracker.Amount(), 100 - 50 + 1024 * 1024);
+
+  // Allocations made outside of the scope aren't tracked.
+  ThreadScope::Alloc(1024 * 1024);
+  ASSERT_EQ(memory_tracker.Amount(), 100 - 50 + 1024 * 1024);
+}
+
+TEST(MemoryTrackerTest, ThreadScopeHardLimit) {
+  using ThreadScope = memgraph::utils::MemoryTracker::ThreadScope;
+  memgraph::utils::MemoryTracker memory_tracker;
+  memory_tracker.SetHardLimit(1024 * 1024);
+
+  memgraph::utils::MemoryTracker::OutOfMemoryExceptionEnabler exception_enabler;
+  const ThreadScope scope{&memory_tracker};
+  ThreadScope::Alloc(1024);
+  ASSERT_THROW(ThreadScope::Alloc(2 * 1024 * 1024), memgraph::utils::OutOfMemoryException);
+  ASSERT_EQ(memory_tracker.Amount(), 0);
+  // The allocations which didn't fail are still counted.
+  ThreadScope::Alloc(1024 * 1024 - 1024);
+  ASSERT_EQ(memory_tracker.Amount(), 1024 * 1024);
+}
+
+TEST(MemoryTrackerTest, RelocationAllocationReleasedWithDelete) {
+  static constexpr size_t size = 1000;
+  // The memory which a `uint8_t` array leaves tracked after it is released,
+  // which depends on the allocator.
+  const auto tracked_after = [](auto allocate) {
+    const auto before = memgraph::utils::total_memory_tracker.Amount();
+    auto *ptr = static_cast<uint8_t *>(allocate());
+    EXPECT_NE(ptr, nullptr);
+    EXPECT_GE(memgraph::utils::total_memory_tracker.Amount(), before + static_cast<int64_t>(size));
+    delete[] ptr;
+    return memgraph::utils::total_memory_tracker.Amount() - before;
+  };
+
+  const auto array = tracked_after([] { return new (std::nothrow) uint8_t[size]; });
+  const auto relocation = tracked_after([] { return memgraph::memory::AllocateForRelocation(size); });
+  EXPECT_EQ(relocation, array);
+}
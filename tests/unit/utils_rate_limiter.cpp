@@ -0,0 +1,47 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utils/rate_limiter.hpp"
+#include "utils/timer.hpp"
+
+TEST(RateLimiter, Unlimited) {
+  memgraph::utils::RateLimiter limiter(0);
+  memgraph::utils::Timer timer;
+  for (int i = 0; i < 1000; ++i) limiter.Acquire(1'000'000);
+  ASSERT_LT(timer.Elapsed().count(), 1.0);
+}
+
+TEST(RateLimiter, LimitsRate) {
+  memgraph::utils::RateLimiter limiter(10'000);
+  memgraph::utils::Timer timer;
+  // The first acquisition is free, the following ones wait for the previous.
+  for (int i = 0; i < 6; ++i) limiter.Acquire(1'000);
+  ASSERT_GE(timer.Elapsed().count(), 0.5);
+}
+
+TEST(RateLimiter, SharedBetweenThreads) {
+  memgraph::utils::RateLimiter limiter(10'000);
+  memgraph::utils::Timer timer;
+  {
+    std::vector<std::jthread> threads;
+    for (int i = 0; i < 3; ++i) {
+      threads.emplace_back([&limiter] {
+        for (int j = 0; j < 2; ++j) limiter.Acquire(1'000);
+      });
+    }
+  }
+  ASSERT_GE(timer.Elapsed().count(), 0.5);
+}
@@ -0,0 +1,58 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <regex>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "utils/regex.hpp"
+
+using memgraph::utils::PrefixUpperBound;
+using memgraph::utils::Regex;
+using memgraph::utils::RegexLiteralPrefix;
+
+TEST(Regex, MatchesLikeStdRegex) {
+  // The literal patterns with wildcards at the ends are matched by comparing
+  // the strings, the others by `std::regex`.
+  const std::string patterns[] = {".*@corp\\.com", "abc", "abc.*", ".*abc.*", ".*", "a\\.*", "ab*c", "(a|b)c", ".*a.*b"};
+  const std::string targets[] = {"x@corp.com", "x@corpxcom", "abc",  "abcdef", "zzabczz", "",    "a...",
+                                 "abbbc",      "bc",         "\nab", "a\nb",   "ab\nc",   "\nabc"};
+  for (const auto &pattern : patterns) {
+    const Regex regex(pattern);
+    const std::regex expected(pattern);
+    for (const auto &target : targets) {
+      EXPECT_EQ(regex.Match(target), std::regex_match(target, expected)) << pattern << " " << target;
+    }
+  }
+}
+
+TEST(Regex, InvalidPattern) {
+  EXPECT_THROW(Regex("[abc"), std::regex_error);
+  EXPECT_THROW(Regex("*abc"), std::regex_error);
+}
+
+TEST(Regex, LiteralPrefix) {
+  EXPECT_EQ(RegexLiteralPrefix("abc.*"), "abc");
+  EXPECT_EQ(RegexLiteralPrefix("a\\.b[0-9]+"), "a.b");
+  // The quantified characters and the alternatives aren't in the prefix.
+  EXPECT_EQ(RegexLiteralPrefix("abc*"), "ab");
+  EXPECT_EQ(RegexLiteralPrefix("abc|abd"), "");
+  EXPECT_EQ(RegexLiteralPrefix(".*abc"), "");
+  EXPECT_EQ(RegexLiteralPrefix("\\d+"), "");
+}
+
+TEST(Regex, PrefixUpperBound) {
+  EXPECT_EQ(PrefixUpperBound("ab"), "ac");
+  EXPECT_EQ(PrefixUpperBound("a\xFF"), "b");
+  EXPECT_EQ(PrefixUpperBound("\xFF"), std::nullopt);
+  EXPECT_EQ(PrefixUpperBound(""), std::nullopt);
+}
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -9,13 +9,17 @@
 // by the Apache License, Version 2.0, included in the file
 // licenses/APL.txt.
 
+#include <atomic>
 #include <shared_mutex>
 #include <thread>
 
 #include "gtest/gtest.h"
 
+#include "utils/event_histogram.hpp"
 #include "utils/rw_lock.hpp"
+#include "utils/spin_lock.hpp"
 #include "utils/timer.hpp"
+#include "utils/wait_measured_lock.hpp"
 
 using namespace std::chrono_literals;
 
@@ -152,3 +156,172 @@ TEST(RWLock, TryLock) {
   });
   t5.join();
 }
+
+TEST(ScalableRWLock, MultipleReaders) {
+  memgraph::utils::ScalableRWLock rwlock;
+
+  std::vector<std::thread> threads;
+  memgraph::utils::Timer timer;
+  for (int i = 0; i < 3; ++i) {
+    threads.push_back(std::thread([&rwlock] {
+      std::shared_lock<memgraph::utils::ScalableRWLock> lock(rwlock);
+      std::this_thread::sleep_for(100ms);
+    }));
+  }
+
+  for (int i = 0; i < 3; ++i) {
+    threads[i].join();
+  }
+
+  EXPECT_LE(timer.Elapsed(), 150ms);
+  EXPECT_GE(timer.Elapsed(), 90ms);
+}
+
+TEST(ScalableRWLock, SingleWriter) {
+  memgraph::utils::ScalableRWLock rwlock;
+
+  std::vector<std::thread> threads;
+  memgraph::utils::Timer timer;
+  for (int i = 0; i < 3; ++i) {
+    threads.push_back(std::thread([&rwlock] {
+      std::unique_lock<memgraph::utils::ScalableRWLock> lock(rwlock);
+      std::this_thread::sleep_for(100ms);
+    }));
+  }
+
+  for (int i = 0; i < 3; ++i) {
+    threads[i].join();
+  }
+
+  EXPECT_GE(timer.Elapsed(), 290ms);
+}
+
+TEST(ScalableRWLock, WritePriority) {
+  memgraph::utils::ScalableRWLock rwlock;
+  rwlock.lock_shared();
+  bool first = true;
+
+  std::thread t1([&rwlock, &first] {
+    std::this_thread::sleep_for(30ms);
+    std::unique_lock<memgraph::utils::ScalableRWLock> lock(rwlock);
+    EXPECT_TRUE(first);
+    first = false;
+  });
+
+  std::thread t2([&rwlock, &first] {
+    std::this_thread::sleep_for(60ms);
+    std::shared_lock<memgraph::utils::ScalableRWLock> lock(rwlock);
+    EXPECT_FALSE(first);
+  });
+
+  std::this_thread::sleep_for(100ms);
+  rwlock.unlock_shared();
+
+  t1.join();
+  t2.join();
+}
+
+TEST(ScalableRWLock, TryLock) {
+  memgraph::utils::ScalableRWLock rwlock;
+  rwlock.lock();
+
+  std::thread t1([&rwlock] { EXPECT_FALSE(rwlock.try_lock()); });
+  t1.join();
+
+  std::thread t2([&rwlock] { EXPECT_FALSE(rwlock.try_lock_shared()); });
+  t2.join();
+
+  rwlock.unlock();
+
+  std::thread t3([&rwlock] {
+    EXPECT_TRUE(rwlock.try_lock());
+    rwlock.unlock();
+  });
+  t3.join();
+
+  rwlock.lock_shared();
+
+  std::thread t4([&rwlock] {
+    EXPECT_TRUE(rwlock.try_lock_shared());
+    EXPECT_FALSE(rwlock.try_lock());
+    rwlock.unlock_shared();
+  });
+  t4.join();
+
+  rwlock.unlock_shared();
+  EXPECT_TRUE(rwlock.try_lock());
+  rwlock.unlock();
+}
+
+TEST(ScalableRWLock, UnlockSharedOnAnotherThread) {
+  memgraph::utils::ScalableRWLock rwlock;
+  std::vector<std::thread> threads;
+  // The shared locks are taken on many threads and all released on this one.
+  for (int i = 0; i < 100; ++i) {
+    threads.emplace_back([&rwlock] { rwlock.lock_shared(); });
+  }
+  for (auto &thread : threads) thread.join();
+
+  std::atomic<bool> locked{false};
+  std::thread writer([&] {
+    rwlock.lock();
+    locked = true;
+    rwlock.unlock();
+  });
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_FALSE(locked);
+    rwlock.unlock_shared();
+  }
+  writer.join();
+  EXPECT_TRUE(locked);
+}
+
+TEST(ScalableRWLock, Counter) {
+  memgraph::utils::ScalableRWLock rwlock;
+  int64_t counter = 0;
+  std::atomic<int64_t> reads{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&, i] {
+      for (int j = 0; j < 10000; ++j) {
+        if (j % 100 == i) {
+          std::unique_lock<memgraph::utils::ScalableRWLock> lock(rwlock);
+          ++counter;
+        } else {
+          std::shared_lock<memgraph::utils::ScalableRWLock> lock(rwlock);
+          reads += counter >= 0;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+  EXPECT_EQ(counter, 8 * 100);
+  EXPECT_EQ(reads, 8 * (10000 - 100));
+}
+
+namespace memgraph::metrics {
+extern const Event ObjectLockWait_ns;
+}  // namespace memgraph::metrics
+
+struct TestLockWait {
+  static memgraph::metrics::Event Histogram() { return memgraph::metrics::ObjectLockWait_ns; }
+};
+
+TEST(WaitMeasuredLock, MeasuresContendedWaits) {
+  using Lock = memgraph::utils::WaitMeasuredLock<memgraph::utils::SpinLock, TestLockWait>;
+  const auto &histogram = memgraph::metrics::global_histograms[memgraph::metrics::ObjectLockWait_ns];
+  if (!memgraph::utils::GetTSCFrequency()) GTEST_SKIP() << "TSC frequency is unknown";
+  Lock lock;
+  const auto count = histogram.Count();
+  {
+    std::lock_guard guard(lock);
+  }
+  EXPECT_EQ(histogram.Count(), count);
+
+  lock.lock();
+  std::thread waiter([&lock] { std::lock_guard guard(lock); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  lock.unlock();
+  waiter.join();
+  EXPECT_EQ(histogram.Count(), count + 1);
+}
@@ -13,7 +13,12 @@
 #include "gtest/gtest.h"
 
 #include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "utils/scheduler.hpp"
+#include "utils/timer_wheel.hpp"
 
 /**
  * Scheduler runs every 2 seconds and increases one variable. Test thread
@@ -40,3 +45,61 @@ TEST(Scheduler, TestFunctionExecuting) {
   scheduler.Stop();
   EXPECT_EQ(x, 3);
 }
+
+TEST(Scheduler, TestStopWaitsForRun) {
+  std::atomic<bool> running{false};
+  std::atomic<int> runs{0};
+  memgraph::utils::Scheduler scheduler;
+  scheduler.Run("Test", std::chrono::milliseconds(100), [&] {
+    running = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    ++runs;
+    running = false;
+  });
+  while (!running) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  scheduler.Stop();
+  EXPECT_FALSE(running);
+  EXPECT_EQ(runs, 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  EXPECT_EQ(runs, 1);
+  EXPECT_FALSE(scheduler.IsRunning());
+}
+
+TEST(TimerWheel, PrioritiesAndJitter) {
+  // A single worker runs the due tasks by priority.
+  memgraph::utils::TimerWheel wheel(1, 1);
+  std::mutex mutex;
+  std::vector<std::string> order;
+  auto record = [&](std::string name) {
+    return [&, name] {
+      std::lock_guard guard(mutex);
+      order.push_back(name);
+      // Holds up the worker, so the other tasks become due meanwhile.
+      std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    };
+  };
+  using memgraph::utils::PeriodicTaskPriority;
+  auto blocker = wheel.Register("blocker", std::chrono::milliseconds(50), record("blocker"),
+                                {.priority = PeriodicTaskPriority::NORMAL});
+  auto normal = wheel.Register("normal", std::chrono::milliseconds(100), record("normal"),
+                               {.priority = PeriodicTaskPriority::NORMAL});
+  auto high = wheel.Register("high", std::chrono::milliseconds(150), record("high"),
+                             {.priority = PeriodicTaskPriority::HIGH});
+  std::this_thread::sleep_for(std::chrono::milliseconds(250));
+  memgraph::utils::TimerWheel::Cancel(blocker);
+  memgraph::utils::TimerWheel::Cancel(normal);
+  memgraph::utils::TimerWheel::Cancel(high);
+  ASSERT_GE(order.size(), 2);
+  EXPECT_EQ(order[0], "blocker");
+  EXPECT_EQ(order[1], "high");
+
+  // The jitter delays the runs by at most its duration.
+  std::atomic<int> runs{0};
+  auto jittered = wheel.Register(
+      "jittered", std::chrono::milliseconds(100), [&] { ++runs; },
+      {.jitter = std::chrono::milliseconds(100), .priority = PeriodicTaskPriority::LOW});
+  std::this_thread::sleep_for(std::chrono::milliseconds(550));
+  memgraph::utils::TimerWheel::Cancel(jittered);
+  EXPECT_GE(runs, 2);
+  EXPECT_LE(runs, 5);
+}
@@ -0,0 +1,76 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "utils/sparse_bitset.hpp"
+
+using memgraph::utils::SparseBitset;
+
+TEST(SparseBitset, Empty) {
+  SparseBitset bitset;
+  auto acc = bitset.access();
+  ASSERT_FALSE(acc.Test(0));
+  ASSERT_FALSE(acc.Test(123456789));
+  acc.Clear(42);
+  ASSERT_EQ(acc.BlockCount(), 0);
+}
+
+TEST(SparseBitset, SetClearTest) {
+  SparseBitset bitset;
+  auto acc = bitset.access();
+  for (uint64_t i = 0; i < 10000; i += 3) acc.Set(i);
+  for (uint64_t i = 0; i < 10000; ++i) ASSERT_EQ(acc.Test(i), i % 3 == 0) << i;
+  for (uint64_t i = 0; i < 10000; i += 6) acc.Clear(i);
+  for (uint64_t i = 0; i < 10000; ++i) ASSERT_EQ(acc.Test(i), i % 3 == 0 && i % 6 != 0) << i;
+
+  // Another accessor sees the same values.
+  auto other_acc = bitset.access();
+  ASSERT_TRUE(other_acc.Test(3));
+  ASSERT_FALSE(other_acc.Test(6));
+}
+
+TEST(SparseBitset, SparseBlocks) {
+  SparseBitset bitset;
+  auto acc = bitset.access();
+  acc.Set(5);
+  acc.Set(SparseBitset::kBitsPerBlock - 1);
+  ASSERT_EQ(acc.BlockCount(), 1);
+  acc.Set(1000 * SparseBitset::kBitsPerBlock + 7);
+  ASSERT_EQ(acc.BlockCount(), 2);
+  ASSERT_TRUE(acc.Test(1000 * SparseBitset::kBitsPerBlock + 7));
+  ASSERT_FALSE(acc.Test(1000 * SparseBitset::kBitsPerBlock + 6));
+  ASSERT_FALSE(acc.Test(500 * SparseBitset::kBitsPerBlock));
+  ASSERT_EQ(acc.BlockCount(), 2);
+}
+
+TEST(SparseBitset, ConcurrentSet) {
+  constexpr uint64_t kThreads = 8;
+  constexpr uint64_t kValues = 100000;
+  SparseBitset bitset;
+  {
+    std::vector<std::jthread> threads;
+    for (uint64_t t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&bitset, t] {
+        auto acc = bitset.access();
+        for (uint64_t i = t; i < kValues; i += kThreads) acc.Set(i);
+      });
+    }
+  }
+  auto acc = bitset.access();
+  for (uint64_t i = 0; i < kValues; ++i) ASSERT_TRUE(acc.Test(i)) << i;
+  ASSERT_FALSE(acc.Test(kValues));
+  ASSERT_EQ(acc.BlockCount(), (kValues + SparseBitset::kBitsPerBlock - 1) / SparseBitset::kBitsPerBlock);
+}
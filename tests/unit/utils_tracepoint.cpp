@@ -0,0 +1,41 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "utils/tracepoint.hpp"
+
+using memgraph::utils::CurrentQueryId;
+using memgraph::utils::NextQueryId;
+using memgraph::utils::QueryIdScope;
+
+TEST(Tracepoint, QueryIdScope) {
+  EXPECT_EQ(CurrentQueryId(), 0);
+  const auto outer_id = NextQueryId();
+  const auto inner_id = NextQueryId();
+  EXPECT_NE(outer_id, 0);
+  EXPECT_NE(outer_id, inner_id);
+  {
+    const QueryIdScope outer{outer_id};
+    EXPECT_EQ(CurrentQueryId(), outer_id);
+    {
+      const QueryIdScope inner{inner_id};
+      EXPECT_EQ(CurrentQueryId(), inner_id);
+      MG_TRACEPOINT(test__probe, CurrentQueryId(), "inner");
+    }
+    EXPECT_EQ(CurrentQueryId(), outer_id);
+    std::thread([] { EXPECT_EQ(CurrentQueryId(), 0); }).join();
+  }
+  EXPECT_EQ(CurrentQueryId(), 0);
+  MG_TRACEPOINT(test__probe);
+}